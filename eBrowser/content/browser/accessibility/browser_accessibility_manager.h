@@ -74,6 +74,9 @@ class CONTENT_EXPORT BrowserAccessibilityDelegate {
   virtual void AccessibilityFatalError() = 0;
   virtual gfx::AcceleratedWidget AccessibilityGetAcceleratedWidget() = 0;
   virtual gfx::NativeViewAccessible AccessibilityGetNativeViewAccessible() = 0;
+  // The frame rate the view's interactions are paced at, or 0 for the
+  // display rate.
+  virtual int AccessibilityGetTargetFrameRate() const = 0;
 };
 
 class CONTENT_EXPORT BrowserAccessibilityFactory {
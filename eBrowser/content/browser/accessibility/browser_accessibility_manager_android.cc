@@ -19,6 +19,7 @@
 #include "content/common/accessibility_messages.h"
 #include "jni/BrowserAccessibilityManager_jni.h"
 #include "ui/accessibility/ax_text_utils.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 
 using base::android::AttachCurrentThread;
 using base::android::JavaParamRef;
@@ -302,6 +303,48 @@ void BrowserAccessibilityManagerAndroid::NotifyAccessibilityEvent(
 
 void BrowserAccessibilityManagerAndroid::SendLocationChangeEvents(
       const std::vector<AccessibilityHostMsg_LocationChangeParams>& params) {
+  // The new locations are already in the tree, so a client that reads bounds
+  // later still gets them; only a client reading them now needs telling.
+  if (!IsClientQueryingBounds()) {
+    pending_location_change_ids_.clear();
+    location_change_timer_.Stop();
+    return;
+  }
+
+  for (const auto& param : params)
+    pending_location_change_ids_.insert(param.id);
+  if (location_change_timer_.IsRunning())
+    return;
+
+  // During a scroll every frame moves nodes; tell Java once per frame at the
+  // rate the scroll is paced at rather than on every renderer update.
+  BrowserAccessibilityDelegate* delegate = GetDelegateFromRootManager();
+  int fps = delegate ? delegate->AccessibilityGetTargetFrameRate() : 0;
+  if (fps <= 0)
+    fps = ui::ScrollUpdatePacer::kMaxFrameRate;
+  base::TimeDelta delay = last_location_change_time_ +
+                          base::TimeDelta::FromSeconds(1) / fps -
+                          base::TimeTicks::Now();
+  if (delay > base::TimeDelta()) {
+    location_change_timer_.Start(
+        FROM_HERE, delay, this,
+        &BrowserAccessibilityManagerAndroid::SendPendingLocationChangeEvents);
+    return;
+  }
+  SendPendingLocationChangeEvents();
+}
+
+void BrowserAccessibilityManagerAndroid::SendPendingLocationChangeEvents() {
+  last_location_change_time_ = base::TimeTicks::Now();
+  std::vector<AccessibilityHostMsg_LocationChangeParams> params(
+      pending_location_change_ids_.size());
+  size_t i = 0;
+  for (int32_t id : pending_location_change_ids_)
+    params[i++].id = id;
+  pending_location_change_ids_.clear();
+  if (params.empty())
+    return;
+
   // Android is not very efficient at handling notifications, and location
   // changes in particular are frequent and not time-critical. If a lot of
   // nodes changed location, just send a single notification after a short
@@ -319,6 +362,23 @@ void BrowserAccessibilityManagerAndroid::SendLocationChangeEvents(
   BrowserAccessibilityManager::SendLocationChangeEvents(params);
 }
 
+void BrowserAccessibilityManagerAndroid::DidQueryBounds() {
+  last_bounds_query_time_ = base::TimeTicks::Now();
+}
+
+bool BrowserAccessibilityManagerAndroid::IsClientQueryingBounds() {
+  // Screen readers refetch the nodes they show after every content change,
+  // so a client that cares about bounds reads them at least this often
+  // while the page moves.
+  const int kBoundsQueryIdleSeconds = 2;
+  BrowserAccessibilityManagerAndroid* root_manager =
+      static_cast<BrowserAccessibilityManagerAndroid*>(GetRootManager());
+  if (!root_manager || root_manager->last_bounds_query_time_.is_null())
+    return false;
+  return base::TimeTicks::Now() - root_manager->last_bounds_query_time_ <
+         base::TimeDelta::FromSeconds(kBoundsQueryIdleSeconds);
+}
+
 base::android::ScopedJavaLocalRef<jstring>
 BrowserAccessibilityManagerAndroid::GetSupportedHtmlElementTypes(
     JNIEnv* env,
@@ -348,6 +408,7 @@ void BrowserAccessibilityManagerAndroid::HitTest(
     const JavaParamRef<jobject>& obj,
     jint x,
     jint y) {
+  DidQueryBounds();
   BrowserAccessibilityManager::HitTest(gfx::Point(x, y));
 }
 
@@ -393,6 +454,7 @@ jboolean BrowserAccessibilityManagerAndroid::PopulateAccessibilityNodeInfo(
   if (!node)
     return false;
 
+  DidQueryBounds();
   if (node->GetParent()) {
     Java_BrowserAccessibilityManager_setAccessibilityNodeInfoParent(
         env, obj, info, node->GetParent()->unique_id());
@@ -7,8 +7,12 @@
 
 #include <stdint.h>
 
+#include <set>
+
 #include "base/android/scoped_java_ref.h"
 #include "base/macros.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/browser/accessibility/browser_accessibility_manager.h"
 #include "content/browser/android/content_view_core_impl.h"
 
@@ -256,9 +260,28 @@ class CONTENT_EXPORT BrowserAccessibilityManagerAndroid
   // Handle a hover event from the renderer process.
   void HandleHoverEvent(BrowserAccessibility* node);
 
+  // Notes that the client read node bounds, on the root manager, which is
+  // the one Java calls.
+  void DidQueryBounds();
+  // Whether the client read node bounds recently enough to care where the
+  // nodes have moved.
+  bool IsClientQueryingBounds();
+
+  // Notifies Java of the location changes held in
+  // |pending_location_change_ids_|.
+  void SendPendingLocationChangeEvents();
+
   // See docs for set_prune_tree_for_screen_reader, above.
   bool prune_tree_for_screen_reader_;
 
+  base::TimeTicks last_bounds_query_time_;
+
+  // Location changes are sent at most once per frame at the view's target
+  // frame rate; the ones that arrive in between wait here for the timer.
+  std::set<int32_t> pending_location_change_ids_;
+  base::TimeTicks last_location_change_time_;
+  base::OneShotTimer location_change_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(BrowserAccessibilityManagerAndroid);
 };
 
@@ -81,6 +81,7 @@ class TestBrowserAccessibilityDelegate
   gfx::NativeViewAccessible AccessibilityGetNativeViewAccessible() override {
     return nullptr;
   }
+  int AccessibilityGetTargetFrameRate() const override { return 0; }
 
   bool got_fatal_error() const { return got_fatal_error_; }
   void reset_got_fatal_error() { got_fatal_error_ = false; }
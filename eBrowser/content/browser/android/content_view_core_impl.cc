@@ -5,15 +5,26 @@
 #include "content/browser/android/content_view_core_impl.h"
 
 #include <stddef.h>
+#include <string.h>
+
+#include <limits>
+#include <string>
+#include <utility>
 
 #include "base/android/jni_android.h"
 #include "base/android/jni_array.h"
 #include "base/android/jni_string.h"
 #include "base/android/scoped_java_ref.h"
+#include "base/bind.h"
 #include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/shared_memory.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
@@ -23,12 +34,16 @@
 #include "content/browser/accessibility/browser_accessibility_manager_android.h"
 #include "content/browser/accessibility/browser_accessibility_state_impl.h"
 #include "content/browser/android/gesture_event_type.h"
+#include "content/browser/android/input_model_cache.h"
+#include "content/browser/android/input_model_trainer_host.h"
 #include "content/browser/android/interstitial_page_delegate_android.h"
 #include "content/browser/android/java/gin_java_bridge_dispatcher_host.h"
 #include "content/browser/android/load_url_params.h"
 #include "content/browser/frame_host/interstitial_page_impl.h"
 #include "content/browser/media/media_web_contents_observer.h"
 #include "content/browser/renderer_host/compositor_impl_android.h"
+#include "content/browser/renderer_host/input/input_model_registry.h"
+#include "content/browser/renderer_host/input/input_rate_trace_metadata.h"
 #include "content/browser/renderer_host/input/web_input_event_builders_android.h"
 #include "content/browser/renderer_host/render_view_host_impl.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
@@ -36,12 +51,14 @@
 #include "content/browser/web_contents/web_contents_view_android.h"
 #include "content/common/frame_messages.h"
 #include "content/common/input_messages.h"
+#include "content/common/text_input_state.h"
 #include "content/common/view_messages.h"
 #include "content/public/browser/android/compositor.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/favicon_status.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/screen_orientation_dispatcher_host.h"
 #include "content/public/browser/ssl_host_state_delegate.h"
 #include "content/public/browser/web_contents.h"
@@ -59,12 +76,17 @@
 #include "ui/base/ui_base_switches_util.h"
 #include "ui/events/android/motion_event_android.h"
 #include "ui/events/blink/blink_event_util.h"
+#include "ui/events/blink/input_model_type.h"
+#include "ui/events/blink/speed_feature.h"
 #include "ui/events/blink/web_input_event_traits.h"
 #include "ui/events/event_utils.h"
+#include "ui/gfx/android/device_display_info.h"
 #include "ui/gfx/android/java_bitmap.h"
 #include "ui/gfx/geometry/point_conversions.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/geometry/size_f.h"
+#include "url/gurl.h"
+#include "url/origin.h"
 
 using base::android::AttachCurrentThread;
 using base::android::ConvertJavaStringToUTF16;
@@ -79,6 +101,18 @@ using blink::WebInputEvent;
 
 namespace content {
 
+// A model file read by LoadInputModelFile().
+struct LoadedInputModel {
+  LoadedInputModel() : size(0) {}
+
+  // The compiled model, or null if the model has to be sent as |text|.
+  std::unique_ptr<base::SharedMemory> binary;
+  size_t size;
+  std::string text;
+  // The shell names model files after the device they were trained for.
+  std::string device_id;
+};
+
 namespace {
 
 // Describes the type and enabled state of a select popup item.
@@ -98,6 +132,26 @@ enum PopupItemType {
 
 const void* const kContentViewUserDataKey = &kContentViewUserDataKey;
 
+// Subdirectory of the app's cache directory holding InputModelCache.
+const char kInputModelCacheDirName[] = "input_models";
+
+// Runs on the FILE thread.
+std::unique_ptr<LoadedInputModel> LoadInputModelFile(
+    ui::InputModelType type,
+    const base::FilePath& path,
+    double table_step) {
+  std::unique_ptr<LoadedInputModel> model(new LoadedInputModel());
+  model->device_id = path.BaseName().RemoveExtension().AsUTF8Unsafe();
+  base::FilePath cache_dir;
+  if (base::PathService::Get(base::DIR_CACHE, &cache_dir)) {
+    InputModelCache cache(cache_dir.AppendASCII(kInputModelCacheDirName));
+    model->binary = cache.Load(type, path, table_step, &model->size);
+  }
+  if (!model->binary && !base::ReadFileToString(path, &model->text))
+    LOG(ERROR) << "Failed to read model " << path.value();
+  return model;
+}
+
 int GetRenderProcessIdFromRenderViewHost(RenderViewHost* host) {
   DCHECK(host);
   RenderProcessHost* render_process = host->GetProcess();
@@ -217,7 +271,14 @@ ContentViewCoreImpl::ContentViewCoreImpl(
       page_scale_(1),
       dpi_scale_(ui::GetScaleFactorForNativeView(&view_)),
       device_orientation_(0),
-      accessibility_enabled_(false) {
+      accessibility_enabled_(false),
+      has_sent_frame_info_(false),
+      lazy_scroll_in_progress_(false),
+      sent_scroll_update_consumed_(false),
+      has_deferred_selection_event_(false),
+      send_ime_text_changes_(base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEBrowserImeTextDeltas)),
+      weak_factory_(this) {
       //LOG(INFO)<<")))))))))))))))))))))))))))";
   CHECK(web_contents) <<
       "A ContentViewCoreImpl should be created with a valid WebContents.";
@@ -245,6 +306,18 @@ ContentViewCoreImpl::ContentViewCoreImpl(
                                       java_bridge_retained_object_set);
 
   InitWebContents();
+
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEBrowserLazyScrollFrameInfo)) {
+    // Java drops the buffer in onNativeContentViewCoreDestroyed().
+    const size_t kScrollOffsetBlockFloats = 2;
+    scroll_offset_block_.reset(new float[kScrollOffsetBlockFloats]());
+    ScopedJavaLocalRef<jobject> block(
+        env, env->NewDirectByteBuffer(
+                 scroll_offset_block_.get(),
+                 kScrollOffsetBlockFloats * sizeof(float)));
+    Java_ContentViewCore_setScrollOffsetBlock(env, obj, block);
+  }
 }
 
 void ContentViewCoreImpl::AddObserver(
@@ -258,6 +331,8 @@ void ContentViewCoreImpl::RemoveObserver(
 }
 
 ContentViewCoreImpl::~ContentViewCoreImpl() {
+  if (input_model_trainer_host_)
+    input_model_trainer_host_->Shutdown();
   view_.GetLayer()->RemoveFromParent();
   for (auto& observer : observer_list_)
     observer.OnContentViewCoreDestroyed();
@@ -342,6 +417,7 @@ void ContentViewCoreImpl::RenderViewReady() {
 
 void ContentViewCoreImpl::RenderViewHostChanged(RenderViewHost* old_host,
                                                 RenderViewHost* new_host) {
+  has_sent_frame_info_ = false;
   int old_pid = 0;
   if (old_host) {
     old_pid = GetRenderProcessIdFromRenderViewHost(old_host);
@@ -424,28 +500,98 @@ void ContentViewCoreImpl::UpdateFrameInfo(
       gfx::Vector2dF(0.0f, top_controls_height * top_controls_shown_ratio));
 
   page_scale_ = page_scale_factor;
-
+  scroll_speed_tracker_.OnScrollOffset(
+      base::TimeTicks::Now(),
+      scroll_offset.y() * page_scale_factor * dpi_scale());
+
+  JavaFrameInfo info;
+  info.scroll_offset = scroll_offset;
+  info.page_scale_factor = page_scale_factor;
+  info.page_scale_factor_limits = page_scale_factor_limits;
+  info.content_size = content_size;
+  info.viewport_size = viewport_size;
+  info.top_controls_height = top_controls_height;
+  info.top_controls_shown_ratio = top_controls_shown_ratio;
+  info.bottom_controls_height = bottom_controls_height;
+  info.bottom_controls_shown_ratio = bottom_controls_shown_ratio;
+  info.is_mobile_optimized_hint = is_mobile_optimized_hint;
   // The CursorAnchorInfo API in Android only supports zero width selection
   // bounds.
-  const jboolean has_insertion_marker =
+  info.has_insertion_marker =
       selection_start.type() == gfx::SelectionBound::CENTER;
-  const jboolean is_insertion_marker_visible = selection_start.visible();
-  const jfloat insertion_marker_horizontal =
-      has_insertion_marker ? selection_start.edge_top().x() : 0.0f;
-  const jfloat insertion_marker_top =
-      has_insertion_marker ? selection_start.edge_top().y() : 0.0f;
-  const jfloat insertion_marker_bottom =
-      has_insertion_marker ? selection_start.edge_bottom().y() : 0.0f;
+  info.is_insertion_marker_visible = selection_start.visible();
+  info.insertion_marker_horizontal =
+      info.has_insertion_marker ? selection_start.edge_top().x() : 0.0f;
+  info.insertion_marker_top =
+      info.has_insertion_marker ? selection_start.edge_top().y() : 0.0f;
+  info.insertion_marker_bottom =
+      info.has_insertion_marker ? selection_start.edge_bottom().y() : 0.0f;
+
+  latest_frame_info_ = info;
+  if (scroll_offset_block_) {
+    scroll_offset_block_[0] = scroll_offset.x();
+    scroll_offset_block_[1] = scroll_offset.y();
+  }
+  if (has_sent_frame_info_) {
+    if (info == sent_frame_info_)
+      return;
+    if (lazy_scroll_in_progress_) {
+      JavaFrameInfo unscrolled = info;
+      unscrolled.scroll_offset = sent_frame_info_.scroll_offset;
+      if (unscrolled == sent_frame_info_)
+        return;
+    }
+  }
+  SendFrameInfo(env, obj, info);
+}
 
+void ContentViewCoreImpl::SendFrameInfo(JNIEnv* env,
+                                        const JavaRef<jobject>& obj,
+                                        const JavaFrameInfo& info) {
+  sent_frame_info_ = info;
+  has_sent_frame_info_ = true;
   Java_ContentViewCore_updateFrameInfo(
-      env, obj, scroll_offset.x(), scroll_offset.y(), page_scale_factor,
-      page_scale_factor_limits.x(), page_scale_factor_limits.y(),
-      content_size.width(), content_size.height(), viewport_size.width(),
-      viewport_size.height(), top_controls_height, top_controls_shown_ratio,
-      bottom_controls_height, bottom_controls_shown_ratio,
-      is_mobile_optimized_hint, has_insertion_marker,
-      is_insertion_marker_visible, insertion_marker_horizontal,
-      insertion_marker_top, insertion_marker_bottom);
+      env, obj, info.scroll_offset.x(), info.scroll_offset.y(),
+      info.page_scale_factor, info.page_scale_factor_limits.x(),
+      info.page_scale_factor_limits.y(), info.content_size.width(),
+      info.content_size.height(), info.viewport_size.width(),
+      info.viewport_size.height(), info.top_controls_height,
+      info.top_controls_shown_ratio, info.bottom_controls_height,
+      info.bottom_controls_shown_ratio, info.is_mobile_optimized_hint,
+      info.has_insertion_marker, info.is_insertion_marker_visible,
+      info.insertion_marker_horizontal, info.insertion_marker_top,
+      info.insertion_marker_bottom);
+}
+
+void ContentViewCoreImpl::EndLazyScroll(JNIEnv* env,
+                                        const JavaRef<jobject>& obj) {
+  if (!lazy_scroll_in_progress_)
+    return;
+  lazy_scroll_in_progress_ = false;
+  // Scroll offset listeners and the container view's onScrollChanged() then
+  // see where the gesture left the page, before its end is acked.
+  if (has_sent_frame_info_ && !(latest_frame_info_ == sent_frame_info_))
+    SendFrameInfo(env, obj, latest_frame_info_);
+  SendDeferredSelectionEvent(env, obj);
+}
+
+bool ContentViewCoreImpl::JavaFrameInfo::operator==(
+    const JavaFrameInfo& other) const {
+  return scroll_offset == other.scroll_offset &&
+         page_scale_factor == other.page_scale_factor &&
+         page_scale_factor_limits == other.page_scale_factor_limits &&
+         content_size == other.content_size &&
+         viewport_size == other.viewport_size &&
+         top_controls_height == other.top_controls_height &&
+         top_controls_shown_ratio == other.top_controls_shown_ratio &&
+         bottom_controls_height == other.bottom_controls_height &&
+         bottom_controls_shown_ratio == other.bottom_controls_shown_ratio &&
+         is_mobile_optimized_hint == other.is_mobile_optimized_hint &&
+         has_insertion_marker == other.has_insertion_marker &&
+         is_insertion_marker_visible == other.is_insertion_marker_visible &&
+         insertion_marker_horizontal == other.insertion_marker_horizontal &&
+         insertion_marker_top == other.insertion_marker_top &&
+         insertion_marker_bottom == other.insertion_marker_bottom;
 }
 
 void ContentViewCoreImpl::SetTitle(const base::string16& title) {
@@ -543,27 +689,36 @@ void ContentViewCoreImpl::OnGestureEventAck(const blink::WebGestureEvent& event,
   switch (event.type) {
     case WebInputEvent::GestureFlingStart:
       if (ack_result == INPUT_EVENT_ACK_STATE_CONSUMED) {
-        // The view expects the fling velocity in pixels/s.
+        // The view expects the fling velocity in pixels/s. A lazy scroll
+        // carries on through the fling, until DidStopFlinging().
         Java_ContentViewCore_onFlingStartEventConsumed(env, j_obj);
       } else {
         // If a scroll ends with a fling, a SCROLL_END event is never sent.
         // However, if that fling went unconsumed, we still need to let the
         // listeners know that scrolling has ended.
+        EndLazyScroll(env, j_obj);
         Java_ContentViewCore_onScrollEndEventAck(env, j_obj);
       }
       break;
     case WebInputEvent::GestureFlingCancel:
+      EndLazyScroll(env, j_obj);
       Java_ContentViewCore_onFlingCancelEventAck(env, j_obj);
       break;
     case WebInputEvent::GestureScrollBegin:
+      lazy_scroll_in_progress_ = !!scroll_offset_block_;
+      sent_scroll_update_consumed_ = false;
       Java_ContentViewCore_onScrollBeginEventAck(env, j_obj);
       break;
     case WebInputEvent::GestureScrollUpdate:
       if (ack_result == INPUT_EVENT_ACK_STATE_CONSUMED){
 	//LOG(INFO)<<"INPUT_EVENT_ACK_STATE_CONSUMED";
+        if (lazy_scroll_in_progress_ && sent_scroll_update_consumed_)
+          break;
+        sent_scroll_update_consumed_ = true;
         Java_ContentViewCore_onScrollUpdateGestureConsumed(env, j_obj);}
       break;
     case WebInputEvent::GestureScrollEnd:
+      EndLazyScroll(env, j_obj);
       Java_ContentViewCore_onScrollEndEventAck(env, j_obj);
       break;
     case WebInputEvent::GesturePinchBegin:
@@ -637,12 +792,40 @@ void ContentViewCoreImpl::OnSelectionEvent(ui::SelectionEventType event,
   if (j_obj.is_null())
     return;
 
+  if (lazy_scroll_in_progress_ && (event == ui::SELECTION_HANDLES_MOVED ||
+                                   event == ui::INSERTION_HANDLE_MOVED)) {
+    has_deferred_selection_event_ = true;
+    deferred_selection_event_ = event;
+    deferred_selection_anchor_ = selection_anchor;
+    deferred_selection_rect_ = selection_rect;
+    return;
+  }
+  SendDeferredSelectionEvent(env, j_obj);
+  SendSelectionEvent(env, j_obj, event, selection_anchor, selection_rect);
+}
+
+void ContentViewCoreImpl::SendSelectionEvent(
+    JNIEnv* env,
+    const JavaRef<jobject>& obj,
+    ui::SelectionEventType event,
+    const gfx::PointF& selection_anchor,
+    const gfx::RectF& selection_rect) {
   Java_ContentViewCore_onSelectionEvent(
-      env, j_obj, event, selection_anchor.x(), selection_anchor.y(),
+      env, obj, event, selection_anchor.x(), selection_anchor.y(),
       selection_rect.x(), selection_rect.y(), selection_rect.right(),
       selection_rect.bottom());
 }
 
+void ContentViewCoreImpl::SendDeferredSelectionEvent(
+    JNIEnv* env,
+    const JavaRef<jobject>& obj) {
+  if (!has_deferred_selection_event_)
+    return;
+  has_deferred_selection_event_ = false;
+  SendSelectionEvent(env, obj, deferred_selection_event_,
+                     deferred_selection_anchor_, deferred_selection_rect_);
+}
+
 void ContentViewCoreImpl::ShowPastePopup(int x_dip, int y_dip) {
   RenderWidgetHostViewAndroid* view = GetRenderWidgetHostViewAndroid();
   if (!view)
@@ -703,8 +886,10 @@ void ContentViewCoreImpl::DidStopFlinging() {
   JNIEnv* env = AttachCurrentThread();
 
   ScopedJavaLocalRef<jobject> obj = java_ref_.get(env);
-  if (!obj.is_null())
+  if (!obj.is_null()) {
+    EndLazyScroll(env, obj);
     Java_ContentViewCore_onNativeFlingStopped(env, obj);
+  }
 }
 
 ScopedJavaLocalRef<jobject> ContentViewCoreImpl::GetContext() const {
@@ -860,6 +1045,14 @@ void ContentViewCoreImpl::SetFocus(JNIEnv* env,
   SetFocusInternal(focused);
 }
 
+void ContentViewCoreImpl::OnWindowFocusChanged(
+    JNIEnv* env,
+    const JavaParamRef<jobject>& obj,
+    jboolean has_window_focus) {
+  if (GetRenderWidgetHostViewAndroid())
+    GetRenderWidgetHostViewAndroid()->OnWindowFocusChanged(has_window_focus);
+}
+
 void ContentViewCoreImpl::SetFocusInternal(bool focused) {
   if (!GetRenderWidgetHostViewAndroid())
     return;
@@ -1044,10 +1237,86 @@ void ContentViewCoreImpl::ScrollBegin(JNIEnv* env,
 //my code
 void ContentViewCoreImpl::SendModelStr(JNIEnv* env,
                                       const JavaParamRef<jobject>& obj,
+                                      jint type,
                                      const JavaParamRef<jstring>& model) {
-
+  if (type < 0 || type > ui::INPUT_MODEL_TYPE_LAST)
+    return;
   std::string model_str = ConvertJavaStringToUTF8(env, model);
-  Send(new InputMsg_ModelStr(routing_id(),model_str));
+  SendModelFeatureScale();
+  Send(new InputMsg_ModelStr(routing_id(),
+                             static_cast<ui::InputModelType>(type),
+                             model_str));
+}
+
+void ContentViewCoreImpl::SendOriginModelStr(
+    JNIEnv* env,
+    const JavaParamRef<jobject>& obj,
+    jint type,
+    const JavaParamRef<jstring>& origin,
+    const JavaParamRef<jstring>& model) {
+  if (type < 0 || type > ui::INPUT_MODEL_TYPE_LAST)
+    return;
+  // Serialized the way the renderer serializes its committed origins.
+  url::Origin model_origin(GURL(ConvertJavaStringToUTF8(env, origin)));
+  if (model_origin.unique())
+    return;
+  SendModelFeatureScale();
+  Send(new InputMsg_OriginModelStr(routing_id(),
+                                   static_cast<ui::InputModelType>(type),
+                                   model_origin.Serialize(),
+                                   ConvertJavaStringToUTF8(env, model)));
+}
+
+void ContentViewCoreImpl::SendEnergyCurveStr(
+    JNIEnv* env,
+    const JavaParamRef<jobject>& obj,
+    const JavaParamRef<jstring>& curve) {
+  std::string curve_str = ConvertJavaStringToUTF8(env, curve);
+  InputRateTraceMetadata::GetInstance()->SetEnergyCurve(curve_str);
+  Send(new InputMsg_EnergyCurveStr(routing_id(), curve_str));
+}
+
+void ContentViewCoreImpl::AddModelFeedback(JNIEnv* env,
+                                           const JavaParamRef<jobject>& obj,
+                                           jfloat speed,
+                                           jint frame_rate) {
+  if (!input_model_trainer_host_) {
+    input_model_trainer_host_ = new InputModelTrainerHost(base::Bind(
+        &ContentViewCoreImpl::OnInputModelTrained, base::Unretained(this)));
+  }
+  input_model_trainer_host_->AddFeedback(speed, frame_rate);
+}
+
+jlong ContentViewCoreImpl::GetScrollSpeed(JNIEnv* env,
+                                          const JavaParamRef<jobject>& obj) {
+  return scroll_speed_tracker_.average_speed();
+}
+
+jfloat ContentViewCoreImpl::GetScrollSpeedFeature(
+    JNIEnv* env,
+    const JavaParamRef<jobject>& obj) {
+  gfx::DeviceDisplayInfo device_info;
+  ui::SpeedFeature speed_feature(device_info.GetPhysicalDpi(),
+                                 device_info.GetRefreshRate());
+  return speed_feature.FromPhysicalPixelsPerSecond(
+      scroll_speed_tracker_.average_speed());
+}
+
+void ContentViewCoreImpl::ResetScrollSpeed(JNIEnv* env,
+                                           const JavaParamRef<jobject>& obj) {
+  scroll_speed_tracker_.Reset();
+}
+
+void ContentViewCoreImpl::SendModelFeatureScale() {
+  gfx::DeviceDisplayInfo device_info;
+  Send(new InputMsg_ModelFeatureScale(routing_id(), dpi_scale(),
+                                      device_info.GetPhysicalDpi(),
+                                      device_info.GetRefreshRate()));
+}
+
+void ContentViewCoreImpl::OnInputModelTrained(const std::string& model) {
+  SendModelFeatureScale();
+  Send(new InputMsg_ModelStr(routing_id(), ui::INPUT_MODEL_SCROLL, model));
 }
 
 void ContentViewCoreImpl::SendModelParams(JNIEnv* env,
@@ -1055,6 +1324,86 @@ void ContentViewCoreImpl::SendModelParams(JNIEnv* env,
  
   Send(new InputMsg_ModelParams(routing_id(), speed, entropy));
 }
+
+void ContentViewCoreImpl::SendModelBinary(
+    JNIEnv* env,
+    const JavaParamRef<jobject>& obj,
+    jint type,
+    const JavaParamRef<jobject>& model) {
+  if (type < 0 || type > ui::INPUT_MODEL_TYPE_LAST)
+    return;
+  const void* data = env->GetDirectBufferAddress(model);
+  jlong capacity = env->GetDirectBufferCapacity(model);
+  if (!data || capacity <= 0 || capacity > std::numeric_limits<uint32_t>::max())
+    return;
+  size_t size = static_cast<size_t>(capacity);
+
+  // |model| is usually the model file mapped by the Java side. This is the
+  // only copy: the renderer maps the region read-only and evaluates in place.
+  std::unique_ptr<base::SharedMemory> shared_memory(new base::SharedMemory());
+  if (!shared_memory->CreateAndMapAnonymous(size))
+    return;
+  memcpy(shared_memory->memory(), data, size);
+  SendSharedModel(static_cast<ui::InputModelType>(type), std::string(),
+                  std::move(shared_memory), size);
+}
+
+void ContentViewCoreImpl::SendModelFile(JNIEnv* env,
+                                        const JavaParamRef<jobject>& obj,
+                                        jint type,
+                                        const JavaParamRef<jstring>& path) {
+  if (type < 0 || type > ui::INPUT_MODEL_TYPE_LAST)
+    return;
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  // Compiled with the renderer's step, so that the cached table is the one
+  // the renderer would have built.
+  double table_step;
+  if (!base::StringToDouble(command_line.GetSwitchValueASCII(
+                                switches::kEBrowserPredictorTableStep),
+                            &table_step)) {
+    table_step = 0;
+  }
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&LoadInputModelFile, static_cast<ui::InputModelType>(type),
+                 base::FilePath(ConvertJavaStringToUTF8(env, path)),
+                 table_step),
+      base::Bind(&ContentViewCoreImpl::OnModelFileLoaded,
+                 weak_factory_.GetWeakPtr(),
+                 static_cast<ui::InputModelType>(type)));
+}
+
+void ContentViewCoreImpl::OnModelFileLoaded(
+    ui::InputModelType type,
+    std::unique_ptr<LoadedInputModel> model) {
+  if (model->binary) {
+    SendSharedModel(type, model->device_id, std::move(model->binary),
+                    model->size);
+    return;
+  }
+  if (model->text.empty())
+    return;
+  SendModelFeatureScale();
+  Send(new InputMsg_ModelStr(routing_id(), type, model->text));
+}
+
+void ContentViewCoreImpl::SendSharedModel(
+    ui::InputModelType type,
+    const std::string& device_id,
+    std::unique_ptr<base::SharedMemory> model,
+    size_t size) {
+  if (size > std::numeric_limits<uint32_t>::max())
+    return;
+  // Every view that loads the same model gets the same version, so that its
+  // renderer fetches and maps the model once.
+  uint32_t version = InputModelRegistry::GetInstance()->Register(
+      InputModelRegistry::Key(type, device_id, std::string()),
+      std::move(model), size);
+  SendModelFeatureScale();
+  Send(new InputMsg_ModelAvailable(routing_id(), type, device_id,
+                                   std::string(), version));
+}
 //end
 
 
@@ -1260,6 +1609,8 @@ void ContentViewCoreImpl::RemoveJavascriptInterface(
 
 void ContentViewCoreImpl::WasResized(JNIEnv* env,
                                      const JavaParamRef<jobject>& obj) {
+  // Java clamps the content size to its own viewport size.
+  has_sent_frame_info_ = false;
   RenderWidgetHostViewAndroid* view = GetRenderWidgetHostViewAndroid();
   gfx::Size physical_size(
       Java_ContentViewCore_getPhysicalBackingWidthPix(env, obj),
@@ -1305,12 +1656,33 @@ void ContentViewCoreImpl::UpdateImeAdapter(long native_ime_adapter,
   if (obj.is_null())
     return;
 
-  ScopedJavaLocalRef<jstring> jstring_text = ConvertUTF8ToJavaString(env, text);
+  ScopedJavaLocalRef<jstring> jstring_text;
+  int text_change_start = -1;
+  int text_change_end = -1;
+  if (send_ime_text_changes_) {
+    base::string16 text16 = base::UTF8ToUTF16(text);
+    if (sent_ime_text_.size() >= kMinTextInputValueLengthForChanges) {
+      size_t change_start = 0;
+      size_t change_end = 0;
+      FindTextChange(sent_ime_text_, text16, &change_start, &change_end);
+      text_change_start = change_start;
+      text_change_end = change_end;
+      jstring_text = ConvertUTF16ToJavaString(
+          env, text16.substr(change_start, change_end + text16.size() -
+                                               sent_ime_text_.size() -
+                                               change_start));
+    } else {
+      jstring_text = ConvertUTF16ToJavaString(env, text16);
+    }
+    sent_ime_text_.swap(text16);
+  } else {
+    jstring_text = ConvertUTF8ToJavaString(env, text);
+  }
   Java_ContentViewCore_updateImeAdapter(
       env, obj, native_ime_adapter, text_input_type, text_input_flags,
-      jstring_text, selection_start, selection_end, composition_start,
-      composition_end, show_ime_if_needed, is_non_ime_change,
-      in_batch_edit_mode);
+      jstring_text, text_change_start, text_change_end, selection_start,
+      selection_end, composition_start, composition_end, show_ime_if_needed,
+      is_non_ime_change, in_batch_edit_mode);
 }
 
 void ContentViewCoreImpl::SetAccessibilityEnabled(
@@ -1536,6 +1908,26 @@ void ContentViewCoreImpl::OnSmartClipDataExtracted(
                                                 clip_rect_object);
 }
 
+void ContentViewCoreImpl::OnImplicitFeedback(
+    const std::vector<ui::ImplicitFeedbackSample>& samples) {
+  JNIEnv* env = AttachCurrentThread();
+  ScopedJavaLocalRef<jobject> obj = java_ref_.get(env);
+  if (obj.is_null() || samples.empty())
+    return;
+  std::vector<int> types;
+  std::vector<float> speeds;
+  std::vector<int> frame_rates;
+  for (const ui::ImplicitFeedbackSample& sample : samples) {
+    types.push_back(sample.type);
+    speeds.push_back(sample.speed);
+    frame_rates.push_back(sample.fps);
+  }
+  Java_ContentViewCore_onImplicitFeedback(
+      env, obj, base::android::ToJavaIntArray(env, types),
+      base::android::ToJavaFloatArray(env, speeds),
+      base::android::ToJavaIntArray(env, frame_rates));
+}
+
 void ContentViewCoreImpl::WebContentsDestroyed() {
   WebContentsViewAndroid* wcva = static_cast<WebContentsViewAndroid*>(
       static_cast<WebContentsImpl*>(web_contents())->GetView());
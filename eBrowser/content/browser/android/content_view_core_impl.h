@@ -16,8 +16,10 @@
 #include "base/compiler_specific.h"
 #include "base/i18n/rtl.h"
 #include "base/macros.h"
+#include "base/memory/weak_ptr.h"
 #include "base/process/process.h"
 #include "content/browser/android/content_view_core_impl_observer.h"
+#include "content/browser/android/scroll_speed_tracker.h"
 #include "content/browser/renderer_host/render_widget_host_view_android.h"
 #include "content/browser/web_contents/web_contents_impl.h"
 #include "content/public/browser/android/content_view_core.h"
@@ -25,11 +27,19 @@
 #include "third_party/WebKit/public/web/WebInputEvent.h"
 #include "ui/android/overscroll_refresh.h"
 #include "ui/android/view_android.h"
+#include "ui/events/blink/implicit_feedback_recorder.h"
+#include "ui/events/blink/input_model_type.h"
 #include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/geometry/rect_f.h"
+#include "ui/gfx/geometry/size_f.h"
+#include "ui/gfx/geometry/vector2d_f.h"
 #include "ui/gfx/selection_bound.h"
 #include "url/gurl.h"
 
+namespace base {
+class SharedMemory;
+}
+
 namespace cc {
 struct ViewportSelectionBound;
 }
@@ -41,8 +51,10 @@ class WindowAndroid;
 namespace content {
 
 class GinJavaBridgeDispatcherHost;
+class InputModelTrainerHost;
 class RenderFrameHost;
 class RenderWidgetHostViewAndroid;
+struct LoadedInputModel;
 struct MenuItem;
 
 class ContentViewCoreImpl : public ContentViewCore,
@@ -150,11 +162,54 @@ class ContentViewCoreImpl : public ContentViewCore,
                    jfloat hinty,
                    jboolean target_viewport);
   //my code
+  // |type| is a ui::InputModelType.
   void SendModelStr(JNIEnv* env,
-                   const base::android::JavaParamRef<jobject>& obj,                
+                   const base::android::JavaParamRef<jobject>& obj,
+                   jint type,
                    const base::android::JavaParamRef<jstring>& model);
+  // Like SendModelStr, for a model that only paces pages of |origin|, a URL
+  // whose origin is used.
+  void SendOriginModelStr(JNIEnv* env,
+                          const base::android::JavaParamRef<jobject>& obj,
+                          jint type,
+                          const base::android::JavaParamRef<jstring>& origin,
+                          const base::android::JavaParamRef<jstring>& model);
+  // Sends the device's energy curve, in the ui::EnergyCurve text format.
+  void SendEnergyCurveStr(JNIEnv* env,
+                          const base::android::JavaParamRef<jobject>& obj,
+                          const base::android::JavaParamRef<jstring>& curve);
   void SendModelParams(JNIEnv* env,
                    const base::android::JavaParamRef<jobject>& obj, jlong speed, jfloat entropy);
+  // Sends a model in the ui::DenseRbfModel binary format. |model| is a direct
+  // java.nio.ByteBuffer.
+  void SendModelBinary(JNIEnv* env,
+                       const base::android::JavaParamRef<jobject>& obj,
+                       jint type,
+                       const base::android::JavaParamRef<jobject>& model);
+  // Sends the model in the file at |path|, text or binary. Text models are
+  // compiled once into InputModelCache and sent in their binary form.
+  void SendModelFile(JNIEnv* env,
+                     const base::android::JavaParamRef<jobject>& obj,
+                     jint type,
+                     const base::android::JavaParamRef<jstring>& path);
+  // Feeds the user's frame rate choice for the last scroll to the on-device
+  // trainer of the scroll model. |speed| is in the units of the cloud
+  // trainer's feedback.
+  void AddModelFeedback(JNIEnv* env,
+                        const base::android::JavaParamRef<jobject>& obj,
+                        jfloat speed,
+                        jint frame_rate);
+  // Average speed of the current scroll, in physical pixels per second, as
+  // rated by the user's feedback; see ScrollSpeedTracker.
+  jlong GetScrollSpeed(JNIEnv* env,
+                       const base::android::JavaParamRef<jobject>& obj);
+  // The same speed as the models' speed feature on this panel, the units
+  // feedback is given in; see ui::SpeedFeature.
+  jfloat GetScrollSpeedFeature(
+      JNIEnv* env,
+      const base::android::JavaParamRef<jobject>& obj);
+  void ResetScrollSpeed(JNIEnv* env,
+                        const base::android::JavaParamRef<jobject>& obj);
   //end
 
   void ScrollEnd(JNIEnv* env,
@@ -230,6 +285,9 @@ class ContentViewCoreImpl : public ContentViewCore,
   void SetFocus(JNIEnv* env,
                 const base::android::JavaParamRef<jobject>& obj,
                 jboolean focused);
+  void OnWindowFocusChanged(JNIEnv* env,
+                            const base::android::JavaParamRef<jobject>& obj,
+                            jboolean has_window_focus);
 
   jint GetBackgroundColor(JNIEnv* env, jobject obj);
   void SetAllowJavascriptInterfacesInspection(
@@ -302,6 +360,11 @@ class ContentViewCoreImpl : public ContentViewCore,
                                 const base::string16& html,
                                 const gfx::Rect& clip_rect);
 
+  // Passes a batch of the renderer's implicit feedback on the frame rate
+  // models to the embedder.
+  void OnImplicitFeedback(
+      const std::vector<ui::ImplicitFeedbackSample>& samples);
+
   // Creates a popup menu with |items|.
   // |multiple| defines if it should support multi-select.
   // If not |multiple|, |selected_item| sets the initially selected item.
@@ -421,8 +484,43 @@ class ContentViewCoreImpl : public ContentViewCore,
   // Other private methods and data
   // --------------------------------------------------------------------------
 
+  // The arguments of ContentViewCore.updateFrameInfo().
+  struct JavaFrameInfo {
+    bool operator==(const JavaFrameInfo& other) const;
+
+    gfx::Vector2dF scroll_offset;
+    float page_scale_factor;
+    gfx::Vector2dF page_scale_factor_limits;
+    gfx::SizeF content_size;
+    gfx::SizeF viewport_size;
+    float top_controls_height;
+    float top_controls_shown_ratio;
+    float bottom_controls_height;
+    float bottom_controls_shown_ratio;
+    bool is_mobile_optimized_hint;
+    bool has_insertion_marker;
+    bool is_insertion_marker_visible;
+    float insertion_marker_horizontal;
+    float insertion_marker_top;
+    float insertion_marker_bottom;
+  };
+
   void InitWebContents();
 
+  void SendFrameInfo(JNIEnv* env,
+                     const base::android::JavaRef<jobject>& obj,
+                     const JavaFrameInfo& info);
+  void SendSelectionEvent(JNIEnv* env,
+                          const base::android::JavaRef<jobject>& obj,
+                          ui::SelectionEventType event,
+                          const gfx::PointF& selection_anchor,
+                          const gfx::RectF& selection_rect);
+  void SendDeferredSelectionEvent(JNIEnv* env,
+                                  const base::android::JavaRef<jobject>& obj);
+  // Ends a lazy scroll, sending the frame info and the selection handle move
+  // it held back.
+  void EndLazyScroll(JNIEnv* env, const base::android::JavaRef<jobject>& obj);
+
   RenderWidgetHostViewAndroid* GetRenderWidgetHostViewAndroid() const;
 
   blink::WebGestureEvent MakeGestureEvent(blink::WebInputEvent::Type type,
@@ -442,6 +540,23 @@ class ContentViewCoreImpl : public ContentViewCore,
   // Send device_orientation_ to renderer.
   void SendOrientationChangeEventInternal();
 
+  // Tells the renderer how to turn scroll deltas into the models' speed
+  // feature. Sent ahead of every model.
+  void SendModelFeatureScale();
+
+  // Installs a scroll model trained on the device.
+  void OnInputModelTrained(const std::string& model);
+
+  // Shares |size| bytes of |model|, in a ui::InputModel binary format, with
+  // the renderer through InputModelRegistry. |device_id| names the device the
+  // model was trained for, if known.
+  void SendSharedModel(ui::InputModelType type,
+                       const std::string& device_id,
+                       std::unique_ptr<base::SharedMemory> model,
+                       size_t size);
+  void OnModelFileLoaded(ui::InputModelType type,
+                         std::unique_ptr<LoadedInputModel> model);
+
   float dpi_scale() const { 
 //LOG(INFO)<<"dpi_scale:"<<dpi_scale_;
 return dpi_scale_; }
@@ -476,6 +591,49 @@ return dpi_scale_; }
   // Manages injecting Java objects.
   scoped_refptr<GinJavaBridgeDispatcherHost> java_bridge_dispatcher_host_;
 
+  // Created with the first model feedback.
+  scoped_refptr<InputModelTrainerHost> input_model_trainer_host_;
+
+  // Fed by UpdateFrameInfo(), so the speed is tracked without a call into
+  // Java per frame.
+  ScrollSpeedTracker scroll_speed_tracker_;
+
+  // The arguments of the last updateFrameInfo() call into Java. Most frames,
+  // such as those of an animation or of a fling's tail once the top controls
+  // settle, change none of them, and UpdateFrameInfo() then skips the call
+  // and the Java work behind it. Cleared whenever Java's own state may have
+  // moved on without a frame, so the next frame is sent regardless.
+  JavaFrameInfo sent_frame_info_;
+  bool has_sent_frame_info_;
+
+  // With --ebrowser-lazy-scroll-frame-info, the latest scroll offset in CSS
+  // pixels, x then y, in a direct buffer that Java's RenderCoordinates reads
+  // when it needs it. Frames of a scroll or fling that only move the offset
+  // are then written here rather than sent, and Java is brought up to date
+  // with |latest_frame_info_| when the gesture ends. Null otherwise.
+  std::unique_ptr<float[]> scroll_offset_block_;
+  JavaFrameInfo latest_frame_info_;
+  bool lazy_scroll_in_progress_;
+  // Whether onScrollUpdateGestureConsumed() was sent for the current lazy
+  // scroll; listeners only need its first.
+  bool sent_scroll_update_consumed_;
+  // The latest selection or insertion handle move of a lazy scroll. Java
+  // keeps its action mode and paste popup hidden while scrolling, so only
+  // where the handles end up matters to it; the handles themselves are
+  // composited layers and move with every frame regardless.
+  bool has_deferred_selection_event_;
+  ui::SelectionEventType deferred_selection_event_;
+  gfx::PointF deferred_selection_anchor_;
+  gfx::RectF deferred_selection_rect_;
+
+  // With --ebrowser-ime-text-deltas, the text last passed to Java's
+  // updateImeAdapter(). Java's ImeAdapter keeps the same copy, so only the
+  // range that changed since is converted and sent.
+  const bool send_ime_text_changes_;
+  base::string16 sent_ime_text_;
+
+  base::WeakPtrFactory<ContentViewCoreImpl> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(ContentViewCoreImpl);
 };
 
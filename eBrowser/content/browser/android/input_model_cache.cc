@@ -0,0 +1,135 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/android/input_model_cache.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/memory/shared_memory.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "crypto/sha2.h"
+#include "ui/events/blink/input_model.h"
+
+namespace content {
+
+namespace {
+
+// Part of every key, so that entries written in an older compiled format
+// miss instead of failing to load.
+const char kCacheFormatVersion[] = "1";
+
+const char kEntryExtension[] = ".bin";
+
+std::unique_ptr<base::SharedMemory> CopyToSharedMemory(const uint8_t* data,
+                                                       size_t size) {
+  std::unique_ptr<base::SharedMemory> memory(new base::SharedMemory());
+  if (!size || !memory->CreateAndMapAnonymous(size))
+    return nullptr;
+  memcpy(memory->memory(), data, size);
+  return memory;
+}
+
+// Returns |path| in shared memory if it holds a model in a binary format.
+std::unique_ptr<base::SharedMemory> LoadBinaryFile(const base::FilePath& path,
+                                                   size_t* size) {
+  base::MemoryMappedFile file;
+  if (!file.Initialize(path) ||
+      !ui::InputModel::IsBinary(file.data(), file.length())) {
+    return nullptr;
+  }
+  *size = file.length();
+  return CopyToSharedMemory(file.data(), file.length());
+}
+
+// Models are written by hand as often as by the server; trailing spaces and
+// CRLF line ends must neither break parsing nor change the key.
+std::string NormalizeModelText(const std::string& model_str) {
+  return base::JoinString(
+      base::SplitStringPiece(model_str, "\n", base::TRIM_WHITESPACE,
+                             base::SPLIT_WANT_NONEMPTY),
+      "\n");
+}
+
+std::string EntryPrefix(ui::InputModelType type) {
+  return base::IntToString(type) + "-";
+}
+
+}  // namespace
+
+InputModelCache::InputModelCache(const base::FilePath& cache_dir)
+    : cache_dir_(cache_dir) {}
+
+InputModelCache::~InputModelCache() {}
+
+std::unique_ptr<base::SharedMemory> InputModelCache::Load(
+    ui::InputModelType type,
+    const base::FilePath& model_file,
+    double table_step,
+    size_t* size) {
+  std::unique_ptr<base::SharedMemory> memory =
+      LoadBinaryFile(model_file, size);
+  if (memory)
+    return memory;
+
+  std::string model_str;
+  if (!base::ReadFileToString(model_file, &model_str))
+    return nullptr;
+  model_str = NormalizeModelText(model_str);
+
+  base::FilePath entry = GetEntryPath(type, model_str, table_step);
+  memory = LoadBinaryFile(entry, size);
+  if (memory)
+    return memory;
+
+  std::vector<uint8_t> binary;
+  if (!ui::InputModel::CompileToBinary(type, model_str, table_step, &binary))
+    return nullptr;
+  if (base::CreateDirectory(cache_dir_) &&
+      base::ImportantFileWriter::WriteFileAtomically(
+          entry, base::StringPiece(reinterpret_cast<const char*>(binary.data()),
+                                   binary.size()))) {
+    DeleteOtherEntries(type, entry);
+  } else {
+    LOG(WARNING) << "Failed to cache compiled model " << entry.value();
+  }
+  *size = binary.size();
+  return CopyToSharedMemory(binary.data(), binary.size());
+}
+
+base::FilePath InputModelCache::GetEntryPath(ui::InputModelType type,
+                                             const std::string& model_str,
+                                             double table_step) const {
+  std::string key = std::string(kCacheFormatVersion) + "\n" +
+                    base::DoubleToString(table_step) + "\n" + model_str;
+  std::string hash = crypto::SHA256HashString(key);
+  return cache_dir_.AppendASCII(
+      EntryPrefix(type) +
+      base::ToLowerASCII(base::HexEncode(hash.data(), hash.size())) +
+      kEntryExtension);
+}
+
+void InputModelCache::DeleteOtherEntries(ui::InputModelType type,
+                                         const base::FilePath& keep) const {
+  base::FileEnumerator entries(
+      cache_dir_, false, base::FileEnumerator::FILES,
+      EntryPrefix(type) + "*" + kEntryExtension);
+  for (base::FilePath path = entries.Next(); !path.empty();
+       path = entries.Next()) {
+    if (path != keep)
+      base::DeleteFile(path, false);
+  }
+}
+
+}  // namespace content
@@ -0,0 +1,64 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_ANDROID_INPUT_MODEL_CACHE_H_
+#define CONTENT_BROWSER_ANDROID_INPUT_MODEL_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "content/common/content_export.h"
+#include "ui/events/blink/input_model_type.h"
+
+namespace base {
+class SharedMemory;
+}
+
+namespace content {
+
+// Keeps event rate models compiled into their binary form, a FrameRateTable
+// or a DenseRbfModel, in the app's cache directory, keyed by a hash of the
+// model text and the compile options. A downloaded model is then parsed once
+// rather than on every power saving toggle and process start, and the
+// renderer maps the compiled form with no parse at all.
+//
+// All methods block on file I/O and must not run on the UI or IO threads.
+class CONTENT_EXPORT InputModelCache {
+ public:
+  // |cache_dir| is created on first use. Entries are named
+  // "<type>-<sha256>.bin"; compiling a new model of a type deletes the other
+  // entries of that type.
+  explicit InputModelCache(const base::FilePath& cache_dir);
+  ~InputModelCache();
+
+  // Returns the compiled form of the model in |model_file|, in read-only
+  // shareable memory, compiling it on a cache miss. Files that already hold a
+  // binary model are returned as they are. |table_step| is as for
+  // ui::InputModel::CompileToBinary(). Returns null if the file cannot be
+  // read or holds no valid model; models without a binary form, such as
+  // sparse multi-feature models, are left to the text path.
+  std::unique_ptr<base::SharedMemory> Load(ui::InputModelType type,
+                                           const base::FilePath& model_file,
+                                           double table_step,
+                                           size_t* size);
+
+  // Path of the entry for |model_str|, whether or not it exists.
+  base::FilePath GetEntryPath(ui::InputModelType type,
+                              const std::string& model_str,
+                              double table_step) const;
+
+ private:
+  void DeleteOtherEntries(ui::InputModelType type,
+                          const base::FilePath& keep) const;
+
+  const base::FilePath cache_dir_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputModelCache);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_ANDROID_INPUT_MODEL_CACHE_H_
@@ -0,0 +1,128 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/android/input_model_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/shared_memory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/frame_rate_table.h"
+#include "ui/events/blink/input_model.h"
+
+namespace content {
+namespace {
+
+const char kScrollModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.5\n"
+    "nr_class 2\n"
+    "total_sv 2\n"
+    "rho -30\n"
+    "SV\n"
+    "10 1:1\n"
+    "-10 1:3\n";
+
+}  // namespace
+
+class InputModelCacheTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    cache_dir_ = temp_dir_.GetPath().AppendASCII("cache");
+    cache_.reset(new InputModelCache(cache_dir_));
+  }
+
+  base::FilePath WriteModel(const std::string& name,
+                            const std::string& contents) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_EQ(static_cast<int>(contents.size()),
+              base::WriteFile(path, contents.data(), contents.size()));
+    return path;
+  }
+
+  int CountEntries() {
+    int count = 0;
+    base::FileEnumerator entries(cache_dir_, false,
+                                 base::FileEnumerator::FILES);
+    for (base::FilePath path = entries.Next(); !path.empty();
+         path = entries.Next()) {
+      ++count;
+    }
+    return count;
+  }
+
+ protected:
+  base::ScopedTempDir temp_dir_;
+  base::FilePath cache_dir_;
+  std::unique_ptr<InputModelCache> cache_;
+};
+
+TEST_F(InputModelCacheTest, CompilesOnceAndServesFromCache) {
+  base::FilePath model = WriteModel("model", kScrollModel);
+  size_t size = 0;
+  std::unique_ptr<base::SharedMemory> compiled =
+      cache_->Load(ui::INPUT_MODEL_SCROLL, model, 0, &size);
+  ASSERT_TRUE(compiled);
+  EXPECT_TRUE(ui::InputModel::IsBinary(compiled->memory(), size));
+  base::FilePath entry =
+      cache_->GetEntryPath(ui::INPUT_MODEL_SCROLL, kScrollModel, 0);
+  EXPECT_TRUE(base::PathExists(entry));
+  EXPECT_EQ(1, CountEntries());
+
+  // Whitespace differences hit the same entry.
+  WriteModel("model", std::string(kScrollModel) + "\n\n");
+  size_t cached_size = 0;
+  compiled = cache_->Load(ui::INPUT_MODEL_SCROLL, model, 0, &cached_size);
+  ASSERT_TRUE(compiled);
+  EXPECT_EQ(size, cached_size);
+  EXPECT_EQ(1, CountEntries());
+}
+
+TEST_F(InputModelCacheTest, TableStepIsPartOfTheKey) {
+  base::FilePath model = WriteModel("model", kScrollModel);
+  size_t size = 0;
+  std::unique_ptr<base::SharedMemory> compiled =
+      cache_->Load(ui::INPUT_MODEL_SCROLL, model, 0.5, &size);
+  ASSERT_TRUE(compiled);
+  EXPECT_TRUE(ui::FrameRateTable::IsBinaryTable(compiled->memory(), size));
+  EXPECT_NE(cache_->GetEntryPath(ui::INPUT_MODEL_SCROLL, kScrollModel, 0.5),
+            cache_->GetEntryPath(ui::INPUT_MODEL_SCROLL, kScrollModel, 0));
+}
+
+TEST_F(InputModelCacheTest, NewModelReplacesEntriesOfItsType) {
+  size_t size = 0;
+  ASSERT_TRUE(cache_->Load(ui::INPUT_MODEL_SCROLL,
+                           WriteModel("scroll", kScrollModel), 0, &size));
+  ASSERT_TRUE(cache_->Load(ui::INPUT_MODEL_PINCH,
+                           WriteModel("pinch", kScrollModel), 0, &size));
+  EXPECT_EQ(2, CountEntries());
+
+  std::string updated(kScrollModel);
+  updated.replace(updated.find("rho -30"), 7, "rho -20");
+  ASSERT_TRUE(cache_->Load(ui::INPUT_MODEL_SCROLL,
+                           WriteModel("scroll", updated), 0, &size));
+  EXPECT_EQ(2, CountEntries());
+  EXPECT_FALSE(base::PathExists(
+      cache_->GetEntryPath(ui::INPUT_MODEL_SCROLL, kScrollModel, 0)));
+  EXPECT_TRUE(base::PathExists(
+      cache_->GetEntryPath(ui::INPUT_MODEL_PINCH, kScrollModel, 0)));
+}
+
+TEST_F(InputModelCacheTest, InvalidModels) {
+  size_t size = 0;
+  EXPECT_FALSE(cache_->Load(ui::INPUT_MODEL_SCROLL,
+                            temp_dir_.GetPath().AppendASCII("missing"), 0,
+                            &size));
+  EXPECT_FALSE(cache_->Load(ui::INPUT_MODEL_SCROLL,
+                            WriteModel("garbage", "not a model"), 0, &size));
+  EXPECT_EQ(0, CountEntries());
+}
+
+}  // namespace content
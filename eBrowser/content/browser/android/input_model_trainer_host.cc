@@ -0,0 +1,102 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/android/input_model_trainer_host.h"
+
+#include "base/bind.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/trace_event/trace_event.h"
+#include "content/common/utility_messages.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/utility_process_host.h"
+#include "ipc/ipc_message_macros.h"
+
+namespace content {
+
+InputModelTrainerHost::InputModelTrainerHost(
+    const ModelTrainedCallback& callback)
+    : training_(false), callback_(callback) {}
+
+InputModelTrainerHost::~InputModelTrainerHost() {}
+
+void InputModelTrainerHost::AddFeedback(double speed, int frame_rate) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  trainer_.AddSample(speed, frame_rate);
+  MaybeStartTraining();
+}
+
+void InputModelTrainerHost::Shutdown() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  callback_.Reset();
+}
+
+void InputModelTrainerHost::MaybeStartTraining() {
+  if (training_ || callback_.is_null() || !trainer_.ShouldTrain())
+    return;
+  training_ = true;
+  uint64_t first_sample_id = 0;
+  ui::SvrTrainingSet training_set = trainer_.GetTrainingSet(&first_sample_id);
+  TRACE_EVENT_ASYNC_BEGIN1("input", "InputModelTrainerHost::Train", this,
+                           "samples",
+                           static_cast<int>(training_set.speeds.size()));
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&InputModelTrainerHost::StartTrainingOnIOThread, this,
+                 first_sample_id, training_set));
+}
+
+void InputModelTrainerHost::StartTrainingOnIOThread(
+    uint64_t first_sample_id,
+    const ui::SvrTrainingSet& training_set) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  // The host deletes itself when the process exits after replying.
+  UtilityProcessHost* host = UtilityProcessHost::Create(
+      this, BrowserThread::GetTaskRunnerForThread(BrowserThread::UI).get());
+  host->SetName(base::ASCIIToUTF16("Input model trainer"));
+  host->Send(new UtilityMsg_TrainInputModel(first_sample_id, training_set));
+}
+
+void InputModelTrainerHost::OnProcessCrashed(int exit_code) {
+  OnInputModelTrainingFailed(0);
+}
+
+void InputModelTrainerHost::OnProcessLaunchFailed(int error_code) {
+  OnInputModelTrainingFailed(0);
+}
+
+bool InputModelTrainerHost::OnMessageReceived(const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(InputModelTrainerHost, message)
+    IPC_MESSAGE_HANDLER(UtilityHostMsg_InputModelTrained, OnInputModelTrained)
+    IPC_MESSAGE_HANDLER(UtilityHostMsg_InputModelTrainingFailed,
+                        OnInputModelTrainingFailed)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+void InputModelTrainerHost::OnInputModelTrained(
+    uint64_t first_sample_id,
+    const std::string& model,
+    const std::vector<double>& coefs) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  TRACE_EVENT_ASYNC_END0("input", "InputModelTrainerHost::Train", this);
+  training_ = false;
+  trainer_.DidTrain(first_sample_id, coefs);
+  if (!callback_.is_null())
+    callback_.Run(model);
+  MaybeStartTraining();
+}
+
+void InputModelTrainerHost::OnInputModelTrainingFailed(
+    uint64_t first_sample_id) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!training_)
+    return;
+  TRACE_EVENT_ASYNC_END0("input", "InputModelTrainerHost::Train", this);
+  // The window is kept, so the next feedback retries with it.
+  training_ = false;
+}
+
+}  // namespace content
@@ -0,0 +1,71 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_ANDROID_INPUT_MODEL_TRAINER_HOST_H_
+#define CONTENT_BROWSER_ANDROID_INPUT_MODEL_TRAINER_HOST_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "content/public/browser/utility_process_host_client.h"
+#include "ui/events/blink/incremental_svr_trainer.h"
+
+namespace content {
+
+// Personalizes the scroll model on the device. Collects the frame rates the
+// user settles on for their scrolls and, every
+// ui::IncrementalSvrTrainer::kSamplesPerTraining of them, retrains the model
+// in a utility process, warm started from the previous solution, so feedback
+// takes effect within seconds and without a network. The feedback window and
+// the solution live here; each utility process trains once and exits.
+//
+// Lives on the UI thread, apart from starting the utility process.
+class InputModelTrainerHost : public UtilityProcessHostClient {
+ public:
+  // Receives each trained model, in the libsvm text format.
+  using ModelTrainedCallback = base::Callback<void(const std::string& model)>;
+
+  explicit InputModelTrainerHost(const ModelTrainedCallback& callback);
+
+  // Records that the user asked for |frame_rate| after a scroll at |speed|,
+  // in the units of the cloud trainer's /save endpoint.
+  void AddFeedback(double speed, int frame_rate);
+
+  // Stops reporting models. Trainings still running are discarded.
+  void Shutdown();
+
+  // UtilityProcessHostClient implementation.
+  void OnProcessCrashed(int exit_code) override;
+  void OnProcessLaunchFailed(int error_code) override;
+  bool OnMessageReceived(const IPC::Message& message) override;
+
+ private:
+  ~InputModelTrainerHost() override;
+
+  void MaybeStartTraining();
+  void StartTrainingOnIOThread(uint64_t first_sample_id,
+                               const ui::SvrTrainingSet& training_set);
+
+  // Utility process message handlers.
+  void OnInputModelTrained(uint64_t first_sample_id,
+                           const std::string& model,
+                           const std::vector<double>& coefs);
+  void OnInputModelTrainingFailed(uint64_t first_sample_id);
+
+  ui::IncrementalSvrTrainer trainer_;
+  // True while a utility process is training. One training runs at a time;
+  // feedback that arrives meanwhile goes into the next one.
+  bool training_;
+  ModelTrainedCallback callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputModelTrainerHost);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_ANDROID_INPUT_MODEL_TRAINER_HOST_H_
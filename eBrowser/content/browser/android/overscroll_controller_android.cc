@@ -221,6 +221,11 @@ void OverscrollControllerAndroid::OnOverscrolled(
   }
 }
 
+void OverscrollControllerAndroid::SetTargetFrameRate(int fps) {
+  if (glow_effect_)
+    glow_effect_->SetTargetFrameRate(fps);
+}
+
 bool OverscrollControllerAndroid::Animate(base::TimeTicks current_time,
                                           cc::Layer* parent_layer) {
   DCHECK(parent_layer);
@@ -52,6 +52,9 @@ class OverscrollControllerAndroid : public ui::OverscrollGlowClient {
   // To be called upon receipt of an overscroll event.
   void OnOverscrolled(const ui::DidOverscrollParams& overscroll_params);
 
+  // The rate the interaction is paced at, or 0, for the glow to animate at.
+  void SetTargetFrameRate(int fps);
+
   // Returns true if the effect still needs animation ticks.
   // Note: The effect will detach itself when no further animation is required.
   bool Animate(base::TimeTicks current_time, cc::Layer* parent_layer);
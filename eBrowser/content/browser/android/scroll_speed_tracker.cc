@@ -0,0 +1,46 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/android/scroll_speed_tracker.h"
+
+#include <cmath>
+
+namespace content {
+
+namespace {
+
+const int64_t kMaxScrollGapMs = 1000;
+
+}  // namespace
+
+ScrollSpeedTracker::ScrollSpeedTracker() : last_offset_y_(0) {
+  Reset();
+}
+
+ScrollSpeedTracker::~ScrollSpeedTracker() {}
+
+void ScrollSpeedTracker::OnScrollOffset(base::TimeTicks time,
+                                        float offset_y) {
+  if (!last_time_.is_null() && offset_y == last_offset_y_)
+    return;
+  base::TimeDelta elapsed = time - last_time_;
+  if (last_time_.is_null() || elapsed.InMilliseconds() > kMaxScrollGapMs) {
+    Reset();
+  } else if (elapsed > base::TimeDelta()) {
+    total_speed_ += static_cast<int64_t>(
+        std::abs(offset_y - last_offset_y_) / elapsed.InSecondsF());
+    ++sample_count_;
+    average_speed_ = total_speed_ / sample_count_;
+  }
+  last_time_ = time;
+  last_offset_y_ = offset_y;
+}
+
+void ScrollSpeedTracker::Reset() {
+  total_speed_ = 0;
+  sample_count_ = 0;
+  average_speed_ = 0;
+}
+
+}  // namespace content
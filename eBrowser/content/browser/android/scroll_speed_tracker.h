@@ -0,0 +1,47 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_ANDROID_SCROLL_SPEED_TRACKER_H_
+#define CONTENT_BROWSER_ANDROID_SCROLL_SPEED_TRACKER_H_
+
+#include <stdint.h>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+// Average vertical speed of the current scroll, from the root scroll offsets
+// in the frame metadata. This is the speed the user rates when giving
+// feedback on a scroll, so it is in physical pixels per second, the units the
+// feedback has always been sent in. Samples more than a second apart start a
+// new scroll.
+class CONTENT_EXPORT ScrollSpeedTracker {
+ public:
+  ScrollSpeedTracker();
+  ~ScrollSpeedTracker();
+
+  // |offset_y| is the root scroll offset, in physical pixels.
+  void OnScrollOffset(base::TimeTicks time, float offset_y);
+
+  // Forgets the current scroll, e.g. once feedback has been given on it.
+  void Reset();
+
+  // In physical pixels per second; 0 until the scroll has moved twice.
+  int64_t average_speed() const { return average_speed_; }
+
+ private:
+  base::TimeTicks last_time_;
+  float last_offset_y_;
+  int64_t total_speed_;
+  int64_t sample_count_;
+  int64_t average_speed_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScrollSpeedTracker);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_ANDROID_SCROLL_SPEED_TRACKER_H_
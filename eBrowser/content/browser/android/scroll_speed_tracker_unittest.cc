@@ -0,0 +1,60 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/android/scroll_speed_tracker.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+base::TimeTicks MillisecondsToTicks(int64_t ms) {
+  return base::TimeTicks() + base::TimeDelta::FromMilliseconds(ms);
+}
+
+}  // namespace
+
+TEST(ScrollSpeedTrackerTest, AveragesSpeedOverTheScroll) {
+  ScrollSpeedTracker tracker;
+  EXPECT_EQ(0, tracker.average_speed());
+
+  tracker.OnScrollOffset(MillisecondsToTicks(1000), 0);
+  EXPECT_EQ(0, tracker.average_speed());
+  // 100px in 100ms, then 50px back up in 100ms.
+  tracker.OnScrollOffset(MillisecondsToTicks(1100), 100);
+  EXPECT_EQ(1000, tracker.average_speed());
+  tracker.OnScrollOffset(MillisecondsToTicks(1200), 50);
+  EXPECT_EQ(750, tracker.average_speed());
+
+  // Frames that do not move the page are not samples.
+  tracker.OnScrollOffset(MillisecondsToTicks(1300), 50);
+  EXPECT_EQ(750, tracker.average_speed());
+}
+
+TEST(ScrollSpeedTrackerTest, PausesStartANewScroll) {
+  ScrollSpeedTracker tracker;
+  tracker.OnScrollOffset(MillisecondsToTicks(1000), 0);
+  tracker.OnScrollOffset(MillisecondsToTicks(1100), 100);
+  EXPECT_EQ(1000, tracker.average_speed());
+
+  tracker.OnScrollOffset(MillisecondsToTicks(2200), 110);
+  EXPECT_EQ(0, tracker.average_speed());
+  tracker.OnScrollOffset(MillisecondsToTicks(2300), 130);
+  EXPECT_EQ(200, tracker.average_speed());
+}
+
+TEST(ScrollSpeedTrackerTest, Reset) {
+  ScrollSpeedTracker tracker;
+  tracker.OnScrollOffset(MillisecondsToTicks(1000), 0);
+  tracker.OnScrollOffset(MillisecondsToTicks(1100), 100);
+  tracker.Reset();
+  EXPECT_EQ(0, tracker.average_speed());
+
+  // The scroll goes on from where it was.
+  tracker.OnScrollOffset(MillisecondsToTicks(1200), 120);
+  EXPECT_EQ(200, tracker.average_speed());
+}
+
+}  // namespace content
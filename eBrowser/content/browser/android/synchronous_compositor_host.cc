@@ -27,6 +27,7 @@
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "ui/events/blink/did_overscroll_params.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 #include "ui/gfx/skia_util.h"
 
 namespace content {
@@ -74,6 +75,7 @@ SynchronousCompositorHost::SynchronousCompositorHost(
       sender_(rwhva_->GetRenderWidgetHost()),
       use_in_process_zero_copy_software_draw_(use_in_proc_software_draw),
       bytes_limit_(0u),
+      target_frame_rate_(0),
       renderer_param_version_(0u),
       need_animate_scroll_(false),
       need_invalidate_count_(0u),
@@ -112,6 +114,21 @@ SynchronousCompositor::Frame SynchronousCompositorHost::DemandDrawHw(
     const gfx::Size& viewport_size,
     const gfx::Rect& viewport_rect_for_tile_priority,
     const gfx::Transform& transform_for_tile_priority) {
+  // The embedder draws on its own vsync. A frame the interaction does not
+  // need is not asked of the renderer; the embedder is invalidated instead so
+  // that the frame ending the interaction still gets drawn.
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (target_frame_rate_ &&
+      !ui::ScrollUpdatePacer::IsFrameDue(last_draw_hw_time_, now,
+                                         target_frame_rate_)) {
+    TRACE_EVENT_INSTANT1("browser", "SynchronousCompositorHost::SkipDrawHw",
+                         TRACE_EVENT_SCOPE_THREAD, "target_fps",
+                         target_frame_rate_);
+    client_->PostInvalidate(this);
+    return SynchronousCompositor::Frame();
+  }
+  last_draw_hw_time_ = now;
+
   SyncCompositorDemandDrawHwParams params(viewport_size,
                                           viewport_rect_for_tile_priority,
                                           transform_for_tile_priority);
@@ -390,6 +407,10 @@ void SynchronousCompositorHost::DidSendBeginFrame(
   rph_observer_->SyncStateAfterVSync(window_android, this);
 }
 
+void SynchronousCompositorHost::SetTargetFrameRate(int fps) {
+  target_frame_rate_ = fps;
+}
+
 void SynchronousCompositorHost::CompositorFrameSinkCreated() {
   // New CompositorFrameSink is not aware of state from Browser side. So need to
   // re-send all browser side state here.
@@ -14,6 +14,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "cc/output/compositor_frame.h"
 #include "content/common/input/input_event_ack_state.h"
 #include "content/public/browser/android/synchronous_compositor.h"
@@ -74,6 +75,10 @@ class SynchronousCompositorHost : public SynchronousCompositor {
 
   void DidOverscroll(const ui::DidOverscrollParams& over_scroll_params);
   void DidSendBeginFrame(ui::WindowAndroid* window_android);
+  // Skips synchronous hardware draws that come sooner than one interval of
+  // |fps| after the last one, or none if zero. The embedder keeps showing its
+  // last frame for a skipped draw.
+  void SetTargetFrameRate(int fps);
   bool OnMessageReceived(const IPC::Message& message);
 
   // Called by SynchronousCompositorObserver.
@@ -113,6 +118,9 @@ class SynchronousCompositorHost : public SynchronousCompositor {
   size_t bytes_limit_;
   std::unique_ptr<SharedMemoryWithSize> software_draw_shm_;
 
+  int target_frame_rate_;
+  base::TimeTicks last_draw_hw_time_;
+
   // Updated by both renderer and browser.
   gfx::ScrollOffset root_scroll_offset_;
 
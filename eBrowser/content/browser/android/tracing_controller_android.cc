@@ -57,11 +57,15 @@ void TracingControllerAndroid::StopTracing(
     const JavaParamRef<jstring>& jfilepath) {
   base::FilePath file_path(
       base::android::ConvertJavaStringToUTF8(env, jfilepath));
-  if (!TracingController::GetInstance()->StopTracing(
-          TracingController::CreateFileSink(
-              file_path,
-              base::Bind(&TracingControllerAndroid::OnTracingStopped,
-                         weak_factory_.GetWeakPtr())))) {
+  base::Closure callback = base::Bind(
+      &TracingControllerAndroid::OnTracingStopped, weak_factory_.GetWeakPtr());
+  // Long field traces are asked for with a .gz path, and streamed to it
+  // compressed rather than written out as JSON.
+  scoped_refptr<TracingController::TraceDataSink> sink =
+      file_path.MatchesExtension(FILE_PATH_LITERAL(".gz"))
+          ? TracingController::CreateCompressedFileSink(file_path, callback)
+          : TracingController::CreateFileSink(file_path, callback);
+  if (!TracingController::GetInstance()->StopTracing(sink)) {
     LOG(ERROR) << "EndTracingAsync failed, forcing an immediate stop";
     OnTracingStopped();
   }
@@ -164,6 +164,7 @@ enum BadMessageReason {
   ARH_CREATED_STREAM_WITHOUT_AUTHORIZATION = 140,
   MDDH_INVALID_DEVICE_TYPE_REQUEST = 141,
   MDDH_UNAUTHORIZED_ORIGIN = 142,
+  RWH_BAD_TEXT_INPUT_CHANGE = 143,
 
   // Please add new elements here. The naming convention is abbreviated class
   // name (e.g. RenderFrameHost becomes RFH) plus a unique description of the
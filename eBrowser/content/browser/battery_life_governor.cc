@@ -0,0 +1,84 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/battery_life_governor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/strings/string_number_conversions.h"
+
+namespace content {
+
+namespace {
+
+// Battery levels move in whole percents, so shorter discharges say little
+// about the rate.
+const int kMinDischargeMinutes = 10;
+
+// Below this share of the full rate's power, gestures would run at the
+// controller's floor anyway.
+const double kMinFullRateFraction = 0.2;
+
+// Smaller changes are not worth a message to every renderer.
+const double kMinFractionChange = 0.05;
+
+}  // namespace
+
+BatteryLifeGovernor::BatteryLifeGovernor(base::TimeDelta target)
+    : target_(target), discharge_start_level_(0), full_rate_fraction_(0) {}
+
+BatteryLifeGovernor::~BatteryLifeGovernor() {}
+
+// static
+bool BatteryLifeGovernor::ParseTarget(const std::string& hours,
+                                      base::TimeDelta* target) {
+  double value;
+  if (!base::StringToDouble(hours, &value) || !(value > 0))
+    return false;
+  *target = base::TimeDelta::FromSecondsD(value * 3600);
+  return true;
+}
+
+bool BatteryLifeGovernor::OnBatteryStatus(bool on_battery_power,
+                                          double level,
+                                          base::Time now) {
+  if (!on_battery_power) {
+    discharge_start_time_ = base::Time();
+    return SetFullRateFraction(0);
+  }
+  if (discharge_start_time_.is_null()) {
+    discharge_start_time_ = now;
+    discharge_start_level_ = level;
+    return SetFullRateFraction(0);
+  }
+
+  base::TimeDelta elapsed = now - discharge_start_time_;
+  base::TimeDelta remaining = discharge_start_time_ + target_ - now;
+  double drained = discharge_start_level_ - level;
+  if (elapsed < base::TimeDelta::FromMinutes(kMinDischargeMinutes) ||
+      drained <= 0 || remaining <= base::TimeDelta()) {
+    return SetFullRateFraction(0);
+  }
+
+  // Levels per second; the units cancel out.
+  double drain_rate = drained / elapsed.InSecondsF();
+  double allowed_rate = level / remaining.InSecondsF();
+  double fraction = allowed_rate / drain_rate;
+  return SetFullRateFraction(
+      fraction >= 1 ? 0 : std::max(fraction, kMinFullRateFraction));
+}
+
+bool BatteryLifeGovernor::SetFullRateFraction(double fraction) {
+  // Setting or clearing the budget always counts.
+  if (fraction == full_rate_fraction_ ||
+      (fraction > 0 && full_rate_fraction_ > 0 &&
+       std::abs(fraction - full_rate_fraction_) < kMinFractionChange)) {
+    return false;
+  }
+  full_rate_fraction_ = fraction;
+  return true;
+}
+
+}  // namespace content
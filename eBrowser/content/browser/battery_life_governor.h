@@ -0,0 +1,56 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_BATTERY_LIFE_GOVERNOR_H_
+#define CONTENT_BROWSER_BATTERY_LIFE_GOVERNOR_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+// Turns "the battery must last N hours after unplugging" into the share of
+// the full frame rate's power that paced gestures may draw, for
+// ui::EnergyBudget::full_rate_fraction: the rate the remaining charge may
+// drain at to last until the target, over the rate it has drained at since
+// the unplug. Gestures are only part of the drain, so the share is a
+// proportional correction rather than an exact budget, applied again with
+// every battery update. There is no budget, a zero share, on wall power,
+// before enough of the discharge has been seen, or while the battery is on
+// course for the target.
+class CONTENT_EXPORT BatteryLifeGovernor {
+ public:
+  explicit BatteryLifeGovernor(base::TimeDelta target);
+  ~BatteryLifeGovernor();
+
+  // Parses a --ebrowser-battery-life-target value, in hours. Returns false
+  // unless it is positive.
+  static bool ParseTarget(const std::string& hours, base::TimeDelta* target);
+
+  // |level| is in [0, 1]. Returns true if full_rate_fraction() changed by
+  // enough to be worth sending to renderers.
+  bool OnBatteryStatus(bool on_battery_power, double level, base::Time now);
+
+  double full_rate_fraction() const { return full_rate_fraction_; }
+
+ private:
+  bool SetFullRateFraction(double fraction);
+
+  const base::TimeDelta target_;
+
+  // Null while on wall power.
+  base::Time discharge_start_time_;
+  double discharge_start_level_;
+
+  double full_rate_fraction_;
+
+  DISALLOW_COPY_AND_ASSIGN(BatteryLifeGovernor);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_BATTERY_LIFE_GOVERNOR_H_
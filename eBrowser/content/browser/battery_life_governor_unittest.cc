@@ -0,0 +1,73 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/battery_life_governor.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+base::TimeDelta Hours(double hours) {
+  return base::TimeDelta::FromSecondsD(hours * 3600);
+}
+
+}  // namespace
+
+TEST(BatteryLifeGovernorTest, ParseTarget) {
+  base::TimeDelta target;
+  EXPECT_TRUE(BatteryLifeGovernor::ParseTarget("8", &target));
+  EXPECT_EQ(Hours(8), target);
+  EXPECT_TRUE(BatteryLifeGovernor::ParseTarget("1.5", &target));
+  EXPECT_EQ(Hours(1.5), target);
+
+  EXPECT_FALSE(BatteryLifeGovernor::ParseTarget("", &target));
+  EXPECT_FALSE(BatteryLifeGovernor::ParseTarget("0", &target));
+  EXPECT_FALSE(BatteryLifeGovernor::ParseTarget("-2", &target));
+  EXPECT_FALSE(BatteryLifeGovernor::ParseTarget("long", &target));
+}
+
+TEST(BatteryLifeGovernorTest, BudgetsOnlyWhenDrainingTooFast) {
+  BatteryLifeGovernor governor(Hours(10));
+  base::Time start = base::Time::FromInternalValue(1000);
+  EXPECT_FALSE(governor.OnBatteryStatus(true, 1.0, start));
+  EXPECT_EQ(0, governor.full_rate_fraction());
+  // Too early to tell.
+  EXPECT_FALSE(governor.OnBatteryStatus(true, 0.9, start + Hours(0.1)));
+
+  // 10% an hour lasts exactly the target.
+  EXPECT_FALSE(governor.OnBatteryStatus(true, 0.9, start + Hours(1)));
+  EXPECT_EQ(0, governor.full_rate_fraction());
+
+  // 20% an hour: the remaining 60% may only drain at 7.5% an hour.
+  EXPECT_TRUE(governor.OnBatteryStatus(true, 0.6, start + Hours(2)));
+  EXPECT_DOUBLE_EQ(0.375, governor.full_rate_fraction());
+  // Small corrections are not resent.
+  EXPECT_FALSE(governor.OnBatteryStatus(true, 0.59, start + Hours(2)));
+  EXPECT_DOUBLE_EQ(0.375, governor.full_rate_fraction());
+
+  // Far behind the target, the share bottoms out.
+  EXPECT_TRUE(governor.OnBatteryStatus(true, 0.1, start + Hours(3)));
+  EXPECT_DOUBLE_EQ(0.2, governor.full_rate_fraction());
+
+  // Charging clears the budget, and the next unplug starts afresh.
+  EXPECT_TRUE(governor.OnBatteryStatus(false, 0.1, start + Hours(4)));
+  EXPECT_EQ(0, governor.full_rate_fraction());
+  EXPECT_FALSE(governor.OnBatteryStatus(true, 0.5, start + Hours(5)));
+  EXPECT_FALSE(governor.OnBatteryStatus(true, 0.46, start + Hours(6)));
+  EXPECT_EQ(0, governor.full_rate_fraction());
+}
+
+TEST(BatteryLifeGovernorTest, NoBudgetPastTheTarget) {
+  BatteryLifeGovernor governor(Hours(2));
+  base::Time start = base::Time::FromInternalValue(1000);
+  governor.OnBatteryStatus(true, 1.0, start);
+  EXPECT_TRUE(governor.OnBatteryStatus(true, 0.3, start + Hours(1)));
+  EXPECT_LT(0, governor.full_rate_fraction());
+  EXPECT_TRUE(governor.OnBatteryStatus(true, 0.2, start + Hours(2)));
+  EXPECT_EQ(0, governor.full_rate_fraction());
+}
+
+}  // namespace content
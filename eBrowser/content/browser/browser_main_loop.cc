@@ -63,6 +63,7 @@
 #include "content/browser/service_manager/service_manager_context.h"
 #include "content/browser/speech/speech_recognition_manager_impl.h"
 #include "content/browser/startup_task_runner.h"
+#include "content/browser/subprocess_histogram_merger.h"
 #include "content/browser/utility_process_host_impl.h"
 #include "content/browser/webui/content_web_ui_controller_factory.h"
 #include "content/browser/webui/url_data_manager.h"
@@ -634,6 +635,15 @@ void BrowserMainLoop::PostMainMessageLoopStart() {
   if (!parsed_command_line_.HasSwitch(switches::kSingleProcess)) {
     base::DiscardableMemoryAllocator::SetInstance(
         HostDiscardableSharedMemoryManager::current());
+
+    unsigned battery_limit_mb = 0;
+    if (base::StringToUint(
+            parsed_command_line_.GetSwitchValueASCII(
+                switches::kEBrowserBatteryDiscardableMemoryLimit),
+            &battery_limit_mb)) {
+      HostDiscardableSharedMemoryManager::current()->SetBatteryMemoryLimit(
+          static_cast<size_t>(battery_limit_mb) * 1024 * 1024);
+    }
   }
 
   if (parts_)
@@ -713,6 +723,14 @@ void BrowserMainLoop::PostMainMessageLoopStart() {
     base::MessageLoop::current()->AddTaskObserver(memory_observer_.get());
   }
 
+  if (parsed_command_line_.HasSwitch(
+          switches::kEBrowserSharedChildHistograms)) {
+    TRACE_EVENT0("startup",
+                 "BrowserMainLoop::Subsystem:SubprocessHistogramMerger");
+    SubprocessHistogramMerger::CreateGlobalHistogramAllocator();
+    subprocess_histogram_merger_.reset(new SubprocessHistogramMerger());
+  }
+
   if (parsed_command_line_.HasSwitch(
           switches::kEnableAggressiveDOMStorageFlushing)) {
     TRACE_EVENT0("startup",
@@ -720,6 +738,17 @@ void BrowserMainLoop::PostMainMessageLoopStart() {
     DOMStorageArea::EnableAggressiveCommitDelay();
   }
 
+  if (parsed_command_line_.HasSwitch(
+          switches::kEBrowserBatteryStorageCommits)) {
+    std::string spec = parsed_command_line_.GetSwitchValueASCII(
+        switches::kEBrowserBatteryStorageCommits);
+    DOMStorageArea::BatteryCommitPolicy policy;
+    if (DOMStorageArea::ParseBatteryCommitPolicy(spec, &policy))
+      DOMStorageArea::EnableBatteryCommitBatching(policy);
+    else
+      LOG(ERROR) << "Invalid battery storage commit policy: " << spec;
+  }
+
   // Enable memory-infra dump providers.
   InitSkiaEventTracer();
   tracing::ProcessMetricsMemoryDumpProvider::RegisterForProcess(
@@ -813,21 +842,26 @@ void BrowserMainLoop::CreateStartupTasks() {
     startup_task_runner_ = base::MakeUnique<StartupTaskRunner>(
         base::Callback<void(int)>(), base::ThreadTaskRunnerHandle::Get());
 #endif
+    startup_task_runner_->set_record_task_timings(
+        parsed_command_line_.HasSwitch(switches::kEBrowserStartupTimings));
+
     StartupTask pre_create_threads =
         base::Bind(&BrowserMainLoop::PreCreateThreads, base::Unretained(this));
-    startup_task_runner_->AddTask(pre_create_threads);
+    startup_task_runner_->AddTask("PreCreateThreads", pre_create_threads);
 
     StartupTask create_threads =
         base::Bind(&BrowserMainLoop::CreateThreads, base::Unretained(this));
-    startup_task_runner_->AddTask(create_threads);
+    startup_task_runner_->AddTask("CreateThreads", create_threads);
 
     StartupTask browser_thread_started = base::Bind(
         &BrowserMainLoop::BrowserThreadsStarted, base::Unretained(this));
-    startup_task_runner_->AddTask(browser_thread_started);
+    startup_task_runner_->AddTask("BrowserThreadsStarted",
+                                  browser_thread_started);
 
     StartupTask pre_main_message_loop_run = base::Bind(
         &BrowserMainLoop::PreMainMessageLoopRun, base::Unretained(this));
-    startup_task_runner_->AddTask(pre_main_message_loop_run);
+    startup_task_runner_->AddTask("PreMainMessageLoopRun",
+                                  pre_main_message_loop_run);
 
 #if defined(OS_ANDROID)
     if (BrowserMayStartAsynchronously()) {
@@ -1013,6 +1047,7 @@ void BrowserMainLoop::ShutdownThreadsAndCleanUp() {
 #endif
 
   system_stats_monitor_.reset();
+  subprocess_histogram_merger_.reset();
 
   // Destroying the GpuProcessHostUIShims on the UI thread posts a task to
   // delete related objects on the GPU thread. This must be done before
@@ -1274,6 +1309,14 @@ int BrowserMainLoop::BrowserThreadsStarted() {
       nullptr);
 #endif
 
+  // With --ebrowser-parallel-startup, the GPU process is launched now rather
+  // than at the end of this task, so that it starts up while the remaining
+  // browser subsystems are created.
+  bool launch_gpu_process_early =
+      parsed_command_line_.HasSwitch(switches::kEBrowserParallelStartup);
+  if (launch_gpu_process_early)
+    MaybeLaunchGpuProcess(established_gpu_channel, always_uses_gpu);
+
   {
     TRACE_EVENT0("startup", "BrowserThreadsStarted::Subsystem:AudioMan");
     CreateAudioManager();
@@ -1357,6 +1400,23 @@ int BrowserMainLoop::BrowserThreadsStarted() {
 #endif
   ui::Clipboard::SetAllowedThreads(allowed_clipboard_threads);
 
+  if (!launch_gpu_process_early)
+    MaybeLaunchGpuProcess(established_gpu_channel, always_uses_gpu);
+
+#if defined(OS_MACOSX)
+  ThemeHelperMac::GetInstance();
+  SystemHotkeyHelperMac::GetInstance()->DeferredLoadSystemHotkeys();
+#endif  // defined(OS_MACOSX)
+
+#if defined(OS_ANDROID)
+  media::SetMediaClientAndroid(GetContentClient()->GetMediaClientAndroid());
+#endif
+
+  return result_code_;
+}
+
+void BrowserMainLoop::MaybeLaunchGpuProcess(bool established_gpu_channel,
+                                            bool always_uses_gpu) {
   // When running the GPU thread in-process, avoid optimistically starting it
   // since creating the GPU thread races against creation of the one-and-only
   // ChildProcess instance which is created by the renderer thread.
@@ -1371,17 +1431,6 @@ int BrowserMainLoop::BrowserThreadsStarted() {
                    GpuProcessHost::GPU_PROCESS_KIND_SANDBOXED,
                    true /* force_create */));
   }
-
-#if defined(OS_MACOSX)
-  ThemeHelperMac::GetInstance();
-  SystemHotkeyHelperMac::GetInstance()->DeferredLoadSystemHotkeys();
-#endif  // defined(OS_MACOSX)
-
-#if defined(OS_ANDROID)
-  media::SetMediaClientAndroid(GetContentClient()->GetMediaClientAndroid());
-#endif
-
-  return result_code_;
 }
 
 bool BrowserMainLoop::UsingInProcessGpu() const {
@@ -82,6 +82,7 @@ class SaveFileManager;
 class ServiceManagerContext;
 class SpeechRecognitionManagerImpl;
 class StartupTaskRunner;
+class SubprocessHistogramMerger;
 struct MainFunctionParams;
 
 #if defined(OS_ANDROID)
@@ -188,6 +189,10 @@ class CONTENT_EXPORT BrowserMainLoop {
   void EndStartupTracing();
 
   void CreateAudioManager();
+  // Posts a task to launch the GPU process unless it runs in-process or a
+  // channel is established later on demand.
+  void MaybeLaunchGpuProcess(bool established_gpu_channel,
+                             bool always_uses_gpu);
   bool UsingInProcessGpu() const;
 
   void InitializeMemoryManagementComponent();
@@ -244,6 +249,7 @@ class CONTENT_EXPORT BrowserMainLoop {
 #endif
 
   std::unique_ptr<MemoryObserver> memory_observer_;
+  std::unique_ptr<SubprocessHistogramMerger> subprocess_histogram_merger_;
 
   // Members initialized in |InitStartupTracingForDuration()| ------------------
   base::FilePath startup_trace_file_;
@@ -14,12 +14,16 @@
 #include "base/barrier_closure.h"
 #include "base/bind_helpers.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/guid.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/stl_util.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "base/task_runner_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/browser/cache_storage/cache_storage.pb.h"
 #include "content/browser/cache_storage/cache_storage_blob_to_disk_cache.h"
@@ -71,6 +75,9 @@ typedef base::Callback<void(std::unique_ptr<CacheMetadata>)> MetadataCallback;
 // is controlled per-origin by the QuotaManager.
 const int kMaxCacheBytes = std::numeric_limits<int>::max();
 
+// A CacheUrlIndex in the cache's directory, next to the backend's files.
+const char kUrlIndexFileName[] = "url_index";
+
 blink::WebServiceWorkerResponseType ProtoResponseTypeToWebResponseType(
     CacheResponse::ResponseType response_type) {
   switch (response_type) {
@@ -174,6 +181,31 @@ void ReadMetadata(disk_cache::Entry* entry, const MetadataCallback& callback) {
     read_header_callback.Run(read_rv);
 }
 
+// Runs on the CACHE thread. The index is deleted as it is read, so that an
+// exit without closing the cache cannot leave one missing later entries.
+std::string ReadAndDeleteUrlIndexInPool(const base::FilePath& cache_path) {
+  base::FilePath index_path = cache_path.AppendASCII(kUrlIndexFileName);
+  std::string serialized;
+  base::ReadFileToString(index_path, &serialized);
+  base::DeleteFile(index_path, false /* recursive */);
+  return serialized;
+}
+
+// Runs on the CACHE thread.
+void WriteUrlIndexInPool(const base::FilePath& cache_path,
+                         const std::string& serialized) {
+  base::FilePath tmp_path =
+      cache_path.AppendASCII(std::string(kUrlIndexFileName) + ".tmp");
+  int bytes_written =
+      base::WriteFile(tmp_path, serialized.c_str(), serialized.size());
+  if (bytes_written != base::checked_cast<int>(serialized.size())) {
+    base::DeleteFile(tmp_path, false /* recursive */);
+    return;
+  }
+  base::ReplaceFile(tmp_path, cache_path.AppendASCII(kUrlIndexFileName),
+                    NULL);
+}
+
 void ReadMetadataDidReadMetadata(disk_cache::Entry* entry,
                                  const MetadataCallback& callback,
                                  scoped_refptr<net::IOBufferWithSize> buffer,
@@ -247,6 +279,13 @@ struct CacheStorageCache::QueryCacheContext {
   std::unique_ptr<disk_cache::Backend::Iterator> backend_iterator;
   disk_cache::Entry* enumerated_entry = nullptr;
 
+  // The keys to open instead of iterating, if the index picked them.
+  std::unique_ptr<std::vector<std::string>> index_keys;
+  size_t next_index_key = 0;
+
+  // The keys seen while iterating, to become the index once done.
+  std::unique_ptr<UrlIndex> scanned_keys;
+
   // Output of QueryCache
   std::unique_ptr<std::vector<QueryCacheResult>> matches;
 
@@ -498,6 +537,9 @@ void CacheStorageCache::GetSizeThenClose(const SizeCallback& callback) {
 }
 
 CacheStorageCache::~CacheStorageCache() {
+  // Caches are usually dropped without being closed.
+  if (backend_state_ == BACKEND_OPEN)
+    PersistUrlIndex();
   quota_manager_proxy_->NotifyOriginNoLongerInUse(origin_);
 }
 
@@ -552,6 +594,14 @@ void CacheStorageCache::QueryCache(
 
   if (query_cache_context->request &&
       !query_cache_context->request->url.is_empty() && !options.ignore_search) {
+    if (url_index_ &&
+        !base::ContainsKey(*url_index_, request_ptr->url.spec())) {
+      // No entry has the URL, so there is nothing to open.
+      query_cache_context->callback.Run(
+          CACHE_STORAGE_OK, std::move(query_cache_context->matches));
+      return;
+    }
+
     // There is no need to scan the entire backend, just open the exact
     // URL.
     disk_cache::Entry** entry_ptr = &query_cache_context->enumerated_entry;
@@ -566,6 +616,22 @@ void CacheStorageCache::QueryCache(
     return;
   }
 
+  if (url_index_ && query_cache_context->request &&
+      !query_cache_context->request->url.is_empty()) {
+    // Only open the entries whose URL matches but for the query.
+    GURL request_url = RemoveQueryParam(query_cache_context->request->url);
+    query_cache_context->index_keys =
+        base::MakeUnique<std::vector<std::string>>();
+    for (const std::string& key : *url_index_) {
+      if (RemoveQueryParam(GURL(key)) == request_url)
+        query_cache_context->index_keys->push_back(key);
+    }
+    QueryCacheOpenNextEntry(std::move(query_cache_context));
+    return;
+  }
+
+  if (!url_index_)
+    query_cache_context->scanned_keys = base::MakeUnique<UrlIndex>();
   query_cache_context->backend_iterator = backend_->CreateIterator();
   QueryCacheOpenNextEntry(std::move(query_cache_context));
 }
@@ -586,8 +652,28 @@ void CacheStorageCache::QueryCacheOpenNextEntry(
     std::unique_ptr<QueryCacheContext> query_cache_context) {
   DCHECK_EQ(nullptr, query_cache_context->enumerated_entry);
 
+  if (query_cache_context->index_keys &&
+      query_cache_context->next_index_key <
+          query_cache_context->index_keys->size()) {
+    std::string key =
+        (*query_cache_context->index_keys)[query_cache_context
+                                               ->next_index_key++];
+    disk_cache::Entry** entry_ptr = &query_cache_context->enumerated_entry;
+    net::CompletionCallback open_entry_callback =
+        base::Bind(&CacheStorageCache::QueryCacheDidOpenIndexedEntry,
+                   weak_ptr_factory_.GetWeakPtr(),
+                   base::Passed(std::move(query_cache_context)));
+    int rv = backend_->OpenEntry(key, entry_ptr, open_entry_callback);
+    if (rv != net::ERR_IO_PENDING)
+      open_entry_callback.Run(rv);
+    return;
+  }
+
   if (!query_cache_context->backend_iterator) {
     // Iteration is complete.
+    if (query_cache_context->scanned_keys)
+      url_index_ = std::move(query_cache_context->scanned_keys);
+
     std::sort(query_cache_context->matches->begin(),
               query_cache_context->matches->end(), QueryCacheResultCompare);
 
@@ -609,6 +695,17 @@ void CacheStorageCache::QueryCacheOpenNextEntry(
     open_entry_callback.Run(rv);
 }
 
+void CacheStorageCache::QueryCacheDidOpenIndexedEntry(
+    std::unique_ptr<QueryCacheContext> query_cache_context,
+    int rv) {
+  if (rv != net::OK) {
+    // The index can still hold the key of an entry that failed to write.
+    QueryCacheOpenNextEntry(std::move(query_cache_context));
+    return;
+  }
+  QueryCacheFilterEntry(std::move(query_cache_context), rv);
+}
+
 void CacheStorageCache::QueryCacheFilterEntry(
     std::unique_ptr<QueryCacheContext> query_cache_context,
     int rv) {
@@ -636,6 +733,9 @@ void CacheStorageCache::QueryCacheFilterEntry(
     return;
   }
 
+  if (query_cache_context->scanned_keys)
+    query_cache_context->scanned_keys->insert(entry->GetKey());
+
   if (query_cache_context->request &&
       !query_cache_context->request->url.is_empty()) {
     GURL requestURL = query_cache_context->request->url;
@@ -665,6 +765,8 @@ void CacheStorageCache::QueryCacheDidReadMetadata(
     disk_cache::ScopedEntryPtr entry,
     std::unique_ptr<CacheMetadata> metadata) {
   if (!metadata) {
+    if (url_index_)
+      url_index_->erase(entry->GetKey());
     entry->Doom();
     QueryCacheOpenNextEntry(std::move(query_cache_context));
     return;
@@ -1000,6 +1102,10 @@ void CacheStorageCache::PutImpl(std::unique_ptr<PutContext> put_context) {
   }
 
   std::string key = put_context->request->url.spec();
+  // Indexed before it is written, as the index may hold keys that have no
+  // entry but not the other way round.
+  if (url_index_)
+    url_index_->insert(key);
 
   net::CompletionCallback callback = base::Bind(
       &CacheStorageCache::PutDidDoomEntry, weak_ptr_factory_.GetWeakPtr(),
@@ -1241,6 +1347,8 @@ void CacheStorageCache::DeleteDidQueryCache(
 
   for (auto& result : *query_cache_results) {
     disk_cache::ScopedEntryPtr entry = std::move(result.entry);
+    if (url_index_)
+      url_index_->erase(entry->GetKey());
     entry->Doom();
   }
 
@@ -1283,6 +1391,8 @@ void CacheStorageCache::KeysDidQueryCache(
 void CacheStorageCache::CloseImpl(const base::Closure& callback) {
   DCHECK_NE(BACKEND_CLOSED, backend_state_);
 
+  if (backend_state_ == BACKEND_OPEN)
+    PersistUrlIndex();
   backend_state_ = BACKEND_CLOSED;
   backend_.reset();
   callback.Run();
@@ -1384,9 +1494,53 @@ void CacheStorageCache::InitGotCacheSize(const base::Closure& callback,
   UMA_HISTOGRAM_ENUMERATION("ServiceWorkerCache.InitBackendResult",
                             cache_create_error, CACHE_STORAGE_ERROR_LAST + 1);
 
+  if (backend_state_ != BACKEND_OPEN) {
+    callback.Run();
+    return;
+  }
+
+  if (memory_only_) {
+    url_index_ = base::MakeUnique<UrlIndex>();
+    callback.Run();
+    return;
+  }
+
+  PostTaskAndReplyWithResult(
+      BrowserThread::GetTaskRunnerForThread(BrowserThread::CACHE).get(),
+      FROM_HERE, base::Bind(&ReadAndDeleteUrlIndexInPool, path_),
+      base::Bind(&CacheStorageCache::InitDidReadUrlIndex,
+                 weak_ptr_factory_.GetWeakPtr(), callback));
+}
+
+void CacheStorageCache::InitDidReadUrlIndex(const base::Closure& callback,
+                                            const std::string& serialized) {
+  // An empty index is written as an empty file, which cannot be told from a
+  // missing one; scanning an empty cache to rebuild it is cheap.
+  CacheUrlIndex index;
+  if (!serialized.empty() && index.ParseFromString(serialized))
+    url_index_ = base::MakeUnique<UrlIndex>(index.key().begin(),
+                                            index.key().end());
+  UMA_HISTOGRAM_BOOLEAN("ServiceWorkerCache.Cache.UrlIndexLoaded",
+                        !!url_index_);
   callback.Run();
 }
 
+void CacheStorageCache::PersistUrlIndex() {
+  if (memory_only_ || !url_index_)
+    return;
+
+  CacheUrlIndex index;
+  for (const std::string& key : *url_index_)
+    index.add_key(key);
+  std::string serialized;
+  if (!index.SerializeToString(&serialized))
+    return;
+
+  BrowserThread::PostTask(
+      BrowserThread::CACHE, FROM_HERE,
+      base::Bind(&WriteUrlIndexInPool, path_, serialized));
+}
+
 void CacheStorageCache::PopulateRequestFromMetadata(
     const CacheMetadata& metadata,
     const GURL& request_url,
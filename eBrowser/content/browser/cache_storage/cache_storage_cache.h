@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "base/callback.h"
@@ -187,6 +188,8 @@ class CONTENT_EXPORT CacheStorageCache {
   using OpenAllEntriesCallback =
       base::Callback<void(std::unique_ptr<OpenAllEntriesContext>,
                           CacheStorageError)>;
+  // The keys (request URLs) of the backend's entries.
+  using UrlIndex = std::unordered_set<std::string>;
 
   CacheStorageCache(
       const GURL& origin,
@@ -218,6 +221,9 @@ class CONTENT_EXPORT CacheStorageCache {
       int rv);
   void QueryCacheOpenNextEntry(
       std::unique_ptr<QueryCacheContext> query_cache_context);
+  void QueryCacheDidOpenIndexedEntry(
+      std::unique_ptr<QueryCacheContext> query_cache_context,
+      int rv);
   void QueryCacheFilterEntry(
       std::unique_ptr<QueryCacheContext> query_cache_context,
       int rv);
@@ -355,6 +361,11 @@ class CONTENT_EXPORT CacheStorageCache {
   void InitGotCacheSize(const base::Closure& callback,
                         CacheStorageError cache_create_error,
                         int cache_size);
+  void InitDidReadUrlIndex(const base::Closure& callback,
+                           const std::string& serialized);
+
+  // Writes |url_index_| to the cache directory for the next open to load.
+  void PersistUrlIndex();
 
   void PopulateRequestFromMetadata(const CacheMetadata& metadata,
                                    const GURL& request_url,
@@ -387,6 +398,12 @@ class CONTENT_EXPORT CacheStorageCache {
   int64_t cache_size_ = 0;
   size_t max_query_size_bytes_;
 
+  // Every key in the backend, and possibly keys of entries that have since
+  // gone, or null until loaded. An empty memory backend starts with an empty
+  // index. A disk one loads the index persisted when it last closed, or else
+  // builds it on the first query that scans every entry.
+  std::unique_ptr<UrlIndex> url_index_;
+
   // Owns the elements of the list
   BlobToDiskCacheIDMap active_blob_to_disk_cache_writers_;
 
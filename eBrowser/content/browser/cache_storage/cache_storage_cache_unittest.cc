@@ -12,11 +12,13 @@
 #include <utility>
 
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/run_loop.h"
+#include "base/stl_util.h"
 #include "base/strings/string_split.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/browser/blob_storage/chrome_blob_storage_context.h"
@@ -671,6 +673,24 @@ class CacheStorageCacheTest : public testing::Test {
     cache_->max_query_size_bytes_ = max_bytes;
   }
 
+  bool HasUrlIndex() { return !!cache_->url_index_; }
+
+  bool IsUrlIndexed(const GURL& url) {
+    return cache_->url_index_ &&
+           base::ContainsKey(*cache_->url_index_, url.spec());
+  }
+
+  // Replaces |cache_| with a new one on the same directory.
+  void ReopenCache() {
+    cache_ = base::MakeUnique<TestCacheStorageCache>(
+        GURL(kOrigin), kCacheName, temp_dir_.GetPath(),
+        nullptr /* CacheStorage */,
+        BrowserContext::GetDefaultStoragePartition(&browser_context_)
+            ->GetURLRequestContext(),
+        quota_manager_proxy_, blob_storage_context_->AsWeakPtr());
+    cache_->Init();
+  }
+
  protected:
   base::ScopedTempDir temp_dir_;
   TestBrowserThreadBundle browser_thread_bundle_;
@@ -983,6 +1003,48 @@ TEST_P(CacheStorageCacheTestP, Match_IgnoreSearch) {
   EXPECT_TRUE(Match(body_request_, match_params));
 }
 
+TEST_P(CacheStorageCacheTestP, UrlIndex) {
+  EXPECT_TRUE(Put(body_request_, body_response_));
+  EXPECT_TRUE(Put(body_request_with_query_, body_response_with_query_));
+  // A disk cache without a persisted index builds one on its first scan.
+  EXPECT_EQ(MemoryOnly(), HasUrlIndex());
+  EXPECT_TRUE(Keys());
+  EXPECT_TRUE(IsUrlIndexed(body_request_.url));
+  EXPECT_TRUE(IsUrlIndexed(body_request_with_query_.url));
+
+  EXPECT_TRUE(Delete(body_request_));
+  EXPECT_FALSE(IsUrlIndexed(body_request_.url));
+  EXPECT_FALSE(Match(body_request_));
+  EXPECT_TRUE(Match(body_request_with_query_));
+  CacheStorageCacheQueryParams match_params;
+  match_params.ignore_search = true;
+  EXPECT_TRUE(Match(body_request_, match_params));
+
+  EXPECT_TRUE(Put(no_body_request_, no_body_response_));
+  EXPECT_TRUE(IsUrlIndexed(no_body_request_.url));
+  EXPECT_TRUE(Match(no_body_request_));
+}
+
+TEST_F(CacheStorageCacheTest, UrlIndexPersistsAcrossOpens) {
+  EXPECT_TRUE(Put(body_request_, body_response_));
+  EXPECT_TRUE(Put(body_request_with_query_, body_response_with_query_));
+  EXPECT_TRUE(Keys());
+  EXPECT_TRUE(Close());
+  base::RunLoop().RunUntilIdle();
+  base::FilePath index_path = temp_dir_.GetPath().AppendASCII("url_index");
+  EXPECT_TRUE(base::PathExists(index_path));
+
+  ReopenCache();
+  CacheStorageCacheQueryParams match_params;
+  match_params.ignore_search = true;
+  EXPECT_TRUE(Match(body_request_with_query_, match_params));
+  EXPECT_TRUE(IsUrlIndexed(body_request_.url));
+  EXPECT_TRUE(IsUrlIndexed(body_request_with_query_.url));
+  // Loading consumes the file until the cache is dropped again.
+  EXPECT_FALSE(base::PathExists(index_path));
+  EXPECT_FALSE(Match(no_body_request_));
+}
+
 TEST_P(CacheStorageCacheTestP, Match_IgnoreMethod) {
   EXPECT_TRUE(Put(body_request_, body_response_));
 
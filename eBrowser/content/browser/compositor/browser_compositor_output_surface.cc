@@ -66,8 +66,11 @@ void BrowserCompositorOutputSurface::OnUpdateVSyncParametersFromGpu(
     // TODO(brianderson): We should not be receiving 0 intervals.
     interval = cc::BeginFrameArgs::DefaultInterval();
   }
-  synthetic_begin_frame_source_->OnUpdateVSyncParameters(timebase, interval);
   vsync_manager_->UpdateVSyncParameters(timebase, interval);
+  // Ticks only as often as the manager's clients need, which can be a
+  // multiple of the display's interval.
+  synthetic_begin_frame_source_->OnUpdateVSyncParameters(
+      timebase, vsync_manager_->GetFrameInterval());
 }
 
 void BrowserCompositorOutputSurface::SetReflector(ReflectorImpl* reflector) {
@@ -8,6 +8,7 @@
 
 #include "base/base64.h"
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string16.h"
@@ -16,6 +17,7 @@
 #include "base/threading/worker_pool.h"
 #include "content/browser/devtools/page_navigation_throttle.h"
 #include "content/browser/devtools/protocol/color_picker.h"
+#include "content/browser/devtools/protocol/screencast_pacer.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "content/browser/renderer_host/render_widget_host_view_base.h"
 #include "content/browser/web_contents/web_contents_impl.h"
@@ -30,6 +32,7 @@
 #include "content/public/browser/notification_types.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents_delegate.h"
+#include "content/public/common/content_switches.h"
 #include "content/public/common/referrer.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/base/page_transition_types.h"
@@ -104,12 +107,19 @@ PageHandler::PageHandler()
       session_id_(0),
       frame_counter_(0),
       frames_in_flight_(0),
+      paced_capture_pending_(false),
       color_picker_(new ColorPicker(
           base::Bind(&PageHandler::OnColorPicked, base::Unretained(this)))),
       navigation_throttle_enabled_(false),
       next_navigation_id_(0),
       host_(nullptr),
-      weak_factory_(this) {}
+      weak_factory_(this) {
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEBrowserAdaptiveScreencast)) {
+    screencast_pacer_.reset(
+        new ScreencastPacer(kMaxScreencastFramesInFlight));
+  }
+}
 
 PageHandler::~PageHandler() {
 }
@@ -309,6 +319,8 @@ Response PageHandler::StartScreencast(const std::string* format,
   ++session_id_;
   frame_counter_ = 0;
   frames_in_flight_ = 0;
+  if (screencast_pacer_)
+    screencast_pacer_->Reset();
   capture_every_nth_frame_ =
       every_nth_frame && *every_nth_frame ? *every_nth_frame : 1;
 
@@ -331,8 +343,11 @@ Response PageHandler::StopScreencast() {
 }
 
 Response PageHandler::ScreencastFrameAck(int session_id) {
-  if (session_id == session_id_)
+  if (session_id == session_id_) {
     --frames_in_flight_;
+    if (screencast_pacer_)
+      screencast_pacer_->DidAckFrame(base::TimeTicks::Now());
+  }
   return Response::OK();
 }
 
@@ -456,6 +471,21 @@ void PageHandler::InnerSwapCompositorFrame() {
   if (frames_in_flight_ > kMaxScreencastFramesInFlight)
     return;
 
+  if (screencast_pacer_) {
+    base::TimeDelta delay =
+        screencast_pacer_->GetCaptureDelay(base::TimeTicks::Now());
+    if (!delay.is_zero()) {
+      if (!paced_capture_pending_) {
+        paced_capture_pending_ = true;
+        base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+            FROM_HERE, base::Bind(&PageHandler::OnPacedCaptureDue,
+                                  weak_factory_.GetWeakPtr()),
+            delay);
+      }
+      return;
+    }
+  }
+
   if (++frame_counter_ % capture_every_nth_frame_)
     return;
 
@@ -499,9 +529,17 @@ void PageHandler::InnerSwapCompositorFrame() {
                    base::Passed(last_compositor_frame_metadata_.Clone())),
         kN32_SkColorType);
     frames_in_flight_++;
+    if (screencast_pacer_)
+      screencast_pacer_->DidCapture(base::TimeTicks::Now());
   }
 }
 
+void PageHandler::OnPacedCaptureDue() {
+  paced_capture_pending_ = false;
+  if (screencast_enabled_ && has_compositor_frame_metadata_)
+    InnerSwapCompositorFrame();
+}
+
 void PageHandler::ScreencastFrameCaptured(cc::CompositorFrameMetadata metadata,
                                           const SkBitmap& bitmap,
                                           ReadbackResponse response) {
@@ -522,12 +560,16 @@ void PageHandler::ScreencastFrameCaptured(cc::CompositorFrameMetadata metadata,
                  screencast_quality_),
       base::Bind(&PageHandler::ScreencastFrameEncoded,
                  weak_factory_.GetWeakPtr(), base::Passed(&metadata),
-                 base::Time::Now()));
+                 base::Time::Now(), base::TimeTicks::Now()));
 }
 
 void PageHandler::ScreencastFrameEncoded(cc::CompositorFrameMetadata metadata,
                                          const base::Time& timestamp,
+                                         base::TimeTicks encode_start_time,
                                          const std::string& data) {
+  if (screencast_pacer_)
+    screencast_pacer_->DidEncode(base::TimeTicks::Now() - encode_start_time);
+
   // Consider metadata empty in case it has no device scale factor.
   if (metadata.device_scale_factor == 0 || !host_ || data.empty()) {
     --frames_in_flight_;
@@ -554,6 +596,8 @@ void PageHandler::ScreencastFrameEncoded(cc::CompositorFrameMetadata metadata,
           ->set_scroll_offset_x(metadata.root_scroll_offset.x())
           ->set_scroll_offset_y(metadata.root_scroll_offset.y())
           ->set_timestamp(timestamp.ToDoubleT());
+  if (screencast_pacer_)
+    screencast_pacer_->DidSendFrame(base::TimeTicks::Now());
   client_->ScreencastFrame(ScreencastFrameParams::Create()
       ->set_data(data)
       ->set_metadata(param_metadata)
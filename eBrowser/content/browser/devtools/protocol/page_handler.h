@@ -31,6 +31,7 @@ class PageNavigationThrottle;
 namespace page {
 
 class ColorPicker;
+class ScreencastPacer;
 
 class PageHandler : public NotificationObserver {
  public:
@@ -95,11 +96,13 @@ class PageHandler : public NotificationObserver {
   WebContentsImpl* GetWebContents();
   void NotifyScreencastVisibility(bool visible);
   void InnerSwapCompositorFrame();
+  void OnPacedCaptureDue();
   void ScreencastFrameCaptured(cc::CompositorFrameMetadata metadata,
                                const SkBitmap& bitmap,
                                ReadbackResponse response);
   void ScreencastFrameEncoded(cc::CompositorFrameMetadata metadata,
                               const base::Time& timestamp,
+                              base::TimeTicks encode_start_time,
                               const std::string& data);
 
   void ScreenshotCaptured(
@@ -129,6 +132,11 @@ class PageHandler : public NotificationObserver {
   int session_id_;
   int frame_counter_;
   int frames_in_flight_;
+  // Null unless --ebrowser-adaptive-screencast is given.
+  std::unique_ptr<ScreencastPacer> screencast_pacer_;
+  // Whether a capture is posted for when the pacer next allows one, so that
+  // the last frame of an animation is not lost to pacing.
+  bool paced_capture_pending_;
 
   std::unique_ptr<ColorPicker> color_picker_;
 
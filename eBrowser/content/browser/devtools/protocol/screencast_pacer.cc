@@ -0,0 +1,81 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/devtools/protocol/screencast_pacer.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace content {
+namespace devtools {
+namespace page {
+
+namespace {
+
+// Each new measurement moves the smoothed one by this fraction of the
+// difference, so that one slow encode or ack does not stall the screencast.
+const int kSmoothingDivisor = 4;
+
+// A client that stops acking still gets a frame a second once the frames in
+// flight are acked.
+const int kMaxFrameIntervalMs = 1000;
+
+void Smooth(base::TimeDelta sample, base::TimeDelta* smoothed) {
+  if (smoothed->is_zero())
+    *smoothed = sample;
+  else
+    *smoothed += (sample - *smoothed) / kSmoothingDivisor;
+}
+
+}  // namespace
+
+ScreencastPacer::ScreencastPacer(int frames_in_flight)
+    : frames_in_flight_(frames_in_flight) {
+  DCHECK_GT(frames_in_flight_, 0);
+}
+
+ScreencastPacer::~ScreencastPacer() {}
+
+void ScreencastPacer::Reset() {
+  encode_time_ = base::TimeDelta();
+  ack_time_ = base::TimeDelta();
+  last_capture_time_ = base::TimeTicks();
+  unacked_send_times_.clear();
+}
+
+base::TimeDelta ScreencastPacer::GetCaptureDelay(base::TimeTicks now) const {
+  if (last_capture_time_.is_null())
+    return base::TimeDelta();
+  base::TimeDelta delay = last_capture_time_ + frame_interval() - now;
+  return std::max(delay, base::TimeDelta());
+}
+
+void ScreencastPacer::DidCapture(base::TimeTicks now) {
+  last_capture_time_ = now;
+}
+
+void ScreencastPacer::DidEncode(base::TimeDelta encode_time) {
+  Smooth(encode_time, &encode_time_);
+}
+
+void ScreencastPacer::DidSendFrame(base::TimeTicks now) {
+  unacked_send_times_.push_back(now);
+}
+
+void ScreencastPacer::DidAckFrame(base::TimeTicks now) {
+  if (unacked_send_times_.empty())
+    return;
+  Smooth(now - unacked_send_times_.front(), &ack_time_);
+  unacked_send_times_.pop_front();
+}
+
+base::TimeDelta ScreencastPacer::frame_interval() const {
+  return std::min(std::max(encode_time_, ack_time_ / frames_in_flight_),
+                  base::TimeDelta::FromMilliseconds(kMaxFrameIntervalMs));
+}
+
+}  // namespace page
+}  // namespace devtools
+}  // namespace content
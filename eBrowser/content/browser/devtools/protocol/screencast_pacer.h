@@ -0,0 +1,58 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_DEVTOOLS_PROTOCOL_SCREENCAST_PACER_H_
+#define CONTENT_BROWSER_DEVTOOLS_PROTOCOL_SCREENCAST_PACER_H_
+
+#include <deque>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace content {
+namespace devtools {
+namespace page {
+
+// Paces screencast captures, with --ebrowser-adaptive-screencast, to what
+// the encoder and the client keep up with. A frame is not read back until
+// one interval after the previous capture, the interval being the longer of
+// the smoothed encode time and the smoothed ack round trip shared among the
+// frames allowed in flight. Frames that come sooner are dropped before the
+// readback rather than after it.
+class CONTENT_EXPORT ScreencastPacer {
+ public:
+  // |frames_in_flight| is how many unacked frames the client may hold.
+  explicit ScreencastPacer(int frames_in_flight);
+  ~ScreencastPacer();
+
+  // Forgets the measurements, for a new screencast session.
+  void Reset();
+
+  // How long after |now| the next capture is due; zero if it is due now.
+  base::TimeDelta GetCaptureDelay(base::TimeTicks now) const;
+
+  void DidCapture(base::TimeTicks now);
+  void DidEncode(base::TimeDelta encode_time);
+  void DidSendFrame(base::TimeTicks now);
+  void DidAckFrame(base::TimeTicks now);
+
+  base::TimeDelta frame_interval() const;
+
+ private:
+  const int frames_in_flight_;
+
+  base::TimeDelta encode_time_;
+  base::TimeDelta ack_time_;
+  base::TimeTicks last_capture_time_;
+  std::deque<base::TimeTicks> unacked_send_times_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScreencastPacer);
+};
+
+}  // namespace page
+}  // namespace devtools
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_DEVTOOLS_PROTOCOL_SCREENCAST_PACER_H_
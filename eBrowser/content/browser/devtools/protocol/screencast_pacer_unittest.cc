@@ -0,0 +1,82 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/devtools/protocol/screencast_pacer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+namespace devtools {
+namespace page {
+
+namespace {
+
+base::TimeDelta Ms(int ms) {
+  return base::TimeDelta::FromMilliseconds(ms);
+}
+
+}  // namespace
+
+TEST(ScreencastPacerTest, UnmeasuredCapturesEveryFrame) {
+  ScreencastPacer pacer(2);
+  base::TimeTicks now = base::TimeTicks() + Ms(1000);
+  EXPECT_EQ(base::TimeDelta(), pacer.GetCaptureDelay(now));
+  pacer.DidCapture(now);
+  EXPECT_EQ(base::TimeDelta(), pacer.GetCaptureDelay(now + Ms(16)));
+}
+
+TEST(ScreencastPacerTest, PacesToEncodeTime) {
+  ScreencastPacer pacer(2);
+  base::TimeTicks now = base::TimeTicks() + Ms(1000);
+  pacer.DidCapture(now);
+  pacer.DidEncode(Ms(40));
+  EXPECT_EQ(Ms(40), pacer.frame_interval());
+  EXPECT_EQ(Ms(24), pacer.GetCaptureDelay(now + Ms(16)));
+  EXPECT_EQ(base::TimeDelta(), pacer.GetCaptureDelay(now + Ms(40)));
+
+  // A single fast encode only moves the interval part of the way.
+  pacer.DidEncode(Ms(20));
+  EXPECT_EQ(Ms(35), pacer.frame_interval());
+}
+
+TEST(ScreencastPacerTest, PacesToAckRoundTrip) {
+  ScreencastPacer pacer(2);
+  base::TimeTicks now = base::TimeTicks() + Ms(1000);
+  pacer.DidEncode(Ms(10));
+  pacer.DidSendFrame(now);
+  pacer.DidSendFrame(now + Ms(16));
+  pacer.DidAckFrame(now + Ms(200));
+  // Two frames in flight share the 200ms round trip.
+  EXPECT_EQ(Ms(100), pacer.frame_interval());
+
+  // Acks without a sent frame, e.g. from before a Reset(), are ignored.
+  pacer.DidAckFrame(now + Ms(216));
+  pacer.DidAckFrame(now + Ms(300));
+  EXPECT_EQ(Ms(100), pacer.frame_interval());
+}
+
+TEST(ScreencastPacerTest, IntervalIsCapped) {
+  ScreencastPacer pacer(1);
+  base::TimeTicks now = base::TimeTicks() + Ms(1000);
+  pacer.DidSendFrame(now);
+  pacer.DidAckFrame(now + Ms(5000));
+  EXPECT_EQ(Ms(1000), pacer.frame_interval());
+}
+
+TEST(ScreencastPacerTest, Reset) {
+  ScreencastPacer pacer(2);
+  base::TimeTicks now = base::TimeTicks() + Ms(1000);
+  pacer.DidCapture(now);
+  pacer.DidEncode(Ms(40));
+  pacer.DidSendFrame(now);
+  pacer.Reset();
+  EXPECT_EQ(base::TimeDelta(), pacer.frame_interval());
+  EXPECT_EQ(base::TimeDelta(), pacer.GetCaptureDelay(now));
+  pacer.DidAckFrame(now + Ms(500));
+  EXPECT_EQ(base::TimeDelta(), pacer.frame_interval());
+}
+
+}  // namespace page
+}  // namespace devtools
+}  // namespace content
@@ -8,17 +8,22 @@
 
 #include <algorithm>
 #include <cctype>  // for std::isalnum
+#include <vector>
 
 #include "base/bind.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/power_monitor/power_monitor.h"
 #include "base/process/process_info.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "base/trace_event/process_memory_dump.h"
+#include "base/trace_event/trace_event.h"
 #include "content/browser/dom_storage/dom_storage_namespace.h"
 #include "content/browser/dom_storage/dom_storage_task_runner.h"
 #include "content/browser/dom_storage/local_storage_database_adapter.h"
@@ -47,9 +52,21 @@ const int kCommitDefaultDelaySecs = 5;
 const int kMaxBytesPerHour = kPerStorageAreaQuota;
 const int kMaxCommitsPerHour = 60;
 
+size_t StringBytes(const base::string16& string) {
+  return string.size() * sizeof(base::char16);
+}
+
+// PowerMonitor's power state is safe to read from the storage sequences.
+bool IsOnBatteryPower() {
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  return power_monitor && power_monitor->IsOnBatteryPower();
+}
+
 }  // namespace
 
 bool DOMStorageArea::s_aggressive_flushing_enabled_ = false;
+DOMStorageArea::BatteryCommitPolicy DOMStorageArea::s_battery_commit_policy_ =
+    {0, 0, 0};
 
 DOMStorageArea::RateLimiter::RateLimiter(size_t desired_rate,
                                          base::TimeDelta time_quantum)
@@ -69,8 +86,18 @@ base::TimeDelta DOMStorageArea::RateLimiter::ComputeDelayNeeded(
   return base::TimeDelta();
 }
 
-DOMStorageArea::CommitBatch::CommitBatch() : clear_all_first(false) {
+base::TimeDelta DOMStorageArea::RateLimiter::ComputeDelayNeeded(
+    const base::TimeDelta elapsed_time,
+    size_t desired_rate) const {
+  DCHECK_GT(desired_rate, 0ul);
+  base::TimeDelta time_needed = time_quantum_ * (samples_ / desired_rate);
+  if (time_needed > elapsed_time)
+    return time_needed - elapsed_time;
+  return base::TimeDelta();
 }
+
+DOMStorageArea::CommitBatch::CommitBatch()
+    : clear_all_first(false), page_bytes(0) {}
 DOMStorageArea::CommitBatch::~CommitBatch() {}
 
 size_t DOMStorageArea::CommitBatch::GetDataSize() const {
@@ -104,6 +131,33 @@ void DOMStorageArea::EnableAggressiveCommitDelay() {
   LevelDBWrapperImpl::EnableAggressiveCommitDelay();
 }
 
+// static
+bool DOMStorageArea::ParseBatteryCommitPolicy(const std::string& spec,
+                                              BatteryCommitPolicy* policy) {
+  std::vector<std::string> values = base::SplitString(
+      spec, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+  BatteryCommitPolicy parsed;
+  if (values.size() != 3 ||
+      !base::StringToInt(values[0], &parsed.delay_seconds) ||
+      !base::StringToInt(values[1], &parsed.max_commits_per_hour) ||
+      !base::StringToInt(values[2], &parsed.max_kilobytes_per_hour) ||
+      parsed.delay_seconds <= 0 || parsed.max_commits_per_hour <= 0 ||
+      parsed.max_kilobytes_per_hour <= 0) {
+    return false;
+  }
+  *policy = parsed;
+  return true;
+}
+
+// static
+void DOMStorageArea::EnableBatteryCommitBatching(
+    const BatteryCommitPolicy& policy) {
+  DCHECK_GT(policy.delay_seconds, 0);
+  DCHECK_GT(policy.max_commits_per_hour, 0);
+  DCHECK_GT(policy.max_kilobytes_per_hour, 0);
+  s_battery_commit_policy_ = policy;
+}
+
 DOMStorageArea::DOMStorageArea(const GURL& origin,
                                const base::FilePath& directory,
                                DOMStorageTaskRunner* task_runner)
@@ -197,6 +251,7 @@ bool DOMStorageArea::SetItem(const base::string16& key,
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
     // Values are populated later to avoid holding duplicate memory.
     commit_batch->changed_values[key] = base::NullableString16();
+    commit_batch->page_bytes += StringBytes(key) + StringBytes(value);
   }
   return success;
 }
@@ -212,6 +267,7 @@ bool DOMStorageArea::RemoveItem(const base::string16& key,
   if (success && backing_) {
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
     commit_batch->changed_values[key] = base::NullableString16();
+    commit_batch->page_bytes += StringBytes(key);
   }
   return success;
 }
@@ -460,12 +516,29 @@ base::TimeDelta DOMStorageArea::ComputeCommitDelay() const {
   if (s_aggressive_flushing_enabled_)
     return base::TimeDelta::FromSeconds(1);
 
+  base::TimeDelta delay = ComputeCommitDelay(
+      s_battery_commit_policy_.delay_seconds > 0 && IsOnBatteryPower());
+  UMA_HISTOGRAM_LONG_TIMES("LocalStorage.CommitDelay", delay);
+  return delay;
+}
+
+base::TimeDelta DOMStorageArea::ComputeCommitDelay(
+    bool on_battery_power) const {
   base::TimeDelta elapsed_time = base::TimeTicks::Now() - start_time_;
   base::TimeDelta delay = std::max(
       base::TimeDelta::FromSeconds(kCommitDefaultDelaySecs),
       std::max(commit_rate_limiter_.ComputeDelayNeeded(elapsed_time),
                data_rate_limiter_.ComputeDelayNeeded(elapsed_time)));
-  UMA_HISTOGRAM_LONG_TIMES("LocalStorage.CommitDelay", delay);
+  if (!on_battery_power)
+    return delay;
+
+  const BatteryCommitPolicy& policy = s_battery_commit_policy_;
+  delay = std::max(delay, base::TimeDelta::FromSeconds(policy.delay_seconds));
+  delay = std::max(delay, commit_rate_limiter_.ComputeDelayNeeded(
+                              elapsed_time, policy.max_commits_per_hour));
+  delay = std::max(delay,
+                   data_rate_limiter_.ComputeDelayNeeded(
+                       elapsed_time, policy.max_kilobytes_per_hour * 1024));
   return delay;
 }
 
@@ -488,8 +561,21 @@ void DOMStorageArea::PostCommitTask() {
   DCHECK(backing_.get());
 
   PopulateCommitBatchValues();
+  size_t data_size = commit_batch_->GetDataSize();
   commit_rate_limiter_.add_samples(1);
-  data_rate_limiter_.add_samples(commit_batch_->GetDataSize());
+  data_rate_limiter_.add_samples(data_size);
+
+  // How much of what the page wrote reaches the disk; batching drops the
+  // values overwritten before the commit.
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"),
+                       "DOMStorageArea::Commit", TRACE_EVENT_SCOPE_THREAD,
+                       "page_bytes", commit_batch_->page_bytes,
+                       "committed_bytes", data_size);
+  if (commit_batch_->page_bytes) {
+    UMA_HISTOGRAM_PERCENTAGE(
+        "LocalStorage.CommitWriteAmplification",
+        std::min<size_t>(100, data_size * 100 / commit_batch_->page_bytes));
+  }
 
   // This method executes on the primary sequence, we schedule
   // a task for immediate execution on the commit sequence.
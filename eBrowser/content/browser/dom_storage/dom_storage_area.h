@@ -51,6 +51,28 @@ class CONTENT_EXPORT DOMStorageArea
   // aggressive flushing will commence.
   static void EnableAggressiveCommitDelay();
 
+  // How commits are batched while the device runs on battery power, on top
+  // of the limits that always apply. Flash writes wake the storage
+  // controller, so pages that write from scroll handlers get fewer, larger
+  // commits instead.
+  struct BatteryCommitPolicy {
+    // The least time a change waits for others to batch with.
+    int delay_seconds;
+    // Limits on each area's average commit rate since it was opened.
+    int max_commits_per_hour;
+    int max_kilobytes_per_hour;
+  };
+
+  // Parses a --ebrowser-battery-storage-commits value,
+  // "<delay_seconds>,<max_commits_per_hour>,<max_kilobytes_per_hour>" with
+  // all three positive, e.g. "30,12,512".
+  static bool ParseBatteryCommitPolicy(const std::string& spec,
+                                       BatteryCommitPolicy* policy);
+
+  // Applies |policy| to commits scheduled while on battery power. Like
+  // EnableAggressiveCommitDelay(), before any localStorage writing.
+  static void EnableBatteryCommitBatching(const BatteryCommitPolicy& policy);
+
   // Local storage. Backed on disk if directory is nonempty.
   DOMStorageArea(const GURL& origin,
                  const base::FilePath& directory,
@@ -116,6 +138,8 @@ class CONTENT_EXPORT DOMStorageArea
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, DeleteOrigin);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, PurgeMemory);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, RateLimiter);
+  FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, BatteryCommitDelay);
+  FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, CommitBatchPageBytes);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageContextImplTest, PersistentIds);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageContextImplTest, PurgeMemory);
   friend class base::RefCountedThreadSafe<DOMStorageArea>;
@@ -138,6 +162,9 @@ class CONTENT_EXPORT DOMStorageArea
     // seen at the desired rate.
     base::TimeDelta ComputeDelayNeeded(
         const base::TimeDelta elapsed_time) const;
+    // As above, at |desired_rate| rather than the limiter's own.
+    base::TimeDelta ComputeDelayNeeded(const base::TimeDelta elapsed_time,
+                                       size_t desired_rate) const;
 
    private:
     float rate_;
@@ -148,6 +175,9 @@ class CONTENT_EXPORT DOMStorageArea
   struct CONTENT_EXPORT CommitBatch {
     bool clear_all_first;
     DOMStorageValuesMap changed_values;
+    // Bytes of the keys and values the page wrote into the batch, counting
+    // every overwrite, for the write amplification of the commit.
+    size_t page_bytes;
 
     CommitBatch();
     ~CommitBatch();
@@ -172,10 +202,13 @@ class CONTENT_EXPORT DOMStorageArea
   void CommitChanges(const CommitBatch* commit_batch);
   void OnCommitComplete();
   base::TimeDelta ComputeCommitDelay() const;
+  base::TimeDelta ComputeCommitDelay(bool on_battery_power) const;
 
   void ShutdownInCommitSequence();
 
   static bool s_aggressive_flushing_enabled_;
+  // Zero delay while battery batching is disabled.
+  static BatteryCommitPolicy s_battery_commit_policy_;
 
   int64_t namespace_id_;
   std::string persistent_namespace_id_;
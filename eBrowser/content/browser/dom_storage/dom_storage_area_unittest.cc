@@ -542,4 +542,68 @@ TEST_F(DOMStorageAreaTest, RateLimiter) {
                 base::TimeDelta::FromDays(1)));
 }
 
+
+TEST_F(DOMStorageAreaTest, ParseBatteryCommitPolicy) {
+  DOMStorageArea::BatteryCommitPolicy policy;
+  EXPECT_TRUE(DOMStorageArea::ParseBatteryCommitPolicy("30, 12, 512",
+                                                       &policy));
+  EXPECT_EQ(30, policy.delay_seconds);
+  EXPECT_EQ(12, policy.max_commits_per_hour);
+  EXPECT_EQ(512, policy.max_kilobytes_per_hour);
+
+  EXPECT_FALSE(DOMStorageArea::ParseBatteryCommitPolicy("", &policy));
+  EXPECT_FALSE(DOMStorageArea::ParseBatteryCommitPolicy("30,12", &policy));
+  EXPECT_FALSE(DOMStorageArea::ParseBatteryCommitPolicy("30,0,512", &policy));
+  EXPECT_FALSE(DOMStorageArea::ParseBatteryCommitPolicy("30,x,512", &policy));
+  EXPECT_EQ(30, policy.delay_seconds);
+}
+
+TEST_F(DOMStorageAreaTest, BatteryCommitDelay) {
+  scoped_refptr<DOMStorageArea> area(new DOMStorageArea(
+      kOrigin, base::FilePath(),
+      new MockDOMStorageTaskRunner(base::ThreadTaskRunnerHandle::Get().get())));
+  DOMStorageArea::BatteryCommitPolicy policy = {30, 12, 1};
+  DOMStorageArea::EnableBatteryCommitBatching(policy);
+
+  // Nothing committed yet: only the battery delay differs.
+  EXPECT_EQ(base::TimeDelta::FromSeconds(5), area->ComputeCommitDelay(false));
+  EXPECT_EQ(base::TimeDelta::FromSeconds(30), area->ComputeCommitDelay(true));
+
+  // One commit takes a twelfth of the hour on battery, a sixtieth otherwise.
+  area->commit_rate_limiter_.add_samples(1);
+  EXPECT_GE(base::TimeDelta::FromMinutes(1), area->ComputeCommitDelay(false));
+  EXPECT_LT(base::TimeDelta::FromMinutes(4), area->ComputeCommitDelay(true));
+  EXPECT_GE(base::TimeDelta::FromMinutes(5), area->ComputeCommitDelay(true));
+
+  // 2KB against a 1KB an hour budget.
+  area->data_rate_limiter_.add_samples(2048);
+  EXPECT_LT(base::TimeDelta::FromMinutes(119),
+            area->ComputeCommitDelay(true));
+
+  DOMStorageArea::s_battery_commit_policy_ =
+      DOMStorageArea::BatteryCommitPolicy{0, 0, 0};
+}
+
+TEST_F(DOMStorageAreaTest, CommitBatchPageBytes) {
+  scoped_refptr<DOMStorageArea> area(new DOMStorageArea(
+      kOrigin, base::FilePath(),
+      new MockDOMStorageTaskRunner(base::ThreadTaskRunnerHandle::Get().get())));
+  // Inject an in-memory db to speed up the test.
+  area->backing_.reset(new LocalStorageDatabaseAdapter());
+
+  base::NullableString16 old_value;
+  base::string16 removed_value;
+  EXPECT_TRUE(area->SetItem(kKey, kValue, &old_value));
+  EXPECT_TRUE(area->SetItem(kKey, kValue2, &old_value));
+  EXPECT_TRUE(area->RemoveItem(kKey, &removed_value));
+  ASSERT_TRUE(area->commit_batch_);
+  // Three writes to one key, of which only the removal is committed.
+  EXPECT_EQ((3 * kKey.size() + kValue.size() + kValue2.size()) *
+                sizeof(base::char16),
+            area->commit_batch_->page_bytes);
+  EXPECT_EQ(1u, area->commit_batch_->changed_values.size());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(area->HasUncommittedChanges());
+}
+
 }  // namespace content
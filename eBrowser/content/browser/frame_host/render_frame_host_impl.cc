@@ -798,6 +798,10 @@ gfx::NativeViewAccessible
   return NULL;
 }
 
+int RenderFrameHostImpl::AccessibilityGetTargetFrameRate() const {
+  return render_view_host_->GetWidget()->target_frame_rate();
+}
+
 void RenderFrameHostImpl::RenderProcessGone(SiteInstanceImpl* site_instance) {
   DCHECK_EQ(site_instance_.get(), site_instance);
 
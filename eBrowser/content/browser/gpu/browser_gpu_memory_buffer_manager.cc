@@ -7,7 +7,10 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/command_line.h"
+#include "base/memory/shared_memory.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/thread_restrictions.h"
@@ -30,6 +33,26 @@
 namespace content {
 namespace {
 
+// How long a deleted buffer waits in the pool before it is freed.
+const int kPooledBufferIdleTimeoutMs = 2000;
+
+// The shared memory handle given to a child process can only be duplicated by
+// the browser where it is a file descriptor.
+size_t GetPoolBytesPerClient() {
+#if defined(OS_POSIX) && !defined(OS_MACOSX)
+  size_t megabytes = 0;
+  if (!base::StringToSizeT(
+          base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+              switches::kEBrowserGpuMemoryBufferPool),
+          &megabytes)) {
+    return 0;
+  }
+  return megabytes * 1024 * 1024;
+#else
+  return 0;
+#endif
+}
+
 void HostCreateGpuMemoryBuffer(
     gpu::SurfaceHandle surface_handle,
     GpuProcessHost* host,
@@ -154,12 +177,25 @@ BrowserGpuMemoryBufferManager::BrowserGpuMemoryBufferManager(
     : native_configurations_(GetNativeGpuMemoryBufferConfigurations()),
       gpu_client_id_(gpu_client_id),
       gpu_client_tracing_id_(gpu_client_tracing_id),
-      gpu_host_id_(0) {
+      gpu_host_id_(0),
+      pool_bytes_per_client_(GetPoolBytesPerClient()),
+      pool_expiry_scheduled_(false) {
   DCHECK(!g_gpu_memory_buffer_manager);
   g_gpu_memory_buffer_manager = this;
+  if (pool_bytes_per_client_) {
+    memory_pressure_listener_.reset(new base::MemoryPressureListener(
+        base::Bind(&BrowserGpuMemoryBufferManager::OnMemoryPressure,
+                   base::Unretained(this))));
+  }
 }
 
 BrowserGpuMemoryBufferManager::~BrowserGpuMemoryBufferManager() {
+  // The IO thread is stopped by now, so the retained handles can be closed
+  // here.
+  for (auto& client : clients_) {
+    for (auto& buffer : client.second)
+      ReleaseRetainedHandleOnIO(client.first, &buffer.second);
+  }
   g_gpu_memory_buffer_manager = nullptr;
 }
 
@@ -275,6 +311,9 @@ void BrowserGpuMemoryBufferManager::AllocateGpuMemoryBufferForChildProcess(
     return;
   }
 
+  if (ReusePooledBufferOnIO(child_client_id, size, format, usage, callback))
+    return;
+
   BufferMap& buffers = clients_[child_client_id];
 
   // Allocate shared memory buffer as fallback.
@@ -287,8 +326,11 @@ void BrowserGpuMemoryBufferManager::AllocateGpuMemoryBufferForChildProcess(
     return;
   }
 
-  callback.Run(gpu::GpuMemoryBufferImplSharedMemory::AllocateForChildProcess(
-      id, size, format, child_process_handle));
+  gfx::GpuMemoryBufferHandle handle =
+      gpu::GpuMemoryBufferImplSharedMemory::AllocateForChildProcess(
+          id, size, format, child_process_handle);
+  RetainHandleOnIO(child_client_id, &insert_result.first->second, handle);
+  callback.Run(handle);
 }
 
 gfx::GpuMemoryBuffer*
@@ -378,7 +420,10 @@ void BrowserGpuMemoryBufferManager::ProcessRemoved(
       host->DestroyGpuMemoryBuffer(buffer.first, client_id, gpu::SyncToken());
   }
 
+  for (auto& buffer : client_it->second)
+    ReleaseRetainedHandleOnIO(client_id, &buffer.second);
   clients_.erase(client_it);
+  retained_bytes_.erase(client_id);
 }
 
 bool BrowserGpuMemoryBufferManager::IsNativeGpuMemoryBufferConfiguration(
@@ -652,13 +697,181 @@ void BrowserGpuMemoryBufferManager::DestroyGpuMemoryBufferOnIO(
     return;
   }
 
+  if (buffer_it->second.pooled) {
+    LOG(ERROR) << "GpuMemoryBuffer deleted twice.";
+    return;
+  }
+
+  if (PoolBufferOnIO(&buffer_it->second, sync_token))
+    return;
+
   GpuProcessHost* host = GpuProcessHost::FromID(buffer_it->second.gpu_host_id);
   if (host)
     host->DestroyGpuMemoryBuffer(id, client_id, sync_token);
 
+  ReleaseRetainedHandleOnIO(client_id, &buffer_it->second);
   buffers.erase(buffer_it);
 }
 
+bool BrowserGpuMemoryBufferManager::ReusePooledBufferOnIO(
+    int client_id,
+    const gfx::Size& size,
+    gfx::BufferFormat format,
+    gfx::BufferUsage usage,
+    const AllocationCallback& callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  ClientMap::iterator client_it = clients_.find(client_id);
+  if (client_it == clients_.end())
+    return false;
+
+  for (auto& buffer : client_it->second) {
+    BufferInfo& info = buffer.second;
+    if (!info.pooled || info.size != size || info.format != format ||
+        info.usage != usage) {
+      continue;
+    }
+    // The buffer keeps the ID the client gave it, which the client will not
+    // hand out again, and its contents are undefined to the client either
+    // way.
+    gfx::GpuMemoryBufferHandle handle = info.retained_handle;
+    handle.handle =
+        base::SharedMemory::DuplicateHandle(info.retained_handle.handle);
+    if (!base::SharedMemory::IsHandleValid(handle.handle))
+      return false;
+    TRACE_EVENT2("browser",
+                 "BrowserGpuMemoryBufferManager::ReusePooledBufferOnIO",
+                 "width", size.width(), "height", size.height());
+    info.pooled = false;
+    callback.Run(handle);
+    return true;
+  }
+  return false;
+}
+
+void BrowserGpuMemoryBufferManager::RetainHandleOnIO(
+    int client_id,
+    BufferInfo* info,
+    const gfx::GpuMemoryBufferHandle& handle) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  if (!pool_bytes_per_client_ || handle.type != gfx::SHARED_MEMORY_BUFFER)
+    return;
+
+  // Past the limit buffers are freed as before, which also bounds the file
+  // descriptors the browser holds on a client's behalf.
+  size_t buffer_size_in_bytes =
+      gfx::BufferSizeForBufferFormat(info->size, info->format);
+  size_t& retained_bytes = retained_bytes_[client_id];
+  if (retained_bytes + buffer_size_in_bytes > pool_bytes_per_client_)
+    return;
+
+  info->retained_handle = handle;
+  info->retained_handle.handle =
+      base::SharedMemory::DuplicateHandle(handle.handle);
+  if (!base::SharedMemory::IsHandleValid(info->retained_handle.handle)) {
+    info->retained_handle = gfx::GpuMemoryBufferHandle();
+    return;
+  }
+  retained_bytes += buffer_size_in_bytes;
+}
+
+bool BrowserGpuMemoryBufferManager::PoolBufferOnIO(
+    BufferInfo* info,
+    const gpu::SyncToken& sync_token) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  if (info->retained_handle.type != gfx::SHARED_MEMORY_BUFFER)
+    return false;
+
+  // A destruction sync token means the GPU may still read the buffer, and the
+  // browser has no way to wait for it before the client writes to it again.
+  if (sync_token.HasData())
+    return false;
+
+  info->pooled = true;
+  info->pooled_time = base::TimeTicks::Now();
+  if (!pool_expiry_scheduled_) {
+    pool_expiry_scheduled_ = true;
+    // Note: Unretained is safe as IO thread is stopped before manager is
+    // destroyed.
+    BrowserThread::PostDelayedTask(
+        BrowserThread::IO, FROM_HERE,
+        base::Bind(&BrowserGpuMemoryBufferManager::ExpirePooledBuffersOnIO,
+                   base::Unretained(this)),
+        base::TimeDelta::FromMilliseconds(kPooledBufferIdleTimeoutMs));
+  }
+  return true;
+}
+
+void BrowserGpuMemoryBufferManager::ReleaseRetainedHandleOnIO(
+    int client_id,
+    BufferInfo* info) {
+  if (info->retained_handle.type != gfx::SHARED_MEMORY_BUFFER)
+    return;
+
+  base::SharedMemory::CloseHandle(info->retained_handle.handle);
+  info->retained_handle = gfx::GpuMemoryBufferHandle();
+  retained_bytes_[client_id] -=
+      gfx::BufferSizeForBufferFormat(info->size, info->format);
+}
+
+bool BrowserGpuMemoryBufferManager::PurgePooledBuffersOnIO(
+    base::TimeDelta min_idle) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  const base::TimeTicks cutoff = base::TimeTicks::Now() - min_idle;
+  bool buffers_remain = false;
+  for (auto& client : clients_) {
+    BufferMap& buffers = client.second;
+    for (BufferMap::iterator buffer_it = buffers.begin();
+         buffer_it != buffers.end();) {
+      if (!buffer_it->second.pooled) {
+        ++buffer_it;
+        continue;
+      }
+      if (buffer_it->second.pooled_time > cutoff) {
+        buffers_remain = true;
+        ++buffer_it;
+        continue;
+      }
+      ReleaseRetainedHandleOnIO(client.first, &buffer_it->second);
+      buffer_it = buffers.erase(buffer_it);
+    }
+  }
+  return buffers_remain;
+}
+
+void BrowserGpuMemoryBufferManager::ExpirePooledBuffersOnIO() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  pool_expiry_scheduled_ = false;
+  const base::TimeDelta idle_timeout =
+      base::TimeDelta::FromMilliseconds(kPooledBufferIdleTimeoutMs);
+  if (!PurgePooledBuffersOnIO(idle_timeout))
+    return;
+
+  // Check again once the newest of the remaining buffers could have expired.
+  pool_expiry_scheduled_ = true;
+  BrowserThread::PostDelayedTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&BrowserGpuMemoryBufferManager::ExpirePooledBuffersOnIO,
+                 base::Unretained(this)),
+      idle_timeout);
+}
+
+void BrowserGpuMemoryBufferManager::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  // Note: Unretained is safe as IO thread is stopped before manager is
+  // destroyed.
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(
+          base::IgnoreResult(
+              &BrowserGpuMemoryBufferManager::PurgePooledBuffersOnIO),
+          base::Unretained(this), base::TimeDelta()));
+}
+
 uint64_t BrowserGpuMemoryBufferManager::ClientIdToTracingProcessId(
     int client_id) const {
   if (client_id == gpu_client_id_) {
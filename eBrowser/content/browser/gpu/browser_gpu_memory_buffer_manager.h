@@ -15,6 +15,8 @@
 #include "base/containers/hash_tables.h"
 #include "base/hash.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/time/time.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "content/common/content_export.h"
 #include "gpu/command_buffer/client/gpu_memory_buffer_manager.h"
@@ -116,6 +118,12 @@ class CONTENT_EXPORT BrowserGpuMemoryBufferManager
     gfx::BufferFormat format = gfx::BufferFormat::RGBA_8888;
     gfx::BufferUsage usage = gfx::BufferUsage::GPU_READ;
     int gpu_host_id = 0;
+    // A duplicate of the shared memory handle given to the client, kept so
+    // that the buffer can be recycled once the client deletes it.
+    gfx::GpuMemoryBufferHandle retained_handle;
+    // Set while the client has deleted the buffer and it waits to be reused.
+    bool pooled = false;
+    base::TimeTicks pooled_time;
   };
 
   struct CreateGpuMemoryBufferRequest;
@@ -163,6 +171,26 @@ class CONTENT_EXPORT BrowserGpuMemoryBufferManager
                                   int client_id,
                                   const gpu::SyncToken& sync_token);
 
+  // The pool of --ebrowser-gpu-memory-buffer-pool. Raster and video keep
+  // replacing buffers of equal size, so a deleted buffer is handed back to its
+  // client for the next allocation that matches it instead of being freed.
+  bool ReusePooledBufferOnIO(int client_id,
+                             const gfx::Size& size,
+                             gfx::BufferFormat format,
+                             gfx::BufferUsage usage,
+                             const AllocationCallback& callback);
+  void RetainHandleOnIO(int client_id,
+                        BufferInfo* info,
+                        const gfx::GpuMemoryBufferHandle& handle);
+  bool PoolBufferOnIO(BufferInfo* info, const gpu::SyncToken& sync_token);
+  void ReleaseRetainedHandleOnIO(int client_id, BufferInfo* info);
+  // Frees the pooled buffers unused for at least |min_idle| and returns
+  // whether any remain.
+  bool PurgePooledBuffersOnIO(base::TimeDelta min_idle);
+  void ExpirePooledBuffersOnIO();
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
   uint64_t ClientIdToTracingProcessId(int client_id) const;
 
   const GpuMemoryBufferConfigurationSet native_configurations_;
@@ -178,6 +206,18 @@ class CONTENT_EXPORT BrowserGpuMemoryBufferManager
   using ClientMap = base::hash_map<int, BufferMap>;
   ClientMap clients_;
 
+  // The most bytes of a client's buffers the pool keeps handles for, or zero
+  // if the pool is off.
+  const size_t pool_bytes_per_client_;
+
+  // The bytes each client has retained handles for, pooled or still in use,
+  // and whether an expiry of the pool is pending. These should only be
+  // accessed on the IO thread.
+  base::hash_map<int, size_t> retained_bytes_;
+  bool pool_expiry_scheduled_;
+
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   DISALLOW_COPY_AND_ASSIGN(BrowserGpuMemoryBufferManager);
 };
 
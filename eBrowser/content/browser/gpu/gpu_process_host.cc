@@ -992,6 +992,10 @@ bool GpuProcessHost::LaunchGpuProcess(gpu::GpuPreferences* gpu_preferences) {
   cmd_line->CopySwitchesFrom(
       browser_command_line, switches::kGLSwitchesCopiedFromGpuProcessHost,
       switches::kGLSwitchesCopiedFromGpuProcessHostNumSwitches);
+#if defined(OS_ANDROID)
+  if (browser_command_line.HasSwitch(switches::kEBrowserPartialSwap))
+    cmd_line->AppendSwitch(switches::kEnableSwapBuffersWithDamage);
+#endif
 
   GetContentClient()->browser()->AppendExtraCommandLineSwitches(
       cmd_line, process_->GetData().id);
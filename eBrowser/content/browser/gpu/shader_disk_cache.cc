@@ -4,10 +4,21 @@
 
 #include "content/browser/gpu/shader_disk_cache.h"
 
+#include <algorithm>
+
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/task_runner_util.h"
 #include "base/threading/thread_checker.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "content/browser/gpu/gpu_process_host.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/common/content_switches.h"
 #include "gpu/command_buffer/common/constants.h"
 #include "net/base/cache_type.h"
 #include "net/base/io_buffer.h"
@@ -20,6 +31,17 @@ namespace {
 static const base::FilePath::CharType kGpuCachePath[] =
     FILE_PATH_LITERAL("GPUCache");
 
+// Kept beside, not inside, the disk cache directory, which the backend owns.
+static const base::FilePath::CharType kGpuCacheUsageLogPath[] =
+    FILE_PATH_LITERAL("GPUCacheUsage");
+
+// The most shader keys kept in the usage log.
+static const size_t kMaxUsageLogSize = 512;
+
+// Delay before a changed usage log is written, so that the burst of shaders
+// compiled while a page loads is written once.
+static const int kUsageLogWriteDelaySeconds = 10;
+
 void EntryCloser(disk_cache::Entry* entry) {
   entry->Close();
 }
@@ -27,6 +49,20 @@ void EntryCloser(disk_cache::Entry* entry) {
 void FreeDiskCacheIterator(
     std::unique_ptr<disk_cache::Backend::Iterator> iterator) {}
 
+// The usage log holds one shader key per line, most recently used first.
+std::vector<std::string> ReadUsageLog(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return std::vector<std::string>();
+  return base::SplitString(contents, "\n", base::TRIM_WHITESPACE,
+                           base::SPLIT_WANT_NONEMPTY);
+}
+
+void WriteUsageLogToFile(const base::FilePath& path,
+                         const std::string& contents) {
+  base::ImportantFileWriter::WriteFileAtomically(path, contents);
+}
+
 }  // namespace
 
 // ShaderDiskCacheEntry handles the work of caching/updating the cached
@@ -73,7 +109,11 @@ class ShaderDiskReadHelper
     : public base::ThreadChecker,
       public base::RefCounted<ShaderDiskReadHelper> {
  public:
-  ShaderDiskReadHelper(base::WeakPtr<ShaderDiskCache> cache, int host_id);
+  // Loads every entry, or if |keys| is not empty, only the entries of |keys|
+  // in order, yielding to other tasks between them.
+  ShaderDiskReadHelper(base::WeakPtr<ShaderDiskCache> cache,
+                       int host_id,
+                       const std::vector<std::string>& keys);
   void LoadCache();
 
  private:
@@ -83,6 +123,8 @@ class ShaderDiskReadHelper
     TERMINATE,
     OPEN_NEXT,
     OPEN_NEXT_COMPLETE,
+    OPEN_KEY,
+    OPEN_KEY_COMPLETE,
     READ_COMPLETE,
     ITERATION_FINISHED
   };
@@ -94,11 +136,16 @@ class ShaderDiskReadHelper
 
   int OpenNextEntry();
   int OpenNextEntryComplete(int rv);
+  int OpenKeyEntry();
+  int OpenKeyEntryComplete(int rv);
+  int ReadEntry();
   int ReadComplete(int rv);
   int IterationComplete(int rv);
 
   base::WeakPtr<ShaderDiskCache> cache_;
   OpType op_type_;
+  std::vector<std::string> keys_;
+  size_t next_key_;
   std::unique_ptr<disk_cache::Backend::Iterator> iter_;
   scoped_refptr<net::IOBufferWithSize> buf_;
   int host_id_;
@@ -244,9 +291,12 @@ int ShaderDiskCacheEntry::IOComplete(int rv) {
 
 ShaderDiskReadHelper::ShaderDiskReadHelper(
     base::WeakPtr<ShaderDiskCache> cache,
-    int host_id)
+    int host_id,
+    const std::vector<std::string>& keys)
     : cache_(cache),
-      op_type_(OPEN_NEXT),
+      op_type_(keys.empty() ? OPEN_NEXT : OPEN_KEY),
+      keys_(keys),
+      next_key_(0),
       buf_(NULL),
       host_id_(host_id),
       entry_(NULL) {
@@ -272,6 +322,12 @@ void ShaderDiskReadHelper::OnOpComplete(int rv) {
       case OPEN_NEXT_COMPLETE:
         rv = OpenNextEntryComplete(rv);
         break;
+      case OPEN_KEY:
+        rv = OpenKeyEntry();
+        break;
+      case OPEN_KEY_COMPLETE:
+        rv = OpenKeyEntryComplete(rv);
+        break;
       case READ_COMPLETE:
         rv = ReadComplete(rv);
         break;
@@ -312,6 +368,36 @@ int ShaderDiskReadHelper::OpenNextEntryComplete(int rv) {
   if (rv < 0)
     return rv;
 
+  return ReadEntry();
+}
+
+int ShaderDiskReadHelper::OpenKeyEntry() {
+  DCHECK(CalledOnValidThread());
+  // Called through OnOpComplete, so we know |cache_| is valid.
+  if (next_key_ == keys_.size()) {
+    op_type_ = TERMINATE;
+    return net::OK;
+  }
+  op_type_ = OPEN_KEY_COMPLETE;
+  return cache_->backend()->OpenEntry(
+      keys_[next_key_++], &entry_,
+      base::Bind(&ShaderDiskReadHelper::OnOpComplete, this));
+}
+
+int ShaderDiskReadHelper::OpenKeyEntryComplete(int rv) {
+  DCHECK(CalledOnValidThread());
+  // Called through OnOpComplete, so we know |cache_| is valid.
+  if (rv != net::OK) {
+    // The entry was evicted since it was logged.
+    entry_ = NULL;
+    op_type_ = OPEN_KEY;
+    return net::OK;
+  }
+  return ReadEntry();
+}
+
+int ShaderDiskReadHelper::ReadEntry() {
+  DCHECK(CalledOnValidThread());
   op_type_ = READ_COMPLETE;
   buf_ = new net::IOBufferWithSize(entry_->GetDataSize(1));
   return entry_->ReadData(
@@ -336,8 +422,18 @@ int ShaderDiskReadHelper::ReadComplete(int rv) {
   entry_->Close();
   entry_ = NULL;
 
-  op_type_ = OPEN_NEXT;
-  return net::OK;
+  if (keys_.empty()) {
+    op_type_ = OPEN_NEXT;
+    return net::OK;
+  }
+
+  // Prewarming runs alongside browser startup, so let other tasks on this
+  // thread run between entries.
+  op_type_ = OPEN_KEY;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::Bind(&ShaderDiskReadHelper::OnOpComplete, this,
+                            net::OK));
+  return net::ERR_IO_PENDING;
 }
 
 int ShaderDiskReadHelper::IterationComplete(int rv) {
@@ -516,12 +612,23 @@ ShaderDiskCache::ShaderDiskCache(const base::FilePath& cache_path)
     : cache_available_(false),
       host_id_(0),
       cache_path_(cache_path),
-      is_initialized_(false) {
+      is_initialized_(false),
+      max_prewarm_shaders_(0) {
   ShaderCacheFactory::GetInstance()->AddToCache(cache_path_, this);
+
+  unsigned max_prewarm_shaders = 0;
+  if (base::StringToUint(
+          base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+              switches::kEBrowserShaderCachePrewarm),
+          &max_prewarm_shaders)) {
+    max_prewarm_shaders_ = max_prewarm_shaders;
+  }
 }
 
 ShaderDiskCache::~ShaderDiskCache() {
   ShaderCacheFactory::GetInstance()->RemoveFromCache(cache_path_);
+  if (usage_log_write_timer_.IsRunning())
+    WriteUsageLog();
 }
 
 void ShaderDiskCache::Init() {
@@ -551,6 +658,15 @@ void ShaderDiskCache::Cache(const std::string& key, const std::string& shader) {
   shim->Cache();
 
   entry_map_[shim.get()] = shim;
+
+  if (max_prewarm_shaders_) {
+    RecordUsage(&usage_log_, key, kMaxUsageLogSize);
+    if (!usage_log_write_timer_.IsRunning()) {
+      usage_log_write_timer_.Start(
+          FROM_HERE, base::TimeDelta::FromSeconds(kUsageLogWriteDelaySeconds),
+          base::Bind(&ShaderDiskCache::WriteUsageLog, base::Unretained(this)));
+    }
+  }
 }
 
 int ShaderDiskCache::Clear(
@@ -558,6 +674,11 @@ int ShaderDiskCache::Clear(
     const net::CompletionCallback& completion_callback) {
   int rv;
   if (begin_time.is_null()) {
+    if (max_prewarm_shaders_) {
+      usage_log_.clear();
+      usage_log_write_timer_.Stop();
+      WriteUsageLog();
+    }
     rv = backend_->DoomAllEntries(completion_callback);
   } else {
     rv = backend_->DoomEntriesBetween(begin_time, end_time,
@@ -585,10 +706,59 @@ void ShaderDiskCache::CacheCreatedCallback(int rv) {
     LOG(ERROR) << "Shader Cache Creation failed: " << rv;
     return;
   }
-  helper_ = new ShaderDiskReadHelper(AsWeakPtr(), host_id_);
+  if (!max_prewarm_shaders_) {
+    LoadCache(std::vector<std::string>());
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      BrowserThread::GetTaskRunnerForThread(BrowserThread::FILE).get(),
+      FROM_HERE,
+      base::Bind(&ReadUsageLog, cache_path_.Append(kGpuCacheUsageLogPath)),
+      base::Bind(&ShaderDiskCache::LoadCache, this));
+}
+
+void ShaderDiskCache::LoadCache(const std::vector<std::string>& usage_log) {
+  std::vector<std::string> keys;
+  if (max_prewarm_shaders_) {
+    // Shaders cached while the log was read are the most recently used.
+    std::vector<std::string> recent;
+    recent.swap(usage_log_);
+    usage_log_.assign(usage_log.begin(),
+                      usage_log.begin() +
+                          std::min(usage_log.size(), kMaxUsageLogSize));
+    for (auto it = recent.rbegin(); it != recent.rend(); ++it)
+      RecordUsage(&usage_log_, *it, kMaxUsageLogSize);
+    // Without a log yet, |keys| stays empty and the whole cache is loaded.
+    keys.assign(usage_log_.begin(),
+                usage_log_.begin() +
+                    std::min(usage_log_.size(), max_prewarm_shaders_));
+  }
+  helper_ = new ShaderDiskReadHelper(AsWeakPtr(), host_id_, keys);
   helper_->LoadCache();
 }
 
+void ShaderDiskCache::WriteUsageLog() {
+  std::string contents;
+  for (const std::string& key : usage_log_)
+    contents += key + "\n";
+  BrowserThread::PostTask(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&WriteUsageLogToFile,
+                 cache_path_.Append(kGpuCacheUsageLogPath), contents));
+}
+
+// static
+void ShaderDiskCache::RecordUsage(std::vector<std::string>* usage_log,
+                                  const std::string& key,
+                                  size_t max_size) {
+  auto it = std::find(usage_log->begin(), usage_log->end(), key);
+  if (it != usage_log->end())
+    usage_log->erase(it);
+  usage_log->insert(usage_log->begin(), key);
+  if (usage_log->size() > max_size)
+    usage_log->resize(max_size);
+}
+
 void ShaderDiskCache::EntryComplete(void* entry) {
   entry_map_.erase(entry);
 
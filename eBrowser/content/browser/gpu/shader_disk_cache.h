@@ -10,11 +10,13 @@
 #include <map>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/singleton.h"
+#include "base/timer/timer.h"
 #include "content/common/content_export.h"
 #include "net/disk_cache/disk_cache.h"
 
@@ -67,6 +69,12 @@ class CONTENT_EXPORT ShaderDiskCache
   // been written to the cache.
   int SetCacheCompleteCallback(const net::CompletionCallback& callback);
 
+  // Moves |key| to the front of |usage_log|, the most recently used shader
+  // keys first, and keeps at most |max_size| keys.
+  static void RecordUsage(std::vector<std::string>* usage_log,
+                          const std::string& key,
+                          size_t max_size);
+
  private:
   friend class base::RefCounted<ShaderDiskCache>;
   friend class ShaderDiskCacheEntry;
@@ -83,6 +91,13 @@ class CONTENT_EXPORT ShaderDiskCache
   void EntryComplete(void* entry);
   void ReadComplete();
 
+  // Starts loading the cached shaders into the GPU process: all of them, or
+  // with prewarming, the most recently used ones of |usage_log| in order.
+  void LoadCache(const std::vector<std::string>& usage_log);
+
+  // Persists |usage_log_| next to the cache.
+  void WriteUsageLog();
+
   bool cache_available_;
   int host_id_;
   base::FilePath cache_path_;
@@ -95,6 +110,13 @@ class CONTENT_EXPORT ShaderDiskCache
   scoped_refptr<ShaderDiskReadHelper> helper_;
   std::map<void*, scoped_refptr<ShaderDiskCacheEntry> > entry_map_;
 
+  // The number of shaders to prewarm from |usage_log_|, set by
+  // --ebrowser-shader-cache-prewarm, or 0 to load the whole cache.
+  size_t max_prewarm_shaders_;
+  // Keys of the shaders the GPU process cached, most recently used first.
+  std::vector<std::string> usage_log_;
+  base::OneShotTimer usage_log_write_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(ShaderDiskCache);
 };
 
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string>
+#include <vector>
+
 #include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/threading/thread.h"
@@ -73,4 +76,20 @@ TEST_F(ShaderDiskCacheTest, ClearsCache) {
   EXPECT_EQ(0, cache->Size());
 };
 
+TEST(ShaderDiskCacheUsageTest, RecordUsage) {
+  std::vector<std::string> usage_log;
+  ShaderDiskCache::RecordUsage(&usage_log, "a", 3);
+  ShaderDiskCache::RecordUsage(&usage_log, "b", 3);
+  ShaderDiskCache::RecordUsage(&usage_log, "c", 3);
+  EXPECT_EQ((std::vector<std::string>{"c", "b", "a"}), usage_log);
+
+  // Using a logged shader again moves it to the front without duplicating it.
+  ShaderDiskCache::RecordUsage(&usage_log, "a", 3);
+  EXPECT_EQ((std::vector<std::string>{"a", "c", "b"}), usage_log);
+
+  // The least recently used shader falls off the end.
+  ShaderDiskCache::RecordUsage(&usage_log, "d", 3);
+  EXPECT_EQ((std::vector<std::string>{"d", "a", "c"}), usage_log);
+}
+
 }  // namespace content
@@ -17,6 +17,7 @@
 #include "base/threading/thread.h"
 #include "base/threading/thread_restrictions.h"
 #include "content/browser/histogram_controller.h"
+#include "content/browser/subprocess_histogram_merger.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/histogram_fetcher.h"
 #include "content/public/common/content_constants.h"
@@ -244,6 +245,11 @@ void HistogramSynchronizer::RegisterAndNotifyAllProcesses(
 
   RequestContext::Register(callback, sequence_number);
 
+  // Children's histograms in shared memory are read directly; the rest come
+  // over IPC.
+  if (SubprocessHistogramMerger::GetInstance())
+    SubprocessHistogramMerger::GetInstance()->MergeHistogramDeltas();
+
   // Get histogram data from renderer and browser child processes.
   HistogramController::GetInstance()->GetHistogramData(sequence_number);
 
@@ -7,8 +7,10 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <limits>
 #include <utility>
 
+#include "base/memory/shared_memory.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
@@ -37,8 +39,40 @@ namespace content {
 namespace {
 const int32_t kNoCursor = -1;
 const int64_t kNoTransaction = -1;
+
+// Prefetched values with more bits than this in total are shipped in shared
+// memory: copied once, rather than pickled into the message, written through
+// the channel and unpickled again.
+const size_t kPrefetchSharedMemoryThreshold = 32 * 1024;
+
+// Packs the bits of |values|, |bits_size| bytes in all, into a read-only
+// region shared with |process|. Leaves |params| untouched on failure.
+bool PackPrefetchValues(
+    const std::vector<IndexedDBValue>& values,
+    size_t bits_size,
+    base::ProcessHandle process,
+    IndexedDBMsg_CallbacksSuccessCursorPrefetch_Params* params) {
+  base::SharedMemory shared_memory;
+  if (bits_size > std::numeric_limits<uint32_t>::max() ||
+      !shared_memory.CreateAndMapAnonymous(bits_size)) {
+    return false;
+  }
+  char* data = static_cast<char*>(shared_memory.memory());
+  std::vector<uint32_t> value_sizes;
+  value_sizes.reserve(values.size());
+  for (const auto& value : values) {
+    std::copy(value.bits.begin(), value.bits.end(), data);
+    data += value.bits.size();
+    value_sizes.push_back(static_cast<uint32_t>(value.bits.size()));
+  }
+  if (!shared_memory.ShareReadOnlyToProcess(process, &params->values_buffer))
+    return false;
+  params->value_sizes.swap(value_sizes);
+  return true;
 }
 
+}  // namespace
+
 class IndexedDBCallbacks::IOThreadHelper {
  public:
   explicit IOThreadHelper(CallbacksAssociatedPtrInfo callbacks_info);
@@ -475,11 +509,28 @@ void IndexedDBCallbacks::OnSuccessWithPrefetch(
   params->primary_keys = msg_primary_keys;
   params->values.resize(values->size());
 
+  size_t bits_size = 0;
   bool found_blob_info = false;
+  for (const auto& value : *values) {
+    bits_size += value.bits.size();
+    found_blob_info |= !value.blob_info.empty();
+  }
+  // Batches with blobs are finished on the IO thread, which may drop them, so
+  // they always go inline.
+  if (!found_blob_info && bits_size > kPrefetchSharedMemoryThreshold &&
+      PackPrefetchValues(*values, bits_size, dispatcher_host_->PeerHandle(),
+                         params.get())) {
+    UMA_HISTOGRAM_COUNTS_10000("WebCore.IndexedDB.PrefetchSharedMemoryKB",
+                               bits_size / 1024);
+    dispatcher_host_->Send(
+        new IndexedDBMsg_CallbacksSuccessCursorPrefetch(*params.get()));
+    dispatcher_host_ = nullptr;
+    return;
+  }
+
   for (size_t i = 0; i < values->size(); ++i) {
     params->values[i].bits.swap(values->at(i).bits);
     if (!values->at(i).blob_info.empty()) {
-      found_blob_info = true;
       FillInBlobData(values->at(i).blob_info,
                      &params->values[i].blob_or_file_info);
       for (const auto& blob_iter : values->at(i).blob_info) {
@@ -17,6 +17,7 @@
 #include "content/browser/loader/resource_request_info_impl.h"
 #include "content/common/resource_request_completion_status.h"
 #include "content/public/browser/resource_dispatcher_host_delegate.h"
+#include "content/public/common/content_switches.h"
 #include "content/public/common/resource_response.h"
 #include "mojo/public/c/system/data_pipe.h"
 #include "mojo/public/cpp/system/data_pipe.h"
@@ -30,6 +31,9 @@ namespace {
 
 int g_allocation_size = MojoAsyncResourceHandler::kDefaultAllocationSize;
 
+// Whether body data pipes are sized to the expected content size.
+bool g_size_data_pipes_to_content = false;
+
 // MimeTypeResourceHandler *implicitly* requires that the buffer size
 // returned from OnWillRead should be larger than certain size.
 // TODO(yhirano): Fix MimeTypeResourceHandler.
@@ -51,6 +55,9 @@ void InitializeResourceBufferConstants() {
   did_init = true;
 
   GetNumericArg("resource-buffer-size", &g_allocation_size);
+  g_size_data_pipes_to_content =
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEBrowserSizedBodyDataPipes);
 }
 
 }  // namespace
@@ -108,7 +115,8 @@ MojoAsyncResourceHandler::MojoAsyncResourceHandler(
     : ResourceHandler(request),
       rdh_(rdh),
       binding_(this, std::move(mojo_request)),
-      url_loader_client_(std::move(url_loader_client)) {
+      url_loader_client_(std::move(url_loader_client)),
+      max_chunk_size_(kMaxChunkSize) {
   DCHECK(url_loader_client_);
   InitializeResourceBufferConstants();
 }
@@ -162,6 +170,14 @@ bool MojoAsyncResourceHandler::OnWillRead(scoped_refptr<net::IOBuffer>* buf,
     options.flags = MOJO_CREATE_DATA_PIPE_OPTIONS_FLAG_NONE;
     options.element_num_bytes = 1;
     options.capacity_num_bytes = g_allocation_size;
+    if (g_size_data_pipes_to_content) {
+      // With room for the whole body, the network layer reads straight into
+      // contiguous pipe memory that the renderer consumes in place, in as few
+      // chunks as the network delivers.
+      options.capacity_num_bytes = CalculateSizedAllocationSize(
+          g_allocation_size, request()->GetExpectedContentSize());
+      max_chunk_size_ = options.capacity_num_bytes;
+    }
     mojo::DataPipe data_pipe(options);
 
     url_loader_client_->OnStartLoadingResponseBody(
@@ -249,12 +265,24 @@ void MojoAsyncResourceHandler::SetAllocationSizeForTesting(size_t size) {
   g_allocation_size = size;
 }
 
+// static
+size_t MojoAsyncResourceHandler::CalculateSizedAllocationSize(
+    size_t default_size,
+    int64_t expected_content_size) {
+  if (expected_content_size <= static_cast<int64_t>(default_size))
+    return default_size;
+  if (expected_content_size >= static_cast<int64_t>(kMaxSizedAllocationSize))
+    return kMaxSizedAllocationSize;
+  size_t size = static_cast<size_t>(expected_content_size);
+  return (size + kMaxChunkSize - 1) / kMaxChunkSize * kMaxChunkSize;
+}
+
 MojoResult MojoAsyncResourceHandler::BeginWrite(void** data,
                                                 uint32_t* available) {
   MojoResult result = mojo::BeginWriteDataRaw(
       shared_writer_->writer(), data, available, MOJO_WRITE_DATA_FLAG_NONE);
   if (result == MOJO_RESULT_OK)
-    *available = std::min(*available, static_cast<uint32_t>(kMaxChunkSize));
+    *available = std::min(*available, static_cast<uint32_t>(max_chunk_size_));
   return result;
 }
 
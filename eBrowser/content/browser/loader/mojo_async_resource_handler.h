@@ -74,6 +74,16 @@ class CONTENT_EXPORT MojoAsyncResourceHandler
   static void SetAllocationSizeForTesting(size_t size);
   static constexpr size_t kDefaultAllocationSize = 512 * 1024;
 
+  // The largest body data pipe allocated for a response whose size is known.
+  static constexpr size_t kMaxSizedAllocationSize = 4 * 1024 * 1024;
+
+  // Returns the capacity of the body data pipe for a response of
+  // |expected_content_size| bytes, or -1 if unknown, when pipes are sized to
+  // their content: large enough to hold the whole body, rounded up to whole
+  // write chunks, and between |default_size| and kMaxSizedAllocationSize.
+  static size_t CalculateSizedAllocationSize(size_t default_size,
+                                             int64_t expected_content_size);
+
  protected:
   // These functions can be overriden only for tests.
   virtual MojoResult BeginWrite(void** data, uint32_t* available);
@@ -112,6 +122,8 @@ class CONTENT_EXPORT MojoAsyncResourceHandler
   scoped_refptr<net::IOBufferWithSize> buffer_;
   size_t buffer_offset_ = 0;
   size_t buffer_bytes_read_ = 0;
+  // The most bytes handed to the network layer per read.
+  size_t max_chunk_size_;
   scoped_refptr<SharedWriter> shared_writer_;
 
   DISALLOW_COPY_AND_ASSIGN(MojoAsyncResourceHandler);
@@ -1134,6 +1134,24 @@ TEST_P(
   EXPECT_EQ("B", body);
 }
 
+TEST(MojoAsyncResourceHandlerSizedAllocationTest, SizesToContent) {
+  const size_t kDefault = MojoAsyncResourceHandler::kDefaultAllocationSize;
+  const size_t kMax = MojoAsyncResourceHandler::kMaxSizedAllocationSize;
+  // Unknown and small bodies use the default size.
+  EXPECT_EQ(kDefault, MojoAsyncResourceHandler::CalculateSizedAllocationSize(
+                          kDefault, -1));
+  EXPECT_EQ(kDefault, MojoAsyncResourceHandler::CalculateSizedAllocationSize(
+                          kDefault, 1000));
+  // Larger bodies are rounded up to whole 32kB chunks.
+  EXPECT_EQ(768u * 1024, MojoAsyncResourceHandler::CalculateSizedAllocationSize(
+                             kDefault, 768 * 1024));
+  EXPECT_EQ(800u * 1024, MojoAsyncResourceHandler::CalculateSizedAllocationSize(
+                             kDefault, 768 * 1024 + 1));
+  // Huge bodies are capped.
+  EXPECT_EQ(kMax, MojoAsyncResourceHandler::CalculateSizedAllocationSize(
+                      kDefault, 100 * 1024 * 1024));
+}
+
 INSTANTIATE_TEST_CASE_P(MojoAsyncResourceHandlerWithAllocationSizeTest,
                         MojoAsyncResourceHandlerWithAllocationSizeTest,
                         ::testing::Values(8, 32 * 2014));
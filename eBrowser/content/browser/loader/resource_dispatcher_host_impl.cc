@@ -1836,6 +1836,13 @@ void ResourceDispatcherHostImpl::OnRenderViewHostSetIsLoading(int child_id,
   scheduler_->OnLoadingStateChanged(child_id, route_id, !is_loading);
 }
 
+void ResourceDispatcherHostImpl::OnRenderViewHostUserInteractionChanged(
+    int child_id,
+    int route_id,
+    bool is_interacting) {
+  scheduler_->OnUserInteractionChanged(child_id, route_id, is_interacting);
+}
+
 void ResourceDispatcherHostImpl::MarkAsTransferredNavigation(
     const GlobalRequestID& id,
     const base::Closure& on_transfer_complete_callback) {
@@ -192,6 +192,11 @@ class CONTENT_EXPORT ResourceDispatcherHostImpl
                                     int route_id,
                                     bool is_loading);
 
+  // Called when the user starts or stops interacting with a RenderViewHost.
+  void OnRenderViewHostUserInteractionChanged(int child_id,
+                                              int route_id,
+                                              bool is_interacting);
+
   // Force cancels any pending requests for the given process.
   void CancelRequestsForProcess(int child_id);
 
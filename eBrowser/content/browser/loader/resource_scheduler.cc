@@ -10,16 +10,21 @@
 #include <utility>
 #include <vector>
 
+#include "base/auto_reset.h"
+#include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/macros.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/supports_user_data.h"
+#include "base/timer/timer.h"
 #include "content/common/resource_messages.h"
 #include "content/public/browser/resource_controller.h"
 #include "content/public/browser/resource_request_info.h"
 #include "content/public/browser/resource_throttle.h"
+#include "content/public/common/content_switches.h"
 #include "net/base/host_port_pair.h"
 #include "net/base/load_flags.h"
 #include "net/base/request_priority.h"
@@ -79,6 +84,11 @@ static const net::RequestPriority
 // requests should be blocked.
 static const size_t kInFlightNonDelayableRequestCountPerClientThreshold = 1;
 
+// The priority level at or below which delayable requests, such as prefetches
+// and offscreen images, are batched when radio batching is enabled.
+static const net::RequestPriority
+    kBatchablePriorityThreshold = net::LOWEST;
+
 struct ResourceScheduler::RequestPriorityParams {
   RequestPriorityParams()
     : priority(net::DEFAULT_PRIORITY),
@@ -312,9 +322,11 @@ void ResourceScheduler::RequestQueue::Insert(
 // Each client represents a tab.
 class ResourceScheduler::Client {
  public:
-  explicit Client(bool priority_requests_delayable)
-      : is_loaded_(false),
+  Client(ResourceScheduler* scheduler, bool priority_requests_delayable)
+      : scheduler_(scheduler),
+        is_loaded_(false),
         has_html_body_(false),
+        is_user_interacting_(false),
         using_spdy_proxy_(false),
         in_flight_delayable_count_(0),
         total_layout_blocking_count_(0),
@@ -372,10 +384,22 @@ class ResourceScheduler::Client {
 
   bool is_loaded() const { return is_loaded_; }
 
+  bool has_in_flight_requests() const { return !in_flight_requests_.empty(); }
+
+  void LoadBatchedRequests() { LoadAnyStartablePendingRequests(); }
+
   void OnLoadingStateChanged(bool is_loaded) {
     is_loaded_ = is_loaded;
   }
 
+  void OnUserInteractionChanged(bool is_interacting) {
+    if (is_user_interacting_ == is_interacting)
+      return;
+    is_user_interacting_ = is_interacting;
+    if (!is_user_interacting_)
+      LoadAnyStartablePendingRequests();
+  }
+
   void OnNavigate() {
     has_html_body_ = false;
     is_loaded_ = false;
@@ -561,6 +585,7 @@ class ResourceScheduler::Client {
                     StartMode start_mode) {
     InsertInFlightRequest(request);
     request->Start(start_mode);
+    scheduler_->OnRequestStarted();
   }
 
   // ShouldStartRequest is the main scheduling algorithm.
@@ -588,6 +613,12 @@ class ResourceScheduler::Client {
   //   * Non-delayable, High-priority and request-priority capable requests are
   //     issued immediately.
   //   * Low priority requests are delayable.
+  //   * While the user is interacting with the client, e.g. scrolling it, no
+  //     delayable requests are started. They are released together once the
+  //     interaction ends, batching their network activity.
+  //   * With radio batching, delayable requests at or below
+  //     kBatchablePriorityThreshold only start alongside other network
+  //     activity, or together once the batching window expires.
   //   * While kInFlightNonDelayableRequestCountPerClientThreshold
   //     layout-blocking requests are loading or the body tag has not yet been
   //     parsed, limit the number of delayable requests that may be in flight
@@ -633,6 +664,16 @@ class ResourceScheduler::Client {
     if (!RequestAttributesAreSet(request->attributes(), kAttributeDelayable))
       return START_REQUEST;
 
+    if (is_user_interacting_)
+      return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+
+    // Pending requests are sorted by priority, so no later request is
+    // startable either.
+    if (url_request.priority() <= kBatchablePriorityThreshold &&
+        !scheduler_->CanStartBatchableRequest()) {
+      return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+    }
+
     if (in_flight_delayable_count_ >= kMaxNumDelayableRequestsPerClient)
       return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
 
@@ -706,10 +747,13 @@ class ResourceScheduler::Client {
     }
   }
 
+  ResourceScheduler* scheduler_;
   bool is_loaded_;
   // Tracks if the main HTML parser has reached the body which marks the end of
   // layout-blocking resources.
   bool has_html_body_;
+  // True while the user is interacting with the client.
+  bool is_user_interacting_;
   bool using_spdy_proxy_;
   RequestQueue pending_requests_;
   RequestSet in_flight_requests_;
@@ -725,7 +769,18 @@ class ResourceScheduler::Client {
 
 ResourceScheduler::ResourceScheduler()
     : priority_requests_delayable_(
-          base::FeatureList::IsEnabled(kPrioritySupportedRequestsDelayable)) {}
+          base::FeatureList::IsEnabled(kPrioritySupportedRequestsDelayable)),
+      batching_timer_(new base::OneShotTimer()),
+      releasing_batch_(false) {
+  int batching_window_ms = 0;
+  if (base::StringToInt(
+          base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+              switches::kEBrowserRadioBatchingWindow),
+          &batching_window_ms) &&
+      batching_window_ms > 0) {
+    batching_window_ = base::TimeDelta::FromMilliseconds(batching_window_ms);
+  }
+}
 
 ResourceScheduler::~ResourceScheduler() {
   DCHECK(unowned_requests_.empty());
@@ -752,6 +807,7 @@ std::unique_ptr<ResourceThrottle> ResourceScheduler::ScheduleRequest(
     // 3. The tab is closed while a RequestResource IPC is in flight.
     unowned_requests_.insert(request.get());
     request->Start(START_SYNC);
+    OnRequestStarted();
     return std::move(request);
   }
 
@@ -782,7 +838,7 @@ void ResourceScheduler::OnClientCreated(int child_id,
   ClientId client_id = MakeClientId(child_id, route_id);
   DCHECK(!base::ContainsKey(client_map_, client_id));
 
-  Client* client = new Client(priority_requests_delayable_);
+  Client* client = new Client(this, priority_requests_delayable_);
   client_map_[client_id] = client;
 }
 
@@ -814,6 +870,18 @@ void ResourceScheduler::OnLoadingStateChanged(int child_id,
   client->OnLoadingStateChanged(is_loaded);
 }
 
+void ResourceScheduler::OnUserInteractionChanged(int child_id,
+                                                 int route_id,
+                                                 bool is_interacting) {
+  DCHECK(CalledOnValidThread());
+  Client* client = GetClient(child_id, route_id);
+  if (!client) {
+    // Widgets that are not views, such as popups, have no client.
+    return;
+  }
+  client->OnUserInteractionChanged(is_interacting);
+}
+
 void ResourceScheduler::OnNavigate(int child_id, int route_id) {
   DCHECK(CalledOnValidThread());
   ClientId client_id = MakeClientId(child_id, route_id);
@@ -915,6 +983,45 @@ void ResourceScheduler::ReprioritizeRequest(net::URLRequest* request,
                               new_priority_params);
 }
 
+void ResourceScheduler::SetBatchingForTesting(
+    base::TimeDelta window,
+    std::unique_ptr<base::Timer> timer) {
+  batching_window_ = window;
+  batching_timer_ = std::move(timer);
+}
+
+bool ResourceScheduler::CanStartBatchableRequest() {
+  if (batching_window_.is_zero() || releasing_batch_)
+    return true;
+  if (!unowned_requests_.empty())
+    return true;
+  for (const auto& client : client_map_) {
+    if (client.second->has_in_flight_requests())
+      return true;
+  }
+  if (!batching_timer_->IsRunning()) {
+    batching_timer_->Start(
+        FROM_HERE, batching_window_,
+        base::Bind(&ResourceScheduler::ReleaseBatchedRequests,
+                   base::Unretained(this)));
+  }
+  return false;
+}
+
+void ResourceScheduler::OnRequestStarted() {
+  // The timer only runs while requests are batched.
+  if (!releasing_batch_ && batching_timer_->IsRunning())
+    ReleaseBatchedRequests();
+}
+
+void ResourceScheduler::ReleaseBatchedRequests() {
+  DCHECK(CalledOnValidThread());
+  batching_timer_->Stop();
+  base::AutoReset<bool> releasing_batch(&releasing_batch_, true);
+  for (const auto& client : client_map_)
+    client.second->LoadBatchedRequests();
+}
+
 ResourceScheduler::ClientId ResourceScheduler::MakeClientId(
     int child_id, int route_id) {
   return (static_cast<ResourceScheduler::ClientId>(child_id) << 32) | route_id;
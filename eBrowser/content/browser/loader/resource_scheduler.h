@@ -15,10 +15,15 @@
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
 #include "content/common/content_export.h"
 #include "net/base/priority_queue.h"
 #include "net/base/request_priority.h"
 
+namespace base {
+class Timer;
+}
+
 namespace net {
 class HostPortPair;
 class URLRequest;
@@ -78,6 +83,12 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // Called when a renderer stops or restarts loading.
   void OnLoadingStateChanged(int child_id, int route_id, bool is_loaded);
 
+  // Called when the user starts or stops interacting with a renderer, e.g.
+  // scrolling it. Delayable requests are held back while interacting.
+  void OnUserInteractionChanged(int child_id,
+                                int route_id,
+                                bool is_interacting);
+
   // Signals from IPC messages directly from the renderers:
 
   // Called when a client navigates to a new main document.
@@ -104,6 +115,11 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
                            net::RequestPriority new_priority,
                            int intra_priority_value);
 
+  // Overrides the radio batching window and the timer that releases batched
+  // requests.
+  void SetBatchingForTesting(base::TimeDelta window,
+                             std::unique_ptr<base::Timer> timer);
+
  private:
   // Returns the maximum number of delayable requests to all be in-flight at
   // any point in time (across all hosts).
@@ -133,6 +149,17 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // Returns the client for the given |child_id| and |route_id| combo.
   Client* GetClient(int child_id, int route_id);
 
+  // Returns true if a batchable request may start now: batching is off, the
+  // batch is being released, or another transfer already keeps the radio
+  // awake. Otherwise arms |batching_timer_| and returns false.
+  bool CanStartBatchableRequest();
+
+  // Called when any request starts. Batched requests piggyback on it.
+  void OnRequestStarted();
+
+  // Starts the batched requests of all clients.
+  void ReleaseBatchedRequests();
+
   ClientMap client_map_;
   size_t max_num_delayable_requests_;
   RequestSet unowned_requests_;
@@ -141,6 +168,14 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // be delayed.
   bool priority_requests_delayable_;
 
+  // How long the lowest priority delayable requests may wait for other
+  // network activity before they are issued together, or zero to issue them
+  // as usual. Set by --ebrowser-radio-batching-window.
+  base::TimeDelta batching_window_;
+  // Runs while batched requests are waiting.
+  std::unique_ptr<base::Timer> batching_timer_;
+  bool releasing_batch_;
+
   DISALLOW_COPY_AND_ASSIGN(ResourceScheduler);
 };
 
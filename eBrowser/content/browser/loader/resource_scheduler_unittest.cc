@@ -398,6 +398,67 @@ TEST_F(ResourceSchedulerTest, NavigationResetsState) {
   EXPECT_FALSE(low2->started());
 }
 
+TEST_F(ResourceSchedulerTest, UserInteractionHoldsBackDelayableRequests) {
+  scheduler()->OnWillInsertBody(kChildId, kRouteId);
+  scheduler()->OnUserInteractionChanged(kChildId, kRouteId, true);
+  std::unique_ptr<TestRequest> high(
+      NewRequest("http://host/high", net::HIGHEST));
+  std::unique_ptr<TestRequest> low(NewRequest("http://host/low", net::LOWEST));
+  std::unique_ptr<TestRequest> idle(NewRequest("http://host/idle", net::IDLE));
+  std::unique_ptr<TestRequest> background(
+      NewBackgroundRequest("http://host/background", net::LOWEST));
+  EXPECT_TRUE(high->started());
+  EXPECT_FALSE(low->started());
+  EXPECT_FALSE(idle->started());
+  // Other clients are not affected.
+  EXPECT_TRUE(background->started());
+
+  scheduler()->OnUserInteractionChanged(kChildId, kRouteId, false);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(low->started());
+  EXPECT_TRUE(idle->started());
+}
+
+TEST_F(ResourceSchedulerTest, RadioBatchingReleasesLowestRequestsTogether) {
+  mock_timer_ = new base::MockTimer(false, false);
+  scheduler()->SetBatchingForTesting(base::TimeDelta::FromSeconds(1),
+                                     base::WrapUnique(mock_timer_));
+  scheduler()->OnWillInsertBody(kChildId, kRouteId);
+  std::unique_ptr<TestRequest> lowest(
+      NewRequest("http://host/lowest", net::LOWEST));
+  std::unique_ptr<TestRequest> idle(NewRequest("http://host/idle", net::IDLE));
+  EXPECT_FALSE(lowest->started());
+  EXPECT_FALSE(idle->started());
+
+  FireCoalescingTimer();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(lowest->started());
+  EXPECT_TRUE(idle->started());
+}
+
+TEST_F(ResourceSchedulerTest, RadioBatchingPiggybacksOnActiveTransfers) {
+  mock_timer_ = new base::MockTimer(false, false);
+  scheduler()->SetBatchingForTesting(base::TimeDelta::FromSeconds(1),
+                                     base::WrapUnique(mock_timer_));
+  scheduler()->OnWillInsertBody(kChildId, kRouteId);
+  std::unique_ptr<TestRequest> idle(NewRequest("http://host/idle", net::IDLE));
+  EXPECT_FALSE(idle->started());
+  EXPECT_TRUE(mock_timer_->IsRunning());
+
+  // A request of another client wakes the radio, so the batch goes with it.
+  std::unique_ptr<TestRequest> background(
+      NewBackgroundRequest("http://host/background", net::HIGHEST));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(background->started());
+  EXPECT_TRUE(idle->started());
+  EXPECT_FALSE(mock_timer_->IsRunning());
+
+  // While transfers are active, new batchable requests start right away.
+  std::unique_ptr<TestRequest> lowest(
+      NewRequest("http://host/lowest", net::LOWEST));
+  EXPECT_TRUE(lowest->started());
+}
+
 TEST_F(ResourceSchedulerTest, BackgroundRequestStartsImmediately) {
   const int route_id = 0;  // Indicates a background request.
   std::unique_ptr<TestRequest> request(
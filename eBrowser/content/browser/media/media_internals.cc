@@ -723,6 +723,9 @@ void MediaInternals::UpdateVideoCaptureDeviceCapabilities(
     device_dict->SetString("id", descriptor.device_id);
     device_dict->SetString("name", descriptor.GetNameAndModel());
     device_dict->Set("formats", format_list);
+    auto power_saving = video_capture_power_saving_.find(descriptor.device_id);
+    if (power_saving != video_capture_power_saving_.end())
+      device_dict->SetString("powerSaving", power_saving->second);
 #if defined(OS_WIN) || defined(OS_MACOSX) || defined(OS_LINUX) || \
     defined(OS_ANDROID)
     device_dict->SetString("captureApi", descriptor.GetCaptureApiTypeString());
@@ -733,6 +736,25 @@ void MediaInternals::UpdateVideoCaptureDeviceCapabilities(
   SendVideoCaptureDeviceCapabilities();
 }
 
+void MediaInternals::UpdateVideoCapturePowerSaving(
+    const std::string& device_id,
+    const std::string& power_saving) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  video_capture_power_saving_[device_id] = power_saving;
+
+  for (size_t i = 0; i < video_capture_capabilities_cached_data_.GetSize();
+       ++i) {
+    base::DictionaryValue* device_dict = nullptr;
+    std::string id;
+    if (video_capture_capabilities_cached_data_.GetDictionary(i,
+                                                              &device_dict) &&
+        device_dict->GetString("id", &id) && id == device_id) {
+      device_dict->SetString("powerSaving", power_saving);
+    }
+  }
+  SendVideoCaptureDeviceCapabilities();
+}
+
 std::unique_ptr<media::AudioLog> MediaInternals::CreateAudioLog(
     AudioComponent component) {
   base::AutoLock auto_lock(lock_);
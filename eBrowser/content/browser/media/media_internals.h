@@ -79,6 +79,11 @@ class CONTENT_EXPORT MediaInternals
                                    media::VideoCaptureFormats>>&
           descriptors_and_formats);
 
+  // Called with the capture format a camera is started with while power
+  // saving lowers it, or "off", shown with the device's capabilities.
+  void UpdateVideoCapturePowerSaving(const std::string& device_id,
+                                     const std::string& power_saving);
+
   // AudioLogFactory implementation.  Safe to call from any thread.
   std::unique_ptr<media::AudioLog> CreateAudioLog(
       AudioComponent component) override;
@@ -130,6 +135,9 @@ class CONTENT_EXPORT MediaInternals
 
   // Must only be accessed on the IO thread.
   base::ListValue video_capture_capabilities_cached_data_;
+  // The last UpdateVideoCapturePowerSaving() of each device, kept across
+  // enumerations.
+  std::map<std::string, std::string> video_capture_power_saving_;
 
   NotificationRegistrar registrar_;
 
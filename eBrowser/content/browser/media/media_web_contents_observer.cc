@@ -10,9 +10,13 @@
 #include "build/build_config.h"
 #include "content/browser/media/audible_metrics.h"
 #include "content/browser/media/audio_stream_monitor.h"
+#include "content/browser/renderer_host/render_widget_host_view_base.h"
 #include "content/browser/web_contents/web_contents_impl.h"
+#include "content/common/input_messages.h"
 #include "content/common/media/media_player_delegate_messages.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_view_host.h"
+#include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/web_contents.h"
 #include "device/power_save_blocker/power_save_blocker.h"
 #include "ipc/ipc_message_macros.h"
@@ -28,7 +32,8 @@ static base::LazyInstance<AudibleMetrics>::Leaky g_audible_metrics =
 
 MediaWebContentsObserver::MediaWebContentsObserver(WebContents* web_contents)
     : WebContentsObserver(web_contents),
-      session_controllers_manager_(this) {}
+      session_controllers_manager_(this),
+      video_playing_reported_(false) {}
 
 MediaWebContentsObserver::~MediaWebContentsObserver() {}
 
@@ -58,6 +63,13 @@ void MediaWebContentsObserver::MaybeUpdateAudibleState() {
 
   g_audible_metrics.Get().UpdateAudibleWebContentsState(
       web_contents(), audio_stream_monitor->IsCurrentlyAudible());
+
+  // Lets the view's frame rate budget slow audible pages the user cannot see
+  // much of. Given every time, as the view changes across navigations.
+  RenderWidgetHostViewBase* view = static_cast<RenderWidgetHostViewBase*>(
+      web_contents()->GetRenderWidgetHostView());
+  if (view)
+    view->SetAudible(audio_stream_monitor->WasRecentlyAudible());
 }
 
 bool MediaWebContentsObserver::OnMessageReceived(
@@ -105,6 +117,7 @@ void MediaWebContentsObserver::OnMediaPaused(RenderFrameHost* render_frame_host,
   const bool removed_video =
       RemoveMediaPlayerEntry(player_id, &active_video_players_);
   MaybeReleasePowerSaveBlockers();
+  MaybeUpdateVideoPlaying();
 
   if (removed_audio || removed_video) {
     // Notify observers the player has been "paused".
@@ -145,6 +158,7 @@ void MediaWebContentsObserver::OnMediaPlaying(
 
   if (has_video) {
     AddMediaPlayerEntry(id, &active_video_players_);
+    MaybeUpdateVideoPlaying();
 
     // If we're not hidden and have just created a player, create a blocker.
     if (!video_power_save_blocker_ &&
@@ -171,6 +185,7 @@ void MediaWebContentsObserver::ClearPowerSaveBlockers(
   RemoveAllMediaPlayerEntries(render_frame_host, &active_video_players_,
                               &removed_players);
   MaybeReleasePowerSaveBlockers();
+  MaybeUpdateVideoPlaying();
 
   // Notify all observers the player has been "paused".
   WebContentsImpl* wci = static_cast<WebContentsImpl*>(web_contents());
@@ -178,6 +193,19 @@ void MediaWebContentsObserver::ClearPowerSaveBlockers(
     wci->MediaStoppedPlaying(id);
 }
 
+void MediaWebContentsObserver::MaybeUpdateVideoPlaying() {
+  const bool video_playing = !active_video_players_.empty();
+  if (video_playing == video_playing_reported_)
+    return;
+  RenderViewHost* render_view_host = web_contents()->GetRenderViewHost();
+  if (!render_view_host)
+    return;
+  RenderWidgetHost* widget = render_view_host->GetWidget();
+  video_playing_reported_ = video_playing;
+  widget->Send(new InputMsg_SetVideoPlaying(widget->GetRoutingID(),
+                                            video_playing));
+}
+
 void MediaWebContentsObserver::CreateAudioPowerSaveBlocker() {
   DCHECK(!audio_power_save_blocker_);
   audio_power_save_blocker_.reset(new device::PowerSaveBlocker(
@@ -88,6 +88,10 @@ class CONTENT_EXPORT MediaWebContentsObserver : public WebContentsObserver {
   // is empty.
   void MaybeReleasePowerSaveBlockers();
 
+  // Tells the main frame's input handler whether a video is playing, so that
+  // gestures are not throttled below the rate video needs.
+  void MaybeUpdateVideoPlaying();
+
   // Helper methods for adding or removing player entries in |player_map|.
   using PlayerSet = std::set<int>;
   using ActiveMediaPlayerMap = std::map<RenderFrameHost*, PlayerSet>;
@@ -110,6 +114,9 @@ class CONTENT_EXPORT MediaWebContentsObserver : public WebContentsObserver {
 
   MediaSessionControllersManager session_controllers_manager_;
 
+  // The state last sent by MaybeUpdateVideoPlaying().
+  bool video_playing_reported_;
+
   DISALLOW_COPY_AND_ASSIGN(MediaWebContentsObserver);
 };
 
@@ -56,7 +56,8 @@ void MemoryCoordinatorHandleImpl::AddChild(
 }
 
 MemoryCoordinator::MemoryCoordinator()
-    : delegate_(GetContentClient()->browser()->GetMemoryCoordinatorDelegate()) {
+    : delegate_(GetContentClient()->browser()->GetMemoryCoordinatorDelegate()),
+      power_saving_(false) {
 }
 
 MemoryCoordinator::~MemoryCoordinator() {}
@@ -92,6 +93,9 @@ bool MemoryCoordinator::SetMemoryState(int render_process_id,
   if (!iter->second.handle->child().is_bound())
     return false;
 
+  if (power_saving_ && CanSuspendRenderer(render_process_id))
+    memory_state = mojom::MemoryState::POWER_SAVING;
+
   // A nop doesn't need to be sent, but is considered successful.
   if (iter->second.memory_state == memory_state)
     return true;
@@ -102,7 +106,8 @@ bool MemoryCoordinator::SetMemoryState(int render_process_id,
     return false;
 
   // Can't suspend the given renderer.
-  if (memory_state == mojom::MemoryState::SUSPENDED &&
+  if ((memory_state == mojom::MemoryState::SUSPENDED ||
+       memory_state == mojom::MemoryState::POWER_SAVING) &&
       !CanSuspendRenderer(render_process_id))
     return false;
 
@@ -120,6 +125,22 @@ mojom::MemoryState MemoryCoordinator::GetMemoryState(
   return iter->second.memory_state;
 }
 
+void MemoryCoordinator::SetPowerSaving(bool power_saving) {
+  if (power_saving_ == power_saving)
+    return;
+  power_saving_ = power_saving;
+
+  mojom::MemoryState state = ToMojomMemoryState(GetCurrentMemoryState());
+  if (state == mojom::MemoryState::UNKNOWN)
+    state = mojom::MemoryState::NORMAL;
+  for (auto& iter : children()) {
+    if (power_saving ||
+        iter.second.memory_state == mojom::MemoryState::POWER_SAVING) {
+      SetMemoryState(iter.first, state);
+    }
+  }
+}
+
 base::MemoryState MemoryCoordinator::GetCurrentMemoryState() const {
   return base::MemoryState::UNKNOWN;
 }
@@ -149,6 +170,24 @@ bool MemoryCoordinator::CanThrottleRenderer(int render_process_id) {
   return render_process_host->IsProcessBackgrounded();
 }
 
+// static
+mojom::MemoryState MemoryCoordinator::ToMojomMemoryState(
+    base::MemoryState state) {
+  switch (state) {
+    case base::MemoryState::UNKNOWN:
+      return mojom::MemoryState::UNKNOWN;
+    case base::MemoryState::NORMAL:
+      return mojom::MemoryState::NORMAL;
+    case base::MemoryState::THROTTLED:
+      return mojom::MemoryState::THROTTLED;
+    case base::MemoryState::SUSPENDED:
+      return mojom::MemoryState::SUSPENDED;
+    default:
+      NOTREACHED();
+      return mojom::MemoryState::UNKNOWN;
+  }
+}
+
 bool MemoryCoordinator::CanSuspendRenderer(int render_process_id) {
   // If there is no delegate (i.e. tests), renderers are always suspendable.
   if (!delegate_)
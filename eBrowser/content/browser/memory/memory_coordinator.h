@@ -50,6 +50,11 @@ class CONTENT_EXPORT MemoryCoordinator {
   // if the process is not tracked by this coordinator.
   mojom::MemoryState GetMemoryState(int render_process_id) const;
 
+  // While |power_saving| is set, every child that can be suspended is kept in
+  // POWER_SAVING whatever state it is asked to be in. Clearing it returns those
+  // children to the current memory state.
+  void SetPowerSaving(bool power_saving);
+
   // Called when ChildMemoryCoordinator calls AddChild().
   virtual void OnChildAdded(int render_process_id) {}
 
@@ -74,6 +79,8 @@ class CONTENT_EXPORT MemoryCoordinator {
   // Returns true when a given renderer can be suspended.
   bool CanSuspendRenderer(int render_process_id);
 
+  static mojom::MemoryState ToMojomMemoryState(base::MemoryState state);
+
   // Stores information about any known child processes.
   struct ChildInfo {
     // This object must be compatible with STL containers.
@@ -103,6 +110,8 @@ private:
 
   std::unique_ptr<MemoryCoordinatorDelegate> delegate_;
 
+  bool power_saving_;
+
   DISALLOW_COPY_AND_ASSIGN(MemoryCoordinator);
 };
 
@@ -30,22 +30,6 @@ const int kDefaultNewRenderersBackToThrottled = 3;
 const int kDefaultMinimumTransitionPeriodSeconds = 30;
 const int kDefaultMonitoringIntervalSeconds = 5;
 
-mojom::MemoryState ToMojomMemoryState(base::MemoryState state) {
-  switch (state) {
-    case base::MemoryState::UNKNOWN:
-      return mojom::MemoryState::UNKNOWN;
-    case base::MemoryState::NORMAL:
-      return mojom::MemoryState::NORMAL;
-    case base::MemoryState::THROTTLED:
-      return mojom::MemoryState::THROTTLED;
-    case base::MemoryState::SUSPENDED:
-      return mojom::MemoryState::SUSPENDED;
-    default:
-      NOTREACHED();
-      return mojom::MemoryState::UNKNOWN;
-  }
-}
-
 }  // namespace
 
 // SingletonTraits for MemoryCoordinator. Returns MemoryCoordinatorImpl
@@ -136,4 +136,24 @@ TEST_F(MemoryCoordinatorTest, SetMemoryStateDelivered) {
   EXPECT_EQ(mojom::MemoryState::SUSPENDED, cmc2->state());
 }
 
+TEST_F(MemoryCoordinatorTest, PowerSavingOverridesState) {
+  TestMemoryCoordinator mc;
+  auto cmc1 = mc.CreateChildMemoryCoordinator(1);
+
+  mc.SetPowerSaving(true);
+  RunUntilIdle();
+  EXPECT_EQ(1, cmc1->on_state_change_calls());
+  EXPECT_EQ(mojom::MemoryState::POWER_SAVING, cmc1->state());
+
+  // Other states do not take the child out of power saving.
+  EXPECT_TRUE(mc.SetMemoryState(1, mojom::MemoryState::THROTTLED));
+  EXPECT_EQ(1, cmc1->on_state_change_calls());
+  EXPECT_EQ(mojom::MemoryState::POWER_SAVING, cmc1->state());
+
+  mc.SetPowerSaving(false);
+  RunUntilIdle();
+  EXPECT_EQ(2, cmc1->on_state_change_calls());
+  EXPECT_EQ(mojom::MemoryState::NORMAL, cmc1->state());
+}
+
 }  // namespace content
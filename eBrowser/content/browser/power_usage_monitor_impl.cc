@@ -8,18 +8,27 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/sys_info.h"
+#include "base/trace_event/trace_event.h"
+#include "content/browser/battery_life_governor.h"
+#include "content/browser/memory/memory_coordinator.h"
+#include "content/common/input_messages.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/notification_service.h"
 #include "content/public/browser/notification_source.h"
 #include "content/public/browser/notification_types.h"
 #include "content/public/browser/power_usage_monitor.h"
 #include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
+#include "content/public/common/content_switches.h"
 
 namespace content {
 
@@ -31,6 +40,10 @@ const int kMinUptimeMinutes = 30;
 // Minimum discharge time after which we collect the discharge rate.
 const int kMinDischargeMinutes = 30;
 
+// How far above the power-saving threshold the battery must charge before
+// renderers leave the power-saving memory state.
+const double kPowerSavingHysteresis = 0.05;
+
 class PowerUsageMonitorSystemInterface
     : public PowerUsageMonitor::SystemInterface {
  public:
@@ -116,7 +129,9 @@ PowerUsageMonitor::PowerUsageMonitor()
       tracking_discharge_(false),
       on_battery_power_(false),
       initial_battery_level_(0),
-      current_battery_level_(0) {
+      current_battery_level_(0),
+      power_saving_battery_level_(0),
+      power_saving_(false) {
 }
 
 PowerUsageMonitor::~PowerUsageMonitor() {
@@ -134,6 +149,26 @@ void PowerUsageMonitor::Start() {
   registrar_.Add(this,
                  NOTIFICATION_RENDERER_PROCESS_CLOSED,
                  NotificationService::AllBrowserContextsAndSources());
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (command_line.HasSwitch(switches::kEBrowserBatteryLifeTarget)) {
+    std::string value =
+        command_line.GetSwitchValueASCII(switches::kEBrowserBatteryLifeTarget);
+    base::TimeDelta target;
+    if (BatteryLifeGovernor::ParseTarget(value, &target))
+      battery_life_governor_.reset(new BatteryLifeGovernor(target));
+    else
+      LOG(ERROR) << "Invalid battery life target: " << value;
+  }
+  if (command_line.HasSwitch(switches::kEBrowserPowerSavingMemoryState)) {
+    std::string value = command_line.GetSwitchValueASCII(
+        switches::kEBrowserPowerSavingMemoryState);
+    int percent;
+    if (base::StringToInt(value, &percent) && percent > 0 && percent <= 100)
+      power_saving_battery_level_ = percent / 100.0;
+    else
+      LOG(ERROR) << "Invalid power saving battery level: " << value;
+  }
   subscription_ =
       device::BatteryStatusService::GetInstance()->AddCallback(callback_);
 
@@ -212,12 +247,55 @@ void PowerUsageMonitor::WallPowerConnected(double battery_level) {
   tracking_discharge_ = false;
 }
 
+// static
+bool PowerUsageMonitor::ShouldSavePower(bool power_saving,
+                                        bool on_battery_power,
+                                        double battery_level,
+                                        double threshold) {
+  if (!on_battery_power)
+    return false;
+  if (power_saving)
+    return battery_level <= threshold + kPowerSavingHysteresis;
+  return battery_level <= threshold;
+}
+
+void PowerUsageMonitor::UpdatePowerSaving(
+    const device::BatteryStatus& status) {
+  if (!power_saving_battery_level_)
+    return;
+  bool power_saving =
+      ShouldSavePower(power_saving_, status.charging == 0, status.level,
+                      power_saving_battery_level_);
+  if (power_saving == power_saving_)
+    return;
+  // The coordinator only exists with the MemoryCoordinator feature; without
+  // it there are no memory states to move renderers between.
+  MemoryCoordinator* coordinator = MemoryCoordinator::GetInstance();
+  if (!coordinator)
+    return;
+  power_saving_ = power_saving;
+  coordinator->SetPowerSaving(power_saving);
+}
+
 void PowerUsageMonitor::OnBatteryStatusUpdate(
     const device::BatteryStatus& status) {
   bool now_on_battery_power = (status.charging == 0);
   bool was_on_battery_power = on_battery_power_;
   double battery_level = status.level;
 
+  // Lets traces attribute battery discharge to the throttled gestures
+  // recorded in the same category by the renderers.
+  TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"), "BatteryStatus",
+                 "level_x10000", static_cast<int>(battery_level * 10000),
+                 "charging", now_on_battery_power ? 0 : 1);
+
+  if (battery_life_governor_ &&
+      battery_life_governor_->OnBatteryStatus(
+          now_on_battery_power, battery_level, system_interface_->Now())) {
+    SendEnergyBudget();
+  }
+  UpdatePowerSaving(status);
+
   if (now_on_battery_power == was_on_battery_power) {
     if (now_on_battery_power)
       current_battery_level_ = battery_level;
@@ -275,4 +353,17 @@ void PowerUsageMonitor::CancelPendingHistogramReporting() {
   system_interface_->CancelPendingHistogramReports();
 }
 
+void PowerUsageMonitor::SendEnergyBudget() {
+  double fraction = battery_life_governor_->full_rate_fraction();
+  TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"),
+                 "EnergyBudgetFraction_x100", static_cast<int>(fraction * 100));
+  // Widgets created later only get the budget with the next change.
+  std::unique_ptr<RenderWidgetHostIterator> widgets(
+      RenderWidgetHost::GetRenderWidgetHosts());
+  while (RenderWidgetHost* widget = widgets->GetNextHost()) {
+    widget->Send(new InputMsg_SetEnergyBudgetFraction(widget->GetRoutingID(),
+                                                      fraction));
+  }
+}
+
 }  // namespace content
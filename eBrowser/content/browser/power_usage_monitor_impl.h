@@ -5,6 +5,8 @@
 #ifndef CONTENT_BROWSER_POWER_USAGE_MONITOR_IMPL_H_
 #define CONTENT_BROWSER_POWER_USAGE_MONITOR_IMPL_H_
 
+#include <memory>
+
 #include "base/containers/hash_tables.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
@@ -19,6 +21,8 @@
 
 namespace content {
 
+class BatteryLifeGovernor;
+
 // Record statistics on power usage.
 //
 // Two main statics are recorded by this class:
@@ -32,6 +36,11 @@ namespace content {
 // * Data collection starts after system uptime exceeds 30 minutes.
 // * If the machine goes to sleep or all renderers are closed then the current
 //   measurement is cancelled.
+//
+// With --ebrowser-battery-life-target, battery updates also drive a
+// BatteryLifeGovernor, whose energy budget is sent to every renderer. With
+// --ebrowser-power-saving-memory-state, a low battery puts the background
+// renderers into the MemoryCoordinator's power-saving state.
 class CONTENT_EXPORT PowerUsageMonitor : public base::PowerObserver,
                                          public NotificationObserver {
  public:
@@ -79,6 +88,16 @@ class CONTENT_EXPORT PowerUsageMonitor : public base::PowerObserver,
   friend class PowerUsageMonitorTest;
   FRIEND_TEST_ALL_PREFIXES(PowerUsageMonitorTest, OnBatteryStatusUpdate);
   FRIEND_TEST_ALL_PREFIXES(PowerUsageMonitorTest, OnRenderProcessNotification);
+  FRIEND_TEST_ALL_PREFIXES(PowerUsageMonitorTest, ShouldSavePower);
+
+  // Returns whether renderers should be in the power-saving memory state.
+  // Once saving, it continues until wall power is connected or the battery
+  // level rises clearly above |threshold|, so a level hovering around it
+  // doesn't make renderers purge again and again.
+  static bool ShouldSavePower(bool power_saving,
+                              bool on_battery_power,
+                              double battery_level,
+                              double threshold);
 
   // Start monitoring system power usage.
   // This function may be called after a delay, see Start() for details.
@@ -92,6 +111,12 @@ class CONTENT_EXPORT PowerUsageMonitor : public base::PowerObserver,
 
   void CancelPendingHistogramReporting();
 
+  // Sends |battery_life_governor_|'s budget to the renderers of all widgets.
+  void SendEnergyBudget();
+
+  // Enters or leaves the power-saving memory state for |status|.
+  void UpdatePowerSaving(const device::BatteryStatus& status);
+
   device::BatteryStatusService::BatteryUpdateCallback callback_;
   std::unique_ptr<device::BatteryStatusService::BatteryUpdateSubscription>
       subscription_;
@@ -124,6 +149,16 @@ class CONTENT_EXPORT PowerUsageMonitor : public base::PowerObserver,
   // IDs of live renderer processes.
   base::hash_set<int> live_renderer_ids_;
 
+  // Null without --ebrowser-battery-life-target.
+  std::unique_ptr<BatteryLifeGovernor> battery_life_governor_;
+
+  // Battery level [0.0, 1.0] at which power saving starts. 0 without
+  // --ebrowser-power-saving-memory-state.
+  double power_saving_battery_level_;
+
+  // True while the MemoryCoordinator was asked to save power.
+  bool power_saving_;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(PowerUsageMonitor);
 };
@@ -166,4 +166,16 @@ TEST_F(PowerUsageMonitorTest, NoRenderersCancelsInProgressMonitoring) {
   ASSERT_EQ(0, system_interface_->discharge_percent_per_hour());
 }
 
+TEST_F(PowerUsageMonitorTest, ShouldSavePower) {
+  // Starts on battery power at or below the threshold.
+  EXPECT_FALSE(PowerUsageMonitor::ShouldSavePower(false, true, 0.25, 0.2));
+  EXPECT_TRUE(PowerUsageMonitor::ShouldSavePower(false, true, 0.2, 0.2));
+  EXPECT_FALSE(PowerUsageMonitor::ShouldSavePower(false, false, 0.1, 0.2));
+
+  // Continues a little above the threshold, stops on wall power.
+  EXPECT_TRUE(PowerUsageMonitor::ShouldSavePower(true, true, 0.22, 0.2));
+  EXPECT_FALSE(PowerUsageMonitor::ShouldSavePower(true, true, 0.3, 0.2));
+  EXPECT_FALSE(PowerUsageMonitor::ShouldSavePower(true, false, 0.1, 0.2));
+}
+
 }  // namespace content
@@ -408,6 +408,7 @@ bool PpapiPluginProcessHost::Init(const PepperPluginInfo& info) {
 #if defined(OS_MACOSX)
       switches::kEnableSandboxLogging,
 #endif
+      switches::kEnablePepperMessageBatching,
       switches::kNoSandbox,
       switches::kPpapiStartupDialog,
     };
@@ -51,12 +51,15 @@
 #include "components/display_compositor/gl_helper.h"
 #include "content/browser/gpu/browser_gpu_memory_buffer_manager.h"
 #include "content/browser/gpu/compositor_util.h"
+#include "content/browser/gpu/gpu_process_host.h"
 #include "content/browser/renderer_host/context_provider_factory_impl_android.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "content/common/gpu/client/context_provider_command_buffer.h"
+#include "content/common/gpu_host_messages.h"
 #include "content/common/host_shared_bitmap_manager.h"
 #include "content/public/browser/android/compositor.h"
 #include "content/public/browser/android/compositor_client.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/common/content_switches.h"
 #include "gpu/command_buffer/client/context_support.h"
 #include "gpu/command_buffer/client/gles2_interface.h"
@@ -235,9 +238,11 @@ class AndroidOutputSurface : public cc::OutputSurface {
     GetCommandBufferProxy()->SetLatencyInfo(frame.latency_info);
     if (frame.sub_buffer_rect.IsEmpty()) {
       context_provider_->ContextSupport()->CommitOverlayPlanes();
-    } else {
-      DCHECK(frame.sub_buffer_rect == gfx::Rect(frame.size));
+    } else if (frame.sub_buffer_rect == gfx::Rect(frame.size)) {
       context_provider_->ContextSupport()->Swap();
+    } else {
+      context_provider_->ContextSupport()->PartialSwapBuffers(
+          frame.sub_buffer_rect);
     }
   }
 
@@ -387,6 +392,13 @@ class SingleThreadTaskGraphRunner : public cc::SingleThreadTaskGraphRunner {
 base::LazyInstance<SingleThreadTaskGraphRunner> g_task_graph_runner =
     LAZY_INSTANCE_INITIALIZER;
 
+void SendGpuSwapIntervalOnIO(int interval) {
+  GpuProcessHost* host = GpuProcessHost::Get(
+      GpuProcessHost::GPU_PROCESS_KIND_SANDBOXED, false /* force_create */);
+  if (host)
+    host->Send(new GpuMsg_SetThrottledSwapInterval(interval));
+}
+
 }  // anonymous namespace
 
 // static
@@ -519,6 +531,10 @@ void CompositorImpl::CreateLayerTreeHost() {
   settings.initial_debug_state.show_fps_counter =
       command_line->HasSwitch(cc::switches::kUIShowFPSCounter);
   settings.single_thread_proxy_scheduler = true;
+  // Partial swaps are only used when the GPU surface reports support for
+  // them, so this is a no-op on drivers without it.
+  settings.renderer_settings.partial_swap_enabled =
+      command_line->HasSwitch(switches::kEBrowserPartialSwap);
 
   cc::LayerTreeHostInProcess::InitParams params;
   params.client = this;
@@ -818,6 +834,17 @@ void CompositorImpl::OnVSync(base::TimeTicks frame_time,
     root_window_->RequestVSyncUpdate();
 }
 
+void CompositorImpl::SetSwapInterval(int interval) {
+  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEBrowserThrottledSwapInterval)) {
+    return;
+  }
+  TRACE_EVENT_INSTANT1("cc", "CompositorImpl::SetSwapInterval",
+                       TRACE_EVENT_SCOPE_THREAD, "interval", interval);
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                          base::Bind(&SendGpuSwapIntervalOnIO, interval));
+}
+
 void CompositorImpl::OnNeedsBeginFramesChange(bool needs_begin_frames) {
   if (needs_begin_frames_ == needs_begin_frames)
     return;
@@ -120,6 +120,7 @@ class CONTENT_EXPORT CompositorImpl
   void OnVSync(base::TimeTicks frame_time,
                base::TimeDelta vsync_period) override;
   void SetNeedsAnimate() override;
+  void SetSwapInterval(int interval) override;
   cc::FrameSinkId GetFrameSinkId() override;
 
   void SetVisible(bool visible);
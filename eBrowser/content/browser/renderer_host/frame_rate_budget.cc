@@ -0,0 +1,86 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/frame_rate_budget.h"
+
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace content {
+
+FrameRateBudget::Rates::Rates()
+    : foreground_idle(ui::ScrollUpdatePacer::kMaxFrameRate),
+      occluded(ui::ScrollUpdatePacer::kMaxFrameRate),
+      audible_occluded(ui::ScrollUpdatePacer::kMaxFrameRate) {}
+
+// static
+bool FrameRateBudget::ParseRates(const std::string& value, Rates* rates) {
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      value, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+  if (fields.size() != 2 && fields.size() != 3)
+    return false;
+  Rates parsed;
+  if (!base::StringToInt(fields[0], &parsed.foreground_idle) ||
+      !base::StringToInt(fields[1], &parsed.occluded)) {
+    return false;
+  }
+  parsed.audible_occluded = parsed.occluded;
+  if (fields.size() == 3 &&
+      !base::StringToInt(fields[2], &parsed.audible_occluded)) {
+    return false;
+  }
+  const int max_frame_rate = ui::ScrollUpdatePacer::kMaxFrameRate;
+  if (parsed.audible_occluded < 1 ||
+      parsed.audible_occluded > parsed.occluded ||
+      parsed.occluded > parsed.foreground_idle ||
+      parsed.foreground_idle > max_frame_rate) {
+    return false;
+  }
+  *rates = parsed;
+  return true;
+}
+
+FrameRateBudget::FrameRateBudget(const Rates& rates)
+    : rates_(rates),
+      visible_(false),
+      occluded_(false),
+      interacting_(false),
+      audible_(false) {}
+
+FrameRateBudget::~FrameRateBudget() {}
+
+FrameRateBudgetLevel FrameRateBudget::level() const {
+  if (!visible_)
+    return FRAME_RATE_BUDGET_BACKGROUND;
+  if (occluded_) {
+    return audible_ ? FRAME_RATE_BUDGET_AUDIBLE_OCCLUDED
+                    : FRAME_RATE_BUDGET_OCCLUDED;
+  }
+  if (interacting_)
+    return FRAME_RATE_BUDGET_INTERACTING;
+  return FRAME_RATE_BUDGET_FOREGROUND_IDLE;
+}
+
+int FrameRateBudget::frame_rate() const {
+  switch (level()) {
+    case FRAME_RATE_BUDGET_INTERACTING:
+      return ui::ScrollUpdatePacer::kMaxFrameRate;
+    case FRAME_RATE_BUDGET_FOREGROUND_IDLE:
+      return rates_.foreground_idle;
+    case FRAME_RATE_BUDGET_OCCLUDED:
+      return rates_.occluded;
+    case FRAME_RATE_BUDGET_AUDIBLE_OCCLUDED:
+      return rates_.audible_occluded;
+    case FRAME_RATE_BUDGET_BACKGROUND:
+      return 0;
+  }
+  NOTREACHED();
+  return 0;
+}
+
+}  // namespace content
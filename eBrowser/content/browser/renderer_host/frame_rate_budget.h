@@ -0,0 +1,81 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_FRAME_RATE_BUDGET_H_
+#define CONTENT_BROWSER_RENDERER_HOST_FRAME_RATE_BUDGET_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+// How much a widget's frames are worth to the user, from most to least.
+enum FrameRateBudgetLevel {
+  // Visible, and the user is touching, typing or flinging.
+  FRAME_RATE_BUDGET_INTERACTING,
+  // Visible and on top, but without recent input.
+  FRAME_RATE_BUDGET_FOREGROUND_IDLE,
+  // Visible, but the window has lost focus to a dialog, the notification
+  // shade or another window in multi-window mode.
+  FRAME_RATE_BUDGET_OCCLUDED,
+  // Occluded while playing sound, such as a music page behind the
+  // notification shade; what the user attends to is the audio, so its frames
+  // can go much slower.
+  FRAME_RATE_BUDGET_AUDIBLE_OCCLUDED,
+  // Hidden; no BeginFrames are sent at all.
+  FRAME_RATE_BUDGET_BACKGROUND,
+};
+
+// The most BeginFrames per second a widget's renderer may turn into frames,
+// by how much the user can be attending to it. Interacting widgets are left
+// to the eBrowser frame rate models; the levels below get progressively
+// lower caps, applied in the renderer by CompositorExternalBeginFrameSource
+// on top of any gesture throttling.
+class CONTENT_EXPORT FrameRateBudget {
+ public:
+  struct Rates {
+    Rates();
+
+    int foreground_idle;
+    int occluded;
+    int audible_occluded;
+  };
+
+  // Parses the value of --ebrowser-frame-rate-budget,
+  // "<idle>,<occluded>[,<audible occluded>]" frame rates such as "30,10,2".
+  // The audible occluded rate defaults to the occluded one. The rates must be
+  // in [1, 60] and must not increase down the levels.
+  static bool ParseRates(const std::string& value, Rates* rates);
+
+  explicit FrameRateBudget(const Rates& rates);
+  ~FrameRateBudget();
+
+  void SetVisible(bool visible) { visible_ = visible; }
+  void SetOccluded(bool occluded) { occluded_ = occluded; }
+  void SetInteracting(bool interacting) { interacting_ = interacting; }
+  void SetAudible(bool audible) { audible_ = audible; }
+
+  bool audible() const { return audible_; }
+
+  FrameRateBudgetLevel level() const;
+
+  // The cap for level(); ui::ScrollUpdatePacer::kMaxFrameRate when
+  // interacting and 0 in the background.
+  int frame_rate() const;
+
+ private:
+  const Rates rates_;
+  bool visible_;
+  bool occluded_;
+  bool interacting_;
+  bool audible_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameRateBudget);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_FRAME_RATE_BUDGET_H_
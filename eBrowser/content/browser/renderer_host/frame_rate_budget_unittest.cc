@@ -0,0 +1,95 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/frame_rate_budget.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace content {
+
+TEST(FrameRateBudgetTest, ParseRates) {
+  FrameRateBudget::Rates rates;
+  EXPECT_TRUE(FrameRateBudget::ParseRates("30,10", &rates));
+  EXPECT_EQ(30, rates.foreground_idle);
+  EXPECT_EQ(10, rates.occluded);
+  EXPECT_EQ(10, rates.audible_occluded);
+  EXPECT_TRUE(FrameRateBudget::ParseRates("30,10,2", &rates));
+  EXPECT_EQ(2, rates.audible_occluded);
+  EXPECT_TRUE(FrameRateBudget::ParseRates(" 60 , 60 ", &rates));
+  EXPECT_EQ(60, rates.foreground_idle);
+
+  EXPECT_FALSE(FrameRateBudget::ParseRates("", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("30", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("30,10,5,1", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("30,10,", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("30,10,20", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("thirty,10", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("30,0", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("10,30", &rates));
+  EXPECT_FALSE(FrameRateBudget::ParseRates("90,10", &rates));
+  EXPECT_EQ(60, rates.foreground_idle);
+  EXPECT_EQ(60, rates.occluded);
+  EXPECT_EQ(60, rates.audible_occluded);
+}
+
+TEST(FrameRateBudgetTest, Levels) {
+  const int kMaxFrameRate = ui::ScrollUpdatePacer::kMaxFrameRate;
+  FrameRateBudget::Rates rates;
+  rates.foreground_idle = 30;
+  rates.occluded = 10;
+  FrameRateBudget budget(rates);
+  EXPECT_EQ(FRAME_RATE_BUDGET_BACKGROUND, budget.level());
+  EXPECT_EQ(0, budget.frame_rate());
+
+  budget.SetVisible(true);
+  EXPECT_EQ(FRAME_RATE_BUDGET_FOREGROUND_IDLE, budget.level());
+  EXPECT_EQ(30, budget.frame_rate());
+
+  budget.SetInteracting(true);
+  EXPECT_EQ(FRAME_RATE_BUDGET_INTERACTING, budget.level());
+  EXPECT_EQ(kMaxFrameRate, budget.frame_rate());
+
+  // Input that somehow reaches an occluded widget does not lift its cap.
+  budget.SetOccluded(true);
+  EXPECT_EQ(FRAME_RATE_BUDGET_OCCLUDED, budget.level());
+  EXPECT_EQ(10, budget.frame_rate());
+
+  budget.SetVisible(false);
+  EXPECT_EQ(FRAME_RATE_BUDGET_BACKGROUND, budget.level());
+  EXPECT_EQ(0, budget.frame_rate());
+}
+
+TEST(FrameRateBudgetTest, Audible) {
+  const int kMaxFrameRate = ui::ScrollUpdatePacer::kMaxFrameRate;
+  FrameRateBudget::Rates rates;
+  rates.foreground_idle = 30;
+  rates.occluded = 10;
+  rates.audible_occluded = 2;
+  FrameRateBudget budget(rates);
+  budget.SetVisible(true);
+  budget.SetAudible(true);
+  EXPECT_TRUE(budget.audible());
+
+  // Sound alone changes nothing on top.
+  EXPECT_EQ(FRAME_RATE_BUDGET_FOREGROUND_IDLE, budget.level());
+  EXPECT_EQ(30, budget.frame_rate());
+  budget.SetInteracting(true);
+  EXPECT_EQ(kMaxFrameRate, budget.frame_rate());
+
+  budget.SetOccluded(true);
+  EXPECT_EQ(FRAME_RATE_BUDGET_AUDIBLE_OCCLUDED, budget.level());
+  EXPECT_EQ(2, budget.frame_rate());
+
+  budget.SetAudible(false);
+  EXPECT_EQ(FRAME_RATE_BUDGET_OCCLUDED, budget.level());
+  EXPECT_EQ(10, budget.frame_rate());
+
+  budget.SetAudible(true);
+  budget.SetVisible(false);
+  EXPECT_EQ(FRAME_RATE_BUDGET_BACKGROUND, budget.level());
+  EXPECT_EQ(0, budget.frame_rate());
+}
+
+}  // namespace content
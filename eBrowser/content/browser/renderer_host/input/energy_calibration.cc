@@ -0,0 +1,125 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/energy_calibration.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
+#include "base/values.h"
+#include "content/common/input/synthetic_smooth_scroll_gesture_params.h"
+
+namespace content {
+
+EnergyCalibration::EnergyCalibration(Client* client,
+                                     const std::vector<int>& frame_rates,
+                                     float speed,
+                                     const gfx::Vector2dF& distance,
+                                     const gfx::PointF& anchor,
+                                     const ReportCallback& callback)
+    : client_(client),
+      frame_rates_(frame_rates),
+      speed_(speed),
+      distance_(distance),
+      anchor_(anchor),
+      callback_(callback),
+      is_running_(false),
+      current_run_(0),
+      run_frames_(0),
+      weak_ptr_factory_(this) {
+  DCHECK(client_);
+}
+
+EnergyCalibration::~EnergyCalibration() {}
+
+void EnergyCalibration::Start() {
+  DCHECK(!is_running_);
+  is_running_ = true;
+  current_run_ = 0;
+  runs_.reset(new base::ListValue());
+  if (frame_rates_.empty()) {
+    Finish(true);
+    return;
+  }
+  StartRun();
+}
+
+void EnergyCalibration::DidSwapCompositorFrame() {
+  if (is_running_)
+    ++run_frames_;
+}
+
+void EnergyCalibration::StartRun() {
+  client_->SetFixedFrameRate(current_frame_rate());
+
+  SyntheticSmoothScrollGestureParams params;
+  params.gesture_source_type = SyntheticGestureParams::TOUCH_INPUT;
+  params.anchor = anchor_;
+  params.distances.push_back(current_run_ % 2 == 0 ? distance_ : -distance_);
+  params.speed_in_pixels_s = speed_;
+  params.prevent_fling = true;
+
+  run_frames_ = 0;
+  run_start_time_ = base::TimeTicks::Now();
+  TRACE_EVENT_ASYNC_BEGIN1(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"),
+                           "EnergyCalibration::Run", this, "target_fps",
+                           current_frame_rate());
+  client_->QueueSyntheticGesture(
+      SyntheticGesture::Create(params),
+      base::Bind(&EnergyCalibration::OnRunCompleted,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+void EnergyCalibration::OnRunCompleted(SyntheticGesture::Result result) {
+  base::TimeTicks end_time = base::TimeTicks::Now();
+  TRACE_EVENT_ASYNC_END1(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"),
+                         "EnergyCalibration::Run", this, "frames",
+                         run_frames_);
+  if (result != SyntheticGesture::GESTURE_FINISHED) {
+    Finish(false);
+    return;
+  }
+
+  base::TimeDelta duration = end_time - run_start_time_;
+  std::unique_ptr<base::DictionaryValue> run(new base::DictionaryValue());
+  run->SetInteger("target_fps", current_frame_rate());
+  // Doubles, as base::Value has no 64-bit integers; exact to 2^53 us.
+  run->SetDouble("start_us", (run_start_time_ - base::TimeTicks())
+                                 .InMicrosecondsF());
+  run->SetDouble("end_us", (end_time - base::TimeTicks()).InMicrosecondsF());
+  run->SetDouble("duration_ms", duration.InMillisecondsF());
+  run->SetInteger("frames", run_frames_);
+  run->SetDouble("frames_per_second",
+                 duration > base::TimeDelta()
+                     ? run_frames_ / duration.InSecondsF()
+                     : 0);
+  runs_->Append(std::move(run));
+
+  if (++current_run_ == run_count()) {
+    Finish(true);
+    return;
+  }
+  StartRun();
+}
+
+void EnergyCalibration::Finish(bool success) {
+  is_running_ = false;
+  client_->SetFixedFrameRate(0);
+
+  std::string report;
+  if (success) {
+    base::DictionaryValue value;
+    value.Set("runs", std::move(runs_));
+    base::JSONWriter::Write(value, &report);
+  }
+  runs_.reset();
+  // The callback may delete |this|.
+  ReportCallback callback = callback_;
+  callback.Run(report);
+}
+
+}  // namespace content
@@ -0,0 +1,107 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_INPUT_ENERGY_CALIBRATION_H_
+#define CONTENT_BROWSER_RENDERER_HOST_INPUT_ENERGY_CALIBRATION_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "content/browser/renderer_host/input/synthetic_gesture.h"
+#include "content/common/content_export.h"
+#include "ui/gfx/geometry/point_f.h"
+#include "ui/gfx/geometry/vector2d_f.h"
+
+namespace base {
+class ListValue;
+}
+
+namespace content {
+
+// Runs a touch scroll at one speed with the renderer pacing every gesture at
+// each of the requested frame rates in turn, so that a power monitor such as
+// the BattOr behind PowerTracingAgent can measure the energy of a frame at
+// each rate. Each rate gets two runs, the second scrolling back over the
+// same content. Every run is an async "EnergyCalibration::Run" slice in the
+// disabled-by-default-ebrowser.energy trace category, and is reported as
+// JSON:
+//
+//   {"runs": [{"target_fps": 30, "start_us": 81723941, "end_us": 83724102,
+//              "duration_ms": 2000.2, "frames": 60,
+//              "frames_per_second": 30}, ...]}
+//
+// |start_us| and |end_us| are on the base::TimeTicks clock that traces use,
+// for cutting the power samples into runs. The lab uploads the runs with
+// their measured energy to the model server, which fits the device's
+// ui::EnergyCurve.
+class CONTENT_EXPORT EnergyCalibration {
+ public:
+  class Client {
+   public:
+    virtual ~Client() {}
+
+    // Paces every gesture at |fps|, or as the models choose if zero.
+    // Ordered with the input events of the gestures that follow.
+    virtual void SetFixedFrameRate(int fps) = 0;
+    virtual void QueueSyntheticGesture(
+        std::unique_ptr<SyntheticGesture> gesture,
+        const base::Callback<void(SyntheticGesture::Result)>& on_complete) = 0;
+  };
+
+  // Called with the report, or an empty string if a gesture failed.
+  using ReportCallback = base::Callback<void(const std::string& report)>;
+
+  // |speed| is in DIPs per second. |client| must outlive the calibration.
+  EnergyCalibration(Client* client,
+                    const std::vector<int>& frame_rates,
+                    float speed,
+                    const gfx::Vector2dF& distance,
+                    const gfx::PointF& anchor,
+                    const ReportCallback& callback);
+  ~EnergyCalibration();
+
+  void Start();
+
+  // Counts a compositor frame submitted by the renderer.
+  void DidSwapCompositorFrame();
+
+  bool is_running() const { return is_running_; }
+
+ private:
+  size_t run_count() const { return 2 * frame_rates_.size(); }
+  int current_frame_rate() const { return frame_rates_[current_run_ / 2]; }
+
+  void StartRun();
+  void OnRunCompleted(SyntheticGesture::Result result);
+  void Finish(bool success);
+
+  Client* client_;
+  const std::vector<int> frame_rates_;
+  const float speed_;
+  const gfx::Vector2dF distance_;
+  const gfx::PointF anchor_;
+  ReportCallback callback_;
+  bool is_running_;
+
+  size_t current_run_;
+  base::TimeTicks run_start_time_;
+  int run_frames_;
+
+  std::unique_ptr<base::ListValue> runs_;
+
+  base::WeakPtrFactory<EnergyCalibration> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(EnergyCalibration);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_INPUT_ENERGY_CALIBRATION_H_
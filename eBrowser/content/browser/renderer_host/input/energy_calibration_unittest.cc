@@ -0,0 +1,145 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/energy_calibration.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/macros.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+namespace {
+
+class TestClient : public EnergyCalibration::Client {
+ public:
+  TestClient() {}
+  ~TestClient() override {}
+
+  void SetFixedFrameRate(int fps) override { frame_rates_.push_back(fps); }
+
+  void QueueSyntheticGesture(
+      std::unique_ptr<SyntheticGesture> gesture,
+      const base::Callback<void(SyntheticGesture::Result)>& on_complete)
+      override {
+    EXPECT_TRUE(gesture);
+    EXPECT_TRUE(pending_callback_.is_null());
+    pending_callback_ = on_complete;
+  }
+
+  bool has_pending_gesture() const { return !pending_callback_.is_null(); }
+
+  void CompleteGesture(SyntheticGesture::Result result) {
+    ASSERT_TRUE(has_pending_gesture());
+    base::Callback<void(SyntheticGesture::Result)> callback =
+        pending_callback_;
+    pending_callback_.Reset();
+    callback.Run(result);
+  }
+
+  const std::vector<int>& frame_rates() const { return frame_rates_; }
+
+ private:
+  std::vector<int> frame_rates_;
+  base::Callback<void(SyntheticGesture::Result)> pending_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestClient);
+};
+
+}  // namespace
+
+class EnergyCalibrationTest : public testing::Test {
+ public:
+  EnergyCalibrationTest() : report_count_(0) {}
+
+  std::unique_ptr<EnergyCalibration> CreateCalibration(
+      const std::vector<int>& frame_rates) {
+    return std::unique_ptr<EnergyCalibration>(new EnergyCalibration(
+        &client_, frame_rates, 800, gfx::Vector2dF(0, -500),
+        gfx::PointF(100, 100),
+        base::Bind(&EnergyCalibrationTest::OnReport, base::Unretained(this))));
+  }
+
+  std::unique_ptr<base::DictionaryValue> ParseReport() {
+    return base::DictionaryValue::From(base::JSONReader::Read(report_));
+  }
+
+ protected:
+  TestClient client_;
+  std::string report_;
+  int report_count_;
+
+ private:
+  void OnReport(const std::string& report) {
+    report_ = report;
+    ++report_count_;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(EnergyCalibrationTest);
+};
+
+TEST_F(EnergyCalibrationTest, RunsEachRateTwice) {
+  std::unique_ptr<EnergyCalibration> calibration =
+      CreateCalibration({10, 60});
+  calibration->Start();
+  EXPECT_TRUE(calibration->is_running());
+
+  const int kFrames[] = {5, 6, 30, 31};
+  for (size_t i = 0; i < arraysize(kFrames); ++i) {
+    ASSERT_TRUE(client_.has_pending_gesture());
+    for (int frame = 0; frame < kFrames[i]; ++frame)
+      calibration->DidSwapCompositorFrame();
+    EXPECT_EQ(0, report_count_);
+    client_.CompleteGesture(SyntheticGesture::GESTURE_FINISHED);
+  }
+  EXPECT_FALSE(client_.has_pending_gesture());
+  EXPECT_FALSE(calibration->is_running());
+  EXPECT_EQ(1, report_count_);
+
+  // The models pace gestures again once done.
+  EXPECT_EQ(std::vector<int>({10, 10, 60, 60, 0}), client_.frame_rates());
+
+  std::unique_ptr<base::DictionaryValue> report = ParseReport();
+  ASSERT_TRUE(report);
+  base::ListValue* runs = nullptr;
+  ASSERT_TRUE(report->GetList("runs", &runs));
+  ASSERT_EQ(4u, runs->GetSize());
+  const int kTargets[] = {10, 10, 60, 60};
+  for (size_t i = 0; i < runs->GetSize(); ++i) {
+    base::DictionaryValue* run = nullptr;
+    ASSERT_TRUE(runs->GetDictionary(i, &run));
+    int target_fps = 0;
+    EXPECT_TRUE(run->GetInteger("target_fps", &target_fps));
+    EXPECT_EQ(kTargets[i], target_fps);
+    int frames = 0;
+    EXPECT_TRUE(run->GetInteger("frames", &frames));
+    EXPECT_EQ(kFrames[i], frames);
+    double start_us = 0;
+    double end_us = 0;
+    EXPECT_TRUE(run->GetDouble("start_us", &start_us));
+    EXPECT_TRUE(run->GetDouble("end_us", &end_us));
+    EXPECT_LE(start_us, end_us);
+  }
+}
+
+TEST_F(EnergyCalibrationTest, FailedGestureReportsNothing) {
+  std::unique_ptr<EnergyCalibration> calibration = CreateCalibration({30});
+  calibration->Start();
+  client_.CompleteGesture(
+      SyntheticGesture::GESTURE_SOURCE_TYPE_NOT_IMPLEMENTED);
+  EXPECT_FALSE(client_.has_pending_gesture());
+  EXPECT_FALSE(calibration->is_running());
+  EXPECT_EQ(1, report_count_);
+  EXPECT_TRUE(report_.empty());
+  EXPECT_EQ(std::vector<int>({30, 0}), client_.frame_rates());
+}
+
+}  // namespace content
@@ -0,0 +1,70 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/frame_latency_internals_ui.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/json/json_writer.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/values.h"
+#include "content/browser/renderer_host/input/frame_latency_log.h"
+#include "content/grit/content_resources.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_ui.h"
+#include "content/public/browser/web_ui_data_source.h"
+#include "content/public/common/url_constants.h"
+
+namespace content {
+
+namespace {
+
+const char kDataFile[] = "frame-latency-data.json";
+const char kClearFile[] = "frame-latency-clear.json";
+
+bool HandleRequestCallback(const std::string& path,
+                           const WebUIDataSource::GotDataCallback& callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  FrameLatencyLog* log = FrameLatencyLog::GetInstance();
+  if (path == kClearFile)
+    log->Clear();
+  else if (path != kDataFile)
+    return false;
+
+  base::DictionaryValue data;
+  data.Set("frames", log->AsValue().release());
+  std::string json_string;
+  base::JSONWriter::Write(data, &json_string);
+  callback.Run(base::RefCountedString::TakeString(&json_string));
+  return true;
+}
+
+}  // namespace
+
+FrameLatencyInternalsUI::FrameLatencyInternalsUI(WebUI* web_ui)
+    : WebUIController(web_ui) {
+  WebUIDataSource* html_source =
+      WebUIDataSource::Create(kChromeUIFrameLatencyInternalsHost);
+  html_source->SetJsonPath("strings.js");
+  html_source->AddResourcePath("frame_latency_internals.css",
+                               IDR_FRAME_LATENCY_INTERNALS_CSS);
+  html_source->AddResourcePath("frame_latency_internals.js",
+                               IDR_FRAME_LATENCY_INTERNALS_JS);
+  html_source->SetDefaultResource(IDR_FRAME_LATENCY_INTERNALS_HTML);
+  html_source->SetRequestFilter(base::Bind(&HandleRequestCallback));
+  WebUIDataSource::Add(web_ui->GetWebContents()->GetBrowserContext(),
+                       html_source);
+
+  // Frames are only recorded while someone is looking.
+  FrameLatencyLog::GetInstance()->AddViewer();
+}
+
+FrameLatencyInternalsUI::~FrameLatencyInternalsUI() {
+  FrameLatencyLog::GetInstance()->RemoveViewer();
+}
+
+}  // namespace content
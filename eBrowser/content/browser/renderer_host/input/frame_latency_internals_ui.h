@@ -0,0 +1,26 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_INPUT_FRAME_LATENCY_INTERNALS_UI_H_
+#define CONTENT_BROWSER_RENDERER_HOST_INPUT_FRAME_LATENCY_INTERNALS_UI_H_
+
+#include "base/macros.h"
+#include "content/public/browser/web_ui_controller.h"
+
+namespace content {
+
+// chrome://frame-latency-internals: a live per-frame breakdown of input to
+// present latency, read from FrameLatencyLog.
+class FrameLatencyInternalsUI : public WebUIController {
+ public:
+  explicit FrameLatencyInternalsUI(WebUI* web_ui);
+  ~FrameLatencyInternalsUI() override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(FrameLatencyInternalsUI);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_INPUT_FRAME_LATENCY_INTERNALS_UI_H_
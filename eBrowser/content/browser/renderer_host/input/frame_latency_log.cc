@@ -0,0 +1,108 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/frame_latency_log.h"
+
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/values.h"
+
+namespace content {
+
+namespace {
+
+base::LazyInstance<FrameLatencyLog>::Leaky g_frame_latency_log =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Adds the time from |start| to |end| as |name|, if the frame went through
+// both.
+void SetStage(base::DictionaryValue* frame,
+              const char* name,
+              base::TimeTicks start,
+              base::TimeTicks end) {
+  if (start.is_null() || end.is_null() || end < start)
+    return;
+  frame->SetDouble(name, (end - start).InMillisecondsF());
+}
+
+}  // namespace
+
+// static
+const size_t FrameLatencyLog::kMaxEntries;
+
+FrameLatencyLog::Entry::Entry()
+    : handled_on_main(false), target_frame_rate(0) {}
+
+// static
+FrameLatencyLog* FrameLatencyLog::GetInstance() {
+  return g_frame_latency_log.Pointer();
+}
+
+FrameLatencyLog::FrameLatencyLog() : viewer_count_(0), next_index_(0) {}
+
+FrameLatencyLog::~FrameLatencyLog() {}
+
+void FrameLatencyLog::AddViewer() {
+  ++viewer_count_;
+}
+
+void FrameLatencyLog::RemoveViewer() {
+  DCHECK_GT(viewer_count_, 0);
+  if (--viewer_count_ == 0)
+    Clear();
+}
+
+void FrameLatencyLog::Add(const Entry& entry) {
+  if (!is_recording())
+    return;
+  if (entries_.size() < kMaxEntries) {
+    entries_.push_back(entry);
+  } else {
+    entries_[next_index_] = entry;
+  }
+  next_index_ = (next_index_ + 1) % kMaxEntries;
+}
+
+void FrameLatencyLog::Clear() {
+  entries_.clear();
+  next_index_ = 0;
+}
+
+std::unique_ptr<base::ListValue> FrameLatencyLog::AsValue() const {
+  std::unique_ptr<base::ListValue> frames(new base::ListValue());
+  // Until the buffer wraps, the oldest entry is the first one.
+  size_t oldest = entries_.size() < kMaxEntries ? 0 : next_index_;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const Entry& entry = entries_[(oldest + i) % entries_.size()];
+    std::unique_ptr<base::DictionaryValue> frame(new base::DictionaryValue());
+    base::TimeDelta present_time = entry.present_time - base::TimeTicks();
+    frame->SetDouble("presentTime", present_time.InMillisecondsF());
+    frame->SetInteger("targetFps", entry.target_frame_rate);
+    frame->SetString("handledOn", entry.handled_on_main ? "main" : "impl");
+    SetStage(frame.get(), "input", entry.input_time, entry.browser_time);
+    SetStage(frame.get(), "pacing", entry.browser_time,
+             entry.paced_release_time);
+    SetStage(frame.get(), "handling",
+             entry.paced_release_time.is_null() ? entry.browser_time
+                                                : entry.paced_release_time,
+             entry.handled_time);
+    SetStage(frame.get(), "raster", entry.handled_time,
+             entry.renderer_swap_time);
+    SetStage(frame.get(), "submit", entry.renderer_swap_time,
+             entry.browser_received_swap_time);
+    SetStage(frame.get(), "gpuSwap", entry.browser_received_swap_time,
+             entry.gpu_swap_begin_time);
+    SetStage(frame.get(), "present", entry.gpu_swap_begin_time,
+             entry.present_time);
+    SetStage(frame.get(), "total",
+             entry.input_time.is_null() ? entry.browser_time : entry.input_time,
+             entry.present_time);
+    frames->Append(std::move(frame));
+  }
+  return frames;
+}
+
+}  // namespace content
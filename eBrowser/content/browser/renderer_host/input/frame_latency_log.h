@@ -0,0 +1,84 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_INPUT_FRAME_LATENCY_LOG_H_
+#define CONTENT_BROWSER_RENDERER_HOST_INPUT_FRAME_LATENCY_LOG_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace base {
+class ListValue;
+}
+
+namespace content {
+
+// Keeps the stage timestamps of the last |kMaxEntries| input-driven frames
+// for chrome://frame-latency-internals. Frames are only recorded while that
+// page is open, so the log costs nothing otherwise. Lives on the UI thread.
+class CONTENT_EXPORT FrameLatencyLog {
+ public:
+  // The timestamps of one presented frame, from the LatencyInfo of the input
+  // that caused it. Stages the frame didn't go through stay null.
+  struct CONTENT_EXPORT Entry {
+    Entry();
+
+    // The event reached the browser.
+    base::TimeTicks input_time;
+    // The browser got it ready for the renderer.
+    base::TimeTicks browser_time;
+    // Rate control released it to the renderer, if it held it back.
+    base::TimeTicks paced_release_time;
+    // The renderer's main or compositor thread handled it and scheduled
+    // rendering.
+    base::TimeTicks handled_time;
+    bool handled_on_main;
+    // The renderer swapped the frame, which covers raster and draw.
+    base::TimeTicks renderer_swap_time;
+    // The browser got the frame.
+    base::TimeTicks browser_received_swap_time;
+    base::TimeTicks gpu_swap_begin_time;
+    // Swap buffers completed, the closest to presentation we see.
+    base::TimeTicks present_time;
+    // The frame rate that rate control paced the gesture to.
+    int target_frame_rate;
+  };
+
+  static const size_t kMaxEntries = 600;
+
+  static FrameLatencyLog* GetInstance();
+
+  FrameLatencyLog();
+  ~FrameLatencyLog();
+
+  // Recording is on while there is at least one viewer.
+  void AddViewer();
+  void RemoveViewer();
+  bool is_recording() const { return viewer_count_ > 0; }
+
+  void Add(const Entry& entry);
+  void Clear();
+
+  // The entries, oldest first, with the duration of each stage in
+  // milliseconds.
+  std::unique_ptr<base::ListValue> AsValue() const;
+
+ private:
+  int viewer_count_;
+  // A ring buffer; |next_index_| is the slot the next entry goes to.
+  std::vector<Entry> entries_;
+  size_t next_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameLatencyLog);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_INPUT_FRAME_LATENCY_LOG_H_
@@ -0,0 +1,129 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/frame_latency_log.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+FrameLatencyLog::Entry CreateEntry(int index) {
+  base::TimeTicks start =
+      base::TimeTicks() + base::TimeDelta::FromMilliseconds(1000 + index * 16);
+  FrameLatencyLog::Entry entry;
+  entry.input_time = start;
+  entry.browser_time = start + base::TimeDelta::FromMilliseconds(1);
+  entry.handled_time = start + base::TimeDelta::FromMilliseconds(3);
+  entry.renderer_swap_time = start + base::TimeDelta::FromMilliseconds(9);
+  entry.browser_received_swap_time =
+      start + base::TimeDelta::FromMilliseconds(10);
+  entry.gpu_swap_begin_time = start + base::TimeDelta::FromMilliseconds(12);
+  entry.present_time = start + base::TimeDelta::FromMilliseconds(20);
+  entry.target_frame_rate = 60;
+  return entry;
+}
+
+double GetStage(const base::ListValue& frames, size_t index, const char* name) {
+  const base::DictionaryValue* frame = nullptr;
+  EXPECT_TRUE(frames.GetDictionary(index, &frame));
+  double value = -1;
+  if (frame)
+    frame->GetDouble(name, &value);
+  return value;
+}
+
+}  // namespace
+
+TEST(FrameLatencyLogTest, RecordsOnlyWithViewers) {
+  FrameLatencyLog log;
+  log.Add(CreateEntry(0));
+  EXPECT_TRUE(log.AsValue()->empty());
+
+  log.AddViewer();
+  log.Add(CreateEntry(0));
+  EXPECT_EQ(1u, log.AsValue()->GetSize());
+
+  // The last viewer leaving drops what was recorded.
+  log.RemoveViewer();
+  EXPECT_FALSE(log.is_recording());
+  EXPECT_TRUE(log.AsValue()->empty());
+}
+
+TEST(FrameLatencyLogTest, Stages) {
+  FrameLatencyLog log;
+  log.AddViewer();
+  FrameLatencyLog::Entry entry = CreateEntry(0);
+  log.Add(entry);
+  entry.paced_release_time =
+      entry.browser_time + base::TimeDelta::FromMilliseconds(1);
+  entry.handled_on_main = true;
+  entry.target_frame_rate = 30;
+  log.Add(entry);
+
+  std::unique_ptr<base::ListValue> frames = log.AsValue();
+  ASSERT_EQ(2u, frames->GetSize());
+  EXPECT_DOUBLE_EQ(1, GetStage(*frames, 0, "input"));
+  EXPECT_DOUBLE_EQ(-1, GetStage(*frames, 0, "pacing"));
+  EXPECT_DOUBLE_EQ(2, GetStage(*frames, 0, "handling"));
+  EXPECT_DOUBLE_EQ(6, GetStage(*frames, 0, "raster"));
+  EXPECT_DOUBLE_EQ(1, GetStage(*frames, 0, "submit"));
+  EXPECT_DOUBLE_EQ(2, GetStage(*frames, 0, "gpuSwap"));
+  EXPECT_DOUBLE_EQ(8, GetStage(*frames, 0, "present"));
+  EXPECT_DOUBLE_EQ(20, GetStage(*frames, 0, "total"));
+
+  // Time held back by rate control is not counted as handling.
+  EXPECT_DOUBLE_EQ(1, GetStage(*frames, 1, "pacing"));
+  EXPECT_DOUBLE_EQ(1, GetStage(*frames, 1, "handling"));
+  const base::DictionaryValue* frame = nullptr;
+  ASSERT_TRUE(frames->GetDictionary(1, &frame));
+  std::string handled_on;
+  EXPECT_TRUE(frame->GetString("handledOn", &handled_on));
+  EXPECT_EQ("main", handled_on);
+  int target_fps = 0;
+  EXPECT_TRUE(frame->GetInteger("targetFps", &target_fps));
+  EXPECT_EQ(30, target_fps);
+}
+
+TEST(FrameLatencyLogTest, MissingStagesAreLeftOut) {
+  FrameLatencyLog log;
+  log.AddViewer();
+  FrameLatencyLog::Entry entry = CreateEntry(0);
+  entry.input_time = base::TimeTicks();
+  entry.renderer_swap_time = base::TimeTicks();
+  log.Add(entry);
+
+  std::unique_ptr<base::ListValue> frames = log.AsValue();
+  EXPECT_DOUBLE_EQ(-1, GetStage(*frames, 0, "input"));
+  EXPECT_DOUBLE_EQ(-1, GetStage(*frames, 0, "raster"));
+  EXPECT_DOUBLE_EQ(-1, GetStage(*frames, 0, "submit"));
+  // Without the input time the total starts when the browser got the event.
+  EXPECT_DOUBLE_EQ(19, GetStage(*frames, 0, "total"));
+}
+
+TEST(FrameLatencyLogTest, KeepsNewestEntriesInOrder) {
+  FrameLatencyLog log;
+  log.AddViewer();
+  const size_t kExtra = 5;
+  for (size_t i = 0; i < FrameLatencyLog::kMaxEntries + kExtra; ++i)
+    log.Add(CreateEntry(i));
+
+  std::unique_ptr<base::ListValue> frames = log.AsValue();
+  ASSERT_EQ(FrameLatencyLog::kMaxEntries, frames->GetSize());
+  double first = GetStage(*frames, 0, "presentTime");
+  double last =
+      GetStage(*frames, FrameLatencyLog::kMaxEntries - 1, "presentTime");
+  EXPECT_DOUBLE_EQ(1000 + kExtra * 16 + 20, first);
+  EXPECT_DOUBLE_EQ(
+      1000 + (FrameLatencyLog::kMaxEntries + kExtra - 1) * 16 + 20, last);
+}
+
+}  // namespace content
@@ -4,9 +4,11 @@
 
 #include "content/browser/renderer_host/input/gesture_event_queue.h"
 
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "content/browser/renderer_host/input/touchpad_tap_suppression_controller.h"
 #include "content/browser/renderer_host/input/touchscreen_tap_suppression_controller.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 #include "ui/events/blink/web_input_event_traits.h"
 
 using blink::WebGestureEvent;
@@ -15,6 +17,11 @@ using blink::WebInputEvent;
 namespace content {
 namespace {
 
+// A scroll update is held only if it would otherwise arrive at least this much
+// earlier than a target frame after the previous one, so that updates that
+// are merely a little early because of input jitter are not delayed.
+const int kScrollUpdateHoldSlackMs = 2;
+
 // Whether |event_in_queue| is GesturePinchUpdate or GestureScrollUpdate and
 // has the same modifiers/source as the new scroll/pinch event. Compatible
 // scroll and pinch event pairs can be logically coalesced.
@@ -72,7 +79,8 @@ GestureEventQueue::GestureEventQueue(
       touchscreen_tap_suppression_controller_(
           this,
           config.touchscreen_tap_suppression_config),
-      debounce_interval_(config.debounce_interval) {
+      debounce_interval_(config.debounce_interval),
+      scroll_update_held_(false) {
   DCHECK(client);
   DCHECK(touchpad_client);
 }
@@ -176,6 +184,10 @@ bool GestureEventQueue::ShouldForwardForTapSuppression(
 
 void GestureEventQueue::QueueAndForwardIfNecessary(
     const GestureEventWithLatencyInfo& gesture_event) {
+  // Only scroll updates wait for the next target frame; anything else, such
+  // as the end of the scroll or a pinch, releases the held update first.
+  if (gesture_event.event.type != WebInputEvent::GestureScrollUpdate)
+    SendHeldScrollUpdate();
   switch (gesture_event.event.type) {
     case WebInputEvent::GestureFlingCancel:
       fling_in_progress_ = false;
@@ -223,7 +235,7 @@ void GestureEventQueue::ProcessGestureAck(InputEventAckState ack_result,
                                           const ui::LatencyInfo& latency) {
   TRACE_EVENT0("input", "GestureEventQueue::ProcessGestureAck");
 
-  if (coalesced_gesture_events_.empty()) {
+  if (coalesced_gesture_events_.empty() || scroll_update_held_) {
     DLOG(ERROR) << "Received unexpected ACK for event type " << type;
     return;
   }
@@ -281,6 +293,13 @@ void GestureEventQueue::ProcessGestureAck(InputEventAckState ack_result,
     ignore_next_ack_ = true;
   }
 
+  if (first_gesture_event.event.type == WebInputEvent::GestureScrollUpdate &&
+      second_gesture_event.event.type == WebInputEvent::Undefined) {
+    SendOrHoldScrollUpdate();
+    return;
+  }
+  if (first_gesture_event.event.type == WebInputEvent::GestureScrollUpdate)
+    last_scroll_update_time_ = base::TimeTicks::Now();
   client_->SendGestureEventImmediately(first_gesture_event);
   if (second_gesture_event.event.type != WebInputEvent::Undefined)
     client_->SendGestureEventImmediately(second_gesture_event);
@@ -291,6 +310,16 @@ TouchpadTapSuppressionController*
   return &touchpad_tap_suppression_controller_;
 }
 
+void GestureEventQueue::SetTargetFrameRate(int fps) {
+  if (fps > 0 && fps < ui::ScrollUpdatePacer::kMaxFrameRate) {
+    scroll_update_interval_ = base::TimeDelta::FromMicroseconds(
+        base::Time::kMicrosecondsPerSecond / fps);
+    return;
+  }
+  scroll_update_interval_ = base::TimeDelta();
+  SendHeldScrollUpdate();
+}
+
 void GestureEventQueue::FlingHasBeenHalted() {
   fling_in_progress_ = false;
 }
@@ -323,7 +352,10 @@ void GestureEventQueue::QueueScrollOrPinchAndForwardIfNecessary(
   if (!unsent_events_count) {
     coalesced_gesture_events_.push_back(gesture_event);
     if (coalesced_gesture_events_.size() == 1) {
-      client_->SendGestureEventImmediately(gesture_event);
+      if (gesture_event.event.type == WebInputEvent::GestureScrollUpdate)
+        SendOrHoldScrollUpdate();
+      else
+        client_->SendGestureEventImmediately(gesture_event);
     } else if (coalesced_gesture_events_.size() == 2) {
       DCHECK(!ignore_next_ack_);
       // If there is an in-flight scroll, the new pinch can be forwarded
@@ -407,7 +439,7 @@ void GestureEventQueue::QueueScrollOrPinchAndForwardIfNecessary(
 }
 
 size_t GestureEventQueue::EventsInFlightCount() const {
-  if (coalesced_gesture_events_.empty())
+  if (coalesced_gesture_events_.empty() || scroll_update_held_)
     return 0;
 
   if (!ignore_next_ack_)
@@ -417,4 +449,36 @@ size_t GestureEventQueue::EventsInFlightCount() const {
   return 2;
 }
 
+void GestureEventQueue::SendOrHoldScrollUpdate() {
+  DCHECK(!coalesced_gesture_events_.empty());
+  DCHECK_EQ(WebInputEvent::GestureScrollUpdate,
+            coalesced_gesture_events_.front().event.type);
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeDelta wait =
+      last_scroll_update_time_ + scroll_update_interval_ - now;
+  if (wait > base::TimeDelta::FromMilliseconds(kScrollUpdateHoldSlackMs)) {
+    TRACE_EVENT_INSTANT0("input", "GestureEventQueue::HoldScrollUpdate",
+                         TRACE_EVENT_SCOPE_THREAD);
+    scroll_update_held_ = true;
+    scroll_update_timer_.Start(FROM_HERE, wait, this,
+                               &GestureEventQueue::SendHeldScrollUpdate);
+    return;
+  }
+  last_scroll_update_time_ = now;
+  client_->SendGestureEventImmediately(coalesced_gesture_events_.front());
+}
+
+void GestureEventQueue::SendHeldScrollUpdate() {
+  if (!scroll_update_held_)
+    return;
+  scroll_update_held_ = false;
+  scroll_update_timer_.Stop();
+  DCHECK(!coalesced_gesture_events_.empty());
+  last_scroll_update_time_ = base::TimeTicks::Now();
+  coalesced_gesture_events_.front().latency.AddLatencyNumberWithTimestamp(
+      ui::INPUT_EVENT_LATENCY_PACED_RELEASE_COMPONENT, 0, 0,
+      last_scroll_update_time_, 1);
+  client_->SendGestureEventImmediately(coalesced_gesture_events_.front());
+}
+
 }  // namespace content
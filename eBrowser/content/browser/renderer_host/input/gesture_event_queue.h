@@ -54,6 +54,10 @@ class CONTENT_EXPORT GestureEventQueueClient {
 // 4. Whenever possible, events in the queue are coalesced to have as few events
 //    as possible and therefore maximize the chance that the event stream can be
 //    handled entirely by the compositor thread.
+// 5. While the renderer runs at a reduced target frame rate, a
+//    GestureScrollUpdate that would be sent less than a target frame after the
+//    previous one is held back, and later updates are coalesced into it, so
+//    that the renderer receives about one scroll update per frame it draws.
 // Events in the queue are forwarded to the renderer one by one; i.e., each
 // event is sent after receiving the ACK for previous one. The only exception is
 // that if a GestureScrollUpdate is followed by a GesturePinchUpdate, they are
@@ -109,6 +113,10 @@ class CONTENT_EXPORT GestureEventQueue {
            debouncing_deferral_queue_.empty();
   }
 
+  // Sets the frame rate the renderer currently targets; 0 or the display
+  // rate disables rate-aware coalescing and releases any held update.
+  void SetTargetFrameRate(int fps);
+
   void set_debounce_interval_time_ms_for_testing(int interval_ms) {
     debounce_interval_ = base::TimeDelta::FromMilliseconds(interval_ms);
   }
@@ -159,6 +167,13 @@ class CONTENT_EXPORT GestureEventQueue {
   // remain at the head of the queue until ack'ed.
   size_t EventsInFlightCount() const;
 
+  // Sends the GestureScrollUpdate at the front of the queue, or holds it until
+  // a target frame has passed since the previous one was sent.
+  void SendOrHoldScrollUpdate();
+
+  // Sends the held GestureScrollUpdate, if any.
+  void SendHeldScrollUpdate();
+
   // The receiver of all forwarded gesture events.
   GestureEventQueueClient* client_;
 
@@ -205,6 +220,20 @@ class CONTENT_EXPORT GestureEventQueue {
   // of zero effectively disables debouncing.
   base::TimeDelta debounce_interval_;
 
+  // Duration of one target frame, or zero when the renderer runs at the
+  // display rate.
+  base::TimeDelta scroll_update_interval_;
+
+  // When the last GestureScrollUpdate was sent.
+  base::TimeTicks last_scroll_update_time_;
+
+  // True if the event at the front of the queue is a GestureScrollUpdate
+  // that has not been sent yet; nothing is then in flight.
+  bool scroll_update_held_;
+
+  // Timer to release a held GestureScrollUpdate.
+  base::OneShotTimer scroll_update_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(GestureEventQueue);
 };
 
@@ -1180,4 +1180,77 @@ TEST_F(GestureEventQueueTest, CoalescesSyntheticScrollBeginEndEvents) {
   EXPECT_EQ(1U, GestureEventQueueSize());
 }
 
+// Test that at a reduced target frame rate, scroll updates that arrive within
+// a target frame of the previous one are held and coalesced into one, which
+// is sent when the frame has passed.
+TEST_F(GestureEventQueueTest, RateAwareCoalescingHoldsScrollUpdates) {
+  // 50ms per target frame.
+  queue()->SetTargetFrameRate(20);
+
+  SimulateGestureScrollUpdateEvent(0, -5, 0);
+  EXPECT_EQ(1U, GetAndResetSentGestureEventCount());
+  SendInputEventACK(WebInputEvent::GestureScrollUpdate,
+                    INPUT_EVENT_ACK_STATE_CONSUMED);
+  EXPECT_EQ(0U, GestureEventQueueSize());
+
+  // Acked right away, but one target frame has not passed yet.
+  SimulateGestureScrollUpdateEvent(0, -5, 0);
+  EXPECT_EQ(0U, GetAndResetSentGestureEventCount());
+  EXPECT_EQ(1U, GestureEventQueueSize());
+  SimulateGestureScrollUpdateEvent(0, -7, 0);
+  EXPECT_EQ(0U, GetAndResetSentGestureEventCount());
+  EXPECT_EQ(1U, GestureEventQueueSize());
+  EXPECT_EQ(-12, GestureEventLastQueueEvent().data.scrollUpdate.deltaY);
+
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE, base::MessageLoop::QuitWhenIdleClosure(),
+      TimeDelta::FromMilliseconds(60));
+  base::RunLoop().Run();
+
+  EXPECT_EQ(1U, GetAndResetSentGestureEventCount());
+  EXPECT_EQ(1U, GestureEventQueueSize());
+  SendInputEventACK(WebInputEvent::GestureScrollUpdate,
+                    INPUT_EVENT_ACK_STATE_CONSUMED);
+  EXPECT_EQ(-12, last_acked_event().data.scrollUpdate.deltaY);
+  EXPECT_EQ(0U, GestureEventQueueSize());
+}
+
+// Test that a held scroll update is sent as soon as an event of another type
+// arrives, ahead of it.
+TEST_F(GestureEventQueueTest, RateAwareCoalescingReleasesOnScrollEnd) {
+  queue()->SetTargetFrameRate(20);
+  SimulateGestureScrollUpdateEvent(0, -5, 0);
+  SendInputEventACK(WebInputEvent::GestureScrollUpdate,
+                    INPUT_EVENT_ACK_STATE_CONSUMED);
+  EXPECT_EQ(1U, GetAndResetSentGestureEventCount());
+
+  SimulateGestureScrollUpdateEvent(0, -5, 0);
+  EXPECT_EQ(0U, GetAndResetSentGestureEventCount());
+  SimulateGestureEvent(WebInputEvent::GestureScrollEnd,
+                       blink::WebGestureDeviceTouchscreen);
+  EXPECT_EQ(1U, GetAndResetSentGestureEventCount());
+  EXPECT_EQ(2U, GestureEventQueueSize());
+  EXPECT_EQ(WebInputEvent::GestureScrollUpdate,
+            GestureEventQueueEventAt(0).type);
+  EXPECT_EQ(WebInputEvent::GestureScrollEnd, GestureEventQueueEventAt(1).type);
+}
+
+// Test that returning to the display rate releases a held scroll update and
+// stops holding.
+TEST_F(GestureEventQueueTest, RateAwareCoalescingDisabledAtDisplayRate) {
+  queue()->SetTargetFrameRate(20);
+  SimulateGestureScrollUpdateEvent(0, -5, 0);
+  SendInputEventACK(WebInputEvent::GestureScrollUpdate,
+                    INPUT_EVENT_ACK_STATE_CONSUMED);
+  SimulateGestureScrollUpdateEvent(0, -5, 0);
+  EXPECT_EQ(1U, GetAndResetSentGestureEventCount());
+
+  queue()->SetTargetFrameRate(0);
+  EXPECT_EQ(1U, GetAndResetSentGestureEventCount());
+  SendInputEventACK(WebInputEvent::GestureScrollUpdate,
+                    INPUT_EVENT_ACK_STATE_CONSUMED);
+  SimulateGestureScrollUpdateEvent(0, -5, 0);
+  EXPECT_EQ(1U, GetAndResetSentGestureEventCount());
+}
+
 }  // namespace content
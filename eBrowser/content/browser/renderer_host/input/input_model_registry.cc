@@ -0,0 +1,151 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/input_model_registry.h"
+
+#include <string.h>
+
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/shared_memory.h"
+#include "base/values.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "mojo/public/cpp/bindings/strong_binding.h"
+#include "mojo/public/cpp/system/platform_handle.h"
+
+namespace content {
+
+namespace {
+
+base::LazyInstance<InputModelRegistry>::Leaky g_input_model_registry =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Serves one renderer's mojom::InputModelProvider from the registry.
+class InputModelProviderImpl : public mojom::InputModelProvider {
+ public:
+  explicit InputModelProviderImpl(int render_process_id)
+      : render_process_id_(render_process_id) {}
+  ~InputModelProviderImpl() override {}
+
+  // mojom::InputModelProvider:
+  void GetModel(mojom::InputModelKeyPtr key,
+                const GetModelCallback& callback) override {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    uint32_t version = 0;
+    size_t size = 0;
+    base::SharedMemory* model = nullptr;
+    if (key->type >= 0 && key->type <= ui::INPUT_MODEL_TYPE_LAST) {
+      model = InputModelRegistry::GetInstance()->Lookup(
+          InputModelRegistry::Key(static_cast<ui::InputModelType>(key->type),
+                                  key->device_id, key->origin),
+          &version, &size);
+    }
+    RenderProcessHost* process =
+        RenderProcessHost::FromID(render_process_id_);
+    base::SharedMemoryHandle handle;
+    if (!model || !process ||
+        !model->ShareReadOnlyToProcess(process->GetHandle(), &handle)) {
+      callback.Run(0, mojo::ScopedSharedBufferHandle(), 0);
+      return;
+    }
+    callback.Run(version,
+                 mojo::WrapSharedMemoryHandle(handle, size,
+                                              true /* read_only */),
+                 static_cast<uint32_t>(size));
+  }
+
+ private:
+  const int render_process_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputModelProviderImpl);
+};
+
+}  // namespace
+
+InputModelRegistry::Key::Key(ui::InputModelType type,
+                             const std::string& device_id,
+                             const std::string& origin)
+    : type(type), device_id(device_id), origin(origin) {}
+
+InputModelRegistry::Key::~Key() {}
+
+bool InputModelRegistry::Key::operator<(const Key& other) const {
+  return std::tie(type, device_id, origin) <
+         std::tie(other.type, other.device_id, other.origin);
+}
+
+InputModelRegistry::Entry::Entry() : version(0), size(0) {}
+
+InputModelRegistry::Entry::~Entry() {}
+
+// static
+InputModelRegistry* InputModelRegistry::GetInstance() {
+  return g_input_model_registry.Pointer();
+}
+
+// static
+void InputModelRegistry::BindProvider(
+    int render_process_id,
+    mojom::InputModelProviderRequest request) {
+  mojo::MakeStrongBinding(
+      base::MakeUnique<InputModelProviderImpl>(render_process_id),
+      std::move(request));
+}
+
+InputModelRegistry::InputModelRegistry() : last_version_(0) {}
+
+InputModelRegistry::~InputModelRegistry() {}
+
+uint32_t InputModelRegistry::Register(
+    const Key& key,
+    std::unique_ptr<base::SharedMemory> model,
+    size_t size) {
+  DCHECK(model);
+  DCHECK(model->memory());
+  DCHECK_LE(size, std::numeric_limits<uint32_t>::max());
+  Entry& entry = models_[key];
+  if (entry.memory && entry.size == size &&
+      memcmp(entry.memory->memory(), model->memory(), size) == 0) {
+    return entry.version;
+  }
+  entry.version = ++last_version_;
+  entry.memory = std::move(model);
+  entry.size = size;
+  return entry.version;
+}
+
+base::SharedMemory* InputModelRegistry::Lookup(const Key& key,
+                                               uint32_t* version,
+                                               size_t* size) const {
+  auto it = models_.find(key);
+  if (it == models_.end())
+    return nullptr;
+  *version = it->second.version;
+  *size = it->second.size;
+  return it->second.memory.get();
+}
+
+std::unique_ptr<base::ListValue> InputModelRegistry::AsValue() const {
+  std::unique_ptr<base::ListValue> models(new base::ListValue());
+  for (const auto& it : models_) {
+    std::unique_ptr<base::DictionaryValue> model(new base::DictionaryValue());
+    model->SetString("type", it.first.type == ui::INPUT_MODEL_PINCH
+                                 ? "pinch"
+                                 : "scroll");
+    model->SetString("device_id", it.first.device_id);
+    model->SetString("origin", it.first.origin);
+    model->SetDouble("version", it.second.version);
+    model->SetInteger("size", static_cast<int>(it.second.size));
+    models->Append(std::move(model));
+  }
+  return models;
+}
+
+}  // namespace content
@@ -0,0 +1,93 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_MODEL_REGISTRY_H_
+#define CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_MODEL_REGISTRY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "content/common/content_export.h"
+#include "content/common/input_model_provider.mojom.h"
+#include "ui/events/blink/input_model_type.h"
+
+namespace base {
+class ListValue;
+class SharedMemory;
+}
+
+namespace content {
+
+// Keeps the compiled input models the browser has handed out, so that every
+// renderer maps the one copy of a model instead of getting its own. Views are
+// told about a model with InputMsg_ModelAvailable and their renderer fetches
+// it once through mojom::InputModelProvider. Lives on the UI thread.
+class CONTENT_EXPORT InputModelRegistry {
+ public:
+  struct CONTENT_EXPORT Key {
+    Key(ui::InputModelType type,
+        const std::string& device_id,
+        const std::string& origin);
+    ~Key();
+
+    bool operator<(const Key& other) const;
+
+    ui::InputModelType type;
+    std::string device_id;
+    // A serialized url::Origin, or empty for a default model.
+    std::string origin;
+  };
+
+  static InputModelRegistry* GetInstance();
+
+  // Binds |request| for the renderer |render_process_id|.
+  static void BindProvider(int render_process_id,
+                           mojom::InputModelProviderRequest request);
+
+  InputModelRegistry();
+  ~InputModelRegistry();
+
+  // Makes |model|, |size| mapped bytes in the ui::DenseRbfModel format, the
+  // current model for |key| and returns its version, which is never 0. The
+  // same bytes as the current model keep its version and shared copy, so that
+  // renderers which already have it do not fetch it again.
+  uint32_t Register(const Key& key,
+                    std::unique_ptr<base::SharedMemory> model,
+                    size_t size);
+
+  // Returns the current model for |key| and sets |version| and |size|, or
+  // returns null if there is none.
+  base::SharedMemory* Lookup(const Key& key,
+                             uint32_t* version,
+                             size_t* size) const;
+
+  // The current models, with their key, version and size, for traces.
+  std::unique_ptr<base::ListValue> AsValue() const;
+
+ private:
+  struct Entry {
+    Entry();
+    ~Entry();
+
+    uint32_t version;
+    std::unique_ptr<base::SharedMemory> memory;
+    size_t size;
+  };
+
+  std::map<Key, Entry> models_;
+  // Versions are unique across keys, so that a renderer can never mistake a
+  // replaced model for the current one.
+  uint32_t last_version_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputModelRegistry);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_MODEL_REGISTRY_H_
@@ -0,0 +1,107 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/input_model_registry.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+
+#include "base/memory/shared_memory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+std::unique_ptr<base::SharedMemory> CreateModel(const std::string& bytes) {
+  std::unique_ptr<base::SharedMemory> memory(new base::SharedMemory());
+  EXPECT_TRUE(memory->CreateAndMapAnonymous(bytes.size()));
+  memcpy(memory->memory(), bytes.data(), bytes.size());
+  return memory;
+}
+
+InputModelRegistry::Key ScrollKey(const std::string& device_id) {
+  return InputModelRegistry::Key(ui::INPUT_MODEL_SCROLL, device_id,
+                                 std::string());
+}
+
+}  // namespace
+
+TEST(InputModelRegistryTest, LookupWithoutModel) {
+  InputModelRegistry registry;
+  uint32_t version = 0;
+  size_t size = 0;
+  EXPECT_FALSE(registry.Lookup(ScrollKey("device"), &version, &size));
+}
+
+TEST(InputModelRegistryTest, IdenticalModelKeepsVersionAndCopy) {
+  InputModelRegistry registry;
+  uint32_t first = registry.Register(ScrollKey("device"), CreateModel("abcd"),
+                                     4);
+  EXPECT_NE(0u, first);
+  uint32_t version = 0;
+  size_t size = 0;
+  base::SharedMemory* shared =
+      registry.Lookup(ScrollKey("device"), &version, &size);
+  ASSERT_TRUE(shared);
+  EXPECT_EQ(first, version);
+  EXPECT_EQ(4u, size);
+
+  // A second view loading the same model must not make renderers fetch it
+  // again.
+  EXPECT_EQ(first, registry.Register(ScrollKey("device"), CreateModel("abcd"),
+                                     4));
+  EXPECT_EQ(shared, registry.Lookup(ScrollKey("device"), &version, &size));
+}
+
+TEST(InputModelRegistryTest, ChangedModelGetsNewVersion) {
+  InputModelRegistry registry;
+  uint32_t first = registry.Register(ScrollKey("device"), CreateModel("abcd"),
+                                     4);
+  uint32_t second = registry.Register(ScrollKey("device"),
+                                      CreateModel("abce"), 4);
+  EXPECT_GT(second, first);
+  uint32_t third = registry.Register(ScrollKey("device"),
+                                     CreateModel("abcdef"), 6);
+  EXPECT_GT(third, second);
+
+  uint32_t version = 0;
+  size_t size = 0;
+  base::SharedMemory* shared =
+      registry.Lookup(ScrollKey("device"), &version, &size);
+  ASSERT_TRUE(shared);
+  EXPECT_EQ(third, version);
+  EXPECT_EQ(6u, size);
+  EXPECT_EQ(0, memcmp(shared->memory(), "abcdef", 6));
+}
+
+TEST(InputModelRegistryTest, KeysAreSeparate) {
+  InputModelRegistry registry;
+  uint32_t scroll = registry.Register(ScrollKey("a"), CreateModel("abcd"), 4);
+  uint32_t other_device =
+      registry.Register(ScrollKey("b"), CreateModel("abcd"), 4);
+  uint32_t pinch = registry.Register(
+      InputModelRegistry::Key(ui::INPUT_MODEL_PINCH, "a", std::string()),
+      CreateModel("abcd"), 4);
+  uint32_t origin = registry.Register(
+      InputModelRegistry::Key(ui::INPUT_MODEL_SCROLL, "a",
+                              "https://example.com"),
+      CreateModel("abcd"), 4);
+  // Versions are unique across keys.
+  EXPECT_NE(scroll, other_device);
+  EXPECT_NE(scroll, pinch);
+  EXPECT_NE(scroll, origin);
+  EXPECT_NE(pinch, origin);
+
+  uint32_t version = 0;
+  size_t size = 0;
+  ASSERT_TRUE(registry.Lookup(ScrollKey("a"), &version, &size));
+  EXPECT_EQ(scroll, version);
+}
+
+}  // namespace content
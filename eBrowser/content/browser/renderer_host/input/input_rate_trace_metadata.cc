@@ -0,0 +1,153 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/input_rate_trace_metadata.h"
+
+#include <utility>
+
+#include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/lazy_instance.h"
+#include "base/metrics/field_trial.h"
+#include "base/values.h"
+#include "content/browser/renderer_host/input/input_model_registry.h"
+#include "content/public/common/content_features.h"
+#include "content/public/common/content_switches.h"
+#include "ui/events/blink/energy_curve.h"
+#include "ui/events/blink/input_rate_controller.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace content {
+
+namespace {
+
+base::LazyInstance<InputRateTraceMetadata>::Leaky
+    g_input_rate_trace_metadata = LAZY_INSTANCE_INITIALIZER;
+
+// The policy renderers run, resolved the way InputHandlerWrapper resolves it
+// from the switches and field trial the browser hands them.
+const char* RatePolicyName() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  ui::InputRatePolicy policy = ui::INPUT_RATE_POLICY_SVR_SLEEP;
+  if (command_line.HasSwitch(switches::kEBrowserInputRateController)) {
+    ui::InputRateController::ParsePolicy(
+        command_line.GetSwitchValueASCII(
+            switches::kEBrowserInputRateController),
+        &policy);
+  } else if (base::FeatureList::IsEnabled(
+                 features::kEBrowserInputRateExperiment)) {
+    base::FieldTrial* trial = base::FeatureList::GetFieldTrial(
+        features::kEBrowserInputRateExperiment);
+    if (trial)
+      ui::InputRateController::ParsePolicy(trial->group_name(), &policy);
+  }
+  return ui::InputRateController::PolicyName(policy);
+}
+
+}  // namespace
+
+// static
+const size_t InputRateTraceMetadata::kMaxGestures;
+
+InputRateTraceMetadata::Gesture::Gesture()
+    : target_frame_rate(ui::ScrollUpdatePacer::kMaxFrameRate),
+      presented_frames(0),
+      presented_fps(0),
+      latency_count(0) {}
+
+// static
+InputRateTraceMetadata* InputRateTraceMetadata::GetInstance() {
+  return g_input_rate_trace_metadata.Pointer();
+}
+
+InputRateTraceMetadata::InputRateTraceMetadata()
+    : recording_(false), num_dropped_gestures_(0) {}
+
+InputRateTraceMetadata::~InputRateTraceMetadata() {}
+
+void InputRateTraceMetadata::Start() {
+  gestures_.clear();
+  num_dropped_gestures_ = 0;
+  // Empties the histogram of what the last trace left in it.
+  ui::LatencyHistogramSnapshot discarded;
+  scroll_latency_.TakeInto(&discarded);
+  recording_ = true;
+}
+
+void InputRateTraceMetadata::AddGesture(const Gesture& gesture) {
+  if (!recording_)
+    return;
+  if (gestures_.size() < kMaxGestures)
+    gestures_.push_back(gesture);
+  else
+    ++num_dropped_gestures_;
+}
+
+void InputRateTraceMetadata::AddScrollLatency(base::TimeDelta latency) {
+  if (recording_)
+    scroll_latency_.Record(latency, 1);
+}
+
+void InputRateTraceMetadata::SetEnergyCurve(const std::string& curve_str) {
+  std::unique_ptr<ui::EnergyCurve> curve =
+      ui::EnergyCurve::CreateFromString(curve_str);
+  if (curve)
+    energy_curve_ = std::move(curve);
+}
+
+std::unique_ptr<base::DictionaryValue> InputRateTraceMetadata::Stop() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  std::unique_ptr<base::DictionaryValue> block(new base::DictionaryValue());
+  block->SetString("rate_policy", RatePolicyName());
+  block->SetString("gesture_rate_policies",
+                   command_line.GetSwitchValueASCII(
+                       switches::kEBrowserGestureRatePolicies));
+  block->Set("models", InputModelRegistry::GetInstance()->AsValue());
+  block->SetBoolean("has_energy_curve", !!energy_curve_);
+
+  std::unique_ptr<base::ListValue> gestures(new base::ListValue());
+  for (const Gesture& gesture : gestures_) {
+    std::unique_ptr<base::DictionaryValue> value(new base::DictionaryValue());
+    value->SetInteger("target_fps", gesture.target_frame_rate);
+    value->SetInteger("presented_frames", gesture.presented_frames);
+    value->SetDouble("presented_fps", gesture.presented_fps);
+    value->SetDouble("duration_ms", gesture.duration.InMillisecondsF());
+    value->SetInteger("latency_count", gesture.latency_count);
+    value->SetDouble("mean_latency_ms", gesture.mean_latency.InMillisecondsF());
+    value->SetDouble("max_latency_ms", gesture.max_latency.InMillisecondsF());
+    if (energy_curve_) {
+      // What the gesture drew, and what it would have at the full rate.
+      double seconds = gesture.duration.InSecondsF();
+      value->SetDouble(
+          "energy_mj",
+          energy_curve_->MilliwattsAt(gesture.presented_fps) * seconds);
+      value->SetDouble("full_rate_energy_mj",
+                       energy_curve_->MilliwattsAt(
+                           ui::ScrollUpdatePacer::kMaxFrameRate) *
+                           seconds);
+    }
+    gestures->Append(std::move(value));
+  }
+  block->Set("gestures", std::move(gestures));
+  block->SetInteger("dropped_gestures",
+                    static_cast<int>(num_dropped_gestures_));
+
+  ui::LatencyHistogramSnapshot snapshot;
+  scroll_latency_.TakeInto(&snapshot);
+  std::unique_ptr<base::DictionaryValue> latency(new base::DictionaryValue());
+  latency->SetDouble("count", static_cast<double>(snapshot.count()));
+  latency->SetDouble("p50_ms", snapshot.Percentile(50).InMillisecondsF());
+  latency->SetDouble("p95_ms", snapshot.Percentile(95).InMillisecondsF());
+  latency->SetDouble("p99_ms", snapshot.Percentile(99).InMillisecondsF());
+  block->Set("scroll_latency", std::move(latency));
+
+  gestures_.clear();
+  num_dropped_gestures_ = 0;
+  recording_ = false;
+  return block;
+}
+
+}  // namespace content
@@ -0,0 +1,87 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_RATE_TRACE_METADATA_H_
+#define CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_RATE_TRACE_METADATA_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+#include "ui/events/blink/latency_histogram.h"
+
+namespace base {
+class DictionaryValue;
+}
+
+namespace ui {
+class EnergyCurve;
+}
+
+namespace content {
+
+// Collects the input rate measurements of one trace into the "ebrowser"
+// block TracingControllerImpl adds to the trace metadata, so that builds and
+// devices can be compared from their traces alone: the rate policy, the
+// models handed to renderers, the target and presented frame rate and the
+// estimated energy of each scroll gesture, and scroll latency percentiles.
+// Gestures are only recorded while tracing. Lives on the UI thread.
+class CONTENT_EXPORT InputRateTraceMetadata {
+ public:
+  // One scroll gesture, as RenderWidgetHostLatencyTracker saw it presented.
+  struct CONTENT_EXPORT Gesture {
+    Gesture();
+
+    // The lowest frame rate rate control targeted during the gesture.
+    int target_frame_rate;
+    int presented_frames;
+    double presented_fps;
+    // From the first to the last presented frame.
+    base::TimeDelta duration;
+    // Of the input to swap latency of the gesture's scroll updates.
+    int latency_count;
+    base::TimeDelta mean_latency;
+    base::TimeDelta max_latency;
+  };
+
+  // Gestures past this many in one trace are counted but not kept.
+  static const size_t kMaxGestures = 1000;
+
+  static InputRateTraceMetadata* GetInstance();
+
+  InputRateTraceMetadata();
+  ~InputRateTraceMetadata();
+
+  // Drops what the last trace recorded and starts recording.
+  void Start();
+  bool is_recording() const { return recording_; }
+
+  void AddGesture(const Gesture& gesture);
+  void AddScrollLatency(base::TimeDelta latency);
+
+  // Sets the curve, in the ui::EnergyCurve text format, that gesture energy
+  // is estimated on; the last one a view sent wins.
+  void SetEnergyCurve(const std::string& curve_str);
+
+  // Stops recording and returns the block.
+  std::unique_ptr<base::DictionaryValue> Stop();
+
+ private:
+  bool recording_;
+  std::vector<Gesture> gestures_;
+  size_t num_dropped_gestures_;
+  ui::LatencyHistogram scroll_latency_;
+  std::unique_ptr<ui::EnergyCurve> energy_curve_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputRateTraceMetadata);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_INPUT_INPUT_RATE_TRACE_METADATA_H_
@@ -0,0 +1,161 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/input_rate_trace_metadata.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+const char kEnergyCurve[] =
+    "energy_curve\n"
+    "version 1\n"
+    "frame_rates 30 60\n"
+    "millijoules_per_frame 6 5\n";
+
+InputRateTraceMetadata::Gesture CreateGesture(int target_fps) {
+  InputRateTraceMetadata::Gesture gesture;
+  gesture.target_frame_rate = target_fps;
+  gesture.presented_frames = target_fps * 2 + 1;
+  gesture.presented_fps = target_fps;
+  gesture.duration = base::TimeDelta::FromSeconds(2);
+  gesture.latency_count = 10;
+  gesture.mean_latency = base::TimeDelta::FromMilliseconds(20);
+  gesture.max_latency = base::TimeDelta::FromMilliseconds(40);
+  return gesture;
+}
+
+const base::DictionaryValue* GetGesture(const base::DictionaryValue& block,
+                                        size_t index) {
+  const base::ListValue* gestures = nullptr;
+  const base::DictionaryValue* gesture = nullptr;
+  EXPECT_TRUE(block.GetList("gestures", &gestures));
+  if (gestures)
+    EXPECT_TRUE(gestures->GetDictionary(index, &gesture));
+  return gesture;
+}
+
+}  // namespace
+
+TEST(InputRateTraceMetadataTest, RecordsOnlyWhileTracing) {
+  InputRateTraceMetadata metadata;
+  metadata.AddGesture(CreateGesture(30));
+  metadata.AddScrollLatency(base::TimeDelta::FromMilliseconds(16));
+
+  metadata.Start();
+  EXPECT_TRUE(metadata.is_recording());
+  metadata.AddGesture(CreateGesture(60));
+  std::unique_ptr<base::DictionaryValue> block = metadata.Stop();
+  EXPECT_FALSE(metadata.is_recording());
+
+  const base::ListValue* gestures = nullptr;
+  ASSERT_TRUE(block->GetList("gestures", &gestures));
+  EXPECT_EQ(1u, gestures->GetSize());
+  double count = -1;
+  EXPECT_TRUE(block->GetDouble("scroll_latency.count", &count));
+  EXPECT_EQ(0, count);
+
+  // A new trace starts empty.
+  metadata.Start();
+  block = metadata.Stop();
+  ASSERT_TRUE(block->GetList("gestures", &gestures));
+  EXPECT_TRUE(gestures->empty());
+}
+
+TEST(InputRateTraceMetadataTest, DescribesEachGesture) {
+  InputRateTraceMetadata metadata;
+  metadata.Start();
+  metadata.AddGesture(CreateGesture(30));
+  std::unique_ptr<base::DictionaryValue> block = metadata.Stop();
+
+  std::string policy;
+  EXPECT_TRUE(block->GetString("rate_policy", &policy));
+  EXPECT_FALSE(policy.empty());
+  const base::ListValue* models = nullptr;
+  EXPECT_TRUE(block->GetList("models", &models));
+
+  const base::DictionaryValue* gesture = GetGesture(*block, 0);
+  ASSERT_TRUE(gesture);
+  int target_fps = 0;
+  double value = 0;
+  EXPECT_TRUE(gesture->GetInteger("target_fps", &target_fps));
+  EXPECT_EQ(30, target_fps);
+  EXPECT_TRUE(gesture->GetDouble("duration_ms", &value));
+  EXPECT_DOUBLE_EQ(2000, value);
+  EXPECT_TRUE(gesture->GetDouble("mean_latency_ms", &value));
+  EXPECT_DOUBLE_EQ(20, value);
+  // Without a curve there is no energy estimate.
+  EXPECT_FALSE(gesture->HasKey("energy_mj"));
+  bool has_energy_curve = true;
+  EXPECT_TRUE(block->GetBoolean("has_energy_curve", &has_energy_curve));
+  EXPECT_FALSE(has_energy_curve);
+}
+
+TEST(InputRateTraceMetadataTest, EstimatesEnergyOnTheCurve) {
+  InputRateTraceMetadata metadata;
+  metadata.SetEnergyCurve("not a curve");
+  metadata.Start();
+  metadata.AddGesture(CreateGesture(30));
+  std::unique_ptr<base::DictionaryValue> block = metadata.Stop();
+  const base::DictionaryValue* gesture = GetGesture(*block, 0);
+  ASSERT_TRUE(gesture);
+  EXPECT_FALSE(gesture->HasKey("energy_mj"));
+
+  metadata.SetEnergyCurve(kEnergyCurve);
+  metadata.Start();
+  metadata.AddGesture(CreateGesture(30));
+  block = metadata.Stop();
+  gesture = GetGesture(*block, 0);
+  ASSERT_TRUE(gesture);
+  // 2s at 30fps and 6mJ a frame, against 2s at 60fps and 5mJ a frame.
+  double energy = 0;
+  EXPECT_TRUE(gesture->GetDouble("energy_mj", &energy));
+  EXPECT_DOUBLE_EQ(360, energy);
+  EXPECT_TRUE(gesture->GetDouble("full_rate_energy_mj", &energy));
+  EXPECT_DOUBLE_EQ(600, energy);
+}
+
+TEST(InputRateTraceMetadataTest, ReportsLatencyPercentiles) {
+  InputRateTraceMetadata metadata;
+  metadata.Start();
+  for (int i = 0; i < 98; ++i)
+    metadata.AddScrollLatency(base::TimeDelta::FromMilliseconds(16));
+  metadata.AddScrollLatency(base::TimeDelta::FromMilliseconds(100));
+  metadata.AddScrollLatency(base::TimeDelta::FromMilliseconds(100));
+  std::unique_ptr<base::DictionaryValue> block = metadata.Stop();
+
+  double value = 0;
+  EXPECT_TRUE(block->GetDouble("scroll_latency.count", &value));
+  EXPECT_EQ(100, value);
+  // Percentiles are bucket midpoints, within an eighth of the latency.
+  EXPECT_TRUE(block->GetDouble("scroll_latency.p50_ms", &value));
+  EXPECT_NEAR(16, value, 2);
+  EXPECT_TRUE(block->GetDouble("scroll_latency.p99_ms", &value));
+  EXPECT_NEAR(100, value, 13);
+}
+
+TEST(InputRateTraceMetadataTest, CountsGesturesPastTheCap) {
+  InputRateTraceMetadata metadata;
+  metadata.Start();
+  for (size_t i = 0; i < InputRateTraceMetadata::kMaxGestures + 2; ++i)
+    metadata.AddGesture(CreateGesture(60));
+  std::unique_ptr<base::DictionaryValue> block = metadata.Stop();
+
+  const base::ListValue* gestures = nullptr;
+  ASSERT_TRUE(block->GetList("gestures", &gestures));
+  EXPECT_EQ(InputRateTraceMetadata::kMaxGestures, gestures->GetSize());
+  int dropped = 0;
+  EXPECT_TRUE(block->GetInteger("dropped_gestures", &dropped));
+  EXPECT_EQ(2, dropped);
+}
+
+}  // namespace content
@@ -62,6 +62,11 @@ class InputRouter : public IPC::Listener {
   // Sets the frame tree node id of associated frame, used when tracing
   // input event latencies to relate events to their target frames.
   virtual void SetFrameTreeNodeId(int frameTreeNodeId) = 0;
+
+  // The frame rate the renderer has been asked to produce frames at while
+  // the user interacts, as decided by its event rate model, or 0 if it runs
+  // at the display rate. Events are batched to match.
+  virtual void SetTargetFrameRate(int fps) = 0;
 };
 
 }  // namespace content
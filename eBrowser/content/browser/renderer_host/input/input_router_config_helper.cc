@@ -5,6 +5,7 @@
 #include "content/browser/renderer_host/input/input_router_config_helper.h"
 
 #include "base/command_line.h"
+#include "base/strings/string_number_conversions.h"
 #include "build/build_config.h"
 #include "content/public/common/content_switches.h"
 #include "ui/events/gesture_detection/gesture_configuration.h"
@@ -71,6 +72,17 @@ InputRouterImpl::Config GetInputRouterConfigForPlatform() {
   InputRouterImpl::Config config;
   config.gesture_config = GetGestureEventQueueConfig();
   config.touch_config = GetTouchEventQueueConfig();
+
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  int batch_window_ms = 0;
+  if (command_line.HasSwitch(switches::kEBrowserInputBatchWindow) &&
+      base::StringToInt(
+          command_line.GetSwitchValueASCII(switches::kEBrowserInputBatchWindow),
+          &batch_window_ms) &&
+      batch_window_ms > 0) {
+    config.batch_window = base::TimeDelta::FromMilliseconds(batch_window_ms);
+  }
   return config;
 }
 
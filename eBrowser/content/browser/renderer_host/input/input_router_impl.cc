@@ -90,7 +90,8 @@ InputRouterImpl::InputRouterImpl(IPC::Sender* sender,
                              features::kTouchpadAndWheelScrollLatching)),
       touch_event_queue_(this, config.touch_config),
       gesture_event_queue_(this, this, config.gesture_config),
-      device_scale_factor_(1.f) {
+      device_scale_factor_(1.f),
+      batch_window_(config.batch_window) {
   DCHECK(sender);
   DCHECK(client);
   DCHECK(ack_handler);
@@ -245,6 +246,11 @@ void InputRouterImpl::SetDeviceScaleFactor(float device_scale_factor) {
   device_scale_factor_ = device_scale_factor;
 }
 
+void InputRouterImpl::SetTargetFrameRate(int fps) {
+  gesture_event_queue_.SetTargetFrameRate(fps);
+  touch_event_queue_.SetTargetFrameRate(fps);
+}
+
 bool InputRouterImpl::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(InputRouterImpl, message)
@@ -345,9 +351,31 @@ bool InputRouterImpl::SendMoveCaret(std::unique_ptr<IPC::Message> message) {
 }
 
 bool InputRouterImpl::Send(IPC::Message* message) {
+  if (!batched_events_.empty())
+    SendBatchedEvents();
   return sender_->Send(message);
 }
 
+void InputRouterImpl::SendBatchedEvents() {
+  batch_timer_.Stop();
+  if (batched_events_.empty())
+    return;
+  TRACE_EVENT1("input", "InputRouterImpl::SendBatchedEvents", "count",
+               batched_events_.size());
+  std::unique_ptr<IPC::Message> message;
+  if (batched_events_.size() == 1) {
+    message.reset(new InputMsg_HandleInputEvent(
+        routing_id(), batched_events_[0].get(), batched_latency_info_[0],
+        InputEventDispatchType::DISPATCH_TYPE_NON_BLOCKING));
+  } else {
+    message.reset(new InputMsg_HandleInputEventBatch(
+        routing_id(), batched_events_, batched_latency_info_));
+  }
+  batched_events_.clear();
+  batched_latency_info_.clear();
+  sender_->Send(message.release());
+}
+
 void InputRouterImpl::FilterAndSendWebInputEvent(
     const WebInputEvent& input_event,
     const ui::LatencyInfo& latency_info) {
@@ -436,6 +464,17 @@ bool InputRouterImpl::OfferToRenderer(const WebInputEvent& input_event,
   //LOG(INFO)<<"device_scale_factor_------------"<<device_scale_factor_;
   const WebInputEvent* event_to_send =
       event_in_viewport ? event_in_viewport.get() : &input_event;
+
+  if (dispatch_type == InputEventDispatchType::DISPATCH_TYPE_NON_BLOCKING &&
+      !batch_window_.is_zero()) {
+    batched_events_.push_back(ui::WebInputEventTraits::Clone(*event_to_send));
+    batched_latency_info_.push_back(latency_info);
+    if (!batch_timer_.IsRunning()) {
+      batch_timer_.Start(FROM_HERE, batch_window_, this,
+                         &InputRouterImpl::SendBatchedEvents);
+    }
+    return true;
+  }
   //LOG(INFO)<<"~~~~~~~~~~~~~~~~~~~~~~~~~~~~Send(new InputMsg_HandleInputEvent";
   if (Send(new InputMsg_HandleInputEvent(routing_id(), event_to_send,
                                          latency_info, dispatch_type))) {
@@ -9,9 +9,11 @@
 
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/browser/renderer_host/input/gesture_event_queue.h"
 #include "content/browser/renderer_host/input/input_router.h"
 #include "content/browser/renderer_host/input/mouse_wheel_event_queue.h"
@@ -21,13 +23,14 @@
 #include "content/common/input/input_event_dispatch_type.h"
 #include "content/common/input/input_event_stream_validator.h"
 #include "content/public/browser/native_web_keyboard_event.h"
+#include "ui/events/blink/scoped_web_input_event.h"
+#include "ui/events/latency_info.h"
 
 namespace IPC {
 class Sender;
 }
 
 namespace ui {
-class LatencyInfo;
 struct DidOverscrollParams;
 }
 
@@ -50,6 +53,9 @@ class CONTENT_EXPORT InputRouterImpl
     Config();
     GestureEventQueue::Config gesture_config;
     TouchEventQueue::Config touch_config;
+    // How long non-blocking events wait to share one IPC with those that
+    // follow them. Zero sends each on its own.
+    base::TimeDelta batch_window;
   };
 
   InputRouterImpl(IPC::Sender* sender,
@@ -74,6 +80,7 @@ class CONTENT_EXPORT InputRouterImpl
   void RequestNotificationWhenFlushed() override;
   bool HasPendingEvents() const override;
   void SetDeviceScaleFactor(float device_scale_factor) override;
+  void SetTargetFrameRate(int fps) override;
 
   // IPC::Listener
   bool OnMessageReceived(const IPC::Message& message) override;
@@ -134,6 +141,10 @@ class CONTENT_EXPORT InputRouterImpl
                        const ui::LatencyInfo& latency_info,
                        InputEventDispatchType dispatch_type);
 
+  // Sends the non-blocking events waiting out the batch window, in one
+  // InputMsg_HandleInputEventBatch if there are several.
+  void SendBatchedEvents();
+
   // IPC message handlers
   void OnInputEventAck(const InputEventAck& ack);
   void OnDidOverscroll(const ui::DidOverscrollParams& params);
@@ -256,6 +267,13 @@ class CONTENT_EXPORT InputRouterImpl
 
   float device_scale_factor_;
 
+  // See Config::batch_window. Any other message sends the batch first, so
+  // the renderer sees everything in the order it was sent.
+  const base::TimeDelta batch_window_;
+  std::vector<ui::ScopedWebInputEvent> batched_events_;
+  std::vector<ui::LatencyInfo> batched_latency_info_;
+  base::OneShotTimer batch_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(InputRouterImpl);
 };
 
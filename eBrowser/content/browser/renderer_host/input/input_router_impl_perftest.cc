@@ -5,6 +5,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 
 #include "base/macros.h"
@@ -17,6 +19,7 @@
 #include "ipc/ipc_sender.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
+#include "ui/events/base_event_utils.h"
 #include "ui/events/blink/web_input_event_traits.h"
 #include "ui/gfx/geometry/vector2d_f.h"
 
@@ -95,14 +98,34 @@ class NullInputRouterClient : public InputRouterClient {
       const ui::LatencyInfo& latency_info) override {}
 };
 
+// Counts what is sent and remembers, in order, the events the renderer owes
+// an ack for: blocking events and the non-blocking touchmoves TouchEventQueue
+// waits on.
 class NullIPCSender : public IPC::Sender {
  public:
-  NullIPCSender() : sent_count_(0) {}
+  struct PendingAck {
+    WebInputEvent::Type type;
+    uint32_t unique_touch_event_id;
+  };
+
+  NullIPCSender() : sent_count_(0), sent_bytes_(0) {}
   ~NullIPCSender() override {}
 
   bool Send(IPC::Message* message) override {
-    delete message;
     ++sent_count_;
+    sent_bytes_ += message->size();
+    if (message->type() == InputMsg_HandleInputEvent::ID) {
+      InputMsg_HandleInputEvent::Param params;
+      if (InputMsg_HandleInputEvent::Read(message, &params))
+        RecordEvent(*std::get<0>(params), std::get<2>(params));
+    } else if (message->type() == InputMsg_HandleInputEventBatch::ID) {
+      InputMsg_HandleInputEventBatch::Param params;
+      if (InputMsg_HandleInputEventBatch::Read(message, &params)) {
+        for (const ui::ScopedWebInputEvent& event : std::get<0>(params))
+          RecordEvent(*event, DISPATCH_TYPE_NON_BLOCKING);
+      }
+    }
+    delete message;
     return true;
   }
 
@@ -112,10 +135,39 @@ class NullIPCSender : public IPC::Sender {
     return message_count;
   }
 
+  size_t GetAndResetSentBytes() {
+    size_t sent_bytes = sent_bytes_;
+    sent_bytes_ = 0;
+    return sent_bytes;
+  }
+
   bool HasMessages() const { return sent_count_ > 0; }
 
+  bool HasPendingAcks() const { return !pending_acks_.empty(); }
+
+  PendingAck TakePendingAck() {
+    PendingAck ack = pending_acks_.front();
+    pending_acks_.pop_front();
+    return ack;
+  }
+
  private:
+  void RecordEvent(const WebInputEvent& event,
+                   InputEventDispatchType dispatch_type) {
+    uint32_t unique_touch_event_id = 0;
+    if (WebInputEvent::isTouchEventType(event.type)) {
+      unique_touch_event_id =
+          static_cast<const WebTouchEvent&>(event).uniqueTouchEventId;
+    }
+    if (dispatch_type == DISPATCH_TYPE_BLOCKING ||
+        event.type == WebInputEvent::TouchMove) {
+      pending_acks_.push_back({event.type, unique_touch_event_id});
+    }
+  }
+
   size_t sent_count_;
+  size_t sent_bytes_;
+  std::deque<PendingAck> pending_acks_;
 };
 
 typedef std::vector<WebGestureEvent> Gestures;
@@ -217,11 +269,15 @@ class InputRouterImplPerfTest : public testing::Test {
     sender_.reset(new NullIPCSender());
     client_.reset(new NullInputRouterClient());
     ack_handler_.reset(new NullInputAckHandler());
+    ResetRouter(InputRouterImpl::Config());
+  }
+
+  void ResetRouter(const InputRouterImpl::Config& config) {
     input_router_.reset(new InputRouterImpl(sender_.get(),
                                             client_.get(),
                                             ack_handler_.get(),
                                             MSG_ROUTING_NONE,
-                                            InputRouterImpl::Config()));
+                                            config));
   }
 
   void TearDown() override {
@@ -305,6 +361,114 @@ class InputRouterImplPerfTest : public testing::Test {
     }
   }
 
+  // Sends |events| with the moves marked non-blocking, so that with batching
+  // on each swipe reaches the renderer as start, one batch and end.
+  void SimulateNonBlockingTouchSequence(const char* test_name,
+                                        Touches events,
+                                        size_t iterations) {
+    OnHasTouchEventHandlers(true);
+
+    for (WebTouchEvent& touch : events) {
+      if (touch.type == WebInputEvent::TouchMove)
+        touch.dispatchType = WebInputEvent::EventNonBlocking;
+    }
+    const size_t event_count = events.size();
+    const size_t total_event_count = event_count * iterations;
+
+    size_t sent_count = 0;
+    {
+      InputEventTimer timer(test_name, total_event_count);
+      for (size_t n = 0; n < iterations; ++n) {
+        for (const WebTouchEvent& touch : events) {
+          SendEvent(touch, CreateLatencyInfo());
+          SendEventAckIfNecessary(touch, INPUT_EVENT_ACK_STATE_CONSUMED);
+        }
+        sent_count += GetAndResetSentEventCount();
+        EXPECT_EQ(event_count, GetAndResetAckCount());
+      }
+    }
+    perf_test::PrintResult("messages_per_event", "", test_name,
+                           static_cast<double>(sent_count) / total_event_count,
+                           "messages", true);
+  }
+
+  // Sends one step of |touches| and |gestures| every input frame while the
+  // renderer acks a single event every |steps_per_frame| steps, as when the
+  // eBrowser reduced rate leaves the renderer slower than the input. What
+  // waits for an ack meanwhile is coalesced by the touch and gesture queues.
+  // Either sequence may be empty; otherwise they are of equal length.
+  void SimulateFramePacedSequence(const char* test_name,
+                                  const Touches& touches,
+                                  const Gestures& gestures,
+                                  size_t steps_per_frame,
+                                  InputEventAckState touch_ack_result,
+                                  size_t iterations) {
+    OnHasTouchEventHandlers(true);
+
+    const size_t steps = std::max(touches.size(), gestures.size());
+    const size_t event_count = touches.size() + gestures.size();
+    const size_t total_event_count = event_count * iterations;
+    size_t max_queue_depth = 0;
+    size_t sent_count = 0;
+    size_t sent_bytes = 0;
+
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (size_t n = 0; n < iterations; ++n) {
+      size_t routed_count = 0;
+      for (size_t i = 0; i < steps; ++i) {
+        if (!touches.empty()) {
+          WebTouchEvent touch = touches[i];
+          touch.uniqueTouchEventId = ui::GetNextTouchEventId();
+          SendEvent(touch, CreateLatencyInfo());
+          ++routed_count;
+        }
+        if (!gestures.empty()) {
+          SendEvent(gestures[i], CreateLatencyInfo());
+          ++routed_count;
+        }
+        max_queue_depth = std::max(max_queue_depth, routed_count - AckCount());
+        if ((i + 1) % steps_per_frame == 0 && sender_->HasPendingAcks())
+          AckNextEvent(touch_ack_result);
+      }
+
+      // Acks may release further events, so drain until nothing is owed.
+      while (sender_->HasPendingAcks())
+        AckNextEvent(touch_ack_result);
+
+      sent_count += GetAndResetSentEventCount();
+      sent_bytes += sender_->GetAndResetSentBytes();
+      EXPECT_EQ(event_count, GetAndResetAckCount());
+    }
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    perf_test::PrintResult("throughput", "", test_name,
+                           total_event_count / elapsed.InSecondsF(),
+                           "events/s", true);
+    perf_test::PrintResult(
+        "avg_time_per_event", "", test_name,
+        static_cast<size_t>((elapsed / total_event_count).InMicroseconds()),
+        "us", true);
+    perf_test::PrintResult("max_queue_depth", "", test_name, max_queue_depth,
+                           "events", true);
+    perf_test::PrintResult("messages_per_event", "", test_name,
+                           static_cast<double>(sent_count) / total_event_count,
+                           "messages", true);
+    perf_test::PrintResult("bytes_per_event", "", test_name,
+                           static_cast<double>(sent_bytes) / total_event_count,
+                           "bytes", true);
+  }
+
+  // Acks the oldest event the renderer owes an ack for.
+  void AckNextEvent(InputEventAckState touch_ack_result) {
+    NullIPCSender::PendingAck pending = sender_->TakePendingAck();
+    InputEventAck ack(pending.type,
+                      WebInputEvent::isTouchEventType(pending.type)
+                          ? touch_ack_result
+                          : INPUT_EVENT_ACK_STATE_CONSUMED,
+                      pending.unique_touch_event_id);
+    input_router_->OnMessageReceived(InputHostMsg_HandleInputEvent_ACK(0, ack));
+  }
+
   void SimulateTouchAndScrollEventSequence(const char* test_name,
                                            size_t steps,
                                            const gfx::Vector2dF& origin,
@@ -367,6 +531,73 @@ TEST_F(InputRouterImplPerfTest, TouchSwipeDelayedAck) {
       kDefaultIterations);
 }
 
+TEST_F(InputRouterImplPerfTest, TouchSwipeNonBlocking) {
+  SimulateNonBlockingTouchSequence(
+      "TouchSwipeNonBlocking ",
+      BuildTouchSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      kDefaultIterations);
+}
+
+TEST_F(InputRouterImplPerfTest, TouchSwipeNonBlockingBatched) {
+  InputRouterImpl::Config config;
+  config.batch_window = base::TimeDelta::FromMilliseconds(16);
+  ResetRouter(config);
+  SimulateNonBlockingTouchSequence(
+      "TouchSwipeNonBlockingBatched ",
+      BuildTouchSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      kDefaultIterations);
+}
+
+// Touch arriving at 120Hz against a renderer acking at 30fps.
+const size_t kStepsPerReducedFrame(4);
+
+TEST_F(InputRouterImplPerfTest, TouchSwipeFramePaced) {
+  SimulateFramePacedSequence(
+      "TouchSwipeFramePaced ",
+      BuildTouchSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      Gestures(), kStepsPerReducedFrame, INPUT_EVENT_ACK_STATE_CONSUMED,
+      kDefaultIterations);
+}
+
+TEST_F(InputRouterImplPerfTest, GestureScrollFramePaced) {
+  SimulateFramePacedSequence(
+      "GestureScrollFramePaced ", Touches(),
+      BuildScrollSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      kStepsPerReducedFrame, INPUT_EVENT_ACK_STATE_CONSUMED,
+      kDefaultIterations);
+}
+
+// Unconsumed touches let the scroll start, after which TouchEventQueue sends
+// touchmoves async.
+TEST_F(InputRouterImplPerfTest, TouchSwipeToGestureScrollAsync) {
+  SimulateFramePacedSequence(
+      "TouchSwipeToGestureScrollAsync ",
+      BuildTouchSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      BuildScrollSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance), 1,
+      INPUT_EVENT_ACK_STATE_NOT_CONSUMED, kDefaultIterations);
+}
+
+TEST_F(InputRouterImplPerfTest, TouchSwipeToGestureScrollAsyncFramePaced) {
+  SimulateFramePacedSequence(
+      "TouchSwipeToGestureScrollAsyncFramePaced ",
+      BuildTouchSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      BuildScrollSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      kStepsPerReducedFrame, INPUT_EVENT_ACK_STATE_NOT_CONSUMED,
+      kDefaultIterations);
+}
+
+TEST_F(InputRouterImplPerfTest, TouchSwipeToGestureScrollAsyncBatched) {
+  InputRouterImpl::Config config;
+  config.batch_window = base::TimeDelta::FromMilliseconds(16);
+  ResetRouter(config);
+  SimulateFramePacedSequence(
+      "TouchSwipeToGestureScrollAsyncBatched ",
+      BuildTouchSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      BuildScrollSequence(kDefaultSteps, kDefaultOrigin, kDefaultDistance),
+      kStepsPerReducedFrame, INPUT_EVENT_ACK_STATE_NOT_CONSUMED,
+      kDefaultIterations);
+}
+
 TEST_F(InputRouterImplPerfTest, GestureScroll) {
   SimulateEventSequence(
       "GestureScroll ",
@@ -1058,6 +1058,36 @@ TEST_F(InputRouterImplTest, GestureTypesIgnoringAck) {
   }
 }
 
+TEST_F(InputRouterImplTest, BatchesNonBlockingEvents) {
+  config_.batch_window = base::TimeDelta::FromMilliseconds(5);
+  TearDown();
+  SetUp();
+
+  // Non-blocking events are acked at once but wait out the window together.
+  SimulateGestureEvent(WebInputEvent::GestureScrollBegin,
+                       blink::WebGestureDeviceTouchscreen);
+  SimulateGestureEvent(WebInputEvent::GestureScrollEnd,
+                       blink::WebGestureDeviceTouchscreen);
+  EXPECT_EQ(2U, ack_handler_->GetAndResetAckCount());
+  EXPECT_EQ(0U, process_->sink().message_count());
+  RunTasksAndWait(base::TimeDelta::FromMilliseconds(10));
+  ASSERT_EQ(1U, process_->sink().message_count());
+  EXPECT_EQ(static_cast<uint32_t>(InputMsg_HandleInputEventBatch::ID),
+            process_->sink().GetMessageAt(0)->type());
+  process_->sink().ClearMessages();
+
+  // A blocking event sends those waiting ahead of itself.
+  SimulateGestureEvent(WebInputEvent::GestureScrollBegin,
+                       blink::WebGestureDeviceTouchscreen);
+  SimulateGestureScrollUpdateEvent(0, -5, 0,
+                                   blink::WebGestureDeviceTouchscreen);
+  ASSERT_EQ(2U, process_->sink().message_count());
+  EXPECT_EQ(static_cast<uint32_t>(InputMsg_HandleInputEvent::ID),
+            process_->sink().GetMessageAt(0)->type());
+  EXPECT_EQ(static_cast<uint32_t>(InputMsg_HandleInputEvent::ID),
+            process_->sink().GetMessageAt(1)->type());
+}
+
 TEST_F(InputRouterImplTest, MouseTypesIgnoringAck) {
   int start_type = static_cast<int>(WebInputEvent::MouseDown);
   int end_type = static_cast<int>(WebInputEvent::ContextMenu);
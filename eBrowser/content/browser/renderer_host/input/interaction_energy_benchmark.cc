@@ -0,0 +1,155 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/interaction_energy_benchmark.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/values.h"
+#include "content/browser/renderer_host/input/render_widget_host_latency_tracker.h"
+#include "content/common/input/synthetic_smooth_scroll_gesture_params.h"
+#include "device/battery/battery_status.mojom.h"
+
+namespace content {
+
+InteractionEnergyBenchmark::InteractionEnergyBenchmark(
+    Client* client,
+    RenderWidgetHostLatencyTracker* latency_tracker,
+    const std::vector<float>& speeds,
+    const gfx::Vector2dF& distance,
+    const gfx::PointF& anchor,
+    const ReportCallback& callback)
+    : client_(client),
+      latency_tracker_(latency_tracker),
+      speeds_(speeds),
+      distance_(distance),
+      anchor_(anchor),
+      callback_(callback),
+      is_running_(false),
+      current_run_(0),
+      run_frames_(0),
+      run_start_battery_level_(0),
+      has_battery_status_(false),
+      battery_level_(0),
+      charging_(false),
+      weak_ptr_factory_(this) {
+  DCHECK(client_);
+  DCHECK(latency_tracker_);
+}
+
+InteractionEnergyBenchmark::~InteractionEnergyBenchmark() {}
+
+void InteractionEnergyBenchmark::Start() {
+  DCHECK(!is_running_);
+  is_running_ = true;
+  current_run_ = 0;
+  runs_.reset(new base::ListValue());
+  if (speeds_.empty()) {
+    Finish(true);
+    return;
+  }
+  StartRun();
+}
+
+void InteractionEnergyBenchmark::DidSwapCompositorFrame() {
+  if (is_running_)
+    ++run_frames_;
+}
+
+void InteractionEnergyBenchmark::OnBatteryStatusUpdate(
+    const device::BatteryStatus& status) {
+  if (!has_battery_status_ && is_running_)
+    run_start_battery_level_ = status.level;
+  has_battery_status_ = true;
+  battery_level_ = status.level;
+  charging_ = status.charging;
+}
+
+void InteractionEnergyBenchmark::StartRun() {
+  bool models_enabled = current_run_ % 2 == 0;
+  client_->SetInputModelsEnabled(models_enabled);
+
+  SyntheticSmoothScrollGestureParams params;
+  params.gesture_source_type = SyntheticGestureParams::TOUCH_INPUT;
+  params.anchor = anchor_;
+  params.distances.push_back(models_enabled ? distance_ : -distance_);
+  params.speed_in_pixels_s = speeds_[current_run_ / 2];
+  params.prevent_fling = true;
+
+  latency_tracker_->ResetScrollLatencySummary();
+  run_frames_ = 0;
+  run_start_battery_level_ = battery_level_;
+  run_start_time_ = base::TimeTicks::Now();
+  client_->QueueSyntheticGesture(
+      SyntheticGesture::Create(params),
+      base::Bind(&InteractionEnergyBenchmark::OnRunCompleted,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+void InteractionEnergyBenchmark::OnRunCompleted(
+    SyntheticGesture::Result result) {
+  if (result != SyntheticGesture::GESTURE_FINISHED) {
+    Finish(false);
+    return;
+  }
+
+  base::TimeDelta duration = base::TimeTicks::Now() - run_start_time_;
+  const RenderWidgetHostLatencyTracker::ScrollLatencySummary& latency =
+      latency_tracker_->scroll_latency_summary();
+
+  std::unique_ptr<base::DictionaryValue> run(new base::DictionaryValue());
+  run->SetDouble("speed", speeds_[current_run_ / 2]);
+  run->SetBoolean("models_enabled", current_run_ % 2 == 0);
+  run->SetDouble("duration_ms", duration.InMillisecondsF());
+  run->SetInteger("frames", run_frames_);
+  run->SetDouble("frames_per_second",
+                 duration > base::TimeDelta()
+                     ? run_frames_ / duration.InSecondsF()
+                     : 0);
+
+  std::unique_ptr<base::DictionaryValue> latency_value(
+      new base::DictionaryValue());
+  latency_value->SetInteger("count", latency.count);
+  latency_value->SetDouble(
+      "mean_ms",
+      latency.count ? latency.total.InMillisecondsF() / latency.count : 0);
+  latency_value->SetDouble("max_ms", latency.max.InMillisecondsF());
+  run->Set("scroll_update_latency", std::move(latency_value));
+
+  if (has_battery_status_) {
+    std::unique_ptr<base::DictionaryValue> battery(new base::DictionaryValue());
+    battery->SetDouble("start_level", run_start_battery_level_);
+    battery->SetDouble("end_level", battery_level_);
+    battery->SetBoolean("charging", charging_);
+    run->Set("battery", std::move(battery));
+  }
+  runs_->Append(std::move(run));
+
+  if (++current_run_ == run_count()) {
+    Finish(true);
+    return;
+  }
+  StartRun();
+}
+
+void InteractionEnergyBenchmark::Finish(bool success) {
+  is_running_ = false;
+  client_->SetInputModelsEnabled(true);
+
+  std::string report;
+  if (success) {
+    base::DictionaryValue value;
+    value.Set("runs", std::move(runs_));
+    base::JSONWriter::Write(value, &report);
+  }
+  runs_.reset();
+  // The callback may delete |this|.
+  ReportCallback callback = callback_;
+  callback.Run(report);
+}
+
+}  // namespace content
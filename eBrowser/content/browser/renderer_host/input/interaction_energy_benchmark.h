@@ -0,0 +1,119 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_INPUT_INTERACTION_ENERGY_BENCHMARK_H_
+#define CONTENT_BROWSER_RENDERER_HOST_INPUT_INTERACTION_ENERGY_BENCHMARK_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "content/browser/renderer_host/input/synthetic_gesture.h"
+#include "content/common/content_export.h"
+#include "ui/gfx/geometry/point_f.h"
+#include "ui/gfx/geometry/vector2d_f.h"
+
+namespace base {
+class ListValue;
+}
+
+namespace device {
+class BatteryStatus;
+}
+
+namespace content {
+
+class RenderWidgetHostLatencyTracker;
+
+// Runs a touch scroll at each requested speed, once with the renderer's frame
+// rate models enabled and once with them disabled, and reports for each run
+// the compositor frames received, the scroll update latencies seen by
+// RenderWidgetHostLatencyTracker and the battery level change, as JSON:
+//
+//   {"runs": [{"speed": 800, "models_enabled": true, "duration_ms": 1250.5,
+//              "frames": 40, "frames_per_second": 32,
+//              "scroll_update_latency": {"count": 38, "mean_ms": 41.2,
+//                                        "max_ms": 58.1},
+//              "battery": {"start_level": 0.81, "end_level": 0.81,
+//                          "charging": false}}, ...]}
+//
+// "battery" is left out until the battery status is known. The second run of
+// each speed scrolls back by the same distance, so that both runs cover the
+// same content.
+class CONTENT_EXPORT InteractionEnergyBenchmark {
+ public:
+  class Client {
+   public:
+    virtual ~Client() {}
+
+    // Enables or disables the renderer's frame rate models. Ordered with the
+    // input events of the gestures that follow.
+    virtual void SetInputModelsEnabled(bool enabled) = 0;
+    virtual void QueueSyntheticGesture(
+        std::unique_ptr<SyntheticGesture> gesture,
+        const base::Callback<void(SyntheticGesture::Result)>& on_complete) = 0;
+  };
+
+  // Called with the report, or an empty string if a gesture failed.
+  using ReportCallback = base::Callback<void(const std::string& report)>;
+
+  // |speeds| are in DIPs per second. |client| and |latency_tracker| must
+  // outlive the benchmark.
+  InteractionEnergyBenchmark(Client* client,
+                             RenderWidgetHostLatencyTracker* latency_tracker,
+                             const std::vector<float>& speeds,
+                             const gfx::Vector2dF& distance,
+                             const gfx::PointF& anchor,
+                             const ReportCallback& callback);
+  ~InteractionEnergyBenchmark();
+
+  void Start();
+
+  // Counts a compositor frame submitted by the renderer.
+  void DidSwapCompositorFrame();
+  void OnBatteryStatusUpdate(const device::BatteryStatus& status);
+
+  bool is_running() const { return is_running_; }
+
+ private:
+  size_t run_count() const { return 2 * speeds_.size(); }
+
+  void StartRun();
+  void OnRunCompleted(SyntheticGesture::Result result);
+  void Finish(bool success);
+
+  Client* client_;
+  RenderWidgetHostLatencyTracker* latency_tracker_;
+  const std::vector<float> speeds_;
+  const gfx::Vector2dF distance_;
+  const gfx::PointF anchor_;
+  ReportCallback callback_;
+  bool is_running_;
+
+  // Runs alternate between the models enabled and disabled, two per speed.
+  size_t current_run_;
+  base::TimeTicks run_start_time_;
+  int run_frames_;
+  double run_start_battery_level_;
+
+  bool has_battery_status_;
+  double battery_level_;
+  bool charging_;
+
+  std::unique_ptr<base::ListValue> runs_;
+
+  base::WeakPtrFactory<InteractionEnergyBenchmark> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(InteractionEnergyBenchmark);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_INPUT_INTERACTION_ENERGY_BENCHMARK_H_
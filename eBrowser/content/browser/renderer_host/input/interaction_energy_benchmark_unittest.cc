@@ -0,0 +1,191 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/input/interaction_energy_benchmark.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/macros.h"
+#include "base/values.h"
+#include "content/browser/renderer_host/input/render_widget_host_latency_tracker.h"
+#include "device/battery/battery_status.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+namespace {
+
+class TestClient : public InteractionEnergyBenchmark::Client {
+ public:
+  TestClient() {}
+  ~TestClient() override {}
+
+  void SetInputModelsEnabled(bool enabled) override {
+    models_enabled_.push_back(enabled);
+  }
+
+  void QueueSyntheticGesture(
+      std::unique_ptr<SyntheticGesture> gesture,
+      const base::Callback<void(SyntheticGesture::Result)>& on_complete)
+      override {
+    EXPECT_TRUE(gesture);
+    EXPECT_TRUE(pending_callback_.is_null());
+    pending_callback_ = on_complete;
+  }
+
+  bool has_pending_gesture() const { return !pending_callback_.is_null(); }
+
+  void CompleteGesture(SyntheticGesture::Result result) {
+    ASSERT_TRUE(has_pending_gesture());
+    base::Callback<void(SyntheticGesture::Result)> callback =
+        pending_callback_;
+    pending_callback_.Reset();
+    callback.Run(result);
+  }
+
+  const std::vector<bool>& models_enabled() const { return models_enabled_; }
+
+ private:
+  std::vector<bool> models_enabled_;
+  base::Callback<void(SyntheticGesture::Result)> pending_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestClient);
+};
+
+}  // namespace
+
+class InteractionEnergyBenchmarkTest : public testing::Test {
+ public:
+  InteractionEnergyBenchmarkTest() : report_count_(0) {
+    latency_tracker_.Initialize(1, 1);
+  }
+
+  std::unique_ptr<InteractionEnergyBenchmark> CreateBenchmark(
+      const std::vector<float>& speeds) {
+    return std::unique_ptr<InteractionEnergyBenchmark>(
+        new InteractionEnergyBenchmark(
+            &client_, &latency_tracker_, speeds, gfx::Vector2dF(0, -500),
+            gfx::PointF(100, 100),
+            base::Bind(&InteractionEnergyBenchmarkTest::OnReport,
+                       base::Unretained(this))));
+  }
+
+  std::unique_ptr<base::DictionaryValue> ParseReport() {
+    return base::DictionaryValue::From(base::JSONReader::Read(report_));
+  }
+
+ protected:
+  TestClient client_;
+  RenderWidgetHostLatencyTracker latency_tracker_;
+  std::string report_;
+  int report_count_;
+
+ private:
+  void OnReport(const std::string& report) {
+    report_ = report;
+    ++report_count_;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(InteractionEnergyBenchmarkTest);
+};
+
+TEST_F(InteractionEnergyBenchmarkTest, RunsEachSpeedWithAndWithoutModels) {
+  std::unique_ptr<InteractionEnergyBenchmark> benchmark =
+      CreateBenchmark({400, 1600});
+  benchmark->Start();
+  EXPECT_TRUE(benchmark->is_running());
+
+  device::BatteryStatus status;
+  status.charging = false;
+  status.level = 0.75;
+  benchmark->OnBatteryStatusUpdate(status);
+
+  const int kFrames[] = {10, 20, 30, 40};
+  for (size_t i = 0; i < arraysize(kFrames); ++i) {
+    ASSERT_TRUE(client_.has_pending_gesture());
+    for (int frame = 0; frame < kFrames[i]; ++frame)
+      benchmark->DidSwapCompositorFrame();
+    if (i == 1) {
+      status.level = 0.74;
+      benchmark->OnBatteryStatusUpdate(status);
+    }
+    EXPECT_EQ(0, report_count_);
+    client_.CompleteGesture(SyntheticGesture::GESTURE_FINISHED);
+  }
+  EXPECT_FALSE(client_.has_pending_gesture());
+  EXPECT_FALSE(benchmark->is_running());
+  EXPECT_EQ(1, report_count_);
+
+  // Models are restored once done.
+  EXPECT_EQ(std::vector<bool>({true, false, true, false, true}),
+            client_.models_enabled());
+
+  std::unique_ptr<base::DictionaryValue> report = ParseReport();
+  ASSERT_TRUE(report);
+  base::ListValue* runs = nullptr;
+  ASSERT_TRUE(report->GetList("runs", &runs));
+  ASSERT_EQ(4u, runs->GetSize());
+  const float kSpeeds[] = {400, 400, 1600, 1600};
+  for (size_t i = 0; i < runs->GetSize(); ++i) {
+    base::DictionaryValue* run = nullptr;
+    ASSERT_TRUE(runs->GetDictionary(i, &run));
+    double speed = 0;
+    EXPECT_TRUE(run->GetDouble("speed", &speed));
+    EXPECT_EQ(kSpeeds[i], speed);
+    bool models_enabled = false;
+    EXPECT_TRUE(run->GetBoolean("models_enabled", &models_enabled));
+    EXPECT_EQ(i % 2 == 0, models_enabled);
+    int frames = 0;
+    EXPECT_TRUE(run->GetInteger("frames", &frames));
+    EXPECT_EQ(kFrames[i], frames);
+    int latency_count = -1;
+    EXPECT_TRUE(run->GetInteger("scroll_update_latency.count",
+                                &latency_count));
+    EXPECT_EQ(0, latency_count);
+    double start_level = 0;
+    double end_level = 0;
+    EXPECT_TRUE(run->GetDouble("battery.start_level", &start_level));
+    EXPECT_TRUE(run->GetDouble("battery.end_level", &end_level));
+    EXPECT_DOUBLE_EQ(i < 2 ? 0.75 : 0.74, start_level);
+    EXPECT_DOUBLE_EQ(i < 1 ? 0.75 : 0.74, end_level);
+  }
+}
+
+TEST_F(InteractionEnergyBenchmarkTest, NoBatteryStatus) {
+  std::unique_ptr<InteractionEnergyBenchmark> benchmark =
+      CreateBenchmark({800});
+  benchmark->Start();
+  client_.CompleteGesture(SyntheticGesture::GESTURE_FINISHED);
+  client_.CompleteGesture(SyntheticGesture::GESTURE_FINISHED);
+  ASSERT_EQ(1, report_count_);
+
+  std::unique_ptr<base::DictionaryValue> report = ParseReport();
+  ASSERT_TRUE(report);
+  base::ListValue* runs = nullptr;
+  ASSERT_TRUE(report->GetList("runs", &runs));
+  EXPECT_EQ(2u, runs->GetSize());
+  base::DictionaryValue* run = nullptr;
+  ASSERT_TRUE(runs->GetDictionary(0, &run));
+  EXPECT_FALSE(run->HasKey("battery"));
+}
+
+TEST_F(InteractionEnergyBenchmarkTest, FailedGestureReportsNothing) {
+  std::unique_ptr<InteractionEnergyBenchmark> benchmark =
+      CreateBenchmark({800});
+  benchmark->Start();
+  client_.CompleteGesture(
+      SyntheticGesture::GESTURE_SOURCE_TYPE_NOT_IMPLEMENTED);
+  EXPECT_FALSE(client_.has_pending_gesture());
+  EXPECT_FALSE(benchmark->is_running());
+  EXPECT_EQ(1, report_count_);
+  EXPECT_TRUE(report_.empty());
+  EXPECT_EQ(std::vector<bool>({true, true}), client_.models_enabled());
+}
+
+}  // namespace content
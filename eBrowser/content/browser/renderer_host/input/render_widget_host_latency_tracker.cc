@@ -6,10 +6,21 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_argument.h"
 #include "build/build_config.h"
+#include "content/browser/renderer_host/input/frame_latency_log.h"
+#include "content/browser/renderer_host/input/input_rate_trace_metadata.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 #include "ui/events/blink/web_input_event_traits.h"
 
 using blink::WebGestureEvent;
@@ -354,15 +365,37 @@ void AddLatencyInfoComponentIds(LatencyInfo* latency,
   }
 }
 
+// Smoothness histograms are split by the lowest target frame rate of the
+// gesture, rounded down to a multiple of 10fps.
+std::string TargetFrameRateSuffix(int fps) {
+  const int kMaxFrameRate = ui::ScrollUpdatePacer::kMaxFrameRate;
+  int bucket = std::max(10, std::min(kMaxFrameRate, fps / 10 * 10));
+  return ".Target" + base::IntToString(bucket);
+}
+
 }  // namespace
 
+RenderWidgetHostLatencyTracker::ScrollLatencySummary::ScrollLatencySummary()
+    : count(0) {}
+
+RenderWidgetHostLatencyTracker::GestureSmoothness::GestureSmoothness()
+    : frame_count(0),
+      interval_sum_ms(0),
+      interval_square_sum_ms(0),
+      min_target_frame_rate(ui::ScrollUpdatePacer::kMaxFrameRate),
+      latency_count(0) {}
+
 RenderWidgetHostLatencyTracker::RenderWidgetHostLatencyTracker()
     : last_event_id_(0),
       latency_component_id_(0),
       device_scale_factor_(1),
       has_seen_first_gesture_scroll_update_(false),
       multi_finger_gesture_(false),
-      touch_start_default_prevented_(false) {}
+      touch_start_default_prevented_(false),
+      target_frame_rate_(ui::ScrollUpdatePacer::kMaxFrameRate),
+      in_scroll_gesture_(false),
+      gesture_latency_histograms_(
+          "RenderWidgetHostLatencyTracker::GestureLatency") {}
 
 RenderWidgetHostLatencyTracker::~RenderWidgetHostLatencyTracker() {}
 
@@ -374,6 +407,176 @@ void RenderWidgetHostLatencyTracker::Initialize(int routing_id,
   latency_component_id_ = routing_id | last_event_id_;
 }
 
+void RenderWidgetHostLatencyTracker::ResetScrollLatencySummary() {
+  scroll_latency_summary_ = ScrollLatencySummary();
+}
+
+void RenderWidgetHostLatencyTracker::AddScrollLatencySample(
+    const LatencyInfo& latency,
+    const LatencyInfo::LatencyComponent& gpu_swap_begin_component) {
+  if (latency.coalesced())
+    return;
+  LatencyInfo::LatencyComponent original_component;
+  if (!latency.FindLatency(
+          ui::INPUT_EVENT_LATENCY_FIRST_SCROLL_UPDATE_ORIGINAL_COMPONENT,
+          latency_component_id_, &original_component) &&
+      !latency.FindLatency(
+          ui::INPUT_EVENT_LATENCY_SCROLL_UPDATE_ORIGINAL_COMPONENT,
+          latency_component_id_, &original_component)) {
+    return;
+  }
+  base::TimeDelta sample =
+      gpu_swap_begin_component.last_event_time -
+      original_component.first_event_time;
+  if (sample < base::TimeDelta())
+    return;
+  ++scroll_latency_summary_.count;
+  scroll_latency_summary_.total += sample;
+  scroll_latency_summary_.max = std::max(scroll_latency_summary_.max, sample);
+  gesture_latency_histograms_.Record(WebInputEvent::GestureScrollUpdate,
+                                     sample, 1);
+  InputRateTraceMetadata::GetInstance()->AddScrollLatency(sample);
+  if (in_scroll_gesture_) {
+    GestureSmoothness& gesture = gesture_smoothness_;
+    ++gesture.latency_count;
+    gesture.latency_sum += sample;
+    gesture.max_latency = std::max(gesture.max_latency, sample);
+  }
+}
+
+void RenderWidgetHostLatencyTracker::AddFrameLatencyLogEntry(
+    const LatencyInfo& latency,
+    const LatencyInfo::LatencyComponent& gpu_swap_begin_component,
+    const LatencyInfo::LatencyComponent& gpu_swap_end_component) {
+  FrameLatencyLog::Entry entry;
+  LatencyInfo::LatencyComponent component;
+  if (latency.FindLatency(
+          ui::INPUT_EVENT_LATENCY_FIRST_SCROLL_UPDATE_ORIGINAL_COMPONENT,
+          latency_component_id_, &component) ||
+      latency.FindLatency(
+          ui::INPUT_EVENT_LATENCY_SCROLL_UPDATE_ORIGINAL_COMPONENT,
+          latency_component_id_, &component) ||
+      latency.FindLatency(ui::INPUT_EVENT_LATENCY_ORIGINAL_COMPONENT,
+                          latency_component_id_, &component)) {
+    entry.input_time = component.first_event_time;
+  }
+  if (latency.FindLatency(ui::INPUT_EVENT_LATENCY_BEGIN_RWH_COMPONENT,
+                          latency_component_id_, &component)) {
+    entry.browser_time = component.event_time;
+  }
+  if (latency.FindLatency(ui::INPUT_EVENT_LATENCY_PACED_RELEASE_COMPONENT, 0,
+                          &component)) {
+    entry.paced_release_time = component.event_time;
+  }
+  if (latency.FindLatency(
+          ui::INPUT_EVENT_LATENCY_RENDERING_SCHEDULED_MAIN_COMPONENT, 0,
+          &component)) {
+    entry.handled_time = component.event_time;
+    entry.handled_on_main = true;
+  } else if (latency.FindLatency(
+                 ui::INPUT_EVENT_LATENCY_RENDERING_SCHEDULED_IMPL_COMPONENT, 0,
+                 &component)) {
+    entry.handled_time = component.event_time;
+  }
+  if (latency.FindLatency(ui::INPUT_EVENT_LATENCY_RENDERER_SWAP_COMPONENT, 0,
+                          &component)) {
+    entry.renderer_swap_time = component.event_time;
+  }
+  if (latency.FindLatency(
+          ui::INPUT_EVENT_BROWSER_RECEIVED_RENDERER_SWAP_COMPONENT, 0,
+          &component)) {
+    entry.browser_received_swap_time = component.event_time;
+  }
+  entry.gpu_swap_begin_time = gpu_swap_begin_component.event_time;
+  entry.present_time = gpu_swap_end_component.event_time;
+  entry.target_frame_rate = target_frame_rate_;
+  FrameLatencyLog::GetInstance()->Add(entry);
+}
+
+void RenderWidgetHostLatencyTracker::SetTargetFrameRate(int fps) {
+  const int kMaxFrameRate = ui::ScrollUpdatePacer::kMaxFrameRate;
+  target_frame_rate_ = fps > 0 ? std::min(fps, kMaxFrameRate) : kMaxFrameRate;
+  if (in_scroll_gesture_) {
+    gesture_smoothness_.min_target_frame_rate =
+        std::min(gesture_smoothness_.min_target_frame_rate, target_frame_rate_);
+  }
+}
+
+void RenderWidgetHostLatencyTracker::AddPresentedScrollFrame(
+    base::TimeTicks frame_time) {
+  GestureSmoothness& gesture = gesture_smoothness_;
+  if (gesture.frame_count) {
+    // Latencies of events presented in the same frame share its swap time.
+    if (frame_time <= gesture.last_frame_time)
+      return;
+    base::TimeDelta interval = frame_time - gesture.last_frame_time;
+    double interval_ms = interval.InMillisecondsF();
+    gesture.interval_sum_ms += interval_ms;
+    gesture.interval_square_sum_ms += interval_ms * interval_ms;
+    gesture.max_interval = std::max(gesture.max_interval, interval);
+  } else {
+    gesture.first_frame_time = frame_time;
+  }
+  gesture.last_frame_time = frame_time;
+  ++gesture.frame_count;
+}
+
+void RenderWidgetHostLatencyTracker::ReportGestureSmoothness() {
+  const GestureSmoothness& gesture = gesture_smoothness_;
+  // Smoothness needs at least two intervals.
+  if (gesture.frame_count < 3)
+    return;
+
+  int intervals = gesture.frame_count - 1;
+  double mean_interval_ms = gesture.interval_sum_ms / intervals;
+  double presented_fps = 1000 / mean_interval_ms;
+  double interval_variance =
+      std::max(0.0, gesture.interval_square_sum_ms / intervals -
+                        mean_interval_ms * mean_interval_ms);
+
+  std::string suffix = TargetFrameRateSuffix(gesture.min_target_frame_rate);
+  base::LinearHistogram::FactoryGet(
+      "Event.Smoothness.ScrollUpdate.PresentedFps" + suffix, 1, 121, 122,
+      base::HistogramBase::kUmaTargetedHistogramFlag)
+      ->Add(static_cast<int>(presented_fps + 0.5));
+  base::Histogram::FactoryGet(
+      "Event.Smoothness.ScrollUpdate.FrameIntervalVariance" + suffix, 1, 10000,
+      50, base::HistogramBase::kUmaTargetedHistogramFlag)
+      ->Add(static_cast<int>(interval_variance + 0.5));
+  base::Histogram::FactoryTimeGet(
+      "Event.Smoothness.ScrollUpdate.MaxFrameGap" + suffix,
+      base::TimeDelta::FromMilliseconds(1), base::TimeDelta::FromSeconds(1),
+      50, base::HistogramBase::kUmaTargetedHistogramFlag)
+      ->AddTime(gesture.max_interval);
+
+  std::unique_ptr<base::trace_event::TracedValue> smoothness(
+      new base::trace_event::TracedValue());
+  smoothness->SetInteger("target_fps", gesture.min_target_frame_rate);
+  smoothness->SetInteger("presented_frames", gesture.frame_count);
+  smoothness->SetDouble("presented_fps", presented_fps);
+  smoothness->SetDouble("frame_interval_variance_ms2", interval_variance);
+  smoothness->SetDouble("max_frame_gap_ms",
+                        gesture.max_interval.InMillisecondsF());
+  TRACE_EVENT_INSTANT1("input,benchmark",
+                       "RenderWidgetHostLatencyTracker::ScrollSmoothness",
+                       TRACE_EVENT_SCOPE_THREAD, "data", std::move(smoothness));
+
+  InputRateTraceMetadata* trace_metadata =
+      InputRateTraceMetadata::GetInstance();
+  if (trace_metadata->is_recording()) {
+    InputRateTraceMetadata::Gesture entry;
+    entry.target_frame_rate = gesture.min_target_frame_rate;
+    entry.presented_frames = gesture.frame_count;
+    entry.presented_fps = presented_fps;
+    entry.duration = gesture.last_frame_time - gesture.first_frame_time;
+    entry.latency_count = gesture.latency_count;
+    if (gesture.latency_count)
+      entry.mean_latency = gesture.latency_sum / gesture.latency_count;
+    entry.max_latency = gesture.max_latency;
+    trace_metadata->AddGesture(entry);
+  }
+}
+
 void RenderWidgetHostLatencyTracker::ComputeInputLatencyHistograms(
     WebInputEvent::Type type,
     int64_t latency_component_id,
@@ -571,6 +774,18 @@ void RenderWidgetHostLatencyTracker::OnInputEvent(
 
   if (event.type == blink::WebInputEvent::GestureScrollBegin) {
     has_seen_first_gesture_scroll_update_ = false;
+    if (in_scroll_gesture_)
+      ReportGestureSmoothness();
+    in_scroll_gesture_ = true;
+    gesture_smoothness_ = GestureSmoothness();
+    gesture_smoothness_.min_target_frame_rate = target_frame_rate_;
+  } else if (event.type == blink::WebInputEvent::GestureScrollEnd) {
+    // Frames presented after the end are not counted; they are the last
+    // one or two of the gesture.
+    if (in_scroll_gesture_)
+      ReportGestureSmoothness();
+    in_scroll_gesture_ = false;
+    gesture_latency_histograms_.MaybeMerge(base::TimeTicks::Now());
   } else if (event.type == blink::WebInputEvent::GestureScrollUpdate) {
     // Make a copy of the INPUT_EVENT_LATENCY_ORIGINAL_COMPONENT with a
     // different name INPUT_EVENT_LATENCY_SCROLL_UPDATE_ORIGINAL_COMPONENT.
@@ -697,6 +912,11 @@ void RenderWidgetHostLatencyTracker::OnFrameSwapped(
     return;
   }
 
+  if (FrameLatencyLog::GetInstance()->is_recording()) {
+    AddFrameLatencyLogEntry(latency, gpu_swap_begin_component,
+                            gpu_swap_end_component);
+  }
+
   ui::SourceEventType source_event_type = latency.source_event_type();
   if (source_event_type == ui::SourceEventType::WHEEL ||
       source_event_type == ui::SourceEventType::TOUCH) {
@@ -704,6 +924,17 @@ void RenderWidgetHostLatencyTracker::OnFrameSwapped(
         gpu_swap_begin_component, gpu_swap_end_component, latency_component_id_,
         latency,
         source_event_type == ui::SourceEventType::WHEEL ? "Wheel" : "Touch");
+    AddScrollLatencySample(latency, gpu_swap_begin_component);
+  }
+
+  if (in_scroll_gesture_ &&
+      (latency.FindLatency(
+           ui::INPUT_EVENT_LATENCY_FIRST_SCROLL_UPDATE_ORIGINAL_COMPONENT,
+           latency_component_id_, nullptr) ||
+       latency.FindLatency(
+           ui::INPUT_EVENT_LATENCY_SCROLL_UPDATE_ORIGINAL_COMPONENT,
+           latency_component_id_, nullptr))) {
+    AddPresentedScrollFrame(gpu_swap_end_component.event_time);
   }
 
   // Compute the old scroll update latency metrics. They are exclusively
@@ -10,9 +10,11 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "content/browser/renderer_host/event_with_latency_info.h"
 #include "content/common/content_export.h"
 #include "content/common/input/input_event_ack_state.h"
+#include "ui/events/blink/latency_histogram.h"
 #include "ui/events/latency_info.h"
 
 namespace content {
@@ -21,6 +23,17 @@ namespace content {
 // a given RenderWidgetHost.
 class CONTENT_EXPORT RenderWidgetHostLatencyTracker {
  public:
+  // Touch or wheel to scroll update swap latencies, the samples of
+  // Event.Latency.ScrollUpdate.*.Time*ToScrollUpdateSwapBegin2, since the last
+  // reset. Benchmarks read them per interaction.
+  struct CONTENT_EXPORT ScrollLatencySummary {
+    ScrollLatencySummary();
+
+    int count;
+    base::TimeDelta total;
+    base::TimeDelta max;
+  };
+
   RenderWidgetHostLatencyTracker();
   ~RenderWidgetHostLatencyTracker();
 
@@ -68,7 +81,49 @@ class CONTENT_EXPORT RenderWidgetHostLatencyTracker {
   // subsystem.
   int64_t latency_component_id() const { return latency_component_id_; }
 
+  const ScrollLatencySummary& scroll_latency_summary() const {
+    return scroll_latency_summary_;
+  }
+  void ResetScrollLatencySummary();
+
+  // Sets the frame rate the renderer targets, or 0 for the display rate. The
+  // smoothness of each scroll gesture is reported against the lowest target
+  // it ran at.
+  void SetTargetFrameRate(int fps);
+
  private:
+  // Frames presented with scroll updates of the current scroll gesture.
+  struct GestureSmoothness {
+    GestureSmoothness();
+
+    base::TimeTicks first_frame_time;
+    base::TimeTicks last_frame_time;
+    int frame_count;
+    // Of the intervals between presented frames, in milliseconds.
+    double interval_sum_ms;
+    double interval_square_sum_ms;
+    base::TimeDelta max_interval;
+    int min_target_frame_rate;
+    // Of the input to swap latency of the gesture's scroll updates.
+    int latency_count;
+    base::TimeDelta latency_sum;
+    base::TimeDelta max_latency;
+  };
+
+  void AddPresentedScrollFrame(base::TimeTicks frame_time);
+  // Records the smoothness UMA and trace of the gesture that just ended.
+  void ReportGestureSmoothness();
+
+  void AddScrollLatencySample(
+      const ui::LatencyInfo& latency,
+      const ui::LatencyInfo::LatencyComponent& gpu_swap_begin_component);
+
+  // Records the stages of a presented input-driven frame in FrameLatencyLog.
+  void AddFrameLatencyLogEntry(
+      const ui::LatencyInfo& latency,
+      const ui::LatencyInfo::LatencyComponent& gpu_swap_begin_component,
+      const ui::LatencyInfo::LatencyComponent& gpu_swap_end_component);
+
   int64_t last_event_id_;
   int64_t latency_component_id_;
   float device_scale_factor_;
@@ -79,6 +134,13 @@ class CONTENT_EXPORT RenderWidgetHostLatencyTracker {
   // Whether the touch start for the current stream of touch events had its
   // default action prevented. Only valid for single finger gestures.
   bool touch_start_default_prevented_;
+  ScrollLatencySummary scroll_latency_summary_;
+
+  int target_frame_rate_;
+  bool in_scroll_gesture_;
+  GestureSmoothness gesture_smoothness_;
+  // Input to swap latency of scroll updates, for its percentiles.
+  ui::GestureLatencyHistograms gesture_latency_histograms_;
 
   DISALLOW_COPY_AND_ASSIGN(RenderWidgetHostLatencyTracker);
 };
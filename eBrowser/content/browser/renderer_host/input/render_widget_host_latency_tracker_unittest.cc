@@ -37,6 +37,29 @@ void AddFakeComponentsWithTimeStamp(
       time_stamp, 1);
 }
 
+// A scroll update's latency as received with the frame that presented it.
+ui::LatencyInfo CreateScrollUpdateSwapLatency(
+    const RenderWidgetHostLatencyTracker& tracker,
+    bool first_scroll_update,
+    base::TimeTicks original_time,
+    base::TimeTicks swap_time) {
+  ui::LatencyInfo latency(ui::SourceEventType::TOUCH);
+  latency.AddLatencyNumberWithTimestamp(
+      ui::INPUT_EVENT_LATENCY_BEGIN_RWH_COMPONENT,
+      tracker.latency_component_id(), 0, original_time, 1);
+  latency.AddLatencyNumberWithTimestamp(
+      first_scroll_update
+          ? ui::INPUT_EVENT_LATENCY_FIRST_SCROLL_UPDATE_ORIGINAL_COMPONENT
+          : ui::INPUT_EVENT_LATENCY_SCROLL_UPDATE_ORIGINAL_COMPONENT,
+      tracker.latency_component_id(), 0, original_time, 1);
+  latency.AddLatencyNumberWithTimestamp(
+      ui::INPUT_EVENT_GPU_SWAP_BUFFER_COMPONENT, 0, 0, swap_time, 1);
+  latency.AddLatencyNumberWithTimestamp(
+      ui::INPUT_EVENT_LATENCY_TERMINATED_FRAME_SWAP_COMPONENT, 0, 0, swap_time,
+      1);
+  return latency;
+}
+
 void AddFakeComponents(const RenderWidgetHostLatencyTracker& tracker,
                        ui::LatencyInfo* latency) {
   AddFakeComponentsWithTimeStamp(tracker, latency, base::TimeTicks::Now());
@@ -459,6 +482,77 @@ TEST_F(RenderWidgetHostLatencyTrackerTest, ScrollLatency) {
   EXPECT_EQ(3U, scroll_latency.latency_components().size());
 }
 
+TEST_F(RenderWidgetHostLatencyTrackerTest, ScrollLatencySummary) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  tracker()->OnFrameSwapped(
+      CreateScrollUpdateSwapLatency(*tracker(), true, now,
+                                    now + base::TimeDelta::FromMilliseconds(10)),
+      false);
+  tracker()->OnFrameSwapped(
+      CreateScrollUpdateSwapLatency(*tracker(), false, now,
+                                    now + base::TimeDelta::FromMilliseconds(20)),
+      false);
+
+  const RenderWidgetHostLatencyTracker::ScrollLatencySummary& summary =
+      tracker()->scroll_latency_summary();
+  EXPECT_EQ(2, summary.count);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(30), summary.total);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(20), summary.max);
+
+  tracker()->ResetScrollLatencySummary();
+  EXPECT_EQ(0, tracker()->scroll_latency_summary().count);
+  EXPECT_EQ(base::TimeDelta(), tracker()->scroll_latency_summary().max);
+}
+
+TEST_F(RenderWidgetHostLatencyTrackerTest, ScrollSmoothness) {
+  auto scroll_begin = SyntheticWebGestureEventBuilder::BuildScrollBegin(
+      5, -5, blink::WebGestureDeviceTouchscreen);
+  ui::LatencyInfo begin_latency;
+  tracker()->OnInputEvent(scroll_begin, &begin_latency);
+  tracker()->SetTargetFrameRate(30);
+
+  // Two events presented in the third frame, then a skipped frame.
+  base::TimeTicks now = base::TimeTicks::Now();
+  const int kSwapTimesMs[] = {0, 33, 66, 66, 133};
+  for (size_t i = 0; i < arraysize(kSwapTimesMs); ++i) {
+    base::TimeTicks swap_time =
+        now + base::TimeDelta::FromMilliseconds(kSwapTimesMs[i]);
+    tracker()->OnFrameSwapped(
+        CreateScrollUpdateSwapLatency(*tracker(), i == 0, swap_time, swap_time),
+        false);
+  }
+
+  // Nothing is reported before the gesture ends.
+  EXPECT_TRUE(HistogramSizeEq(
+      "Event.Smoothness.ScrollUpdate.PresentedFps.Target30", 0));
+
+  tracker()->SetTargetFrameRate(0);
+  auto scroll_end = SyntheticWebGestureEventBuilder::Build(
+      WebInputEvent::GestureScrollEnd, blink::WebGestureDeviceTouchscreen);
+  ui::LatencyInfo end_latency;
+  tracker()->OnInputEvent(scroll_end, &end_latency);
+
+  // Intervals of 33, 33 and 67ms.
+  EXPECT_THAT(histogram_tester().GetAllSamples(
+                  "Event.Smoothness.ScrollUpdate.PresentedFps.Target30"),
+              ElementsAre(Bucket(23, 1)));
+  EXPECT_TRUE(HistogramSizeEq(
+      "Event.Smoothness.ScrollUpdate.FrameIntervalVariance.Target30", 1));
+  EXPECT_TRUE(HistogramSizeEq(
+      "Event.Smoothness.ScrollUpdate.MaxFrameGap.Target30", 1));
+  EXPECT_TRUE(HistogramSizeEq(
+      "Event.Smoothness.ScrollUpdate.PresentedFps.Target60", 0));
+
+  // Frames after the end are not counted, nor reported again.
+  tracker()->OnFrameSwapped(
+      CreateScrollUpdateSwapLatency(*tracker(), false, now,
+                                    now + base::TimeDelta::FromSeconds(1)),
+      false);
+  tracker()->OnInputEvent(scroll_begin, &begin_latency);
+  EXPECT_TRUE(HistogramSizeEq(
+      "Event.Smoothness.ScrollUpdate.PresentedFps.Target30", 1));
+}
+
 TEST_F(RenderWidgetHostLatencyTrackerTest, TouchBlockingAndQueueingTime) {
   // These numbers are sensitive to where the histogram buckets are.
   int touchstart_timestamps_ms[] = {11, 25, 35};
@@ -13,6 +13,7 @@
 #include "base/trace_event/trace_event.h"
 #include "content/browser/renderer_host/input/timeout_monitor.h"
 #include "content/common/input/web_touch_event_traits.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 #include "ui/gfx/geometry/point_f.h"
 
 using blink::WebInputEvent;
@@ -27,6 +28,11 @@ namespace {
 // scrolling is active and possible.
 const double kAsyncTouchMoveIntervalSec = .2;
 
+// A blocking touchmove is held for the next target frame only if it would
+// otherwise be sent at least this much early, so that input jitter does not
+// delay moves that are about due.
+const int kTouchMoveHoldSlackMs = 2;
+
 // A sanity check on touches received to ensure that touch movement outside
 // the platform slop region will cause scrolling.
 const double kMaxConceivablePlatformSlopRegionLengthDipsSquared = 60. * 60.;
@@ -439,7 +445,8 @@ TouchEventQueue::TouchEventQueue(TouchEventQueueClient* client,
       drop_remaining_touches_in_sequence_(false),
       touchmove_slop_suppressor_(new TouchMoveSlopSuppressor),
       send_touch_events_async_(false),
-      last_sent_touch_timestamp_sec_(0) {
+      last_sent_touch_timestamp_sec_(0),
+      touchmove_held_(false) {
   DCHECK(client);
   if (config.touch_ack_timeout_supported) {
     timeout_handler_.reset(
@@ -480,13 +487,19 @@ void TouchEventQueue::QueueEvent(const TouchEventWithLatencyInfo& event) {
 
   // If the last queued touch-event was a touch-move, and the current event is
   // also a touch-move, then the events can be coalesced into a single event.
-  if (touch_queue_.size() > 1) {
+  // A held touchmove has not been sent yet, so it can take more moves.
+  if (touch_queue_.size() > 1 || touchmove_held_) {
     CoalescedWebTouchEvent* last_event = touch_queue_.back().get();
     if (last_event->CoalesceEventIfPossible(event))
       return;
   }
   touch_queue_.push_back(
       base::MakeUnique<CoalescedWebTouchEvent>(event, false));
+  // Another kind of event, such as a touchend, should not wait behind a
+  // touchmove held for the next frame. If this runs within an ack dispatch,
+  // the timer releases it instead.
+  if (!dispatching_touch_ack_)
+    SendHeldTouchMove();
 }
 
 void TouchEventQueue::PrependTouchScrollNotification() {
@@ -548,7 +561,8 @@ void TouchEventQueue::ProcessTouchAck(InputEventAckState ack_result,
 
   touchmove_slop_suppressor_->ConfirmTouchEvent(ack_result);
 
-  if (touch_queue_.empty())
+  // A held touchmove has not been sent, so it cannot be acked yet.
+  if (touch_queue_.empty() || touchmove_held_)
     return;
 
   // We don't care about the ordering of the acks vs the ordering of the
@@ -627,6 +641,29 @@ void TouchEventQueue::ForwardNextEventToRenderer() {
     }
   }
 
+  // While the renderer draws at a reduced rate, a blocking touchmove sent
+  // less than a target frame after the previous one is held, and the moves
+  // that follow are coalesced into it, so that touch handlers run about once
+  // per frame drawn.
+  if (touch.event.type == WebInputEvent::TouchMove &&
+      !send_touch_events_async_ && size() == 1) {
+    base::TimeTicks now = base::TimeTicks::Now();
+    base::TimeDelta wait = last_touchmove_time_ + touchmove_interval_ - now;
+    if (!last_touchmove_time_.is_null() &&
+        wait > base::TimeDelta::FromMilliseconds(kTouchMoveHoldSlackMs)) {
+      TRACE_EVENT_INSTANT0("input", "TouchEventQueue::HoldTouchMove",
+                           TRACE_EVENT_SCOPE_THREAD);
+      touchmove_held_ = true;
+      touchmove_timer_.Start(FROM_HERE, wait, this,
+                             &TouchEventQueue::SendHeldTouchMove);
+      return;
+    }
+  }
+  if (touch.event.type == WebInputEvent::TouchMove)
+    last_touchmove_time_ = base::TimeTicks::Now();
+  else if (touch.event.type == WebInputEvent::TouchStart)
+    last_touchmove_time_ = base::TimeTicks();
+
   last_sent_touch_timestamp_sec_ = touch.event.timeStampSeconds;
 
   // Flush any pending async touch move. If it can be combined with the current
@@ -665,6 +702,17 @@ void TouchEventQueue::FlushPendingAsyncTouchmove() {
   SendTouchEventImmediately(touch.get());
 }
 
+void TouchEventQueue::SendHeldTouchMove() {
+  if (!touchmove_held_)
+    return;
+  touchmove_held_ = false;
+  touchmove_timer_.Stop();
+  DCHECK(!touch_queue_.empty());
+  // The hold was for the front event, so with more events queued, or once
+  // the frame has passed, it is not held again.
+  ForwardNextEventToRenderer();
+}
+
 void TouchEventQueue::OnGestureScrollEvent(
     const GestureEventWithLatencyInfo& gesture_event) {
   if (gesture_event.event.type == blink::WebInputEvent::GestureScrollBegin) {
@@ -727,6 +775,16 @@ void TouchEventQueue::SetIsMobileOptimizedSite(bool mobile_optimized_site) {
     timeout_handler_->SetUseMobileTimeout(mobile_optimized_site);
 }
 
+void TouchEventQueue::SetTargetFrameRate(int fps) {
+  if (fps > 0 && fps < ui::ScrollUpdatePacer::kMaxFrameRate) {
+    touchmove_interval_ = base::TimeDelta::FromMicroseconds(
+        base::Time::kMicrosecondsPerSecond / fps);
+    return;
+  }
+  touchmove_interval_ = base::TimeDelta();
+  SendHeldTouchMove();
+}
+
 bool TouchEventQueue::IsAckTimeoutEnabled() const {
   return timeout_handler_ && timeout_handler_->IsEnabled();
 }
@@ -748,6 +806,8 @@ void TouchEventQueue::FlushQueue() {
   DCHECK(!dispatching_touch_ack_);
   DCHECK(!dispatching_touch_);
   pending_async_touchmove_.reset();
+  touchmove_held_ = false;
+  touchmove_timer_.Stop();
   drop_remaining_touches_in_sequence_ = true;
   while (!touch_queue_.empty())
     PopTouchEventToClient(INPUT_EVENT_ACK_STATE_NO_CONSUMER_EXISTS);
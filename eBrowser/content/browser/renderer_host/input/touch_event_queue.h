@@ -14,6 +14,7 @@
 
 #include "base/macros.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/browser/renderer_host/event_with_latency_info.h"
 #include "content/common/content_export.h"
 #include "content/common/input/input_event_ack_state.h"
@@ -114,6 +115,11 @@ class CONTENT_EXPORT TouchEventQueue {
   // Whether ack timeout behavior is supported and enabled for the current site.
   bool IsAckTimeoutEnabled() const;
 
+  // Sets the frame rate the renderer currently targets. Below the display
+  // rate, blocking touchmoves are batched to one per target frame; 0 or the
+  // display rate sends them as they come, releasing any held touchmove.
+  void SetTargetFrameRate(int fps);
+
   bool empty() const WARN_UNUSED_RESULT {
     return touch_queue_.empty();
   }
@@ -180,6 +186,8 @@ class CONTENT_EXPORT TouchEventQueue {
   void UpdateTouchConsumerStates(const blink::WebTouchEvent& event,
                                  InputEventAckState ack_result);
   void FlushPendingAsyncTouchmove();
+  // Forwards the touchmove held at the front of the queue, if any.
+  void SendHeldTouchMove();
 
   // Handles touch event forwarding and ack'ed event dispatch.
   TouchEventQueueClient* client_;
@@ -239,6 +247,22 @@ class CONTENT_EXPORT TouchEventQueue {
 
   double last_sent_touch_timestamp_sec_;
 
+  // Duration of one target frame, or zero when the renderer runs at the
+  // display rate.
+  base::TimeDelta touchmove_interval_;
+
+  // When the last touchmove was sent; null at the start of a sequence, whose
+  // first touchmove is never held.
+  base::TimeTicks last_touchmove_time_;
+
+  // True if the event at the front of the queue is a blocking touchmove that
+  // has not been sent yet, waiting for the next target frame. Later
+  // touchmoves are coalesced into it, and all their ids are acked with it.
+  bool touchmove_held_;
+
+  // Timer to release a held touchmove.
+  base::OneShotTimer touchmove_timer_;
+
   // Event is saved to compare pointer positions for new touchmove events.
   std::unique_ptr<blink::WebTouchEvent> last_sent_touchevent_;
 
@@ -271,6 +271,8 @@ class TouchEventQueueTest : public testing::Test,
 
   void SetAckTimeoutDisabled() { queue_->SetAckTimeoutEnabled(false); }
 
+  void SetTargetFrameRate(int fps) { queue_->SetTargetFrameRate(fps); }
+
   void SetIsMobileOptimizedSite(bool is_mobile_optimized) {
     queue_->SetIsMobileOptimizedSite(is_mobile_optimized);
   }
@@ -657,6 +659,80 @@ TEST_F(TouchEventQueueTest, SentTouchEventDoesNotCoalesce) {
   EXPECT_EQ(2U, queued_event_count());
 }
 
+// Tests that below the display rate, a touchmove that follows the previous
+// one within a target frame is held, coalesced with the moves after it, and
+// sent once the frame has passed.
+TEST_F(TouchEventQueueTest, TouchMovesBatchedToTargetFrameRate) {
+  SetTargetFrameRate(20);
+  PressTouchPoint(1, 1);
+  EXPECT_EQ(1U, GetAndResetSentEventCount());
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  EXPECT_EQ(1U, GetAndResetAckedEventCount());
+
+  // The first touchmove of a sequence is never held.
+  MoveTouchPoint(0, 5, 5);
+  EXPECT_EQ(1U, GetAndResetSentEventCount());
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  EXPECT_EQ(1U, GetAndResetAckedEventCount());
+
+  MoveTouchPoint(0, 10, 10);
+  MoveTouchPoint(0, 15, 15);
+  EXPECT_EQ(0U, GetAndResetSentEventCount());
+  EXPECT_EQ(1U, queued_event_count());
+
+  RunTasksAndWait(base::TimeDelta::FromMilliseconds(60));
+  EXPECT_EQ(1U, GetAndResetSentEventCount());
+  EXPECT_EQ(WebInputEvent::TouchMove, sent_event().type);
+  EXPECT_EQ(15, sent_event().touches[0].position.x);
+
+  // Acking the batch acks every touchmove coalesced into it.
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  EXPECT_EQ(2U, GetAndResetAckedEventCount());
+  EXPECT_EQ(0U, queued_event_count());
+}
+
+// Tests that a held touchmove is sent as soon as another kind of event is
+// queued behind it.
+TEST_F(TouchEventQueueTest, HeldTouchMoveSentBeforeTouchEnd) {
+  SetTargetFrameRate(20);
+  PressTouchPoint(1, 1);
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  MoveTouchPoint(0, 5, 5);
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  GetAndResetSentEventCount();
+
+  MoveTouchPoint(0, 10, 10);
+  EXPECT_EQ(0U, GetAndResetSentEventCount());
+  ReleaseTouchPoint(0);
+  EXPECT_EQ(1U, GetAndResetSentEventCount());
+  EXPECT_EQ(WebInputEvent::TouchMove, sent_event().type);
+  EXPECT_EQ(2U, queued_event_count());
+
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  EXPECT_EQ(1U, GetAndResetSentEventCount());
+  EXPECT_EQ(WebInputEvent::TouchEnd, sent_event().type);
+}
+
+// Tests that returning to the display rate releases a held touchmove and
+// stops batching.
+TEST_F(TouchEventQueueTest, HeldTouchMoveSentWhenBatchingStops) {
+  SetTargetFrameRate(20);
+  PressTouchPoint(1, 1);
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  MoveTouchPoint(0, 5, 5);
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+  GetAndResetSentEventCount();
+
+  MoveTouchPoint(0, 10, 10);
+  EXPECT_EQ(0U, GetAndResetSentEventCount());
+  SetTargetFrameRate(0);
+  EXPECT_EQ(1U, GetAndResetSentEventCount());
+  SendTouchEventAck(INPUT_EVENT_ACK_STATE_CONSUMED);
+
+  MoveTouchPoint(0, 15, 15);
+  EXPECT_EQ(1U, GetAndResetSentEventCount());
+}
+
 // Tests that coalescing works correctly for multi-touch events.
 TEST_F(TouchEventQueueTest, MultiTouch) {
   // Press the first finger.
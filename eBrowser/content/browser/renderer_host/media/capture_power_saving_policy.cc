@@ -0,0 +1,67 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/media/capture_power_saving_policy.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "media/base/limits.h"
+#include "media/base/video_capture_types.h"
+
+namespace content {
+
+CapturePowerSavingPolicy::Limits::Limits()
+    : frame_rate(media::limits::kMaxFramesPerSecond),
+      height(media::limits::kMaxDimension) {}
+
+// static
+bool CapturePowerSavingPolicy::ParseLimits(const std::string& value,
+                                           Limits* limits) {
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      value, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+  if (fields.size() != 2)
+    return false;
+  Limits parsed;
+  if (!base::StringToInt(fields[0], &parsed.frame_rate) ||
+      !base::StringToInt(fields[1], &parsed.height)) {
+    return false;
+  }
+  if (parsed.frame_rate < 1 ||
+      parsed.frame_rate > media::limits::kMaxFramesPerSecond ||
+      parsed.height < 2 || parsed.height > media::limits::kMaxDimension) {
+    return false;
+  }
+  *limits = parsed;
+  return true;
+}
+
+CapturePowerSavingPolicy::CapturePowerSavingPolicy(const Limits& limits)
+    : limits_(limits) {}
+
+CapturePowerSavingPolicy::~CapturePowerSavingPolicy() {}
+
+bool CapturePowerSavingPolicy::Apply(media::VideoCaptureParams* params) const {
+  media::VideoCaptureFormat* format = &params->requested_format;
+  bool lowered = false;
+  if (format->frame_rate > limits_.frame_rate) {
+    format->frame_rate = limits_.frame_rate;
+    lowered = true;
+  }
+  const gfx::Size& size = format->frame_size;
+  if (size.height() > limits_.height) {
+    // Capture formats are 4:2:0, so the width stays even.
+    int width = static_cast<int>(static_cast<int64_t>(size.width()) *
+                                 limits_.height / size.height());
+    format->frame_size.SetSize(std::max(2, width & ~1), limits_.height);
+    lowered = true;
+  }
+  return lowered;
+}
+
+}  // namespace content
@@ -0,0 +1,55 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_MEDIA_CAPTURE_POWER_SAVING_POLICY_H_
+#define CONTENT_BROWSER_RENDERER_HOST_MEDIA_CAPTURE_POWER_SAVING_POLICY_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "content/common/content_export.h"
+
+namespace media {
+struct VideoCaptureParams;
+}
+
+namespace content {
+
+// The most a camera may capture while on battery power, from
+// --ebrowser-power-saving-capture. Video calls are long sessions in which
+// the camera, its ISP and the encoder all run at the capture rate, so
+// starting the device at a lower rate and size saves power all the way down
+// the pipeline. The requested format only steers the native format the
+// device picks; the renderer's VideoTrackAdapter then fits each track's
+// constraints within what is captured, as it does for any device that
+// cannot meet them.
+class CONTENT_EXPORT CapturePowerSavingPolicy {
+ public:
+  struct Limits {
+    Limits();
+
+    int frame_rate;
+    int height;
+  };
+
+  // Parses "<fps>,<height>" such as "15,480". Both must be positive.
+  static bool ParseLimits(const std::string& value, Limits* limits);
+
+  explicit CapturePowerSavingPolicy(const Limits& limits);
+  ~CapturePowerSavingPolicy();
+
+  // Lowers the requested frame rate and height of |params| to the limits,
+  // keeping the aspect ratio. Returns false if they were already within
+  // them.
+  bool Apply(media::VideoCaptureParams* params) const;
+
+ private:
+  const Limits limits_;
+
+  DISALLOW_COPY_AND_ASSIGN(CapturePowerSavingPolicy);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_MEDIA_CAPTURE_POWER_SAVING_POLICY_H_
@@ -0,0 +1,58 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/media/capture_power_saving_policy.h"
+
+#include "media/base/video_capture_types.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+TEST(CapturePowerSavingPolicyTest, ParseLimits) {
+  CapturePowerSavingPolicy::Limits limits;
+  EXPECT_TRUE(CapturePowerSavingPolicy::ParseLimits("15,480", &limits));
+  EXPECT_EQ(15, limits.frame_rate);
+  EXPECT_EQ(480, limits.height);
+  EXPECT_TRUE(CapturePowerSavingPolicy::ParseLimits(" 30 , 720 ", &limits));
+  EXPECT_EQ(30, limits.frame_rate);
+
+  EXPECT_FALSE(CapturePowerSavingPolicy::ParseLimits("", &limits));
+  EXPECT_FALSE(CapturePowerSavingPolicy::ParseLimits("15", &limits));
+  EXPECT_FALSE(CapturePowerSavingPolicy::ParseLimits("15,480,1", &limits));
+  EXPECT_FALSE(CapturePowerSavingPolicy::ParseLimits("fifteen,480", &limits));
+  EXPECT_FALSE(CapturePowerSavingPolicy::ParseLimits("0,480", &limits));
+  EXPECT_FALSE(CapturePowerSavingPolicy::ParseLimits("15,0", &limits));
+  EXPECT_EQ(30, limits.frame_rate);
+  EXPECT_EQ(720, limits.height);
+}
+
+TEST(CapturePowerSavingPolicyTest, Apply) {
+  CapturePowerSavingPolicy::Limits limits;
+  limits.frame_rate = 15;
+  limits.height = 480;
+  CapturePowerSavingPolicy policy(limits);
+
+  media::VideoCaptureParams params;
+  params.requested_format = media::VideoCaptureFormat(
+      gfx::Size(1280, 720), 30.0f, media::PIXEL_FORMAT_I420);
+  EXPECT_TRUE(policy.Apply(&params));
+  EXPECT_EQ(gfx::Size(852, 480), params.requested_format.frame_size);
+  EXPECT_EQ(15.0f, params.requested_format.frame_rate);
+
+  // Formats within the limits are left alone.
+  EXPECT_FALSE(policy.Apply(&params));
+  params.requested_format = media::VideoCaptureFormat(
+      gfx::Size(320, 240), 10.0f, media::PIXEL_FORMAT_I420);
+  EXPECT_FALSE(policy.Apply(&params));
+  EXPECT_EQ(gfx::Size(320, 240), params.requested_format.frame_size);
+  EXPECT_EQ(10.0f, params.requested_format.frame_rate);
+
+  // Only the rate is over.
+  params.requested_format.frame_rate = 60.0f;
+  EXPECT_TRUE(policy.Apply(&params));
+  EXPECT_EQ(gfx::Size(320, 240), params.requested_format.frame_size);
+  EXPECT_EQ(15.0f, params.requested_format.frame_rate);
+}
+
+}  // namespace content
@@ -14,6 +14,7 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/power_monitor/power_monitor.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
@@ -24,10 +25,12 @@
 #include "content/browser/media/capture/desktop_capture_device_uma_types.h"
 #include "content/browser/media/capture/web_contents_video_capture_device.h"
 #include "content/browser/media/media_internals.h"
+#include "content/browser/renderer_host/media/capture_power_saving_policy.h"
 #include "content/browser/renderer_host/media/video_capture_controller.h"
 #include "content/browser/renderer_host/media/video_capture_controller_event_handler.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/desktop_media_id.h"
+#include "content/public/common/content_switches.h"
 #include "content/public/common/media_stream_request.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/media_switches.h"
@@ -144,6 +147,9 @@ class VideoCaptureManager::DeviceEntry {
   const MediaStreamType stream_type;
   const std::string id;
   const media::VideoCaptureParams parameters;
+  // Whether the device was last started with |parameters| lowered for power
+  // saving.
+  bool power_saving;
 
   VideoCaptureController* video_capture_controller() const;
   media::VideoCaptureDevice* video_capture_device() const;
@@ -205,6 +211,7 @@ VideoCaptureManager::DeviceEntry::DeviceEntry(
       stream_type(stream_type),
       id(id),
       parameters(params),
+      power_saving(false),
       video_capture_controller_(std::move(controller)) {}
 
 VideoCaptureManager::DeviceEntry::~DeviceEntry() {
@@ -267,6 +274,7 @@ VideoCaptureManager::VideoCaptureManager(
     std::unique_ptr<media::VideoCaptureDeviceFactory> factory)
     : listener_(nullptr),
       new_capture_session_id_(1),
+      on_battery_power_(false),
       video_capture_device_factory_(std::move(factory)) {}
 
 VideoCaptureManager::~VideoCaptureManager() {
@@ -288,11 +296,34 @@ void VideoCaptureManager::Register(
       base::Bind(&VideoCaptureManager::OnApplicationStateChange,
                  base::Unretained(this))));
 #endif
+
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  if (command_line.HasSwitch(switches::kEBrowserPowerSavingCapture) &&
+      power_monitor) {
+    CapturePowerSavingPolicy::Limits limits;
+    if (CapturePowerSavingPolicy::ParseLimits(
+            command_line.GetSwitchValueASCII(
+                switches::kEBrowserPowerSavingCapture),
+            &limits)) {
+      power_saving_policy_.reset(new CapturePowerSavingPolicy(limits));
+      power_monitor->AddObserver(this);
+      on_battery_power_ = power_monitor->IsOnBatteryPower();
+    } else {
+      LOG(ERROR) << "Invalid value for --"
+                 << switches::kEBrowserPowerSavingCapture;
+    }
+  }
 }
 
 void VideoCaptureManager::Unregister() {
   DCHECK(listener_);
   listener_ = nullptr;
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  if (power_saving_policy_ && power_monitor)
+    power_monitor->RemoveObserver(this);
+  power_saving_policy_.reset();
 }
 
 void VideoCaptureManager::EnumerateDevices(
@@ -469,9 +500,25 @@ void VideoCaptureManager::HandleQueuedStartRequest() {
                                found->descriptor.GetNameAndModel().c_str(),
                                found->descriptor.GetCaptureApiTypeString()));
 
+        media::VideoCaptureParams params = request->params();
+        entry->power_saving = ApplyPowerSaving(entry->stream_type, &params);
+        if (power_saving_policy_) {
+          std::string power_saving =
+              entry->power_saving
+                  ? base::StringPrintf(
+                        "%s@%.0ffps",
+                        params.requested_format.frame_size.ToString().c_str(),
+                        params.requested_format.frame_rate)
+                  : "off";
+          entry->video_capture_controller()->OnLog(
+              "Power saving capture: " + power_saving);
+          MediaInternals::GetInstance()->UpdateVideoCapturePowerSaving(
+              found->descriptor.device_id, power_saving);
+        }
+
         start_capture_function = base::Bind(
             &VideoCaptureManager::DoStartDeviceCaptureOnDeviceThread, this,
-            found->descriptor, request->params(),
+            found->descriptor, params,
             base::Passed(entry->video_capture_controller()->NewDeviceClient()));
       } else {
         // Errors from DoStartDeviceCaptureOnDeviceThread go via
@@ -856,6 +903,38 @@ void VideoCaptureManager::SetDesktopCaptureWindowId(
   MaybePostDesktopCaptureWindowId(session_id);
 }
 
+void VideoCaptureManager::OnPowerStateChange(bool on_battery_power) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  on_battery_power_ = on_battery_power;
+
+  for (auto& entry : devices_) {
+    // Devices that are still starting pick up the new state when their start
+    // request is handled.
+    if (!entry->video_capture_device())
+      continue;
+    media::VideoCaptureParams params = entry->parameters;
+    if (ApplyPowerSaving(entry->stream_type, &params) == entry->power_saving)
+      continue;
+
+    // Restarting drops a few frames, but unplugging is rare next to the
+    // length of a call. As in ResumeDevices(), the session ID is only used by
+    // screen capture.
+    DoStopDevice(entry.get());
+    QueueStartDevice(kFakeSessionId, entry.get(), entry->parameters);
+  }
+}
+
+bool VideoCaptureManager::ApplyPowerSaving(
+    MediaStreamType stream_type,
+    media::VideoCaptureParams* params) const {
+  // Tab and desktop capture are driven by what is on screen, not a sensor.
+  if (!power_saving_policy_ || !on_battery_power_ ||
+      stream_type != MEDIA_DEVICE_VIDEO_CAPTURE) {
+    return false;
+  }
+  return power_saving_policy_->Apply(params);
+}
+
 void VideoCaptureManager::MaybePostDesktopCaptureWindowId(
     media::VideoCaptureSessionId session_id) {
   SessionMap::iterator session_it = sessions_.find(session_id);
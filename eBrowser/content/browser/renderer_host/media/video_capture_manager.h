@@ -21,6 +21,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/message_loop/message_loop.h"
+#include "base/power_monitor/power_observer.h"
 #include "base/process/process_handle.h"
 #include "base/threading/thread_checker.h"
 #include "base/timer/elapsed_timer.h"
@@ -38,11 +39,13 @@
 #endif
 
 namespace content {
+class CapturePowerSavingPolicy;
 class VideoCaptureController;
 class VideoCaptureControllerEventHandler;
 
 // VideoCaptureManager opens/closes and start/stops video capture devices.
-class CONTENT_EXPORT VideoCaptureManager : public MediaStreamProvider {
+class CONTENT_EXPORT VideoCaptureManager : public MediaStreamProvider,
+                                           public base::PowerObserver {
  public:
   using VideoCaptureDevice = media::VideoCaptureDevice;
 
@@ -134,6 +137,10 @@ class CONTENT_EXPORT VideoCaptureManager : public MediaStreamProvider {
   void SetDesktopCaptureWindowId(media::VideoCaptureSessionId session_id,
                                  gfx::NativeViewId window_id);
 
+  // base::PowerObserver implementation. Restarts the cameras whose capture
+  // format --ebrowser-power-saving-capture lowers or lifts.
+  void OnPowerStateChange(bool on_battery_power) override;
+
   // Gets a weak reference to the device factory, used for tests.
   media::VideoCaptureDeviceFactory* video_capture_device_factory() const {
     return video_capture_device_factory_.get();
@@ -205,6 +212,12 @@ class CONTENT_EXPORT VideoCaptureManager : public MediaStreamProvider {
       const DeviceInfos& old_device_info_cache,
       std::unique_ptr<VideoCaptureDeviceDescriptors> descriptors_snapshot);
 
+  // Lowers |params| for starting a device of |stream_type| if power saving
+  // applies to it. Returns false if it does not, or if they are already low
+  // enough.
+  bool ApplyPowerSaving(MediaStreamType stream_type,
+                        media::VideoCaptureParams* params) const;
+
   // Checks to see if |entry| has no clients left on its controller. If so,
   // remove it from the list of devices, and delete it asynchronously. |entry|
   // may be freed by this function.
@@ -331,6 +344,11 @@ class CONTENT_EXPORT VideoCaptureManager : public MediaStreamProvider {
 
   DeviceStartQueue device_start_queue_;
 
+  // Null unless --ebrowser-power-saving-capture is given. Only accessed on the
+  // IO thread, as is |on_battery_power_|.
+  std::unique_ptr<CapturePowerSavingPolicy> power_saving_policy_;
+  bool on_battery_power_;
+
   // Queue to keep photo-associated requests waiting for a device to initialize,
   // bundles a session id integer and an associated photo-related request.
   std::list<std::pair<int, base::Callback<void(media::VideoCaptureDevice*)>>>
@@ -24,9 +24,11 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/shared_memory.h"
 #include "base/memory/shared_memory_handle.h"
+#include "base/memory/weak_ptr.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/persistent_histogram_allocator.h"
 #include "base/metrics/persistent_memory_allocator.h"
@@ -97,6 +99,7 @@
 #include "content/browser/renderer_host/database_message_filter.h"
 #include "content/browser/renderer_host/file_utilities_message_filter.h"
 #include "content/browser/renderer_host/gamepad_browser_message_filter.h"
+#include "content/browser/renderer_host/input/input_model_registry.h"
 #include "content/browser/renderer_host/media/audio_input_renderer_host.h"
 #include "content/browser/renderer_host/media/audio_renderer_host.h"
 #include "content/browser/renderer_host/media/media_stream_dispatcher_host.h"
@@ -458,6 +461,119 @@ void CreateMemoryCoordinatorHandle(
                                                  std::move(request));
 }
 
+// How long to wait after the spare renderer is handed out before launching its
+// replacement, so that the launch does not compete with the navigation that
+// took the spare.
+const int kSpareRenderProcessHostRewarmDelaySeconds = 2;
+
+// Keeps at most one launched renderer without any views, so that a navigation
+// to a new site can skip process launch and renderer initialization.
+class SpareRenderProcessHostManager : public RenderProcessHostObserver {
+ public:
+  SpareRenderProcessHostManager()
+      : spare_(nullptr),
+        browser_context_(nullptr),
+        memory_pressure_listener_(
+            base::Bind(&SpareRenderProcessHostManager::OnMemoryPressure,
+                       base::Unretained(this))),
+        weak_ptr_factory_(this) {}
+
+  void Warmup(BrowserContext* browser_context) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    if (RenderProcessHost::run_renderer_in_process())
+      return;
+    if (spare_ && spare_->GetBrowserContext() == browser_context)
+      return;
+    Discard();
+
+    // The spare is an extra renderer, so never launch it past the limit.
+    if (g_all_hosts.Get().size() >=
+        RenderProcessHost::GetMaxRendererProcessCount()) {
+      return;
+    }
+
+    browser_context_ = browser_context;
+    StoragePartitionImpl* partition = static_cast<StoragePartitionImpl*>(
+        BrowserContext::GetDefaultStoragePartition(browser_context));
+    spare_ = new RenderProcessHostImpl(browser_context, partition, false);
+    spare_->AddObserver(this);
+    if (!spare_->Init())
+      Discard();
+  }
+
+  RenderProcessHost* Take(BrowserContext* browser_context,
+                          const GURL& site_url) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    if (!spare_ || site_url.SchemeIs(kGuestScheme) ||
+        !RenderProcessHostImpl::IsSuitableHost(spare_, browser_context,
+                                               site_url)) {
+      return nullptr;
+    }
+
+    RenderProcessHost* host = spare_;
+    spare_->RemoveObserver(this);
+    spare_ = nullptr;
+    BrowserThread::PostDelayedTask(
+        BrowserThread::UI, FROM_HERE,
+        base::Bind(&SpareRenderProcessHostManager::Rewarm,
+                   weak_ptr_factory_.GetWeakPtr()),
+        base::TimeDelta::FromSeconds(
+            kSpareRenderProcessHostRewarmDelaySeconds));
+    return host;
+  }
+
+  void Discard() {
+    weak_ptr_factory_.InvalidateWeakPtrs();
+    browser_context_ = nullptr;
+    if (!spare_)
+      return;
+    RenderProcessHost* host = spare_;
+    host->RemoveObserver(this);
+    spare_ = nullptr;
+    host->Cleanup();
+  }
+
+  bool IsSpare(RenderProcessHost* host) const { return host == spare_; }
+
+  // RenderProcessHostObserver:
+  void RenderProcessExited(RenderProcessHost* host,
+                           base::TerminationStatus status,
+                           int exit_code) override {
+    // Do not relaunch a renderer that has just died; wait for the next
+    // Warmup().
+    Discard();
+  }
+
+  void RenderProcessHostDestroyed(RenderProcessHost* host) override {
+    DCHECK_EQ(spare_, host);
+    host->RemoveObserver(this);
+    spare_ = nullptr;
+  }
+
+ private:
+  void Rewarm() {
+    if (browser_context_)
+      Warmup(browser_context_);
+  }
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+    // An idle renderer is the cheapest memory to give back.
+    Discard();
+  }
+
+  RenderProcessHost* spare_;
+  // The context the spare is replaced for after it is handed out.
+  BrowserContext* browser_context_;
+  base::MemoryPressureListener memory_pressure_listener_;
+  base::WeakPtrFactory<SpareRenderProcessHostManager> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRenderProcessHostManager);
+};
+
+base::LazyInstance<SpareRenderProcessHostManager>::Leaky
+    g_spare_render_process_host_manager = LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 RendererMainThreadFactoryFunction g_renderer_main_thread_factory = NULL;
@@ -1257,6 +1373,8 @@ void RenderProcessHostImpl::RegisterMojoInterfaces() {
     AddUIThreadInterface(
         registry.get(), base::Bind(&CreateMemoryCoordinatorHandle, GetID()));
   }
+  AddUIThreadInterface(
+      registry.get(), base::Bind(&InputModelRegistry::BindProvider, GetID()));
 
   // BrowserMainLoop, which owns TimeZoneMonitor, is alive for the lifetime of
   // Mojo communication (see BrowserMainLoop::ShutdownThreadsAndCleanUp(),
@@ -1665,6 +1783,19 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     switches::kDisableV8IdleTasks,
     switches::kDisableWebGLImageChromium,
     switches::kDomAutomationController,
+    switches::kEBrowserEnergyBudget,
+    switches::kEBrowserFlingCutoff,
+    switches::kEBrowserFlingRasterScale,
+    switches::kEBrowserGestureRatePolicies,
+    switches::kEBrowserImeTextDeltas,
+    switches::kEBrowserInputRateController,
+    switches::kEBrowserPowerSavingThreadPlacement,
+    switches::kEBrowserPredictorTableStep,
+    switches::kEBrowserPrepaintTime,
+    switches::kEBrowserReadingPrerenderStrip,
+    switches::kEBrowserSharedBitmapPool,
+    switches::kEBrowserThrottleAnimationFrames,
+    switches::kEBrowserTimerFrameAlignment,
     switches::kEnableBlinkFeatures,
     switches::kEnableBrowserSideNavigation,
     switches::kEnableDisplayList2dCanvas,
@@ -2502,7 +2633,10 @@ RenderProcessHost* RenderProcessHost::GetExistingProcessHost(
 
   iterator iter(AllHostsIterator());
   while (!iter.IsAtEnd()) {
-    if (GetContentClient()->browser()->MayReuseHost(iter.GetCurrentValue()) &&
+    // The spare renderer is handed out whole by TakeSpareRenderProcessHost().
+    if (!g_spare_render_process_host_manager.Get().IsSpare(
+            iter.GetCurrentValue()) &&
+        GetContentClient()->browser()->MayReuseHost(iter.GetCurrentValue()) &&
         RenderProcessHostImpl::IsSuitableHost(iter.GetCurrentValue(),
                                               browser_context, site_url)) {
       suitable_renderers.push_back(iter.GetCurrentValue());
@@ -2520,6 +2654,25 @@ RenderProcessHost* RenderProcessHost::GetExistingProcessHost(
   return NULL;
 }
 
+// static
+void RenderProcessHost::WarmupSpareRenderProcessHost(
+    BrowserContext* browser_context) {
+  g_spare_render_process_host_manager.Get().Warmup(browser_context);
+}
+
+// static
+void RenderProcessHost::DiscardSpareRenderProcessHost() {
+  g_spare_render_process_host_manager.Get().Discard();
+}
+
+// static
+RenderProcessHost* RenderProcessHostImpl::TakeSpareRenderProcessHost(
+    BrowserContext* browser_context,
+    const GURL& site_url) {
+  return g_spare_render_process_host_manager.Get().Take(browser_context,
+                                                        site_url);
+}
+
 // static
 bool RenderProcessHost::ShouldUseProcessPerSite(BrowserContext* browser_context,
                                                 const GURL& url) {
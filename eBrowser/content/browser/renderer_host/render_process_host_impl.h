@@ -242,6 +242,13 @@ class CONTENT_EXPORT RenderProcessHostImpl
       RenderProcessHost* process,
       const GURL& url);
 
+  // Returns the spare renderer launched by WarmupSpareRenderProcessHost() if
+  // it can host |site_url| in |browser_context|, otherwise null. The caller
+  // becomes responsible for the returned host just as if it had created it.
+  static RenderProcessHost* TakeSpareRenderProcessHost(
+      BrowserContext* browser_context,
+      const GURL& site_url);
+
   static base::MessageLoop* GetInProcessRendererThreadForTesting();
 
   // This forces a renderer that is running "in process" to shut down.
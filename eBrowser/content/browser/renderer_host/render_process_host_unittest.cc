@@ -33,6 +33,19 @@ TEST_F(RenderProcessHostUnitTest, GuestsAreNotSuitableHosts) {
       RenderProcessHost::GetExistingProcessHost(browser_context(), test_url));
 }
 
+// Tests that there is no spare RenderProcessHost to hand out unless one was
+// warmed up, and that discarding it when there is none is harmless.
+TEST_F(RenderProcessHostUnitTest, NoSpareHostWithoutWarmup) {
+  GURL test_url("http://foo.com");
+
+  RenderProcessHost::DiscardSpareRenderProcessHost();
+  EXPECT_EQ(nullptr, RenderProcessHostImpl::TakeSpareRenderProcessHost(
+                         browser_context(), test_url));
+  EXPECT_EQ(
+      process(),
+      RenderProcessHost::GetExistingProcessHost(browser_context(), test_url));
+}
+
 #if !defined(OS_ANDROID)
 TEST_F(RenderProcessHostUnitTest, RendererProcessLimit) {
   // This test shouldn't run with --site-per-process mode, which prohibits
@@ -34,6 +34,7 @@
 #include "content/browser/bad_message.h"
 #include "content/browser/browser_plugin/browser_plugin_guest.h"
 #include "content/browser/gpu/compositor_util.h"
+#include "content/browser/loader/resource_dispatcher_host_impl.h"
 #include "content/browser/renderer_host/dip_util.h"
 #include "content/browser/renderer_host/frame_metadata_util.h"
 #include "content/browser/renderer_host/input/input_router_config_helper.h"
@@ -211,7 +212,10 @@ RenderWidgetHostImpl::RenderWidgetHostImpl(RenderWidgetHostDelegate* delegate,
       has_touch_handler_(false),
       is_in_touchpad_gesture_scroll_(false),
       is_in_touchscreen_gesture_scroll_(false),
+      hold_loads_while_interacting_(false),
+      is_user_interacting_(false),
       received_paint_after_load_(false),
+      target_frame_rate_(0),
       next_browser_snapshot_id_(1),
       owned_by_render_frame_host_(false),
       is_focused_(false),
@@ -262,6 +266,17 @@ RenderWidgetHostImpl::RenderWidgetHostImpl(RenderWidgetHostDelegate* delegate,
                    weak_factory_.GetWeakPtr())));
   }
 
+  int grace_period_ms = 0;
+  if (base::StringToInt(
+          base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+              switches::kEBrowserInteractionAwareLoading),
+          &grace_period_ms) &&
+      grace_period_ms >= 0) {
+    hold_loads_while_interacting_ = true;
+    user_interaction_grace_period_ =
+        base::TimeDelta::FromMilliseconds(grace_period_ms);
+  }
+
   new_content_rendering_timeout_.reset(new TimeoutMonitor(
       base::Bind(&RenderWidgetHostImpl::ClearDisplayedGraphics,
                  weak_factory_.GetWeakPtr())));
@@ -470,6 +485,10 @@ bool RenderWidgetHostImpl::OnMessageReceived(const IPC::Message &msg) {
     IPC_MESSAGE_HANDLER(FrameHostMsg_HittestData, OnHittestData)
     IPC_MESSAGE_HANDLER(InputHostMsg_QueueSyntheticGesture,
                         OnQueueSyntheticGesture)
+    IPC_MESSAGE_HANDLER(InputHostMsg_RunInteractionEnergyBenchmark,
+                        OnRunInteractionEnergyBenchmark)
+    IPC_MESSAGE_HANDLER(InputHostMsg_RunEnergyCalibration,
+                        OnRunEnergyCalibration)
     IPC_MESSAGE_HANDLER(InputHostMsg_ImeCancelComposition,
                         OnImeCancelComposition)
     IPC_MESSAGE_HANDLER(ViewHostMsg_Close, OnClose)
@@ -533,6 +552,10 @@ void RenderWidgetHostImpl::WasHidden() {
   // Don't bother reporting hung state when we aren't active.
   StopHangMonitorTimeout();
 
+  // Nothing competes with loads of a hidden widget.
+  user_interaction_grace_timer_.Stop();
+  SetUserInteracting(false);
+
   // If we have a renderer, then inform it that we are being hidden so it can
   // reduce its resource utilization.
   Send(new ViewMsg_WasHidden(routing_id_));
@@ -1049,6 +1072,16 @@ void RenderWidgetHostImpl::ForwardGestureEventWithLatencyInfo(
     *is_in_gesture_scroll = false;
   }
 
+  if (hold_loads_while_interacting_) {
+    if (gesture_event.type == blink::WebInputEvent::GestureScrollBegin) {
+      user_interaction_grace_timer_.Stop();
+      SetUserInteracting(true);
+    } else if (gesture_event.type == blink::WebInputEvent::GestureScrollEnd) {
+      // A fling keeps the interaction going until DidStopFlinging().
+      OnUserInteractionEnded();
+    }
+  }
+
   bool scroll_update_needs_wrapping =
       gesture_event.type == blink::WebInputEvent::GestureScrollUpdate &&
       gesture_event.resendingPluginId != -1 && !(*is_in_gesture_scroll);
@@ -1193,6 +1226,12 @@ void RenderWidgetHostImpl::QueueSyntheticGesture(
   }
 }
 
+void RenderWidgetHostImpl::SetTargetFrameRate(int fps) {
+  target_frame_rate_ = fps;
+  input_router_->SetTargetFrameRate(fps);
+  latency_tracker_.SetTargetFrameRate(fps);
+}
+
 void RenderWidgetHostImpl::SetCursor(const WebCursor& cursor) {
   if (!view_)
     return;
@@ -1361,6 +1400,9 @@ void RenderWidgetHostImpl::RendererExited(base::TerminationStatus status,
   // Must reset these to ensure that keyboard events work with a new renderer.
   suppress_next_char_events_ = false;
 
+  user_interaction_grace_timer_.Stop();
+  SetUserInteracting(false);
+
   // Reset some fields in preparation for recovering from a crash.
   ResetSizeAndRepaintPendingFlags();
   current_size_.SetSize(0, 0);
@@ -1622,6 +1664,10 @@ bool RenderWidgetHostImpl::OnSwapCompositorFrame(
   }
 
   latency_tracker_.OnSwapCompositorFrame(&frame.metadata.latency_info);
+  if (interaction_energy_benchmark_)
+    interaction_energy_benchmark_->DidSwapCompositorFrame();
+  if (energy_calibration_)
+    energy_calibration_->DidSwapCompositorFrame();
 
   bool is_mobile_optimized = IsMobileOptimizedFrame(frame.metadata);
   input_router_->NotifySiteIsMobileOptimized(is_mobile_optimized);
@@ -1751,6 +1797,58 @@ void RenderWidgetHostImpl::OnQueueSyntheticGesture(
                    weak_factory_.GetWeakPtr()));
 }
 
+void RenderWidgetHostImpl::OnRunInteractionEnergyBenchmark(
+    const std::vector<float>& speeds,
+    const gfx::Vector2dF& distance,
+    const gfx::PointF& anchor) {
+  // Only allow untrustworthy gestures if explicitly enabled.
+  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(
+          cc::switches::kEnableGpuBenchmarking)) {
+    bad_message::ReceivedBadMessage(GetProcess(),
+                                    bad_message::RWH_SYNTHETIC_GESTURE);
+    return;
+  }
+
+  // The renderer runs one benchmark at a time.
+  if (interaction_energy_benchmark_ &&
+      interaction_energy_benchmark_->is_running()) {
+    return;
+  }
+  battery_status_subscription_.reset();
+  interaction_energy_benchmark_.reset(new InteractionEnergyBenchmark(
+      this, &latency_tracker_, speeds, distance, anchor,
+      base::Bind(&RenderWidgetHostImpl::OnInteractionEnergyBenchmarkCompleted,
+                 weak_factory_.GetWeakPtr())));
+  battery_status_subscription_ =
+      device::BatteryStatusService::GetInstance()->AddCallback(
+          base::Bind(&InteractionEnergyBenchmark::OnBatteryStatusUpdate,
+                     base::Unretained(interaction_energy_benchmark_.get())));
+  interaction_energy_benchmark_->Start();
+}
+
+void RenderWidgetHostImpl::OnRunEnergyCalibration(
+    const std::vector<int>& frame_rates,
+    float speed,
+    const gfx::Vector2dF& distance,
+    const gfx::PointF& anchor) {
+  // Only allow untrustworthy gestures if explicitly enabled.
+  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(
+          cc::switches::kEnableGpuBenchmarking)) {
+    bad_message::ReceivedBadMessage(GetProcess(),
+                                    bad_message::RWH_SYNTHETIC_GESTURE);
+    return;
+  }
+
+  // The renderer runs one calibration at a time.
+  if (energy_calibration_ && energy_calibration_->is_running())
+    return;
+  energy_calibration_.reset(new EnergyCalibration(
+      this, frame_rates, speed, distance, anchor,
+      base::Bind(&RenderWidgetHostImpl::OnEnergyCalibrationCompleted,
+                 weak_factory_.GetWeakPtr())));
+  energy_calibration_->Start();
+}
+
 void RenderWidgetHostImpl::OnSetCursor(const WebCursor& cursor) {
   SetCursor(cursor);
 }
@@ -1772,8 +1870,31 @@ void RenderWidgetHostImpl::SetTouchEventEmulationEnabled(
 
 void RenderWidgetHostImpl::OnTextInputStateChanged(
     const TextInputState& params) {
-  if (view_)
-    view_->TextInputStateChanged(params);
+  if (params.value_change_start == -1) {
+    text_input_value_ = params.value;
+    if (view_)
+      view_->TextInputStateChanged(params);
+    return;
+  }
+
+  if (params.value_change_start < 0 ||
+      params.value_change_end < params.value_change_start ||
+      static_cast<size_t>(params.value_change_end) >
+          text_input_value_.size()) {
+    bad_message::ReceivedBadMessage(GetProcess(),
+                                    bad_message::RWH_BAD_TEXT_INPUT_CHANGE);
+    return;
+  }
+  text_input_value_.replace(params.value_change_start,
+                            params.value_change_end - params.value_change_start,
+                            params.value);
+  if (!view_)
+    return;
+  TextInputState state = params;
+  state.value = text_input_value_;
+  state.value_change_start = -1;
+  state.value_change_end = -1;
+  view_->TextInputStateChanged(state);
 }
 
 void RenderWidgetHostImpl::OnImeCompositionRangeChanged(
@@ -1939,6 +2060,30 @@ void RenderWidgetHostImpl::DidOverscroll(
 void RenderWidgetHostImpl::DidStopFlinging() {
   if (view_)
     view_->DidStopFlinging();
+  OnUserInteractionEnded();
+}
+
+void RenderWidgetHostImpl::SetUserInteracting(bool is_interacting) {
+  if (is_user_interacting_ == is_interacting)
+    return;
+  is_user_interacting_ = is_interacting;
+  if (ResourceDispatcherHostImpl::Get()) {
+    BrowserThread::PostTask(
+        BrowserThread::IO, FROM_HERE,
+        base::Bind(
+            &ResourceDispatcherHostImpl::OnRenderViewHostUserInteractionChanged,
+            base::Unretained(ResourceDispatcherHostImpl::Get()),
+            process_->GetID(), routing_id_, is_interacting));
+  }
+}
+
+void RenderWidgetHostImpl::OnUserInteractionEnded() {
+  if (!is_user_interacting_)
+    return;
+  user_interaction_grace_timer_.Start(
+      FROM_HERE, user_interaction_grace_period_,
+      base::Bind(&RenderWidgetHostImpl::SetUserInteracting,
+                 base::Unretained(this), false));
 }
 
 void RenderWidgetHostImpl::DispatchInputEventWithLatencyInfo(
@@ -2026,6 +2171,26 @@ void RenderWidgetHostImpl::OnSyntheticGestureCompleted(
   Send(new InputMsg_SyntheticGestureCompleted(GetRoutingID()));
 }
 
+void RenderWidgetHostImpl::OnInteractionEnergyBenchmarkCompleted(
+    const std::string& report) {
+  battery_status_subscription_.reset();
+  Send(new InputMsg_InteractionEnergyBenchmarkCompleted(GetRoutingID(),
+                                                        report));
+}
+
+void RenderWidgetHostImpl::OnEnergyCalibrationCompleted(
+    const std::string& report) {
+  Send(new InputMsg_EnergyCalibrationCompleted(GetRoutingID(), report));
+}
+
+void RenderWidgetHostImpl::SetInputModelsEnabled(bool enabled) {
+  Send(new InputMsg_SetModelsEnabled(GetRoutingID(), enabled));
+}
+
+void RenderWidgetHostImpl::SetFixedFrameRate(int fps) {
+  Send(new InputMsg_SetFixedFrameRate(GetRoutingID(), fps));
+}
+
 bool RenderWidgetHostImpl::ShouldDropInputEvents() const {
   return ignore_input_events_ || process_->IgnoreInputEvents() || !delegate_;
 }
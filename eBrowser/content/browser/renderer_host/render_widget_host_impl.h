@@ -23,11 +23,14 @@
 #include "base/strings/string16.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
+#include "base/timer/timer.h"
 #include "build/build_config.h"
 #include "cc/resources/shared_bitmap.h"
 #include "content/browser/renderer_host/event_with_latency_info.h"
+#include "content/browser/renderer_host/input/energy_calibration.h"
 #include "content/browser/renderer_host/input/input_ack_handler.h"
 #include "content/browser/renderer_host/input/input_router_client.h"
+#include "content/browser/renderer_host/input/interaction_energy_benchmark.h"
 #include "content/browser/renderer_host/input/render_widget_host_latency_tracker.h"
 #include "content/browser/renderer_host/input/synthetic_gesture.h"
 #include "content/browser/renderer_host/input/touch_emulator_client.h"
@@ -39,6 +42,7 @@
 #include "content/public/browser/readback_types.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/common/page_zoom.h"
+#include "device/battery/battery_status_service.h"
 #include "ipc/ipc_listener.h"
 #include "third_party/WebKit/public/platform/WebDisplayMode.h"
 #include "ui/base/ime/text_input_mode.h"
@@ -99,6 +103,8 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
                                             public InputRouterClient,
                                             public InputAckHandler,
                                             public TouchEmulatorClient,
+                                            public InteractionEnergyBenchmark::Client,
+                                            public EnergyCalibration::Client,
                                             public IPC::Listener {
  public:
   // |routing_id| must not be MSG_ROUTING_NONE.
@@ -341,7 +347,8 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
   // callback when the gesture is finished running.
   void QueueSyntheticGesture(
       std::unique_ptr<SyntheticGesture> synthetic_gesture,
-      const base::Callback<void(SyntheticGesture::Result)>& on_complete);
+      const base::Callback<void(SyntheticGesture::Result)>& on_complete)
+      override;
 
   void CancelUpdateTextDirection();
 
@@ -486,6 +493,11 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
 
   InputRouter* input_router() { return input_router_.get(); }
 
+  // Forwards the frame rate the renderer targets during an interaction, or 0
+  // for the display rate, to input routing and latency tracking.
+  void SetTargetFrameRate(int fps);
+  int target_frame_rate() const { return target_frame_rate_; }
+
   // Get the BrowserAccessibilityManager for the root of the frame tree,
   BrowserAccessibilityManager* GetRootBrowserAccessibilityManager();
 
@@ -582,6 +594,14 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
   // NotifyRendererResponsive.
   void RendererIsResponsive();
 
+  // Tells the ResourceScheduler whether the user is interacting with this
+  // widget, so that its delayable loads wait for the interaction to end.
+  void SetUserInteracting(bool is_interacting);
+
+  // Called when a scroll or fling ends. Delayable loads resume after
+  // |user_interaction_grace_period_| unless another scroll starts.
+  void OnUserInteractionEnded();
+
   // IPC message handlers
   void OnRenderProcessGone(int status, int error_code);
   void OnClose();
@@ -592,6 +612,13 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
   bool OnSwapCompositorFrame(const IPC::Message& message);
   void OnUpdateRect(const ViewHostMsg_UpdateRect_Params& params);
   void OnQueueSyntheticGesture(const SyntheticGesturePacket& gesture_packet);
+  void OnRunInteractionEnergyBenchmark(const std::vector<float>& speeds,
+                                       const gfx::Vector2dF& distance,
+                                       const gfx::PointF& anchor);
+  void OnRunEnergyCalibration(const std::vector<int>& frame_rates,
+                              float speed,
+                              const gfx::Vector2dF& distance,
+                              const gfx::PointF& anchor);
   void OnSetCursor(const WebCursor& cursor);
   void OnTextInputStateChanged(const TextInputState& params);
 
@@ -652,6 +679,14 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
   void OnUnexpectedEventAck(UnexpectedEventAckType type) override;
 
   void OnSyntheticGestureCompleted(SyntheticGesture::Result result);
+  void OnInteractionEnergyBenchmarkCompleted(const std::string& report);
+  void OnEnergyCalibrationCompleted(const std::string& report);
+
+  // InteractionEnergyBenchmark::Client implementation.
+  void SetInputModelsEnabled(bool enabled) override;
+
+  // EnergyCalibration::Client implementation.
+  void SetFixedFrameRate(int fps) override;
 
   // Called when there is a new auto resize (using a post to avoid a stack
   // which may get in recursive loops).
@@ -721,6 +756,10 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
   // The maximum size for the render widget if auto-resize is enabled.
   gfx::Size max_size_for_auto_resize_;
 
+  // The value of the focused text field, which the renderer may update with
+  // just the changes to it.
+  std::string text_input_value_;
+
   bool waiting_for_screen_rects_ack_;
   gfx::Rect last_view_screen_rect_;
   gfx::Rect last_window_screen_rect_;
@@ -796,8 +835,22 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
   bool is_in_touchpad_gesture_scroll_;
   bool is_in_touchscreen_gesture_scroll_;
 
+  // Set by --ebrowser-interaction-aware-loading. True while delayable loads
+  // are held back for a scroll, including its grace period.
+  bool hold_loads_while_interacting_;
+  bool is_user_interacting_;
+  base::TimeDelta user_interaction_grace_period_;
+  base::OneShotTimer user_interaction_grace_timer_;
+
   std::unique_ptr<SyntheticGestureController> synthetic_gesture_controller_;
 
+  // The last interaction energy benchmark, and its battery feed while it runs.
+  std::unique_ptr<InteractionEnergyBenchmark> interaction_energy_benchmark_;
+  std::unique_ptr<device::BatteryStatusService::BatteryUpdateSubscription>
+      battery_status_subscription_;
+  // The last energy calibration.
+  std::unique_ptr<EnergyCalibration> energy_calibration_;
+
   std::unique_ptr<TouchEmulator> touch_emulator_;
 
   // Receives and handles all input events.
@@ -821,6 +874,9 @@ class CONTENT_EXPORT RenderWidgetHostImpl : public RenderWidgetHost,
 
   RenderWidgetHostLatencyTracker latency_tracker_;
 
+  // See SetTargetFrameRate().
+  int target_frame_rate_;
+
   int next_browser_snapshot_id_;
   using PendingSnapshotMap = std::map<int, GetSnapshotFromBrowserCallback>;
   PendingSnapshotMap pending_browser_snapshots_;
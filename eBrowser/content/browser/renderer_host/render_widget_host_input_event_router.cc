@@ -566,8 +566,8 @@ void RenderWidgetHostInputEventRouter::SendGestureScrollEnd(
          event.type == blink::WebInputEvent::GesturePinchEnd);
   blink::WebGestureEvent scroll_end(event);
   scroll_end.type = blink::WebInputEvent::GestureScrollEnd;
-  scroll_end.timeStampSeconds =
-      (base::TimeTicks::Now() - base::TimeTicks()).InSecondsF();
+  // Keep the timestamp of the input that ended the scroll, like the begin
+  // sent alongside it, so the sequence stays on the input timeline.
   scroll_end.data.scrollEnd.inertialPhase =
       event.data.scrollUpdate.inertialPhase;
   scroll_end.data.scrollEnd.deltaUnits = event.data.scrollUpdate.deltaUnits;
@@ -25,6 +25,7 @@
 #include "content/common/input/synthetic_web_input_event_builders.h"
 #include "content/common/input_messages.h"
 #include "content/common/resize_params.h"
+#include "content/common/text_input_state.h"
 #include "content/common/view_messages.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/test/mock_render_process_host.h"
@@ -131,6 +132,7 @@ class MockInputRouter : public InputRouter {
   bool HasPendingEvents() const override { return false; }
   void SetDeviceScaleFactor(float device_scale_factor) override {}
   void SetFrameTreeNodeId(int frameTreeNodeId) override {}
+  void SetTargetFrameRate(int fps) override {}
 
   // IPC::Listener
   bool OnMessageReceived(const IPC::Message& message) override {
@@ -270,6 +272,7 @@ class TestView : public TestRenderWidgetHostView {
   }
   int gesture_event_type() const { return gesture_event_type_; }
   InputEventAckState ack_result() const { return ack_result_; }
+  const std::string& text_input_value() const { return text_input_value_; }
 
   void SetMockPhysicalBackingSize(const gfx::Size& mock_physical_backing_size) {
     use_fake_physical_backing_size_ = true;
@@ -303,6 +306,10 @@ class TestView : public TestRenderWidgetHostView {
       return mock_physical_backing_size_;
     return TestRenderWidgetHostView::GetPhysicalBackingSize();
   }
+  void TextInputStateChanged(const TextInputState& params) override {
+    EXPECT_EQ(-1, params.value_change_start);
+    text_input_value_ = params.value;
+  }
 #if defined(USE_AURA)
   ~TestView() override {
     // Simulate the mouse exit event dispatched when an aura window is
@@ -327,6 +334,7 @@ class TestView : public TestRenderWidgetHostView {
   bool use_fake_physical_backing_size_;
   gfx::Size mock_physical_backing_size_;
   InputEventAckState ack_result_;
+  std::string text_input_value_;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(TestView);
@@ -1713,4 +1721,34 @@ TEST_F(RenderWidgetHostTest, EventDispatchPostDetach) {
   ASSERT_FALSE(host_->input_router()->HasPendingEvents());
 }
 
+// Tests that the view is given the whole value of a text field that the
+// renderer updates with just the changes to it.
+TEST_F(RenderWidgetHostTest, TextInputValueChanges) {
+  TextInputState state;
+  state.value = "Hello world";
+  host_->OnMessageReceived(ViewHostMsg_TextInputStateChanged(0, state));
+  EXPECT_EQ("Hello world", view_->text_input_value());
+
+  state.value = ", big";
+  state.value_change_start = 5;
+  state.value_change_end = 5;
+  host_->OnMessageReceived(ViewHostMsg_TextInputStateChanged(0, state));
+  EXPECT_EQ("Hello, big world", view_->text_input_value());
+
+  state.value = "";
+  state.value_change_start = 5;
+  state.value_change_end = 10;
+  host_->OnMessageReceived(ViewHostMsg_TextInputStateChanged(0, state));
+  EXPECT_EQ("Hello world", view_->text_input_value());
+  EXPECT_EQ(0, process_->bad_msg_count());
+
+  // A change beyond the end of the value is rejected.
+  state.value = "!";
+  state.value_change_start = 11;
+  state.value_change_end = 12;
+  host_->OnMessageReceived(ViewHostMsg_TextInputStateChanged(0, state));
+  EXPECT_EQ("Hello world", view_->text_input_value());
+  EXPECT_EQ(1, process_->bad_msg_count());
+}
+
 }  // namespace content
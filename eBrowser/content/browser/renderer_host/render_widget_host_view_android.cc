@@ -46,10 +46,12 @@
 #include "content/browser/gpu/browser_gpu_channel_host_factory.h"
 #include "content/browser/gpu/compositor_util.h"
 #include "content/browser/gpu/gpu_data_manager_impl.h"
+#include "content/browser/gpu/gpu_process_host.h"
 #include "content/browser/gpu/gpu_process_host_ui_shim.h"
 #include "content/browser/media/android/media_web_contents_observer_android.h"
 #include "content/browser/renderer_host/compositor_impl_android.h"
 #include "content/browser/renderer_host/dip_util.h"
+#include "content/browser/renderer_host/frame_rate_budget.h"
 #include "content/browser/renderer_host/frame_metadata_util.h"
 #include "content/browser/renderer_host/input/input_router_impl.h"
 #include "content/browser/renderer_host/input/synthetic_gesture_target_android.h"
@@ -57,6 +59,7 @@
 #include "content/browser/renderer_host/render_process_host_impl.h"
 #include "content/browser/renderer_host/render_view_host_impl.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
+#include "content/browser/renderer_host/renderer_frame_manager.h"
 #include "content/common/gpu_host_messages.h"
 #include "content/common/input_messages.h"
 #include "content/common/view_messages.h"
@@ -84,6 +87,7 @@
 #include "ui/display/screen.h"
 #include "ui/events/blink/blink_event_util.h"
 #include "ui/events/blink/did_overscroll_params.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 #include "ui/events/blink/web_input_event_traits.h"
 #include "ui/events/gesture_detection/gesture_provider_config_helper.h"
 #include "ui/events/gesture_detection/motion_event.h"
@@ -100,6 +104,20 @@ namespace {
 
 const int kUndefinedCompositorFrameSinkId = -1;
 
+// How long after the last input a widget falls back to the foreground idle
+// frame rate budget.
+const int kFrameRateBudgetIdleDelayMs = 3000;
+// The same for audible widgets, so that pages the user plays along with, such
+// as rhythm games, keep the full frame rate through pauses in their input.
+const int kAudibleFrameRateBudgetIdleDelayMs = 10000;
+
+void SendGpuTargetFrameRateOnIO(int fps) {
+  GpuProcessHost* host = GpuProcessHost::Get(
+      GpuProcessHost::GPU_PROCESS_KIND_SANDBOXED, false /* force_create */);
+  if (host)
+    host->Send(new GpuMsg_SetTargetFrameRate(fps));
+}
+
 static const char kAsyncReadBackString[] = "Compositing.CopyFromSurfaceTime";
 
 class PendingReadbackLock;
@@ -438,6 +456,7 @@ RenderWidgetHostViewAndroid::RenderWidgetHostViewAndroid(
     ContentViewCoreImpl* content_view_core)
     : host_(widget_host),
       outstanding_vsync_requests_(0),
+      begin_frame_target_rate_(0),
       is_showing_(!widget_host->is_hidden()),
       is_window_visible_(true),
       is_window_activity_started_(true),
@@ -453,7 +472,23 @@ RenderWidgetHostViewAndroid::RenderWidgetHostViewAndroid(
       frame_evictor_(new DelegatedFrameEvictor(this)),
       locks_on_frame_count_(0),
       observing_root_window_(false),
+      is_flinging_(false),
+      sent_frame_rate_budget_(ui::ScrollUpdatePacer::kMaxFrameRate),
       weak_ptr_factory_(this) {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (command_line.HasSwitch(switches::kEBrowserFrameRateBudget)) {
+    FrameRateBudget::Rates rates;
+    if (FrameRateBudget::ParseRates(command_line.GetSwitchValueASCII(
+                                        switches::kEBrowserFrameRateBudget),
+                                    &rates)) {
+      frame_rate_budget_.reset(new FrameRateBudget(rates));
+    } else {
+      LOG(ERROR) << "Ignoring invalid --"
+                 << switches::kEBrowserFrameRateBudget;
+    }
+  }
+
   // Set the layer which will hold the content layer for this view. The content
   // layer is managed by the DelegatedFrameHost.
   view_.SetLayer(cc::Layer::Create());
@@ -494,6 +529,10 @@ bool RenderWidgetHostViewAndroid::OnMessageReceived(
                         OnSmartClipDataExtracted)
     IPC_MESSAGE_HANDLER(ViewHostMsg_ShowUnhandledTapUIIfNeeded,
                         OnShowUnhandledTapUIIfNeeded)
+    IPC_MESSAGE_HANDLER(ViewHostMsg_SetBeginFrameTargetRate,
+                        OnSetBeginFrameTargetRate)
+    IPC_MESSAGE_HANDLER(InputHostMsg_DidRecordImplicitFeedback,
+                        OnDidRecordImplicitFeedback)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
   return handled;
@@ -816,11 +855,19 @@ void RenderWidgetHostViewAndroid::OnSmartClipDataExtracted(
     content_view_core_->OnSmartClipDataExtracted(text, html, rect);
 }
 
+void RenderWidgetHostViewAndroid::OnDidRecordImplicitFeedback(
+    const std::vector<ui::ImplicitFeedbackSample>& samples) {
+  if (content_view_core_)
+    content_view_core_->OnImplicitFeedback(samples);
+}
+
 bool RenderWidgetHostViewAndroid::OnTouchEvent(
     const ui::MotionEvent& event) {
   if (!host_)
     return false;
 
+  OnFrameRateBudgetInput();
+
   ComputeEventLatencyOSTouchHistograms(event);
 
   // If a browser-based widget consumes the touch event, it's critical that
@@ -1375,6 +1422,7 @@ void RenderWidgetHostViewAndroid::ShowInternal() {
     overscroll_controller_->Enable();
 
   host_->WasShown(ui::LatencyInfo());
+  UpdateFrameRateBudget();
 
   if (content_view_core_) {
     StartObservingRootWindow();
@@ -1419,6 +1467,49 @@ void RenderWidgetHostViewAndroid::HideInternal() {
   // Inform the renderer that we are being hidden so it can reduce its resource
   // utilization.
   host_->WasHidden();
+  UpdateFrameRateBudget();
+}
+
+void RenderWidgetHostViewAndroid::OnFrameRateBudgetInput() {
+  if (!frame_rate_budget_)
+    return;
+
+  frame_rate_budget_->SetInteracting(true);
+  frame_rate_budget_idle_timer_.Start(
+      FROM_HERE,
+      base::TimeDelta::FromMilliseconds(
+          frame_rate_budget_->audible() ? kAudibleFrameRateBudgetIdleDelayMs
+                                        : kFrameRateBudgetIdleDelayMs),
+      base::Bind(&RenderWidgetHostViewAndroid::OnFrameRateBudgetIdle,
+                 base::Unretained(this)));
+  UpdateFrameRateBudget();
+}
+
+void RenderWidgetHostViewAndroid::OnFrameRateBudgetIdle() {
+  // DidStopFlinging() restarts the idle delay.
+  if (is_flinging_)
+    return;
+
+  frame_rate_budget_->SetInteracting(false);
+  UpdateFrameRateBudget();
+}
+
+void RenderWidgetHostViewAndroid::UpdateFrameRateBudget() {
+  if (!frame_rate_budget_ || !host_)
+    return;
+
+  frame_rate_budget_->SetVisible(!host_->is_hidden());
+  int fps = frame_rate_budget_->frame_rate();
+  // Hidden widgets get no BeginFrames at all, so there is nothing to cap; the
+  // last cap stays in place until the widget is shown again.
+  if (!fps || fps == sent_frame_rate_budget_)
+    return;
+
+  TRACE_EVENT_INSTANT2("input", "RenderWidgetHostViewAndroid::FrameRateBudget",
+                       TRACE_EVENT_SCOPE_THREAD, "level",
+                       frame_rate_budget_->level(), "fps", fps);
+  sent_frame_rate_budget_ = fps;
+  host_->Send(new ViewMsg_SetBeginFrameBudget(host_->GetRoutingID(), fps));
 }
 
 void RenderWidgetHostViewAndroid::RequestVSyncUpdate(uint32_t requests) {
@@ -1453,6 +1544,8 @@ void RenderWidgetHostViewAndroid::StartObservingRootWindow() {
   if (host_)
     host_->Send(new ViewMsg_SetBeginFramePaused(host_->GetRoutingID(), false));
   content_view_core_->GetWindowAndroid()->AddObserver(this);
+  if (begin_frame_target_rate_ && using_browser_compositor_)
+    SetRootWindowTargetFrameRate(begin_frame_target_rate_);
 
   // Clear existing vsync requests to allow a request to the new window.
   uint32_t outstanding_vsync_requests = outstanding_vsync_requests_;
@@ -1467,6 +1560,44 @@ void RenderWidgetHostViewAndroid::StartObservingRootWindow() {
   }
 }
 
+void RenderWidgetHostViewAndroid::OnSetBeginFrameTargetRate(int fps) {
+  begin_frame_target_rate_ =
+      fps < ui::ScrollUpdatePacer::kMaxFrameRate ? fps : 0;
+  if (host_)
+    host_->SetTargetFrameRate(begin_frame_target_rate_);
+  // The synchronous compositor is driven by the embedder's vsync, which is
+  // not ours to decimate, so it skips the draws the embedder demands instead.
+  if (sync_compositor_)
+    sync_compositor_->SetTargetFrameRate(begin_frame_target_rate_);
+  if (observing_root_window_ && using_browser_compositor_)
+    SetRootWindowTargetFrameRate(begin_frame_target_rate_);
+}
+
+void RenderWidgetHostViewAndroid::SetRootWindowTargetFrameRate(int fps) {
+  content_view_core_->GetWindowAndroid()->SetVSyncTargetFrameRate(fps);
+  RendererFrameManager::GetInstance()->SetForegroundInteractionThrottled(
+      fps > 0);
+  // The display compositor's swaps then reach the GPU at |fps| as well.
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                          base::Bind(&SendGpuTargetFrameRateOnIO, fps));
+}
+
+void RenderWidgetHostViewAndroid::OnWindowFocusChanged(bool has_window_focus) {
+  if (!frame_rate_budget_)
+    return;
+
+  frame_rate_budget_->SetOccluded(!has_window_focus);
+  UpdateFrameRateBudget();
+}
+
+void RenderWidgetHostViewAndroid::SetAudible(bool audible) {
+  if (!frame_rate_budget_)
+    return;
+
+  frame_rate_budget_->SetAudible(audible);
+  UpdateFrameRateBudget();
+}
+
 void RenderWidgetHostViewAndroid::StopObservingRootWindow() {
   if (!content_view_core_ || !(content_view_core_->GetWindowAndroid())) {
     DCHECK(!observing_root_window_);
@@ -1482,6 +1613,8 @@ void RenderWidgetHostViewAndroid::StopObservingRootWindow() {
   observing_root_window_ = false;
   if (host_)
     host_->Send(new ViewMsg_SetBeginFramePaused(host_->GetRoutingID(), true));
+  if (begin_frame_target_rate_)
+    SetRootWindowTargetFrameRate(0);
   content_view_core_->GetWindowAndroid()->RemoveObserver(this);
   // If the DFH has already been destroyed, it will have cleaned itself up.
   // This happens in some WebView cases.
@@ -1656,17 +1789,20 @@ void RenderWidgetHostViewAndroid::SendKeyEvent(
   if (!target_host)
     return;
 
+  OnFrameRateBudgetInput();
   target_host->ForwardKeyboardEvent(event);
 }
 
 void RenderWidgetHostViewAndroid::SendMouseEvent(
     const blink::WebMouseEvent& event) {
+  OnFrameRateBudgetInput();
   if (host_)
     host_->ForwardMouseEvent(event);
 }
 
 void RenderWidgetHostViewAndroid::SendMouseWheelEvent(
     const blink::WebMouseWheelEvent& event) {
+  OnFrameRateBudgetInput();
   if (host_) {
     ui::LatencyInfo latency_info(ui::SourceEventType::WHEEL);
     latency_info.AddLatencyNumber(ui::INPUT_EVENT_LATENCY_UI_COMPONENT, 0, 0);
@@ -1680,6 +1816,12 @@ void RenderWidgetHostViewAndroid::SendGestureEvent(
   if (overscroll_controller_)
     overscroll_controller_->Enable();
 
+  if (event.type == blink::WebInputEvent::GestureFlingStart)
+    is_flinging_ = true;
+  else if (event.type == blink::WebInputEvent::GestureFlingCancel)
+    is_flinging_ = false;
+  OnFrameRateBudgetInput();
+
   if (host_) {
     ui::LatencyInfo latency_info =
         ui::WebInputEventTraits::CreateLatencyInfoForWebGestureEvent(event);
@@ -1735,11 +1877,16 @@ void RenderWidgetHostViewAndroid::DidOverscroll(
   if (!content_view_core_ || !is_showing_)
     return;
 
-  if (overscroll_controller_)
+  if (overscroll_controller_) {
+    overscroll_controller_->SetTargetFrameRate(begin_frame_target_rate_);
     overscroll_controller_->OnOverscrolled(params);
+  }
 }
 
 void RenderWidgetHostViewAndroid::DidStopFlinging() {
+  // Start the idle delay from the end of the fling rather than its start.
+  is_flinging_ = false;
+  OnFrameRateBudgetInput();
   if (content_view_core_)
     content_view_core_->DidStopFlinging();
 }
@@ -1816,6 +1963,8 @@ void RenderWidgetHostViewAndroid::SetContentViewCore(
   if (!sync_compositor_) {
     sync_compositor_ = SynchronousCompositorHost::Create(
         this, content_view_core_->GetWebContents());
+    if (sync_compositor_)
+      sync_compositor_->SetTargetFrameRate(begin_frame_target_rate_);
   }
 }
 
@@ -1926,6 +2075,12 @@ void RenderWidgetHostViewAndroid::OnAnimate(base::TimeTicks begin_frame_time) {
     SetNeedsAnimate();
 }
 
+void RenderWidgetHostViewAndroid::OnDisplayRefreshRateChanged() {
+  // The renderer snaps its gesture frame rates to what the display can show.
+  if (host_)
+    host_->NotifyScreenInfoChanged();
+}
+
 void RenderWidgetHostViewAndroid::OnActivityStopped() {
   TRACE_EVENT0("browser", "RenderWidgetHostViewAndroid::OnActivityStopped");
   DCHECK(observing_root_window_);
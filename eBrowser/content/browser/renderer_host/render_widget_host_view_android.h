@@ -11,6 +11,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/compiler_specific.h"
@@ -18,6 +19,7 @@
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/process/process.h"
+#include "base/timer/timer.h"
 #include "cc/input/selection.h"
 #include "cc/output/begin_frame_args.h"
 #include "content/browser/accessibility/browser_accessibility_manager.h"
@@ -32,6 +34,7 @@
 #include "third_party/skia/include/core/SkColor.h"
 #include "ui/android/view_android.h"
 #include "ui/android/window_android_observer.h"
+#include "ui/events/blink/implicit_feedback_recorder.h"
 #include "ui/events/gesture_detection/filtered_gesture_provider.h"
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/geometry/vector2d_f.h"
@@ -62,6 +65,7 @@ class DelegatedFrameHostAndroid;
 namespace content {
 class ContentViewCoreImpl;
 class ContentViewCoreObserver;
+class FrameRateBudget;
 class OverscrollControllerAndroid;
 class RenderWidgetHost;
 class RenderWidgetHostImpl;
@@ -156,6 +160,7 @@ class CONTENT_EXPORT RenderWidgetHostViewAndroid
   void ClearCompositorFrame() override;
   void DidOverscroll(const ui::DidOverscrollParams& params) override;
   void DidStopFlinging() override;
+  void SetAudible(bool audible) override;
   cc::FrameSinkId GetFrameSinkId() override;
   void ShowDisambiguationPopup(const gfx::Rect& rect_pixels,
                                const SkBitmap& zoomed_bitmap) override;
@@ -177,6 +182,7 @@ class CONTENT_EXPORT RenderWidgetHostViewAndroid
   void OnVSync(base::TimeTicks frame_time,
                base::TimeDelta vsync_period) override;
   void OnAnimate(base::TimeTicks begin_frame_time) override;
+  void OnDisplayRefreshRateChanged() override;
   void OnActivityStopped() override;
   void OnActivityStarted() override;
 
@@ -239,6 +245,10 @@ class CONTENT_EXPORT RenderWidgetHostViewAndroid
   void SetTextHandlesTemporarilyHidden(bool hidden);
   void OnShowingPastePopup(const gfx::PointF& point);
   void OnShowUnhandledTapUIIfNeeded(int x_dip, int y_dip);
+  void OnSetBeginFrameTargetRate(int fps);
+  void OnDidRecordImplicitFeedback(
+      const std::vector<ui::ImplicitFeedbackSample>& samples);
+  void OnWindowFocusChanged(bool has_window_focus);
 
   void SynchronousFrameMetadata(cc::CompositorFrameMetadata frame_metadata);
 
@@ -257,6 +267,12 @@ class CONTENT_EXPORT RenderWidgetHostViewAndroid
 
   void ShowInternal();
   void HideInternal();
+
+  // Frame rate budget bookkeeping; no-ops unless --ebrowser-frame-rate-budget
+  // is given.
+  void OnFrameRateBudgetInput();
+  void OnFrameRateBudgetIdle();
+  void UpdateFrameRateBudget();
   void AttachLayers();
   void RemoveLayers();
 
@@ -293,6 +309,9 @@ class CONTENT_EXPORT RenderWidgetHostViewAndroid
   void RequestVSyncUpdate(uint32_t requests);
   void StartObservingRootWindow();
   void StopObservingRootWindow();
+  // Decimates the root window's vsync and paces the GPU's swaps to |fps|, or
+  // restores the display rate for 0.
+  void SetRootWindowTargetFrameRate(int fps);
   void SendBeginFrame(base::TimeTicks frame_time, base::TimeDelta vsync_period);
   bool Animate(base::TimeTicks frame_time);
   void RequestDisallowInterceptTouchEvent();
@@ -307,6 +326,10 @@ class CONTENT_EXPORT RenderWidgetHostViewAndroid
   // Used to control action dispatch at the next |OnVSync()| call.
   uint32_t outstanding_vsync_requests_;
 
+  // Frame rate the renderer is throttled to, or 0 when it runs at the display
+  // rate. Applied to the root window's vsync while observing it.
+  int begin_frame_target_rate_;
+
   bool is_showing_;
 
   // Window-specific bits that affect widget visibility.
@@ -374,6 +397,15 @@ class CONTENT_EXPORT RenderWidgetHostViewAndroid
   // The last scroll offset of the view.
   gfx::Vector2dF last_scroll_offset_;
 
+  // Caps the renderer's BeginFrame rate once the user stops interacting with
+  // this widget or its window loses focus. Null when disabled.
+  std::unique_ptr<FrameRateBudget> frame_rate_budget_;
+  base::OneShotTimer frame_rate_budget_idle_timer_;
+  // A fling keeps the widget interacting until DidStopFlinging().
+  bool is_flinging_;
+  // The cap last sent to the renderer.
+  int sent_frame_rate_budget_;
+
   base::WeakPtrFactory<RenderWidgetHostViewAndroid> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(RenderWidgetHostViewAndroid);
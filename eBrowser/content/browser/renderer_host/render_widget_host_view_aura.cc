@@ -73,8 +73,10 @@
 #include "ui/base/hit_test.h"
 #include "ui/base/ime/input_method.h"
 #include "ui/base/ui_base_types.h"
+#include "ui/compositor/compositor.h"
 #include "ui/compositor/compositor_vsync_manager.h"
 #include "ui/compositor/dip_util.h"
+#include "ui/compositor/layer_animator_collection.h"
 #include "ui/display/display.h"
 #include "ui/display/screen.h"
 #include "ui/events/blink/blink_event_util.h"
@@ -371,6 +373,7 @@ RenderWidgetHostViewAura::RenderWidgetHostViewAura(RenderWidgetHost* host,
       has_composition_text_(false),
       begin_frame_source_(nullptr),
       needs_begin_frames_(false),
+      begin_frame_target_rate_(0),
       needs_flush_input_(false),
       added_frame_observer_(false),
       cursor_visibility_state_in_renderer_(UNKNOWN),
@@ -432,6 +435,16 @@ RenderWidgetHostViewAura::RenderWidgetHostViewAura(RenderWidgetHost* host,
 ////////////////////////////////////////////////////////////////////////////////
 // RenderWidgetHostViewAura, RenderWidgetHostView implementation:
 
+bool RenderWidgetHostViewAura::OnMessageReceived(const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(RenderWidgetHostViewAura, message)
+    IPC_MESSAGE_HANDLER(ViewHostMsg_SetBeginFrameTargetRate,
+                        OnSetBeginFrameTargetRate)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
 void RenderWidgetHostViewAura::InitAsChild(
     gfx::NativeView parent_view) {
   CreateAuraWindow();
@@ -1453,6 +1466,12 @@ void RenderWidgetHostViewAura::OnDisplayMetricsChanged(
     UpdateScreenInfo(window_);
     current_cursor_.SetDisplayInfo(display);
     UpdateCursorIfOverSelf();
+    if ((metrics & DISPLAY_METRIC_REFRESH_RATE) && display.refresh_rate() > 0 &&
+        window_->GetHost() && window_->GetHost()->compositor()) {
+      // The display configuration knows the rate better than the GPU does.
+      window_->GetHost()->compositor()->SetAuthoritativeVSyncInterval(
+          base::TimeDelta::FromSecondsD(1. / display.refresh_rate()));
+    }
   }
 }
 
@@ -2107,6 +2126,7 @@ void RenderWidgetHostViewAura::AddedToRootWindow() {
 #endif
 
   delegated_frame_host_->SetCompositor(window_->GetHost()->compositor());
+  UpdateCompositorTargetFrameRate();
 }
 
 void RenderWidgetHostViewAura::RemovingFromRootWindow() {
@@ -2118,6 +2138,12 @@ void RenderWidgetHostViewAura::RemovingFromRootWindow() {
   DetachFromInputMethod();
 
   window_->GetHost()->RemoveObserver(this);
+  ui::Compositor* compositor = window_->GetHost()->compositor();
+  if (compositor) {
+    compositor->vsync_manager()->RemoveTargetInterval(this);
+    if (begin_frame_target_rate_)
+      compositor->layer_animator_collection()->SetTargetFrameRate(0);
+  }
   delegated_frame_host_->ResetCompositor();
 
 #if defined(OS_WIN)
@@ -2128,6 +2154,30 @@ void RenderWidgetHostViewAura::RemovingFromRootWindow() {
 #endif
 }
 
+void RenderWidgetHostViewAura::OnSetBeginFrameTargetRate(int fps) {
+  int target_rate =
+      fps < ui::LayerAnimatorCollection::kMaxFrameRate ? fps : 0;
+  if (target_rate == begin_frame_target_rate_)
+    return;
+  begin_frame_target_rate_ = target_rate;
+  if (window_ && window_->GetHost())
+    UpdateCompositorTargetFrameRate();
+}
+
+void RenderWidgetHostViewAura::UpdateCompositorTargetFrameRate() {
+  ui::Compositor* compositor = window_->GetHost()->compositor();
+  if (!compositor)
+    return;
+  // Other views sharing the compositor still get every vsync they need; an
+  // unthrottled view keeps the whole compositor at the display rate.
+  compositor->vsync_manager()->SetTargetInterval(
+      this, begin_frame_target_rate_
+                ? base::TimeDelta::FromSecondsD(1. / begin_frame_target_rate_)
+                : base::TimeDelta());
+  compositor->layer_animator_collection()->SetTargetFrameRate(
+      begin_frame_target_rate_);
+}
+
 void RenderWidgetHostViewAura::DetachFromInputMethod() {
   ui::InputMethod* input_method = GetInputMethod();
   if (input_method)
@@ -114,6 +114,7 @@ class CONTENT_EXPORT RenderWidgetHostViewAura
   RenderWidgetHostViewAura(RenderWidgetHost* host, bool is_guest_view_hack);
 
   // RenderWidgetHostView implementation.
+  bool OnMessageReceived(const IPC::Message& msg) override;
   void InitAsChild(gfx::NativeView parent_view) override;
   RenderWidgetHost* GetRenderWidgetHost() const override;
   void SetSize(const gfx::Size& size) override;
@@ -428,6 +429,12 @@ class CONTENT_EXPORT RenderWidgetHostViewAura
   // Called prior to removing |window_| from a WindowEventDispatcher.
   void RemovingFromRootWindow();
 
+  // Handles the renderer's throttled frame rate for the current interaction
+  // by pacing the compositor's UI animations and vsync to it.
+  void OnSetBeginFrameTargetRate(int fps);
+  // Reports the frame rate this view needs to its compositor.
+  void UpdateCompositorTargetFrameRate();
+
   // DelegatedFrameHostClient implementation.
   ui::Layer* DelegatedFrameHostGetLayer() const override;
   bool DelegatedFrameHostIsVisible() const override;
@@ -546,6 +553,9 @@ class CONTENT_EXPORT RenderWidgetHostViewAura
   // Whether a request for begin frames has been issued.
   bool needs_begin_frames_;
 
+  // The renderer's throttled frame rate, or 0 when it is not throttled.
+  int begin_frame_target_rate_;
+
   // Whether a request to flush input has been issued.
   bool needs_flush_input_;
 
@@ -227,6 +227,9 @@ class CONTENT_EXPORT RenderWidgetHostViewBase : public RenderWidgetHostView,
 
   virtual void DidStopFlinging() {}
 
+  // Called when the page starts or stops playing sound the user can hear.
+  virtual void SetAudible(bool audible) {}
+
   // Returns the compositing surface ID namespace, or 0 if Surfaces are not
   // enabled.
   virtual cc::FrameSinkId GetFrameSinkId();
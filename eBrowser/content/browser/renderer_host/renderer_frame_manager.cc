@@ -7,19 +7,23 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/logging.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/memory/memory_pressure_monitor.h"
 #include "base/memory/shared_memory.h"
+#include "base/power_monitor/power_monitor.h"
 #include "base/sys_info.h"
 #include "build/build_config.h"
 #include "content/common/host_shared_bitmap_manager.h"
+#include "content/public/common/content_switches.h"
 
 namespace content {
 namespace {
 
 const int kModeratePressurePercentage = 50;
 const int kCriticalPressurePercentage = 10;
+const int kBatteryPercentage = 50;
 
 }  // namespace
 
@@ -72,10 +76,11 @@ void RendererFrameManager::UnlockFrame(RendererFrameManagerClient* frame) {
 }
 
 size_t RendererFrameManager::GetMaxNumberOfSavedFrames() const {
+  size_t max_number_of_saved_frames = GetSavedFrameBudget();
   base::MemoryPressureMonitor* monitor = base::MemoryPressureMonitor::Get();
 
   if (!monitor)
-    return max_number_of_saved_frames_;
+    return max_number_of_saved_frames;
 
   // Until we have a global OnMemoryPressureChanged event we need to query the
   // value from our specific pressure monitor.
@@ -91,14 +96,48 @@ size_t RendererFrameManager::GetMaxNumberOfSavedFrames() const {
       percentage = kCriticalPressurePercentage;
       break;
   }
-  size_t frames = (max_number_of_saved_frames_ * percentage) / 100;
+  size_t frames = (max_number_of_saved_frames * percentage) / 100;
   return std::max(static_cast<size_t>(1), frames);
 }
 
+size_t RendererFrameManager::GetSavedFrameBudget() const {
+  if (!adaptive_eviction_)
+    return max_number_of_saved_frames_;
+
+  // Keep only the frames in use, which cannot be evicted anyway.
+  if (foreground_interaction_throttled_)
+    return 1;
+
+  if (on_battery_power_) {
+    return std::max(static_cast<size_t>(1),
+                    (max_number_of_saved_frames_ * kBatteryPercentage) / 100);
+  }
+  return max_number_of_saved_frames_;
+}
+
+void RendererFrameManager::SetForegroundInteractionThrottled(bool throttled) {
+  if (foreground_interaction_throttled_ == throttled)
+    return;
+  foreground_interaction_throttled_ = throttled;
+  if (adaptive_eviction_)
+    CullUnlockedFrames(GetMaxNumberOfSavedFrames());
+}
+
+void RendererFrameManager::OnPowerStateChange(bool on_battery_power) {
+  on_battery_power_ = on_battery_power;
+  if (adaptive_eviction_)
+    CullUnlockedFrames(GetMaxNumberOfSavedFrames());
+}
+
 RendererFrameManager::RendererFrameManager()
     : memory_pressure_listener_(
         base::Bind(&RendererFrameManager::OnMemoryPressure,
-                   base::Unretained(this))) {
+                   base::Unretained(this))),
+      adaptive_eviction_(base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEBrowserAdaptiveFrameEviction)),
+      observing_power_state_(false),
+      on_battery_power_(false),
+      foreground_interaction_throttled_(false) {
   // Note: With the destruction of this class the |memory_pressure_listener_|
   // gets destroyed and the observer will remove itself.
   max_number_of_saved_frames_ =
@@ -110,9 +149,20 @@ RendererFrameManager::RendererFrameManager()
       std::min(5, 2 + (base::SysInfo::AmountOfPhysicalMemoryMB() / 256));
 #endif
   max_handles_ = base::SharedMemory::GetHandleLimit() / 8.0f;
+
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  if (adaptive_eviction_ && power_monitor) {
+    power_monitor->AddObserver(this);
+    observing_power_state_ = true;
+    on_battery_power_ = power_monitor->IsOnBatteryPower();
+  }
 }
 
-RendererFrameManager::~RendererFrameManager() {}
+RendererFrameManager::~RendererFrameManager() {
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  if (observing_power_state_ && power_monitor)
+    power_monitor->RemoveObserver(this);
+}
 
 void RendererFrameManager::CullUnlockedFrames(size_t saved_frame_limit) {
   if (unlocked_frames_.size() + locked_frames_.size() > 0) {
@@ -136,7 +186,7 @@ void RendererFrameManager::CullUnlockedFrames(size_t saved_frame_limit) {
 
 void RendererFrameManager::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
-  int saved_frame_limit = max_number_of_saved_frames_;
+  int saved_frame_limit = GetSavedFrameBudget();
   if (saved_frame_limit <= 1)
     return;
   int percentage = 100;
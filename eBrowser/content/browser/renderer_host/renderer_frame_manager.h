@@ -13,6 +13,7 @@
 #include "base/macros.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/memory/singleton.h"
+#include "base/power_monitor/power_observer.h"
 #include "content/common/content_export.h"
 
 namespace content {
@@ -31,7 +32,11 @@ class CONTENT_EXPORT RendererFrameManagerClient {
 // between a small set of tabs faster. The limit is a soft limit, because
 // clients can lock their frame to prevent it from being discarded, e.g. if the
 // tab is visible, or while capturing a screenshot.
-class CONTENT_EXPORT RendererFrameManager {
+//
+// With --ebrowser-adaptive-frame-eviction, fewer frames are kept on battery
+// power, and only locked ones while the foreground page runs a throttled
+// interaction, so that its compositor keeps the GPU memory.
+class CONTENT_EXPORT RendererFrameManager : public base::PowerObserver {
  public:
   static RendererFrameManager* GetInstance();
 
@@ -42,6 +47,13 @@ class CONTENT_EXPORT RendererFrameManager {
 
   size_t GetMaxNumberOfSavedFrames() const;
 
+  // Called when the frame rate of the foreground page's interaction is
+  // throttled, or no longer is.
+  void SetForegroundInteractionThrottled(bool throttled);
+
+  // base::PowerObserver implementation.
+  void OnPowerStateChange(bool on_battery_power) override;
+
   // For testing only
   void set_max_number_of_saved_frames(size_t max_number_of_saved_frames) {
     max_number_of_saved_frames_ = max_number_of_saved_frames;
@@ -53,9 +65,13 @@ class CONTENT_EXPORT RendererFrameManager {
   friend class RenderWidgetHostViewAuraTest;
 
   RendererFrameManager();
-  ~RendererFrameManager();
+  ~RendererFrameManager() override;
   void CullUnlockedFrames(size_t saved_frame_limit);
 
+  // Returns the number of saved frames for the power and interaction state,
+  // before memory pressure is taken into account.
+  size_t GetSavedFrameBudget() const;
+
   // React on memory pressure events to adjust the number of cached frames.
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
@@ -71,6 +87,11 @@ class CONTENT_EXPORT RendererFrameManager {
   size_t max_number_of_saved_frames_;
   float max_handles_;
 
+  bool adaptive_eviction_;
+  bool observing_power_state_;
+  bool on_battery_power_;
+  bool foreground_interaction_throttled_;
+
   DISALLOW_COPY_AND_ASSIGN(RendererFrameManager);
 };
 
@@ -0,0 +1,106 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+cr.define('frameLatency', function() {
+  'use strict';
+
+  /** How often the page polls for new frames, in milliseconds. */
+  var POLL_INTERVAL_MS = 500;
+
+  /** The stages of a frame, in the order it goes through them. */
+  var STAGES = ['input', 'pacing', 'handling', 'raster', 'submit', 'gpuSwap',
+                'present', 'total'];
+
+  var paused = false;
+
+  function formatMs(value) {
+    return value === undefined ? '' : value.toFixed(2);
+  }
+
+  function percentile(values, p) {
+    if (!values.length)
+      return undefined;
+    var sorted = values.slice().sort(function(a, b) { return a - b; });
+    return sorted[Math.min(sorted.length - 1,
+                           Math.floor(sorted.length * p))];
+  }
+
+  function renderSummary(frames) {
+    var totals = [];
+    for (var i = 0; i < frames.length; i++) {
+      if (frames[i].total !== undefined)
+        totals.push(frames[i].total);
+    }
+    $('summary').textContent = frames.length + ' frames, total p50 ' +
+        formatMs(percentile(totals, 0.5)) + ' ms, p95 ' +
+        formatMs(percentile(totals, 0.95)) + ' ms, p99 ' +
+        formatMs(percentile(totals, 0.99)) + ' ms';
+  }
+
+  function renderFrames(frames) {
+    var tbody = $('frames').querySelector('tbody');
+    tbody.textContent = '';
+    for (var i = frames.length - 1; i >= 0; i--) {
+      var frame = frames[i];
+      var row = document.createElement('tr');
+      var cells = [formatMs(frame.presentTime), frame.targetFps,
+                   frame.handledOn];
+      for (var j = 0; j < STAGES.length; j++)
+        cells.push(formatMs(frame[STAGES[j]]));
+      for (var j = 0; j < cells.length; j++) {
+        var cell = document.createElement('td');
+        cell.textContent = cells[j];
+        row.appendChild(cell);
+      }
+      if (frame.targetFps > 0 && frame.total > 3000 / frame.targetFps)
+        row.className = 'slow';
+      tbody.appendChild(row);
+    }
+  }
+
+  function render(data) {
+    renderSummary(data.frames);
+    renderFrames(data.frames);
+    $('export').href = 'data:application/json,' +
+        encodeURIComponent(JSON.stringify(data));
+  }
+
+  function request(path, callback) {
+    var xhr = new XMLHttpRequest();
+    xhr.open('GET', path);
+    xhr.addEventListener('load', function(e) {
+      if (xhr.status === 200) {
+        try {
+          callback(JSON.parse(xhr.responseText));
+        } catch (e) {
+          $('summary').textContent = 'Could not parse the frame data.';
+        }
+      }
+    });
+    xhr.send();
+  }
+
+  function poll() {
+    if (!paused)
+      request('frame-latency-data.json', render);
+    setTimeout(poll, POLL_INTERVAL_MS);
+  }
+
+  function initialize() {
+    $('pause').addEventListener('click', function() {
+      paused = !paused;
+      $('pause').textContent = paused ? 'Resume' : 'Pause';
+    });
+    $('clear').addEventListener('click', function() {
+      request('frame-latency-clear.json', render);
+    });
+    poll();
+  }
+
+  return {
+    initialize: initialize
+  };
+});
+
+document.addEventListener('DOMContentLoaded', frameLatency.initialize);
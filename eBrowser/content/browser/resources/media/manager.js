@@ -158,7 +158,8 @@ var Manager = (function() {
       }
 
       // The keys of each device to be shown in order of appearance.
-      var videoCaptureDeviceKeys = ['name','formats','captureApi','id'];
+      var videoCaptureDeviceKeys =
+          ['name','formats','captureApi','powerSaving','id'];
 
       this.clientRenderer_.redrawVideoCaptureCapabilities(
           videoCaptureCapabilities, videoCaptureDeviceKeys);
@@ -381,6 +381,18 @@ void ServiceWorkerMetrics::RecordStartWorkerTime(base::TimeDelta time,
   }
 }
 
+void ServiceWorkerMetrics::RecordScriptPreloadStartWorkerTime(
+    base::TimeDelta time,
+    bool all_preloaded,
+    StartSituation start_situation) {
+  std::string name = all_preloaded
+                         ? "ServiceWorker.ScriptPreload.StartWorker.Time_Warm"
+                         : "ServiceWorker.ScriptPreload.StartWorker.Time_Cold";
+  RecordSuffixedMediumTimeHistogram(name, "", time);
+  RecordSuffixedMediumTimeHistogram(
+      name, StartSituationToSuffix(start_situation), time);
+}
+
 void ServiceWorkerMetrics::RecordActivatedWorkerPreparationTimeForMainFrame(
     base::TimeDelta time,
     EmbeddedWorkerStatus initial_worker_status,
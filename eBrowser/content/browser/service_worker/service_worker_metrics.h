@@ -188,6 +188,14 @@ class ServiceWorkerMetrics {
                                     StartSituation start_situation,
                                     EventType purpose);
 
+  // Records the time taken to successfully start an installed worker whose
+  // scripts were preloaded. |all_preloaded| is whether every script it read
+  // came from memory (a warm start) rather than the disk cache (a cold one).
+  static void RecordScriptPreloadStartWorkerTime(
+      base::TimeDelta time,
+      bool all_preloaded,
+      StartSituation start_situation);
+
   // Records the time taken to prepare an activated Service Worker for a main
   // frame fetch.
   static void RecordActivatedWorkerPreparationTimeForMainFrame(
@@ -4,6 +4,9 @@
 
 #include "content/browser/service_worker/service_worker_read_from_cache_job.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -51,6 +54,7 @@ void ServiceWorkerReadFromCacheJob::Kill() {
   weak_factory_.InvalidateWeakPtrs();
   has_been_killed_ = true;
   reader_.reset();
+  preloaded_script_ = nullptr;
   context_.reset();
   http_info_io_buffer_ = nullptr;
   http_info_.reset();
@@ -107,6 +111,8 @@ void ServiceWorkerReadFromCacheJob::SetExtraRequestHeaders(
 int ServiceWorkerReadFromCacheJob::ReadRawData(net::IOBuffer* buf,
                                                int buf_size) {
   DCHECK_NE(buf_size, 0);
+  if (preloaded_script_)
+    return ReadPreloadedData(buf, buf_size);
   DCHECK(!reader_->IsReadPending());
   TRACE_EVENT_ASYNC_BEGIN1("ServiceWorker",
                            "ServiceWorkerReadFromCacheJob::ReadRawData",
@@ -129,10 +135,27 @@ void ServiceWorkerReadFromCacheJob::StartAsync() {
     return;
   }
 
-  // Create a response reader and start reading the headers,
-  // we'll continue when thats done.
   if (is_main_script())
     version_->embedded_worker()->OnScriptReadStarted();
+
+  // Use the copy read ahead when the worker started; ranges are rare enough
+  // for scripts that they go to disk.
+  if (!is_range_request()) {
+    preloaded_script_ =
+        version_->script_cache_map()->TakePreloadedScript(request_->url());
+  }
+  if (preloaded_script_) {
+    preloaded_script_->WaitForCompletion(
+        base::Bind(&ServiceWorkerReadFromCacheJob::OnPreloadComplete,
+                   weak_factory_.GetWeakPtr()));
+    return;
+  }
+  ReadInfoFromDisk();
+}
+
+void ServiceWorkerReadFromCacheJob::ReadInfoFromDisk() {
+  // Create a response reader and start reading the headers,
+  // we'll continue when thats done.
   reader_ = context_->storage()->CreateResponseReader(resource_id_);
   http_info_io_buffer_ = new HttpResponseInfoIOBuffer;
   reader_->ReadInfo(
@@ -164,6 +187,26 @@ void ServiceWorkerReadFromCacheJob::OnReadInfoComplete(int result) {
   if (is_range_request())
     SetupRangeResponse(http_info_io_buffer_->response_data_size);
   http_info_io_buffer_ = nullptr;
+  DidReadInfo(result);
+}
+
+void ServiceWorkerReadFromCacheJob::OnPreloadComplete() {
+  if (preloaded_script_->result() != net::OK) {
+    // Try the disk once more; it reports the error if it persists.
+    preloaded_script_ = nullptr;
+    if (!context_) {
+      NotifyStartError(net::URLRequestStatus(net::URLRequestStatus::FAILED,
+                                             net::ERR_FAILED));
+      return;
+    }
+    ReadInfoFromDisk();
+    return;
+  }
+  http_info_.reset(new net::HttpResponseInfo(*preloaded_script_->http_info()));
+  DidReadInfo(net::OK);
+}
+
+void ServiceWorkerReadFromCacheJob::DidReadInfo(int result) {
   if (is_main_script()) {
     // TODO(nhiroki): Temporary check for debugging (https://crbug.com/485900).
     CHECK_EQ(request_->url(), version_->script_url());
@@ -214,6 +257,21 @@ void ServiceWorkerReadFromCacheJob::Done(const net::URLRequestStatus& status) {
     version_->embedded_worker()->OnScriptReadFinished();
 }
 
+int ServiceWorkerReadFromCacheJob::ReadPreloadedData(net::IOBuffer* buf,
+                                                     int buf_size) {
+  int bytes = std::min(buf_size,
+                       preloaded_script_->data_size() - preloaded_offset_);
+  if (bytes > 0) {
+    memcpy(buf->data(), preloaded_script_->data()->data() + preloaded_offset_,
+           bytes);
+    preloaded_offset_ += bytes;
+  } else {
+    Done(net::URLRequestStatus());
+  }
+  ServiceWorkerMetrics::CountReadResponseResult(ServiceWorkerMetrics::READ_OK);
+  return bytes;
+}
+
 void ServiceWorkerReadFromCacheJob::OnReadComplete(int result) {
   ServiceWorkerMetrics::ReadResponseResult check_result;
 
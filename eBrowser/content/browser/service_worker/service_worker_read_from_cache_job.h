@@ -13,6 +13,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "content/browser/service_worker/service_worker_disk_cache.h"
+#include "content/browser/service_worker/service_worker_script_cache_map.h"
 #include "content/common/content_export.h"
 #include "content/public/common/resource_type.h"
 #include "net/http/http_byte_range.h"
@@ -26,7 +27,8 @@ class ServiceWorkerVersion;
 
 // A URLRequestJob derivative used to retrieve script resources
 // from the service workers script cache. It uses a response reader
-// and pipes the response to the consumer of this url request job.
+// and pipes the response to the consumer of this url request job,
+// or serves the copy the script cache map preloaded if there is one.
 class CONTENT_EXPORT ServiceWorkerReadFromCacheJob
     : public net::URLRequestJob {
  public:
@@ -60,9 +62,13 @@ class CONTENT_EXPORT ServiceWorkerReadFromCacheJob
   // Reader completion callbacks.
   void OnReadInfoComplete(int result);
   void OnReadComplete(int result);
+  void OnPreloadComplete();
 
   // Helpers
   void StartAsync();
+  void ReadInfoFromDisk();
+  void DidReadInfo(int result);
+  int ReadPreloadedData(net::IOBuffer* buf, int buf_size);
   const net::HttpResponseInfo* http_info() const;
   bool is_range_request() const { return range_requested_.IsValid(); }
   void SetupRangeResponse(int response_data_size);
@@ -74,6 +80,8 @@ class CONTENT_EXPORT ServiceWorkerReadFromCacheJob
   base::WeakPtr<ServiceWorkerContextCore> context_;
   scoped_refptr<ServiceWorkerVersion> version_;
   std::unique_ptr<ServiceWorkerResponseReader> reader_;
+  scoped_refptr<ServiceWorkerScriptCacheMap::PreloadedScript> preloaded_script_;
+  int preloaded_offset_ = 0;
   scoped_refptr<HttpResponseInfoIOBuffer> http_info_io_buffer_;
   std::unique_ptr<net::HttpResponseInfo> http_info_;
   net::HttpByteRange range_requested_;
@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -227,6 +228,34 @@ TEST_P(ServiceWorkerReadFromCacheJobTestP, ReadImportedScript) {
             DeduceStartWorkerFailureReason(SERVICE_WORKER_OK));
 }
 
+TEST_P(ServiceWorkerReadFromCacheJobTestP, ReadPreloadedScript) {
+  ServiceWorkerScriptCacheMap* script_cache_map = version_->script_cache_map();
+  script_cache_map->PreloadScripts(kResourceSize);
+  base::RunLoop().RunUntilIdle();
+
+  // Read the imported script from memory.
+  std::unique_ptr<net::URLRequest> request =
+      url_request_context_->CreateRequest(imported_script_.url,
+                                          net::DEFAULT_PRIORITY, &delegate_);
+  test_job_interceptor_->set_main_intercept_job(
+      base::MakeUnique<ServiceWorkerReadFromCacheJob>(
+          request.get(), nullptr /* NetworkDelegate */, RESOURCE_TYPE_SCRIPT,
+          context()->AsWeakPtr(), version_, imported_script_.resource_id));
+  StartAndWaitForRequest(request.get());
+
+  EXPECT_EQ(net::URLRequestStatus::SUCCESS, request->status().status());
+  EXPECT_EQ(std::string("Hello", arraysize("Hello")),
+            delegate_.response_data());
+  EXPECT_TRUE(script_cache_map->served_all_from_preload());
+
+  // Only the imported script fit in the budget, so the main script misses.
+  EXPECT_FALSE(script_cache_map->TakePreloadedScript(main_script_.url));
+  EXPECT_FALSE(script_cache_map->served_all_from_preload());
+
+  script_cache_map->ClearPreloadedScripts();
+  EXPECT_FALSE(script_cache_map->is_preloading());
+}
+
 TEST_P(ServiceWorkerReadFromCacheJobTestP, ResourceNotFound) {
   ASSERT_EQ(SERVICE_WORKER_OK, FindRegistration());
 
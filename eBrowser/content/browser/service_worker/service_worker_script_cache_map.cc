@@ -4,6 +4,7 @@
 
 #include "content/browser/service_worker/service_worker_script_cache_map.h"
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "content/browser/service_worker/service_worker_context_core.h"
 #include "content/browser/service_worker/service_worker_disk_cache.h"
@@ -15,6 +16,88 @@
 
 namespace content {
 
+ServiceWorkerScriptCacheMap::PreloadedScript::PreloadedScript(
+    std::unique_ptr<ServiceWorkerResponseReader> reader)
+    : reader_(std::move(reader)), weak_factory_(this) {}
+
+ServiceWorkerScriptCacheMap::PreloadedScript::~PreloadedScript() {}
+
+const net::HttpResponseInfo*
+ServiceWorkerScriptCacheMap::PreloadedScript::http_info() const {
+  if (!complete_ || result_ != net::OK)
+    return nullptr;
+  return info_buffer_->http_info.get();
+}
+
+void ServiceWorkerScriptCacheMap::PreloadedScript::WaitForCompletion(
+    const base::Closure& callback) {
+  if (complete_) {
+    callback.Run();
+    return;
+  }
+  callbacks_.push_back(callback);
+}
+
+void ServiceWorkerScriptCacheMap::PreloadedScript::Start() {
+  info_buffer_ = new HttpResponseInfoIOBuffer;
+  reader_->ReadInfo(info_buffer_.get(),
+                    base::Bind(&PreloadedScript::OnReadInfoComplete,
+                               weak_factory_.GetWeakPtr()));
+}
+
+void ServiceWorkerScriptCacheMap::PreloadedScript::OnReadInfoComplete(
+    int result) {
+  if (!info_buffer_->http_info) {
+    DCHECK_LT(result, 0);
+    Complete(result);
+    return;
+  }
+  if (info_buffer_->response_data_size <= 0) {
+    Complete(net::OK);
+    return;
+  }
+  data_ = new net::IOBufferWithSize(info_buffer_->response_data_size);
+  pending_data_ = new net::DrainableIOBuffer(data_.get(), data_->size());
+  ReadSome();
+}
+
+void ServiceWorkerScriptCacheMap::PreloadedScript::ReadSome() {
+  reader_->ReadData(pending_data_.get(), pending_data_->BytesRemaining(),
+                    base::Bind(&PreloadedScript::OnReadDataComplete,
+                               weak_factory_.GetWeakPtr()));
+}
+
+void ServiceWorkerScriptCacheMap::PreloadedScript::OnReadDataComplete(
+    int result) {
+  if (result < 0) {
+    Complete(result);
+    return;
+  }
+  pending_data_->DidConsume(result);
+  data_size_ = pending_data_->BytesConsumed();
+  if (result > 0 && pending_data_->BytesRemaining() > 0) {
+    ReadSome();
+    return;
+  }
+  Complete(net::OK);
+}
+
+void ServiceWorkerScriptCacheMap::PreloadedScript::Complete(int result) {
+  DCHECK(!complete_);
+  complete_ = true;
+  result_ = result;
+  reader_.reset();
+  pending_data_ = nullptr;
+  if (result != net::OK) {
+    data_ = nullptr;
+    data_size_ = 0;
+  }
+  std::vector<base::Closure> callbacks;
+  callbacks.swap(callbacks_);
+  for (const base::Closure& callback : callbacks)
+    callback.Run();
+}
+
 ServiceWorkerScriptCacheMap::ServiceWorkerScriptCacheMap(
     ServiceWorkerVersion* owner,
     base::WeakPtr<ServiceWorkerContextCore> context)
@@ -88,6 +171,46 @@ void ServiceWorkerScriptCacheMap::SetResources(
   }
 }
 
+void ServiceWorkerScriptCacheMap::PreloadScripts(int64_t max_bytes) {
+  ClearPreloadedScripts();
+  if (!context_)
+    return;
+  preloading_ = true;
+  preload_misses_ = 0;
+  int64_t total_bytes = 0;
+  for (const auto& resource : resource_map_) {
+    const ServiceWorkerDatabase::ResourceRecord& record = resource.second;
+    if (record.resource_id == kInvalidServiceWorkerResourceId ||
+        record.size_bytes < 0 || total_bytes + record.size_bytes > max_bytes) {
+      continue;
+    }
+    total_bytes += record.size_bytes;
+    scoped_refptr<PreloadedScript> script(new PreloadedScript(
+        context_->storage()->CreateResponseReader(record.resource_id)));
+    preloaded_scripts_[resource.first] = script;
+    script->Start();
+  }
+}
+
+scoped_refptr<ServiceWorkerScriptCacheMap::PreloadedScript>
+ServiceWorkerScriptCacheMap::TakePreloadedScript(const GURL& url) {
+  PreloadMap::iterator found = preloaded_scripts_.find(url);
+  if (found == preloaded_scripts_.end()) {
+    if (preloading_)
+      ++preload_misses_;
+    return nullptr;
+  }
+  scoped_refptr<PreloadedScript> script = found->second;
+  preloaded_scripts_.erase(found);
+  return script;
+}
+
+void ServiceWorkerScriptCacheMap::ClearPreloadedScripts() {
+  preloaded_scripts_.clear();
+  preloading_ = false;
+  preload_misses_ = 0;
+}
+
 void ServiceWorkerScriptCacheMap::WriteMetadata(
     const GURL& url,
     const std::vector<char>& data,
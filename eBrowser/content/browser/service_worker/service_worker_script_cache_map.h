@@ -9,27 +9,83 @@
 #include <stdint.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "content/browser/service_worker/service_worker_database.h"
 #include "content/common/content_export.h"
 #include "net/base/completion_callback.h"
+#include "net/base/net_errors.h"
 #include "net/url_request/url_request_status.h"
 
 class GURL;
 
+namespace net {
+class DrainableIOBuffer;
+class HttpResponseInfo;
+class IOBufferWithSize;
+}
+
 namespace content {
 
 class ServiceWorkerContextCore;
 class ServiceWorkerVersion;
 class ServiceWorkerResponseMetadataWriter;
+class ServiceWorkerResponseReader;
+struct HttpResponseInfoIOBuffer;
 
 // Class that maintains the mapping between urls and a resource id
 // for a particular version's implicit script resources.
 class CONTENT_EXPORT ServiceWorkerScriptCacheMap {
  public:
+  // A script read from the disk cache into memory ahead of the worker
+  // requesting it, so that its read job can serve it without waiting on disk.
+  class CONTENT_EXPORT PreloadedScript
+      : public base::RefCounted<PreloadedScript> {
+   public:
+    bool is_complete() const { return complete_; }
+    // The net error the reads failed with, or net::OK.
+    int result() const { return result_; }
+    // Valid once the reads have completed successfully.
+    const net::HttpResponseInfo* http_info() const;
+    net::IOBufferWithSize* data() const { return data_.get(); }
+    int data_size() const { return data_size_; }
+
+    // Runs |callback| once the reads have finished, right away if they have.
+    void WaitForCompletion(const base::Closure& callback);
+
+   private:
+    friend class base::RefCounted<PreloadedScript>;
+    friend class ServiceWorkerScriptCacheMap;
+
+    explicit PreloadedScript(
+        std::unique_ptr<ServiceWorkerResponseReader> reader);
+    ~PreloadedScript();
+
+    void Start();
+    void OnReadInfoComplete(int result);
+    void ReadSome();
+    void OnReadDataComplete(int result);
+    void Complete(int result);
+
+    std::unique_ptr<ServiceWorkerResponseReader> reader_;
+    scoped_refptr<HttpResponseInfoIOBuffer> info_buffer_;
+    scoped_refptr<net::IOBufferWithSize> data_;
+    scoped_refptr<net::DrainableIOBuffer> pending_data_;
+    int data_size_ = 0;
+    int result_ = net::OK;
+    bool complete_ = false;
+    std::vector<base::Closure> callbacks_;
+
+    base::WeakPtrFactory<PreloadedScript> weak_factory_;
+
+    DISALLOW_COPY_AND_ASSIGN(PreloadedScript);
+  };
+
   int64_t LookupResourceId(const GURL& url);
 
   // Used during the initial run of a new version to build the map
@@ -55,6 +111,27 @@ class CONTENT_EXPORT ServiceWorkerScriptCacheMap {
   // Clears the metadata of the existing script.
   void ClearMetadata(const GURL& url, const net::CompletionCallback& callback);
 
+  // Starts reading every recorded script of at most |max_bytes| into memory,
+  // all in parallel, for a worker that is about to start. Scripts of unknown
+  // size are skipped, as are any once |max_bytes| in total are in flight.
+  void PreloadScripts(int64_t max_bytes);
+
+  // Returns the preloaded copy of |url| and forgets it, or null if |url| was
+  // not preloaded. The copy may still be reading.
+  scoped_refptr<PreloadedScript> TakePreloadedScript(const GURL& url);
+
+  // Drops the preloaded copies nobody took and ends the preload, once the
+  // worker has started or failed to.
+  void ClearPreloadedScripts();
+
+  // Whether PreloadScripts was called since the last ClearPreloadedScripts.
+  bool is_preloading() const { return preloading_; }
+
+  // Whether every script asked for since PreloadScripts was in memory.
+  bool served_all_from_preload() const {
+    return preloading_ && preload_misses_ == 0;
+  }
+
   size_t size() const { return resource_map_.size(); }
 
   const net::URLRequestStatus& main_script_status() const {
@@ -67,6 +144,7 @@ class CONTENT_EXPORT ServiceWorkerScriptCacheMap {
 
  private:
   typedef std::map<GURL, ServiceWorkerDatabase::ResourceRecord> ResourceMap;
+  typedef std::map<GURL, scoped_refptr<PreloadedScript>> PreloadMap;
 
   // The version objects owns its script cache and provides a rawptr to it.
   friend class ServiceWorkerVersion;
@@ -83,6 +161,9 @@ class CONTENT_EXPORT ServiceWorkerScriptCacheMap {
   ServiceWorkerVersion* owner_;
   base::WeakPtr<ServiceWorkerContextCore> context_;
   ResourceMap resource_map_;
+  PreloadMap preloaded_scripts_;
+  bool preloading_ = false;
+  int preload_misses_ = 0;
   net::URLRequestStatus main_script_status_;
   std::string main_script_status_message_;
 
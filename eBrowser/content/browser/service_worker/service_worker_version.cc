@@ -19,6 +19,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
@@ -73,6 +74,23 @@ const char kClaimClientsShutdownErrorMesage[] =
 
 const char kNotRespondingErrorMesage[] = "Service Worker is not responding.";
 
+// Returns how many bytes of scripts to preload when an installed worker
+// starts, 0 when preloading is off.
+int64_t GetScriptPreloadBytes() {
+  static int64_t preload_bytes = -1;
+  if (preload_bytes < 0) {
+    unsigned preload_kb = 0;
+    if (!base::StringToUint(
+            base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+                switches::kEBrowserServiceWorkerScriptPreload),
+            &preload_kb)) {
+      preload_kb = 0;
+    }
+    preload_bytes = static_cast<int64_t>(preload_kb) * 1024;
+  }
+  return preload_bytes;
+}
+
 void RunSoon(const base::Closure& callback) {
   if (!callback.is_null())
     base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, callback);
@@ -1481,6 +1499,11 @@ void ServiceWorkerVersion::StartWorkerInternal() {
   params->is_installed = IsInstalled(status_);
   params->pause_after_download = pause_after_download_;
 
+  // Installed versions have all their scripts recorded, so they can all be
+  // read at once instead of as the worker asks for each.
+  if (params->is_installed && GetScriptPreloadBytes() > 0)
+    script_cache_map_.PreloadScripts(GetScriptPreloadBytes());
+
   embedded_worker_->Start(
       std::move(params),
       base::Bind(&ServiceWorkerVersion::OnStartSentAndScriptEvaluated,
@@ -1681,6 +1704,13 @@ void ServiceWorkerVersion::RecordStartWorkerResult(
         ServiceWorkerMetrics::GetStartSituation(
             is_browser_startup_complete, embedded_worker_->is_new_process()),
         purpose);
+    if (script_cache_map_.is_preloading()) {
+      ServiceWorkerMetrics::RecordScriptPreloadStartWorkerTime(
+          GetTickDuration(start_time),
+          script_cache_map_.served_all_from_preload(),
+          ServiceWorkerMetrics::GetStartSituation(
+              is_browser_startup_complete, embedded_worker_->is_new_process()));
+    }
   }
 
   if (status != SERVICE_WORKER_ERROR_TIMEOUT)
@@ -1869,6 +1899,8 @@ void ServiceWorkerVersion::OnBeginEvent() {
 void ServiceWorkerVersion::FinishStartWorker(ServiceWorkerStatusCode status) {
   start_worker_first_purpose_ = base::nullopt;
   RunCallbacks(this, &start_callbacks_, status);
+  // The worker has read all it is going to during startup.
+  script_cache_map_.ClearPreloadedScripts();
 }
 
 void ServiceWorkerVersion::CleanUpExternalRequest(
@@ -116,12 +116,17 @@ RenderProcessHost* SiteInstanceImpl::GetProcess() {
         process_ = g_render_process_host_factory_->CreateRenderProcessHost(
             browser_context, this);
       } else {
-        StoragePartitionImpl* partition =
-            static_cast<StoragePartitionImpl*>(
-                BrowserContext::GetStoragePartition(browser_context, this));
-        process_ = new RenderProcessHostImpl(browser_context,
-                                             partition,
-                                             site_.SchemeIs(kGuestScheme));
+        // Prefer the already launched spare renderer, if it fits.
+        process_ = RenderProcessHostImpl::TakeSpareRenderProcessHost(
+            browser_context, site_);
+        if (!process_) {
+          StoragePartitionImpl* partition =
+              static_cast<StoragePartitionImpl*>(
+                  BrowserContext::GetStoragePartition(browser_context, this));
+          process_ = new RenderProcessHostImpl(browser_context,
+                                               partition,
+                                               site_.SchemeIs(kGuestScheme));
+        }
       }
     }
     CHECK(process_);
@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/location.h"
+#include "base/logging.h"
 #include "base/message_loop/message_loop.h"
 
 namespace content {
@@ -13,23 +14,25 @@ namespace content {
 StartupTaskRunner::StartupTaskRunner(
     base::Callback<void(int)> const startup_complete_callback,
     scoped_refptr<base::SingleThreadTaskRunner> proxy)
-    : startup_complete_callback_(startup_complete_callback), proxy_(proxy) {}
+    : startup_complete_callback_(startup_complete_callback),
+      proxy_(proxy),
+      record_task_timings_(false) {}
 
 StartupTaskRunner::~StartupTaskRunner() {}
 
 void StartupTaskRunner::AddTask(StartupTask& callback) {
-  task_list_.push_back(callback);
+  AddTask("unnamed", callback);
+}
+
+void StartupTaskRunner::AddTask(const char* name, StartupTask& callback) {
+  task_list_.push_back({name, callback});
 }
 
 void StartupTaskRunner::StartRunningTasksAsync() {
   DCHECK(proxy_.get());
   int result = 0;
   if (task_list_.empty()) {
-    if (!startup_complete_callback_.is_null()) {
-      startup_complete_callback_.Run(result);
-      // Clear the callback to prevent it being called a second time
-      startup_complete_callback_.Reset();
-    }
+    StartupComplete(result);
   } else {
     const base::Closure next_task =
         base::Bind(&StartupTaskRunner::WrappedTask, base::Unretained(this));
@@ -39,18 +42,14 @@ void StartupTaskRunner::StartRunningTasksAsync() {
 
 void StartupTaskRunner::RunAllTasksNow() {
   int result = 0;
-  for (std::list<StartupTask>::iterator it = task_list_.begin();
+  for (std::list<NamedTask>::iterator it = task_list_.begin();
        it != task_list_.end();
        it++) {
-    result = it->Run();
+    result = RunTask(*it);
     if (result > 0) break;
   }
   task_list_.clear();
-  if (!startup_complete_callback_.is_null()) {
-    startup_complete_callback_.Run(result);
-    // Clear the callback to prevent it being called a second time
-    startup_complete_callback_.Reset();
-  }
+  StartupComplete(result);
 }
 
 void StartupTaskRunner::WrappedTask() {
@@ -60,18 +59,14 @@ void StartupTaskRunner::WrappedTask() {
     // so there is nothing to do
     return;
   }
-  int result = task_list_.front().Run();
+  int result = RunTask(task_list_.front());
   task_list_.pop_front();
   if (result > 0) {
     // Stop now and throw away the remaining tasks
     task_list_.clear();
   }
   if (task_list_.empty()) {
-    if (!startup_complete_callback_.is_null()) {
-      startup_complete_callback_.Run(result);
-      // Clear the callback to prevent it being called a second time
-      startup_complete_callback_.Reset();
-    }
+    StartupComplete(result);
   } else {
     const base::Closure next_task =
         base::Bind(&StartupTaskRunner::WrappedTask, base::Unretained(this));
@@ -79,4 +74,42 @@ void StartupTaskRunner::WrappedTask() {
   }
 }
 
+int StartupTaskRunner::RunTask(const NamedTask& task) {
+  if (!record_task_timings_)
+    return task.task.Run();
+
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  if (first_task_start_time_.is_null())
+    first_task_start_time_ = start_time;
+  int result = task.task.Run();
+  task_timings_.push_back({task.name, base::TimeTicks::Now() - start_time});
+  return result;
+}
+
+void StartupTaskRunner::StartupComplete(int result) {
+  if (record_task_timings_) {
+    // Report once; startup may complete again after a synchronous request.
+    record_task_timings_ = false;
+    base::TimeDelta busy_time;
+    for (const TaskTiming& timing : task_timings_) {
+      LOG(INFO) << "Startup task " << timing.name << ": "
+                << timing.duration.InMillisecondsF() << " ms";
+      busy_time += timing.duration;
+    }
+    if (!first_task_start_time_.is_null()) {
+      LOG(INFO) << "Startup tasks: " << busy_time.InMillisecondsF()
+                << " ms of "
+                << (base::TimeTicks::Now() - first_task_start_time_)
+                       .InMillisecondsF()
+                << " ms";
+    }
+  }
+
+  if (!startup_complete_callback_.is_null()) {
+    startup_complete_callback_.Run(result);
+    // Clear the callback to prevent it being called a second time
+    startup_complete_callback_.Reset();
+  }
+}
+
 }  // namespace content
@@ -6,10 +6,12 @@
 #define CONTENT_BROWSER_STARTUP_TASK_RUNNER_H_
 
 #include <list>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
 #include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 
 #include "build/build_config.h"
 
@@ -42,8 +44,10 @@ class CONTENT_EXPORT StartupTaskRunner {
 
   ~StartupTaskRunner();
 
-  // Add a task to the queue of startup tasks to be run.
+  // Add a task to the queue of startup tasks to be run. |name| identifies the
+  // task in the recorded task timings and must outlive |this|.
   void AddTask(StartupTask& callback);
+  void AddTask(const char* name, StartupTask& callback);
 
   // Start running the tasks asynchronously.
   void StartRunningTasksAsync();
@@ -51,14 +55,36 @@ class CONTENT_EXPORT StartupTaskRunner {
   // Run all tasks, or all remaining tasks, synchronously
   void RunAllTasksNow();
 
+  struct TaskTiming {
+    const char* name;
+    base::TimeDelta duration;
+  };
+
+  // When enabled, the duration of each task is recorded, and logged once
+  // startup is complete.
+  void set_record_task_timings(bool record_task_timings) {
+    record_task_timings_ = record_task_timings;
+  }
+  const std::vector<TaskTiming>& task_timings() const { return task_timings_; }
+
  private:
   friend class base::RefCounted<StartupTaskRunner>;
 
-  std::list<StartupTask> task_list_;
+  struct NamedTask {
+    const char* name;
+    StartupTask task;
+  };
+
+  std::list<NamedTask> task_list_;
   void WrappedTask();
+  int RunTask(const NamedTask& task);
+  void StartupComplete(int result);
 
   base::Callback<void(int)> startup_complete_callback_;
   scoped_refptr<base::SingleThreadTaskRunner> proxy_;
+  bool record_task_timings_;
+  std::vector<TaskTiming> task_timings_;
+  base::TimeTicks first_task_start_time_;
 
   DISALLOW_COPY_AND_ASSIGN(StartupTaskRunner);
 };
@@ -315,5 +315,33 @@ TEST_F(StartupTaskRunnerTest, AsynchronousExecutionFailedTask) {
   EXPECT_EQ(observer_calls, 1);
   EXPECT_EQ(task_count, 1);
 }
+
+TEST_F(StartupTaskRunnerTest, RecordTaskTimings) {
+  MockTaskRunner mock_runner;
+  scoped_refptr<TaskRunnerProxy> proxy = new TaskRunnerProxy(&mock_runner);
+
+  StartupTaskRunner runner(base::Bind(&Observer), proxy);
+  runner.set_record_task_timings(true);
+
+  StartupTask task1 =
+      base::Bind(&StartupTaskRunnerTest::Task1, base::Unretained(this));
+  runner.AddTask("Task1", task1);
+  StartupTask failing_task =
+      base::Bind(&StartupTaskRunnerTest::FailingTask, base::Unretained(this));
+  runner.AddTask("FailingTask", failing_task);
+  StartupTask task2 =
+      base::Bind(&StartupTaskRunnerTest::Task2, base::Unretained(this));
+  runner.AddTask("Task2", task2);
+
+  runner.RunAllTasksNow();
+
+  // Only the tasks that ran are timed.
+  ASSERT_EQ(2u, runner.task_timings().size());
+  EXPECT_STREQ("Task1", runner.task_timings()[0].name);
+  EXPECT_STREQ("FailingTask", runner.task_timings()[1].name);
+  EXPECT_GE(runner.task_timings()[0].duration, base::TimeDelta());
+  EXPECT_EQ(observer_calls, 1);
+  EXPECT_EQ(observer_result, 1);
+}
 }  // namespace
 }  // namespace content
@@ -0,0 +1,166 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/subprocess_histogram_merger.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/persistent_histogram_allocator.h"
+#include "base/metrics/persistent_memory_allocator.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_child_process_host.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/child_process_data.h"
+#include "content/public/browser/notification_service.h"
+#include "content/public/browser/notification_types.h"
+#include "content/public/browser/render_process_host.h"
+
+namespace content {
+
+namespace {
+
+// Chrome's own size for the browser's segment, which holds the browser's
+// histograms as well.
+const size_t kBrowserAllocatorMemoryBytes = 3 << 20;  // 3 MiB
+
+SubprocessHistogramMerger* g_instance = nullptr;
+
+std::unique_ptr<base::SharedPersistentMemoryAllocator>
+TakeSubprocessAllocatorOnIOThread(int id) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  // BrowserChildProcessHost::FromID() only works on the IO thread.
+  BrowserChildProcessHost* host = BrowserChildProcessHost::FromID(id);
+  if (!host)
+    return nullptr;
+  return host->TakeMetricsAllocator();
+}
+
+}  // namespace
+
+// static
+SubprocessHistogramMerger* SubprocessHistogramMerger::GetInstance() {
+  return g_instance;
+}
+
+// static
+void SubprocessHistogramMerger::CreateGlobalHistogramAllocator() {
+  if (base::GlobalHistogramAllocator::Get())
+    return;
+  base::GlobalHistogramAllocator::CreateWithLocalMemory(
+      kBrowserAllocatorMemoryBytes, 0, "BrowserMetrics");
+}
+
+SubprocessHistogramMerger::SubprocessHistogramMerger()
+    : scoped_observer_(this), weak_factory_(this) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  DCHECK(!g_instance);
+  g_instance = this;
+  BrowserChildProcessObserver::Add(this);
+  registrar_.Add(this, NOTIFICATION_RENDERER_PROCESS_CREATED,
+                 NotificationService::AllSources());
+}
+
+SubprocessHistogramMerger::~SubprocessHistogramMerger() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  BrowserChildProcessObserver::Remove(this);
+  g_instance = nullptr;
+}
+
+void SubprocessHistogramMerger::MergeHistogramDeltas() {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  TRACE_EVENT1("browser", "SubprocessHistogramMerger::MergeHistogramDeltas",
+               "subprocesses", allocators_.size());
+  for (const auto& entry : allocators_)
+    MergeHistogramDeltasFrom(entry.second.get());
+}
+
+void SubprocessHistogramMerger::RegisterSubprocessAllocator(
+    int id,
+    std::unique_ptr<base::SharedPersistentMemoryAllocator> allocator) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (!allocator)
+    return;
+  DeregisterSubprocessAllocator(id);
+  allocators_[id] = base::MakeUnique<base::PersistentHistogramAllocator>(
+      std::move(allocator));
+}
+
+void SubprocessHistogramMerger::DeregisterSubprocessAllocator(int id) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  auto it = allocators_.find(id);
+  if (it == allocators_.end())
+    return;
+  // Whatever the child recorded since the last collection is in its
+  // segment, which outlives the child.
+  MergeHistogramDeltasFrom(it->second.get());
+  allocators_.erase(it);
+}
+
+void SubprocessHistogramMerger::BrowserChildProcessLaunchedAndConnected(
+    const ChildProcessData& data) {
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&TakeSubprocessAllocatorOnIOThread, data.id),
+      base::Bind(&SubprocessHistogramMerger::RegisterSubprocessAllocator,
+                 weak_factory_.GetWeakPtr(), data.id));
+}
+
+void SubprocessHistogramMerger::BrowserChildProcessHostDisconnected(
+    const ChildProcessData& data) {
+  DeregisterSubprocessAllocator(data.id);
+}
+
+void SubprocessHistogramMerger::BrowserChildProcessCrashed(
+    const ChildProcessData& data,
+    int exit_code) {
+  DeregisterSubprocessAllocator(data.id);
+}
+
+void SubprocessHistogramMerger::BrowserChildProcessKilled(
+    const ChildProcessData& data,
+    int exit_code) {
+  DeregisterSubprocessAllocator(data.id);
+}
+
+void SubprocessHistogramMerger::Observe(int type,
+                                        const NotificationSource& source,
+                                        const NotificationDetails& details) {
+  DCHECK_EQ(NOTIFICATION_RENDERER_PROCESS_CREATED, type);
+  RenderProcessHost* host = Source<RenderProcessHost>(source).ptr();
+  // A host is created once but may launch several renderers.
+  if (!scoped_observer_.IsObserving(host))
+    scoped_observer_.Add(host);
+}
+
+void SubprocessHistogramMerger::RenderProcessReady(RenderProcessHost* host) {
+  RegisterSubprocessAllocator(host->GetID(), host->TakeMetricsAllocator());
+}
+
+void SubprocessHistogramMerger::RenderProcessExited(
+    RenderProcessHost* host,
+    base::TerminationStatus status,
+    int exit_code) {
+  DeregisterSubprocessAllocator(host->GetID());
+}
+
+void SubprocessHistogramMerger::RenderProcessHostDestroyed(
+    RenderProcessHost* host) {
+  DeregisterSubprocessAllocator(host->GetID());
+  scoped_observer_.Remove(host);
+}
+
+void SubprocessHistogramMerger::MergeHistogramDeltasFrom(
+    base::PersistentHistogramAllocator* allocator) {
+  base::PersistentHistogramAllocator::Iterator histogram_iter(allocator);
+  while (std::unique_ptr<base::HistogramBase> histogram =
+             histogram_iter.GetNext()) {
+    allocator->MergeHistogramDeltaToStatisticsRecorder(histogram.get());
+  }
+}
+
+}  // namespace content
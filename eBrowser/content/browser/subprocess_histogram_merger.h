@@ -0,0 +1,106 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_SUBPROCESS_HISTOGRAM_MERGER_H_
+#define CONTENT_BROWSER_SUBPROCESS_HISTOGRAM_MERGER_H_
+
+#include <map>
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/scoped_observer.h"
+#include "content/common/content_export.h"
+#include "content/public/browser/browser_child_process_observer.h"
+#include "content/public/browser/notification_observer.h"
+#include "content/public/browser/notification_registrar.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+namespace base {
+class PersistentHistogramAllocator;
+class SharedPersistentMemoryAllocator;
+}
+
+namespace content {
+
+class RenderProcessHost;
+
+// With --ebrowser-shared-child-histograms, the browser creates a global
+// histogram allocator, and RenderProcessHostImpl and
+// BrowserChildProcessHostImpl then give every child a shared memory segment
+// to record its histograms into. This reads those segments directly,
+// merging the children's new samples into the browser's StatisticsRecorder
+// whenever HistogramSynchronizer collects, and a final time when a child
+// goes away. Children leave persistent histograms out of their IPC uploads,
+// so they are never pickled.
+//
+// Lives on the UI thread.
+class CONTENT_EXPORT SubprocessHistogramMerger
+    : public BrowserChildProcessObserver,
+      public NotificationObserver,
+      public RenderProcessHostObserver {
+ public:
+  // Returns the merger, or null if there is none.
+  static SubprocessHistogramMerger* GetInstance();
+
+  // Creates the browser's global histogram allocator, if there is none yet,
+  // so that children are given theirs.
+  static void CreateGlobalHistogramAllocator();
+
+  SubprocessHistogramMerger();
+  ~SubprocessHistogramMerger() override;
+
+  // Merges the samples children recorded since the last call.
+  void MergeHistogramDeltas();
+
+  // Takes ownership of |allocator|, the shared memory of child |id|. A
+  // previous allocator of |id|, from before a renderer restart, is merged
+  // and dropped. Null allocators are ignored.
+  void RegisterSubprocessAllocator(
+      int id,
+      std::unique_ptr<base::SharedPersistentMemoryAllocator> allocator);
+  void DeregisterSubprocessAllocator(int id);
+
+ private:
+  // BrowserChildProcessObserver:
+  void BrowserChildProcessLaunchedAndConnected(
+      const ChildProcessData& data) override;
+  void BrowserChildProcessHostDisconnected(
+      const ChildProcessData& data) override;
+  void BrowserChildProcessCrashed(const ChildProcessData& data,
+                                  int exit_code) override;
+  void BrowserChildProcessKilled(const ChildProcessData& data,
+                                 int exit_code) override;
+
+  // NotificationObserver:
+  void Observe(int type,
+               const NotificationSource& source,
+               const NotificationDetails& details) override;
+
+  // RenderProcessHostObserver:
+  void RenderProcessReady(RenderProcessHost* host) override;
+  void RenderProcessExited(RenderProcessHost* host,
+                           base::TerminationStatus status,
+                           int exit_code) override;
+  void RenderProcessHostDestroyed(RenderProcessHost* host) override;
+
+  void MergeHistogramDeltasFrom(base::PersistentHistogramAllocator* allocator);
+
+  // Keyed by the child's unique id, which renderers and other children
+  // draw from the same sequence.
+  std::map<int, std::unique_ptr<base::PersistentHistogramAllocator>>
+      allocators_;
+
+  NotificationRegistrar registrar_;
+  ScopedObserver<RenderProcessHost, RenderProcessHostObserver>
+      scoped_observer_;
+
+  base::WeakPtrFactory<SubprocessHistogramMerger> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SubprocessHistogramMerger);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_SUBPROCESS_HISTOGRAM_MERGER_H_
@@ -35,6 +35,7 @@ class CONTENT_EXPORT BackgroundTracingConfigImpl
     BENCHMARK_MEMORY_HEAVY,
     BENCHMARK_MEMORY_LIGHT,
     BENCHMARK_EXECUTION_METRIC,
+    BENCHMARK_INPUT,
     BLINK_STYLE
   };
 
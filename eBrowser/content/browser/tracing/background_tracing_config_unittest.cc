@@ -271,6 +271,48 @@ TEST_F(BackgroundTracingConfigTest, PreemptiveConfigFromValidString) {
   EXPECT_EQ(config->scenario_name(), "my_awesome_experiment");
 }
 
+TEST_F(BackgroundTracingConfigTest, ThrottledGestureRule) {
+  std::unique_ptr<BackgroundTracingConfigImpl> config = ReadFromJSONString(
+      "{\"mode\":\"PREEMPTIVE_TRACING_MODE\", \"category\": "
+      "\"BENCHMARK_INPUT\",\"configs\": [{\"rule\": "
+      "\"MONITOR_AND_DUMP_WHEN_THROTTLED_GESTURE_SLOW\", "
+      "\"latency_threshold_ms\": 100, \"frame_gap_threshold_ms\": 50}]}");
+  ASSERT_TRUE(config);
+  EXPECT_EQ(config->category_preset(),
+            BackgroundTracingConfigImpl::BENCHMARK_INPUT);
+  ASSERT_EQ(config->rules().size(), 1u);
+  EXPECT_EQ(RuleToString(config->rules()[0]),
+            "{\"frame_gap_threshold_ms\":50,\"latency_threshold_ms\":100,"
+            "\"rule\":\"MONITOR_AND_DUMP_WHEN_THROTTLED_GESTURE_SLOW\"}");
+  EXPECT_TRUE(config->rules()[0]->ShouldTriggerNamedEvent(
+      "Event.PacedScroll.Delay"));
+  EXPECT_TRUE(config->rules()[0]->ShouldTriggerNamedEvent(
+      "Event.PacedScroll.FrameGap"));
+
+  // Either threshold alone.
+  config = ReadFromJSONString(
+      "{\"mode\":\"REACTIVE_TRACING_MODE\",\"configs\": [{\"rule\": "
+      "\"MONITOR_AND_DUMP_WHEN_THROTTLED_GESTURE_SLOW\", "
+      "\"category\": \"BENCHMARK_INPUT\", \"frame_gap_threshold_ms\": 50}]}");
+  ASSERT_TRUE(config);
+  ASSERT_EQ(config->rules().size(), 1u);
+  EXPECT_EQ(RuleToString(config->rules()[0]),
+            "{\"category\":\"BENCHMARK_INPUT\",\"frame_gap_threshold_ms\":50,"
+            "\"rule\":\"MONITOR_AND_DUMP_WHEN_THROTTLED_GESTURE_SLOW\"}");
+  EXPECT_FALSE(config->rules()[0]->ShouldTriggerNamedEvent(
+      "Event.PacedScroll.Delay"));
+
+  EXPECT_FALSE(ReadFromJSONString(
+      "{\"mode\":\"PREEMPTIVE_TRACING_MODE\", \"category\": "
+      "\"BENCHMARK_INPUT\",\"configs\": [{\"rule\": "
+      "\"MONITOR_AND_DUMP_WHEN_THROTTLED_GESTURE_SLOW\"}]}"));
+  EXPECT_FALSE(ReadFromJSONString(
+      "{\"mode\":\"PREEMPTIVE_TRACING_MODE\", \"category\": "
+      "\"BENCHMARK_INPUT\",\"configs\": [{\"rule\": "
+      "\"MONITOR_AND_DUMP_WHEN_THROTTLED_GESTURE_SLOW\", "
+      "\"latency_threshold_ms\": 0}]}"));
+}
+
 TEST_F(BackgroundTracingConfigTest, ValidPreemptiveCategoryToString) {
   std::unique_ptr<BackgroundTracingConfigImpl> config = ReadFromJSONString(
       "{\"mode\":\"PREEMPTIVE_TRACING_MODE\", \"category\": "
@@ -287,6 +329,7 @@ TEST_F(BackgroundTracingConfigTest, ValidPreemptiveCategoryToString) {
       BackgroundTracingConfigImpl::BENCHMARK_MEMORY_HEAVY,
       BackgroundTracingConfigImpl::BENCHMARK_MEMORY_LIGHT,
       BackgroundTracingConfigImpl::BENCHMARK_EXECUTION_METRIC,
+      BackgroundTracingConfigImpl::BENCHMARK_INPUT,
       BackgroundTracingConfigImpl::BLINK_STYLE,
   };
 
@@ -299,6 +342,7 @@ TEST_F(BackgroundTracingConfigTest, ValidPreemptiveCategoryToString) {
                                     "BENCHMARK_MEMORY_HEAVY",
                                     "BENCHMARK_MEMORY_LIGHT",
                                     "BENCHMARK_EXECUTION_METRIC",
+                                    "BENCHMARK_INPUT",
                                     "BLINK_STYLE"};
   for (size_t i = 0;
        i <
@@ -564,6 +564,9 @@ BackgroundTracingManagerImpl::GetCategoryFilterStringForCategoryPreset(
     case BackgroundTracingConfigImpl::CategoryPreset::
         BENCHMARK_EXECUTION_METRIC:
       return "blink.console,v8";
+    case BackgroundTracingConfigImpl::CategoryPreset::BENCHMARK_INPUT:
+      // "input" carries the eBrowser rate controller's counters.
+      return "benchmark,toplevel,input,cc,gpu";
     case BackgroundTracingConfigImpl::CategoryPreset::BLINK_STYLE:
       return "blink_style";
     case BackgroundTracingConfigImpl::CategoryPreset::CATEGORY_PRESET_UNSET:
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 #include "content/browser/tracing/background_tracing_rule.h"
 
+#include <limits>
 #include <string>
 
 #include "base/bind.h"
@@ -32,6 +33,9 @@ const char kConfigRuleHistogramValue1Key[] = "histogram_lower_value";
 const char kConfigRuleHistogramValue2Key[] = "histogram_upper_value";
 const char kConfigRuleHistogramRepeatKey[] = "histogram_repeat";
 
+const char kConfigRuleThrottledGestureLatencyKey[] = "latency_threshold_ms";
+const char kConfigRuleThrottledGestureFrameGapKey[] = "frame_gap_threshold_ms";
+
 const char kConfigRuleRandomIntervalTimeoutMin[] = "timeout_min";
 const char kConfigRuleRandomIntervalTimeoutMax[] = "timeout_max";
 
@@ -41,12 +45,20 @@ const char kConfigRuleTypeMonitorNamed[] =
 const char kConfigRuleTypeMonitorHistogram[] =
     "MONITOR_AND_DUMP_WHEN_SPECIFIC_HISTOGRAM_AND_VALUE";
 
+const char kConfigRuleTypeMonitorThrottledGesture[] =
+    "MONITOR_AND_DUMP_WHEN_THROTTLED_GESTURE_SLOW";
+
 const char kConfigRuleTypeTraceOnNavigationUntilTriggerOrFull[] =
     "TRACE_ON_NAVIGATION_UNTIL_TRIGGER_OR_FULL";
 
 const char kConfigRuleTypeTraceAtRandomIntervals[] =
     "TRACE_AT_RANDOM_INTERVALS";
 
+// Recorded by ui::InputHandlerProxy for each scroll update applied at an
+// eBrowser-throttled frame rate, in microseconds and milliseconds.
+const char kPacedScrollDelayHistogram[] = "Event.PacedScroll.Delay";
+const char kPacedScrollFrameGapHistogram[] = "Event.PacedScroll.FrameGap";
+
 const char kTraceAtRandomIntervalsEventName[] =
     "ReactiveTraceAtRandomIntervals";
 
@@ -268,6 +280,141 @@ class HistogramRule : public BackgroundTracingRule,
   bool repeat_;
 };
 
+// Triggers when a gesture the eBrowser rate controller throttles applies a
+// scroll update later than the latency threshold after its input, or leaves a
+// gap longer than the frame gap threshold between two updates. Renderers
+// watch the paced scroll histograms, as for HistogramRule.
+class ThrottledGestureRule
+    : public BackgroundTracingRule,
+      public TracingControllerImpl::TraceMessageFilterObserver {
+ private:
+  ThrottledGestureRule(int latency_threshold_ms, int frame_gap_threshold_ms)
+      : latency_threshold_ms_(latency_threshold_ms),
+        frame_gap_threshold_ms_(frame_gap_threshold_ms) {}
+
+ public:
+  static std::unique_ptr<BackgroundTracingRule> Create(
+      const base::DictionaryValue* dict) {
+    // Either threshold may be left out, but not both.
+    int latency_threshold_ms = 0;
+    int frame_gap_threshold_ms = 0;
+    bool has_latency = dict->GetInteger(kConfigRuleThrottledGestureLatencyKey,
+                                        &latency_threshold_ms);
+    bool has_frame_gap = dict->GetInteger(
+        kConfigRuleThrottledGestureFrameGapKey, &frame_gap_threshold_ms);
+    if (!has_latency && !has_frame_gap)
+      return nullptr;
+    // The delay histogram is in microseconds.
+    if ((has_latency && (latency_threshold_ms <= 0 ||
+                         latency_threshold_ms >
+                             std::numeric_limits<int>::max() / 1000)) ||
+        (has_frame_gap && frame_gap_threshold_ms <= 0)) {
+      return nullptr;
+    }
+
+    return std::unique_ptr<BackgroundTracingRule>(
+        new ThrottledGestureRule(latency_threshold_ms, frame_gap_threshold_ms));
+  }
+
+  ~ThrottledGestureRule() override {
+    if (latency_threshold_ms_)
+      base::StatisticsRecorder::ClearCallback(kPacedScrollDelayHistogram);
+    if (frame_gap_threshold_ms_)
+      base::StatisticsRecorder::ClearCallback(kPacedScrollFrameGapHistogram);
+    TracingControllerImpl::GetInstance()->RemoveTraceMessageFilterObserver(
+        this);
+  }
+
+  // BackgroundTracingRule implementation
+  void Install() override {
+    if (latency_threshold_ms_) {
+      base::StatisticsRecorder::SetCallback(
+          kPacedScrollDelayHistogram,
+          base::Bind(&ThrottledGestureRule::OnHistogramChangedCallback,
+                     base::Unretained(this), kPacedScrollDelayHistogram,
+                     latency_threshold_ms_ * 1000));
+    }
+    if (frame_gap_threshold_ms_) {
+      base::StatisticsRecorder::SetCallback(
+          kPacedScrollFrameGapHistogram,
+          base::Bind(&ThrottledGestureRule::OnHistogramChangedCallback,
+                     base::Unretained(this), kPacedScrollFrameGapHistogram,
+                     frame_gap_threshold_ms_));
+    }
+
+    TracingControllerImpl::GetInstance()->AddTraceMessageFilterObserver(this);
+  }
+
+  void IntoDict(base::DictionaryValue* dict) const override {
+    DCHECK(dict);
+    BackgroundTracingRule::IntoDict(dict);
+    dict->SetString(kConfigRuleKey, kConfigRuleTypeMonitorThrottledGesture);
+    if (latency_threshold_ms_) {
+      dict->SetInteger(kConfigRuleThrottledGestureLatencyKey,
+                       latency_threshold_ms_);
+    }
+    if (frame_gap_threshold_ms_) {
+      dict->SetInteger(kConfigRuleThrottledGestureFrameGapKey,
+                       frame_gap_threshold_ms_);
+    }
+  }
+
+  void OnHistogramTrigger(const std::string& histogram_name) const override {
+    if (!ShouldTriggerNamedEvent(histogram_name))
+      return;
+
+    content::BrowserThread::PostTask(
+        content::BrowserThread::UI, FROM_HERE,
+        base::Bind(
+            &BackgroundTracingManagerImpl::OnRuleTriggered,
+            base::Unretained(BackgroundTracingManagerImpl::GetInstance()), this,
+            BackgroundTracingManager::StartedFinalizingCallback()));
+  }
+
+  // TracingControllerImpl::TraceMessageFilterObserver implementation
+  void OnTraceMessageFilterAdded(TraceMessageFilter* filter) override {
+    if (latency_threshold_ms_) {
+      filter->Send(new TracingMsg_SetUMACallback(
+          kPacedScrollDelayHistogram, latency_threshold_ms_ * 1000,
+          std::numeric_limits<int>::max(), true));
+    }
+    if (frame_gap_threshold_ms_) {
+      filter->Send(new TracingMsg_SetUMACallback(
+          kPacedScrollFrameGapHistogram, frame_gap_threshold_ms_,
+          std::numeric_limits<int>::max(), true));
+    }
+  }
+
+  void OnTraceMessageFilterRemoved(TraceMessageFilter* filter) override {
+    if (latency_threshold_ms_)
+      filter->Send(new TracingMsg_ClearUMACallback(kPacedScrollDelayHistogram));
+    if (frame_gap_threshold_ms_) {
+      filter->Send(
+          new TracingMsg_ClearUMACallback(kPacedScrollFrameGapHistogram));
+    }
+  }
+
+  void OnHistogramChangedCallback(const std::string& histogram_name,
+                                  base::Histogram::Sample threshold,
+                                  base::Histogram::Sample actual_value) {
+    if (actual_value < threshold)
+      return;
+    OnHistogramTrigger(histogram_name);
+  }
+
+  bool ShouldTriggerNamedEvent(const std::string& named_event) const override {
+    return (latency_threshold_ms_ &&
+            named_event == kPacedScrollDelayHistogram) ||
+           (frame_gap_threshold_ms_ &&
+            named_event == kPacedScrollFrameGapHistogram);
+  }
+
+ private:
+  // Zero when not monitored.
+  int latency_threshold_ms_;
+  int frame_gap_threshold_ms_;
+};
+
 class TraceForNSOrTriggerOrFullRule : public BackgroundTracingRule {
  private:
   TraceForNSOrTriggerOrFullRule(const std::string& named_event)
@@ -403,6 +550,8 @@ BackgroundTracingRule::CreateRuleFromDict(const base::DictionaryValue* dict) {
     tracing_rule = NamedTriggerRule::Create(dict);
   else if (type == kConfigRuleTypeMonitorHistogram)
     tracing_rule = HistogramRule::Create(dict);
+  else if (type == kConfigRuleTypeMonitorThrottledGesture)
+    tracing_rule = ThrottledGestureRule::Create(dict);
   else if (type == kConfigRuleTypeTraceOnNavigationUntilTriggerOrFull) {
     tracing_rule = TraceForNSOrTriggerOrFullRule::Create(dict);
   } else if (type == kConfigRuleTypeTraceAtRandomIntervals) {
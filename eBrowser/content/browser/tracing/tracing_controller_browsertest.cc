@@ -303,7 +303,8 @@ class TracingControllerTest : public ContentBrowserTest {
   }
 
   void TestStartAndStopTracingFile(
-      const base::FilePath& result_file_path) {
+      const base::FilePath& result_file_path,
+      bool compressed) {
     Navigate(shell());
 
     TracingController* controller = TracingController::GetInstance();
@@ -328,7 +329,10 @@ class TracingControllerTest : public ContentBrowserTest {
           run_loop.QuitClosure(),
           result_file_path);
       bool result = controller->StopTracing(
-          TracingController::CreateFileSink(result_file_path, callback));
+          compressed ? TracingController::CreateCompressedFileSink(
+                           result_file_path, callback)
+                     : TracingController::CreateFileSink(result_file_path,
+                                                         callback));
       ASSERT_TRUE(result);
       run_loop.Run();
       EXPECT_EQ(disable_recording_done_callback_count(), 1);
@@ -429,10 +433,29 @@ IN_PROC_BROWSER_TEST_F(TracingControllerTest,
     base::ThreadRestrictions::ScopedAllowIO allow_io_for_creating_test_file;
     base::CreateTemporaryFile(&file_path);
   }
-  TestStartAndStopTracingFile(file_path);
+  TestStartAndStopTracingFile(file_path, false);
   EXPECT_EQ(file_path.value(), last_actual_recording_file_path().value());
 }
 
+IN_PROC_BROWSER_TEST_F(TracingControllerTest,
+                       EnableAndStopTracingWithCompressedFilePath) {
+  base::FilePath file_path;
+  {
+    base::ThreadRestrictions::ScopedAllowIO allow_io_for_creating_test_file;
+    base::CreateTemporaryFile(&file_path);
+  }
+  TestStartAndStopTracingFile(file_path, true);
+  EXPECT_EQ(file_path.value(), last_actual_recording_file_path().value());
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io_for_test_verifications;
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(file_path, &contents));
+  // The gzip magic number.
+  ASSERT_GE(contents.size(), 2u);
+  EXPECT_EQ('\x1f', contents[0]);
+  EXPECT_EQ('\x8b', contents[1]);
+}
+
 IN_PROC_BROWSER_TEST_F(TracingControllerTest,
                        EnableAndStopTracingWithCompression) {
   TestStartAndStopTracingCompressed();
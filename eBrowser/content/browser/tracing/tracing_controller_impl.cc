@@ -17,6 +17,7 @@
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "components/tracing/common/process_metrics_memory_dump_provider.h"
+#include "content/browser/renderer_host/input/input_rate_trace_metadata.h"
 #include "content/browser/tracing/file_tracing_provider_impl.h"
 #include "content/browser/tracing/trace_message_filter.h"
 #include "content/browser/tracing/tracing_ui.h"
@@ -262,6 +263,7 @@ bool TracingControllerImpl::StartTracing(
   start_tracing_trace_config_.reset(
       new base::trace_event::TraceConfig(trace_config));
   metadata_.reset(new base::DictionaryValue());
+  InputRateTraceMetadata::GetInstance()->Start();
   pending_start_tracing_ack_count_ = 0;
 
 #if defined(OS_ANDROID)
@@ -361,6 +363,12 @@ bool TracingControllerImpl::StopTracing(
     return true;
   }
 
+  // What InputRateTraceMetadata recorded since StartTracing().
+  std::unique_ptr<base::DictionaryValue> input_rate_metadata =
+      InputRateTraceMetadata::GetInstance()->Stop();
+  if (metadata_)
+    metadata_->Set("ebrowser", std::move(input_rate_metadata));
+
   if (trace_data_sink) {
     MetadataFilterPredicate metadata_filter;
     if (TraceLog::GetInstance()->GetCurrentTraceConfig()
@@ -65,6 +65,12 @@ class FileTraceDataEndpoint : public TraceDataEndpoint {
         file_(NULL) {}
 
   void ReceiveTraceChunk(std::unique_ptr<std::string> chunk) override {
+    // A CompressedTraceDataEndpoint in front of this one already runs on the
+    // FILE thread, and only ever calls in from there.
+    if (BrowserThread::CurrentlyOn(BrowserThread::FILE)) {
+      ReceiveTraceChunkOnFileThread(std::move(chunk));
+      return;
+    }
     BrowserThread::PostTask(
         BrowserThread::FILE, FROM_HERE,
         base::Bind(&FileTraceDataEndpoint::ReceiveTraceChunkOnFileThread, this,
@@ -260,8 +266,8 @@ class CompressedTraceDataEndpoint : public TraceDataEndpoint {
 
       int bytes = kChunkSize - stream_->avail_out;
       if (bytes) {
-        std::string compressed(buffer, bytes);
-        endpoint_->ReceiveTraceChunk(base::MakeUnique<std::string>(compressed));
+        endpoint_->ReceiveTraceChunk(
+            base::MakeUnique<std::string>(buffer, bytes));
       }
     } while (stream_->avail_out == 0);
   }
@@ -325,6 +331,13 @@ TracingController::CreateFileSink(const base::FilePath& file_path,
   return new JSONTraceDataSink(new FileTraceDataEndpoint(file_path, callback));
 }
 
+scoped_refptr<TracingController::TraceDataSink>
+TracingController::CreateCompressedFileSink(const base::FilePath& file_path,
+                                            const base::Closure& callback) {
+  return new JSONTraceDataSink(new CompressedTraceDataEndpoint(
+      new FileTraceDataEndpoint(file_path, callback)));
+}
+
 scoped_refptr<TracingController::TraceDataSink>
 TracingControllerImpl::CreateCompressedStringSink(
     scoped_refptr<TraceDataEndpoint> endpoint) {
@@ -43,6 +43,8 @@ void WebContentsView::GetDefaultScreenInfo(ScreenInfo* results) {
   results->depth = display.color_depth();
   results->depth_per_component = display.depth_per_component();
   results->is_monochrome = display.is_monochrome();
+  results->refresh_rate = display.refresh_rate();
+  results->supported_refresh_rates = display.supported_refresh_rates();
 }
 
 WebContentsView* CreateWebContentsView(
@@ -654,6 +654,8 @@ void GetScreenInfoForWindow(ScreenInfo* results,
   results->depth_per_component = 8;
   results->is_monochrome = false;
   results->device_scale_factor = display.device_scale_factor();
+  results->refresh_rate = display.refresh_rate();
+  results->supported_refresh_rates = display.supported_refresh_rates();
 
   // The Display rotation and the ScreenInfo orientation are not the same
   // angle. The former is the physical display rotation while the later is the
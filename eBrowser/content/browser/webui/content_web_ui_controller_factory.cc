@@ -11,6 +11,7 @@
 #include "content/browser/indexed_db/indexed_db_internals_ui.h"
 #include "content/browser/media/media_internals_ui.h"
 #include "content/browser/net/network_errors_listing_ui.h"
+#include "content/browser/renderer_host/input/frame_latency_internals_ui.h"
 #include "content/browser/service_worker/service_worker_internals_ui.h"
 #include "content/browser/tracing/tracing_ui.h"
 #include "content/public/browser/storage_partition.h"
@@ -34,6 +35,7 @@ WebUI::TypeID ContentWebUIControllerFactory::GetWebUIType(
       url.host() == kChromeUITracingHost ||
 #endif
       url.host() == kChromeUIGpuHost ||
+      url.host() == kChromeUIFrameLatencyInternalsHost ||
       url.host() == kChromeUIIndexedDBInternalsHost ||
       url.host() == kChromeUIMediaInternalsHost ||
       url.host() == kChromeUIServiceWorkerInternalsHost ||
@@ -64,6 +66,8 @@ WebUIController* ContentWebUIControllerFactory::CreateWebUIControllerForURL(
     return new AppCacheInternalsUI(web_ui);
   if (url.host() == kChromeUIGpuHost)
     return new GpuInternalsUI(web_ui);
+  if (url.host() == kChromeUIFrameLatencyInternalsHost)
+    return new FrameLatencyInternalsUI(web_ui);
   if (url.host() == kChromeUIIndexedDBInternalsHost)
     return new IndexedDBInternalsUI(web_ui);
   if (url.host() == kChromeUIMediaInternalsHost)
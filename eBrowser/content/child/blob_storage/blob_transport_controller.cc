@@ -259,13 +259,17 @@ void BlobTransportController::OnMemoryRequest(
           std::unique_ptr<SharedMemory> shared_memory(
               new SharedMemory(handle, false));
 
-          if (!shared_memory->Map(size)) {
+          bool map_failed = !shared_memory->Map(size);
+          UMA_HISTOGRAM_BOOLEAN("Storage.Blob.RendererSharedMemoryMapFailed",
+                                map_failed);
+          if (map_failed) {
             // This would happen if the renderer process doesn't have enough
-            // memory to map the shared memory, which is possible if we don't
-            // have much memory. If this scenario happens often, we could delay
-            // the response until we have enough memory.  For now we just fail.
-            CHECK(false) << "Unable to map shared memory to send blob " << uuid
-                         << ".";
+            // address space or memory to map the segment, which large
+            // uploads make more likely. The blob fails as out of memory
+            // rather than taking the renderer down with it.
+            sender->Send(new BlobStorageMsg_CancelBuildingBlob(
+                uuid, IPCBlobCreationCancelCode::OUT_OF_MEMORY));
+            ReleaseBlobConsolidation(uuid);
             return;
           }
           memory = shared_memory.get();
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/atomic_sequence_num.h"
 #include "base/bind.h"
@@ -139,6 +140,9 @@ ChildDiscardableSharedMemoryManager::AllocateLockedDiscardableMemory(
     slack = allocation_pages - pages;
 
   size_t heap_size_prior_to_releasing_purged_memory = heap_.GetSize();
+  // Spans of purged segments found while searching. They are released in one
+  // pass over the segments rather than one pass per span.
+  std::vector<std::unique_ptr<DiscardableSharedMemoryHeap::Span>> purged_spans;
   for (;;) {
     // Search free lists for suitable span.
     std::unique_ptr<DiscardableSharedMemoryHeap::Span> free_span =
@@ -154,14 +158,24 @@ ChildDiscardableSharedMemoryManager::AllocateLockedDiscardableMemory(
             free_span->length() * base::GetPageSize()) ==
         base::DiscardableSharedMemory::FAILED) {
       DCHECK(!free_span->shared_memory()->IsMemoryResident());
-      // We have to release purged memory before |free_span| can be destroyed.
-      heap_.ReleasePurgedMemory();
-      DCHECK(!free_span->shared_memory());
+      // We have to release purged memory before |free_span| can be destroyed,
+      // so keep it until the search is over.
+      purged_spans.push_back(std::move(free_span));
       continue;
     }
 
     free_span->set_is_locked(true);
 
+    if (!purged_spans.empty()) {
+      heap_.ReleasePurgedMemory();
+      DCHECK(std::none_of(
+          purged_spans.begin(), purged_spans.end(),
+          [](const std::unique_ptr<DiscardableSharedMemoryHeap::Span>& span) {
+            return span->shared_memory();
+          }));
+      purged_spans.clear();
+    }
+
     // Memory usage is guaranteed to have changed after having removed
     // at least one span from the free lists.
     MemoryUsageChanged(heap_.GetSize(), heap_.GetSizeOfFreeLists());
@@ -172,6 +186,7 @@ ChildDiscardableSharedMemoryManager::AllocateLockedDiscardableMemory(
   // Release purged memory to free up the address space before we attempt to
   // allocate more memory.
   heap_.ReleasePurgedMemory();
+  purged_spans.clear();
 
   // Make sure crash keys are up to date in case allocation fails.
   if (heap_.GetSize() != heap_size_prior_to_releasing_purged_memory)
@@ -7,18 +7,106 @@
 #include <stddef.h>
 
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
+#include "base/command_line.h"
 #include "base/debug/alias.h"
 #include "base/memory/ptr_util.h"
 #include "base/process/memory.h"
 #include "base/process/process_metrics.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
 #include "build/build_config.h"
 #include "content/child/child_thread_impl.h"
 #include "content/common/child_process_messages.h"
+#include "content/public/common/content_switches.h"
 #include "ui/gfx/geometry/size.h"
 
 namespace content {
 
+// Holds bitmaps cc is done with, still mapped and still registered with the
+// browser under their ids, so that an allocation of the same size can take
+// one over without any IPC. Bitmaps may be deleted on any thread and may
+// outlive the manager, hence the lock and the reference counting.
+class ChildSharedBitmapPool
+    : public base::RefCountedThreadSafe<ChildSharedBitmapPool> {
+ public:
+  ChildSharedBitmapPool(scoped_refptr<ThreadSafeSender> sender,
+                        size_t max_bytes)
+      : sender_(sender), max_bytes_(max_bytes), pooled_bytes_(0) {}
+
+  // Returns a pooled bitmap of |size| and sets |id| to its id, or returns
+  // null if there is none.
+  std::unique_ptr<base::SharedMemory> Take(const gfx::Size& size,
+                                           cc::SharedBitmapId* id) {
+    base::AutoLock lock(lock_);
+    for (auto it = bitmaps_.begin(); it != bitmaps_.end(); ++it) {
+      if (it->size != size)
+        continue;
+      std::unique_ptr<base::SharedMemory> memory = std::move(it->memory);
+      *id = it->id;
+      pooled_bytes_ -= memory->mapped_size();
+      bitmaps_.erase(it);
+      return memory;
+    }
+    return nullptr;
+  }
+
+  // Keeps |memory| for reuse, or frees it and its registration if the pool is
+  // full.
+  void Put(const gfx::Size& size,
+           std::unique_ptr<base::SharedMemory> memory,
+           const cc::SharedBitmapId& id) {
+    {
+      base::AutoLock lock(lock_);
+      if (pooled_bytes_ + memory->mapped_size() <= max_bytes_) {
+        pooled_bytes_ += memory->mapped_size();
+        bitmaps_.push_back(PooledBitmap(size, std::move(memory), id));
+        return;
+      }
+    }
+    sender_->Send(new ChildProcessHostMsg_DeletedSharedBitmap(id));
+  }
+
+  // Frees every pooled bitmap.
+  void Clear() {
+    std::vector<PooledBitmap> bitmaps;
+    {
+      base::AutoLock lock(lock_);
+      bitmaps.swap(bitmaps_);
+      pooled_bytes_ = 0;
+    }
+    for (const PooledBitmap& bitmap : bitmaps)
+      sender_->Send(new ChildProcessHostMsg_DeletedSharedBitmap(bitmap.id));
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<ChildSharedBitmapPool>;
+
+  struct PooledBitmap {
+    PooledBitmap(const gfx::Size& size,
+                 std::unique_ptr<base::SharedMemory> memory,
+                 const cc::SharedBitmapId& id)
+        : size(size), memory(std::move(memory)), id(id) {}
+
+    gfx::Size size;
+    std::unique_ptr<base::SharedMemory> memory;
+    cc::SharedBitmapId id;
+  };
+
+  ~ChildSharedBitmapPool() { Clear(); }
+
+  scoped_refptr<ThreadSafeSender> sender_;
+  const size_t max_bytes_;
+
+  base::Lock lock_;
+  std::vector<PooledBitmap> bitmaps_;
+  size_t pooled_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ChildSharedBitmapPool);
+};
+
 namespace {
 
 class ChildSharedBitmap : public SharedMemoryBitmap {
@@ -39,12 +127,26 @@ class ChildSharedBitmap : public SharedMemoryBitmap {
   }
 
   ~ChildSharedBitmap() override {
+    if (pool_) {
+      pool_->Put(size_, std::move(shared_memory_holder_), id());
+      return;
+    }
     sender_->Send(new ChildProcessHostMsg_DeletedSharedBitmap(id()));
   }
 
+  // Hands the bitmap back to |pool| instead of freeing it when deleted.
+  void set_pool(const gfx::Size& size,
+                scoped_refptr<ChildSharedBitmapPool> pool) {
+    DCHECK(shared_memory_holder_);
+    size_ = size;
+    pool_ = pool;
+  }
+
  private:
   scoped_refptr<ThreadSafeSender> sender_;
   std::unique_ptr<base::SharedMemory> shared_memory_holder_;
+  gfx::Size size_;
+  scoped_refptr<ChildSharedBitmapPool> pool_;
 };
 
 // Collect extra information for debugging bitmap creation failures.
@@ -81,18 +183,47 @@ SharedMemoryBitmap::SharedMemoryBitmap(uint8_t* pixels,
 ChildSharedBitmapManager::ChildSharedBitmapManager(
     scoped_refptr<ThreadSafeSender> sender)
     : sender_(sender) {
+  size_t pool_megabytes = 0;
+  if (base::StringToSizeT(
+          base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+              switches::kEBrowserSharedBitmapPool),
+          &pool_megabytes) &&
+      pool_megabytes) {
+    pool_ = new ChildSharedBitmapPool(sender_, pool_megabytes * 1024 * 1024);
+    memory_pressure_listener_.reset(new base::MemoryPressureListener(
+        base::Bind(&ChildSharedBitmapManager::OnMemoryPressure,
+                   base::Unretained(this))));
+  }
 }
 
 ChildSharedBitmapManager::~ChildSharedBitmapManager() {}
 
 std::unique_ptr<cc::SharedBitmap>
 ChildSharedBitmapManager::AllocateSharedBitmap(const gfx::Size& size) {
+  if (pool_) {
+    cc::SharedBitmapId id;
+    std::unique_ptr<base::SharedMemory> memory = pool_->Take(size, &id);
+    if (memory) {
+      TRACE_EVENT2("renderer",
+                   "ChildSharedBitmapManager::AllocateSharedBitmap reused",
+                   "width", size.width(), "height", size.height());
+      std::unique_ptr<ChildSharedBitmap> bitmap =
+          base::MakeUnique<ChildSharedBitmap>(sender_, std::move(memory), id);
+      bitmap->set_pool(size, pool_);
+      return std::move(bitmap);
+    }
+  }
+
   std::unique_ptr<SharedMemoryBitmap> bitmap = AllocateSharedMemoryBitmap(size);
 #if defined(OS_POSIX)
   // Close file descriptor to avoid running out.
   if (bitmap)
     bitmap->shared_memory()->Close();
 #endif
+  // Only these bitmaps are recycled, as their callers never use the handle of
+  // the memory and the memory is owned by the bitmap.
+  if (bitmap && pool_)
+    static_cast<ChildSharedBitmap*>(bitmap.get())->set_pool(size, pool_);
   return std::move(bitmap);
 }
 
@@ -166,4 +297,9 @@ ChildSharedBitmapManager::GetBitmapForSharedMemory(base::SharedMemory* mem) {
   return base::MakeUnique<ChildSharedBitmap>(sender_, mem, id);
 }
 
+void ChildSharedBitmapManager::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  pool_->Clear();
+}
+
 }  // namespace content
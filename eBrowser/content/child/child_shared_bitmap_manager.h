@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/shared_memory.h"
 #include "cc/resources/shared_bitmap_manager.h"
@@ -17,6 +18,8 @@
 
 namespace content {
 
+class ChildSharedBitmapPool;
+
 class SharedMemoryBitmap : public cc::SharedBitmap {
  public:
   base::SharedMemory* shared_memory() { return shared_memory_; }
@@ -47,8 +50,16 @@ class ChildSharedBitmapManager : public cc::SharedBitmapManager {
       const gfx::Size& size);
 
  private:
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
   scoped_refptr<ThreadSafeSender> sender_;
 
+  // Recycles the bitmaps of AllocateSharedBitmap(), see
+  // --ebrowser-shared-bitmap-pool. Null if the pool is off.
+  scoped_refptr<ChildSharedBitmapPool> pool_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   DISALLOW_COPY_AND_ASSIGN(ChildSharedBitmapManager);
 };
 
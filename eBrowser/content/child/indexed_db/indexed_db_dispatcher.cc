@@ -8,7 +8,10 @@
 
 #include "base/format_macros.h"
 #include "base/lazy_instance.h"
+#include "base/memory/shared_memory.h"
+#include "base/numerics/safe_math.h"
 #include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_local.h"
 #include "content/child/indexed_db/indexed_db_key_builders.h"
 #include "content/child/indexed_db/webidbcursor_impl.h"
@@ -475,13 +478,8 @@ void IndexedDBDispatcher::OnSuccessIndexedDBKey(int32_t ipc_thread_id,
 
 // Populate some WebIDBValue members (data & blob info) from the supplied
 // value message (IndexedDBMsg_Value or one that includes it).
-template <class IndexedDBMsgValueType>
-static void PrepareWebValue(const IndexedDBMsgValueType& value,
-                            WebIDBValue* web_value) {
-  if (value.bits.empty())
-    return;
-
-  web_value->data.assign(&*value.bits.begin(), value.bits.size());
+static void PrepareWebBlobInfo(const IndexedDBMsg_Value& value,
+                               WebIDBValue* web_value) {
   blink::WebVector<WebBlobInfo> local_blob_info(value.blob_or_file_info.size());
   for (size_t i = 0; i < value.blob_or_file_info.size(); ++i) {
     const IndexedDBMsg_BlobOrFileInfo& info = value.blob_or_file_info[i];
@@ -498,6 +496,45 @@ static void PrepareWebValue(const IndexedDBMsgValueType& value,
   web_value->webBlobInfo.swap(local_blob_info);
 }
 
+template <class IndexedDBMsgValueType>
+static void PrepareWebValue(const IndexedDBMsgValueType& value,
+                            WebIDBValue* web_value) {
+  if (value.bits.empty())
+    return;
+
+  web_value->data.assign(&*value.bits.begin(), value.bits.size());
+  PrepareWebBlobInfo(value, web_value);
+}
+
+// Fills |values| from a prefetch batch whose bits are in |buffer|. Returns
+// false if the sizes do not fit the region.
+static bool PrepareWebValuesFromBuffer(
+    const IndexedDBMsg_CallbacksSuccessCursorPrefetch_Params& p,
+    base::SharedMemory* buffer,
+    std::vector<WebIDBValue>* values) {
+  if (p.value_sizes.size() != p.values.size())
+    return false;
+  base::CheckedNumeric<size_t> total_size = 0;
+  for (uint32_t size : p.value_sizes)
+    total_size += size;
+  if (!total_size.IsValid())
+    return false;
+  if (!total_size.ValueOrDie())
+    return true;
+  if (!buffer->Map(total_size.ValueOrDie()))
+    return false;
+
+  const char* data = static_cast<const char*>(buffer->memory());
+  for (size_t i = 0; i < p.values.size(); ++i) {
+    if (!p.value_sizes[i])
+      continue;
+    (*values)[i].data.assign(data, p.value_sizes[i]);
+    PrepareWebBlobInfo(p.values[i], &(*values)[i]);
+    data += p.value_sizes[i];
+  }
+  return true;
+}
+
 static void PrepareReturnWebValue(const IndexedDBMsg_ReturnValue& value,
                                   WebIDBValue* web_value) {
   PrepareWebValue(value, web_value);
@@ -614,8 +651,19 @@ void IndexedDBDispatcher::OnSuccessCursorPrefetch(
   int32_t ipc_callbacks_id = p.ipc_callbacks_id;
   int32_t ipc_cursor_id = p.ipc_cursor_id;
   std::vector<WebIDBValue> values(p.values.size());
-  for (size_t i = 0; i < p.values.size(); ++i)
-    PrepareWebValue(p.values[i], &values[i]);
+  if (base::SharedMemory::IsHandleValid(p.values_buffer)) {
+    // Owns the handle from here on, so that it is closed on every path.
+    base::SharedMemory buffer(p.values_buffer, true /* read_only */);
+    if (!PrepareWebValuesFromBuffer(p, &buffer, &values)) {
+      OnError(p.ipc_thread_id, ipc_callbacks_id,
+              blink::WebIDBDatabaseExceptionUnknownError,
+              base::ASCIIToUTF16("Malformed prefetch batch."));
+      return;
+    }
+  } else {
+    for (size_t i = 0; i < p.values.size(); ++i)
+      PrepareWebValue(p.values[i], &values[i]);
+  }
   std::map<int32_t, WebIDBCursorImpl*>::const_iterator cur_iter =
       cursors_.find(ipc_cursor_id);
   if (cur_iter == cursors_.end())
@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,8 @@ WebIDBCursorImpl::WebIDBCursorImpl(int32_t ipc_cursor_id,
       used_prefetches_(0),
       pending_onsuccess_callbacks_(0),
       prefetch_amount_(kMinPrefetchAmount),
+      prefetch_batch_size_(0),
+      prefetch_batch_bytes_(0),
       thread_safe_sender_(thread_safe_sender) {}
 
 WebIDBCursorImpl::~WebIDBCursorImpl() {
@@ -93,10 +96,10 @@ void WebIDBCursorImpl::continueFunction(const WebIDBKey& key,
       dispatcher->RequestIDBCursorPrefetch(
           prefetch_amount_, callbacks.release(), ipc_cursor_id_);
 
-      // Increase prefetch_amount_ exponentially.
-      prefetch_amount_ *= 2;
-      if (prefetch_amount_ > kMaxPrefetchAmount)
-        prefetch_amount_ = kMaxPrefetchAmount;
+      // The cache is empty, so any previous batch has been consumed.
+      prefetch_amount_ = NextPrefetchAmount(
+          prefetch_amount_, prefetch_batch_size_, prefetch_batch_bytes_,
+          base::TimeTicks::Now() - prefetch_arrival_time_);
 
       return;
     }
@@ -135,6 +138,31 @@ void WebIDBCursorImpl::SetPrefetchData(
 
   used_prefetches_ = 0;
   pending_onsuccess_callbacks_ = 0;
+
+  prefetch_arrival_time_ = base::TimeTicks::Now();
+  prefetch_batch_size_ = static_cast<int>(keys.size());
+  prefetch_batch_bytes_ = 0;
+  for (const auto& value : values)
+    prefetch_batch_bytes_ += value.data.size();
+}
+
+// static
+int WebIDBCursorImpl::NextPrefetchAmount(int amount,
+                                         int batch_size,
+                                         size_t batch_bytes,
+                                         base::TimeDelta consumption_time) {
+  double next = 2.0 * amount;
+  if (batch_size > 0 && consumption_time > base::TimeDelta()) {
+    double items_per_ms = batch_size / consumption_time.InMillisecondsF();
+    next = std::min(next, items_per_ms * kPrefetchTargetMs);
+  }
+  if (batch_size > 0 && batch_bytes > 0) {
+    double bytes_per_item = static_cast<double>(batch_bytes) / batch_size;
+    next = std::min(next, kMaxPrefetchBytes / bytes_per_item);
+  }
+  next = std::max(next, static_cast<double>(kMinPrefetchAmount));
+  return static_cast<int>(
+      std::min(next, static_cast<double>(kMaxPrefetchAmount)));
 }
 
 void WebIDBCursorImpl::CachedAdvance(unsigned long count,
@@ -185,6 +213,8 @@ void WebIDBCursorImpl::CachedContinue(WebIDBCallbacks* callbacks) {
 void WebIDBCursorImpl::ResetPrefetchCache() {
   continue_count_ = 0;
   prefetch_amount_ = kMinPrefetchAmount;
+  prefetch_batch_size_ = 0;
+  prefetch_batch_bytes_ = 0;
 
   if (prefetch_keys_.empty()) {
     // No prefetch cache, so no need to reset the cursor in the back-end.
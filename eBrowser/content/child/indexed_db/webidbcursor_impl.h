@@ -13,6 +13,7 @@
 #include "base/compiler_specific.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "content/common/content_export.h"
 #include "content/common/indexed_db/indexed_db_key.h"
 #include "third_party/WebKit/public/platform/modules/indexeddb/WebIDBCallbacks.h"
@@ -55,13 +56,29 @@ class CONTENT_EXPORT WebIDBCursorImpl
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorReset);
   FRIEND_TEST_ALL_PREFIXES(IndexedDBDispatcherTest, CursorTransactionId);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, AdvancePrefetchTest);
+  FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, NextPrefetchAmount);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchReset);
   FRIEND_TEST_ALL_PREFIXES(WebIDBCursorImplTest, PrefetchTest);
 
   enum { kInvalidCursorId = -1 };
   enum { kPrefetchContinueThreshold = 2 };
   enum { kMinPrefetchAmount = 5 };
-  enum { kMaxPrefetchAmount = 100 };
+  enum { kMaxPrefetchAmount = 400 };
+  // Caps the value bytes a batch is sized for.
+  enum { kMaxPrefetchBytes = 1024 * 1024 };
+  // How long a batch should last at the rate the last one was consumed.
+  enum { kPrefetchTargetMs = 500 };
+
+  // Returns the number of items to request after a prefetch of |amount|.
+  // Without a consumed batch to go by, that doubles. Otherwise it grows no
+  // faster, and is also bounded by what the page consumes in
+  // kPrefetchTargetMs, at the rate it got through the last batch of
+  // |batch_size| items in |consumption_time|, and by kMaxPrefetchBytes at
+  // that batch's value bytes per item.
+  static int NextPrefetchAmount(int amount,
+                                int batch_size,
+                                size_t batch_bytes,
+                                base::TimeDelta consumption_time);
 
   int32_t ipc_cursor_id_;
   int64_t transaction_id_;
@@ -83,6 +100,11 @@ class CONTENT_EXPORT WebIDBCursorImpl
   // Number of items to request in next prefetch.
   int prefetch_amount_;
 
+  // The last batch received, for sizing the next one.
+  base::TimeTicks prefetch_arrival_time_;
+  int prefetch_batch_size_;
+  size_t prefetch_batch_bytes_;
+
   scoped_refptr<ThreadSafeSender> thread_safe_sender_;
 };
 
@@ -336,4 +336,28 @@ TEST_F(WebIDBCursorImplTest, PrefetchReset) {
   EXPECT_EQ(1, dispatcher_->last_used_count());
 }
 
+TEST_F(WebIDBCursorImplTest, NextPrefetchAmount) {
+  const base::TimeDelta kNoTime;
+  const base::TimeDelta kOneSecond = base::TimeDelta::FromSeconds(1);
+
+  // Doubles without a consumed batch, within the limits.
+  EXPECT_EQ(10, WebIDBCursorImpl::NextPrefetchAmount(5, 0, 0, kNoTime));
+  EXPECT_EQ(WebIDBCursorImpl::kMaxPrefetchAmount,
+            WebIDBCursorImpl::NextPrefetchAmount(
+                WebIDBCursorImpl::kMaxPrefetchAmount, 0, 0, kNoTime));
+
+  // A page that reads 40 items a second gets 20, the target 500ms worth.
+  EXPECT_EQ(20, WebIDBCursorImpl::NextPrefetchAmount(40, 40, 0, kOneSecond));
+  // But never less than the minimum.
+  EXPECT_EQ(WebIDBCursorImpl::kMinPrefetchAmount,
+            WebIDBCursorImpl::NextPrefetchAmount(40, 1, 0, kOneSecond));
+  // Fast consumption still only doubles.
+  EXPECT_EQ(80, WebIDBCursorImpl::NextPrefetchAmount(
+                    40, 40, 0, base::TimeDelta::FromMilliseconds(1)));
+
+  // 64KB values fit 16 to the batch.
+  EXPECT_EQ(16, WebIDBCursorImpl::NextPrefetchAmount(
+                    40, 10, 10 * 64 * 1024, kNoTime));
+}
+
 }  // namespace content
@@ -24,6 +24,7 @@ base::MemoryState ToBaseMemoryState(mojom::MemoryState state) {
     case mojom::MemoryState::THROTTLED:
       return base::MemoryState::THROTTLED;
     case mojom::MemoryState::SUSPENDED:
+    case mojom::MemoryState::POWER_SAVING:
       return base::MemoryState::SUSPENDED;
     default:
       NOTREACHED();
@@ -42,7 +43,10 @@ ChildMemoryCoordinatorImpl* ChildMemoryCoordinatorImpl::GetInstance() {
 ChildMemoryCoordinatorImpl::ChildMemoryCoordinatorImpl(
     mojom::MemoryCoordinatorHandlePtr parent,
     ChildMemoryCoordinatorDelegate* delegate)
-    : binding_(this), parent_(std::move(parent)), delegate_(delegate) {
+    : binding_(this),
+      parent_(std::move(parent)),
+      delegate_(delegate),
+      power_saving_(false) {
   base::AutoLock lock(*g_lock.Pointer());
   DCHECK(delegate_);
   DCHECK(!g_child_memory_coordinator);
@@ -60,6 +64,12 @@ void ChildMemoryCoordinatorImpl::OnStateChange(mojom::MemoryState state) {
   base::MemoryState base_state = ToBaseMemoryState(state);
   base::MemoryCoordinatorClientRegistry::GetInstance()->Notify(
       base_state);
+
+  bool power_saving = state == mojom::MemoryState::POWER_SAVING;
+  if (power_saving != power_saving_) {
+    power_saving_ = power_saving;
+    delegate_->OnPowerSavingChange(power_saving);
+  }
 }
 
 #if !defined(OS_ANDROID)
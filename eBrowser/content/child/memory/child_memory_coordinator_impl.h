@@ -20,6 +20,10 @@ class CONTENT_EXPORT ChildMemoryCoordinatorDelegate {
 
   // Called when the system requests immediate actions to free memory.
   virtual void OnTrimMemoryImmediately() = 0;
+
+  // Called when the process enters or leaves the POWER_SAVING state, after
+  // clients have been told it is SUSPENDED or of the state that follows.
+  virtual void OnPowerSavingChange(bool power_saving) = 0;
 };
 
 // ChildMemoryCoordinatorImpl is the implementation of ChildMemoryCoordinator.
@@ -47,6 +51,7 @@ class CONTENT_EXPORT ChildMemoryCoordinatorImpl
   mojo::Binding<mojom::ChildMemoryCoordinator> binding_;
   mojom::MemoryCoordinatorHandlePtr parent_;
   ChildMemoryCoordinatorDelegate* delegate_;
+  bool power_saving_;
 
   DISALLOW_COPY_AND_ASSIGN(ChildMemoryCoordinatorImpl);
 };
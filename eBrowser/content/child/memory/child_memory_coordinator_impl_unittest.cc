@@ -77,9 +77,15 @@ class ChildMemoryCoordinatorImplTest : public testing::Test,
   void OnTrimMemoryImmediately() override {
     on_trim_memory_called_ = true;
   }
+  void OnPowerSavingChange(bool power_saving) override {
+    ++power_saving_changes_;
+    power_saving_ = power_saving;
+  }
 
  protected:
   bool on_trim_memory_called_ = false;
+  int power_saving_changes_ = 0;
+  bool power_saving_ = false;
 
  private:
   std::unique_ptr<base::MessageLoop> message_loop_;
@@ -152,6 +158,26 @@ TEST_F(ChildMemoryCoordinatorImplTest, SingleClient) {
   EXPECT_TRUE(base::MemoryState::THROTTLED != client.last_state());
 }
 
+TEST_F(ChildMemoryCoordinatorImplTest, PowerSaving) {
+  MockMemoryCoordinatorClient client;
+  RegisterClient(&client);
+
+  ChangeState(mojom::MemoryState::POWER_SAVING);
+  EXPECT_EQ(base::MemoryState::SUSPENDED, client.last_state());
+  EXPECT_EQ(1, power_saving_changes_);
+  EXPECT_TRUE(power_saving_);
+
+  ChangeState(mojom::MemoryState::THROTTLED);
+  EXPECT_EQ(base::MemoryState::THROTTLED, client.last_state());
+  EXPECT_EQ(2, power_saving_changes_);
+  EXPECT_FALSE(power_saving_);
+
+  ChangeState(mojom::MemoryState::NORMAL);
+  EXPECT_EQ(2, power_saving_changes_);
+
+  UnregisterClient(&client);
+}
+
 TEST_F(ChildMemoryCoordinatorImplTest, MultipleClients) {
   MemoryCoordinatorTestThread t1("thread 1");
   MemoryCoordinatorTestThread t2("thread 2");
@@ -540,6 +540,8 @@ void ResourceDispatcher::DidChangePriority(int request_id,
                                            net::RequestPriority new_priority,
                                            int intra_priority_value) {
   DCHECK(base::ContainsKey(pending_requests_, request_id));
+  if (resource_scheduling_filter_.get())
+    resource_scheduling_filter_->SetRequestIdPriority(request_id, new_priority);
   message_sender_->Send(new ResourceHostMsg_DidChangePriority(
       request_id, new_priority, intra_priority_value));
 }
@@ -663,9 +665,13 @@ int ResourceDispatcher::StartAsync(
       std::move(peer), request->resource_type, request->origin_pid,
       frame_origin, request->url, request->download_to_file);
 
-  if (resource_scheduling_filter_.get() && loading_task_runner) {
-    resource_scheduling_filter_->SetRequestIdTaskRunner(request_id,
-                                                        loading_task_runner);
+  if (resource_scheduling_filter_.get()) {
+    resource_scheduling_filter_->SetRequestIdPriority(request_id,
+                                                      request->priority);
+    if (loading_task_runner) {
+      resource_scheduling_filter_->SetRequestIdTaskRunner(request_id,
+                                                          loading_task_runner);
+    }
   }
 
   if (ipc_type == blink::WebURLRequest::LoadingIPCType::Mojo) {
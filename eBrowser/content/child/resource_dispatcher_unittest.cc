@@ -20,7 +20,9 @@
 #include "base/message_loop/message_loop.h"
 #include "base/process/process_handle.h"
 #include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "content/child/request_extra_data.h"
+#include "content/child/resource_scheduling_filter.h"
 #include "content/common/appcache_interfaces.h"
 #include "content/common/resource_messages.h"
 #include "content/common/resource_request.h"
@@ -74,6 +76,8 @@ class TestRequestPeer : public RequestPeer {
     EXPECT_FALSE(context_->cancelled);
     EXPECT_FALSE(context_->received_response);
     context_->received_response = true;
+    if (context_->response_order)
+      context_->response_order->push_back(context_->request_id);
     if (context_->cancel_on_receive_response) {
       dispatcher_->Cancel(context_->request_id);
       context_->cancelled = true;
@@ -118,6 +122,8 @@ class TestRequestPeer : public RequestPeer {
 
     bool cancel_on_receive_response = false;
     bool received_response = false;
+    // If set, the request id is appended on receiving the response.
+    std::vector<int>* response_order = nullptr;
 
     // Data received. If downloading to file, remains empty.
     std::string data;
@@ -248,15 +254,19 @@ class ResourceDispatcherTest : public testing::Test, public IPC::Sender {
                         request_id, redirect_info, head)));
   }
 
-  void NotifyReceivedResponse(int request_id) {
+  ResourceResponseHead CreateResponseHead() {
     ResourceResponseHead head;
     std::string raw_headers(kTestPageHeaders);
     std::replace(raw_headers.begin(), raw_headers.end(), '\n', '\0');
     head.headers = new net::HttpResponseHeaders(raw_headers);
     head.mime_type = kTestPageMimeType;
     head.charset = kTestPageCharset;
-    EXPECT_EQ(true, dispatcher_->OnMessageReceived(
-                        ResourceMsg_ReceivedResponse(request_id, head)));
+    return head;
+  }
+
+  void NotifyReceivedResponse(int request_id) {
+    EXPECT_EQ(true, dispatcher_->OnMessageReceived(ResourceMsg_ReceivedResponse(
+                        request_id, CreateResponseHead())));
   }
 
   void NotifySetDataBuffer(int request_id, size_t buffer_size) {
@@ -454,6 +464,46 @@ TEST_F(ResourceDispatcherTest, MultipleRequests) {
   EXPECT_EQ(0u, queued_messages());
 }
 
+// Tests that ResourceSchedulingFilter dispatches the messages of higher
+// priority requests first.
+TEST_F(ResourceDispatcherTest, PrioritizedMessages) {
+  auto feature_list = base::MakeUnique<base::FeatureList>();
+  feature_list->InitializeFromCommandLine(
+      features::kPrioritizeResourceMessages.name, std::string());
+  base::FeatureList::ClearInstanceForTesting();
+  base::FeatureList::SetInstance(std::move(feature_list));
+  scoped_refptr<ResourceSchedulingFilter> filter(new ResourceSchedulingFilter(
+      base::ThreadTaskRunnerHandle::Get(), dispatcher()));
+  dispatcher()->SetResourceSchedulingFilter(filter);
+
+  std::vector<int> response_order;
+  std::unique_ptr<ResourceRequest> request1(CreateResourceRequest(false));
+  request1->priority = net::IDLE;
+  TestRequestPeer::Context peer_context1;
+  peer_context1.response_order = &response_order;
+  StartAsync(std::move(request1), NULL, &peer_context1);
+
+  std::unique_ptr<ResourceRequest> request2(CreateResourceRequest(false));
+  request2->priority = net::HIGHEST;
+  TestRequestPeer::Context peer_context2;
+  peer_context2.response_order = &response_order;
+  StartAsync(std::move(request2), NULL, &peer_context2);
+
+  int id1 = ConsumeRequestResource();
+  int id2 = ConsumeRequestResource();
+
+  EXPECT_TRUE(filter->OnMessageReceived(
+      ResourceMsg_ReceivedResponse(id1, CreateResponseHead())));
+  EXPECT_TRUE(filter->OnMessageReceived(
+      ResourceMsg_ReceivedResponse(id2, CreateResponseHead())));
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_EQ(2u, response_order.size());
+  EXPECT_EQ(id2, response_order[0]);
+  EXPECT_EQ(id1, response_order[1]);
+  EXPECT_EQ(0u, queued_messages());
+}
+
 // Tests that the cancel method prevents other messages from being received.
 TEST_F(ResourceDispatcherTest, Cancel) {
   std::unique_ptr<ResourceRequest> request(CreateResourceRequest(false));
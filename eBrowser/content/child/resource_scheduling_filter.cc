@@ -7,17 +7,34 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "content/child/resource_dispatcher.h"
+#include "content/public/common/content_features.h"
 #include "ipc/ipc_message.h"
 #include "ipc/ipc_message_start.h"
 
 namespace content {
 
+namespace {
+
+// The number of times in a row a message may be passed over for messages of
+// higher priority requests before it is dispatched anyway.
+const int kMaxPassedOverCount = 16;
+
+}  // namespace
+
+ResourceSchedulingFilter::PendingMessages::PendingMessages() {}
+
+ResourceSchedulingFilter::PendingMessages::~PendingMessages() {}
+
 ResourceSchedulingFilter::ResourceSchedulingFilter(
     const scoped_refptr<base::SingleThreadTaskRunner>& main_thread_task_runner,
     ResourceDispatcher* resource_dispatcher)
-    : main_thread_task_runner_(main_thread_task_runner),
+    : next_sequence_number_(0),
+      prioritize_messages_(
+          base::FeatureList::IsEnabled(features::kPrioritizeResourceMessages)),
+      main_thread_task_runner_(main_thread_task_runner),
       resource_dispatcher_(resource_dispatcher),
       weak_ptr_factory_(this) {
   DCHECK(main_thread_task_runner_.get());
@@ -46,9 +63,19 @@ bool ResourceSchedulingFilter::OnMessageReceived(const IPC::Message& message) {
   } else {
     task_runner = main_thread_task_runner_;
   }
-  task_runner->PostTask(FROM_HERE,
-                        base::Bind(&ResourceSchedulingFilter::DispatchMessage,
-                                   weak_ptr_factory_.GetWeakPtr(), message));
+  if (!prioritize_messages_) {
+    task_runner->PostTask(FROM_HERE,
+                          base::Bind(&ResourceSchedulingFilter::DispatchMessage,
+                                     weak_ptr_factory_.GetWeakPtr(), message));
+    return true;
+  }
+
+  PendingMessages& pending = pending_messages_[task_runner.get()];
+  pending.request_id_to_messages[request_id].push_back(
+      {message, next_sequence_number_++});
+  task_runner->PostTask(
+      FROM_HERE, base::Bind(&ResourceSchedulingFilter::DispatchNextMessage,
+                            weak_ptr_factory_.GetWeakPtr(), task_runner));
   return true;
 }
 
@@ -62,6 +89,14 @@ void ResourceSchedulingFilter::SetRequestIdTaskRunner(
 void ResourceSchedulingFilter::ClearRequestIdTaskRunner(int id) {
   base::AutoLock lock(request_id_to_task_runner_map_lock_);
   request_id_to_task_runner_map_.erase(id);
+  request_id_to_priority_map_.erase(id);
+}
+
+void ResourceSchedulingFilter::SetRequestIdPriority(
+    int id,
+    net::RequestPriority priority) {
+  base::AutoLock lock(request_id_to_task_runner_map_lock_);
+  request_id_to_priority_map_[id] = priority;
 }
 
 bool ResourceSchedulingFilter::GetSupportedMessageClasses(
@@ -74,4 +109,63 @@ void ResourceSchedulingFilter::DispatchMessage(const IPC::Message& message) {
   resource_dispatcher_->OnMessageReceived(message);
 }
 
+void ResourceSchedulingFilter::DispatchNextMessage(
+    const scoped_refptr<base::SingleThreadTaskRunner>& task_runner) {
+  IPC::Message message;
+  {
+    base::AutoLock lock(request_id_to_task_runner_map_lock_);
+    auto pending = pending_messages_.find(task_runner.get());
+    DCHECK(pending != pending_messages_.end());
+    auto messages = pending->second.request_id_to_messages.find(
+        PickNextRequestId(&pending->second));
+    message = messages->second.front().message;
+    messages->second.pop_front();
+    if (messages->second.empty())
+      pending->second.request_id_to_messages.erase(messages);
+    if (pending->second.request_id_to_messages.empty())
+      pending_messages_.erase(pending);
+  }
+  DispatchMessage(message);
+}
+
+int ResourceSchedulingFilter::PickNextRequestId(
+    PendingMessages* pending) const {
+  request_id_to_task_runner_map_lock_.AssertAcquired();
+  DCHECK(!pending->request_id_to_messages.empty());
+
+  int next_id = 0;
+  int oldest_id = 0;
+  net::RequestPriority next_priority = net::MINIMUM_PRIORITY;
+  uint64_t next_sequence_number = 0;
+  uint64_t oldest_sequence_number = 0;
+  bool first = true;
+  for (const auto& messages : pending->request_id_to_messages) {
+    auto iter = request_id_to_priority_map_.find(messages.first);
+    net::RequestPriority priority = iter == request_id_to_priority_map_.end()
+                                        ? net::MAXIMUM_PRIORITY
+                                        : iter->second;
+    uint64_t sequence_number = messages.second.front().sequence_number;
+    if (first || priority > next_priority ||
+        (priority == next_priority &&
+         sequence_number < next_sequence_number)) {
+      next_id = messages.first;
+      next_priority = priority;
+      next_sequence_number = sequence_number;
+    }
+    if (first || sequence_number < oldest_sequence_number) {
+      oldest_id = messages.first;
+      oldest_sequence_number = sequence_number;
+    }
+    first = false;
+  }
+
+  // Don't let a stream of urgent messages starve the others.
+  if (next_id != oldest_id &&
+      ++pending->oldest_passed_over_count <= kMaxPassedOverCount) {
+    return next_id;
+  }
+  pending->oldest_passed_over_count = 0;
+  return oldest_id;
+}
+
 }  // namespace content
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <deque>
 #include <map>
 #include <memory>
 
@@ -15,13 +16,18 @@
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
 #include "content/common/content_export.h"
+#include "ipc/ipc_message.h"
 #include "ipc/message_filter.h"
+#include "net/base/request_priority.h"
 
 namespace content {
 class ResourceDispatcher;
 
 // This filter is used to dispatch resource messages on a specific
-// SingleThreadTaskRunner to facilitate task scheduling.
+// SingleThreadTaskRunner to facilitate task scheduling. With the
+// PrioritizeResourceMessages feature, messages waiting on the same task runner
+// are dispatched in request priority order rather than arrival order, while
+// each request's messages stay in order.
 class CONTENT_EXPORT ResourceSchedulingFilter : public IPC::MessageFilter {
  public:
   ResourceSchedulingFilter(const scoped_refptr<base::SingleThreadTaskRunner>&
@@ -39,20 +45,56 @@ class CONTENT_EXPORT ResourceSchedulingFilter : public IPC::MessageFilter {
       int id,
       const scoped_refptr<base::SingleThreadTaskRunner>& task_runner);
 
-  // Removes the task runner associated with |id|.
+  // Removes the task runner and the priority associated with |id|.
   void ClearRequestIdTaskRunner(int id);
 
+  // Sets the priority of the request with |id|. Requests without one are
+  // treated as having the maximum priority.
+  void SetRequestIdPriority(int id, net::RequestPriority priority);
+
   void DispatchMessage(const IPC::Message& message);
 
  private:
   ~ResourceSchedulingFilter() override;
 
+  // The messages waiting to be dispatched on one task runner.
+  struct PendingMessages {
+    PendingMessages();
+    ~PendingMessages();
+
+    struct Entry {
+      IPC::Message message;
+      uint64_t sequence_number;
+    };
+    std::map<int, std::deque<Entry>> request_id_to_messages;
+    // How many times in a row the oldest message has been passed over.
+    int oldest_passed_over_count = 0;
+  };
+
   using RequestIdToTaskRunnerMap =
       std::map<int, scoped_refptr<base::SingleThreadTaskRunner>>;
+  using RequestIdToPriorityMap = std::map<int, net::RequestPriority>;
+  using TaskRunnerToPendingMessagesMap =
+      std::map<base::SingleThreadTaskRunner*, PendingMessages>;
 
-  // This lock guards |request_id_to_task_runner_map_|
+  // Dispatches the most urgent message queued for |task_runner|. One task is
+  // posted per queued message.
+  void DispatchNextMessage(
+      const scoped_refptr<base::SingleThreadTaskRunner>& task_runner);
+
+  // Returns the id of the request whose oldest message should be dispatched
+  // next out of |pending|. Must be called with the lock held.
+  int PickNextRequestId(PendingMessages* pending) const;
+
+  // This lock guards |request_id_to_task_runner_map_|,
+  // |request_id_to_priority_map_| and |pending_messages_|.
   base::Lock request_id_to_task_runner_map_lock_;
   RequestIdToTaskRunnerMap request_id_to_task_runner_map_;
+  RequestIdToPriorityMap request_id_to_priority_map_;
+  TaskRunnerToPendingMessagesMap pending_messages_;
+  uint64_t next_sequence_number_;
+
+  const bool prioritize_messages_;
 
   scoped_refptr<base::SingleThreadTaskRunner> main_thread_task_runner_;
   ResourceDispatcher* resource_dispatcher_;  // NOT OWNED
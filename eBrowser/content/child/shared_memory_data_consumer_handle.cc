@@ -51,6 +51,38 @@ class DelegateThreadSafeReceivedData final
   DISALLOW_COPY_AND_ASSIGN(DelegateThreadSafeReceivedData);
 };
 
+// Borrows the sender's buffer until Detach() is called, and then owns a copy
+// of the payload. This lets readers that keep up with the writer read straight
+// from the shared memory without holding it for readers that don't.
+class DetachableReceivedData final
+    : public RequestPeer::ThreadSafeReceivedData {
+ public:
+  explicit DetachableReceivedData(
+      std::unique_ptr<RequestPeer::ReceivedData> data)
+      : data_(base::MakeUnique<DelegateThreadSafeReceivedData>(
+            std::move(data))) {}
+  ~DetachableReceivedData() override {}
+
+  // Copies the payload and releases the borrowed data. Must be called on the
+  // thread this object was created on, and not while a reader holds a pointer
+  // to the payload.
+  void Detach() { data_ = base::MakeUnique<FixedReceivedData>(data_.get()); }
+
+  const char* payload() const override { return data_->payload(); }
+  int length() const override { return data_->length(); }
+  int encoded_data_length() const override {
+    return data_->encoded_data_length();
+  }
+  int encoded_body_length() const override {
+    return data_->encoded_body_length();
+  }
+
+ private:
+  std::unique_ptr<RequestPeer::ThreadSafeReceivedData> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(DetachableReceivedData);
+};
+
 }  // namespace
 
 using Result = blink::WebDataConsumerHandle::Result;
@@ -68,7 +100,8 @@ class SharedMemoryDataConsumerHandle::Context final
         on_reader_detached_(on_reader_detached),
         is_on_reader_detached_valid_(!on_reader_detached_.is_null()),
         is_handle_active_(true),
-        is_two_phase_read_in_progress_(false) {}
+        is_two_phase_read_in_progress_(false),
+        borrowed_data_(nullptr) {}
 
   bool IsEmpty() const {
     lock_.AssertAcquired();
@@ -91,6 +124,7 @@ class SharedMemoryDataConsumerHandle::Context final
     lock_.AssertAcquired();
     queue_.clear();
     first_offset_ = 0;
+    borrowed_data_ = nullptr;
   }
   RequestPeer::ThreadSafeReceivedData* Top() {
     lock_.AssertAcquired();
@@ -100,6 +134,20 @@ class SharedMemoryDataConsumerHandle::Context final
     lock_.AssertAcquired();
     queue_.push_back(std::move(data));
   }
+  // Pushes |data| without copying it. The previously borrowed data, if it is
+  // still queued, is detached so that at most one chunk of the sender's buffer
+  // is held for a reader that doesn't keep up.
+  void PushBorrowed(std::unique_ptr<DetachableReceivedData> data) {
+    lock_.AssertAcquired();
+    if (borrowed_data_ &&
+        !(is_two_phase_read_in_progress_ && borrowed_data_ == Top())) {
+      // A reader in a two-phase read holds a pointer to the top payload, so
+      // it stays borrowed until the reader consumes it.
+      borrowed_data_->Detach();
+    }
+    borrowed_data_ = data.get();
+    queue_.push_back(std::move(data));
+  }
   size_t first_offset() const {
     lock_.AssertAcquired();
     return first_offset_;
@@ -185,6 +233,8 @@ class SharedMemoryDataConsumerHandle::Context final
     first_offset_ += s;
     auto* top = Top();
     if (static_cast<size_t>(top->length()) <= first_offset_) {
+      if (top == borrowed_data_)
+        borrowed_data_ = nullptr;
       queue_.pop_front();
       first_offset_ = 0;
     }
@@ -258,6 +308,9 @@ class SharedMemoryDataConsumerHandle::Context final
   bool is_on_reader_detached_valid_;
   bool is_handle_active_;
   bool is_two_phase_read_in_progress_;
+  // The most recently pushed chunk that still refers to the sender's buffer,
+  // or null. Only used without backpressure.
+  DetachableReceivedData* borrowed_data_;
 
   DISALLOW_COPY_AND_ASSIGN(Context);
 };
@@ -290,14 +343,15 @@ void SharedMemoryDataConsumerHandle::Writer::AddData(
     }
 
     needs_notification = context_->IsEmpty();
-    std::unique_ptr<RequestPeer::ThreadSafeReceivedData> data_to_pass;
     if (mode_ == kApplyBackpressure) {
-      data_to_pass =
-          base::MakeUnique<DelegateThreadSafeReceivedData>(std::move(data));
+      context_->Push(
+          base::MakeUnique<DelegateThreadSafeReceivedData>(std::move(data)));
     } else {
-      data_to_pass = base::MakeUnique<FixedReceivedData>(data.get());
+      // The data is copied only if it is still queued when the next chunk
+      // arrives, so a reader that keeps up reads the sender's buffer directly.
+      context_->PushBorrowed(
+          base::MakeUnique<DetachableReceivedData>(std::move(data)));
     }
-    context_->Push(std::move(data_to_pass));
   }
 
   if (needs_notification) {
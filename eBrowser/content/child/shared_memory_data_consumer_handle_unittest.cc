@@ -1007,12 +1007,62 @@ TEST(SharedMemoryDataConsumerHandleWithoutBackpressureTest, AddData) {
   writer->AddData(
       base::MakeUnique<LoggingFixedReceivedData>("data2", "upon ", logger));
   logger->Add("3");
+  writer->AddData(
+      base::MakeUnique<LoggingFixedReceivedData>("data3", "a ", logger));
+  logger->Add("4");
+
+  char buffer[20] = {};
+  size_t size = 0;
+  auto reader = handle->obtainReader(nullptr);
+  EXPECT_EQ(kOk, reader->read(buffer, sizeof(buffer), kNone, &size));
+  EXPECT_EQ(12u, size);
+  EXPECT_STREQ("Once upon a ", buffer);
+  logger->Add("5");
 
+  // Only the latest chunk is held without being copied.
   EXPECT_EQ(
       "1\n"
-      "data1 is destructed.\n"
       "2\n"
+      "data1 is destructed.\n"
+      "3\n"
       "data2 is destructed.\n"
+      "4\n"
+      "data3 is destructed.\n"
+      "5\n",
+      logger->log());
+}
+
+TEST(SharedMemoryDataConsumerHandleWithoutBackpressureTest,
+     TwoPhaseReadReadsSenderBuffer) {
+  base::MessageLoop loop;
+  std::unique_ptr<Writer> writer;
+  auto handle = base::MakeUnique<SharedMemoryDataConsumerHandle>(
+      kDoNotApplyBackpressure, &writer);
+  scoped_refptr<Logger> logger(new Logger);
+  auto data1 =
+      base::MakeUnique<LoggingFixedReceivedData>("data1", "Once ", logger);
+  const char* payload1 = data1->payload();
+  writer->AddData(std::move(data1));
+
+  auto reader = handle->obtainReader(nullptr);
+  const void* buffer = nullptr;
+  size_t available = 0;
+  EXPECT_EQ(kOk, reader->beginRead(&buffer, kNone, &available));
+  EXPECT_EQ(payload1, buffer);
+  EXPECT_EQ(5u, available);
+  logger->Add("1");
+
+  // The chunk being read is not released underneath the reader.
+  writer->AddData(
+      base::MakeUnique<LoggingFixedReceivedData>("data2", "upon ", logger));
+  logger->Add("2");
+  EXPECT_EQ(kOk, reader->endRead(available));
+  logger->Add("3");
+
+  EXPECT_EQ(
+      "1\n"
+      "2\n"
+      "data1 is destructed.\n"
       "3\n",
       logger->log());
 }
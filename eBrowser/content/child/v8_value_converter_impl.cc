@@ -19,7 +19,6 @@
 #include "base/values.h"
 #include "third_party/WebKit/public/web/WebArrayBuffer.h"
 #include "third_party/WebKit/public/web/WebArrayBufferConverter.h"
-#include "third_party/WebKit/public/web/WebArrayBufferView.h"
 #include "v8/include/v8.h"
 
 namespace content {
@@ -66,6 +65,18 @@ namespace {
 // For the sake of the storage API, make this quite large.
 const int kMaxRecursionDepth = 100;
 
+// Converts |val| the way FromV8ValueImpl does when there is no strategy.
+std::unique_ptr<base::Value> FromV8NumberImpl(v8::Local<v8::Number> val) {
+  if (val->IsInt32())
+    return base::MakeUnique<base::FundamentalValue>(
+        val.As<v8::Int32>()->Value());
+
+  double val_as_double = val->Value();
+  if (!std::isfinite(val_as_double))
+    return nullptr;
+  return base::MakeUnique<base::FundamentalValue>(val_as_double);
+}
+
 }  // namespace
 
 // The state of a call to FromV8Value.
@@ -369,16 +380,8 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8ValueImpl(
       return out;
   }
 
-  if (val->IsInt32())
-    return base::MakeUnique<base::FundamentalValue>(
-        val->ToInt32(isolate)->Value());
-
-  if (val->IsNumber()) {
-    double val_as_double = val.As<v8::Number>()->Value();
-    if (!std::isfinite(val_as_double))
-      return nullptr;
-    return base::MakeUnique<base::FundamentalValue>(val_as_double);
-  }
+  if (val->IsNumber())
+    return FromV8NumberImpl(val.As<v8::Number>());
 
   if (val->IsString()) {
     v8::String::Utf8Value utf8(val);
@@ -462,8 +465,19 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Array(
 
   std::unique_ptr<base::ListValue> result(new base::ListValue());
 
+  // Numbers don't recurse, so large numeric arrays are converted here instead
+  // of through FromV8ValueImpl, unless a strategy or the recursion limit has
+  // to see each element.
+  bool convert_numbers_inline = !strategy_;
+  {
+    FromV8ValueState::Level child_level(state);
+    if (state->HasReachedMaxRecursionDepth())
+      convert_numbers_inline = false;
+  }
+
   // Only fields with integer keys are carried over to the ListValue.
-  for (uint32_t i = 0; i < val->Length(); ++i) {
+  const uint32_t length = val->Length();
+  for (uint32_t i = 0; i < length; ++i) {
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8 = val->Get(i);
     if (try_catch.HasCaught()) {
@@ -477,7 +491,9 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Array(
     }
 
     std::unique_ptr<base::Value> child =
-        FromV8ValueImpl(state, child_v8, isolate);
+        convert_numbers_inline && child_v8->IsNumber()
+            ? FromV8NumberImpl(child_v8.As<v8::Number>())
+            : FromV8ValueImpl(state, child_v8, isolate);
     if (child)
       result->Append(std::move(child));
     else
@@ -497,27 +513,21 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8ArrayBuffer(
       return out;
   }
 
-  char* data = NULL;
-  size_t length = 0;
-
-  std::unique_ptr<blink::WebArrayBuffer> array_buffer(
-      blink::WebArrayBufferConverter::createFromV8Value(val, isolate));
-  std::unique_ptr<blink::WebArrayBufferView> view;
-  if (array_buffer) {
-    data = reinterpret_cast<char*>(array_buffer->data());
-    length = array_buffer->byteLength();
-  } else {
-    view.reset(blink::WebArrayBufferView::createFromV8Value(val));
-    if (view) {
-      data = reinterpret_cast<char*>(view->baseAddress()) + view->byteOffset();
-      length = view->byteLength();
-    }
+  // Copy the bytes straight out of V8 rather than through Blink wrappers.
+  // CopyContents() doesn't externalize the small typed arrays V8 keeps on its
+  // heap.
+  if (val->IsArrayBuffer()) {
+    v8::ArrayBuffer::Contents contents =
+        val.As<v8::ArrayBuffer>()->GetContents();
+    return base::BinaryValue::CreateWithCopiedBuffer(
+        static_cast<const char*>(contents.Data()), contents.ByteLength());
   }
 
-  if (data)
-    return base::BinaryValue::CreateWithCopiedBuffer(data, length);
-  else
-    return nullptr;
+  v8::Local<v8::ArrayBufferView> view = val.As<v8::ArrayBufferView>();
+  size_t length = view->ByteLength();
+  std::unique_ptr<char[]> buffer(new char[length]);
+  view->CopyContents(buffer.get(), length);
+  return base::MakeUnique<base::BinaryValue>(std::move(buffer), length);
 }
 
 std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Object(
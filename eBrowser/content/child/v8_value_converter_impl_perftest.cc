@@ -0,0 +1,152 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "content/child/v8_value_converter_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "v8/include/v8.h"
+
+namespace content {
+
+namespace {
+
+const uint32_t kElements = 100000;
+const int kIterations = 20;
+
+// Declines every conversion, which makes the converter visit each element
+// through the generic path the way it does for extension APIs that install a
+// strategy.
+class DecliningStrategy : public V8ValueConverter::Strategy {
+ public:
+  DecliningStrategy() {}
+  ~DecliningStrategy() override {}
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(DecliningStrategy);
+};
+
+}  // namespace
+
+class V8ValueConverterImplPerfTest : public testing::Test {
+ public:
+  V8ValueConverterImplPerfTest() : isolate_(v8::Isolate::GetCurrent()) {}
+
+ protected:
+  void SetUp() override {
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate_);
+    context_.Reset(isolate_, v8::Context::New(isolate_, NULL, global));
+  }
+
+  void TearDown() override { context_.Reset(); }
+
+  v8::Local<v8::Array> CreateArray(v8::Local<v8::Context> context,
+                                   bool doubles) {
+    v8::Local<v8::Array> array = v8::Array::New(isolate_, kElements);
+    for (uint32_t i = 0; i < kElements; ++i) {
+      v8::Local<v8::Value> element =
+          doubles ? v8::Number::New(isolate_, i + 0.5).As<v8::Value>()
+                  : v8::Integer::New(isolate_, i).As<v8::Value>();
+      EXPECT_TRUE(array->Set(context, i, element).FromJust());
+    }
+    return array;
+  }
+
+  // Converts |value| |kIterations| times and prints the mean time.
+  void RunFromV8(const std::string& trace,
+                 v8::Local<v8::Value> value,
+                 V8ValueConverter::Strategy* strategy) {
+    v8::Local<v8::Context> context =
+        v8::Local<v8::Context>::New(isolate_, context_);
+    V8ValueConverterImpl converter;
+    converter.SetStrategy(strategy);
+    base::TimeDelta total;
+    for (int i = 0; i < kIterations; ++i) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      std::unique_ptr<base::Value> result =
+          converter.FromV8Value(value, context);
+      total += base::TimeTicks::Now() - start;
+      ASSERT_TRUE(result);
+    }
+    perf_test::PrintResult(
+        "from_v8_time", "", trace,
+        static_cast<size_t>(total.InMicroseconds() / kIterations), "us",
+        true);
+  }
+
+  // Converts |value| to V8 |kIterations| times and prints the mean time.
+  void RunToV8(const std::string& trace, const base::Value& value) {
+    v8::Local<v8::Context> context =
+        v8::Local<v8::Context>::New(isolate_, context_);
+    V8ValueConverterImpl converter;
+    base::TimeDelta total;
+    for (int i = 0; i < kIterations; ++i) {
+      v8::HandleScope handle_scope(isolate_);
+      base::TimeTicks start = base::TimeTicks::Now();
+      v8::Local<v8::Value> result = converter.ToV8Value(&value, context);
+      total += base::TimeTicks::Now() - start;
+      ASSERT_FALSE(result.IsEmpty());
+    }
+    perf_test::PrintResult(
+        "to_v8_time", "", trace,
+        static_cast<size_t>(total.InMicroseconds() / kIterations), "us",
+        true);
+  }
+
+  v8::Isolate* isolate_;
+
+  // Context for the JavaScript in the test.
+  v8::Persistent<v8::Context> context_;
+};
+
+TEST_F(V8ValueConverterImplPerfTest, NumericArrays) {
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context =
+      v8::Local<v8::Context>::New(isolate_, context_);
+  v8::Context::Scope context_scope(context);
+
+  DecliningStrategy strategy;
+  v8::Local<v8::Array> ints = CreateArray(context, false);
+  v8::Local<v8::Array> doubles = CreateArray(context, true);
+  RunFromV8("int_array", ints, nullptr);
+  RunFromV8("int_array_generic", ints, &strategy);
+  RunFromV8("double_array", doubles, nullptr);
+  RunFromV8("double_array_generic", doubles, &strategy);
+
+  V8ValueConverterImpl converter;
+  std::unique_ptr<base::Value> list = converter.FromV8Value(ints, context);
+  ASSERT_TRUE(list);
+  RunToV8("int_array", *list);
+}
+
+TEST_F(V8ValueConverterImplPerfTest, ArrayBuffers) {
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context =
+      v8::Local<v8::Context>::New(isolate_, context_);
+  v8::Context::Scope context_scope(context);
+
+  v8::Local<v8::ArrayBuffer> buffer =
+      v8::ArrayBuffer::New(isolate_, kElements * sizeof(double));
+  v8::Local<v8::Float64Array> view =
+      v8::Float64Array::New(buffer, 0, kElements);
+  RunFromV8("array_buffer", buffer, nullptr);
+  RunFromV8("float64_array", view, nullptr);
+
+  V8ValueConverterImpl converter;
+  std::unique_ptr<base::Value> binary = converter.FromV8Value(view, context);
+  ASSERT_TRUE(binary);
+  EXPECT_TRUE(binary->IsType(base::Value::TYPE_BINARY));
+  RunToV8("array_buffer", *binary);
+}
+
+}  // namespace content
@@ -392,6 +392,45 @@ TEST_F(V8ValueConverterImplTest, ArrayExceptions) {
   EXPECT_EQ("bar", GetString(copy, 1));
 }
 
+TEST_F(V8ValueConverterImplTest, NumbersAndTypedArrays) {
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context =
+      v8::Local<v8::Context>::New(isolate_, context_);
+  v8::Context::Scope context_scope(context);
+  v8::MicrotasksScope microtasks(
+      isolate_, v8::MicrotasksScope::kDoNotRunMicrotasks);
+
+  const char* source = "(function() {"
+      "var arr = [1, -2.5, NaN, 2147483648, , 'x'];"
+      "return [arr, new Uint8Array([1, 2, 3, 4]).subarray(1, 3)];"
+      "})();";
+
+  v8::Local<v8::Script> script(
+      v8::Script::Compile(v8::String::NewFromUtf8(isolate_, source)));
+  v8::Local<v8::Array> array = script->Run().As<v8::Array>();
+  ASSERT_FALSE(array.IsEmpty());
+
+  // Numbers are converted without going through the generic path, which must
+  // not change the result.
+  V8ValueConverterImpl converter;
+  std::unique_ptr<base::ListValue> converted(
+      base::ListValue::From(converter.FromV8Value(array, context)));
+  ASSERT_TRUE(converted.get());
+  ASSERT_EQ(2u, converted->GetSize());
+  base::ListValue* numbers = nullptr;
+  ASSERT_TRUE(converted->GetList(0, &numbers));
+  std::unique_ptr<base::Value> expected =
+      base::test::ParseJson("[1, -2.5, null, 2147483648.0, null, \"x\"]");
+  EXPECT_TRUE(expected->Equals(numbers)) << *numbers;
+
+  // Only the bytes the view covers are copied.
+  base::BinaryValue* binary = nullptr;
+  ASSERT_TRUE(converted->GetBinary(1, &binary));
+  ASSERT_EQ(2u, binary->GetSize());
+  EXPECT_EQ(2, binary->GetBuffer()[0]);
+  EXPECT_EQ(3, binary->GetBuffer()[1]);
+}
+
 TEST_F(V8ValueConverterImplTest, WeirdTypes) {
   v8::HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context =
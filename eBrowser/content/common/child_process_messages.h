@@ -221,6 +221,11 @@ IPC_SYNC_MESSAGE_CONTROL2_1(
 IPC_MESSAGE_CONTROL1(ChildProcessHostMsg_DeletedDiscardableSharedMemory,
                      content::DiscardableSharedMemoryId)
 
+// Carries several asynchronous messages of a child's channel in one IPC. The
+// receiver dispatches them in order, as if each had been sent on its own.
+IPC_MESSAGE_CONTROL1(ChildProcessHostMsg_MessageBatch,
+                     std::vector<IPC::Message> /* messages */)
+
 #if defined(OS_LINUX)
 // Asks the browser to change the priority of thread.
 IPC_MESSAGE_CONTROL2(ChildProcessHostMsg_SetThreadPriority,
@@ -13,6 +13,11 @@
 #include "base/memory/ptr_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/trace_event/memory_dump_manager.h"
+#include "build/build_config.h"
+
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#endif
 
 namespace content {
 namespace {
@@ -25,6 +30,18 @@ bool IsInFreeList(DiscardableSharedMemoryHeap::Span* span) {
   return span->previous() || span->next();
 }
 
+// Returns the index of the lowest set bit. |x| must not be 0.
+size_t CountTrailingZeroBits(uint32_t x) {
+  DCHECK(x);
+#if defined(COMPILER_MSVC)
+  unsigned long index;
+  _BitScanForward(&index, x);
+  return index;
+#else
+  return __builtin_ctz(x);
+#endif
+}
+
 }  // namespace
 
 DiscardableSharedMemoryHeap::Span::Span(
@@ -96,6 +113,10 @@ DiscardableSharedMemoryHeap::DiscardableSharedMemoryHeap(size_t block_size)
     : block_size_(block_size), num_blocks_(0), num_free_blocks_(0) {
   DCHECK_NE(block_size_, 0u);
   DCHECK(IsPowerOfTwo(block_size_));
+  static_assert(arraysize(non_empty_free_spans_) * 32 == arraysize(free_spans_),
+                "one bit per free list");
+  std::fill(non_empty_free_spans_,
+            non_empty_free_spans_ + arraysize(non_empty_free_spans_), 0u);
 }
 
 DiscardableSharedMemoryHeap::~DiscardableSharedMemoryHeap() {
@@ -192,19 +213,19 @@ std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::SearchFreeLists(size_t blocks, size_t slack) {
   DCHECK(blocks);
 
-  size_t length = blocks;
   size_t max_length = blocks + slack;
 
-  // Search array of free lists for a suitable span.
-  while (length - 1 < arraysize(free_spans_) - 1) {
-    const base::LinkedList<Span>& free_spans = free_spans_[length - 1];
-    if (!free_spans.empty()) {
+  // Search array of free lists for the shortest suitable span.
+  if (blocks < arraysize(free_spans_)) {
+    size_t last = std::min(max_length, arraysize(free_spans_) - 1) - 1;
+    size_t index = FindNonEmptyFreeList(blocks - 1, last);
+    if (index <= last) {
       // Return the most recently used span located in tail.
-      return Carve(free_spans.tail()->value(), blocks);
+      return Carve(free_spans_[index].tail()->value(), blocks);
     }
 
-    // Return early after surpassing |max_length|.
-    if (++length > max_length)
+    // Return early when the overflow free list is beyond |max_length|.
+    if (max_length < arraysize(free_spans_))
       return nullptr;
   }
 
@@ -267,15 +288,35 @@ void DiscardableSharedMemoryHeap::InsertIntoFreeList(
   DCHECK(!IsInFreeList(span.get()));
   size_t index = std::min(span->length_, arraysize(free_spans_)) - 1;
   free_spans_[index].Append(span.release());
+  non_empty_free_spans_[index / 32] |= 1u << (index % 32);
 }
 
 std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::RemoveFromFreeList(Span* span) {
   DCHECK(IsInFreeList(span));
   span->RemoveFromList();
+  size_t index = std::min(span->length_, arraysize(free_spans_)) - 1;
+  if (free_spans_[index].empty())
+    non_empty_free_spans_[index / 32] &= ~(1u << (index % 32));
   return base::WrapUnique(span);
 }
 
+size_t DiscardableSharedMemoryHeap::FindNonEmptyFreeList(size_t first,
+                                                         size_t last) const {
+  DCHECK_LE(first, last);
+  DCHECK_LT(last, arraysize(free_spans_));
+  for (size_t word = first / 32; word <= last / 32; ++word) {
+    uint32_t bits = non_empty_free_spans_[word];
+    if (word == first / 32)
+      bits &= ~0u << (first % 32);
+    if (bits) {
+      size_t index = word * 32 + CountTrailingZeroBits(bits);
+      return std::min(index, last + 1);
+    }
+  }
+  return last + 1;
+}
+
 std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::Carve(Span* span, size_t blocks) {
   std::unique_ptr<Span> serving = RemoveFromFreeList(span);
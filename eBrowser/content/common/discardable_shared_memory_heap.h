@@ -146,6 +146,9 @@ class CONTENT_EXPORT DiscardableSharedMemoryHeap {
 
   void InsertIntoFreeList(std::unique_ptr<Span> span);
   std::unique_ptr<Span> RemoveFromFreeList(Span* span);
+  // Returns the index of the first non-empty free list in [first, last], or
+  // last + 1 if they are all empty.
+  size_t FindNonEmptyFreeList(size_t first, size_t last) const;
   std::unique_ptr<Span> Carve(Span* span, size_t blocks);
   void RegisterSpan(Span* span);
   void UnregisterSpan(Span* span);
@@ -178,6 +181,11 @@ class CONTENT_EXPORT DiscardableSharedMemoryHeap {
   // free list of runs that have length >= 256 blocks.
   base::LinkedList<Span> free_spans_[256];
 
+  // Bit i is set when |free_spans_[i]| is not empty, so that the best fitting
+  // non-empty free list is found a word at a time instead of a list at a
+  // time.
+  uint32_t non_empty_free_spans_[256 / 32];
+
   DISALLOW_COPY_AND_ASSIGN(DiscardableSharedMemoryHeap);
 };
 
@@ -8,13 +8,18 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/memory/discardable_memory.h"
 #include "base/memory/discardable_shared_memory.h"
 #include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
 #include "base/process/process_metrics.h"
+#include "content/common/host_discardable_shared_memory_manager.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -97,5 +102,95 @@ TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
                          count / accumulator.InSecondsF(), "runs/s", true);
 }
 
+// Measures searches that have to skip many empty free lists, as when the
+// free spans left behind by image decodes are few and of scattered sizes.
+TEST(DiscardableSharedMemoryHeapTest, SearchSparseFreeLists) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+
+  const size_t kBlocks = 256;
+  const size_t kSegments = 16;
+  size_t segment_size = block_size * kBlocks;
+  int next_discardable_shared_memory_id = 0;
+
+  // Leave one free span of 128 blocks or more in each segment.
+  std::vector<std::unique_ptr<DiscardableSharedMemoryHeap::Span>> allocated;
+  for (size_t i = 0; i < kSegments; ++i) {
+    std::unique_ptr<base::DiscardableSharedMemory> memory(
+        new base::DiscardableSharedMemory);
+    ASSERT_TRUE(memory->CreateAndMap(segment_size));
+    std::unique_ptr<DiscardableSharedMemoryHeap::Span> span =
+        heap.Grow(std::move(memory), segment_size,
+                  next_discardable_shared_memory_id++, base::Bind(NullTask));
+    heap.MergeIntoFreeLists(heap.Split(span.get(), kBlocks / 2 - i));
+    allocated.push_back(std::move(span));
+  }
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeTicks end = start + base::TimeDelta::FromMilliseconds(kTimeLimitMs);
+  base::TimeDelta accumulator;
+  int count = 0;
+  while (start < end) {
+    for (int i = 0; i < kTimeCheckInterval; ++i) {
+      // Small allocations allow any slack below the overflow free list.
+      std::unique_ptr<DiscardableSharedMemoryHeap::Span> span =
+          heap.SearchFreeLists(1 + i % 4, kBlocks - 8);
+      ASSERT_TRUE(span);
+      heap.MergeIntoFreeLists(std::move(span));
+      ++count;
+    }
+
+    base::TimeTicks now = base::TimeTicks::Now();
+    accumulator += now - start;
+    start = now;
+  }
+
+  for (auto& span : allocated)
+    heap.MergeIntoFreeLists(std::move(span));
+
+  perf_test::PrintResult("search_sparse_free_lists", "", "",
+                         count / accumulator.InSecondsF(), "runs/s", true);
+}
+
+// Measures a full battery cycle of the host manager: the working set grows
+// on charger, the budget shrinks on battery and the LRU segments are purged,
+// then the budget is restored.
+TEST(DiscardableSharedMemoryHeapTest, BatteryMemoryLimitCycle) {
+  // HostDiscardableSharedMemoryManager requires a message loop.
+  base::MessageLoop message_loop;
+  HostDiscardableSharedMemoryManager manager;
+
+  const size_t kSegmentSize = 64 * base::GetPageSize();
+  const size_t kSegments = 64;
+  manager.SetMemoryLimit(kSegmentSize * kSegments);
+  manager.SetBatteryMemoryLimit(kSegmentSize * kSegments / 4);
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeTicks end = start + base::TimeDelta::FromMilliseconds(kTimeLimitMs);
+  base::TimeDelta accumulator;
+  int count = 0;
+  while (start < end) {
+    std::vector<std::unique_ptr<base::DiscardableMemory>> segments;
+    for (size_t i = 0; i < kSegments; ++i) {
+      segments.push_back(manager.AllocateLockedDiscardableMemory(kSegmentSize));
+      segments.back()->Unlock();
+    }
+
+    manager.OnPowerStateChange(true);
+    manager.EnforceMemoryPolicy();
+    manager.OnPowerStateChange(false);
+
+    segments.clear();
+    ++count;
+
+    base::TimeTicks now = base::TimeTicks::Now();
+    accumulator += now - start;
+    start = now;
+  }
+
+  perf_test::PrintResult("battery_memory_limit_cycle", "", "",
+                         count / accumulator.InSecondsF(), "runs/s", true);
+}
+
 }  // namespace
 }  // namespace content
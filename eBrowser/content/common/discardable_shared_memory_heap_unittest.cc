@@ -282,6 +282,53 @@ TEST(DiscardableSharedMemoryHeapTest, Slack) {
   heap.MergeIntoFreeLists(std::move(span));
 }
 
+TEST(DiscardableSharedMemoryHeapTest, BestFitAcrossFreeLists) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+
+  const size_t kBlocks = 300;
+  size_t memory_size = block_size * kBlocks;
+  int next_discardable_shared_memory_id = 0;
+
+  std::unique_ptr<base::DiscardableSharedMemory> memory(
+      new base::DiscardableSharedMemory);
+  ASSERT_TRUE(memory->CreateAndMap(memory_size));
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> small_span =
+      heap.Grow(std::move(memory), memory_size,
+                next_discardable_shared_memory_id++, base::Bind(NullTask));
+
+  // Free spans of 40 and 100 blocks, kept apart by allocated spans.
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> separator =
+      heap.Split(small_span.get(), 40);
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> large_span =
+      heap.Split(separator.get(), 1);
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> rest =
+      heap.Split(large_span.get(), 100);
+  size_t small_start = small_span->start();
+  size_t large_start = large_span->start();
+  heap.MergeIntoFreeLists(std::move(small_span));
+  heap.MergeIntoFreeLists(std::move(large_span));
+
+  // No free span between 50 and 50 + 10 blocks.
+  EXPECT_FALSE(heap.SearchFreeLists(50, 10));
+
+  // The shortest span that fits is used, in another word of the free list
+  // bitmap than the requested length.
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span =
+      heap.SearchFreeLists(2, 200);
+  ASSERT_TRUE(span);
+  EXPECT_EQ(small_start, span->start());
+  heap.MergeIntoFreeLists(std::move(span));
+
+  span = heap.SearchFreeLists(60, 200);
+  ASSERT_TRUE(span);
+  EXPECT_EQ(large_start, span->start());
+  heap.MergeIntoFreeLists(std::move(span));
+
+  heap.MergeIntoFreeLists(std::move(separator));
+  heap.MergeIntoFreeLists(std::move(rest));
+}
+
 void OnDeleted(bool* deleted) {
   *deleted = true;
 }
@@ -150,6 +150,15 @@ IPC_MESSAGE_CONTROL0(GpuMsg_WakeUpGpu)
 
 // Tells the GPU process to release the surface because it's being destroyed.
 IPC_MESSAGE_CONTROL1(GpuMsg_DestroyingVideoSurface, int /* surface_id */)
+
+// Tells the GPU process the frame rate the display compositor is throttled
+// to, or 0 when it runs at the display rate, so that swaps carry a matching
+// presentation deadline.
+IPC_MESSAGE_CONTROL1(GpuMsg_SetTargetFrameRate, int /* fps */)
+
+// Tells the GPU process how many display refreshes the browser compositor's
+// window surface should wait per swap, 1 when not throttled.
+IPC_MESSAGE_CONTROL1(GpuMsg_SetThrottledSwapInterval, int /* interval */)
 #endif
 
 // Tells the GPU process to remove all contexts.
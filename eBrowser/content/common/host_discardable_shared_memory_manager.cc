@@ -17,6 +17,7 @@
 #include "base/memory/memory_coordinator_client_registry.h"
 #include "base/memory/ptr_util.h"
 #include "base/numerics/safe_math.h"
+#include "base/power_monitor/power_monitor.h"
 #include "base/process/memory.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
@@ -165,6 +166,10 @@ HostDiscardableSharedMemoryManager::MemorySegment::~MemorySegment() {
 
 HostDiscardableSharedMemoryManager::HostDiscardableSharedMemoryManager()
     : default_memory_limit_(GetDefaultMemoryLimit()),
+      requested_memory_limit_(default_memory_limit_),
+      battery_memory_limit_(0),
+      on_battery_power_(false),
+      observing_power_state_(false),
       memory_limit_(default_memory_limit_),
       bytes_allocated_(0),
       memory_pressure_listener_(new base::MemoryPressureListener(
@@ -187,6 +192,9 @@ HostDiscardableSharedMemoryManager::HostDiscardableSharedMemoryManager()
 HostDiscardableSharedMemoryManager::~HostDiscardableSharedMemoryManager() {
   base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
       this);
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  if (observing_power_state_ && power_monitor)
+    power_monitor->RemoveObserver(this);
 }
 
 HostDiscardableSharedMemoryManager*
@@ -332,10 +340,40 @@ void HostDiscardableSharedMemoryManager::ProcessRemoved(int child_process_id) {
 void HostDiscardableSharedMemoryManager::SetMemoryLimit(size_t limit) {
   base::AutoLock lock(lock_);
 
-  memory_limit_ = limit;
+  requested_memory_limit_ = limit;
+  UpdateMemoryLimit();
   ReduceMemoryUsageUntilWithinMemoryLimit();
 }
 
+void HostDiscardableSharedMemoryManager::SetBatteryMemoryLimit(size_t limit) {
+  // Observers are notified on the thread they were added on, so this is
+  // expected to be called on the thread that owns the PowerMonitor.
+  base::PowerMonitor* power_monitor = base::PowerMonitor::Get();
+  if (limit && !observing_power_state_ && power_monitor) {
+    power_monitor->AddObserver(this);
+    observing_power_state_ = true;
+  }
+
+  {
+    base::AutoLock lock(lock_);
+    battery_memory_limit_ = limit;
+  }
+  OnPowerStateChange(power_monitor && power_monitor->IsOnBatteryPower());
+}
+
+void HostDiscardableSharedMemoryManager::OnPowerStateChange(
+    bool on_battery_power) {
+  base::AutoLock lock(lock_);
+
+  on_battery_power_ = on_battery_power;
+  UpdateMemoryLimit();
+
+  // Purge from the enforcement task rather than while the power state
+  // observers are being notified.
+  if (bytes_allocated_ > memory_limit_)
+    ScheduleEnforceMemoryPolicy();
+}
+
 void HostDiscardableSharedMemoryManager::EnforceMemoryPolicy() {
   base::AutoLock lock(lock_);
 
@@ -473,6 +511,14 @@ void HostDiscardableSharedMemoryManager::OnMemoryPressure(
   }
 }
 
+void HostDiscardableSharedMemoryManager::UpdateMemoryLimit() {
+  lock_.AssertAcquired();
+
+  memory_limit_ = requested_memory_limit_;
+  if (on_battery_power_ && battery_memory_limit_)
+    memory_limit_ = std::min(memory_limit_, battery_memory_limit_);
+}
+
 void
 HostDiscardableSharedMemoryManager::ReduceMemoryUsageUntilWithinMemoryLimit() {
   lock_.AssertAcquired();
@@ -22,6 +22,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/shared_memory.h"
 #include "base/memory/weak_ptr.h"
+#include "base/power_monitor/power_observer.h"
 #include "base/process/process_handle.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -37,7 +38,8 @@ typedef int32_t DiscardableSharedMemoryId;
 class CONTENT_EXPORT HostDiscardableSharedMemoryManager
     : public base::DiscardableMemoryAllocator,
       public base::trace_event::MemoryDumpProvider,
-      public base::MemoryCoordinatorClient {
+      public base::MemoryCoordinatorClient,
+      public base::PowerObserver {
  public:
   HostDiscardableSharedMemoryManager();
   ~HostDiscardableSharedMemoryManager() override;
@@ -76,12 +78,22 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
   // cause memory usage to be reduced if currently above |limit|.
   void SetMemoryLimit(size_t limit);
 
+  // The maximum number of bytes of memory that may be allocated while the
+  // device runs on battery power, or 0 for no separate limit. When the device
+  // goes on battery, the least recently used segments above |limit| are purged
+  // in the background. The limit set by SetMemoryLimit() applies again once
+  // the device is charging.
+  void SetBatteryMemoryLimit(size_t limit);
+
   // Reduce memory usage if above current memory limit.
   void EnforceMemoryPolicy();
 
   // Returns bytes of allocated discardable memory.
   size_t GetBytesAllocated();
 
+  // Overridden from base::PowerObserver:
+  void OnPowerStateChange(bool on_battery_power) override;
+
  private:
   class MemorySegment : public base::RefCountedThreadSafe<MemorySegment> {
    public:
@@ -118,6 +130,9 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
                                       int client_process_id);
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+  // Recomputes |memory_limit_| from |requested_memory_limit_| and the power
+  // state.
+  void UpdateMemoryLimit();
   void ReduceMemoryUsageUntilWithinMemoryLimit();
   void ReduceMemoryUsageUntilWithinLimit(size_t limit);
   void ReleaseMemory(base::DiscardableSharedMemory* memory);
@@ -137,6 +152,11 @@ class CONTENT_EXPORT HostDiscardableSharedMemoryManager
   typedef std::vector<scoped_refptr<MemorySegment>> MemorySegmentVector;
   MemorySegmentVector segments_;
   size_t default_memory_limit_;
+  // The limit set by SetMemoryLimit(). |memory_limit_| is the limit in effect.
+  size_t requested_memory_limit_;
+  size_t battery_memory_limit_;
+  bool on_battery_power_;
+  bool observing_power_state_;
   size_t memory_limit_;
   size_t bytes_allocated_;
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
@@ -197,6 +197,48 @@ TEST_F(HostDiscardableSharedMemoryManagerTest, EnforceMemoryPolicy) {
   EXPECT_EQ(base::DiscardableSharedMemory::FAILED, memory.Lock(0, 0));
 }
 
+TEST_F(HostDiscardableSharedMemoryManagerTest, BatteryMemoryLimit) {
+  const int kDataSize = 1024;
+
+  base::SharedMemoryHandle shared_handle;
+  manager_->AllocateLockedDiscardableSharedMemoryForChild(
+      base::GetCurrentProcessHandle(), ChildProcessHost::kInvalidUniqueID,
+      kDataSize, 0, &shared_handle);
+  ASSERT_TRUE(base::SharedMemory::IsHandleValid(shared_handle));
+
+  TestDiscardableSharedMemory memory(shared_handle);
+  bool rv = memory.Map(kDataSize);
+  ASSERT_TRUE(rv);
+
+  // The battery limit does not apply while charging.
+  manager_->SetBatteryMemoryLimit(memory.mapped_size() - 1);
+  EXPECT_FALSE(manager_->enforce_memory_policy_pending());
+
+  // Going on battery schedules a purge rather than purging right away.
+  memory.SetNow(base::Time::FromDoubleT(1));
+  memory.Unlock(0, 0);
+  manager_->OnPowerStateChange(true);
+  EXPECT_TRUE(manager_->enforce_memory_policy_pending());
+  EXPECT_EQ(memory.mapped_size(), manager_->GetBytesAllocated());
+
+  manager_->set_enforce_memory_policy_pending(false);
+  manager_->SetNow(base::Time::FromDoubleT(2));
+  manager_->EnforceMemoryPolicy();
+  EXPECT_FALSE(manager_->enforce_memory_policy_pending());
+  EXPECT_EQ(0u, manager_->GetBytesAllocated());
+  EXPECT_EQ(base::DiscardableSharedMemory::FAILED, memory.Lock(0, 0));
+
+  // Once charging, an allocation above the battery limit is kept.
+  manager_->OnPowerStateChange(false);
+  manager_->AllocateLockedDiscardableSharedMemoryForChild(
+      base::GetCurrentProcessHandle(), ChildProcessHost::kInvalidUniqueID,
+      kDataSize, 1, &shared_handle);
+  ASSERT_TRUE(base::SharedMemory::IsHandleValid(shared_handle));
+  EXPECT_FALSE(manager_->enforce_memory_policy_pending());
+  TestDiscardableSharedMemory memory2(shared_handle);
+  ASSERT_TRUE(memory2.Map(kDataSize));
+}
+
 TEST_F(HostDiscardableSharedMemoryManagerTest,
        ReduceMemoryAfterSegmentHasBeenDeleted) {
   const int kDataSize = 1024;
@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/memory/shared_memory.h"
 #include "content/common/indexed_db/indexed_db_key.h"
 #include "content/common/indexed_db/indexed_db_key_path.h"
 #include "content/common/indexed_db/indexed_db_key_range.h"
@@ -292,6 +293,11 @@ IPC_STRUCT_BEGIN(IndexedDBMsg_CallbacksSuccessCursorPrefetch_Params)
   IPC_STRUCT_MEMBER(std::vector<content::IndexedDBKey>, keys)
   IPC_STRUCT_MEMBER(std::vector<content::IndexedDBKey>, primary_keys)
   IPC_STRUCT_MEMBER(std::vector<IndexedDBMsg_Value>, values)
+  // Large batches ship their values' bits back to back in one read-only
+  // region instead, |value_sizes| bytes each, and leave |bits| empty. Invalid
+  // for batches sent inline.
+  IPC_STRUCT_MEMBER(base::SharedMemoryHandle, values_buffer)
+  IPC_STRUCT_MEMBER(std::vector<uint32_t>, value_sizes)
 IPC_STRUCT_END()
 
 IPC_STRUCT_BEGIN(IndexedDBMsg_CallbacksSuccessArray_Params)
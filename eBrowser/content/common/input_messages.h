@@ -6,6 +6,7 @@
 // order relative to input events.
 // Multiply-included message file, hence no include guard.
 
+#include "base/memory/shared_memory.h"
 #include "base/strings/string16.h"
 #include "build/build_config.h"
 #include "content/common/content_export.h"
@@ -27,8 +28,11 @@
 #include "ipc/ipc_message_macros.h"
 #include "third_party/WebKit/public/web/WebInputEvent.h"
 #include "ui/events/blink/did_overscroll_params.h"
+#include "ui/events/blink/implicit_feedback_recorder.h"
+#include "ui/events/blink/input_model_type.h"
 #include "ui/events/ipc/latency_info_param_traits.h"
 #include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/point_f.h"
 #include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/geometry/vector2d_f.h"
 #include "ui/gfx/ipc/gfx_param_traits.h"
@@ -57,6 +61,9 @@ IPC_ENUM_TRAITS_MAX_VALUE(
 IPC_ENUM_TRAITS_MAX_VALUE(content::InputEventDispatchType,
                           content::InputEventDispatchType::DISPATCH_TYPE_MAX)
 IPC_ENUM_TRAITS_MAX_VALUE(content::TouchAction, content::TOUCH_ACTION_MAX)
+IPC_ENUM_TRAITS_MAX_VALUE(ui::InputModelType, ui::INPUT_MODEL_TYPE_LAST)
+IPC_ENUM_TRAITS_MAX_VALUE(ui::ImplicitFeedbackType,
+                          ui::IMPLICIT_FEEDBACK_TYPE_LAST)
 
 IPC_STRUCT_TRAITS_BEGIN(ui::DidOverscrollParams)
   IPC_STRUCT_TRAITS_MEMBER(accumulated_overscroll)
@@ -65,6 +72,12 @@ IPC_STRUCT_TRAITS_BEGIN(ui::DidOverscrollParams)
   IPC_STRUCT_TRAITS_MEMBER(causal_event_viewport_point)
 IPC_STRUCT_TRAITS_END()
 
+IPC_STRUCT_TRAITS_BEGIN(ui::ImplicitFeedbackSample)
+  IPC_STRUCT_TRAITS_MEMBER(type)
+  IPC_STRUCT_TRAITS_MEMBER(speed)
+  IPC_STRUCT_TRAITS_MEMBER(fps)
+IPC_STRUCT_TRAITS_END()
+
 IPC_STRUCT_TRAITS_BEGIN(content::EditCommand)
   IPC_STRUCT_TRAITS_MEMBER(name)
   IPC_STRUCT_TRAITS_MEMBER(value)
@@ -128,6 +141,13 @@ IPC_MESSAGE_ROUTED3(InputMsg_HandleInputEvent,
                     ui::LatencyInfo /* latency_info */,
                     content::InputEventDispatchType)
 
+// Sends several non-blocking input events to the render widget at once. The
+// renderer handles them as it would the same events sent one by one as
+// InputMsg_HandleInputEvent with DISPATCH_TYPE_NON_BLOCKING.
+IPC_MESSAGE_ROUTED2(InputMsg_HandleInputEventBatch,
+                    std::vector<ui::ScopedWebInputEvent> /* events */,
+                    std::vector<ui::LatencyInfo> /* latency_info */)
+
 // Sends the cursor visibility state to the render widget.
 IPC_MESSAGE_ROUTED1(InputMsg_CursorVisibilityChange,
                     bool /* is_visible */)
@@ -199,8 +219,58 @@ IPC_MESSAGE_ROUTED2(InputMsg_ExecuteEditCommand,
 IPC_MESSAGE_ROUTED1(InputMsg_ExecuteNoValueEditCommand, std::string /* name */)
 
 //my code
-IPC_MESSAGE_ROUTED1(InputMsg_ModelStr, std::string /* model */)
+// A libsvm text model for the gesture |type|, or "stop" to drop all models.
+IPC_MESSAGE_ROUTED2(InputMsg_ModelStr,
+                    ui::InputModelType /* type */,
+                    std::string /* model */)
+// Like InputMsg_ModelStr, for a model that only paces pages of the serialized
+// url::Origin |origin|.
+IPC_MESSAGE_ROUTED3(InputMsg_OriginModelStr,
+                    ui::InputModelType /* type */,
+                    std::string /* origin */,
+                    std::string /* model */)
 IPC_MESSAGE_ROUTED2(InputMsg_ModelParams, int /* speed */, float /* entropy */)
+// Physical pixels per DIP, and the panel's physical pixels per inch and
+// refresh rate, so that the renderer can measure the speed feature from
+// scroll deltas in the units the model was trained in; see ui::SpeedFeature.
+// The last two are 0 if not known.
+IPC_MESSAGE_ROUTED3(InputMsg_ModelFeatureScale,
+                    float /* scale */,
+                    float /* physical_dpi */,
+                    float /* refresh_rate */)
+// Whether the page plays a video, which keeps gestures above the rate video
+// needs to look smooth.
+IPC_MESSAGE_ROUTED1(InputMsg_SetVideoPlaying, bool /* playing */)
+// A model in the ui::DenseRbfModel binary format, mapped read-only by the
+// renderer and evaluated in place.
+IPC_MESSAGE_ROUTED3(InputMsg_ModelBinary,
+                    ui::InputModelType /* type */,
+                    base::SharedMemoryHandle /* model */,
+                    uint32_t /* size */)
+// A model for the view is available from mojom::InputModelProvider under the
+// key of |type|, |device_id| and the serialized url::Origin |origin|, or empty
+// for a default model. Replaces InputMsg_ModelBinary, so that renderers with
+// several views fetch and map a model once.
+IPC_MESSAGE_ROUTED4(InputMsg_ModelAvailable,
+                    ui::InputModelType /* type */,
+                    std::string /* device_id */,
+                    std::string /* origin */,
+                    uint32_t /* version */)
+// Enables or disables frame rate prediction without dropping the models; sent
+// by the interaction energy benchmark.
+IPC_MESSAGE_ROUTED1(InputMsg_SetModelsEnabled, bool /* enabled */)
+// Paces every gesture at |fps| regardless of the models, or stops doing so if
+// |fps| is zero; sent by the energy calibration harness.
+IPC_MESSAGE_ROUTED1(InputMsg_SetFixedFrameRate, int /* fps */)
+// The device's energy cost per frame, in the ui::EnergyCurve text format.
+IPC_MESSAGE_ROUTED1(InputMsg_EnergyCurveStr, std::string /* curve */)
+// The share of the full frame rate's power gestures may draw to meet the
+// battery life target, or zero for no bound; see ui::EnergyBudget.
+IPC_MESSAGE_ROUTED1(InputMsg_SetEnergyBudgetFraction, double /* fraction */)
+// The frame rate predicted for the view's active gesture changed. Not sent by
+// the browser: InputEventFilter posts it from the compositor thread to the
+// main thread, for RenderWidgetCompositor.
+IPC_MESSAGE_ROUTED1(InputMsg_SetTargetFrameRate, int /* fps */)
 //end
 IPC_MESSAGE_ROUTED0(InputMsg_MouseCaptureLost)
 
@@ -280,6 +350,16 @@ IPC_MESSAGE_ROUTED2(InputMsg_RequestCompositionUpdate,
 
 IPC_MESSAGE_ROUTED0(InputMsg_SyntheticGestureCompleted)
 
+// The JSON report of a benchmark started by
+// InputHostMsg_RunInteractionEnergyBenchmark; empty if it could not run.
+IPC_MESSAGE_ROUTED1(InputMsg_InteractionEnergyBenchmarkCompleted,
+                    std::string /* report */)
+
+// The JSON report of a calibration started by
+// InputHostMsg_RunEnergyCalibration; empty if it could not run.
+IPC_MESSAGE_ROUTED1(InputMsg_EnergyCalibrationCompleted,
+                    std::string /* report */)
+
 // -----------------------------------------------------------------------------
 // Messages sent from the renderer to the browser.
 
@@ -290,6 +370,23 @@ IPC_MESSAGE_ROUTED1(InputHostMsg_HandleInputEvent_ACK,
 IPC_MESSAGE_ROUTED1(InputHostMsg_QueueSyntheticGesture,
                     content::SyntheticGesturePacket)
 
+// Runs a touch scroll by |distance| from |anchor| at each of |speeds|, in
+// DIPs per second, once with the frame rate models enabled and once with them
+// disabled, and measures each.
+IPC_MESSAGE_ROUTED3(InputHostMsg_RunInteractionEnergyBenchmark,
+                    std::vector<float> /* speeds */,
+                    gfx::Vector2dF /* distance */,
+                    gfx::PointF /* anchor */)
+
+// Runs a touch scroll by |distance| from |anchor| at |speed|, in DIPs per
+// second, twice with every gesture paced at each of |frame_rates|, for
+// calibrating the device's energy cost per frame.
+IPC_MESSAGE_ROUTED4(InputHostMsg_RunEnergyCalibration,
+                    std::vector<int> /* frame_rates */,
+                    float /* speed */,
+                    gfx::Vector2dF /* distance */,
+                    gfx::PointF /* anchor */)
+
 // Notifies the allowed touch actions for a new touch point.
 IPC_MESSAGE_ROUTED1(InputHostMsg_SetTouchAction,
                     content::TouchAction /* touch_action */)
@@ -302,6 +399,11 @@ IPC_MESSAGE_ROUTED1(InputHostMsg_DidOverscroll,
 // Sent by the compositor when a fling animation is stopped.
 IPC_MESSAGE_ROUTED0(InputHostMsg_DidStopFlinging)
 
+// Sent by the compositor with each batch of feedback inferred from how the
+// widget's throttled gestures went, for the frame rate models to learn from.
+IPC_MESSAGE_ROUTED1(InputHostMsg_DidRecordImplicitFeedback,
+                    std::vector<ui::ImplicitFeedbackSample> /* samples */)
+
 // Acknowledges receipt of a InputMsg_MoveCaret message.
 IPC_MESSAGE_ROUTED0(InputHostMsg_MoveCaret_ACK)
 
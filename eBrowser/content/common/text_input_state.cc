@@ -10,6 +10,8 @@ TextInputState::TextInputState()
     : type(ui::TEXT_INPUT_TYPE_NONE),
       mode(ui::TEXT_INPUT_MODE_DEFAULT),
       flags(0),
+      value_change_start(-1),
+      value_change_end(-1),
       selection_start(0),
       selection_end(0),
       composition_start(-1),
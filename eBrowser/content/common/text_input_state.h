@@ -5,6 +5,9 @@
 #ifndef CONTENT_COMMON_TEXT_INPUT_STATE_H_
 #define CONTENT_COMMON_TEXT_INPUT_STATE_H_
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <string>
 
 #include "content/common/content_export.h"
@@ -29,8 +32,12 @@ struct CONTENT_EXPORT TextInputState {
   // The flags of input field (autocorrect, autocomplete, etc.)
   int flags;
 
-  // The value of input field.
+  // The value of input field, or if |value_change_start| is not -1, the text
+  // that replaces the range [value_change_start, value_change_end) of the
+  // value the previous update carried. Offsets are in bytes of UTF-8.
   std::string value;
+  int value_change_start;
+  int value_change_end;
 
   // The cursor position of the current selection start, or the caret position
   // if nothing is selected.
@@ -62,6 +69,33 @@ struct CONTENT_EXPORT TextInputState {
   bool batch_edit;
 };
 
+// Values shorter than this are always sent whole, as their changes would save
+// little.
+const size_t kMinTextInputValueLengthForChanges = 256;
+
+// Finds the range [*change_start, *change_end) of |old_value| that has to be
+// replaced to turn it into |new_value|, by trimming the prefix and the suffix
+// the two share. The replacement is the range of |new_value| from
+// |*change_start| to |*change_end| + new_value.size() - old_value.size().
+template <typename STRING>
+void FindTextChange(const STRING& old_value,
+                    const STRING& new_value,
+                    size_t* change_start,
+                    size_t* change_end) {
+  const size_t common_length = std::min(old_value.size(), new_value.size());
+  size_t prefix = 0;
+  while (prefix < common_length && old_value[prefix] == new_value[prefix])
+    ++prefix;
+  size_t suffix = 0;
+  while (suffix < common_length - prefix &&
+         old_value[old_value.size() - suffix - 1] ==
+             new_value[new_value.size() - suffix - 1]) {
+    ++suffix;
+  }
+  *change_start = prefix;
+  *change_end = old_value.size() - suffix;
+}
+
 }  // namespace content
 
 #endif  // CONTENT_COMMON_TEXT_INPUT_STATE_H_
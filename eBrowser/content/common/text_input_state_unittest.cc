@@ -0,0 +1,73 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/common/text_input_state.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/strings/utf_string_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+namespace {
+
+// Applies the change FindTextChange() finds back to |old_value|.
+template <typename STRING>
+STRING ApplyTextChange(const STRING& old_value, const STRING& new_value) {
+  size_t change_start = 0;
+  size_t change_end = 0;
+  FindTextChange(old_value, new_value, &change_start, &change_end);
+  EXPECT_LE(change_start, change_end);
+  EXPECT_LE(change_end, old_value.size());
+  STRING value = old_value;
+  value.replace(change_start, change_end - change_start,
+                new_value.substr(change_start, change_end + new_value.size() -
+                                                   old_value.size() -
+                                                   change_start));
+  return value;
+}
+
+}  // namespace
+
+TEST(TextInputStateTest, FindTextChange) {
+  size_t change_start = 0;
+  size_t change_end = 0;
+  FindTextChange(std::string("Hello world"), std::string("Hello, world"),
+                 &change_start, &change_end);
+  EXPECT_EQ(5u, change_start);
+  EXPECT_EQ(5u, change_end);
+
+  FindTextChange(std::string("Hello, world"), std::string("Hello world"),
+                 &change_start, &change_end);
+  EXPECT_EQ(5u, change_start);
+  EXPECT_EQ(6u, change_end);
+
+  FindTextChange(std::string("same"), std::string("same"), &change_start,
+                 &change_end);
+  EXPECT_EQ(change_start, change_end);
+}
+
+TEST(TextInputStateTest, FindTextChangeRoundTrips) {
+  const char* const kValues[] = {"",     "a",    "aa",    "aaa", "abc",
+                                 "abbc", "abcb", "xabcx", "bc",  "ab"};
+  for (const char* old_value : kValues) {
+    for (const char* new_value : kValues) {
+      EXPECT_EQ(new_value, ApplyTextChange(std::string(old_value),
+                                           std::string(new_value)));
+    }
+  }
+
+  // UTF-8 changes may split characters; the bytes still round trip.
+  const std::string old_utf8 = "caf\xc3\xa9 au lait";
+  const std::string new_utf8 = "caf\xc3\xa8 au lait";
+  EXPECT_EQ(new_utf8, ApplyTextChange(old_utf8, new_utf8));
+
+  const base::string16 old_utf16 = base::ASCIIToUTF16("typing in a field");
+  const base::string16 new_utf16 = base::ASCIIToUTF16("typing into a field");
+  EXPECT_EQ(new_utf16, ApplyTextChange(old_utf16, new_utf16));
+}
+
+}  // namespace content
@@ -4,13 +4,25 @@
 
 // Multiply-included message file, so no include guard.
 
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
 #include "content/common/content_export.h"
 #include "ipc/ipc_message_macros.h"
+#include "ui/events/blink/incremental_svr_trainer.h"
 
 #undef IPC_MESSAGE_EXPORT
 #define IPC_MESSAGE_EXPORT CONTENT_EXPORT
 #define IPC_MESSAGE_START UtilityMsgStart
 
+IPC_STRUCT_TRAITS_BEGIN(ui::SvrTrainingSet)
+  IPC_STRUCT_TRAITS_MEMBER(speeds)
+  IPC_STRUCT_TRAITS_MEMBER(frame_rates)
+  IPC_STRUCT_TRAITS_MEMBER(coefs)
+IPC_STRUCT_TRAITS_END()
+
 //------------------------------------------------------------------------------
 // Utility process messages:
 // These are messages from the browser to the utility process.
@@ -20,3 +32,25 @@ IPC_MESSAGE_CONTROL0(UtilityMsg_BatchMode_Started)
 
 // Tells the utility process that it can shutdown.
 IPC_MESSAGE_CONTROL0(UtilityMsg_BatchMode_Finished)
+
+// Trains a personalized scroll model on a window of frame rate feedback.
+// |first_sample_id| is echoed back so the browser can match the result with
+// its window. The utility process exits after replying.
+IPC_MESSAGE_CONTROL2(UtilityMsg_TrainInputModel,
+                     uint64_t /* first_sample_id */,
+                     ui::SvrTrainingSet /* training_set */)
+
+//------------------------------------------------------------------------------
+// Utility process host messages:
+// These are messages from the utility process to the browser.
+
+// Reply to UtilityMsg_TrainInputModel with the libsvm text model and the
+// coefficient of every sample, to warm start the next training.
+IPC_MESSAGE_CONTROL3(UtilityHostMsg_InputModelTrained,
+                     uint64_t /* first_sample_id */,
+                     std::string /* model */,
+                     std::vector<double> /* coefs */)
+
+// Reply to UtilityMsg_TrainInputModel when no model could be trained.
+IPC_MESSAGE_CONTROL1(UtilityHostMsg_InputModelTrainingFailed,
+                     uint64_t /* first_sample_id */)
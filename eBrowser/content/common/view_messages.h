@@ -173,6 +173,8 @@ IPC_STRUCT_TRAITS_BEGIN(content::ScreenInfo)
   IPC_STRUCT_TRAITS_MEMBER(available_rect)
   IPC_STRUCT_TRAITS_MEMBER(orientation_type)
   IPC_STRUCT_TRAITS_MEMBER(orientation_angle)
+  IPC_STRUCT_TRAITS_MEMBER(refresh_rate)
+  IPC_STRUCT_TRAITS_MEMBER(supported_refresh_rates)
 IPC_STRUCT_TRAITS_END()
 
 IPC_STRUCT_TRAITS_BEGIN(content::ResizeParams)
@@ -275,6 +277,8 @@ IPC_STRUCT_TRAITS_BEGIN(content::TextInputState)
   IPC_STRUCT_TRAITS_MEMBER(mode)
   IPC_STRUCT_TRAITS_MEMBER(flags)
   IPC_STRUCT_TRAITS_MEMBER(value)
+  IPC_STRUCT_TRAITS_MEMBER(value_change_start)
+  IPC_STRUCT_TRAITS_MEMBER(value_change_end)
   IPC_STRUCT_TRAITS_MEMBER(selection_start)
   IPC_STRUCT_TRAITS_MEMBER(selection_end)
   IPC_STRUCT_TRAITS_MEMBER(composition_start)
@@ -622,6 +626,11 @@ IPC_MESSAGE_ROUTED1(ViewMsg_SetBeginFramePaused, bool /* paused */)
 IPC_MESSAGE_ROUTED1(ViewMsg_BeginFrame,
                     cc::BeginFrameArgs /* args */)
 
+// The most BeginFrames per second the renderer should produce frames for,
+// from the browser's FrameRateBudget; 60 means uncapped. Applied on top of
+// the rate predicted for the active gesture.
+IPC_MESSAGE_ROUTED1(ViewMsg_SetBeginFrameBudget, int /* fps */)
+
 // Sent by the browser to deliver a compositor proto to the renderer.
 IPC_MESSAGE_ROUTED1(ViewMsg_HandleCompositorProto,
                     std::vector<uint8_t> /* proto */)
@@ -635,6 +644,12 @@ IPC_MESSAGE_ROUTED1(ViewMsg_HandleCompositorProto,
 IPC_MESSAGE_ROUTED1(ViewHostMsg_SetNeedsBeginFrames,
                     bool /* enabled */)
 
+// Sent by renderer when the frame rate predicted for the active input gesture
+// changes, so that the browser can decimate the display events it turns into
+// ViewMsg_BeginFrame messages. 60 means unthrottled.
+IPC_MESSAGE_ROUTED1(ViewHostMsg_SetBeginFrameTargetRate,
+                    int /* fps */)
+
 // Similar to ViewHostMsg_CreateWindow, except used for sub-widgets, like
 // <select> dropdowns.  This message is sent to the WebContentsImpl that
 // contains the widget being created.
@@ -52,6 +52,7 @@
 #if defined(OS_ANDROID)
 #include "media/base/android/media_client_android.h"
 #include "media/gpu/avda_surface_tracker.h"
+#include "ui/gl/gl_surface_egl.h"
 #endif
 
 namespace content {
@@ -260,6 +261,9 @@ bool GpuChildThread::OnMessageReceived(const IPC::Message& msg) {
     IPC_MESSAGE_HANDLER(GpuMsg_WakeUpGpu, OnWakeUpGpu);
     IPC_MESSAGE_HANDLER(GpuMsg_DestroyingVideoSurface,
                         OnDestroyingVideoSurface);
+    IPC_MESSAGE_HANDLER(GpuMsg_SetTargetFrameRate, OnSetTargetFrameRate);
+    IPC_MESSAGE_HANDLER(GpuMsg_SetThrottledSwapInterval,
+                        OnSetThrottledSwapInterval);
 #endif
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
@@ -513,6 +517,15 @@ void GpuChildThread::OnDestroyingVideoSurface(int surface_id) {
   media::AVDASurfaceTracker::GetInstance()->NotifyDestroyingSurface(surface_id);
   Send(new GpuHostMsg_DestroyingVideoSurfaceAck(surface_id));
 }
+
+void GpuChildThread::OnSetTargetFrameRate(int fps) {
+  gl::GLSurfaceEGL::SetTargetFrameInterval(
+      fps > 0 ? base::TimeDelta::FromSecondsD(1.0 / fps) : base::TimeDelta());
+}
+
+void GpuChildThread::OnSetThrottledSwapInterval(int interval) {
+  gl::GLSurfaceEGL::SetThrottledSwapInterval(interval);
+}
 #endif
 
 void GpuChildThread::OnLoseAllContexts() {
@@ -124,6 +124,8 @@ class GpuChildThread : public ChildThreadImpl,
 #if defined(OS_ANDROID)
   void OnWakeUpGpu();
   void OnDestroyingVideoSurface(int surface_id);
+  void OnSetTargetFrameRate(int fps);
+  void OnSetThrottledSwapInterval(int interval);
 #endif
   void OnLoseAllContexts();
 
@@ -6,7 +6,13 @@
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/command_line.h"
+#include "base/location.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "content/child/child_process.h"
+#include "content/common/child_process_messages.h"
+#include "content/public/common/content_switches.h"
+#include "ppapi/proxy/ppapi_messages.h"
 
 namespace content {
 namespace {
@@ -14,6 +20,12 @@ namespace {
 // How long we wait before releasing the plugin process.
 const int kPluginReleaseTimeSeconds = 30;
 
+// A batch is sent early once it holds this many messages or bytes, which keeps
+// a plugin that issues thousands of calls in one task from growing it without
+// bound.
+const size_t kMaxBatchedMessages = 64;
+const size_t kMaxBatchedBytes = 64 * 1024;
+
 }  // namespace
 
 PluginProcessDispatcher::PluginProcessDispatcher(
@@ -22,10 +34,18 @@ PluginProcessDispatcher::PluginProcessDispatcher(
     bool incognito)
     : ppapi::proxy::PluginDispatcher(get_interface,
                                      permissions,
-                                     incognito) {
+                                     incognito),
+      batching_enabled_(base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnablePepperMessageBatching)),
+      main_task_runner_(base::ThreadTaskRunnerHandle::Get()),
+      pending_bytes_(0),
+      flush_scheduled_(false),
+      weak_ptr_factory_(this) {
 }
 
 PluginProcessDispatcher::~PluginProcessDispatcher() {
+  FlushPendingMessages();
+
   // Don't free the process right away. This timer allows the child process
   // to be re-used if the user rapidly goes to a new page that requires this
   // plugin. This is the case for common plugins where they may be used on a
@@ -35,4 +55,61 @@ PluginProcessDispatcher::~PluginProcessDispatcher() {
       base::TimeDelta::FromSeconds(kPluginReleaseTimeSeconds));
 }
 
+bool PluginProcessDispatcher::Send(IPC::Message* msg) {
+  if (!batching_enabled_ || !CanBatch(*msg) ||
+      !main_task_runner_->BelongsToCurrentThread()) {
+    FlushPendingMessages();
+    return ppapi::proxy::PluginDispatcher::Send(msg);
+  }
+
+  base::AutoLock lock(pending_lock_);
+  pending_bytes_ += msg->size();
+  pending_messages_.push_back(*msg);
+  delete msg;
+  if (pending_messages_.size() >= kMaxBatchedMessages ||
+      pending_bytes_ >= kMaxBatchedBytes) {
+    FlushPendingMessagesLocked();
+  } else if (!flush_scheduled_) {
+    // The PPAPI proxy has no explicit frame boundary, so the end of the task
+    // that made the calls stands in for one.
+    flush_scheduled_ = true;
+    main_task_runner_->PostTask(
+        FROM_HERE, base::Bind(&PluginProcessDispatcher::FlushPendingMessages,
+                              weak_ptr_factory_.GetWeakPtr()));
+  }
+  return true;
+}
+
+// static
+bool PluginProcessDispatcher::CanBatch(const IPC::Message& msg) {
+  // Handles can't be carried inside another message, and sync calls need
+  // their reply before the plugin can go on.
+  return msg.type() == PpapiHostMsg_ResourceCall::ID && !msg.is_sync() &&
+         !msg.HasAttachments();
+}
+
+void PluginProcessDispatcher::FlushPendingMessages() {
+  base::AutoLock lock(pending_lock_);
+  FlushPendingMessagesLocked();
+}
+
+void PluginProcessDispatcher::FlushPendingMessagesLocked() {
+  pending_lock_.AssertAcquired();
+  flush_scheduled_ = false;
+  if (pending_messages_.empty())
+    return;
+
+  // The send is asynchronous, so holding the lock across it doesn't block. It
+  // keeps another thread's message from overtaking the batch.
+  if (pending_messages_.size() == 1) {
+    ppapi::proxy::PluginDispatcher::Send(
+        new IPC::Message(pending_messages_.front()));
+  } else {
+    ppapi::proxy::PluginDispatcher::Send(
+        new ChildProcessHostMsg_MessageBatch(pending_messages_));
+  }
+  pending_messages_.clear();
+  pending_bytes_ = 0;
+}
+
 }  // namespace content
@@ -5,10 +5,22 @@
 #ifndef CONTENT_PPAPI_PLUGIN_PLUGIN_PROCESS_DISPATCHER_H_
 #define CONTENT_PPAPI_PLUGIN_PLUGIN_PROCESS_DISPATCHER_H_
 
+#include <stddef.h>
+
+#include <vector>
+
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "content/child/scoped_child_process_reference.h"
+#include "ipc/ipc_message.h"
 #include "ppapi/proxy/plugin_dispatcher.h"
 
+namespace base {
+class SingleThreadTaskRunner;
+}
+
 namespace content {
 
 // Wrapper around a PluginDispatcher that provides the necessary integration
@@ -21,9 +33,35 @@ class PluginProcessDispatcher : public ppapi::proxy::PluginDispatcher {
                           bool incognito);
   ~PluginProcessDispatcher() override;
 
+  // ppapi::proxy::PluginDispatcher implementation. When batching is enabled,
+  // asynchronous resource calls made on the main thread are held back until
+  // the current task finishes and then sent to the renderer in a single
+  // ChildProcessHostMsg_MessageBatch. Any other message flushes the batch
+  // first, so the renderer sees everything in the order it was sent.
+  bool Send(IPC::Message* msg) override;
+
  private:
+  // Returns true if |msg| may wait in |pending_messages_|.
+  static bool CanBatch(const IPC::Message& msg);
+
+  // Sends whatever is in |pending_messages_|.
+  void FlushPendingMessages();
+  void FlushPendingMessagesLocked();
+
   ScopedChildProcessReference process_ref_;
 
+  const bool batching_enabled_;
+  scoped_refptr<base::SingleThreadTaskRunner> main_task_runner_;
+
+  // Guards the members below. Plugin threads other than the main one may send
+  // while a flush is pending.
+  base::Lock pending_lock_;
+  std::vector<IPC::Message> pending_messages_;
+  size_t pending_bytes_;
+  bool flush_scheduled_;
+
+  base::WeakPtrFactory<PluginProcessDispatcher> weak_ptr_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(PluginProcessDispatcher);
 };
 
@@ -4,6 +4,7 @@
 
 package org.chromium.content.browser;
 
+import android.app.ActivityManager;
 import android.content.ComponentName;
 import android.content.Context;
 import android.content.pm.ApplicationInfo;
@@ -12,6 +13,7 @@ import android.graphics.SurfaceTexture;
 import android.os.Bundle;
 import android.os.ParcelFileDescriptor;
 import android.os.RemoteException;
+import android.os.SystemClock;
 import android.text.TextUtils;
 import android.util.Pair;
 import android.view.Surface;
@@ -19,6 +21,7 @@ import android.view.Surface;
 import org.chromium.base.CommandLine;
 import org.chromium.base.CpuFeatures;
 import org.chromium.base.Log;
+import org.chromium.base.SysUtils;
 import org.chromium.base.ThreadUtils;
 import org.chromium.base.TraceEvent;
 import org.chromium.base.VisibleForTesting;
@@ -438,7 +441,7 @@ public class ChildProcessLauncher {
 
     private static void freeConnection(ChildProcessConnection connection) {
         synchronized (ChildProcessLauncher.class) {
-            if (connection.equals(sSpareSandboxedConnection)) sSpareSandboxedConnection = null;
+            sSpareSandboxedConnections.remove(connection);
         }
 
         // Freeing a service should be delayed. This is so that we avoid immediately reusing the
@@ -484,8 +487,18 @@ public class ChildProcessLauncher {
     private static Map<Integer, ChildProcessConnection> sServiceMap =
             new ConcurrentHashMap<Integer, ChildProcessConnection>();
 
-    // A pre-allocated and pre-bound connection ready for connection setup, or null.
-    private static ChildProcessConnection sSpareSandboxedConnection = null;
+    // Pre-allocated and pre-bound connections ready for connection setup, oldest first.
+    private static final LinkedList<ChildProcessConnection> sSpareSandboxedConnections =
+            new LinkedList<ChildProcessConnection>();
+
+    // Uptimes of the recent sandboxed launches, oldest first, for sizing the warm pool.
+    private static final LinkedList<Long> sRecentSandboxedLaunchTimes = new LinkedList<Long>();
+
+    // Sandboxed launches within this window count as recent.
+    private static final long RECENT_LAUNCH_WINDOW_MILLIS = 60 * 1000;
+
+    // Upper bound of the warm pool, however much memory the device has.
+    private static final int MAX_WARM_POOL_SIZE = 3;
 
     // Manages oom bindings used to bind chind services.
     private static BindingManager sBindingManager = BindingManagerImpl.createBindingManager();
@@ -607,24 +620,66 @@ public class ChildProcessLauncher {
 
     /**
      * Should be called early in startup so the work needed to spawn the child process can be done
-     * in parallel to other startup work. Must not be called on the UI thread. Spare connection is
-     * created in sandboxed child process.
+     * in parallel to other startup work. Must not be called on the UI thread. Spare connections are
+     * created in sandboxed child processes, one unless the warm pool is enabled.
      * @param context the application context used for the connection.
      */
     public static void warmUp(Context context) {
         synchronized (ChildProcessLauncher.class) {
             assert !ThreadUtils.runningOnUiThread();
-            if (sSpareSandboxedConnection == null) {
+            int poolSize = getWarmPoolSize(context);
+            while (sSpareSandboxedConnections.size() < poolSize) {
                 ChildProcessCreationParams params = ChildProcessCreationParams.get();
                 if (params != null) {
                     params = params.copy();
                 }
-                sSpareSandboxedConnection = allocateBoundConnection(context, null, true, false,
-                        params);
+                ChildProcessConnection connection =
+                        allocateBoundConnection(context, null, true, false, params);
+                // Out of sandboxed services; leave the rest to the renderers themselves.
+                if (connection == null) break;
+                sSpareSandboxedConnections.add(connection);
             }
         }
     }
 
+    private static boolean isWarmPoolEnabled() {
+        return CommandLine.isInitialized()
+                && CommandLine.getInstance().hasSwitch(ContentSwitches.EBROWSER_WARM_RENDERER_POOL);
+    }
+
+    /**
+     * Returns how many spare sandboxed connections to keep bound: one, or with the warm pool
+     * enabled, one per 128MB of the app's memory class and one more while renderers are being
+     * launched faster than the pool refills, up to MAX_WARM_POOL_SIZE.
+     */
+    private static int getWarmPoolSize(Context context) {
+        if (!isWarmPoolEnabled() || SysUtils.isLowEndDevice()) return 1;
+
+        ActivityManager activityManager =
+                (ActivityManager) context.getSystemService(Context.ACTIVITY_SERVICE);
+        int poolSize = Math.max(1, activityManager.getMemoryClass() / 128);
+        long windowStart = SystemClock.uptimeMillis() - RECENT_LAUNCH_WINDOW_MILLIS;
+        while (!sRecentSandboxedLaunchTimes.isEmpty()
+                && sRecentSandboxedLaunchTimes.getFirst() < windowStart) {
+            sRecentSandboxedLaunchTimes.removeFirst();
+        }
+        if (sRecentSandboxedLaunchTimes.size() > poolSize) poolSize++;
+        return Math.min(poolSize, MAX_WARM_POOL_SIZE);
+    }
+
+    /**
+     * Binds new spare connections in place of the ones launches have taken, off the launching
+     * thread so that the launch itself does not wait on the binds.
+     */
+    private static void refillWarmPool(final Context context) {
+        new Thread(new Runnable() {
+            @Override
+            public void run() {
+                warmUp(context);
+            }
+        }).start();
+    }
+
     @CalledByNative
     private static FileDescriptorInfo makeFdInfo(
             int id, int fd, boolean autoClose, long offset, long size) {
@@ -715,13 +770,23 @@ public class ChildProcessLauncher {
             ChildProcessConnection allocatedConnection = null;
             String packageName = creationParams != null ? creationParams.getPackageName()
                     : context.getPackageName();
+            boolean refillWarmPool = false;
             synchronized (ChildProcessLauncher.class) {
-                if (inSandbox && sSpareSandboxedConnection != null
-                        && sSpareSandboxedConnection.getPackageName().equals(packageName)) {
-                    allocatedConnection = sSpareSandboxedConnection;
-                    sSpareSandboxedConnection = null;
+                if (inSandbox) {
+                    for (ChildProcessConnection spare : sSpareSandboxedConnections) {
+                        if (spare.getPackageName().equals(packageName)) {
+                            allocatedConnection = spare;
+                            sSpareSandboxedConnections.remove(spare);
+                            break;
+                        }
+                    }
+                    if (isWarmPoolEnabled()) {
+                        sRecentSandboxedLaunchTimes.add(SystemClock.uptimeMillis());
+                        refillWarmPool = true;
+                    }
                 }
             }
+            if (refillWarmPool) refillWarmPool(context);
             if (allocatedConnection == null) {
                 boolean alwaysInForeground = false;
                 if (callbackType == CALLBACK_FOR_GPU_PROCESS) alwaysInForeground = true;
@@ -20,7 +20,6 @@ import android.view.accessibility.AccessibilityNodeProvider;
 import android.view.inputmethod.EditorInfo;
 import android.view.inputmethod.InputConnection;
 import android.widget.FrameLayout;
-import android.os.SystemClock;
 import org.chromium.base.Log;
 import org.chromium.base.TraceEvent;
 
@@ -32,10 +31,6 @@ public class ContentView extends FrameLayout
         implements ContentViewCore.InternalAccessDelegate, SmartClipProvider {
 
     private static final String TAG = "cr.ContentView";
-    private long lastScrollTime = 0;
-    private long totalScrollSpeed = 0;
-    private long countScroll = 0;
-    public static long lastScrollAvgSpeed = 0;
     protected final ContentViewCore mContentViewCore;
 
     /**
@@ -94,31 +89,6 @@ public class ContentView extends FrameLayout
     // Needed by ContentViewCore.InternalAccessDelegate
     @Override
     public void onScrollChanged(int l, int t, int oldl, int oldt) {
-        Log.w(TAG, "onScrollChanged:%s,%s,%s,%s ", l,t,oldl,oldt);
-        int deltaY = t - oldt;
-	long deltaT = 0;
-	long time = SystemClock.uptimeMillis();
-	if(lastScrollTime!=0&&(time - lastScrollTime)>1000){
-		lastScrollTime = 0;countScroll=0;totalScrollSpeed=0;lastScrollAvgSpeed=0;
-	}
-	if((time - lastScrollTime)!=0 && lastScrollTime!=0){
-	    deltaT = time - lastScrollTime;
-	    countScroll ++;
-	}
-	
-	lastScrollTime = time;
-	Log.w(TAG, "speeeeeeeeeeeeeeeeeeed: %s,%s,%s",deltaY, deltaT,time);
-	if(deltaT!=0){
-	    long temp = (deltaY*1000/deltaT);
-		
-	    temp = Math.abs(temp);
-        float entropy = 0;
-	    totalScrollSpeed+=temp;
-	    lastScrollAvgSpeed = totalScrollSpeed/countScroll;
-        mContentViewCore.sendModelParams(temp,entropy);
-	    Log.w(TAG, "speeeeeeeeeeeeeeeeeeed: %s ", temp);
-	    Log.w(TAG, "speeeeeeeeeeeeeeeeeeed-avg: %s ", lastScrollAvgSpeed);
-	}
         super.onScrollChanged(l, t, oldl, oldt);
     }
 
@@ -182,7 +152,6 @@ public class ContentView extends FrameLayout
 
     @Override
     public boolean onTouchEvent(MotionEvent event) {
-        Log.e(TAG, "onTouchEvent");
         return mContentViewCore.onTouchEvent(event);//调用 ContentViewCore 的对象方法
     }
 
@@ -221,7 +190,6 @@ public class ContentView extends FrameLayout
      */
     @Override
     public void scrollBy(int x, int y) {
-        Log.w(TAG, "scrollBy:%s,%s",x,y);
         mContentViewCore.scrollBy(x, y, false);
     }
 
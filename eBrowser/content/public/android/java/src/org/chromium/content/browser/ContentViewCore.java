@@ -91,6 +91,8 @@ import org.chromium.ui.touch_selection.SelectionEventType;
 
 import java.lang.annotation.Annotation;
 import java.lang.ref.WeakReference;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.HashMap;
 import java.util.HashSet;
@@ -317,6 +319,19 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
         public void onSmartClipDataExtracted(String text, String html, Rect clipRect);
     }
 
+    /**
+     * An interface that allows the embedder to collect the feedback the renderer infers on the
+     * frame rates it chose for throttled gestures, e.g. to send it to the model server.
+     */
+    public interface ImplicitFeedbackListener {
+        /**
+         * @param type One of the IMPLICIT_FEEDBACK_* constants.
+         * @param speed The speed of the gesture, in the units of the model's speed feature.
+         * @param frameRate The frame rate the gesture ran at.
+         */
+        public void onImplicitFeedback(int type, float speed, int frameRate);
+    }
+
     private final Context mContext;
     private final String mProductVersion;
     private ViewGroup mContainerView;
@@ -434,6 +449,7 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
     private int mPotentiallyActiveFlingCount;
 
     private SmartClipDataListener mSmartClipDataListener = null;
+    private ImplicitFeedbackListener mImplicitFeedbackListener;
 
     /**
      * PID used to indicate an invalid render process.
@@ -745,6 +761,15 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
     private void onNativeContentViewCoreDestroyed(long nativeContentViewCore) {
         assert nativeContentViewCore == mNativeContentViewCore;
         mNativeContentViewCore = 0;
+        // The block is native memory.
+        mRenderCoordinates.setScrollOffsetBlock(null);
+    }
+
+    @SuppressWarnings("unused")
+    @CalledByNative
+    private void setScrollOffsetBlock(ByteBuffer block) {
+        mRenderCoordinates.setScrollOffsetBlock(
+                block.order(ByteOrder.nativeOrder()).asFloatBuffer());
     }
 
     /**
@@ -839,6 +864,7 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
         mWebContentsObserver.destroy();
         mWebContentsObserver = null;
         setSmartClipDataListener(null);
+        setImplicitFeedbackListener(null);
         setZoomControlsDelegate(null);
         mImeAdapter.resetAndHideKeyboard();
         // TODO(igsolla): address TODO in ContentViewClient because ContentViewClient is not
@@ -1236,9 +1262,48 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
     }
 
 //-------------------------------------------------
+    // Gestures a model can pace. Must match ui::InputModelType.
+    public static final int MODEL_TYPE_SCROLL = 0;
+    public static final int MODEL_TYPE_PINCH = 1;
+
+    // Kinds of implicit feedback. Must match ui::ImplicitFeedbackType.
+    public static final int IMPLICIT_FEEDBACK_ABANDONED = 0;
+    public static final int IMPLICIT_FEEDBACK_DIRECTION_REVERSAL = 1;
+    public static final int IMPLICIT_FEEDBACK_RESCROLL_AFTER_FLING = 2;
+    public static final int IMPLICIT_FEEDBACK_DROPPED_FRAME_BURST = 3;
+
     public void SendModelStr(String modelStr) {
+        sendModelStr(MODEL_TYPE_SCROLL, modelStr);
+    }
+
+    /**
+     * Sends a libsvm text model for one gesture type.
+     * @param modelType One of the MODEL_TYPE_* constants.
+     */
+    public void sendModelStr(int modelType, String modelStr) {
         if (mNativeContentViewCore == 0) return;
-        nativeSendModelStr(mNativeContentViewCore,modelStr);
+        nativeSendModelStr(mNativeContentViewCore, modelType, modelStr);
+    }
+
+    /**
+     * Like {@link #sendModelStr(int, String)}, for a model that only paces pages of one origin.
+     * It is kept, compiled, with the models of a few other recently used origins.
+     * @param modelType One of the MODEL_TYPE_* constants.
+     * @param origin A URL whose origin the model is for, e.g. "https://example.com".
+     */
+    public void sendOriginModelStr(int modelType, String origin, String modelStr) {
+        if (mNativeContentViewCore == 0) return;
+        nativeSendOriginModelStr(mNativeContentViewCore, modelType, origin, modelStr);
+    }
+
+    /**
+     * Sends the device's energy cost per frame at each target frame rate, as fitted by the model
+     * server from calibration runs, for rate policies that weigh energy.
+     * @param curveStr The curve in the server's energy_curve text format.
+     */
+    public void sendEnergyCurveStr(String curveStr) {
+        if (mNativeContentViewCore == 0) return;
+        nativeSendEnergyCurveStr(mNativeContentViewCore, curveStr);
     }
 
     public void sendModelParams(long speed, float entropy) {
@@ -1246,6 +1311,74 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
         nativeSendModelParams(mNativeContentViewCore,speed,entropy);
     }
 
+    /**
+     * Sends a model in the binary format produced by the model server.
+     * @param model A direct buffer, typically the mapped model file.
+     */
+    public void sendModelBinary(ByteBuffer model) {
+        sendModelBinary(MODEL_TYPE_SCROLL, model);
+    }
+
+    /**
+     * Like {@link #sendModelBinary(ByteBuffer)}, for one gesture type.
+     * @param modelType One of the MODEL_TYPE_* constants.
+     */
+    public void sendModelBinary(int modelType, ByteBuffer model) {
+        if (mNativeContentViewCore == 0) return;
+        nativeSendModelBinary(mNativeContentViewCore, modelType, model);
+    }
+
+    /**
+     * Sends the model stored in a file, text or binary. Text models are compiled once and kept
+     * in the app's cache directory, keyed by their content, so sending the same model again,
+     * even after a restart, costs no parsing.
+     * @param modelType One of the MODEL_TYPE_* constants.
+     * @param path Absolute path of the model file.
+     */
+    public void sendModelFile(int modelType, String path) {
+        if (mNativeContentViewCore == 0) return;
+        nativeSendModelFile(mNativeContentViewCore, modelType, path);
+    }
+
+    /**
+     * Reports the frame rate the user settled on after a scroll. The scroll model is retrained
+     * on the device, and installed, every few reports.
+     * @param speed The speed of the scroll, in the units of the model server's feedback.
+     * @param frameRate The frame rate the user asked for.
+     */
+    public void addModelFeedback(float speed, int frameRate) {
+        if (mNativeContentViewCore == 0) return;
+        nativeAddModelFeedback(mNativeContentViewCore, speed, frameRate);
+    }
+
+    /**
+     * @return The average speed of the current scroll, in pixels per second. The speed is
+     *         tracked natively from the frame metadata, at no cost per frame in Java.
+     */
+    public long getScrollSpeed() {
+        if (mNativeContentViewCore == 0) return 0;
+        return nativeGetScrollSpeed(mNativeContentViewCore);
+    }
+
+    /**
+     * @return The average speed of the current scroll as the models' speed feature: normalized
+     *         to the panel's pixel density and refresh rate, so that feedback from different
+     *         devices trains the same model. The units addModelFeedback() and the model
+     *         server's feedback take.
+     */
+    public float getScrollSpeedFeature() {
+        if (mNativeContentViewCore == 0) return 0;
+        return nativeGetScrollSpeedFeature(mNativeContentViewCore);
+    }
+
+    /**
+     * Forgets the current scroll, e.g. once feedback has been given on it.
+     */
+    public void resetScrollSpeed() {
+        if (mNativeContentViewCore == 0) return;
+        nativeResetScrollSpeed(mNativeContentViewCore);
+    }
+
     public void changeFps(int fps) {
         if (mNativeContentViewCore == 0) return;
         nativeScrollBegin(mNativeContentViewCore, fps, -1, -1, 0, 0, true);     
@@ -1535,6 +1668,9 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
         for (mGestureStateListenersIterator.rewind(); mGestureStateListenersIterator.hasNext();) {
             mGestureStateListenersIterator.next().onWindowFocusChanged(hasWindowFocus);
         }
+        if (mNativeContentViewCore != 0) {
+            nativeOnWindowFocusChanged(mNativeContentViewCore, hasWindowFocus);
+        }
     }
 
     public void onFocusChanged(boolean gainFocus) {
@@ -1697,8 +1833,7 @@ public class ContentViewCore implements AccessibilityStateChangeListener, Displa
      * (0, 0). This is critical for drawing ContentView correctly.
      */
     public void scrollBy(float dxPix, float dyPix, boolean useLastFocalEventLocation) {
-long time = SystemClock.uptimeMillis();
-Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
+        long time = SystemClock.uptimeMillis();
         if (mNativeContentViewCore == 0) return;
         if (dxPix == 0 && dyPix == 0) return;
         
@@ -2303,8 +2438,8 @@ Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
                 pageScaleFactor != mRenderCoordinates.getPageScaleFactor();
         final boolean scrollChanged =
                 pageScaleChanged
-                || scrollOffsetX != mRenderCoordinates.getScrollX()
-                || scrollOffsetY != mRenderCoordinates.getScrollY();
+                || scrollOffsetX != mRenderCoordinates.getReportedScrollX()
+                || scrollOffsetY != mRenderCoordinates.getReportedScrollY();
         final boolean topBarChanged = Float.compare(topBarShownPix,
                 mRenderCoordinates.getContentOffsetYPix()) != 0;
         final boolean bottomBarChanged = Float.compare(bottomBarShownPix, mRenderCoordinates
@@ -2319,8 +2454,10 @@ Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
             mContainerViewInternals.onScrollChanged(
                     (int) mRenderCoordinates.fromLocalCssToPix(scrollOffsetX),
                     (int) mRenderCoordinates.fromLocalCssToPix(scrollOffsetY),
-                    (int) mRenderCoordinates.getScrollXPix(),
-                    (int) mRenderCoordinates.getScrollYPix());
+                    (int) mRenderCoordinates.fromLocalCssToPix(
+                            mRenderCoordinates.getReportedScrollX()),
+                    (int) mRenderCoordinates.fromLocalCssToPix(
+                            mRenderCoordinates.getReportedScrollY()));
         }
 
         mRenderCoordinates.updateFrameInfo(
@@ -2363,9 +2500,9 @@ Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
 
     @CalledByNative
     private void updateImeAdapter(long nativeImeAdapterAndroid, int textInputType,
-            int textInputFlags, String text, int selectionStart, int selectionEnd,
-            int compositionStart, int compositionEnd, boolean showImeIfNeeded,
-            boolean isNonImeChange, boolean inBatchEditMode) {
+            int textInputFlags, String text, int textChangeStart, int textChangeEnd,
+            int selectionStart, int selectionEnd, int compositionStart, int compositionEnd,
+            boolean showImeIfNeeded, boolean isNonImeChange, boolean inBatchEditMode) {
         try {
             TraceEvent.begin("ContentViewCore.updateImeAdapter");
             boolean focusedNodeEditable = (textInputType != TextInputType.NONE);
@@ -2375,7 +2512,8 @@ Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
             mImeAdapter.attach(nativeImeAdapterAndroid);
             mImeAdapter.updateKeyboardVisibility(
                     textInputType, textInputFlags, showImeIfNeeded);
-            mImeAdapter.updateState(text, selectionStart, selectionEnd, compositionStart,
+            mImeAdapter.updateState(mImeAdapter.applyTextChange(text, textChangeStart,
+                    textChangeEnd), selectionStart, selectionEnd, compositionStart,
                     compositionEnd, isNonImeChange, inBatchEditMode);
 
             if (mActionMode != null) {
@@ -3167,6 +3305,22 @@ Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
         mSmartClipDataListener = listener;
     }
 
+    @CalledByNative
+    private void onImplicitFeedback(int[] types, float[] speeds, int[] frameRates) {
+        if (mImplicitFeedbackListener == null) return;
+        for (int i = 0; i < types.length; ++i) {
+            mImplicitFeedbackListener.onImplicitFeedback(types[i], speeds[i], frameRates[i]);
+        }
+    }
+
+    /**
+     * Sets the listener for the renderer's implicit feedback, which arrives in batches once
+     * enough throttled gestures have given some. Without one the feedback is dropped.
+     */
+    public void setImplicitFeedbackListener(ImplicitFeedbackListener listener) {
+        mImplicitFeedbackListener = listener;
+    }
+
     public void setBackgroundOpaque(boolean opaque) {
         if (mNativeContentViewCore != 0) {
             nativeSetBackgroundOpaque(mNativeContentViewCore, opaque);
@@ -3355,6 +3509,9 @@ Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
 
     private native void nativeSetFocus(long nativeContentViewCoreImpl, boolean focused);
 
+    private native void nativeOnWindowFocusChanged(
+            long nativeContentViewCoreImpl, boolean hasWindowFocus);
+
     private native void nativeSendOrientationChangeEvent(
             long nativeContentViewCoreImpl, int orientation);
 
@@ -3382,10 +3539,28 @@ Log.w(TAG, "ContentViewCore-dx: %s, dy: %s, time: %s",dxPix,dyPix,time);
     private native void nativeScrollBegin(long nativeContentViewCoreImpl, long timeMs, float x,
             float y, float hintX, float hintY, boolean targetViewport);
     
-    private native void nativeSendModelStr(long nativeContentViewCoreImpl,String model);
+    private native void nativeSendModelStr(
+            long nativeContentViewCoreImpl, int modelType, String model);
+
+    private native void nativeSendOriginModelStr(
+            long nativeContentViewCoreImpl, int modelType, String origin, String model);
+
+    private native void nativeSendEnergyCurveStr(long nativeContentViewCoreImpl, String curve);
 
     private native void nativeSendModelParams(long nativeContentViewCoreImpl,long speed,float entropy);
 
+    private native void nativeSendModelBinary(
+            long nativeContentViewCoreImpl, int modelType, ByteBuffer model);
+
+    private native void nativeSendModelFile(
+            long nativeContentViewCoreImpl, int modelType, String path);
+
+    private native void nativeAddModelFeedback(
+            long nativeContentViewCoreImpl, float speed, int frameRate);
+    private native long nativeGetScrollSpeed(long nativeContentViewCoreImpl);
+    private native float nativeGetScrollSpeedFeature(long nativeContentViewCoreImpl);
+    private native void nativeResetScrollSpeed(long nativeContentViewCoreImpl);
+
     private native void nativeScrollEnd(long nativeContentViewCoreImpl, long timeMs);
 
     private native void nativeScrollBy(
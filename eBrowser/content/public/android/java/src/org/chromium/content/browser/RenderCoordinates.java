@@ -10,6 +10,8 @@ import android.util.TypedValue;
 import org.chromium.base.VisibleForTesting;
 import org.chromium.ui.base.WindowAndroid;
 
+import java.nio.FloatBuffer;
+
 /**
  * Cached copy of all positions and scales (CSS-to-DIP-to-physical pixels)
  * reported from the renderer.
@@ -20,10 +22,14 @@ import org.chromium.ui.base.WindowAndroid;
  */
 public class RenderCoordinates {
 
-    // Scroll offset from the native in CSS.
+    // Scroll offset from the native in CSS, as of the last updateFrameInfo().
     private float mScrollXCss;
     private float mScrollYCss;
 
+    // With --ebrowser-lazy-scroll-frame-info, the latest scroll offset in CSS, x then y, which
+    // native writes for the frames of a scroll that skip updateFrameInfo(). Null otherwise.
+    private FloatBuffer mScrollOffsetBlock;
+
     // Content size from native in CSS.
     private float mContentWidthCss;
     private float mContentHeightCss;
@@ -52,10 +58,43 @@ public class RenderCoordinates {
     // Internally-visible set of update methods (used by ContentViewCore).
     void reset() {
         mScrollXCss = mScrollYCss = 0;
+        if (mScrollOffsetBlock != null) mScrollOffsetBlock.put(0, 0).put(1, 0);
         mPageScaleFactor = 1.0f;
         mHasFrameInfo = false;
     }
 
+    void setScrollOffsetBlock(FloatBuffer block) {
+        if (block == null && mScrollOffsetBlock != null) {
+            // Native is going away; keep its last word.
+            mScrollXCss = scrollXCss();
+            mScrollYCss = scrollYCss();
+        }
+        mScrollOffsetBlock = block;
+    }
+
+    /**
+     * @return Horizontal scroll offset in CSS pixels as of the last updateFrameInfo(), which
+     *         may trail getScrollX() while a scroll is in progress.
+     */
+    float getReportedScrollX() {
+        return mScrollXCss;
+    }
+
+    /**
+     * @return Vertical scroll offset in CSS pixels as of the last updateFrameInfo().
+     */
+    float getReportedScrollY() {
+        return mScrollYCss;
+    }
+
+    private float scrollXCss() {
+        return mScrollOffsetBlock != null ? mScrollOffsetBlock.get(0) : mScrollXCss;
+    }
+
+    private float scrollYCss() {
+        return mScrollOffsetBlock != null ? mScrollOffsetBlock.get(1) : mScrollYCss;
+    }
+
     void updateContentSizeCss(float contentWidthCss, float contentHeightCss) {
         mContentWidthCss = contentWidthCss;
         mContentHeightCss = contentHeightCss;
@@ -142,14 +181,14 @@ public class RenderCoordinates {
          * @return Local device-scale-unadjusted X coordinate of the point.
          */
         public float getXLocalDip() {
-            return (mXAbsoluteCss - mScrollXCss) * mPageScaleFactor;
+            return (mXAbsoluteCss - scrollXCss()) * mPageScaleFactor;
         }
 
         /**
          * @return Local device-scale-unadjusted Y coordinate of the point.
          */
         public float getYLocalDip() {
-            return (mYAbsoluteCss - mScrollYCss) * mPageScaleFactor;
+            return (mYAbsoluteCss - scrollYCss()) * mPageScaleFactor;
         }
 
         /**
@@ -179,8 +218,8 @@ public class RenderCoordinates {
          */
         public void setLocalDip(float xDip, float yDip) {
             setAbsoluteCss(
-                    xDip / mPageScaleFactor + mScrollXCss,
-                    yDip / mPageScaleFactor + mScrollYCss);
+                    xDip / mPageScaleFactor + scrollXCss(),
+                    yDip / mPageScaleFactor + scrollYCss());
         }
 
         /**
@@ -202,28 +241,28 @@ public class RenderCoordinates {
      * @return Horizontal scroll offset in CSS pixels.
      */
     public float getScrollX() {
-        return mScrollXCss;
+        return scrollXCss();
     }
 
     /**
      * @return Vertical scroll offset in CSS pixels.
      */
     public float getScrollY() {
-        return mScrollYCss;
+        return scrollYCss();
     }
 
     /**
      * @return Horizontal scroll offset in physical pixels.
      */
     public float getScrollXPix() {
-        return fromLocalCssToPix(mScrollXCss);
+        return fromLocalCssToPix(scrollXCss());
     }
 
     /**
      * @return Vertical scroll offset in physical pixels.
      */
     public float getScrollYPix() {
-        return fromLocalCssToPix(mScrollYCss);
+        return fromLocalCssToPix(scrollYCss());
     }
 
     /**
@@ -292,6 +292,24 @@ public class ImeAdapter {
         }
     }
 
+    /**
+     * Returns the text of the field being edited once a change from native is applied.
+     *
+     * @param text The text replacing the range [changeStart, changeEnd) of the text last passed
+     *             to {@link #updateState}, or the whole text if changeStart is -1.
+     * @param changeStart The character offset of the start of the replaced range, or -1.
+     * @param changeEnd The character offset of the end of the replaced range, or -1.
+     */
+    public String applyTextChange(String text, int changeStart, int changeEnd) {
+        if (changeStart == -1) return text;
+        assert mLastText != null && changeEnd <= mLastText.length();
+        return new StringBuilder(mLastText.length() - (changeEnd - changeStart) + text.length())
+                .append(mLastText, 0, changeStart)
+                .append(text)
+                .append(mLastText, changeEnd, mLastText.length())
+                .toString();
+    }
+
     /**
      * Updates internal representation of the text being edited and its selection and composition
      * properties.
@@ -77,6 +77,12 @@ public abstract class ContentSwitches {
     // Native switch kGPUProcess
     public static final String SWITCH_GPU_PROCESS = "gpu-process";
 
+    // Native switch kEBrowserStartupTimings
+    public static final String EBROWSER_STARTUP_TIMINGS = "ebrowser-startup-timings";
+
+    // Native switch kEBrowserWarmRendererPool
+    public static final String EBROWSER_WARM_RENDERER_POOL = "ebrowser-warm-renderer-pool";
+
     // Prevent instantiation.
     private ContentSwitches() {}
 
@@ -372,6 +372,17 @@ class CONTENT_EXPORT RenderProcessHost : public IPC::Sender,
   static RenderProcessHost* GetExistingProcessHost(
       content::BrowserContext* browser_context, const GURL& site_url);
 
+  // Launches a spare renderer for |browser_context| that the next new site
+  // can use without waiting on process launch. After the spare is handed out
+  // it is replaced a little later; it is dropped under memory pressure until
+  // the next call. Does nothing in single-process mode.
+  static void WarmupSpareRenderProcessHost(
+      content::BrowserContext* browser_context);
+
+  // Shuts down the spare renderer, if any, and stops replacing it. Call before
+  // destroying the browser context it was launched for.
+  static void DiscardSpareRenderProcessHost();
+
   // Overrides the default heuristic for limiting the max renderer process
   // count.  This is useful for unit testing process limit behaviors.  It is
   // also used to allow a command line parameter to configure the max number of
@@ -67,6 +67,13 @@ class TracingController {
       const base::FilePath& file_path,
       const base::Closure& callback);
 
+  // Like CreateFileSink(), but gzips the trace. The chunks are compressed and
+  // written on the FILE thread as they arrive, so neither the JSON nor the
+  // compressed trace is ever held in memory whole.
+  CONTENT_EXPORT static scoped_refptr<TraceDataSink> CreateCompressedFileSink(
+      const base::FilePath& file_path,
+      const base::Closure& callback);
+
   // Get a set of category groups. The category groups can change as
   // new code paths are reached.
   //
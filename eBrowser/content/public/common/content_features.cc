@@ -45,6 +45,20 @@ const base::Feature kDefaultEnableGpuRasterization{
 const base::Feature kDocumentWriteEvaluator{"DocumentWriteEvaluator",
                                             base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Paces scrolls by the population frame rate table compiled into the binary
+// until the device's own scroll model arrives, so that first runs save energy
+// too.
+const base::Feature kEBrowserDefaultInputModel{
+    "EBrowserDefaultInputModel", base::FEATURE_ENABLED_BY_DEFAULT};
+
+// Selects the eBrowser input rate policy by field trial: the name of the
+// trial group the feature is associated with is the policy, as named by
+// --ebrowser-input-rate-controller, which takes precedence. Querying the
+// group activates the trial, so every UMA log of the renderer carries the
+// arm it ran.
+const base::Feature kEBrowserInputRateExperiment{
+    "EBrowserInputRateExperiment", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Throttle tasks in Blink background timer queues based on CPU budgets
 // for the background tab. Bug: https://crbug.com/639852.
 const base::Feature kExpensiveBackgroundTimerThrottling{
@@ -140,6 +154,11 @@ const base::Feature kPointerEvents{"PointerEvent",
 const base::Feature kPointerEventV1SpecCapturing{
     "PointerEventV1SpecCapturing", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Dispatches resource messages for higher priority requests first when several
+// are waiting on the renderer's loading task runner.
+const base::Feature kPrioritizeResourceMessages{
+    "PrioritizeResourceMessages", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // RAF aligned input events support.
 const base::Feature kRafAlignedInputEvents{"RafAlignedInput",
                                            base::FEATURE_DISABLED_BY_DEFAULT};
@@ -23,6 +23,8 @@ CONTENT_EXPORT extern const base::Feature kCompositeOpaqueScrollers;
 CONTENT_EXPORT extern const base::Feature kCredentialManagementAPI;
 CONTENT_EXPORT extern const base::Feature kDefaultEnableGpuRasterization;
 CONTENT_EXPORT extern const base::Feature kDocumentWriteEvaluator;
+CONTENT_EXPORT extern const base::Feature kEBrowserDefaultInputModel;
+CONTENT_EXPORT extern const base::Feature kEBrowserInputRateExperiment;
 CONTENT_EXPORT extern const base::Feature kExpensiveBackgroundTimerThrottling;
 CONTENT_EXPORT extern const base::Feature kFeaturePolicy;
 CONTENT_EXPORT extern const base::Feature kFontCacheScaling;
@@ -43,6 +45,7 @@ CONTENT_EXPORT extern const base::Feature kPassiveEventListenersDueToFling;
 CONTENT_EXPORT extern const base::Feature kPepper3DImageChromium;
 CONTENT_EXPORT extern const base::Feature kPointerEvents;
 CONTENT_EXPORT extern const base::Feature kPointerEventV1SpecCapturing;
+CONTENT_EXPORT extern const base::Feature kPrioritizeResourceMessages;
 CONTENT_EXPORT extern const base::Feature kRafAlignedInputEvents;
 CONTENT_EXPORT extern const base::Feature kRenderingPipelineThrottling;
 CONTENT_EXPORT extern const base::Feature kScrollAnchoring;
@@ -323,6 +323,199 @@ const char kDomAutomationController[]       = "dom-automation";
 // Disable antialiasing on 2d canvas clips
 const char kDisable2dCanvasClipAntialiasing[] = "disable-2d-canvas-clip-aa";
 
+// Compiles each eBrowser event rate model into a speed -> frame rate lookup
+// table quantized at the given step (in model speed units, e.g. "0.1"), and
+// uses the table instead of evaluating the model on every scroll update.
+const char kEBrowserPredictorTableStep[] = "ebrowser-predictor-table-step";
+
+// Paces DevTools screencast frames to the encode time and the client's ack
+// round trip, dropping the frames that come sooner before they are read back.
+const char kEBrowserAdaptiveScreencast[] = "ebrowser-adaptive-screencast";
+
+// Keeps fewer saved compositor frames of hidden pages while on battery power,
+// and none while the foreground page runs a throttled interaction.
+const char kEBrowserAdaptiveFrameEviction[] =
+    "ebrowser-adaptive-frame-eviction";
+
+// Caps discardable memory, such as decoded images, at N=value MB while the
+// device runs on battery power. The least recently used segments above it are
+// purged in the background, and the default limit returns on charger.
+const char kEBrowserBatteryDiscardableMemoryLimit[] =
+    "ebrowser-battery-discardable-memory-limit";
+
+// Batches localStorage and sessionStorage commits harder while the device
+// runs on battery power: "<delay_seconds>,<max_commits_per_hour>,
+// <max_kilobytes_per_hour>" for each storage area, e.g. "30,12,512".
+const char kEBrowserBatteryStorageCommits[] =
+    "ebrowser-battery-storage-commits";
+
+// Aims for the battery to last N=value hours after each unplug: while it
+// drains faster than that, renderers paced by the "energy-budget" input rate
+// controller get a share of the full frame rate's power in proportion.
+const char kEBrowserBatteryLifeTarget[] = "ebrowser-battery-life-target";
+
+// Caps the power of paced gestures at N=value mW on the device's energy
+// curve, under the "energy-budget" input rate controller.
+const char kEBrowserEnergyBudget[] = "ebrowser-energy-budget";
+
+// How far ahead of a scroll, in milliseconds of its current velocity, the
+// compositor prepaints tiles in the scroll direction.
+const char kEBrowserPrepaintTime[] = "ebrowser-prepaint-time";
+
+// Launches the GPU process as soon as the browser's GPU channel factory is
+// set up, so that it starts up in parallel with the rest of browser startup.
+const char kEBrowserParallelStartup[] = "ebrowser-parallel-startup";
+
+// Logs how long each browser startup task ran once startup is complete, and on
+// Android how long the shell took to load its native library.
+const char kEBrowserStartupTimings[] = "ebrowser-startup-timings";
+
+// Keeps one launched renderer ready after startup so that navigating to a new
+// site does not wait on renderer process launch.
+const char kEBrowserSpareRenderer[] = "ebrowser-spare-renderer";
+
+// Ends compositor flings once they would move the content less than the given
+// number of physical pixels per frame at the rate they are paced at, e.g.
+// "0.5", instead of animating their sub-pixel tail.
+const char kEBrowserFlingCutoff[] = "ebrowser-fling-cutoff";
+
+// Rasters scrolls and flings faster than the given number of physical pixels
+// per second at the given fraction of the device scale factor, scaled back up
+// when composited, e.g. "4000,0.5". Full resolution returns once they slow to
+// half that speed or the fling stops.
+const char kEBrowserFlingRasterScale[] = "ebrowser-fling-raster-scale";
+
+// Prerenders a strip this percent of the viewport deep ahead of throttled
+// scrolls slow enough not to outrun it, on raster threads that would
+// otherwise sleep between frames, e.g. "50".
+const char kEBrowserReadingPrerenderStrip[] =
+    "ebrowser-reading-prerender-strip";
+
+// Caps the BeginFrame rate of visible widgets the user is not interacting
+// with: "<idle>,<occluded>[,<audible occluded>]" frame rates, e.g. "30,10,2",
+// for widgets without recent input, for widgets whose window has lost focus,
+// and for those of the latter that are playing sound.
+const char kEBrowserFrameRateBudget[] = "ebrowser-frame-rate-budget";
+
+// Overrides the rate policy of gesture classes, as comma separated
+// "<class>=<policy>" pairs, e.g. "fling=model:20-60,drag=60". The classes are
+// scroll, drag, fling and pinch; a policy is either a fixed frame rate or
+// "model:<min>-<max>" to bound the rate the models pick.
+const char kEBrowserGestureRatePolicies[] = "ebrowser-gesture-rate-policies";
+
+// Recycles the shared memory GpuMemoryBuffers child processes delete for
+// their next allocation of the same size, format and usage, holding on to at
+// most N=value megabytes of each process's buffers.
+const char kEBrowserGpuMemoryBufferPool[] = "ebrowser-gpu-memory-buffer-pool";
+
+// On Android, sends the text of the focused field to the browser and on to the
+// Java ImeAdapter as the range that changed since the last update instead of
+// the whole text, once the field holds a few hundred characters.
+const char kEBrowserImeTextDeltas[] = "ebrowser-ime-text-deltas";
+
+// Holds non-blocking input events, such as uncancelable touch moves, for up to
+// N=value milliseconds so that those arriving together reach the renderer in
+// one IPC.
+const char kEBrowserInputBatchWindow[] = "ebrowser-input-batch-window";
+
+// Selects how the compositor thread paces gestures from the eBrowser event
+// rate models: "svr-sleep" (the default) coalesces input to the predicted
+// rate, "begin-frame" only decimates BeginFrames to it, "table" uses the
+// compiled lookup table alone, "energy-budget" coalesces like "svr-sleep"
+// within the power --ebrowser-energy-budget and
+// --ebrowser-battery-life-target allow, and "none" disables pacing. Without
+// it the EBrowserInputRateExperiment field trial picks the policy.
+const char kEBrowserInputRateController[] = "ebrowser-input-rate-controller";
+
+// Holds back low-priority and prefetch loads of a page while the user scrolls
+// it, and until the given grace period in milliseconds, e.g. "500", has
+// passed after the scroll or fling ends.
+const char kEBrowserInteractionAwareLoading[] =
+    "ebrowser-interaction-aware-loading";
+
+// Shares the scroll offset with Java's RenderCoordinates through a direct
+// buffer, so that the frames of a scroll or fling that only move the page do
+// not call into Java; Java is updated when the gesture ends. Selection handle
+// moves during the gesture are held back until then too.
+const char kEBrowserLazyScrollFrameInfo[] = "ebrowser-lazy-scroll-frame-info";
+
+// Lets the Android browser compositor swap only the damaged part of the
+// window, using EGL_KHR_swap_buffers_with_damage when EGL_NV_post_sub_buffer
+// is unavailable.
+const char kEBrowserPartialSwap[] = "ebrowser-partial-swap";
+
+// Starts cameras at no more than the given frame rate and height while on
+// battery power, e.g. "15,480", restarting them when the power source
+// changes. The lowered format is shown in chrome://media-internals.
+const char kEBrowserPowerSavingCapture[] = "ebrowser-power-saving-capture";
+
+// Puts background renderers into the power-saving memory state, which purges
+// their caches and suspends their timers, while on battery power at or below
+// the given battery percentage, e.g. "20".
+const char kEBrowserPowerSavingMemoryState[] =
+    "ebrowser-power-saving-memory-state";
+
+// Moves the renderer's compositor and raster threads onto the efficiency
+// cores of big.LITTLE CPUs while a gesture is throttled below the given frame
+// rate, e.g. "30".
+const char kEBrowserPowerSavingThreadPlacement[] =
+    "ebrowser-power-saving-thread-placement";
+
+// Batches the lowest priority delayable loads, such as prefetches and
+// offscreen images: they start alongside other network activity, or together
+// once they have waited for the given window in milliseconds, e.g. "2000".
+const char kEBrowserRadioBatchingWindow[] = "ebrowser-radio-batching-window";
+
+// Reads all the stored scripts of an installed service worker into memory, in
+// parallel, when it starts, up to the given value in KB in total, e.g. "512",
+// and serves the worker's script requests from there instead of one disk
+// cache read after another.
+const char kEBrowserServiceWorkerScriptPreload[] =
+    "ebrowser-service-worker-script-preload";
+
+// Keeps a log of the most recently used GPU shaders and, when the shader cache
+// is opened, sends only the first N=value of them to the GPU process, one at
+// a time, instead of every cached shader in cache order.
+const char kEBrowserShaderCachePrewarm[] = "ebrowser-shader-cache-prewarm";
+
+// Keeps the shared bitmaps software compositing deletes, up to N=value
+// megabytes of them, for the next allocation of the same size, so that the
+// child neither maps new memory nor registers it with the browser again.
+const char kEBrowserSharedBitmapPool[] = "ebrowser-shared-bitmap-pool";
+
+// Has child processes record their histograms into shared memory that the
+// browser reads directly, instead of pickling them over IPC on each fetch.
+const char kEBrowserSharedChildHistograms[] =
+    "ebrowser-shared-child-histograms";
+
+// Sizes the data pipe of each Mojo-loaded response body to its expected
+// content size, up to 4MB, so that large bodies are written and consumed in
+// place in as few chunks as possible.
+const char kEBrowserSizedBodyDataPipes[] = "ebrowser-sized-body-data-pipes";
+
+// Also runs requestAnimationFrame callbacks and main thread animations at the
+// predicted frame rate while a gesture is throttled, rather than at the rate
+// of the main frames.
+const char kEBrowserThrottleAnimationFrames[] =
+    "ebrowser-throttle-animation-frames";
+
+// Raises the swap interval of the browser compositor's window surface to the
+// number of display refreshes per frame while an interaction is throttled,
+// so that the display controller paces presentation.
+const char kEBrowserThrottledSwapInterval[] =
+    "ebrowser-throttled-swap-interval";
+
+// Runs setTimeout and setInterval callbacks at the main frames while a
+// gesture is throttled, holding each no longer than the given delay in
+// milliseconds, e.g. "100".
+const char kEBrowserTimerFrameAlignment[] = "ebrowser-timer-frame-alignment";
+
+// On Android, keeps up to three sandboxed services bound ahead of renderer
+// launches instead of one, sized by the app's memory class and by how often
+// renderers have been launched in the last minute, and rebinds them as
+// launches take them.
+const char kEBrowserWarmRendererPool[] = "ebrowser-warm-renderer-pool";
+
 // Disable partially decoding jpeg images using the GPU.
 // At least YUV decoding will be accelerated when not using this flag.
 // Has no effect unless GPU rasterization is enabled.
@@ -419,6 +612,10 @@ const char kEnableNetworkInformation[]      = "enable-network-information";
 // Disables the video decoder from drawing to an NV12 textures instead of ARGB.
 const char kDisableNv12DxgiVideo[] = "disable-nv12-dxgi-video";
 
+// Lets out-of-process Pepper plugins coalesce the asynchronous resource calls
+// made during a task into a single IPC to the renderer.
+const char kEnablePepperMessageBatching[]   = "enable-pepper-message-batching";
+
 // Enables compositor-accelerated touch-screen pinch gestures.
 const char kEnablePinch[]                   = "enable-pinch";
 
@@ -104,6 +104,42 @@ CONTENT_EXPORT extern const char kDisableZeroCopy[];
 CONTENT_EXPORT extern const char kDisableZeroCopyDxgiVideo[];
 CONTENT_EXPORT extern const char kDomAutomationController[];
 extern const char kDisable2dCanvasClipAntialiasing[];
+CONTENT_EXPORT extern const char kEBrowserAdaptiveFrameEviction[];
+CONTENT_EXPORT extern const char kEBrowserAdaptiveScreencast[];
+CONTENT_EXPORT extern const char kEBrowserBatteryDiscardableMemoryLimit[];
+CONTENT_EXPORT extern const char kEBrowserBatteryLifeTarget[];
+CONTENT_EXPORT extern const char kEBrowserBatteryStorageCommits[];
+CONTENT_EXPORT extern const char kEBrowserEnergyBudget[];
+CONTENT_EXPORT extern const char kEBrowserFlingCutoff[];
+CONTENT_EXPORT extern const char kEBrowserFlingRasterScale[];
+CONTENT_EXPORT extern const char kEBrowserFrameRateBudget[];
+CONTENT_EXPORT extern const char kEBrowserGestureRatePolicies[];
+CONTENT_EXPORT extern const char kEBrowserGpuMemoryBufferPool[];
+CONTENT_EXPORT extern const char kEBrowserImeTextDeltas[];
+CONTENT_EXPORT extern const char kEBrowserInputBatchWindow[];
+CONTENT_EXPORT extern const char kEBrowserInputRateController[];
+CONTENT_EXPORT extern const char kEBrowserInteractionAwareLoading[];
+CONTENT_EXPORT extern const char kEBrowserLazyScrollFrameInfo[];
+CONTENT_EXPORT extern const char kEBrowserParallelStartup[];
+CONTENT_EXPORT extern const char kEBrowserPartialSwap[];
+CONTENT_EXPORT extern const char kEBrowserPowerSavingCapture[];
+CONTENT_EXPORT extern const char kEBrowserPowerSavingMemoryState[];
+CONTENT_EXPORT extern const char kEBrowserPowerSavingThreadPlacement[];
+CONTENT_EXPORT extern const char kEBrowserPredictorTableStep[];
+CONTENT_EXPORT extern const char kEBrowserPrepaintTime[];
+CONTENT_EXPORT extern const char kEBrowserRadioBatchingWindow[];
+CONTENT_EXPORT extern const char kEBrowserReadingPrerenderStrip[];
+CONTENT_EXPORT extern const char kEBrowserServiceWorkerScriptPreload[];
+CONTENT_EXPORT extern const char kEBrowserShaderCachePrewarm[];
+CONTENT_EXPORT extern const char kEBrowserSharedBitmapPool[];
+CONTENT_EXPORT extern const char kEBrowserSharedChildHistograms[];
+CONTENT_EXPORT extern const char kEBrowserSizedBodyDataPipes[];
+CONTENT_EXPORT extern const char kEBrowserSpareRenderer[];
+CONTENT_EXPORT extern const char kEBrowserStartupTimings[];
+CONTENT_EXPORT extern const char kEBrowserThrottleAnimationFrames[];
+CONTENT_EXPORT extern const char kEBrowserThrottledSwapInterval[];
+CONTENT_EXPORT extern const char kEBrowserTimerFrameAlignment[];
+CONTENT_EXPORT extern const char kEBrowserWarmRendererPool[];
 CONTENT_EXPORT extern const char kEnableAggressiveDOMStorageFlushing[];
 CONTENT_EXPORT extern const char kEnablePreferCompositingToLCDText[];
 CONTENT_EXPORT extern const char kEnableBlinkFeatures[];
@@ -135,6 +171,7 @@ CONTENT_EXPORT extern const char kEnableLogging[];
 extern const char kEnableMemoryBenchmarking[];
 CONTENT_EXPORT extern const char kEnableNetworkInformation[];
 CONTENT_EXPORT extern const char kDisableNv12DxgiVideo[];
+CONTENT_EXPORT extern const char kEnablePepperMessageBatching[];
 CONTENT_EXPORT extern const char kEnablePinch[];
 CONTENT_EXPORT extern const char kEnablePluginPlaceholderTesting[];
 CONTENT_EXPORT extern const char kEnablePreciseMemoryInfo[];
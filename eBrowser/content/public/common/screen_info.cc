@@ -19,7 +19,9 @@ bool ScreenInfo::operator==(const ScreenInfo& other) const {
          rect == other.rect &&
          available_rect == other.available_rect &&
          orientation_type == other.orientation_type &&
-         orientation_angle == other.orientation_angle;
+         orientation_angle == other.orientation_angle &&
+         refresh_rate == other.refresh_rate &&
+         supported_refresh_rates == other.supported_refresh_rates;
 }
 
 bool ScreenInfo::operator!=(const ScreenInfo& other) const {
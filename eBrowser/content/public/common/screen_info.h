@@ -5,6 +5,8 @@
 #ifndef CONTENT_PUBLIC_COMMON_SCREEN_INFO_H_
 #define CONTENT_PUBLIC_COMMON_SCREEN_INFO_H_
 
+#include <vector>
+
 #include "content/common/content_export.h"
 #include "content/public/common/screen_orientation_values.h"
 #include "ui/gfx/geometry/rect.h"
@@ -51,6 +53,13 @@ struct CONTENT_EXPORT ScreenInfo {
     // It is the opposite of the physical rotation.
     uint16_t orientation_angle = 0;
 
+    // The rate the display refreshes at, in Hz, or 0 if it is not known.
+    float refresh_rate = 0.f;
+
+    // The rates, in Hz and ascending, the display can switch to. Empty if
+    // only |refresh_rate| is known.
+    std::vector<float> supported_refresh_rates;
+
     bool operator==(const ScreenInfo& other) const;
     bool operator!=(const ScreenInfo& other) const;
 };
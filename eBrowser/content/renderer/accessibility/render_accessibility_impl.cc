@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <queue>
 
 #include "base/bind.h"
@@ -17,8 +18,10 @@
 #include "build/build_config.h"
 #include "content/common/accessibility_messages.h"
 #include "content/renderer/accessibility/blink_ax_enum_conversion.h"
+#include "content/renderer/gpu/render_widget_compositor.h"
 #include "content/renderer/render_frame_impl.h"
 #include "content/renderer/render_view_impl.h"
+#include "content/renderer/render_widget.h"
 #include "third_party/WebKit/public/platform/WebFloatRect.h"
 #include "third_party/WebKit/public/web/WebAXObject.h"
 #include "third_party/WebKit/public/web/WebDocument.h"
@@ -28,6 +31,7 @@
 #include "third_party/WebKit/public/web/WebUserGestureIndicator.h"
 #include "third_party/WebKit/public/web/WebView.h"
 #include "ui/accessibility/ax_node.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 
 using blink::WebAXObject;
 using blink::WebDocument;
@@ -232,10 +236,7 @@ void RenderAccessibilityImpl::HandleAXEvent(
     // When no accessibility events are in-flight post a task to send
     // the events to the browser. We use PostTask so that we can queue
     // up additional events.
-    base::ThreadTaskRunnerHandle::Get()->PostTask(
-        FROM_HERE,
-        base::Bind(&RenderAccessibilityImpl::SendPendingAccessibilityEvents,
-                   weak_factory_.GetWeakPtr()));
+    ScheduleSendPendingAccessibilityEvents();
   }
 }
 
@@ -300,6 +301,7 @@ void RenderAccessibilityImpl::SendPendingAccessibilityEvents() {
     return;
 
   ack_pending_ = true;
+  last_send_time_ = base::TimeTicks::Now();
 
   // Make a copy of the events, because it's possible that
   // actions inside this loop will cause more events to be
@@ -313,6 +315,11 @@ void RenderAccessibilityImpl::SendPendingAccessibilityEvents() {
   // If there's a layout complete message, we need to send location changes.
   bool had_layout_complete_messages = false;
 
+  // The nodes already in this batch's updates. The tree cannot change while
+  // the batch is serialized, so an event on one of them needs no update of
+  // its own; scrolling fires several events on the same few nodes per frame.
+  base::hash_set<int> serialized_node_ids;
+
   // Loop over each event and generate an updated event message.
   for (size_t i = 0; i < src_events.size(); ++i) {
     AccessibilityHostMsg_EventParams& event = src_events[i];
@@ -341,6 +348,10 @@ void RenderAccessibilityImpl::SendPendingAccessibilityEvents() {
     event_msg.event_type = event.event_type;
     event_msg.id = event.id;
     event_msg.event_from = event.event_from;
+    if (serialized_node_ids.count(obj.axID())) {
+      event_msgs.push_back(event_msg);
+      continue;
+    }
     if (!serializer_.SerializeChanges(obj, &event_msg.update)) {
       LOG(ERROR) << "Failed to serialize one accessibility event.";
       continue;
@@ -355,6 +366,7 @@ void RenderAccessibilityImpl::SendPendingAccessibilityEvents() {
     // ids to locations.
     for (size_t i = 0; i < event_msg.update.nodes.size(); ++i) {
       ui::AXNodeData& src = event_msg.update.nodes[i];
+      serialized_node_ids.insert(src.id);
       ui::AXRelativeBounds& dst = locations_[event_msg.update.nodes[i].id];
       dst.offset_container_id = src.offset_container_id;
       dst.bounds = src.location;
@@ -376,6 +388,24 @@ void RenderAccessibilityImpl::SendPendingAccessibilityEvents() {
     SendLocationChanges();
 }
 
+void RenderAccessibilityImpl::ScheduleSendPendingAccessibilityEvents() {
+  base::TimeDelta delay =
+      last_send_time_ + MinSendInterval() - base::TimeTicks::Now();
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&RenderAccessibilityImpl::SendPendingAccessibilityEvents,
+                 weak_factory_.GetWeakPtr()),
+      std::max(delay, base::TimeDelta()));
+}
+
+base::TimeDelta RenderAccessibilityImpl::MinSendInterval() {
+  int fps = ui::ScrollUpdatePacer::kMaxFrameRate;
+  RenderWidget* widget = render_frame_->GetRenderWidget();
+  if (widget && widget->compositor())
+    fps = widget->compositor()->target_frame_rate();
+  return base::TimeDelta::FromSecondsD(1.0 / std::max(fps, 1));
+}
+
 void RenderAccessibilityImpl::SendLocationChanges() {
   std::vector<AccessibilityHostMsg_LocationChangeParams> messages;
 
@@ -502,7 +532,12 @@ void RenderAccessibilityImpl::OnEventsAck(int ack_token) {
 
   DCHECK(ack_pending_);
   ack_pending_ = false;
-  SendPendingAccessibilityEvents();
+  if (pending_events_.empty() || weak_factory_.HasWeakPtrs())
+    return;
+  if (base::TimeTicks::Now() - last_send_time_ >= MinSendInterval())
+    SendPendingAccessibilityEvents();
+  else
+    ScheduleSendPendingAccessibilityEvents();
 }
 
 void RenderAccessibilityImpl::OnFatalError() {
@@ -10,6 +10,7 @@
 #include "base/containers/hash_tables.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/common/ax_content_node_data.h"
 #include "content/public/renderer/render_accessibility.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -106,6 +107,15 @@ class CONTENT_EXPORT RenderAccessibilityImpl
   // Send queued events from the renderer to the browser.
   void SendPendingAccessibilityEvents();
 
+  // Posts a task to send the queued events, at least MinSendInterval()
+  // after the previous batch, so that events coalesce into one batch per
+  // frame of the interaction.
+  void ScheduleSendPendingAccessibilityEvents();
+
+  // One frame at the rate the widget's interactions are currently paced at,
+  // which eBrowser lowers for throttled scrolls.
+  base::TimeDelta MinSendInterval();
+
   // Check the entire accessibility tree to see if any nodes have
   // changed location, by comparing their locations to the cached
   // versions. If any have moved, send an IPC with the new locations.
@@ -160,6 +170,9 @@ class CONTENT_EXPORT RenderAccessibilityImpl
   // Set if we are waiting for an accessibility event ack.
   bool ack_pending_;
 
+  // When the last batch of events was sent.
+  base::TimeTicks last_send_time_;
+
   // Nonzero if the browser requested we reset the accessibility state.
   // We need to return this token in the next IPC.
   int reset_token_;
@@ -0,0 +1,206 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/hash_tables.h"
+#include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "content/common/accessibility_messages.h"
+#include "content/common/ax_content_node_data.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/accessibility/ax_node.h"
+#include "ui/accessibility/ax_tree.h"
+#include "ui/accessibility/ax_tree_serializer.h"
+#include "ui/accessibility/ax_tree_source.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace content {
+
+namespace {
+
+const int kRoutingId = 1;
+const int kRootId = 1;
+const int kParagraphs = 500;
+// A two second fling at 60 fps.
+const int kScrollFrames = 120;
+const int kPixelsPerFrame = 40;
+
+// Exposes a ui::AXTree the way BlinkAXTreeSource exposes Blink's, so that
+// the serializer produces the updates RenderAccessibilityImpl sends.
+class ContentTreeSource
+    : public ui::AXTreeSource<const ui::AXNode*,
+                              AXContentNodeData,
+                              AXContentTreeData> {
+ public:
+  explicit ContentTreeSource(ui::AXTree* tree) : tree_(tree) {}
+  ~ContentTreeSource() override {}
+
+  bool GetTreeData(AXContentTreeData* data) const override {
+    *static_cast<ui::AXTreeData*>(data) = tree_->data();
+    return true;
+  }
+  const ui::AXNode* GetRoot() const override { return tree_->root(); }
+  const ui::AXNode* GetFromId(int32_t id) const override {
+    return tree_->GetFromId(id);
+  }
+  int32_t GetId(const ui::AXNode* node) const override { return node->id(); }
+  void GetChildren(
+      const ui::AXNode* node,
+      std::vector<const ui::AXNode*>* out_children) const override {
+    for (int i = 0; i < node->child_count(); ++i)
+      out_children->push_back(node->ChildAtIndex(i));
+  }
+  const ui::AXNode* GetParent(const ui::AXNode* node) const override {
+    return node->parent();
+  }
+  bool IsValid(const ui::AXNode* node) const override { return !!node; }
+  bool IsEqual(const ui::AXNode* node1,
+               const ui::AXNode* node2) const override {
+    return node1 == node2;
+  }
+  const ui::AXNode* GetNull() const override { return nullptr; }
+  void SerializeNode(const ui::AXNode* node,
+                     AXContentNodeData* out_data) const override {
+    *static_cast<ui::AXNodeData*>(out_data) = node->data();
+  }
+
+ private:
+  ui::AXTree* tree_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContentTreeSource);
+};
+
+using ContentTreeSerializer =
+    ui::AXTreeSerializer<const ui::AXNode*,
+                         AXContentNodeData,
+                         AXContentTreeData>;
+
+// A long article: a root web area of paragraphs of static text.
+ui::AXTreeUpdate CreatePage() {
+  ui::AXTreeUpdate update;
+  update.root_id = kRootId;
+  ui::AXNodeData root;
+  root.id = kRootId;
+  root.role = ui::AX_ROLE_ROOT_WEB_AREA;
+  root.SetName("A long article");
+  root.AddStringAttribute(ui::AX_ATTR_URL, "https://example.com/article");
+  root.AddIntAttribute(ui::AX_ATTR_SCROLL_X_MAX, 0);
+  root.AddIntAttribute(ui::AX_ATTR_SCROLL_Y_MAX, kParagraphs * 100);
+  root.AddIntAttribute(ui::AX_ATTR_SCROLL_Y, 0);
+  root.location = gfx::RectF(0, 0, 360, 640);
+  update.nodes.push_back(root);
+  for (int i = 0; i < kParagraphs; ++i) {
+    ui::AXNodeData paragraph;
+    paragraph.id = 2 + 2 * i;
+    paragraph.role = ui::AX_ROLE_PARAGRAPH;
+    paragraph.location = gfx::RectF(0, 100 * i, 360, 100);
+    paragraph.child_ids.push_back(paragraph.id + 1);
+    update.nodes[0].child_ids.push_back(paragraph.id);
+    update.nodes.push_back(paragraph);
+
+    ui::AXNodeData text;
+    text.id = paragraph.id + 1;
+    text.role = ui::AX_ROLE_STATIC_TEXT;
+    text.SetName("Paragraph " + base::IntToString(i) +
+                 " of a page that a screen reader user scrolls through.");
+    text.location = paragraph.location;
+    update.nodes.push_back(text);
+  }
+  return update;
+}
+
+struct ScrollCost {
+  size_t bytes = 0;
+  base::TimeDelta time;
+};
+
+// Scrolls the page once, sending a batch every |1 / batch_fps| seconds the
+// way RenderAccessibilityImpl does: Blink fires a scroll position change on
+// the root, and the scroll offset check adds a layout complete on it.
+ScrollCost Scroll(int batch_fps, bool skip_serialized_nodes) {
+  ui::AXTree tree(CreatePage());
+  ContentTreeSource source(&tree);
+  ContentTreeSerializer serializer(&source);
+  AXContentTreeUpdate initial_update;
+  EXPECT_TRUE(serializer.SerializeChanges(source.GetRoot(), &initial_update));
+
+  const int frames_per_batch =
+      ui::ScrollUpdatePacer::kMaxFrameRate / batch_fps;
+  const ui::AXEvent kEvents[] = {ui::AX_EVENT_SCROLL_POSITION_CHANGED,
+                                 ui::AX_EVENT_LAYOUT_COMPLETE};
+  ScrollCost cost;
+  for (int frame = 1; frame <= kScrollFrames; ++frame) {
+    ui::AXNodeData root = tree.root()->data();
+    for (auto& attribute : root.int_attributes) {
+      if (attribute.first == ui::AX_ATTR_SCROLL_Y)
+        attribute.second = frame * kPixelsPerFrame;
+    }
+    ui::AXTreeUpdate scroll;
+    scroll.nodes.push_back(root);
+    EXPECT_TRUE(tree.Unserialize(scroll));
+    if (frame % frames_per_batch)
+      continue;
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    std::vector<AccessibilityHostMsg_EventParams> events;
+    base::hash_set<int> serialized_node_ids;
+    for (ui::AXEvent event_type : kEvents) {
+      AccessibilityHostMsg_EventParams event;
+      event.id = kRootId;
+      event.event_type = event_type;
+      event.event_from = ui::AX_EVENT_FROM_USER;
+      if (!skip_serialized_nodes || !serialized_node_ids.count(kRootId)) {
+        EXPECT_TRUE(serializer.SerializeChanges(tree.root(), &event.update));
+        for (const auto& node : event.update.nodes)
+          serialized_node_ids.insert(node.id);
+      }
+      events.push_back(event);
+    }
+    AccessibilityHostMsg_Events message(kRoutingId, events, 0, 0);
+    cost.time += base::TimeTicks::Now() - start;
+    cost.bytes += message.size();
+  }
+  return cost;
+}
+
+}  // namespace
+
+TEST(RenderAccessibilityPerfTest, ScrollUpdates) {
+  struct {
+    const char* trace;
+    int batch_fps;
+    bool skip_serialized_nodes;
+  } kConfigs[] = {
+      {"per_event_60fps", 60, false},
+      {"coalesced_60fps", 60, true},
+      {"coalesced_30fps", 30, true},
+      {"coalesced_20fps", 20, true},
+      {"coalesced_10fps", 10, true},
+  };
+  const int kIterations = 20;
+  for (const auto& config : kConfigs) {
+    ScrollCost total;
+    for (int i = 0; i < kIterations; ++i) {
+      ScrollCost cost = Scroll(config.batch_fps, config.skip_serialized_nodes);
+      total.bytes += cost.bytes;
+      total.time += cost.time;
+    }
+    perf_test::PrintResult("bytes_per_scroll", "", config.trace,
+                           total.bytes / kIterations, "bytes", true);
+    perf_test::PrintResult(
+        "serialize_time_per_scroll", "", config.trace,
+        static_cast<size_t>(total.time.InMicroseconds() / kIterations), "us",
+        true);
+  }
+}
+
+}  // namespace content
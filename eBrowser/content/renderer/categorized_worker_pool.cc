@@ -4,15 +4,18 @@
 
 #include "content/renderer/categorized_worker_pool.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/strings/stringprintf.h"
+#include "base/threading/platform_thread.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_event.h"
 #include "cc/base/math_util.h"
 #include "cc/raster/task_category.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 
 namespace content {
 namespace {
@@ -123,11 +126,21 @@ CategorizedWorkerPool::CategorizedWorkerPool()
       has_ready_to_run_foreground_tasks_cv_(&lock_),
       has_ready_to_run_background_tasks_cv_(&lock_),
       has_namespaces_with_finished_running_tasks_cv_(&lock_),
-      shutdown_(false) {}
+      shutdown_(false),
+      num_foreground_threads_(0),
+      num_active_foreground_threads_(0),
+      num_prepaint_boost_tasks_(0),
+      num_idle_prerender_tasks_(0) {}
 
 void CategorizedWorkerPool::Start(int num_threads) {
   DCHECK(threads_.empty());
 
+  {
+    base::AutoLock lock(lock_);
+    num_foreground_threads_ = num_threads;
+    num_active_foreground_threads_ = num_threads;
+  }
+
   // Start |num_threads| threads for foreground work, including nonconcurrent
   // foreground work.
   std::vector<cc::TaskCategory> foreground_categories;
@@ -160,6 +173,73 @@ void CategorizedWorkerPool::Start(int num_threads) {
   threads_.push_back(std::move(thread));
 }
 
+std::vector<base::PlatformThreadId>
+CategorizedWorkerPool::foreground_worker_thread_ids() const {
+  // All but the last thread, which runs background work.
+  std::vector<base::PlatformThreadId> thread_ids;
+  for (size_t i = 0; i + 1 < threads_.size(); ++i)
+    thread_ids.push_back(threads_[i]->tid());
+  return thread_ids;
+}
+
+void CategorizedWorkerPool::SetTargetFrameRate(int fps) {
+  base::AutoLock lock(lock_);
+
+  int num_active_threads =
+      NumActiveForegroundThreads(num_foreground_threads_, fps);
+  if (num_active_threads == num_active_foreground_threads_)
+    return;
+
+  TRACE_EVENT2("cc", "CategorizedWorkerPool::SetTargetFrameRate", "fps", fps,
+               "active_threads", num_active_threads);
+  bool more_threads = num_active_threads > num_active_foreground_threads_;
+  num_active_foreground_threads_ = num_active_threads;
+
+  // Wake the threads that may run tasks again; extra threads find nothing to
+  // do and go back to sleep.
+  if (more_threads)
+    has_ready_to_run_foreground_tasks_cv_.Broadcast();
+}
+
+// static
+int CategorizedWorkerPool::NumActiveForegroundThreads(int num_threads,
+                                                      int fps) {
+  const int kMaxFrameRate = ui::ScrollUpdatePacer::kMaxFrameRate;
+  if (fps >= kMaxFrameRate)
+    return num_threads;
+  int num_active_threads =
+      (num_threads * std::max(fps, 0) + kMaxFrameRate - 1) / kMaxFrameRate;
+  return std::min(num_threads, std::max(1, num_active_threads));
+}
+
+void CategorizedWorkerPool::SetPrepaintBoost(int num_tasks) {
+  base::AutoLock lock(lock_);
+
+  num_tasks = std::max(num_tasks, 0);
+  if (num_tasks == num_prepaint_boost_tasks_)
+    return;
+  TRACE_EVENT1("cc", "CategorizedWorkerPool::SetPrepaintBoost", "tasks",
+               num_tasks);
+  bool more_tasks = num_tasks > num_prepaint_boost_tasks_;
+  num_prepaint_boost_tasks_ = num_tasks;
+  if (more_tasks)
+    SignalHasReadyToRunTasksWithLockAcquired();
+}
+
+void CategorizedWorkerPool::SetIdlePrerender(int num_tasks) {
+  base::AutoLock lock(lock_);
+
+  num_tasks = std::max(num_tasks, 0);
+  if (num_tasks == num_idle_prerender_tasks_)
+    return;
+  TRACE_EVENT1("cc", "CategorizedWorkerPool::SetIdlePrerender", "tasks",
+               num_tasks);
+  bool more_tasks = num_tasks > num_idle_prerender_tasks_;
+  num_idle_prerender_tasks_ = num_tasks;
+  if (more_tasks)
+    SignalHasReadyToRunTasksWithLockAcquired();
+}
+
 void CategorizedWorkerPool::Shutdown() {
   WaitForTasksToFinishRunning(namespace_token_);
   CollectCompletedTasks(namespace_token_, &completed_tasks_);
@@ -335,15 +415,58 @@ bool CategorizedWorkerPool::RunTaskWithLockAcquired(
     const std::vector<cc::TaskCategory>& categories) {
   for (const auto& category : categories) {
     if (ShouldRunTaskForCategoryWithLockAcquired(category)) {
-      RunTaskInCategoryWithLockAcquired(category);
+      RunTaskInCategoryWithLockAcquired(category, false);
       return true;
     }
   }
+  if (std::find(categories.begin(), categories.end(),
+                cc::TASK_CATEGORY_FOREGROUND) == categories.end()) {
+    return false;
+  }
+  // Foreground threads help with the prepaint tiles while boosted, and
+  // prerender the ones after them while they would otherwise sleep.
+  if (ShouldBoostPrepaintWithLockAcquired()) {
+    RunTaskInCategoryWithLockAcquired(cc::TASK_CATEGORY_BACKGROUND, false);
+    return true;
+  }
+  if (ShouldRunIdlePrerenderWithLockAcquired()) {
+    RunTaskInCategoryWithLockAcquired(cc::TASK_CATEGORY_BACKGROUND, true);
+    return true;
+  }
   return false;
 }
 
+bool CategorizedWorkerPool::ShouldBoostPrepaintWithLockAcquired() {
+  lock_.AssertAcquired();
+
+  if (!num_prepaint_boost_tasks_ ||
+      !ShouldRunTaskForCategoryWithLockAcquired(cc::TASK_CATEGORY_BACKGROUND)) {
+    return false;
+  }
+  // Counts the background thread's task too, which may start one more besides.
+  size_t max_boosted_tasks = static_cast<size_t>(
+      std::min(num_prepaint_boost_tasks_, num_active_foreground_threads_));
+  return work_queue_.NumRunningTasksForCategory(
+             cc::TASK_CATEGORY_BACKGROUND) < max_boosted_tasks;
+}
+
+bool CategorizedWorkerPool::ShouldRunIdlePrerenderWithLockAcquired() {
+  lock_.AssertAcquired();
+
+  if (!num_idle_prerender_tasks_ ||
+      !ShouldRunTaskForCategoryWithLockAcquired(cc::TASK_CATEGORY_BACKGROUND)) {
+    return false;
+  }
+  size_t max_prerender_tasks = static_cast<size_t>(
+      std::min(num_prepaint_boost_tasks_ + num_idle_prerender_tasks_,
+               num_active_foreground_threads_));
+  return work_queue_.NumRunningTasksForCategory(
+             cc::TASK_CATEGORY_BACKGROUND) < max_prerender_tasks;
+}
+
 void CategorizedWorkerPool::RunTaskInCategoryWithLockAcquired(
-    cc::TaskCategory category) {
+    cc::TaskCategory category,
+    bool idle_priority) {
   TRACE_EVENT0("toplevel", "TaskGraphRunner::RunTask");
 
   lock_.AssertAcquired();
@@ -356,7 +479,24 @@ void CategorizedWorkerPool::RunTaskInCategoryWithLockAcquired(
   {
     base::AutoUnlock unlock(lock_);
 
+#if !defined(OS_MACOSX)
+    // The thread must be able to return to normal priority afterwards.
+    idle_priority = idle_priority &&
+                    base::PlatformThread::CanIncreaseCurrentThreadPriority();
+    if (idle_priority) {
+      base::PlatformThread::SetCurrentThreadPriority(
+          base::ThreadPriority::BACKGROUND);
+    }
+#endif
+
     prioritized_task.task->RunOnWorkerThread();
+
+#if !defined(OS_MACOSX)
+    if (idle_priority) {
+      base::PlatformThread::SetCurrentThreadPriority(
+          base::ThreadPriority::NORMAL);
+    }
+#endif
   }
 
   auto* task_namespace = prioritized_task.task_namespace;
@@ -390,6 +530,13 @@ bool CategorizedWorkerPool::ShouldRunTaskForCategoryWithLockAcquired(
       return false;
   }
 
+  // Leave the foreground threads beyond the target frame rate's share idle.
+  if (category == cc::TASK_CATEGORY_FOREGROUND &&
+      work_queue_.NumRunningTasksForCategory(cc::TASK_CATEGORY_FOREGROUND) >=
+          static_cast<size_t>(num_active_foreground_threads_)) {
+    return false;
+  }
+
   // Enforce that only one nonconcurrent task runs at a time.
   if (category == cc::TASK_CATEGORY_NONCONCURRENT_FOREGROUND &&
       work_queue_.NumRunningTasksForCategory(
@@ -405,7 +552,9 @@ void CategorizedWorkerPool::SignalHasReadyToRunTasksWithLockAcquired() {
 
   if (ShouldRunTaskForCategoryWithLockAcquired(cc::TASK_CATEGORY_FOREGROUND) ||
       ShouldRunTaskForCategoryWithLockAcquired(
-          cc::TASK_CATEGORY_NONCONCURRENT_FOREGROUND)) {
+          cc::TASK_CATEGORY_NONCONCURRENT_FOREGROUND) ||
+      ShouldBoostPrepaintWithLockAcquired() ||
+      ShouldRunIdlePrerenderWithLockAcquired()) {
     has_ready_to_run_foreground_tasks_cv_.Signal();
   }
 
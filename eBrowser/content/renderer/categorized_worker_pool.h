@@ -58,6 +58,33 @@ class CONTENT_EXPORT CategorizedWorkerPool : public base::TaskRunner,
   // worker threads.
   void Start(int num_threads);
 
+  // Limits the foreground threads allowed to run tasks at once to the share
+  // of ui::ScrollUpdatePacer::kMaxFrameRate that |fps| is, but at least one.
+  // A throttled gesture needs proportionally fewer tiles per second, and the
+  // idle threads stay asleep instead of waking big cores. Nonconcurrent
+  // foreground tasks and the background thread are unaffected.
+  void SetTargetFrameRate(int fps);
+
+  // The number of foreground threads SetTargetFrameRate(|fps|) leaves active
+  // out of |num_threads|.
+  static int NumActiveForegroundThreads(int num_threads, int fps);
+
+  // Lets up to |num_tasks| TASK_CATEGORY_BACKGROUND tasks at once, but no more
+  // than the active foreground threads, also run on idle foreground threads
+  // instead of queueing for the background thread. cc gives its prepaint
+  // tiles that category and orders them nearest the viewport first, so these
+  // are the tiles a throttled frame scrolls into view. Zero, the default,
+  // leaves background tasks to the background thread.
+  void SetPrepaintBoost(int num_tasks);
+
+  // Lets up to |num_tasks| more TASK_CATEGORY_BACKGROUND tasks than the
+  // prepaint boost run on idle foreground threads, within the same cap, but
+  // at background thread priority. These prerender the tiles past the ones a
+  // slow throttled scroll reaches by its next frame, in the gaps between
+  // frames where the foreground threads would otherwise sleep, so the frames
+  // after it only composite. Zero, the default, prerenders nothing.
+  void SetIdlePrerender(int num_tasks);
+
   // Finish running all the posted tasks (and nested task posted by those tasks)
   // of all the associated task runners.
   // Once all the tasks are executed the method blocks until the threads are
@@ -73,6 +100,8 @@ class CONTENT_EXPORT CategorizedWorkerPool : public base::TaskRunner,
     return threads_.back()->tid();
   }
 
+  std::vector<base::PlatformThreadId> foreground_worker_thread_ids() const;
+
  protected:
   ~CategorizedWorkerPool() override;
 
@@ -110,7 +139,10 @@ class CONTENT_EXPORT CategorizedWorkerPool : public base::TaskRunner,
 
   // Run next task for the given category. Caller must acquire |lock_| prior to
   // calling this function and make sure at least one task is ready to run.
-  void RunTaskInCategoryWithLockAcquired(cc::TaskCategory category);
+  // With |idle_priority| the thread drops to background priority while the
+  // task runs.
+  void RunTaskInCategoryWithLockAcquired(cc::TaskCategory category,
+                                         bool idle_priority);
 
   // Helper function which signals worker threads if tasks are ready to run.
   void SignalHasReadyToRunTasksWithLockAcquired();
@@ -120,6 +152,14 @@ class CONTENT_EXPORT CategorizedWorkerPool : public base::TaskRunner,
   // low enough to start a new one.
   bool ShouldRunTaskForCategoryWithLockAcquired(cc::TaskCategory category);
 
+  // Whether a foreground thread should run a background task; see
+  // SetPrepaintBoost().
+  bool ShouldBoostPrepaintWithLockAcquired();
+
+  // Whether a foreground thread should run a background task at background
+  // priority; see SetIdlePrerender().
+  bool ShouldRunIdlePrerenderWithLockAcquired();
+
   // The actual threads where work is done.
   std::vector<std::unique_ptr<base::SimpleThread>> threads_;
 
@@ -145,6 +185,14 @@ class CONTENT_EXPORT CategorizedWorkerPool : public base::TaskRunner,
   base::ConditionVariable has_namespaces_with_finished_running_tasks_cv_;
   // Set during shutdown. Tells Run() to return when no more tasks are pending.
   bool shutdown_;
+  // Threads started for foreground work, and how many of them may run
+  // TASK_CATEGORY_FOREGROUND tasks at once.
+  int num_foreground_threads_;
+  int num_active_foreground_threads_;
+  // See SetPrepaintBoost().
+  int num_prepaint_boost_tasks_;
+  // See SetIdlePrerender().
+  int num_idle_prerender_tasks_;
 };
 
 }  // namespace content
@@ -2,11 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/synchronization/lock.h"
 #include "base/test/sequenced_task_runner_test_template.h"
 #include "base/test/task_runner_test_template.h"
+#include "base/threading/platform_thread.h"
 #include "base/threading/simple_thread.h"
+#include "cc/raster/task_category.h"
 #include "cc/test/task_graph_runner_test_template.h"
 #include "content/renderer/categorized_worker_pool.h"
+#include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
 namespace {
@@ -120,3 +127,143 @@ INSTANTIATE_TYPED_TEST_CASE_P(
 
 }  // namespace
 }  // namespace cc
+
+namespace content {
+namespace {
+
+class ConcurrencyCounter {
+ public:
+  ConcurrencyCounter() : running_(0), max_running_(0) {}
+
+  void Run() {
+    {
+      base::AutoLock lock(lock_);
+      ++running_;
+      max_running_ = std::max(max_running_, running_);
+    }
+    base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(5));
+    base::AutoLock lock(lock_);
+    --running_;
+  }
+
+  int max_running() {
+    base::AutoLock lock(lock_);
+    return max_running_;
+  }
+
+ private:
+  base::Lock lock_;
+  int running_;
+  int max_running_;
+};
+
+class ConcurrencyCounterTask : public cc::Task {
+ public:
+  explicit ConcurrencyCounterTask(ConcurrencyCounter* counter)
+      : counter_(counter) {}
+
+  // Overridden from cc::Task:
+  void RunOnWorkerThread() override { counter_->Run(); }
+
+ private:
+  ~ConcurrencyCounterTask() override {}
+
+  ConcurrencyCounter* const counter_;
+};
+
+// Runs |count| background tasks on |pool| and returns how many ran at once.
+int RunBackgroundTasks(CategorizedWorkerPool* pool, int count) {
+  ConcurrencyCounter counter;
+  cc::NamespaceToken token = pool->GenerateNamespaceToken();
+  cc::TaskGraph graph;
+  for (int i = 0; i < count; ++i) {
+    graph.nodes.push_back(cc::TaskGraph::Node(
+        new ConcurrencyCounterTask(&counter), cc::TASK_CATEGORY_BACKGROUND,
+        static_cast<uint16_t>(i), 0u /* dependencies */));
+  }
+  pool->ScheduleTasks(token, &graph);
+  pool->WaitForTasksToFinishRunning(token);
+  cc::Task::Vector completed_tasks;
+  pool->CollectCompletedTasks(token, &completed_tasks);
+  return counter.max_running();
+}
+
+TEST(CategorizedWorkerPoolTest, NumActiveForegroundThreads) {
+  EXPECT_EQ(4, CategorizedWorkerPool::NumActiveForegroundThreads(4, 60));
+  EXPECT_EQ(2, CategorizedWorkerPool::NumActiveForegroundThreads(4, 30));
+  EXPECT_EQ(2, CategorizedWorkerPool::NumActiveForegroundThreads(4, 20));
+  EXPECT_EQ(1, CategorizedWorkerPool::NumActiveForegroundThreads(4, 15));
+  EXPECT_EQ(1, CategorizedWorkerPool::NumActiveForegroundThreads(4, 0));
+  EXPECT_EQ(1, CategorizedWorkerPool::NumActiveForegroundThreads(1, 10));
+}
+
+TEST(CategorizedWorkerPoolTest, TargetFrameRateLimitsForegroundConcurrency) {
+  scoped_refptr<CategorizedWorkerPool> pool(new CategorizedWorkerPool());
+  pool->Start(4);
+  pool->SetTargetFrameRate(15);
+
+  ConcurrencyCounter counter;
+  for (int i = 0; i < 8; ++i) {
+    pool->PostTask(FROM_HERE, base::Bind(&ConcurrencyCounter::Run,
+                                         base::Unretained(&counter)));
+  }
+  pool->FlushForTesting();
+  EXPECT_EQ(1, counter.max_running());
+
+  // Restoring the full rate wakes the idle threads.
+  pool->SetTargetFrameRate(60);
+  for (int i = 0; i < 8; ++i) {
+    pool->PostTask(FROM_HERE, base::Bind(&ConcurrencyCounter::Run,
+                                         base::Unretained(&counter)));
+  }
+  pool->FlushForTesting();
+  pool->Shutdown();
+}
+
+TEST(CategorizedWorkerPoolTest, PrepaintBoostRunsBackgroundTasksInParallel) {
+  scoped_refptr<CategorizedWorkerPool> pool(new CategorizedWorkerPool());
+  pool->Start(4);
+  EXPECT_EQ(1, RunBackgroundTasks(pool.get(), 16));
+
+  pool->SetPrepaintBoost(2);
+  int max_running = RunBackgroundTasks(pool.get(), 16);
+  EXPECT_GT(max_running, 1);
+  EXPECT_LE(max_running, 3);
+
+  // The boost never wakes threads the target frame rate keeps idle.
+  pool->SetTargetFrameRate(15);
+  pool->SetPrepaintBoost(4);
+  EXPECT_LE(RunBackgroundTasks(pool.get(), 16), 2);
+
+  pool->SetPrepaintBoost(0);
+  EXPECT_EQ(1, RunBackgroundTasks(pool.get(), 16));
+  pool->Shutdown();
+}
+
+TEST(CategorizedWorkerPoolTest, IdlePrerenderAddsToThePrepaintBoost) {
+  scoped_refptr<CategorizedWorkerPool> pool(new CategorizedWorkerPool());
+  pool->Start(4);
+
+  pool->SetIdlePrerender(1);
+  int max_running = RunBackgroundTasks(pool.get(), 16);
+  EXPECT_GT(max_running, 1);
+  EXPECT_LE(max_running, 2);
+
+  pool->SetPrepaintBoost(1);
+  pool->SetIdlePrerender(2);
+  max_running = RunBackgroundTasks(pool.get(), 16);
+  EXPECT_GT(max_running, 1);
+  EXPECT_LE(max_running, 4);
+
+  // Prerendering shares the boost's cap of the active foreground threads.
+  pool->SetTargetFrameRate(15);
+  EXPECT_LE(RunBackgroundTasks(pool.get(), 16), 2);
+
+  pool->SetPrepaintBoost(0);
+  pool->SetIdlePrerender(0);
+  EXPECT_EQ(1, RunBackgroundTasks(pool.get(), 16));
+  pool->Shutdown();
+}
+
+}  // namespace
+}  // namespace content
@@ -0,0 +1,140 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/cpu_cluster_affinity.h"
+
+#include <algorithm>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#endif
+
+namespace content {
+
+namespace {
+
+// Returns the core's maximum frequency, or 0 if it is unknown.
+int64_t ReadMaxFreqKhz(int cpu) {
+  std::string contents;
+  base::FilePath path(base::StringPrintf(
+      "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu));
+  int64_t freq_khz = 0;
+  if (!base::ReadFileToString(path, &contents) ||
+      !base::StringToInt64(
+          base::TrimWhitespaceASCII(contents, base::TRIM_ALL), &freq_khz)) {
+    return 0;
+  }
+  return freq_khz;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<CpuClusterAffinity> CpuClusterAffinity::Create(
+    int threshold_fps) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  std::vector<int64_t> max_freqs_khz;
+  std::vector<int> all_cpus;
+  for (int cpu = 0; cpu < base::SysInfo::NumberOfProcessors(); ++cpu) {
+    max_freqs_khz.push_back(ReadMaxFreqKhz(cpu));
+    if (max_freqs_khz.back() > 0)
+      all_cpus.push_back(cpu);
+  }
+  std::vector<int> efficiency_cpus = FindEfficiencyCpus(max_freqs_khz);
+  if (efficiency_cpus.empty())
+    return nullptr;
+  return std::unique_ptr<CpuClusterAffinity>(
+      new CpuClusterAffinity(efficiency_cpus, all_cpus, threshold_fps));
+#else
+  return nullptr;
+#endif
+}
+
+// static
+std::vector<int> CpuClusterAffinity::FindEfficiencyCpus(
+    const std::vector<int64_t>& max_freqs_khz) {
+  int64_t min_freq = 0;
+  int64_t max_freq = 0;
+  for (int64_t freq : max_freqs_khz) {
+    if (freq <= 0)
+      continue;
+    min_freq = min_freq ? std::min(min_freq, freq) : freq;
+    max_freq = std::max(max_freq, freq);
+  }
+
+  std::vector<int> efficiency_cpus;
+  if (min_freq == max_freq)
+    return efficiency_cpus;
+  for (size_t cpu = 0; cpu < max_freqs_khz.size(); ++cpu) {
+    if (max_freqs_khz[cpu] == min_freq)
+      efficiency_cpus.push_back(static_cast<int>(cpu));
+  }
+  return efficiency_cpus;
+}
+
+CpuClusterAffinity::CpuClusterAffinity(const std::vector<int>& efficiency_cpus,
+                                       const std::vector<int>& all_cpus,
+                                       int threshold_fps)
+    : efficiency_cpus_(efficiency_cpus),
+      all_cpus_(all_cpus),
+      threshold_fps_(threshold_fps),
+      on_efficiency_cpus_(false),
+      disabled_(false) {
+  DCHECK(!efficiency_cpus_.empty());
+}
+
+CpuClusterAffinity::~CpuClusterAffinity() {}
+
+void CpuClusterAffinity::AddThread(base::PlatformThreadId thread_id) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  thread_ids_.push_back(thread_id);
+  if (on_efficiency_cpus_ && !disabled_)
+    disabled_ = !Apply(thread_id, efficiency_cpus_);
+}
+
+void CpuClusterAffinity::SetTargetFrameRate(int fps) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  bool on_efficiency_cpus = fps < threshold_fps_;
+  if (on_efficiency_cpus == on_efficiency_cpus_ || disabled_)
+    return;
+
+  TRACE_EVENT2("renderer", "CpuClusterAffinity::SetTargetFrameRate", "fps",
+               fps, "efficiency_cpus", on_efficiency_cpus);
+  on_efficiency_cpus_ = on_efficiency_cpus;
+  const std::vector<int>& cpus =
+      on_efficiency_cpus_ ? efficiency_cpus_ : all_cpus_;
+  for (base::PlatformThreadId thread_id : thread_ids_) {
+    if (!Apply(thread_id, cpus)) {
+      disabled_ = true;
+      return;
+    }
+  }
+}
+
+bool CpuClusterAffinity::Apply(base::PlatformThreadId thread_id,
+                               const std::vector<int>& cpus) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus)
+    CPU_SET(cpu, &cpu_set);
+  if (sched_setaffinity(thread_id, sizeof(cpu_set), &cpu_set) == 0)
+    return true;
+  PLOG(WARNING) << "Disabling power-saving thread placement";
+#endif
+  return false;
+}
+
+}  // namespace content
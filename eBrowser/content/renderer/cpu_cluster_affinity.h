@@ -0,0 +1,70 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_CPU_CLUSTER_AFFINITY_H_
+#define CONTENT_RENDERER_CPU_CLUSTER_AFFINITY_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/thread_checker.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+// Moves the renderer's compositor and raster threads onto the efficiency
+// cores of a heterogeneous (big.LITTLE) CPU while the gesture in progress is
+// throttled below a threshold frame rate, and back onto all cores once the
+// rate climbs again. Lives on the main thread, fed by the same target frame
+// rate as the raster worker pool.
+class CONTENT_EXPORT CpuClusterAffinity {
+ public:
+  // Reads the cores' maximum frequencies from sysfs. Returns null when the
+  // CPU is homogeneous or thread affinity is unsupported.
+  static std::unique_ptr<CpuClusterAffinity> Create(int threshold_fps);
+
+  // Returns the cores with the lowest maximum frequency, given the maximum
+  // frequency of each core by index. Cores with unknown (non-positive)
+  // frequencies are skipped. Empty if all known cores are alike.
+  static std::vector<int> FindEfficiencyCpus(
+      const std::vector<int64_t>& max_freqs_khz);
+
+  CpuClusterAffinity(const std::vector<int>& efficiency_cpus,
+                     const std::vector<int>& all_cpus,
+                     int threshold_fps);
+  ~CpuClusterAffinity();
+
+  void AddThread(base::PlatformThreadId thread_id);
+
+  // |fps| of ui::ScrollUpdatePacer::kMaxFrameRate means unthrottled.
+  void SetTargetFrameRate(int fps);
+
+  bool on_efficiency_cpus() const { return on_efficiency_cpus_; }
+
+ private:
+  // Returns false if the kernel refused the mask.
+  bool Apply(base::PlatformThreadId thread_id, const std::vector<int>& cpus);
+
+  const std::vector<int> efficiency_cpus_;
+  const std::vector<int> all_cpus_;
+  const int threshold_fps_;
+
+  std::vector<base::PlatformThreadId> thread_ids_;
+  bool on_efficiency_cpus_;
+  // Set once the kernel or sandbox rejects an affinity change, after which
+  // placement is left alone.
+  bool disabled_;
+
+  base::ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(CpuClusterAffinity);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_RENDERER_CPU_CLUSTER_AFFINITY_H_
@@ -0,0 +1,44 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/cpu_cluster_affinity.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+TEST(CpuClusterAffinityTest, FindEfficiencyCpus) {
+  // Four little and four big cores.
+  std::vector<int64_t> big_little = {1400000, 1400000, 1400000, 1400000,
+                                     2100000, 2100000, 2100000, 2100000};
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3}),
+            CpuClusterAffinity::FindEfficiencyCpus(big_little));
+
+  // Offline or unreadable cores are skipped.
+  std::vector<int64_t> offline = {0, 1800000, 1800000, 2400000};
+  EXPECT_EQ(std::vector<int>({1, 2}),
+            CpuClusterAffinity::FindEfficiencyCpus(offline));
+
+  std::vector<int64_t> homogeneous = {1800000, 1800000, 0, 1800000};
+  EXPECT_TRUE(CpuClusterAffinity::FindEfficiencyCpus(homogeneous).empty());
+  EXPECT_TRUE(
+      CpuClusterAffinity::FindEfficiencyCpus(std::vector<int64_t>()).empty());
+}
+
+TEST(CpuClusterAffinityTest, FollowsThreshold) {
+  CpuClusterAffinity affinity({0, 1}, {0, 1, 2, 3}, 30);
+  EXPECT_FALSE(affinity.on_efficiency_cpus());
+  affinity.SetTargetFrameRate(30);
+  EXPECT_FALSE(affinity.on_efficiency_cpus());
+  affinity.SetTargetFrameRate(20);
+  EXPECT_TRUE(affinity.on_efficiency_cpus());
+  affinity.SetTargetFrameRate(60);
+  EXPECT_FALSE(affinity.on_efficiency_cpus());
+}
+
+}  // namespace content
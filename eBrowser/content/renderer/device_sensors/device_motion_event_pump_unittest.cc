@@ -206,4 +206,17 @@ TEST_F(DeviceMotionEventPumpTest, PumpThrottlesEventRate) {
   EXPECT_GE(6, listener()->number_of_events());
 }
 
+TEST_F(DeviceMotionEventPumpTest, PumpDelayFollowsFrameRate) {
+  const int kDelay = DeviceMotionEventPump::kDefaultPumpDelayMicroseconds;
+  EXPECT_EQ(kDelay,
+            DeviceMotionEventPump::PumpDelayMicroseconds(kDelay, 60, false));
+  EXPECT_EQ(50000,
+            DeviceMotionEventPump::PumpDelayMicroseconds(kDelay, 20, false));
+  // Events never come faster than the pump's own rate.
+  EXPECT_EQ(kDelay,
+            DeviceMotionEventPump::PumpDelayMicroseconds(kDelay, 120, false));
+  EXPECT_EQ(200000,
+            DeviceMotionEventPump::PumpDelayMicroseconds(kDelay, 60, true));
+}
+
 }  // namespace content
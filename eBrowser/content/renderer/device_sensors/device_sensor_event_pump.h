@@ -5,6 +5,8 @@
 #ifndef CONTENT_RENDERER_DEVICE_SENSORS_DEVICE_SENSOR_EVENT_PUMP_H_
 #define CONTENT_RENDERER_DEVICE_SENSORS_DEVICE_SENSOR_EVENT_PUMP_H_
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/macros.h"
@@ -64,6 +66,22 @@ class CONTENT_EXPORT DeviceSensorEventPump
   static const int kDefaultPumpFrequencyHz = 60;
   static const int kDefaultPumpDelayMicroseconds =
       base::Time::kMicrosecondsPerSecond / kDefaultPumpFrequencyHz;
+  // Rate the pump slows to while all of the renderer's widgets are hidden.
+  static const int kHiddenPumpFrequencyHz = 5;
+
+  // The delay between events for a pump whose own delay is
+  // |pump_delay_microseconds|, in a renderer whose content runs at
+  // |frame_rate|: events come no faster than the frames that can show them.
+  static int PumpDelayMicroseconds(int pump_delay_microseconds,
+                                   int frame_rate,
+                                   bool hidden) {
+    int frequency_hz = hidden ? kHiddenPumpFrequencyHz : frame_rate;
+    if (frequency_hz <= 0)
+      return pump_delay_microseconds;
+    return std::max(pump_delay_microseconds,
+                    static_cast<int>(base::Time::kMicrosecondsPerSecond /
+                                     frequency_hz));
+  }
 
   // PlatformEventObserver
   void Start(blink::WebPlatformEventListener* listener) override {
@@ -128,14 +146,34 @@ class CONTENT_EXPORT DeviceSensorEventPump
     DCHECK_EQ(MOJO_RESULT_OK, result);
 
     if (InitializeReader(handle)) {
-      timer_.Start(FROM_HERE,
-                   base::TimeDelta::FromMicroseconds(pump_delay_microseconds_),
-                   this,
-                   &DeviceSensorEventPump::FireEvent);
+      timer_.Start(FROM_HERE, CurrentPumpDelay(), this,
+                   &DeviceSensorEventPump::Pump);
       state_ = RUNNING;
     }
   }
 
+  // The pump delay for the renderer's current frame rate and visibility.
+  base::TimeDelta CurrentPumpDelay() const {
+    RenderThreadImpl* render_thread = RenderThreadImpl::current();
+    if (!render_thread)
+      return base::TimeDelta::FromMicroseconds(pump_delay_microseconds_);
+    return base::TimeDelta::FromMicroseconds(PumpDelayMicroseconds(
+        pump_delay_microseconds_,
+        render_thread->interaction_target_frame_rate(),
+        render_thread->RendererIsHidden()));
+  }
+
+  // Fires an event and follows the renderer's frame rate, which only
+  // changes at gesture boundaries, so checking it once per event is enough.
+  void Pump() {
+    FireEvent();
+    if (state_ != RUNNING)
+      return;
+    base::TimeDelta delay = CurrentPumpDelay();
+    if (delay != timer_.GetCurrentDelay())
+      timer_.Start(FROM_HERE, delay, this, &DeviceSensorEventPump::Pump);
+  }
+
   virtual void FireEvent() = 0;
   virtual bool InitializeReader(base::SharedMemoryHandle handle) = 0;
 
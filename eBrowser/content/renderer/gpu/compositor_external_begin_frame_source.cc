@@ -4,20 +4,36 @@
 
 #include "content/renderer/gpu/compositor_external_begin_frame_source.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_argument.h"
 #include "content/common/view_messages.h"
 #include "ipc/ipc_sync_channel.h"
 #include "ipc/ipc_sync_message_filter.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 
 namespace content {
 
 CompositorExternalBeginFrameSource::CompositorExternalBeginFrameSource(
     CompositorForwardingMessageFilter* filter,
     IPC::SyncMessageFilter* sync_message_filter,
+    InputHandlerManager* input_handler_manager,
     int routing_id)
     : external_begin_frame_source_(this),
       begin_frame_source_filter_(filter),
       message_sender_(sync_message_filter),
-      routing_id_(routing_id) {
+      routing_id_(routing_id),
+      input_handler_manager_(input_handler_manager),
+      target_frame_rate_(ui::ScrollUpdatePacer::kMaxFrameRate),
+      budget_frame_rate_(ui::ScrollUpdatePacer::kMaxFrameRate),
+      video_frame_rate_(0),
+      gesture_frames_produced_(0),
+      gesture_frames_skipped_(0),
+      gesture_min_fps_(0),
+      gesture_fps_sum_(0) {
   DCHECK(begin_frame_source_filter_);
   DCHECK(message_sender_);
   DetachFromThread();
@@ -30,6 +46,8 @@ CompositorExternalBeginFrameSource::~CompositorExternalBeginFrameSource() {
     begin_frame_source_filter_->RemoveHandlerOnCompositorThread(
                                     routing_id_,
                                     begin_frame_source_filter_handler_);
+    if (input_handler_manager_)
+      input_handler_manager_->RemoveTargetFrameRateObserver(routing_id_, this);
   }
 }
 
@@ -45,6 +63,8 @@ void CompositorExternalBeginFrameSource::AddObserver(
                    begin_frame_source_proxy_);
     begin_frame_source_filter_->AddHandlerOnCompositorThread(
         routing_id_, begin_frame_source_filter_handler_);
+    if (input_handler_manager_)
+      input_handler_manager_->AddTargetFrameRateObserver(routing_id_, this);
   }
 
   external_begin_frame_source_.AddObserver(obs);
@@ -61,9 +81,36 @@ bool CompositorExternalBeginFrameSource::IsThrottled() const {
 
 void CompositorExternalBeginFrameSource::OnNeedsBeginFrames(
     bool needs_begin_frames) {
+  // The first frame after an idle period is never throttled.
+  if (!needs_begin_frames)
+    last_forwarded_frame_time_ = base::TimeTicks();
   Send(new ViewHostMsg_SetNeedsBeginFrames(routing_id_, needs_begin_frames));
 }
 
+void CompositorExternalBeginFrameSource::OnTargetFrameRateChanged(int fps) {
+  DCHECK(CalledOnValidThread());
+  TRACE_COUNTER_ID1("cc", "CompositorExternalBeginFrameSource::TargetFps",
+                    this, fps);
+  bool was_throttled =
+      target_frame_rate_ < ui::ScrollUpdatePacer::kMaxFrameRate;
+  bool throttled = fps < ui::ScrollUpdatePacer::kMaxFrameRate;
+  if (throttled && !was_throttled)
+    BeginGestureEnergyTrace(fps);
+  else if (was_throttled && !throttled)
+    EndGestureEnergyTrace();
+  gesture_min_fps_ = std::min(gesture_min_fps_, fps);
+  target_frame_rate_ = fps;
+  Send(new ViewHostMsg_SetBeginFrameTargetRate(routing_id_, fps));
+}
+
+void CompositorExternalBeginFrameSource::OnVideoCadenceChanged(
+    int fps,
+    base::TimeTicks frame_time) {
+  DCHECK(CalledOnValidThread());
+  video_frame_rate_ = fps;
+  video_frame_time_ = frame_time;
+}
+
 void CompositorExternalBeginFrameSource::OnMessageReceived(
     const IPC::Message& message) {
   DCHECK(CalledOnValidThread());
@@ -72,6 +119,7 @@ void CompositorExternalBeginFrameSource::OnMessageReceived(
     IPC_MESSAGE_HANDLER(ViewMsg_SetBeginFramePaused,
                         OnSetBeginFrameSourcePaused)
     IPC_MESSAGE_HANDLER(ViewMsg_BeginFrame, OnBeginFrame)
+    IPC_MESSAGE_HANDLER(ViewMsg_SetBeginFrameBudget, OnSetBeginFrameBudget)
   IPC_END_MESSAGE_MAP()
 }
 
@@ -82,9 +130,77 @@ void CompositorExternalBeginFrameSource::OnSetBeginFrameSourcePaused(
 
 void CompositorExternalBeginFrameSource::OnBeginFrame(
     const cc::BeginFrameArgs& args) {
+  bool throttled = target_frame_rate_ < ui::ScrollUpdatePacer::kMaxFrameRate;
+  if (throttled)
+    gesture_fps_sum_ += target_frame_rate_;
+  // The gesture statistics only cover the gesture's own throttling; the
+  // budget can lower the rate further.
+  int fps = std::min(target_frame_rate_, budget_frame_rate_);
+  // A video frame is displayed one interval after the BeginFrame that picks
+  // it. At a multiple of the video's rate, the frames on its grid show both
+  // the gesture and the video; off the grid they would double the count.
+  bool frame_due =
+      video_frame_rate_
+          ? ui::ScrollUpdatePacer::IsFrameDueOnCadence(
+                last_forwarded_frame_time_, args.frame_time,
+                video_frame_time_ - args.interval, fps)
+          : ui::ScrollUpdatePacer::IsFrameDue(last_forwarded_frame_time_,
+                                              args.frame_time, fps);
+  if (!frame_due) {
+    TRACE_EVENT_INSTANT1("cc",
+                         "CompositorExternalBeginFrameSource::DroppedBeginFrame",
+                         TRACE_EVENT_SCOPE_THREAD, "target_fps", fps);
+    if (throttled)
+      ++gesture_frames_skipped_;
+    return;
+  }
+  if (throttled)
+    ++gesture_frames_produced_;
+  last_forwarded_frame_time_ = args.frame_time;
   external_begin_frame_source_.OnBeginFrame(args);
 }
 
+void CompositorExternalBeginFrameSource::OnSetBeginFrameBudget(int fps) {
+  TRACE_COUNTER_ID1("cc", "CompositorExternalBeginFrameSource::BudgetFps",
+                    this, fps);
+  budget_frame_rate_ = fps;
+}
+
+void CompositorExternalBeginFrameSource::BeginGestureEnergyTrace(int fps) {
+  gesture_frames_produced_ = 0;
+  gesture_frames_skipped_ = 0;
+  gesture_min_fps_ = fps;
+  gesture_fps_sum_ = 0;
+  TRACE_EVENT_ASYNC_BEGIN1(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"),
+                           "ThrottledGesture", this, "routing_id",
+                           routing_id_);
+}
+
+void CompositorExternalBeginFrameSource::EndGestureEnergyTrace() {
+  bool enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+      TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"), &enabled);
+  if (!enabled) {
+    TRACE_EVENT_ASYNC_END0(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"),
+                           "ThrottledGesture", this);
+    return;
+  }
+  // Battery discharge over the slice comes from the browser's
+  // PowerUsageMonitor counters in the same category.
+  std::unique_ptr<base::trace_event::TracedValue> stats(
+      new base::trace_event::TracedValue());
+  int begin_frames = gesture_frames_produced_ + gesture_frames_skipped_;
+  stats->SetInteger("min_predicted_fps", gesture_min_fps_);
+  stats->SetDouble("mean_predicted_fps",
+                   begin_frames ? static_cast<double>(gesture_fps_sum_) /
+                                      begin_frames
+                                : gesture_min_fps_);
+  stats->SetInteger("frames_produced", gesture_frames_produced_);
+  stats->SetInteger("frames_skipped", gesture_frames_skipped_);
+  TRACE_EVENT_ASYNC_END1(TRACE_DISABLED_BY_DEFAULT("ebrowser.energy"),
+                         "ThrottledGesture", this, "stats", std::move(stats));
+}
+
 bool CompositorExternalBeginFrameSource::Send(IPC::Message* message) {
   return message_sender_->Send(message);
 }
@@ -5,13 +5,17 @@
 #ifndef CONTENT_RENDERER_GPU_COMPOSITOR_EXTERNAL_BEGIN_FRAME_SOURCE_H_
 #define CONTENT_RENDERER_GPU_COMPOSITOR_EXTERNAL_BEGIN_FRAME_SOURCE_H_
 
+#include <stdint.h>
+
 #include <unordered_set>
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "cc/scheduler/begin_frame_source.h"
 #include "content/renderer/gpu/compositor_forwarding_message_filter.h"
+#include "content/renderer/input/input_handler_manager.h"
 
 namespace IPC {
 class Message;
@@ -28,14 +32,24 @@ namespace content {
 // future, if this is owned by an output surface, then the internal
 // cc::ExternalBeginFrameSource can be the BeginFrameSource passed to cc
 // directly rather than proxied by this class.
+//
+// While a gesture is paced by the eBrowser frame rate model, BeginFrames that
+// arrive sooner than one target interval after the last forwarded one are
+// dropped here, so that raster, draw and swap all run at the predicted rate.
+// While a video plays, the forwarded BeginFrames are the ones that display
+// its frames.
 class CompositorExternalBeginFrameSource
     : public cc::BeginFrameSource,
       public cc::ExternalBeginFrameSourceClient,
+      public InputHandlerManager::TargetFrameRateObserver,
       public NON_EXPORTED_BASE(base::NonThreadSafe) {
  public:
-  explicit CompositorExternalBeginFrameSource(
+  // |input_handler_manager| may be null, in which case BeginFrames are never
+  // throttled. Otherwise it must outlive this object.
+  CompositorExternalBeginFrameSource(
       CompositorForwardingMessageFilter* filter,
       IPC::SyncMessageFilter* sync_message_filter,
+      InputHandlerManager* input_handler_manager,
       int routing_id);
   ~CompositorExternalBeginFrameSource() override;
 
@@ -49,6 +63,10 @@ class CompositorExternalBeginFrameSource
   // cc::ExternalBeginFrameSourceClient implementation.
   void OnNeedsBeginFrames(bool need_begin_frames) override;
 
+  // InputHandlerManager::TargetFrameRateObserver implementation.
+  void OnTargetFrameRateChanged(int fps) override;
+  void OnVideoCadenceChanged(int fps, base::TimeTicks frame_time) override;
+
  private:
   class CompositorExternalBeginFrameSourceProxy
       : public base::RefCountedThreadSafe<
@@ -76,8 +94,15 @@ class CompositorExternalBeginFrameSource
   void OnMessageReceived(const IPC::Message& message);
   void OnSetBeginFrameSourcePaused(bool paused);
   void OnBeginFrame(const cc::BeginFrameArgs& args);
+  void OnSetBeginFrameBudget(int fps);
   bool Send(IPC::Message* message);
 
+  // Per-gesture energy accounting, traced under the
+  // disabled-by-default-ebrowser.energy category as one async slice per
+  // throttled gesture.
+  void BeginGestureEnergyTrace(int fps);
+  void EndGestureEnergyTrace();
+
   // Shared helper implementation.
   cc::ExternalBeginFrameSource external_begin_frame_source_;
 
@@ -88,6 +113,25 @@ class CompositorExternalBeginFrameSource
   int routing_id_;
   CompositorForwardingMessageFilter::Handler begin_frame_source_filter_handler_;
 
+  // Not owned. Null when BeginFrames are not throttled.
+  InputHandlerManager* input_handler_manager_;
+  int target_frame_rate_;
+  // Cap from the browser's frame rate budget for idle and occluded widgets.
+  int budget_frame_rate_;
+  // Frame time of the last BeginFrame passed on to the observers.
+  base::TimeTicks last_forwarded_frame_time_;
+  // The playing video's frame rate, or 0, and the display time of one of its
+  // frames.
+  int video_frame_rate_;
+  base::TimeTicks video_frame_time_;
+
+  // Statistics of the current throttled gesture, if any.
+  int gesture_frames_produced_;
+  int gesture_frames_skipped_;
+  int gesture_min_fps_;
+  // Sum of the target rate over the BeginFrames seen during the gesture.
+  int64_t gesture_fps_sum_;
+
   DISALLOW_COPY_AND_ASSIGN(CompositorExternalBeginFrameSource);
 };
 
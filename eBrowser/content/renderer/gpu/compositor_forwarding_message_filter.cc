@@ -49,6 +49,7 @@ bool CompositorForwardingMessageFilter::OnMessageReceived(
   switch (message.type()) {
     case ViewMsg_SetBeginFramePaused::ID:
     case ViewMsg_BeginFrame::ID:
+    case ViewMsg_SetBeginFrameBudget::ID:
     case ViewMsg_ReclaimCompositorResources::ID:
       break;
     default:
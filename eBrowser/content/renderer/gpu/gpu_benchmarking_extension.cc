@@ -8,11 +8,13 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/base64.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
@@ -52,6 +54,8 @@
 // an experimental, fragile, and diagnostic-only document type.
 #include "third_party/skia/src/utils/SkMultiPictureDocument.h"
 #include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/geometry/point_f.h"
+#include "ui/gfx/geometry/vector2d_f.h"
 #include "v8/include/v8.h"
 
 using blink::WebCanvas;
@@ -322,6 +326,17 @@ void OnSyntheticGestureCompleted(CallbackAndContext* callback_and_context) {
   }
 }
 
+// Hands the JSON report of an energy benchmark or calibration to the page,
+// as null if it failed.
+void OnEnergyReportCompleted(
+    CallbackAndContext* callback_and_context,
+    const std::string& report) {
+  std::unique_ptr<base::Value> value = base::JSONReader::Read(report);
+  if (!value)
+    value = base::Value::CreateNullValue();
+  OnMicroBenchmarkCompleted(callback_and_context, std::move(value));
+}
+
 bool BeginSmoothScroll(v8::Isolate* isolate,
                        float pixels_to_scroll,
                        v8::Local<v8::Function> callback,
@@ -526,6 +541,9 @@ gin::ObjectTemplateBuilder GpuBenchmarking::GetObjectTemplateBuilder(
       .SetMethod("gestureSourceTypeSupported",
                  &GpuBenchmarking::GestureSourceTypeSupported)
       .SetMethod("smoothScrollBy", &GpuBenchmarking::SmoothScrollBy)
+      .SetMethod("interactionEnergyBenchmark",
+                 &GpuBenchmarking::InteractionEnergyBenchmark)
+      .SetMethod("energyCalibration", &GpuBenchmarking::EnergyCalibration)
       .SetMethod("smoothDrag", &GpuBenchmarking::SmoothDrag)
       .SetMethod("swipe", &GpuBenchmarking::Swipe)
       .SetMethod("scrollBounce", &GpuBenchmarking::ScrollBounce)
@@ -655,6 +673,82 @@ bool GpuBenchmarking::SmoothScrollBy(gin::Arguments* args) {
                            start_y);
 }
 
+bool GpuBenchmarking::InteractionEnergyBenchmark(gin::Arguments* args) {
+  GpuBenchmarkingContext context;
+  if (!context.Init(true))
+    return false;
+
+  float page_scale_factor = context.web_view()->pageScaleFactor();
+  blink::WebRect rect = context.render_view_impl()->GetWidget()->viewRect();
+
+  std::vector<float> speeds_in_pixels_s;
+  v8::Local<v8::Function> callback;
+  float pixels_to_scroll = rect.height / (page_scale_factor * 2);
+  float start_x = rect.width / (page_scale_factor * 2);
+  float start_y = rect.height / (page_scale_factor * 2);
+
+  if (!GetArg(args, &speeds_in_pixels_s) ||
+      !GetArg(args, &callback) ||
+      !GetOptionalArg(args, &pixels_to_scroll) ||
+      !GetOptionalArg(args, &start_x) ||
+      !GetOptionalArg(args, &start_y)) {
+    return false;
+  }
+
+  scoped_refptr<CallbackAndContext> callback_and_context =
+      new CallbackAndContext(args->isolate(), callback,
+                             context.web_frame()->mainWorldScriptContext());
+
+  // Convert coordinates from CSS pixels to density independent pixels (DIPs).
+  // The first run of each speed scrolls down, the second back up.
+  RenderWidget* widget = context.render_view_impl()->GetWidget();
+  return widget->RunInteractionEnergyBenchmark(
+      speeds_in_pixels_s,
+      gfx::Vector2dF(0, -pixels_to_scroll * page_scale_factor),
+      gfx::PointF(start_x * page_scale_factor, start_y * page_scale_factor),
+      base::Bind(&OnEnergyReportCompleted,
+                 base::RetainedRef(callback_and_context)));
+}
+
+bool GpuBenchmarking::EnergyCalibration(gin::Arguments* args) {
+  GpuBenchmarkingContext context;
+  if (!context.Init(true))
+    return false;
+
+  float page_scale_factor = context.web_view()->pageScaleFactor();
+  blink::WebRect rect = context.render_view_impl()->GetWidget()->viewRect();
+
+  std::vector<int> frame_rates;
+  v8::Local<v8::Function> callback;
+  float speed_in_pixels_s = 800;
+  float pixels_to_scroll = rect.height / (page_scale_factor * 2);
+  float start_x = rect.width / (page_scale_factor * 2);
+  float start_y = rect.height / (page_scale_factor * 2);
+
+  if (!GetArg(args, &frame_rates) ||
+      !GetArg(args, &callback) ||
+      !GetOptionalArg(args, &speed_in_pixels_s) ||
+      !GetOptionalArg(args, &pixels_to_scroll) ||
+      !GetOptionalArg(args, &start_x) ||
+      !GetOptionalArg(args, &start_y)) {
+    return false;
+  }
+
+  scoped_refptr<CallbackAndContext> callback_and_context =
+      new CallbackAndContext(args->isolate(), callback,
+                             context.web_frame()->mainWorldScriptContext());
+
+  // Convert coordinates from CSS pixels to density independent pixels (DIPs).
+  // The first run of each rate scrolls down, the second back up.
+  RenderWidget* widget = context.render_view_impl()->GetWidget();
+  return widget->RunEnergyCalibration(
+      frame_rates, speed_in_pixels_s,
+      gfx::Vector2dF(0, -pixels_to_scroll * page_scale_factor),
+      gfx::PointF(start_x * page_scale_factor, start_y * page_scale_factor),
+      base::Bind(&OnEnergyReportCompleted,
+                 base::RetainedRef(callback_and_context)));
+}
+
 bool GpuBenchmarking::SmoothDrag(gin::Arguments* args) {
   GpuBenchmarkingContext context;
   if (!context.Init(true))
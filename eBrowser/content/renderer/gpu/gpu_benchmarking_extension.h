@@ -46,6 +46,11 @@ class GpuBenchmarking : public gin::Wrappable<GpuBenchmarking> {
                               const std::string& filename);
   bool GestureSourceTypeSupported(int gesture_source_type);
   bool SmoothScrollBy(gin::Arguments* args);
+  // Runs smooth touch scrolls at each of the given speeds with the frame rate
+  // models enabled and disabled, and passes the browser's report of frames,
+  // scroll latencies and battery level per run to the callback.
+  bool InteractionEnergyBenchmark(gin::Arguments* args);
+  bool EnergyCalibration(gin::Arguments* args);
   bool SmoothDrag(gin::Arguments* args);
   bool Swipe(gin::Arguments* args);
   bool ScrollBounce(gin::Arguments* args);
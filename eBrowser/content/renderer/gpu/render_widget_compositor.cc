@@ -5,9 +5,12 @@
 #include "content/renderer/gpu/render_widget_compositor.h"
 
 #include <stddef.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/location.h"
@@ -15,10 +18,12 @@
 #include "base/numerics/safe_conversions.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
 #include "base/synchronization/lock.h"
 #include "base/sys_info.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "build/build_config.h"
 #include "cc/animation/animation_host.h"
@@ -58,6 +63,8 @@
 #include "third_party/WebKit/public/web/WebKit.h"
 #include "third_party/WebKit/public/web/WebRuntimeFeatures.h"
 #include "third_party/WebKit/public/web/WebSelection.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+#include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gl/gl_switches.h"
 #include "ui/native_theme/native_theme_switches.h"
 #include "ui/native_theme/overlay_scrollbar_constants_aura.h"
@@ -102,6 +109,26 @@ bool GetSwitchValueAsInt(const base::CommandLine& command_line,
   }
 }
 
+// Parses --ebrowser-fling-raster-scale's "<pixels per second>,<scale>".
+bool ParseFlingRasterScale(const std::string& value,
+                           float* velocity,
+                           float* scale) {
+  std::vector<std::string> parts = base::SplitString(
+      value, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  double parsed_velocity = 0;
+  double parsed_scale = 0;
+  if (parts.size() != 2 || !base::StringToDouble(parts[0], &parsed_velocity) ||
+      !base::StringToDouble(parts[1], &parsed_scale) || parsed_velocity <= 0 ||
+      parsed_scale <= 0 || parsed_scale >= 1) {
+    LOG(WARNING) << "Failed to parse switch "
+                 << switches::kEBrowserFlingRasterScale << ": " << value;
+    return false;
+  }
+  *velocity = static_cast<float>(parsed_velocity);
+  *scale = static_cast<float>(parsed_scale);
+  return true;
+}
+
 cc::LayerSelectionBound ConvertWebSelectionBound(
     const WebSelection& web_selection,
     bool is_start) {
@@ -204,6 +231,18 @@ static cc::TopControlsState ConvertTopControlsState(
   return static_cast<cc::TopControlsState>(state);
 }
 
+void AccumulateContentComplexity(const cc::Layer* layer,
+                                 int* layer_count,
+                                 double* content_area) {
+  ++*layer_count;
+  if (layer->DrawsContent()) {
+    *content_area +=
+        static_cast<double>(layer->bounds().width()) * layer->bounds().height();
+  }
+  for (const auto& child : layer->children())
+    AccumulateContentComplexity(child.get(), layer_count, content_area);
+}
+
 }  // namespace
 
 // static
@@ -225,9 +264,36 @@ RenderWidgetCompositor::RenderWidgetCompositor(
       compositor_deps_(compositor_deps),
       threaded_(!!compositor_deps_->GetCompositorImplThreadTaskRunner()),
       never_visible_(false),
+      throttle_animation_frames_(
+          base::CommandLine::ForCurrentProcess()->HasSwitch(
+              switches::kEBrowserThrottleAnimationFrames)),
+      target_frame_rate_(ui::ScrollUpdatePacer::kMaxFrameRate),
+      video_frame_rate_(0),
+      num_prepaint_tiles_(0),
+      num_idle_prerender_tiles_(0),
+      reading_prerender_strip_(0),
+      fling_raster_scale_velocity_(0),
+      fling_raster_scale_(1),
+      fling_raster_scale_applied_(false),
+      device_scale_factor_(1),
       layout_and_paint_async_callback_(nullptr),
       remote_proto_channel_receiver_(nullptr),
-      weak_factory_(this) {}
+      weak_factory_(this) {
+  const base::CommandLine& cmd = *base::CommandLine::ForCurrentProcess();
+  if (cmd.HasSwitch(switches::kEBrowserFlingRasterScale)) {
+    ParseFlingRasterScale(
+        cmd.GetSwitchValueASCII(switches::kEBrowserFlingRasterScale),
+        &fling_raster_scale_velocity_, &fling_raster_scale_);
+  }
+  if (cmd.HasSwitch(switches::kEBrowserReadingPrerenderStrip)) {
+    const int kMaxStripPercent = 200;
+    int strip_percent = 0;
+    if (GetSwitchValueAsInt(cmd, switches::kEBrowserReadingPrerenderStrip, 0,
+                            kMaxStripPercent, &strip_percent)) {
+      reading_prerender_strip_ = strip_percent / 100.f;
+    }
+  }
+}
 
 void RenderWidgetCompositor::Initialize(float device_scale_factor) {
   base::CommandLine* cmd = base::CommandLine::ForCurrentProcess();
@@ -374,6 +440,20 @@ cc::LayerTreeSettings RenderWidgetCompositor::GenerateLayerTreeSettings(
         &settings.initial_debug_state.slow_down_raster_scale_factor);
   }
 
+  // The skewport extends the prepaint region ahead of the scroll by the
+  // viewport's measured velocity times this time, so fast scrolls prepaint
+  // further and slow, throttled ones barely past the viewport.
+  if (cmd.HasSwitch(switches::kEBrowserPrepaintTime)) {
+    const int kMaxPrepaintTimeMs = 5000;
+    int prepaint_time_ms = 0;
+    if (GetSwitchValueAsInt(cmd, switches::kEBrowserPrepaintTime, 0,
+                            kMaxPrepaintTimeMs, &prepaint_time_ms)) {
+      settings.skewport_target_time_in_seconds = prepaint_time_ms / 1000.f;
+      settings.gpu_rasterization_skewport_target_time_in_seconds =
+          prepaint_time_ms / 1000.f;
+    }
+  }
+
 #if defined(OS_ANDROID)
   bool using_synchronous_compositor =
       GetContentClient()->UsingSynchronousCompositing();
@@ -632,6 +712,27 @@ const cc::Layer* RenderWidgetCompositor::GetRootLayer() const {
   return layer_tree_host_->GetLayerTree()->root_layer();
 }
 
+void RenderWidgetCompositor::GetContentComplexity(int* layer_count,
+                                                  float* raster_cost) const {
+  *layer_count = 0;
+  *raster_cost = 0;
+  const cc::Layer* root = GetRootLayer();
+  if (!root)
+    return;
+  double content_area = 0;
+  AccumulateContentComplexity(root, layer_count, &content_area);
+
+  // Layer bounds are in DIPs, the viewport in physical pixels.
+  cc::LayerTree* layer_tree = layer_tree_host_->GetLayerTree();
+  gfx::Size viewport = layer_tree->device_viewport_size();
+  double scale = layer_tree->device_scale_factor();
+  double viewport_area =
+      static_cast<double>(viewport.width()) * viewport.height() /
+      (scale * scale);
+  if (viewport_area > 0)
+    *raster_cost = static_cast<float>(content_area / viewport_area);
+}
+
 int RenderWidgetCompositor::ScheduleMicroBenchmark(
     const std::string& name,
     std::unique_ptr<base::Value> value,
@@ -673,11 +774,12 @@ void RenderWidgetCompositor::detachCompositorAnimationTimeline(
 
 void RenderWidgetCompositor::setViewportSize(
     const WebSize& device_viewport_size) {
-  layer_tree_host_->GetLayerTree()->SetViewportSize(device_viewport_size);
+  device_viewport_size_ = device_viewport_size;
+  ApplyRasterScale();
 }
 
 WebSize RenderWidgetCompositor::getViewportSize() const {
-  return layer_tree_host_->GetLayerTree()->device_viewport_size();
+  return device_viewport_size_;
 }
 
 WebFloatPoint RenderWidgetCompositor::adjustEventPointForPinchZoom(
@@ -686,7 +788,8 @@ WebFloatPoint RenderWidgetCompositor::adjustEventPointForPinchZoom(
 }
 
 void RenderWidgetCompositor::setDeviceScaleFactor(float device_scale) {
-  layer_tree_host_->GetLayerTree()->SetDeviceScaleFactor(device_scale);
+  device_scale_factor_ = device_scale;
+  ApplyRasterScale();
 }
 
 void RenderWidgetCompositor::setBackgroundColor(blink::WebColor color) {
@@ -741,6 +844,7 @@ void RenderWidgetCompositor::setNeedsCompositorUpdate() {
 
 void RenderWidgetCompositor::didStopFlinging() {
   layer_tree_host_->DidStopFlinging();
+  SetFlingRasterScaleApplied(false);
 }
 
 void RenderWidgetCompositor::registerViewportLayers(
@@ -994,11 +1098,179 @@ void RenderWidgetCompositor::DidBeginMainFrame() {
 }
 
 void RenderWidgetCompositor::BeginMainFrame(const cc::BeginFrameArgs& args) {
-  compositor_deps_->GetRendererScheduler()->WillBeginFrame(args);
+  // While input is throttled BeginFrames only come at the target rate, so
+  // the renderer scheduler is told that interval to size the idle period it
+  // gives GC and idle tasks by, instead of the display's.
+  cc::BeginFrameArgs scheduler_args = args;
+  if (target_frame_rate_ > 0 &&
+      target_frame_rate_ < ui::ScrollUpdatePacer::kMaxFrameRate) {
+    scheduler_args.interval = std::max(
+        args.interval, base::TimeDelta::FromSecondsD(1.0 / target_frame_rate_));
+  }
+  compositor_deps_->GetRendererScheduler()->WillBeginFrame(scheduler_args);
+  UpdateScrollVelocity(args.frame_time);
+  // Video frames are displayed one interval after the BeginFrame that picks
+  // them.
+  bool frame_due =
+      video_frame_rate_
+          ? ui::ScrollUpdatePacer::IsFrameDueOnCadence(
+                last_animation_frame_time_, args.frame_time,
+                video_frame_time_ - args.interval, target_frame_rate_)
+          : ui::ScrollUpdatePacer::IsFrameDue(last_animation_frame_time_,
+                                              args.frame_time,
+                                              target_frame_rate_);
+  if (throttle_animation_frames_ &&
+      target_frame_rate_ < ui::ScrollUpdatePacer::kMaxFrameRate &&
+      !frame_due) {
+    // The callbacks stay queued in Blink; ask for the frame they are due in.
+    TRACE_EVENT_INSTANT1("cc", "RenderWidgetCompositor::SkippedAnimationFrame",
+                         TRACE_EVENT_SCOPE_THREAD, "target_fps",
+                         target_frame_rate_);
+    layer_tree_host_->SetNeedsAnimate();
+    return;
+  }
+  last_animation_frame_time_ = args.frame_time;
   double frame_time_sec = (args.frame_time - base::TimeTicks()).InSecondsF();
   delegate_->BeginMainFrame(frame_time_sec);
 }
 
+void RenderWidgetCompositor::UpdateScrollVelocity(base::TimeTicks frame_time) {
+  gfx::Vector2dF velocity;
+  if (!last_main_frame_time_.is_null() && frame_time > last_main_frame_time_) {
+    velocity = gfx::ScaleVector2d(
+        scroll_delta_since_main_frame_,
+        device_scale_factor_ /
+            (frame_time - last_main_frame_time_).InSecondsF());
+  }
+  scroll_delta_since_main_frame_ = gfx::Vector2dF();
+  last_main_frame_time_ = frame_time;
+
+  if (fling_raster_scale_velocity_) {
+    // Half the speed it took to lower the scale restores it, so a speed that
+    // hovers around the threshold does not re-raster back and forth.
+    float speed = velocity.Length();
+    SetFlingRasterScaleApplied(
+        speed > fling_raster_scale_velocity_ ||
+        (fling_raster_scale_applied_ &&
+         speed > fling_raster_scale_velocity_ / 2));
+  }
+
+  // The tiles are in raster pixels.
+  gfx::Vector2dF raster_velocity =
+      gfx::ScaleVector2d(velocity, CurrentRasterScale());
+  const gfx::Size& viewport =
+      layer_tree_host_->GetLayerTree()->device_viewport_size();
+  const gfx::Size& tile_size =
+      layer_tree_host_->GetSettings().default_tile_size;
+  int num_tiles = PrepaintTilesForThrottledFrame(
+      raster_velocity, target_frame_rate_, viewport, tile_size);
+  int num_idle_tiles = PrerenderTilesForReadingScroll(
+      raster_velocity, target_frame_rate_, viewport, tile_size,
+      reading_prerender_strip_);
+  if (num_tiles == num_prepaint_tiles_ &&
+      num_idle_tiles == num_idle_prerender_tiles_) {
+    return;
+  }
+  num_prepaint_tiles_ = num_tiles;
+  num_idle_prerender_tiles_ = num_idle_tiles;
+  delegate_->RequestPrepaintBoost(num_tiles, num_idle_tiles);
+}
+
+// static
+int RenderWidgetCompositor::PrepaintTilesForThrottledFrame(
+    const gfx::Vector2dF& velocity,
+    int fps,
+    const gfx::Size& viewport,
+    const gfx::Size& tile_size) {
+  if (fps <= 0 || fps >= ui::ScrollUpdatePacer::kMaxFrameRate ||
+      tile_size.IsEmpty() || viewport.IsEmpty()) {
+    return 0;
+  }
+  // How far the content moves before the next throttled frame.
+  gfx::Vector2dF lead = gfx::ScaleVector2d(velocity, 1.f / fps);
+  int rows = static_cast<int>(std::ceil(std::abs(lead.y()) /
+                                        tile_size.height()));
+  int columns =
+      static_cast<int>(std::ceil(std::abs(lead.x()) / tile_size.width()));
+  int tiles_per_row = (viewport.width() + tile_size.width() - 1) /
+                      tile_size.width();
+  int tiles_per_column = (viewport.height() + tile_size.height() - 1) /
+                         tile_size.height();
+  return rows * tiles_per_row + columns * tiles_per_column;
+}
+
+// static
+int RenderWidgetCompositor::PrerenderTilesForReadingScroll(
+    const gfx::Vector2dF& velocity,
+    int fps,
+    const gfx::Size& viewport,
+    const gfx::Size& tile_size,
+    float strip_fraction) {
+  if (strip_fraction <= 0 || fps <= 0 ||
+      fps >= ui::ScrollUpdatePacer::kMaxFrameRate || tile_size.IsEmpty() ||
+      viewport.IsEmpty()) {
+    return 0;
+  }
+  gfx::Vector2dF lead = gfx::ScaleVector2d(velocity, 1.f / fps);
+  int num_tiles = 0;
+  if (lead.y()) {
+    int strip_rows = static_cast<int>(
+        std::ceil(viewport.height() * strip_fraction / tile_size.height()));
+    int rows = static_cast<int>(std::ceil(std::abs(lead.y()) /
+                                          tile_size.height()));
+    int tiles_per_row = (viewport.width() + tile_size.width() - 1) /
+                        tile_size.width();
+    num_tiles += std::max(strip_rows - rows, 0) * tiles_per_row;
+  }
+  if (lead.x()) {
+    int strip_columns = static_cast<int>(
+        std::ceil(viewport.width() * strip_fraction / tile_size.width()));
+    int columns =
+        static_cast<int>(std::ceil(std::abs(lead.x()) / tile_size.width()));
+    int tiles_per_column = (viewport.height() + tile_size.height() - 1) /
+                           tile_size.height();
+    num_tiles += std::max(strip_columns - columns, 0) * tiles_per_column;
+  }
+  return num_tiles;
+}
+
+float RenderWidgetCompositor::CurrentRasterScale() const {
+  return fling_raster_scale_applied_ ? fling_raster_scale_ : 1.f;
+}
+
+void RenderWidgetCompositor::SetFlingRasterScaleApplied(bool applied) {
+  if (applied == fling_raster_scale_applied_)
+    return;
+  TRACE_EVENT_INSTANT1("cc", "RenderWidgetCompositor::FlingRasterScale",
+                       TRACE_EVENT_SCOPE_THREAD, "applied", applied);
+  fling_raster_scale_applied_ = applied;
+  ApplyRasterScale();
+}
+
+void RenderWidgetCompositor::ApplyRasterScale() {
+  // Both shrink together, so layout and the viewport in DIPs stay the same
+  // and only the raster resolution drops. The frame's device scale factor
+  // tells the browser to scale it back up.
+  float scale = CurrentRasterScale();
+  cc::LayerTree* layer_tree = layer_tree_host_->GetLayerTree();
+  layer_tree->SetDeviceScaleFactor(device_scale_factor_ * scale);
+  layer_tree->SetViewportSize(
+      gfx::ScaleToCeiledSize(device_viewport_size_, scale));
+}
+
+void RenderWidgetCompositor::SetTargetFrameRate(int fps) {
+  TRACE_COUNTER_ID1("cc", "RenderWidgetCompositor::TargetFps", this, fps);
+  target_frame_rate_ = fps;
+  // The first animation frame at a new rate is never held back.
+  last_animation_frame_time_ = base::TimeTicks();
+}
+
+void RenderWidgetCompositor::SetVideoCadence(int fps,
+                                             base::TimeTicks frame_time) {
+  video_frame_rate_ = fps;
+  video_frame_time_ = frame_time;
+}
+
 void RenderWidgetCompositor::BeginMainFrameNotExpectedSoon() {
   compositor_deps_->GetRendererScheduler()->BeginFrameNotExpectedSoon();
 }
@@ -1013,6 +1285,7 @@ void RenderWidgetCompositor::ApplyViewportDeltas(
     const gfx::Vector2dF& elastic_overscroll_delta,
     float page_scale,
     float top_controls_delta) {
+  scroll_delta_since_main_frame_ += inner_delta + outer_delta;
   delegate_->ApplyViewportDeltas(inner_delta, outer_delta,
                                  elastic_overscroll_delta, page_scale,
                                  top_controls_delta);
@@ -23,6 +23,7 @@
 #include "content/renderer/gpu/compositor_dependencies.h"
 #include "third_party/WebKit/public/platform/WebLayerTreeView.h"
 #include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/vector2d_f.h"
 
 namespace base {
 class CommandLine;
@@ -71,6 +72,23 @@ class CONTENT_EXPORT RenderWidgetCompositor
       float device_scale_factor);
   static cc::ManagedMemoryPolicy GetGpuMemoryPolicy(
       const cc::ManagedMemoryPolicy& policy);
+  // How many tiles of |tile_size| a scroll at |velocity|, in device pixels
+  // per second, brings into a |viewport| sized view by the next frame at
+  // |fps|: the rows and columns it moves across, times the tiles in each.
+  // Zero when frames are not throttled.
+  static int PrepaintTilesForThrottledFrame(const gfx::Vector2dF& velocity,
+                                            int fps,
+                                            const gfx::Size& viewport,
+                                            const gfx::Size& tile_size);
+  // How many tiles past those PrepaintTilesForThrottledFrame() counts it
+  // takes to cover a strip |strip_fraction| of the viewport deep ahead of a
+  // throttled scroll. Zero when frames are not throttled, nothing scrolls, or
+  // the scroll outruns the strip by the next frame anyway.
+  static int PrerenderTilesForReadingScroll(const gfx::Vector2dF& velocity,
+                                            int fps,
+                                            const gfx::Size& viewport,
+                                            const gfx::Size& tile_size,
+                                            float strip_fraction);
 
   void SetNeverVisible();
   const base::WeakPtr<cc::InputHandler>& GetInputHandler();
@@ -96,6 +114,10 @@ class CONTENT_EXPORT RenderWidgetCompositor
   void SetNeedsCommit();
   void NotifyInputThrottledUntilCommit();
   const cc::Layer* GetRootLayer() const;
+  // Returns the number of layers in the tree and the area of the layers that
+  // draw content, in viewports, as cheap estimates of how costly frames are
+  // to raster. Transforms and clips are ignored.
+  void GetContentComplexity(int* layer_count, float* raster_cost) const;
   int ScheduleMicroBenchmark(
       const std::string& name,
       std::unique_ptr<base::Value> value,
@@ -104,6 +126,18 @@ class CONTENT_EXPORT RenderWidgetCompositor
   void SetFrameSinkId(const cc::FrameSinkId& frame_sink_id);
   void OnHandleCompositorProto(const std::vector<uint8_t>& proto);
   void SetPaintedDeviceScaleFactor(float device_scale);
+  // The frame rate predicted for the active gesture, or
+  // ui::ScrollUpdatePacer::kMaxFrameRate when input is not throttled.
+  // Compositor animations already follow it through the BeginFrames that
+  // CompositorExternalBeginFrameSource drops; with
+  // --ebrowser-throttle-animation-frames, requestAnimationFrame callbacks and
+  // main thread animations are also run no faster than it.
+  void SetTargetFrameRate(int fps);
+  int target_frame_rate() const { return target_frame_rate_; }
+  // The rate a playing video presents frames at, or 0, and the display time
+  // of one of them. Throttled animation frames are then run on the video's
+  // frames rather than between them.
+  void SetVideoCadence(int fps, base::TimeTicks frame_time);
   void SetDeviceColorSpace(const gfx::ColorSpace& color_space);
 
   // WebLayerTreeView implementation.
@@ -219,6 +253,17 @@ class CONTENT_EXPORT RenderWidgetCompositor
   void InvokeLayoutAndPaintCallback();
   bool CompositeIsSynchronous() const;
   void SynchronouslyComposite();
+  // Estimates the scroll velocity at the main frame at |frame_time|, asks
+  // the delegate to boost the prepaint tiles it reaches by the next
+  // throttled frame, and those of the reading strip past them to prerender
+  // while idle, and lowers or restores the fling raster scale.
+  void UpdateScrollVelocity(base::TimeTicks frame_time);
+  // |fling_raster_scale_| while it is applied, otherwise 1.
+  float CurrentRasterScale() const;
+  void SetFlingRasterScaleApplied(bool applied);
+  // Gives cc the device scale factor and viewport size times
+  // CurrentRasterScale().
+  void ApplyRasterScale();
 
   int num_failed_recreate_attempts_;
   RenderWidgetCompositorDelegate* const delegate_;
@@ -227,6 +272,33 @@ class CONTENT_EXPORT RenderWidgetCompositor
   std::unique_ptr<cc::LayerTreeHost> layer_tree_host_;
   bool never_visible_;
 
+  const bool throttle_animation_frames_;
+  int target_frame_rate_;
+  // Frame time of the last main frame that ran animation frame callbacks.
+  base::TimeTicks last_animation_frame_time_;
+  // See SetVideoCadence().
+  int video_frame_rate_;
+  base::TimeTicks video_frame_time_;
+  // The scroll applied since the last main frame, and that frame's time, to
+  // estimate the velocity PrepaintTilesForThrottledFrame() is given.
+  gfx::Vector2dF scroll_delta_since_main_frame_;
+  base::TimeTicks last_main_frame_time_;
+  // The last counts passed to RenderWidgetCompositorDelegate::
+  // RequestPrepaintBoost().
+  int num_prepaint_tiles_;
+  int num_idle_prerender_tiles_;
+  // See --ebrowser-reading-prerender-strip, as a fraction of the viewport.
+  // Zero disables it.
+  float reading_prerender_strip_;
+  // See --ebrowser-fling-raster-scale. Zero velocity disables it.
+  float fling_raster_scale_velocity_;
+  float fling_raster_scale_;
+  bool fling_raster_scale_applied_;
+  // The device scale factor and viewport size Blink sets, before the fling
+  // raster scale.
+  float device_scale_factor_;
+  gfx::Size device_viewport_size_;
+
   blink::WebLayoutAndPaintAsyncCallback* layout_and_paint_async_callback_;
 
   cc::RemoteProtoChannel::ProtoReceiver* remote_proto_channel_receiver_;
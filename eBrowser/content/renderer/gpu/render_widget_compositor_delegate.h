@@ -76,6 +76,12 @@ class CONTENT_EXPORT RenderWidgetCompositorDelegate {
   // Called by the compositor in single-threaded mode when a swap is posted.
   virtual void OnSwapBuffersPosted() = 0;
 
+  // Asks that about |num_tiles| prepaint tiles, those a throttled scroll
+  // brings into view by its next frame, be rastered ahead of the others, and
+  // about |num_idle_tiles| more after them at idle priority between frames.
+  // Zero when frames are not throttled or nothing scrolls.
+  virtual void RequestPrepaintBoost(int num_tiles, int num_idle_tiles) = 0;
+
   // Requests that the client schedule a composite now, and calculate
   // appropriate delay for potential future frame.
   virtual void RequestScheduleAnimation() = 0;
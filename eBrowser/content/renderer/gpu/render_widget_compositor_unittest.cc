@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "base/command_line.h"
 #include "base/location.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -14,16 +15,21 @@
 #include "base/threading/thread_task_runner_handle.h"
 #include "cc/output/begin_frame_args.h"
 #include "cc/output/copy_output_request.h"
+#include "cc/test/begin_frame_args_test.h"
 #include "cc/test/fake_compositor_frame_sink.h"
 #include "cc/test/test_context_provider.h"
 #include "cc/test/test_web_graphics_context_3d.h"
+#include "cc/trees/layer_tree.h"
 #include "cc/trees/layer_tree_host.h"
+#include "content/public/common/content_switches.h"
 #include "content/public/test/mock_render_thread.h"
 #include "content/renderer/render_widget.h"
 #include "content/test/fake_compositor_dependencies.h"
 #include "gpu/GLES2/gl2extchromium.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/WebKit/public/platform/WebSize.h"
+#include "third_party/WebKit/public/platform/scheduler/test/fake_renderer_scheduler.h"
 
 using testing::AllOf;
 using testing::Field;
@@ -54,6 +60,7 @@ class StubRenderWidgetCompositorDelegate
   void OnSwapBuffersAborted() override {}
   void OnSwapBuffersComplete() override {}
   void OnSwapBuffersPosted() override {}
+  void RequestPrepaintBoost(int num_tiles, int num_idle_tiles) override {}
   void RequestScheduleAnimation() override {}
   void UpdateVisualState() override {}
   void WillBeginCompositorFrame() override {}
@@ -296,5 +303,265 @@ TEST_F(RenderWidgetCompositorFrameSinkTest, FallbackSuccessNormalSuccess) {
           1, 1);
 }
 
+class CountingRenderWidgetCompositorDelegate
+    : public StubRenderWidgetCompositorDelegate {
+ public:
+  CountingRenderWidgetCompositorDelegate() = default;
+
+  void BeginMainFrame(double frame_time_sec) override { ++num_main_frames_; }
+  void RequestPrepaintBoost(int num_tiles, int num_idle_tiles) override {
+    prepaint_tiles_ = num_tiles;
+    idle_prerender_tiles_ = num_idle_tiles;
+  }
+
+  int num_main_frames() const { return num_main_frames_; }
+  int prepaint_tiles() const { return prepaint_tiles_; }
+  int idle_prerender_tiles() const { return idle_prerender_tiles_; }
+
+ private:
+  int num_main_frames_ = 0;
+  int prepaint_tiles_ = 0;
+  int idle_prerender_tiles_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingRenderWidgetCompositorDelegate);
+};
+
+// Records the interval of the last frame the renderer scheduler was told of.
+class IntervalRecordingRendererScheduler
+    : public blink::scheduler::FakeRendererScheduler {
+ public:
+  IntervalRecordingRendererScheduler() {}
+  ~IntervalRecordingRendererScheduler() override {}
+
+  // RendererScheduler implementation:
+  void WillBeginFrame(const cc::BeginFrameArgs& args) override {
+    interval_ = args.interval;
+  }
+
+  base::TimeDelta interval() const { return interval_; }
+
+ private:
+  base::TimeDelta interval_;
+
+  DISALLOW_COPY_AND_ASSIGN(IntervalRecordingRendererScheduler);
+};
+
+class IntervalRecordingCompositorDependencies
+    : public FakeCompositorDependencies {
+ public:
+  IntervalRecordingCompositorDependencies() {}
+
+  // CompositorDependencies implementation:
+  blink::scheduler::RendererScheduler* GetRendererScheduler() override {
+    return &renderer_scheduler_;
+  }
+
+  IntervalRecordingRendererScheduler* renderer_scheduler() {
+    return &renderer_scheduler_;
+  }
+
+ private:
+  IntervalRecordingRendererScheduler renderer_scheduler_;
+
+  DISALLOW_COPY_AND_ASSIGN(IntervalRecordingCompositorDependencies);
+};
+
+class TestRenderWidgetCompositor : public RenderWidgetCompositor {
+ public:
+  TestRenderWidgetCompositor(RenderWidgetCompositorDelegate* delegate,
+                             CompositorDependencies* compositor_deps)
+      : RenderWidgetCompositor(delegate, compositor_deps) {}
+
+  using RenderWidgetCompositor::Initialize;
+  using RenderWidgetCompositor::layer_tree_host;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TestRenderWidgetCompositor);
+};
+
+class RenderWidgetCompositorAnimationFrameTest : public testing::Test {
+ public:
+  RenderWidgetCompositorAnimationFrameTest()
+      : saved_command_line_(*base::CommandLine::ForCurrentProcess()) {}
+  ~RenderWidgetCompositorAnimationFrameTest() override {
+    *base::CommandLine::ForCurrentProcess() = saved_command_line_;
+  }
+
+  int RunMainFrames(TestRenderWidgetCompositor* compositor, int count) {
+    base::TimeTicks frame_time = base::TimeTicks() +
+                                 base::TimeDelta::FromSeconds(1);
+    int start = compositor_delegate_.num_main_frames();
+    for (int i = 0; i < count; ++i) {
+      compositor->BeginMainFrame(
+          cc::CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, frame_time));
+      frame_time += base::TimeDelta::FromMicroseconds(16667);
+    }
+    return compositor_delegate_.num_main_frames() - start;
+  }
+
+ protected:
+  base::MessageLoop ye_olde_message_loope_;
+  MockRenderThread render_thread_;
+  FakeCompositorDependencies compositor_deps_;
+  CountingRenderWidgetCompositorDelegate compositor_delegate_;
+
+ private:
+  base::CommandLine saved_command_line_;
+
+  DISALLOW_COPY_AND_ASSIGN(RenderWidgetCompositorAnimationFrameTest);
+};
+
+TEST_F(RenderWidgetCompositorAnimationFrameTest, UnthrottledByDefault) {
+  TestRenderWidgetCompositor compositor(&compositor_delegate_,
+                                        &compositor_deps_);
+  compositor.Initialize(1.f);
+  compositor.SetTargetFrameRate(20);
+  EXPECT_EQ(20, compositor.target_frame_rate());
+  EXPECT_EQ(6, RunMainFrames(&compositor, 6));
+}
+
+TEST_F(RenderWidgetCompositorAnimationFrameTest, ThrottledToTargetFrameRate) {
+  base::CommandLine::ForCurrentProcess()->AppendSwitch(
+      switches::kEBrowserThrottleAnimationFrames);
+  TestRenderWidgetCompositor compositor(&compositor_delegate_,
+                                        &compositor_deps_);
+  compositor.Initialize(1.f);
+  EXPECT_EQ(6, RunMainFrames(&compositor, 6));
+
+  // At 20fps every third 60Hz frame runs animation frame callbacks.
+  compositor.SetTargetFrameRate(20);
+  EXPECT_EQ(2, RunMainFrames(&compositor, 6));
+
+  compositor.SetTargetFrameRate(60);
+  EXPECT_EQ(6, RunMainFrames(&compositor, 6));
+}
+
+TEST_F(RenderWidgetCompositorAnimationFrameTest,
+       SchedulerIdlePeriodSpansThrottledInterval) {
+  IntervalRecordingCompositorDependencies compositor_deps;
+  TestRenderWidgetCompositor compositor(&compositor_delegate_,
+                                        &compositor_deps);
+  compositor.Initialize(1.f);
+  RunMainFrames(&compositor, 1);
+  EXPECT_EQ(cc::BeginFrameArgs::DefaultInterval(),
+            compositor_deps.renderer_scheduler()->interval());
+
+  compositor.SetTargetFrameRate(20);
+  RunMainFrames(&compositor, 1);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(50),
+            compositor_deps.renderer_scheduler()->interval());
+
+  compositor.SetTargetFrameRate(60);
+  RunMainFrames(&compositor, 1);
+  EXPECT_EQ(cc::BeginFrameArgs::DefaultInterval(),
+            compositor_deps.renderer_scheduler()->interval());
+}
+
+TEST_F(RenderWidgetCompositorAnimationFrameTest, FastFlingLowersRasterScale) {
+  base::CommandLine::ForCurrentProcess()->AppendSwitchASCII(
+      switches::kEBrowserFlingRasterScale, "4000,0.5");
+  TestRenderWidgetCompositor compositor(&compositor_delegate_,
+                                        &compositor_deps_);
+  compositor.Initialize(2.f);
+  compositor.setDeviceScaleFactor(2.f);
+  compositor.setViewportSize(blink::WebSize(1000, 2000));
+  cc::LayerTree* layer_tree = compositor.layer_tree_host()->GetLayerTree();
+
+  base::TimeTicks frame_time = base::TimeTicks() +
+                               base::TimeDelta::FromSeconds(1);
+  auto scroll_frame = [&](float delta) {
+    compositor.ApplyViewportDeltas(gfx::Vector2dF(0, delta), gfx::Vector2dF(),
+                                   gfx::Vector2dF(), 1.f, 0.f);
+    frame_time += base::TimeDelta::FromMilliseconds(20);
+    compositor.BeginMainFrame(
+        cc::CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, frame_time));
+  };
+  scroll_frame(0);
+  // 30 DIPs in 20ms is 3000 physical pixels per second.
+  scroll_frame(30);
+  EXPECT_EQ(2.f, layer_tree->device_scale_factor());
+
+  // 50 DIPs is 5000 pixels per second; it still reads as the same viewport.
+  scroll_frame(50);
+  EXPECT_EQ(1.f, layer_tree->device_scale_factor());
+  EXPECT_EQ(gfx::Size(500, 1000), layer_tree->device_viewport_size());
+  EXPECT_EQ(gfx::Size(1000, 2000), gfx::Size(compositor.getViewportSize()));
+
+  // Slowing below the threshold keeps the lower scale until half of it.
+  scroll_frame(30);
+  EXPECT_EQ(1.f, layer_tree->device_scale_factor());
+  scroll_frame(50);
+  compositor.didStopFlinging();
+  EXPECT_EQ(2.f, layer_tree->device_scale_factor());
+  EXPECT_EQ(gfx::Size(1000, 2000), layer_tree->device_viewport_size());
+}
+
+TEST(RenderWidgetCompositorTest, PrepaintTilesForThrottledFrame) {
+  gfx::Size viewport(1000, 2000);
+  gfx::Size tile(256, 256);
+  // Unthrottled frames and still content need no boost.
+  EXPECT_EQ(0, RenderWidgetCompositor::PrepaintTilesForThrottledFrame(
+                   gfx::Vector2dF(0, 3000), 60, viewport, tile));
+  EXPECT_EQ(0, RenderWidgetCompositor::PrepaintTilesForThrottledFrame(
+                   gfx::Vector2dF(), 20, viewport, tile));
+  // 3000px/s at 20fps leads by 150px, one row of four tiles.
+  EXPECT_EQ(4, RenderWidgetCompositor::PrepaintTilesForThrottledFrame(
+                   gfx::Vector2dF(0, -3000), 20, viewport, tile));
+  // At 10fps it leads by 300px, two rows; sideways by 100px, one column.
+  EXPECT_EQ(16, RenderWidgetCompositor::PrepaintTilesForThrottledFrame(
+                    gfx::Vector2dF(1000, 3000), 10, viewport, tile));
+}
+
+TEST(RenderWidgetCompositorTest, PrerenderTilesForReadingScroll) {
+  gfx::Size viewport(1000, 2000);
+  gfx::Size tile(256, 256);
+  // Off by default, and only for throttled scrolls.
+  EXPECT_EQ(0, RenderWidgetCompositor::PrerenderTilesForReadingScroll(
+                   gfx::Vector2dF(0, 3000), 20, viewport, tile, 0));
+  EXPECT_EQ(0, RenderWidgetCompositor::PrerenderTilesForReadingScroll(
+                   gfx::Vector2dF(0, 3000), 60, viewport, tile, 0.5f));
+  EXPECT_EQ(0, RenderWidgetCompositor::PrerenderTilesForReadingScroll(
+                   gfx::Vector2dF(), 20, viewport, tile, 0.5f));
+  // Half the viewport is four rows; the 150px lead at 20fps takes one of
+  // them, which leaves three rows of four tiles.
+  EXPECT_EQ(12, RenderWidgetCompositor::PrerenderTilesForReadingScroll(
+                    gfx::Vector2dF(0, -3000), 20, viewport, tile, 0.5f));
+  // At 10fps the lead takes two rows of the four and one column of the two.
+  EXPECT_EQ(16, RenderWidgetCompositor::PrerenderTilesForReadingScroll(
+                    gfx::Vector2dF(1000, 3000), 10, viewport, tile, 0.5f));
+  // A fast scroll leaves the strip behind by its next frame.
+  EXPECT_EQ(0, RenderWidgetCompositor::PrerenderTilesForReadingScroll(
+                   gfx::Vector2dF(0, 30000), 20, viewport, tile, 0.5f));
+}
+
+TEST_F(RenderWidgetCompositorAnimationFrameTest, ThrottledScrollBoosts) {
+  TestRenderWidgetCompositor compositor(&compositor_delegate_,
+                                        &compositor_deps_);
+  compositor.Initialize(1.f);
+  compositor.setViewportSize(blink::WebSize(1000, 2000));
+  compositor.SetTargetFrameRate(20);
+  base::TimeTicks frame_time = base::TimeTicks() +
+                               base::TimeDelta::FromSeconds(1);
+  compositor.BeginMainFrame(
+      cc::CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, frame_time));
+  EXPECT_EQ(0, compositor_delegate_.prepaint_tiles());
+
+  // 100px in 50ms is 2000px/s, which crosses a row by the next 20fps frame.
+  compositor.ApplyViewportDeltas(gfx::Vector2dF(0, 100), gfx::Vector2dF(),
+                                 gfx::Vector2dF(), 1.f, 0.f);
+  frame_time += base::TimeDelta::FromMilliseconds(50);
+  compositor.BeginMainFrame(
+      cc::CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, frame_time));
+  EXPECT_LT(0, compositor_delegate_.prepaint_tiles());
+  // Without --ebrowser-reading-prerender-strip nothing is prerendered.
+  EXPECT_EQ(0, compositor_delegate_.idle_prerender_tiles());
+
+  // The boost ends once the scroll stops.
+  frame_time += base::TimeDelta::FromMilliseconds(50);
+  compositor.BeginMainFrame(
+      cc::CreateBeginFrameArgsForTesting(BEGINFRAME_FROM_HERE, frame_time));
+  EXPECT_EQ(0, compositor_delegate_.prepaint_tiles());
+}
+
 }  // namespace
 }  // namespace content
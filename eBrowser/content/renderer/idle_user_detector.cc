@@ -21,6 +21,8 @@ IdleUserDetector::~IdleUserDetector() {
 bool IdleUserDetector::OnMessageReceived(const IPC::Message& message) {
   IPC_BEGIN_MESSAGE_MAP(IdleUserDetector, message)
     IPC_MESSAGE_HANDLER(InputMsg_HandleInputEvent, OnHandleInputEvent)
+    IPC_MESSAGE_HANDLER(InputMsg_HandleInputEventBatch,
+                        OnHandleInputEventBatch)
   IPC_END_MESSAGE_MAP()
   return false;
 }
@@ -37,6 +39,12 @@ void IdleUserDetector::OnHandleInputEvent(
   }
 }
 
+void IdleUserDetector::OnHandleInputEventBatch(
+    const std::vector<ui::ScopedWebInputEvent>& events,
+    const std::vector<ui::LatencyInfo>& latency_info) {
+  OnHandleInputEvent(nullptr, ui::LatencyInfo(), DISPATCH_TYPE_NON_BLOCKING);
+}
+
 void IdleUserDetector::OnDestruct() {
   delete this;
 }
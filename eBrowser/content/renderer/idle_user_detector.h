@@ -5,9 +5,12 @@
 #ifndef CONTENT_RENDERER_IDLE_USER_DETECTOR_H_
 #define CONTENT_RENDERER_IDLE_USER_DETECTOR_H_
 
+#include <vector>
+
 #include "base/macros.h"
 #include "content/common/input/input_event_dispatch_type.h"
 #include "content/public/renderer/render_view_observer.h"
+#include "ui/events/blink/scoped_web_input_event.h"
 
 namespace blink {
 class WebInputEvent;
@@ -34,6 +37,9 @@ class IdleUserDetector : public RenderViewObserver {
   void OnHandleInputEvent(const blink::WebInputEvent* event,
                           const ui::LatencyInfo& latency_info,
                           InputEventDispatchType dispatch_type);
+  void OnHandleInputEventBatch(
+      const std::vector<ui::ScopedWebInputEvent>& events,
+      const std::vector<ui::LatencyInfo>& latency_info);
 
   DISALLOW_COPY_AND_ASSIGN(IdleUserDetector);
 };
@@ -23,6 +23,7 @@
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_sender.h"
 #include "ui/events/base_event_utils.h"
+#include "ui/events/blink/compositor_thread_watchdog.h"
 #include "ui/events/blink/did_overscroll_params.h"
 #include "ui/events/blink/web_input_event_traits.h"
 #include "ui/gfx/geometry/vector2d_f.h"
@@ -48,6 +49,15 @@ const char* GetInputMessageTypeName(const IPC::Message& message) {
 
 namespace content {
 
+namespace {
+
+// Slots of the ring between the IO and target threads. Enough for the events
+// of a frame or more from a 240 Hz digitizer, with several touch points, plus
+// the model messages; more overflow to a locked queue.
+const size_t kMessageRingCapacity = 64;
+
+}  // namespace
+
 InputEventFilter::InputEventFilter(
     const base::Callback<void(const IPC::Message&)>& main_listener,
     const scoped_refptr<base::SingleThreadTaskRunner>& main_task_runner,
@@ -57,6 +67,7 @@ InputEventFilter::InputEventFilter(
       sender_(NULL),
       target_task_runner_(target_task_runner),
       input_handler_manager_(NULL),
+      message_ring_(kMessageRingCapacity),
       renderer_scheduler_(NULL) {
   DCHECK(target_task_runner_.get());
   DCHECK(main_task_runner_->BelongsToCurrentThread());
@@ -108,6 +119,25 @@ void InputEventFilter::DidStopFlinging(int routing_id) {
   SendMessage(base::MakeUnique<InputHostMsg_DidStopFlinging>(routing_id));
 }
 
+void InputEventFilter::DidChangeTargetFrameRate(int routing_id, int fps) {
+  DCHECK(target_task_runner_->BelongsToCurrentThread());
+  RouteQueueMap::iterator iter = route_queues_.find(routing_id);
+  if (iter == route_queues_.end() || !iter->second)
+    return;
+
+  iter->second->SetTargetFrameRate(fps);
+  main_task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(main_listener_, InputMsg_SetTargetFrameRate(routing_id, fps)));
+}
+
+void InputEventFilter::DidRecordImplicitFeedback(
+    int routing_id,
+    const std::vector<ui::ImplicitFeedbackSample>& samples) {
+  SendMessage(base::MakeUnique<InputHostMsg_DidRecordImplicitFeedback>(
+      routing_id, samples));
+}
+
 void InputEventFilter::DispatchNonBlockingEventToMainThread(
     int routing_id,
     ui::ScopedWebInputEvent event,
@@ -192,20 +222,36 @@ bool InputEventFilter::OnMessageReceived(const IPC::Message& message) {
       return false;
   }
 
-  target_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&InputEventFilter::ForwardToHandler, this, message,
-                            received_time));
+  // Messages go through the ring rather than a task each; only the first of
+  // a batch posts the task that drains it.
+  message_ring_.Push(message, received_time);
+  if (message_ring_.RequestDrain()) {
+    target_task_runner_->PostTask(
+        FROM_HERE, base::Bind(&InputEventFilter::DrainMessageRing, this));
+  }
   return true;
 }
 
 InputEventFilter::~InputEventFilter() {}
 
+void InputEventFilter::DrainMessageRing() {
+  DCHECK(target_task_runner_->BelongsToCurrentThread());
+  TRACE_EVENT0("input", "InputEventFilter::DrainMessageRing");
+  message_ring_.DidStartDrain();
+  while (const InputMessageRing::Slot* slot = message_ring_.Front()) {
+    ForwardToHandler(slot->message, slot->received_time);
+    message_ring_.PopFront();
+  }
+}
+
 void InputEventFilter::ForwardToHandler(const IPC::Message& message,
                                         base::TimeTicks received_time) {
   DCHECK(input_handler_manager_);
   DCHECK(target_task_runner_->BelongsToCurrentThread());
   TRACE_EVENT1("input", "InputEventFilter::ForwardToHandler",
                "message_type", GetInputMessageTypeName(message));
+  ui::CompositorThreadWatchdog::ScopedSpan watchdog_span(
+      ui::CompositorThreadWatchdog::SOURCE_INPUT_MESSAGE);
 
   //my code
 	if (message.type() == InputMsg_ModelStr::ID) {
@@ -214,14 +260,25 @@ void InputEventFilter::ForwardToHandler(const IPC::Message& message,
   	if (!InputMsg_ModelStr::Read(&message, &params)){
       return;
     }
- 	  std::string msg = std::get<0>(params);
+ 	  ui::InputModelType type = std::get<0>(params);
+ 	  std::string msg = std::get<1>(params);
 	
   /*
     int speed = std::get<1>(params);
   	input_handler_manager_->HandleInputModelInfoMsg(routing_id_,msg,speed);
           return;
   */
-    input_handler_manager_->HandleInputModelStrMsg(routing_id_,msg);
+    input_handler_manager_->HandleInputModelStrMsg(routing_id_, type, msg);
+    return;
+  }
+
+  if (message.type() == InputMsg_OriginModelStr::ID) {
+    InputMsg_OriginModelStr::Param params;
+    if (!InputMsg_OriginModelStr::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleInputOriginModelStrMsg(
+        message.routing_id(), std::get<0>(params), std::get<1>(params),
+        std::get<2>(params));
     return;
   }
 
@@ -236,8 +293,101 @@ void InputEventFilter::ForwardToHandler(const IPC::Message& message,
     input_handler_manager_->HandleInputModelParamsMsg(routing_id_,speed, entropy);
     return;
   }
+
+  if (message.type() == InputMsg_ModelFeatureScale::ID) {
+    InputMsg_ModelFeatureScale::Param params;
+    if (!InputMsg_ModelFeatureScale::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleInputModelFeatureScaleMsg(
+        message.routing_id(), std::get<0>(params), std::get<1>(params),
+        std::get<2>(params));
+    return;
+  }
+
+  if (message.type() == InputMsg_SetVideoPlaying::ID) {
+    InputMsg_SetVideoPlaying::Param params;
+    if (!InputMsg_SetVideoPlaying::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleVideoPlayingMsg(message.routing_id(),
+                                                  std::get<0>(params));
+    return;
+  }
+
+  if (message.type() == InputMsg_ModelBinary::ID) {
+    InputMsg_ModelBinary::Param params;
+    if (!InputMsg_ModelBinary::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleInputModelBinaryMsg(
+        message.routing_id(), std::get<0>(params), std::get<1>(params),
+        std::get<2>(params));
+    return;
+  }
+
+  if (message.type() == InputMsg_ModelAvailable::ID) {
+    InputMsg_ModelAvailable::Param params;
+    if (!InputMsg_ModelAvailable::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleInputModelAvailableMsg(
+        message.routing_id(), std::get<0>(params), std::get<1>(params),
+        std::get<2>(params), std::get<3>(params));
+    return;
+  }
+
+  if (message.type() == InputMsg_SetModelsEnabled::ID) {
+    InputMsg_SetModelsEnabled::Param params;
+    if (!InputMsg_SetModelsEnabled::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleInputModelsEnabledMsg(message.routing_id(),
+                                                        std::get<0>(params));
+    return;
+  }
+
+  if (message.type() == InputMsg_SetFixedFrameRate::ID) {
+    InputMsg_SetFixedFrameRate::Param params;
+    if (!InputMsg_SetFixedFrameRate::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleFixedFrameRateMsg(message.routing_id(),
+                                                    std::get<0>(params));
+    return;
+  }
+
+  if (message.type() == InputMsg_EnergyCurveStr::ID) {
+    InputMsg_EnergyCurveStr::Param params;
+    if (!InputMsg_EnergyCurveStr::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleEnergyCurveStrMsg(message.routing_id(),
+                                                    std::get<0>(params));
+    return;
+  }
+
+  if (message.type() == InputMsg_SetEnergyBudgetFraction::ID) {
+    InputMsg_SetEnergyBudgetFraction::Param params;
+    if (!InputMsg_SetEnergyBudgetFraction::Read(&message, &params))
+      return;
+    input_handler_manager_->HandleEnergyBudgetFractionMsg(
+        message.routing_id(), std::get<0>(params));
+    return;
+  }
   
   //end
+  if (message.type() == InputMsg_HandleInputEventBatch::ID) {
+    InputMsg_HandleInputEventBatch::Param params;
+    if (!InputMsg_HandleInputEventBatch::Read(&message, &params))
+      return;
+    std::vector<ui::ScopedWebInputEvent>& events = std::get<0>(params);
+    const std::vector<ui::LatencyInfo>& latency_info = std::get<1>(params);
+    if (events.size() != latency_info.size())
+      return;
+    for (size_t i = 0; i < events.size(); ++i) {
+      if (!events[i])
+        continue;
+      ForwardEventToHandler(message.routing_id(), std::move(events[i]),
+                            latency_info[i], DISPATCH_TYPE_NON_BLOCKING,
+                            received_time);
+    }
+    return;
+  }
+
   if (message.type() != InputMsg_HandleInputEvent::ID) {
     TRACE_EVENT_INSTANT0(
         "input",
@@ -252,11 +402,18 @@ void InputEventFilter::ForwardToHandler(const IPC::Message& message,
   InputMsg_HandleInputEvent::Param params;
   if (!InputMsg_HandleInputEvent::Read(&message, &params))
     return;
-  ui::ScopedWebInputEvent event =
-      ui::WebInputEventTraits::Clone(*std::get<0>(params));
-  ui::LatencyInfo latency_info = std::get<1>(params);
-  InputEventDispatchType dispatch_type = std::get<2>(params);
+  ForwardEventToHandler(routing_id,
+                        ui::WebInputEventTraits::Clone(*std::get<0>(params)),
+                        std::get<1>(params), std::get<2>(params),
+                        received_time);
+}
 
+void InputEventFilter::ForwardEventToHandler(
+    int routing_id,
+    ui::ScopedWebInputEvent event,
+    const ui::LatencyInfo& latency_info,
+    InputEventDispatchType dispatch_type,
+    base::TimeTicks received_time) {
   DCHECK(event);
   DCHECK(dispatch_type == DISPATCH_TYPE_BLOCKING ||
          dispatch_type == DISPATCH_TYPE_NON_BLOCKING);
@@ -14,6 +14,7 @@
 #include "content/common/content_export.h"
 #include "content/common/input/input_event_ack_state.h"
 #include "content/renderer/input/input_handler_manager_client.h"
+#include "content/renderer/input/input_message_ring.h"
 #include "content/renderer/input/main_thread_event_queue.h"
 #include "ipc/message_filter.h"
 #include "third_party/WebKit/public/web/WebInputEvent.h"
@@ -69,6 +70,10 @@ class CONTENT_EXPORT InputEventFilter : public InputHandlerManagerClient,
                      const ui::DidOverscrollParams& params) override;
   void DidStartFlinging(int routing_id) override;
   void DidStopFlinging(int routing_id) override;
+  void DidChangeTargetFrameRate(int routing_id, int fps) override;
+  void DidRecordImplicitFeedback(
+      int routing_id,
+      const std::vector<ui::ImplicitFeedbackSample>& samples) override;
   void DispatchNonBlockingEventToMainThread(
       int routing_id,
       ui::ScopedWebInputEvent event,
@@ -103,8 +108,17 @@ class CONTENT_EXPORT InputEventFilter : public InputHandlerManagerClient,
  private:
   ~InputEventFilter() override;
 
+  // Forwards the messages handed over by the IO thread, on the target thread.
+  void DrainMessageRing();
   void ForwardToHandler(const IPC::Message& message,
                         base::TimeTicks received_time);
+  // Hands one event of an InputMsg_HandleInputEvent(Batch) to the input
+  // handler manager.
+  void ForwardEventToHandler(int routing_id,
+                             ui::ScopedWebInputEvent event,
+                             const ui::LatencyInfo& latency_info,
+                             InputEventDispatchType dispatch_type,
+                             base::TimeTicks received_time);
   void DidForwardToHandlerAndOverscroll(
       int routing_id,
       InputEventDispatchType dispatch_type,
@@ -128,6 +142,9 @@ class CONTENT_EXPORT InputEventFilter : public InputHandlerManagerClient,
   scoped_refptr<base::SingleThreadTaskRunner> target_task_runner_;
   InputHandlerManager* input_handler_manager_;
 
+  // Input messages on their way from the IO thread to the target thread.
+  InputMessageRing message_ring_;
+
   // Protects access to routes_.
   base::Lock routes_lock_;
 
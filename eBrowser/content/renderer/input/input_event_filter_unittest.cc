@@ -499,4 +499,33 @@ TEST_F(InputEventFilterTest, IntermingledNonBlockingTouch) {
   }
 }
 
+TEST_F(InputEventFilterTest, BatchedEvents) {
+  WebMouseEvent kEvents[3] = {
+    SyntheticWebMouseEventBuilder::Build(WebMouseEvent::MouseMove, 10, 10, 0),
+    SyntheticWebMouseEventBuilder::Build(WebMouseEvent::MouseMove, 20, 20, 0),
+    SyntheticWebMouseEventBuilder::Build(WebMouseEvent::MouseMove, 30, 30, 0)
+  };
+  std::vector<ui::ScopedWebInputEvent> events;
+  std::vector<ui::LatencyInfo> latency_info;
+  for (size_t i = 0; i < arraysize(kEvents); ++i) {
+    events.push_back(ui::WebInputEventTraits::Clone(kEvents[i]));
+    latency_info.push_back(ui::LatencyInfo());
+  }
+  filter_->RegisterRoutingID(kTestRoutingID);
+
+  std::vector<IPC::Message> messages;
+  messages.push_back(
+      InputMsg_HandleInputEventBatch(kTestRoutingID, events, latency_info));
+  AddMessagesToFilter(filter_.get(), messages);
+
+  // Each event reaches the handler in order, and none of them are acked.
+  ASSERT_EQ(arraysize(kEvents), event_recorder_->record_count());
+  EXPECT_EQ(0U, ipc_sink_.message_count());
+  for (size_t i = 0; i < arraysize(kEvents); ++i) {
+    const WebInputEvent* event = event_recorder_->record_at(i);
+    EXPECT_EQ(kEvents[i].size, event->size);
+    EXPECT_TRUE(memcmp(&kEvents[i], event, event->size) == 0);
+  }
+}
+
 }  // namespace content
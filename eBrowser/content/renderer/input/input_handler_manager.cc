@@ -4,20 +4,29 @@
 
 #include "content/renderer/input/input_handler_manager.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/location.h"
+#include "base/logging.h"
+#include "base/memory/shared_memory.h"
+#include "base/sequenced_task_runner.h"
 #include "base/single_thread_task_runner.h"
+#include "base/task_runner_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "cc/input/input_handler.h"
 #include "content/renderer/input/input_event_filter.h"
 #include "content/renderer/input/input_handler_manager_client.h"
 #include "content/renderer/input/input_handler_wrapper.h"
+#include "mojo/public/cpp/system/platform_handle.h"
 #include "third_party/WebKit/public/platform/scheduler/renderer/renderer_scheduler.h"
 #include "ui/events/blink/did_overscroll_params.h"
+#include "ui/events/blink/energy_curve.h"
 #include "ui/events/blink/input_handler_proxy.h"
+#include "ui/events/blink/input_model.h"
 #include "ui/events/blink/web_input_event_traits.h"
 
 using blink::WebInputEvent;
@@ -60,6 +69,11 @@ InputHandlerManager::InputHandlerManager(
   client_->SetInputHandlerManager(this);
 }
 
+InputHandlerManager::SharedModel::SharedModel()
+    : size(0), version(0), fetching(false) {}
+
+InputHandlerManager::SharedModel::~SharedModel() {}
+
 InputHandlerManager::~InputHandlerManager() {
   client_->SetInputHandlerManager(nullptr);
 }
@@ -127,6 +141,16 @@ void InputHandlerManager::RemoveInputHandler(int routing_id) {
   input_handlers_.erase(routing_id);
 }
 
+void InputHandlerManager::SetModelTaskRunner(
+    const scoped_refptr<base::SequencedTaskRunner>& task_runner) {
+  model_task_runner_ = task_runner;
+}
+
+void InputHandlerManager::SetInputModelProvider(
+    mojom::InputModelProviderPtrInfo provider) {
+  model_provider_info_ = std::move(provider);
+}
+
 void InputHandlerManager::RegisterRoutingID(int routing_id) {
   if (task_runner_->BelongsToCurrentThread()) {
     RegisterRoutingIDOnCompositorThread(routing_id);
@@ -186,6 +210,88 @@ void InputHandlerManager::ObserveGestureEventAndResultOnCompositorThread(
       gesture_event, scroll_result);
 }
 
+void InputHandlerManager::SetContentFeaturesOnMainThread(int routing_id,
+                                                         int layer_count,
+                                                         float raster_cost) {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&InputHandlerManager::SetContentFeaturesOnCompositorThread,
+                 base::Unretained(this), routing_id, layer_count,
+                 raster_cost));
+}
+
+void InputHandlerManager::SetContentFeaturesOnCompositorThread(
+    int routing_id,
+    int layer_count,
+    float raster_cost) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->SetContentFeatures(layer_count,
+                                                        raster_cost);
+}
+
+void InputHandlerManager::SetOriginOnMainThread(int routing_id,
+                                                const std::string& origin) {
+  task_runner_->PostTask(
+      FROM_HERE, base::Bind(&InputHandlerManager::SetOriginOnCompositorThread,
+                            base::Unretained(this), routing_id, origin));
+}
+
+void InputHandlerManager::SetOriginOnCompositorThread(
+    int routing_id,
+    const std::string& origin) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->SetOrigin(origin);
+}
+
+void InputHandlerManager::SetVideoCadenceOnMainThread(
+    int routing_id,
+    int fps,
+    base::TimeTicks frame_time) {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&InputHandlerManager::SetVideoCadenceOnCompositorThread,
+                 base::Unretained(this), routing_id, fps, frame_time));
+}
+
+void InputHandlerManager::SetVideoCadenceOnCompositorThread(
+    int routing_id,
+    int fps,
+    base::TimeTicks frame_time) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto range = target_frame_rate_observers_.equal_range(routing_id);
+  for (auto it = range.first; it != range.second; ++it)
+    it->second->OnVideoCadenceChanged(fps, frame_time);
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->SetVideoFrameRate(fps);
+}
+
+void InputHandlerManager::SetDisplayRefreshRatesOnMainThread(
+    int routing_id,
+    const std::vector<float>& refresh_rates) {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&InputHandlerManager::SetDisplayRefreshRatesOnCompositorThread,
+                 base::Unretained(this), routing_id, refresh_rates));
+}
+
+void InputHandlerManager::SetDisplayRefreshRatesOnCompositorThread(
+    int routing_id,
+    const std::vector<float>& refresh_rates) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->SetDisplayRefreshRates(refresh_rates);
+}
+
 void InputHandlerManager::NotifyInputEventHandledOnMainThread(
     int routing_id,
     blink::WebInputEvent::Type type,
@@ -199,14 +305,57 @@ void InputHandlerManager::ProcessRafAlignedInputOnMainThread(int routing_id) {
 
 
 //my code
-void InputHandlerManager::HandleInputModelStrMsg(int routing_id,std::string model)
+void InputHandlerManager::HandleInputModelStrMsg(int routing_id,
+                                                 ui::InputModelType type,
+                                                 std::string model)
 {
   auto it = input_handlers_.find(routing_id);
   if (it == input_handlers_.end()) { 
     return;
   }
   InputHandlerProxy* proxy = it->second->input_handler_proxy();
-  proxy->HandleInputModelStrMsg(routing_id,model);
+  if (!model_task_runner_ || model.empty()) {
+    proxy->HandleInputModelStrMsg(routing_id, type, model);
+    return;
+  }
+  // "stop" goes through the worker as well so that it cannot overtake a model
+  // that is still being prepared.
+  if (model == "stop") {
+    model_task_runner_->PostTaskAndReply(
+        FROM_HERE, base::Bind(&base::DoNothing),
+        base::Bind(&InputHandlerManager::ClearModelsOnCompositorThread,
+                   weak_ptr_factory_.GetWeakPtr(), routing_id));
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      model_task_runner_.get(), FROM_HERE,
+      base::Bind(&ui::InputModel::CreateFromString, type, model,
+                 proxy->frame_rate_table_step()),
+      base::Bind(&InputHandlerManager::InstallModelOnCompositorThread,
+                 weak_ptr_factory_.GetWeakPtr(), routing_id, type));
+}
+
+void InputHandlerManager::HandleInputOriginModelStrMsg(
+    int routing_id,
+    ui::InputModelType type,
+    const std::string& origin,
+    const std::string& model) {
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  double table_step =
+      it->second->input_handler_proxy()->frame_rate_table_step();
+  if (!model_task_runner_) {
+    InstallOriginModelOnCompositorThread(
+        routing_id, type, origin,
+        ui::InputModel::CreateFromString(type, model, table_step));
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      model_task_runner_.get(), FROM_HERE,
+      base::Bind(&ui::InputModel::CreateFromString, type, model, table_step),
+      base::Bind(&InputHandlerManager::InstallOriginModelOnCompositorThread,
+                 weak_ptr_factory_.GetWeakPtr(), routing_id, type, origin));
 }
 
 void InputHandlerManager::HandleInputModelParamsMsg(int routing_id, int speed, float entropy){
@@ -217,6 +366,247 @@ void InputHandlerManager::HandleInputModelParamsMsg(int routing_id, int speed, f
   InputHandlerProxy* proxy = it->second->input_handler_proxy();
   proxy->HandleInputModelParamsMsg(routing_id, speed, entropy);
 }
+
+void InputHandlerManager::HandleInputModelFeatureScaleMsg(int routing_id,
+                                                          float scale,
+                                                          float physical_dpi,
+                                                          float refresh_rate) {
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  InputHandlerProxy* proxy = it->second->input_handler_proxy();
+  proxy->HandleInputModelFeatureScaleMsg(routing_id, scale, physical_dpi,
+                                         refresh_rate);
+}
+
+void InputHandlerManager::HandleVideoPlayingMsg(int routing_id,
+                                                bool playing) {
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->SetVideoPlaying(playing);
+}
+
+void InputHandlerManager::HandleInputModelBinaryMsg(
+    int routing_id,
+    ui::InputModelType type,
+    const base::SharedMemoryHandle& model,
+    size_t size) {
+  // Take ownership of the handle even if nobody is listening, so that it is
+  // closed rather than leaked.
+  std::unique_ptr<base::SharedMemory> memory(
+      new base::SharedMemory(model, true /* read_only */));
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  InputHandlerProxy* proxy = it->second->input_handler_proxy();
+  if (!model_task_runner_) {
+    proxy->HandleInputModelBinaryMsg(routing_id, type, std::move(memory),
+                                     size);
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      model_task_runner_.get(), FROM_HERE,
+      base::Bind(&ui::InputModel::CreateFromSharedMemory, type,
+                 base::Passed(&memory), size, proxy->frame_rate_table_step()),
+      base::Bind(&InputHandlerManager::InstallModelOnCompositorThread,
+                 weak_ptr_factory_.GetWeakPtr(), routing_id, type));
+}
+
+void InputHandlerManager::HandleInputModelAvailableMsg(
+    int routing_id,
+    ui::InputModelType type,
+    const std::string& device_id,
+    const std::string& origin,
+    uint32_t version) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  if (!input_handlers_.contains(routing_id))
+    return;
+  SharedModelKey key(type, device_id, origin);
+  SharedModel& model = shared_models_[key];
+  if (model.memory && model.version >= version) {
+    InstallSharedModel(routing_id, key, model);
+    return;
+  }
+  model.waiting_routing_ids.push_back(routing_id);
+  if (model.fetching)
+    return;
+  if (!model_provider_) {
+    if (!model_provider_info_.is_valid()) {
+      LOG(ERROR) << "No model provider to fetch a model from";
+      return;
+    }
+    model_provider_.Bind(std::move(model_provider_info_));
+  }
+  mojom::InputModelKeyPtr model_key(mojom::InputModelKey::New());
+  model_key->type = type;
+  model_key->device_id = device_id;
+  model_key->origin = origin;
+  model_key->version = version;
+  model.fetching = true;
+  model_provider_->GetModel(
+      std::move(model_key),
+      base::Bind(&InputHandlerManager::OnGotSharedModel,
+                 weak_ptr_factory_.GetWeakPtr(), key));
+}
+
+void InputHandlerManager::OnGotSharedModel(
+    const SharedModelKey& key,
+    uint32_t version,
+    mojo::ScopedSharedBufferHandle model,
+    uint32_t size) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  SharedModel& shared_model = shared_models_[key];
+  shared_model.fetching = false;
+  // The first of concurrent announcements may reply with a model a later one
+  // already installed.
+  if (version > shared_model.version || !shared_model.memory) {
+    base::SharedMemoryHandle handle;
+    size_t mapped_size = 0;
+    bool read_only = false;
+    if (model.is_valid() &&
+        mojo::UnwrapSharedMemoryHandle(std::move(model), &handle,
+                                       &mapped_size, &read_only) ==
+            MOJO_RESULT_OK &&
+        size <= mapped_size) {
+      shared_model.memory.reset(
+          new base::SharedMemory(handle, true /* read_only */));
+      shared_model.size = size;
+      shared_model.version = version;
+    } else {
+      shared_model.memory.reset();
+    }
+  }
+  std::vector<int> routing_ids;
+  routing_ids.swap(shared_model.waiting_routing_ids);
+  for (int routing_id : routing_ids)
+    InstallSharedModel(routing_id, key, shared_model);
+}
+
+void InputHandlerManager::InstallSharedModel(int routing_id,
+                                             const SharedModelKey& key,
+                                             const SharedModel& model) {
+  ui::InputModelType type = std::get<0>(key);
+  const std::string& origin = std::get<2>(key);
+  if (!model.memory) {
+    if (origin.empty())
+      InstallModelOnCompositorThread(routing_id, type, nullptr);
+    else
+      InstallOriginModelOnCompositorThread(routing_id, type, origin, nullptr);
+    return;
+  }
+  base::SharedMemoryHandle handle =
+      base::SharedMemory::DuplicateHandle(model.memory->handle());
+  if (origin.empty()) {
+    HandleInputModelBinaryMsg(routing_id, type, handle, model.size);
+    return;
+  }
+  std::unique_ptr<base::SharedMemory> memory(
+      new base::SharedMemory(handle, true /* read_only */));
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  double table_step =
+      it->second->input_handler_proxy()->frame_rate_table_step();
+  if (!model_task_runner_) {
+    InstallOriginModelOnCompositorThread(
+        routing_id, type, origin,
+        ui::InputModel::CreateFromSharedMemory(type, std::move(memory),
+                                               model.size, table_step));
+    return;
+  }
+  base::PostTaskAndReplyWithResult(
+      model_task_runner_.get(), FROM_HERE,
+      base::Bind(&ui::InputModel::CreateFromSharedMemory, type,
+                 base::Passed(&memory), model.size, table_step),
+      base::Bind(&InputHandlerManager::InstallOriginModelOnCompositorThread,
+                 weak_ptr_factory_.GetWeakPtr(), routing_id, type, origin));
+}
+
+void InputHandlerManager::HandleInputModelsEnabledMsg(int routing_id,
+                                                      bool enabled) {
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->set_models_enabled(enabled);
+}
+
+void InputHandlerManager::HandleFixedFrameRateMsg(int routing_id, int fps) {
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->set_fixed_frame_rate(fps);
+}
+
+void InputHandlerManager::HandleEnergyCurveStrMsg(int routing_id,
+                                                  const std::string& curve) {
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  // Curves are a few numbers, so they are parsed here rather than posted.
+  std::unique_ptr<ui::EnergyCurve> energy_curve =
+      ui::EnergyCurve::CreateFromString(curve);
+  if (!energy_curve) {
+    LOG(ERROR) << "Ignoring unparsable energy curve for routing_id:"
+               << routing_id;
+    return;
+  }
+  it->second->input_handler_proxy()->SetEnergyCurve(std::move(energy_curve));
+}
+
+void InputHandlerManager::HandleEnergyBudgetFractionMsg(int routing_id,
+                                                        double fraction) {
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  ui::InputHandlerProxy* proxy = it->second->input_handler_proxy();
+  // Keeps the renderer's own --ebrowser-energy-budget bound.
+  ui::EnergyBudget budget = proxy->rate_controller().energy_budget();
+  budget.full_rate_fraction = std::max(0.0, std::min(fraction, 1.0));
+  proxy->SetEnergyBudget(budget);
+}
+
+void InputHandlerManager::InstallModelOnCompositorThread(
+    int routing_id,
+    ui::InputModelType type,
+    std::unique_ptr<ui::InputModel> model) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  if (!model) {
+    LOG(ERROR) << "Rejecting invalid model for routing_id:" << routing_id;
+    it->second->input_handler_proxy()->RejectModel(type);
+    return;
+  }
+  it->second->input_handler_proxy()->InstallModel(std::move(model));
+}
+
+void InputHandlerManager::InstallOriginModelOnCompositorThread(
+    int routing_id,
+    ui::InputModelType type,
+    const std::string& origin,
+    std::unique_ptr<ui::InputModel> model) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  if (!model) {
+    LOG(ERROR) << "Ignoring invalid model for " << origin;
+    InputHandlerProxy::RecordRejectedModel(type);
+    return;
+  }
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->InstallOriginModel(origin,
+                                                        std::move(model));
+}
+
+void InputHandlerManager::ClearModelsOnCompositorThread(int routing_id) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto it = input_handlers_.find(routing_id);
+  if (it == input_handlers_.end())
+    return;
+  it->second->input_handler_proxy()->ClearModels();
+}
 //end
 
 void InputHandlerManager::HandleInputEvent(
@@ -290,6 +680,42 @@ void InputHandlerManager::DidAnimateForInput() {
   renderer_scheduler_->DidAnimateForInputOnCompositorThread();
 }
 
+void InputHandlerManager::AddTargetFrameRateObserver(
+    int routing_id,
+    TargetFrameRateObserver* observer) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  target_frame_rate_observers_.insert(std::make_pair(routing_id, observer));
+}
+
+void InputHandlerManager::RemoveTargetFrameRateObserver(
+    int routing_id,
+    TargetFrameRateObserver* observer) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto range = target_frame_rate_observers_.equal_range(routing_id);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == observer) {
+      target_frame_rate_observers_.erase(it);
+      return;
+    }
+  }
+  NOTREACHED();
+}
+
+void InputHandlerManager::DidChangeTargetFrameRate(int routing_id, int fps) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  auto range = target_frame_rate_observers_.equal_range(routing_id);
+  for (auto it = range.first; it != range.second; ++it)
+    it->second->OnTargetFrameRateChanged(fps);
+  client_->DidChangeTargetFrameRate(routing_id, fps);
+}
+
+void InputHandlerManager::DidRecordImplicitFeedback(
+    int routing_id,
+    const std::vector<ui::ImplicitFeedbackSample>& samples) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  client_->DidRecordImplicitFeedback(routing_id, samples);
+}
+
 void InputHandlerManager::NeedsMainFrame(int routing_id) {
   DCHECK(task_runner_->BelongsToCurrentThread());
   auto it = input_handlers_.find(routing_id);
@@ -5,15 +5,28 @@
 #ifndef CONTENT_RENDERER_INPUT_INPUT_HANDLER_MANAGER_H_
 #define CONTENT_RENDERER_INPUT_INPUT_HANDLER_MANAGER_H_
 
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include "base/containers/scoped_ptr_hash_map.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/shared_memory_handle.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/common/content_export.h"
 #include "content/common/input/input_event_ack_state.h"
+#include "content/common/input_model_provider.mojom.h"
 #include "content/renderer/render_view_impl.h"
 #include "ui/events/blink/input_handler_proxy.h"
 
 namespace base {
+class SequencedTaskRunner;
+class SharedMemory;
 class SingleThreadTaskRunner;
 }
 
@@ -35,6 +48,7 @@ class RendererScheduler;
 
 namespace ui {
 struct DidOverscrollParams;
+struct InputModel;
 }
 
 namespace content {
@@ -47,6 +61,20 @@ class InputHandlerManagerClient;
 // the WebViews in this renderer.
 class CONTENT_EXPORT InputHandlerManager {
  public:
+  // Receives the frame rate predicted for a view's active gesture. Lives on
+  // the compositor thread.
+  class TargetFrameRateObserver {
+   public:
+    // |fps| of ScrollUpdatePacer::kMaxFrameRate means unthrottled.
+    virtual void OnTargetFrameRateChanged(int fps) = 0;
+    // A video on the view presents frames at |fps|, or 0 if none does, one
+    // of them displayed at |frame_time|.
+    virtual void OnVideoCadenceChanged(int fps, base::TimeTicks frame_time) = 0;
+
+   protected:
+    virtual ~TargetFrameRateObserver() {}
+  };
+
   // |task_runner| is the SingleThreadTaskRunner of the compositor thread. The
   // underlying MessageLoop and supplied |client| and the |renderer_scheduler|
   // must outlive this object. The RendererScheduler needs to know when input
@@ -64,6 +92,18 @@ class CONTENT_EXPORT InputHandlerManager {
                        const base::WeakPtr<RenderViewImpl>& render_view_impl,
                        bool enable_smooth_scrolling);
 
+  // Model updates are parsed and compiled on |task_runner| and then installed
+  // on the compositor thread, so that a large model never stalls input. Must
+  // be called before any model message arrives. Without it, models are
+  // prepared on the compositor thread.
+  void SetModelTaskRunner(
+      const scoped_refptr<base::SequencedTaskRunner>& task_runner);
+
+  // Models announced by InputMsg_ModelAvailable are fetched from |provider|,
+  // once for all views. It is bound on the compositor thread when the first
+  // model is announced. Must be called before any model message arrives.
+  void SetInputModelProvider(mojom::InputModelProviderPtrInfo provider);
+
   void RegisterRoutingID(int routing_id);
   void UnregisterRoutingID(int routing_id);
 
@@ -76,6 +116,27 @@ class CONTENT_EXPORT InputHandlerManager {
                                            blink::WebInputEvent::Type,
                                            InputEventAckState);
   void ProcessRafAlignedInputOnMainThread(int routing_id);
+  // Forwards the content complexity of |routing_id|'s last commit to its
+  // input handler proxy, as event rate model features.
+  void SetContentFeaturesOnMainThread(int routing_id,
+                                      int layer_count,
+                                      float raster_cost);
+  // Selects the models |routing_id|'s input handler paces gestures with after
+  // its main frame commits a page of the serialized url::Origin |origin|.
+  void SetOriginOnMainThread(int routing_id, const std::string& origin);
+
+  // Called from the main thread with the cadence of a video the view plays;
+  // see ui::PageActivity::video_frame_rate.
+  void SetVideoCadenceOnMainThread(int routing_id,
+                                   int fps,
+                                   base::TimeTicks frame_time);
+
+  // Called from the main thread with the refresh rates of the display
+  // |routing_id| is shown on; see
+  // ui::InputRateController::set_display_refresh_rates().
+  void SetDisplayRefreshRatesOnMainThread(
+      int routing_id,
+      const std::vector<float>& refresh_rates);
 
   // Callback only from the compositor's thread.
   void RemoveInputHandler(int routing_id);
@@ -92,8 +153,33 @@ class CONTENT_EXPORT InputHandlerManager {
                                 const InputEventAckStateCallback& callback);
   // my code
   // Called from the compositor's thread.
-  virtual void HandleInputModelStrMsg(int routing_id,std::string model);
+  virtual void HandleInputModelStrMsg(int routing_id,
+                                      ui::InputModelType type,
+                                      std::string model);
+  virtual void HandleInputOriginModelStrMsg(int routing_id,
+                                            ui::InputModelType type,
+                                            const std::string& origin,
+                                            const std::string& model);
   virtual void HandleInputModelParamsMsg(int routing_id, int speed, float entropy);
+  virtual void HandleInputModelFeatureScaleMsg(int routing_id,
+                                               float scale,
+                                               float physical_dpi,
+                                               float refresh_rate);
+  virtual void HandleVideoPlayingMsg(int routing_id, bool playing);
+  virtual void HandleInputModelBinaryMsg(int routing_id,
+                                         ui::InputModelType type,
+                                         const base::SharedMemoryHandle& model,
+                                         size_t size);
+  virtual void HandleInputModelAvailableMsg(int routing_id,
+                                            ui::InputModelType type,
+                                            const std::string& device_id,
+                                            const std::string& origin,
+                                            uint32_t version);
+  virtual void HandleInputModelsEnabledMsg(int routing_id, bool enabled);
+  virtual void HandleFixedFrameRateMsg(int routing_id, int fps);
+  virtual void HandleEnergyCurveStrMsg(int routing_id,
+                                       const std::string& curve);
+  virtual void HandleEnergyBudgetFractionMsg(int routing_id, double fraction);
   // end
   // Called from the compositor's thread.
   void DidOverscroll(int routing_id, const ui::DidOverscrollParams& params);
@@ -108,6 +194,17 @@ class CONTENT_EXPORT InputHandlerManager {
   // Called from the compositor's thread.
   void NeedsMainFrame(int routing_id);
 
+  // Called from the compositor's thread. Observers must remove themselves
+  // before they are destroyed.
+  void AddTargetFrameRateObserver(int routing_id,
+                                  TargetFrameRateObserver* observer);
+  void RemoveTargetFrameRateObserver(int routing_id,
+                                     TargetFrameRateObserver* observer);
+  void DidChangeTargetFrameRate(int routing_id, int fps);
+  void DidRecordImplicitFeedback(
+      int routing_id,
+      const std::vector<ui::ImplicitFeedbackSample>& samples);
+
   // Called from the compositor's thread.
   void DispatchNonBlockingEventToMainThread(
       int routing_id,
@@ -136,6 +233,54 @@ class CONTENT_EXPORT InputHandlerManager {
       const blink::WebGestureEvent& gesture_event,
       const cc::InputHandlerScrollResult& scroll_result);
 
+  void SetContentFeaturesOnCompositorThread(int routing_id,
+                                            int layer_count,
+                                            float raster_cost);
+  void SetOriginOnCompositorThread(int routing_id, const std::string& origin);
+  void SetVideoCadenceOnCompositorThread(int routing_id,
+                                         int fps,
+                                         base::TimeTicks frame_time);
+  void SetDisplayRefreshRatesOnCompositorThread(
+      int routing_id,
+      const std::vector<float>& refresh_rates);
+
+  // Replies from |model_task_runner_|. A null |model| failed to load; the
+  // slot for |type| is then emptied, and an origin keeps the default models.
+  void InstallModelOnCompositorThread(int routing_id,
+                                      ui::InputModelType type,
+                                      std::unique_ptr<ui::InputModel> model);
+  void InstallOriginModelOnCompositorThread(
+      int routing_id,
+      ui::InputModelType type,
+      const std::string& origin,
+      std::unique_ptr<ui::InputModel> model);
+  void ClearModelsOnCompositorThread(int routing_id);
+
+  // Type, device id and origin of a model held by |shared_models_|.
+  using SharedModelKey =
+      std::tuple<ui::InputModelType, std::string, std::string>;
+  struct SharedModel {
+    SharedModel();
+    ~SharedModel();
+
+    // The read-only model, unmapped, or null if none was fetched yet or the
+    // provider had none. Views map duplicates of its handle.
+    std::unique_ptr<base::SharedMemory> memory;
+    size_t size;
+    uint32_t version;
+    // Views to install the model for when the pending fetch replies.
+    std::vector<int> waiting_routing_ids;
+    bool fetching;
+  };
+  // Replies from |model_provider_|.
+  void OnGotSharedModel(const SharedModelKey& key,
+                        uint32_t version,
+                        mojo::ScopedSharedBufferHandle model,
+                        uint32_t size);
+  void InstallSharedModel(int routing_id,
+                          const SharedModelKey& key,
+                          const SharedModel& model);
+
   void DidHandleInputEventAndOverscroll(
       const InputEventAckStateCallback& callback,
       ui::InputHandlerProxy::EventDisposition event_disposition,
@@ -148,11 +293,24 @@ class CONTENT_EXPORT InputHandlerManager {
       InputHandlerMap;
   InputHandlerMap input_handlers_;
 
+  // Compositor thread only.
+  std::multimap<int, TargetFrameRateObserver*> target_frame_rate_observers_;
+
   const scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
   InputHandlerManagerClient* const client_;
   // May be null.
   SynchronousInputHandlerProxyClient* const synchronous_handler_proxy_client_;
   blink::scheduler::RendererScheduler* const renderer_scheduler_;  // Not owned.
+  // Sequenced, so that model updates land in the order they were sent. May be
+  // null.
+  scoped_refptr<base::SequencedTaskRunner> model_task_runner_;
+  // Handed over from the main thread and bound into |model_provider_| on the
+  // compositor thread.
+  mojom::InputModelProviderPtrInfo model_provider_info_;
+
+  // Compositor thread only.
+  mojom::InputModelProviderPtr model_provider_;
+  std::map<SharedModelKey, SharedModel> shared_models_;
 
   base::WeakPtrFactory<InputHandlerManager> weak_ptr_factory_;
 };
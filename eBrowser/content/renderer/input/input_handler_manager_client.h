@@ -5,12 +5,15 @@
 #ifndef CONTENT_RENDERER_INPUT_INPUT_HANDLER_MANAGER_CLIENT_H_
 #define CONTENT_RENDERER_INPUT_INPUT_HANDLER_MANAGER_CLIENT_H_
 
+#include <vector>
+
 #include "base/callback.h"
 #include "base/callback_forward.h"
 #include "base/macros.h"
 #include "content/common/content_export.h"
 #include "content/common/input/input_event_ack_state.h"
 #include "third_party/WebKit/public/web/WebInputEvent.h"
+#include "ui/events/blink/implicit_feedback_recorder.h"
 #include "ui/events/blink/scoped_web_input_event.h"
 #include "ui/gfx/geometry/vector2d_f.h"
 
@@ -49,6 +52,14 @@ class CONTENT_EXPORT InputHandlerManagerClient {
                              const ui::DidOverscrollParams& params) = 0;
   virtual void DidStartFlinging(int routing_id) = 0;
   virtual void DidStopFlinging(int routing_id) = 0;
+  // The renderer now targets |fps| frames per second, or the display rate if
+  // |fps| is ui::ScrollUpdatePacer::kMaxFrameRate.
+  virtual void DidChangeTargetFrameRate(int routing_id, int fps) = 0;
+  // Sends a batch of the implicit feedback recorded for the widget's
+  // throttled gestures on to the browser.
+  virtual void DidRecordImplicitFeedback(
+      int routing_id,
+      const std::vector<ui::ImplicitFeedbackSample>& samples) = 0;
   virtual void DispatchNonBlockingEventToMainThread(
       int routing_id,
       ui::ScopedWebInputEvent event,
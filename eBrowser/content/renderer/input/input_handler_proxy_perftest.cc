@@ -0,0 +1,363 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "cc/input/input_handler.h"
+#include "cc/input/main_thread_scrolling_reason.h"
+#include "cc/trees/swap_promise_monitor.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/WebKit/public/platform/WebGestureCurve.h"
+#include "third_party/WebKit/public/platform/WebInputEvent.h"
+#include "ui/events/blink/input_handler_proxy.h"
+#include "ui/events/blink/input_handler_proxy_client.h"
+#include "ui/events/blink/svm.h"
+#include "ui/events/blink/svm_predictor.h"
+#include "ui/events/latency_info.h"
+
+using blink::WebGestureEvent;
+using blink::WebInputEvent;
+
+namespace content {
+
+namespace {
+
+// The shared model served by the model server as models/model.
+const char kModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.1\n"
+    "nr_class 2\n"
+    "total_sv 31\n"
+    "rho -30.063987011970905\n"
+    "SV\n"
+    "-375.19069932927516 1:0.4\n"
+    "-1000.0 1:0.5\n"
+    "76.88789430911002 1:0.9\n"
+    "1000.0 1:1.0\n"
+    "1000.0 1:1.1\n"
+    "1000.0 1:1.3\n"
+    "-1000.0 1:1.5\n"
+    "-1000.0 1:2.0\n"
+    "152.42443338259005 1:2.8\n"
+    "-658.9273041510949 1:3.6\n"
+    "1000.0 1:4.0\n"
+    "110.25834122312415 1:4.8\n"
+    "-1000.0 1:5.6\n"
+    "1000.0 1:6.0\n"
+    "-1000.0 1:6.8\n"
+    "497.46093522517856 1:7.6\n"
+    "1000.0 1:8.0\n"
+    "-1000.0 1:8.8\n"
+    "-816.4934305923082 1:9.6\n"
+    "1000.0 1:10.0\n"
+    "471.5388027392294 1:11.0\n"
+    "-1000.0 1:12.0\n"
+    "771.8231997159018 1:13.0\n"
+    "-276.2898550887135 1:14.0\n"
+    "36.631108005750654 1:16.0\n"
+    "6.134237008088796 1:18.0\n"
+    "-13.277763249826501 1:20.0\n"
+    "16.396378331197322 1:21.0\n"
+    "-2.474188188578108 1:23.0\n"
+    "3.300645387053644 1:25.0\n"
+    "-0.20273472742506202 1:28.0\n";
+
+const int kRoutingId = 1;
+const double kFrameSeconds = 1. / 60;
+
+// Scroll speed over the course of a gesture, in DIPs per second, as seen in
+// traces of typical reading and skimming on a phone.
+struct ScrollProfile {
+  const char* name;
+  float start_speed;
+  float end_speed;
+  size_t steps;
+};
+
+const ScrollProfile kScrollProfiles[] = {
+    {"SlowRead", 80, 120, 120},
+    {"Skim", 600, 900, 60},
+    {"FastSwipe", 3000, 1500, 20},
+    {"Decelerate", 2000, 50, 90},
+};
+
+// Replays a GestureScrollBegin, |profile.steps| updates at 60Hz with
+// +-2ms of timestamp jitter, and a GestureScrollEnd. The speed ramps
+// linearly from the profile's start to its end speed.
+std::vector<WebGestureEvent> BuildScrollStream(const ScrollProfile& profile) {
+  std::vector<WebGestureEvent> events;
+  WebGestureEvent gesture;
+  gesture.sourceDevice = blink::WebGestureDeviceTouchscreen;
+  gesture.type = WebInputEvent::GestureScrollBegin;
+  gesture.x = 100;
+  gesture.y = 400;
+  gesture.timeStampSeconds = 1;
+  events.push_back(gesture);
+
+  gesture.type = WebInputEvent::GestureScrollUpdate;
+  for (size_t i = 0; i < profile.steps; ++i) {
+    float progress = static_cast<float>(i) / profile.steps;
+    float speed = profile.start_speed +
+                  (profile.end_speed - profile.start_speed) * progress;
+    gesture.data.scrollUpdate.deltaY = -speed * kFrameSeconds;
+    gesture.timeStampSeconds =
+        1 + (i + 1) * kFrameSeconds + (i % 2 ? 0.002 : -0.002);
+    events.push_back(gesture);
+  }
+
+  gesture.type = WebInputEvent::GestureScrollEnd;
+  gesture.timeStampSeconds += kFrameSeconds;
+  events.push_back(gesture);
+  return events;
+}
+
+// Accepts every scroll on the compositor thread.
+class NullInputHandler : public cc::InputHandler {
+ public:
+  NullInputHandler() {}
+  ~NullInputHandler() override {}
+
+  void BindToClient(cc::InputHandlerClient* client) override {}
+  ScrollStatus ScrollBegin(cc::ScrollState* scroll_state,
+                           ScrollInputType type) override {
+    return ScrollStatus(SCROLL_ON_IMPL_THREAD,
+                        cc::MainThreadScrollingReason::kNotScrollingOnMain);
+  }
+  ScrollStatus RootScrollBegin(cc::ScrollState* scroll_state,
+                               ScrollInputType type) override {
+    return ScrollBegin(scroll_state, type);
+  }
+  ScrollStatus ScrollAnimatedBegin(const gfx::Point& viewport_point) override {
+    return ScrollBegin(nullptr, TOUCHSCREEN);
+  }
+  ScrollStatus ScrollAnimated(const gfx::Point& viewport_point,
+                              const gfx::Vector2dF& scroll_delta,
+                              base::TimeDelta delayed_by) override {
+    return ScrollBegin(nullptr, TOUCHSCREEN);
+  }
+  cc::InputHandlerScrollResult ScrollBy(
+      cc::ScrollState* scroll_state) override {
+    cc::InputHandlerScrollResult result;
+    result.did_scroll = true;
+    return result;
+  }
+  void ScrollEnd(cc::ScrollState* scroll_state) override {}
+  ScrollStatus FlingScrollBegin() override {
+    return ScrollBegin(nullptr, TOUCHSCREEN);
+  }
+  void MouseMoveAt(const gfx::Point& mouse_position) override {}
+  void MouseDown() override {}
+  void MouseUp() override {}
+  void MouseLeave() override {}
+  void PinchGestureBegin() override {}
+  void PinchGestureUpdate(float magnify_delta,
+                          const gfx::Point& anchor) override {}
+  void PinchGestureEnd() override {}
+  void SetNeedsAnimateInput() override {}
+  bool IsCurrentlyScrollingViewport() const override { return true; }
+  bool IsCurrentlyScrollingLayerAt(const gfx::Point& viewport_point,
+                                   ScrollInputType type) const override {
+    return true;
+  }
+  cc::EventListenerProperties GetEventListenerProperties(
+      cc::EventListenerClass event_class) const override {
+    return cc::EventListenerProperties::kNone;
+  }
+  bool DoTouchEventsBlockScrollAt(const gfx::Point& viewport_port) override {
+    return false;
+  }
+  std::unique_ptr<cc::SwapPromiseMonitor> CreateLatencyInfoSwapPromiseMonitor(
+      ui::LatencyInfo* latency) override {
+    return nullptr;
+  }
+  cc::ScrollElasticityHelper* CreateScrollElasticityHelper() override {
+    return nullptr;
+  }
+  bool GetScrollOffsetForLayer(int layer_id,
+                               gfx::ScrollOffset* offset) override {
+    return false;
+  }
+  bool ScrollLayerTo(int layer_id, const gfx::ScrollOffset& offset) override {
+    return false;
+  }
+  void RequestUpdateForSynchronousInputHandler() override {}
+  void SetSynchronousInputHandlerRootScrollOffset(
+      const gfx::ScrollOffset& root_offset) override {}
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NullInputHandler);
+};
+
+class NullInputHandlerProxyClient : public ui::InputHandlerProxyClient {
+ public:
+  NullInputHandlerProxyClient() {}
+  ~NullInputHandlerProxyClient() override {}
+
+  void WillShutdown() override {}
+  void TransferActiveWheelFlingAnimation(
+      const blink::WebActiveWheelFlingParameters& params) override {}
+  void DispatchNonBlockingEventToMainThread(
+      ui::ScopedWebInputEvent event,
+      const ui::LatencyInfo& latency_info) override {}
+  blink::WebGestureCurve* CreateFlingAnimationCurve(
+      blink::WebGestureDevice device_source,
+      const blink::WebFloatPoint& velocity,
+      const blink::WebSize& cumulative_scroll) override {
+    return nullptr;
+  }
+  void DidOverscroll(const gfx::Vector2dF& accumulated_overscroll,
+                     const gfx::Vector2dF& latest_overscroll_delta,
+                     const gfx::Vector2dF& current_fling_velocity,
+                     const gfx::PointF& causal_event_viewport_point) override {}
+  void DidStartFlinging() override {}
+  void DidStopFlinging() override {}
+  void DidAnimateForInput() override {}
+  void DidChangeTargetFrameRate(int fps) override {}
+  void DidRecordImplicitFeedback(
+      const std::vector<ui::ImplicitFeedbackSample>& samples) override {}
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NullInputHandlerProxyClient);
+};
+
+// Returns the value of rank |fraction| * (n - 1), rounded to the nearest rank,
+// among the n |values| in increasing order.
+int Percentile(std::vector<int> values, double fraction) {
+  DCHECK(!values.empty());
+  DCHECK(fraction >= 0 && fraction <= 1);
+  const size_t last_rank = values.size() - 1;
+  const size_t rank = static_cast<size_t>(std::lround(fraction * last_rank));
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+}  // namespace
+
+class InputHandlerProxyPerfTest : public testing::Test {
+ public:
+  InputHandlerProxyPerfTest() {}
+  ~InputHandlerProxyPerfTest() override {}
+
+ protected:
+  void SetUp() override {
+    proxy_.reset(new ui::InputHandlerProxy(&input_handler_, &client_));
+    proxy_->HandleInputModelStrMsg(kRoutingId, ui::INPUT_MODEL_SCROLL,
+                                   kModel);
+    ASSERT_TRUE(proxy_->has_predictor());
+  }
+
+  // Feeds |events| through the proxy |iterations| times, ticking Animate()
+  // once per update as the compositor would. Reports the average time per
+  // event and the distribution of predicted frame rates.
+  void ReplayScrollStream(const char* trace,
+                          const std::vector<WebGestureEvent>& events,
+                          size_t iterations) {
+    std::vector<int> frame_rates;
+    base::TimeDelta elapsed;
+    for (size_t i = 0; i < iterations; ++i) {
+      frame_rates.clear();
+      base::TimeTicks start = base::TimeTicks::Now();
+      for (const WebGestureEvent& event : events) {
+        proxy_->HandleInputEvent(event);
+        if (event.type != WebInputEvent::GestureScrollUpdate)
+          continue;
+        proxy_->Animate(base::TimeTicks() + base::TimeDelta::FromSecondsD(
+                                                event.timeStampSeconds));
+        frame_rates.push_back(proxy_->paced_scroll_frame_rate());
+      }
+      elapsed += base::TimeTicks::Now() - start;
+    }
+
+    perf_test::PrintResult(
+        "avg_time_per_event", "", trace,
+        elapsed.InMicroseconds() * 1000. / (events.size() * iterations), "ns",
+        true);
+    // Paced frame rates are never negative.
+    perf_test::PrintResult("predicted_fps", "_p10", trace,
+                           static_cast<size_t>(Percentile(frame_rates, 0.1)),
+                           "fps", false);
+    perf_test::PrintResult("predicted_fps", "_p50", trace,
+                           static_cast<size_t>(Percentile(frame_rates, 0.5)),
+                           "fps", true);
+    perf_test::PrintResult("predicted_fps", "_p90", trace,
+                           static_cast<size_t>(Percentile(frame_rates, 0.9)),
+                           "fps", false);
+  }
+
+  NullInputHandler input_handler_;
+  NullInputHandlerProxyClient client_;
+  std::unique_ptr<ui::InputHandlerProxy> proxy_;
+};
+
+const size_t kDefaultIterations = 100;
+
+TEST_F(InputHandlerProxyPerfTest, ScrollStreams) {
+  for (const ScrollProfile& profile : kScrollProfiles) {
+    ReplayScrollStream(profile.name, BuildScrollStream(profile),
+                       kDefaultIterations);
+  }
+}
+
+TEST_F(InputHandlerProxyPerfTest, ScrollStreamsWithoutModel) {
+  proxy_->HandleInputModelStrMsg(kRoutingId, ui::INPUT_MODEL_SCROLL,
+                                 "stop");
+  for (const ScrollProfile& profile : kScrollProfiles) {
+    ReplayScrollStream(profile.name, BuildScrollStream(profile),
+                       kDefaultIterations);
+  }
+}
+
+// Time spent evaluating the model for one scroll update, for the libsvm
+// sparse kernel and for SvmPredictor, over the speed range the model covers.
+TEST(SvmPredictPerfTest, Predict) {
+  const int kSpeeds = 1000;
+  const int kIterations = 100;
+  svm_model* model = svm_load_model(kModel);
+  ASSERT_TRUE(model);
+  std::unique_ptr<ui::SvmPredictor> predictor =
+      ui::SvmPredictor::Create(kModel);
+  ASSERT_TRUE(predictor);
+
+  double sum = 0;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (int speed = 0; speed < kSpeeds; ++speed) {
+      svm_node x[] = {{1, speed * 0.03}, {-1, 0}};
+      sum += svm_predict(model, x);
+    }
+  }
+  base::TimeDelta sparse = base::TimeTicks::Now() - start;
+
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (int speed = 0; speed < kSpeeds; ++speed)
+      sum -= predictor->Predict(speed * 0.03);
+  }
+  base::TimeDelta dense = base::TimeTicks::Now() - start;
+  // Keeps the loops from being optimized away; the paths agree closely.
+  EXPECT_LT(std::abs(sum), kSpeeds * kIterations);
+
+  perf_test::PrintResult("svm_predict", "", "sparse",
+                         sparse.InMicroseconds() * 1000. /
+                             (kSpeeds * kIterations),
+                         "ns", true);
+  perf_test::PrintResult("svm_predict", "", "SvmPredictor",
+                         dense.InMicroseconds() * 1000. /
+                             (kSpeeds * kIterations),
+                         "ns", true);
+  svm_free_and_destroy_model(&model);
+}
+
+}  // namespace content
@@ -4,16 +4,33 @@
 
 #include "content/renderer/input/input_handler_wrapper.h"
 
+#include <memory>
+#include <utility>
+
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/location.h"
+#include "base/logging.h"
+#include "base/metrics/field_trial.h"
+#include "base/strings/string_number_conversions.h"
+#include "content/public/common/content_features.h"
 #include "content/public/common/content_switches.h"
 #include "content/renderer/input/input_event_filter.h"
 #include "content/renderer/input/input_handler_manager.h"
 #include "third_party/WebKit/public/platform/Platform.h"
 #include "ui/events/blink/did_overscroll_params.h"
+#include "ui/events/blink/input_rate_controller.h"
 
 namespace content {
 
+namespace {
+
+// Table step used by the table policy when --ebrowser-predictor-table-step
+// is not given, in model speed units.
+const double kDefaultTableStep = 0.1;
+
+}  // namespace
+
 InputHandlerWrapper::InputHandlerWrapper(
     InputHandlerManager* input_handler_manager,
     int routing_id,
@@ -28,6 +45,65 @@ InputHandlerWrapper::InputHandlerWrapper(
       render_view_impl_(render_view_impl) {
   DCHECK(input_handler);
   input_handler_proxy_.set_smooth_scroll_enabled(enable_smooth_scrolling);
+
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  double table_step = 0;
+  if (command_line.HasSwitch(switches::kEBrowserPredictorTableStep) &&
+      base::StringToDouble(command_line.GetSwitchValueASCII(
+                               switches::kEBrowserPredictorTableStep),
+                           &table_step)) {
+    input_handler_proxy_.set_frame_rate_table_step(table_step);
+  }
+  double fling_cutoff = 0;
+  if (command_line.HasSwitch(switches::kEBrowserFlingCutoff) &&
+      base::StringToDouble(
+          command_line.GetSwitchValueASCII(switches::kEBrowserFlingCutoff),
+          &fling_cutoff)) {
+    input_handler_proxy_.set_fling_cutoff(fling_cutoff);
+  }
+  input_handler_proxy_.set_default_model_enabled(
+      base::FeatureList::IsEnabled(features::kEBrowserDefaultInputModel));
+
+  ui::InputRatePolicy policy = ui::INPUT_RATE_POLICY_SVR_SLEEP;
+  if (command_line.HasSwitch(switches::kEBrowserInputRateController)) {
+    std::string name = command_line.GetSwitchValueASCII(
+        switches::kEBrowserInputRateController);
+    if (!ui::InputRateController::ParsePolicy(name, &policy))
+      LOG(ERROR) << "Unknown input rate controller: " << name;
+  } else if (base::FeatureList::IsEnabled(
+                 features::kEBrowserInputRateExperiment)) {
+    base::FieldTrial* trial = base::FeatureList::GetFieldTrial(
+        features::kEBrowserInputRateExperiment);
+    // Arms with other names, such as a default group, keep the default.
+    if (trial)
+      ui::InputRateController::ParsePolicy(trial->group_name(), &policy);
+  }
+  std::unique_ptr<ui::InputRateController> rate_controller =
+      ui::InputRateController::Create(policy);
+  if (command_line.HasSwitch(switches::kEBrowserGestureRatePolicies)) {
+    std::string spec = command_line.GetSwitchValueASCII(
+        switches::kEBrowserGestureRatePolicies);
+    if (!rate_controller->ParseGesturePolicies(spec))
+      LOG(ERROR) << "Invalid gesture rate policies: " << spec;
+  }
+  input_handler_proxy_.SetRateController(std::move(rate_controller));
+  if (command_line.HasSwitch(switches::kEBrowserEnergyBudget)) {
+    std::string value =
+        command_line.GetSwitchValueASCII(switches::kEBrowserEnergyBudget);
+    ui::EnergyBudget budget;
+    if (base::StringToDouble(value, &budget.milliwatts) &&
+        budget.milliwatts > 0) {
+      input_handler_proxy_.SetEnergyBudget(budget);
+    } else {
+      LOG(ERROR) << "Invalid energy budget: " << value;
+    }
+  }
+  // The table policy needs the models compiled into tables.
+  if (policy == ui::INPUT_RATE_POLICY_TABLE_LOOKUP &&
+      input_handler_proxy_.frame_rate_table_step() <= 0) {
+    input_handler_proxy_.set_frame_rate_table_step(kDefaultTableStep);
+  }
 }
 
 InputHandlerWrapper::~InputHandlerWrapper() {
@@ -91,4 +167,13 @@ void InputHandlerWrapper::DidAnimateForInput() {
   input_handler_manager_->DidAnimateForInput();
 }
 
+void InputHandlerWrapper::DidChangeTargetFrameRate(int fps) {
+  input_handler_manager_->DidChangeTargetFrameRate(routing_id_, fps);
+}
+
+void InputHandlerWrapper::DidRecordImplicitFeedback(
+    const std::vector<ui::ImplicitFeedbackSample>& samples) {
+  input_handler_manager_->DidRecordImplicitFeedback(routing_id_, samples);
+}
+
 }  // namespace content
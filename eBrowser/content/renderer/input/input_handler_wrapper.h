@@ -56,6 +56,9 @@ class InputHandlerWrapper : public ui::InputHandlerProxyClient {
   void DidStartFlinging() override;
   void DidStopFlinging() override;
   void DidAnimateForInput() override;
+  void DidChangeTargetFrameRate(int fps) override;
+  void DidRecordImplicitFeedback(
+      const std::vector<ui::ImplicitFeedbackSample>& samples) override;
 
  private:
   InputHandlerManager* input_handler_manager_;
@@ -0,0 +1,109 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/input/input_message_ring.h"
+
+#include "base/logging.h"
+
+namespace content {
+
+InputMessageRing::Slot::Slot() {}
+
+InputMessageRing::Slot::~Slot() {}
+
+InputMessageRing::InputMessageRing(size_t capacity)
+    : mask_(static_cast<uint32_t>(capacity - 1)),
+      slots_(capacity),
+      push_count_(0),
+      pop_count_(0),
+      drain_pending_(0),
+      overflowing_(0),
+      front_is_overflow_(false) {
+  DCHECK_GT(capacity, 0u);
+  DCHECK_EQ(0u, capacity & (capacity - 1));
+}
+
+InputMessageRing::~InputMessageRing() {}
+
+void InputMessageRing::Push(const IPC::Message& message,
+                            base::TimeTicks received_time) {
+  if (!base::subtle::Acquire_Load(&overflowing_)) {
+    uint32_t pushed =
+        static_cast<uint32_t>(base::subtle::NoBarrier_Load(&push_count_));
+    uint32_t popped =
+        static_cast<uint32_t>(base::subtle::Acquire_Load(&pop_count_));
+    if (pushed - popped <= mask_) {
+      Slot& slot = slots_[pushed & mask_];
+      slot.message = message;
+      slot.received_time = received_time;
+      base::subtle::Release_Store(
+          &push_count_, static_cast<base::subtle::Atomic32>(pushed + 1));
+      return;
+    }
+  }
+
+  base::AutoLock lock(overflow_lock_);
+  overflow_.emplace_back();
+  overflow_.back().message = message;
+  overflow_.back().received_time = received_time;
+  base::subtle::Release_Store(&overflowing_, 1);
+}
+
+bool InputMessageRing::RequestDrain() {
+  // Orders the push before the check, against the consumer clearing
+  // |drain_pending_| before it checks for messages; otherwise both could
+  // miss the message.
+  base::subtle::MemoryBarrier();
+  return base::subtle::NoBarrier_CompareAndSwap(&drain_pending_, 0, 1) == 0;
+}
+
+void InputMessageRing::DidStartDrain() {
+  base::subtle::NoBarrier_Store(&drain_pending_, 0);
+  base::subtle::MemoryBarrier();
+}
+
+const InputMessageRing::Slot* InputMessageRing::Front() {
+  if (front_is_overflow_)
+    return &overflow_front_;
+
+  uint32_t popped =
+      static_cast<uint32_t>(base::subtle::NoBarrier_Load(&pop_count_));
+  uint32_t pushed =
+      static_cast<uint32_t>(base::subtle::Acquire_Load(&push_count_));
+  if (pushed != popped)
+    return &slots_[popped & mask_];
+
+  if (!base::subtle::Acquire_Load(&overflowing_))
+    return nullptr;
+  // The producer pushes nothing to the ring while overflowing, so messages
+  // it pushed there before it overflowed are older than the overflow. Check
+  // for them again, in case they came after the first check.
+  pushed = static_cast<uint32_t>(base::subtle::Acquire_Load(&push_count_));
+  if (pushed != popped)
+    return &slots_[popped & mask_];
+  base::AutoLock lock(overflow_lock_);
+  DCHECK(!overflow_.empty());
+  overflow_front_ = overflow_.front();
+  overflow_.pop_front();
+  if (overflow_.empty())
+    base::subtle::Release_Store(&overflowing_, 0);
+  front_is_overflow_ = true;
+  return &overflow_front_;
+}
+
+void InputMessageRing::PopFront() {
+  if (front_is_overflow_) {
+    front_is_overflow_ = false;
+    return;
+  }
+  uint32_t popped =
+      static_cast<uint32_t>(base::subtle::NoBarrier_Load(&pop_count_));
+  DCHECK_NE(popped,
+            static_cast<uint32_t>(base::subtle::Acquire_Load(&push_count_)));
+  // Releases the slot to the producer once the consumer is done with it.
+  base::subtle::Release_Store(&pop_count_,
+                              static_cast<base::subtle::Atomic32>(popped + 1));
+}
+
+}  // namespace content
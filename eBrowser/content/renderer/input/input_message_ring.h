@@ -0,0 +1,92 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_INPUT_INPUT_MESSAGE_RING_H_
+#define CONTENT_RENDERER_INPUT_INPUT_MESSAGE_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+#include "ipc/ipc_message.h"
+
+namespace content {
+
+// InputMessageRing hands input messages from the IO thread to the compositor
+// thread without a task, and so without a closure allocation and a task queue
+// lock, per message. It is a single producer, single consumer ring of
+// preallocated slots: a slot's message keeps its buffer once it has held a
+// message that large, so in the steady state neither thread allocates.
+//
+// The producer calls |Push()|, then posts a drain task only if
+// |RequestDrain()| returns true, so a burst of messages costs one wakeup. The
+// consumer's drain task calls |DidStartDrain()|, then consumes |Front()| and
+// |PopFront()| until the ring is empty.
+//
+// If the ring is full, messages go to a locked overflow queue, and keep going
+// there until the consumer has emptied it, so that they are consumed in the
+// order they were pushed.
+class CONTENT_EXPORT InputMessageRing {
+ public:
+  struct Slot {
+    Slot();
+    ~Slot();
+
+    IPC::Message message;
+    base::TimeTicks received_time;
+  };
+
+  // |capacity| must be a power of two.
+  explicit InputMessageRing(size_t capacity);
+  ~InputMessageRing();
+
+  // Called from the producer thread.
+  void Push(const IPC::Message& message, base::TimeTicks received_time);
+  // Returns true if no drain is pending, in which case the caller must post
+  // one. Called from the producer thread, after |Push()|.
+  bool RequestDrain();
+
+  // Called from the consumer thread, before consuming: messages pushed from
+  // then on request a new drain.
+  void DidStartDrain();
+  // Returns the oldest message, or null if there is none. The slot stays
+  // valid until |PopFront()|. Called from the consumer thread.
+  const Slot* Front();
+  void PopFront();
+
+ private:
+  const uint32_t mask_;
+  std::vector<Slot> slots_;
+
+  // Number of slots pushed and popped since the ring was created, wrapping
+  // around. Written by the producer and the consumer respectively.
+  base::subtle::Atomic32 push_count_;
+  base::subtle::Atomic32 pop_count_;
+
+  // Non-zero while a drain task is posted or running.
+  base::subtle::Atomic32 drain_pending_;
+
+  // Non-zero while |overflow_| holds messages, during which the producer
+  // bypasses the ring. Written with |overflow_lock_| held.
+  base::subtle::Atomic32 overflowing_;
+  base::Lock overflow_lock_;
+  std::deque<Slot> overflow_;
+
+  // The overflow message returned by |Front()|, owned by the consumer.
+  Slot overflow_front_;
+  bool front_is_overflow_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputMessageRing);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_RENDERER_INPUT_INPUT_MESSAGE_RING_H_
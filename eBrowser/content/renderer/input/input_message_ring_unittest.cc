@@ -0,0 +1,136 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/input/input_message_ring.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/threading/simple_thread.h"
+#include "ipc/ipc_message.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+namespace {
+
+const int kTestRoutingID = 13;
+const uint32_t kTestMessageType = 1;
+
+IPC::Message CreateMessage(int value) {
+  IPC::Message message(kTestRoutingID, kTestMessageType,
+                       IPC::Message::PRIORITY_NORMAL);
+  message.WriteInt(value);
+  return message;
+}
+
+int ReadValue(const IPC::Message& message) {
+  base::PickleIterator iter(message);
+  int value = -1;
+  EXPECT_TRUE(iter.ReadInt(&value));
+  return value;
+}
+
+// Pops every message left in |ring|, returning their values in order.
+std::vector<int> Drain(InputMessageRing* ring) {
+  std::vector<int> values;
+  ring->DidStartDrain();
+  while (const InputMessageRing::Slot* slot = ring->Front()) {
+    values.push_back(ReadValue(slot->message));
+    ring->PopFront();
+  }
+  return values;
+}
+
+class Producer : public base::DelegateSimpleThread::Delegate {
+ public:
+  Producer(InputMessageRing* ring, int count) : ring_(ring), count_(count) {}
+
+  void Run() override {
+    for (int i = 0; i < count_; ++i) {
+      ring_->Push(CreateMessage(i), base::TimeTicks());
+      ring_->RequestDrain();
+    }
+  }
+
+ private:
+  InputMessageRing* ring_;
+  int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(Producer);
+};
+
+}  // namespace
+
+TEST(InputMessageRingTest, MessagesConsumedInOrder) {
+  InputMessageRing ring(4);
+  EXPECT_FALSE(ring.Front());
+
+  base::TimeTicks received_time = base::TimeTicks::Now();
+  ring.Push(CreateMessage(1), received_time);
+  ring.Push(CreateMessage(2), base::TimeTicks());
+  ASSERT_TRUE(ring.Front());
+  EXPECT_EQ(kTestRoutingID, ring.Front()->message.routing_id());
+  EXPECT_EQ(received_time, ring.Front()->received_time);
+  EXPECT_EQ(std::vector<int>({1, 2}), Drain(&ring));
+
+  // Run around the ring a few times.
+  for (int i = 0; i < 10; ++i) {
+    ring.Push(CreateMessage(2 * i), base::TimeTicks());
+    ring.Push(CreateMessage(2 * i + 1), base::TimeTicks());
+    ring.Push(CreateMessage(-1), base::TimeTicks());
+    EXPECT_EQ(std::vector<int>({2 * i, 2 * i + 1, -1}), Drain(&ring));
+  }
+}
+
+TEST(InputMessageRingTest, OneDrainRequestUntilDrainStarts) {
+  InputMessageRing ring(4);
+  ring.Push(CreateMessage(1), base::TimeTicks());
+  EXPECT_TRUE(ring.RequestDrain());
+  ring.Push(CreateMessage(2), base::TimeTicks());
+  EXPECT_FALSE(ring.RequestDrain());
+
+  EXPECT_EQ(std::vector<int>({1, 2}), Drain(&ring));
+  ring.Push(CreateMessage(3), base::TimeTicks());
+  EXPECT_TRUE(ring.RequestDrain());
+}
+
+TEST(InputMessageRingTest, OverflowKeepsOrder) {
+  InputMessageRing ring(2);
+  for (int i = 0; i < 5; ++i)
+    ring.Push(CreateMessage(i), base::TimeTicks());
+
+  // Once overflowing, messages keep going to the overflow even when slots
+  // free up, until it is empty.
+  ASSERT_TRUE(ring.Front());
+  EXPECT_EQ(0, ReadValue(ring.Front()->message));
+  ring.PopFront();
+  ring.Push(CreateMessage(5), base::TimeTicks());
+  EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5}), Drain(&ring));
+
+  ring.Push(CreateMessage(6), base::TimeTicks());
+  EXPECT_EQ(std::vector<int>({6}), Drain(&ring));
+}
+
+TEST(InputMessageRingTest, ConcurrentProducer) {
+  const int kCount = 10000;
+  InputMessageRing ring(16);
+  Producer producer(&ring, kCount);
+  base::DelegateSimpleThread thread(&producer, "InputMessageRingProducer");
+  thread.Start();
+
+  int expected = 0;
+  while (expected < kCount) {
+    while (const InputMessageRing::Slot* slot = ring.Front()) {
+      EXPECT_EQ(expected++, ReadValue(slot->message));
+      ring.PopFront();
+    }
+  }
+  thread.Join();
+  EXPECT_FALSE(ring.Front());
+}
+
+}  // namespace content
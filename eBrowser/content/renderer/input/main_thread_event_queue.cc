@@ -7,6 +7,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "content/common/input/event_with_latency_info.h"
 #include "content/common/input_messages.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 
 namespace content {
 
@@ -57,7 +58,7 @@ void EventWithDispatchType::CoalesceWith(const EventWithDispatchType& other) {
 }
 
 MainThreadEventQueue::SharedState::SharedState()
-    : sent_main_frame_request_(false) {}
+    : sent_main_frame_request_(false), frame_rate_throttled_(false) {}
 
 MainThreadEventQueue::SharedState::~SharedState() {}
 
@@ -177,6 +178,23 @@ void MainThreadEventQueue::DispatchInFlightEvent() {
   in_flight_event_.reset();
 }
 
+bool MainThreadEventQueue::IsRafAlignedEvent(
+    const std::unique_ptr<EventWithDispatchType>& event) const {
+  shared_state_lock_.AssertAcquired();
+  if (isContinuousEvent(event))
+    return true;
+  // At a reduced frame rate the main thread scroll runs once per main frame,
+  // the frame that shows it, rather than once per gesture scroll update.
+  return shared_state_.frame_rate_throttled_ &&
+         event->event().type == blink::WebInputEvent::GestureScrollUpdate;
+}
+
+void MainThreadEventQueue::SetTargetFrameRate(int fps) {
+  base::AutoLock lock(shared_state_lock_);
+  shared_state_.frame_rate_throttled_ =
+      fps < ui::ScrollUpdatePacer::kMaxFrameRate;
+}
+
 void MainThreadEventQueue::PossiblyScheduleMainFrame() {
   if (!handle_raf_aligned_input_)
     return;
@@ -185,7 +203,7 @@ void MainThreadEventQueue::PossiblyScheduleMainFrame() {
     base::AutoLock lock(shared_state_lock_);
     if (!shared_state_.sent_main_frame_request_ &&
         !shared_state_.events_.empty() &&
-        isContinuousEvent(shared_state_.events_.front())) {
+        IsRafAlignedEvent(shared_state_.events_.front())) {
       needs_main_frame = !shared_state_.sent_main_frame_request_;
       shared_state_.sent_main_frame_request_ = false;
     }
@@ -230,7 +248,7 @@ void MainThreadEventQueue::DispatchRafAlignedInput() {
     shared_state_.sent_main_frame_request_ = false;
 
     while(!shared_state_.events_.empty()) {
-      if (!isContinuousEvent(shared_state_.events_.front()))
+      if (!IsRafAlignedEvent(shared_state_.events_.front()))
         break;
       events_to_process.emplace_back(shared_state_.events_.Pop());
     }
@@ -251,23 +269,23 @@ void MainThreadEventQueue::SendEventNotificationToMainThread() {
 
 void MainThreadEventQueue::QueueEvent(
     std::unique_ptr<EventWithDispatchType> event) {
-  bool is_continuous = isContinuousEvent(event);
   size_t send_notification_count = 0;
   bool needs_main_frame = false;
   {
     base::AutoLock lock(shared_state_lock_);
+    bool is_raf_aligned = IsRafAlignedEvent(event);
     size_t size_before = shared_state_.events_.size();
     shared_state_.events_.Queue(std::move(event));
     size_t size_after = shared_state_.events_.size();
     if (size_before != size_after) {
       if (!handle_raf_aligned_input_) {
         send_notification_count = 1;
-      } else if (!is_continuous) {
+      } else if (!is_raf_aligned) {
         send_notification_count = 1;
         // If we had just enqueued a non-rAF input event we will send a series
         // of normal post messages to ensure they are all handled right away.
         for (size_t pos = size_after - 1; pos >= 1; --pos) {
-          if (isContinuousEvent(shared_state_.events_.at(pos - 1)))
+          if (IsRafAlignedEvent(shared_state_.events_.at(pos - 1)))
             send_notification_count++;
           else
             break;
@@ -129,6 +129,13 @@ class CONTENT_EXPORT MainThreadEventQueue
 
   void set_is_flinging(bool is_flinging) { is_flinging_ = is_flinging; }
 
+  // Called from the compositor thread when the renderer's target frame rate
+  // changes. Below the display rate, main frames are throttled, and gesture
+  // scroll updates the compositor did not handle are aligned to them like
+  // continuous events: they wait in the queue, coalescing, for the next
+  // main frame instead of each running a main thread scroll.
+  void SetTargetFrameRate(int fps);
+
  private:
   friend class base::RefCountedThreadSafe<MainThreadEventQueue>;
   ~MainThreadEventQueue();
@@ -137,6 +144,10 @@ class CONTENT_EXPORT MainThreadEventQueue
   void DispatchSingleEvent();
   void DispatchInFlightEvent();
   void PossiblyScheduleMainFrame();
+  // Whether |event| waits for the next main frame. Must be called with
+  // |shared_state_lock_| held.
+  bool IsRafAlignedEvent(
+      const std::unique_ptr<EventWithDispatchType>& event) const;
 
   void SendEventToMainThread(const blink::WebInputEvent* event,
                              const ui::LatencyInfo& latency,
@@ -158,6 +169,8 @@ class CONTENT_EXPORT MainThreadEventQueue
 
     WebInputEventQueue<EventWithDispatchType> events_;
     bool sent_main_frame_request_;
+    // Whether the renderer targets a frame rate below the display rate.
+    bool frame_rate_throttled_;
   };
 
   // Lock used to serialize |shared_state_|.
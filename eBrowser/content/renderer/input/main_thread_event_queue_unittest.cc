@@ -19,6 +19,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/WebKit/public/platform/scheduler/test/mock_renderer_scheduler.h"
 
+using blink::WebGestureEvent;
 using blink::WebInputEvent;
 using blink::WebMouseEvent;
 using blink::WebMouseWheelEvent;
@@ -94,6 +95,8 @@ class MainThreadEventQueueTest : public testing::TestWithParam<bool>,
     return queue_->last_touch_start_forced_nonblocking_due_to_fling_;
   }
 
+  void SetTargetFrameRate(int fps) { queue_->SetTargetFrameRate(fps); }
+
   void set_enable_fling_passive_listener_flag(bool enable_flag) {
     queue_->enable_fling_passive_listener_flag_ = enable_flag;
   }
@@ -421,6 +424,51 @@ TEST_P(MainThreadEventQueueTest, RafAlignedTouchInput) {
   main_task_runner_->RunUntilIdle();
 }
 
+TEST_P(MainThreadEventQueueTest, RafAlignedScrollUpdatesWhenThrottled) {
+  // Don't run the test when we aren't supporting rAF aligned input.
+  if (!handle_raf_aligned_input_)
+    return;
+
+  WebGestureEvent scroll_update =
+      SyntheticWebGestureEventBuilder::BuildScrollUpdate(
+          0, -10, 0, blink::WebGestureDeviceTouchscreen);
+
+  // At the display rate, unhandled scroll updates are dispatched right away.
+  HandleEvent(scroll_update, INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  EXPECT_TRUE(main_task_runner_->HasPendingTask());
+  EXPECT_FALSE(needs_main_frame_);
+  main_task_runner_->RunUntilIdle();
+  EXPECT_EQ(1u, handled_events_.size());
+
+  // Below it, they wait for the next main frame, coalescing, and every
+  // coalesced update is acked.
+  SetTargetFrameRate(30);
+  HandleEvent(scroll_update, INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  HandleEvent(scroll_update, INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  EXPECT_FALSE(main_task_runner_->HasPendingTask());
+  EXPECT_TRUE(needs_main_frame_);
+  EXPECT_EQ(1u, event_queue().size());
+  RunSimulatedRafOnce();
+  EXPECT_EQ(0u, event_queue().size());
+  EXPECT_EQ(2u, handled_events_.size());
+  EXPECT_EQ(-20, static_cast<const WebGestureEvent&>(*handled_events_.back())
+                     .data.scrollUpdate.deltaY);
+  EXPECT_EQ(1u, additional_acked_events_.size());
+
+  // A discrete event still flushes them.
+  HandleEvent(scroll_update, INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  WebGestureEvent scroll_end = SyntheticWebGestureEventBuilder::Build(
+      WebInputEvent::GestureScrollEnd, blink::WebGestureDeviceTouchscreen);
+  HandleEvent(scroll_end, INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  main_task_runner_->RunUntilIdle();
+  EXPECT_EQ(0u, event_queue().size());
+  EXPECT_EQ(4u, handled_events_.size());
+
+  SetTargetFrameRate(60);
+  HandleEvent(scroll_update, INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  EXPECT_TRUE(main_task_runner_->HasPendingTask());
+}
+
 TEST_P(MainThreadEventQueueTest, BlockingTouchesDuringFling) {
   SyntheticWebTouchEvent kEvents[1];
   kEvents[0].PressPoint(10, 10);
@@ -0,0 +1,83 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/media/video_cadence_estimator.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace content {
+
+namespace {
+
+// Enough intervals to cover several periods of a pulldown pattern.
+const int kMinIntervals = 10;
+// Each later interval's weight in the average.
+const double kIntervalWeight = 0.1;
+// A longer gap is a pause or a stall, after which the video starts over.
+const int kMaxIntervalMs = 250;
+// How far the average rate may stray from the reported one, beyond the half
+// frame per second that rounding allows, before the rate is reported as
+// changed.
+const double kFrameRateHysteresis = 0.25;
+const int kMaxFrameRate = 60;
+
+}  // namespace
+
+VideoCadenceEstimator::VideoCadenceEstimator()
+    : interval_count_(0), frame_rate_(0) {}
+
+VideoCadenceEstimator::~VideoCadenceEstimator() {}
+
+bool VideoCadenceEstimator::AddFrame(base::TimeTicks display_time) {
+  base::TimeDelta interval = display_time - last_frame_time_;
+  bool had_frame = !last_frame_time_.is_null();
+  last_frame_time_ = display_time;
+  if (!had_frame || interval <= base::TimeDelta())
+    return false;
+  if (interval > base::TimeDelta::FromMilliseconds(kMaxIntervalMs)) {
+    base::TimeTicks frame_time = last_frame_time_;
+    bool changed = Reset();
+    last_frame_time_ = frame_time;
+    return changed;
+  }
+
+  // The first intervals are averaged evenly, which a whole number of
+  // pulldown periods averages exactly; later ones track rate changes.
+  ++interval_count_;
+  if (interval_count_ <= kMinIntervals) {
+    average_interval_ +=
+        (interval - average_interval_) / static_cast<int64_t>(interval_count_);
+  } else {
+    average_interval_ = average_interval_ * (1 - kIntervalWeight) +
+                        interval * kIntervalWeight;
+  }
+  if (interval_count_ < kMinIntervals)
+    return false;
+
+  double fps = 1 / average_interval_.InSecondsF();
+  if (frame_rate_ &&
+      std::abs(fps - frame_rate_) <= 0.5 + kFrameRateHysteresis) {
+    return false;
+  }
+  int rounded_fps = std::max(
+      1, std::min(static_cast<int>(std::round(fps)), kMaxFrameRate));
+  if (rounded_fps == frame_rate_)
+    return false;
+  frame_rate_ = rounded_fps;
+  return true;
+}
+
+bool VideoCadenceEstimator::Reset() {
+  bool had_frame_rate = frame_rate_ != 0;
+  last_frame_time_ = base::TimeTicks();
+  average_interval_ = base::TimeDelta();
+  interval_count_ = 0;
+  frame_rate_ = 0;
+  return had_frame_rate;
+}
+
+}  // namespace content
@@ -0,0 +1,50 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_MEDIA_VIDEO_CADENCE_ESTIMATOR_H_
+#define CONTENT_RENDERER_MEDIA_VIDEO_CADENCE_ESTIMATOR_H_
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+// Estimates the rate a video presents new frames at from the times they are
+// first displayed, so that interaction pacing can put its frames on the
+// video's instead of interleaving with them. A display vsync grid makes the
+// intervals uneven, e.g. a 24fps video alternates 3 and 2 frames at 60Hz,
+// so the rate comes from the average interval, and only changes once the
+// average strays from it by more than that jitter.
+class CONTENT_EXPORT VideoCadenceEstimator {
+ public:
+  VideoCadenceEstimator();
+  ~VideoCadenceEstimator();
+
+  // Records that a new frame was first displayed at |display_time|. Returns
+  // true if frame_rate() changed.
+  bool AddFrame(base::TimeTicks display_time);
+
+  // Forgets the frames seen so far. Returns true if frame_rate() was set.
+  bool Reset();
+
+  // The estimated rate in frames per second, or 0 while unknown.
+  int frame_rate() const { return frame_rate_; }
+  // The display time of the latest frame, through which the video's frame
+  // grid runs.
+  base::TimeTicks last_frame_time() const { return last_frame_time_; }
+
+ private:
+  base::TimeTicks last_frame_time_;
+  // Exponentially weighted average of the intervals between frames.
+  base::TimeDelta average_interval_;
+  int interval_count_;
+  int frame_rate_;
+
+  DISALLOW_COPY_AND_ASSIGN(VideoCadenceEstimator);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_RENDERER_MEDIA_VIDEO_CADENCE_ESTIMATOR_H_
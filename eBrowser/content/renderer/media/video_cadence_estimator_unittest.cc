@@ -0,0 +1,85 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/media/video_cadence_estimator.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+base::TimeTicks VsyncTime(int vsync) {
+  return base::TimeTicks() + base::TimeDelta::FromMicroseconds(16667 * vsync);
+}
+
+// Displays |frames| frames of a |fps| video on a 60Hz display, each on the
+// first vsync at or after its presentation time, starting at |*vsync|.
+// Returns how often the rate changed.
+int PlayVideo(VideoCadenceEstimator* estimator,
+              int fps,
+              int frames,
+              int* vsync) {
+  int changes = 0;
+  int start = *vsync;
+  for (int frame = 0; frame < frames; ++frame) {
+    *vsync = start + (frame * 60 + fps - 1) / fps;
+    if (estimator->AddFrame(VsyncTime(*vsync)))
+      ++changes;
+  }
+  return changes;
+}
+
+}  // namespace
+
+TEST(VideoCadenceEstimatorTest, PulldownPatterns) {
+  const int kFrameRates[] = {24, 25, 30, 15};
+  for (int fps : kFrameRates) {
+    VideoCadenceEstimator estimator;
+    int vsync = 1;
+    EXPECT_EQ(1, PlayVideo(&estimator, fps, 120, &vsync)) << fps;
+    EXPECT_EQ(fps, estimator.frame_rate());
+    EXPECT_EQ(VsyncTime(vsync), estimator.last_frame_time());
+  }
+}
+
+TEST(VideoCadenceEstimatorTest, UnknownUntilEnoughFrames) {
+  VideoCadenceEstimator estimator;
+  int vsync = 0;
+  EXPECT_EQ(0, PlayVideo(&estimator, 30, 10, &vsync));
+  EXPECT_EQ(0, estimator.frame_rate());
+  EXPECT_EQ(1, PlayVideo(&estimator, 30, 2, &vsync));
+  EXPECT_EQ(30, estimator.frame_rate());
+}
+
+TEST(VideoCadenceEstimatorTest, FollowsRateChanges) {
+  VideoCadenceEstimator estimator;
+  int vsync = 0;
+  PlayVideo(&estimator, 30, 60, &vsync);
+  EXPECT_EQ(30, estimator.frame_rate());
+  vsync += 4;
+  EXPECT_LE(1, PlayVideo(&estimator, 24, 120, &vsync));
+  EXPECT_EQ(24, estimator.frame_rate());
+}
+
+TEST(VideoCadenceEstimatorTest, PauseStartsOver) {
+  VideoCadenceEstimator estimator;
+  int vsync = 0;
+  PlayVideo(&estimator, 30, 60, &vsync);
+  EXPECT_EQ(30, estimator.frame_rate());
+
+  // A second without frames.
+  vsync += 60;
+  EXPECT_TRUE(estimator.AddFrame(VsyncTime(vsync)));
+  EXPECT_EQ(0, estimator.frame_rate());
+  EXPECT_EQ(VsyncTime(vsync), estimator.last_frame_time());
+
+  PlayVideo(&estimator, 30, 60, &vsync);
+  EXPECT_EQ(30, estimator.frame_rate());
+  EXPECT_TRUE(estimator.Reset());
+  EXPECT_EQ(0, estimator.frame_rate());
+  EXPECT_FALSE(estimator.Reset());
+}
+
+}  // namespace content
@@ -23,6 +23,7 @@
 #include "content/renderer/media/webmediaplayer_ms_compositor.h"
 #include "content/renderer/render_frame_impl.h"
 #include "content/renderer/render_thread_impl.h"
+#include "content/renderer/render_widget.h"
 #include "media/base/media_content_type.h"
 #include "media/base/media_log.h"
 #include "media/base/video_frame.h"
@@ -72,7 +73,8 @@ WebMediaPlayerMS::WebMediaPlayerMS(
                                    : url::Origin(security_origin)),
       volume_(1.0),
       volume_multiplier_(1.0),
-      should_play_upon_shown_(false) {
+      should_play_upon_shown_(false),
+      video_frame_rate_(0) {
   DVLOG(1) << __func__;
   DCHECK(client);
   if (delegate_)
@@ -99,6 +101,9 @@ WebMediaPlayerMS::~WebMediaPlayerMS() {
   if (audio_renderer_)
     audio_renderer_->Stop();
 
+  if (video_frame_rate_)
+    OnVideoCadenceChanged(0, base::TimeTicks());
+
   media_log_->AddEvent(
       media_log_->CreateEvent(media::MediaLogEvent::WEBMEDIAPLAYER_DESTROYED));
 
@@ -566,4 +571,15 @@ void WebMediaPlayerMS::TriggerResize() {
   get_client()->sizeChanged();
 }
 
+void WebMediaPlayerMS::OnVideoCadenceChanged(int fps,
+                                             base::TimeTicks frame_time) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  video_frame_rate_ = fps;
+  RenderFrameImpl* const render_frame = RenderFrameImpl::FromWebFrame(frame_);
+  RenderWidget* const widget =
+      render_frame ? render_frame->GetRenderWidget() : nullptr;
+  if (widget)
+    widget->SetVideoCadence(fps, frame_time);
+}
+
 }  // namespace content
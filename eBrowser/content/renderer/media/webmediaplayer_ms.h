@@ -113,6 +113,10 @@ class CONTENT_EXPORT WebMediaPlayerMS
   // Methods to trigger resize event.
   void TriggerResize();
 
+  // Passes the rate the compositor measured new frames to be displayed at,
+  // or 0, on to the widget; see RenderWidget::SetVideoCadence().
+  void OnVideoCadenceChanged(int fps, base::TimeTicks frame_time);
+
   // True if the loaded media has a playable video/audio track.
   bool hasVideo() const override;
   bool hasAudio() const override;
@@ -238,6 +242,9 @@ class CONTENT_EXPORT WebMediaPlayerMS
   // used on Android.
   bool should_play_upon_shown_;
 
+  // The rate last passed to OnVideoCadenceChanged().
+  int video_frame_rate_;
+
   DISALLOW_COPY_AND_ASSIGN(WebMediaPlayerMS);
 };
 
@@ -135,6 +135,7 @@ WebMediaPlayerMSCompositor::WebMediaPlayerMSCompositor(
       total_frame_count_(0),
       dropped_frame_count_(0),
       stopped_(true),
+      cadence_frame_(nullptr),
       weak_ptr_factory_(this) {
   main_message_loop_ = base::MessageLoop::current();
 
@@ -284,6 +285,14 @@ bool WebMediaPlayerMSCompositor::UpdateCurrentFrame(
            "sophisticated video rendering algorithm.";
   }
 
+  // A new frame is displayed at the start of the interval it was picked for.
+  if (!current_frame_used_by_compositor_ &&
+      current_frame_.get() != cadence_frame_) {
+    cadence_frame_ = current_frame_.get();
+    if (cadence_estimator_.AddFrame(deadline_min))
+      ReportCadence();
+  }
+
   TRACE_EVENT_END2("webrtc", "WebMediaPlayerMS::UpdateCurrentFrame",
                    "Ideal Render Instant", render_time.ToInternalValue(),
                    "Serial", serial_);
@@ -352,6 +361,18 @@ void WebMediaPlayerMSCompositor::StopRenderingInternal() {
 
   if (video_frame_provider_client_)
     video_frame_provider_client_->StopRendering();
+
+  cadence_frame_ = nullptr;
+  if (cadence_estimator_.Reset())
+    ReportCadence();
+}
+
+void WebMediaPlayerMSCompositor::ReportCadence() {
+  DCHECK(compositor_task_runner_->BelongsToCurrentThread());
+  main_message_loop_->task_runner()->PostTask(
+      FROM_HERE, base::Bind(&WebMediaPlayerMS::OnVideoCadenceChanged, player_,
+                            cadence_estimator_.frame_rate(),
+                            cadence_estimator_.last_frame_time()));
 }
 
 void WebMediaPlayerMSCompositor::ReplaceCurrentFrameWithACopy() {
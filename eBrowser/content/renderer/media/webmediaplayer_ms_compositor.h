@@ -17,6 +17,7 @@
 #include "base/threading/thread_checker.h"
 #include "cc/layers/video_frame_provider.h"
 #include "content/common/content_export.h"
+#include "content/renderer/media/video_cadence_estimator.h"
 
 namespace base {
 class SingleThreadTaskRunner;
@@ -105,6 +106,9 @@ class CONTENT_EXPORT WebMediaPlayerMSCompositor
   void StartRenderingInternal();
   void StopRenderingInternal();
 
+  // Posts |cadence_estimator_|'s rate to the player.
+  void ReportCadence();
+
   void SetAlgorithmEnabledForTesting(bool algorithm_enabled);
 
   // Used for DCHECKs to ensure method calls executed in the correct thread.
@@ -152,6 +156,13 @@ class CONTENT_EXPORT WebMediaPlayerMSCompositor
 
   std::map<base::TimeDelta, base::TimeTicks> timestamps_to_clock_times_;
 
+  // Measures the rate new frames are displayed at, for interaction pacing.
+  // Used on the compositor thread only.
+  VideoCadenceEstimator cadence_estimator_;
+  // The last frame |cadence_estimator_| counted. Only compared, never
+  // dereferenced, so that it holds no buffer.
+  const media::VideoFrame* cadence_frame_;
+
   // |current_frame_lock_| protects |current_frame_used_by_compositor_|,
   // |current_frame_|, and |rendering_frame_buffer_|.
   base::Lock current_frame_lock_;
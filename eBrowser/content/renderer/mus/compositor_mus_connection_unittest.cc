@@ -133,6 +133,10 @@ class TestInputHandlerManagerClient
                      const ui::DidOverscrollParams& params) override {}
   void DidStartFlinging(int routing_id) override {}
   void DidStopFlinging(int routing_id) override {}
+  void DidChangeTargetFrameRate(int routing_id, int fps) override {}
+  void DidRecordImplicitFeedback(
+      int routing_id,
+      const std::vector<ui::ImplicitFeedbackSample>& samples) override {}
   void DispatchNonBlockingEventToMainThread(
       int routing_id,
       ui::ScopedWebInputEvent event,
@@ -4,10 +4,13 @@
 
 #include "content/renderer/pepper/host_dispatcher_wrapper.h"
 
+#include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "build/build_config.h"
 #include "content/common/frame_messages.h"
 #include "content/public/common/origin_util.h"
 #include "content/renderer/pepper/pepper_hung_plugin_filter.h"
+#include "content/renderer/pepper/pepper_message_batch_filter.h"
 #include "content/renderer/pepper/pepper_plugin_instance_impl.h"
 #include "content/renderer/pepper/pepper_proxy_channel_delegate_impl.h"
 #include "content/renderer/pepper/plugin_module.h"
@@ -29,7 +32,8 @@ HostDispatcherWrapper::HostDispatcherWrapper(
       peer_pid_(peer_pid),
       plugin_child_id_(plugin_child_id),
       permissions_(perms),
-      is_external_(is_external) {}
+      is_external_(is_external),
+      weak_ptr_factory_(this) {}
 
 HostDispatcherWrapper::~HostDispatcherWrapper() {}
 
@@ -61,12 +65,29 @@ bool HostDispatcherWrapper::Init(const IPC::ChannelHandle& channel_handle,
   }
   // HungPluginFilter needs to listen for some messages on the IO thread.
   dispatcher_->AddIOThreadMessageFilter(filter);
+  // The plugin may coalesce its resource calls; unpack them on the IO thread
+  // and dispatch them here as if they had arrived one by one.
+  dispatcher_->AddIOThreadMessageFilter(new PepperMessageBatchFilter(
+      base::ThreadTaskRunnerHandle::Get(),
+      base::Bind(&HostDispatcherWrapper::DispatchBatchedMessages,
+                 weak_ptr_factory_.GetWeakPtr())));
 
   dispatcher_->channel()->SetRestrictDispatchChannelGroup(
       kRendererRestrictDispatchGroup_Pepper);
   return true;
 }
 
+void HostDispatcherWrapper::DispatchBatchedMessages(
+    std::unique_ptr<std::vector<IPC::Message>> messages) {
+  // A message may shut the plugin module down, taking this object with it.
+  base::WeakPtr<HostDispatcherWrapper> self = weak_ptr_factory_.GetWeakPtr();
+  for (const IPC::Message& message : *messages) {
+    if (!self || !dispatcher_)
+      return;
+    dispatcher_->OnMessageReceived(message);
+  }
+}
+
 const void* HostDispatcherWrapper::GetProxiedInterface(const char* name) {
   return dispatcher_->GetProxiedInterface(name);
 }
@@ -5,7 +5,11 @@
 #ifndef CONTENT_RENDERER_PEPPER_HOST_DISPATCHER_WRAPPER_H_
 #define CONTENT_RENDERER_PEPPER_HOST_DISPATCHER_WRAPPER_H_
 
+#include <memory>
+#include <vector>
+
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/process/process_handle.h"
 #include "content/renderer/pepper/pepper_hung_plugin_filter.h"
 #include "ppapi/c/pp_instance.h"
@@ -57,6 +61,10 @@ class HostDispatcherWrapper {
   ppapi::proxy::HostDispatcher* dispatcher() { return dispatcher_.get(); }
 
  private:
+  // Dispatches the messages of a batch the plugin sent, in order.
+  void DispatchBatchedMessages(
+      std::unique_ptr<std::vector<IPC::Message>> messages);
+
   PluginModule* module_;
 
   base::ProcessId peer_pid_;
@@ -74,6 +82,8 @@ class HostDispatcherWrapper {
   // We hold the hung_plugin_filter_ to guarantee it outlives |dispatcher_|,
   // since it is an observer of |dispatcher_| for sync calls.
   scoped_refptr<PepperHungPluginFilter> hung_plugin_filter_;
+
+  base::WeakPtrFactory<HostDispatcherWrapper> weak_ptr_factory_;
 };
 
 }  // namespace content
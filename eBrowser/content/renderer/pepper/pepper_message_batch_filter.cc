@@ -0,0 +1,44 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/pepper/pepper_message_batch_filter.h"
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/single_thread_task_runner.h"
+#include "content/common/child_process_messages.h"
+#include "ipc/ipc_message_macros.h"
+
+namespace content {
+
+PepperMessageBatchFilter::PepperMessageBatchFilter(
+    scoped_refptr<base::SingleThreadTaskRunner> main_task_runner,
+    const DispatchCallback& dispatch_callback)
+    : main_task_runner_(main_task_runner),
+      dispatch_callback_(dispatch_callback) {}
+
+PepperMessageBatchFilter::~PepperMessageBatchFilter() {}
+
+bool PepperMessageBatchFilter::OnMessageReceived(const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(PepperMessageBatchFilter, message)
+    IPC_MESSAGE_HANDLER(ChildProcessHostMsg_MessageBatch, OnMessageBatch)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+void PepperMessageBatchFilter::OnMessageBatch(
+    const std::vector<IPC::Message>& messages) {
+  if (messages.empty())
+    return;
+  // Messages the channel receives after this one are posted to the main thread
+  // behind this task, so the batch can't be overtaken.
+  std::unique_ptr<std::vector<IPC::Message>> batch(
+      new std::vector<IPC::Message>(messages));
+  main_task_runner_->PostTask(
+      FROM_HERE, base::Bind(dispatch_callback_, base::Passed(&batch)));
+}
+
+}  // namespace content
@@ -0,0 +1,58 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_PEPPER_PEPPER_MESSAGE_BATCH_FILTER_H_
+#define CONTENT_RENDERER_PEPPER_PEPPER_MESSAGE_BATCH_FILTER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "content/common/content_export.h"
+#include "ipc/message_filter.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}
+
+namespace content {
+
+// Unpacks the ChildProcessHostMsg_MessageBatch messages that an out-of-process
+// plugin sends (see PluginProcessDispatcher) on the I/O thread of the renderer,
+// and hands each batch to the main thread as one task. Messages keep the order
+// in which the plugin sent them, and every inner resource call keeps its own
+// sequence number, so replies are routed exactly as for unbatched calls.
+//
+// NOTE: This class is refcounted (via IPC::MessageFilter).
+class CONTENT_EXPORT PepperMessageBatchFilter : public IPC::MessageFilter {
+ public:
+  using DispatchCallback =
+      base::Callback<void(std::unique_ptr<std::vector<IPC::Message>>)>;
+
+  // |dispatch_callback| is run on |main_task_runner| with the messages of
+  // each batch.
+  PepperMessageBatchFilter(
+      scoped_refptr<base::SingleThreadTaskRunner> main_task_runner,
+      const DispatchCallback& dispatch_callback);
+
+  // IPC::MessageFilter implementation.
+  bool OnMessageReceived(const IPC::Message& message) override;
+
+ protected:
+  ~PepperMessageBatchFilter() override;
+
+ private:
+  void OnMessageBatch(const std::vector<IPC::Message>& messages);
+
+  scoped_refptr<base::SingleThreadTaskRunner> main_task_runner_;
+  DispatchCallback dispatch_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(PepperMessageBatchFilter);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_RENDERER_PEPPER_PEPPER_MESSAGE_BATCH_FILTER_H_
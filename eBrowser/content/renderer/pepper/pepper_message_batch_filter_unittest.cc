@@ -0,0 +1,97 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/pepper/pepper_message_batch_filter.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "content/common/child_process_messages.h"
+#include "ipc/ipc_message.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+const uint32_t kFirstType = 1;
+const uint32_t kSecondType = 2;
+
+IPC::Message CreateMessage(uint32_t type, int payload) {
+  IPC::Message message(MSG_ROUTING_CONTROL, type,
+                       IPC::Message::PRIORITY_NORMAL);
+  message.WriteInt(payload);
+  return message;
+}
+
+class PepperMessageBatchFilterTest : public testing::Test {
+ public:
+  PepperMessageBatchFilterTest() : dispatch_count_(0) {
+    filter_ = new PepperMessageBatchFilter(
+        base::ThreadTaskRunnerHandle::Get(),
+        base::Bind(&PepperMessageBatchFilterTest::OnDispatch,
+                   base::Unretained(this)));
+  }
+
+ protected:
+  void OnDispatch(std::unique_ptr<std::vector<IPC::Message>> messages) {
+    ++dispatch_count_;
+    for (const IPC::Message& message : *messages)
+      dispatched_.push_back(message);
+  }
+
+  base::MessageLoop message_loop_;
+  scoped_refptr<PepperMessageBatchFilter> filter_;
+  int dispatch_count_;
+  std::vector<IPC::Message> dispatched_;
+};
+
+}  // namespace
+
+TEST_F(PepperMessageBatchFilterTest, IgnoresOtherMessages) {
+  EXPECT_FALSE(filter_->OnMessageReceived(CreateMessage(kFirstType, 1)));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, dispatch_count_);
+}
+
+TEST_F(PepperMessageBatchFilterTest, DispatchesBatchInOrder) {
+  std::vector<IPC::Message> messages;
+  messages.push_back(CreateMessage(kFirstType, 10));
+  messages.push_back(CreateMessage(kSecondType, 20));
+  messages.push_back(CreateMessage(kFirstType, 30));
+
+  ChildProcessHostMsg_MessageBatch batch(messages);
+  ASSERT_TRUE(filter_->OnMessageReceived(batch));
+  // Nothing runs until the main thread gets to the posted task.
+  EXPECT_EQ(0, dispatch_count_);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, dispatch_count_);
+  ASSERT_EQ(3u, dispatched_.size());
+  EXPECT_EQ(kFirstType, dispatched_[0].type());
+  EXPECT_EQ(kSecondType, dispatched_[1].type());
+  EXPECT_EQ(kFirstType, dispatched_[2].type());
+
+  for (size_t i = 0; i < dispatched_.size(); ++i) {
+    base::PickleIterator iter(dispatched_[i]);
+    int payload = 0;
+    ASSERT_TRUE(iter.ReadInt(&payload));
+    EXPECT_EQ(static_cast<int>(i + 1) * 10, payload);
+  }
+}
+
+TEST_F(PepperMessageBatchFilterTest, EmptyBatchIsHandled) {
+  ChildProcessHostMsg_MessageBatch batch((std::vector<IPC::Message>()));
+  EXPECT_TRUE(filter_->OnMessageReceived(batch));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, dispatch_count_);
+}
+
+}  // namespace content
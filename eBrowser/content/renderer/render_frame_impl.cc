@@ -202,6 +202,7 @@
 #include "third_party/WebKit/public/web/WebUserGestureIndicator.h"
 #include "third_party/WebKit/public/web/WebView.h"
 #include "third_party/WebKit/public/web/WebWidget.h"
+#include "url/origin.h"
 #include "url/url_constants.h"
 #include "url/url_util.h"
 
@@ -3614,6 +3615,14 @@ void RenderFrameImpl::didCommitProvisionalLoad(
       render_thread_impl->histogram_customizer()->
           RenderViewNavigatedToHost(GURL(GetLoadingUrl()).host(),
                                     RenderView::GetRenderViewCount());
+      // Gestures on the new page are paced with its origin's models.
+      InputHandlerManager* input_handler_manager =
+          render_thread_impl->input_handler_manager();
+      if (input_handler_manager && !navigation_state->WasWithinSamePage()) {
+        url::Origin origin = frame->getSecurityOrigin();
+        input_handler_manager->SetOriginOnMainThread(
+            render_view_->GetRoutingID(), origin.Serialize());
+      }
       // The scheduler isn't interested in history inert commits unless they
       // are reloads.
       if (commit_type != blink::WebHistoryInertCommit ||
@@ -93,6 +93,7 @@
 #include "content/renderer/cache_storage/cache_storage_dispatcher.h"
 #include "content/renderer/cache_storage/cache_storage_message_filter.h"
 #include "content/renderer/categorized_worker_pool.h"
+#include "content/renderer/cpu_cluster_affinity.h"
 #include "content/renderer/devtools/devtools_agent_filter.h"
 #include "content/renderer/dom_storage/dom_storage_dispatcher.h"
 #include "content/renderer/dom_storage/webstoragearea_impl.h"
@@ -119,6 +120,7 @@
 #include "content/renderer/render_view_impl.h"
 #include "content/renderer/renderer_blink_platform_impl.h"
 #include "content/renderer/scheduler/resource_dispatch_throttler.h"
+#include "content/renderer/scheduler/timer_frame_aligner.h"
 #include "content/renderer/service_worker/embedded_worker_dispatcher.h"
 #include "content/renderer/service_worker/embedded_worker_instance_client_impl.h"
 #include "content/renderer/service_worker/service_worker_context_client.h"
@@ -155,6 +157,7 @@
 #include "third_party/WebKit/public/web/WebDatabase.h"
 #include "third_party/WebKit/public/web/WebDocument.h"
 #include "third_party/WebKit/public/web/WebFrame.h"
+#include "third_party/WebKit/public/web/WebImageCache.h"
 #include "third_party/WebKit/public/web/WebKit.h"
 #include "third_party/WebKit/public/web/WebNetworkStateNotifier.h"
 #include "third_party/WebKit/public/web/WebRuntimeFeatures.h"
@@ -165,6 +168,8 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "ui/base/layout.h"
 #include "ui/base/ui_base_switches.h"
+#include "ui/events/blink/compositor_thread_watchdog.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 #include "ui/gl/gl_switches.h"
 
 #if defined(OS_ANDROID)
@@ -672,6 +677,7 @@ LOG(INFO)<<"启动了一个新的Render进程-------------------";
   webkit_shared_timer_suspended_ = false;
   widget_count_ = 0;
   hidden_widget_count_ = 0;
+  interaction_target_frame_rate_ = ui::ScrollUpdatePacer::kMaxFrameRate;
   idle_notification_delay_in_ms_ = kInitialIdleHandlerDelayMs;
   idle_notifications_to_skip_ = 0;
 
@@ -692,6 +698,17 @@ LOG(INFO)<<"启动了一个新的Render进程-------------------";
       kMaxResourceRequestsPerFlushWhenThrottled));
   resource_dispatcher()->set_message_sender(resource_dispatch_throttler_.get());
 
+  int timer_alignment_ms = 0;
+  if (base::StringToInt(
+          base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+              switches::kEBrowserTimerFrameAlignment),
+          &timer_alignment_ms) &&
+      timer_alignment_ms > 0) {
+    timer_frame_aligner_.reset(new TimerFrameAligner(
+        renderer_scheduler_.get(),
+        base::TimeDelta::FromMilliseconds(timer_alignment_ms)));
+  }
+
   media_stream_center_ = nullptr;
 
   blob_message_filter_ = new BlobMessageFilter(GetFileThreadTaskRunner());
@@ -877,6 +894,22 @@ LOG(INFO)<<"启动了一个新的Render进程-------------------";
 
   categorized_worker_pool_->Start(num_raster_threads);
 
+  if (command_line.HasSwitch(switches::kEBrowserPowerSavingThreadPlacement)) {
+    int threshold_fps = 0;
+    if (base::StringToInt(command_line.GetSwitchValueASCII(
+                              switches::kEBrowserPowerSavingThreadPlacement),
+                          &threshold_fps) &&
+        threshold_fps > 0) {
+      cpu_cluster_affinity_ = CpuClusterAffinity::Create(threshold_fps);
+    }
+    if (cpu_cluster_affinity_) {
+      for (base::PlatformThreadId thread_id :
+           categorized_worker_pool_->foreground_worker_thread_ids()) {
+        cpu_cluster_affinity_->AddThread(thread_id);
+      }
+    }
+  }
+
   // TODO(boliu): In single process, browser main loop should set up the
   // discardable memory manager, and should skip this if kSingleProcess.
   // See crbug.com/503724.
@@ -977,6 +1010,14 @@ void RenderThreadImpl::Shutdown() {
 
   blink_platform_impl_->SetCompositorThread(nullptr);
 
+  if (compositor_task_runner_) {
+    compositor_task_runner_->PostTask(
+        FROM_HERE,
+        base::Bind(&ui::CompositorThreadWatchdog::StopOnCurrentThread));
+  }
+
+  // Drop the thread ids before the threads go away and the ids get reused.
+  cpu_cluster_affinity_.reset();
   compositor_thread_.reset();
 
   // AudioMessageFilter may be accessed on |media_thread_|, so shutdown after.
@@ -1018,6 +1059,8 @@ void RenderThreadImpl::Shutdown() {
   // constructed) and the renderer scheduler before shutting down Blink. This
   // prevents a scenario where a pending task in the message loop accesses Blink
   // objects after Blink shuts down.
+  // It holds the timer queue suspended and a timer on the scheduler.
+  timer_frame_aligner_.reset();
   renderer_scheduler_->SetRAILModeObserver(nullptr);
   renderer_scheduler_->Shutdown();
   if (main_message_loop_)
@@ -1188,10 +1231,15 @@ void RenderThreadImpl::InitializeCompositorThread() {
   compositor_task_runner_->PostTask(
       FROM_HERE,
       base::Bind(base::IgnoreResult(&ThreadRestrictions::SetIOAllowed), false));
+  compositor_task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&ui::CompositorThreadWatchdog::StartOnCurrentThread));
 #if defined(OS_LINUX)
   ChildThreadImpl::current()->SetThreadPriority(compositor_thread_->threadId(),
                                                 base::ThreadPriority::DISPLAY);
 #endif
+  if (cpu_cluster_affinity_)
+    cpu_cluster_affinity_->AddThread(compositor_thread_->threadId());
 
   SynchronousInputHandlerProxyClient* synchronous_input_handler_proxy_client =
       nullptr;
@@ -1214,6 +1262,12 @@ void RenderThreadImpl::InitializeCompositorThread() {
   input_handler_manager_.reset(new InputHandlerManager(
       compositor_task_runner_, input_handler_manager_client,
       synchronous_input_handler_proxy_client, renderer_scheduler_.get()));
+  input_handler_manager_->SetModelTaskRunner(
+      categorized_worker_pool_->CreateSequencedTaskRunner());
+  mojom::InputModelProviderPtr input_model_provider;
+  GetRemoteInterfaces()->GetInterface(mojo::GetProxy(&input_model_provider));
+  input_handler_manager_->SetInputModelProvider(
+      input_model_provider.PassInterface());
 }
 
 void RenderThreadImpl::InitializeWebKit(
@@ -1683,7 +1737,8 @@ RenderThreadImpl::CreateExternalBeginFrameSource(int routing_id) {
   }
 
   return base::MakeUnique<CompositorExternalBeginFrameSource>(
-      compositor_message_filter_.get(), sync_message_filter(), routing_id);
+      compositor_message_filter_.get(), sync_message_filter(),
+      input_handler_manager_.get(), routing_id);
 }
 
 cc::ImageSerializationProcessor*
@@ -2319,6 +2374,26 @@ base::TaskRunner* RenderThreadImpl::GetWorkerTaskRunner() {
   return categorized_worker_pool_.get();
 }
 
+void RenderThreadImpl::SetInteractionTargetFrameRate(int fps) {
+  interaction_target_frame_rate_ = fps;
+  categorized_worker_pool_->SetTargetFrameRate(fps);
+  if (cpu_cluster_affinity_)
+    cpu_cluster_affinity_->SetTargetFrameRate(fps);
+  if (timer_frame_aligner_)
+    timer_frame_aligner_->SetTargetFrameRate(fps);
+}
+
+void RenderThreadImpl::DidBeginInteractionMainFrame() {
+  if (timer_frame_aligner_)
+    timer_frame_aligner_->DidBeginMainFrame();
+}
+
+void RenderThreadImpl::SetInteractionPrepaintBoost(int num_tiles,
+                                                   int num_idle_tiles) {
+  categorized_worker_pool_->SetPrepaintBoost(num_tiles);
+  categorized_worker_pool_->SetIdlePrerender(num_idle_tiles);
+}
+
 scoped_refptr<ContextProviderCommandBuffer>
 RenderThreadImpl::SharedCompositorWorkerContextProvider() {
   DCHECK(IsMainThread());
@@ -2475,6 +2550,20 @@ void RenderThreadImpl::OnTrimMemoryImmediately() {
   }
 }
 
+void RenderThreadImpl::OnPowerSavingChange(bool power_saving) {
+  // OnMemoryStateChange() has already purged what SUSPENDED asks for, that is
+  // free and discardable memory and the font cache.
+  if (power_saving) {
+    if (blink_platform_impl_) {
+      blink::WebImageCache::clear();
+      blink::WebCache::clear();
+    }
+    renderer_scheduler_->SuspendTimerQueue();
+  } else {
+    renderer_scheduler_->ResumeTimerQueue();
+  }
+}
+
 void RenderThreadImpl::OnRendererInterfaceRequest(
     mojom::RendererAssociatedRequest request) {
   DCHECK(!renderer_binding_.is_bound());
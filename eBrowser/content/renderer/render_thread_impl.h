@@ -124,10 +124,12 @@ class P2PSocketDispatcher;
 class PeerConnectionDependencyFactory;
 class PeerConnectionTracker;
 class CategorizedWorkerPool;
+class CpuClusterAffinity;
 class RenderThreadObserver;
 class RendererBlinkPlatformImpl;
 class RendererGpuVideoAcceleratorFactories;
 class ResourceDispatchThrottler;
+class TimerFrameAligner;
 class VideoCaptureImplManager;
 
 #if defined(OS_ANDROID)
@@ -368,6 +370,26 @@ class CONTENT_EXPORT RenderThreadImpl
   // A TaskRunner instance that runs tasks on the raster worker pool.
   base::TaskRunner* GetWorkerTaskRunner();
 
+  // Scales the raster worker pool's foreground concurrency and, if enabled,
+  // the placement of the compositor and raster threads and the timers to the
+  // frame rate of the gesture in progress.
+  void SetInteractionTargetFrameRate(int fps);
+  int interaction_target_frame_rate() const {
+    return interaction_target_frame_rate_;
+  }
+
+  // Called as a widget begins a main frame; with
+  // --ebrowser-timer-frame-alignment, runs the timers held back for it.
+  void DidBeginInteractionMainFrame();
+
+  // Whether every widget of the renderer is hidden.
+  bool RendererIsHidden() const;
+
+  // Lets the raster worker pool's idle foreground threads raster up to
+  // |num_tiles| prepaint tiles, those a throttled scroll reaches by its next
+  // frame, and |num_idle_tiles| more past them at background priority.
+  void SetInteractionPrepaintBoost(int num_tiles, int num_idle_tiles);
+
   // Returns a worker context provider that will be bound on the compositor
   // thread.
   scoped_refptr<ContextProviderCommandBuffer>
@@ -469,6 +491,7 @@ class CONTENT_EXPORT RenderThreadImpl
 
   // ChildMemoryCoordinatorDelegate implementation.
   void OnTrimMemoryImmediately() override;
+  void OnPowerSavingChange(bool power_saving) override;
 
  protected:
   RenderThreadImpl(
@@ -537,7 +560,6 @@ class CONTENT_EXPORT RenderThreadImpl
 
   void OnCreateNewSharedWorker(
       const WorkerProcessMsg_CreateWorker_Params& params);
-  bool RendererIsHidden() const;
   void OnRendererHidden();
   void OnRendererVisible();
 
@@ -655,6 +677,14 @@ class CONTENT_EXPORT RenderThreadImpl
   // Pool of workers used for raster operations (e.g., tile rasterization).
   scoped_refptr<CategorizedWorkerPool> categorized_worker_pool_;
 
+  // Null unless --ebrowser-power-saving-thread-placement is given on a
+  // big.LITTLE device.
+  std::unique_ptr<CpuClusterAffinity> cpu_cluster_affinity_;
+  // See SetInteractionTargetFrameRate().
+  int interaction_target_frame_rate_;
+  // Null without --ebrowser-timer-frame-alignment.
+  std::unique_ptr<TimerFrameAligner> timer_frame_aligner_;
+
   base::CancelableCallback<void(const IPC::Message&)> main_input_callback_;
   scoped_refptr<IPC::MessageFilter> input_event_filter_;
   std::unique_ptr<InputHandlerManager> input_handler_manager_;
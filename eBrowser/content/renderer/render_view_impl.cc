@@ -2006,6 +2006,8 @@ void RenderViewImpl::initializeLayerTreeView() {
         GetRoutingID(), rwc->GetInputHandler(), AsWeakPtr(),
         webkit_preferences_.enable_scroll_animator);
     has_added_input_handler_ = true;
+    // Resizes only send the rates when they change.
+    SendDisplayRefreshRatesToInputHandler();
   }
 }
 
@@ -254,6 +254,9 @@ RenderWidget::RenderWidget(CompositorDependencies* compositor_deps,
       device_scale_factor_(screen_info_.device_scale_factor),
 #if defined(OS_ANDROID)
       text_field_is_dirty_(false),
+      send_text_input_value_changes_(
+          base::CommandLine::ForCurrentProcess()->HasSwitch(
+              switches::kEBrowserImeTextDeltas)),
 #endif
       monitor_composition_info_(false),
       popup_origin_scale_for_emulation_(0.f),
@@ -264,7 +267,9 @@ RenderWidget::RenderWidget(CompositorDependencies* compositor_deps,
 #if defined(OS_MACOSX)
       text_input_client_observer_(new TextInputClientObserver(this)),
 #endif
-      focused_pepper_plugin_(nullptr) {
+      focused_pepper_plugin_(nullptr),
+      last_layer_count_(0),
+      last_raster_cost_(0) {
   if (!swapped_out)
     RenderProcess::current()->AddRefProcess();
   DCHECK(RenderThread::Get());
@@ -495,6 +500,8 @@ bool RenderWidget::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(RenderWidget, message)
     IPC_MESSAGE_HANDLER(InputMsg_HandleInputEvent, OnHandleInputEvent)
+    IPC_MESSAGE_HANDLER(InputMsg_HandleInputEventBatch,
+                        OnHandleInputEventBatch)
     IPC_MESSAGE_HANDLER(InputMsg_CursorVisibilityChange,
                         OnCursorVisibilityChange)
     IPC_MESSAGE_HANDLER(InputMsg_ImeSetComposition, OnImeSetComposition)
@@ -507,6 +514,11 @@ bool RenderWidget::OnMessageReceived(const IPC::Message& message) {
     IPC_MESSAGE_HANDLER(InputMsg_SetFocus, OnSetFocus)
     IPC_MESSAGE_HANDLER(InputMsg_SyntheticGestureCompleted,
                         OnSyntheticGestureCompleted)
+    IPC_MESSAGE_HANDLER(InputMsg_InteractionEnergyBenchmarkCompleted,
+                        OnInteractionEnergyBenchmarkCompleted)
+    IPC_MESSAGE_HANDLER(InputMsg_EnergyCalibrationCompleted,
+                        OnEnergyCalibrationCompleted)
+    IPC_MESSAGE_HANDLER(InputMsg_SetTargetFrameRate, OnSetTargetFrameRate)
     IPC_MESSAGE_HANDLER(ViewMsg_Close, OnClose)
     IPC_MESSAGE_HANDLER(ViewMsg_Resize, OnResize)
     IPC_MESSAGE_HANDLER(ViewMsg_EnableDeviceEmulation,
@@ -692,6 +704,17 @@ void RenderWidget::OnHandleInputEvent(const blink::WebInputEvent* input_event,
   input_handler_->HandleInputEvent(*input_event, latency_info, dispatch_type);
 }
 
+void RenderWidget::OnHandleInputEventBatch(
+    const std::vector<ui::ScopedWebInputEvent>& events,
+    const std::vector<ui::LatencyInfo>& latency_info) {
+  if (events.size() != latency_info.size())
+    return;
+  for (size_t i = 0; i < events.size(); ++i) {
+    OnHandleInputEvent(events[i].get(), latency_info[i],
+                       DISPATCH_TYPE_NON_BLOCKING);
+  }
+}
+
 void RenderWidget::OnCursorVisibilityChange(bool is_visible) {
   if (GetWebWidget())
     GetWebWidget()->setCursorVisibilityState(is_visible);
@@ -745,6 +768,8 @@ void RenderWidget::BeginMainFrame(double frame_time_sec) {
       render_thread ? render_thread->input_handler_manager() : NULL;
   if (input_handler_manager)
     input_handler_manager->ProcessRafAlignedInputOnMainThread(routing_id_);
+  if (render_thread)
+    render_thread->DidBeginInteractionMainFrame();
 
   GetWebWidget()->beginFrame(frame_time_sec);
 }
@@ -778,6 +803,55 @@ void RenderWidget::DidCommitCompositorFrame() {
   for (auto& observer : render_frame_proxies_)
     observer.DidCommitCompositorFrame();
   input_handler_->FlushPendingInputEventAck();
+  UpdateContentFeatures();
+}
+
+void RenderWidget::UpdateContentFeatures() {
+  RenderThreadImpl* render_thread = RenderThreadImpl::current();
+  // render_thread may be NULL in tests.
+  InputHandlerManager* input_handler_manager =
+      render_thread ? render_thread->input_handler_manager() : NULL;
+  if (!input_handler_manager || !compositor_)
+    return;
+  int layer_count;
+  float raster_cost;
+  compositor_->GetContentComplexity(&layer_count, &raster_cost);
+  // Most commits leave the layer tree's shape alone, so only changes are
+  // posted to the compositor thread.
+  if (layer_count == last_layer_count_ && raster_cost == last_raster_cost_)
+    return;
+  last_layer_count_ = layer_count;
+  last_raster_cost_ = raster_cost;
+  input_handler_manager->SetContentFeaturesOnMainThread(routing_id_,
+                                                        layer_count,
+                                                        raster_cost);
+}
+
+void RenderWidget::SetVideoCadence(int fps, base::TimeTicks frame_time) {
+  if (compositor_)
+    compositor_->SetVideoCadence(fps, frame_time);
+  RenderThreadImpl* render_thread = RenderThreadImpl::current();
+  // render_thread may be NULL in tests.
+  InputHandlerManager* input_handler_manager =
+      render_thread ? render_thread->input_handler_manager() : NULL;
+  if (input_handler_manager) {
+    input_handler_manager->SetVideoCadenceOnMainThread(routing_id_, fps,
+                                                       frame_time);
+  }
+}
+
+void RenderWidget::SendDisplayRefreshRatesToInputHandler() {
+  RenderThreadImpl* render_thread = RenderThreadImpl::current();
+  // render_thread may be NULL in tests.
+  InputHandlerManager* input_handler_manager =
+      render_thread ? render_thread->input_handler_manager() : NULL;
+  if (!input_handler_manager)
+    return;
+  std::vector<float> refresh_rates = screen_info_.supported_refresh_rates;
+  if (refresh_rates.empty() && screen_info_.refresh_rate > 0)
+    refresh_rates.push_back(screen_info_.refresh_rate);
+  input_handler_manager->SetDisplayRefreshRatesOnMainThread(routing_id_,
+                                                            refresh_rates);
 }
 
 void RenderWidget::DidCompletePageScaleAnimation() {}
@@ -826,6 +900,13 @@ void RenderWidget::OnSwapBuffersPosted() {
   TRACE_EVENT0("renderer", "RenderWidget::OnSwapBuffersPosted");
 }
 
+void RenderWidget::RequestPrepaintBoost(int num_tiles, int num_idle_tiles) {
+  if (RenderThreadImpl::current()) {
+    RenderThreadImpl::current()->SetInteractionPrepaintBoost(num_tiles,
+                                                             num_idle_tiles);
+  }
+}
+
 void RenderWidget::RequestScheduleAnimation() {
   scheduleAnimation();
 }
@@ -983,8 +1064,32 @@ void RenderWidget::UpdateTextInputState(ShowIme show_ime,
     if (params.is_non_ime_change)
       OnImeEventSentForAck(new_info);
     text_field_is_dirty_ = false;
-#endif
+
+    std::string value;
+    if (send_text_input_value_changes_) {
+      value = params.value;
+      if (sent_text_input_value_.size() >= kMinTextInputValueLengthForChanges) {
+        size_t change_start = 0;
+        size_t change_end = 0;
+        FindTextChange(sent_text_input_value_, value, &change_start,
+                       &change_end);
+        params.value_change_start = change_start;
+        params.value_change_end = change_end;
+        params.value = value.substr(
+            change_start,
+            change_end + value.size() - sent_text_input_value_.size() -
+                change_start);
+      }
+    }
+    // The browser applies a change to the value it last received, so the
+    // value is only remembered once the message is on its way.
+    if (Send(new ViewHostMsg_TextInputStateChanged(routing_id(), params)) &&
+        send_text_input_value_changes_) {
+      sent_text_input_value_.swap(value);
+    }
+#else
     Send(new ViewHostMsg_TextInputStateChanged(routing_id(), params));
+#endif
 
     text_input_info_ = new_info;
     text_input_mode_ = new_mode;
@@ -1034,9 +1139,16 @@ void RenderWidget::Resize(const ResizeParams& params) {
   bool orientation_changed =
       screen_info_.orientation_angle != params.screen_info.orientation_angle ||
       screen_info_.orientation_type != params.screen_info.orientation_type;
+  bool refresh_rates_changed =
+      screen_info_.refresh_rate != params.screen_info.refresh_rate ||
+      screen_info_.supported_refresh_rates !=
+          params.screen_info.supported_refresh_rates;
 
   screen_info_ = params.screen_info;
 
+  if (refresh_rates_changed)
+    SendDisplayRefreshRatesToInputHandler();
+
   if (device_scale_factor_ != screen_info_.device_scale_factor) {
     device_scale_factor_ = screen_info_.device_scale_factor;
     OnDeviceScaleFactorChanged();
@@ -1315,6 +1427,35 @@ void RenderWidget::QueueSyntheticGesture(
   Send(new InputHostMsg_QueueSyntheticGesture(routing_id_, gesture_packet));
 }
 
+bool RenderWidget::RunInteractionEnergyBenchmark(
+    const std::vector<float>& speeds,
+    const gfx::Vector2dF& distance,
+    const gfx::PointF& anchor,
+    const InteractionEnergyBenchmarkCallback& callback) {
+  DCHECK(!callback.is_null());
+  if (!pending_energy_benchmark_callback_.is_null())
+    return false;
+  pending_energy_benchmark_callback_ = callback;
+  Send(new InputHostMsg_RunInteractionEnergyBenchmark(routing_id_, speeds,
+                                                      distance, anchor));
+  return true;
+}
+
+bool RenderWidget::RunEnergyCalibration(
+    const std::vector<int>& frame_rates,
+    float speed,
+    const gfx::Vector2dF& distance,
+    const gfx::PointF& anchor,
+    const InteractionEnergyBenchmarkCallback& callback) {
+  DCHECK(!callback.is_null());
+  if (!pending_energy_calibration_callback_.is_null())
+    return false;
+  pending_energy_calibration_callback_ = callback;
+  Send(new InputHostMsg_RunEnergyCalibration(routing_id_, frame_rates, speed,
+                                             distance, anchor));
+  return true;
+}
+
 void RenderWidget::Close() {
   screen_metrics_emulator_.reset();
   WillCloseLayerTreeView();
@@ -1514,6 +1655,34 @@ void RenderWidget::OnSyntheticGestureCompleted() {
   pending_synthetic_gesture_callbacks_.pop();
 }
 
+void RenderWidget::OnInteractionEnergyBenchmarkCompleted(
+    const std::string& report) {
+  if (pending_energy_benchmark_callback_.is_null())
+    return;
+  InteractionEnergyBenchmarkCallback callback =
+      pending_energy_benchmark_callback_;
+  pending_energy_benchmark_callback_.Reset();
+  callback.Run(report);
+}
+
+void RenderWidget::OnEnergyCalibrationCompleted(const std::string& report) {
+  if (pending_energy_calibration_callback_.is_null())
+    return;
+  InteractionEnergyBenchmarkCallback callback =
+      pending_energy_calibration_callback_;
+  pending_energy_calibration_callback_.Reset();
+  callback.Run(report);
+}
+
+void RenderWidget::OnSetTargetFrameRate(int fps) {
+  if (compositor_)
+    compositor_->SetTargetFrameRate(fps);
+  // The raster workers are shared by all widgets, but only the one being
+  // interacted with reports a throttled rate.
+  if (RenderThreadImpl::current())
+    RenderThreadImpl::current()->SetInteractionTargetFrameRate(fps);
+}
+
 void RenderWidget::OnSetTextDirection(WebTextDirection direction) {
   if (!GetWebWidget())
     return;
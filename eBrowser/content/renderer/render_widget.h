@@ -12,6 +12,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/compiler_specific.h"
@@ -47,6 +48,7 @@
 #include "ui/base/ime/text_input_mode.h"
 #include "ui/base/ime/text_input_type.h"
 #include "ui/base/ui_base_types.h"
+#include "ui/events/blink/scoped_web_input_event.h"
 #include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/geometry/vector2d_f.h"
 #include "ui/gfx/native_widget_types.h"
@@ -80,6 +82,7 @@ class SwapPromise;
 }
 
 namespace gfx {
+class PointF;
 class Range;
 }
 
@@ -231,6 +234,7 @@ class CONTENT_EXPORT RenderWidget
   void OnSwapBuffersAborted() override;
   void OnSwapBuffersComplete() override;
   void OnSwapBuffersPosted() override;
+  void RequestPrepaintBoost(int num_tiles, int num_idle_tiles) override;
   void RequestScheduleAnimation() override;
   void UpdateVisualState() override;
   void WillBeginCompositorFrame() override;
@@ -315,6 +319,17 @@ class CONTENT_EXPORT RenderWidget
 
   RenderWidgetCompositor* compositor() const;
 
+  // Called by media players with the rate a playing video presents frames
+  // at, or 0 once it stops, and the display time of one of its frames, so
+  // that paced gestures and animation frames land on the video's frames.
+  // The latest report holds.
+  void SetVideoCadence(int fps, base::TimeTicks frame_time);
+
+  // Tells the compositor thread's input handler which refresh rates the
+  // screen in |screen_info_| can present, so that it paces gestures at rates
+  // the display shows evenly.
+  void SendDisplayRefreshRatesToInputHandler();
+
   const RenderWidgetInputHandler& input_handler() const {
     return *input_handler_;
   }
@@ -339,6 +354,30 @@ class CONTENT_EXPORT RenderWidget
       std::unique_ptr<SyntheticGestureParams> gesture_params,
       const SyntheticGestureCompletionCallback& callback);
 
+  // Callback for RunInteractionEnergyBenchmark(), with the JSON report, or an
+  // empty string if the benchmark failed.
+  typedef base::Callback<void(const std::string& report)>
+      InteractionEnergyBenchmarkCallback;
+
+  // Asks the browser to run the interaction energy benchmark: a touch scroll
+  // by |distance| from |anchor| at each of |speeds|, with the frame rate
+  // models enabled and disabled. Returns false if one is already running.
+  bool RunInteractionEnergyBenchmark(
+      const std::vector<float>& speeds,
+      const gfx::Vector2dF& distance,
+      const gfx::PointF& anchor,
+      const InteractionEnergyBenchmarkCallback& callback);
+
+  // Asks the browser to run the energy calibration: a touch scroll by
+  // |distance| from |anchor| at |speed|, paced at each of |frame_rates|. The
+  // callback is as for RunInteractionEnergyBenchmark(). Returns false if one
+  // is already running.
+  bool RunEnergyCalibration(const std::vector<int>& frame_rates,
+                            float speed,
+                            const gfx::Vector2dF& distance,
+                            const gfx::PointF& anchor,
+                            const InteractionEnergyBenchmarkCallback& callback);
+
   // Deliveres |message| together with compositor state change updates. The
   // exact behavior depends on |policy|.
   // This mechanism is not a drop-in replacement for IPC: messages sent this way
@@ -471,6 +510,9 @@ class CONTENT_EXPORT RenderWidget
   void OnHandleInputEvent(const blink::WebInputEvent* event,
                           const ui::LatencyInfo& latency_info,
                           InputEventDispatchType dispatch_type);
+  void OnHandleInputEventBatch(
+      const std::vector<ui::ScopedWebInputEvent>& events,
+      const std::vector<ui::LatencyInfo>& latency_info);
   void OnCursorVisibilityChange(bool is_visible);
   void OnMouseCaptureLost();
   void OnSetEditCommandsForNextKeyEvent(const EditCommands& edit_commands);
@@ -503,6 +545,9 @@ class CONTENT_EXPORT RenderWidget
 
   void OnRepaint(gfx::Size size_to_paint);
   void OnSyntheticGestureCompleted();
+  void OnInteractionEnergyBenchmarkCompleted(const std::string& report);
+  void OnEnergyCalibrationCompleted(const std::string& report);
+  void OnSetTargetFrameRate(int fps);
   void OnSetTextDirection(blink::WebTextDirection direction);
   void OnGetFPS();
   void OnUpdateScreenRects(const gfx::Rect& view_screen_rect,
@@ -761,12 +806,19 @@ class CONTENT_EXPORT RenderWidget
   // completed gesture.
   std::queue<SyntheticGestureCompletionCallback>
       pending_synthetic_gesture_callbacks_;
+  InteractionEnergyBenchmarkCallback pending_energy_benchmark_callback_;
+  InteractionEnergyBenchmarkCallback pending_energy_calibration_callback_;
 
 #if defined(OS_ANDROID)
   // Indicates value in the focused text field is in dirty state, i.e. modified
   // by script etc., not by user input.
   bool text_field_is_dirty_;
 
+  // Whether text input updates carry only the change to the value of the
+  // field, and the last value sent in full or as a change.
+  const bool send_text_input_value_changes_;
+  std::string sent_text_input_value_;
+
   // Stores the history of text input infos from the last ACK'ed one from the
   // current one. The size is the number of pending ACKs plus one, since we
   // intentionally keep the last ack'd value to know what the browser is
@@ -815,6 +867,10 @@ class CONTENT_EXPORT RenderWidget
   void ScreenRectToEmulatedIfNeeded(blink::WebRect* window_rect) const;
   void EmulatedToScreenRectIfNeeded(blink::WebRect* window_rect) const;
 
+  // Measures the committed layer tree and, if it changed, hands the content
+  // complexity features to this widget's input handler proxy.
+  void UpdateContentFeatures();
+
   // Indicates whether this widget has focus.
   bool has_focus_;
 
@@ -832,6 +888,10 @@ class CONTENT_EXPORT RenderWidget
   // Will be cleared as soon as the next key event is processed.
   EditCommands edit_commands_;
 
+  // Content complexity last sent by UpdateContentFeatures().
+  int last_layer_count_;
+  float last_raster_cost_;
+
   DISALLOW_COPY_AND_ASSIGN(RenderWidget);
 };
 
@@ -0,0 +1,117 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/scheduler/timer_frame_aligner.h"
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/trace_event/trace_event.h"
+#include "third_party/WebKit/public/platform/scheduler/renderer/renderer_scheduler.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace content {
+
+TimerFrameAligner::TimerFrameAligner(
+    blink::scheduler::RendererScheduler* scheduler,
+    base::TimeDelta max_delay)
+    : scheduler_(scheduler),
+      max_delay_(max_delay),
+      aligning_(false),
+      timers_suspended_(false),
+      weak_factory_(this) {
+  DCHECK(scheduler);
+  DCHECK_GT(max_delay_, base::TimeDelta());
+  // The timer queue is suspended when this fires.
+  max_delay_timer_.SetTaskRunner(scheduler->DefaultTaskRunner());
+}
+
+TimerFrameAligner::~TimerFrameAligner() {
+  if (timers_suspended_)
+    ResumeTimers();
+}
+
+void TimerFrameAligner::SetTargetFrameRate(int fps) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  bool aligning = fps > 0 && fps < ui::ScrollUpdatePacer::kMaxFrameRate;
+  if (aligning == aligning_)
+    return;
+  aligning_ = aligning;
+  TRACE_EVENT_INSTANT1("renderer", "TimerFrameAligner::SetAligning",
+                       TRACE_EVENT_SCOPE_THREAD, "aligning", aligning);
+  if (aligning_) {
+    timers_suspended_ = true;
+    SuspendTimers();
+    ScheduleMaxDelay();
+    return;
+  }
+  CancelMaxDelay();
+  weak_factory_.InvalidateWeakPtrs();
+  if (timers_suspended_) {
+    timers_suspended_ = false;
+    ResumeTimers();
+  }
+}
+
+void TimerFrameAligner::DidBeginMainFrame() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (!aligning_)
+    return;
+  OpenWindow();
+  ScheduleMaxDelay();
+}
+
+void TimerFrameAligner::SuspendTimers() {
+  scheduler_->SuspendTimerQueue();
+}
+
+void TimerFrameAligner::ResumeTimers() {
+  scheduler_->ResumeTimerQueue();
+}
+
+void TimerFrameAligner::ScheduleCloseWindow() {
+  // Delayed tasks run in the order they are due, so a task posted to the
+  // timer queue just after now runs behind every timer already due, and the
+  // timers the next frame is closer to stay queued.
+  scheduler_->TimerTaskRunner()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&TimerFrameAligner::CloseWindow, weak_factory_.GetWeakPtr()),
+      base::TimeDelta::FromMilliseconds(1));
+}
+
+void TimerFrameAligner::ScheduleMaxDelay() {
+  max_delay_timer_.Start(
+      FROM_HERE, max_delay_,
+      base::Bind(&TimerFrameAligner::OnMaxDelay, base::Unretained(this)));
+}
+
+void TimerFrameAligner::CancelMaxDelay() {
+  max_delay_timer_.Stop();
+}
+
+void TimerFrameAligner::OpenWindow() {
+  // Still open from an earlier frame whose timers have not all run.
+  if (!timers_suspended_)
+    return;
+  timers_suspended_ = false;
+  ResumeTimers();
+  ScheduleCloseWindow();
+}
+
+void TimerFrameAligner::CloseWindow() {
+  if (!aligning_ || timers_suspended_)
+    return;
+  timers_suspended_ = true;
+  SuspendTimers();
+}
+
+void TimerFrameAligner::OnMaxDelay() {
+  if (!aligning_)
+    return;
+  TRACE_EVENT_INSTANT0("renderer", "TimerFrameAligner::MaxDelay",
+                       TRACE_EVENT_SCOPE_THREAD);
+  OpenWindow();
+  ScheduleMaxDelay();
+}
+
+}  // namespace content
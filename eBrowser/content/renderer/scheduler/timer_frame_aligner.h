@@ -0,0 +1,79 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_SCHEDULER_TIMER_FRAME_ALIGNER_H_
+#define CONTENT_RENDERER_SCHEDULER_TIMER_FRAME_ALIGNER_H_
+
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "content/common/content_export.h"
+
+namespace blink {
+namespace scheduler {
+class RendererScheduler;
+}
+}
+
+namespace content {
+
+// Runs the renderer's setTimeout and setInterval callbacks at the main frames
+// of a throttled gesture, so the main thread wakes for frames and timers
+// together rather than at two cadences:
+//  * While the target frame rate is below the display's, the timer queue is
+//    suspended between main frames.
+//  * At each main frame it is resumed until the timers then due have run.
+//  * A timer never waits more than |max_delay| for a frame; timers may run
+//    late by the HTML spec, as background tabs already do.
+// Input, rendering and loading tasks are left alone.
+class CONTENT_EXPORT TimerFrameAligner {
+ public:
+  TimerFrameAligner(blink::scheduler::RendererScheduler* scheduler,
+                    base::TimeDelta max_delay);
+  virtual ~TimerFrameAligner();
+
+  // Aligns timers while |fps| is below ui::ScrollUpdatePacer::kMaxFrameRate.
+  void SetTargetFrameRate(int fps);
+
+  // Runs the timers that are due, if aligning.
+  void DidBeginMainFrame();
+
+  bool aligning() const { return aligning_; }
+
+ private:
+  friend class TimerFrameAlignerForTest;
+
+  // Virtual for testing.
+  virtual void SuspendTimers();
+  virtual void ResumeTimers();
+  // Posts CloseWindow() behind the timers that are due.
+  virtual void ScheduleCloseWindow();
+  // Calls OnMaxDelay() in |max_delay_|, replacing any earlier call.
+  virtual void ScheduleMaxDelay();
+  virtual void CancelMaxDelay();
+
+  void OpenWindow();
+  void CloseWindow();
+  void OnMaxDelay();
+
+  base::ThreadChecker thread_checker_;
+
+  blink::scheduler::RendererScheduler* const scheduler_;
+  const base::TimeDelta max_delay_;
+
+  bool aligning_;
+  // Whether this suspended the timer queue, which counts suspensions.
+  bool timers_suspended_;
+  base::OneShotTimer max_delay_timer_;
+
+  base::WeakPtrFactory<TimerFrameAligner> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerFrameAligner);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_RENDERER_SCHEDULER_TIMER_FRAME_ALIGNER_H_
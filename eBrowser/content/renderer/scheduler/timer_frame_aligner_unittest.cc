@@ -0,0 +1,138 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/scheduler/timer_frame_aligner.h"
+
+#include "base/macros.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/WebKit/public/platform/scheduler/test/fake_renderer_scheduler.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace content {
+namespace {
+
+const int kThrottledFps = 20;
+const int kMaxDelayMs = 100;
+
+}  // namespace
+
+class TimerFrameAlignerForTest : public TimerFrameAligner {
+ public:
+  explicit TimerFrameAlignerForTest(
+      blink::scheduler::RendererScheduler* scheduler)
+      : TimerFrameAligner(scheduler,
+                          base::TimeDelta::FromMilliseconds(kMaxDelayMs)),
+        suspend_count_(0),
+        close_window_scheduled_(false),
+        max_delay_scheduled_(false) {}
+  ~TimerFrameAlignerForTest() override {}
+
+  bool RunScheduledCloseWindow() {
+    if (!close_window_scheduled_)
+      return false;
+    close_window_scheduled_ = false;
+    CloseWindow();
+    return true;
+  }
+
+  bool RunScheduledMaxDelay() {
+    if (!max_delay_scheduled_)
+      return false;
+    max_delay_scheduled_ = false;
+    OnMaxDelay();
+    return true;
+  }
+
+  int suspend_count() const { return suspend_count_; }
+  bool max_delay_scheduled() const { return max_delay_scheduled_; }
+
+ private:
+  // TimerFrameAligner overrides:
+  void SuspendTimers() override { ++suspend_count_; }
+  void ResumeTimers() override { --suspend_count_; }
+  void ScheduleCloseWindow() override { close_window_scheduled_ = true; }
+  void ScheduleMaxDelay() override { max_delay_scheduled_ = true; }
+  void CancelMaxDelay() override { max_delay_scheduled_ = false; }
+
+  int suspend_count_;
+  bool close_window_scheduled_;
+  bool max_delay_scheduled_;
+};
+
+class TimerFrameAlignerTest : public testing::Test {
+ public:
+  TimerFrameAlignerTest() : aligner_(&scheduler_) {}
+  ~TimerFrameAlignerTest() override {}
+
+ protected:
+  blink::scheduler::FakeRendererScheduler scheduler_;
+  TimerFrameAlignerForTest aligner_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TimerFrameAlignerTest);
+};
+
+TEST_F(TimerFrameAlignerTest, NotAligningByDefault) {
+  EXPECT_FALSE(aligner_.aligning());
+  aligner_.DidBeginMainFrame();
+  EXPECT_EQ(0, aligner_.suspend_count());
+  EXPECT_FALSE(aligner_.RunScheduledCloseWindow());
+
+  aligner_.SetTargetFrameRate(ui::ScrollUpdatePacer::kMaxFrameRate);
+  EXPECT_FALSE(aligner_.aligning());
+  EXPECT_EQ(0, aligner_.suspend_count());
+}
+
+TEST_F(TimerFrameAlignerTest, TimersRunAtFrames) {
+  aligner_.SetTargetFrameRate(kThrottledFps);
+  EXPECT_TRUE(aligner_.aligning());
+  EXPECT_EQ(1, aligner_.suspend_count());
+
+  aligner_.DidBeginMainFrame();
+  EXPECT_EQ(0, aligner_.suspend_count());
+  // A second widget's frame before the due timers ran keeps them released.
+  aligner_.DidBeginMainFrame();
+  EXPECT_EQ(0, aligner_.suspend_count());
+
+  EXPECT_TRUE(aligner_.RunScheduledCloseWindow());
+  EXPECT_EQ(1, aligner_.suspend_count());
+  EXPECT_FALSE(aligner_.RunScheduledCloseWindow());
+
+  aligner_.DidBeginMainFrame();
+  EXPECT_EQ(0, aligner_.suspend_count());
+  EXPECT_TRUE(aligner_.RunScheduledCloseWindow());
+  EXPECT_EQ(1, aligner_.suspend_count());
+}
+
+TEST_F(TimerFrameAlignerTest, MaxDelayWithoutFrames) {
+  aligner_.SetTargetFrameRate(kThrottledFps);
+  EXPECT_TRUE(aligner_.max_delay_scheduled());
+
+  EXPECT_TRUE(aligner_.RunScheduledMaxDelay());
+  EXPECT_EQ(0, aligner_.suspend_count());
+  EXPECT_TRUE(aligner_.max_delay_scheduled());
+  EXPECT_TRUE(aligner_.RunScheduledCloseWindow());
+  EXPECT_EQ(1, aligner_.suspend_count());
+}
+
+TEST_F(TimerFrameAlignerTest, GestureEndResumesTimers) {
+  aligner_.SetTargetFrameRate(kThrottledFps);
+  // A lower rate within the same gesture changes nothing.
+  aligner_.SetTargetFrameRate(kThrottledFps / 2);
+  EXPECT_EQ(1, aligner_.suspend_count());
+
+  aligner_.SetTargetFrameRate(ui::ScrollUpdatePacer::kMaxFrameRate);
+  EXPECT_FALSE(aligner_.aligning());
+  EXPECT_EQ(0, aligner_.suspend_count());
+  EXPECT_FALSE(aligner_.max_delay_scheduled());
+
+  // The window closing late must not suspend the timers again.
+  aligner_.SetTargetFrameRate(kThrottledFps);
+  aligner_.DidBeginMainFrame();
+  aligner_.SetTargetFrameRate(ui::ScrollUpdatePacer::kMaxFrameRate);
+  aligner_.RunScheduledCloseWindow();
+  EXPECT_EQ(0, aligner_.suspend_count());
+}
+
+}  // namespace content
@@ -0,0 +1,581 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+package org.chromium.content_shell;
+
+import android.annotation.TargetApi;
+import android.content.BroadcastReceiver;
+import android.content.Context;
+import android.content.Intent;
+import android.content.IntentFilter;
+import android.content.SharedPreferences;
+import android.net.ConnectivityManager;
+import android.net.NetworkInfo;
+import android.os.BatteryManager;
+import android.os.Build;
+import android.os.Environment;
+import android.os.Handler;
+import android.os.HandlerThread;
+import android.os.Looper;
+import android.os.SystemClock;
+import android.telephony.TelephonyManager;
+import android.widget.Toast;
+
+import org.chromium.base.Log;
+
+import java.io.BufferedReader;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.FileReader;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.HttpURLConnection;
+import java.net.URL;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Sends feedback to the model server and fetches models from it, on a single
+ * background thread.
+ *
+ * Feedback samples are kept in a queue on disk in the compact InteractionLog
+ * format. When they are sent depends on the connection:
+ * - On Wi-Fi they go within UNMETERED_DELAY_MS, so a burst shares a request.
+ * - On cellular they go in batches of BATCH_SIZE samples, or once the oldest
+ *   has waited BATCH_DELAY_MS. Waking the radio costs far more energy than
+ *   the bytes sent, so a batch waits until the device charges or the radio is
+ *   already up. A finished page load had it up, so the queue, full batch or
+ *   not, is sent then; the learning loop never wakes the radio on its own.
+ * - On 2G and the slowest 3G nothing is sent, short of a model the user is
+ *   waiting on; a switch to Wi-Fi sends what waited right away.
+ * Batches that can not be sent, or fail, are retried with exponential backoff.
+ * All requests go to the same server with their bodies read to the end, which
+ * lets HttpURLConnection keep the connection alive between them.
+ */
+public class FeedbackUploader {
+    private static final String TAG = "eBrowser.FeedbackUploader";
+
+    private static final int BATCH_SIZE = 20;
+    private static final long BATCH_DELAY_MS = 5 * 60 * 1000;
+    private static final long MIN_BACKOFF_MS = 60 * 1000;
+    private static final long MAX_BACKOFF_MS = 60 * 60 * 1000;
+    // Samples beyond this are dropped oldest first, should the device stay off
+    // any cheap network for days.
+    private static final int MAX_QUEUED_SAMPLES = 1000;
+    private static final long UNMETERED_DELAY_MS = 10 * 1000;
+
+    // How cheap the current connection is, from worst to best.
+    private static final int NETWORK_NONE = 0;
+    private static final int NETWORK_SLOW = 1;
+    private static final int NETWORK_CELLULAR = 2;
+    private static final int NETWORK_UNMETERED = 3;
+
+    private static final int CONNECT_TIMEOUT_MS = 10 * 1000;
+    private static final int POST_TIMEOUT_MS = 10 * 1000;
+    private static final int DOWNLOAD_TIMEOUT_MS = 10 * 60 * 1000;
+
+    private static final String QUEUE_FILE = "interaction_log";
+    // The text queue of earlier versions, read once and converted.
+    private static final String LEGACY_QUEUE_FILE = "feedback_queue";
+    // Version (ETag) of each downloaded model, keyed by file name.
+    private static final String ETAG_PREFS = "model_etags";
+
+    private static FeedbackUploader sInstance;
+
+    private final Context mContext;
+    private final String mServer;
+    private final String mDeviceId;
+    private final File mQueueFile;
+    private final File mLegacyQueueFile;
+    private final Handler mHandler;
+    private final Handler mUiHandler;
+
+    // Only used on the uploader thread.
+    private List<InteractionLog.Sample> mQueue;
+    private long mOldestSampleTime;
+    private long mBackoffMs;
+    private String mPendingDownload;
+    private boolean mFlushScheduled;
+
+    private final Runnable mFlushRunnable = new Runnable() {
+        @Override
+        public void run() {
+            mFlushScheduled = false;
+            flush(false);
+        }
+    };
+
+    /**
+     * Returns the uploader for |deviceId|'s feedback to |server|. The first
+     * call decides both.
+     */
+    public static synchronized FeedbackUploader get(
+            Context context, String server, String deviceId) {
+        if (sInstance == null) {
+            sInstance = new FeedbackUploader(context.getApplicationContext(), server, deviceId);
+        }
+        return sInstance;
+    }
+
+    private FeedbackUploader(Context context, String server, String deviceId) {
+        mContext = context;
+        mServer = server;
+        mDeviceId = deviceId;
+        mQueueFile = new File(context.getFilesDir(), QUEUE_FILE);
+        mLegacyQueueFile = new File(context.getFilesDir(), LEGACY_QUEUE_FILE);
+        HandlerThread thread = new HandlerThread("FeedbackUploader");
+        thread.start();
+        mHandler = new Handler(thread.getLooper());
+        mUiHandler = new Handler(Looper.getMainLooper());
+        mHandler.post(new Runnable() {
+            @Override
+            public void run() {
+                mQueue = readQueue();
+                // Whatever survived the last run has waited long enough.
+                mOldestSampleTime = mQueue.isEmpty() ? 0 : SystemClock.elapsedRealtime()
+                        - BATCH_DELAY_MS;
+                scheduleFlush(0);
+            }
+        });
+        // Delivered on the uploader thread, after the queue is read.
+        context.registerReceiver(new BroadcastReceiver() {
+            @Override
+            public void onReceive(Context context, Intent intent) {
+                onConnectivityChange();
+            }
+        }, new IntentFilter(ConnectivityManager.CONNECTIVITY_ACTION), null, mHandler);
+    }
+
+    /**
+     * Tells the uploader a page load finished, so the radio is up for a
+     * while anyway. Does nothing before the uploader is created.
+     */
+    public static synchronized void onPageLoadFinished() {
+        if (sInstance == null) return;
+        final FeedbackUploader uploader = sInstance;
+        uploader.mHandler.post(new Runnable() {
+            @Override
+            public void run() {
+                uploader.flushWithRadioUp();
+            }
+        });
+    }
+
+    /**
+     * Queues scroll feedback: |step| fps up or down at |speed|, the speed
+     * feature of ContentViewCore.getScrollSpeedFeature(), which made the
+     * scroll rate |fps|.
+     */
+    public void addScrollFeedback(float speed, int step, int fps) {
+        enqueue(InteractionLog.KIND_SCROLL, 0, speed, fps, step);
+    }
+
+    /** Queues pinch feedback: |fps| wanted at |speed|. */
+    public void addPinchFeedback(long speed, String fps) {
+        enqueue(InteractionLog.KIND_PINCH, 0, speed, parseInt(fps), 0);
+    }
+
+    /**
+     * Queues feedback inferred from a throttled gesture of |type| at |speed|
+     * that ran at |fps|; see ContentViewCore.ImplicitFeedbackListener.
+     */
+    public void addImplicitFeedback(int type, float speed, int fps) {
+        enqueue(InteractionLog.KIND_IMPLICIT, type, speed, fps, 0);
+    }
+
+    /** Asks the server to retrain this device's model with the next batch. */
+    public void requestTraining() {
+        enqueue(InteractionLog.KIND_TRAIN, 0, 0, 0, 0);
+    }
+
+    /**
+     * Downloads the model at |url| to libsvm/ on external storage, under the
+     * name that ends the URL, in place of any earlier model. A download that
+     * is not |urgent| waits for the next batch to be sent; an urgent one, for
+     * a model the user is waiting on, is made right away.
+     */
+    public void download(final String url, final boolean urgent) {
+        mHandler.post(new Runnable() {
+            @Override
+            public void run() {
+                mPendingDownload = url;
+                if (urgent) {
+                    flush(true);
+                } else if (mQueue.isEmpty()) {
+                    scheduleFlush(0);
+                }
+            }
+        });
+    }
+
+    private void enqueue(int kind, int gestureType, float speed, int fps, int correction) {
+        final InteractionLog.Sample sample = new InteractionLog.Sample(
+                System.currentTimeMillis(), kind, gestureType, speed, fps, correction);
+        mHandler.post(new Runnable() {
+            @Override
+            public void run() {
+                if (sample.kind == InteractionLog.KIND_TRAIN && hasTrainingRequest(mQueue)) {
+                    return;
+                }
+                if (mQueue.isEmpty()) mOldestSampleTime = SystemClock.elapsedRealtime();
+                mQueue.add(sample);
+                if (mQueue.size() > MAX_QUEUED_SAMPLES) mQueue.remove(0);
+                // The log is a few kilobytes at most, and feedback comes
+                // seconds apart, so it is simply rewritten.
+                writeQueue(mQueue);
+                if (mQueue.size() >= BATCH_SIZE) {
+                    scheduleFlush(0);
+                } else if (getNetworkClass() == NETWORK_UNMETERED) {
+                    scheduleFlush(UNMETERED_DELAY_MS);
+                } else {
+                    scheduleFlush(mOldestSampleTime + BATCH_DELAY_MS
+                            - SystemClock.elapsedRealtime());
+                }
+            }
+        });
+    }
+
+    private void scheduleFlush(long delayMs) {
+        if (mFlushScheduled) mHandler.removeCallbacks(mFlushRunnable);
+        mFlushScheduled = true;
+        mHandler.postDelayed(mFlushRunnable, Math.max(0, delayMs) + mBackoffMs);
+    }
+
+    private void flush(boolean force) {
+        if (mQueue.isEmpty() && mPendingDownload == null) return;
+        int network = getNetworkClass();
+        // A download on its own is due at once; otherwise it rides with the
+        // next batch.
+        boolean due = force || mQueue.isEmpty() || mQueue.size() >= BATCH_SIZE
+                || network == NETWORK_UNMETERED
+                || SystemClock.elapsedRealtime() - mOldestSampleTime >= BATCH_DELAY_MS;
+        if (!due) {
+            scheduleFlush(mOldestSampleTime + BATCH_DELAY_MS - SystemClock.elapsedRealtime());
+            return;
+        }
+        if (!force && !canSend(network)) {
+            backOff();
+            return;
+        }
+        send();
+    }
+
+    // Sends everything waiting whether or not a batch is due, as long as the
+    // connection is not slow.
+    private void flushWithRadioUp() {
+        if (mQueue.isEmpty() && mPendingDownload == null) return;
+        int network = getNetworkClass();
+        if (network != NETWORK_CELLULAR && network != NETWORK_UNMETERED) return;
+        send();
+    }
+
+    private void onConnectivityChange() {
+        if (mQueue.isEmpty() && mPendingDownload == null) return;
+        if (getNetworkClass() != NETWORK_UNMETERED) return;
+        mBackoffMs = 0;
+        scheduleFlush(0);
+    }
+
+    private void send() {
+        boolean sent = mQueue.isEmpty() || postBatch();
+        if (sent && mPendingDownload != null && downloadModel(mPendingDownload)) {
+            mPendingDownload = null;
+        }
+        if (!mQueue.isEmpty() || mPendingDownload != null) {
+            backOff();
+        } else {
+            mBackoffMs = 0;
+        }
+    }
+
+    private void backOff() {
+        mBackoffMs = mBackoffMs == 0 ? MIN_BACKOFF_MS : Math.min(mBackoffMs * 2, MAX_BACKOFF_MS);
+        Log.w(TAG, "uploads deferred for %s ms", mBackoffMs);
+        scheduleFlush(0);
+    }
+
+    private boolean canSend(int network) {
+        if (network == NETWORK_UNMETERED) return true;
+        if (network != NETWORK_CELLULAR) return false;
+        if (isCharging()) return true;
+        ConnectivityManager cm =
+                (ConnectivityManager) mContext.getSystemService(Context.CONNECTIVITY_SERVICE);
+        return Build.VERSION.SDK_INT >= Build.VERSION_CODES.LOLLIPOP && isRadioActive(cm);
+    }
+
+    private boolean isCharging() {
+        Intent battery = mContext.registerReceiver(
+                null, new IntentFilter(Intent.ACTION_BATTERY_CHANGED));
+        return battery != null && battery.getIntExtra(BatteryManager.EXTRA_PLUGGED, 0) != 0;
+    }
+
+    // The effective connection type is only estimated natively, so the radio
+    // technology stands in for it; the slow ones are 2G and EV-DO rev. 0.
+    private int getNetworkClass() {
+        ConnectivityManager cm =
+                (ConnectivityManager) mContext.getSystemService(Context.CONNECTIVITY_SERVICE);
+        NetworkInfo info = cm.getActiveNetworkInfo();
+        if (info == null || !info.isConnected()) return NETWORK_NONE;
+        if (info.getType() == ConnectivityManager.TYPE_WIFI
+                || info.getType() == ConnectivityManager.TYPE_ETHERNET) {
+            return NETWORK_UNMETERED;
+        }
+        switch (info.getSubtype()) {
+            case TelephonyManager.NETWORK_TYPE_GPRS:
+            case TelephonyManager.NETWORK_TYPE_EDGE:
+            case TelephonyManager.NETWORK_TYPE_CDMA:
+            case TelephonyManager.NETWORK_TYPE_1xRTT:
+            case TelephonyManager.NETWORK_TYPE_IDEN:
+            case TelephonyManager.NETWORK_TYPE_EVDO_0:
+                return NETWORK_SLOW;
+            default:
+                return NETWORK_CELLULAR;
+        }
+    }
+
+    @TargetApi(Build.VERSION_CODES.LOLLIPOP)
+    private static boolean isRadioActive(ConnectivityManager cm) {
+        return cm.isDefaultNetworkActive();
+    }
+
+    private static boolean hasTrainingRequest(List<InteractionLog.Sample> samples) {
+        for (InteractionLog.Sample sample : samples) {
+            if (sample.kind == InteractionLog.KIND_TRAIN) return true;
+        }
+        return false;
+    }
+
+    /** Posts the queue and removes what was sent from it. */
+    private boolean postBatch() {
+        int count = mQueue.size();
+        List<InteractionLog.Sample> batch = new ArrayList<InteractionLog.Sample>(count);
+        boolean train = false;
+        for (InteractionLog.Sample sample : mQueue.subList(0, count)) {
+            if (sample.kind == InteractionLog.KIND_TRAIN) {
+                train = true;
+            } else {
+                batch.add(sample);
+            }
+        }
+        String url = mServer + "/feedback?deviceId=" + mDeviceId + "&train=" + train
+                + "&format=interaction_log";
+        try {
+            byte[] bytes = InteractionLog.encode(batch);
+            HttpURLConnection conn = (HttpURLConnection) new URL(url).openConnection();
+            conn.setConnectTimeout(CONNECT_TIMEOUT_MS);
+            conn.setReadTimeout(POST_TIMEOUT_MS);
+            conn.setRequestMethod("POST");
+            conn.setDoOutput(true);
+            conn.setRequestProperty("Content-Type", "application/octet-stream");
+            conn.setFixedLengthStreamingMode(bytes.length);
+            OutputStream out = conn.getOutputStream();
+            try {
+                out.write(bytes);
+            } finally {
+                out.close();
+            }
+            int code = conn.getResponseCode();
+            drain(code < 400 ? conn.getInputStream() : conn.getErrorStream());
+            if (code != HttpURLConnection.HTTP_OK) {
+                Log.w(TAG, "feedback rejected: %s", code);
+                return false;
+            }
+        } catch (IOException e) {
+            Log.w(TAG, "feedback not sent: %s", e.toString());
+            return false;
+        }
+        mQueue.subList(0, count).clear();
+        writeQueue(mQueue);
+        Log.w(TAG, "sent %s feedback samples", batch.size());
+        return true;
+    }
+
+    private boolean downloadModel(String url) {
+        String fileName = url.substring(url.lastIndexOf("=") + 1);
+        if (!Environment.getExternalStorageState().equals(Environment.MEDIA_MOUNTED)) {
+            return true;
+        }
+        String parent = Environment.getExternalStorageDirectory().getAbsolutePath() + "/libsvm/";
+        File downloadFile = new File(parent, fileName);
+        try {
+            HttpURLConnection conn = (HttpURLConnection) new URL(url).openConnection();
+            conn.setConnectTimeout(CONNECT_TIMEOUT_MS);
+            conn.setReadTimeout(DOWNLOAD_TIMEOUT_MS);
+            // Only worth asking when the model we have is the one the version
+            // belongs to. Gzip is negotiated by HttpURLConnection.
+            String etag = getETag(fileName);
+            if (etag != null && downloadFile.exists()) {
+                conn.setRequestProperty("If-None-Match", etag);
+            }
+            int code = conn.getResponseCode();
+            if (code == HttpURLConnection.HTTP_NOT_MODIFIED) {
+                Log.w(TAG, "model unchanged: %s ", fileName);
+                drain(conn.getInputStream());
+                return true;
+            }
+            if (code != HttpURLConnection.HTTP_OK) {
+                drain(conn.getErrorStream());
+                // The server has no model for us yet; asking again will not help.
+                return code == HttpURLConnection.HTTP_NOT_FOUND;
+            }
+            // Written aside and renamed, so an interrupted transfer never
+            // replaces a good model.
+            File partialFile = new File(parent, fileName + ".part");
+            InputStream in = conn.getInputStream();
+            FileOutputStream out = new FileOutputStream(partialFile);
+            byte[] b = new byte[2 * 1024];
+            int len;
+            try {
+                while ((len = in.read(b)) != -1) {
+                    out.write(b, 0, len);
+                }
+            } finally {
+                out.close();
+                in.close();
+            }
+            if (!partialFile.renameTo(downloadFile)) {
+                partialFile.delete();
+                return true;
+            }
+            setETag(fileName, conn.getHeaderField("ETag"));
+        } catch (IOException e) {
+            Log.w(TAG, "model not downloaded: %s", e.toString());
+            return false;
+        }
+        mUiHandler.post(new Runnable() {
+            @Override
+            public void run() {
+                Toast.makeText(mContext, "a new model is available, restart the switch.",
+                        Toast.LENGTH_SHORT).show();
+            }
+        });
+        return true;
+    }
+
+    // The connection is only returned to the pool once its body is consumed.
+    private static void drain(InputStream in) throws IOException {
+        if (in == null) return;
+        byte[] b = new byte[2 * 1024];
+        try {
+            while (in.read(b) != -1) {
+            }
+        } finally {
+            in.close();
+        }
+    }
+
+    private List<InteractionLog.Sample> readQueue() {
+        List<InteractionLog.Sample> queue = new ArrayList<InteractionLog.Sample>();
+        if (mQueueFile.exists()) {
+            try {
+                queue.addAll(InteractionLog.decode(readFile(mQueueFile)));
+            } catch (IOException e) {
+                Log.w(TAG, "feedback queue unreadable: %s", e.toString());
+            }
+        }
+        if (mLegacyQueueFile.exists()) {
+            queue.addAll(readLegacyQueue());
+            writeQueue(queue);
+            mLegacyQueueFile.delete();
+        }
+        while (queue.size() > MAX_QUEUED_SAMPLES) queue.remove(0);
+        return queue;
+    }
+
+    // Lines of "save speed step", "pinch speed fps", "implicit type speed fps"
+    // or "train". They carry no time, so they are stamped with now.
+    private List<InteractionLog.Sample> readLegacyQueue() {
+        List<InteractionLog.Sample> queue = new ArrayList<InteractionLog.Sample>();
+        long now = System.currentTimeMillis();
+        try {
+            BufferedReader reader = new BufferedReader(new FileReader(mLegacyQueueFile));
+            try {
+                String line;
+                while ((line = reader.readLine()) != null) {
+                    String[] f = line.split(" ");
+                    try {
+                        if (f[0].equals("save") && f.length == 3) {
+                            queue.add(new InteractionLog.Sample(now, InteractionLog.KIND_SCROLL,
+                                    0, Float.parseFloat(f[1]), 0, Integer.parseInt(f[2])));
+                        } else if (f[0].equals("pinch") && f.length == 3) {
+                            queue.add(new InteractionLog.Sample(now, InteractionLog.KIND_PINCH,
+                                    0, Float.parseFloat(f[1]), parseInt(f[2]), 0));
+                        } else if (f[0].equals("implicit") && f.length == 4) {
+                            queue.add(new InteractionLog.Sample(now,
+                                    InteractionLog.KIND_IMPLICIT, Integer.parseInt(f[1]),
+                                    Float.parseFloat(f[2]), Integer.parseInt(f[3]), 0));
+                        } else if (f[0].equals("train")) {
+                            queue.add(new InteractionLog.Sample(
+                                    now, InteractionLog.KIND_TRAIN, 0, 0, 0, 0));
+                        }
+                    } catch (NumberFormatException e) {
+                        // Dropped, like any other malformed line.
+                    }
+                }
+            } finally {
+                reader.close();
+            }
+        } catch (IOException e) {
+            Log.w(TAG, "old feedback queue unreadable: %s", e.toString());
+        }
+        return queue;
+    }
+
+    private static int parseInt(String value) {
+        try {
+            return Integer.parseInt(value);
+        } catch (NumberFormatException e) {
+            return 0;
+        }
+    }
+
+    private static byte[] readFile(File file) throws IOException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream((int) file.length());
+        FileInputStream in = new FileInputStream(file);
+        byte[] b = new byte[2 * 1024];
+        int len;
+        try {
+            while ((len = in.read(b)) != -1) out.write(b, 0, len);
+        } finally {
+            in.close();
+        }
+        return out.toByteArray();
+    }
+
+    // Rewritten aside and renamed, so a crash never loses the whole queue.
+    private void writeQueue(List<InteractionLog.Sample> queue) {
+        File tempFile = new File(mQueueFile.getPath() + ".tmp");
+        try {
+            byte[] bytes = InteractionLog.encode(queue);
+            FileOutputStream out = new FileOutputStream(tempFile);
+            try {
+                out.write(bytes);
+            } finally {
+                out.close();
+            }
+            if (!tempFile.renameTo(mQueueFile)) tempFile.delete();
+        } catch (IOException e) {
+            Log.w(TAG, "feedback queue not written: %s", e.toString());
+        }
+    }
+
+    private String getETag(String fileName) {
+        SharedPreferences sp = mContext.getSharedPreferences(ETAG_PREFS, Context.MODE_PRIVATE);
+        return sp.getString(fileName, null);
+    }
+
+    private void setETag(String fileName, String etag) {
+        SharedPreferences sp = mContext.getSharedPreferences(ETAG_PREFS, Context.MODE_PRIVATE);
+        SharedPreferences.Editor editor = sp.edit();
+        if (etag == null) {
+            editor.remove(fileName);
+        } else {
+            editor.putString(fileName, etag);
+        }
+        editor.apply();
+    }
+}
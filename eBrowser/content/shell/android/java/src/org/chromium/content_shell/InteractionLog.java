@@ -0,0 +1,157 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+package org.chromium.content_shell;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.zip.GZIPInputStream;
+import java.util.zip.GZIPOutputStream;
+
+/**
+ * The columnar format FeedbackUploader keeps its queue in and posts to the
+ * model server; a sample costs a handful of bytes instead of a text line.
+ *
+ * After a version byte and the sample count, each field is stored as one
+ * column, so runs of similar values sit together for gzip: times as deltas
+ * from the previous sample, speeds quantized to 1/SPEED_SCALE, and frame
+ * rates and corrections as small integers. Signed values are zigzag
+ * varints. The whole block is gzipped.
+ */
+public final class InteractionLog {
+    /** What a sample records. */
+    public static final int KIND_SCROLL = 0;
+    public static final int KIND_PINCH = 1;
+    public static final int KIND_IMPLICIT = 2;
+    /** Asks the server to retrain with the batch it comes in; no feedback. */
+    public static final int KIND_TRAIN = 3;
+
+    public static final int SPEED_SCALE = 100;
+
+    private static final int VERSION = 1;
+
+    /** One interaction the user gave feedback on. */
+    public static final class Sample {
+        /** Wall clock time of the feedback, in milliseconds. */
+        public final long timeMs;
+        public final int kind;
+        /** The gesture type of implicit feedback, otherwise 0. */
+        public final int gestureType;
+        /** In the units of the server's /save endpoint. */
+        public final float speed;
+        /** The frame rate the gesture ran at, or that the user asked for. */
+        public final int fps;
+        /** The fps step the user asked for, 0 if they did not correct it. */
+        public final int correction;
+
+        public Sample(long timeMs, int kind, int gestureType, float speed, int fps,
+                int correction) {
+            this.timeMs = timeMs;
+            this.kind = kind;
+            this.gestureType = gestureType;
+            this.speed = speed;
+            this.fps = fps;
+            this.correction = correction;
+        }
+    }
+
+    private InteractionLog() {}
+
+    /** Returns |samples| encoded and gzipped. */
+    public static byte[] encode(List<Sample> samples) throws IOException {
+        ByteArrayOutputStream columns = new ByteArrayOutputStream();
+        columns.write(VERSION);
+        writeVarint(columns, samples.size());
+        long lastTimeMs = 0;
+        for (Sample sample : samples) {
+            writeSignedVarint(columns, sample.timeMs - lastTimeMs);
+            lastTimeMs = sample.timeMs;
+        }
+        for (Sample sample : samples) columns.write(sample.kind);
+        for (Sample sample : samples) writeVarint(columns, sample.gestureType);
+        for (Sample sample : samples) {
+            writeSignedVarint(columns, Math.round(sample.speed * SPEED_SCALE));
+        }
+        for (Sample sample : samples) writeVarint(columns, Math.max(0, sample.fps));
+        for (Sample sample : samples) writeSignedVarint(columns, sample.correction);
+
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        GZIPOutputStream gzip = new GZIPOutputStream(out);
+        try {
+            columns.writeTo(gzip);
+        } finally {
+            gzip.close();
+        }
+        return out.toByteArray();
+    }
+
+    /** Decodes what encode() made; throws if |data| is not such a block. */
+    public static List<Sample> decode(byte[] data) throws IOException {
+        InputStream in = new GZIPInputStream(new ByteArrayInputStream(data));
+        try {
+            if (in.read() != VERSION) throw new IOException("unknown log version");
+            int count = (int) readVarint(in);
+            if (count < 0) throw new IOException("bad sample count");
+            long[] timesMs = new long[count];
+            long timeMs = 0;
+            for (int i = 0; i < count; ++i) {
+                timeMs += readSignedVarint(in);
+                timesMs[i] = timeMs;
+            }
+            int[] kinds = new int[count];
+            for (int i = 0; i < count; ++i) {
+                kinds[i] = in.read();
+                if (kinds[i] < 0) throw new IOException("truncated log");
+            }
+            int[] gestureTypes = new int[count];
+            for (int i = 0; i < count; ++i) gestureTypes[i] = (int) readVarint(in);
+            float[] speeds = new float[count];
+            for (int i = 0; i < count; ++i) {
+                speeds[i] = (float) readSignedVarint(in) / SPEED_SCALE;
+            }
+            int[] fps = new int[count];
+            for (int i = 0; i < count; ++i) fps[i] = (int) readVarint(in);
+            List<Sample> samples = new ArrayList<Sample>(count);
+            for (int i = 0; i < count; ++i) {
+                samples.add(new Sample(timesMs[i], kinds[i], gestureTypes[i], speeds[i], fps[i],
+                        (int) readSignedVarint(in)));
+            }
+            return samples;
+        } finally {
+            in.close();
+        }
+    }
+
+    private static void writeVarint(ByteArrayOutputStream out, long value) {
+        while ((value & ~0x7FL) != 0) {
+            out.write((int) ((value & 0x7F) | 0x80));
+            value >>>= 7;
+        }
+        out.write((int) value);
+    }
+
+    private static void writeSignedVarint(ByteArrayOutputStream out, long value) {
+        writeVarint(out, (value << 1) ^ (value >> 63));
+    }
+
+    private static long readVarint(InputStream in) throws IOException {
+        long value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int b = in.read();
+            if (b < 0) throw new IOException("truncated log");
+            value |= (long) (b & 0x7F) << shift;
+            if ((b & 0x80) == 0) return value;
+        }
+        throw new IOException("bad varint");
+    }
+
+    private static long readSignedVarint(InputStream in) throws IOException {
+        long value = readVarint(in);
+        return (value >>> 1) ^ -(value & 1);
+    }
+}
@@ -47,8 +47,6 @@ import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
 import java.io.OutputStream;
-import java.io.BufferedReader;
-import java.io.FileReader;
 import java.io.IOException;
 import java.util.UUID;
 /**
@@ -319,41 +317,38 @@ public class Shell extends LinearLayout {
         @Override
         public void onClick(View v) {
           if(!isPowerSaving){return;}
-          Log.w(TAG, "speed-shell: %s ", ContentView.lastScrollAvgSpeed);
+          Log.w(TAG, "speed-shell: %s ", mContentViewCore.getScrollSpeed());
           Log.w(TAG, "start-time: %s ", System.currentTimeMillis());
-          final String urlSave = ipAddr+"/save?deviceId="+getUUID(mContext)+"&speed="+(ContentView.lastScrollAvgSpeed/50)+"&step=1";
-          final String urlTrain = ipAddr+"/train?deviceId="+getUUID(mContext);
-          final String urlDownload = ipAddr+"/download?fileName="+getUUID(mContext);
+          final String urlDownload = ipAddr+"/download?format=binary&fileName="+getUUID(mContext);
           Toast.makeText(mContext,"反馈",Toast.LENGTH_SHORT).show();
-          new HttpPostThread(urlSave, mContext, handler).start();
+          getUploader().addScrollFeedback(mContentViewCore.getScrollSpeedFeature(), 1, initalFps);
           int lastCount = getCount(mContext);
           lastCount += 1;
           Log.w(TAG,"已反馈次数: %s",lastCount);
           setCount(mContext,lastCount);
           if(lastCount % 5 == 0){
            Toast.makeText(mContext,"训练",Toast.LENGTH_SHORT).show();
-           new HttpPostThread(urlTrain, mContext, handler).start();
+           getUploader().requestTraining();
        }
        if(lastCount % 6 == 0){
            Toast.makeText(mContext,"下载",Toast.LENGTH_SHORT).show();
-           new HttpDownloadThread(urlDownload, mContext, handler).start();
+           getUploader().download(urlDownload, false);
        }
-       ContentView.lastScrollAvgSpeed = 0;
+       mContentViewCore.resetScrollSpeed();
        return;
    }
 });
     feedbackButton.setOnClickListener(new OnClickListener() {
         @Override
         public void onClick(View v) {
-          if(ContentView.lastScrollAvgSpeed<=0){return;}
-          long tempSpeed = ContentView.lastScrollAvgSpeed;
+          if(mContentViewCore.getScrollSpeed()<=0){return;}
+          long tempSpeed = mContentViewCore.getScrollSpeed();
           String tempFps = fpsText.getText().toString();
           initalBushuang += 1;
           text_bushuang.setText(String.valueOf(initalBushuang));
-          final String urlSave0 = ipAddr+"/pinch?deviceId="+getUUID(mContext)+"&speed="+tempSpeed+"&fps="+tempFps;
-          new HttpPostThread(urlSave0, mContext, handler).start();
-          Toast.makeText(mContext,"速度："+ContentView.lastScrollAvgSpeed+" FPS:"+tempFps,Toast.LENGTH_SHORT).show();
-          ContentView.lastScrollAvgSpeed = 0;
+          getUploader().addPinchFeedback(tempSpeed, tempFps);
+          Toast.makeText(mContext,"速度："+mContentViewCore.getScrollSpeed()+" FPS:"+tempFps,Toast.LENGTH_SHORT).show();
+          mContentViewCore.resetScrollSpeed();
           return;
       }
   });
@@ -369,40 +364,12 @@ public class Shell extends LinearLayout {
             }else{
                 msavePowerButton.setText("start");
             }
+            setPowerSaving(mContext, isPowerSaving);
             if(!isPowerSaving){
                 mContentViewCore.SendModelStr("stop");
                 return;
             }
-            String diskPath = Environment.getExternalStorageDirectory().getAbsolutePath() + "/";
-            String modelPath = diskPath+"libsvm/";
-            String personalizedModel = modelPath+getUUID(mContext);
-            String sharedModel = modelPath+"model";
-            String line = null;
-            StringBuilder text = new StringBuilder();
-            try {	
-               File file = new File(personalizedModel);
-               if(!file.exists()){
-                  file = new File(sharedModel);
-                  if(!file.exists()){
-                    final String urlDownload = ipAddr+"/download?fileName=model";
-                    new HttpDownloadThread(urlDownload, mContext, handler).start();
-                    return;
-                  }
-              }
-              BufferedReader buf = new BufferedReader(new FileReader(file));	     
-              while(( line = buf.readLine() ) != null )
-              {
-                  if(text.length()>0){
-                      text.append("\n");
-                  }
-                  text.append(line.trim());
-              }
-              buf.close();
-          }catch (IOException e){
-             throw new RuntimeException("Read file error");
-         }
-         final String modelStr = text.toString();
-         mContentViewCore.SendModelStr(modelStr);
+            sendModels();
      }
  });
 
@@ -419,33 +386,84 @@ public class Shell extends LinearLayout {
    });
 }
 
+// Scroll models are fetched as frame rate tables compiled by the server, so the
+// renderer only looks predictions up. Set to false to fetch binary models,
+// e.g. for multi-feature models, which cannot be tabulated.
+private static final boolean DOWNLOAD_MODEL_TABLES = true;
+// Speed step of downloaded tables, in the units the model is trained in.
+private static final String MODEL_TABLE_STEP = "0.05";
+
+/**
+ * URL of the scroll model |fileName|. FeedbackUploader saves the download
+ * under the name that ends the URL, in place of any earlier model.
+ */
+private String modelDownloadUrl(String fileName) {
+  if (DOWNLOAD_MODEL_TABLES) {
+    return ipAddr + "/model/table?step=" + MODEL_TABLE_STEP + "&fileName=" + fileName;
+  }
+  return ipAddr + "/download?format=binary&fileName=" + fileName;
+}
+
+/**
+ * Sends the provisioned models. Text models are compiled once and cached by the
+ * browser, so this costs no parsing after the first time a model is sent.
+ */
+private void sendModels() {
+  String diskPath = Environment.getExternalStorageDirectory().getAbsolutePath() + "/";
+  String modelPath = diskPath+"libsvm/";
+  File file = new File(modelPath+getUUID(mContext));
+  if(!file.exists()){
+    file = new File(modelPath+"model");
+    if(!file.exists()){
+      // Power saving waits on this one, so it goes out on any network.
+      getUploader().download(modelDownloadUrl("model"), true);
+      return;
+    }
+  }
+  // Without a pinch model pinch updates run at the full frame rate.
+  File pinchModel = new File(modelPath + "pinch_model");
+  if (pinchModel.exists()) {
+    mContentViewCore.sendModelFile(ContentViewCore.MODEL_TYPE_PINCH,
+        pinchModel.getAbsolutePath());
+  }
+  mContentViewCore.sendModelFile(ContentViewCore.MODEL_TYPE_SCROLL, file.getAbsolutePath());
+}
+
 private void talkToServer(int step){
   if(!isPowerSaving){
     return;
   }
-  Log.w(TAG, "speed-shell: %s ", ContentView.lastScrollAvgSpeed);
+  // Tracked natively; read once per feedback rather than pushed per frame.
+  float scrollSpeed = mContentViewCore.getScrollSpeedFeature();
+  Log.w(TAG, "speed-shell: %s ", scrollSpeed);
   Log.w(TAG, "start-time: %s ", System.currentTimeMillis());
-  final String urlSave = ipAddr+"/save?deviceId="+getUUID(mContext)+"&speed="+(ContentView.lastScrollAvgSpeed/50)+"&step="+step;
-  final String urlTrain = ipAddr+"/train?deviceId="+getUUID(mContext);
-  final String urlDownload = ipAddr+"/download?fileName="+getUUID(mContext);
+  final String urlDownload = modelDownloadUrl(getUUID(mContext));
   Toast.makeText(mContext,"tweak",Toast.LENGTH_SHORT).show();
-  new HttpPostThread(urlSave, mContext, handler).start();
+  // Personalizes the model on the device right away; the server still gets the
+  // feedback for its aggregate models.
+  mContentViewCore.addModelFeedback(scrollSpeed, initalFps);
+  // Queued and sent in batches over a cheap network.
+  getUploader().addScrollFeedback(scrollSpeed, step, initalFps);
   int lastCount = getCount(mContext);
   lastCount += 1;
   //Log.w(TAG,"已反馈次数: %s",lastCount);
   setCount(mContext,lastCount);
   if(lastCount % 5 == 0){
      //Toast.makeText(mContext,"训练",Toast.LENGTH_SHORT).show();
-     new HttpPostThread(urlTrain, mContext, handler).start();
+     getUploader().requestTraining();
  }
  if(lastCount % 6 == 0){
      Toast.makeText(mContext,"get a new model, restart the switch.",Toast.LENGTH_SHORT).show();
-     new HttpDownloadThread(urlDownload, mContext, handler).start();
+     getUploader().download(urlDownload, false);
  }
- ContentView.lastScrollAvgSpeed = 0;
+ mContentViewCore.resetScrollSpeed();
  return;
 }
 
+private FeedbackUploader getUploader() {
+  return FeedbackUploader.get(mContext, ipAddr, getUUID(mContext));
+}
+
 //end
 @SuppressWarnings("unused")
 @CalledByNative
@@ -477,6 +495,8 @@ private boolean isFullscreenForTabOrPending() {
 @CalledByNative
 private void setIsLoading(boolean loading) {
     mLoading = loading;
+    // Feedback and models wait for the radio a page load woke up.
+    if (!mLoading) FeedbackUploader.onPageLoadFinished();
     if (mLoading) {
         mStopReloadButton
         .setImageResource(android.R.drawable.ic_menu_close_clear_cancel);
@@ -498,6 +518,16 @@ private void setIsLoading(boolean loading) {
         mContentViewCore.initialize(ViewAndroidDelegate.createBasicDelegate(cv), cv,
             webContents, mWindow);
         mContentViewCore.setContentViewClient(mContentViewClient);
+        // Scrolls the user reacts to tell the server as much as the +/- buttons
+        // do, without the user having to press them.
+        mContentViewCore.setImplicitFeedbackListener(
+                new ContentViewCore.ImplicitFeedbackListener() {
+                    @Override
+                    public void onImplicitFeedback(int type, float speed, int frameRate) {
+                        if (!isPowerSaving) return;
+                        getUploader().addImplicitFeedback(type, speed, frameRate);
+                    }
+                });
         mWebContents = mContentViewCore.getWebContents();
         mNavigationController = mWebContents.getNavigationController();
         if (getParent() != null) mContentViewCore.onShow();
@@ -510,6 +540,13 @@ private void setIsLoading(boolean loading) {
                 FrameLayout.LayoutParams.MATCH_PARENT));
         cv.requestFocus();
         mContentViewRenderView.setCurrentContentViewCore(mContentViewCore);
+        // Power saving survives restarts; the cached models make it effective
+        // from the first scroll.
+        if (getPowerSaving(mContext)) {
+            isPowerSaving = true;
+            if (msavePowerButton != null) msavePowerButton.setText("stop");
+            sendModels();
+        }
     }
 
     @CalledByNative
@@ -588,6 +625,18 @@ private void setIsLoading(boolean loading) {
         editor.apply();
     }
 
+    private boolean getPowerSaving(Context context){
+        SharedPreferences sp = context.getSharedPreferences("config",context.MODE_PRIVATE);
+        return sp.getBoolean("powerSaving",false);
+    }
+
+    private void setPowerSaving(Context context,boolean value){
+        SharedPreferences sp = context.getSharedPreferences("config",context.MODE_PRIVATE);
+        SharedPreferences.Editor editor = sp.edit();
+        editor.putBoolean("powerSaving",value);
+        editor.apply();
+    }
+
     public String getUUID(Context context){
         SharedPreferences sp = context.getSharedPreferences("config",context.MODE_PRIVATE);
         return sp.getString("uuid","");
@@ -0,0 +1,72 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+package org.chromium.content_shell_apk;
+
+import android.test.InstrumentationTestCase;
+import android.test.suitebuilder.annotation.SmallTest;
+
+import org.chromium.base.test.util.Feature;
+import org.chromium.content_shell.InteractionLog;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Tests the InteractionLog format.
+ */
+public class InteractionLogTest extends InstrumentationTestCase {
+    @SmallTest
+    @Feature({"InteractionLog"})
+    public void testRoundTrip() throws Exception {
+        List<InteractionLog.Sample> samples = new ArrayList<InteractionLog.Sample>();
+        long start = 1500000000000L;
+        samples.add(new InteractionLog.Sample(start, InteractionLog.KIND_SCROLL, 0, 12f, 30, 1));
+        samples.add(new InteractionLog.Sample(
+                start + 2500, InteractionLog.KIND_IMPLICIT, 4, 0.37f, 45, 0));
+        // The wall clock may step back.
+        samples.add(new InteractionLog.Sample(start - 10, InteractionLog.KIND_PINCH, 0, 3f, 20, 0));
+        samples.add(new InteractionLog.Sample(start, InteractionLog.KIND_SCROLL, 0, 7f, 24, -1));
+        samples.add(new InteractionLog.Sample(start, InteractionLog.KIND_TRAIN, 0, 0, 0, 0));
+
+        List<InteractionLog.Sample> decoded = InteractionLog.decode(InteractionLog.encode(samples));
+        assertEquals(samples.size(), decoded.size());
+        for (int i = 0; i < samples.size(); ++i) {
+            InteractionLog.Sample expected = samples.get(i);
+            InteractionLog.Sample actual = decoded.get(i);
+            assertEquals(expected.timeMs, actual.timeMs);
+            assertEquals(expected.kind, actual.kind);
+            assertEquals(expected.gestureType, actual.gestureType);
+            assertEquals(expected.speed, actual.speed, 0.5f / InteractionLog.SPEED_SCALE);
+            assertEquals(expected.fps, actual.fps);
+            assertEquals(expected.correction, actual.correction);
+        }
+    }
+
+    @SmallTest
+    @Feature({"InteractionLog"})
+    public void testIsCompact() throws Exception {
+        List<InteractionLog.Sample> samples = new ArrayList<InteractionLog.Sample>();
+        long time = 1500000000000L;
+        for (int i = 0; i < 1000; ++i) {
+            time += 3000 + (i % 7) * 100;
+            samples.add(new InteractionLog.Sample(
+                    time, InteractionLog.KIND_IMPLICIT, 1, 0.1f * (i % 20), 30 + i % 4, 0));
+        }
+        // The text queue took about 25 bytes a sample.
+        assertTrue(InteractionLog.encode(samples).length < 4 * samples.size());
+    }
+
+    @SmallTest
+    @Feature({"InteractionLog"})
+    public void testRejectsGarbage() throws Exception {
+        try {
+            InteractionLog.decode(new byte[] {1, 2, 3});
+            fail();
+        } catch (IOException e) {
+            // Expected.
+        }
+    }
+}
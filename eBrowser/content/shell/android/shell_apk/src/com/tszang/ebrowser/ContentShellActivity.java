@@ -13,7 +13,9 @@ import android.view.KeyEvent;
 import android.widget.Toast;
 
 import android.content.res.AssetManager;
+import android.os.AsyncTask;
 import android.os.Environment;
+import android.os.SystemClock;
 import java.io.File;
 import java.io.FileOutputStream;
 import java.io.IOException;
@@ -68,6 +70,7 @@ public class ContentShellActivity extends Activity {
 
         DeviceUtils.addDeviceSpecificUserAgentSwitch(this);
         //load JNI lib
+        long libraryLoadStartMs = SystemClock.uptimeMillis();
         try {
             LibraryLoader.get(LibraryProcessType.PROCESS_BROWSER).ensureInitialized();
         } catch (ProcessInitException e) {
@@ -77,6 +80,15 @@ public class ContentShellActivity extends Activity {
             System.exit(-1);
             return;
         }
+        if (CommandLine.getInstance().hasSwitch(ContentSwitches.EBROWSER_STARTUP_TIMINGS)) {
+            Log.i(TAG, "Native library load: "
+                    + (SystemClock.uptimeMillis() - libraryLoadStartMs) + " ms");
+        }
+        // Only the pages startup touched are resident yet. Reading the rest of
+        // the library into the page cache in the background turns the hard
+        // faults of later browser code, and of renderers mapping the same file,
+        // into soft ones.
+        LibraryLoader.get(LibraryProcessType.PROCESS_BROWSER).asyncPrefetchLibrariesToMemory();
 
         setContentView(R.layout.content_shell_activity);
         //my code
@@ -86,9 +98,9 @@ public class ContentShellActivity extends Activity {
             Toast.makeText(ContentShellActivity.this,"External storage is not available",Toast.LENGTH_SHORT).show();
             //apply for storage permissions
         }
-        //Create folder for saving model files
-        createAppFolderIfNeed(modelPath);
-        copyAssetsDataIfNeed(modelPath);
+        //Create folder for saving model files, off the UI thread so that it
+        //overlaps with browser process startup
+        copyAssetsDataInBackground(modelPath);
         //end
         mShellManager = (ShellManager) findViewById(R.id.shell_container);//Get shellManager obj
         final boolean listenToActivityState = true;
@@ -152,6 +164,16 @@ public class ContentShellActivity extends Activity {
         }
     }
 
+    private void copyAssetsDataInBackground(final String dir) {
+        AsyncTask.THREAD_POOL_EXECUTOR.execute(new Runnable() {
+            @Override
+            public void run() {
+                createAppFolderIfNeed(dir);
+                copyAssetsDataIfNeed(dir);
+            }
+        });
+    }
+
     private void copyAssetsDataIfNeed(String dir){
         String assetsToCopy[] = {"model"};
        for(int i=0; i<assetsToCopy.length; i++){
@@ -172,17 +194,20 @@ public class ContentShellActivity extends Activity {
     private boolean copyAsset(AssetManager assetManager, String fromAssetPath, String toPath) {
         InputStream in = null;
         OutputStream out = null;
+        // Copy to a temporary file first, so that the renderer never loads a
+        // partially copied model.
+        File tmpFile = new File(toPath + ".tmp");
         try {
             in = assetManager.open(fromAssetPath);
-            new File(toPath).createNewFile();
-            out = new FileOutputStream(toPath);
+            tmpFile.createNewFile();
+            out = new FileOutputStream(tmpFile);
             copyFile(in, out);
             in.close();
             in = null;
             out.flush();
             out.close();
             out = null;
-            return true;
+            return tmpFile.renameTo(new File(toPath));
         } catch(Exception e) {
             e.printStackTrace();
             Log.e(LOG_TAG, "[ERROR]: copyAsset: unable to copy file = "+fromAssetPath);
@@ -191,7 +216,7 @@ public class ContentShellActivity extends Activity {
     }
 
     private void copyFile(InputStream in, OutputStream out) throws IOException {
-        byte[] buffer = new byte[1024];
+        byte[] buffer = new byte[64 * 1024];
         int read;
         while((read = in.read(buffer)) != -1){
             out.write(buffer, 0, read);
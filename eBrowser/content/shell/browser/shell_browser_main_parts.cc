@@ -14,6 +14,8 @@
 #include "build/build_config.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/devtools_agent_host.h"
+#include "content/public/browser/power_usage_monitor.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/main_function_params.h"
@@ -186,6 +188,19 @@ void ShellBrowserMainParts::PreMainMessageLoopRun() {
   net::NetModule::SetResourceProvider(PlatformResourceProvider);
   ShellDevToolsManagerDelegate::StartHttpHandler(browser_context_.get());
   InitializeMessageLoopContext();
+  // Feeds battery status into the ebrowser.energy trace category.
+  StartPowerUsageMonitor();
+
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (command_line.HasSwitch(switches::kEBrowserSpareRenderer) &&
+      !command_line.HasSwitch(switches::kRunLayoutTest) &&
+      !parameters_.ui_task) {
+    BrowserThread::PostAfterStartupTask(
+        FROM_HERE, BrowserThread::GetTaskRunnerForThread(BrowserThread::UI),
+        base::Bind(&RenderProcessHost::WarmupSpareRenderProcessHost,
+                   browser_context()));
+  }
 
   if (parameters_.ui_task) {
     parameters_.ui_task->Run();
@@ -199,6 +214,7 @@ bool ShellBrowserMainParts::MainMessageLoopRun(int* result_code)  {
 }
 
 void ShellBrowserMainParts::PostMainMessageLoopRun() {
+  RenderProcessHost::DiscardSpareRenderProcessHost();
   ShellDevToolsManagerDelegate::StopHttpHandler();
   browser_context_.reset();
   off_the_record_browser_context_.reset();
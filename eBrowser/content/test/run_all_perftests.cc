@@ -4,12 +4,14 @@
 
 #include "base/bind.h"
 #include "base/test/launcher/unit_test_launcher.h"
+#include "content/app/mojo/mojo_init.h"
 #include "content/public/test/unittest_test_suite.h"
 #include "content/test/content_test_suite.h"
 
 int main(int argc, char** argv) {
   content::UnitTestTestSuite test_suite(
       new content::ContentTestSuite(argc, argv));
+  content::InitializeMojo();
 
   // Always run the perf tests serially, to avoid distorting
   // perf measurements with randomness resulting from running
@@ -20,6 +20,7 @@
 #include "ipc/ipc_sync_channel.h"
 #include "services/service_manager/public/cpp/interface_registry.h"
 #include "third_party/WebKit/public/web/WebKit.h"
+#include "ui/events/blink/incremental_svr_trainer.h"
 
 #if defined(OS_POSIX) && defined(ENABLE_PLUGINS)
 #include "base/files/file_path.h"
@@ -107,6 +108,7 @@ bool UtilityThreadImpl::OnControlMessageReceived(const IPC::Message& msg) {
   IPC_BEGIN_MESSAGE_MAP(UtilityThreadImpl, msg)
     IPC_MESSAGE_HANDLER(UtilityMsg_BatchMode_Started, OnBatchModeStarted)
     IPC_MESSAGE_HANDLER(UtilityMsg_BatchMode_Finished, OnBatchModeFinished)
+    IPC_MESSAGE_HANDLER(UtilityMsg_TrainInputModel, OnTrainInputModel)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
   return handled;
@@ -121,6 +123,19 @@ void UtilityThreadImpl::OnBatchModeFinished() {
   ReleaseProcessIfNeeded();
 }
 
+void UtilityThreadImpl::OnTrainInputModel(
+    uint64_t first_sample_id,
+    const ui::SvrTrainingSet& training_set) {
+  std::string model;
+  std::vector<double> coefs;
+  if (ui::TrainSvrModel(training_set, &model, &coefs)) {
+    Send(new UtilityHostMsg_InputModelTrained(first_sample_id, model, coefs));
+  } else {
+    Send(new UtilityHostMsg_InputModelTrainingFailed(first_sample_id));
+  }
+  ReleaseProcessIfNeeded();
+}
+
 void UtilityThreadImpl::BindServiceFactoryRequest(
     service_manager::mojom::ServiceFactoryRequest request) {
   DCHECK(service_factory_);
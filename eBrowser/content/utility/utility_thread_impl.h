@@ -22,6 +22,10 @@ namespace base {
 class FilePath;
 }
 
+namespace ui {
+struct SvrTrainingSet;
+}
+
 namespace content {
 class BlinkPlatformImpl;
 class UtilityBlinkPlatformImpl;
@@ -55,6 +59,8 @@ class UtilityThreadImpl : public UtilityThread,
   // IPC message handlers.
   void OnBatchModeStarted();
   void OnBatchModeFinished();
+  void OnTrainInputModel(uint64_t first_sample_id,
+                         const ui::SvrTrainingSet& training_set);
 
   void BindServiceFactoryRequest(
       service_manager::mojom::ServiceFactoryRequest request);
@@ -55,6 +55,7 @@
 #include "third_party/icu/source/i18n/unicode/timezone.h"
 #include "third_party/skia/include/ports/SkFontConfigInterface.h"
 #include "third_party/skia/include/ports/SkFontMgr_android.h"
+#include "ui/events/blink/incremental_svr_trainer.h"
 
 #if defined(OS_LINUX)
 #include <sys/prctl.h>
@@ -357,6 +358,11 @@ static void ZygotePreSandboxInit() {
   // will work inside the sandbox.
   RAND_set_urandom_fd(base::GetUrandomFD());
 
+  // Renderers predict frame rates with libsvm and utility processes retrain
+  // the models. Run both once so that forked children find that code already
+  // paged in and relocated instead of faulting it in on every launch.
+  ui::WarmUpSvrTraining();
+
 #if defined(ENABLE_PLUGINS)
   // Ensure access to the Pepper plugins before the sandbox is turned on.
   PreloadPepperPlugins();
@@ -19,6 +19,7 @@
 #include "ui/android/window_android_compositor.h"
 #include "ui/gfx/android/device_display_info.h"
 #include "ui/gfx/geometry/dip_util.h"
+#include "ui/gfx/geometry/size_conversions.h"
 
 namespace ui {
 
@@ -46,13 +47,16 @@ scoped_refptr<cc::SurfaceLayer> CreateSurfaceLayer(
     cc::SurfaceManager* surface_manager,
     cc::SurfaceId surface_id,
     const gfx::Size surface_size,
+    float surface_scale,
     bool surface_opaque) {
   // manager must outlive compositors using it.
   scoped_refptr<cc::SurfaceLayer> layer = cc::SurfaceLayer::Create(
       base::Bind(&SatisfyCallback, base::Unretained(surface_manager)),
       base::Bind(&RequireCallback, base::Unretained(surface_manager)));
-  layer->SetSurfaceId(surface_id, 1.f, surface_size);
-  layer->SetBounds(surface_size);
+  // A surface rastered below the display's scale is scaled up to fill the
+  // same bounds.
+  layer->SetSurfaceId(surface_id, surface_scale, surface_size);
+  layer->SetBounds(gfx::ScaleToCeiledSize(surface_size, 1.f / surface_scale));
   layer->SetIsDrawable(true);
   layer->SetContentsOpaque(surface_opaque);
 
@@ -114,8 +118,13 @@ void DelegatedFrameHostAndroid::SubmitCompositorFrame(
   cc::RenderPass* root_pass =
       frame.delegated_frame_data->render_pass_list.back().get();
   gfx::Size surface_size = root_pass->output_rect.size();
+  float surface_scale = 1.f;
+  float display_scale = gfx::DeviceDisplayInfo().GetDIPScale();
+  if (frame.metadata.device_scale_factor > 0 && display_scale > 0)
+    surface_scale = frame.metadata.device_scale_factor / display_scale;
 
   if (!current_frame_ || surface_size != current_frame_->surface_size ||
+      surface_scale != current_frame_->surface_scale ||
       current_frame_->top_controls_height !=
           frame.metadata.top_controls_height ||
       current_frame_->top_controls_shown_ratio !=
@@ -136,6 +145,7 @@ void DelegatedFrameHostAndroid::SubmitCompositorFrame(
     surface_factory_->Create(current_frame_->local_frame_id);
 
     current_frame_->surface_size = surface_size;
+    current_frame_->surface_scale = surface_scale;
     current_frame_->top_controls_height = frame.metadata.top_controls_height;
     current_frame_->top_controls_shown_ratio =
         frame.metadata.top_controls_shown_ratio;
@@ -150,7 +160,7 @@ void DelegatedFrameHostAndroid::SubmitCompositorFrame(
     content_layer_ = CreateSurfaceLayer(
         surface_manager_, cc::SurfaceId(surface_factory_->frame_sink_id(),
                                         current_frame_->local_frame_id),
-        current_frame_->surface_size,
+        current_frame_->surface_size, current_frame_->surface_scale,
         !current_frame_->has_transparent_background);
     view_->GetLayer()->AddChild(content_layer_);
     UpdateBackgroundLayer();
@@ -174,7 +184,7 @@ void DelegatedFrameHostAndroid::RequestCopyOfSurface(
   scoped_refptr<cc::Layer> readback_layer = CreateSurfaceLayer(
       surface_manager_, cc::SurfaceId(surface_factory_->frame_sink_id(),
                                       current_frame_->local_frame_id),
-      current_frame_->surface_size,
+      current_frame_->surface_size, current_frame_->surface_scale,
       !current_frame_->has_transparent_background);
   readback_layer->SetHideLayerAndSubtree(true);
   compositor->AttachLayerForReadback(readback_layer);
@@ -261,7 +271,8 @@ void DelegatedFrameHostAndroid::UpdateBackgroundLayer() {
   bool background_is_drawable = false;
 
   if (current_frame_) {
-    float device_scale_factor = gfx::DeviceDisplayInfo().GetDIPScale();
+    float device_scale_factor = gfx::DeviceDisplayInfo().GetDIPScale() *
+                                current_frame_->surface_scale;
     gfx::Size content_size_in_dip = gfx::ConvertSizeToDIP(
         device_scale_factor, current_frame_->surface_size);
     background_is_drawable =
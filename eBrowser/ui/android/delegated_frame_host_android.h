@@ -93,6 +93,9 @@ class UI_ANDROID_EXPORT DelegatedFrameHostAndroid
 
     cc::LocalFrameId local_frame_id;
     gfx::Size surface_size;
+    // The renderer's raster scale relative to the display's; below 1 while
+    // it rasters fast flings at a reduced scale.
+    float surface_scale;
     float top_controls_height;
     float top_controls_shown_ratio;
     float bottom_controls_height;
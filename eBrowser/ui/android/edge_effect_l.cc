@@ -28,6 +28,9 @@ const int kPullDecayTimeMs = 2000;
 
 const float kMaxAlpha = 0.5f;
 
+// Below this the glow's opacity rounds to zero on an 8-bit surface.
+const float kMinVisibleAlpha = 0.5f / 255;
+
 const float kPullGlowBegin = 0.f;
 
 // Min/max velocity that will be absorbed
@@ -205,8 +208,11 @@ bool EdgeEffectL::Update(base::TimeTicks current_time) {
     }
   }
 
+  // A fading glow that can no longer be seen asks for no more frames, which
+  // ends a pull decay well before its two seconds are up.
   bool one_last_frame = false;
-  if (state_ == STATE_RECEDE && glow_scale_y_ <= 0) {
+  bool fading = state_ == STATE_RECEDE || state_ == STATE_PULL_DECAY;
+  if (fading && (glow_scale_y_ <= 0 || glow_alpha_ < kMinVisibleAlpha)) {
     Finish();
     one_last_frame = true;
   }
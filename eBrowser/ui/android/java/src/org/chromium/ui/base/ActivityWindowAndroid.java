@@ -19,7 +19,10 @@ import android.os.Handler;
 import android.os.Process;
 import android.text.TextUtils;
 import android.util.SparseArray;
+import android.view.Display;
 import android.view.View;
+import android.view.Window;
+import android.view.WindowManager;
 
 import org.chromium.base.ActivityState;
 import org.chromium.base.ApiCompatibilityUtils;
@@ -27,6 +30,7 @@ import org.chromium.base.ApplicationStatus;
 import org.chromium.base.Callback;
 import org.chromium.base.ContextUtils;
 import org.chromium.ui.UiUtils;
+import org.chromium.ui.display.DisplayAndroid;
 
 import java.lang.ref.WeakReference;
 
@@ -44,11 +48,23 @@ public class ActivityWindowAndroid
 
     private static final String PERMISSION_QUERIED_KEY_PREFIX = "HasRequestedAndroidPermission::";
 
+    // A mode switch is not free, so lower refresh rates are only requested once the predicted
+    // frame rate has held for this long. Restoring the default is immediate.
+    private static final long REFRESH_RATE_SETTLE_DELAY_MS = 500;
+
     private final Handler mHandler;
     private final SparseArray<PermissionCallback> mOutstandingPermissionRequests;
 
     private int mNextRequestCode = 0;
 
+    private float mRequestedRefreshRate;
+    private final Runnable mApplyRefreshRate = new Runnable() {
+        @Override
+        public void run() {
+            applyRefreshRateToWindow(mRequestedRefreshRate);
+        }
+    };
+
     /**
      * Creates an Activity-specific WindowAndroid with associated intent functionality.
      * TODO(jdduke): Remove this overload when all callsites have been updated to
@@ -79,6 +95,37 @@ public class ActivityWindowAndroid
         setAndroidPermissionDelegate(new ActivityAndroidPermissionDelegate());
     }
 
+    @Override
+    protected void onPreferredRefreshRateChanged(float refreshRate) {
+        mHandler.removeCallbacks(mApplyRefreshRate);
+        mRequestedRefreshRate = refreshRate;
+        if (refreshRate <= 0) {
+            applyRefreshRateToWindow(0);
+            return;
+        }
+        mHandler.postDelayed(mApplyRefreshRate, REFRESH_RATE_SETTLE_DELAY_MS);
+    }
+
+    private void applyRefreshRateToWindow(float refreshRate) {
+        Activity activity = getActivity().get();
+        if (activity == null) return;
+        Window window = activity.getWindow();
+        WindowManager.LayoutParams params = window.getAttributes();
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.M) {
+            Display display = window.getWindowManager().getDefaultDisplay();
+            int modeId = refreshRate > 0
+                    ? DisplayAndroid.getModeIdForRefreshRate(display, refreshRate) : 0;
+            if (params.preferredDisplayModeId == modeId) return;
+            params.preferredDisplayModeId = modeId;
+        } else if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.LOLLIPOP) {
+            if (params.preferredRefreshRate == refreshRate) return;
+            params.preferredRefreshRate = refreshRate;
+        } else {
+            return;
+        }
+        window.setAttributes(params);
+    }
+
     @Override
     protected void registerKeyboardVisibilityCallbacks() {
         Activity activity = getActivity().get();
@@ -475,6 +475,23 @@ public class WindowAndroid {
         mVSyncMonitor.requestUpdate();
     }
 
+    /**
+     * Called while an interaction is throttled to a lower frame rate, so that the panel can
+     * refresh at a matching rate.
+     * @param refreshRate The desired refresh rate in Hz, or 0 to restore the default.
+     */
+    @CalledByNative
+    private void setPreferredRefreshRate(float refreshRate) {
+        onPreferredRefreshRateChanged(refreshRate);
+    }
+
+    /**
+     * Applies a refresh rate requested through {@link #setPreferredRefreshRate(float)}. Only
+     * windows backed by an Activity can do so.
+     */
+    protected void onPreferredRefreshRateChanged(float refreshRate) {
+    }
+
     /**
      * An interface that intent callback objects have to implement.
      */
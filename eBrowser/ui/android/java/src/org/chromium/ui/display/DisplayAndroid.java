@@ -138,6 +138,31 @@ public class DisplayAndroid {
         return mDisplayMetrics.density;
     }
 
+    /**
+     * Finds the display mode to request for a panel refresh rate of at least |refreshRate|
+     * while keeping the current resolution.
+     * @return The id of the slowest such mode, or 0 (no preference) if that is already the
+     *         fastest mode available.
+     */
+    @TargetApi(Build.VERSION_CODES.M)
+    public static int getModeIdForRefreshRate(Display display, float refreshRate) {
+        Display.Mode current = display.getMode();
+        Display.Mode best = null;
+        float maxRefreshRate = 0;
+        for (Display.Mode mode : display.getSupportedModes()) {
+            if (mode.getPhysicalWidth() != current.getPhysicalWidth()
+                    || mode.getPhysicalHeight() != current.getPhysicalHeight()) {
+                continue;
+            }
+            maxRefreshRate = Math.max(maxRefreshRate, mode.getRefreshRate());
+            // Panels report rates like 59.94Hz for a nominal 60.
+            if (mode.getRefreshRate() < refreshRate - 0.5f) continue;
+            if (best == null || mode.getRefreshRate() < best.getRefreshRate()) best = mode;
+        }
+        if (best == null || best.getRefreshRate() >= maxRefreshRate) return 0;
+        return best.getModeId();
+    }
+
     /**
      * Add observer. Note repeat observers will be called only one.
      * Observers are held only weakly by Display.
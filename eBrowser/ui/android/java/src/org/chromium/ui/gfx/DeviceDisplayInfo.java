@@ -17,6 +17,8 @@ import android.view.WindowManager;
 import org.chromium.base.annotations.CalledByNative;
 import org.chromium.base.annotations.JNINamespace;
 
+import java.util.Arrays;
+
 /**
  * This class facilitates access to android information typically only
  * available using the Java SDK, including {@link Display} properties.
@@ -150,6 +152,16 @@ public class DeviceDisplayInfo {
         return mTempMetrics.density;
     }
 
+    /**
+     * @return The panel's pixel density, in physical pixels per inch, as reported by the
+     *         manufacturer. Unlike getDIPScale(), it is not rounded to a density bucket.
+     */
+    @CalledByNative
+    public float getPhysicalDpi() {
+        getDisplay().getMetrics(mTempMetrics);
+        return (mTempMetrics.xdpi + mTempMetrics.ydpi) / 2;
+    }
+
     /**
      * @return Smallest screen size in density-independent pixels that the
      *         application will see, regardless of orientation.
@@ -183,6 +195,43 @@ public class DeviceDisplayInfo {
         return 0;
     }
 
+    /**
+     * @return The rate the display refreshes at, in Hz.
+     */
+    @CalledByNative
+    public float getRefreshRate() {
+        return getDisplay().getRefreshRate();
+    }
+
+    /**
+     * @return The distinct refresh rates, in Hz and ascending, of the display modes at the
+     *         current resolution. Empty before M, where the mode cannot be chosen.
+     */
+    @TargetApi(Build.VERSION_CODES.M)
+    @CalledByNative
+    public float[] getSupportedRefreshRates() {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.M) return new float[0];
+        Display display = getDisplay();
+        Display.Mode current = display.getMode();
+        Display.Mode[] modes = display.getSupportedModes();
+        float[] rates = new float[modes.length];
+        int count = 0;
+        for (Display.Mode mode : modes) {
+            if (mode.getPhysicalWidth() != current.getPhysicalWidth()
+                    || mode.getPhysicalHeight() != current.getPhysicalHeight()) {
+                continue;
+            }
+            rates[count++] = mode.getRefreshRate();
+        }
+        rates = Arrays.copyOf(rates, count);
+        Arrays.sort(rates);
+        int distinct = 0;
+        for (int i = 0; i < rates.length; i++) {
+            if (distinct == 0 || rates[i] != rates[distinct - 1]) rates[distinct++] = rates[i];
+        }
+        return Arrays.copyOf(rates, distinct);
+    }
+
     /**
      * Inform the native implementation to update its cached representation of
      * the DeviceDisplayInfo values.
@@ -192,7 +241,8 @@ public class DeviceDisplayInfo {
                 getDisplayHeight(), getDisplayWidth(),
                 getPhysicalDisplayHeight(), getPhysicalDisplayWidth(),
                 getBitsPerPixel(), getBitsPerComponent(),
-                getDIPScale(), getSmallestDIPWidth(), getRotationDegrees());
+                getDIPScale(), getPhysicalDpi(), getSmallestDIPWidth(),
+                getRotationDegrees(), getRefreshRate(), getSupportedRefreshRates());
     }
 
     private Display getDisplay() {
@@ -214,6 +264,7 @@ public class DeviceDisplayInfo {
             int displayHeight, int displayWidth,
             int physicalDisplayHeight, int physicalDisplayWidth,
             int bitsPerPixel, int bitsPerComponent, double dipScale,
-            int smallestDIPWidth, int rotationDegrees);
+            float physicalDpi, int smallestDIPWidth, int rotationDegrees,
+            float refreshRate, float[] supportedRefreshRates);
 
 }
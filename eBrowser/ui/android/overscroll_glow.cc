@@ -19,6 +19,10 @@ namespace {
 
 const float kEpsilon = 1e-3f;
 
+// Allows for vsync jitter, so that 30fps on a 60Hz display is every other
+// frame.
+const float kFrameIntervalSlackSeconds = 0.002f;
+
 bool IsApproxZero(float value) {
   return std::abs(value) < kEpsilon;
 }
@@ -38,7 +42,9 @@ OverscrollGlow::OverscrollGlow(OverscrollGlowClient* client)
       edge_offsets_(),
       initialized_(false),
       allow_horizontal_overscroll_(true),
-      allow_vertical_overscroll_(true) {
+      allow_vertical_overscroll_(true),
+      target_frame_rate_(0),
+      animation_frame_rate_(0) {
   DCHECK(client);
 }
 
@@ -54,6 +60,10 @@ void OverscrollGlow::Reset() {
     edge_effects_[i]->Finish();
 }
 
+void OverscrollGlow::SetTargetFrameRate(int fps) {
+  target_frame_rate_ = std::max(fps, 0);
+}
+
 bool OverscrollGlow::IsActive() const {
   if (!initialized_)
     return false;
@@ -109,6 +119,9 @@ bool OverscrollGlow::OnOverscrolled(base::TimeTicks current_time,
   bool y_overscroll_started =
       !IsApproxZero(overscroll_delta.y()) && IsApproxZero(old_overscroll.y());
 
+  if (target_frame_rate_)
+    animation_frame_rate_ = target_frame_rate_;
+
   velocity = ZeroSmallComponents(velocity);
   if (!velocity.IsZero())
     Absorb(current_time, velocity, x_overscroll_started, y_overscroll_started);
@@ -126,6 +139,15 @@ bool OverscrollGlow::Animate(base::TimeTicks current_time,
 
   UpdateLayerAttachment(parent_layer);
 
+  // Leaving the layers untouched lets the compositor skip the frame.
+  if (animation_frame_rate_ && !last_update_time_.is_null() &&
+      current_time - last_update_time_ <
+          base::TimeDelta::FromSecondsD(1. / animation_frame_rate_ -
+                                        kFrameIntervalSlackSeconds)) {
+    return true;
+  }
+  last_update_time_ = current_time;
+
   for (size_t i = 0; i < EDGE_COUNT; ++i) {
     if (edge_effects_[i]->Update(current_time)) {
       EdgeEffectBase::Edge edge = static_cast<EdgeEffectBase::Edge>(i);
@@ -166,6 +188,8 @@ bool OverscrollGlow::CheckNeedsAnimate() {
     return true;
 
   Detach();
+  animation_frame_rate_ = 0;
+  last_update_time_ = base::TimeTicks();
   return false;
 }
 
@@ -67,6 +67,12 @@ class UI_ANDROID_EXPORT OverscrollGlow {
   // Reset the effect to its inactive state, clearing any active effects.
   void Reset();
 
+  // Sets the rate of the interaction driving the effect, or 0 if unpaced.
+  // An effect pulled or absorbed while paced keeps updating its layers at
+  // that rate until it finishes, so a glow receding after a paced fling does
+  // not bring the compositor back to every vsync.
+  void SetTargetFrameRate(int fps);
+
   // Whether the effect is active, either being pulled or receding.
   bool IsActive() const;
 
@@ -103,6 +109,11 @@ class UI_ANDROID_EXPORT OverscrollGlow {
   bool allow_horizontal_overscroll_;
   bool allow_vertical_overscroll_;
 
+  int target_frame_rate_;
+  // The rate the active effect updates at, or 0 for every frame.
+  int animation_frame_rate_;
+  base::TimeTicks last_update_time_;
+
   scoped_refptr<cc::Layer> root_layer_;
 
   DISALLOW_COPY_AND_ASSIGN(OverscrollGlow);
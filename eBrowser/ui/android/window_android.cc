@@ -4,15 +4,19 @@
 
 #include "ui/android/window_android.h"
 
+#include <algorithm>
+
 #include "base/android/context_utils.h"
 #include "base/android/jni_android.h"
 #include "base/android/jni_array.h"
 #include "base/android/jni_string.h"
 #include "base/android/jni_weak_ref.h"
 #include "base/android/scoped_java_ref.h"
+#include "base/trace_event/trace_event.h"
 #include "jni/WindowAndroid_jni.h"
 #include "ui/android/window_android_compositor.h"
 #include "ui/android/window_android_observer.h"
+#include "ui/display/screen.h"
 
 namespace ui {
 
@@ -21,8 +25,17 @@ using base::android::JavaParamRef;
 using base::android::JavaRef;
 using base::android::ScopedJavaLocalRef;
 
-WindowAndroid::WindowAndroid(JNIEnv* env, jobject obj) : compositor_(NULL) {
+WindowAndroid::WindowAndroid(JNIEnv* env, jobject obj)
+    : compositor_(NULL),
+      vsync_target_frame_rate_(0),
+      skipped_vsyncs_(0),
+      swap_interval_(1) {
   java_window_.Reset(env, obj);
+  display::Screen* screen = display::Screen::GetScreen();
+  if (screen) {
+    display_ = screen->GetPrimaryDisplay();
+    screen->AddObserver(this);
+  }
 }
 
 void WindowAndroid::Destroy(JNIEnv* env, const JavaParamRef<jobject>& obj) {
@@ -40,6 +53,9 @@ bool WindowAndroid::RegisterWindowAndroid(JNIEnv* env) {
 WindowAndroid::~WindowAndroid() {
   DCHECK(parent_ == nullptr) << "WindowAndroid must be a root view.";
   DCHECK(!compositor_);
+  display::Screen* screen = display::Screen::GetScreen();
+  if (screen)
+    screen->RemoveObserver(this);
   Java_WindowAndroid_clearNativePointer(AttachCurrentThread(), GetJavaObject());
 }
 
@@ -73,6 +89,7 @@ void WindowAndroid::AttachCompositor(WindowAndroidCompositor* compositor) {
     DetachCompositor();
 
   compositor_ = compositor;
+  swap_interval_ = 1;
   for (WindowAndroidObserver& observer : observer_list_)
     observer.OnAttachCompositor();
 }
@@ -89,6 +106,58 @@ void WindowAndroid::RequestVSyncUpdate() {
   Java_WindowAndroid_requestVSyncUpdate(env, GetJavaObject());
 }
 
+void WindowAndroid::SetVSyncTargetFrameRate(int fps) {
+  if (fps == vsync_target_frame_rate_)
+    return;
+  TRACE_EVENT_INSTANT1("cc", "WindowAndroid::SetVSyncTargetFrameRate",
+                       TRACE_EVENT_SCOPE_THREAD, "fps", fps);
+  vsync_target_frame_rate_ = fps;
+  skipped_vsyncs_ = 0;
+  // Displays that support a matching mode can then refresh at the lower rate
+  // as well, after which no vsyncs need to be swallowed.
+  Java_WindowAndroid_setPreferredRefreshRate(
+      AttachCurrentThread(), GetJavaObject(), GetPreferredRefreshRate());
+}
+
+float WindowAndroid::GetPreferredRefreshRate() const {
+  if (vsync_target_frame_rate_ <= 0)
+    return 0;
+  // Before M the window can only hint a rate, so it gets the frame rate.
+  if (display_.supported_refresh_rates().empty())
+    return vsync_target_frame_rate_;
+  return display_.GetRefreshRateForFrameRate(vsync_target_frame_rate_);
+}
+
+void WindowAndroid::OnDisplayMetricsChanged(const display::Display& display,
+                                            uint32_t changed_metrics) {
+  if (!(changed_metrics & DISPLAY_METRIC_REFRESH_RATE))
+    return;
+  TRACE_EVENT_INSTANT1("cc", "WindowAndroid::OnDisplayRefreshRateChanged",
+                       TRACE_EVENT_SCOPE_THREAD, "refresh_rate",
+                       display.refresh_rate());
+  bool rates_changed =
+      display.supported_refresh_rates() != display_.supported_refresh_rates();
+  display_ = display;
+  // A new mode set may show the target rate better at another refresh rate.
+  // The decimation follows the vsync period by itself.
+  if (rates_changed && vsync_target_frame_rate_ > 0) {
+    Java_WindowAndroid_setPreferredRefreshRate(
+        AttachCurrentThread(), GetJavaObject(), GetPreferredRefreshRate());
+  }
+  for (WindowAndroidObserver& observer : observer_list_)
+    observer.OnDisplayRefreshRateChanged();
+}
+
+int WindowAndroid::GetVSyncDecimation(base::TimeDelta vsync_period) const {
+  if (vsync_target_frame_rate_ <= 0 || vsync_period <= base::TimeDelta())
+    return 1;
+  // Rounds down, so the browser never ticks slower than the renderer asked
+  // for. The slack keeps 30fps on a 60Hz display at exactly two refreshes.
+  double refreshes_per_frame =
+      1. / (vsync_period.InSecondsF() * vsync_target_frame_rate_);
+  return std::max(1, static_cast<int>(refreshes_per_frame + 0.05));
+}
+
 void WindowAndroid::SetNeedsAnimate() {
   if (compositor_)
     compositor_->SetNeedsAnimate();
@@ -106,6 +175,21 @@ void WindowAndroid::OnVSync(JNIEnv* env,
   base::TimeTicks frame_time(base::TimeTicks::FromInternalValue(time_micros));
   base::TimeDelta vsync_period(
       base::TimeDelta::FromMicroseconds(period_micros));
+  int decimation = GetVSyncDecimation(vsync_period);
+  if (compositor_ && decimation != swap_interval_) {
+    swap_interval_ = decimation;
+    compositor_->SetSwapInterval(decimation);
+  }
+  if (decimation > 1) {
+    if (++skipped_vsyncs_ < decimation) {
+      // Vsync requests are one-shot; keep them coming for whoever is waiting
+      // on the next forwarded one.
+      RequestVSyncUpdate();
+      return;
+    }
+    skipped_vsyncs_ = 0;
+    vsync_period *= decimation;
+  }
   for (WindowAndroidObserver& observer : observer_list_)
     observer.OnVSync(frame_time, vsync_period);
   if (compositor_)
@@ -16,6 +16,8 @@
 #include "base/time/time.h"
 #include "ui/android/ui_android_export.h"
 #include "ui/android/view_android.h"
+#include "ui/display/display.h"
+#include "ui/display/display_observer.h"
 #include "ui/gfx/geometry/vector2d_f.h"
 
 namespace ui {
@@ -25,7 +27,8 @@ class WindowAndroidObserver;
 
 // Android implementation of the activity window.
 // WindowAndroid is also the root of a ViewAndroid tree.
-class UI_ANDROID_EXPORT WindowAndroid : public ViewAndroid {
+class UI_ANDROID_EXPORT WindowAndroid : public ViewAndroid,
+                                         public display::DisplayObserver {
  public:
   WindowAndroid(JNIEnv* env, jobject obj);
 
@@ -57,6 +60,13 @@ class UI_ANDROID_EXPORT WindowAndroid : public ViewAndroid {
   WindowAndroidCompositor* GetCompositor() { return compositor_; }
 
   void RequestVSyncUpdate();
+  // Forwards only every Nth vsync to observers and the compositor, with N the
+  // whole number of display refreshes per frame at |fps|, so that the browser
+  // compositor idles between the frames of a throttled interaction. A
+  // non-positive |fps| forwards every vsync. Also asks the Java window for the
+  // display mode that shows |fps| best, see
+  // display::Display::GetRefreshRateForFrameRate().
+  void SetVSyncTargetFrameRate(int fps);
   void SetNeedsAnimate();
   void Animate(base::TimeTicks begin_frame_time);
   void OnVSync(JNIEnv* env,
@@ -85,10 +95,31 @@ class UI_ANDROID_EXPORT WindowAndroid : public ViewAndroid {
   // ViewAndroid overrides.
   WindowAndroid* GetWindowAndroid() const override;
 
+  // display::DisplayObserver overrides.
+  void OnDisplayMetricsChanged(const display::Display& display,
+                               uint32_t changed_metrics) override;
+
+  // The refresh rate to ask the Java window for at |vsync_target_frame_rate_|,
+  // or 0 for the default.
+  float GetPreferredRefreshRate() const;
+
+  // Number of display refreshes of |vsync_period| per forwarded vsync.
+  int GetVSyncDecimation(base::TimeDelta vsync_period) const;
+
   base::android::ScopedJavaGlobalRef<jobject> java_window_;
   gfx::Vector2dF content_offset_;
   WindowAndroidCompositor* compositor_;
 
+  // The display as last seen, for its refresh rates. Stays default constructed
+  // without a display::Screen, as in tests.
+  display::Display display_;
+
+  int vsync_target_frame_rate_;
+  // Vsyncs swallowed since the last forwarded one.
+  int skipped_vsyncs_;
+  // The decimation last reported to |compositor_|.
+  int swap_interval_;
+
   base::ObserverList<WindowAndroidObserver> observer_list_;
 
   DISALLOW_COPY_AND_ASSIGN(WindowAndroid);
@@ -30,6 +30,9 @@ class UI_ANDROID_EXPORT WindowAndroidCompositor {
   virtual void OnVSync(base::TimeTicks frame_time,
                        base::TimeDelta vsync_period) = 0;
   virtual void SetNeedsAnimate() = 0;
+  // Called when the number of display refreshes per forwarded vsync changes,
+  // so that the display can be paced at the same rate.
+  virtual void SetSwapInterval(int interval) = 0;
   virtual ResourceManager& GetResourceManager() = 0;
   virtual cc::FrameSinkId GetFrameSinkId() = 0;
 };
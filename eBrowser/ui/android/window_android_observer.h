@@ -18,6 +18,8 @@ class UI_ANDROID_EXPORT WindowAndroidObserver {
   virtual void OnVSync(base::TimeTicks frame_time,
                        base::TimeDelta vsync_period) = 0;
   virtual void OnAnimate(base::TimeTicks frame_begin_time) {}
+  // The display's refresh rate or its supported rates changed.
+  virtual void OnDisplayRefreshRateChanged() {}
 
   // Note that activity state callbacks will only be made if the WindowAndroid
   // has been explicitly subscribed to receive them. The observer instance
@@ -17,6 +17,15 @@ bool WindowEventDispatcherTestApi::HoldingPointerMoves() const {
   return dispatcher_->move_hold_count_ > 0;
 }
 
+bool WindowEventDispatcherTestApi::WaitingForFrame() const {
+  return !!dispatcher_->observed_compositor_;
+}
+
+void WindowEventDispatcherTestApi::OnAnimationStep(
+    base::TimeTicks frame_time) {
+  dispatcher_->OnAnimationStep(frame_time);
+}
+
 }  // namespace test
 }  // namespace aura
 
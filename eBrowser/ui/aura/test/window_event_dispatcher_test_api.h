@@ -6,6 +6,7 @@
 #define UI_AURA_TEST_WINDOW_EVENT_DISPATCHER_TEST_API_H_
 
 #include "base/macros.h"
+#include "base/time/time.h"
 
 namespace aura {
 
@@ -19,6 +20,12 @@ class WindowEventDispatcherTestApi {
 
   bool HoldingPointerMoves() const;
 
+  // Whether coalesced moves are waiting for a compositor frame.
+  bool WaitingForFrame() const;
+
+  // Delivers a compositor frame at |frame_time| to the dispatcher.
+  void OnAnimationStep(base::TimeTicks frame_time);
+
  private:
   WindowEventDispatcher* dispatcher_;
 
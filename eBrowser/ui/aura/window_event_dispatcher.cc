@@ -7,7 +7,9 @@
 #include <stddef.h>
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/logging.h"
+#include "base/memory/ptr_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
@@ -24,8 +26,11 @@
 #include "ui/aura/window_tracker.h"
 #include "ui/aura/window_tree_host.h"
 #include "ui/base/hit_test.h"
+#include "ui/compositor/compositor.h"
 #include "ui/compositor/dip_util.h"
+#include "ui/compositor/layer_animator_collection.h"
 #include "ui/events/event.h"
+#include "ui/events/event_switches.h"
 #include "ui/events/event_utils.h"
 #include "ui/events/gestures/gesture_recognizer.h"
 #include "ui/events/gestures/gesture_types.h"
@@ -59,6 +64,24 @@ bool IsEventCandidateForHold(const ui::Event& event) {
   return false;
 }
 
+// Allows for BeginFrame jitter when pacing coalesced moves to a reduced rate.
+const double kFrameIntervalSlackSeconds = 1. / 240.;
+
+bool IsEventCandidateForCoalescing(const ui::Event& event) {
+  if (event.flags() & ui::EF_IS_SYNTHESIZED)
+    return false;
+  return event.type() == ui::ET_MOUSE_MOVED ||
+         event.type() == ui::ET_MOUSE_DRAGGED ||
+         event.type() == ui::ET_TOUCH_MOVED;
+}
+
+// Whether |a| and |b| are moves of the same mouse or touch point.
+bool IsSamePointer(const ui::LocatedEvent& a, const ui::LocatedEvent& b) {
+  if (a.IsTouchEvent() && b.IsTouchEvent())
+    return a.AsTouchEvent()->touch_id() == b.AsTouchEvent()->touch_id();
+  return a.IsMouseEvent() && b.IsMouseEvent();
+}
+
 }  // namespace
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,16 +96,23 @@ WindowEventDispatcher::WindowEventDispatcher(WindowTreeHost* host)
       synthesize_mouse_move_(false),
       move_hold_count_(0),
       dispatching_held_event_(nullptr),
+      coalesce_moves_per_frame_(
+          base::CommandLine::ForCurrentProcess()->HasSwitch(
+              switches::kCoalescePointerMovesPerFrame)),
+      queued_move_event_(nullptr),
+      observed_compositor_(nullptr),
       observer_manager_(this),
       env_controller_(new EnvInputStateController),
       repost_event_factory_(this),
-      held_event_factory_(this) {
+      held_event_factory_(this),
+      coalesced_event_factory_(this) {
   ui::GestureRecognizer::Get()->AddGestureEventHelper(this);
   Env::GetInstance()->AddObserver(this);
 }
 
 WindowEventDispatcher::~WindowEventDispatcher() {
   TRACE_EVENT0("shutdown", "WindowEventDispatcher::Destructor");
+  StopObservingFrames();
   Env::GetInstance()->RemoveObserver(this);
   ui::GestureRecognizer::Get()->RemoveGestureEventHelper(this);
 }
@@ -135,7 +165,10 @@ void WindowEventDispatcher::DispatchCancelModeEvent() {
 void WindowEventDispatcher::DispatchGestureEvent(
     ui::GestureConsumer* raw_input_consumer,
     ui::GestureEvent* event) {
-  DispatchDetails details = DispatchHeldEvents();
+  DispatchDetails details = DispatchCoalescedMoveEvents();
+  if (details.dispatcher_destroyed)
+    return;
+  details = DispatchHeldEvents();
   if (details.dispatcher_destroyed)
     return;
   Window* target = ConsumerToWindow(raw_input_consumer);
@@ -190,6 +223,24 @@ void WindowEventDispatcher::ReleasePointerMoves() {
   TRACE_EVENT_ASYNC_END0("ui", "WindowEventDispatcher::HoldPointerMoves", this);
 }
 
+void WindowEventDispatcher::SetCoalescePointerMovesPerFrame(bool coalesce) {
+  coalesce_moves_per_frame_ = coalesce;
+  if (!coalesce && !coalesced_move_events_.empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
+        FROM_HERE,
+        base::Bind(base::IgnoreResult(
+                       &WindowEventDispatcher::DispatchCoalescedMoveEvents),
+                   coalesced_event_factory_.GetWeakPtr()));
+  }
+}
+
+std::vector<const ui::LocatedEvent*> WindowEventDispatcher::GetCoalescedEvents(
+    const ui::Event& event) const {
+  if (!is_dispatched_held_event(event))
+    return std::vector<const ui::LocatedEvent*>();
+  return dispatching_coalesced_events_;
+}
+
 gfx::Point WindowEventDispatcher::GetLastMouseLocationInRoot() const {
   gfx::Point location = Env::GetInstance()->last_mouse_location();
   client::ScreenPositionClient* client =
@@ -440,6 +491,11 @@ ui::EventDispatchDetails WindowEventDispatcher::PreDispatchEvent(
   CHECK(window()->Contains(target_window));
 
   if (!dispatching_held_event_) {
+    if (!coalesced_move_events_.empty() && !CanCoalesceMoveEvent(*event)) {
+      DispatchDetails details = DispatchCoalescedMoveEvents();
+      if (details.dispatcher_destroyed || details.target_destroyed)
+        return details;
+    }
     bool can_be_held = IsEventCandidateForHold(*event);
     if (!move_hold_count_ || !can_be_held) {
       if (can_be_held)
@@ -469,6 +525,8 @@ ui::EventDispatchDetails WindowEventDispatcher::PreDispatchEvent(
 ui::EventDispatchDetails WindowEventDispatcher::PostDispatchEvent(
     ui::EventTarget* target,
     const ui::Event& event) {
+  bool queued = &event == queued_move_event_;
+  queued_move_event_ = nullptr;
   DispatchDetails details;
   if (!target || target != event_dispatch_target_)
     details.target_destroyed = true;
@@ -478,9 +536,9 @@ ui::EventDispatchDetails WindowEventDispatcher::PostDispatchEvent(
   DCHECK(!event_dispatch_target_ || window()->Contains(event_dispatch_target_));
 #endif
 
-  if (event.IsTouchEvent() && !details.target_destroyed) {
+  if (event.IsTouchEvent() && !details.target_destroyed && !queued) {
     // Do not let 'held' touch events contribute to any gestures unless it is
-    // being dispatched.
+    // being dispatched. Coalesced moves are acked when they are dispatched.
     if (is_dispatched_held_event(event) || !held_move_event_ ||
         !held_move_event_->IsTouchEvent()) {
       const ui::TouchEvent& touchevent = *event.AsTouchEvent();
@@ -593,7 +651,10 @@ void WindowEventDispatcher::OnWindowBoundsChanged(Window* window,
     TRACE_EVENT1("ui", "WindowEventDispatcher::OnWindowBoundsChanged(root)",
                  "size", new_bounds.size().ToString());
 
-    DispatchDetails details = DispatchHeldEvents();
+    DispatchDetails details = DispatchCoalescedMoveEvents();
+    if (details.dispatcher_destroyed)
+      return;
+    details = DispatchHeldEvents();
     if (details.dispatcher_destroyed)
       return;
 
@@ -635,6 +696,38 @@ void WindowEventDispatcher::OnWindowInitialized(Window* window) {
   observer_manager_.Add(window);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// WindowEventDispatcher, ui::CompositorAnimationObserver implementation:
+
+void WindowEventDispatcher::OnAnimationStep(base::TimeTicks timestamp) {
+  if (coalesced_move_events_.empty()) {
+    StopObservingFrames();
+    return;
+  }
+  int fps = observed_compositor_->layer_animator_collection()
+                ->target_frame_rate();
+  if (fps && !last_coalesced_dispatch_time_.is_null() &&
+      timestamp - last_coalesced_dispatch_time_ <
+          base::TimeDelta::FromSecondsD(1. / fps -
+                                        kFrameIntervalSlackSeconds)) {
+    return;
+  }
+  last_coalesced_dispatch_time_ = timestamp;
+  StopObservingFrames();
+  // Like the held events, the moves are not dispatched from within the
+  // compositor's frame.
+  base::ThreadTaskRunnerHandle::Get()->PostNonNestableTask(
+      FROM_HERE,
+      base::Bind(base::IgnoreResult(
+                     &WindowEventDispatcher::DispatchCoalescedMoveEvents),
+                 coalesced_event_factory_.GetWeakPtr()));
+}
+
+void WindowEventDispatcher::OnCompositingShuttingDown(
+    ui::Compositor* compositor) {
+  StopObservingFrames();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // WindowEventDispatcher, private:
 
@@ -677,6 +770,87 @@ ui::EventDispatchDetails WindowEventDispatcher::DispatchHeldEvents() {
   return dispatch_details;
 }
 
+bool WindowEventDispatcher::CanCoalesceMoveEvent(
+    const ui::Event& event) const {
+  if (!coalesce_moves_per_frame_ || move_hold_count_ ||
+      dispatching_held_event_ || !host_->compositor() ||
+      !IsEventCandidateForCoalescing(event)) {
+    return false;
+  }
+  if (coalesced_move_events_.empty())
+    return true;
+  // A mouse move only joins moves with the same buttons and modifiers down.
+  const ui::LocatedEvent& last = *coalesced_move_events_.back();
+  return last.type() == event.type() &&
+         (event.IsTouchEvent() || last.flags() == event.flags());
+}
+
+void WindowEventDispatcher::QueueCoalescedMoveEvent(
+    Window* target,
+    const ui::LocatedEvent& event) {
+  if (event.IsMouseEvent()) {
+    coalesced_move_events_.push_back(base::MakeUnique<ui::MouseEvent>(
+        *event.AsMouseEvent(), target, window()));
+  } else {
+    coalesced_move_events_.push_back(base::MakeUnique<ui::TouchEvent>(
+        *event.AsTouchEvent(), target, window()));
+  }
+  queued_move_event_ = &event;
+  ObserveFrames();
+}
+
+void WindowEventDispatcher::ObserveFrames() {
+  if (observed_compositor_ || !host_->compositor())
+    return;
+  observed_compositor_ = host_->compositor();
+  observed_compositor_->AddAnimationObserver(this);
+}
+
+void WindowEventDispatcher::StopObservingFrames() {
+  if (!observed_compositor_)
+    return;
+  observed_compositor_->RemoveAnimationObserver(this);
+  observed_compositor_ = nullptr;
+}
+
+ui::EventDispatchDetails WindowEventDispatcher::DispatchCoalescedMoveEvents() {
+  if (coalesced_move_events_.empty())
+    return DispatchDetails();
+  // Moves queued before a held event is reposted wait for the next frame
+  // rather than nest inside its dispatch.
+  if (dispatching_held_event_) {
+    ObserveFrames();
+    return DispatchDetails();
+  }
+
+  TRACE_EVENT1("ui", "WindowEventDispatcher::DispatchCoalescedMoveEvents",
+               "count", coalesced_move_events_.size());
+  StopObservingFrames();
+  std::vector<std::unique_ptr<ui::LocatedEvent>> events;
+  events.swap(coalesced_move_events_);
+
+  DispatchDetails dispatch_details;
+  for (size_t i = 0; i < events.size(); ++i) {
+    // Only the last move of each pointer is dispatched, carrying the others.
+    bool superseded = false;
+    for (size_t j = i + 1; j < events.size() && !superseded; ++j)
+      superseded = IsSamePointer(*events[i], *events[j]);
+    if (superseded)
+      continue;
+    for (size_t j = 0; j <= i; ++j) {
+      if (IsSamePointer(*events[i], *events[j]))
+        dispatching_coalesced_events_.push_back(events[j].get());
+    }
+    dispatching_held_event_ = events[i].get();
+    dispatch_details = OnEventFromSource(events[i].get());
+    if (dispatch_details.dispatcher_destroyed)
+      return dispatch_details;
+    dispatching_held_event_ = nullptr;
+    dispatching_coalesced_events_.clear();
+  }
+  return dispatch_details;
+}
+
 void WindowEventDispatcher::PostSynthesizeMouseMove() {
   if (synthesize_mouse_move_)
     return;
@@ -753,7 +927,17 @@ DispatchDetails WindowEventDispatcher::PreDispatchMouseEvent(
     return DispatchDetails();
   }
 
-  env_controller_->UpdateStateForMouseEvent(window(), *event);
+  // A coalesced move updated the state when it was queued.
+  bool dispatching_coalesced_move = !dispatching_coalesced_events_.empty() &&
+                                    is_dispatched_held_event(*event);
+  if (!dispatching_coalesced_move)
+    env_controller_->UpdateStateForMouseEvent(window(), *event);
+
+  if (CanCoalesceMoveEvent(*event)) {
+    QueueCoalescedMoveEvent(target, *event);
+    event->SetHandled();
+    return DispatchDetails();
+  }
 
   if (IsEventCandidateForHold(*event) && !dispatching_held_event_) {
     if (move_hold_count_) {
@@ -849,6 +1033,12 @@ DispatchDetails WindowEventDispatcher::PreDispatchTouchEvent(
     return DispatchDetails();
   }
 
+  if (CanCoalesceMoveEvent(*event)) {
+    QueueCoalescedMoveEvent(target, *event);
+    event->SetHandled();
+    return DispatchDetails();
+  }
+
   env_controller_->UpdateStateForTouchEvent(*event);
 
   ui::TouchEvent orig_event(*event, target, window());
@@ -19,6 +19,7 @@
 #include "ui/aura/env_observer.h"
 #include "ui/aura/window_observer.h"
 #include "ui/base/cursor/cursor.h"
+#include "ui/compositor/compositor_animation_observer.h"
 #include "ui/events/event_constants.h"
 #include "ui/events/event_processor.h"
 #include "ui/events/event_targeter.h"
@@ -33,6 +34,7 @@ class Transform;
 }
 
 namespace ui {
+class Compositor;
 class GestureEvent;
 class GestureRecognizer;
 class KeyEvent;
@@ -55,11 +57,13 @@ class WindowEventDispatcherTestApi;
 // owned by WindowTreeHost. WTH also owns the WED.
 // TODO(beng): In progress, remove functionality not directly related to
 //             event dispatch.
-class AURA_EXPORT WindowEventDispatcher : public ui::EventProcessor,
-                                          public ui::GestureEventHelper,
-                                          public client::CaptureDelegate,
-                                          public WindowObserver,
-                                          public EnvObserver {
+class AURA_EXPORT WindowEventDispatcher
+    : public ui::EventProcessor,
+      public ui::GestureEventHelper,
+      public client::CaptureDelegate,
+      public WindowObserver,
+      public EnvObserver,
+      public ui::CompositorAnimationObserver {
  public:
   explicit WindowEventDispatcher(WindowTreeHost* host);
   ~WindowEventDispatcher() override;
@@ -107,6 +111,20 @@ class AURA_EXPORT WindowEventDispatcher : public ui::EventProcessor,
   void HoldPointerMoves();
   void ReleasePointerMoves();
 
+  // Merges mouse and touch moves that arrive between compositor frames and
+  // dispatches them once per frame: the last mouse move, and the last move
+  // of each touch point. While UI animations are throttled (see
+  // ui::LayerAnimatorCollection::SetTargetFrameRate()), the moves follow the
+  // reduced rate. Any other event dispatches the pending moves first. On by
+  // default with --coalesce-pointer-moves-per-frame.
+  void SetCoalescePointerMovesPerFrame(bool coalesce);
+
+  // When |event| is a coalesced move being dispatched, returns the moves
+  // merged into it, oldest first and ending with the latest, in the
+  // coordinates of this root window. Returns an empty list for other events.
+  std::vector<const ui::LocatedEvent*> GetCoalescedEvents(
+      const ui::Event& event) const;
+
   // Gets the last location seen in a mouse event in this root window's
   // coordinates. This may return a point outside the root window's bounds.
   gfx::Point GetLastMouseLocationInRoot() const;
@@ -213,6 +231,26 @@ class AURA_EXPORT WindowEventDispatcher : public ui::EventProcessor,
   // Overridden from EnvObserver:
   void OnWindowInitialized(Window* window) override;
 
+  // Overridden from ui::CompositorAnimationObserver:
+  void OnAnimationStep(base::TimeTicks timestamp) override;
+  void OnCompositingShuttingDown(ui::Compositor* compositor) override;
+
+  // Returns true if |event| is a move that joins the pending coalesced moves
+  // instead of being dispatched now.
+  bool CanCoalesceMoveEvent(const ui::Event& event) const;
+
+  // Adds |event|, located in |target|, to the moves waiting for the next
+  // frame.
+  void QueueCoalescedMoveEvent(Window* target, const ui::LocatedEvent& event);
+
+  // Starts or stops waiting for frames of the compositor.
+  void ObserveFrames();
+  void StopObservingFrames();
+
+  // Dispatches the pending coalesced moves, see
+  // SetCoalescePointerMovesPerFrame().
+  ui::EventDispatchDetails DispatchCoalescedMoveEvents() WARN_UNUSED_RESULT;
+
   // We hold and aggregate mouse drags and touch moves as a way of throttling
   // resizes when HoldMouseMoves() is called. The following methods are used to
   // dispatch held and newly incoming mouse and touch events, typically when an
@@ -262,6 +300,20 @@ class AURA_EXPORT WindowEventDispatcher : public ui::EventProcessor,
   // Set when dispatching a held event.
   ui::LocatedEvent* dispatching_held_event_;
 
+  bool coalesce_moves_per_frame_;
+  // The moves waiting for the next frame, oldest first. The locations are in
+  // |window_|'s coordinate.
+  std::vector<std::unique_ptr<ui::LocatedEvent>> coalesced_move_events_;
+  // The moves merged into the coalesced move being dispatched.
+  std::vector<const ui::LocatedEvent*> dispatching_coalesced_events_;
+  // The event PreDispatchEvent() just queued, until its PostDispatchEvent().
+  // It never reached the gesture recognizer, so it must not be acked.
+  const ui::Event* queued_move_event_;
+  // The compositor whose next frame the coalesced moves wait for, if any.
+  ui::Compositor* observed_compositor_;
+  // Frame time of the last dispatch of coalesced moves.
+  base::TimeTicks last_coalesced_dispatch_time_;
+
   ScopedObserver<aura::Window, aura::WindowObserver> observer_manager_;
 
   std::unique_ptr<EnvInputStateController> env_controller_;
@@ -272,6 +324,9 @@ class AURA_EXPORT WindowEventDispatcher : public ui::EventProcessor,
   // Used to schedule DispatchHeldEvents() when |move_hold_count_| goes to 0.
   base::WeakPtrFactory<WindowEventDispatcher> held_event_factory_;
 
+  // Used to schedule DispatchCoalescedMoveEvents() after a frame.
+  base::WeakPtrFactory<WindowEventDispatcher> coalesced_event_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(WindowEventDispatcher);
 };
 
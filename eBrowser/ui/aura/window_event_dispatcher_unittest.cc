@@ -24,11 +24,14 @@
 #include "ui/aura/test/env_test_helper.h"
 #include "ui/aura/test/test_cursor_client.h"
 #include "ui/aura/test/test_screen.h"
+#include "ui/aura/test/window_event_dispatcher_test_api.h"
 #include "ui/aura/test/test_window_delegate.h"
 #include "ui/aura/test/test_windows.h"
 #include "ui/aura/window.h"
 #include "ui/aura/window_tracker.h"
 #include "ui/base/hit_test.h"
+#include "ui/compositor/compositor.h"
+#include "ui/compositor/layer_animator_collection.h"
 #include "ui/display/screen.h"
 #include "ui/events/event.h"
 #include "ui/events/event_handler.h"
@@ -617,6 +620,16 @@ std::string EventTypesToString(const EventFilterRecorder::Events& events) {
   return result;
 }
 
+// Like EventTypesToString(), but skips everything that is not a touch event.
+std::string TouchEventTypesToString(const EventFilterRecorder::Events& events) {
+  EventFilterRecorder::Events touch_events;
+  for (ui::EventType type : events) {
+    if (type >= ui::ET_TOUCH_RELEASED && type <= ui::ET_TOUCH_CANCELLED)
+      touch_events.push_back(type);
+  }
+  return EventTypesToString(touch_events);
+}
+
 }  // namespace
 
 #if defined(OS_WIN) && defined(ARCH_CPU_X86)
@@ -832,6 +845,182 @@ TEST_F(WindowEventDispatcherTest, TouchMovesHeld) {
   root_window()->RemovePreTargetHandler(&recorder);
 }
 
+// Records how many moves were coalesced into each dispatched mouse event.
+class CoalescedEventsRecorder : public ui::EventHandler {
+ public:
+  explicit CoalescedEventsRecorder(WindowEventDispatcher* dispatcher)
+      : dispatcher_(dispatcher) {}
+  ~CoalescedEventsRecorder() override {}
+
+  const std::vector<size_t>& counts() const { return counts_; }
+
+  // ui::EventHandler:
+  void OnMouseEvent(ui::MouseEvent* event) override {
+    counts_.push_back(dispatcher_->GetCoalescedEvents(*event).size());
+  }
+
+ private:
+  WindowEventDispatcher* dispatcher_;
+  std::vector<size_t> counts_;
+
+  DISALLOW_COPY_AND_ASSIGN(CoalescedEventsRecorder);
+};
+
+TEST_F(WindowEventDispatcherTest, MouseMovesCoalescedPerFrame) {
+  EventFilterRecorder recorder;
+  root_window()->AddPreTargetHandler(&recorder);
+  CoalescedEventsRecorder coalesced_recorder(host()->dispatcher());
+  root_window()->AddPreTargetHandler(&coalesced_recorder);
+
+  test::TestWindowDelegate delegate;
+  std::unique_ptr<aura::Window> window(CreateTestWindowWithDelegate(
+      &delegate, 1, gfx::Rect(0, 0, 100, 100), root_window()));
+  host()->dispatcher()->SetCoalescePointerMovesPerFrame(true);
+  test::WindowEventDispatcherTestApi test_api(host()->dispatcher());
+
+  // The drags wait for the next frame.
+  ui::MouseEvent mouse_dragged_event(ui::ET_MOUSE_DRAGGED, gfx::Point(0, 0),
+                                     gfx::Point(0, 0), ui::EventTimeForNow(),
+                                     0, 0);
+  ui::MouseEvent mouse_dragged_event2(ui::ET_MOUSE_DRAGGED, gfx::Point(10, 10),
+                                      gfx::Point(10, 10),
+                                      ui::EventTimeForNow(), 0, 0);
+  DispatchEventUsingWindowDispatcher(&mouse_dragged_event);
+  DispatchEventUsingWindowDispatcher(&mouse_dragged_event2);
+  EXPECT_TRUE(recorder.events().empty());
+  EXPECT_TRUE(test_api.WaitingForFrame());
+
+  // The frame posts the dispatch of the last one, carrying both.
+  base::TimeTicks frame_time = base::TimeTicks::Now();
+  test_api.OnAnimationStep(frame_time);
+  EXPECT_FALSE(test_api.WaitingForFrame());
+  EXPECT_TRUE(recorder.events().empty());
+  RunAllPendingInMessageLoop();
+  EXPECT_EQ("MOUSE_DRAGGED", EventTypesToString(recorder.events()));
+  EXPECT_EQ(gfx::Point(10, 10), recorder.mouse_location(0));
+  ASSERT_EQ(1u, coalesced_recorder.counts().size());
+  EXPECT_EQ(2u, coalesced_recorder.counts()[0]);
+  recorder.Reset();
+
+  // Another event dispatches the pending drag before itself.
+  mouse_dragged_event =
+      ui::MouseEvent(ui::ET_MOUSE_DRAGGED, gfx::Point(20, 20),
+                     gfx::Point(20, 20), ui::EventTimeForNow(), 0, 0);
+  DispatchEventUsingWindowDispatcher(&mouse_dragged_event);
+  ui::MouseEvent mouse_pressed_event(ui::ET_MOUSE_PRESSED, gfx::Point(20, 20),
+                                     gfx::Point(20, 20), ui::EventTimeForNow(),
+                                     0, 0);
+  DispatchEventUsingWindowDispatcher(&mouse_pressed_event);
+  EXPECT_EQ("MOUSE_DRAGGED MOUSE_PRESSED",
+            EventTypesToString(recorder.events()));
+  EXPECT_FALSE(test_api.WaitingForFrame());
+  recorder.Reset();
+
+  // While UI animations are throttled, frames in between are skipped.
+  ui::LayerAnimatorCollection* collection =
+      host()->compositor()->layer_animator_collection();
+  collection->SetTargetFrameRate(30);
+  mouse_dragged_event =
+      ui::MouseEvent(ui::ET_MOUSE_DRAGGED, gfx::Point(30, 30),
+                     gfx::Point(30, 30), ui::EventTimeForNow(), 0, 0);
+  DispatchEventUsingWindowDispatcher(&mouse_dragged_event);
+  test_api.OnAnimationStep(frame_time +
+                           base::TimeDelta::FromMilliseconds(16));
+  EXPECT_TRUE(test_api.WaitingForFrame());
+  test_api.OnAnimationStep(frame_time +
+                           base::TimeDelta::FromMilliseconds(33));
+  EXPECT_FALSE(test_api.WaitingForFrame());
+  RunAllPendingInMessageLoop();
+  EXPECT_EQ("MOUSE_DRAGGED", EventTypesToString(recorder.events()));
+  collection->SetTargetFrameRate(0);
+
+  root_window()->RemovePreTargetHandler(&coalesced_recorder);
+  root_window()->RemovePreTargetHandler(&recorder);
+}
+
+// Tests that touch moves are coalesced per pointer, and that a press or release
+// of another pointer dispatches the pending moves first, so that the gesture
+// recognizer sees every touch in order and is acked once per dispatched move.
+TEST_F(WindowEventDispatcherTest, TouchMovesCoalescedPerFrame) {
+  EventFilterRecorder recorder;
+  root_window()->AddPreTargetHandler(&recorder);
+
+  test::TestWindowDelegate delegate;
+  std::unique_ptr<aura::Window> window(CreateTestWindowWithDelegate(
+      &delegate, 1, gfx::Rect(0, 0, 100, 100), root_window()));
+  host()->dispatcher()->SetCoalescePointerMovesPerFrame(true);
+  test::WindowEventDispatcherTestApi test_api(host()->dispatcher());
+
+  ui::TouchEvent press0(ui::ET_TOUCH_PRESSED, gfx::Point(10, 10), 0,
+                        ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&press0);
+  EXPECT_EQ("TOUCH_PRESSED", TouchEventTypesToString(recorder.events()));
+  recorder.Reset();
+
+  // The moves of the first touch wait for the next frame, until the second
+  // touch is pressed.
+  ui::TouchEvent move0(ui::ET_TOUCH_MOVED, gfx::Point(11, 10), 0,
+                       ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&move0);
+  move0 = ui::TouchEvent(ui::ET_TOUCH_MOVED, gfx::Point(12, 10), 0,
+                         ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&move0);
+  EXPECT_TRUE(recorder.events().empty());
+  EXPECT_TRUE(test_api.WaitingForFrame());
+  ui::TouchEvent press1(ui::ET_TOUCH_PRESSED, gfx::Point(50, 50), 1,
+                        ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&press1);
+  EXPECT_EQ("TOUCH_MOVED TOUCH_PRESSED",
+            TouchEventTypesToString(recorder.events()));
+  ASSERT_EQ(2u, recorder.touch_locations().size());
+  EXPECT_EQ(gfx::Point(12, 10), recorder.touch_locations()[0]);
+  EXPECT_EQ(gfx::Point(50, 50), recorder.touch_locations()[1]);
+  EXPECT_FALSE(test_api.WaitingForFrame());
+  recorder.Reset();
+
+  // The frame dispatches the last move of each touch.
+  move0 = ui::TouchEvent(ui::ET_TOUCH_MOVED, gfx::Point(13, 10), 0,
+                         ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&move0);
+  ui::TouchEvent move1(ui::ET_TOUCH_MOVED, gfx::Point(51, 50), 1,
+                       ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&move1);
+  move0 = ui::TouchEvent(ui::ET_TOUCH_MOVED, gfx::Point(14, 10), 0,
+                         ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&move0);
+  move1 = ui::TouchEvent(ui::ET_TOUCH_MOVED, gfx::Point(52, 50), 1,
+                         ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&move1);
+  EXPECT_TRUE(recorder.events().empty());
+  test_api.OnAnimationStep(base::TimeTicks::Now());
+  RunAllPendingInMessageLoop();
+  EXPECT_EQ("TOUCH_MOVED TOUCH_MOVED",
+            TouchEventTypesToString(recorder.events()));
+  ASSERT_EQ(2u, recorder.touch_locations().size());
+  EXPECT_EQ(gfx::Point(14, 10), recorder.touch_locations()[0]);
+  EXPECT_EQ(gfx::Point(52, 50), recorder.touch_locations()[1]);
+  recorder.Reset();
+
+  // Releasing the second touch dispatches its pending move first.
+  move1 = ui::TouchEvent(ui::ET_TOUCH_MOVED, gfx::Point(53, 50), 1,
+                         ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&move1);
+  ui::TouchEvent release1(ui::ET_TOUCH_RELEASED, gfx::Point(53, 50), 1,
+                          ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&release1);
+  EXPECT_EQ("TOUCH_MOVED TOUCH_RELEASED",
+            TouchEventTypesToString(recorder.events()));
+  EXPECT_FALSE(test_api.WaitingForFrame());
+  recorder.Reset();
+
+  ui::TouchEvent release0(ui::ET_TOUCH_RELEASED, gfx::Point(14, 10), 0,
+                          ui::EventTimeForNow());
+  DispatchEventUsingWindowDispatcher(&release0);
+  EXPECT_EQ("TOUCH_RELEASED", TouchEventTypesToString(recorder.events()));
+
+  root_window()->RemovePreTargetHandler(&recorder);
+}
+
 // Tests that mouse move event has a right location
 // when there isn't the target window
 TEST_F(WindowEventDispatcherTest, MouseEventWithoutTargetWindow) {
@@ -4,21 +4,30 @@
 
 #include "ui/aura/window_targeter.h"
 
+#include <algorithm>
+
+#include "base/auto_reset.h"
 #include "ui/aura/client/capture_client.h"
 #include "ui/aura/client/event_client.h"
 #include "ui/aura/client/focus_client.h"
 #include "ui/aura/window.h"
 #include "ui/aura/window_delegate.h"
 #include "ui/aura/window_event_dispatcher.h"
+#include "ui/aura/window_targeting_index.h"
 #include "ui/aura/window_tree_host.h"
 #include "ui/events/event_target.h"
 #include "ui/events/event_target_iterator.h"
 
 namespace aura {
 
-WindowTargeter::WindowTargeter() {}
+WindowTargeter::WindowTargeter()
+    : spatial_index_enabled_(false), spatial_index_candidates_(nullptr) {}
 WindowTargeter::~WindowTargeter() {}
 
+void WindowTargeter::EnableSpatialIndex() {
+  spatial_index_enabled_ = true;
+}
+
 Window* WindowTargeter::FindTargetForLocatedEvent(Window* window,
                                                   ui::LocatedEvent* event) {
   if (!window->parent()) {
@@ -27,6 +36,14 @@ Window* WindowTargeter::FindTargetForLocatedEvent(Window* window,
       window->ConvertEventToTarget(target, event);
       return target;
     }
+    if (spatial_index_enabled_) {
+      if (!spatial_index_ || spatial_index_->root() != window)
+        spatial_index_.reset(new WindowTargetingIndex(window));
+      base::AutoReset<const std::vector<const Window*>*> candidates(
+          &spatial_index_candidates_,
+          spatial_index_->GetCandidatesAt(event->location()));
+      return FindTargetForLocatedEventRecursively(window, event);
+    }
   }
   return FindTargetForLocatedEventRecursively(window, event);
 }
@@ -178,8 +195,16 @@ Window* WindowTargeter::FindTargetForLocatedEventRecursively(
          child = iter->GetNextTarget()) {
       WindowTargeter* targeter =
           static_cast<WindowTargeter*>(child->GetEventTargeter());
-      if (!targeter)
+      if (!targeter) {
         targeter = this;
+        // The index ruled out that the event is inside |child|.
+        if (spatial_index_candidates_ &&
+            !std::binary_search(spatial_index_candidates_->begin(),
+                                spatial_index_candidates_->end(),
+                                static_cast<Window*>(child))) {
+          continue;
+        }
+      }
       if (!targeter->SubtreeShouldBeExploredForEvent(
               static_cast<Window*>(child), *event)) {
         continue;
@@ -5,6 +5,9 @@
 #ifndef UI_AURA_WINDOW_TARGETER_H_
 #define UI_AURA_WINDOW_TARGETER_H_
 
+#include <memory>
+#include <vector>
+
 #include "base/macros.h"
 #include "ui/aura/aura_export.h"
 #include "ui/events/event_targeter.h"
@@ -17,12 +20,20 @@ class LocatedEvent;
 namespace aura {
 
 class Window;
+class WindowTargetingIndex;
 
 class AURA_EXPORT WindowTargeter : public ui::EventTargeter {
  public:
   WindowTargeter();
   ~WindowTargeter() override;
 
+  // Makes the targeter keep a WindowTargetingIndex of the root window it is
+  // installed on, and skip the children without a targeter of their own
+  // whose bounds the index rules out. Only for targeters that keep the
+  // default EventLocationInsideBounds() and
+  // SubtreeShouldBeExploredForEvent().
+  void EnableSpatialIndex();
+
   // Returns true if |window| or one of its descendants can be a target of
   // |event|. This requires that |window| and its descendants are not
   // prohibited from accepting the event, and that the event is within an
@@ -68,6 +79,12 @@ class AURA_EXPORT WindowTargeter : public ui::EventTargeter {
   Window* FindTargetForLocatedEventRecursively(Window* root_window,
                                                ui::LocatedEvent* event);
 
+  bool spatial_index_enabled_;
+  std::unique_ptr<WindowTargetingIndex> spatial_index_;
+  // While looking for the target of an event in the root window, the windows
+  // |spatial_index_| found at its location.
+  const std::vector<const Window*>* spatial_index_candidates_;
+
   DISALLOW_COPY_AND_ASSIGN(WindowTargeter);
 };
 
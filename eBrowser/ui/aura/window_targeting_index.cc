@@ -0,0 +1,147 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/aura/window_targeting_index.h"
+
+#include <algorithm>
+
+#include "ui/aura/window.h"
+#include "ui/compositor/compositor.h"
+#include "ui/compositor/layer.h"
+#include "ui/compositor/layer_animator_collection.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/rect_conversions.h"
+#include "ui/gfx/geometry/rect_f.h"
+#include "ui/gfx/transform.h"
+
+namespace aura {
+
+WindowTargetingIndex::WindowTargetingIndex(Window* root)
+    : root_(root), observer_(this), dirty_(true), usable_(false) {
+  DCHECK(!root->parent());
+  ObserveSubtree(root);
+}
+
+WindowTargetingIndex::~WindowTargetingIndex() {}
+
+const std::vector<const Window*>* WindowTargetingIndex::GetCandidatesAt(
+    const gfx::Point& point_in_root) {
+  // Targeting follows the layers' current bounds, which the grid does not
+  // track while they animate.
+  ui::Compositor* compositor = root_->layer()->GetCompositor();
+  if (compositor &&
+      compositor->layer_animator_collection()->HasActiveAnimators()) {
+    return nullptr;
+  }
+
+  if (dirty_)
+    Rebuild();
+  if (!usable_ || !grid_bounds_.Contains(point_in_root))
+    return nullptr;
+  int column = (point_in_root.x() - grid_bounds_.x()) * kGridSize /
+               grid_bounds_.width();
+  int row = (point_in_root.y() - grid_bounds_.y()) * kGridSize /
+            grid_bounds_.height();
+  return &cells_[row * kGridSize + column];
+}
+
+void WindowTargetingIndex::ObserveSubtree(Window* window) {
+  if (!observer_.IsObserving(window))
+    observer_.Add(window);
+  for (Window* child : window->children())
+    ObserveSubtree(child);
+}
+
+void WindowTargetingIndex::UnobserveSubtree(Window* window) {
+  if (observer_.IsObserving(window))
+    observer_.Remove(window);
+  for (Window* child : window->children())
+    UnobserveSubtree(child);
+}
+
+void WindowTargetingIndex::Rebuild() {
+  dirty_ = false;
+  cells_.assign(kGridSize * kGridSize, std::vector<const Window*>());
+  grid_bounds_ = gfx::Rect(root_->bounds().size());
+  usable_ = !grid_bounds_.IsEmpty() && root_->layer();
+
+  std::vector<const Window*> pending(root_->children().begin(),
+                                     root_->children().end());
+  while (usable_ && !pending.empty()) {
+    const Window* window = pending.back();
+    pending.pop_back();
+    AddToCells(window);
+    pending.insert(pending.end(), window->children().begin(),
+                   window->children().end());
+  }
+  for (auto& cell : cells_)
+    std::sort(cell.begin(), cell.end());
+}
+
+void WindowTargetingIndex::AddToCells(const Window* window) {
+  if (!window->layer()) {
+    usable_ = false;
+    return;
+  }
+  // The same conversion WindowTargeter::EventLocationInsideBounds() makes,
+  // applied to the window's bounds instead of the event.
+  gfx::Transform transform;
+  if (!window->layer()->GetTargetTransformRelativeTo(root_->layer(),
+                                                     &transform)) {
+    usable_ = false;
+    return;
+  }
+  gfx::Rect bounds = grid_bounds_;
+  if (!transform.HasPerspective()) {
+    gfx::RectF bounds_f(gfx::SizeF(window->bounds().size()));
+    transform.TransformRect(&bounds_f);
+    bounds = gfx::ToEnclosingRect(bounds_f);
+    // The event's location is floored at each level on its way down.
+    bounds.Inset(-2, -2);
+    bounds.Intersect(grid_bounds_);
+    if (bounds.IsEmpty())
+      return;
+  }
+
+  int first_column =
+      (bounds.x() - grid_bounds_.x()) * kGridSize / grid_bounds_.width();
+  int last_column = (bounds.right() - 1 - grid_bounds_.x()) * kGridSize /
+                    grid_bounds_.width();
+  int first_row =
+      (bounds.y() - grid_bounds_.y()) * kGridSize / grid_bounds_.height();
+  int last_row = (bounds.bottom() - 1 - grid_bounds_.y()) * kGridSize /
+                 grid_bounds_.height();
+  for (int row = first_row; row <= last_row; ++row) {
+    for (int column = first_column; column <= last_column; ++column)
+      cells_[row * kGridSize + column].push_back(window);
+  }
+}
+
+void WindowTargetingIndex::OnWindowAdded(Window* new_window) {
+  ObserveSubtree(new_window);
+  dirty_ = true;
+}
+
+void WindowTargetingIndex::OnWillRemoveWindow(Window* window) {
+  UnobserveSubtree(window);
+  dirty_ = true;
+}
+
+void WindowTargetingIndex::OnWindowBoundsChanged(Window* window,
+                                                 const gfx::Rect& old_bounds,
+                                                 const gfx::Rect& new_bounds) {
+  dirty_ = true;
+}
+
+void WindowTargetingIndex::OnWindowTransformed(Window* window) {
+  dirty_ = true;
+}
+
+void WindowTargetingIndex::OnWindowDestroying(Window* window) {
+  if (observer_.IsObserving(window))
+    observer_.Remove(window);
+  dirty_ = true;
+}
+
+}  // namespace aura
@@ -0,0 +1,76 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_AURA_WINDOW_TARGETING_INDEX_H_
+#define UI_AURA_WINDOW_TARGETING_INDEX_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/scoped_observer.h"
+#include "ui/aura/aura_export.h"
+#include "ui/aura/window_observer.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace gfx {
+class Point;
+}
+
+namespace aura {
+
+class Window;
+
+// A uniform grid over a root window that records, for each cell, the windows
+// whose bounds in root coordinates overlap it. WindowTargeter uses it to skip
+// the windows an event cannot be inside of without converting the event into
+// each of them. The grid is rebuilt lazily after the bounds, transform or
+// children of any window in the tree change.
+class AURA_EXPORT WindowTargetingIndex : public WindowObserver {
+ public:
+  // Cells along each axis of the root window.
+  static const int kGridSize = 16;
+
+  explicit WindowTargetingIndex(Window* root);
+  ~WindowTargetingIndex() override;
+
+  Window* root() const { return root_; }
+
+  // Returns the windows whose bounds may contain |point_in_root|, sorted by
+  // address. Returns null if the index cannot rule out any window there:
+  // outside the root's bounds, while layers animate, or when a window has
+  // no layer.
+  const std::vector<const Window*>* GetCandidatesAt(
+      const gfx::Point& point_in_root);
+
+ private:
+  void ObserveSubtree(Window* window);
+  void UnobserveSubtree(Window* window);
+
+  void Rebuild();
+  void AddToCells(const Window* window);
+
+  // WindowObserver:
+  void OnWindowAdded(Window* new_window) override;
+  void OnWillRemoveWindow(Window* window) override;
+  void OnWindowBoundsChanged(Window* window,
+                             const gfx::Rect& old_bounds,
+                             const gfx::Rect& new_bounds) override;
+  void OnWindowTransformed(Window* window) override;
+  void OnWindowDestroying(Window* window) override;
+
+  Window* const root_;
+  ScopedObserver<Window, WindowObserver> observer_;
+
+  bool dirty_;
+  // False if a window in the tree could not be placed in the grid.
+  bool usable_;
+  gfx::Rect grid_bounds_;
+  std::vector<std::vector<const Window*>> cells_;
+
+  DISALLOW_COPY_AND_ASSIGN(WindowTargetingIndex);
+};
+
+}  // namespace aura
+
+#endif  // UI_AURA_WINDOW_TARGETING_INDEX_H_
@@ -0,0 +1,113 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/aura/window_targeting_index.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base/memory/ptr_util.h"
+#include "ui/aura/test/aura_test_base.h"
+#include "ui/aura/test/test_window_delegate.h"
+#include "ui/aura/test/test_windows.h"
+#include "ui/aura/window.h"
+#include "ui/events/event.h"
+#include "ui/events/event_targeter.h"
+#include "ui/events/event_utils.h"
+#include "ui/gfx/transform.h"
+
+namespace aura {
+
+namespace {
+
+bool IsCandidate(WindowTargetingIndex* index,
+                 const gfx::Point& point,
+                 const Window* window) {
+  const std::vector<const Window*>* candidates =
+      index->GetCandidatesAt(point);
+  return !candidates ||
+         std::binary_search(candidates->begin(), candidates->end(), window);
+}
+
+}  // namespace
+
+using WindowTargetingIndexTest = test::AuraTestBase;
+
+TEST_F(WindowTargetingIndexTest, Candidates) {
+  WindowTargetingIndex index(root_window());
+  std::unique_ptr<Window> left(
+      test::CreateTestWindowWithBounds(gfx::Rect(0, 0, 100, 100),
+                                       root_window()));
+  std::unique_ptr<Window> right(
+      test::CreateTestWindowWithBounds(gfx::Rect(400, 0, 100, 100),
+                                       root_window()));
+  Window* child =
+      test::CreateTestWindowWithBounds(gfx::Rect(10, 10, 20, 20), right.get());
+
+  gfx::Point point(50, 50);
+  ASSERT_TRUE(index.GetCandidatesAt(point));
+  EXPECT_TRUE(IsCandidate(&index, point, left.get()));
+  EXPECT_FALSE(IsCandidate(&index, point, right.get()));
+  EXPECT_FALSE(IsCandidate(&index, point, child));
+  EXPECT_TRUE(IsCandidate(&index, gfx::Point(415, 15), child));
+
+  // Moves, transforms and new windows are picked up.
+  right->SetBounds(gfx::Rect(40, 40, 100, 100));
+  EXPECT_TRUE(IsCandidate(&index, point, right.get()));
+  left->SetBounds(gfx::Rect(0, 0, 20, 20));
+  EXPECT_FALSE(IsCandidate(&index, point, left.get()));
+  gfx::Transform scale;
+  scale.Scale(4, 4);
+  left->SetTransform(scale);
+  EXPECT_TRUE(IsCandidate(&index, point, left.get()));
+  std::unique_ptr<Window> added(
+      test::CreateTestWindowWithBounds(gfx::Rect(600, 400, 50, 50),
+                                       root_window()));
+  EXPECT_TRUE(IsCandidate(&index, gfx::Point(620, 420), added.get()));
+  EXPECT_FALSE(IsCandidate(&index, point, added.get()));
+
+  // Outside the root window, nothing is ruled out.
+  EXPECT_FALSE(index.GetCandidatesAt(gfx::Point(-10, 50)));
+}
+
+TEST_F(WindowTargetingIndexTest, TargetsMatchWalk) {
+  test::TestWindowDelegate delegate;
+  std::vector<std::unique_ptr<Window>> windows;
+  for (int i = 0; i < 20; ++i) {
+    windows.push_back(base::WrapUnique(test::CreateTestWindowWithDelegate(
+        &delegate, i, gfx::Rect(i * 30, i * 20, 100, 100), root_window())));
+    test::CreateTestWindowWithDelegate(&delegate, 100 + i,
+                                       gfx::Rect(10, 10, 30, 30),
+                                       windows.back().get());
+  }
+  root_window()->Show();
+
+  ui::EventTarget* root = root_window();
+  ui::EventTargeter* targeter = root->GetEventTargeter();
+  for (int x = 0; x < 700; x += 7) {
+    for (int y = 0; y < 500; y += 11) {
+      gfx::Point location(x, y);
+      ui::MouseEvent mouse(ui::ET_MOUSE_MOVED, location, location,
+                           ui::EventTimeForNow(), ui::EF_NONE, ui::EF_NONE);
+      ui::EventTarget* target = targeter->FindTargetForEvent(root, &mouse);
+
+      // The topmost window containing the location, or its child.
+      Window* expected = root_window();
+      for (auto it = windows.rbegin(); it != windows.rend(); ++it) {
+        if (!(*it)->bounds().Contains(location))
+          continue;
+        expected = it->get();
+        Window* child = expected->children()[0];
+        gfx::Point in_window = location - expected->bounds().OffsetFromOrigin();
+        if (child->bounds().Contains(in_window))
+          expected = child;
+        break;
+      }
+      EXPECT_EQ(expected, target) << location.ToString();
+    }
+  }
+}
+
+}  // namespace aura
@@ -4,6 +4,8 @@
 
 #include "ui/aura/window_tree_host.h"
 
+#include <utility>
+
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "ui/aura/client/capture_client.h"
@@ -254,8 +256,9 @@ void WindowTreeHost::CreateCompositor() {
     window()->Init(ui::LAYER_NOT_DRAWN);
     window()->set_host(this);
     window()->SetName("RootWindow");
-    window()->SetEventTargeter(
-        std::unique_ptr<ui::EventTargeter>(new WindowTargeter()));
+    std::unique_ptr<WindowTargeter> targeter(new WindowTargeter());
+    targeter->EnableSpatialIndex();
+    window()->SetEventTargeter(std::move(targeter));
     dispatcher_.reset(new WindowEventDispatcher(this));
   }
 }
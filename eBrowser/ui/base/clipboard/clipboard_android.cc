@@ -44,18 +44,42 @@ const char kBitmapFormat[] = "bitmap";
 const char kWebKitSmartPasteFormat[] = "webkit_smart";
 const char kBookmarkFormat[] = "bookmark";
 
+// Bitmaps at most this large keep their packed kBitmapFormat form once it has
+// been read. Larger ones are packed again on every read rather than holding
+// their pixels twice.
+const size_t kMaxCachedPackedBitmapBytes = 1024 * 1024;
+
+// Packs |bitmap| into the kBitmapFormat form: its gfx::Size followed by its
+// N32 pixels.
+std::string PackBitmap(const SkBitmap& bitmap) {
+  gfx::Size size(bitmap.width(), bitmap.height());
+
+  std::string packed(reinterpret_cast<const char*>(&size), sizeof(size));
+  SkAutoLockPixels bitmap_lock(bitmap);
+  packed.append(static_cast<const char*>(bitmap.getPixels()),
+                bitmap.getSize());
+  return packed;
+}
+
 class ClipboardMap {
  public:
   ClipboardMap();
   std::string Get(const std::string& format);
   bool HasFormat(const std::string& format);
   void Set(const std::string& format, const std::string& data);
+  // Stores |bitmap|, which must be immutable and N32, without packing it.
+  void SetBitmap(const SkBitmap& bitmap);
+  // Returns the stored bitmap, or a null bitmap if there is none.
+  SkBitmap GetBitmap();
   void CommitToAndroidClipboard();
   void Clear();
 
  private:
   void UpdateFromAndroidClipboard();
   std::map<std::string, std::string> map_;
+  // The last written bitmap. It is packed into the kBitmapFormat entry of
+  // |map_| only when that format is read.
+  SkBitmap bitmap_;
   base::Lock lock_;
 
   // Java class and methods for the Android ClipboardManager.
@@ -73,18 +97,44 @@ std::string ClipboardMap::Get(const std::string& format) {
   base::AutoLock lock(lock_);
   UpdateFromAndroidClipboard();
   std::map<std::string, std::string>::const_iterator it = map_.find(format);
-  return it == map_.end() ? std::string() : it->second;
+  if (it != map_.end())
+    return it->second;
+  if (format != kBitmapFormat || bitmap_.isNull())
+    return std::string();
+
+  std::string packed = PackBitmap(bitmap_);
+  if (packed.size() <= kMaxCachedPackedBitmapBytes)
+    map_[kBitmapFormat] = packed;
+  return packed;
 }
 
 bool ClipboardMap::HasFormat(const std::string& format) {
   base::AutoLock lock(lock_);
   UpdateFromAndroidClipboard();
+  if (format == kBitmapFormat && !bitmap_.isNull())
+    return true;
   return base::ContainsKey(map_, format);
 }
 
 void ClipboardMap::Set(const std::string& format, const std::string& data) {
   base::AutoLock lock(lock_);
   map_[format] = data;
+  if (format == kBitmapFormat)
+    bitmap_.reset();
+}
+
+void ClipboardMap::SetBitmap(const SkBitmap& bitmap) {
+  DCHECK(bitmap.isImmutable());
+  DCHECK_EQ(kN32_SkColorType, bitmap.colorType());
+  base::AutoLock lock(lock_);
+  map_.erase(kBitmapFormat);
+  bitmap_ = bitmap;
+}
+
+SkBitmap ClipboardMap::GetBitmap() {
+  base::AutoLock lock(lock_);
+  UpdateFromAndroidClipboard();
+  return bitmap_;
 }
 
 void ClipboardMap::CommitToAndroidClipboard() {
@@ -118,6 +168,7 @@ void ClipboardMap::Clear() {
   JNIEnv* env = AttachCurrentThread();
   base::AutoLock lock(lock_);
   map_.clear();
+  bitmap_.reset();
   Java_Clipboard_clear(env, clipboard_manager_);
 }
 
@@ -161,8 +212,10 @@ void ClipboardMap::UpdateFromAndroidClipboard() {
   AddMapEntry(env, &android_clipboard_state, kPlainTextFormat, jtext);
   AddMapEntry(env, &android_clipboard_state, kHTMLFormat, jhtml);
 
-  if (!MapIsSubset(android_clipboard_state, map_))
+  if (!MapIsSubset(android_clipboard_state, map_)) {
     android_clipboard_state.swap(map_);
+    bitmap_.reset();
+  }
 }
 
 }  // namespace
@@ -364,6 +417,11 @@ void ClipboardAndroid::ReadRTF(ClipboardType type, std::string* result) const {
 SkBitmap ClipboardAndroid::ReadImage(ClipboardType type) const {
   DCHECK(CalledOnValidThread());
   DCHECK_EQ(type, CLIPBOARD_TYPE_COPY_PASTE);
+  SkBitmap bitmap = g_map.Get().GetBitmap();
+  if (!bitmap.isNull())
+    return bitmap;
+
+  // The bitmap was written as data in the packed format.
   std::string input = g_map.Get().Get(kBitmapFormat);
 
   SkBitmap bmp;
@@ -447,15 +505,18 @@ void ClipboardAndroid::WriteWebSmartPaste() {
 // Note: we implement this to pass all unit tests but it is currently unclear
 // how some code would consume this.
 void ClipboardAndroid::WriteBitmap(const SkBitmap& bitmap) {
-  gfx::Size size(bitmap.width(), bitmap.height());
-
-  std::string packed(reinterpret_cast<const char*>(&size), sizeof(size));
-  {
-    SkAutoLockPixels bitmap_lock(bitmap);
-    packed += std::string(static_cast<const char*>(bitmap.getPixels()),
-                          bitmap.getSize());
+  // Immutable N32 pixels are shared rather than copied. Other bitmaps are
+  // copied once, since their owner may still draw into them. Either way the
+  // packed string form is only built if someone reads it.
+  if (bitmap.isImmutable() && bitmap.colorType() == kN32_SkColorType) {
+    g_map.Get().SetBitmap(bitmap);
+    return;
   }
-  g_map.Get().Set(kBitmapFormat, packed);
+  SkBitmap copy;
+  if (!bitmap.copyTo(&copy, kN32_SkColorType))
+    return;
+  copy.setImmutable();
+  g_map.Get().SetBitmap(copy);
 }
 
 void ClipboardAndroid::WriteData(const Clipboard::FormatType& format,
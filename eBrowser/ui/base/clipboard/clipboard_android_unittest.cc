@@ -8,7 +8,9 @@
 #include "base/android/jni_android.h"
 #include "base/android/jni_string.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/base/clipboard/scoped_clipboard_writer.h"
+#include "ui/gfx/geometry/size.h"
 
 namespace ui {
 
@@ -85,6 +87,35 @@ TEST_F(ClipboardAndroidTest, InternalClipboardInvalidation) {
   EXPECT_EQ(contents, new_value);
 }
 
+// Test that a written bitmap keeps its pixels when its owner draws into it
+// afterwards, and that the packed format is still produced when read.
+TEST_F(ClipboardAndroidTest, BitmapIsCopiedButPackedOnRead) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(4, 3);
+  bitmap.eraseColor(SK_ColorRED);
+  {
+    ScopedClipboardWriter clipboard_writer(CLIPBOARD_TYPE_COPY_PASTE);
+    clipboard_writer.WriteImage(bitmap);
+  }
+  bitmap.eraseColor(SK_ColorBLUE);
+
+  EXPECT_TRUE(clipboard().IsFormatAvailable(Clipboard::GetBitmapFormatType(),
+                                            CLIPBOARD_TYPE_COPY_PASTE));
+  SkBitmap image = clipboard().ReadImage(CLIPBOARD_TYPE_COPY_PASTE);
+  ASSERT_EQ(4, image.width());
+  ASSERT_EQ(3, image.height());
+  {
+    SkAutoLockPixels image_lock(image);
+    EXPECT_EQ(SK_ColorRED, image.getColor(2, 1));
+  }
+
+  std::string packed;
+  clipboard().ReadData(Clipboard::GetBitmapFormatType(), &packed);
+  ASSERT_EQ(sizeof(gfx::Size) + image.getSize(), packed.size());
+  EXPECT_EQ(gfx::Size(4, 3),
+            *reinterpret_cast<const gfx::Size*>(packed.data()));
+}
+
 }  // namespace ui
 
 #include "ui/base/clipboard/clipboard_test_template.h"
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/big_endian.h"
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
@@ -22,6 +23,7 @@
 #include "base/strings/string_piece.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/synchronization/lock.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "build/build_config.h"
 #include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -37,6 +39,7 @@
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/safe_integer_conversions.h"
+#include "ui/gfx/geometry/size.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_source.h"
@@ -64,6 +67,8 @@ const unsigned char kPngMagic[8] = { 0x89, 'P', 'N', 'G', 13, 10, 26, 10 };
 const size_t kPngChunkMetadataSize = 12;  // length, type, crc32
 const unsigned char kPngScaleChunkType[4] = { 'c', 's', 'C', 'l' };
 const unsigned char kPngDataChunkType[4] = { 'I', 'D', 'A', 'T' };
+const unsigned char kPngHeaderChunkType[4] = { 'I', 'H', 'D', 'R' };
+const size_t kPngHeaderChunkDataSize = 13;
 
 #if !defined(OS_MACOSX)
 const char kPakFileSuffix[] = ".pak";
@@ -103,6 +108,31 @@ base::FilePath GetResourcesPakFilePath(const std::string& pak_name) {
 #endif  // OS_WIN
 }
 
+// Reads the pixel size of the PNG in |buf| from its IHDR chunk, which must be
+// the first chunk, without decoding the image.
+bool ReadPNGSize(const unsigned char* buf, size_t size, gfx::Size* pixel_size) {
+  const size_t header_pos = arraysize(kPngMagic);
+  if (size < header_pos + kPngChunkMetadataSize + kPngHeaderChunkDataSize ||
+      memcmp(buf, kPngMagic, arraysize(kPngMagic)) != 0 ||
+      memcmp(buf + header_pos + sizeof(uint32_t), kPngHeaderChunkType,
+             arraysize(kPngHeaderChunkType)) != 0) {
+    return false;
+  }
+  // The chunk data follows its length and type.
+  const char* data = reinterpret_cast<const char*>(buf + header_pos) +
+                     2 * sizeof(uint32_t);
+  uint32_t width = 0;
+  uint32_t height = 0;
+  base::ReadBigEndian(data, &width);
+  base::ReadBigEndian(data + sizeof(uint32_t), &height);
+  const uint32_t kMaxDimension =
+      static_cast<uint32_t>(std::numeric_limits<int>::max());
+  if (!width || !height || width > kMaxDimension || height > kMaxDimension)
+    return false;
+  pixel_size->SetSize(width, height);
+  return true;
+}
+
 SkBitmap CreateEmptyBitmap() {
   SkBitmap bitmap;
   bitmap.allocN32Pixels(32, 32);
@@ -422,13 +452,21 @@ gfx::Image& ResourceBundle::GetImageNamed(int resource_id) {
 #else
     ui::ScaleFactor scale_factor_to_load = ui::SCALE_FACTOR_100P;
 #endif
-    // TODO(oshima): Consider reading the image size from png IHDR chunk and
-    // skip decoding here and remove #ifdef below.
     // ResourceBundle::GetSharedInstance() is destroyed after the
     // BrowserMainLoop has finished running. |image_skia| is guaranteed to be
     // destroyed before the resource bundle is destroyed.
-    gfx::ImageSkia image_skia(new ResourceBundleImageSource(this, resource_id),
-                              GetScaleForScaleFactor(scale_factor_to_load));
+    gfx::ImageSkia image_skia;
+    gfx::Size size;
+    if (LoadImageSize(resource_id, scale_factor_to_load, &size)) {
+      // The size is known from the PNG header, so no scale is decoded until
+      // it is drawn.
+      image_skia = gfx::ImageSkia(
+          new ResourceBundleImageSource(this, resource_id), size);
+    } else {
+      image_skia = gfx::ImageSkia(
+          new ResourceBundleImageSource(this, resource_id),
+          GetScaleForScaleFactor(scale_factor_to_load));
+    }
     if (image_skia.isNull()) {
       LOG(WARNING) << "Unable to load image with id " << resource_id;
       NOTREACHED();  // Want to assert in debug mode.
@@ -446,10 +484,23 @@ gfx::Image& ResourceBundle::GetImageNamed(int resource_id) {
   if (images_.count(resource_id))
     return images_[resource_id];
 
+  if (!memory_pressure_listener_ && base::ThreadTaskRunnerHandle::IsSet()) {
+    memory_pressure_listener_.reset(new base::MemoryPressureListener(
+        base::Bind(&ResourceBundle::OnMemoryPressure, base::Unretained(this))));
+  }
+
   images_[resource_id] = image;
   return images_[resource_id];
 }
 
+void ResourceBundle::DiscardDecodedImages() {
+  base::AutoLock lock_scope(*images_and_fonts_lock_);
+  for (const auto& image : images_) {
+    if (image.second.HasRepresentation(gfx::Image::kImageRepSkia))
+      image.second.ToImageSkia()->DiscardRepsFromSource();
+  }
+}
+
 base::RefCountedMemory* ResourceBundle::LoadDataResourceBytes(
     int resource_id) const {
   return LoadDataResourceBytesForScale(resource_id, ui::SCALE_FACTOR_NONE);
@@ -852,6 +903,46 @@ bool ResourceBundle::LoadBitmap(int resource_id,
   return false;
 }
 
+bool ResourceBundle::LoadImageSize(int resource_id,
+                                   ScaleFactor scale_factor,
+                                   gfx::Size* size) const {
+  // Mirrors the data pack lookup of LoadBitmap(), except for the test-only
+  // fallback to 1x, which is left to the decoding path.
+  for (size_t i = 0; i < data_packs_.size(); ++i) {
+    ScaleFactor pack_scale_factor = data_packs_[i]->GetScaleFactor();
+    if (pack_scale_factor != ui::SCALE_FACTOR_NONE &&
+        pack_scale_factor != scale_factor) {
+      continue;
+    }
+    scoped_refptr<base::RefCountedMemory> memory(
+        data_packs_[i]->GetStaticMemory(static_cast<uint16_t>(resource_id)));
+    if (!memory.get())
+      continue;
+
+    gfx::Size pixel_size;
+    if (!ReadPNGSize(memory->front(), memory->size(), &pixel_size))
+      return false;
+    // Scale independent images and images GRIT fell back to 1x for are
+    // already sized in DIP.
+    if (pack_scale_factor == ui::SCALE_FACTOR_NONE ||
+        PNGContainsFallbackMarker(memory->front(), memory->size())) {
+      *size = pixel_size;
+      return true;
+    }
+    // Matches the truncation of ImageSkiaRep::GetWidth().
+    float scale = GetScaleForScaleFactor(scale_factor);
+    size->SetSize(static_cast<int>(pixel_size.width() / scale),
+                  static_cast<int>(pixel_size.height() / scale));
+    return true;
+  }
+  return false;
+}
+
+void ResourceBundle::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  DiscardDecodedImages();
+}
+
 gfx::Image& ResourceBundle::GetEmptyImage() {
   base::AutoLock lock(*images_and_fonts_lock_);
 
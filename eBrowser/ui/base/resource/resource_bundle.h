@@ -16,6 +16,7 @@
 #include "base/files/memory_mapped_file.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/scoped_vector.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
@@ -28,6 +29,10 @@
 
 class SkBitmap;
 
+namespace gfx {
+class Size;
+}
+
 namespace base {
 class File;
 class Lock;
@@ -204,6 +209,12 @@ class UI_BASE_EXPORT ResourceBundle {
   // loading code of ResourceBundle.
   gfx::Image& GetNativeImageNamed(int resource_id);
 
+  // Drops the decoded bitmaps of the cached images. Images from the data packs
+  // are decoded again from the memory mapped packs the next time they are
+  // drawn. Called on memory pressure, since most cached images are rarely
+  // shown.
+  void DiscardDecodedImages();
+
   // Loads the raw bytes of a scale independent data resource.
   base::RefCountedMemory* LoadDataResourceBytes(int resource_id) const;
 
@@ -361,6 +372,17 @@ class UI_BASE_EXPORT ResourceBundle {
                   SkBitmap* bitmap,
                   bool* fell_back_to_1x) const;
 
+  // Reads the size in DIP of the PNG image |resource_id| at |scale_factor| from
+  // its header, so that the image can be created without decoding it. Returns
+  // false if the size can only be known by decoding, such as for JPEGs.
+  bool LoadImageSize(int resource_id,
+                     ScaleFactor scale_factor,
+                     gfx::Size* size) const;
+
+  // Discards decoded images when the system is low on memory.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
   // Returns true if missing scaled resources should be visually indicated when
   // drawing the fallback (e.g., by tinting the image).
   static bool ShouldHighlightMissingScaledResources();
@@ -408,6 +430,10 @@ class UI_BASE_EXPORT ResourceBundle {
 
   gfx::Image empty_image_;
 
+  // Created with the first image, once there is a message loop to deliver
+  // memory pressure notifications on.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   // The various font lists used, as a map from a signed size delta from the
   // platform base font size, plus style, to the FontList. Cached to avoid
   // repeated GDI creation/destruction and font derivation.
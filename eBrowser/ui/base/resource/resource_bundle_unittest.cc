@@ -469,14 +469,11 @@ TEST_F(ResourceBundleImageTest, GetImageNamed) {
 
   gfx::ImageSkia* image_skia = resource_bundle->GetImageSkiaNamed(3);
 
-#if defined(OS_CHROMEOS) || defined(OS_WIN)
-  // ChromeOS/Windows load highest scale factor first.
-  EXPECT_EQ(ui::SCALE_FACTOR_200P,
-            GetSupportedScaleFactor(image_skia->image_reps()[0].scale()));
-#else
-  EXPECT_EQ(ui::SCALE_FACTOR_100P,
-            GetSupportedScaleFactor(image_skia->image_reps()[0].scale()));
-#endif
+  // The size is read from the PNG header, and no scale is decoded until it is
+  // requested.
+  EXPECT_EQ(10, image_skia->width());
+  EXPECT_EQ(10, image_skia->height());
+  EXPECT_TRUE(image_skia->image_reps().empty());
 
   // Resource ID 3 exists in both 1x and 2x paks. Image reps should be
   // available for both scale factors in |image_skia|.
@@ -537,6 +534,37 @@ TEST_F(ResourceBundleImageTest, GetImageNamedFallback1x) {
   EXPECT_EQ(20, image_rep.pixel_height());
 }
 
+// Test that decoded image reps can be discarded and are decoded again from the
+// data pack on demand.
+TEST_F(ResourceBundleImageTest, DiscardDecodedImages) {
+  std::vector<ScaleFactor> supported_factors;
+  supported_factors.push_back(SCALE_FACTOR_100P);
+  supported_factors.push_back(SCALE_FACTOR_200P);
+  test::ScopedSetSupportedScaleFactors scoped_supported(supported_factors);
+  base::FilePath data_1x_path = dir_path().AppendASCII("sample_1x.pak");
+  base::FilePath data_2x_path = dir_path().AppendASCII("sample_2x.pak");
+  CreateDataPackWithSingleBitmap(data_1x_path, 10, base::StringPiece());
+  CreateDataPackWithSingleBitmap(data_2x_path, 20, base::StringPiece());
+
+  ResourceBundle* resource_bundle = CreateResourceBundleWithEmptyLocalePak();
+  resource_bundle->AddDataPackFromPath(data_1x_path, SCALE_FACTOR_100P);
+  resource_bundle->AddDataPackFromPath(data_2x_path, SCALE_FACTOR_200P);
+
+  gfx::ImageSkia* image_skia = resource_bundle->GetImageSkiaNamed(3);
+  image_skia->GetRepresentation(2.0f);
+  EXPECT_EQ(1u, image_skia->image_reps().size());
+
+  resource_bundle->DiscardDecodedImages();
+  EXPECT_TRUE(image_skia->image_reps().empty());
+  EXPECT_EQ(10, image_skia->width());
+
+  // The same image is returned, and decodes again when drawn.
+  EXPECT_EQ(image_skia, resource_bundle->GetImageSkiaNamed(3));
+  gfx::ImageSkiaRep image_rep = image_skia->GetRepresentation(2.0f);
+  EXPECT_EQ(20, image_rep.pixel_width());
+  EXPECT_EQ(ui::SCALE_FACTOR_200P, GetSupportedScaleFactor(image_rep.scale()));
+}
+
 #if defined(OS_WIN)
 // Tests GetImageNamed() behaves properly when the size of a scaled image
 // requires rounding as a result of using a non-integer scale factor.
@@ -595,6 +623,8 @@ TEST_F(ResourceBundleImageTest, MAYBE_FallbackToNone) {
   resource_bundle->AddDataPackFromPath(data_default_path, SCALE_FACTOR_NONE);
 
   gfx::ImageSkia* image_skia = resource_bundle->GetImageSkiaNamed(3);
+  EXPECT_EQ(10, image_skia->width());
+  image_skia->GetRepresentation(1.0f);
   EXPECT_EQ(1u, image_skia->image_reps().size());
   EXPECT_TRUE(image_skia->image_reps()[0].unscaled());
   EXPECT_EQ(ui::SCALE_FACTOR_100P,
@@ -372,8 +372,9 @@ void Compositor::SetAuthoritativeVSyncInterval(
 
 void Compositor::SetDisplayVSyncParameters(base::TimeTicks timebase,
                                            base::TimeDelta interval) {
-  context_factory_->SetDisplayVSyncParameters(this, timebase, interval);
   vsync_manager_->UpdateVSyncParameters(timebase, interval);
+  context_factory_->SetDisplayVSyncParameters(
+      this, timebase, vsync_manager_->GetFrameInterval());
 }
 
 void Compositor::SetAcceleratedWidget(gfx::AcceleratedWidget widget) {
@@ -4,8 +4,20 @@
 
 #include "ui/compositor/compositor_vsync_manager.h"
 
+#include <algorithm>
+
+#include "base/trace_event/trace_event.h"
+
 namespace ui {
 
+namespace {
+
+// Tolerance, in vsync intervals, for a target that is a whole number of
+// vsyncs, e.g. 30fps on a display reporting slightly over 60Hz.
+const double kTargetIntervalSlack = 0.05;
+
+}  // namespace
+
 CompositorVSyncManager::CompositorVSyncManager()
     : authoritative_vsync_interval_(base::TimeDelta::FromSeconds(0)) {
 }
@@ -37,6 +49,32 @@ void CompositorVSyncManager::RemoveObserver(Observer* observer) {
   observer_list_.RemoveObserver(observer);
 }
 
+void CompositorVSyncManager::SetTargetInterval(const void* client,
+                                               base::TimeDelta interval) {
+  target_intervals_[client] = interval;
+  TRACE_COUNTER1("ui", "CompositorVSyncManager::FrameIntervalUs",
+                 GetFrameInterval().InMicroseconds());
+}
+
+void CompositorVSyncManager::RemoveTargetInterval(const void* client) {
+  target_intervals_.erase(client);
+  TRACE_COUNTER1("ui", "CompositorVSyncManager::FrameIntervalUs",
+                 GetFrameInterval().InMicroseconds());
+}
+
+base::TimeDelta CompositorVSyncManager::GetFrameInterval() const {
+  if (target_intervals_.empty() || last_interval_ <= base::TimeDelta())
+    return last_interval_;
+  base::TimeDelta fastest = base::TimeDelta::Max();
+  for (const auto& target : target_intervals_)
+    fastest = std::min(fastest, target.second);
+  // Rounds down, so that no client gets fewer frames than it asked for.
+  int vsyncs_per_frame = static_cast<int>(
+      fastest.InSecondsF() / last_interval_.InSecondsF() +
+      kTargetIntervalSlack);
+  return last_interval_ * std::max(1, vsyncs_per_frame);
+}
+
 void CompositorVSyncManager::NotifyObservers(base::TimeTicks timebase,
                                              base::TimeDelta interval) {
   for (auto& observer : observer_list_)
@@ -5,6 +5,8 @@
 #ifndef UI_COMPOSITOR_COMPOSITOR_VSYNC_MANAGER_H_
 #define UI_COMPOSITOR_COMPOSITOR_VSYNC_MANAGER_H_
 
+#include <map>
+
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/observer_list.h"
@@ -45,6 +47,17 @@ class COMPOSITOR_EXPORT CompositorVSyncManager
   void AddObserver(Observer* observer);
   void RemoveObserver(Observer* observer);
 
+  // Sets the frame interval that |client| needs, e.g. the interval of a
+  // throttled renderer or of a video. A zero |interval| means the client needs
+  // every vsync. The compositor produces frames at the slowest multiple of the
+  // vsync interval that is still at least as fast as every client needs.
+  void SetTargetInterval(const void* client, base::TimeDelta interval);
+  void RemoveTargetInterval(const void* client);
+
+  // The interval at which frames should be produced: the vsync interval when
+  // no client has set a target, and a whole multiple of it otherwise.
+  base::TimeDelta GetFrameInterval() const;
+
  private:
   friend class base::RefCounted<CompositorVSyncManager>;
 
@@ -57,6 +70,7 @@ class COMPOSITOR_EXPORT CompositorVSyncManager
   base::TimeTicks last_timebase_;
   base::TimeDelta last_interval_;
   base::TimeDelta authoritative_vsync_interval_;
+  std::map<const void*, base::TimeDelta> target_intervals_;
 
   DISALLOW_COPY_AND_ASSIGN(CompositorVSyncManager);
 };
@@ -0,0 +1,46 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/compositor/compositor_vsync_manager.h"
+
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+
+TEST(CompositorVSyncManagerTest, FrameIntervalMergesTargets) {
+  scoped_refptr<CompositorVSyncManager> manager(new CompositorVSyncManager);
+  base::TimeDelta vsync = base::TimeDelta::FromMicroseconds(16667);
+  manager->UpdateVSyncParameters(base::TimeTicks(), vsync);
+  int renderer = 0;
+  int video = 0;
+
+  // Without targets, frames are produced on every vsync.
+  EXPECT_EQ(vsync, manager->GetFrameInterval());
+
+  // A 30fps target halves the rate, even if it is slightly short of two
+  // vsyncs.
+  manager->SetTargetInterval(&renderer, base::TimeDelta::FromSecondsD(1. / 30));
+  EXPECT_EQ(vsync * 2, manager->GetFrameInterval());
+
+  // A rate that is not a whole divisor rounds up to the next one.
+  manager->SetTargetInterval(&renderer, base::TimeDelta::FromSecondsD(1. / 24));
+  EXPECT_EQ(vsync * 2, manager->GetFrameInterval());
+  manager->SetTargetInterval(&renderer, base::TimeDelta::FromSecondsD(1. / 20));
+  EXPECT_EQ(vsync * 3, manager->GetFrameInterval());
+
+  // The fastest client wins.
+  manager->SetTargetInterval(&video, base::TimeDelta::FromSecondsD(1. / 30));
+  EXPECT_EQ(vsync * 2, manager->GetFrameInterval());
+  manager->SetTargetInterval(&video, base::TimeDelta());
+  EXPECT_EQ(vsync, manager->GetFrameInterval());
+
+  manager->RemoveTargetInterval(&video);
+  EXPECT_EQ(vsync * 3, manager->GetFrameInterval());
+  manager->RemoveTargetInterval(&renderer);
+  EXPECT_EQ(vsync, manager->GetFrameInterval());
+}
+
+}  // namespace ui
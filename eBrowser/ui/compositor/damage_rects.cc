@@ -0,0 +1,62 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/compositor/damage_rects.h"
+
+#include <limits>
+
+#include "cc/base/region.h"
+
+namespace ui {
+
+namespace {
+
+// Regions fragmented into more rects than this are not worth merging pair by
+// pair; their bounds are invalidated instead.
+const size_t kMaxRectsToMerge = 64;
+
+int64_t Area(const gfx::Rect& rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+}  // namespace
+
+const int64_t kSeparateDamageRectCost = 128 * 128;
+const size_t kMaxDamageRects = 8;
+
+std::vector<gfx::Rect> MergeDamageRects(const cc::Region& region) {
+  std::vector<gfx::Rect> rects;
+  for (cc::Region::Iterator iter(region); iter.has_rect(); iter.next())
+    rects.push_back(iter.rect());
+  if (rects.size() > kMaxRectsToMerge)
+    return std::vector<gfx::Rect>(1, region.bounds());
+
+  while (rects.size() > 1) {
+    // Find the pair whose union adds the fewest pixels. Merged rects can
+    // overlap the others, in which case uniting them saves pixels.
+    size_t best_first = 0;
+    size_t best_second = 0;
+    int64_t best_cost = std::numeric_limits<int64_t>::max();
+    for (size_t i = 0; i < rects.size(); ++i) {
+      for (size_t j = i + 1; j < rects.size(); ++j) {
+        int64_t cost = Area(gfx::UnionRects(rects[i], rects[j])) -
+                       Area(rects[i]) - Area(rects[j]);
+        if (cost < best_cost) {
+          best_first = i;
+          best_second = j;
+          best_cost = cost;
+        }
+      }
+    }
+    if (best_cost >= kSeparateDamageRectCost &&
+        rects.size() <= kMaxDamageRects) {
+      break;
+    }
+    rects[best_first].Union(rects[best_second]);
+    rects.erase(rects.begin() + best_second);
+  }
+  return rects;
+}
+
+}  // namespace ui
@@ -0,0 +1,39 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_COMPOSITOR_DAMAGE_RECTS_H_
+#define UI_COMPOSITOR_DAMAGE_RECTS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "ui/compositor/compositor_export.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace cc {
+class Region;
+}
+
+namespace ui {
+
+// Keeping a damage rect separate costs about as much as rastering this many
+// more pixels, so two rects are united when their union adds fewer.
+COMPOSITOR_EXPORT extern const int64_t kSeparateDamageRectCost;
+
+// The most rects a frame's damage is split into.
+COMPOSITOR_EXPORT extern const size_t kMaxDamageRects;
+
+// Returns the rects to invalidate for the damage a layer accumulated over a
+// frame. cc::Region splits overlapping invalidations into bands, and small
+// invalidations from throbbers, tooltips and animations pile up, so the
+// region's rects are merged, cheapest union first, while uniting is cheaper
+// than keeping them apart or there are more than kMaxDamageRects.
+COMPOSITOR_EXPORT std::vector<gfx::Rect> MergeDamageRects(
+    const cc::Region& region);
+
+}  // namespace ui
+
+#endif  // UI_COMPOSITOR_DAMAGE_RECTS_H_
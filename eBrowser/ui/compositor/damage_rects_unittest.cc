@@ -0,0 +1,61 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/compositor/damage_rects.h"
+
+#include "cc/base/region.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+TEST(DamageRectsTest, MergesNearbyRects) {
+  // A throbber and its label invalidate small rects next to each other.
+  cc::Region region;
+  region.Union(gfx::Rect(10, 10, 16, 16));
+  region.Union(gfx::Rect(30, 12, 40, 12));
+  std::vector<gfx::Rect> rects = MergeDamageRects(region);
+  ASSERT_EQ(1u, rects.size());
+  EXPECT_EQ(gfx::Rect(10, 10, 60, 16), rects[0]);
+}
+
+TEST(DamageRectsTest, UndoesBanding) {
+  // Overlapping rects come out of the region as three bands.
+  cc::Region region;
+  region.Union(gfx::Rect(0, 0, 100, 100));
+  region.Union(gfx::Rect(50, 50, 100, 100));
+  std::vector<gfx::Rect> rects = MergeDamageRects(region);
+  ASSERT_EQ(1u, rects.size());
+  EXPECT_EQ(gfx::Rect(0, 0, 150, 150), rects[0]);
+}
+
+TEST(DamageRectsTest, KeepsDistantRectsSeparate) {
+  // A tooltip and an animation in opposite corners of a window.
+  cc::Region region;
+  region.Union(gfx::Rect(0, 0, 100, 40));
+  region.Union(gfx::Rect(900, 700, 100, 100));
+  std::vector<gfx::Rect> rects = MergeDamageRects(region);
+  ASSERT_EQ(2u, rects.size());
+  EXPECT_EQ(gfx::Rect(0, 0, 100, 40), rects[0]);
+  EXPECT_EQ(gfx::Rect(900, 700, 100, 100), rects[1]);
+}
+
+TEST(DamageRectsTest, LimitsRectCount) {
+  cc::Region region;
+  for (int i = 0; i < 12; ++i)
+    region.Union(gfx::Rect(i * 500, i * 500, 10, 10));
+  std::vector<gfx::Rect> rects = MergeDamageRects(region);
+  EXPECT_EQ(kMaxDamageRects, rects.size());
+  cc::Region merged;
+  for (const gfx::Rect& rect : rects)
+    merged.Union(rect);
+  EXPECT_TRUE(merged.Contains(region));
+}
+
+TEST(DamageRectsTest, EmptyRegion) {
+  EXPECT_TRUE(MergeDamageRects(cc::Region()).empty());
+}
+
+}  // namespace
+}  // namespace ui
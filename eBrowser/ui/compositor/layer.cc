@@ -26,6 +26,7 @@
 #include "cc/resources/transferable_resource.h"
 #include "cc/trees/layer_tree_settings.h"
 #include "ui/compositor/compositor_switches.h"
+#include "ui/compositor/damage_rects.h"
 #include "ui/compositor/dip_util.h"
 #include "ui/compositor/layer_animator.h"
 #include "ui/compositor/layer_observer.h"
@@ -688,8 +689,8 @@ void Layer::SendDamagedRects() {
   if (!delegate_ && !mailbox_.IsValid())
     return;
 
-  for (cc::Region::Iterator iter(damaged_region_); iter.has_rect(); iter.next())
-    cc_layer_->SetNeedsDisplayRect(iter.rect());
+  for (const gfx::Rect& rect : MergeDamageRects(damaged_region_))
+    cc_layer_->SetNeedsDisplayRect(rect);
   if (layer_mask_)
     layer_mask_->SendDamagedRects();
 
@@ -324,8 +324,8 @@ class COMPOSITOR_EXPORT Layer
   // SchedulePaint() for that.
   void ScheduleDraw();
 
-  // Uses damaged rectangles recorded in |damaged_region_| to invalidate the
-  // |cc_layer_|.
+  // Uses damaged rectangles recorded in |damaged_region_|, merged by
+  // MergeDamageRects(), to invalidate the |cc_layer_|.
   void SendDamagedRects();
 
   const cc::Region& damaged_region() const { return damaged_region_; }
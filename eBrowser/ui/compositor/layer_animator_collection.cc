@@ -4,17 +4,30 @@
 
 #include "ui/compositor/layer_animator_collection.h"
 
-#include <set>
+#include <algorithm>
+#include <utility>
 
+#include "base/auto_reset.h"
 #include "base/time/time.h"
 #include "ui/compositor/compositor.h"
 #include "ui/compositor/layer_animator.h"
 
 namespace ui {
 
+namespace {
+
+// BeginFrame timestamps jitter around the vsync grid, so a throttled step is
+// allowed slightly before a full target interval has passed.
+const double kFrameIntervalSlackSeconds = 1. / 240.;
+
+}  // namespace
+
 LayerAnimatorCollection::LayerAnimatorCollection(Compositor* compositor)
-    : compositor_(compositor), last_tick_time_(base::TimeTicks::Now()) {
-}
+    : compositor_(compositor),
+      last_tick_time_(base::TimeTicks::Now()),
+      target_frame_rate_(0),
+      active_animator_count_(0),
+      is_stepping_(false) {}
 
 LayerAnimatorCollection::~LayerAnimatorCollection() {
   if (compositor_)
@@ -23,36 +36,59 @@ LayerAnimatorCollection::~LayerAnimatorCollection() {
 
 void LayerAnimatorCollection::StartAnimator(
     scoped_refptr<LayerAnimator> animator) {
-  DCHECK_EQ(0U, animators_.count(animator));
-  if (animators_.empty())
+  DCHECK(std::find(animators_.begin(), animators_.end(), animator) ==
+         animators_.end());
+  if (!HasActiveAnimators()) {
     last_tick_time_ = base::TimeTicks::Now();
-  animators_.insert(animator);
-  if (animators_.size() == 1U && compositor_)
+    last_step_time_ = base::TimeTicks();
+  }
+  animators_.push_back(std::move(animator));
+  ++active_animator_count_;
+  if (active_animator_count_ == 1U && compositor_)
     compositor_->AddAnimationObserver(this);
 }
 
 void LayerAnimatorCollection::StopAnimator(
     scoped_refptr<LayerAnimator> animator) {
-  DCHECK_GT(animators_.count(animator), 0U);
-  animators_.erase(animator);
-  if (animators_.empty() && compositor_)
+  auto it = std::find(animators_.begin(), animators_.end(), animator);
+  DCHECK(it != animators_.end());
+  if (it == animators_.end())
+    return;
+  // Erasing would shift the animators that the step in progress has yet to
+  // visit.
+  if (is_stepping_)
+    *it = nullptr;
+  else
+    animators_.erase(it);
+  --active_animator_count_;
+  if (!HasActiveAnimators() && compositor_)
     compositor_->RemoveAnimationObserver(this);
 }
 
 bool LayerAnimatorCollection::HasActiveAnimators() const {
-  return !animators_.empty();
+  return active_animator_count_ > 0;
+}
+
+void LayerAnimatorCollection::SetTargetFrameRate(int fps) {
+  target_frame_rate_ = fps >= kMaxFrameRate ? 0 : std::max(fps, 0);
 }
 
 void LayerAnimatorCollection::OnAnimationStep(base::TimeTicks now) {
+  if (HasActiveAnimators() && !IsStepDue(now))
+    return;
   last_tick_time_ = now;
-  std::set<scoped_refptr<LayerAnimator> > list = animators_;
-  for (std::set<scoped_refptr<LayerAnimator> >::iterator iter = list.begin();
-       iter != list.end();
-       ++iter) {
-    // Make sure the animator is still valid.
-    if (animators_.count(*iter) > 0)
-      (*iter)->Step(now);
+  last_step_time_ = now;
+  {
+    base::AutoReset<bool> stepping(&is_stepping_, true);
+    const size_t count = animators_.size();
+    for (size_t i = 0; i < count; ++i) {
+      // Keeps the animator alive if stepping it stops it.
+      scoped_refptr<LayerAnimator> animator = animators_[i];
+      if (animator)
+        animator->Step(now);
+    }
   }
+  RemoveStoppedAnimators();
   if (!HasActiveAnimators() && compositor_)
     compositor_->RemoveAnimationObserver(this);
 }
@@ -64,4 +100,24 @@ void LayerAnimatorCollection::OnCompositingShuttingDown(
   compositor_ = nullptr;
 }
 
+bool LayerAnimatorCollection::IsStepDue(base::TimeTicks now) const {
+  if (!target_frame_rate_ || last_step_time_.is_null())
+    return true;
+  base::TimeDelta interval = base::TimeDelta::FromSecondsD(
+      1. / target_frame_rate_ - kFrameIntervalSlackSeconds);
+  return now - last_step_time_ >= interval;
+}
+
+void LayerAnimatorCollection::RemoveStoppedAnimators() {
+  if (animators_.size() == active_animator_count_)
+    return;
+  animators_.erase(
+      std::remove_if(animators_.begin(), animators_.end(),
+                     [](const scoped_refptr<LayerAnimator>& animator) {
+                       return !animator;
+                     }),
+      animators_.end());
+  DCHECK_EQ(active_animator_count_, animators_.size());
+}
+
 }  // namespace ui
@@ -5,7 +5,7 @@
 #ifndef UI_COMPOSITOR_LAYER_ANIMATOR_COLLECTION_H_
 #define UI_COMPOSITOR_LAYER_ANIMATOR_COLLECTION_H_
 
-#include <set>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
@@ -32,6 +32,15 @@ class COMPOSITOR_EXPORT LayerAnimatorCollection
 
   bool HasActiveAnimators() const;
 
+  // Steps the animators at no more than |fps| frames per second, so that UI
+  // animations do not outpace content that is throttled during an
+  // interaction. 0, or a rate at or above kMaxFrameRate, steps every frame.
+  void SetTargetFrameRate(int fps);
+  int target_frame_rate() const { return target_frame_rate_; }
+
+  // Frame rate at and above which stepping is not throttled.
+  static const int kMaxFrameRate = 60;
+
   base::TimeTicks last_tick_time() const { return last_tick_time_; }
 
   // CompositorAnimationObserver:
@@ -39,9 +48,25 @@ class COMPOSITOR_EXPORT LayerAnimatorCollection
   void OnCompositingShuttingDown(Compositor* compositor) override;
 
  private:
+  bool IsStepDue(base::TimeTicks now) const;
+
+  // Drops the slots of animators stopped while a step was in progress.
+  void RemoveStoppedAnimators();
+
   Compositor* compositor_;
   base::TimeTicks last_tick_time_;
-  std::set<scoped_refptr<LayerAnimator> > animators_;
+  // Time of the last frame the animators were stepped in. Null until the
+  // first step after the collection becomes active.
+  base::TimeTicks last_step_time_;
+  int target_frame_rate_;
+
+  // The animators are kept contiguously and stepped by index, so a frame
+  // neither copies nor rebalances a tree. Animators stopped during a step
+  // leave a null slot that is compacted once the step completes; animators
+  // started during a step are appended and first stepped on the next frame.
+  std::vector<scoped_refptr<LayerAnimator>> animators_;
+  size_t active_animator_count_;
+  bool is_stepping_;
 
   DISALLOW_COPY_AND_ASSIGN(LayerAnimatorCollection);
 };
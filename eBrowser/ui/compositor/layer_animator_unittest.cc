@@ -2412,6 +2412,42 @@ TEST(LayerAnimatorTest, LayerAnimatorCollectionTickTime) {
   animator->SetDelegate(nullptr);
 }
 
+TEST(LayerAnimatorTest, LayerAnimatorCollectionTargetFrameRate) {
+  Layer layer;
+  LayerAnimatorTestController test_controller(layer.GetAnimator());
+  scoped_refptr<LayerAnimator> animator = test_controller.animator();
+  CollectionLayerAnimationDelegate collection_delegate;
+  animator->SetDelegate(&collection_delegate);
+  LayerAnimatorCollection* collection =
+      collection_delegate.GetLayerAnimatorCollection();
+
+  animator->ScheduleAnimation(
+      new LayerAnimationSequence(LayerAnimationElement::CreateOpacityElement(
+          1.0, base::TimeDelta::FromSeconds(1))));
+  ASSERT_TRUE(collection->HasActiveAnimators());
+
+  collection->SetTargetFrameRate(30);
+  EXPECT_EQ(30, collection->target_frame_rate());
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::TimeDelta vsync = base::TimeDelta::FromMicroseconds(16667);
+
+  // The first frame is always stepped; the next is too early at 30fps.
+  collection->OnAnimationStep(start);
+  EXPECT_EQ(start, collection->last_tick_time());
+  collection->OnAnimationStep(start + vsync);
+  EXPECT_EQ(start, collection->last_tick_time());
+  collection->OnAnimationStep(start + vsync * 2);
+  EXPECT_EQ(start + vsync * 2, collection->last_tick_time());
+
+  // Rates at or above the frame rate cap step every frame.
+  collection->SetTargetFrameRate(60);
+  EXPECT_EQ(0, collection->target_frame_rate());
+  collection->OnAnimationStep(start + vsync * 3);
+  EXPECT_EQ(start + vsync * 3, collection->last_tick_time());
+
+  animator->SetDelegate(nullptr);
+}
+
 TEST(LayerAnimatorTest, AnimatorStartedCorrectly) {
   Layer layer;
   LayerAnimatorTestController test_controller(layer.GetAnimator());
@@ -4,31 +4,70 @@
 
 #include "ui/compositor/paint_cache.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "cc/playback/display_item_list.h"
 #include "ui/compositor/paint_context.h"
 
 namespace ui {
 
-PaintCache::PaintCache() : has_cache_(false) {
-}
+struct PaintCache::Entry {
+  gfx::Size size;
+  float device_scale_factor;
+  cc::DrawingDisplayItem display_item;
+};
+
+PaintCache::PaintCache() : hit_count_(0), miss_count_(0) {}
 
 PaintCache::~PaintCache() {
 }
 
 bool PaintCache::UseCache(const PaintContext& context,
                           const gfx::Size& size_in_context) {
-  if (!has_cache_)
+  auto it = FindEntry(context, size_in_context);
+  if (it == entries_.end()) {
+    ++miss_count_;
     return false;
+  }
+  ++hit_count_;
+  std::rotate(entries_.begin(), it, it + 1);
   DCHECK(context.list_);
   gfx::Rect bounds_in_layer = context.ToLayerSpaceBounds(size_in_context);
   context.list_->CreateAndAppendDrawingItem<cc::DrawingDisplayItem>(
-      bounds_in_layer, display_item_);
+      bounds_in_layer, entries_.front()->display_item);
   return true;
 }
 
-void PaintCache::SetCache(const cc::DrawingDisplayItem& item) {
-  item.CloneTo(&display_item_);
-  has_cache_ = true;
+PaintCache::Entries::iterator PaintCache::FindEntry(
+    const PaintContext& context,
+    const gfx::Size& size_in_context) {
+  return std::find_if(
+      entries_.begin(), entries_.end(),
+      [&context, &size_in_context](const std::unique_ptr<Entry>& entry) {
+        return entry->size == size_in_context &&
+               entry->device_scale_factor == context.device_scale_factor_;
+      });
+}
+
+void PaintCache::SetCache(const PaintContext& context,
+                          const gfx::Size& size_in_context,
+                          const cc::DrawingDisplayItem& item) {
+  std::unique_ptr<Entry> entry;
+  auto it = FindEntry(context, size_in_context);
+  if (it != entries_.end()) {
+    entry = std::move(*it);
+    entries_.erase(it);
+  } else if (entries_.size() == kMaxEntries) {
+    entry = std::move(entries_.back());
+    entries_.pop_back();
+  } else {
+    entry.reset(new Entry);
+  }
+  entry->size = size_in_context;
+  entry->device_scale_factor = context.device_scale_factor_;
+  item.CloneTo(&entry->display_item);
+  entries_.insert(entries_.begin(), std::move(entry));
 }
 
 }  // namespace ui
@@ -5,6 +5,9 @@
 #ifndef UI_COMPOSITOR_PAINT_CACHE_H_
 #define UI_COMPOSITOR_PAINT_CACHE_H_
 
+#include <memory>
+#include <vector>
+
 #include "base/macros.h"
 #include "cc/playback/drawing_display_item.h"
 #include "ui/compositor/compositor_export.h"
@@ -16,6 +19,9 @@ class PaintRecorder;
 
 // A class that holds the output of a PaintRecorder to be reused when the
 // object that created the PaintRecorder has not been changed/invalidated.
+// A few outputs are kept, keyed by the recorded size and the device scale
+// factor, so that an object painted alternately at different sizes or scales
+// does not re-record each time.
 class COMPOSITOR_EXPORT PaintCache {
  public:
   PaintCache();
@@ -27,14 +33,29 @@ class COMPOSITOR_EXPORT PaintCache {
   // to be used next time.
   bool UseCache(const PaintContext& context, const gfx::Size& size_in_context);
 
+  int hit_count() const { return hit_count_; }
+  int miss_count() const { return miss_count_; }
+
  private:
   // Only PaintRecorder can modify these.
   friend PaintRecorder;
 
-  void SetCache(const cc::DrawingDisplayItem& item);
+  struct Entry;
+  using Entries = std::vector<std::unique_ptr<Entry>>;
+
+  // The number of outputs kept.
+  static const size_t kMaxEntries = 4;
+
+  Entries::iterator FindEntry(const PaintContext& context,
+                              const gfx::Size& size_in_context);
+  void SetCache(const PaintContext& context,
+                const gfx::Size& size_in_context,
+                const cc::DrawingDisplayItem& item);
 
-  bool has_cache_;
-  cc::DrawingDisplayItem display_item_;
+  // Most recently used first.
+  Entries entries_;
+  int hit_count_;
+  int miss_count_;
 
   DISALLOW_COPY_AND_ASSIGN(PaintCache);
 };
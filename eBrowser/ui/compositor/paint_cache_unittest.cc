@@ -0,0 +1,65 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/compositor/paint_cache.h"
+
+#include "cc/playback/display_item_list.h"
+#include "cc/playback/display_item_list_settings.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/compositor/paint_context.h"
+#include "ui/compositor/paint_recorder.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace ui {
+namespace {
+
+// Paints into |cache| if it has nothing for |size| at |device_scale_factor|,
+// and returns whether the cache was used.
+bool PaintWithCache(PaintCache* cache,
+                    const gfx::Size& size,
+                    float device_scale_factor) {
+  scoped_refptr<cc::DisplayItemList> list =
+      cc::DisplayItemList::Create(cc::DisplayItemListSettings());
+  PaintContext context(list.get(), device_scale_factor, gfx::Rect(size));
+  if (cache->UseCache(context, size))
+    return true;
+  PaintRecorder recorder(context, size, cache);
+  return false;
+}
+
+}  // namespace
+
+TEST(PaintCacheTest, KeyedBySizeAndScale) {
+  PaintCache cache;
+  gfx::Size small(10, 10);
+  gfx::Size large(20, 10);
+
+  EXPECT_FALSE(PaintWithCache(&cache, small, 1.f));
+  EXPECT_TRUE(PaintWithCache(&cache, small, 1.f));
+  EXPECT_FALSE(PaintWithCache(&cache, large, 1.f));
+  EXPECT_FALSE(PaintWithCache(&cache, small, 2.f));
+
+  // Each earlier recording is still available.
+  EXPECT_TRUE(PaintWithCache(&cache, large, 1.f));
+  EXPECT_TRUE(PaintWithCache(&cache, small, 1.f));
+  EXPECT_TRUE(PaintWithCache(&cache, small, 2.f));
+
+  EXPECT_EQ(4, cache.hit_count());
+  EXPECT_EQ(3, cache.miss_count());
+}
+
+TEST(PaintCacheTest, EvictsLeastRecentlyUsed) {
+  PaintCache cache;
+  // Fill the cache, then use the first recording so that the second is the
+  // least recently used.
+  for (int i = 1; i <= 4; ++i)
+    EXPECT_FALSE(PaintWithCache(&cache, gfx::Size(i, i), 1.f));
+  EXPECT_TRUE(PaintWithCache(&cache, gfx::Size(1, 1), 1.f));
+
+  EXPECT_FALSE(PaintWithCache(&cache, gfx::Size(5, 5), 1.f));
+  EXPECT_TRUE(PaintWithCache(&cache, gfx::Size(1, 1), 1.f));
+  EXPECT_FALSE(PaintWithCache(&cache, gfx::Size(2, 2), 1.f));
+}
+
+}  // namespace ui
@@ -45,7 +45,7 @@ PaintRecorder::~PaintRecorder() {
       context_.list_->CreateAndAppendDrawingItem<cc::DrawingDisplayItem>(
           bounds_in_layer_, context_.recorder_->finishRecordingAsPicture());
   if (cache_)
-    cache_->SetCache(item);
+    cache_->SetCache(context_, bounds_in_layer_.size(), item);
 }
 
 }  // namespace ui
@@ -4,9 +4,11 @@
 
 #include "ui/display/screen.h"
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "ui/display/display.h"
+#include "ui/display/display_change_notifier.h"
 #include "ui/gfx/android/device_display_info.h"
 #include "ui/gfx/geometry/size_conversions.h"
 
@@ -14,7 +16,14 @@ namespace display {
 
 class ScreenAndroid : public Screen {
  public:
-  ScreenAndroid() {}
+  ScreenAndroid() : observing_display_info_(false) {}
+
+  ~ScreenAndroid() override {
+    if (observing_display_info_) {
+      gfx::DeviceDisplayInfo::SetUpdateCallback(
+          base::Closure());
+    }
+  }
 
   gfx::Point GetCursorScreenPoint() override { return gfx::Point(); }
 
@@ -50,6 +59,8 @@ class ScreenAndroid : public Screen {
     display.set_color_depth(device_info.GetBitsPerPixel());
     display.set_depth_per_component(device_info.GetBitsPerComponent());
     display.set_is_monochrome(device_info.GetBitsPerComponent() == 0);
+    display.set_refresh_rate(device_info.GetRefreshRate());
+    display.set_supported_refresh_rates(device_info.GetSupportedRefreshRates());
     return display;
   }
 
@@ -72,14 +83,36 @@ class ScreenAndroid : public Screen {
   }
 
   void AddObserver(DisplayObserver* observer) override {
-    // no display change on Android.
+    // The display info is only watched once someone cares, so that screens
+    // nobody observes never call into Java.
+    if (!observing_display_info_) {
+      observing_display_info_ = true;
+      displays_ = GetAllDisplays();
+      gfx::DeviceDisplayInfo::SetUpdateCallback(
+          base::Bind(&ScreenAndroid::OnDisplayInfoUpdated,
+                     base::Unretained(this)));
+    }
+    change_notifier_.AddObserver(observer);
   }
 
   void RemoveObserver(DisplayObserver* observer) override {
-    // no display change on Android.
+    change_notifier_.RemoveObserver(observer);
   }
 
  private:
+  // Runs on the UI thread whenever Java reports the display changed, e.g. on
+  // a rotation or a refresh rate switch.
+  void OnDisplayInfoUpdated() {
+    std::vector<Display> old_displays = displays_;
+    displays_ = GetAllDisplays();
+    change_notifier_.NotifyDisplaysChanged(old_displays, displays_);
+  }
+
+  bool observing_display_info_;
+  // The displays as last reported to observers.
+  std::vector<Display> displays_;
+  DisplayChangeNotifier change_notifier_;
+
   DISALLOW_COPY_AND_ASSIGN(ScreenAndroid);
 };
 
@@ -5,6 +5,7 @@
 #include "ui/display/display.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "base/command_line.h"
 #include "base/logging.h"
@@ -51,6 +52,13 @@ float GetForcedDeviceScaleFactorImpl() {
 
 int64_t internal_display_id_ = -1;
 
+// Panels report rates like 59.94Hz for a nominal 60.
+const float kRefreshRateSlack = 0.5f;
+
+// Tolerance, in refreshes, for a refresh rate that is a whole multiple of a
+// frame rate.
+const float kRefreshesPerFrameSlack = 0.05f;
+
 }  // namespace
 
 // static
@@ -83,7 +91,8 @@ Display::Display()
       touch_support_(TOUCH_SUPPORT_UNKNOWN),
       color_depth_(DEFAULT_BITS_PER_PIXEL),
       depth_per_component_(DEFAULT_BITS_PER_COMPONENT),
-      is_monochrome_(false) {}
+      is_monochrome_(false),
+      refresh_rate_(0.f) {}
 
 Display::Display(const Display& other) = default;
 
@@ -93,7 +102,8 @@ Display::Display(int64_t id)
       rotation_(ROTATE_0),
       touch_support_(TOUCH_SUPPORT_UNKNOWN),
       color_depth_(DEFAULT_BITS_PER_PIXEL),
-      depth_per_component_(DEFAULT_BITS_PER_COMPONENT) {}
+      depth_per_component_(DEFAULT_BITS_PER_COMPONENT),
+      refresh_rate_(0.f) {}
 
 Display::Display(int64_t id, const gfx::Rect& bounds)
     : id_(id),
@@ -103,7 +113,8 @@ Display::Display(int64_t id, const gfx::Rect& bounds)
       rotation_(ROTATE_0),
       touch_support_(TOUCH_SUPPORT_UNKNOWN),
       color_depth_(DEFAULT_BITS_PER_PIXEL),
-      depth_per_component_(DEFAULT_BITS_PER_COMPONENT) {
+      depth_per_component_(DEFAULT_BITS_PER_COMPONENT),
+      refresh_rate_(0.f) {
 #if defined(USE_AURA)
   SetScaleAndBounds(device_scale_factor_, bounds);
 #endif
@@ -188,11 +199,37 @@ gfx::Size Display::GetSizeInPixel() const {
   return gfx::ScaleToFlooredSize(size(), device_scale_factor_);
 }
 
+void Display::set_supported_refresh_rates(
+    const std::vector<float>& refresh_rates) {
+  supported_refresh_rates_ = refresh_rates;
+  std::sort(supported_refresh_rates_.begin(), supported_refresh_rates_.end());
+}
+
+float Display::GetRefreshRateForFrameRate(float fps) const {
+  if (supported_refresh_rates_.empty())
+    return refresh_rate_;
+  if (fps <= 0)
+    return supported_refresh_rates_.back();
+  float fastest_enough = 0;
+  for (float refresh_rate : supported_refresh_rates_) {
+    if (refresh_rate < fps - kRefreshRateSlack)
+      continue;
+    float refreshes_per_frame = refresh_rate / fps;
+    if (std::abs(refreshes_per_frame - std::round(refreshes_per_frame)) <
+        kRefreshesPerFrameSlack) {
+      return refresh_rate;
+    }
+    if (!fastest_enough)
+      fastest_enough = refresh_rate;
+  }
+  return fastest_enough ? fastest_enough : supported_refresh_rates_.back();
+}
+
 std::string Display::ToString() const {
   return base::StringPrintf(
-      "Display[%lld] bounds=%s, workarea=%s, scale=%f, %s",
+      "Display[%lld] bounds=%s, workarea=%s, scale=%f, refresh=%.2fHz, %s",
       static_cast<long long int>(id_), bounds_.ToString().c_str(),
-      work_area_.ToString().c_str(), device_scale_factor_,
+      work_area_.ToString().c_str(), device_scale_factor_, refresh_rate_,
       IsInternal() ? "internal" : "external");
 }
 
@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 #include "base/compiler_specific.h"
 #include "ui/display/display_export.h"
 #include "ui/gfx/geometry/rect.h"
@@ -191,6 +193,25 @@ class DISPLAY_EXPORT Display final {
     is_monochrome_ = is_monochrome;
   }
 
+  // The rate the display currently refreshes at, in Hz, or 0 if the platform
+  // does not report it.
+  float refresh_rate() const { return refresh_rate_; }
+  void set_refresh_rate(float refresh_rate) { refresh_rate_ = refresh_rate; }
+
+  // The rates, in Hz and ascending, the display can be switched to at its
+  // current resolution, e.g. 60, 90 and 120 on some Android panels. Empty if
+  // only the current rate is known.
+  const std::vector<float>& supported_refresh_rates() const {
+    return supported_refresh_rates_;
+  }
+  void set_supported_refresh_rates(const std::vector<float>& refresh_rates);
+
+  // Returns the supported refresh rate that shows |fps| best: the slowest one
+  // that refreshes a whole number of times per frame, else the slowest one at
+  // least as fast as |fps|, else the fastest. Returns refresh_rate() if no
+  // supported rates are known.
+  float GetRefreshRateForFrameRate(float fps) const;
+
  private:
   int64_t id_;
   gfx::Rect bounds_;
@@ -203,6 +224,8 @@ class DISPLAY_EXPORT Display final {
   int color_depth_;
   int depth_per_component_;
   bool is_monochrome_;
+  float refresh_rate_;
+  std::vector<float> supported_refresh_rates_;
 
 #if !defined(OS_IOS)
   friend struct mojo::StructTraits<display::mojom::DisplayDataView,
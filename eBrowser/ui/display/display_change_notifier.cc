@@ -80,6 +80,12 @@ void DisplayChangeNotifier::NotifyDisplaysChanged(
     if (new_it->device_scale_factor() != old_it->device_scale_factor())
       metrics |= DisplayObserver::DISPLAY_METRIC_DEVICE_SCALE_FACTOR;
 
+    if (new_it->refresh_rate() != old_it->refresh_rate() ||
+        new_it->supported_refresh_rates() !=
+            old_it->supported_refresh_rates()) {
+      metrics |= DisplayObserver::DISPLAY_METRIC_REFRESH_RATE;
+    }
+
     if (metrics != DisplayObserver::DISPLAY_METRIC_NONE) {
       for (DisplayObserver& observer : observer_list_)
         observer.OnDisplayMetricsChanged(*new_it, metrics);
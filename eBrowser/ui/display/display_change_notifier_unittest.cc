@@ -422,6 +422,31 @@ TEST(DisplayChangeNotifierTest, NotifyDisplaysChanged_Changed_DSF) {
             observer.latest_metrics_change());
 }
 
+TEST(DisplayChangeNotifierTest, NotifyDisplaysChanged_Changed_RefreshRate) {
+  DisplayChangeNotifier change_notifier;
+  MockDisplayObserver observer;
+  change_notifier.AddObserver(&observer);
+
+  std::vector<Display> old_displays, new_displays;
+  old_displays.push_back(Display(1));
+  old_displays[0].set_refresh_rate(60.f);
+  new_displays.push_back(Display(1));
+  new_displays[0].set_refresh_rate(90.f);
+
+  change_notifier.NotifyDisplaysChanged(old_displays, new_displays);
+  EXPECT_EQ(1, observer.display_changed());
+  EXPECT_EQ(DisplayObserver::DISPLAY_METRIC_REFRESH_RATE,
+            observer.latest_metrics_change());
+
+  // A new set of modes counts as a change, even at the same rate.
+  old_displays = new_displays;
+  new_displays[0].set_supported_refresh_rates({60.f, 90.f});
+  change_notifier.NotifyDisplaysChanged(old_displays, new_displays);
+  EXPECT_EQ(2, observer.display_changed());
+  EXPECT_EQ(DisplayObserver::DISPLAY_METRIC_REFRESH_RATE,
+            observer.latest_metrics_change());
+}
+
 TEST(DisplayChangeNotifierTest, NotifyDisplaysChanged_Changed_Multi_Displays) {
   DisplayChangeNotifier change_notifier;
   MockDisplayObserver observer;
@@ -50,6 +50,27 @@ TEST(DisplayTest, Scale) {
   EXPECT_EQ("10,10 80x80", display.work_area().ToString());
 }
 
+TEST(DisplayTest, RefreshRateForFrameRate) {
+  Display display(0, gfx::Rect(0, 0, 100, 100));
+  // Without known modes, the current rate is all there is.
+  EXPECT_EQ(0.f, display.GetRefreshRateForFrameRate(30.f));
+  display.set_refresh_rate(60.f);
+  EXPECT_EQ(60.f, display.GetRefreshRateForFrameRate(45.f));
+
+  display.set_supported_refresh_rates({120.f, 59.94f, 90.f});
+  EXPECT_EQ(59.94f, display.supported_refresh_rates().front());
+  // Whole multiples of the frame rate win over closer rates.
+  EXPECT_EQ(59.94f, display.GetRefreshRateForFrameRate(30.f));
+  EXPECT_EQ(90.f, display.GetRefreshRateForFrameRate(45.f));
+  EXPECT_EQ(120.f, display.GetRefreshRateForFrameRate(40.f));
+  EXPECT_EQ(59.94f, display.GetRefreshRateForFrameRate(60.f));
+  // Otherwise the slowest rate that keeps up, or the fastest there is.
+  EXPECT_EQ(59.94f, display.GetRefreshRateForFrameRate(50.f));
+  EXPECT_EQ(90.f, display.GetRefreshRateForFrameRate(70.f));
+  EXPECT_EQ(120.f, display.GetRefreshRateForFrameRate(144.f));
+  EXPECT_EQ(120.f, display.GetRefreshRateForFrameRate(0.f));
+}
+
 // https://crbug.com/517944
 TEST(DisplayTest, ForcedDeviceScaleFactorByCommandLine) {
   Display::ResetForceDeviceScaleFactorForTesting();
@@ -208,6 +208,10 @@ bool Scroller::ComputeScrollOffset(base::TimeTicks time,
   return true;
 }
 
+gfx::Vector2dF Scroller::GetFinalOffset() const {
+  return gfx::Vector2dF(GetFinalX(), GetFinalY());
+}
+
 void Scroller::StartScroll(float start_x,
                            float start_y,
                            float dx,
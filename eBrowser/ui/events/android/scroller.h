@@ -34,6 +34,7 @@ class EVENTS_BASE_EXPORT Scroller : public GestureCurve {
   bool ComputeScrollOffset(base::TimeTicks time,
                            gfx::Vector2dF* offset,
                            gfx::Vector2dF* velocity) override;
+  gfx::Vector2dF GetFinalOffset() const override;
 
   // Start scrolling by providing a starting point and the distance to travel.
   // The default value of 250 milliseconds will be used for the duration.
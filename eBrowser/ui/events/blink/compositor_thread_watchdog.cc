@@ -0,0 +1,158 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/compositor_thread_watchdog.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/single_thread_task_runner.h"
+#include "base/threading/thread_local.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/default_tick_clock.h"
+#include "base/trace_event/trace_event.h"
+
+namespace ui {
+
+namespace {
+
+base::LazyInstance<base::ThreadLocalPointer<CompositorThreadWatchdog>>::Leaky
+    lazy_tls = LAZY_INSTANCE_INITIALIZER;
+
+const char* const kSourceNames[] = {
+    "input_event", "pinch", "fling", "rate_control", "input_message", "other",
+};
+static_assert(arraysize(kSourceNames) == CompositorThreadWatchdog::SOURCE_COUNT,
+              "a name is needed for each source");
+
+}  // namespace
+
+const int CompositorThreadWatchdog::kLongBlockMs;
+
+CompositorThreadWatchdog::ScopedSpan::ScopedSpan(Source source)
+    : watchdog_(CompositorThreadWatchdog::Current()),
+      source_(source),
+      outer_(nullptr) {
+  if (!watchdog_)
+    return;
+  outer_ = watchdog_->current_span_;
+  watchdog_->current_span_ = this;
+  start_time_ = watchdog_->tick_clock_->NowTicks();
+  // The probe queues behind the whole outermost span.
+  if (!outer_)
+    watchdog_->PostProbe();
+}
+
+CompositorThreadWatchdog::ScopedSpan::~ScopedSpan() {
+  if (!watchdog_)
+    return;
+  DCHECK_EQ(this, watchdog_->current_span_);
+  base::TimeTicks end_time = watchdog_->tick_clock_->NowTicks();
+  base::TimeDelta duration = end_time - start_time_;
+  watchdog_->current_span_ = outer_;
+  if (outer_)
+    outer_->nested_time_ += duration;
+  watchdog_->DidEndSpan(source_, start_time_, end_time,
+                        duration - nested_time_);
+}
+
+CompositorThreadWatchdog::CompositorThreadWatchdog(
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+    std::unique_ptr<base::TickClock> tick_clock)
+    : task_runner_(std::move(task_runner)),
+      tick_clock_(std::move(tick_clock)),
+      current_span_(nullptr),
+      probe_pending_(false),
+      weak_factory_(this) {
+  DCHECK(!Current());
+  lazy_tls.Pointer()->Set(this);
+}
+
+CompositorThreadWatchdog::~CompositorThreadWatchdog() {
+  DCHECK_EQ(this, Current());
+  DCHECK(!current_span_);
+  lazy_tls.Pointer()->Set(nullptr);
+}
+
+// static
+void CompositorThreadWatchdog::StartOnCurrentThread() {
+  new CompositorThreadWatchdog(base::ThreadTaskRunnerHandle::Get(),
+                               base::WrapUnique(new base::DefaultTickClock));
+}
+
+// static
+void CompositorThreadWatchdog::StopOnCurrentThread() {
+  delete Current();
+}
+
+// static
+CompositorThreadWatchdog* CompositorThreadWatchdog::Current() {
+  return lazy_tls.Pointer()->Get();
+}
+
+// static
+const char* CompositorThreadWatchdog::SourceName(Source source) {
+  DCHECK_GE(source, 0);
+  DCHECK_LT(source, SOURCE_COUNT);
+  return kSourceNames[source];
+}
+
+void CompositorThreadWatchdog::DidEndSpan(Source source,
+                                          base::TimeTicks start_time,
+                                          base::TimeTicks end_time,
+                                          base::TimeDelta self_time) {
+  if (self_time < base::TimeDelta::FromMilliseconds(kLongBlockMs))
+    return;
+  blocked_time_[source] += self_time;
+  UMA_HISTOGRAM_ENUMERATION("Event.CompositorThread.LongSpanSource", source,
+                            SOURCE_COUNT);
+  UMA_HISTOGRAM_CUSTOM_COUNTS("Event.CompositorThread.LongSpan",
+                              self_time.InMicroseconds(), 1, 1000000, 50);
+  TRACE_EVENT_ASYNC_BEGIN_WITH_TIMESTAMP2(
+      "input", "CompositorThreadWatchdog::LongSpan", this, start_time,
+      "source", SourceName(source), "self_us", self_time.InMicroseconds());
+  TRACE_EVENT_ASYNC_END_WITH_TIMESTAMP0(
+      "input", "CompositorThreadWatchdog::LongSpan", this, end_time);
+}
+
+void CompositorThreadWatchdog::PostProbe() {
+  if (probe_pending_)
+    return;
+  probe_pending_ = true;
+  task_runner_->PostTask(
+      FROM_HERE, base::Bind(&CompositorThreadWatchdog::RunProbe,
+                            weak_factory_.GetWeakPtr(),
+                            tick_clock_->NowTicks()));
+}
+
+void CompositorThreadWatchdog::RunProbe(base::TimeTicks post_time) {
+  probe_pending_ = false;
+  base::TimeTicks now = tick_clock_->NowTicks();
+  base::TimeDelta delay = now - post_time;
+  UMA_HISTOGRAM_CUSTOM_COUNTS("Event.CompositorThread.QueueingDelay",
+                              delay.InMicroseconds(), 1, 1000000, 50);
+  if (delay >= base::TimeDelta::FromMilliseconds(kLongBlockMs)) {
+    Source source = SOURCE_OTHER;
+    for (int i = 0; i < SOURCE_COUNT; ++i) {
+      if (blocked_time_[i] > blocked_time_[source])
+        source = static_cast<Source>(i);
+    }
+    UMA_HISTOGRAM_ENUMERATION("Event.CompositorThread.StarvationSource",
+                              source, SOURCE_COUNT);
+    TRACE_EVENT_ASYNC_BEGIN_WITH_TIMESTAMP2(
+        "input", "CompositorThreadWatchdog::Starved", this, post_time,
+        "source", SourceName(source), "delay_us", delay.InMicroseconds());
+    TRACE_EVENT_ASYNC_END_WITH_TIMESTAMP0(
+        "input", "CompositorThreadWatchdog::Starved", this, now);
+  }
+  std::fill(blocked_time_, blocked_time_ + SOURCE_COUNT, base::TimeDelta());
+}
+
+}  // namespace ui
@@ -0,0 +1,108 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_COMPOSITOR_THREAD_WATCHDOG_H_
+#define UI_EVENTS_BLINK_COMPOSITOR_THREAD_WATCHDOG_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/tick_clock.h"
+#include "base/time/time.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}
+
+namespace ui {
+
+// Watches the compositor thread for input work that keeps its other tasks,
+// flings, pinches, InputHandlerManager messages and cc's frames, waiting.
+// Input handling marks what it does with ScopedSpan, and each outermost span
+// posts a probe behind itself unless one is already queued. The probe's
+// queueing delay is how long a task posted at that moment waited for the
+// thread. Long spans and long probe delays go to UMA and to trace slices; a
+// long delay is attributed to the source whose long spans blocked the
+// thread the most since the last probe ran, so pacing that sleeps on the
+// thread shows up as SOURCE_RATE_CONTROL.
+class CompositorThreadWatchdog {
+ public:
+  // Recorded to UMA; append only.
+  enum Source {
+    SOURCE_INPUT_EVENT,
+    SOURCE_PINCH,
+    SOURCE_FLING,
+    // Paced scroll and pinch updates applied at a BeginFrame.
+    SOURCE_RATE_CONTROL,
+    SOURCE_INPUT_MESSAGE,
+    // Delays no long span accounts for, like cc's own tasks.
+    SOURCE_OTHER,
+    SOURCE_COUNT,
+  };
+
+  // Marks the work of the current task on behalf of |source| until it goes
+  // out of scope. A nested span's time counts only to its own source. Does
+  // nothing on a thread without a watchdog.
+  class ScopedSpan {
+   public:
+    explicit ScopedSpan(Source source);
+    ~ScopedSpan();
+
+   private:
+    CompositorThreadWatchdog* const watchdog_;
+    const Source source_;
+    ScopedSpan* outer_;
+    base::TimeTicks start_time_;
+    base::TimeDelta nested_time_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedSpan);
+  };
+
+  // Spans and probe delays this long or longer are reported; half a frame at
+  // ScrollUpdatePacer::kMaxFrameRate.
+  static const int kLongBlockMs = 8;
+
+  // Watches the current thread, whose tasks |task_runner| posts to, until
+  // destroyed.
+  CompositorThreadWatchdog(
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+      std::unique_ptr<base::TickClock> tick_clock);
+  ~CompositorThreadWatchdog();
+
+  // Create and destroy the watchdog of the current thread.
+  static void StartOnCurrentThread();
+  static void StopOnCurrentThread();
+
+  // The watchdog of the current thread, or null.
+  static CompositorThreadWatchdog* Current();
+
+  static const char* SourceName(Source source);
+
+ private:
+  // Reports a span of |source| from |start_time| to |end_time| that spent
+  // |self_time| outside its nested spans.
+  void DidEndSpan(Source source,
+                  base::TimeTicks start_time,
+                  base::TimeTicks end_time,
+                  base::TimeDelta self_time);
+  void PostProbe();
+  void RunProbe(base::TimeTicks post_time);
+
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+  std::unique_ptr<base::TickClock> tick_clock_;
+  ScopedSpan* current_span_;
+  bool probe_pending_;
+  // The time each source's long spans took since the last probe ran.
+  base::TimeDelta blocked_time_[SOURCE_COUNT];
+
+  base::WeakPtrFactory<CompositorThreadWatchdog> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompositorThreadWatchdog);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_COMPOSITOR_THREAD_WATCHDOG_H_
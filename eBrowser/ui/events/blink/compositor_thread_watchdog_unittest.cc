@@ -0,0 +1,103 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/compositor_thread_watchdog.h"
+
+#include "base/memory/ptr_util.h"
+#include "base/test/histogram_tester.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "base/test/test_simple_task_runner.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+const char kQueueingDelayHistogram[] = "Event.CompositorThread.QueueingDelay";
+const char kLongSpanHistogram[] = "Event.CompositorThread.LongSpanSource";
+const char kStarvationHistogram[] = "Event.CompositorThread.StarvationSource";
+
+class CompositorThreadWatchdogTest : public testing::Test {
+ public:
+  CompositorThreadWatchdogTest()
+      : task_runner_(new base::TestSimpleTaskRunner),
+        clock_(new base::SimpleTestTickClock) {
+    watchdog_.reset(
+        new CompositorThreadWatchdog(task_runner_, base::WrapUnique(clock_)));
+  }
+
+ protected:
+  // Runs a span of |source| that blocks the thread for |ms|.
+  void Block(CompositorThreadWatchdog::Source source, int ms) {
+    CompositorThreadWatchdog::ScopedSpan span(source);
+    clock_->Advance(base::TimeDelta::FromMilliseconds(ms));
+  }
+
+  scoped_refptr<base::TestSimpleTaskRunner> task_runner_;
+  base::SimpleTestTickClock* clock_;
+  std::unique_ptr<CompositorThreadWatchdog> watchdog_;
+  base::HistogramTester histograms_;
+};
+
+TEST_F(CompositorThreadWatchdogTest, ShortSpansAreNotReported) {
+  EXPECT_EQ(watchdog_.get(), CompositorThreadWatchdog::Current());
+  Block(CompositorThreadWatchdog::SOURCE_INPUT_EVENT, 1);
+  Block(CompositorThreadWatchdog::SOURCE_FLING, 1);
+  // The second span finds the first one's probe still queued.
+  EXPECT_EQ(1u, task_runner_->NumPendingTasks());
+  task_runner_->RunPendingTasks();
+
+  histograms_.ExpectTotalCount(kQueueingDelayHistogram, 1);
+  histograms_.ExpectTotalCount(kLongSpanHistogram, 0);
+  histograms_.ExpectTotalCount(kStarvationHistogram, 0);
+}
+
+TEST_F(CompositorThreadWatchdogTest, AttributesStarvationToTheLongestBlock) {
+  Block(CompositorThreadWatchdog::SOURCE_INPUT_EVENT, 9);
+  Block(CompositorThreadWatchdog::SOURCE_RATE_CONTROL, 20);
+  task_runner_->RunPendingTasks();
+
+  histograms_.ExpectBucketCount(
+      kLongSpanHistogram, CompositorThreadWatchdog::SOURCE_INPUT_EVENT, 1);
+  histograms_.ExpectBucketCount(
+      kLongSpanHistogram, CompositorThreadWatchdog::SOURCE_RATE_CONTROL, 1);
+  histograms_.ExpectUniqueSample(
+      kStarvationHistogram, CompositorThreadWatchdog::SOURCE_RATE_CONTROL, 1);
+
+  // Blocking no span accounts for counts as other.
+  Block(CompositorThreadWatchdog::SOURCE_PINCH, 1);
+  clock_->Advance(base::TimeDelta::FromMilliseconds(30));
+  task_runner_->RunPendingTasks();
+  histograms_.ExpectBucketCount(kStarvationHistogram,
+                                CompositorThreadWatchdog::SOURCE_OTHER, 1);
+  histograms_.ExpectTotalCount(kQueueingDelayHistogram, 2);
+}
+
+TEST_F(CompositorThreadWatchdogTest, NestedSpansCountToTheirOwnSource) {
+  {
+    CompositorThreadWatchdog::ScopedSpan message(
+        CompositorThreadWatchdog::SOURCE_INPUT_MESSAGE);
+    clock_->Advance(base::TimeDelta::FromMilliseconds(2));
+    Block(CompositorThreadWatchdog::SOURCE_PINCH, 12);
+  }
+  task_runner_->RunPendingTasks();
+
+  // The message span's own 2ms is short; the pinch inside it is not.
+  histograms_.ExpectUniqueSample(kLongSpanHistogram,
+                                 CompositorThreadWatchdog::SOURCE_PINCH, 1);
+  histograms_.ExpectUniqueSample(kStarvationHistogram,
+                                 CompositorThreadWatchdog::SOURCE_PINCH, 1);
+}
+
+TEST(CompositorThreadWatchdogSpanTest, SpansWithoutAWatchdogDoNothing) {
+  EXPECT_FALSE(CompositorThreadWatchdog::Current());
+  base::HistogramTester histograms;
+  {
+    CompositorThreadWatchdog::ScopedSpan span(
+        CompositorThreadWatchdog::SOURCE_FLING);
+  }
+  histograms.ExpectTotalCount(kQueueingDelayHistogram, 0);
+}
+
+}  // namespace
+}  // namespace ui
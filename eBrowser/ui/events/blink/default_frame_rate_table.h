@@ -0,0 +1,32 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Generated by ui/events/blink/tools/export_default_frame_rate_table from the
+// cloud trainer's population scroll table (/model/table?device=population).
+// Do not edit; regenerate with
+//
+//   export_default_frame_rate_table population_table.txt \
+//       > ui/events/blink/default_frame_rate_table.h
+
+#ifndef UI_EVENTS_BLINK_DEFAULT_FRAME_RATE_TABLE_H_
+#define UI_EVENTS_BLINK_DEFAULT_FRAME_RATE_TABLE_H_
+
+#include <stdint.h>
+
+namespace ui {
+namespace default_frame_rate_table {
+
+constexpr char kVersion[] = "population-20170301";
+// Speed units per bucket, in physical pixels per second.
+constexpr double kStep = 250;
+constexpr int kMaxError = 2;
+constexpr uint8_t kFrameRates[] = {
+    30, 30, 30, 32, 34, 36, 38, 40, 42, 44, 45, 46, 48,
+    50, 51, 52, 54, 55, 56, 57, 58, 59, 60, 60, 60,
+};
+
+}  // namespace default_frame_rate_table
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_DEFAULT_FRAME_RATE_TABLE_H_
@@ -0,0 +1,295 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/dense_rbf_model.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "build/build_config.h"
+#include "ui/events/blink/svm.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define DENSE_RBF_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#define DENSE_RBF_USE_NEON
+#endif
+
+namespace ui {
+
+namespace {
+
+const size_t kVectorWidth = 4;
+
+const float kLog2e = 1.44269504f;
+
+// exp() of anything smaller is below the smallest normal float.
+const float kMinExponent = -87.f;
+
+// Taylor coefficients of 2^f = e^(f ln 2) for f in [-0.5, 0.5].
+const float kExp2C1 = 0.693147181f;
+const float kExp2C2 = 0.240226507f;
+const float kExp2C3 = 0.0555041087f;
+const float kExp2C4 = 0.00961812911f;
+const float kExp2C5 = 0.00133335581f;
+
+#if defined(DENSE_RBF_USE_SSE2)
+
+__m128 ApproximateExp4(__m128 x) {
+  const __m128 one = _mm_set1_ps(1.f);
+  __m128 y = _mm_mul_ps(_mm_max_ps(x, _mm_set1_ps(kMinExponent)),
+                        _mm_set1_ps(kLog2e));
+  // n = floor(y + 0.5). Truncation rounds negative values up, so correct
+  // those lanes by one.
+  __m128 t = _mm_add_ps(y, _mm_set1_ps(0.5f));
+  __m128 n = _mm_cvtepi32_ps(_mm_cvttps_epi32(t));
+  n = _mm_sub_ps(n, _mm_and_ps(_mm_cmpgt_ps(n, t), one));
+  __m128 f = _mm_sub_ps(y, n);
+
+  __m128 p = _mm_set1_ps(kExp2C5);
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C4));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C3));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C2));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(kExp2C1));
+  p = _mm_add_ps(_mm_mul_ps(p, f), one);
+
+  __m128i bits = _mm_slli_epi32(
+      _mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23);
+  return _mm_mul_ps(p, _mm_castsi128_ps(bits));
+}
+
+#elif defined(DENSE_RBF_USE_NEON)
+
+float32x4_t ApproximateExp4(float32x4_t x) {
+  const float32x4_t one = vdupq_n_f32(1.f);
+  float32x4_t y =
+      vmulq_f32(vmaxq_f32(x, vdupq_n_f32(kMinExponent)), vdupq_n_f32(kLog2e));
+  float32x4_t t = vaddq_f32(y, vdupq_n_f32(0.5f));
+  float32x4_t n = vcvtq_f32_s32(vcvtq_s32_f32(t));
+  uint32x4_t too_big = vcgtq_f32(n, t);
+  n = vsubq_f32(n, vreinterpretq_f32_u32(
+                       vandq_u32(too_big, vreinterpretq_u32_f32(one))));
+  float32x4_t f = vsubq_f32(y, n);
+
+  float32x4_t p = vdupq_n_f32(kExp2C5);
+  p = vmlaq_f32(vdupq_n_f32(kExp2C4), p, f);
+  p = vmlaq_f32(vdupq_n_f32(kExp2C3), p, f);
+  p = vmlaq_f32(vdupq_n_f32(kExp2C2), p, f);
+  p = vmlaq_f32(vdupq_n_f32(kExp2C1), p, f);
+  p = vmlaq_f32(one, p, f);
+
+  int32x4_t bits =
+      vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);
+  return vmulq_f32(p, vreinterpretq_f32_s32(bits));
+}
+
+#endif
+
+}  // namespace
+
+float ApproximateExp(float x) {
+  float y = std::max(x, kMinExponent) * kLog2e;
+  float n = std::floor(y + 0.5f);
+  float f = y - n;
+  float p = kExp2C5;
+  p = p * f + kExp2C4;
+  p = p * f + kExp2C3;
+  p = p * f + kExp2C2;
+  p = p * f + kExp2C1;
+  p = p * f + 1.f;
+  int32_t bits = (static_cast<int32_t>(n) + 127) << 23;
+  float scale;
+  memcpy(&scale, &bits, sizeof(scale));
+  return p * scale;
+}
+
+// static
+std::unique_ptr<DenseRbfModel> DenseRbfModel::Create(const svm_model& model) {
+  if (model.param.svm_type != EPSILON_SVR && model.param.svm_type != NU_SVR)
+    return nullptr;
+  if (model.param.kernel_type != RBF || model.l <= 0)
+    return nullptr;
+
+  int num_features = 0;
+  for (int i = 0; i < model.l; ++i) {
+    for (const svm_node* node = model.SV[i]; node->index != -1; ++node) {
+      if (node->index < 1 || node->index > kMaxDenseFeatures)
+        return nullptr;
+      num_features = std::max(num_features, node->index);
+    }
+  }
+  if (!num_features)
+    return nullptr;
+
+  std::unique_ptr<DenseRbfModel> dense(
+      new DenseRbfModel(num_features, model.l));
+  dense->gamma_ = static_cast<float>(model.param.gamma);
+  dense->rho_ = model.rho[0];
+  size_t padded_count = dense->padded_count_;
+  dense->storage_.assign((num_features + 1) * padded_count, 0.f);
+  float* coefficients = dense->storage_.data();
+  float* support_vectors = coefficients + padded_count;
+  for (int i = 0; i < model.l; ++i) {
+    coefficients[i] = static_cast<float>(model.sv_coef[0][i]);
+    for (const svm_node* node = model.SV[i]; node->index != -1; ++node) {
+      support_vectors[(node->index - 1) * padded_count + i] =
+          static_cast<float>(node->value);
+    }
+  }
+  dense->coefficients_ = coefficients;
+  dense->support_vectors_ = support_vectors;
+  return dense;
+}
+
+// static
+bool DenseRbfModel::IsBinaryModel(const void* data, size_t size) {
+  uint32_t magic;
+  if (!data || size < sizeof(magic))
+    return false;
+  memcpy(&magic, data, sizeof(magic));
+  return magic == kDenseRbfModelMagic;
+}
+
+// static
+std::unique_ptr<DenseRbfModel> DenseRbfModel::CreateFromBinary(
+    const void* data,
+    size_t size) {
+  if (!IsBinaryModel(data, size) || size < sizeof(DenseRbfModelHeader))
+    return nullptr;
+  if (reinterpret_cast<uintptr_t>(data) % alignof(DenseRbfModelHeader))
+    return nullptr;
+
+  const DenseRbfModelHeader* header =
+      static_cast<const DenseRbfModelHeader*>(data);
+  if (header->version != kDenseRbfModelVersion)
+    return nullptr;
+  if (header->num_features < 1 || header->num_features > kMaxDenseFeatures)
+    return nullptr;
+  if (header->num_support_vectors < 1 ||
+      header->padded_count % kVectorWidth ||
+      header->padded_count < header->num_support_vectors ||
+      header->padded_count - header->num_support_vectors >= kVectorWidth) {
+    return nullptr;
+  }
+  // Compared by division, so that a huge |padded_count| cannot wrap the
+  // expected size around to |size| on 32-bit targets.
+  const size_t row_size = (header->num_features + 1) * sizeof(float);
+  const size_t payload_size = size - sizeof(DenseRbfModelHeader);
+  if (payload_size % row_size ||
+      payload_size / row_size != header->padded_count) {
+    return nullptr;
+  }
+
+  std::unique_ptr<DenseRbfModel> dense(new DenseRbfModel(
+      header->num_features, header->num_support_vectors));
+  DCHECK_EQ(dense->padded_count_, header->padded_count);
+  dense->gamma_ = static_cast<float>(header->gamma);
+  dense->rho_ = header->rho;
+  dense->coefficients_ = reinterpret_cast<const float*>(header + 1);
+  dense->support_vectors_ = dense->coefficients_ + header->padded_count;
+  return dense;
+}
+
+std::vector<uint8_t> DenseRbfModel::SerializeToBinary() const {
+  DenseRbfModelHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kDenseRbfModelMagic;
+  header.version = kDenseRbfModelVersion;
+  header.num_features = static_cast<uint16_t>(num_features_);
+  header.num_support_vectors = static_cast<uint32_t>(num_support_vectors_);
+  header.padded_count = static_cast<uint32_t>(padded_count_);
+  header.gamma = gamma_;
+  header.rho = rho_;
+
+  size_t coefficient_bytes = padded_count_ * sizeof(float);
+  size_t support_vector_bytes = num_features_ * coefficient_bytes;
+  std::vector<uint8_t> result(sizeof(header) + coefficient_bytes +
+                              support_vector_bytes);
+  memcpy(result.data(), &header, sizeof(header));
+  memcpy(result.data() + sizeof(header), coefficients_, coefficient_bytes);
+  memcpy(result.data() + sizeof(header) + coefficient_bytes, support_vectors_,
+         support_vector_bytes);
+  return result;
+}
+
+DenseRbfModel::DenseRbfModel(int num_features, int num_support_vectors)
+    : num_features_(num_features),
+      num_support_vectors_(num_support_vectors),
+      padded_count_((num_support_vectors + kVectorWidth - 1) / kVectorWidth *
+                    kVectorWidth),
+      gamma_(0),
+      rho_(0),
+      support_vectors_(nullptr),
+      coefficients_(nullptr) {}
+
+DenseRbfModel::~DenseRbfModel() {}
+
+double DenseRbfModel::MaxFeatureValue(int feature) const {
+  DCHECK_GE(feature, 0);
+  DCHECK_LT(feature, num_features_);
+  const float* row = support_vectors_ + feature * padded_count_;
+  return *std::max_element(row, row + num_support_vectors_);
+}
+
+double DenseRbfModel::Predict(const float* features) const {
+  const float* coefficients = coefficients_;
+  const float* support_vectors = support_vectors_;
+  float sum = 0;
+
+#if defined(DENSE_RBF_USE_SSE2)
+  const __m128 neg_gamma = _mm_set1_ps(-gamma_);
+  __m128 acc = _mm_setzero_ps();
+  for (size_t i = 0; i < padded_count_; i += kVectorWidth) {
+    __m128 dist = _mm_setzero_ps();
+    for (int f = 0; f < num_features_; ++f) {
+      __m128 d = _mm_sub_ps(
+          _mm_set1_ps(features[f]),
+          _mm_loadu_ps(support_vectors + f * padded_count_ + i));
+      dist = _mm_add_ps(dist, _mm_mul_ps(d, d));
+    }
+    __m128 k = ApproximateExp4(_mm_mul_ps(neg_gamma, dist));
+    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(coefficients + i), k));
+  }
+  float lanes[kVectorWidth];
+  _mm_storeu_ps(lanes, acc);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(DENSE_RBF_USE_NEON)
+  const float32x4_t neg_gamma = vdupq_n_f32(-gamma_);
+  float32x4_t acc = vdupq_n_f32(0.f);
+  for (size_t i = 0; i < padded_count_; i += kVectorWidth) {
+    float32x4_t dist = vdupq_n_f32(0.f);
+    for (int f = 0; f < num_features_; ++f) {
+      float32x4_t d = vsubq_f32(
+          vdupq_n_f32(features[f]),
+          vld1q_f32(support_vectors + f * padded_count_ + i));
+      dist = vmlaq_f32(dist, d, d);
+    }
+    float32x4_t k = ApproximateExp4(vmulq_f32(neg_gamma, dist));
+    acc = vmlaq_f32(acc, vld1q_f32(coefficients + i), k);
+  }
+  float lanes[kVectorWidth];
+  vst1q_f32(lanes, acc);
+  sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#else
+  for (size_t i = 0; i < padded_count_; ++i) {
+    float dist = 0;
+    for (int f = 0; f < num_features_; ++f) {
+      float d = features[f] - support_vectors[f * padded_count_ + i];
+      dist += d * d;
+    }
+    sum += coefficients[i] * ApproximateExp(-gamma_ * dist);
+  }
+#endif
+
+  return sum - rho_;
+}
+
+}  // namespace ui
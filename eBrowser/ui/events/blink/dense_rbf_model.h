@@ -0,0 +1,112 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_DENSE_RBF_MODEL_H_
+#define UI_EVENTS_BLINK_DENSE_RBF_MODEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+
+struct svm_model;
+
+namespace ui {
+
+// Approximates exp(x) for x <= 0 with a relative error below 1e-5. This is
+// the scalar form of the vectorized approximation used by DenseRbfModel, and
+// is exposed so that both can be checked against std::exp.
+float ApproximateExp(float x);
+
+// Binary model format, version 1. All fields are little-endian and every
+// array starts on a 4-byte boundary, so a mapped file or shared memory region
+// can be used in place:
+//   DenseRbfModelHeader
+//   float coefficients[padded_count]
+//   float support_vectors[num_features][padded_count]
+// Padding entries have zero coefficients.
+const uint32_t kDenseRbfModelMagic = 0x56534245;  // "EBSV"
+const uint16_t kDenseRbfModelVersion = 1;
+
+struct DenseRbfModelHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t num_features;
+  uint32_t num_support_vectors;
+  uint32_t padded_count;
+  double gamma;
+  double rho;
+};
+static_assert(sizeof(DenseRbfModelHeader) == 32,
+              "DenseRbfModelHeader layout is part of the model format");
+
+// A regression model with an RBF kernel whose support vectors are stored
+// densely in a structure-of-arrays layout: all values of feature 0, then all
+// values of feature 1, and so on. The kernel sum is evaluated four support
+// vectors at a time with SSE2 or NEON where available, so the cost no longer
+// depends on walking the -1 terminated svm_node arrays of the sparse form.
+class DenseRbfModel {
+ public:
+  // Models with more features than this stay on the sparse path.
+  static const int kMaxDenseFeatures = 16;
+
+  // Converts |model|. Returns nullptr unless it is an epsilon- or nu-SVR
+  // model with an RBF kernel and at most kMaxDenseFeatures features. Features
+  // that are absent from a sparse support vector are stored as zero, which is
+  // what the sparse kernel assumes.
+  static std::unique_ptr<DenseRbfModel> Create(const svm_model& model);
+
+  // Wraps a model in the binary format without copying it. |data| must stay
+  // valid and unchanged for the lifetime of the returned model. Returns
+  // nullptr if the header or the sizes do not check out.
+  static std::unique_ptr<DenseRbfModel> CreateFromBinary(const void* data,
+                                                         size_t size);
+
+  // Returns true if |data| starts with the binary format's magic number.
+  static bool IsBinaryModel(const void* data, size_t size);
+
+  // Writes the model in the binary format.
+  std::vector<uint8_t> SerializeToBinary() const;
+
+  ~DenseRbfModel();
+
+  // Evaluates the model for |features|, which must hold |num_features()|
+  // values; feature i corresponds to svm_node index i + 1.
+  double Predict(const float* features) const;
+
+  int num_features() const { return num_features_; }
+  int num_support_vectors() const { return num_support_vectors_; }
+  double gamma() const { return gamma_; }
+
+  // Largest value of feature |feature| over all support vectors.
+  double MaxFeatureValue(int feature) const;
+
+ private:
+  DenseRbfModel(int num_features, int num_support_vectors);
+
+  const int num_features_;
+  const int num_support_vectors_;
+  // |num_support_vectors_| rounded up to a multiple of the vector width. The
+  // padding has zero coefficients so it contributes nothing to the sum.
+  const size_t padded_count_;
+
+  float gamma_;
+  double rho_;
+  // |num_features_| rows of |padded_count_| values each. Both point either
+  // into |storage_| or into memory owned by the caller of CreateFromBinary().
+  const float* support_vectors_;
+  const float* coefficients_;
+  // Backing store for models converted from svm_model; the coefficients come
+  // first, followed by the support vectors.
+  std::vector<float> storage_;
+
+  DISALLOW_COPY_AND_ASSIGN(DenseRbfModel);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_DENSE_RBF_MODEL_H_
@@ -0,0 +1,157 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/dense_rbf_model.h"
+
+#include <stdint.h>
+
+#include <cmath>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/svm.h"
+
+namespace ui {
+namespace {
+
+// Two features; the second support vector omits feature 1, which the sparse
+// kernel treats as zero.
+const char kTwoFeatureModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.25\n"
+    "nr_class 2\n"
+    "total_sv 5\n"
+    "rho -30\n"
+    "SV\n"
+    "10 1:1 2:0.5\n"
+    "-10 2:3\n"
+    "4.5 1:2 2:2\n"
+    "-7.25 1:6 2:1\n"
+    "1000 1:12 2:0.1\n";
+
+class DenseRbfModelTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    if (model_)
+      svm_free_and_destroy_model(&model_);
+  }
+
+  void Load(const char* model_str) {
+    model_ = svm_load_model(model_str);
+    ASSERT_TRUE(model_);
+  }
+
+  svm_model* model_ = nullptr;
+};
+
+TEST(ApproximateExpTest, RelativeErrorIsSmall) {
+  for (float x = -80; x <= 0; x += 0.01f) {
+    double exact = std::exp(static_cast<double>(x));
+    EXPECT_NEAR(1, ApproximateExp(x) / exact, 1e-5) << x;
+  }
+  EXPECT_EQ(1.f, ApproximateExp(0));
+  EXPECT_LT(ApproximateExp(-1000), 1e-37f);
+}
+
+TEST_F(DenseRbfModelTest, MatchesSparsePrediction) {
+  Load(kTwoFeatureModel);
+  std::unique_ptr<DenseRbfModel> dense = DenseRbfModel::Create(*model_);
+  ASSERT_TRUE(dense);
+  EXPECT_EQ(2, dense->num_features());
+  EXPECT_EQ(5, dense->num_support_vectors());
+
+  for (float a = 0; a < 14; a += 0.37f) {
+    for (float b = 0; b < 4; b += 0.5f) {
+      svm_node x[] = {{1, a}, {2, b}, {-1, 0}};
+      float features[] = {a, b};
+      // Absolute tolerance scaled to the largest coefficient.
+      EXPECT_NEAR(svm_predict(model_, x), dense->Predict(features), 0.05)
+          << a << ", " << b;
+    }
+  }
+}
+
+TEST_F(DenseRbfModelTest, RejectsNonRbfModels) {
+  Load(
+      "svm_type epsilon_svr\n"
+      "kernel_type linear\n"
+      "degree 3\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho 0\n"
+      "SV\n"
+      "1 1:1\n");
+  EXPECT_FALSE(DenseRbfModel::Create(*model_));
+}
+
+TEST_F(DenseRbfModelTest, RejectsHighDimensionalModels) {
+  Load(
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.1\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho 0\n"
+      "SV\n"
+      "1 1:1 40:2\n");
+  EXPECT_FALSE(DenseRbfModel::Create(*model_));
+}
+
+TEST_F(DenseRbfModelTest, BinaryRoundTrip) {
+  Load(kTwoFeatureModel);
+  std::unique_ptr<DenseRbfModel> dense = DenseRbfModel::Create(*model_);
+  ASSERT_TRUE(dense);
+  std::vector<uint8_t> binary = dense->SerializeToBinary();
+  EXPECT_TRUE(DenseRbfModel::IsBinaryModel(binary.data(), binary.size()));
+
+  std::unique_ptr<DenseRbfModel> mapped =
+      DenseRbfModel::CreateFromBinary(binary.data(), binary.size());
+  ASSERT_TRUE(mapped);
+  EXPECT_EQ(dense->num_features(), mapped->num_features());
+  EXPECT_EQ(dense->num_support_vectors(), mapped->num_support_vectors());
+  EXPECT_EQ(dense->gamma(), mapped->gamma());
+  EXPECT_EQ(12, mapped->MaxFeatureValue(0));
+  for (float a = 0; a < 14; a += 1.5f) {
+    float features[] = {a, 1};
+    EXPECT_EQ(dense->Predict(features), mapped->Predict(features)) << a;
+  }
+  EXPECT_EQ(binary, mapped->SerializeToBinary());
+}
+
+TEST_F(DenseRbfModelTest, RejectsInvalidBinary) {
+  Load(kTwoFeatureModel);
+  std::unique_ptr<DenseRbfModel> dense = DenseRbfModel::Create(*model_);
+  ASSERT_TRUE(dense);
+  std::vector<uint8_t> binary = dense->SerializeToBinary();
+
+  EXPECT_FALSE(DenseRbfModel::CreateFromBinary(nullptr, 0));
+  EXPECT_FALSE(DenseRbfModel::CreateFromBinary(binary.data(), 4));
+  EXPECT_FALSE(
+      DenseRbfModel::CreateFromBinary(binary.data(), binary.size() - 4));
+  EXPECT_FALSE(DenseRbfModel::IsBinaryModel(kTwoFeatureModel,
+                                            sizeof(kTwoFeatureModel)));
+
+  std::vector<uint8_t> bad_version = binary;
+  bad_version[4] = 2;
+  EXPECT_FALSE(
+      DenseRbfModel::CreateFromBinary(bad_version.data(), bad_version.size()));
+
+  std::vector<uint8_t> bad_magic = binary;
+  bad_magic[0] ^= 1;
+  EXPECT_FALSE(
+      DenseRbfModel::CreateFromBinary(bad_magic.data(), bad_magic.size()));
+
+  // Counts whose size wraps around to the real one in 32 bits.
+  std::vector<uint8_t> huge_counts = binary;
+  DenseRbfModelHeader* header =
+      reinterpret_cast<DenseRbfModelHeader*>(huge_counts.data());
+  header->num_support_vectors += 0x40000000;
+  header->padded_count += 0x40000000;
+  EXPECT_FALSE(
+      DenseRbfModel::CreateFromBinary(huge_counts.data(), huge_counts.size()));
+}
+
+}  // namespace
+}  // namespace ui
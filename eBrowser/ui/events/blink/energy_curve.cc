@@ -0,0 +1,97 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/energy_curve.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace ui {
+
+namespace {
+
+// First line of a curve in the text format.
+const char kCurveMagic[] = "energy_curve";
+
+bool ParseValues(const std::vector<base::StringPiece>& fields,
+                 std::vector<double>* values) {
+  for (size_t i = 1; i < fields.size(); ++i) {
+    double value;
+    if (!base::StringToDouble(fields[i].as_string(), &value) || !(value > 0))
+      return false;
+    values->push_back(value);
+  }
+  return true;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<EnergyCurve> EnergyCurve::CreateFromString(
+    const std::string& curve_str) {
+  std::vector<base::StringPiece> lines = base::SplitStringPiece(
+      curve_str, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (lines.empty() || lines[0] != kCurveMagic)
+    return nullptr;
+
+  std::vector<double> frame_rates;
+  std::vector<double> millijoules_per_frame;
+  for (size_t i = 1; i < lines.size(); ++i) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        lines[i], " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields[0] == "frame_rates") {
+      if (!ParseValues(fields, &frame_rates))
+        return nullptr;
+    } else if (fields[0] == "millijoules_per_frame") {
+      if (!ParseValues(fields, &millijoules_per_frame))
+        return nullptr;
+    }
+    // Other lines, such as the version, are for the server's caching.
+  }
+  if (frame_rates.empty() ||
+      frame_rates.size() != millijoules_per_frame.size() ||
+      frame_rates.back() > ScrollUpdatePacer::kMaxFrameRate) {
+    return nullptr;
+  }
+  for (size_t i = 1; i < frame_rates.size(); ++i) {
+    if (!(frame_rates[i] > frame_rates[i - 1]))
+      return nullptr;
+  }
+
+  return base::WrapUnique(new EnergyCurve(std::move(frame_rates),
+                                          std::move(millijoules_per_frame)));
+}
+
+EnergyCurve::EnergyCurve(std::vector<double> frame_rates,
+                         std::vector<double> millijoules_per_frame)
+    : frame_rates_(std::move(frame_rates)),
+      millijoules_per_frame_(std::move(millijoules_per_frame)) {
+  DCHECK(!frame_rates_.empty());
+  DCHECK_EQ(frame_rates_.size(), millijoules_per_frame_.size());
+}
+
+EnergyCurve::~EnergyCurve() {}
+
+double EnergyCurve::MillijoulesPerFrame(double fps) const {
+  std::vector<double>::const_iterator upper =
+      std::lower_bound(frame_rates_.begin(), frame_rates_.end(), fps);
+  if (upper == frame_rates_.begin())
+    return millijoules_per_frame_.front();
+  if (upper == frame_rates_.end())
+    return millijoules_per_frame_.back();
+  size_t i = upper - frame_rates_.begin();
+  double t =
+      (fps - frame_rates_[i - 1]) / (frame_rates_[i] - frame_rates_[i - 1]);
+  return millijoules_per_frame_[i - 1] +
+         t * (millijoules_per_frame_[i] - millijoules_per_frame_[i - 1]);
+}
+
+}  // namespace ui
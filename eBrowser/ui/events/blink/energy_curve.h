@@ -0,0 +1,56 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_ENERGY_CURVE_H_
+#define UI_EVENTS_BLINK_ENERGY_CURVE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace ui {
+
+// A device's energy cost per frame at each target frame rate, fitted by the
+// cloud trainer from lab calibration runs (see EnergyCalibration) and
+// delivered with the frame rate models. Between the calibrated rates the cost
+// is interpolated linearly; beyond them it is held at the nearest one.
+class EnergyCurve {
+ public:
+  // Parses a curve in the cloud trainer's format:
+  //
+  //   energy_curve
+  //   version <opaque>
+  //   frame_rates <fps> <fps> ...
+  //   millijoules_per_frame <mJ> <mJ> ...
+  //
+  // with one cost per rate and the rates strictly increasing. Returns nullptr
+  // if |curve_str| is not such a curve.
+  static std::unique_ptr<EnergyCurve> CreateFromString(
+      const std::string& curve_str);
+
+  ~EnergyCurve();
+
+  double MillijoulesPerFrame(double fps) const;
+  // The average power of frames at |fps|.
+  double MilliwattsAt(double fps) const {
+    return MillijoulesPerFrame(fps) * fps;
+  }
+
+  const std::vector<double>& frame_rates() const { return frame_rates_; }
+
+ private:
+  EnergyCurve(std::vector<double> frame_rates,
+              std::vector<double> millijoules_per_frame);
+
+  const std::vector<double> frame_rates_;
+  const std::vector<double> millijoules_per_frame_;
+
+  DISALLOW_COPY_AND_ASSIGN(EnergyCurve);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_ENERGY_CURVE_H_
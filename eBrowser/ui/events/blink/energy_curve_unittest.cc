@@ -0,0 +1,50 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/energy_curve.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+const char kCurve[] =
+    "energy_curve\n"
+    "version 1a2b\n"
+    "frame_rates 10 30 60\n"
+    "millijoules_per_frame 8 6 5\n";
+
+TEST(EnergyCurveTest, Interpolates) {
+  std::unique_ptr<EnergyCurve> curve = EnergyCurve::CreateFromString(kCurve);
+  ASSERT_TRUE(curve);
+  EXPECT_EQ(3u, curve->frame_rates().size());
+  EXPECT_DOUBLE_EQ(8, curve->MillijoulesPerFrame(10));
+  EXPECT_DOUBLE_EQ(7, curve->MillijoulesPerFrame(20));
+  EXPECT_DOUBLE_EQ(5.5, curve->MillijoulesPerFrame(45));
+  EXPECT_DOUBLE_EQ(300, curve->MilliwattsAt(60));
+
+  // Held beyond the calibrated rates.
+  EXPECT_DOUBLE_EQ(8, curve->MillijoulesPerFrame(5));
+  EXPECT_DOUBLE_EQ(5, curve->MillijoulesPerFrame(90));
+}
+
+TEST(EnergyCurveTest, RejectsMalformedCurves) {
+  EXPECT_FALSE(EnergyCurve::CreateFromString(""));
+  EXPECT_FALSE(EnergyCurve::CreateFromString(
+      "frame_rate_table\nframe_rates 10\nmillijoules_per_frame 8\n"));
+  // Mismatched, unordered, non-positive or out of range.
+  EXPECT_FALSE(EnergyCurve::CreateFromString(
+      "energy_curve\nframe_rates 10 20\nmillijoules_per_frame 8\n"));
+  EXPECT_FALSE(EnergyCurve::CreateFromString(
+      "energy_curve\nframe_rates 20 10\nmillijoules_per_frame 8 6\n"));
+  EXPECT_FALSE(EnergyCurve::CreateFromString(
+      "energy_curve\nframe_rates 10 20\nmillijoules_per_frame 8 0\n"));
+  EXPECT_FALSE(EnergyCurve::CreateFromString(
+      "energy_curve\nframe_rates 10 120\nmillijoules_per_frame 8 6\n"));
+  EXPECT_FALSE(EnergyCurve::CreateFromString(
+      "energy_curve\nframe_rates 10 x\nmillijoules_per_frame 8 6\n"));
+}
+
+}  // namespace
+}  // namespace ui
@@ -0,0 +1,60 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/frame_rate_governor.h"
+
+#include <cmath>
+
+namespace ui {
+
+namespace {
+
+// Keeps an average that has converged on an integer rate from rounding up to
+// the next one.
+const double kRoundingSlack = 0.01;
+
+}  // namespace
+
+const double FrameRateGovernor::kRampUpWeight = 0.5;
+const double FrameRateGovernor::kRampDownWeight = 0.15;
+const double FrameRateGovernor::kMinDwellSeconds = 0.1;
+
+FrameRateGovernor::FrameRateGovernor() {
+  Reset();
+}
+
+FrameRateGovernor::~FrameRateGovernor() {}
+
+int FrameRateGovernor::Update(double time_seconds, int predicted_fps) {
+  if (!has_rate_) {
+    has_rate_ = true;
+    smoothed_fps_ = predicted_fps;
+    frame_rate_ = predicted_fps;
+    last_change_seconds_ = time_seconds;
+    return frame_rate_;
+  }
+
+  double weight =
+      predicted_fps > smoothed_fps_ ? kRampUpWeight : kRampDownWeight;
+  smoothed_fps_ += weight * (predicted_fps - smoothed_fps_);
+
+  // Like ClampPredictedFrameRate(), round up so that pacing errs on the
+  // smooth side.
+  int candidate = static_cast<int>(std::ceil(smoothed_fps_ - kRoundingSlack));
+  if (candidate != frame_rate_ &&
+      time_seconds - last_change_seconds_ >= kMinDwellSeconds) {
+    frame_rate_ = candidate;
+    last_change_seconds_ = time_seconds;
+  }
+  return frame_rate_;
+}
+
+void FrameRateGovernor::Reset() {
+  has_rate_ = false;
+  smoothed_fps_ = 0;
+  frame_rate_ = 0;
+  last_change_seconds_ = 0;
+}
+
+}  // namespace ui
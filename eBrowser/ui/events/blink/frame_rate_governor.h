@@ -0,0 +1,53 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_FRAME_RATE_GOVERNOR_H_
+#define UI_EVENTS_BLINK_FRAME_RATE_GOVERNOR_H_
+
+#include "base/macros.h"
+
+namespace ui {
+
+// Sits between the frame rate model and ScrollUpdatePacer. The model is
+// evaluated from scratch for every event, so its output can flip between
+// adjacent rates from one update to the next, which shows up as judder and as
+// frames spent on a rate that is abandoned right away. The governor smooths
+// the predictions with an exponentially weighted moving average that follows
+// rising rates faster than falling ones, and holds each rate it settles on for
+// at least |kMinDwellSeconds|.
+class FrameRateGovernor {
+ public:
+  // EWMA weights of a new prediction above or below the current average.
+  // Ramping up quickly keeps a speeding finger from being paced too low.
+  static const double kRampUpWeight;
+  static const double kRampDownWeight;
+  // Shortest time between two changes of the governed rate.
+  static const double kMinDwellSeconds;
+
+  FrameRateGovernor();
+  ~FrameRateGovernor();
+
+  // Feeds the rate predicted for an event at |time_seconds| and returns the
+  // rate to pace at. The first prediction after Reset() is taken as is.
+  // Events must arrive in non-decreasing time order.
+  int Update(double time_seconds, int predicted_fps);
+
+  // The rate returned by the last Update().
+  int frame_rate() const { return frame_rate_; }
+
+  // Forgets the history. Called at the start of each scroll gesture.
+  void Reset();
+
+ private:
+  bool has_rate_;
+  double smoothed_fps_;
+  int frame_rate_;
+  double last_change_seconds_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameRateGovernor);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_FRAME_RATE_GOVERNOR_H_
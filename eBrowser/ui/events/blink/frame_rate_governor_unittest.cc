@@ -0,0 +1,79 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/frame_rate_governor.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+const double kFrameSeconds = 1. / 60;
+
+TEST(FrameRateGovernorTest, FirstPredictionIsTakenAsIs) {
+  FrameRateGovernor governor;
+  EXPECT_EQ(30, governor.Update(0, 30));
+  for (int i = 1; i < 30; ++i)
+    EXPECT_EQ(30, governor.Update(i * kFrameSeconds, 30));
+}
+
+TEST(FrameRateGovernorTest, DampsAlternatingPredictions) {
+  FrameRateGovernor governor;
+  governor.Update(0, 40);
+  int changes = 0;
+  int last = governor.frame_rate();
+  // One second of predictions flipping between 30 and 40fps.
+  for (int i = 1; i < 60; ++i) {
+    int fps = governor.Update(i * kFrameSeconds, i % 2 ? 30 : 40);
+    EXPECT_GE(fps, 30);
+    EXPECT_LE(fps, 40);
+    if (fps != last)
+      ++changes;
+    last = fps;
+  }
+  // Without the governor this would be 59 changes; the dwell time allows at
+  // most one per six events.
+  EXPECT_LE(changes, 10);
+}
+
+TEST(FrameRateGovernorTest, HoldsEachRateForTheDwellTime) {
+  FrameRateGovernor governor;
+  governor.Update(0, 60);
+  // The drop is seen, but the rate is not changed again within the dwell
+  // time even though the average keeps falling.
+  EXPECT_GT(60, governor.Update(FrameRateGovernor::kMinDwellSeconds, 24));
+  int held = governor.frame_rate();
+  EXPECT_EQ(held, governor.Update(
+                      FrameRateGovernor::kMinDwellSeconds + kFrameSeconds, 24));
+}
+
+TEST(FrameRateGovernorTest, RampsUpFasterThanDown) {
+  FrameRateGovernor down;
+  FrameRateGovernor up;
+  down.Update(0, 60);
+  up.Update(0, 24);
+  double t = FrameRateGovernor::kMinDwellSeconds;
+  int fps_down = down.Update(t, 24);
+  int fps_up = up.Update(t, 60);
+  EXPECT_LT(60 - fps_down, fps_up - 24);
+}
+
+TEST(FrameRateGovernorTest, ConvergesOnASteadyPrediction) {
+  FrameRateGovernor governor;
+  governor.Update(0, 60);
+  int fps = 0;
+  for (int i = 1; i < 120; ++i)
+    fps = governor.Update(i * kFrameSeconds, 30);
+  EXPECT_EQ(30, fps);
+}
+
+TEST(FrameRateGovernorTest, ResetForgetsHistory) {
+  FrameRateGovernor governor;
+  governor.Update(0, 60);
+  governor.Reset();
+  EXPECT_EQ(24, governor.Update(kFrameSeconds, 24));
+}
+
+}  // namespace
+}  // namespace ui
@@ -0,0 +1,226 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/frame_rate_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "ui/events/blink/default_frame_rate_table.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+#include "ui/events/blink/svm_predictor.h"
+
+namespace ui {
+
+namespace {
+
+// exp(-16) is small enough that even a support vector with the trainer's
+// maximum coefficient (C = 1000) moves the output by well under one frame.
+const double kKernelTailExponent = 16.;
+
+// Bounds the memory a bad |step| could make us allocate.
+const size_t kMaxTableSize = 1 << 16;
+
+constexpr size_t kDefaultTableSize =
+    sizeof(default_frame_rate_table::kFrameRates);
+
+// Checks the generated table at compile time, as CreateFromString() would
+// at run time.
+constexpr bool IsValidDefaultTable(size_t i) {
+  return i == kDefaultTableSize ||
+         (default_frame_rate_table::kFrameRates[i] > 0 &&
+          default_frame_rate_table::kFrameRates[i] <=
+              ScrollUpdatePacer::kMaxFrameRate &&
+          IsValidDefaultTable(i + 1));
+}
+static_assert(default_frame_rate_table::kStep > 0 &&
+                  kDefaultTableSize > 0 && IsValidDefaultTable(0),
+              "default_frame_rate_table.h is not a valid table");
+
+// Number of intervals each bucket is split into when evaluating the exact
+// model to measure the quantization error.
+const int kProbesPerBucket = 4;
+
+// First line of a table in the text format.
+const char kTableMagic[] = "frame_rate_table";
+
+}  // namespace
+
+// static
+std::unique_ptr<FrameRateTable> FrameRateTable::Create(
+    const SvmPredictor& predictor,
+    double step) {
+  if (!(step > 0) || predictor.num_features() != 1)
+    return nullptr;
+
+  double max_speed = predictor.max_support_vector_value();
+  if (predictor.gamma() > 0)
+    max_speed += std::sqrt(kKernelTailExponent / predictor.gamma());
+  double buckets = std::ceil(max_speed / step) + 1;
+  if (buckets > kMaxTableSize)
+    return nullptr;
+
+  std::vector<uint8_t> frame_rates(static_cast<size_t>(buckets));
+  // Each bucket's speed, then its probes from the lower to the upper edge of
+  // the bucket, staying just inside the upper edge so that the probe does not
+  // round to bucket i + 1. All are evaluated in one batch.
+  const size_t kSpeedsPerBucket = kProbesPerBucket + 2;
+  std::vector<float> speeds(frame_rates.size() * kSpeedsPerBucket);
+  for (size_t i = 0; i < frame_rates.size(); ++i) {
+    speeds[i * kSpeedsPerBucket] = static_cast<float>(i * step);
+    for (int probe = 0; probe <= kProbesPerBucket; ++probe) {
+      double offset = std::min(
+          static_cast<double>(probe) / kProbesPerBucket - 0.5, 0.499);
+      speeds[i * kSpeedsPerBucket + probe + 1] =
+          static_cast<float>(std::max(0.0, (i + offset) * step));
+    }
+  }
+  std::vector<double> predictions(speeds.size());
+  predictor.PredictBatch(speeds.data(), static_cast<int>(speeds.size()),
+                         predictions.data());
+
+  int max_error = 0;
+  for (size_t i = 0; i < frame_rates.size(); ++i) {
+    const double* bucket = &predictions[i * kSpeedsPerBucket];
+    int fps = ClampPredictedFrameRate(bucket[0]);
+    frame_rates[i] = static_cast<uint8_t>(fps);
+    for (int probe = 0; probe <= kProbesPerBucket; ++probe) {
+      int exact = ClampPredictedFrameRate(bucket[probe + 1]);
+      max_error = std::max(max_error, std::abs(exact - fps));
+    }
+  }
+
+  return base::WrapUnique(
+      new FrameRateTable(step, std::move(frame_rates), max_error));
+}
+
+// static
+std::unique_ptr<FrameRateTable> FrameRateTable::CreateFromString(
+    const std::string& table_str) {
+  std::vector<base::StringPiece> lines = base::SplitStringPiece(
+      table_str, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (lines.empty() || lines[0] != kTableMagic)
+    return nullptr;
+
+  double step = 0;
+  int max_error = -1;
+  std::vector<uint8_t> frame_rates;
+  for (size_t i = 1; i < lines.size(); ++i) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        lines[i], " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields[0] == "step") {
+      if (fields.size() != 2 ||
+          !base::StringToDouble(fields[1].as_string(), &step)) {
+        return nullptr;
+      }
+    } else if (fields[0] == "max_error") {
+      if (fields.size() != 2 || !base::StringToInt(fields[1], &max_error))
+        return nullptr;
+    } else if (fields[0] == "frame_rates") {
+      if (fields.size() - 1 > kMaxTableSize)
+        return nullptr;
+      for (size_t j = 1; j < fields.size(); ++j) {
+        int fps;
+        // Only rates ClampPredictedFrameRate() can produce are accepted.
+        if (!base::StringToInt(fields[j], &fps) ||
+            ClampPredictedFrameRate(fps) != fps) {
+          return nullptr;
+        }
+        frame_rates.push_back(static_cast<uint8_t>(fps));
+      }
+    }
+    // Other lines, such as the version, are for the server's caching.
+  }
+  if (!(step > 0) || max_error < 0 || frame_rates.empty())
+    return nullptr;
+
+  return base::WrapUnique(
+      new FrameRateTable(step, std::move(frame_rates), max_error));
+}
+
+// static
+std::unique_ptr<FrameRateTable> FrameRateTable::CreateFromBinary(
+    const void* data,
+    size_t size) {
+  if (!IsBinaryTable(data, size) || size < sizeof(FrameRateTableHeader))
+    return nullptr;
+  FrameRateTableHeader header;
+  memcpy(&header, data, sizeof(header));
+  if (header.version != kFrameRateTableVersion || !(header.step > 0) ||
+      header.size == 0 || header.size > kMaxTableSize ||
+      size - sizeof(header) != header.size) {
+    return nullptr;
+  }
+
+  const uint8_t* rates = static_cast<const uint8_t*>(data) + sizeof(header);
+  std::vector<uint8_t> frame_rates(rates, rates + header.size);
+  for (uint8_t fps : frame_rates) {
+    if (ClampPredictedFrameRate(fps) != fps)
+      return nullptr;
+  }
+  return base::WrapUnique(
+      new FrameRateTable(header.step, std::move(frame_rates),
+                         header.max_error));
+}
+
+// static
+bool FrameRateTable::IsBinaryTable(const void* data, size_t size) {
+  uint32_t magic;
+  if (!data || size < sizeof(magic))
+    return false;
+  memcpy(&magic, data, sizeof(magic));
+  return magic == kFrameRateTableMagic;
+}
+
+// static
+int FrameRateTable::LookupDefault(double speed) {
+  if (speed <= 0)
+    return default_frame_rate_table::kFrameRates[0];
+  size_t bucket = static_cast<size_t>(
+      speed * (1. / default_frame_rate_table::kStep) + 0.5);
+  if (bucket >= kDefaultTableSize)
+    return default_frame_rate_table::kFrameRates[kDefaultTableSize - 1];
+  return default_frame_rate_table::kFrameRates[bucket];
+}
+
+std::vector<uint8_t> FrameRateTable::SerializeToBinary() const {
+  FrameRateTableHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kFrameRateTableMagic;
+  header.version = kFrameRateTableVersion;
+  header.max_error = static_cast<uint16_t>(
+      std::min(max_error_,
+               static_cast<int>(std::numeric_limits<uint16_t>::max())));
+  header.size = static_cast<uint32_t>(frame_rates_.size());
+  header.step = step_;
+
+  std::vector<uint8_t> result(sizeof(header) + frame_rates_.size());
+  memcpy(result.data(), &header, sizeof(header));
+  memcpy(result.data() + sizeof(header), frame_rates_.data(),
+         frame_rates_.size());
+  return result;
+}
+
+FrameRateTable::FrameRateTable(double step,
+                               std::vector<uint8_t> frame_rates,
+                               int max_error)
+    : step_(step),
+      inverse_step_(1. / step),
+      frame_rates_(std::move(frame_rates)),
+      max_error_(max_error) {
+  DCHECK(!frame_rates_.empty());
+}
+
+FrameRateTable::~FrameRateTable() {}
+
+}  // namespace ui
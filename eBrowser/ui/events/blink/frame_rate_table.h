@@ -0,0 +1,116 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_FRAME_RATE_TABLE_H_
+#define UI_EVENTS_BLINK_FRAME_RATE_TABLE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace ui {
+
+class SvmPredictor;
+
+// Binary table format, version 1, for tables compiled on the device and
+// cached across restarts. All fields are little-endian:
+//   FrameRateTableHeader
+//   uint8_t frame_rates[size]
+const uint32_t kFrameRateTableMagic = 0x54464245;  // "EBFT"
+const uint16_t kFrameRateTableVersion = 1;
+
+struct FrameRateTableHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t max_error;
+  uint32_t size;
+  uint32_t reserved;
+  double step;
+};
+static_assert(sizeof(FrameRateTableHeader) == 24,
+              "FrameRateTableHeader layout is part of the table format");
+
+// A quantized speed -> frame rate table compiled from an SvmPredictor. The
+// model has a single input feature and its output is clamped to a small
+// integer range, so the RBF kernel sum can be sampled once when a model
+// arrives and each scroll update becomes an O(1) lookup. The cloud trainer
+// can also compile the table itself (/model/table), in which case the device
+// never sees the model.
+class FrameRateTable {
+ public:
+  // Samples |predictor| every |step| units of speed, from zero up to the
+  // point where the kernel sum has decayed to its constant tail. Returns
+  // nullptr if |step| is not positive, the table would be unreasonably large,
+  // or the model reads more than the speed feature.
+  static std::unique_ptr<FrameRateTable> Create(const SvmPredictor& predictor,
+                                                double step);
+
+  // Parses a table compiled by the cloud trainer:
+  //
+  //   frame_rate_table
+  //   version <opaque>
+  //   step <speed units per bucket>
+  //   max_error <fps>
+  //   frame_rates <fps of bucket 0> <fps of bucket 1> ...
+  //
+  // Bucket i holds the clamped frame rate at speed i * step, as Create()
+  // would compute it. Returns nullptr if |table_str| is not such a table.
+  static std::unique_ptr<FrameRateTable> CreateFromString(
+      const std::string& table_str);
+
+  // Reads a table in the binary format. Tables are small, so the frame rates
+  // are copied and |data| need not outlive the table. Returns nullptr if the
+  // header or the rates do not check out.
+  static std::unique_ptr<FrameRateTable> CreateFromBinary(const void* data,
+                                                          size_t size);
+
+  // Returns true if |data| starts with the binary format's magic number.
+  static bool IsBinaryTable(const void* data, size_t size);
+
+  // Like Lookup(), in the population table compiled into the binary, which
+  // paces scrolls before the device has a model of its own. Costs no load or
+  // parse.
+  static int LookupDefault(double speed);
+
+  // Writes the table in the binary format.
+  std::vector<uint8_t> SerializeToBinary() const;
+
+  ~FrameRateTable();
+
+  // Returns the clamped frame rate for |speed|, as ClampPredictedFrameRate()
+  // would for the exact model, up to |max_error()|.
+  int Lookup(double speed) const {
+    if (speed <= 0)
+      return frame_rates_.front();
+    size_t bucket = static_cast<size_t>(speed * inverse_step_ + 0.5);
+    if (bucket >= frame_rates_.size())
+      return frame_rates_.back();
+    return frame_rates_[bucket];
+  }
+
+  double step() const { return step_; }
+  size_t size() const { return frame_rates_.size(); }
+
+  // Largest difference, in frames per second, between the table and the
+  // clamped exact model seen while probing each bucket at several points.
+  int max_error() const { return max_error_; }
+
+ private:
+  FrameRateTable(double step, std::vector<uint8_t> frame_rates, int max_error);
+
+  const double step_;
+  const double inverse_step_;
+  const std::vector<uint8_t> frame_rates_;
+  const int max_error_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameRateTable);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_FRAME_RATE_TABLE_H_
@@ -0,0 +1,177 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/frame_rate_table.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/svm_predictor.h"
+
+namespace ui {
+namespace {
+
+// Outputs range between roughly 20fps and 40fps over speeds 0 to 5.
+const char kTestModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.5\n"
+    "nr_class 2\n"
+    "total_sv 2\n"
+    "rho -30\n"
+    "SV\n"
+    "10 1:1\n"
+    "-10 1:3\n";
+
+class FrameRateTableTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    predictor_ = SvmPredictor::Create(kTestModel);
+    ASSERT_TRUE(predictor_);
+  }
+
+  std::unique_ptr<SvmPredictor> predictor_;
+};
+
+TEST_F(FrameRateTableTest, RejectsInvalidStep) {
+  EXPECT_FALSE(FrameRateTable::Create(*predictor_, 0));
+  EXPECT_FALSE(FrameRateTable::Create(*predictor_, -1));
+  EXPECT_FALSE(FrameRateTable::Create(*predictor_, 1e-9));
+}
+
+TEST_F(FrameRateTableTest, RejectsMultiFeatureModels) {
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -30\n"
+      "SV\n"
+      "10 1:1 3:5\n");
+  ASSERT_TRUE(predictor);
+  EXPECT_FALSE(FrameRateTable::Create(*predictor, 0.5));
+}
+
+TEST_F(FrameRateTableTest, MatchesExactModelWithinReportedError) {
+  std::unique_ptr<FrameRateTable> table =
+      FrameRateTable::Create(*predictor_, 0.05);
+  ASSERT_TRUE(table);
+  EXPECT_LE(table->max_error(), 1);
+  for (double speed = 0; speed < 20; speed += 0.013) {
+    int exact = ClampPredictedFrameRate(predictor_->Predict(speed));
+    EXPECT_NEAR(exact, table->Lookup(speed), table->max_error()) << speed;
+  }
+}
+
+TEST_F(FrameRateTableTest, CoarseStepReportsLargerError) {
+  std::unique_ptr<FrameRateTable> fine =
+      FrameRateTable::Create(*predictor_, 0.05);
+  std::unique_ptr<FrameRateTable> coarse =
+      FrameRateTable::Create(*predictor_, 2);
+  ASSERT_TRUE(fine);
+  ASSERT_TRUE(coarse);
+  EXPECT_LT(coarse->size(), fine->size());
+  EXPECT_GE(coarse->max_error(), fine->max_error());
+}
+
+TEST_F(FrameRateTableTest, ClampsOutOfRangeSpeeds) {
+  std::unique_ptr<FrameRateTable> table =
+      FrameRateTable::Create(*predictor_, 0.1);
+  ASSERT_TRUE(table);
+  EXPECT_EQ(table->Lookup(0), table->Lookup(-5));
+  // Far from every support vector only the bias remains.
+  EXPECT_EQ(30, table->Lookup(1e6));
+}
+
+TEST(FrameRateTableParseTest, ParsesCompiledTable) {
+  std::unique_ptr<FrameRateTable> table = FrameRateTable::CreateFromString(
+      "frame_rate_table\n"
+      "version 1a2b3c-0.5\n"
+      "step 0.5\n"
+      "max_error 1\n"
+      "frame_rates 24 30 41 60\n");
+  ASSERT_TRUE(table);
+  EXPECT_EQ(4u, table->size());
+  EXPECT_EQ(0.5, table->step());
+  EXPECT_EQ(1, table->max_error());
+  EXPECT_EQ(24, table->Lookup(-1));
+  EXPECT_EQ(30, table->Lookup(0.6));
+  EXPECT_EQ(41, table->Lookup(1.1));
+  EXPECT_EQ(60, table->Lookup(100));
+}
+
+TEST(FrameRateTableParseTest, DefaultTableCoversSpeedRange) {
+  int slowest = FrameRateTable::LookupDefault(0);
+  EXPECT_EQ(slowest, FrameRateTable::LookupDefault(-1));
+  EXPECT_LT(slowest, 60);
+  // Faster scrolls never get a lower rate, and the fastest run unthrottled.
+  int last = slowest;
+  for (double speed = 0; speed < 10000; speed += 100) {
+    int fps = FrameRateTable::LookupDefault(speed);
+    EXPECT_GE(fps, last) << speed;
+    last = fps;
+  }
+  EXPECT_EQ(60, FrameRateTable::LookupDefault(1e6));
+}
+
+TEST(FrameRateTableParseTest, RejectsMalformedTables) {
+  // A libsvm model is not a table.
+  EXPECT_FALSE(FrameRateTable::CreateFromString(kTestModel));
+  EXPECT_FALSE(FrameRateTable::CreateFromString(
+      "frame_rate_table\nstep 0\nmax_error 0\nframe_rates 30\n"));
+  EXPECT_FALSE(FrameRateTable::CreateFromString(
+      "frame_rate_table\nstep 0.1\nmax_error 0\nframe_rates\n"));
+  EXPECT_FALSE(FrameRateTable::CreateFromString(
+      "frame_rate_table\nstep 0.1\nframe_rates 30\n"));
+  // 5fps is below what a model is allowed to slow scrolling to.
+  EXPECT_FALSE(FrameRateTable::CreateFromString(
+      "frame_rate_table\nstep 0.1\nmax_error 0\nframe_rates 30 5\n"));
+  EXPECT_FALSE(FrameRateTable::CreateFromString(
+      "frame_rate_table\nstep 0.1\nmax_error 0\nframe_rates 30 x\n"));
+}
+
+TEST_F(FrameRateTableTest, BinaryRoundTrip) {
+  std::unique_ptr<FrameRateTable> table =
+      FrameRateTable::Create(*predictor_, 0.1);
+  ASSERT_TRUE(table);
+  std::vector<uint8_t> binary = table->SerializeToBinary();
+  EXPECT_EQ(sizeof(FrameRateTableHeader) + table->size(), binary.size());
+  EXPECT_TRUE(FrameRateTable::IsBinaryTable(binary.data(), binary.size()));
+
+  std::unique_ptr<FrameRateTable> loaded =
+      FrameRateTable::CreateFromBinary(binary.data(), binary.size());
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(table->size(), loaded->size());
+  EXPECT_EQ(table->step(), loaded->step());
+  EXPECT_EQ(table->max_error(), loaded->max_error());
+  for (double speed = 0; speed < 20; speed += 0.07)
+    EXPECT_EQ(table->Lookup(speed), loaded->Lookup(speed)) << speed;
+}
+
+TEST_F(FrameRateTableTest, RejectsMalformedBinaryTables) {
+  std::unique_ptr<FrameRateTable> table =
+      FrameRateTable::Create(*predictor_, 0.1);
+  ASSERT_TRUE(table);
+  std::vector<uint8_t> binary = table->SerializeToBinary();
+
+  EXPECT_FALSE(FrameRateTable::CreateFromBinary(binary.data(),
+                                                binary.size() - 1));
+  EXPECT_FALSE(FrameRateTable::CreateFromBinary(binary.data(),
+                                                sizeof(uint32_t)));
+
+  std::vector<uint8_t> bad_version = binary;
+  bad_version[4] = 2;
+  EXPECT_FALSE(FrameRateTable::CreateFromBinary(bad_version.data(),
+                                                bad_version.size()));
+
+  std::vector<uint8_t> bad_rate = binary;
+  bad_rate.back() = 5;
+  EXPECT_FALSE(
+      FrameRateTable::CreateFromBinary(bad_rate.data(), bad_rate.size()));
+
+  // Text tables and models are not binary tables.
+  EXPECT_FALSE(FrameRateTable::IsBinaryTable(kTestModel, sizeof(kTestModel)));
+}
+
+}  // namespace
+}  // namespace ui
@@ -0,0 +1,111 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/gesture_cpu_usage.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+
+namespace ui {
+
+namespace {
+
+const char kCpuRoot[] = "/sys/devices/system/cpu";
+
+// Reads a cpuidle "time" file, which holds microseconds.
+bool ReadStateTime(const base::FilePath& path, int64_t* time_us) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+  return base::StringToInt64(
+      base::TrimWhitespaceASCII(contents, base::TRIM_ALL), time_us);
+}
+
+}  // namespace
+
+GestureCpuUsage::Sample::Sample()
+    : has_idle_residency(false), cpu_count(0) {}
+
+GestureCpuUsage::GestureCpuUsage()
+    : in_gesture_(false),
+      has_begin_idle_residency_(false),
+      begin_cpu_count_(0) {}
+
+GestureCpuUsage::~GestureCpuUsage() {}
+
+void GestureCpuUsage::Begin(bool read_idle_residency) {
+  in_gesture_ = true;
+  begin_time_ = base::TimeTicks::Now();
+  begin_thread_time_ = base::ThreadTicks::IsSupported()
+                           ? base::ThreadTicks::Now()
+                           : base::ThreadTicks();
+  has_begin_idle_residency_ =
+      read_idle_residency &&
+      ReadIdleResidency(base::FilePath(kCpuRoot), &begin_idle_residency_,
+                        &begin_cpu_count_);
+}
+
+bool GestureCpuUsage::End(Sample* sample) {
+  if (!in_gesture_)
+    return false;
+  in_gesture_ = false;
+
+  *sample = Sample();
+  sample->wall_time = base::TimeTicks::Now() - begin_time_;
+  if (!begin_thread_time_.is_null())
+    sample->thread_time = base::ThreadTicks::Now() - begin_thread_time_;
+
+  base::TimeDelta idle_residency;
+  int cpu_count = 0;
+  // CPUs going offline mid-gesture would skew the difference.
+  if (has_begin_idle_residency_ &&
+      ReadIdleResidency(base::FilePath(kCpuRoot), &idle_residency,
+                        &cpu_count) &&
+      cpu_count == begin_cpu_count_) {
+    sample->has_idle_residency = true;
+    sample->idle_residency =
+        std::max(base::TimeDelta(), idle_residency - begin_idle_residency_);
+    sample->cpu_count = cpu_count;
+  }
+  return true;
+}
+
+// static
+bool GestureCpuUsage::ReadIdleResidency(const base::FilePath& cpu_root,
+                                        base::TimeDelta* residency,
+                                        int* cpu_count) {
+  int64_t total_us = 0;
+  int cpus = 0;
+  for (;; ++cpus) {
+    base::FilePath cpuidle =
+        cpu_root.Append(base::StringPrintf("cpu%d", cpus)).Append("cpuidle");
+    int64_t time_us = 0;
+    if (!ReadStateTime(cpuidle.Append("state0").Append("time"), &time_us))
+      break;
+    total_us += time_us;
+    for (int state = 1;; ++state) {
+      if (!ReadStateTime(
+              cpuidle.Append(base::StringPrintf("state%d", state))
+                  .Append("time"),
+              &time_us)) {
+        break;
+      }
+      total_us += time_us;
+    }
+  }
+  if (!cpus)
+    return false;
+  *residency = base::TimeDelta::FromMicroseconds(total_us);
+  *cpu_count = cpus;
+  return true;
+}
+
+}  // namespace ui
@@ -0,0 +1,64 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_GESTURE_CPU_USAGE_H_
+#define UI_EVENTS_BLINK_GESTURE_CPU_USAGE_H_
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace ui {
+
+// Measures how much CPU time the calling thread uses over a gesture, against
+// the time the gesture lasted, to tell a thread that paced its work and went
+// idle from one that was merely blocked. Optionally also measures how long
+// the CPUs spent in cpuidle states meanwhile, where sysfs exposes them.
+class GestureCpuUsage {
+ public:
+  struct Sample {
+    Sample();
+
+    base::TimeDelta wall_time;
+    // Zero where base::ThreadTicks is not supported.
+    base::TimeDelta thread_time;
+    // Summed over |cpu_count| CPUs; only set if |has_idle_residency|.
+    bool has_idle_residency;
+    base::TimeDelta idle_residency;
+    int cpu_count;
+  };
+
+  GestureCpuUsage();
+  ~GestureCpuUsage();
+
+  // Starts a measurement, dropping any that was not ended. Reading the idle
+  // residency costs a few dozen file reads, so it is only done on request.
+  void Begin(bool read_idle_residency);
+  // Ends the measurement. Returns false if none was begun.
+  bool End(Sample* sample);
+
+  bool in_gesture() const { return in_gesture_; }
+
+  // Sums the time each CPU under |cpu_root| (/sys/devices/system/cpu on
+  // Linux) has spent in any of its cpuidle states. Returns false if there is
+  // no cpuidle information, e.g. outside Android or when the sandbox denies
+  // access.
+  static bool ReadIdleResidency(const base::FilePath& cpu_root,
+                                base::TimeDelta* residency,
+                                int* cpu_count);
+
+ private:
+  bool in_gesture_;
+  base::TimeTicks begin_time_;
+  base::ThreadTicks begin_thread_time_;
+  bool has_begin_idle_residency_;
+  base::TimeDelta begin_idle_residency_;
+  int begin_cpu_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(GestureCpuUsage);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_GESTURE_CPU_USAGE_H_
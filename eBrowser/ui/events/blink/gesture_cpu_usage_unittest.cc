@@ -0,0 +1,77 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/gesture_cpu_usage.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+void WriteStateTime(const base::FilePath& cpu_root,
+                    int cpu,
+                    int state,
+                    const std::string& time_us) {
+  base::FilePath dir = cpu_root.Append(base::StringPrintf("cpu%d", cpu))
+                           .Append("cpuidle")
+                           .Append(base::StringPrintf("state%d", state));
+  ASSERT_TRUE(base::CreateDirectory(dir));
+  ASSERT_EQ(static_cast<int>(time_us.size()),
+            base::WriteFile(dir.Append("time"), time_us.data(),
+                            time_us.size()));
+}
+
+TEST(GestureCpuUsageTest, EndWithoutBegin) {
+  GestureCpuUsage usage;
+  GestureCpuUsage::Sample sample;
+  EXPECT_FALSE(usage.End(&sample));
+
+  usage.Begin(false);
+  EXPECT_TRUE(usage.in_gesture());
+  EXPECT_TRUE(usage.End(&sample));
+  EXPECT_FALSE(usage.in_gesture());
+  EXPECT_GE(sample.wall_time, base::TimeDelta());
+  EXPECT_GE(sample.thread_time, base::TimeDelta());
+  EXPECT_FALSE(sample.has_idle_residency);
+  EXPECT_FALSE(usage.End(&sample));
+}
+
+TEST(GestureCpuUsageTest, SumsIdleStatesOfEachCpu) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath& root = temp_dir.GetPath();
+  WriteStateTime(root, 0, 0, "1000\n");
+  WriteStateTime(root, 0, 1, "250000\n");
+  WriteStateTime(root, 1, 0, "500\n");
+  // cpu3 is not counted past the missing cpu2.
+  WriteStateTime(root, 3, 0, "7");
+
+  base::TimeDelta residency;
+  int cpu_count = 0;
+  ASSERT_TRUE(GestureCpuUsage::ReadIdleResidency(root, &residency, &cpu_count));
+  EXPECT_EQ(2, cpu_count);
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(251500), residency);
+}
+
+TEST(GestureCpuUsageTest, NoCpuidle) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::TimeDelta residency;
+  int cpu_count = 0;
+  EXPECT_FALSE(GestureCpuUsage::ReadIdleResidency(temp_dir.GetPath(),
+                                                  &residency, &cpu_count));
+
+  // Unparsable times are treated as missing.
+  WriteStateTime(temp_dir.GetPath(), 0, 0, "n/a");
+  EXPECT_FALSE(GestureCpuUsage::ReadIdleResidency(temp_dir.GetPath(),
+                                                  &residency, &cpu_count));
+}
+
+}  // namespace
+}  // namespace ui
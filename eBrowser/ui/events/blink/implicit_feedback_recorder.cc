@@ -0,0 +1,149 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/implicit_feedback_recorder.h"
+
+#include <cmath>
+
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace ui {
+
+namespace {
+
+// Scrolls shorter than this, in pixels, that end without a fling were given
+// up on rather than finished.
+const float kAbandonDistance = 64;
+// Turning back is only telling after a run long enough to have been aimed.
+const float kReversalDistance = 192;
+// A scroll begun this soon after a fling tick corrects where the fling went.
+const int kRescrollWindowMs = 500;
+// Updates are due within one frame at the target rate; waiting over this
+// many means frames were missed.
+const int kDroppedFrames = 2;
+
+bool IsThrottled(int fps) {
+  return fps < ScrollUpdatePacer::kMaxFrameRate;
+}
+
+}  // namespace
+
+ImplicitFeedbackSample::ImplicitFeedbackSample()
+    : type(IMPLICIT_FEEDBACK_ABANDONED), speed(0), fps(0) {}
+
+ImplicitFeedbackSample::ImplicitFeedbackSample(ImplicitFeedbackType type,
+                                               float speed,
+                                               int fps)
+    : type(type), speed(speed), fps(fps) {}
+
+const size_t ImplicitFeedbackRecorder::kBatchSize;
+const size_t ImplicitFeedbackRecorder::kCapacity;
+
+ImplicitFeedbackRecorder::ImplicitFeedbackRecorder()
+    : start_(0),
+      count_(0),
+      in_scroll_(false),
+      scroll_throttled_(false),
+      scroll_distance_(0),
+      run_distance_(0),
+      speed_(0),
+      fps_(ScrollUpdatePacer::kMaxFrameRate),
+      in_dropped_frame_burst_(false),
+      fling_speed_(0),
+      fling_fps_(ScrollUpdatePacer::kMaxFrameRate) {}
+
+ImplicitFeedbackRecorder::~ImplicitFeedbackRecorder() {}
+
+void ImplicitFeedbackRecorder::OnScrollBegin(base::TimeTicks time) {
+  if (!last_fling_tick_time_.is_null() && time >= last_fling_tick_time_ &&
+      time - last_fling_tick_time_ <=
+          base::TimeDelta::FromMilliseconds(kRescrollWindowMs)) {
+    Record(IMPLICIT_FEEDBACK_RESCROLL_AFTER_FLING, fling_speed_, fling_fps_);
+  }
+  last_fling_tick_time_ = base::TimeTicks();
+  in_scroll_ = true;
+  scroll_throttled_ = false;
+  scroll_distance_ = 0;
+  run_distance_ = 0;
+  speed_ = 0;
+  fps_ = ScrollUpdatePacer::kMaxFrameRate;
+  in_dropped_frame_burst_ = false;
+}
+
+void ImplicitFeedbackRecorder::OnScrollUpdate(float delta,
+                                              float speed,
+                                              int fps) {
+  if (!in_scroll_)
+    return;
+  if (delta) {
+    scroll_distance_ += std::abs(delta);
+    if (run_distance_ && (run_distance_ > 0) != (delta > 0)) {
+      // Reported at the speed and rate of the run that was turned back; the
+      // scroll slows to a stop before it reverses.
+      if (std::abs(run_distance_) >= kReversalDistance && IsThrottled(fps_))
+        Record(IMPLICIT_FEEDBACK_DIRECTION_REVERSAL, speed_, fps_);
+      run_distance_ = 0;
+    }
+    run_distance_ += delta;
+  }
+  speed_ = speed;
+  fps_ = fps;
+  scroll_throttled_ |= IsThrottled(fps);
+}
+
+void ImplicitFeedbackRecorder::OnScrollEnd(bool flung) {
+  if (!in_scroll_)
+    return;
+  in_scroll_ = false;
+  if (!flung && scroll_throttled_ && scroll_distance_ < kAbandonDistance)
+    Record(IMPLICIT_FEEDBACK_ABANDONED, speed_, fps_);
+}
+
+void ImplicitFeedbackRecorder::OnFlingTick(base::TimeTicks time,
+                                           float speed,
+                                           int fps) {
+  if (!IsThrottled(fps))
+    return;
+  last_fling_tick_time_ = time;
+  fling_speed_ = speed;
+  fling_fps_ = fps;
+}
+
+void ImplicitFeedbackRecorder::OnPacedScrollUpdate(base::TimeDelta delay) {
+  if (!in_scroll_ || !IsThrottled(fps_))
+    return;
+  bool dropped = delay > base::TimeDelta::FromSecondsD(
+                             static_cast<double>(kDroppedFrames) / fps_);
+  // A burst is recorded once, however many updates it delays.
+  if (dropped && !in_dropped_frame_burst_)
+    Record(IMPLICIT_FEEDBACK_DROPPED_FRAME_BURST, speed_, fps_);
+  in_dropped_frame_burst_ = dropped;
+}
+
+bool ImplicitFeedbackRecorder::TakeBatch(
+    std::vector<ImplicitFeedbackSample>* batch) {
+  if (count_ < kBatchSize)
+    return false;
+  batch->clear();
+  batch->reserve(kBatchSize);
+  for (size_t i = 0; i < kBatchSize; ++i)
+    batch->push_back(samples_[(start_ + i) % kCapacity]);
+  start_ = (start_ + kBatchSize) % kCapacity;
+  count_ -= kBatchSize;
+  return true;
+}
+
+void ImplicitFeedbackRecorder::Record(ImplicitFeedbackType type,
+                                      float speed,
+                                      int fps) {
+  if (count_ == kCapacity) {
+    start_ = (start_ + 1) % kCapacity;
+    --count_;
+  }
+  samples_[(start_ + count_) % kCapacity] =
+      ImplicitFeedbackSample(type, speed, fps);
+  ++count_;
+}
+
+}  // namespace ui
@@ -0,0 +1,99 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_IMPLICIT_FEEDBACK_RECORDER_H_
+#define UI_EVENTS_BLINK_IMPLICIT_FEEDBACK_RECORDER_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace ui {
+
+// Behaviour suggesting that a throttled gesture ran at too low a rate.
+enum ImplicitFeedbackType {
+  // A scroll given up after a short distance, without a fling.
+  IMPLICIT_FEEDBACK_ABANDONED,
+  // A scroll that turned back after a long run in one direction.
+  IMPLICIT_FEEDBACK_DIRECTION_REVERSAL,
+  // A scroll begun shortly after a throttled fling.
+  IMPLICIT_FEEDBACK_RESCROLL_AFTER_FLING,
+  // Coalesced scroll updates that waited several frames to be applied.
+  IMPLICIT_FEEDBACK_DROPPED_FRAME_BURST,
+  IMPLICIT_FEEDBACK_TYPE_LAST = IMPLICIT_FEEDBACK_DROPPED_FRAME_BURST
+};
+
+struct ImplicitFeedbackSample {
+  ImplicitFeedbackSample();
+  ImplicitFeedbackSample(ImplicitFeedbackType type, float speed, int fps);
+
+  ImplicitFeedbackType type;
+  // The speed feature, in the units the models take, and the rate they chose
+  // for it.
+  float speed;
+  int fps;
+};
+
+// Derives feedback on the frame rate models from how a throttled gesture
+// goes, in place of the explicit feedback the user rarely gives. Samples are
+// kept in a fixed ring buffer, so recording allocates nothing, and handed
+// out in batches of kBatchSize; should batches not be taken, the oldest
+// samples are overwritten. Gestures at the full frame rate are not recorded.
+class ImplicitFeedbackRecorder {
+ public:
+  static const size_t kBatchSize = 16;
+  static const size_t kCapacity = 4 * kBatchSize;
+
+  ImplicitFeedbackRecorder();
+  ~ImplicitFeedbackRecorder();
+
+  void OnScrollBegin(base::TimeTicks time);
+  // |speed| and |fps| are the model input and output for the update.
+  void OnScrollUpdate(float delta, float speed, int fps);
+  // |flung| is true when the scroll ended in a fling.
+  void OnScrollEnd(bool flung);
+  // Called for each fling tick, at the rate predicted for the fling.
+  void OnFlingTick(base::TimeTicks time, float speed, int fps);
+  // Called when coalesced scroll updates are applied, |delay| after the
+  // oldest of them arrived.
+  void OnPacedScrollUpdate(base::TimeDelta delay);
+
+  // Moves the oldest kBatchSize samples to |batch|. Returns false, leaving
+  // |batch| alone, while fewer are recorded.
+  bool TakeBatch(std::vector<ImplicitFeedbackSample>* batch);
+
+  size_t size() const { return count_; }
+
+ private:
+  void Record(ImplicitFeedbackType type, float speed, int fps);
+
+  ImplicitFeedbackSample samples_[kCapacity];
+  size_t start_;
+  size_t count_;
+
+  // The scroll in progress.
+  bool in_scroll_;
+  bool scroll_throttled_;
+  float scroll_distance_;
+  // Distance covered since the scroll last changed direction, signed.
+  float run_distance_;
+  float speed_;
+  int fps_;
+  // Whether the current run of delayed updates has been recorded.
+  bool in_dropped_frame_burst_;
+
+  // The last throttled fling tick.
+  base::TimeTicks last_fling_tick_time_;
+  float fling_speed_;
+  int fling_fps_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImplicitFeedbackRecorder);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_IMPLICIT_FEEDBACK_RECORDER_H_
@@ -0,0 +1,120 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/implicit_feedback_recorder.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+const size_t kBatchSize = ImplicitFeedbackRecorder::kBatchSize;
+
+base::TimeTicks Ms(int ms) {
+  return base::TimeTicks() + base::TimeDelta::FromMilliseconds(ms);
+}
+
+// Records |count| abandoned scrolls at 30fps.
+void AbandonScrolls(ImplicitFeedbackRecorder* recorder, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    recorder->OnScrollBegin(Ms(10000 * (i + 1)));
+    recorder->OnScrollUpdate(10, 5, 30);
+    recorder->OnScrollEnd(false);
+  }
+}
+
+TEST(ImplicitFeedbackRecorderTest, ShortThrottledScrollIsAbandoned) {
+  ImplicitFeedbackRecorder recorder;
+  AbandonScrolls(&recorder, 1);
+  EXPECT_EQ(1u, recorder.size());
+
+  // Long, flung or unthrottled scrolls are not.
+  recorder.OnScrollBegin(Ms(1000));
+  recorder.OnScrollUpdate(100, 5, 30);
+  recorder.OnScrollEnd(false);
+  recorder.OnScrollBegin(Ms(2000));
+  recorder.OnScrollUpdate(10, 5, 30);
+  recorder.OnScrollEnd(true);
+  recorder.OnScrollBegin(Ms(3000));
+  recorder.OnScrollUpdate(10, 5, 60);
+  recorder.OnScrollEnd(false);
+  EXPECT_EQ(1u, recorder.size());
+}
+
+TEST(ImplicitFeedbackRecorderTest, ReversalAfterLongRun) {
+  ImplicitFeedbackRecorder recorder;
+  recorder.OnScrollBegin(Ms(0));
+  for (int i = 0; i < 20; ++i)
+    recorder.OnScrollUpdate(20, 12, 24);
+  // Slowing down keeps the direction.
+  recorder.OnScrollUpdate(2, 1, 30);
+  recorder.OnScrollUpdate(-20, 8, 40);
+  recorder.OnScrollEnd(false);
+  ASSERT_EQ(1u, recorder.size());
+
+  AbandonScrolls(&recorder, kBatchSize - 1);
+  std::vector<ImplicitFeedbackSample> batch;
+  ASSERT_TRUE(recorder.TakeBatch(&batch));
+  EXPECT_EQ(IMPLICIT_FEEDBACK_DIRECTION_REVERSAL, batch[0].type);
+  // Reported for the run, not the turn.
+  EXPECT_EQ(1, batch[0].speed);
+  EXPECT_EQ(30, batch[0].fps);
+}
+
+TEST(ImplicitFeedbackRecorderTest, JitterIsNotAReversal) {
+  ImplicitFeedbackRecorder recorder;
+  recorder.OnScrollBegin(Ms(0));
+  for (int i = 0; i < 20; ++i)
+    recorder.OnScrollUpdate(i % 2 ? 5 : -5, 2, 30);
+  recorder.OnScrollUpdate(200, 10, 30);
+  EXPECT_EQ(0u, recorder.size());
+}
+
+TEST(ImplicitFeedbackRecorderTest, RescrollAfterThrottledFling) {
+  ImplicitFeedbackRecorder recorder;
+  recorder.OnFlingTick(Ms(1000), 20, 36);
+  recorder.OnScrollBegin(Ms(1300));
+  EXPECT_EQ(1u, recorder.size());
+
+  // Too late, or after an unthrottled fling.
+  recorder.OnFlingTick(Ms(2000), 20, 36);
+  recorder.OnScrollBegin(Ms(3000));
+  recorder.OnFlingTick(Ms(4000), 20, 60);
+  recorder.OnScrollBegin(Ms(4100));
+  EXPECT_EQ(1u, recorder.size());
+}
+
+TEST(ImplicitFeedbackRecorderTest, DroppedFrameBurstIsRecordedOnce) {
+  ImplicitFeedbackRecorder recorder;
+  recorder.OnScrollBegin(Ms(0));
+  recorder.OnScrollUpdate(20, 10, 30);
+  recorder.OnPacedScrollUpdate(base::TimeDelta::FromMilliseconds(30));
+  EXPECT_EQ(0u, recorder.size());
+  for (int i = 0; i < 5; ++i)
+    recorder.OnPacedScrollUpdate(base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(1u, recorder.size());
+  recorder.OnPacedScrollUpdate(base::TimeDelta::FromMilliseconds(30));
+  recorder.OnPacedScrollUpdate(base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(2u, recorder.size());
+}
+
+TEST(ImplicitFeedbackRecorderTest, BatchesAndOverwritesOldest) {
+  ImplicitFeedbackRecorder recorder;
+  std::vector<ImplicitFeedbackSample> batch;
+  AbandonScrolls(&recorder, kBatchSize - 1);
+  EXPECT_FALSE(recorder.TakeBatch(&batch));
+  EXPECT_TRUE(batch.empty());
+
+  AbandonScrolls(&recorder, 1);
+  ASSERT_TRUE(recorder.TakeBatch(&batch));
+  EXPECT_EQ(kBatchSize, batch.size());
+  EXPECT_EQ(0u, recorder.size());
+
+  const size_t capacity = ImplicitFeedbackRecorder::kCapacity;
+  AbandonScrolls(&recorder, capacity + 3);
+  EXPECT_EQ(capacity, recorder.size());
+}
+
+}  // namespace
+}  // namespace ui
@@ -0,0 +1,198 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/incremental_svr_trainer.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "ui/events/blink/svm.h"
+#include "ui/events/blink/svm_predictor.h"
+
+namespace ui {
+
+namespace {
+
+// Hyperparameters of the models the cloud trainer produces. The warm start
+// is only a valid starting point while they stay the same.
+const double kGamma = 0.1;
+const double kC = 1000;
+const double kEpsilon = 0.1;
+const double kTolerance = 0.001;
+const double kCacheSizeMb = 1;
+
+svm_parameter TrainingParameters() {
+  svm_parameter param;
+  memset(&param, 0, sizeof(param));
+  param.svm_type = EPSILON_SVR;
+  param.kernel_type = RBF;
+  param.gamma = kGamma;
+  param.cache_size = kCacheSizeMb;
+  param.eps = kTolerance;
+  param.C = kC;
+  param.p = kEpsilon;
+  param.shrinking = 1;
+  return param;
+}
+
+// Turns |coefs|, which may have lost samples to eviction since they were
+// trained, back into a feasible starting point of the dual problem: each
+// coefficient within [-C, C] and their sum zero. The sum is restored by
+// shrinking the coefficients on its side towards zero.
+void MakeFeasible(std::vector<double>* coefs) {
+  double sum = 0;
+  for (double& coef : *coefs) {
+    coef = std::max(-kC, std::min(coef, kC));
+    sum += coef;
+  }
+  for (size_t i = 0; i < coefs->size() && sum != 0; ++i) {
+    double& coef = (*coefs)[i];
+    if ((coef > 0) != (sum > 0) || coef == 0)
+      continue;
+    double shrink = std::min(std::abs(coef), std::abs(sum));
+    double delta = sum > 0 ? -shrink : shrink;
+    coef += delta;
+    sum += delta;
+  }
+}
+
+// Writes |model| in the layout svm_load_model() expects: exactly six header
+// lines followed by "SV" and one line per support vector.
+std::string SerializeModel(const svm_model& model) {
+  std::string model_str = base::StringPrintf(
+      "svm_type epsilon_svr\nkernel_type rbf\ngamma %g\nnr_class 2\n"
+      "total_sv %d\nrho %.16g\nSV\n",
+      model.param.gamma, model.l, model.rho[0]);
+  for (int i = 0; i < model.l; ++i) {
+    base::StringAppendF(&model_str, "%.16g 1:%.8g \n", model.sv_coef[0][i],
+                        model.SV[i][0].value);
+  }
+  return model_str;
+}
+
+void QuietPrint(const char*) {}
+
+}  // namespace
+
+SvrTrainingSet::SvrTrainingSet() {}
+
+SvrTrainingSet::SvrTrainingSet(const SvrTrainingSet& other) = default;
+
+SvrTrainingSet::~SvrTrainingSet() {}
+
+bool TrainSvrModel(const SvrTrainingSet& set,
+                   std::string* model_str,
+                   std::vector<double>* coefs) {
+  size_t l = set.speeds.size();
+  if (!l || set.frame_rates.size() != l || set.coefs.size() > l)
+    return false;
+
+  std::vector<svm_node> nodes(2 * l);
+  std::vector<svm_node*> x(l);
+  std::vector<double> y(set.frame_rates);
+  for (size_t i = 0; i < l; ++i) {
+    nodes[2 * i].index = 1;
+    nodes[2 * i].value = set.speeds[i];
+    nodes[2 * i + 1].index = -1;
+    x[i] = &nodes[2 * i];
+  }
+  svm_problem problem;
+  problem.l = static_cast<int>(l);
+  problem.y = y.data();
+  problem.x = x.data();
+
+  svm_parameter param = TrainingParameters();
+  if (const char* error = svm_check_parameter(&problem, &param)) {
+    DLOG(ERROR) << "Bad SVR training parameters: " << error;
+    return false;
+  }
+
+  std::vector<double> initial_coefs(set.coefs);
+  initial_coefs.resize(l, 0);
+  MakeFeasible(&initial_coefs);
+
+  svm_set_print_string_function(&QuietPrint);
+  // The support vectors of |model| point into |nodes|.
+  svm_model* model =
+      svm_train_warm_start(&problem, &param, initial_coefs.data());
+  bool trained = model->l > 0;
+  if (trained) {
+    *model_str = SerializeModel(*model);
+    coefs->assign(l, 0);
+    for (int i = 0; i < model->l; ++i)
+      (*coefs)[model->sv_indices[i] - 1] = model->sv_coef[0][i];
+  }
+  svm_free_and_destroy_model(&model);
+  return trained;
+}
+
+void WarmUpSvrTraining() {
+  // Too few samples for the kernel columns to be filled by worker threads.
+  SvrTrainingSet set;
+  for (int i = 0; i < 3; ++i) {
+    set.speeds.push_back(i);
+    set.frame_rates.push_back(30 + 15 * i);
+  }
+  std::string model_str;
+  std::vector<double> coefs;
+  if (!TrainSvrModel(set, &model_str, &coefs))
+    return;
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(model_str);
+  if (predictor)
+    predictor->Predict(set.speeds[1]);
+}
+
+const size_t IncrementalSvrTrainer::kMaxSamples = 256;
+const size_t IncrementalSvrTrainer::kSamplesPerTraining = 5;
+
+IncrementalSvrTrainer::IncrementalSvrTrainer()
+    : first_sample_id_(0), next_untrained_id_(0) {}
+
+IncrementalSvrTrainer::~IncrementalSvrTrainer() {}
+
+void IncrementalSvrTrainer::AddSample(double speed, double frame_rate) {
+  if (speeds_.size() == kMaxSamples) {
+    speeds_.pop_front();
+    frame_rates_.pop_front();
+    coefs_.pop_front();
+    ++first_sample_id_;
+  }
+  speeds_.push_back(speed);
+  frame_rates_.push_back(frame_rate);
+  coefs_.push_back(0);
+}
+
+bool IncrementalSvrTrainer::ShouldTrain() const {
+  uint64_t end_id = first_sample_id_ + speeds_.size();
+  return end_id - std::max(next_untrained_id_, first_sample_id_) >=
+         kSamplesPerTraining;
+}
+
+SvrTrainingSet IncrementalSvrTrainer::GetTrainingSet(
+    uint64_t* first_sample_id) const {
+  SvrTrainingSet set;
+  set.speeds.assign(speeds_.begin(), speeds_.end());
+  set.frame_rates.assign(frame_rates_.begin(), frame_rates_.end());
+  set.coefs.assign(coefs_.begin(), coefs_.end());
+  *first_sample_id = first_sample_id_;
+  return set;
+}
+
+void IncrementalSvrTrainer::DidTrain(uint64_t first_sample_id,
+                                     const std::vector<double>& coefs) {
+  uint64_t trained_end_id = first_sample_id + coefs.size();
+  for (size_t i = 0; i < coefs_.size(); ++i) {
+    uint64_t id = first_sample_id_ + i;
+    if (id >= first_sample_id && id < trained_end_id)
+      coefs_[i] = coefs[id - first_sample_id];
+  }
+  next_untrained_id_ = std::max(next_untrained_id_, trained_end_id);
+}
+
+}  // namespace ui
@@ -0,0 +1,96 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_INCREMENTAL_SVR_TRAINER_H_
+#define UI_EVENTS_BLINK_INCREMENTAL_SVR_TRAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace ui {
+
+// Frame rate feedback in the form a speed model is trained on. Index i of
+// each vector describes the same sample.
+struct SvrTrainingSet {
+  SvrTrainingSet();
+  SvrTrainingSet(const SvrTrainingSet& other);
+  ~SvrTrainingSet();
+
+  // Gesture speeds, in the units the cloud trainer uses for
+  // MODEL_FEATURE_SPEED.
+  std::vector<double> speeds;
+  // The frame rate the user settled on at each speed.
+  std::vector<double> frame_rates;
+  // alpha_i - alpha_i* of each sample in the previous training, used to warm
+  // start the solver. Samples past the end start from zero.
+  std::vector<double> coefs;
+};
+
+// Trains a single-feature epsilon-SVR speed model on |set|, starting the
+// solver from |set.coefs|. On success, writes the model in the libsvm text
+// format read by SvmPredictor::Create() to |model_str| and the coefficient of
+// every sample to |coefs|, and returns true. Fails if |set| is malformed or
+// the model has no support vectors. Keeps no state, so it can run in a
+// short-lived utility process.
+bool TrainSvrModel(const SvrTrainingSet& set,
+                   std::string* model_str,
+                   std::vector<double>* coefs);
+
+// Trains and evaluates a model on a few samples, so that the training and
+// prediction code is paged in and its one-time setup is done. Starts no
+// threads, so the zygote can call it before forking the processes that train
+// and predict.
+void WarmUpSvrTraining();
+
+// Keeps the sliding window of feedback samples, and the coefficients of the
+// last training, between calls to TrainSvrModel(). The window lives here, on
+// the browser side, rather than with the trainer.
+class IncrementalSvrTrainer {
+ public:
+  // Oldest samples are dropped past this many.
+  static const size_t kMaxSamples;
+  // New samples that make a training worthwhile. Matches the cadence at which
+  // the client asks the cloud trainer to retrain.
+  static const size_t kSamplesPerTraining;
+
+  IncrementalSvrTrainer();
+  ~IncrementalSvrTrainer();
+
+  void AddSample(double speed, double frame_rate);
+  size_t num_samples() const { return speeds_.size(); }
+
+  // Whether kSamplesPerTraining samples arrived since the window of the last
+  // recorded training was taken.
+  bool ShouldTrain() const;
+
+  // Returns the current window. |first_sample_id| receives the id of its
+  // oldest sample, to be passed back to DidTrain().
+  SvrTrainingSet GetTrainingSet(uint64_t* first_sample_id) const;
+
+  // Records |coefs|, the result of training on the window that started at
+  // |first_sample_id|. Samples added since keep a zero coefficient, and
+  // those evicted since are skipped.
+  void DidTrain(uint64_t first_sample_id, const std::vector<double>& coefs);
+
+ private:
+  std::deque<double> speeds_;
+  std::deque<double> frame_rates_;
+  std::deque<double> coefs_;
+  // Id of the oldest sample in the window. Ids count every sample ever added.
+  uint64_t first_sample_id_;
+  // Id of the first sample not covered by the last recorded training.
+  uint64_t next_untrained_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(IncrementalSvrTrainer);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_INCREMENTAL_SVR_TRAINER_H_
@@ -0,0 +1,172 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/incremental_svr_trainer.h"
+
+#include <memory>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/svm.h"
+#include "ui/events/blink/svm_predictor.h"
+
+namespace ui {
+namespace {
+
+// Feedback from a user who wants more frames the faster they scroll.
+SvrTrainingSet RampSet(int num_samples) {
+  SvrTrainingSet set;
+  for (int i = 0; i < num_samples; ++i) {
+    set.speeds.push_back(i);
+    set.frame_rates.push_back(20 + 2 * i);
+  }
+  return set;
+}
+
+TEST(IncrementalSvrTrainerTest, RejectsMalformedSets) {
+  std::string model_str;
+  std::vector<double> coefs;
+  EXPECT_FALSE(TrainSvrModel(SvrTrainingSet(), &model_str, &coefs));
+  SvrTrainingSet set = RampSet(3);
+  set.frame_rates.pop_back();
+  EXPECT_FALSE(TrainSvrModel(set, &model_str, &coefs));
+}
+
+TEST(IncrementalSvrTrainerTest, TrainsAfterWarmUp) {
+  WarmUpSvrTraining();
+  std::string model_str;
+  std::vector<double> coefs;
+  EXPECT_TRUE(TrainSvrModel(RampSet(5), &model_str, &coefs));
+  EXPECT_EQ(5u, coefs.size());
+}
+
+TEST(IncrementalSvrTrainerTest, TrainsModelThatSvmPredictorReads) {
+  SvrTrainingSet set = RampSet(20);
+  std::string model_str;
+  std::vector<double> coefs;
+  ASSERT_TRUE(TrainSvrModel(set, &model_str, &coefs));
+  EXPECT_EQ(set.speeds.size(), coefs.size());
+
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(model_str);
+  ASSERT_TRUE(predictor);
+  for (size_t i = 0; i < set.speeds.size(); ++i)
+    EXPECT_NEAR(set.frame_rates[i], predictor->Predict(set.speeds[i]), 0.5);
+}
+
+TEST(IncrementalSvrTrainerTest, WarmStartConvergesToSameModel) {
+  SvrTrainingSet set = RampSet(20);
+  std::string cold_model;
+  std::vector<double> coefs;
+  ASSERT_TRUE(TrainSvrModel(set, &cold_model, &coefs));
+
+  // One more sample, starting from the previous solution.
+  set.speeds.push_back(9.5);
+  set.frame_rates.push_back(39);
+  set.coefs = coefs;
+  std::string warm_model;
+  ASSERT_TRUE(TrainSvrModel(set, &warm_model, &coefs));
+  set.coefs.clear();
+  ASSERT_TRUE(TrainSvrModel(set, &cold_model, &coefs));
+
+  std::unique_ptr<SvmPredictor> warm = SvmPredictor::Create(warm_model);
+  std::unique_ptr<SvmPredictor> cold = SvmPredictor::Create(cold_model);
+  ASSERT_TRUE(warm && cold);
+  for (double speed = 0; speed < 20; speed += 0.5)
+    EXPECT_NEAR(cold->Predict(speed), warm->Predict(speed), 0.2) << speed;
+}
+
+TEST(IncrementalSvrTrainerTest, RepairsInfeasibleWarmStart) {
+  SvrTrainingSet set = RampSet(10);
+  // What is left after the sample that balanced these was evicted.
+  set.coefs.assign(10, 0);
+  set.coefs[0] = 800;
+  set.coefs[3] = 5000;
+  std::string model_str;
+  std::vector<double> coefs;
+  ASSERT_TRUE(TrainSvrModel(set, &model_str, &coefs));
+  double sum = 0;
+  for (double coef : coefs)
+    sum += coef;
+  EXPECT_NEAR(0, sum, 1e-6);
+}
+
+TEST(IncrementalSvrTrainerTest, ParallelKernelColumnsTrainSameModel) {
+  SvrTrainingSet set = RampSet(200);
+  std::string serial_model;
+  std::vector<double> serial_coefs;
+  svm_set_kernel_threads(1, 4096);
+  ASSERT_TRUE(TrainSvrModel(set, &serial_model, &serial_coefs));
+
+  // Every column, even the short tails of cache misses, is split.
+  std::string parallel_model;
+  std::vector<double> parallel_coefs;
+  svm_set_kernel_threads(3, 2);
+  bool trained = TrainSvrModel(set, &parallel_model, &parallel_coefs);
+  svm_set_kernel_threads(0, 4096);
+  ASSERT_TRUE(trained);
+  EXPECT_EQ(serial_model, parallel_model);
+  EXPECT_EQ(serial_coefs, parallel_coefs);
+}
+
+TEST(IncrementalSvrTrainerTest, ManySmallKernelChunksTrainSameModel) {
+  SvrTrainingSet set = RampSet(200);
+  std::string serial_model;
+  std::vector<double> serial_coefs;
+  svm_set_kernel_threads(1, 4096);
+  ASSERT_TRUE(TrainSvrModel(set, &serial_model, &serial_coefs));
+
+  // Chunks of a few entries finish while later ones are still being posted;
+  // every entry must still be filled before the column is used.
+  svm_set_kernel_threads(32, 2);
+  for (int run = 0; run < 5; ++run) {
+    std::string parallel_model;
+    std::vector<double> parallel_coefs;
+    EXPECT_TRUE(TrainSvrModel(set, &parallel_model, &parallel_coefs));
+    EXPECT_EQ(serial_model, parallel_model) << run;
+    EXPECT_EQ(serial_coefs, parallel_coefs) << run;
+  }
+  svm_set_kernel_threads(0, 4096);
+}
+
+TEST(IncrementalSvrTrainerTest, TrainsEverySamplesPerTraining) {
+  IncrementalSvrTrainer trainer;
+  for (size_t i = 1; i < IncrementalSvrTrainer::kSamplesPerTraining; ++i)
+    trainer.AddSample(i, 30);
+  EXPECT_FALSE(trainer.ShouldTrain());
+  trainer.AddSample(0, 30);
+  EXPECT_TRUE(trainer.ShouldTrain());
+
+  uint64_t first_sample_id = 0;
+  SvrTrainingSet set = trainer.GetTrainingSet(&first_sample_id);
+  EXPECT_EQ(IncrementalSvrTrainer::kSamplesPerTraining, set.speeds.size());
+  trainer.DidTrain(first_sample_id, std::vector<double>(set.speeds.size(), 1));
+  EXPECT_FALSE(trainer.ShouldTrain());
+}
+
+TEST(IncrementalSvrTrainerTest, DidTrainAlignsWithMovedWindow) {
+  IncrementalSvrTrainer trainer;
+  for (size_t i = 0; i < IncrementalSvrTrainer::kMaxSamples; ++i)
+    trainer.AddSample(i, 30);
+  uint64_t first_sample_id = 0;
+  SvrTrainingSet set = trainer.GetTrainingSet(&first_sample_id);
+  std::vector<double> coefs(set.speeds.size());
+  for (size_t i = 0; i < coefs.size(); ++i)
+    coefs[i] = i;
+
+  // Two samples arrive while training runs, evicting the two oldest.
+  trainer.AddSample(1000, 60);
+  trainer.AddSample(1001, 60);
+  trainer.DidTrain(first_sample_id, coefs);
+
+  uint64_t new_first_sample_id = 0;
+  set = trainer.GetTrainingSet(&new_first_sample_id);
+  EXPECT_EQ(first_sample_id + 2, new_first_sample_id);
+  ASSERT_EQ(IncrementalSvrTrainer::kMaxSamples, set.coefs.size());
+  EXPECT_EQ(2, set.coefs[0]);
+  EXPECT_EQ(0, set.coefs[set.coefs.size() - 1]);
+  EXPECT_EQ(0, set.coefs[set.coefs.size() - 2]);
+  EXPECT_FALSE(trainer.ShouldTrain());
+}
+
+}  // namespace
+}  // namespace ui
@@ -8,24 +8,36 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
 #include <time.h>
 #include "base/auto_reset.h"
 #include "base/command_line.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/memory/shared_memory.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/default_tick_clock.h"
 #include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_argument.h"
+#include "build/build_config.h"
 #include "cc/input/main_thread_scrolling_reason.h"
 #include "third_party/WebKit/public/platform/WebInputEvent.h"
+#include "ui/events/blink/compositor_thread_watchdog.h"
 #include "ui/events/blink/did_overscroll_params.h"
+#include "ui/events/blink/frame_rate_table.h"
+#include "ui/events/blink/gesture_cpu_usage.h"
 #include "ui/events/blink/input_handler_proxy_client.h"
+#include "ui/events/blink/input_model.h"
+#include "ui/events/blink/input_rate_controller.h"
 #include "ui/events/blink/input_scroll_elasticity_controller.h"
 #include "ui/events/blink/web_input_event_traits.h"
 #include "ui/events/latency_info.h"
 #include "ui/gfx/geometry/point_conversions.h"
-#include "ui/events/blink/svm.h"
+#include "ui/events/blink/svm_predictor.h"
 
 using blink::WebFloatPoint;
 using blink::WebFloatSize;
@@ -72,6 +84,18 @@ double InSecondsF(const base::TimeTicks& time) {
   return (time - base::TimeTicks()).InSecondsF();
 }
 
+ui::CompositorThreadWatchdog::Source WatchdogSourceForEvent(
+    WebInputEvent::Type type) {
+  switch (type) {
+    case WebInputEvent::GesturePinchBegin:
+    case WebInputEvent::GesturePinchUpdate:
+    case WebInputEvent::GesturePinchEnd:
+      return ui::CompositorThreadWatchdog::SOURCE_PINCH;
+    default:
+      return ui::CompositorThreadWatchdog::SOURCE_INPUT_EVENT;
+  }
+}
+
 bool ShouldSuppressScrollForFlingBoosting(
     const gfx::Vector2dF& current_fling_velocity,
     const WebGestureEvent& scroll_update_event,
@@ -168,7 +192,8 @@ cc::ScrollState CreateScrollStateForGesture(const WebGestureEvent& event) {
 }
 
 void ReportInputEventLatencyUma(const WebInputEvent& event,
-                                const ui::LatencyInfo& latency_info) {
+                                const ui::LatencyInfo& latency_info,
+                                ui::GestureLatencyHistograms* histograms) {
   if (!(event.type == WebInputEvent::GestureScrollBegin ||
         event.type == WebInputEvent::GestureScrollUpdate ||
         event.type == WebInputEvent::GesturePinchBegin ||
@@ -185,6 +210,8 @@ void ReportInputEventLatencyUma(const WebInputEvent& event,
     return;
 
   base::TimeDelta delta = base::TimeTicks::Now() - it->second.event_time;
+  histograms->Record(event.type, delta,
+                     static_cast<int>(it->second.event_count));
   for (size_t i = 0; i < it->second.event_count; ++i) {
     switch (event.type) {
       case blink::WebInputEvent::GestureScrollBegin:
@@ -232,20 +259,258 @@ cc::InputHandler::ScrollInputType GestureScrollInputType(
 
 namespace ui {
 //My code
-std::string modelStr = "";
-int gestureSpeed = 0;
-float pageEntropy = 0;
-void InputHandlerProxy::HandleInputModelStrMsg(int routing_id, std::string model){
-    if(model.length()!=0){
-      modelStr = model;
+void InputHandlerProxy::HandleInputModelStrMsg(int routing_id,
+                                               InputModelType type,
+                                               std::string model){
+    if (model == "stop") {
+      ClearModels();
+      return;
     }
-    LOG(INFO)<<"get message routing_id:"<<routing_id<<" content:"<<modelStr;
+    if (model.empty())
+      return;
+    std::unique_ptr<InputModel> input_model =
+        InputModel::CreateFromString(type, model, frame_rate_table_step_);
+    if (!input_model) {
+      LOG(ERROR) << "Rejecting unparsable model for routing_id:" << routing_id;
+      RejectModel(type);
+      return;
+    }
+    InstallModel(std::move(input_model));
+}
+
+void InputHandlerProxy::HandleInputModelBinaryMsg(
+    int routing_id,
+    InputModelType type,
+    std::unique_ptr<base::SharedMemory> model,
+    size_t size) {
+  std::unique_ptr<InputModel> input_model = InputModel::CreateFromSharedMemory(
+      type, std::move(model), size, frame_rate_table_step_);
+  if (!input_model) {
+    LOG(ERROR) << "Rejecting invalid binary model for routing_id:"
+               << routing_id;
+    RejectModel(type);
+    return;
+  }
+  InstallModel(std::move(input_model));
+}
+
+void InputHandlerProxy::InstallModel(std::unique_ptr<InputModel> model) {
+  DCHECK(model && (model->predictor || model->frame_rate_table));
+  if (model->type == INPUT_MODEL_PINCH) {
+    pinch_predictor_ = std::move(model->predictor);
+    return;
+  }
+  predictor_ = std::move(model->predictor);
+  frame_rate_table_ = std::move(model->frame_rate_table);
+}
+
+void InputHandlerProxy::InstallOriginModel(
+    const std::string& origin,
+    std::unique_ptr<InputModel> model) {
+  origin_model_store_.Install(origin, std::move(model));
+  // Installing may have dropped the current origin's models.
+  origin_models_ = origin_model_store_.Get(origin_);
+}
+
+void InputHandlerProxy::SetOrigin(const std::string& origin) {
+  origin_ = origin;
+  origin_models_ = origin_model_store_.Get(origin_);
+}
+
+void InputHandlerProxy::ClearModels() {
+  predictor_.reset();
+  frame_rate_table_.reset();
+  pinch_predictor_.reset();
+  origin_model_store_.Clear();
+  origin_models_ = nullptr;
+  default_model_enabled_ = false;
+}
+
+void InputHandlerProxy::RejectModel(InputModelType type) {
+  RecordRejectedModel(type);
+  if (type == INPUT_MODEL_PINCH) {
+    pinch_predictor_.reset();
+    return;
+  }
+  predictor_.reset();
+  frame_rate_table_.reset();
+}
+
+// static
+void InputHandlerProxy::RecordRejectedModel(InputModelType type) {
+  UMA_HISTOGRAM_ENUMERATION("Event.InputModel.Rejected", type,
+                            INPUT_MODEL_TYPE_LAST + 1);
+}
+
+void InputHandlerProxy::GetModelFeatures(double speed, float* features) const {
+  features[MODEL_FEATURE_SPEED] = static_cast<float>(speed);
+  features[MODEL_FEATURE_PAGE_ENTROPY] = page_entropy_;
+  features[MODEL_FEATURE_LAYER_COUNT] = static_cast<float>(layer_count_);
+  features[MODEL_FEATURE_RASTER_COST] = raster_cost_;
+}
+
+void InputHandlerProxy::SetRateController(
+    std::unique_ptr<InputRateController> controller) {
+  DCHECK(controller);
+  controller->set_energy_budget(rate_controller_->energy_budget());
+  controller->set_display_refresh_rates(
+      rate_controller_->display_refresh_rates());
+  rate_controller_ = std::move(controller);
+  TRACE_EVENT_INSTANT1(
+      "input", "InputHandlerProxy::SetRateController", TRACE_EVENT_SCOPE_THREAD,
+      "policy", InputRateController::PolicyName(rate_controller_->policy()));
+}
+
+void InputHandlerProxy::SetEnergyBudget(const EnergyBudget& budget) {
+  rate_controller_->set_energy_budget(budget);
+}
+
+void InputHandlerProxy::SetDisplayRefreshRates(
+    const std::vector<float>& refresh_rates) {
+  rate_controller_->set_display_refresh_rates(refresh_rates);
+}
+
+bool InputHandlerProxy::EvaluateModel(InputModelType type,
+                                      double speed,
+                                      int* fps) const {
+  const SvmPredictor* predictor;
+  if (type == INPUT_MODEL_PINCH) {
+    predictor = origin_models_ && origin_models_->pinch_predictor
+                    ? origin_models_->pinch_predictor.get()
+                    : pinch_predictor_.get();
+  } else {
+    predictor = origin_models_ && origin_models_->has_scroll_model()
+                    ? origin_models_->predictor.get()
+                    : predictor_.get();
+  }
+  if (!predictor)
+    return false;
+  float features[MODEL_FEATURE_COUNT];
+  GetModelFeatures(speed, features);
+  *fps = ClampPredictedFrameRate(predictor->PredictCached(features));
+  if (type == INPUT_MODEL_PINCH) {
+    TRACE_COUNTER_ID2("input", "InputHandlerProxy::PinchPredictionCache", this,
+                      "hits", predictor->cache().hits(), "misses",
+                      predictor->cache().misses());
+  } else {
+    TRACE_COUNTER_ID2("input", "InputHandlerProxy::PredictionCache", this,
+                      "hits", predictor->cache().hits(), "misses",
+                      predictor->cache().misses());
+  }
+  return true;
+}
+
+bool InputHandlerProxy::LookupFrameRateTable(double speed, int* fps) const {
+  bool has_origin_model = origin_models_ && origin_models_->has_scroll_model();
+  const FrameRateTable* table = has_origin_model
+                                    ? origin_models_->frame_rate_table.get()
+                                    : frame_rate_table_.get();
+  if (table) {
+    *fps = table->Lookup(speed);
+    return true;
+  }
+  // An untabulated model of the device's own overrides the default.
+  if (!default_model_enabled_ || has_origin_model || predictor_)
+    return false;
+  *fps = FrameRateTable::LookupDefault(speed);
+  return true;
+}
+
+const EnergyCurve* InputHandlerProxy::GetEnergyCurve() const {
+  return energy_curve_.get();
+}
+
+void InputHandlerProxy::set_fixed_frame_rate(int fps) {
+  fixed_frame_rate_ =
+      std::max(0, std::min(fps, ScrollUpdatePacer::kMaxFrameRate));
+}
+
+void InputHandlerProxy::SetEnergyCurve(std::unique_ptr<EnergyCurve> curve) {
+  energy_curve_ = std::move(curve);
+}
+
+int InputHandlerProxy::PredictFrameRate(InputGestureClass gesture,
+                                        double speed) const {
+  if (fixed_frame_rate_)
+    return fixed_frame_rate_;
+  if (!models_enabled_)
+    return ScrollUpdatePacer::kMaxFrameRate;
+  return rate_controller_->GestureFrameRate(*this, gesture, speed,
+                                            page_activity_);
+}
+
+int InputHandlerProxy::PacedFrameRate(int fps) const {
+  return fixed_frame_rate_ || rate_controller_->PacesInput()
+             ? fps
+             : ScrollUpdatePacer::kMaxFrameRate;
+}
+
+void InputHandlerProxy::ReportTargetFrameRate(int fps) {
+  if (fps == reported_frame_rate_)
+    return;
+  reported_frame_rate_ = fps;
+  client_->DidChangeTargetFrameRate(fps);
+}
+
+void InputHandlerProxy::FlushImplicitFeedback() {
+  std::vector<ImplicitFeedbackSample> batch;
+  if (implicit_feedback_recorder_.TakeBatch(&batch))
+    client_->DidRecordImplicitFeedback(batch);
+}
+
+void InputHandlerProxy::SetContentFeatures(int layer_count,
+                                           float raster_cost) {
+  layer_count_ = layer_count;
+  raster_cost_ = raster_cost;
+}
+
+void InputHandlerProxy::SetVideoPlaying(bool playing) {
+  page_activity_.video_playing = playing;
+}
+
+void InputHandlerProxy::SetVideoFrameRate(int fps) {
+  page_activity_.video_frame_rate = fps;
 }
 
 void InputHandlerProxy::HandleInputModelParamsMsg(int routing_id, int speed, float entropy){
-    gestureSpeed = speed;
-    pageEntropy = entropy;
-    //LOG(INFO)<<"gestureSpeed:"<<speed<<" pageEntropy:"<<entropy;
+    gesture_speed_overridden_ = speed >= 0;
+    if (gesture_speed_overridden_)
+      gesture_speed_ = speed;
+    page_entropy_ = entropy;
+}
+
+void InputHandlerProxy::HandleInputModelFeatureScaleMsg(int routing_id,
+                                                        float scale,
+                                                        float physical_dpi,
+                                                        float refresh_rate) {
+  if (scale > 0)
+    model_feature_scale_ = scale;
+  speed_feature_ = SpeedFeature(physical_dpi, refresh_rate);
+}
+
+void InputHandlerProxy::UpdateGestureSpeed(
+    const WebGestureEvent& gesture_event) {
+  velocity_estimator_.AddDelta(gesture_event.timeStampSeconds,
+                               gesture_event.data.scrollUpdate.deltaY);
+  float velocity;
+  if (!gesture_speed_overridden_ &&
+      velocity_estimator_.GetVelocity(&velocity)) {
+    gesture_speed_ =
+        static_cast<int>(std::abs(velocity) * model_feature_scale_);
+  }
+}
+
+void InputHandlerProxy::UpdatePinchSpeed(const WebGestureEvent& gesture_event) {
+  float scale = gesture_event.data.pinchUpdate.scale;
+  if (scale <= 0)
+    return;
+  // Scale changes compose multiplicatively, so the log scale is what grows
+  // linearly during a steady pinch.
+  pinch_velocity_estimator_.AddDelta(gesture_event.timeStampSeconds,
+                                     std::log(scale));
+  float velocity;
+  if (pinch_velocity_estimator_.GetVelocity(&velocity))
+    pinch_speed_ = std::abs(velocity);
 }
 
 //end
@@ -268,7 +533,27 @@ InputHandlerProxy::InputHandlerProxy(cc::InputHandler* input_handler,
       smooth_scroll_enabled_(false),
       uma_latency_reporting_enabled_(base::TimeTicks::IsHighResolution()),
       touch_start_result_(kEventDispositionUndefined),
-      current_overscroll_params_(nullptr) {
+      current_overscroll_params_(nullptr),
+      frame_rate_table_step_(0),
+      models_enabled_(true),
+      default_model_enabled_(false),
+      fixed_frame_rate_(0),
+      fling_cutoff_(0),
+      gesture_speed_(0),
+      gesture_speed_overridden_(false),
+      page_entropy_(0),
+      layer_count_(0),
+      raster_cost_(0),
+      model_feature_scale_(1),
+      reported_frame_rate_(ScrollUpdatePacer::kMaxFrameRate),
+      gesture_latency_histograms_("InputHandlerProxy::GestureLatency"),
+      pinch_speed_(0),
+      rate_controller_(
+          InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP)),
+      scroll_gesture_class_(INPUT_GESTURE_SCROLL),
+      origin_model_store_(InputModelStore::kDefaultCapacity),
+      origin_models_(nullptr),
+      tick_clock_(new base::DefaultTickClock) {
   DCHECK(client);
   input_handler_->BindToClient(this);
   cc::ScrollElasticityHelper* scroll_elasticity_helper =
@@ -292,9 +577,12 @@ void InputHandlerProxy::HandleInputEventWithLatencyInfo(
     const LatencyInfo& latency_info,
     const EventDispositionCallback& callback) {
   DCHECK(input_handler_);
+  CompositorThreadWatchdog::ScopedSpan watchdog_span(
+      WatchdogSourceForEvent(event->type));
 
   if (uma_latency_reporting_enabled_)
-    ReportInputEventLatencyUma(*event, latency_info);
+    ReportInputEventLatencyUma(*event, latency_info,
+                               &gesture_latency_histograms_);
 
   TRACE_EVENT_WITH_FLOW1("input,benchmark", "LatencyInfo.Flow",
                          TRACE_ID_DONT_MANGLE(latency_info.trace_id()),
@@ -347,6 +635,10 @@ InputHandlerProxy::EventDisposition InputHandlerProxy::HandleInputEvent(
       } else {
         input_handler_->PinchGestureBegin();
         gesture_pinch_on_impl_thread_ = true;
+        pinch_speed_ = 0;
+        pinch_velocity_estimator_.Reset();
+        pinch_velocity_estimator_.AddDelta(gesture_event.timeStampSeconds, 0);
+        pinch_update_pacer_.Reset();
         return DID_HANDLE;
       }
     }
@@ -354,26 +646,19 @@ InputHandlerProxy::EventDisposition InputHandlerProxy::HandleInputEvent(
     case WebInputEvent::GesturePinchEnd:
       if (gesture_pinch_on_impl_thread_) {
         gesture_pinch_on_impl_thread_ = false;
+        FlushPacedPinchUpdate(tick_clock_->NowTicks());
+        pinch_update_pacer_.Reset();
+        ReportTargetFrameRate(ScrollUpdatePacer::kMaxFrameRate);
+        gesture_latency_histograms_.MaybeMerge(tick_clock_->NowTicks());
         input_handler_->PinchGestureEnd();
         return DID_HANDLE;
       } else {
         return DID_NOT_HANDLE;
       }
 
-    case WebInputEvent::GesturePinchUpdate: {
-      if (gesture_pinch_on_impl_thread_) {
-        const WebGestureEvent& gesture_event =
-            static_cast<const WebGestureEvent&>(event);
-        if (gesture_event.data.pinchUpdate.zoomDisabled)
-            return DROP_EVENT;
-        input_handler_->PinchGestureUpdate(
-            gesture_event.data.pinchUpdate.scale,
-            gfx::Point(gesture_event.x, gesture_event.y));
-        return DID_HANDLE;
-      } else {
-        return DID_NOT_HANDLE;
-      }
-    }
+    case WebInputEvent::GesturePinchUpdate:
+      return HandleGesturePinchUpdate(
+          static_cast<const WebGestureEvent&>(event));
 
     case WebInputEvent::GestureFlingStart:
       return HandleGestureFlingStart(
@@ -627,6 +912,31 @@ InputHandlerProxy::EventDisposition InputHandlerProxy::HandleGestureScrollBegin(
   DCHECK(!expect_scroll_update_end_);
   expect_scroll_update_end_ = true;
 #endif
+  // The cpuidle residency is read from sysfs, so only when it is traced.
+  bool read_idle_residency = false;
+#if defined(OS_ANDROID)
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("input.energy"),
+                                     &read_idle_residency);
+#endif
+  gesture_cpu_usage_.Begin(read_idle_residency);
+  implicit_feedback_recorder_.OnScrollBegin(
+      base::TimeTicks() +
+      base::TimeDelta::FromSecondsD(gesture_event.timeStampSeconds));
+  FlushImplicitFeedback();
+  // The gesture starts from rest; updates are measured relative to it.
+  if (!gesture_speed_overridden_)
+    gesture_speed_ = 0;
+  velocity_estimator_.Reset();
+  velocity_estimator_.AddDelta(gesture_event.timeStampSeconds, 0);
+  frame_rate_governor_.Reset();
+  last_paced_scroll_update_time_ = base::TimeTicks();
+  // The page may be following a touch that started on a blocking listener;
+  // those touches are sent to the main thread.
+  scroll_gesture_class_ =
+      gesture_event.sourceDevice == blink::WebGestureDeviceTouchscreen &&
+              touch_start_result_ == DID_NOT_HANDLE
+          ? INPUT_GESTURE_DRAG
+          : INPUT_GESTURE_SCROLL;
   cc::ScrollState scroll_state = CreateScrollStateForGesture(gesture_event);
   cc::InputHandler::ScrollStatus scroll_status;
   if (gesture_event.data.scrollBegin.deltaHintUnits ==
@@ -680,112 +990,36 @@ InputHandlerProxy::EventDisposition InputHandlerProxy::HandleGestureScrollBegin(
 
 
 
-//my code
-double predict(double speed)
-{
-  LOG(INFO)<<"here is func predict-------------------";
-
-  if( modelStr.length() == 0 || modelStr == "stop" ){
-    return 60;
-  }
-
-  struct svm_node *x;
-  int max_nr_attr = 64;
-  struct svm_model* model;
-  int predict_probability=0;
-  if((model = svm_load_model(modelStr.data())) == 0)
-  {
-    LOG(INFO)<<"here is func predict-------------------"<<"can't load model string";
-    exit(1);
-  }
-  x = (struct svm_node *) malloc(max_nr_attr*sizeof(struct svm_node));
-  if(x == NULL){
-    LOG(INFO)<<"here is func predict-------------------"<<"can't malloc svm_node";
-  }
-  if(predict_probability)
-  {
-    if(svm_check_probability_model(model) == 0)
-    {
-      LOG(INFO)<<"here is func predict-------------------"<<"Model does not support probabiliy estimates";
-      exit(1);
-    }
-  }
-  else
-  {
-    if(svm_check_probability_model(model)!=0)
-    {
-      LOG(INFO)<<"here is func predict-------------------"<<"Model supports probability estimates, but disabled in prediction";
-    }     
-  }
-
-  int i = 0;
-  double predict_label;
-  x[i].index = 1;
-  x[i].value = speed;
-  ++i;
-  x[i].index = -1;
-  predict_label = svm_predict(model,x);
-  svm_free_and_destroy_model(&model);
-  free(x);
-  return predict_label;
-}
-
-void doSleep(int fps){
-    if(fps >= 1 && fps <= 9){
-       base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(1000000/fps - 16667));
-     }
-
-    if(fps >= 10 && fps <= 15){
-      base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(1000000/fps - 16667+(fps-10)*1667*0.75));
-    }
-    else if(fps > 15 && fps < 20){
-      base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(1000000/fps - 16667+(fps-10)*1667*0.6));
-    }       
-    else if(fps >=20 && fps <= 30){
-      base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(24997+1667*(30-fps)));
-    }
-    else if(fps >30 && fps<=41){
-     base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(16663+1667*(41-fps)*0.5));
-    }
-    else if(fps>41 && fps<=44){
-     base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(16246+1667*(44-fps)*0.5));
-    }
-    else if(fps==45){
-     base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(15412));
-    }
-    else if(fps>45 && fps <=52){
-     base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(11245+1667*(52-fps)*0.5));
-    }
-    else if(fps==55){
-     base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(12912));
-    }
-    else if(fps == 60){}
-    else{
-     base::PlatformThread::Sleep(base::TimeDelta::FromMicroseconds(12912+1667*(55-fps)*0.5));
-    }
-}
-//my code end
-
 InputHandlerProxy::EventDisposition
 InputHandlerProxy::HandleGestureScrollUpdate(
     const WebGestureEvent& gesture_event) {
-  //my code
-      gestureSpeed /= 50;
-      int fps = ceil(predict(abs(gestureSpeed)*2));// cheng2/50 redmi
-      //predict(fabs(gestureSpeed));//c8816
-      if(fps<10){fps = 24;}
-      if(fps>60){fps = 60;}
-      LOG(INFO)<<"here is func HandleGestureScrollUpdate--------------------fps:"<<fps;
-      doSleep(fps);
-
-  //my code end
-
 #ifndef NDEBUG
   DCHECK(expect_scroll_update_end_);
 #endif
+  UpdateGestureSpeed(gesture_event);
   if (!gesture_scroll_on_impl_thread_ && !gesture_pinch_on_impl_thread_)
     return DID_NOT_HANDLE;
 
+  //my code
+      double speed =
+          speed_feature_.FromPhysicalPixelsPerSecond(gesture_speed_);
+      int predicted_fps = PredictFrameRate(scroll_gesture_class_, speed);
+      int fps = frame_rate_governor_.Update(gesture_event.timeStampSeconds,
+                                            predicted_fps);
+      TRACE_COUNTER_ID2("input", "InputHandlerProxy::PacedScroll", this,
+                        "speed", gesture_speed_, "fps", fps);
+      TRACE_COUNTER_ID1("input", "InputHandlerProxy::PredictedScrollFps",
+                        this, predicted_fps);
+      if (fps != reported_frame_rate_) {
+        UMA_HISTOGRAM_ENUMERATION("Event.PacedScroll.PredictedFrameRate", fps,
+                                  ScrollUpdatePacer::kMaxFrameRate + 1);
+      }
+      scroll_update_pacer_.SetTargetFrameRate(PacedFrameRate(fps));
+      ReportTargetFrameRate(fps);
+      implicit_feedback_recorder_.OnScrollUpdate(
+          gesture_event.data.scrollUpdate.deltaY, speed, fps);
+  //my code end
+
   cc::ScrollState scroll_state = CreateScrollStateForGesture(gesture_event);
   gfx::Point scroll_point(gesture_event.x, gesture_event.y);
   gfx::Vector2dF scroll_delta(-gesture_event.data.scrollUpdate.deltaX,
@@ -797,7 +1031,7 @@ InputHandlerProxy::HandleGestureScrollUpdate(
     base::TimeTicks event_time =
         base::TimeTicks() +
         base::TimeDelta::FromSecondsD(gesture_event.timeStampSeconds);
-    base::TimeDelta delay = base::TimeTicks::Now() - event_time;
+    base::TimeDelta delay = tick_clock_->NowTicks() - event_time;
     switch (input_handler_->ScrollAnimated(scroll_point, scroll_delta, delay)
                 .thread) {
       case cc::InputHandler::SCROLL_ON_IMPL_THREAD:
@@ -808,9 +1042,30 @@ InputHandlerProxy::HandleGestureScrollUpdate(
         return DID_NOT_HANDLE;
     }
   }
+
+  // While throttled, the update is coalesced and applied from |Animate()| on
+  // the reduced frame cadence rather than blocking the thread until it is due.
+  if (scroll_update_pacer_.is_throttling()) {
+    if (!scroll_update_pacer_.CanQueue(gesture_event))
+      FlushPacedScrollUpdate(tick_clock_->NowTicks());
+    scroll_update_pacer_.QueueScrollUpdate(gesture_event);
+    RequestAnimation();
+    return DID_HANDLE;
+  }
+
+  FlushPacedScrollUpdate(tick_clock_->NowTicks());
+  return ScrollByGestureUpdate(gesture_event, true);
+}
+
+InputHandlerProxy::EventDisposition InputHandlerProxy::ScrollByGestureUpdate(
+    const WebGestureEvent& gesture_event,
+    bool bundle_overscroll_params_with_ack) {
+  cc::ScrollState scroll_state = CreateScrollStateForGesture(gesture_event);
+  gfx::Point scroll_point(gesture_event.x, gesture_event.y);
   cc::InputHandlerScrollResult scroll_result =
       input_handler_->ScrollBy(&scroll_state);
-  HandleOverscroll(scroll_point, scroll_result, true);
+  HandleOverscroll(scroll_point, scroll_result,
+                   bundle_overscroll_params_with_ack);
 
   if (scroll_elasticity_controller_)
     HandleScrollElasticityOverscroll(gesture_event, scroll_result);
@@ -818,12 +1073,93 @@ InputHandlerProxy::HandleGestureScrollUpdate(
   return scroll_result.did_scroll ? DID_HANDLE : DROP_EVENT;
 }
 
+void InputHandlerProxy::FlushPacedScrollUpdate(base::TimeTicks time) {
+  if (!scroll_update_pacer_.has_pending_update())
+    return;
+  CompositorThreadWatchdog::ScopedSpan watchdog_span(
+      CompositorThreadWatchdog::SOURCE_RATE_CONTROL);
+  // How long the oldest coalesced event waited for its frame.
+  base::TimeDelta delay =
+      std::max(base::TimeDelta(),
+               time - scroll_update_pacer_.oldest_pending_event_time());
+  TRACE_COUNTER_ID1("input", "InputHandlerProxy::PacedScrollDelayUs", this,
+                    delay.InMicroseconds());
+  UMA_HISTOGRAM_CUSTOM_COUNTS("Event.PacedScroll.Delay",
+                              delay.InMicroseconds(), 1, 1000000, 50);
+  // The gap between two applied updates, if input kept arriving in between;
+  // a finger at rest leaves gaps that are none of the pacing's doing.
+  base::TimeTicks oldest_pending_event_time =
+      scroll_update_pacer_.oldest_pending_event_time();
+  if (!last_paced_scroll_update_time_.is_null() &&
+      oldest_pending_event_time - last_paced_scroll_update_time_ <=
+          base::TimeDelta::FromSecondsD(1.0 /
+                                        ScrollUpdatePacer::kMaxFrameRate)) {
+    UMA_HISTOGRAM_CUSTOM_COUNTS(
+        "Event.PacedScroll.FrameGap",
+        (time - last_paced_scroll_update_time_).InMilliseconds(), 1, 1000, 50);
+  }
+  last_paced_scroll_update_time_ = time;
+  implicit_feedback_recorder_.OnPacedScrollUpdate(delay);
+  // The events that make up the pending update have already been acked, so
+  // any overscroll has to be reported separately.
+  ScrollByGestureUpdate(scroll_update_pacer_.TakePendingUpdate(time), false);
+}
+
+InputHandlerProxy::EventDisposition
+InputHandlerProxy::HandleGesturePinchUpdate(
+    const WebGestureEvent& gesture_event) {
+  if (!gesture_pinch_on_impl_thread_)
+    return DID_NOT_HANDLE;
+  if (gesture_event.data.pinchUpdate.zoomDisabled)
+    return DROP_EVENT;
+
+  UpdatePinchSpeed(gesture_event);
+  int fps = PredictFrameRate(INPUT_GESTURE_PINCH, pinch_speed_);
+  // Counters are integral; pinch speeds are a few units per second.
+  TRACE_COUNTER_ID2("input", "InputHandlerProxy::PacedPinch", this,
+                    "speed_x1000", static_cast<int>(pinch_speed_ * 1000),
+                    "fps", fps);
+  pinch_update_pacer_.SetTargetFrameRate(PacedFrameRate(fps));
+  ReportTargetFrameRate(fps);
+
+  gfx::Point anchor(gesture_event.x, gesture_event.y);
+  if (pinch_update_pacer_.is_throttling()) {
+    pinch_update_pacer_.QueuePinchUpdate(gesture_event.data.pinchUpdate.scale,
+                                         anchor);
+    RequestAnimation();
+    return DID_HANDLE;
+  }
+
+  FlushPacedPinchUpdate(tick_clock_->NowTicks());
+  input_handler_->PinchGestureUpdate(gesture_event.data.pinchUpdate.scale,
+                                     anchor);
+  return DID_HANDLE;
+}
+
+void InputHandlerProxy::FlushPacedPinchUpdate(base::TimeTicks time) {
+  if (!pinch_update_pacer_.has_pending_update())
+    return;
+  CompositorThreadWatchdog::ScopedSpan watchdog_span(
+      CompositorThreadWatchdog::SOURCE_RATE_CONTROL);
+  float scale;
+  gfx::Point anchor;
+  pinch_update_pacer_.TakePendingUpdate(time, &scale, &anchor);
+  input_handler_->PinchGestureUpdate(scale, anchor);
+}
+
 InputHandlerProxy::EventDisposition InputHandlerProxy::HandleGestureScrollEnd(
   const WebGestureEvent& gesture_event) {
 #ifndef NDEBUG
   DCHECK(expect_scroll_update_end_);
   expect_scroll_update_end_ = false;
 #endif
+  FlushPacedScrollUpdate(tick_clock_->NowTicks());
+  scroll_update_pacer_.Reset();
+  ReportGestureCpuUsage();
+  ReportTargetFrameRate(ScrollUpdatePacer::kMaxFrameRate);
+  implicit_feedback_recorder_.OnScrollEnd(false);
+  FlushImplicitFeedback();
+  gesture_latency_histograms_.MaybeMerge(tick_clock_->NowTicks());
   if (ShouldAnimate(gesture_event.data.scrollEnd.deltaUnits !=
                     blink::WebGestureEvent::ScrollUnits::Pixels)) {
     // Do nothing if the scroll is being animated; the scroll animation will
@@ -843,8 +1179,51 @@ InputHandlerProxy::EventDisposition InputHandlerProxy::HandleGestureScrollEnd(
   return DID_HANDLE;
 }
 
+void InputHandlerProxy::ReportGestureCpuUsage() {
+  GestureCpuUsage::Sample sample;
+  if (!gesture_cpu_usage_.End(&sample))
+    return;
+
+  std::unique_ptr<base::trace_event::TracedValue> usage(
+      new base::trace_event::TracedValue());
+  usage->SetDouble("wall_time_ms", sample.wall_time.InMillisecondsF());
+  usage->SetDouble("thread_time_ms", sample.thread_time.InMillisecondsF());
+  LOCAL_HISTOGRAM_TIMES("Event.Debug.ScrollGesture.CompositorThreadTime",
+                        sample.thread_time);
+  int64_t wall_time_us = sample.wall_time.InMicroseconds();
+  if (wall_time_us > 0) {
+    LOCAL_HISTOGRAM_PERCENTAGE(
+        "Event.Debug.ScrollGesture.CompositorThreadCpuPercent",
+        static_cast<int>(100 * sample.thread_time.InMicroseconds() /
+                         wall_time_us));
+  }
+  if (sample.has_idle_residency) {
+    usage->SetInteger("cpu_count", sample.cpu_count);
+    usage->SetDouble("cpu_idle_residency_ms",
+                     sample.idle_residency.InMillisecondsF());
+    if (wall_time_us > 0) {
+      // Of the time all CPUs were available.
+      LOCAL_HISTOGRAM_PERCENTAGE(
+          "Event.Debug.ScrollGesture.CpuIdleResidencyPercent",
+          static_cast<int>(100 * sample.idle_residency.InMicroseconds() /
+                           (wall_time_us * sample.cpu_count)));
+    }
+  }
+  TRACE_EVENT_INSTANT1("input,benchmark",
+                       "InputHandlerProxy::GestureCpuUsage",
+                       TRACE_EVENT_SCOPE_THREAD, "data", std::move(usage));
+}
+
 InputHandlerProxy::EventDisposition InputHandlerProxy::HandleGestureFlingStart(
     const WebGestureEvent& gesture_event) {
+  // Deltas still waiting for a paced frame belong before the fling.
+  FlushPacedScrollUpdate(tick_clock_->NowTicks());
+  scroll_update_pacer_.Reset();
+  // Touchscreen flings continue the gesture without a GestureScrollEnd; the
+  // fling animation is left out of the measurement.
+  ReportGestureCpuUsage();
+  implicit_feedback_recorder_.OnScrollEnd(true);
+  FlushImplicitFeedback();
   cc::ScrollState scroll_state = CreateScrollStateForGesture(gesture_event);
   cc::InputHandler::ScrollStatus scroll_status;
   scroll_status.main_thread_scrolling_reasons =
@@ -1169,11 +1548,39 @@ void InputHandlerProxy::Animate(base::TimeTicks time) {
   DCHECK(!input_handler_->IsCurrentlyScrollingViewport() ||
          allow_root_animate_);
 
-  if (scroll_elasticity_controller_)
+  if (scroll_elasticity_controller_) {
+    // The rebound runs at the rate of the interaction that caused it.
+    scroll_elasticity_controller_->set_animation_frame_rate(
+        PacedFrameRate(reported_frame_rate_));
     scroll_elasticity_controller_->Animate(time);
+  }
+
+  if (scroll_update_pacer_.ShouldDispatch(time)) {
+    TRACE_EVENT_INSTANT2(
+        "input", "InputHandlerProxy::animate::pacedScroll",
+        TRACE_EVENT_SCOPE_THREAD, "fps",
+        scroll_update_pacer_.target_frame_rate(), "policy",
+        InputRateController::PolicyName(rate_controller_->policy()));
+    FlushPacedScrollUpdate(time);
+  }
+  if (scroll_update_pacer_.has_pending_update())
+    RequestAnimation();
+
+  if (pinch_update_pacer_.ShouldDispatch(time)) {
+    TRACE_EVENT_INSTANT2(
+        "input", "InputHandlerProxy::animate::pacedPinch",
+        TRACE_EVENT_SCOPE_THREAD, "fps",
+        pinch_update_pacer_.target_frame_rate(), "policy",
+        InputRateController::PolicyName(rate_controller_->policy()));
+    FlushPacedPinchUpdate(time);
+  }
+  if (pinch_update_pacer_.has_pending_update())
+    RequestAnimation();
 
   if (!fling_curve_)
     return;
+  CompositorThreadWatchdog::ScopedSpan watchdog_span(
+      CompositorThreadWatchdog::SOURCE_FLING);
 
   last_fling_animate_time_ = time;
   double monotonic_time_sec = InSecondsF(time);
@@ -1184,6 +1591,26 @@ void InputHandlerProxy::Animate(base::TimeTicks time) {
     return;
   }
 
+  // Fling ticks are paced like scroll updates, at the rate predicted for the
+  // current fling velocity. The curve is sampled by time, so a skipped tick
+  // only makes the next increment larger.
+  int tick_rate = ScrollUpdatePacer::kMaxFrameRate;
+  if (has_fling_animation_started_) {
+    double speed = speed_feature_.FromPhysicalPixelsPerSecond(
+        std::abs(current_fling_velocity_.y()) * model_feature_scale_);
+    int fps = PredictFrameRate(INPUT_GESTURE_FLING, speed);
+    TRACE_COUNTER_ID1("input", "InputHandlerProxy::PacedFling", this, fps);
+    ReportTargetFrameRate(fps);
+    tick_rate = PacedFrameRate(fps);
+    if (!ScrollUpdatePacer::IsFrameDue(last_fling_tick_time_, time,
+                                       tick_rate)) {
+      RequestAnimation();
+      return;
+    }
+    last_fling_tick_time_ = time;
+    implicit_feedback_recorder_.OnFlingTick(time, speed, fps);
+  }
+
   client_->DidAnimateForInput();
 
   if (!has_fling_animation_started_) {
@@ -1207,6 +1634,20 @@ void InputHandlerProxy::Animate(base::TimeTicks time) {
   if (disallow_vertical_fling_scroll_ && disallow_horizontal_fling_scroll_)
     fling_is_active = false;
 
+  // The curves do not expose their final offset, so a fling whose next ticks
+  // would barely move ends where it is.
+  if (fling_is_active && fling_cutoff_ > 0 && fling_curve_) {
+    double pixels_per_tick =
+        std::hypot(current_fling_velocity_.x(), current_fling_velocity_.y()) *
+        model_feature_scale_ / tick_rate;
+    if (pixels_per_tick < fling_cutoff_) {
+      TRACE_EVENT_INSTANT2("input", "InputHandlerProxy::animate::flingCutOff",
+                           TRACE_EVENT_SCOPE_THREAD, "pixels_per_tick",
+                           pixels_per_tick, "fps", tick_rate);
+      fling_is_active = false;
+    }
+  }
+
   if (fling_is_active) {
     RequestAnimation();
   } else {
@@ -1347,6 +1788,8 @@ bool InputHandlerProxy::CancelCurrentFlingWithoutNotifyingClient() {
                        had_fling_animation);
   fling_curve_.reset();
   has_fling_animation_started_ = false;
+  last_fling_tick_time_ = base::TimeTicks();
+  ReportTargetFrameRate(ScrollUpdatePacer::kMaxFrameRate);
   gesture_scroll_on_impl_thread_ = false;
   current_fling_velocity_ = gfx::Vector2dF();
   fling_parameters_ = blink::WebActiveWheelFlingParameters();
@@ -1391,7 +1834,7 @@ bool InputHandlerProxy::TouchpadFlingScroll(
     case cc::EventListenerProperties::kNone: {
       WebMouseWheelEvent synthetic_wheel;
       synthetic_wheel.type = WebInputEvent::MouseWheel;
-      synthetic_wheel.timeStampSeconds = InSecondsF(base::TimeTicks::Now());
+      synthetic_wheel.timeStampSeconds = InSecondsF(tick_clock_->NowTicks());
       synthetic_wheel.deltaX = increment.width;
       synthetic_wheel.deltaY = increment.height;
       synthetic_wheel.hasPreciseScrollingDeltas = true;
@@ -1512,6 +1955,8 @@ void InputHandlerProxy::HandleScrollElasticityOverscroll(
     const WebGestureEvent& gesture_event,
     const cc::InputHandlerScrollResult& scroll_result) {
   DCHECK(scroll_elasticity_controller_);
+  if (!scroll_elasticity_controller_->WillObserveGestureEvent(gesture_event))
+    return;
   // Send the event and its disposition to the elasticity controller to update
   // the over-scroll animation. Note that the call to the elasticity controller
   // is made asynchronously, to minimize divergence between main thread and
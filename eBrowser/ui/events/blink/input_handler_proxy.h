@@ -6,29 +6,52 @@
 #define UI_EVENTS_BLINK_INPUT_HANDLER_PROXY_H_
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/hash_tables.h"
 #include "base/macros.h"
+#include "base/time/tick_clock.h"
 #include "cc/input/input_handler.h"
 #include "third_party/WebKit/public/platform/WebGestureCurve.h"
 #include "third_party/WebKit/public/platform/WebGestureCurveTarget.h"
 #include "third_party/WebKit/public/platform/WebInputEvent.h"
 #include "third_party/WebKit/public/web/WebActiveWheelFlingParameters.h"
+#include "ui/events/blink/energy_curve.h"
+#include "ui/events/blink/frame_rate_governor.h"
+#include "ui/events/blink/gesture_cpu_usage.h"
+#include "ui/events/blink/implicit_feedback_recorder.h"
+#include "ui/events/blink/input_model_store.h"
+#include "ui/events/blink/input_model_type.h"
+#include "ui/events/blink/input_rate_controller.h"
 #include "ui/events/blink/input_scroll_elasticity_controller.h"
+#include "ui/events/blink/latency_histogram.h"
+#include "ui/events/blink/pinch_update_pacer.h"
 #include "ui/events/blink/scoped_web_input_event.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+#include "ui/events/blink/scroll_velocity_estimator.h"
+#include "ui/events/blink/speed_feature.h"
 #include "ui/events/blink/synchronous_input_handler_proxy.h"
 
+namespace base {
+class SharedMemory;
+}
+
 namespace ui {
 
 namespace test {
 class InputHandlerProxyTest;
 }
 
+class FrameRateTable;
 class InputHandlerProxyClient;
 class InputScrollElasticityController;
+class SvmPredictor;
 class SynchronousInputHandler;
 class SynchronousInputHandlerProxy;
 struct DidOverscrollParams;
+struct InputModel;
 
 // This class is a proxy between the blink web input events for a WebWidget and
 // the compositor's input handling logic. InputHandlerProxy instances live
@@ -37,6 +60,7 @@ struct DidOverscrollParams;
 class InputHandlerProxy
     : public cc::InputHandlerClient,
       public SynchronousInputHandlerProxy,
+      public InputRateController::Models,
       public NON_EXPORTED_BASE(blink::WebGestureCurveTarget) {
  public:
 
@@ -50,6 +74,74 @@ class InputHandlerProxy
 
   void set_smooth_scroll_enabled(bool value) { smooth_scroll_enabled_ = value; }
 
+  // When |step| is positive, each received model is also compiled into a
+  // FrameRateTable quantized at |step| and scroll updates look their frame
+  // rate up there instead of evaluating the kernel sum.
+  void set_frame_rate_table_step(double step) {
+    frame_rate_table_step_ = step;
+  }
+  double frame_rate_table_step() const { return frame_rate_table_step_; }
+
+  // When positive, a fling ends as soon as its velocity would move the
+  // content less than |physical_pixels| per tick at the rate it is paced
+  // at, rather than running the curve's sub-pixel tail to completion.
+  void set_fling_cutoff(double physical_pixels) {
+    fling_cutoff_ = physical_pixels;
+  }
+
+  // While disabled, gestures run at the full frame rate but the models are
+  // kept, so that benchmarks can compare both in the same session.
+  void set_models_enabled(bool enabled) { models_enabled_ = enabled; }
+  bool models_enabled() const { return models_enabled_; }
+
+  // While enabled, scrolls are paced by the population table compiled into
+  // the binary (see FrameRateTable::LookupDefault()) until a scroll model for
+  // the page arrives, rather than at the full frame rate. ClearModels()
+  // disables it.
+  void set_default_model_enabled(bool enabled) {
+    default_model_enabled_ = enabled;
+  }
+
+  // While positive, every gesture is paced at |fps|, whatever the models and
+  // the rate policy, for energy calibration runs. Zero restores them.
+  void set_fixed_frame_rate(int fps);
+  int fixed_frame_rate() const { return fixed_frame_rate_; }
+
+  // The device's calibrated energy cost per frame, for rate controllers that
+  // weigh energy rather than the frame rate alone. Null until one arrives.
+  void SetEnergyCurve(std::unique_ptr<EnergyCurve> curve);
+
+  // Replaces the pacing policy, INPUT_RATE_POLICY_SVR_SLEEP by default. The
+  // new controller keeps the current energy budget and display refresh rates.
+  void SetRateController(std::unique_ptr<InputRateController> controller);
+  void SetEnergyBudget(const EnergyBudget& budget);
+  // See InputRateController::set_display_refresh_rates().
+  void SetDisplayRefreshRates(const std::vector<float>& refresh_rates);
+  const InputRateController& rate_controller() const {
+    return *rate_controller_;
+  }
+
+  // Replaces the clock pacing reads when input arrives outside a frame, e.g.
+  // to flush a coalesced update at GestureScrollEnd, so that tests can replay
+  // gestures in virtual time. Frame times still come from Animate().
+  void SetTickClockForTesting(std::unique_ptr<base::TickClock> tick_clock) {
+    tick_clock_ = std::move(tick_clock);
+  }
+
+  // Per-proxy model state.
+  bool has_predictor() const { return !!predictor_; }
+  int gesture_speed() const { return gesture_speed_; }
+  float page_entropy() const { return page_entropy_; }
+  // Frame rate the current scroll gesture is paced at.
+  int paced_scroll_frame_rate() const {
+    return scroll_update_pacer_.target_frame_rate();
+  }
+  bool has_pinch_predictor() const { return !!pinch_predictor_; }
+  // Frame rate the current pinch gesture is paced at.
+  int paced_pinch_frame_rate() const {
+    return pinch_update_pacer_.target_frame_rate();
+  }
+
   enum EventDisposition {
     DID_HANDLE,
     DID_NOT_HANDLE,
@@ -68,8 +160,62 @@ class InputHandlerProxy
   EventDisposition HandleInputEvent(const blink::WebInputEvent& event);
 
  //my code
-  void HandleInputModelStrMsg(int routing_id, std::string model);
+  // Parses |model|, libsvm text or a compiled scroll table, and installs it in
+  // the slot for |type|. "stop" clears every slot. InputHandlerManager
+  // prepares models off the compositor thread and uses InstallModel() instead.
+  void HandleInputModelStrMsg(int routing_id,
+                              InputModelType type,
+                              std::string model);
+  // Sets the page entropy feature. A |speed| of zero or more also fixes the
+  // speed feature, in place of the one measured from scroll updates, until a
+  // negative |speed| hands it back to the measurement.
   void HandleInputModelParamsMsg(int routing_id, int speed, float entropy);
+  // Sets the number of physical pixels per DIP, in which scroll deltas are
+  // converted to the panel's pixels, and the panel's physical pixels per inch
+  // and refresh rate, which normalize the speed feature; see SpeedFeature.
+  // Scroll deltas arrive in DIPs. Unknown metrics are 0.
+  void HandleInputModelFeatureScaleMsg(int routing_id,
+                                       float scale,
+                                       float physical_dpi,
+                                       float refresh_rate);
+  const SpeedFeature& speed_feature() const { return speed_feature_; }
+  // Updates the content complexity features, measured by the main thread
+  // from the committed layer tree.
+  void SetContentFeatures(int layer_count, float raster_cost);
+  // Whether the page plays a video, which bounds how far gestures are
+  // throttled; see GesturePolicy.
+  void SetVideoPlaying(bool playing);
+  // The rate the page's video presents frames at, as measured by the
+  // renderer, or 0. Gestures are then paced at a multiple of it.
+  void SetVideoFrameRate(int fps);
+  // Like HandleInputModelStrMsg, for a model in the DenseRbfModel binary
+  // format. The model is evaluated directly out of |model|.
+  void HandleInputModelBinaryMsg(int routing_id,
+                                 InputModelType type,
+                                 std::unique_ptr<base::SharedMemory> model,
+                                 size_t size);
+  // Replaces the model in |model|'s slot. This is a pointer swap, so a model
+  // update never delays the input events around it.
+  void InstallModel(std::unique_ptr<InputModel> model);
+  // Like InstallModel, for a model that only paces pages of |origin|, a
+  // serialized url::Origin. Gesture types the origin has no model for use
+  // the default model.
+  void InstallOriginModel(const std::string& origin,
+                          std::unique_ptr<InputModel> model);
+  // Selects the models of |origin|, that of the page the main frame has just
+  // committed.
+  void SetOrigin(const std::string& origin);
+  bool has_origin_models() const { return !!origin_models_; }
+  // Drops all models, the default one included; gestures run at the full
+  // frame rate again.
+  void ClearModels();
+  // Drops the model in the slot for |type| after its replacement failed to
+  // load, so that those gestures run at the full frame rate instead of by a
+  // model the server has given up on, and counts the rejection.
+  void RejectModel(InputModelType type);
+  // Counts a model of |type| that failed to load in
+  // Event.InputModel.Rejected.
+  static void RecordRejectedModel(InputModelType type);
 
   // cc::InputHandlerClient implementation.
   void WillShutdown() override;
@@ -93,6 +239,13 @@ class InputHandlerProxy
   void SynchronouslyZoomBy(float magnify_delta,
                            const gfx::Point& anchor) override;
 
+  // InputRateController::Models implementation.
+  bool EvaluateModel(InputModelType type,
+                     double speed,
+                     int* fps) const override;
+  bool LookupFrameRateTable(double speed, int* fps) const override;
+  const EnergyCurve* GetEnergyCurve() const override;
+
   // blink::WebGestureCurveTarget implementation.
   bool scrollBy(const blink::WebFloatSize& offset,
                 const blink::WebFloatSize& velocity) override;
@@ -120,6 +273,44 @@ class InputHandlerProxy
       const blink::WebGestureEvent& event);
   EventDisposition HandleGestureScrollEnd(
       const blink::WebGestureEvent& event);
+  // Applies a GestureScrollUpdate to the InputHandler. Shared by events that
+  // are handled immediately and updates released by |scroll_update_pacer_|.
+  EventDisposition ScrollByGestureUpdate(
+      const blink::WebGestureEvent& event,
+      bool bundle_overscroll_params_with_ack);
+  // Applies the update held by |scroll_update_pacer_|, if any, stamping it
+  // with |time| as its release time.
+  void FlushPacedScrollUpdate(base::TimeTicks time);
+  // Ends the gesture's CPU usage measurement, if any, and reports it to
+  // tracing and debug histograms.
+  void ReportGestureCpuUsage();
+  EventDisposition HandleGesturePinchUpdate(
+      const blink::WebGestureEvent& event);
+  // Applies the update held by |pinch_update_pacer_|, if any.
+  void FlushPacedPinchUpdate(base::TimeTicks time);
+
+  // Adds |gesture_event|'s delta to |velocity_estimator_| and, unless
+  // |gesture_speed_overridden_|, updates |gesture_speed_| from its estimate.
+  void UpdateGestureSpeed(const blink::WebGestureEvent& gesture_event);
+  // Adds |gesture_event|'s log scale to |pinch_velocity_estimator_| and
+  // updates |pinch_speed_| from its estimate.
+  void UpdatePinchSpeed(const blink::WebGestureEvent& gesture_event);
+
+
+  // Returns the frame rate |rate_controller_| picks for |gesture| at |speed|,
+  // or the full frame rate while the models are disabled.
+  int PredictFrameRate(InputGestureClass gesture, double speed) const;
+  // Fills |features|, MODEL_FEATURE_COUNT values, with |speed| and the
+  // current content features.
+  void GetModelFeatures(double speed, float* features) const;
+  // The rate input is coalesced to for a gesture paced at |fps|; the full
+  // frame rate if |rate_controller_| leaves pacing to BeginFrames.
+  int PacedFrameRate(int fps) const;
+  // Tells the client about |fps| if it differs from the last reported rate.
+  void ReportTargetFrameRate(int fps);
+  // Hands the client a batch of |implicit_feedback_recorder_|'s samples, if
+  // one is full.
+  void FlushImplicitFeedback();
   EventDisposition HandleGestureFlingStart(
       const blink::WebGestureEvent& event);
   EventDisposition HandleTouchStart(const blink::WebTouchEvent& event);
@@ -231,6 +422,92 @@ class InputHandlerProxy
   // supporting overscroll IPC notifications due to fling animation updates.
   std::unique_ptr<DidOverscrollParams> current_overscroll_params_;
 
+  // The event rate model most recently received for this proxy's routing id,
+  // parsed once on arrival. Null when power saving is off, in which case
+  // scroll updates run at the full frame rate.
+  std::unique_ptr<SvmPredictor> predictor_;
+
+  // Lookup table compiled from |predictor_| when |frame_rate_table_step_| is
+  // positive.
+  std::unique_ptr<FrameRateTable> frame_rate_table_;
+  double frame_rate_table_step_;
+  // See set_models_enabled().
+  bool models_enabled_;
+  // See set_default_model_enabled().
+  bool default_model_enabled_;
+  // See set_fixed_frame_rate().
+  int fixed_frame_rate_;
+  // See set_fling_cutoff().
+  double fling_cutoff_;
+  std::unique_ptr<EnergyCurve> energy_curve_;
+
+  // Model features, in physical pixels per second for the speed. The speed is
+  // measured from this proxy's own scroll updates unless
+  // |gesture_speed_overridden_|. Each proxy keeps its own so that one tab's
+  // scrolling does not drive another's frame rate.
+  int gesture_speed_;
+  // Set while HandleInputModelParamsMsg() fixes |gesture_speed_|.
+  bool gesture_speed_overridden_;
+  float page_entropy_;
+  // Content complexity of the last committed frame; see SetContentFeatures.
+  int layer_count_;
+  float raster_cost_;
+  float model_feature_scale_;
+  // Turns |gesture_speed_| and fling velocities into the models' feature.
+  SpeedFeature speed_feature_;
+  // Vertical velocity of the current scroll gesture, in DIPs per second.
+  ScrollVelocityEstimator velocity_estimator_;
+  // Smooths the rate predicted for each scroll update before it reaches
+  // |scroll_update_pacer_|.
+  FrameRateGovernor frame_rate_governor_;
+
+  // Coalesces scroll updates while the predicted frame rate is below the
+  // display rate; they are applied from |Animate()|.
+  ScrollUpdatePacer scroll_update_pacer_;
+  // When the current scroll last applied a coalesced update.
+  base::TimeTicks last_paced_scroll_update_time_;
+
+  // Time of the last fling tick that applied the fling curve, used to pace
+  // fling animation at the predicted frame rate.
+  base::TimeTicks last_fling_tick_time_;
+
+  // The rate last passed to DidChangeTargetFrameRate().
+  int reported_frame_rate_;
+
+  // Compositor thread CPU time over each scroll gesture.
+  GestureCpuUsage gesture_cpu_usage_;
+
+  // Signs that throttled gestures were too choppy, sent on in batches to
+  // train the models with.
+  ImplicitFeedbackRecorder implicit_feedback_recorder_;
+
+  // Per-gesture latency percentiles, recorded alongside the UMA latency
+  // histograms and merged at gesture ends.
+  GestureLatencyHistograms gesture_latency_histograms_;
+
+  // The pinch counterparts of the above. The speed feature is the rate of
+  // change of the log page scale, per second.
+  std::unique_ptr<SvmPredictor> pinch_predictor_;
+  float pinch_speed_;
+  ScrollVelocityEstimator pinch_velocity_estimator_;
+  PinchUpdatePacer pinch_update_pacer_;
+
+  // Turns the models' predictions into pacing decisions.
+  std::unique_ptr<InputRateController> rate_controller_;
+  // The class of the current scroll gesture, decided at GestureScrollBegin.
+  InputGestureClass scroll_gesture_class_;
+  PageActivity page_activity_;
+
+  // Models specialized for the origins of recent pages, and those of the
+  // current page's origin, if it has any. They take precedence over the
+  // models above.
+  InputModelStore origin_model_store_;
+  std::string origin_;
+  const OriginInputModels* origin_models_;
+
+  // See SetTickClockForTesting().
+  std::unique_ptr<base::TickClock> tick_clock_;
+
   DISALLOW_COPY_AND_ASSIGN(InputHandlerProxy);
 };
 
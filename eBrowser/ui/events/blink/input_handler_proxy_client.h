@@ -5,6 +5,9 @@
 #ifndef UI_EVENTS_BLINK_INPUT_HANDLER_PROXY_CLIENT_H_
 #define UI_EVENTS_BLINK_INPUT_HANDLER_PROXY_CLIENT_H_
 
+#include <vector>
+
+#include "ui/events/blink/implicit_feedback_recorder.h"
 #include "ui/events/blink/scoped_web_input_event.h"
 
 namespace blink {
@@ -57,6 +60,16 @@ class InputHandlerProxyClient {
 
   virtual void DidAnimateForInput() = 0;
 
+  // Called when the frame rate predicted for the active gesture changes, so
+  // that BeginFrames can be throttled at their source. A rate of
+  // ScrollUpdatePacer::kMaxFrameRate means unthrottled.
+  virtual void DidChangeTargetFrameRate(int fps) = 0;
+
+  // Called with each batch of implicit feedback on the frame rates chosen for
+  // throttled gestures, to be sent on to the model trainer.
+  virtual void DidRecordImplicitFeedback(
+      const std::vector<ImplicitFeedbackSample>& samples) = 0;
+
  protected:
   virtual ~InputHandlerProxyClient() {}
 };
@@ -4,10 +4,15 @@
 
 #include "ui/events/blink/input_handler_proxy.h"
 
+#include <stdint.h>
+
 #include <memory>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/macros.h"
 #include "base/test/histogram_tester.h"
+#include "base/test/test_mock_time_task_runner.h"
 #include "cc/input/main_thread_scrolling_reason.h"
 #include "cc/trees/swap_promise_monitor.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -17,7 +22,9 @@
 #include "third_party/WebKit/public/platform/WebGestureCurve.h"
 #include "third_party/WebKit/public/platform/WebInputEvent.h"
 #include "third_party/WebKit/public/platform/WebPoint.h"
+#include "ui/events/blink/frame_rate_table.h"
 #include "ui/events/blink/input_handler_proxy_client.h"
+#include "ui/events/blink/input_model.h"
 #include "ui/events/latency_info.h"
 #include "ui/gfx/geometry/scroll_offset.h"
 #include "ui/gfx/geometry/size_f.h"
@@ -223,7 +230,8 @@ class FakeWebGestureCurve : public blink::WebGestureCurve {
 class MockInputHandlerProxyClient
     : public InputHandlerProxyClient {
  public:
-  MockInputHandlerProxyClient() {}
+  MockInputHandlerProxyClient()
+      : target_frame_rate_(ScrollUpdatePacer::kMaxFrameRate) {}
   ~MockInputHandlerProxyClient() override {}
 
   void WillShutdown() override {}
@@ -258,8 +266,15 @@ class MockInputHandlerProxyClient
   void DidStartFlinging() override {}
   void DidStopFlinging() override {}
   void DidAnimateForInput() override {}
+  void DidChangeTargetFrameRate(int fps) override { target_frame_rate_ = fps; }
+  void DidRecordImplicitFeedback(
+      const std::vector<ImplicitFeedbackSample>& samples) override {}
+
+  int target_frame_rate() const { return target_frame_rate_; }
 
  private:
+  int target_frame_rate_;
+
   DISALLOW_COPY_AND_ASSIGN(MockInputHandlerProxyClient);
 };
 
@@ -524,6 +539,86 @@ TEST_P(InputHandlerProxyTest, GestureScrollStarted) {
   VERIFY_AND_RESET_MOCKS();
 }
 
+TEST_P(InputHandlerProxyTest, GestureSpeedFromScrollDeltas) {
+  VERIFY_AND_RESET_MOCKS();
+  input_handler_->HandleInputModelFeatureScaleMsg(1, 2, 0, 0);
+
+  EXPECT_CALL(mock_input_handler_, ScrollBegin(testing::_, testing::_))
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  gesture_.type = WebInputEvent::GestureScrollBegin;
+  gesture_.timeStampSeconds = 1;
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+  EXPECT_EQ(0, input_handler_->gesture_speed());
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // 10 DIPs in 20ms at 2 pixels per DIP.
+  EXPECT_CALL(mock_input_handler_, ScrollBy(testing::_))
+      .WillOnce(testing::Return(scroll_result_did_scroll_));
+  gesture_.type = WebInputEvent::GestureScrollUpdate;
+  gesture_.timeStampSeconds = 1.02;
+  gesture_.data.scrollUpdate.deltaY = -10;
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+  EXPECT_NEAR(1000, input_handler_->gesture_speed(), 1);
+
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_, ScrollEnd(testing::_));
+  gesture_.type = WebInputEvent::GestureScrollEnd;
+  gesture_.data.scrollUpdate.deltaY = 0;
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+}
+
+TEST_P(InputHandlerProxyTest, GestureSpeedOverriddenByModelParams) {
+  VERIFY_AND_RESET_MOCKS();
+  input_handler_->HandleInputModelParamsMsg(1, 300, 0.5f);
+
+  // Neither the start of a gesture nor its updates replace the speed.
+  EXPECT_CALL(mock_input_handler_, ScrollBegin(testing::_, testing::_))
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  gesture_.type = WebInputEvent::GestureScrollBegin;
+  gesture_.timeStampSeconds = 1;
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+  EXPECT_EQ(300, input_handler_->gesture_speed());
+
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_, ScrollBy(testing::_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(scroll_result_did_scroll_));
+  gesture_.type = WebInputEvent::GestureScrollUpdate;
+  gesture_.timeStampSeconds = 1.02;
+  gesture_.data.scrollUpdate.deltaY = -10;
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+  EXPECT_EQ(300, input_handler_->gesture_speed());
+  EXPECT_EQ(0.5f, input_handler_->page_entropy());
+
+  // A negative speed hands the speed back to the measured one, which kept
+  // following the updates meanwhile.
+  input_handler_->HandleInputModelParamsMsg(1, -1, 0.5f);
+  gesture_.timeStampSeconds = 1.04;
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+  EXPECT_NEAR(500, input_handler_->gesture_speed(), 1);
+
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_, ScrollEnd(testing::_));
+  gesture_.type = WebInputEvent::GestureScrollEnd;
+  gesture_.data.scrollUpdate.deltaY = 0;
+  EXPECT_EQ(InputHandlerProxy::DID_HANDLE,
+            input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+}
+
 TEST_P(InputHandlerProxyTest, GestureScrollOnMainThread) {
   // We should send all events to the widget for this gesture.
   expected_disposition_ = InputHandlerProxy::DID_NOT_HANDLE;
@@ -695,6 +790,189 @@ TEST_P(InputHandlerProxyTest, GesturePinch) {
   VERIFY_AND_RESET_MOCKS();
 }
 
+TEST_P(InputHandlerProxyTest, GesturePinchIsPacedByModel) {
+  // Predicts 20fps for every pinch speed.
+  input_handler_->HandleInputModelStrMsg(
+      1, INPUT_MODEL_PINCH,
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -20\n"
+      "SV\n"
+      "0 1:1000\n");
+  EXPECT_TRUE(input_handler_->has_pinch_predictor());
+  EXPECT_FALSE(input_handler_->has_predictor());
+  expected_disposition_ = InputHandlerProxy::DID_HANDLE;
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_.type = WebInputEvent::GesturePinchBegin;
+  gesture_.timeStampSeconds = 1;
+  EXPECT_CALL(mock_input_handler_,
+              GetEventListenerProperties(cc::EventListenerClass::kMouseWheel))
+      .WillOnce(testing::Return(cc::EventListenerProperties::kNone));
+  EXPECT_CALL(mock_input_handler_, PinchGestureBegin());
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // Updates are held back and merged until a frame is due.
+  gesture_.type = WebInputEvent::GesturePinchUpdate;
+  gesture_.timeStampSeconds = 1.016;
+  gesture_.data.pinchUpdate.scale = 1.25;
+  gesture_.x = 7;
+  gesture_.y = 13;
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+  EXPECT_CALL(mock_input_handler_, PinchGestureUpdate(testing::_, testing::_))
+      .Times(0);
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+  EXPECT_EQ(20, input_handler_->paced_pinch_frame_rate());
+  EXPECT_EQ(20, mock_client_.target_frame_rate());
+
+  gesture_.timeStampSeconds = 1.032;
+  gesture_.data.pinchUpdate.scale = 2;
+  gesture_.x = 9;
+  gesture_.y = 6;
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_,
+              PinchGestureUpdate(testing::FloatEq(2.5f), gfx::Point(9, 6)));
+  Animate(base::TimeTicks() + base::TimeDelta::FromSeconds(10));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_.type = WebInputEvent::GesturePinchEnd;
+  EXPECT_CALL(mock_input_handler_, PinchGestureEnd());
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+  EXPECT_EQ(ScrollUpdatePacer::kMaxFrameRate, mock_client_.target_frame_rate());
+
+  VERIFY_AND_RESET_MOCKS();
+}
+
+TEST_P(InputHandlerProxyTest, DisabledModelDoesNotPacePinch) {
+  input_handler_->HandleInputModelStrMsg(
+      1, INPUT_MODEL_PINCH,
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -20\n"
+      "SV\n"
+      "0 1:1000\n");
+  input_handler_->set_models_enabled(false);
+  EXPECT_TRUE(input_handler_->has_pinch_predictor());
+  expected_disposition_ = InputHandlerProxy::DID_HANDLE;
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_.type = WebInputEvent::GesturePinchBegin;
+  gesture_.timeStampSeconds = 1;
+  EXPECT_CALL(mock_input_handler_,
+              GetEventListenerProperties(cc::EventListenerClass::kMouseWheel))
+      .WillOnce(testing::Return(cc::EventListenerProperties::kNone));
+  EXPECT_CALL(mock_input_handler_, PinchGestureBegin());
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_.type = WebInputEvent::GesturePinchUpdate;
+  gesture_.timeStampSeconds = 1.016;
+  gesture_.data.pinchUpdate.scale = 1.25;
+  gesture_.x = 7;
+  gesture_.y = 13;
+  EXPECT_CALL(mock_input_handler_,
+              PinchGestureUpdate(1.25, gfx::Point(7, 13)));
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+  EXPECT_EQ(ScrollUpdatePacer::kMaxFrameRate,
+            input_handler_->paced_pinch_frame_rate());
+
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_.type = WebInputEvent::GesturePinchEnd;
+  EXPECT_CALL(mock_input_handler_, PinchGestureEnd());
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+}
+
+TEST_P(InputHandlerProxyTest, DefaultTablePacesScrollUntilModelArrives) {
+  int fps = 0;
+  EXPECT_FALSE(input_handler_->LookupFrameRateTable(1000, &fps));
+
+  input_handler_->set_default_model_enabled(true);
+  ASSERT_TRUE(input_handler_->LookupFrameRateTable(1000, &fps));
+  EXPECT_EQ(FrameRateTable::LookupDefault(1000), fps);
+
+  // The device's own model, even untabulated, overrides the default.
+  input_handler_->HandleInputModelStrMsg(
+      1, INPUT_MODEL_SCROLL,
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -20\n"
+      "SV\n"
+      "0 1:1000\n");
+  EXPECT_FALSE(input_handler_->LookupFrameRateTable(1000, &fps));
+  EXPECT_TRUE(input_handler_->EvaluateModel(INPUT_MODEL_SCROLL, 1000, &fps));
+
+  // "stop" turns rate control off, the default table included.
+  input_handler_->ClearModels();
+  EXPECT_FALSE(input_handler_->LookupFrameRateTable(1000, &fps));
+}
+
+TEST_P(InputHandlerProxyTest, BeginFrameDecimationDoesNotCoalescePinch) {
+  input_handler_->SetRateController(
+      InputRateController::Create(INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION));
+  input_handler_->HandleInputModelStrMsg(
+      1, INPUT_MODEL_PINCH,
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -20\n"
+      "SV\n"
+      "0 1:1000\n");
+  expected_disposition_ = InputHandlerProxy::DID_HANDLE;
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_.type = WebInputEvent::GesturePinchBegin;
+  gesture_.timeStampSeconds = 1;
+  EXPECT_CALL(mock_input_handler_,
+              GetEventListenerProperties(cc::EventListenerClass::kMouseWheel))
+      .WillOnce(testing::Return(cc::EventListenerProperties::kNone));
+  EXPECT_CALL(mock_input_handler_, PinchGestureBegin());
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // The update is applied right away; only the client hears of the rate.
+  gesture_.type = WebInputEvent::GesturePinchUpdate;
+  gesture_.timeStampSeconds = 1.016;
+  gesture_.data.pinchUpdate.scale = 1.25;
+  gesture_.x = 7;
+  gesture_.y = 13;
+  EXPECT_CALL(mock_input_handler_,
+              PinchGestureUpdate(1.25, gfx::Point(7, 13)));
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+  EXPECT_EQ(ScrollUpdatePacer::kMaxFrameRate,
+            input_handler_->paced_pinch_frame_rate());
+  EXPECT_EQ(20, mock_client_.target_frame_rate());
+
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_.type = WebInputEvent::GesturePinchEnd;
+  EXPECT_CALL(mock_input_handler_, PinchGestureEnd());
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+}
+
 TEST_P(InputHandlerProxyTest, GesturePinchWithWheelHandler) {
   // We will send the synthetic wheel event to the widget.
   expected_disposition_ = InputHandlerProxy::DID_NOT_HANDLE;
@@ -1417,6 +1695,124 @@ TEST_P(InputHandlerProxyTest, GestureFlingAnimatesTouchscreen) {
   VERIFY_AND_RESET_MOCKS();
 }
 
+TEST_P(InputHandlerProxyTest, GestureFlingIsPacedByModel) {
+  // Predicts 20fps for every speed.
+  input_handler_->HandleInputModelStrMsg(
+      1, INPUT_MODEL_SCROLL,
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -20\n"
+      "SV\n"
+      "0 1:1000\n");
+  expected_disposition_ = InputHandlerProxy::DID_HANDLE;
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_, ScrollBegin(testing::_, testing::_))
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  gesture_.type = WebInputEvent::GestureScrollBegin;
+  gesture_.sourceDevice = blink::WebGestureDeviceTouchscreen;
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_ = CreateFling(blink::WebGestureDeviceTouchscreen,
+                         WebFloatPoint(0, 1000), WebPoint(7, 13),
+                         WebPoint(17, 23), 0);
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+  EXPECT_CALL(mock_input_handler_, FlingScrollBegin())
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // Picks up the start time.
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+  base::TimeTicks time = base::TimeTicks() + base::TimeDelta::FromSeconds(10);
+  Animate(time);
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // The first tick scrolls.
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+  EXPECT_CALL(mock_input_handler_, ScrollBy(testing::_))
+      .WillOnce(testing::Return(scroll_result_did_scroll_));
+  time += base::TimeDelta::FromMilliseconds(16);
+  Animate(time);
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // The next two vsyncs fall inside the 20fps interval and are skipped, but
+  // keep the animation going.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+    EXPECT_CALL(mock_input_handler_, ScrollBy(testing::_)).Times(0);
+    time += base::TimeDelta::FromMilliseconds(16);
+    Animate(time);
+    VERIFY_AND_RESET_MOCKS();
+  }
+
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+  EXPECT_CALL(mock_input_handler_, ScrollBy(testing::_))
+      .WillOnce(testing::Return(scroll_result_did_scroll_));
+  time += base::TimeDelta::FromMilliseconds(16);
+  Animate(time);
+
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_, ScrollEnd(testing::_));
+  gesture_.type = WebInputEvent::GestureFlingCancel;
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+}
+
+TEST_P(InputHandlerProxyTest, GestureFlingEndsBelowCutoff) {
+  // The fake curve keeps its 1000 pixels per second, which moves about 17
+  // pixels per tick at 60fps.
+  input_handler_->set_fling_cutoff(20);
+  expected_disposition_ = InputHandlerProxy::DID_HANDLE;
+  VERIFY_AND_RESET_MOCKS();
+
+  EXPECT_CALL(mock_input_handler_, ScrollBegin(testing::_, testing::_))
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  gesture_.type = WebInputEvent::GestureScrollBegin;
+  gesture_.sourceDevice = blink::WebGestureDeviceTouchscreen;
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  gesture_ = CreateFling(blink::WebGestureDeviceTouchscreen,
+                         WebFloatPoint(0, 1000), WebPoint(7, 13),
+                         WebPoint(17, 23), 0);
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+  EXPECT_CALL(mock_input_handler_, FlingScrollBegin())
+      .WillOnce(testing::Return(kImplThreadScrollState));
+  EXPECT_EQ(expected_disposition_, input_handler_->HandleInputEvent(gesture_));
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // Picks up the start time.
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(1);
+  base::TimeTicks time = base::TimeTicks() + base::TimeDelta::FromSeconds(10);
+  Animate(time);
+
+  VERIFY_AND_RESET_MOCKS();
+
+  // The first tick still scrolls, then ends the fling instead of asking for
+  // another frame.
+  EXPECT_SET_NEEDS_ANIMATE_INPUT(0);
+  EXPECT_CALL(mock_input_handler_, ScrollBy(testing::_))
+      .WillOnce(testing::Return(scroll_result_did_scroll_));
+  EXPECT_CALL(mock_input_handler_, ScrollEnd(testing::_));
+  time += base::TimeDelta::FromMilliseconds(16);
+  Animate(time);
+
+  VERIFY_AND_RESET_MOCKS();
+}
+
 TEST_P(InputHandlerProxyTest, GestureFlingWithValidTimestamp) {
   // We shouldn't send any events to the widget for this gesture.
   expected_disposition_ = InputHandlerProxy::DID_HANDLE;
@@ -2788,6 +3184,272 @@ TEST(SynchronousInputHandlerProxyTest, SetOffset) {
   testing::Mock::VerifyAndClearExpectations(&mock_synchronous_input_handler);
 }
 
+TEST(InputHandlerProxyModelTest, ModelStateIsPerProxy) {
+  const char kModel[] =
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -30\n"
+      "SV\n"
+      "10 1:1\n";
+  testing::NiceMock<MockInputHandler> mock_input_handler;
+  testing::NiceMock<MockInputHandlerProxyClient> mock_client;
+  ui::InputHandlerProxy first(&mock_input_handler, &mock_client);
+  ui::InputHandlerProxy second(&mock_input_handler, &mock_client);
+
+  first.HandleInputModelStrMsg(1, INPUT_MODEL_SCROLL, kModel);
+  first.HandleInputModelParamsMsg(1, 500, 0.5f);
+  EXPECT_TRUE(first.has_predictor());
+  EXPECT_EQ(500, first.gesture_speed());
+  EXPECT_EQ(0.5f, first.page_entropy());
+  EXPECT_FALSE(second.has_predictor());
+  EXPECT_EQ(0, second.gesture_speed());
+
+  second.HandleInputModelParamsMsg(2, 100, 0.25f);
+  EXPECT_EQ(500, first.gesture_speed());
+  EXPECT_EQ(100, second.gesture_speed());
+
+  first.HandleInputModelStrMsg(1, INPUT_MODEL_SCROLL, "stop");
+  EXPECT_FALSE(first.has_predictor());
+}
+
+TEST(InputHandlerProxyModelTest, SpeedFeatureFollowsThePanel) {
+  testing::NiceMock<MockInputHandler> mock_input_handler;
+  testing::NiceMock<MockInputHandlerProxyClient> mock_client;
+  ui::InputHandlerProxy proxy(&mock_input_handler, &mock_client);
+  EXPECT_EQ(SpeedFeature::kReferenceDpi, proxy.speed_feature().physical_dpi());
+
+  proxy.HandleInputModelFeatureScaleMsg(1, 3, 480, 90);
+  EXPECT_EQ(480, proxy.speed_feature().physical_dpi());
+  EXPECT_EQ(90, proxy.speed_feature().refresh_rate());
+
+  // A browser that cannot tell leaves the reference panel.
+  proxy.HandleInputModelFeatureScaleMsg(1, 3, 0, 0);
+  EXPECT_EQ(SpeedFeature::kReferenceDpi, proxy.speed_feature().physical_dpi());
+  EXPECT_EQ(SpeedFeature::kReferenceRefreshRate,
+            proxy.speed_feature().refresh_rate());
+}
+
+TEST(InputHandlerProxyModelTest, RejectedModelRunsAtFullRate) {
+  const char kModel[] =
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -30\n"
+      "SV\n"
+      "10 1:1\n";
+  base::HistogramTester histograms;
+  testing::NiceMock<MockInputHandler> mock_input_handler;
+  testing::NiceMock<MockInputHandlerProxyClient> mock_client;
+  ui::InputHandlerProxy proxy(&mock_input_handler, &mock_client);
+  proxy.HandleInputModelStrMsg(1, INPUT_MODEL_SCROLL, kModel);
+  proxy.HandleInputModelStrMsg(1, INPUT_MODEL_PINCH, kModel);
+  EXPECT_TRUE(proxy.has_predictor());
+  EXPECT_TRUE(proxy.has_pinch_predictor());
+
+  // A truncated download replaces the scroll model by none, rather than
+  // leaving an outdated one in place; the pinch model is unaffected.
+  proxy.HandleInputModelStrMsg(1, INPUT_MODEL_SCROLL, "svm_type epsilon_s");
+  EXPECT_FALSE(proxy.has_predictor());
+  EXPECT_TRUE(proxy.has_pinch_predictor());
+  int fps;
+  EXPECT_FALSE(proxy.EvaluateModel(INPUT_MODEL_SCROLL, 1, &fps));
+  histograms.ExpectUniqueSample("Event.InputModel.Rejected",
+                                INPUT_MODEL_SCROLL, 1);
+
+  proxy.HandleInputModelStrMsg(1, INPUT_MODEL_SCROLL, kModel);
+  EXPECT_TRUE(proxy.has_predictor());
+}
+
+TEST(InputHandlerProxyModelTest, OriginModelsTakePrecedence) {
+  const char kModel[] =
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -30\n"
+      "SV\n"
+      "10 1:1\n";
+  const char kOriginModel[] =
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -45\n"
+      "SV\n"
+      "10 1:1\n";
+  testing::NiceMock<MockInputHandler> mock_input_handler;
+  testing::NiceMock<MockInputHandlerProxyClient> mock_client;
+  ui::InputHandlerProxy proxy(&mock_input_handler, &mock_client);
+  proxy.HandleInputModelStrMsg(1, INPUT_MODEL_SCROLL, kModel);
+  int default_fps;
+  ASSERT_TRUE(proxy.EvaluateModel(INPUT_MODEL_SCROLL, 1, &default_fps));
+
+  proxy.InstallOriginModel(
+      "https://a.com",
+      InputModel::CreateFromString(INPUT_MODEL_SCROLL, kOriginModel, 0));
+  // Not until a page of the origin commits.
+  EXPECT_FALSE(proxy.has_origin_models());
+  proxy.SetOrigin("https://a.com");
+  EXPECT_TRUE(proxy.has_origin_models());
+  int fps;
+  ASSERT_TRUE(proxy.EvaluateModel(INPUT_MODEL_SCROLL, 1, &fps));
+  EXPECT_NE(default_fps, fps);
+  // The origin has no pinch model.
+  EXPECT_FALSE(proxy.EvaluateModel(INPUT_MODEL_PINCH, 1, &fps));
+
+  proxy.SetOrigin("https://b.com");
+  EXPECT_FALSE(proxy.has_origin_models());
+  ASSERT_TRUE(proxy.EvaluateModel(INPUT_MODEL_SCROLL, 1, &fps));
+  EXPECT_EQ(default_fps, fps);
+
+  proxy.SetOrigin("https://a.com");
+  proxy.HandleInputModelStrMsg(1, INPUT_MODEL_SCROLL, "stop");
+  EXPECT_FALSE(proxy.has_origin_models());
+}
+
+// A 125Hz touchscreen on a 60Hz display.
+const int64_t kReplayTouchIntervalUs = 8000;
+const int64_t kReplayVsyncIntervalUs = 16667;
+
+// Replays a touchscreen scroll through a proxy in virtual time: the updates
+// and vsyncs are posted to a mock task runner whose clock the proxy reads,
+// and the times the updates reach the compositor are recorded.
+class PacedScrollReplay {
+ public:
+  explicit PacedScrollReplay(std::unique_ptr<InputRateController> controller)
+      : task_runner_(new base::TestMockTimeTaskRunner),
+        proxy_(&mock_input_handler_, &mock_client_) {
+    proxy_.SetTickClockForTesting(task_runner_->GetMockTickClock());
+    proxy_.SetRateController(std::move(controller));
+    ON_CALL(mock_input_handler_, ScrollBegin(testing::_, testing::_))
+        .WillByDefault(testing::Return(kImplThreadScrollState));
+    ON_CALL(mock_input_handler_, ScrollBy(testing::_))
+        .WillByDefault(testing::Invoke(this, &PacedScrollReplay::ScrollBy));
+  }
+
+  // Runs a scroll that ends after |duration|, and returns the times of the
+  // ScrollBy() calls, relative to its start.
+  std::vector<base::TimeDelta> Run(base::TimeDelta duration) {
+    start_ = task_runner_->NowTicks();
+    SendGesture(WebInputEvent::GestureScrollBegin);
+    const base::TimeDelta touch_interval =
+        base::TimeDelta::FromMicroseconds(kReplayTouchIntervalUs);
+    for (base::TimeDelta t = touch_interval; t < duration;
+         t += touch_interval) {
+      task_runner_->PostDelayedTask(
+          FROM_HERE,
+          base::Bind(&PacedScrollReplay::SendGesture, base::Unretained(this),
+                     WebInputEvent::GestureScrollUpdate),
+          t);
+    }
+    const base::TimeDelta vsync_interval =
+        base::TimeDelta::FromMicroseconds(kReplayVsyncIntervalUs);
+    for (base::TimeDelta t = vsync_interval; t < duration;
+         t += vsync_interval) {
+      task_runner_->PostDelayedTask(
+          FROM_HERE,
+          base::Bind(&PacedScrollReplay::Animate, base::Unretained(this)), t);
+    }
+    task_runner_->PostDelayedTask(
+        FROM_HERE,
+        base::Bind(&PacedScrollReplay::SendGesture, base::Unretained(this),
+                   WebInputEvent::GestureScrollEnd),
+        duration);
+    task_runner_->FastForwardBy(duration);
+    return scroll_times_;
+  }
+
+ private:
+  void SendGesture(WebInputEvent::Type type) {
+    WebGestureEvent gesture;
+    gesture.type = type;
+    gesture.sourceDevice = blink::WebGestureDeviceTouchscreen;
+    gesture.timeStampSeconds = InSecondsF(task_runner_->NowTicks());
+    if (type == WebInputEvent::GestureScrollUpdate)
+      gesture.data.scrollUpdate.deltaY = -4;
+    proxy_.HandleInputEvent(gesture);
+  }
+
+  void Animate() { proxy_.Animate(task_runner_->NowTicks()); }
+
+  cc::InputHandlerScrollResult ScrollBy(cc::ScrollState* scroll_state) {
+    scroll_times_.push_back(task_runner_->NowTicks() - start_);
+    cc::InputHandlerScrollResult result;
+    result.did_scroll = true;
+    return result;
+  }
+
+  scoped_refptr<base::TestMockTimeTaskRunner> task_runner_;
+  testing::NiceMock<MockInputHandler> mock_input_handler_;
+  testing::NiceMock<MockInputHandlerProxyClient> mock_client_;
+  ui::InputHandlerProxy proxy_;
+  base::TimeTicks start_;
+  std::vector<base::TimeDelta> scroll_times_;
+
+  DISALLOW_COPY_AND_ASSIGN(PacedScrollReplay);
+};
+
+// Returns |times| in whole vsyncs.
+std::vector<int64_t> InVsyncs(const std::vector<base::TimeDelta>& times) {
+  std::vector<int64_t> vsyncs;
+  for (const base::TimeDelta& time : times) {
+    EXPECT_EQ(0, time.InMicroseconds() % kReplayVsyncIntervalUs);
+    vsyncs.push_back(time.InMicroseconds() / kReplayVsyncIntervalUs);
+  }
+  return vsyncs;
+}
+
+TEST(InputHandlerProxyReplayTest, NonePolicyAppliesEveryUpdate) {
+  PacedScrollReplay replay(
+      InputRateController::Create(INPUT_RATE_POLICY_NONE));
+  std::vector<base::TimeDelta> times =
+      replay.Run(base::TimeDelta::FromMilliseconds(500));
+
+  // Each update scrolls as it arrives, at the touch rate.
+  ASSERT_EQ(62u, times.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(base::TimeDelta::FromMicroseconds(kReplayTouchIntervalUs *
+                                                static_cast<int64_t>(i + 1)),
+              times[i]);
+  }
+}
+
+TEST(InputHandlerProxyReplayTest, StaticPoliciesPaceToVsyncs) {
+  const base::TimeDelta kDuration = base::TimeDelta::FromMilliseconds(500);
+
+  // The first update waits for the next vsync; after that, 30fps takes every
+  // second one and 20fps every third. The update pending at the end of the
+  // gesture is flushed with GestureScrollEnd.
+  struct {
+    const char* spec;
+    int64_t vsyncs_per_frame;
+    size_t paced_frames;
+  } kCases[] = {{"scroll=30", 2, 15}, {"scroll=20", 3, 10}};
+  for (const auto& test_case : kCases) {
+    SCOPED_TRACE(test_case.spec);
+    std::unique_ptr<InputRateController> controller =
+        InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP);
+    ASSERT_TRUE(controller->ParseGesturePolicies(test_case.spec));
+    PacedScrollReplay replay(std::move(controller));
+    std::vector<base::TimeDelta> times = replay.Run(kDuration);
+
+    ASSERT_EQ(test_case.paced_frames + 1, times.size());
+    EXPECT_EQ(kDuration, times.back());
+    times.pop_back();
+    std::vector<int64_t> vsyncs = InVsyncs(times);
+    for (size_t i = 0; i < vsyncs.size(); ++i)
+      EXPECT_EQ(1 + test_case.vsyncs_per_frame * static_cast<int64_t>(i),
+                vsyncs[i]);
+  }
+}
+
 TEST_P(InputHandlerProxyTest, MainThreadScrollingMouseWheelHistograms) {
   input_handler_->RecordMainThreadScrollingReasonsForTest(
       blink::WebGestureDeviceTouchpad,
@@ -0,0 +1,118 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/input_model.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/shared_memory.h"
+#include "ui/events/blink/dense_rbf_model.h"
+#include "ui/events/blink/frame_rate_table.h"
+#include "ui/events/blink/svm_predictor.h"
+
+namespace ui {
+
+namespace {
+
+std::unique_ptr<InputModel> Prepare(InputModelType type,
+                                    std::unique_ptr<SvmPredictor> predictor,
+                                    double table_step) {
+  if (!predictor)
+    return nullptr;
+  VLOG(1) << "Model of type " << type << ": "
+          << predictor->num_support_vectors() << " support vectors";
+  std::unique_ptr<InputModel> model =
+      base::MakeUnique<InputModel>(type, std::move(predictor));
+  // Pinch speeds span a few units per second, too narrow for a table
+  // quantized at the scroll step, so the pinch model is always evaluated.
+  if (type == INPUT_MODEL_SCROLL && table_step > 0) {
+    model->frame_rate_table =
+        FrameRateTable::Create(*model->predictor, table_step);
+    if (model->frame_rate_table) {
+      VLOG(1) << "Tabulated predictor: " << model->frame_rate_table->size()
+              << " buckets, step " << model->frame_rate_table->step()
+              << ", max error " << model->frame_rate_table->max_error()
+              << "fps";
+    }
+  }
+  return model;
+}
+
+}  // namespace
+
+InputModel::InputModel(InputModelType type,
+                       std::unique_ptr<SvmPredictor> predictor)
+    : type(type), predictor(std::move(predictor)) {}
+
+InputModel::InputModel(InputModelType type,
+                       std::unique_ptr<FrameRateTable> frame_rate_table)
+    : type(type), frame_rate_table(std::move(frame_rate_table)) {}
+
+InputModel::~InputModel() {}
+
+// static
+std::unique_ptr<InputModel> InputModel::CreateFromString(
+    InputModelType type,
+    const std::string& model_str,
+    double table_step) {
+  if (type == INPUT_MODEL_SCROLL) {
+    std::unique_ptr<FrameRateTable> table =
+        FrameRateTable::CreateFromString(model_str);
+    if (table) {
+      VLOG(1) << "Compiled frame rate table: " << table->size()
+              << " buckets, step " << table->step() << ", max error "
+              << table->max_error() << "fps";
+      return base::MakeUnique<InputModel>(type, std::move(table));
+    }
+  }
+  return Prepare(type, SvmPredictor::Create(model_str), table_step);
+}
+
+// static
+std::unique_ptr<InputModel> InputModel::CreateFromSharedMemory(
+    InputModelType type,
+    std::unique_ptr<base::SharedMemory> memory,
+    size_t size,
+    double table_step) {
+  if (!memory || !memory->Map(size))
+    return nullptr;
+  if (FrameRateTable::IsBinaryTable(memory->memory(), size)) {
+    if (type != INPUT_MODEL_SCROLL)
+      return nullptr;
+    std::unique_ptr<FrameRateTable> table =
+        FrameRateTable::CreateFromBinary(memory->memory(), size);
+    if (!table)
+      return nullptr;
+    return base::MakeUnique<InputModel>(type, std::move(table));
+  }
+  return Prepare(type,
+                 SvmPredictor::CreateFromSharedMemory(std::move(memory), size),
+                 table_step);
+}
+
+// static
+bool InputModel::CompileToBinary(InputModelType type,
+                                 const std::string& model_str,
+                                 double table_step,
+                                 std::vector<uint8_t>* binary) {
+  std::unique_ptr<InputModel> model =
+      CreateFromString(type, model_str, table_step);
+  if (!model)
+    return false;
+  if (model->frame_rate_table) {
+    *binary = model->frame_rate_table->SerializeToBinary();
+    return true;
+  }
+  return model->predictor->SerializeToBinary(binary);
+}
+
+// static
+bool InputModel::IsBinary(const void* data, size_t size) {
+  return FrameRateTable::IsBinaryTable(data, size) ||
+         DenseRbfModel::IsBinaryModel(data, size);
+}
+
+}  // namespace ui
@@ -0,0 +1,81 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_INPUT_MODEL_H_
+#define UI_EVENTS_BLINK_INPUT_MODEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "ui/events/blink/input_model_type.h"
+
+namespace base {
+class SharedMemory;
+}
+
+namespace ui {
+
+class FrameRateTable;
+class SvmPredictor;
+
+// An event rate model ready to be installed with
+// InputHandlerProxy::InstallModel(): parsed, and for scroll models compiled
+// into a FrameRateTable when tabulation is enabled, or a table compiled by the
+// cloud trainer alone. Preparing a model is the
+// expensive part of a model update and touches no proxy state, so it can run
+// on any thread.
+struct InputModel {
+  InputModel(InputModelType type, std::unique_ptr<SvmPredictor> predictor);
+  InputModel(InputModelType type,
+             std::unique_ptr<FrameRateTable> frame_rate_table);
+  ~InputModel();
+
+  // Parses |model_str|, a libsvm text model or, for scroll models, a table in
+  // the FrameRateTable::CreateFromString() format. |table_step| is as for
+  // InputHandlerProxy::set_frame_rate_table_step() and does not apply to
+  // tables, which keep the server's step. Returns nullptr if the text is not a
+  // valid model.
+  static std::unique_ptr<InputModel> CreateFromString(
+      InputModelType type,
+      const std::string& model_str,
+      double table_step);
+
+  // Like CreateFromString(), for |size| bytes of |memory| in the
+  // DenseRbfModel or, for scroll models, the FrameRateTable binary format.
+  static std::unique_ptr<InputModel> CreateFromSharedMemory(
+      InputModelType type,
+      std::unique_ptr<base::SharedMemory> memory,
+      size_t size,
+      double table_step);
+
+  // Prepares |model_str| as CreateFromString() would and writes the result
+  // in a binary format CreateFromSharedMemory() reads without parsing: the
+  // table if there is one, else the dense model. Returns false if the text is
+  // not a valid model or the model has no binary form.
+  static bool CompileToBinary(InputModelType type,
+                              const std::string& model_str,
+                              double table_step,
+                              std::vector<uint8_t>* binary);
+
+  // Returns true if |data| is in one of the binary formats.
+  static bool IsBinary(const void* data, size_t size);
+
+  InputModelType type;
+  // Null for scroll tables compiled by the cloud trainer.
+  std::unique_ptr<SvmPredictor> predictor;
+  // Null unless this is a tabulated scroll model.
+  std::unique_ptr<FrameRateTable> frame_rate_table;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(InputModel);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_INPUT_MODEL_H_
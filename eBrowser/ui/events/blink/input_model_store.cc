@@ -0,0 +1,55 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/input_model_store.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "ui/events/blink/frame_rate_table.h"
+#include "ui/events/blink/input_model.h"
+#include "ui/events/blink/svm_predictor.h"
+
+namespace ui {
+
+OriginInputModels::OriginInputModels() {}
+
+OriginInputModels::~OriginInputModels() {}
+
+const size_t InputModelStore::kDefaultCapacity;
+
+InputModelStore::InputModelStore(size_t capacity) : models_(capacity) {
+  DCHECK_GT(capacity, 0u);
+}
+
+InputModelStore::~InputModelStore() {}
+
+void InputModelStore::Install(const std::string& origin,
+                              std::unique_ptr<InputModel> model) {
+  DCHECK(model && (model->predictor || model->frame_rate_table));
+  auto it = models_.Get(origin);
+  if (it == models_.end()) {
+    it = models_.Put(origin, base::MakeUnique<OriginInputModels>());
+    VLOG(1) << "Models for " << models_.size() << " origins";
+  }
+  OriginInputModels* models = it->second.get();
+  if (model->type == INPUT_MODEL_PINCH) {
+    models->pinch_predictor = std::move(model->predictor);
+    return;
+  }
+  models->predictor = std::move(model->predictor);
+  models->frame_rate_table = std::move(model->frame_rate_table);
+}
+
+const OriginInputModels* InputModelStore::Get(const std::string& origin) {
+  auto it = models_.Get(origin);
+  return it == models_.end() ? nullptr : it->second.get();
+}
+
+void InputModelStore::Clear() {
+  models_.Clear();
+}
+
+}  // namespace ui
@@ -0,0 +1,70 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_INPUT_MODEL_STORE_H_
+#define UI_EVENTS_BLINK_INPUT_MODEL_STORE_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+
+namespace ui {
+
+class FrameRateTable;
+class SvmPredictor;
+struct InputModel;
+
+// The prepared models of one origin. A gesture type without a model here
+// falls back to the proxy's default model.
+struct OriginInputModels {
+  OriginInputModels();
+  ~OriginInputModels();
+
+  bool has_scroll_model() const { return predictor || frame_rate_table; }
+
+  std::unique_ptr<SvmPredictor> predictor;
+  std::unique_ptr<FrameRateTable> frame_rate_table;
+  std::unique_ptr<SvmPredictor> pinch_predictor;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(OriginInputModels);
+};
+
+// Models specialized for the pages of an origin, e.g. a game that needs the
+// full frame rate or a news site that tolerates a low one. Models stay
+// compiled, and the least recently used origin is dropped once |capacity|
+// origins have models.
+class InputModelStore {
+ public:
+  static const size_t kDefaultCapacity = 8;
+
+  explicit InputModelStore(size_t capacity);
+  ~InputModelStore();
+
+  // Replaces the model of |model|'s type for |origin|, a serialized
+  // url::Origin.
+  void Install(const std::string& origin, std::unique_ptr<InputModel> model);
+
+  // Returns the models for |origin| and marks them most recently used, or
+  // null if the origin has none. The pointer is valid until the next
+  // Install() or Clear().
+  const OriginInputModels* Get(const std::string& origin);
+
+  void Clear();
+
+  size_t size() const { return models_.size(); }
+
+ private:
+  base::MRUCache<std::string, std::unique_ptr<OriginInputModels>> models_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputModelStore);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_INPUT_MODEL_STORE_H_
@@ -0,0 +1,63 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/input_model_store.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/input_model.h"
+
+namespace ui {
+namespace {
+
+const char kModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.5\n"
+    "nr_class 2\n"
+    "total_sv 1\n"
+    "rho -30\n"
+    "SV\n"
+    "10 1:1\n";
+
+std::unique_ptr<InputModel> Model(InputModelType type) {
+  return InputModel::CreateFromString(type, kModel, 0);
+}
+
+TEST(InputModelStoreTest, ModelsArePerOriginAndType) {
+  InputModelStore store(InputModelStore::kDefaultCapacity);
+  EXPECT_FALSE(store.Get("https://a.com"));
+
+  store.Install("https://a.com", Model(INPUT_MODEL_PINCH));
+  const OriginInputModels* models = store.Get("https://a.com");
+  ASSERT_TRUE(models);
+  EXPECT_TRUE(models->pinch_predictor);
+  EXPECT_FALSE(models->has_scroll_model());
+
+  store.Install("https://a.com", Model(INPUT_MODEL_SCROLL));
+  models = store.Get("https://a.com");
+  ASSERT_TRUE(models);
+  EXPECT_TRUE(models->has_scroll_model());
+  EXPECT_TRUE(models->pinch_predictor);
+  EXPECT_EQ(1u, store.size());
+  EXPECT_FALSE(store.Get("https://b.com"));
+}
+
+TEST(InputModelStoreTest, EvictsLeastRecentlyUsedOrigin) {
+  InputModelStore store(2);
+  store.Install("https://a.com", Model(INPUT_MODEL_SCROLL));
+  store.Install("https://b.com", Model(INPUT_MODEL_SCROLL));
+  // Visiting a.com keeps it over b.com.
+  EXPECT_TRUE(store.Get("https://a.com"));
+  store.Install("https://c.com", Model(INPUT_MODEL_SCROLL));
+  EXPECT_EQ(2u, store.size());
+  EXPECT_TRUE(store.Get("https://a.com"));
+  EXPECT_FALSE(store.Get("https://b.com"));
+  EXPECT_TRUE(store.Get("https://c.com"));
+
+  store.Clear();
+  EXPECT_EQ(0u, store.size());
+}
+
+}  // namespace
+}  // namespace ui
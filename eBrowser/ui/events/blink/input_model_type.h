@@ -0,0 +1,23 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_INPUT_MODEL_TYPE_H_
+#define UI_EVENTS_BLINK_INPUT_MODEL_TYPE_H_
+
+namespace ui {
+
+// The gesture an event rate model paces. Each type has its own predictor slot
+// in InputHandlerProxy and is trained on its own speed feature.
+// These values are sent over IPC and must match ContentViewCore.MODEL_TYPE_*.
+enum InputModelType {
+  // Speed feature: vertical scroll velocity, in physical pixels per second.
+  INPUT_MODEL_SCROLL,
+  // Speed feature: |d(ln scale)/dt| of the pinch, per second.
+  INPUT_MODEL_PINCH,
+  INPUT_MODEL_TYPE_LAST = INPUT_MODEL_PINCH
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_INPUT_MODEL_TYPE_H_
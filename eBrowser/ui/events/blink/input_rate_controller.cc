@@ -0,0 +1,386 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/input_rate_controller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "ui/events/blink/energy_curve.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace ui {
+
+namespace {
+
+const int kMaxFrameRate = ScrollUpdatePacer::kMaxFrameRate;
+// Most video is 30fps or less; dropping below that would drop its frames.
+const int kVideoMinFrameRate = 30;
+
+bool ParseFrameRate(const std::string& text, int* fps) {
+  return base::StringToInt(text, fps) && *fps >= 1 && *fps <= kMaxFrameRate;
+}
+
+bool ParseGestureClass(const std::string& name, InputGestureClass* gesture) {
+  if (name == "scroll")
+    *gesture = INPUT_GESTURE_SCROLL;
+  else if (name == "drag")
+    *gesture = INPUT_GESTURE_DRAG;
+  else if (name == "fling")
+    *gesture = INPUT_GESTURE_FLING;
+  else if (name == "pinch")
+    *gesture = INPUT_GESTURE_PINCH;
+  else
+    return false;
+  return true;
+}
+
+// Parses "model", "model:<min>-<max>" or a frame rate into a policy that
+// keeps |current|'s model and video bound.
+bool ParseGesturePolicy(const std::string& text,
+                        const GesturePolicy& current,
+                        GesturePolicy* policy) {
+  const char kModel[] = "model";
+  int fps;
+  if (ParseFrameRate(text, &fps)) {
+    *policy = GesturePolicy::Static(fps);
+    return true;
+  }
+  if (!base::StartsWith(text, kModel, base::CompareCase::SENSITIVE))
+    return false;
+  int min_fps = 1;
+  int max_fps = kMaxFrameRate;
+  std::string bounds = text.substr(sizeof(kModel) - 1);
+  if (!bounds.empty()) {
+    std::vector<std::string> range = base::SplitString(
+        bounds.substr(1), "-", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+    if (bounds[0] != ':' || range.size() != 2 ||
+        !ParseFrameRate(range[0], &min_fps) ||
+        !ParseFrameRate(range[1], &max_fps) || min_fps > max_fps) {
+      return false;
+    }
+  }
+  *policy = GesturePolicy::Model(
+      current.model, min_fps, max_fps,
+      current.use_model ? current.content_min_fps : kVideoMinFrameRate);
+  return true;
+}
+
+class NoInputRateController : public InputRateController {
+ public:
+  NoInputRateController() {}
+  ~NoInputRateController() override {}
+
+  InputRatePolicy policy() const override { return INPUT_RATE_POLICY_NONE; }
+
+  int FrameRate(const Models& models,
+                InputModelType type,
+                double speed) const override {
+    return ScrollUpdatePacer::kMaxFrameRate;
+  }
+
+  bool PacesInput() const override { return false; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NoInputRateController);
+};
+
+// Shared by the SVR-sleep and BeginFrame decimation policies, which only
+// differ in where the rate is applied, and the base of the energy budget one.
+class ModelInputRateController : public InputRateController {
+ public:
+  explicit ModelInputRateController(InputRatePolicy policy)
+      : policy_(policy) {}
+  ~ModelInputRateController() override {}
+
+  InputRatePolicy policy() const override { return policy_; }
+
+  int FrameRate(const Models& models,
+                InputModelType type,
+                double speed) const override {
+    int fps;
+    // Only scroll models are tabulated.
+    if (type == INPUT_MODEL_SCROLL && models.LookupFrameRateTable(speed, &fps))
+      return fps;
+    if (models.EvaluateModel(type, speed, &fps))
+      return fps;
+    return ScrollUpdatePacer::kMaxFrameRate;
+  }
+
+  bool PacesInput() const override {
+    return policy_ != INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION;
+  }
+
+ private:
+  const InputRatePolicy policy_;
+
+  DISALLOW_COPY_AND_ASSIGN(ModelInputRateController);
+};
+
+// The model's rate is the lowest users still find smooth, so satisfaction
+// only drops below it: the best rate within the budget is the highest one up
+// to the model's whose power fits.
+class EnergyBudgetInputRateController : public ModelInputRateController {
+ public:
+  EnergyBudgetInputRateController()
+      : ModelInputRateController(INPUT_RATE_POLICY_ENERGY_BUDGET) {}
+  ~EnergyBudgetInputRateController() override {}
+
+  int FrameRate(const Models& models,
+                InputModelType type,
+                double speed) const override {
+    int fps = ModelInputRateController::FrameRate(models, type, speed);
+    const EnergyCurve* curve = models.GetEnergyCurve();
+    if (!curve || !energy_budget().is_set())
+      return fps;
+    double milliwatts = BudgetMilliwatts(*curve);
+    for (; fps > kMinBudgetFrameRate; --fps) {
+      if (curve->MilliwattsAt(fps) <= milliwatts)
+        break;
+    }
+    return fps;
+  }
+
+ private:
+  // Below this, scrolling judders whatever it saves.
+  static const int kMinBudgetFrameRate = 10;
+
+  double BudgetMilliwatts(const EnergyCurve& curve) const {
+    const EnergyBudget& budget = energy_budget();
+    double milliwatts = budget.milliwatts > 0
+                            ? budget.milliwatts
+                            : std::numeric_limits<double>::infinity();
+    if (budget.full_rate_fraction > 0) {
+      milliwatts = std::min(milliwatts, budget.full_rate_fraction *
+                                            curve.MilliwattsAt(kMaxFrameRate));
+    }
+    return milliwatts;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(EnergyBudgetInputRateController);
+};
+
+class TableInputRateController : public InputRateController {
+ public:
+  TableInputRateController() {}
+  ~TableInputRateController() override {}
+
+  InputRatePolicy policy() const override {
+    return INPUT_RATE_POLICY_TABLE_LOOKUP;
+  }
+
+  int FrameRate(const Models& models,
+                InputModelType type,
+                double speed) const override {
+    int fps;
+    if (type == INPUT_MODEL_SCROLL && models.LookupFrameRateTable(speed, &fps))
+      return fps;
+    return ScrollUpdatePacer::kMaxFrameRate;
+  }
+
+  bool PacesInput() const override { return true; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TableInputRateController);
+};
+
+}  // namespace
+
+PageActivity::PageActivity() : video_playing(false), video_frame_rate(0) {}
+
+EnergyBudget::EnergyBudget() : milliwatts(0), full_rate_fraction(0) {}
+
+GesturePolicy::GesturePolicy()
+    : use_model(false),
+      model(INPUT_MODEL_SCROLL),
+      min_fps(kMaxFrameRate),
+      max_fps(kMaxFrameRate),
+      content_min_fps(kMaxFrameRate) {}
+
+// static
+GesturePolicy GesturePolicy::Model(InputModelType model,
+                                   int min_fps,
+                                   int max_fps,
+                                   int content_min_fps) {
+  GesturePolicy policy;
+  policy.use_model = true;
+  policy.model = model;
+  policy.min_fps = min_fps;
+  policy.max_fps = max_fps;
+  policy.content_min_fps = content_min_fps;
+  return policy;
+}
+
+// static
+GesturePolicy GesturePolicy::Static(int fps) {
+  GesturePolicy policy;
+  policy.min_fps = fps;
+  policy.max_fps = fps;
+  policy.content_min_fps = fps;
+  return policy;
+}
+
+InputRateController::InputRateController() {
+  gesture_policies_[INPUT_GESTURE_SCROLL] = GesturePolicy::Model(
+      INPUT_MODEL_SCROLL, 1, kMaxFrameRate, kVideoMinFrameRate);
+  // The finger is on something the page may be moving with it.
+  gesture_policies_[INPUT_GESTURE_DRAG] = GesturePolicy::Static(kMaxFrameRate);
+  // Fling velocities are in the units of the scroll model's speed feature.
+  gesture_policies_[INPUT_GESTURE_FLING] = GesturePolicy::Model(
+      INPUT_MODEL_SCROLL, 1, kMaxFrameRate, kVideoMinFrameRate);
+  gesture_policies_[INPUT_GESTURE_PINCH] = GesturePolicy::Model(
+      INPUT_MODEL_PINCH, 1, kMaxFrameRate, kVideoMinFrameRate);
+}
+
+InputRateController::~InputRateController() {}
+
+int InputRateController::GestureFrameRate(const Models& models,
+                                          InputGestureClass gesture,
+                                          double speed,
+                                          const PageActivity& activity) const {
+  if (policy() == INPUT_RATE_POLICY_NONE)
+    return kMaxFrameRate;
+  const GesturePolicy& gesture_policy = gesture_policies_[gesture];
+  if (!gesture_policy.use_model)
+    return gesture_policy.max_fps;
+  return AlignToDisplayRefreshRates(
+      ModelGestureFrameRate(models, gesture_policy, speed, activity),
+      gesture_policy.max_fps);
+}
+
+int InputRateController::ModelGestureFrameRate(
+    const Models& models,
+    const GesturePolicy& gesture_policy,
+    double speed,
+    const PageActivity& activity) const {
+  int fps = std::min(FrameRate(models, gesture_policy.model, speed),
+                     gesture_policy.max_fps);
+  int min_fps = gesture_policy.min_fps;
+  int video_fps = activity.video_frame_rate;
+  if (video_fps > 0 && video_fps < kMaxFrameRate) {
+    // The video's own rate is the floor that drops none of its frames, and
+    // at a multiple of it the gesture adds no frames the video does not
+    // already cause. Round up to one within the policy's bound, else down.
+    fps = std::max(std::max(fps, min_fps), video_fps);
+    int aligned_fps = (fps + video_fps - 1) / video_fps * video_fps;
+    if (aligned_fps <= gesture_policy.max_fps)
+      return aligned_fps;
+    // Every display frame presents whatever video frame is due.
+    if (gesture_policy.max_fps >= kMaxFrameRate)
+      return kMaxFrameRate;
+    return std::max(video_fps,
+                    gesture_policy.max_fps / video_fps * video_fps);
+  }
+  if (activity.video_playing)
+    min_fps = std::max(min_fps, gesture_policy.content_min_fps);
+  return std::max(fps, min_fps);
+}
+
+int InputRateController::AlignToDisplayRefreshRates(int fps,
+                                                    int max_fps) const {
+  if (display_refresh_rates_.empty() || fps < 1 || fps >= kMaxFrameRate)
+    return fps;
+  // The closest whole fractions of any refresh rate above and below |fps|.
+  int faster = kMaxFrameRate;
+  int slower = 0;
+  for (float refresh_rate : display_refresh_rates_) {
+    for (int refreshes_per_frame = 1;; ++refreshes_per_frame) {
+      int even_fps = static_cast<int>(
+          std::lround(refresh_rate / refreshes_per_frame));
+      if (even_fps < fps) {
+        slower = std::max(slower, even_fps);
+        break;
+      }
+      faster = std::min(faster, even_fps);
+    }
+  }
+  if (faster <= max_fps || slower < 1)
+    return faster;
+  return slower;
+}
+
+bool InputRateController::ParseGesturePolicies(const std::string& spec) {
+  GesturePolicy policies[INPUT_GESTURE_CLASS_LAST + 1];
+  std::copy(gesture_policies_, gesture_policies_ + arraysize(policies),
+            policies);
+  for (const std::string& entry : base::SplitString(
+           spec, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::vector<std::string> parts = base::SplitString(
+        entry, "=", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+    InputGestureClass gesture;
+    if (parts.size() != 2 || !ParseGestureClass(parts[0], &gesture) ||
+        !ParseGesturePolicy(parts[1], policies[gesture],
+                            &policies[gesture])) {
+      return false;
+    }
+  }
+  std::copy(policies, policies + arraysize(policies), gesture_policies_);
+  return true;
+}
+
+// static
+std::unique_ptr<InputRateController> InputRateController::Create(
+    InputRatePolicy policy) {
+  switch (policy) {
+    case INPUT_RATE_POLICY_NONE:
+      return std::unique_ptr<InputRateController>(new NoInputRateController());
+    case INPUT_RATE_POLICY_SVR_SLEEP:
+    case INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION:
+      return std::unique_ptr<InputRateController>(
+          new ModelInputRateController(policy));
+    case INPUT_RATE_POLICY_TABLE_LOOKUP:
+      return std::unique_ptr<InputRateController>(
+          new TableInputRateController());
+    case INPUT_RATE_POLICY_ENERGY_BUDGET:
+      return std::unique_ptr<InputRateController>(
+          new EnergyBudgetInputRateController());
+  }
+  NOTREACHED();
+  return nullptr;
+}
+
+// static
+bool InputRateController::ParsePolicy(const std::string& name,
+                                      InputRatePolicy* policy) {
+  if (name == "none")
+    *policy = INPUT_RATE_POLICY_NONE;
+  else if (name == "svr-sleep")
+    *policy = INPUT_RATE_POLICY_SVR_SLEEP;
+  else if (name == "begin-frame")
+    *policy = INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION;
+  else if (name == "table")
+    *policy = INPUT_RATE_POLICY_TABLE_LOOKUP;
+  else if (name == "energy-budget")
+    *policy = INPUT_RATE_POLICY_ENERGY_BUDGET;
+  else
+    return false;
+  return true;
+}
+
+// static
+const char* InputRateController::PolicyName(InputRatePolicy policy) {
+  switch (policy) {
+    case INPUT_RATE_POLICY_NONE:
+      return "none";
+    case INPUT_RATE_POLICY_SVR_SLEEP:
+      return "svr-sleep";
+    case INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION:
+      return "begin-frame";
+    case INPUT_RATE_POLICY_TABLE_LOOKUP:
+      return "table";
+    case INPUT_RATE_POLICY_ENERGY_BUDGET:
+      return "energy-budget";
+  }
+  NOTREACHED();
+  return "";
+}
+
+}  // namespace ui
@@ -0,0 +1,203 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_INPUT_RATE_CONTROLLER_H_
+#define UI_EVENTS_BLINK_INPUT_RATE_CONTROLLER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ui/events/blink/input_model_type.h"
+
+namespace ui {
+
+class EnergyCurve;
+
+// Pacing policies for InputHandlerProxy, selected with
+// --ebrowser-input-rate-controller.
+enum InputRatePolicy {
+  // Every gesture runs at the full frame rate.
+  INPUT_RATE_POLICY_NONE,
+  // The event rate model picks the rate, from its compiled table when there
+  // is one, and input is coalesced to that rate on the compositor thread.
+  // This is the default.
+  INPUT_RATE_POLICY_SVR_SLEEP,
+  // The model picks the rate as above, but it is only reported to the client
+  // so that BeginFrames are decimated; input is applied as it arrives.
+  INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION,
+  // Only the compiled scroll table is consulted. Gestures without a table run
+  // at the full frame rate instead of evaluating the kernel sum.
+  INPUT_RATE_POLICY_TABLE_LOOKUP,
+  // Like INPUT_RATE_POLICY_SVR_SLEEP, but no gesture draws more power than
+  // the controller's EnergyBudget allows on the device's EnergyCurve.
+  INPUT_RATE_POLICY_ENERGY_BUDGET,
+};
+
+// The gestures InputHandlerProxy tells apart, each paced by its own
+// GesturePolicy.
+enum InputGestureClass {
+  // A touchscreen, touchpad or wheel scroll.
+  INPUT_GESTURE_SCROLL,
+  // A scroll that began over a blocking touch listener, which the page may be
+  // tracking as a drag, e.g. a slider or a drawing surface. Drags the page
+  // consumes, and text selection, never become compositor scrolls.
+  INPUT_GESTURE_DRAG,
+  INPUT_GESTURE_FLING,
+  INPUT_GESTURE_PINCH,
+  INPUT_GESTURE_CLASS_LAST = INPUT_GESTURE_PINCH
+};
+
+// What a page shows besides the gesture, which a low frame rate would make
+// stutter too.
+struct PageActivity {
+  PageActivity();
+
+  bool video_playing;
+  // The rate a playing video presents frames at, when the renderer has
+  // measured it, or 0. Gestures then run at a multiple of it, so that their
+  // frames are the video's rather than interleaved with them.
+  int video_frame_rate;
+};
+
+// The power gestures may draw under INPUT_RATE_POLICY_ENERGY_BUDGET. Either
+// bound may be unset, at zero; with both set the lower one holds.
+struct EnergyBudget {
+  EnergyBudget();
+
+  bool is_set() const { return milliwatts > 0 || full_rate_fraction > 0; }
+
+  // A fixed power, in mW.
+  double milliwatts;
+  // A share of what a gesture draws at the full frame rate, in (0, 1].
+  double full_rate_fraction;
+};
+
+// How one gesture class is paced.
+struct GesturePolicy {
+  GesturePolicy();
+  // A rate predicted by |model|, bounded to [|min_fps|, |max_fps|]. Above
+  // |content_min_fps| instead while the page plays a video.
+  static GesturePolicy Model(InputModelType model,
+                             int min_fps,
+                             int max_fps,
+                             int content_min_fps);
+  // A fixed rate.
+  static GesturePolicy Static(int fps);
+
+  bool use_model;
+  InputModelType model;
+  int min_fps;
+  int max_fps;
+  int content_min_fps;
+};
+
+// Decides the frame rate InputHandlerProxy paces a gesture at, from the
+// models the proxy holds and a policy table keyed by gesture class.
+class InputRateController {
+ public:
+  // The proxy's models, as seen by a controller.
+  class Models {
+   public:
+    virtual ~Models() {}
+
+    // Evaluates the model in |type|'s slot at |speed|, clamped to the pacing
+    // range. Returns false if the slot is empty.
+    virtual bool EvaluateModel(InputModelType type,
+                               double speed,
+                               int* fps) const = 0;
+    // Looks |speed| up in the compiled scroll table, or in the default table
+    // while there is no scroll model at all. Returns false if there is none.
+    virtual bool LookupFrameRateTable(double speed, int* fps) const = 0;
+    // The device's energy cost per frame, or null if it has none.
+    virtual const EnergyCurve* GetEnergyCurve() const = 0;
+  };
+
+  virtual ~InputRateController();
+
+  static std::unique_ptr<InputRateController> Create(InputRatePolicy policy);
+
+  // Parses a --ebrowser-input-rate-controller value: "none", "svr-sleep",
+  // "begin-frame", "table" or "energy-budget". Returns false for anything
+  // else.
+  static bool ParsePolicy(const std::string& name, InputRatePolicy* policy);
+  // The name ParsePolicy() takes for |policy|.
+  static const char* PolicyName(InputRatePolicy policy);
+
+  // Returns the frame rate for |gesture| at |speed| on a page doing
+  // |activity|, from the gesture's policy. Model policies go through
+  // FrameRate() and are then aligned to the display refresh rates; under
+  // INPUT_RATE_POLICY_NONE everything runs at the full frame rate.
+  int GestureFrameRate(const Models& models,
+                       InputGestureClass gesture,
+                       double speed,
+                       const PageActivity& activity) const;
+
+  const GesturePolicy& gesture_policy(InputGestureClass gesture) const {
+    return gesture_policies_[gesture];
+  }
+  void set_gesture_policy(InputGestureClass gesture,
+                          const GesturePolicy& policy) {
+    gesture_policies_[gesture] = policy;
+  }
+
+  // Overrides policies from a --ebrowser-gesture-rate-policies value: comma
+  // separated "<class>=<rate>" entries, where the class is "scroll", "drag",
+  // "fling" or "pinch" and the rate is "model", "model:<min>-<max>" or a
+  // fixed frame rate, e.g. "fling=model:20-60,drag=60". Returns false, with
+  // no policy changed, if any entry is malformed.
+  bool ParseGesturePolicies(const std::string& spec);
+
+  // The rates, in Hz, the display the gestures are shown on can refresh at,
+  // or empty if they are not known. A display shows a frame rate evenly only
+  // at a whole fraction of its refresh rate, so model rates are raised to the
+  // nearest such rate, e.g. 45fps to 60fps on a 60Hz panel but not on a 90Hz
+  // one. Where that would pass the gesture's |max_fps|, they are lowered to
+  // one instead.
+  const std::vector<float>& display_refresh_rates() const {
+    return display_refresh_rates_;
+  }
+  void set_display_refresh_rates(const std::vector<float>& refresh_rates) {
+    display_refresh_rates_ = refresh_rates;
+  }
+
+  // Only INPUT_RATE_POLICY_ENERGY_BUDGET controllers act on the budget.
+  const EnergyBudget& energy_budget() const { return energy_budget_; }
+  void set_energy_budget(const EnergyBudget& budget) {
+    energy_budget_ = budget;
+  }
+
+  virtual InputRatePolicy policy() const = 0;
+
+  // Returns the frame rate for a gesture of |type| at |speed|, in the units
+  // of that type's speed feature.
+  virtual int FrameRate(const Models& models,
+                        InputModelType type,
+                        double speed) const = 0;
+
+  // Whether scroll and pinch updates and fling ticks are coalesced to the
+  // rate on the compositor thread. If not, the rate still reaches
+  // InputHandlerProxyClient::DidChangeTargetFrameRate().
+  virtual bool PacesInput() const = 0;
+
+ protected:
+  InputRateController();
+
+ private:
+  // The rate a model policy picks, before display alignment.
+  int ModelGestureFrameRate(const Models& models,
+                            const GesturePolicy& gesture_policy,
+                            double speed,
+                            const PageActivity& activity) const;
+  // See set_display_refresh_rates().
+  int AlignToDisplayRefreshRates(int fps, int max_fps) const;
+
+  GesturePolicy gesture_policies_[INPUT_GESTURE_CLASS_LAST + 1];
+  EnergyBudget energy_budget_;
+  std::vector<float> display_refresh_rates_;
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_INPUT_RATE_CONTROLLER_H_
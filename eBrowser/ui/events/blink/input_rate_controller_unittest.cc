@@ -0,0 +1,337 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/input_rate_controller.h"
+
+#include "base/macros.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/energy_curve.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace ui {
+namespace {
+
+// Predicts 30fps for scrolls and 20fps for pinches; the table, 40fps.
+class FakeModels : public InputRateController::Models {
+ public:
+  FakeModels() : has_models_(true), has_table_(true), energy_curve_(nullptr) {}
+  ~FakeModels() override {}
+
+  bool EvaluateModel(InputModelType type,
+                     double speed,
+                     int* fps) const override {
+    if (!has_models_)
+      return false;
+    *fps = type == INPUT_MODEL_PINCH ? 20 : 30;
+    return true;
+  }
+
+  bool LookupFrameRateTable(double speed, int* fps) const override {
+    if (!has_table_)
+      return false;
+    *fps = 40;
+    return true;
+  }
+
+  const EnergyCurve* GetEnergyCurve() const override { return energy_curve_; }
+
+  void set_has_models(bool has_models) { has_models_ = has_models; }
+  void set_has_table(bool has_table) { has_table_ = has_table; }
+  void set_energy_curve(const EnergyCurve* curve) { energy_curve_ = curve; }
+
+ private:
+  bool has_models_;
+  bool has_table_;
+  const EnergyCurve* energy_curve_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeModels);
+};
+
+const int kMaxFrameRate = ScrollUpdatePacer::kMaxFrameRate;
+
+TEST(InputRateControllerTest, ParsePolicy) {
+  InputRatePolicy policy = INPUT_RATE_POLICY_SVR_SLEEP;
+  EXPECT_TRUE(InputRateController::ParsePolicy("none", &policy));
+  EXPECT_EQ(INPUT_RATE_POLICY_NONE, policy);
+  EXPECT_TRUE(InputRateController::ParsePolicy("svr-sleep", &policy));
+  EXPECT_EQ(INPUT_RATE_POLICY_SVR_SLEEP, policy);
+  EXPECT_TRUE(InputRateController::ParsePolicy("begin-frame", &policy));
+  EXPECT_EQ(INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION, policy);
+  EXPECT_TRUE(InputRateController::ParsePolicy("table", &policy));
+  EXPECT_EQ(INPUT_RATE_POLICY_TABLE_LOOKUP, policy);
+  EXPECT_TRUE(InputRateController::ParsePolicy("energy-budget", &policy));
+  EXPECT_EQ(INPUT_RATE_POLICY_ENERGY_BUDGET, policy);
+
+  EXPECT_FALSE(InputRateController::ParsePolicy("", &policy));
+  EXPECT_FALSE(InputRateController::ParsePolicy("svr", &policy));
+  EXPECT_EQ(INPUT_RATE_POLICY_ENERGY_BUDGET, policy);
+}
+
+// Field trial arms are named like the switch values, so the names must
+// parse back to their policies.
+TEST(InputRateControllerTest, PolicyNameRoundTrips) {
+  const InputRatePolicy kPolicies[] = {
+      INPUT_RATE_POLICY_NONE, INPUT_RATE_POLICY_SVR_SLEEP,
+      INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION, INPUT_RATE_POLICY_TABLE_LOOKUP,
+      INPUT_RATE_POLICY_ENERGY_BUDGET};
+  for (InputRatePolicy policy : kPolicies) {
+    InputRatePolicy parsed = INPUT_RATE_POLICY_SVR_SLEEP;
+    EXPECT_TRUE(InputRateController::ParsePolicy(
+        InputRateController::PolicyName(policy), &parsed));
+    EXPECT_EQ(policy, parsed);
+  }
+}
+
+TEST(InputRateControllerTest, None) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_NONE);
+  EXPECT_EQ(INPUT_RATE_POLICY_NONE, controller->policy());
+  EXPECT_EQ(kMaxFrameRate,
+            controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+  EXPECT_EQ(kMaxFrameRate,
+            controller->FrameRate(models, INPUT_MODEL_PINCH, 1));
+}
+
+TEST(InputRateControllerTest, SvrSleepPrefersTheTable) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP);
+  EXPECT_TRUE(controller->PacesInput());
+  EXPECT_EQ(40, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+  // Pinches have no table.
+  EXPECT_EQ(20, controller->FrameRate(models, INPUT_MODEL_PINCH, 1));
+
+  models.set_has_table(false);
+  EXPECT_EQ(30, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+
+  models.set_has_models(false);
+  EXPECT_EQ(kMaxFrameRate,
+            controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+  EXPECT_EQ(kMaxFrameRate,
+            controller->FrameRate(models, INPUT_MODEL_PINCH, 1));
+}
+
+TEST(InputRateControllerTest, BeginFrameDecimationOnlyReportsTheRate) {
+  FakeModels models;
+  models.set_has_table(false);
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION);
+  EXPECT_EQ(INPUT_RATE_POLICY_BEGIN_FRAME_DECIMATION, controller->policy());
+  EXPECT_FALSE(controller->PacesInput());
+  EXPECT_EQ(30, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+}
+
+TEST(InputRateControllerTest, TableLookupNeverEvaluatesTheModel) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_TABLE_LOOKUP);
+  EXPECT_TRUE(controller->PacesInput());
+  EXPECT_EQ(40, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+  EXPECT_EQ(kMaxFrameRate,
+            controller->FrameRate(models, INPUT_MODEL_PINCH, 1));
+
+  models.set_has_table(false);
+  EXPECT_EQ(kMaxFrameRate,
+            controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+}
+
+TEST(InputRateControllerTest, EnergyBudgetCapsTheModelRate) {
+  // 10fps draws 80mW, 30fps 180mW and 60fps 300mW.
+  std::unique_ptr<EnergyCurve> curve = EnergyCurve::CreateFromString(
+      "energy_curve\n"
+      "frame_rates 10 30 60\n"
+      "millijoules_per_frame 8 6 5\n");
+  ASSERT_TRUE(curve);
+  FakeModels models;
+  models.set_has_table(false);
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_ENERGY_BUDGET);
+  EXPECT_EQ(INPUT_RATE_POLICY_ENERGY_BUDGET, controller->policy());
+  EXPECT_TRUE(controller->PacesInput());
+
+  // Without a curve or a budget, the model's rate.
+  EnergyBudget budget;
+  budget.milliwatts = 100;
+  controller->set_energy_budget(budget);
+  EXPECT_EQ(30, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+  models.set_energy_curve(curve.get());
+  controller->set_energy_budget(EnergyBudget());
+  EXPECT_EQ(30, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+
+  // A budget above the model's rate never raises it.
+  budget.milliwatts = 1000;
+  controller->set_energy_budget(budget);
+  EXPECT_EQ(30, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+
+  // 13fps draws 7.7mJ * 13 = 100.1mW.
+  budget.milliwatts = 100;
+  controller->set_energy_budget(budget);
+  EXPECT_EQ(12, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+  // Too small a budget still leaves 10fps.
+  budget.milliwatts = 1;
+  controller->set_energy_budget(budget);
+  EXPECT_EQ(10, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+
+  // Half the full rate's 300mW fits 22fps; the lower of both bounds holds.
+  budget.milliwatts = 0;
+  budget.full_rate_fraction = 0.5;
+  controller->set_energy_budget(budget);
+  EXPECT_EQ(22, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+  budget.milliwatts = 100;
+  controller->set_energy_budget(budget);
+  EXPECT_EQ(12, controller->FrameRate(models, INPUT_MODEL_SCROLL, 100));
+}
+
+TEST(InputRateControllerTest, DefaultGesturePolicies) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP);
+  PageActivity activity;
+  EXPECT_EQ(40, controller->GestureFrameRate(models, INPUT_GESTURE_SCROLL, 100,
+                                             activity));
+  EXPECT_EQ(40, controller->GestureFrameRate(models, INPUT_GESTURE_FLING, 100,
+                                             activity));
+  EXPECT_EQ(20, controller->GestureFrameRate(models, INPUT_GESTURE_PINCH, 1,
+                                             activity));
+  EXPECT_EQ(kMaxFrameRate, controller->GestureFrameRate(
+                               models, INPUT_GESTURE_DRAG, 100, activity));
+
+  // Video keeps gestures at 30fps and above.
+  activity.video_playing = true;
+  EXPECT_EQ(40, controller->GestureFrameRate(models, INPUT_GESTURE_SCROLL, 100,
+                                             activity));
+  EXPECT_EQ(30, controller->GestureFrameRate(models, INPUT_GESTURE_PINCH, 1,
+                                             activity));
+}
+
+TEST(InputRateControllerTest, GesturesAlignToVideoFrameRate) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP);
+  controller->set_gesture_policy(
+      INPUT_GESTURE_FLING, GesturePolicy::Model(INPUT_MODEL_SCROLL, 1, 35, 30));
+  PageActivity activity;
+  activity.video_playing = true;
+
+  // A measured rate replaces the 30fps floor, and gestures run at the
+  // smallest multiple of it.
+  activity.video_frame_rate = 24;
+  EXPECT_EQ(48, controller->GestureFrameRate(models, INPUT_GESTURE_SCROLL, 100,
+                                             activity));
+  EXPECT_EQ(24, controller->GestureFrameRate(models, INPUT_GESTURE_PINCH, 1,
+                                             activity));
+  // Rounding up would pass the policy's 35fps bound.
+  EXPECT_EQ(24, controller->GestureFrameRate(models, INPUT_GESTURE_FLING, 100,
+                                             activity));
+  EXPECT_EQ(kMaxFrameRate, controller->GestureFrameRate(
+                               models, INPUT_GESTURE_DRAG, 100, activity));
+
+  activity.video_frame_rate = 30;
+  EXPECT_EQ(kMaxFrameRate, controller->GestureFrameRate(
+                               models, INPUT_GESTURE_SCROLL, 100, activity));
+  EXPECT_EQ(30, controller->GestureFrameRate(models, INPUT_GESTURE_PINCH, 1,
+                                             activity));
+
+  // Video at the display rate leaves only the floor.
+  activity.video_frame_rate = kMaxFrameRate;
+  EXPECT_EQ(40, controller->GestureFrameRate(models, INPUT_GESTURE_SCROLL, 100,
+                                             activity));
+}
+
+TEST(InputRateControllerTest, GesturesAlignToDisplayRefreshRates) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP);
+  controller->set_gesture_policy(
+      INPUT_GESTURE_FLING, GesturePolicy::Model(INPUT_MODEL_SCROLL, 1, 35, 30));
+  controller->set_gesture_policy(INPUT_GESTURE_DRAG,
+                                 GesturePolicy::Static(45));
+  PageActivity activity;
+
+  // A 60Hz panel shows 40fps no better than 60fps, and 35fps only at 30fps.
+  controller->set_display_refresh_rates(std::vector<float>(1, 59.94f));
+  EXPECT_EQ(kMaxFrameRate, controller->GestureFrameRate(
+                               models, INPUT_GESTURE_SCROLL, 100, activity));
+  EXPECT_EQ(30, controller->GestureFrameRate(models, INPUT_GESTURE_FLING, 100,
+                                             activity));
+  EXPECT_EQ(20, controller->GestureFrameRate(models, INPUT_GESTURE_PINCH, 1,
+                                             activity));
+  // Fixed rates are taken as they are.
+  EXPECT_EQ(45, controller->GestureFrameRate(models, INPUT_GESTURE_DRAG, 100,
+                                             activity));
+
+  // 40fps is a third of 120Hz.
+  controller->set_display_refresh_rates({60.f, 90.f, 120.f});
+  EXPECT_EQ(40, controller->GestureFrameRate(models, INPUT_GESTURE_SCROLL, 100,
+                                             activity));
+  EXPECT_EQ(30, controller->GestureFrameRate(models, INPUT_GESTURE_FLING, 100,
+                                             activity));
+}
+
+TEST(InputRateControllerTest, NoneIgnoresGesturePolicies) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_NONE);
+  controller->set_gesture_policy(INPUT_GESTURE_DRAG, GesturePolicy::Static(10));
+  EXPECT_EQ(kMaxFrameRate,
+            controller->GestureFrameRate(models, INPUT_GESTURE_DRAG, 100,
+                                         PageActivity()));
+}
+
+TEST(InputRateControllerTest, ModelPolicyBounds) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP);
+  controller->set_gesture_policy(
+      INPUT_GESTURE_SCROLL,
+      GesturePolicy::Model(INPUT_MODEL_SCROLL, 45, 50, 55));
+  controller->set_gesture_policy(
+      INPUT_GESTURE_FLING, GesturePolicy::Model(INPUT_MODEL_SCROLL, 1, 35, 30));
+  PageActivity activity;
+  EXPECT_EQ(45, controller->GestureFrameRate(models, INPUT_GESTURE_SCROLL, 100,
+                                             activity));
+  EXPECT_EQ(35, controller->GestureFrameRate(models, INPUT_GESTURE_FLING, 100,
+                                             activity));
+  activity.video_playing = true;
+  EXPECT_EQ(55, controller->GestureFrameRate(models, INPUT_GESTURE_SCROLL, 100,
+                                             activity));
+}
+
+TEST(InputRateControllerTest, ParseGesturePolicies) {
+  FakeModels models;
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(INPUT_RATE_POLICY_SVR_SLEEP);
+  EXPECT_TRUE(controller->ParseGesturePolicies(
+      "fling=model:45-60, drag=model, pinch=24"));
+
+  const GesturePolicy& fling = controller->gesture_policy(INPUT_GESTURE_FLING);
+  EXPECT_TRUE(fling.use_model);
+  EXPECT_EQ(INPUT_MODEL_SCROLL, fling.model);
+  EXPECT_EQ(45, fling.min_fps);
+  EXPECT_EQ(kMaxFrameRate, fling.max_fps);
+  EXPECT_EQ(45, controller->GestureFrameRate(models, INPUT_GESTURE_FLING, 100,
+                                             PageActivity()));
+  // A drag taken off its fixed rate goes by the scroll model, unbounded.
+  EXPECT_EQ(40, controller->GestureFrameRate(models, INPUT_GESTURE_DRAG, 100,
+                                             PageActivity()));
+  EXPECT_EQ(24, controller->GestureFrameRate(models, INPUT_GESTURE_PINCH, 1,
+                                             PageActivity()));
+
+  EXPECT_TRUE(controller->ParseGesturePolicies(""));
+  EXPECT_FALSE(controller->ParseGesturePolicies("tap=60"));
+  EXPECT_FALSE(controller->ParseGesturePolicies("scroll=0"));
+  EXPECT_FALSE(controller->ParseGesturePolicies("scroll=61"));
+  EXPECT_FALSE(controller->ParseGesturePolicies("scroll=model:40"));
+  EXPECT_FALSE(controller->ParseGesturePolicies("scroll=model:50-40"));
+  EXPECT_FALSE(controller->ParseGesturePolicies("scroll=modelx"));
+  // A bad entry leaves the good ones before it unapplied.
+  EXPECT_FALSE(controller->ParseGesturePolicies("scroll=30,pinch=fast"));
+  EXPECT_TRUE(controller->gesture_policy(INPUT_GESTURE_SCROLL).use_model);
+  EXPECT_EQ(24, controller->GestureFrameRate(models, INPUT_GESTURE_PINCH, 1,
+                                             PageActivity()));
+}
+
+}  // namespace
+}  // namespace ui
@@ -10,6 +10,7 @@
 
 #include "base/bind.h"
 #include "cc/input/input_handler.h"
+#include "ui/events/blink/scroll_update_pacer.h"
 #include "ui/gfx/geometry/vector2d_conversions.h"
 
 // InputScrollElasticityController is based on
@@ -93,6 +94,8 @@ InputScrollElasticityController::InputScrollElasticityController(
     : helper_(helper),
       state_(kStateInactive),
       momentum_animation_reset_at_next_frame_(false),
+      queued_gesture_events_(0),
+      animation_frame_rate_(ScrollUpdatePacer::kMaxFrameRate),
       weak_factory_(this) {
 }
 
@@ -106,9 +109,22 @@ InputScrollElasticityController::GetWeakPtr() {
   return base::WeakPtr<InputScrollElasticityController>();
 }
 
+bool InputScrollElasticityController::WillObserveGestureEvent(
+    const blink::WebGestureEvent& gesture_event) {
+  if (state_ == kStateInactive && !queued_gesture_events_ &&
+      gesture_event.type != blink::WebInputEvent::GestureScrollBegin) {
+    return false;
+  }
+  ++queued_gesture_events_;
+  return true;
+}
+
 void InputScrollElasticityController::ObserveGestureEventAndResult(
     const blink::WebGestureEvent& gesture_event,
     const cc::InputHandlerScrollResult& scroll_result) {
+  if (queued_gesture_events_)
+    --queued_gesture_events_;
+
   base::TimeTicks event_timestamp =
       base::TimeTicks() +
       base::TimeDelta::FromSecondsD(gesture_event.timeStampSeconds);
@@ -262,6 +278,7 @@ void InputScrollElasticityController::EnterStateMomentumAnimated(
   momentum_animation_initial_stretch_ = helper_->StretchAmount();
   momentum_animation_initial_velocity_ = scroll_velocity;
   momentum_animation_reset_at_next_frame_ = false;
+  last_animation_frame_time_ = base::TimeTicks();
 
   // Similarly to the logic in Overscroll, prefer vertical scrolling to
   // horizontal scrolling.
@@ -293,6 +310,13 @@ void InputScrollElasticityController::Animate(base::TimeTicks time) {
     momentum_animation_reset_at_next_frame_ = false;
   }
 
+  if (!ScrollUpdatePacer::IsFrameDue(last_animation_frame_time_, time,
+                                     animation_frame_rate_)) {
+    helper_->RequestOneBeginFrame();
+    return;
+  }
+  last_animation_frame_time_ = time;
+
   float time_delta =
       std::max((time - momentum_animation_start_time_).InSecondsF(), 0.0);
 
@@ -7,6 +7,7 @@
 
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "cc/input/scroll_elasticity_helper.h"
 #include "third_party/WebKit/public/platform/WebInputEvent.h"
 
@@ -59,8 +60,23 @@ class InputScrollElasticityController {
       const blink::WebGestureEvent& gesture_event,
       const cc::InputHandlerScrollResult& scroll_result);
 
+  // Whether |gesture_event| has to be passed on to
+  // ObserveGestureEventAndResult(). While the controller is at rest only the
+  // start of a scroll can change its state, so the other events of a gesture
+  // that has not started an overscroll can be dropped without posting them.
+  // The events let through are counted until they are observed, so that the
+  // ones queued behind a scroll begin are kept.
+  bool WillObserveGestureEvent(const blink::WebGestureEvent& gesture_event);
+
+  // Does nothing, and requests no frame, unless the stretch is animating.
   void Animate(base::TimeTicks time);
 
+  // The rate, up to the display rate, at which Animate() updates the
+  // stretch while it rebounds. The frames in between only request the next
+  // one; the stretch is a function of the time since the rebound began, so it
+  // comes to rest at the same time at any rate.
+  void set_animation_frame_rate(int fps) { animation_frame_rate_ = fps; }
+
   void ReconcileStretchAndScroll();
 
  private:
@@ -139,6 +155,13 @@ class InputScrollElasticityController {
   // behavior as would happen if the scroll were caused by an active scroll).
   bool momentum_animation_reset_at_next_frame_;
 
+  // See WillObserveGestureEvent().
+  int queued_gesture_events_;
+
+  // See set_animation_frame_rate().
+  int animation_frame_rate_;
+  base::TimeTicks last_animation_frame_time_;
+
   base::WeakPtrFactory<InputScrollElasticityController> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(InputScrollElasticityController);
 };
@@ -420,5 +420,65 @@ TEST_F(ScrollElasticityControllerTest,
   EXPECT_GT(ticks_to_zero, 3);
 }
 
+// Verify that at rest only the start of a scroll is passed on, and that the
+// events queued behind it are kept until it has been observed.
+TEST_F(ScrollElasticityControllerTest, EventsSkippedAtRest) {
+  cc::InputHandlerScrollResult scroll_result;
+  blink::WebGestureEvent update;
+  update.type = blink::WebInputEvent::GestureScrollUpdate;
+  blink::WebGestureEvent end;
+  end.type = blink::WebInputEvent::GestureScrollEnd;
+  EXPECT_FALSE(controller_.WillObserveGestureEvent(update));
+  EXPECT_FALSE(controller_.WillObserveGestureEvent(end));
+
+  // A scroll of unknown phase leaves the controller at rest.
+  blink::WebGestureEvent begin;
+  begin.type = blink::WebInputEvent::GestureScrollBegin;
+  begin.data.scrollBegin.inertialPhase =
+      static_cast<blink::WebGestureEvent::InertialPhaseState>(
+          UnknownMomentumPhase);
+  EXPECT_TRUE(controller_.WillObserveGestureEvent(begin));
+  EXPECT_TRUE(controller_.WillObserveGestureEvent(update));
+  controller_.ObserveGestureEventAndResult(begin, scroll_result);
+  controller_.ObserveGestureEventAndResult(update, scroll_result);
+  EXPECT_FALSE(controller_.WillObserveGestureEvent(update));
+
+  // A precise one does not.
+  begin.data.scrollBegin.inertialPhase =
+      static_cast<blink::WebGestureEvent::InertialPhaseState>(
+          NonMomentumPhase);
+  EXPECT_TRUE(controller_.WillObserveGestureEvent(begin));
+  controller_.ObserveGestureEventAndResult(begin, scroll_result);
+  EXPECT_TRUE(controller_.WillObserveGestureEvent(update));
+  EXPECT_TRUE(controller_.WillObserveGestureEvent(end));
+}
+
+// Verify that the rebound only updates the stretch at the animation frame
+// rate, but keeps requesting frames in between.
+TEST_F(ScrollElasticityControllerTest, AnimationFrameRate) {
+  helper_.SetScrollOffsetAndMaxScrollOffset(gfx::ScrollOffset(0, 0),
+                                            gfx::ScrollOffset(10, 10));
+  gfx::Vector2dF delta(0, -100);
+  SendGestureScrollBegin(NonMomentumPhase);
+  for (int i = 0; i < 4; ++i)
+    SendGestureScrollUpdate(NonMomentumPhase, delta, delta);
+  SendGestureScrollEnd();
+  EXPECT_NE(helper_.StretchAmount(), gfx::Vector2dF(0, 0));
+  int stretch_count = helper_.set_stretch_amount_count();
+  int begin_frame_count = helper_.request_begin_frame_count();
+
+  // At 20fps, two of every three 60fps frames leave the stretch alone.
+  controller_.set_animation_frame_rate(20);
+  for (int frame = 0; frame < 6; ++frame) {
+    TickCurrentTimeAndAnimate();
+    if (frame % 3 == 0)
+      stretch_count += 1;
+    begin_frame_count += 1;
+    EXPECT_EQ(stretch_count, helper_.set_stretch_amount_count());
+    EXPECT_EQ(begin_frame_count, helper_.request_begin_frame_count());
+  }
+  EXPECT_NE(helper_.StretchAmount(), gfx::Vector2dF(0, 0));
+}
+
 }  // namespace
 }  // namespace ui
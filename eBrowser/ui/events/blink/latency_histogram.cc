@@ -0,0 +1,183 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_event_argument.h"
+
+namespace ui {
+
+namespace {
+
+const char* const kGestureLatencyTypeNames[] = {
+    "scroll_begin", "scroll_update", "pinch_begin", "pinch_update",
+    "fling_start",
+};
+static_assert(arraysize(kGestureLatencyTypeNames) ==
+                  GESTURE_LATENCY_TYPE_COUNT,
+              "a name is needed for each gesture type");
+
+}  // namespace
+
+const int LatencyHistogram::kSubBucketBits;
+const int LatencyHistogram::kSubBucketCount;
+const int LatencyHistogram::kMaxMagnitude;
+const size_t LatencyHistogram::kBucketCount;
+
+LatencyHistogram::LatencyHistogram() {
+  std::fill(counts_, counts_ + kBucketCount, 0);
+}
+
+LatencyHistogram::~LatencyHistogram() {}
+
+// static
+size_t LatencyHistogram::BucketForLatency(base::TimeDelta latency) {
+  int64_t us = std::min<int64_t>(std::max<int64_t>(latency.InMicroseconds(), 0),
+                                 (INT64_C(1) << kMaxMagnitude) - 1);
+  if (us < kSubBucketCount)
+    return static_cast<size_t>(us);
+  int magnitude = base::bits::Log2Floor(static_cast<uint32_t>(us));
+  int shift = magnitude - kSubBucketBits;
+  return kSubBucketCount * (shift + 1) +
+         static_cast<size_t>((us >> shift) - kSubBucketCount);
+}
+
+// static
+base::TimeDelta LatencyHistogram::BucketMin(size_t bucket) {
+  DCHECK_LT(bucket, kBucketCount);
+  if (bucket < static_cast<size_t>(kSubBucketCount))
+    return base::TimeDelta::FromMicroseconds(bucket);
+  int shift = static_cast<int>(bucket / kSubBucketCount) - 1;
+  int64_t sub_bucket = bucket % kSubBucketCount;
+  return base::TimeDelta::FromMicroseconds((kSubBucketCount + sub_bucket)
+                                           << shift);
+}
+
+// static
+base::TimeDelta LatencyHistogram::BucketMax(size_t bucket) {
+  DCHECK_LT(bucket, kBucketCount);
+  if (bucket < static_cast<size_t>(kSubBucketCount))
+    return base::TimeDelta::FromMicroseconds(bucket + 1);
+  int shift = static_cast<int>(bucket / kSubBucketCount) - 1;
+  int64_t sub_bucket = bucket % kSubBucketCount;
+  return base::TimeDelta::FromMicroseconds((kSubBucketCount + sub_bucket + 1)
+                                           << shift);
+}
+
+void LatencyHistogram::Record(base::TimeDelta latency, int count) {
+  base::subtle::NoBarrier_AtomicIncrement(&counts_[BucketForLatency(latency)],
+                                          count);
+}
+
+void LatencyHistogram::TakeInto(LatencyHistogramSnapshot* snapshot) {
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    base::subtle::Atomic32 count =
+        base::subtle::NoBarrier_AtomicExchange(&counts_[i], 0);
+    snapshot->counts_[i] += static_cast<uint32_t>(count);
+    snapshot->count_ += static_cast<uint32_t>(count);
+  }
+}
+
+LatencyHistogramSnapshot::LatencyHistogramSnapshot() {
+  Clear();
+}
+
+LatencyHistogramSnapshot::~LatencyHistogramSnapshot() {}
+
+base::TimeDelta LatencyHistogramSnapshot::Percentile(double percentile) const {
+  if (!count_)
+    return base::TimeDelta();
+  double clamped = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(clamped / 100 * count_)));
+  uint64_t seen = 0;
+  size_t bucket = 0;
+  for (; bucket < LatencyHistogram::kBucketCount - 1; ++bucket) {
+    seen += counts_[bucket];
+    if (seen >= rank)
+      break;
+  }
+  base::TimeDelta min = LatencyHistogram::BucketMin(bucket);
+  return min + (LatencyHistogram::BucketMax(bucket) - min) / 2;
+}
+
+void LatencyHistogramSnapshot::Clear() {
+  std::fill(counts_, counts_ + LatencyHistogram::kBucketCount, 0);
+  count_ = 0;
+}
+
+bool GetGestureLatencyType(blink::WebInputEvent::Type type,
+                           GestureLatencyType* gesture_type) {
+  switch (type) {
+    case blink::WebInputEvent::GestureScrollBegin:
+      *gesture_type = GESTURE_LATENCY_SCROLL_BEGIN;
+      return true;
+    case blink::WebInputEvent::GestureScrollUpdate:
+      *gesture_type = GESTURE_LATENCY_SCROLL_UPDATE;
+      return true;
+    case blink::WebInputEvent::GesturePinchBegin:
+      *gesture_type = GESTURE_LATENCY_PINCH_BEGIN;
+      return true;
+    case blink::WebInputEvent::GesturePinchUpdate:
+      *gesture_type = GESTURE_LATENCY_PINCH_UPDATE;
+      return true;
+    case blink::WebInputEvent::GestureFlingStart:
+      *gesture_type = GESTURE_LATENCY_FLING_START;
+      return true;
+    default:
+      return false;
+  }
+}
+
+const int GestureLatencyHistograms::kMergeIntervalSeconds;
+
+GestureLatencyHistograms::GestureLatencyHistograms(const char* trace_name)
+    : trace_name_(trace_name) {}
+
+GestureLatencyHistograms::~GestureLatencyHistograms() {}
+
+void GestureLatencyHistograms::Record(blink::WebInputEvent::Type type,
+                                      base::TimeDelta latency,
+                                      int count) {
+  GestureLatencyType gesture_type;
+  if (GetGestureLatencyType(type, &gesture_type))
+    histograms_[gesture_type].Record(latency, count);
+}
+
+bool GestureLatencyHistograms::MaybeMerge(base::TimeTicks now) {
+  if (!last_merge_time_.is_null() &&
+      now - last_merge_time_ <
+          base::TimeDelta::FromSeconds(kMergeIntervalSeconds)) {
+    return false;
+  }
+  last_merge_time_ = now;
+
+  std::unique_ptr<base::trace_event::TracedValue> percentiles(
+      new base::trace_event::TracedValue());
+  for (int i = 0; i < GESTURE_LATENCY_TYPE_COUNT; ++i) {
+    histograms_[i].TakeInto(&snapshots_[i]);
+    const LatencyHistogramSnapshot& snapshot = snapshots_[i];
+    if (!snapshot.count())
+      continue;
+    percentiles->BeginDictionary(kGestureLatencyTypeNames[i]);
+    percentiles->SetDouble("count", static_cast<double>(snapshot.count()));
+    percentiles->SetDouble("p50_ms", snapshot.Percentile(50).InMillisecondsF());
+    percentiles->SetDouble("p95_ms", snapshot.Percentile(95).InMillisecondsF());
+    percentiles->SetDouble("p99_ms", snapshot.Percentile(99).InMillisecondsF());
+    percentiles->EndDictionary();
+  }
+  TRACE_EVENT_INSTANT1("input,benchmark", trace_name_, TRACE_EVENT_SCOPE_THREAD,
+                       "data", std::move(percentiles));
+  return true;
+}
+
+}  // namespace ui
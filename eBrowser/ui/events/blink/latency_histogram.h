@@ -0,0 +1,131 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_LATENCY_HISTOGRAM_H_
+#define UI_EVENTS_BLINK_LATENCY_HISTOGRAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/atomicops.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "third_party/WebKit/public/platform/WebInputEvent.h"
+
+namespace ui {
+
+class LatencyHistogramSnapshot;
+
+// Counts latencies in log-linear buckets, in the manner of HdrHistogram:
+// each power of two microseconds is split into kSubBucketCount linear
+// buckets, so a bucket is within 1 / kSubBucketCount of any latency in it.
+// Latencies of 2^kMaxMagnitude us (about 33 s) or more share the last bucket.
+//
+// Only the thread that owns the histogram records into it, with a single
+// relaxed atomic increment and no lock or allocation; the counts may be
+// taken from any thread.
+class LatencyHistogram {
+ public:
+  static const int kSubBucketBits = 3;
+  static const int kSubBucketCount = 1 << kSubBucketBits;
+  static const int kMaxMagnitude = 25;
+  static const size_t kBucketCount =
+      kSubBucketCount * (kMaxMagnitude - kSubBucketBits + 1);
+
+  LatencyHistogram();
+  ~LatencyHistogram();
+
+  static size_t BucketForLatency(base::TimeDelta latency);
+  // The latencies bucket |bucket| holds, from |BucketMin| up to but not
+  // including |BucketMax|.
+  static base::TimeDelta BucketMin(size_t bucket);
+  static base::TimeDelta BucketMax(size_t bucket);
+
+  void Record(base::TimeDelta latency, int count);
+
+  // Moves the counts recorded since the last call into |snapshot|, adding
+  // them to what it holds. Each bucket is swapped for zero atomically, so a
+  // concurrent Record() lands either in this snapshot or the next.
+  void TakeInto(LatencyHistogramSnapshot* snapshot);
+
+ private:
+  base::subtle::Atomic32 counts_[kBucketCount];
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+// Counts taken from one or more LatencyHistograms, for reading percentiles.
+class LatencyHistogramSnapshot {
+ public:
+  LatencyHistogramSnapshot();
+  ~LatencyHistogramSnapshot();
+
+  // The latency under which |percentile| percent of the samples fall, as the
+  // midpoint of its bucket. Zero when there are no samples.
+  base::TimeDelta Percentile(double percentile) const;
+
+  void Clear();
+
+  uint64_t count() const { return count_; }
+
+ private:
+  friend class LatencyHistogram;
+
+  uint64_t counts_[LatencyHistogram::kBucketCount];
+  uint64_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogramSnapshot);
+};
+
+// The gestures latency is tracked for, as in Event.Latency.RendererImpl.*.
+enum GestureLatencyType {
+  GESTURE_LATENCY_SCROLL_BEGIN,
+  GESTURE_LATENCY_SCROLL_UPDATE,
+  GESTURE_LATENCY_PINCH_BEGIN,
+  GESTURE_LATENCY_PINCH_UPDATE,
+  GESTURE_LATENCY_FLING_START,
+  GESTURE_LATENCY_TYPE_COUNT
+};
+
+// Returns false for events whose latency is not tracked.
+bool GetGestureLatencyType(blink::WebInputEvent::Type type,
+                           GestureLatencyType* gesture_type);
+
+// A LatencyHistogram per gesture type, merged at most every kMergeInterval
+// into running snapshots whose p50, p95 and p99 are traced as |trace_name|.
+// Merging is left to gesture ends so that no timer is needed and the
+// per-event cost stays a single increment.
+class GestureLatencyHistograms {
+ public:
+  static const int kMergeIntervalSeconds = 10;
+
+  // |trace_name| must outlive the histograms.
+  explicit GestureLatencyHistograms(const char* trace_name);
+  ~GestureLatencyHistograms();
+
+  // Events that are not tracked are ignored.
+  void Record(blink::WebInputEvent::Type type,
+              base::TimeDelta latency,
+              int count);
+
+  // Merges and traces the percentiles if kMergeInterval has passed since the
+  // last merge. Returns whether it did.
+  bool MaybeMerge(base::TimeTicks now);
+
+  const LatencyHistogramSnapshot& snapshot(GestureLatencyType type) const {
+    return snapshots_[type];
+  }
+
+ private:
+  const char* const trace_name_;
+  LatencyHistogram histograms_[GESTURE_LATENCY_TYPE_COUNT];
+  LatencyHistogramSnapshot snapshots_[GESTURE_LATENCY_TYPE_COUNT];
+  base::TimeTicks last_merge_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(GestureLatencyHistograms);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,94 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/latency_histogram.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+base::TimeDelta Us(int64_t us) {
+  return base::TimeDelta::FromMicroseconds(us);
+}
+
+TEST(LatencyHistogramTest, BucketsCoverTheRangeInOrder) {
+  EXPECT_EQ(0u, LatencyHistogram::BucketForLatency(Us(-5)));
+  EXPECT_EQ(7u, LatencyHistogram::BucketForLatency(Us(7)));
+  EXPECT_EQ(8u, LatencyHistogram::BucketForLatency(Us(8)));
+  EXPECT_EQ(LatencyHistogram::kBucketCount - 1,
+            LatencyHistogram::BucketForLatency(base::TimeDelta::Max()));
+
+  for (size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+    base::TimeDelta min = LatencyHistogram::BucketMin(i);
+    base::TimeDelta max = LatencyHistogram::BucketMax(i);
+    EXPECT_EQ(i, LatencyHistogram::BucketForLatency(min));
+    EXPECT_EQ(i, LatencyHistogram::BucketForLatency(max - Us(1)));
+    if (i + 1 < LatencyHistogram::kBucketCount)
+      EXPECT_EQ(max, LatencyHistogram::BucketMin(i + 1));
+    // No bucket is wider than an eighth of its lower bound.
+    if (i >= static_cast<size_t>(LatencyHistogram::kSubBucketCount))
+      EXPECT_LE((max - min) * LatencyHistogram::kSubBucketCount, min);
+  }
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram histogram;
+  LatencyHistogramSnapshot snapshot;
+  EXPECT_EQ(base::TimeDelta(), snapshot.Percentile(50));
+
+  histogram.Record(base::TimeDelta::FromMilliseconds(10), 90);
+  histogram.Record(base::TimeDelta::FromMilliseconds(40), 9);
+  histogram.Record(base::TimeDelta::FromMilliseconds(200), 1);
+  histogram.TakeInto(&snapshot);
+  EXPECT_EQ(100u, snapshot.count());
+
+  EXPECT_NEAR(10, snapshot.Percentile(50).InMillisecondsF(), 10 / 8.0);
+  EXPECT_NEAR(40, snapshot.Percentile(95).InMillisecondsF(), 40 / 8.0);
+  EXPECT_NEAR(40, snapshot.Percentile(99).InMillisecondsF(), 40 / 8.0);
+  EXPECT_NEAR(200, snapshot.Percentile(100).InMillisecondsF(), 200 / 8.0);
+}
+
+TEST(LatencyHistogramTest, TakeIntoMovesAndMerges) {
+  LatencyHistogram first;
+  LatencyHistogram second;
+  LatencyHistogramSnapshot snapshot;
+  first.Record(Us(100), 3);
+  second.Record(Us(5000), 1);
+  first.TakeInto(&snapshot);
+  second.TakeInto(&snapshot);
+  EXPECT_EQ(4u, snapshot.count());
+
+  // The counts were moved, not copied.
+  first.TakeInto(&snapshot);
+  EXPECT_EQ(4u, snapshot.count());
+
+  snapshot.Clear();
+  EXPECT_EQ(0u, snapshot.count());
+}
+
+TEST(GestureLatencyHistogramsTest, MergesAtMostEveryInterval) {
+  GestureLatencyHistograms histograms("GestureLatency");
+  base::TimeTicks now = base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+  histograms.Record(blink::WebInputEvent::GestureScrollUpdate, Us(8000), 2);
+  histograms.Record(blink::WebInputEvent::GesturePinchBegin, Us(3000), 1);
+  // Not tracked.
+  histograms.Record(blink::WebInputEvent::GestureTap, Us(3000), 1);
+  EXPECT_TRUE(histograms.MaybeMerge(now));
+  EXPECT_EQ(2u, histograms.snapshot(GESTURE_LATENCY_SCROLL_UPDATE).count());
+  EXPECT_EQ(1u, histograms.snapshot(GESTURE_LATENCY_PINCH_BEGIN).count());
+  EXPECT_EQ(0u, histograms.snapshot(GESTURE_LATENCY_SCROLL_BEGIN).count());
+
+  histograms.Record(blink::WebInputEvent::GestureScrollUpdate, Us(8000), 1);
+  EXPECT_FALSE(histograms.MaybeMerge(now + base::TimeDelta::FromSeconds(1)));
+  EXPECT_EQ(2u, histograms.snapshot(GESTURE_LATENCY_SCROLL_UPDATE).count());
+
+  const base::TimeDelta interval = base::TimeDelta::FromSeconds(
+      GestureLatencyHistograms::kMergeIntervalSeconds);
+  EXPECT_TRUE(histograms.MaybeMerge(now + interval));
+  EXPECT_EQ(3u, histograms.snapshot(GESTURE_LATENCY_SCROLL_UPDATE).count());
+}
+
+}  // namespace
+}  // namespace ui
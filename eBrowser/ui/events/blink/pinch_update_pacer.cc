@@ -0,0 +1,60 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/pinch_update_pacer.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+
+namespace ui {
+
+PinchUpdatePacer::PinchUpdatePacer()
+    : target_frame_rate_(ScrollUpdatePacer::kMaxFrameRate),
+      has_pending_update_(false),
+      pending_scale_(1) {}
+
+PinchUpdatePacer::~PinchUpdatePacer() {}
+
+void PinchUpdatePacer::SetTargetFrameRate(int fps) {
+  target_frame_rate_ =
+      std::max(1, std::min(fps, ScrollUpdatePacer::kMaxFrameRate));
+}
+
+bool PinchUpdatePacer::is_throttling() const {
+  return target_frame_rate_ < ScrollUpdatePacer::kMaxFrameRate;
+}
+
+void PinchUpdatePacer::QueuePinchUpdate(float scale,
+                                        const gfx::Point& anchor) {
+  pending_scale_ = has_pending_update_ ? pending_scale_ * scale : scale;
+  pending_anchor_ = anchor;
+  has_pending_update_ = true;
+}
+
+bool PinchUpdatePacer::ShouldDispatch(base::TimeTicks frame_time) const {
+  return has_pending_update_ &&
+         ScrollUpdatePacer::IsFrameDue(last_dispatch_time_, frame_time,
+                                       target_frame_rate_);
+}
+
+void PinchUpdatePacer::TakePendingUpdate(base::TimeTicks frame_time,
+                                         float* scale,
+                                         gfx::Point* anchor) {
+  DCHECK(has_pending_update_);
+  *scale = pending_scale_;
+  *anchor = pending_anchor_;
+  has_pending_update_ = false;
+  pending_scale_ = 1;
+  last_dispatch_time_ = frame_time;
+}
+
+void PinchUpdatePacer::Reset() {
+  has_pending_update_ = false;
+  pending_scale_ = 1;
+  last_dispatch_time_ = base::TimeTicks();
+}
+
+}  // namespace ui
@@ -0,0 +1,59 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_PINCH_UPDATE_PACER_H_
+#define UI_EVENTS_BLINK_PINCH_UPDATE_PACER_H_
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "ui/gfx/geometry/point.h"
+
+namespace ui {
+
+// The GesturePinchUpdate counterpart of ScrollUpdatePacer. Pinch updates that
+// arrive between releases are merged by multiplying their scales, and the
+// merged update is released on the first BeginFrame that is at least one
+// target interval after the previous release.
+class PinchUpdatePacer {
+ public:
+  PinchUpdatePacer();
+  ~PinchUpdatePacer();
+
+  // Sets the desired pinch update rate, clamped to
+  // [1, ScrollUpdatePacer::kMaxFrameRate].
+  void SetTargetFrameRate(int fps);
+  int target_frame_rate() const { return target_frame_rate_; }
+  bool is_throttling() const;
+
+  // Merges a pinch update of |scale| around |anchor| into the pending update.
+  // The newest anchor wins.
+  void QueuePinchUpdate(float scale, const gfx::Point& anchor);
+  bool has_pending_update() const { return has_pending_update_; }
+
+  // Whether the pending update should be released for a frame at
+  // |frame_time|.
+  bool ShouldDispatch(base::TimeTicks frame_time) const;
+
+  // Returns the pending update in |scale| and |anchor| and clears it.
+  // |frame_time| is recorded as the release time.
+  void TakePendingUpdate(base::TimeTicks frame_time,
+                         float* scale,
+                         gfx::Point* anchor);
+
+  // Drops any pending update and forgets the last release time.
+  void Reset();
+
+ private:
+  int target_frame_rate_;
+  bool has_pending_update_;
+  float pending_scale_;
+  gfx::Point pending_anchor_;
+  base::TimeTicks last_dispatch_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(PinchUpdatePacer);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_PINCH_UPDATE_PACER_H_
@@ -0,0 +1,64 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/pinch_update_pacer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+// Starts one frame in, since a null TimeTicks means "never dispatched".
+base::TimeTicks FrameTime(int frame) {
+  return base::TimeTicks() +
+         base::TimeDelta::FromMicroseconds(16667 * (frame + 1));
+}
+
+TEST(PinchUpdatePacerTest, MultipliesScales) {
+  PinchUpdatePacer pacer;
+  pacer.SetTargetFrameRate(30);
+  EXPECT_TRUE(pacer.is_throttling());
+  pacer.QueuePinchUpdate(1.1f, gfx::Point(1, 2));
+  pacer.QueuePinchUpdate(2, gfx::Point(3, 4));
+  ASSERT_TRUE(pacer.has_pending_update());
+
+  float scale = 0;
+  gfx::Point anchor;
+  pacer.TakePendingUpdate(FrameTime(0), &scale, &anchor);
+  EXPECT_FLOAT_EQ(2.2f, scale);
+  EXPECT_EQ(gfx::Point(3, 4), anchor);
+  EXPECT_FALSE(pacer.has_pending_update());
+}
+
+TEST(PinchUpdatePacerTest, ReleasesOncePerTargetInterval) {
+  PinchUpdatePacer pacer;
+  pacer.SetTargetFrameRate(15);
+  int releases = 0;
+  for (int frame = 0; frame < 60; ++frame) {
+    pacer.QueuePinchUpdate(1.01f, gfx::Point());
+    if (pacer.ShouldDispatch(FrameTime(frame))) {
+      float scale;
+      gfx::Point anchor;
+      pacer.TakePendingUpdate(FrameTime(frame), &scale, &anchor);
+      ++releases;
+    }
+  }
+  EXPECT_EQ(15, releases);
+}
+
+TEST(PinchUpdatePacerTest, ResetDropsPendingUpdate) {
+  PinchUpdatePacer pacer;
+  pacer.SetTargetFrameRate(10);
+  pacer.QueuePinchUpdate(2, gfx::Point());
+  pacer.Reset();
+  EXPECT_FALSE(pacer.has_pending_update());
+  pacer.QueuePinchUpdate(3, gfx::Point());
+  float scale = 0;
+  gfx::Point anchor;
+  pacer.TakePendingUpdate(FrameTime(0), &scale, &anchor);
+  EXPECT_EQ(3, scale);
+}
+
+}  // namespace
+}  // namespace ui
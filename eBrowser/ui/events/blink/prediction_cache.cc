@@ -0,0 +1,98 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/prediction_cache.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+
+namespace ui {
+
+namespace {
+
+const int kFloatMantissaBits = 23;
+const uint32_t kDroppedBitsMask =
+    (1u << (kFloatMantissaBits - PredictionCache::kMantissaBits)) - 1;
+
+}  // namespace
+
+const int PredictionCache::kMaxFeatures;
+const int PredictionCache::kNumEntries;
+const int PredictionCache::kMantissaBits;
+
+PredictionCache::PredictionCache() : hits_(0), misses_(0) {
+  Clear();
+}
+
+PredictionCache::~PredictionCache() {}
+
+// static
+void PredictionCache::Quantize(const float* features,
+                               int num_features,
+                               float* quantized) {
+  DCHECK_LE(num_features, kMaxFeatures);
+  for (int i = 0; i < num_features; ++i) {
+    uint32_t bits;
+    memcpy(&bits, &features[i], sizeof(bits));
+    // Round to nearest. A carry out of the mantissa bumps the exponent, which
+    // is still the correctly rounded value.
+    bits += (kDroppedBitsMask + 1) >> 1;
+    bits &= ~kDroppedBitsMask;
+    memcpy(&quantized[i], &bits, sizeof(bits));
+  }
+}
+
+bool PredictionCache::Lookup(const float* quantized,
+                             int num_features,
+                             double* value) {
+  uint32_t key[kMaxFeatures];
+  MakeKey(quantized, num_features, key);
+  const Entry& entry = entries_[SlotForKey(key)];
+  if (entry.valid && !memcmp(entry.key, key, sizeof(key))) {
+    ++hits_;
+    *value = entry.value;
+    return true;
+  }
+  ++misses_;
+  return false;
+}
+
+void PredictionCache::Insert(const float* quantized,
+                             int num_features,
+                             double value) {
+  uint32_t key[kMaxFeatures];
+  MakeKey(quantized, num_features, key);
+  Entry& entry = entries_[SlotForKey(key)];
+  entry.valid = true;
+  memcpy(entry.key, key, sizeof(key));
+  entry.value = value;
+}
+
+void PredictionCache::Clear() {
+  for (Entry& entry : entries_)
+    entry.valid = false;
+}
+
+// static
+void PredictionCache::MakeKey(const float* quantized,
+                              int num_features,
+                              uint32_t* key) {
+  DCHECK_LE(num_features, kMaxFeatures);
+  memset(key, 0, kMaxFeatures * sizeof(*key));
+  memcpy(key, quantized, num_features * sizeof(*quantized));
+}
+
+// static
+int PredictionCache::SlotForKey(const uint32_t* key) {
+  // FNV-1a over the key words.
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < kMaxFeatures; ++i) {
+    hash ^= key[i];
+    hash *= 16777619u;
+  }
+  return (hash ^ (hash >> 16)) & (kNumEntries - 1);
+}
+
+}  // namespace ui
@@ -0,0 +1,71 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_PREDICTION_CACHE_H_
+#define UI_EVENTS_BLINK_PREDICTION_CACHE_H_
+
+#include <stdint.h>
+
+#include "base/macros.h"
+
+namespace ui {
+
+// A small direct-mapped cache of model outputs keyed by a quantized feature
+// vector. Gestures tend to hold a similar speed for long stretches, so
+// consecutive predictions mostly fall into the same bucket. Unlike
+// FrameRateTable this works for models with any number of features, at the
+// cost of one exact evaluation per distinct bucket.
+//
+// Each feature is rounded to kMantissaBits bits of mantissa, which bounds the
+// relative quantization error independently of the feature's units. A cache
+// belongs to one model; a new model comes with an empty cache.
+class PredictionCache {
+ public:
+  static const int kMaxFeatures = 4;
+  static const int kNumEntries = 64;
+  static const int kMantissaBits = 7;
+
+  PredictionCache();
+  ~PredictionCache();
+
+  // Writes the first |num_features| values of |features|, rounded to their
+  // bucket's representative, into |quantized|.
+  static void Quantize(const float* features,
+                       int num_features,
+                       float* quantized);
+
+  // Looks up |quantized|, as produced by Quantize(). Returns true and sets
+  // |value| on a hit. Updates the hit and miss counters.
+  bool Lookup(const float* quantized, int num_features, double* value);
+
+  // Stores |value| for |quantized|, evicting whatever shared its slot.
+  void Insert(const float* quantized, int num_features, double value);
+
+  void Clear();
+
+  int64_t hits() const { return hits_; }
+  int64_t misses() const { return misses_; }
+
+ private:
+  struct Entry {
+    bool valid;
+    uint32_t key[kMaxFeatures];
+    double value;
+  };
+
+  static void MakeKey(const float* quantized,
+                      int num_features,
+                      uint32_t* key);
+  static int SlotForKey(const uint32_t* key);
+
+  Entry entries_[kNumEntries];
+  int64_t hits_;
+  int64_t misses_;
+
+  DISALLOW_COPY_AND_ASSIGN(PredictionCache);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_PREDICTION_CACHE_H_
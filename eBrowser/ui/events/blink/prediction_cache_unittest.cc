@@ -0,0 +1,63 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/prediction_cache.h"
+
+#include <cmath>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+TEST(PredictionCacheTest, QuantizeBoundsRelativeError) {
+  const double max_error = 1.0 / (1 << (PredictionCache::kMantissaBits + 1));
+  for (float x : {0.01f, 0.7f, 1.0f, 3.3f, 129.5f, 1234.5f, -42.f}) {
+    float q;
+    PredictionCache::Quantize(&x, 1, &q);
+    EXPECT_LE(std::abs(q - x), std::abs(x) * max_error) << x;
+  }
+  float zero = 0, q = 1;
+  PredictionCache::Quantize(&zero, 1, &q);
+  EXPECT_EQ(0, q);
+}
+
+TEST(PredictionCacheTest, NearbyFeaturesShareABucket) {
+  float a[] = {1000.f, 2.f};
+  float b[] = {1001.f, 2.f};
+  float qa[2], qb[2];
+  PredictionCache::Quantize(a, 2, qa);
+  PredictionCache::Quantize(b, 2, qb);
+  EXPECT_EQ(qa[0], qb[0]);
+  EXPECT_EQ(qa[1], qb[1]);
+}
+
+TEST(PredictionCacheTest, CountsHitsAndMisses) {
+  PredictionCache cache;
+  float features[] = {12.f, 3.f};
+  double value = 0;
+  EXPECT_FALSE(cache.Lookup(features, 2, &value));
+  cache.Insert(features, 2, 42);
+  ASSERT_TRUE(cache.Lookup(features, 2, &value));
+  EXPECT_EQ(42, value);
+  EXPECT_EQ(1, cache.hits());
+  EXPECT_EQ(1, cache.misses());
+
+  // A different second feature is a different key.
+  float other[] = {12.f, 4.f};
+  EXPECT_FALSE(cache.Lookup(other, 2, &value));
+  EXPECT_EQ(2, cache.misses());
+}
+
+TEST(PredictionCacheTest, ClearDropsEntries) {
+  PredictionCache cache;
+  float feature = 5;
+  cache.Insert(&feature, 1, 30);
+  cache.Clear();
+  double value;
+  EXPECT_FALSE(cache.Lookup(&feature, 1, &value));
+}
+
+}  // namespace
+}  // namespace ui
@@ -0,0 +1,122 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/scroll_update_pacer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/logging.h"
+
+using blink::WebGestureEvent;
+using blink::WebInputEvent;
+
+namespace ui {
+
+namespace {
+
+// BeginFrame timestamps jitter around the vsync grid, so a release is allowed
+// slightly before a full target interval has passed. Without this a 30fps
+// target on a 60Hz display would frequently slip to 20fps.
+const double kFrameIntervalSlackSeconds = 1. / 240.;
+
+// The index of the 1 / |fps| slot of the grid through |origin| that
+// |frame_time| falls in.
+double CadenceSlot(base::TimeTicks frame_time,
+                   base::TimeTicks origin,
+                   int fps) {
+  return std::floor(((frame_time - origin).InSecondsF() +
+                     kFrameIntervalSlackSeconds) *
+                    std::max(fps, 1));
+}
+
+}  // namespace
+
+// static
+const int ScrollUpdatePacer::kMaxFrameRate;
+
+ScrollUpdatePacer::ScrollUpdatePacer()
+    : target_frame_rate_(kMaxFrameRate), has_pending_update_(false) {}
+
+ScrollUpdatePacer::~ScrollUpdatePacer() {}
+
+// static
+bool ScrollUpdatePacer::IsFrameDue(base::TimeTicks last_frame_time,
+                                   base::TimeTicks frame_time,
+                                   int fps) {
+  if (fps >= kMaxFrameRate || last_frame_time.is_null())
+    return true;
+  base::TimeDelta interval = base::TimeDelta::FromSecondsD(
+      1. / std::max(fps, 1) - kFrameIntervalSlackSeconds);
+  return frame_time - last_frame_time >= interval;
+}
+
+// static
+bool ScrollUpdatePacer::IsFrameDueOnCadence(base::TimeTicks last_frame_time,
+                                            base::TimeTicks frame_time,
+                                            base::TimeTicks cadence_origin,
+                                            int fps) {
+  if (fps >= kMaxFrameRate || last_frame_time.is_null())
+    return true;
+  return CadenceSlot(frame_time, cadence_origin, fps) >
+         CadenceSlot(last_frame_time, cadence_origin, fps);
+}
+
+void ScrollUpdatePacer::SetTargetFrameRate(int fps) {
+  target_frame_rate_ = std::max(1, std::min(fps, kMaxFrameRate));
+}
+
+bool ScrollUpdatePacer::CanQueue(const WebGestureEvent& event) const {
+  DCHECK_EQ(WebInputEvent::GestureScrollUpdate, event.type);
+  if (!has_pending_update_)
+    return true;
+  return event.sourceDevice == pending_update_.sourceDevice &&
+         event.modifiers == pending_update_.modifiers &&
+         event.data.scrollUpdate.deltaUnits ==
+             pending_update_.data.scrollUpdate.deltaUnits &&
+         event.data.scrollUpdate.inertialPhase ==
+             pending_update_.data.scrollUpdate.inertialPhase;
+}
+
+void ScrollUpdatePacer::QueueScrollUpdate(const WebGestureEvent& event) {
+  DCHECK(CanQueue(event));
+  if (!has_pending_update_) {
+    pending_update_ = event;
+    has_pending_update_ = true;
+    oldest_pending_event_time_ =
+        base::TimeTicks() +
+        base::TimeDelta::FromSecondsD(event.timeStampSeconds);
+    return;
+  }
+  // Keep the newest position, timestamp and velocity, and accumulate deltas
+  // so that no scroll distance is lost by coalescing.
+  float delta_x = pending_update_.data.scrollUpdate.deltaX +
+                  event.data.scrollUpdate.deltaX;
+  float delta_y = pending_update_.data.scrollUpdate.deltaY +
+                  event.data.scrollUpdate.deltaY;
+  pending_update_ = event;
+  pending_update_.data.scrollUpdate.deltaX = delta_x;
+  pending_update_.data.scrollUpdate.deltaY = delta_y;
+}
+
+bool ScrollUpdatePacer::ShouldDispatch(base::TimeTicks frame_time) const {
+  if (!has_pending_update_)
+    return false;
+  return IsFrameDue(last_dispatch_time_, frame_time, target_frame_rate_);
+}
+
+WebGestureEvent ScrollUpdatePacer::TakePendingUpdate(
+    base::TimeTicks frame_time) {
+  DCHECK(has_pending_update_);
+  has_pending_update_ = false;
+  last_dispatch_time_ = frame_time;
+  return pending_update_;
+}
+
+void ScrollUpdatePacer::Reset() {
+  has_pending_update_ = false;
+  last_dispatch_time_ = base::TimeTicks();
+}
+
+}  // namespace ui
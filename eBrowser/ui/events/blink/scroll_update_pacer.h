@@ -0,0 +1,84 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_SCROLL_UPDATE_PACER_H_
+#define UI_EVENTS_BLINK_SCROLL_UPDATE_PACER_H_
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "third_party/WebKit/public/platform/WebInputEvent.h"
+
+namespace ui {
+
+// Paces GestureScrollUpdates to a target frame rate below the display rate.
+// Instead of blocking the compositor thread, updates are coalesced into a
+// single pending update whose deltas are the sum of all queued deltas, and
+// that update is released on the first BeginFrame that is at least one target
+// interval after the previous release. Between releases the thread stays idle.
+class ScrollUpdatePacer {
+ public:
+  // Frame rate at and above which pacing is disabled.
+  static const int kMaxFrameRate = 60;
+
+  ScrollUpdatePacer();
+  ~ScrollUpdatePacer();
+
+  // Whether a frame at |frame_time| is at least one interval of |fps| after
+  // |last_frame_time|, allowing for BeginFrame jitter.
+  static bool IsFrameDue(base::TimeTicks last_frame_time,
+                         base::TimeTicks frame_time,
+                         int fps);
+  // Like IsFrameDue(), but the frames fall on a 1 / |fps| grid through
+  // |cadence_origin| rather than an interval after each other. With the
+  // origin at a video frame's display time, frames at a multiple of the
+  // video's rate are the video's own; 24fps on a 60Hz display comes out as
+  // the video's 3:2 pattern instead of 20fps.
+  static bool IsFrameDueOnCadence(base::TimeTicks last_frame_time,
+                                  base::TimeTicks frame_time,
+                                  base::TimeTicks cadence_origin,
+                                  int fps);
+
+  // Sets the desired scroll update rate, clamped to [1, kMaxFrameRate].
+  void SetTargetFrameRate(int fps);
+  int target_frame_rate() const { return target_frame_rate_; }
+  bool is_throttling() const { return target_frame_rate_ < kMaxFrameRate; }
+
+  // Whether |event| can be merged into the pending update. Updates with a
+  // different device, modifiers, units or phase must not be summed; the
+  // pending update has to be released first.
+  bool CanQueue(const blink::WebGestureEvent& event) const;
+
+  // Merges |event|, a GestureScrollUpdate, into the pending update.
+  void QueueScrollUpdate(const blink::WebGestureEvent& event);
+  bool has_pending_update() const { return has_pending_update_; }
+  // Timestamp of the oldest event merged into the pending update.
+  base::TimeTicks oldest_pending_event_time() const {
+    return oldest_pending_event_time_;
+  }
+
+  // Whether the pending update should be released for a frame at
+  // |frame_time|.
+  bool ShouldDispatch(base::TimeTicks frame_time) const;
+
+  // Returns the pending update and clears it. |frame_time| is recorded as the
+  // release time that the next interval is measured from.
+  blink::WebGestureEvent TakePendingUpdate(base::TimeTicks frame_time);
+
+  // Drops any pending update and forgets the last release time. Called when a
+  // scroll sequence ends.
+  void Reset();
+
+ private:
+  int target_frame_rate_;
+  bool has_pending_update_;
+  blink::WebGestureEvent pending_update_;
+  base::TimeTicks oldest_pending_event_time_;
+  base::TimeTicks last_dispatch_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScrollUpdatePacer);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_SCROLL_UPDATE_PACER_H_
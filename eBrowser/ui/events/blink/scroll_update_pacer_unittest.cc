@@ -0,0 +1,140 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/scroll_update_pacer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using blink::WebGestureEvent;
+using blink::WebInputEvent;
+
+namespace ui {
+namespace {
+
+WebGestureEvent CreateScrollUpdate(float delta_y) {
+  WebGestureEvent event;
+  event.type = WebInputEvent::GestureScrollUpdate;
+  event.sourceDevice = blink::WebGestureDeviceTouchscreen;
+  event.data.scrollUpdate.deltaY = delta_y;
+  return event;
+}
+
+base::TimeTicks FrameTime(int frame) {
+  return base::TimeTicks() + base::TimeDelta::FromMicroseconds(16667 * frame);
+}
+
+TEST(ScrollUpdatePacerTest, NotThrottlingAtDisplayRate) {
+  ScrollUpdatePacer pacer;
+  EXPECT_FALSE(pacer.is_throttling());
+  pacer.SetTargetFrameRate(120);
+  EXPECT_EQ(ScrollUpdatePacer::kMaxFrameRate, pacer.target_frame_rate());
+  EXPECT_FALSE(pacer.is_throttling());
+  pacer.SetTargetFrameRate(0);
+  EXPECT_EQ(1, pacer.target_frame_rate());
+}
+
+TEST(ScrollUpdatePacerTest, CoalescesDeltas) {
+  ScrollUpdatePacer pacer;
+  pacer.SetTargetFrameRate(30);
+  EXPECT_FALSE(pacer.has_pending_update());
+  pacer.QueueScrollUpdate(CreateScrollUpdate(3));
+  pacer.QueueScrollUpdate(CreateScrollUpdate(4));
+  ASSERT_TRUE(pacer.has_pending_update());
+  WebGestureEvent update = pacer.TakePendingUpdate(FrameTime(0));
+  EXPECT_EQ(7, update.data.scrollUpdate.deltaY);
+  EXPECT_FALSE(pacer.has_pending_update());
+}
+
+TEST(ScrollUpdatePacerTest, TracksOldestPendingEvent) {
+  ScrollUpdatePacer pacer;
+  pacer.SetTargetFrameRate(30);
+  WebGestureEvent first = CreateScrollUpdate(1);
+  first.timeStampSeconds = 1;
+  WebGestureEvent second = CreateScrollUpdate(1);
+  second.timeStampSeconds = 1.01;
+  pacer.QueueScrollUpdate(first);
+  pacer.QueueScrollUpdate(second);
+  EXPECT_EQ(base::TimeTicks() + base::TimeDelta::FromSeconds(1),
+            pacer.oldest_pending_event_time());
+  EXPECT_EQ(1.01, pacer.TakePendingUpdate(FrameTime(0)).timeStampSeconds);
+}
+
+TEST(ScrollUpdatePacerTest, ReleasesOncePerTargetInterval) {
+  ScrollUpdatePacer pacer;
+  pacer.SetTargetFrameRate(20);
+  int releases = 0;
+  for (int frame = 0; frame < 60; ++frame) {
+    pacer.QueueScrollUpdate(CreateScrollUpdate(1));
+    if (pacer.ShouldDispatch(FrameTime(frame))) {
+      pacer.TakePendingUpdate(FrameTime(frame));
+      ++releases;
+    }
+  }
+  // One second of 60Hz frames at a 20fps target.
+  EXPECT_EQ(20, releases);
+}
+
+TEST(ScrollUpdatePacerTest, IsFrameDue) {
+  EXPECT_TRUE(ScrollUpdatePacer::IsFrameDue(base::TimeTicks(), FrameTime(1),
+                                            10));
+  EXPECT_TRUE(ScrollUpdatePacer::IsFrameDue(FrameTime(1), FrameTime(2), 60));
+  EXPECT_FALSE(ScrollUpdatePacer::IsFrameDue(FrameTime(1), FrameTime(2), 30));
+  EXPECT_TRUE(ScrollUpdatePacer::IsFrameDue(FrameTime(1), FrameTime(3), 30));
+  EXPECT_FALSE(ScrollUpdatePacer::IsFrameDue(FrameTime(1), FrameTime(3), 20));
+}
+
+TEST(ScrollUpdatePacerTest, IsFrameDueOnCadence) {
+  // One second of 60Hz frames paced to a 24fps video shown from frame 1.
+  int due_frames = 0;
+  int last_frame = 0;
+  for (int frame = 1; frame <= 60; ++frame) {
+    base::TimeTicks last_frame_time =
+        last_frame ? FrameTime(last_frame) : base::TimeTicks();
+    if (!ScrollUpdatePacer::IsFrameDueOnCadence(last_frame_time,
+                                                FrameTime(frame), FrameTime(1),
+                                                24)) {
+      continue;
+    }
+    // The video's 3:2 pattern.
+    if (last_frame)
+      EXPECT_TRUE(frame - last_frame == 2 || frame - last_frame == 3) << frame;
+    last_frame = frame;
+    ++due_frames;
+  }
+  EXPECT_EQ(24, due_frames);
+
+  // The grid, not the last frame, decides: a late frame does not push the
+  // next one back.
+  EXPECT_TRUE(ScrollUpdatePacer::IsFrameDueOnCadence(
+      FrameTime(3), FrameTime(4), FrameTime(0), 30));
+  EXPECT_FALSE(ScrollUpdatePacer::IsFrameDueOnCadence(
+      FrameTime(4), FrameTime(5), FrameTime(0), 30));
+  EXPECT_TRUE(ScrollUpdatePacer::IsFrameDueOnCadence(
+      base::TimeTicks(), FrameTime(5), FrameTime(0), 30));
+}
+
+TEST(ScrollUpdatePacerTest, CannotQueueAcrossPhases) {
+  ScrollUpdatePacer pacer;
+  WebGestureEvent momentum = CreateScrollUpdate(1);
+  momentum.data.scrollUpdate.inertialPhase = WebGestureEvent::MomentumPhase;
+  EXPECT_TRUE(pacer.CanQueue(momentum));
+  pacer.QueueScrollUpdate(CreateScrollUpdate(1));
+  EXPECT_FALSE(pacer.CanQueue(momentum));
+}
+
+TEST(ScrollUpdatePacerTest, ResetDropsPendingUpdate) {
+  ScrollUpdatePacer pacer;
+  pacer.SetTargetFrameRate(10);
+  pacer.QueueScrollUpdate(CreateScrollUpdate(1));
+  pacer.TakePendingUpdate(FrameTime(0));
+  pacer.QueueScrollUpdate(CreateScrollUpdate(1));
+  EXPECT_FALSE(pacer.ShouldDispatch(FrameTime(1)));
+  pacer.Reset();
+  EXPECT_FALSE(pacer.has_pending_update());
+  pacer.QueueScrollUpdate(CreateScrollUpdate(1));
+  EXPECT_TRUE(pacer.ShouldDispatch(FrameTime(1)));
+}
+
+}  // namespace
+}  // namespace ui
@@ -0,0 +1,74 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/scroll_velocity_estimator.h"
+
+#include "base/logging.h"
+
+namespace ui {
+
+const size_t ScrollVelocityEstimator::kHistorySize;
+const double ScrollVelocityEstimator::kHorizonSeconds = 0.1;
+const double ScrollVelocityEstimator::kAssumeStoppedSeconds = 0.04;
+
+ScrollVelocityEstimator::ScrollVelocityEstimator() : newest_(0), count_(0) {}
+
+ScrollVelocityEstimator::~ScrollVelocityEstimator() {}
+
+void ScrollVelocityEstimator::AddDelta(double time_seconds, float delta) {
+  double offset = 0;
+  if (count_) {
+    const Sample& newest = samples_[newest_];
+    DCHECK_GE(time_seconds, newest.time_seconds);
+    if (time_seconds - newest.time_seconds > kAssumeStoppedSeconds) {
+      // Keep the newest sample as the origin of the new motion.
+      samples_[0] = newest;
+      newest_ = 0;
+      count_ = 1;
+    }
+    offset = samples_[newest_].offset + delta;
+    newest_ = (newest_ + 1) % kHistorySize;
+  }
+  samples_[newest_].time_seconds = time_seconds;
+  samples_[newest_].offset = offset;
+  if (count_ < kHistorySize)
+    ++count_;
+}
+
+void ScrollVelocityEstimator::Reset() {
+  newest_ = 0;
+  count_ = 0;
+}
+
+bool ScrollVelocityEstimator::GetVelocity(float* velocity) const {
+  DCHECK(velocity);
+  if (count_ < 2)
+    return false;
+
+  // Fit offset = a + b * t by least squares, with times taken relative to the
+  // newest sample to keep the sums well conditioned.
+  const Sample& newest = samples_[newest_];
+  double sum_t = 0, sum_x = 0, sum_tt = 0, sum_tx = 0;
+  size_t n = 0;
+  for (size_t i = 0; i < count_; ++i) {
+    const Sample& sample =
+        samples_[(newest_ + kHistorySize - i) % kHistorySize];
+    double t = sample.time_seconds - newest.time_seconds;
+    if (-t > kHorizonSeconds)
+      break;
+    double x = sample.offset - newest.offset;
+    sum_t += t;
+    sum_x += x;
+    sum_tt += t * t;
+    sum_tx += t * x;
+    ++n;
+  }
+  double denominator = n * sum_tt - sum_t * sum_t;
+  if (n < 2 || denominator <= 0)
+    return false;
+  *velocity = static_cast<float>((n * sum_tx - sum_t * sum_x) / denominator);
+  return true;
+}
+
+}  // namespace ui
@@ -0,0 +1,59 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_SCROLL_VELOCITY_ESTIMATOR_H_
+#define UI_EVENTS_BLINK_SCROLL_VELOCITY_ESTIMATOR_H_
+
+#include <stddef.h>
+
+#include "base/macros.h"
+
+namespace ui {
+
+// Estimates the velocity of a scroll gesture from the deltas of its
+// GestureScrollUpdates. Like the least-squares strategy of VelocityTracker,
+// it keeps the most recent samples in a fixed-size ring buffer and fits a
+// line to the accumulated offset over the last |kHorizonSeconds|. Fitting
+// several samples smooths out the jitter of single event intervals.
+class ScrollVelocityEstimator {
+ public:
+  static const size_t kHistorySize = 20;
+  // Samples older than this, relative to the newest one, are ignored.
+  static const double kHorizonSeconds;
+  // A gap this long between samples means the scroll stopped in between, so
+  // older samples no longer describe the current motion.
+  static const double kAssumeStoppedSeconds;
+
+  ScrollVelocityEstimator();
+  ~ScrollVelocityEstimator();
+
+  // Adds a scroll update of |delta| at |time_seconds|. Samples must arrive in
+  // non-decreasing time order.
+  void AddDelta(double time_seconds, float delta);
+
+  // Forgets all samples. Called at the start of each scroll gesture.
+  void Reset();
+
+  // Stores the estimated velocity, in units of delta per second, in
+  // |velocity|. Returns false if fewer than two usable samples are available.
+  bool GetVelocity(float* velocity) const;
+
+ private:
+  struct Sample {
+    double time_seconds;
+    // Offset accumulated since the first sample of the gesture.
+    double offset;
+  };
+
+  Sample samples_[kHistorySize];
+  // Index of the newest sample.
+  size_t newest_;
+  size_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScrollVelocityEstimator);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_SCROLL_VELOCITY_ESTIMATOR_H_
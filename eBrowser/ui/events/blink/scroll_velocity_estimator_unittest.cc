@@ -0,0 +1,72 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/scroll_velocity_estimator.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+const double kFrameSeconds = 1. / 60;
+
+TEST(ScrollVelocityEstimatorTest, NeedsTwoSamples) {
+  ScrollVelocityEstimator estimator;
+  float velocity = 0;
+  EXPECT_FALSE(estimator.GetVelocity(&velocity));
+  estimator.AddDelta(1, 10);
+  EXPECT_FALSE(estimator.GetVelocity(&velocity));
+  estimator.AddDelta(1 + kFrameSeconds, 10);
+  ASSERT_TRUE(estimator.GetVelocity(&velocity));
+  EXPECT_NEAR(600, velocity, 0.1);
+}
+
+TEST(ScrollVelocityEstimatorTest, ConstantVelocity) {
+  ScrollVelocityEstimator estimator;
+  // More samples than the ring buffer holds.
+  for (int i = 0; i < 50; ++i)
+    estimator.AddDelta(i * kFrameSeconds, -5);
+  float velocity = 0;
+  ASSERT_TRUE(estimator.GetVelocity(&velocity));
+  EXPECT_NEAR(-300, velocity, 0.1);
+}
+
+TEST(ScrollVelocityEstimatorTest, SmoothsJitteryTimestamps) {
+  ScrollVelocityEstimator estimator;
+  // The finger moves at a constant 1200 DIPs per second and is sampled every
+  // frame, but the timestamps alternate 3ms early and late. A single interval
+  // would be off by more than 30%.
+  for (int i = 0; i < 12; ++i) {
+    double jitter = i % 2 ? 0.003 : -0.003;
+    estimator.AddDelta(i * kFrameSeconds + jitter, 1200 * kFrameSeconds);
+  }
+  float velocity = 0;
+  ASSERT_TRUE(estimator.GetVelocity(&velocity));
+  EXPECT_NEAR(1200, velocity, 60);
+}
+
+TEST(ScrollVelocityEstimatorTest, IgnoresSamplesBeforePause) {
+  ScrollVelocityEstimator estimator;
+  for (int i = 0; i < 5; ++i)
+    estimator.AddDelta(i * kFrameSeconds, 20);
+  // Resume slowly after a pause.
+  double resume = 1;
+  for (int i = 0; i < 3; ++i)
+    estimator.AddDelta(resume + i * kFrameSeconds, 1);
+  float velocity = 0;
+  ASSERT_TRUE(estimator.GetVelocity(&velocity));
+  EXPECT_NEAR(60, velocity, 0.1);
+}
+
+TEST(ScrollVelocityEstimatorTest, ResetForgetsSamples) {
+  ScrollVelocityEstimator estimator;
+  estimator.AddDelta(0, 1);
+  estimator.AddDelta(kFrameSeconds, 1);
+  estimator.Reset();
+  float velocity = 0;
+  EXPECT_FALSE(estimator.GetVelocity(&velocity));
+}
+
+}  // namespace
+}  // namespace ui
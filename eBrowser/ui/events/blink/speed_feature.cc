@@ -0,0 +1,29 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/speed_feature.h"
+
+namespace ui {
+
+namespace {
+
+// The feature for a speed in the reference panel's physical pixels per
+// second. The trainer has always received speeds divided by 50, and the
+// factor of 2 calibrated the shipped model for the reference panel.
+const double kReferenceFeaturePerPixelPerSecond = 2. / 50.;
+
+}  // namespace
+
+const float SpeedFeature::kReferenceDpi = 320;
+const float SpeedFeature::kReferenceRefreshRate = 60;
+
+SpeedFeature::SpeedFeature() : SpeedFeature(0, 0) {}
+
+SpeedFeature::SpeedFeature(float physical_dpi, float refresh_rate)
+    : physical_dpi_(physical_dpi > 0 ? physical_dpi : kReferenceDpi),
+      refresh_rate_(refresh_rate > 0 ? refresh_rate : kReferenceRefreshRate),
+      scale_(kReferenceFeaturePerPixelPerSecond * kReferenceDpi /
+             physical_dpi_ * kReferenceRefreshRate / refresh_rate_) {}
+
+}  // namespace ui
@@ -0,0 +1,45 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_SPEED_FEATURE_H_
+#define UI_EVENTS_BLINK_SPEED_FEATURE_H_
+
+namespace ui {
+
+// Turns a scroll speed on this device into the speed feature the frame rate
+// models take, so that a model trained on one panel predicts the same rates on
+// another. The feature measures how far content moves across the glass in
+// each refresh of the display: a physical pixel spans less distance on a dense
+// panel, and a faster panel shows the same motion in smaller steps. It is
+// expressed in the units the models have always used on the reference panel
+// below, so that the models trained before normalization, and the default
+// frame rate table, keep their meaning there.
+class SpeedFeature {
+ public:
+  // The panel the first models were trained on, an xhdpi phone at 60Hz.
+  static const float kReferenceDpi;
+  static const float kReferenceRefreshRate;
+
+  // On the reference panel.
+  SpeedFeature();
+  // Non-positive values are not known, and taken from the reference panel.
+  SpeedFeature(float physical_dpi, float refresh_rate);
+
+  // |speed| is in physical pixels per second.
+  double FromPhysicalPixelsPerSecond(double speed) const {
+    return speed * scale_;
+  }
+
+  float physical_dpi() const { return physical_dpi_; }
+  float refresh_rate() const { return refresh_rate_; }
+
+ private:
+  float physical_dpi_;
+  float refresh_rate_;
+  double scale_;
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_SPEED_FEATURE_H_
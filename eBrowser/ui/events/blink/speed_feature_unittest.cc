@@ -0,0 +1,51 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/speed_feature.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ui {
+namespace {
+
+const double kTolerance = 1e-9;
+
+TEST(SpeedFeatureTest, ReferencePanelKeepsTheTrainedUnits) {
+  // What the models were trained on: physical pixels per second times 2/50.
+  EXPECT_NEAR(40, SpeedFeature().FromPhysicalPixelsPerSecond(1000),
+              kTolerance);
+  EXPECT_NEAR(40, SpeedFeature(320, 60).FromPhysicalPixelsPerSecond(1000),
+              kTolerance);
+}
+
+TEST(SpeedFeatureTest, UnknownMetricsAreTheReference) {
+  SpeedFeature feature(0, -1);
+  EXPECT_EQ(SpeedFeature::kReferenceDpi, feature.physical_dpi());
+  EXPECT_EQ(SpeedFeature::kReferenceRefreshRate, feature.refresh_rate());
+  EXPECT_NEAR(40, feature.FromPhysicalPixelsPerSecond(1000), kTolerance);
+}
+
+TEST(SpeedFeatureTest, SameMotionOnDenserPanelIsTheSameFeature) {
+  // Content crossing the glass at the same physical speed moves twice as many
+  // pixels on a 640dpi panel.
+  EXPECT_NEAR(SpeedFeature(320, 60).FromPhysicalPixelsPerSecond(1000),
+              SpeedFeature(640, 60).FromPhysicalPixelsPerSecond(2000),
+              kTolerance);
+  const double kSpeedOn441Dpi = 441 * 441 / 320.;
+  EXPECT_NEAR(SpeedFeature(320, 60).FromPhysicalPixelsPerSecond(441),
+              SpeedFeature(441, 60).FromPhysicalPixelsPerSecond(kSpeedOn441Dpi),
+              kTolerance);
+}
+
+TEST(SpeedFeatureTest, FasterPanelsMoveLessPerRefresh) {
+  // At 120Hz each refresh moves content half as far as at 60Hz.
+  EXPECT_NEAR(SpeedFeature(320, 60).FromPhysicalPixelsPerSecond(500),
+              SpeedFeature(320, 120).FromPhysicalPixelsPerSecond(1000),
+              kTolerance);
+  EXPECT_LT(SpeedFeature(320, 90).FromPhysicalPixelsPerSecond(1000),
+            SpeedFeature(320, 60).FromPhysicalPixelsPerSecond(1000));
+}
+
+}  // namespace
+}  // namespace ui
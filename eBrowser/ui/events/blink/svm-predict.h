@@ -1,6 +0,0 @@
-#ifndef LIBSVM_PREDICT
-#define LIBSVM_PREDICT
-namespace svmpredict {
-	double predict(double speed);
-}
-#endif
@@ -17,7 +17,17 @@
 #include <string>
 #include <cstring>
 #include <sstream>
+#include <memory>
+#include <vector>
+#include "base/atomic_ref_count.h"
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/threading/thread.h"
 int libsvm_version = LIBSVM_VERSION;
 typedef float Qfloat;
 typedef signed char schar;
@@ -54,6 +64,15 @@ static void print_string_stdout(const char *s)
 	fflush(stdout);
 }
 static void (*svm_print_string) (const char *) = &print_string_stdout;
+
+// See svm_set_kernel_threads(). Columns of the small sets a device trains on
+// take microseconds, less than handing them to another thread.
+static int svm_kernel_threads = 0;
+static int svm_min_parallel_column_length = 4096;
+// See svm_set_predict_threads(). Batches are only split into chunks of at
+// least this many instances.
+static int svm_predict_threads = 1;
+static const int svm_min_parallel_predict_chunk = 256;
 /*
 #if 1
 static void info_not_used_now(const char *fmt,...)
@@ -75,6 +94,13 @@ static void info_not_used_now(const char *fmt,...) {}
 // l is the number of total data items
 // size is the cache size limit in bytes
 //
+// The columns live in one arena of fixed-stride slots, each long enough for
+// a whole column, so that a column grows in place and eviction never returns
+// memory to the heap. Slots are evicted in clock order: the hand passes over
+// a slot used since it last passed once, and takes the first that was not.
+// The slot used last is never taken, since the solver reads the column it
+// just got alongside the one it gets next.
+//
 class Cache
 {
 public:
@@ -88,79 +114,103 @@ public:
 	void swap_index(int i, int j);
 private:
 	int l;
-	long int size;
 	struct head_t
 	{
-		head_t *prev, *next;	// a circular list
-		Qfloat *data;
-		int len;		// data[0,len) is cached in this entry
+		int slot;	// -1 if not cached
+		int len;	// data[0,len) is cached in the slot
+	};
+	struct slot_t
+	{
+		int index;	// the column in the slot, -1 if free
+		bool used;	// used since the clock hand last passed
 	};
 
 	head_t *head;
-	head_t lru_head;
-	void lru_delete(head_t *h);
-	void lru_insert(head_t *h);
+	slot_t *slots;
+	int slot_count;
+	Qfloat *arena;
+	int hand;
+	int last_slot;
+
+	Qfloat *slot_data(int slot) const
+	{
+		return arena + (size_t)slot * l;
+	}
+	int take_slot();
+	void evict(int slot);
 };
 
-Cache::Cache(int l_,long int size_):l(l_),size(size_)
+Cache::Cache(int l_,long int size_):l(l_),hand(0),last_slot(-1)
 {
-	head = (head_t *)calloc(l,sizeof(head_t));	// initialized to 0
-	size /= sizeof(Qfloat);
-	size -= l * sizeof(head_t) / sizeof(Qfloat);
-	size = max(size, 2 * (long int) l);	// cache must be large enough for two columns
-	lru_head.next = lru_head.prev = &lru_head;
+	head = Malloc(head_t,l);
+	for(int i=0;i<l;i++)
+	{
+		head[i].slot = -1;
+		head[i].len = 0;
+	}
+	long int size = size_ - l * (long int) sizeof(head_t);
+	long int column_size = (long int) (l * sizeof(Qfloat) + sizeof(slot_t));
+	slot_count = (int) min(size / column_size, (long int) l);
+	slot_count = max(slot_count, 2);	// cache must be large enough for two columns
+	slots = Malloc(slot_t,slot_count);
+	for(int s=0;s<slot_count;s++)
+	{
+		slots[s].index = -1;
+		slots[s].used = false;
+	}
+	arena = Malloc(Qfloat,(size_t)slot_count * l);
 }
 
 Cache::~Cache()
 {
-	for(head_t *h = lru_head.next; h != &lru_head; h=h->next)
-		free(h->data);
+	free(arena);
+	free(slots);
 	free(head);
 }
 
-void Cache::lru_delete(head_t *h)
+void Cache::evict(int slot)
 {
-	// delete from current location
-	h->prev->next = h->next;
-	h->next->prev = h->prev;
+	head_t *h = &head[slots[slot].index];
+	h->slot = -1;
+	h->len = 0;
+	slots[slot].index = -1;
+	slots[slot].used = false;
 }
 
-void Cache::lru_insert(head_t *h)
+int Cache::take_slot()
 {
-	// insert to last position
-	h->next = &lru_head;
-	h->prev = lru_head.prev;
-	h->prev->next = h;
-	h->next->prev = h;
+	for(;;)
+	{
+		int slot = hand;
+		hand = (hand + 1) % slot_count;
+		if(slot == last_slot)
+			continue;
+		if(slots[slot].index == -1)
+			return slot;
+		if(slots[slot].used)
+		{
+			slots[slot].used = false;
+			continue;
+		}
+		evict(slot);
+		return slot;
+	}
 }
 
 int Cache::get_data(const int index, Qfloat **data, int len)
 {
 	head_t *h = &head[index];
-	if(h->len) lru_delete(h);
-	int more = len - h->len;
-
-	if(more > 0)
+	if(h->slot == -1)
 	{
-		// free old space
-		while(size < more)
-		{
-			head_t *old = lru_head.next;
-			lru_delete(old);
-			free(old->data);
-			size += old->len;
-			old->data = 0;
-			old->len = 0;
-		}
-
-		// allocate new space
-		h->data = (Qfloat *)realloc(h->data,sizeof(Qfloat)*len);
-		size -= more;
-		swap(h->len,len);
+		h->slot = take_slot();
+		slots[h->slot].index = index;
 	}
+	slots[h->slot].used = true;
+	last_slot = h->slot;
 
-	lru_insert(h);
-	*data = h->data;
+	if(len > h->len)
+		swap(h->len,len);
+	*data = slot_data(h->slot);
 	return len;
 }
 
@@ -168,33 +218,109 @@ void Cache::swap_index(int i, int j)
 {
 	if(i==j) return;
 
-	if(head[i].len) lru_delete(&head[i]);
-	if(head[j].len) lru_delete(&head[j]);
-	swap(head[i].data,head[j].data);
-	swap(head[i].len,head[j].len);
-	if(head[i].len) lru_insert(&head[i]);
-	if(head[j].len) lru_insert(&head[j]);
+	swap(head[i],head[j]);
+	if(head[i].slot != -1) slots[head[i].slot].index = i;
+	if(head[j].slot != -1) slots[head[j].slot].index = j;
 
 	if(i>j) swap(i,j);
-	for(head_t *h = lru_head.next; h!=&lru_head; h=h->next)
+	for(int s=0;s<slot_count;s++)
 	{
+		if(slots[s].index == -1)
+			continue;
+		head_t *h = &head[slots[s].index];
 		if(h->len > i)
 		{
 			if(h->len > j)
-				swap(h->data[i],h->data[j]);
+				swap(slot_data(s)[i],slot_data(s)[j]);
 			else
 			{
 				// give up
-				lru_delete(h);
-				free(h->data);
-				size += h->len;
-				h->data = 0;
-				h->len = 0;
+				if(s == last_slot)
+					last_slot = -1;
+				evict(s);
 			}
 		}
 	}
 }
 
+//
+// Kernel column workers
+//
+// Fills the entries of a kernel column in contiguous chunks, one per thread,
+// the calling thread taking the first. Every entry is computed exactly as the
+// serial loop computes it, so the trained model does not depend on the
+// number of threads.
+//
+class ColumnWorkers
+{
+public:
+	typedef base::Callback<void(int start, int end)> FillCallback;
+
+	explicit ColumnWorkers(int threads)
+	{
+		for(int t=1;t<threads;t++)
+		{
+			workers.push_back(base::MakeUnique<base::Thread>(
+				"SvmKernelWorker" + base::IntToString(t)));
+			CHECK(workers.back()->Start());
+		}
+	}
+
+	// Calls fill over [start,end) and returns once all of it is done.
+	void run(int start, int end, const FillCallback& fill) const
+	{
+		if(start >= end)
+			return;
+		int chunks = (int)workers.size()+1;
+		int chunk_length = (end-start+chunks-1)/chunks;
+		// Every chunk but the calling thread's is counted before any is
+		// posted, so that a worker finishing early cannot take the count to
+		// zero, and signal, while later chunks are still unposted.
+		int remote_chunks = (end-start+chunk_length-1)/chunk_length-1;
+		scoped_refptr<Completion> completion(new Completion(remote_chunks));
+		int posted = 0;
+		for(int begin=start+chunk_length;begin<end;begin+=chunk_length)
+		{
+			workers[posted++]->task_runner()->PostTask(
+				FROM_HERE,
+				base::Bind(&ColumnWorkers::run_chunk, fill, begin,
+					   min(begin+chunk_length,end), completion));
+		}
+		DCHECK_EQ(posted,remote_chunks);
+		fill.Run(start,min(start+chunk_length,end));
+		if(remote_chunks)
+			completion->done.Wait();
+	}
+
+private:
+	// Shared with the posted chunks, so that the last one can still signal
+	// after run() has woken up and returned.
+	struct Completion : public base::RefCountedThreadSafe<Completion>
+	{
+		explicit Completion(int chunks)
+			: pending(chunks),
+			  done(base::WaitableEvent::ResetPolicy::MANUAL,
+			       base::WaitableEvent::InitialState::NOT_SIGNALED) {}
+
+		base::AtomicRefCount pending;
+		base::WaitableEvent done;
+
+	private:
+		friend class base::RefCountedThreadSafe<Completion>;
+		~Completion() {}
+	};
+
+	static void run_chunk(const FillCallback& fill, int start, int end,
+			      const scoped_refptr<Completion>& completion)
+	{
+		fill.Run(start,end);
+		if(!base::AtomicRefCountDec(&completion->pending))
+			completion->done.Signal();
+	}
+
+	std::vector<std::unique_ptr<base::Thread>> workers;
+};
+
 //
 // Kernel evaluation
 //
@@ -228,9 +354,22 @@ protected:
 
 	double (Kernel::*kernel_function)(int i, int j) const;
 
+	// Fills data[start,end) of column i, across the column workers if the
+	// range is long enough to pay for them.
+	void fill_column(int i, Qfloat *data, int start, int end) const
+	{
+		if(workers && end-start >= svm_min_parallel_column_length)
+			workers->run(start,end,base::Bind(&Kernel::fill_range,
+				base::Unretained(this),i,data));
+		else
+			fill_range(i,data,start,end);
+	}
+	virtual void fill_range(int i, Qfloat *data, int start, int end) const = 0;
+
 private:
 	const svm_node **x;
 	double *x_square;
+	std::unique_ptr<ColumnWorkers> workers;
 
 	// svm_parameter
 	const int kernel_type;
@@ -292,6 +431,12 @@ Kernel::Kernel(int l, svm_node * const * x_, const svm_parameter& param):kernel_
 	}
 	else
 		x_square = 0;
+
+	int threads = svm_kernel_threads;
+	if(threads == 0)
+		threads = base::SysInfo::NumberOfProcessors();
+	if(threads > 1 && l >= svm_min_parallel_column_length)
+		workers = base::MakeUnique<ColumnWorkers>(threads);
 }
 
 Kernel::~Kernel()
@@ -1288,15 +1433,18 @@ public:
 	Qfloat *get_Q(int i, int len) const override
 	{
 		Qfloat *data;
-		int start, j;
+		int start;
 		if((start = cache->get_data(i,&data,len)) < len)
-		{
-			for(j=start;j<len;j++)
-				data[j] = (Qfloat)(y[i]*y[j]*(this->*kernel_function)(i,j));
-		}
+			fill_column(i,data,start,len);
 		return data;
 	}
 
+	void fill_range(int i, Qfloat *data, int start, int end) const override
+	{
+		for(int j=start;j<end;j++)
+			data[j] = (Qfloat)(y[i]*y[j]*(this->*kernel_function)(i,j));
+	}
+
 	double *get_QD() const override
 	{
 		return QD;
@@ -1337,15 +1485,18 @@ public:
 	Qfloat *get_Q(int i, int len) const override
 	{
 		Qfloat *data;
-		int start, j;
+		int start;
 		if((start = cache->get_data(i,&data,len)) < len)
-		{
-			for(j=start;j<len;j++)
-				data[j] = (Qfloat)(this->*kernel_function)(i,j);
-		}
+			fill_column(i,data,start,len);
 		return data;
 	}
 
+	void fill_range(int i, Qfloat *data, int start, int end) const override
+	{
+		for(int j=start;j<end;j++)
+			data[j] = (Qfloat)(this->*kernel_function)(i,j);
+	}
+
 	double *get_QD() const override
 	{
 		return QD;
@@ -1404,11 +1555,9 @@ public:
 	{
 		Qfloat *data;
 		int j, real_i = index[i];
-		if(cache->get_data(real_i,&data,l) < l)
-		{
-			for(j=0;j<l;j++)
-				data[j] = (Qfloat)(this->*kernel_function)(real_i,j);
-		}
+		int start;
+		if((start = cache->get_data(real_i,&data,l)) < l)
+			fill_column(real_i,data,start,l);
 
 		// reorder and copy
 		Qfloat *buf = buffer[next_buffer];
@@ -1419,6 +1568,12 @@ public:
 		return buf;
 	}
 
+	void fill_range(int i, Qfloat *data, int start, int end) const override
+	{
+		for(int j=start;j<end;j++)
+			data[j] = (Qfloat)(this->*kernel_function)(i,j);
+	}
+
 	double *get_QD() const override
 	{
 		return QD;
@@ -1568,9 +1723,12 @@ static void solve_one_class(
 	delete[] ones;
 }
 
+// |initial_coef|, if not NULL, holds a feasible starting point as
+// alpha_i - alpha_i* for each sample; the solver starts from it instead of
+// from zero.
 static void solve_epsilon_svr(
 	const svm_problem *prob, const svm_parameter *param,
-	double *alpha, Solver::SolutionInfo* si)
+	double *alpha, Solver::SolutionInfo* si, const double *initial_coef)
 {
 	int l = prob->l;
 	double *alpha2 = new double[2*l];
@@ -1580,11 +1738,12 @@ static void solve_epsilon_svr(
 
 	for(i=0;i<l;i++)
 	{
-		alpha2[i] = 0;
+		double coef = initial_coef ? initial_coef[i] : 0;
+		alpha2[i] = max(coef,0.0);
 		linear_term[i] = param->p - prob->y[i];
 		y[i] = 1;
 
-		alpha2[i+l] = 0;
+		alpha2[i+l] = max(-coef,0.0);
 		linear_term[i+l] = param->p + prob->y[i];
 		y[i+l] = -1;
 	}
@@ -1655,7 +1814,7 @@ struct decision_function
 
 static decision_function svm_train_one(
 	const svm_problem *prob, const svm_parameter *param,
-	double Cp, double Cn)
+	double Cp, double Cn, const double *initial_coef = NULL)
 {
 	double *alpha = Malloc(double,prob->l);
 	Solver::SolutionInfo si;
@@ -1671,7 +1830,7 @@ static decision_function svm_train_one(
 			solve_one_class(prob,param,alpha,&si);
 			break;
 		case EPSILON_SVR:
-			solve_epsilon_svr(prob,param,alpha,&si);
+			solve_epsilon_svr(prob,param,alpha,&si,initial_coef);
 			break;
 		case NU_SVR:
 			solve_nu_svr(prob,param,alpha,&si);
@@ -2099,6 +2258,12 @@ static void svm_group_classes(const svm_problem *prob, int *nr_class_ret, int **
 // Interface functions
 //
 svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
+{
+	return svm_train_warm_start(prob,param,NULL);
+}
+
+svm_model *svm_train_warm_start(const svm_problem *prob,
+	const svm_parameter *param, const double *initial_coef)
 {
 	svm_model *model = Malloc(svm_model,1);
 	model->param = *param;
@@ -2123,7 +2288,8 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 			model->probA[0] = svm_svr_probability(prob,param);
 		}
 
-		decision_function f = svm_train_one(prob,param,0,0);
+		decision_function f = svm_train_one(prob,param,0,0,
+			param->svm_type == EPSILON_SVR ? initial_coef : NULL);
 		model->rho = Malloc(double,1);
 		model->rho[0] = f.rho;
 
@@ -2507,6 +2673,8 @@ double svm_get_svr_probability(const svm_model *model)
 	}
 }
 
+static double svm_vote(const svm_model *model, const double *kvalue, double* dec_values);
+
 double svm_predict_values(const svm_model *model, const svm_node *x, double* dec_values)
 {
 	int i;
@@ -2536,59 +2704,68 @@ double svm_predict_values(const svm_model *model, const svm_node *x, double* dec
 	else
 	{
 //LOG(INFO)<<"执行到了svm_predict_values"<<model->nr_class;
-		int nr_class = model->nr_class;
 		int l = model->l;
 		
 		double *kvalue = Malloc(double,l);
 		for(i=0;i<l;i++)
 			kvalue[i] = Kernel::k_function(x,model->SV[i],model->param);
+		double label = svm_vote(model,kvalue,dec_values);
+		free(kvalue);
+		return label;
+	}
+}
 
-		int *start = Malloc(int,nr_class);
-		start[0] = 0;
-		for(i=1;i<nr_class;i++)
-			start[i] = start[i-1]+model->nSV[i-1];
+// Pairwise votes of a classifier, from the kernel values of x against every
+// support vector.
+static double svm_vote(const svm_model *model, const double *kvalue, double* dec_values)
+{
+	int i;
+	int nr_class = model->nr_class;
 
-		int *vote = Malloc(int,nr_class);
-		for(i=0;i<nr_class;i++)
-			vote[i] = 0;
-//LOG(INFO)<<"执行到了svm_predict_values";
-		int p=0;
-		for(i=0;i<nr_class;i++)
-			for(int j=i+1;j<nr_class;j++)
-			{
-				double sum = 0;
-				int si = start[i];
-				int sj = start[j];
-				int ci = model->nSV[i];
-				int cj = model->nSV[j];
-				
-				int k;
-				double *coef1 = model->sv_coef[j-1];
-				double *coef2 = model->sv_coef[i];
-				for(k=0;k<ci;k++)
-					sum += coef1[si+k] * kvalue[si+k];
-				for(k=0;k<cj;k++)
-					sum += coef2[sj+k] * kvalue[sj+k];
-				sum -= model->rho[p];
-				dec_values[p] = sum;
+	int *start = Malloc(int,nr_class);
+	start[0] = 0;
+	for(i=1;i<nr_class;i++)
+		start[i] = start[i-1]+model->nSV[i-1];
 
-				if(dec_values[p] > 0)
-					++vote[i];
-				else
-					++vote[j];
-				p++;
-			}
+	int *vote = Malloc(int,nr_class);
+	for(i=0;i<nr_class;i++)
+		vote[i] = 0;
 //LOG(INFO)<<"执行到了svm_predict_values";
-		int vote_max_idx = 0;
-		for(i=1;i<nr_class;i++)
-			if(vote[i] > vote[vote_max_idx])
-				vote_max_idx = i;
+	int p=0;
+	for(i=0;i<nr_class;i++)
+		for(int j=i+1;j<nr_class;j++)
+		{
+			double sum = 0;
+			int si = start[i];
+			int sj = start[j];
+			int ci = model->nSV[i];
+			int cj = model->nSV[j];
+			
+			int k;
+			double *coef1 = model->sv_coef[j-1];
+			double *coef2 = model->sv_coef[i];
+			for(k=0;k<ci;k++)
+				sum += coef1[si+k] * kvalue[si+k];
+			for(k=0;k<cj;k++)
+				sum += coef2[sj+k] * kvalue[sj+k];
+			sum -= model->rho[p];
+			dec_values[p] = sum;
+
+			if(dec_values[p] > 0)
+				++vote[i];
+			else
+				++vote[j];
+			p++;
+		}
 //LOG(INFO)<<"执行到了svm_predict_values";
-		free(kvalue);
-		free(start);
-		free(vote);//LOG(INFO)<<"执行到了svm_predict_values";
-		return model->label[vote_max_idx];
-	}
+	int vote_max_idx = 0;
+	for(i=1;i<nr_class;i++)
+		if(vote[i] > vote[vote_max_idx])
+			vote_max_idx = i;
+//LOG(INFO)<<"执行到了svm_predict_values";
+	free(start);
+	free(vote);//LOG(INFO)<<"执行到了svm_predict_values";
+	return model->label[vote_max_idx];
 }
 
 double svm_predict(const svm_model *model, const svm_node *x)
@@ -2609,6 +2786,166 @@ double svm_predict(const svm_model *model, const svm_node *x)
 	return pred_result;
 }
 
+//
+// Batch prediction
+//
+// The support vectors are copied once per batch into a dense feature-major
+// array, so that the kernel values of a block of instances against a block
+// of support vectors come from loops over contiguous memory, which the
+// compiler vectorizes, instead of from a walk of two svm_node lists per pair.
+//
+static const int predict_instance_block = 8;
+static const int predict_sv_block = 256;
+
+struct BatchPrediction
+{
+	const svm_model *model;
+	const float *features;
+	int dim;
+	double *out;
+	// sv[f*l+j] is the feature with index f+1 of support vector j.
+	std::vector<double> sv;
+	// For RBF, the sum of squares of the features of each support vector
+	// that instances do not have.
+	std::vector<double> sv_rest;
+};
+
+static void predict_batch_range(const BatchPrediction *b, int start, int end)
+{
+	const svm_model *model = b->model;
+	const svm_parameter& param = model->param;
+	int l = model->l;
+	int dim = b->dim;
+	bool single = param.svm_type == ONE_CLASS ||
+		      param.svm_type == EPSILON_SVR ||
+		      param.svm_type == NU_SVR;
+	double tile[predict_instance_block][predict_sv_block];
+	double sum[predict_instance_block];
+	// Classifiers vote on all kernel values of an instance at once.
+	std::vector<double> kvalue;
+	std::vector<double> dec_values;
+	if(!single)
+	{
+		kvalue.resize((size_t)predict_instance_block*l);
+		dec_values.resize(model->nr_class*(model->nr_class-1)/2);
+	}
+
+	for(int i0=start;i0<end;i0+=predict_instance_block)
+	{
+		int ni = min(predict_instance_block,end-i0);
+		for(int i=0;i<ni;i++)
+			sum[i] = 0;
+		for(int j0=0;j0<l;j0+=predict_sv_block)
+		{
+			int nj = min(predict_sv_block,l-j0);
+			for(int i=0;i<ni;i++)
+				for(int j=0;j<nj;j++)
+					tile[i][j] = 0;
+			for(int f=0;f<dim;f++)
+			{
+				const double *sv = &b->sv[(size_t)f*l+j0];
+				for(int i=0;i<ni;i++)
+				{
+					double x = b->features[(size_t)(i0+i)*dim+f];
+					double *t = tile[i];
+					if(param.kernel_type == RBF)
+						for(int j=0;j<nj;j++)
+						{
+							double d = x-sv[j];
+							t[j] += d*d;
+						}
+					else
+						for(int j=0;j<nj;j++)
+							t[j] += x*sv[j];
+				}
+			}
+			for(int i=0;i<ni;i++)
+			{
+				double *t = tile[i];
+				for(int j=0;j<nj;j++)
+					switch(param.kernel_type)
+					{
+						case POLY:
+							t[j] = powi(param.gamma*t[j]+param.coef0,param.degree);
+							break;
+						case RBF:
+							t[j] = exp(-param.gamma*(t[j]+b->sv_rest[j0+j]));
+							break;
+						case SIGMOID:
+							t[j] = tanh(param.gamma*t[j]+param.coef0);
+							break;
+					}
+				if(single)
+				{
+					const double *coef = model->sv_coef[0]+j0;
+					for(int j=0;j<nj;j++)
+						sum[i] += coef[j]*t[j];
+				}
+				else
+					memcpy(&kvalue[(size_t)i*l+j0],t,sizeof(double)*nj);
+			}
+		}
+		for(int i=0;i<ni;i++)
+		{
+			double value;
+			if(single)
+			{
+				value = sum[i]-model->rho[0];
+				if(param.svm_type == ONE_CLASS)
+					value = (value>0)?1:-1;
+			}
+			else
+				value = svm_vote(model,&kvalue[(size_t)i*l],&dec_values[0]);
+			b->out[i0+i] = value;
+		}
+	}
+}
+
+void svm_predict_batch(const svm_model *model, const float *features, int n, int dim, double *out)
+{
+	if(model->param.kernel_type == PRECOMPUTED)
+	{
+		std::vector<svm_node> x(dim+1);
+		for(int i=0;i<n;i++)
+		{
+			for(int f=0;f<dim;f++)
+			{
+				x[f].index = f+1;
+				x[f].value = features[(size_t)i*dim+f];
+			}
+			x[dim].index = -1;
+			out[i] = svm_predict(model,&x[0]);
+		}
+		return;
+	}
+
+	int l = model->l;
+	BatchPrediction b;
+	b.model = model;
+	b.features = features;
+	b.dim = dim;
+	b.out = out;
+	b.sv.assign((size_t)dim*l,0);
+	b.sv_rest.assign(l,0);
+	for(int j=0;j<l;j++)
+		for(const svm_node *p=model->SV[j];p->index!=-1;p++)
+		{
+			if(p->index >= 1 && p->index <= dim)
+				b.sv[(size_t)(p->index-1)*l+j] = p->value;
+			else if(model->param.kernel_type == RBF)
+				b.sv_rest[j] += p->value*p->value;
+		}
+
+	int threads = svm_predict_threads;
+	if(threads == 0)
+		threads = base::SysInfo::NumberOfProcessors();
+	threads = min(threads,n/svm_min_parallel_predict_chunk);
+	if(threads > 1)
+		ColumnWorkers(threads).run(0,n,base::Bind(&predict_batch_range,&b));
+	else
+		predict_batch_range(&b,0,n);
+}
+
 double svm_predict_probability(
 	const svm_model *model, const svm_node *x, double *prob_estimates)
 {
@@ -3060,8 +3397,8 @@ char datas_ [31][300]  = {"-375.1906993292752 1:0.4","-1000 1:0.5","76.887894309
 */
 //----   
     int elements = 0;
+    // |line| points into the stack |buffer| below, so it is never freed.
     max_line_len = 200;
-    line = Malloc(char,max_line_len);
     char *p,*endptr,*idx,*val;
 //----    
     //int f = 0;
@@ -3152,7 +3489,7 @@ char datas_ [31][300]  = {"-375.1906993292752 1:0.4","-1000 1:0.5","76.887894309
         while(1)
         {
             idx = strtok(NULL, ":");
-            val = strtok(NULL, "\0");
+            val = strtok(NULL, " \t");
 	   
             if(val == NULL)
                 break;
@@ -3195,7 +3532,7 @@ char datas_ [31][300]  = {"-375.1906993292752 1:0.4","-1000 1:0.5","76.887894309
     }
 */
 //----
-    free(line);
+    line = NULL;
     model->free_sv = 1;	
     return model;
 }
@@ -3382,6 +3719,17 @@ int svm_check_probability_model(const svm_model *model)
 		 model->probA!=NULL);
 }
 
+void svm_set_kernel_threads(int threads, int min_column_length)
+{
+	svm_kernel_threads = threads;
+	svm_min_parallel_column_length = min_column_length;
+}
+
+void svm_set_predict_threads(int threads)
+{
+	svm_predict_threads = threads;
+}
+
 void svm_set_print_string_function(void (*print_func)(const char *))
 {
 	if(print_func == NULL)
@@ -74,6 +74,11 @@ struct svm_model
 };
 
 struct svm_model *svm_train(const struct svm_problem *prob, const struct svm_parameter *param);
+/* Like svm_train(), but for EPSILON_SVR starts the solver from |initial_coef|
+   (alpha_i - alpha_i* per sample, as in sv_coef) instead of from zero. The
+   starting point must be feasible: every |initial_coef[i]| at most param->C
+   and their sum zero. Ignored for other svm types. */
+struct svm_model *svm_train_warm_start(const struct svm_problem *prob, const struct svm_parameter *param, const double *initial_coef);
 void svm_cross_validation(const struct svm_problem *prob, const struct svm_parameter *param, int nr_fold, double *target);
 
 int svm_save_model(const char *model_file_name, const struct svm_model *model);
@@ -89,6 +94,10 @@ double svm_get_svr_probability(const struct svm_model *model);
 double svm_predict_values(const struct svm_model *model, const struct svm_node *x, double* dec_values);
 double svm_predict(const struct svm_model *model, const struct svm_node *x);
 double svm_predict_probability(const struct svm_model *model, const struct svm_node *x, double* prob_estimates);
+/* Predicts n instances, each as svm_predict() would: features holds n rows of
+   dim values, value f of a row being the feature with svm_node index f+1.
+   Support vector features past dim count as absent from the instances. */
+void svm_predict_batch(const struct svm_model *model, const float *features, int n, int dim, double *out);
 
 void svm_free_model_content(struct svm_model *model_ptr);
 void svm_free_and_destroy_model(struct svm_model **model_ptr_ptr);
@@ -98,6 +107,14 @@ const char *svm_check_parameter(const struct svm_problem *prob, const struct svm
 int svm_check_probability_model(const struct svm_model *model);
 
 void svm_set_print_string_function(void (*print_func)(const char *));
+/* Kernel columns of at least min_column_length entries are filled by
+   threads threads, or one per processor if threads is 0. Applies to the
+   trainings started after the call; the defaults are 0 and 4096. */
+void svm_set_kernel_threads(int threads, int min_column_length);
+/* svm_predict_batch() splits batches of a few hundred instances or more
+   across threads threads, or one per processor if threads is 0. The default
+   is 1, since most callers predict on threads that must not block. */
+void svm_set_predict_threads(int threads);
 
 struct svm_model *svm_load_model(const char* model_string);
 #ifdef __cplusplus
@@ -0,0 +1,135 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/svm.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace ui {
+namespace {
+
+const int kIterations = 5;
+
+void QuietPrint(const char*) {}
+
+// Frame rates users settle on at a range of speeds, shaped like the cloud
+// trainer's training files, with deterministic noise.
+struct TrainingSet {
+  explicit TrainingSet(int l) : nodes(2 * l), x(l), y(l) {
+    for (int i = 0; i < l; ++i) {
+      double speed = 0.1 + 6.0 * i / l;
+      nodes[2 * i].index = 1;
+      nodes[2 * i].value = speed;
+      nodes[2 * i + 1].index = -1;
+      x[i] = &nodes[2 * i];
+      y[i] = 60 - 40 * exp(-speed) + 3 * sin(i * 12.9898);
+    }
+    problem.l = l;
+    problem.x = x.data();
+    problem.y = y.data();
+  }
+
+  std::vector<svm_node> nodes;
+  std::vector<svm_node*> x;
+  std::vector<double> y;
+  svm_problem problem;
+};
+
+svm_parameter TrainingParameter(double cache_size_mb) {
+  svm_parameter param;
+  memset(&param, 0, sizeof(param));
+  param.svm_type = EPSILON_SVR;
+  param.kernel_type = RBF;
+  param.gamma = 0.1;
+  param.cache_size = cache_size_mb;
+  param.eps = 0.001;
+  param.C = 1000;
+  param.p = 0.1;
+  param.shrinking = 1;
+  return param;
+}
+
+// Trains the epsilon-SVR the cloud trainer fits, with |cache_size_mb| of
+// kernel cache, and returns the time it took.
+base::TimeDelta Train(const TrainingSet& set, double cache_size_mb) {
+  svm_parameter param = TrainingParameter(cache_size_mb);
+  EXPECT_FALSE(svm_check_parameter(&set.problem, &param));
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  svm_model* model = svm_train(&set.problem, &param);
+  base::TimeDelta time = base::TimeTicks::Now() - start;
+  EXPECT_GT(model->l, 0);
+  svm_free_and_destroy_model(&model);
+  return time;
+}
+
+}  // namespace
+
+// A small cache keeps only a few columns of the larger sets, so those
+// trainings mostly measure the cache's eviction and the kernel fills.
+TEST(SvmPerfTest, Train) {
+  svm_set_print_string_function(&QuietPrint);
+  const int kSizes[] = {47, 256, 1024, 4096};
+  const int kCacheSizesMb[] = {1, 40};
+  for (int size : kSizes) {
+    TrainingSet set(size);
+    for (int cache_size_mb : kCacheSizesMb) {
+      base::TimeDelta total;
+      for (int i = 0; i < kIterations; ++i)
+        total += Train(set, cache_size_mb);
+      perf_test::PrintResult(
+          "svm_train", base::StringPrintf("_%dmb", cache_size_mb),
+          base::StringPrintf("samples_%d", size),
+          total.InMillisecondsF() / kIterations, "ms", true);
+    }
+  }
+  svm_set_print_string_function(nullptr);
+}
+
+// Evaluates a model at the speeds of a frame rate table, one svm_predict()
+// per speed and in one svm_predict_batch().
+TEST(SvmPerfTest, PredictBatch) {
+  svm_set_print_string_function(&QuietPrint);
+  const int kSizes[] = {256, 4096};
+  const int kSpeeds = 6000;
+  std::vector<float> speeds(kSpeeds);
+  for (int i = 0; i < kSpeeds; ++i)
+    speeds[i] = 0.001f * i;
+  for (int size : kSizes) {
+    TrainingSet set(size);
+    svm_parameter param = TrainingParameter(40);
+    svm_model* model = svm_train(&set.problem, &param);
+    std::vector<double> out(kSpeeds);
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kSpeeds; ++i) {
+      svm_node x[] = {{1, speeds[i]}, {-1, 0}};
+      out[i] = svm_predict(model, x);
+    }
+    base::TimeDelta single = base::TimeTicks::Now() - start;
+
+    start = base::TimeTicks::Now();
+    svm_predict_batch(model, speeds.data(), kSpeeds, 1, out.data());
+    base::TimeDelta batch = base::TimeTicks::Now() - start;
+
+    std::string trace = base::StringPrintf("samples_%d", size);
+    perf_test::PrintResult("svm_predict", "", trace, single.InMillisecondsF(),
+                           "ms", true);
+    perf_test::PrintResult("svm_predict_batch", "", trace,
+                           batch.InMillisecondsF(), "ms", true);
+    svm_free_and_destroy_model(&model);
+  }
+  svm_set_print_string_function(nullptr);
+}
+
+}  // namespace ui
@@ -0,0 +1,242 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/svm_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/shared_memory.h"
+#include "ui/events/blink/dense_rbf_model.h"
+#include "ui/events/blink/svm.h"
+
+namespace ui {
+
+namespace {
+
+static_assert(MODEL_FEATURE_COUNT <= PredictionCache::kMaxFeatures,
+              "PredictionCache keys must hold every model feature");
+
+const int kMinPlausibleFrameRate = 10;
+const int kFallbackFrameRate = 24;
+const int kMaxFrameRate = 60;
+
+// Largest difference from the exact model that the single-precision dense
+// model may show at load time. Predictions are rounded up to whole frames, so
+// this only changes a prediction that was within a tenth of a frame of the
+// next one.
+const double kMaxDenseModelError = 0.1;
+
+// The dense model is checked at this many support vectors at most.
+const int kMaxValidationSupportVectors = 32;
+
+// Returns the largest difference between |dense| and the exact |model| it was
+// converted from, at a sample of the support vectors and halfway between
+// consecutive ones, where the kernel sums peak and change fastest.
+double MaxDenseModelError(const svm_model& model, const DenseRbfModel& dense) {
+  const int num_features = dense.num_features();
+  const int stride = std::max(1, model.l / kMaxValidationSupportVectors);
+  std::vector<float> probes;
+  std::vector<float> previous;
+  for (int i = 0; i < model.l; i += stride) {
+    std::vector<float> support_vector(num_features, 0.f);
+    for (const svm_node* node = model.SV[i]; node->index != -1; ++node)
+      support_vector[node->index - 1] = static_cast<float>(node->value);
+    for (size_t f = 0; f < previous.size(); ++f)
+      probes.push_back(0.5f * (previous[f] + support_vector[f]));
+    probes.insert(probes.end(), support_vector.begin(), support_vector.end());
+    previous.swap(support_vector);
+  }
+
+  const int count = static_cast<int>(probes.size()) / num_features;
+  std::vector<double> expected(count);
+  svm_predict_batch(&model, probes.data(), count, num_features,
+                    expected.data());
+  double max_error = 0;
+  for (int i = 0; i < count; ++i) {
+    double error =
+        std::abs(dense.Predict(&probes[i * num_features]) - expected[i]);
+    max_error = std::max(max_error, error);
+  }
+  return max_error;
+}
+
+// Returns the highest feature index used by any support vector of |model|.
+int MaxFeatureIndex(const svm_model& model) {
+  int max_index = 0;
+  for (int i = 0; i < model.l; ++i) {
+    for (const svm_node* node = model.SV[i]; node->index != -1; ++node)
+      max_index = std::max(max_index, node->index);
+  }
+  return max_index;
+}
+
+}  // namespace
+
+int ClampPredictedFrameRate(double prediction) {
+  int fps = static_cast<int>(std::ceil(prediction));
+  if (fps < kMinPlausibleFrameRate)
+    return kFallbackFrameRate;
+  return std::min(fps, kMaxFrameRate);
+}
+
+// static
+std::unique_ptr<SvmPredictor> SvmPredictor::Create(
+    const std::string& model_str) {
+  if (model_str.empty())
+    return nullptr;
+  svm_model* model = svm_load_model(model_str.c_str());
+  if (!model) {
+    DLOG(WARNING) << "Failed to parse SVR model.";
+    return nullptr;
+  }
+  int num_features = MaxFeatureIndex(*model);
+  if (num_features > MODEL_FEATURE_COUNT) {
+    DLOG(WARNING) << "SVR model uses " << num_features << " features, only "
+                  << MODEL_FEATURE_COUNT << " are available.";
+    svm_free_and_destroy_model(&model);
+    return nullptr;
+  }
+  if (svm_check_probability_model(model))
+    DLOG(WARNING) << "Model supports probability estimates, but they are "
+                     "disabled in prediction.";
+  return base::WrapUnique(new SvmPredictor(model, std::max(num_features, 1)));
+}
+
+// static
+std::unique_ptr<SvmPredictor> SvmPredictor::CreateFromSharedMemory(
+    std::unique_ptr<base::SharedMemory> memory,
+    size_t size) {
+  if (!memory || (!memory->memory() && !memory->Map(size)))
+    return nullptr;
+  std::unique_ptr<DenseRbfModel> dense_model =
+      DenseRbfModel::CreateFromBinary(memory->memory(), size);
+  if (!dense_model || dense_model->num_features() < 1 ||
+      dense_model->num_features() > MODEL_FEATURE_COUNT) {
+    DLOG(WARNING) << "Failed to load binary SVR model.";
+    return nullptr;
+  }
+  return base::WrapUnique(
+      new SvmPredictor(std::move(memory), std::move(dense_model)));
+}
+
+SvmPredictor::SvmPredictor(svm_model* model, int num_features)
+    : model_(model), num_features_(num_features) {
+  DCHECK(model_);
+  dense_model_ = DenseRbfModel::Create(*model_);
+  // The dense model reads exactly its own feature count from the input.
+  if (dense_model_ && dense_model_->num_features() > MODEL_FEATURE_COUNT)
+    dense_model_.reset();
+  // Single precision and the approximated exp() are only used where they do
+  // not change the predictions; models whose large coefficients cancel out
+  // lose too much of their output to rounding.
+  if (dense_model_) {
+    double error = MaxDenseModelError(*model_, *dense_model_);
+    if (!(error <= kMaxDenseModelError)) {
+      DLOG(WARNING) << "Dense SVR model is off by " << error
+                    << "fps, evaluating the exact model.";
+      dense_model_.reset();
+    }
+  }
+}
+
+SvmPredictor::SvmPredictor(std::unique_ptr<base::SharedMemory> memory,
+                           std::unique_ptr<DenseRbfModel> dense_model)
+    : model_(nullptr),
+      num_features_(dense_model->num_features()),
+      shared_memory_(std::move(memory)),
+      dense_model_(std::move(dense_model)) {
+  DCHECK(dense_model_);
+}
+
+SvmPredictor::~SvmPredictor() {
+  if (model_)
+    svm_free_and_destroy_model(&model_);
+}
+
+bool SvmPredictor::SerializeToBinary(std::vector<uint8_t>* binary) const {
+  if (!dense_model_)
+    return false;
+  *binary = dense_model_->SerializeToBinary();
+  return true;
+}
+
+double SvmPredictor::Predict(const float* features) const {
+  if (dense_model_)
+    return dense_model_->Predict(features);
+
+  // At most MODEL_FEATURE_COUNT nodes plus the -1 terminator, so the input
+  // vector can live on the stack.
+  svm_node x[MODEL_FEATURE_COUNT + 1];
+  for (int i = 0; i < num_features_; ++i) {
+    x[i].index = i + 1;
+    x[i].value = features[i];
+  }
+  x[num_features_].index = -1;
+
+  int svm_type = svm_get_svm_type(model_);
+  if (svm_type == EPSILON_SVR || svm_type == NU_SVR) {
+    double dec_value = 0;
+    return svm_predict_values(model_, x, &dec_value);
+  }
+  return svm_predict(model_, x);
+}
+
+double SvmPredictor::Predict(double speed) const {
+  float features[MODEL_FEATURE_COUNT] = {};
+  features[MODEL_FEATURE_SPEED] = static_cast<float>(speed);
+  return Predict(features);
+}
+
+void SvmPredictor::PredictBatch(const float* features,
+                                int count,
+                                double* out) const {
+  if (dense_model_) {
+    for (int i = 0; i < count; ++i)
+      out[i] = dense_model_->Predict(features + i * num_features_);
+    return;
+  }
+  svm_predict_batch(model_, features, count, num_features_, out);
+}
+
+double SvmPredictor::PredictCached(const float* features) const {
+  float quantized[MODEL_FEATURE_COUNT] = {};
+  PredictionCache::Quantize(features, num_features_, quantized);
+  double value;
+  if (cache_.Lookup(quantized, num_features_, &value))
+    return value;
+  value = Predict(quantized);
+  cache_.Insert(quantized, num_features_, value);
+  return value;
+}
+
+int SvmPredictor::num_support_vectors() const {
+  if (!model_)
+    return dense_model_->num_support_vectors();
+  return svm_get_nr_sv(model_);
+}
+
+double SvmPredictor::gamma() const {
+  if (!model_)
+    return dense_model_->gamma();
+  return model_->param.gamma;
+}
+
+double SvmPredictor::max_support_vector_value() const {
+  if (!model_)
+    return std::max(0.0, dense_model_->MaxFeatureValue(0));
+  double max_value = 0;
+  for (int i = 0; i < model_->l; ++i) {
+    for (const svm_node* node = model_->SV[i]; node->index != -1; ++node) {
+      if (node->index == MODEL_FEATURE_SPEED + 1)
+        max_value = std::max(max_value, node->value);
+    }
+  }
+  return max_value;
+}
+
+}  // namespace ui
@@ -0,0 +1,131 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_BLINK_SVM_PREDICTOR_H_
+#define UI_EVENTS_BLINK_SVM_PREDICTOR_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "ui/events/blink/prediction_cache.h"
+
+struct svm_model;
+
+namespace base {
+class SharedMemory;
+}
+
+namespace ui {
+
+class DenseRbfModel;
+
+// Inputs of the event rate model, in the order of their svm_node indices
+// (starting at 1). A model trained on fewer features reads only the first
+// ones, so single-feature speed models keep working unchanged.
+enum ModelFeature {
+  // Gesture speed, in the units the model was trained in.
+  MODEL_FEATURE_SPEED,
+  // Visual entropy of the page, as reported by the browser.
+  MODEL_FEATURE_PAGE_ENTROPY,
+  // Number of layers in the compositor's layer tree.
+  MODEL_FEATURE_LAYER_COUNT,
+  // Area of the layers that draw content, in viewports.
+  MODEL_FEATURE_RASTER_COST,
+  MODEL_FEATURE_COUNT
+};
+
+// Converts a raw model output into the frame rate used for throttling:
+// rounded up, capped at 60fps, and with implausibly low predictions (below
+// 10fps) replaced by 24fps.
+int ClampPredictedFrameRate(double prediction);
+
+// Holds an SVR event rate model that has been parsed once from the text
+// produced by the cloud trainer, or mapped from its binary form, so that it
+// can be evaluated for every scroll update without touching the model again.
+// The model is immutable after creation; apart from the result cache used by
+// PredictCached(), instances live on the compositor thread.
+class SvmPredictor {
+ public:
+  // Parses |model_str|. Returns nullptr if the text is not a valid model or
+  // uses features past MODEL_FEATURE_COUNT.
+  static std::unique_ptr<SvmPredictor> Create(const std::string& model_str);
+
+  // Maps |size| bytes of |memory|, unless the caller already has, a model in
+  // the DenseRbfModel binary format, and evaluates it in place without
+  // copying. Returns nullptr if the region
+  // cannot be mapped or does not hold a valid model of at most
+  // MODEL_FEATURE_COUNT features.
+  static std::unique_ptr<SvmPredictor> CreateFromSharedMemory(
+      std::unique_ptr<base::SharedMemory> memory,
+      size_t size);
+
+  ~SvmPredictor();
+
+  // Returns the raw model output (a frame rate) for |features|, which holds
+  // MODEL_FEATURE_COUNT values indexed by ModelFeature. Uses the dense,
+  // vectorized kernel when the model allows it.
+  double Predict(const float* features) const;
+
+  // Predict() with only the speed feature set and the others zero. Exact for
+  // models with a single feature.
+  double Predict(double speed) const;
+
+  // Predict() for |count| inputs at once, with |features| holding |count|
+  // rows of num_features() values. Models without the dense form are
+  // evaluated by svm_predict_batch(), which is much cheaper per input than
+  // Predict() for the batches of table generation and offline evaluation.
+  void PredictBatch(const float* features, int count, double* out) const;
+
+  // Predict() evaluated at the PredictionCache bucket of |features|, answered
+  // from the cache when the same bucket was asked for recently. Used on the
+  // gesture path, where consecutive events mostly ask the same question.
+  double PredictCached(const float* features) const;
+  const PredictionCache& cache() const { return cache_; }
+
+  // Number of leading features the model reads, between 1 and
+  // MODEL_FEATURE_COUNT.
+  int num_features() const { return num_features_; }
+
+  bool uses_dense_model() const { return !!dense_model_; }
+
+  // Writes the model in the DenseRbfModel binary format. Returns false for
+  // models that only have the sparse form.
+  bool SerializeToBinary(std::vector<uint8_t>* binary) const;
+
+  int num_support_vectors() const;
+
+  // Kernel width and the largest speed at which a support vector sits. For a
+  // single-feature model, past that speed (plus a few kernel widths) the
+  // output is effectively constant.
+  double gamma() const;
+  double max_support_vector_value() const;
+
+ private:
+  SvmPredictor(svm_model* model, int num_features);
+  SvmPredictor(std::unique_ptr<base::SharedMemory> memory,
+               std::unique_ptr<DenseRbfModel> dense_model);
+
+  // Null for models loaded from the binary format.
+  svm_model* model_;
+  int num_features_;
+  // Backs |dense_model_| for models loaded from the binary format, so it must
+  // be declared (and therefore destroyed) before it.
+  std::unique_ptr<base::SharedMemory> shared_memory_;
+  // Dense copy of |model_| for RBF regression models whose predictions it
+  // reproduces to within a tenth of a frame, or a view of |shared_memory_|.
+  std::unique_ptr<DenseRbfModel> dense_model_;
+  // Results of PredictCached(). Mutable since caching does not change what
+  // the model predicts for a bucket.
+  mutable PredictionCache cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(SvmPredictor);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_BLINK_SVM_PREDICTOR_H_
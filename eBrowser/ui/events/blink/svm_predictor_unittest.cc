@@ -0,0 +1,224 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/blink/svm_predictor.h"
+
+#include <cmath>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/blink/svm.h"
+
+namespace ui {
+namespace {
+
+// Two support vectors at speed 1 and 3 with an RBF kernel of gamma 0.5, so
+// f(x) = 10 * exp(-0.5 * (x - 1)^2) - 10 * exp(-0.5 * (x - 3)^2) + 30.
+const char kTestModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.5\n"
+    "nr_class 2\n"
+    "total_sv 2\n"
+    "rho -30\n"
+    "SV\n"
+    "10 1:1\n"
+    "-10 1:3\n";
+
+double ExpectedOutput(double x) {
+  return 10 * std::exp(-0.5 * (x - 1) * (x - 1)) -
+         10 * std::exp(-0.5 * (x - 3) * (x - 3)) + 30;
+}
+
+TEST(SvmPredictorTest, RejectsEmptyAndMalformedModels) {
+  EXPECT_FALSE(SvmPredictor::Create(std::string()));
+  EXPECT_FALSE(SvmPredictor::Create("not a model"));
+}
+
+TEST(SvmPredictorTest, PredictMatchesKernelSum) {
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(kTestModel);
+  ASSERT_TRUE(predictor);
+  EXPECT_EQ(2, predictor->num_support_vectors());
+  for (double x : {0.0, 1.0, 2.0, 3.0, 7.5, 100.0})
+    EXPECT_NEAR(ExpectedOutput(x), predictor->Predict(x), 1e-3) << x;
+}
+
+TEST(SvmPredictorTest, RepeatedPredictionsAreStable) {
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(kTestModel);
+  ASSERT_TRUE(predictor);
+  double first = predictor->Predict(2.0);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(first, predictor->Predict(2.0));
+}
+
+// One support vector at speed 1 and layer count 5.
+const char kContentModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.5\n"
+    "nr_class 2\n"
+    "total_sv 1\n"
+    "rho -30\n"
+    "SV\n"
+    "10 1:1 3:5\n";
+
+TEST(SvmPredictorTest, PredictReadsContentFeatures) {
+  std::unique_ptr<SvmPredictor> predictor =
+      SvmPredictor::Create(kContentModel);
+  ASSERT_TRUE(predictor);
+  EXPECT_EQ(MODEL_FEATURE_LAYER_COUNT + 1, predictor->num_features());
+
+  float features[MODEL_FEATURE_COUNT] = {};
+  features[MODEL_FEATURE_SPEED] = 1;
+  features[MODEL_FEATURE_LAYER_COUNT] = 5;
+  EXPECT_NEAR(40, predictor->Predict(features), 1e-3);
+  // Entropy is feature 2 of the model, even though no support vector sets it.
+  features[MODEL_FEATURE_PAGE_ENTROPY] = 2;
+  EXPECT_NEAR(10 * std::exp(-0.5 * 4) + 30, predictor->Predict(features),
+              1e-3);
+  // Features past the model's own are ignored.
+  features[MODEL_FEATURE_RASTER_COST] = 100;
+  EXPECT_NEAR(10 * std::exp(-0.5 * 4) + 30, predictor->Predict(features),
+              1e-3);
+}
+
+TEST(SvmPredictorTest, SingleFeatureModelIgnoresContentFeatures) {
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(kTestModel);
+  ASSERT_TRUE(predictor);
+  EXPECT_EQ(1, predictor->num_features());
+  float features[MODEL_FEATURE_COUNT] = {2, 0.5f, 12, 3};
+  EXPECT_NEAR(ExpectedOutput(2), predictor->Predict(features), 1e-3);
+}
+
+TEST(SvmPredictorTest, RejectsModelsWithUnknownFeatures) {
+  EXPECT_FALSE(SvmPredictor::Create(
+      "svm_type epsilon_svr\n"
+      "kernel_type rbf\n"
+      "gamma 0.5\n"
+      "nr_class 2\n"
+      "total_sv 1\n"
+      "rho -30\n"
+      "SV\n"
+      "10 1:1 5:2\n"));
+}
+
+TEST(SvmPredictorTest, PredictCachedReusesNearbySpeeds) {
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(kTestModel);
+  ASSERT_TRUE(predictor);
+  float features[MODEL_FEATURE_COUNT] = {2.0f};
+  double first = predictor->PredictCached(features);
+  EXPECT_NEAR(ExpectedOutput(2.0), first, 1e-2);
+  EXPECT_EQ(0, predictor->cache().hits());
+  EXPECT_EQ(1, predictor->cache().misses());
+
+  features[MODEL_FEATURE_SPEED] = 2.001f;
+  EXPECT_EQ(first, predictor->PredictCached(features));
+  EXPECT_EQ(1, predictor->cache().hits());
+
+  features[MODEL_FEATURE_SPEED] = 3.0f;
+  EXPECT_NEAR(ExpectedOutput(3.0), predictor->PredictCached(features), 1e-2);
+  EXPECT_EQ(2, predictor->cache().misses());
+}
+
+// A linear kernel has no dense form, so it is evaluated sparsely:
+// f(x) = 2 * (x1 + 3 * x2) - 2 * x1 + 30 = 6 * x2 + 30.
+const char kLinearModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type linear\n"
+    "nr_class 2\n"
+    "total_sv 2\n"
+    "rho -30\n"
+    "SV\n"
+    "2 1:1 2:3\n"
+    "-1 1:2\n";
+
+TEST(SvmPredictorTest, PredictBatchMatchesPredict) {
+  for (const char* model_str : {kTestModel, kLinearModel}) {
+    std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(model_str);
+    ASSERT_TRUE(predictor);
+    const int kCount = 300;
+    const int num_features = predictor->num_features();
+    std::vector<float> features(kCount * num_features);
+    for (size_t i = 0; i < features.size(); ++i)
+      features[i] = 0.05f * i;
+    std::vector<double> out(kCount);
+    predictor->PredictBatch(features.data(), kCount, out.data());
+    for (int i = 0; i < kCount; ++i) {
+      float row[MODEL_FEATURE_COUNT] = {};
+      for (int f = 0; f < num_features; ++f)
+        row[f] = features[i * num_features + f];
+      EXPECT_DOUBLE_EQ(predictor->Predict(row), out[i]) << i;
+    }
+  }
+  std::unique_ptr<SvmPredictor> linear = SvmPredictor::Create(kLinearModel);
+  EXPECT_FALSE(linear->uses_dense_model());
+  const float kFeatures[] = {4, 0.5f};
+  double out = 0;
+  linear->PredictBatch(kFeatures, 1, &out);
+  EXPECT_DOUBLE_EQ(33, out);
+}
+
+TEST(SvmPredictorTest, ParallelPredictBatchFillsEveryOutput) {
+  // The linear model goes through svm_predict_batch(), which gives each
+  // thread a chunk of at least 256 instances.
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(kLinearModel);
+  ASSERT_TRUE(predictor);
+  const int kThreads = 16;
+  const int kCount = kThreads * 256;
+  std::vector<float> features(kCount * 2, 0.f);
+  for (int i = 0; i < kCount; ++i)
+    features[i * 2 + 1] = i;
+  svm_set_predict_threads(kThreads);
+  for (int run = 0; run < 20; ++run) {
+    std::vector<double> out(kCount, -1);
+    predictor->PredictBatch(features.data(), kCount, out.data());
+    int wrong = 0;
+    for (int i = 0; i < kCount; ++i)
+      wrong += out[i] != 6.0 * i + 30;
+    EXPECT_EQ(0, wrong) << run;
+  }
+  svm_set_predict_threads(1);
+}
+
+// Two nearly coincident support vectors whose large coefficients cancel, so
+// that the output is a small difference the dense model's single precision
+// cannot resolve.
+const char kCancellingModel[] =
+    "svm_type epsilon_svr\n"
+    "kernel_type rbf\n"
+    "gamma 0.5\n"
+    "nr_class 2\n"
+    "total_sv 2\n"
+    "rho -30\n"
+    "SV\n"
+    "100000000 1:1\n"
+    "-100000000 1:1.001\n";
+
+TEST(SvmPredictorTest, DenseModelOnlyWhereItMatches) {
+  std::unique_ptr<SvmPredictor> predictor = SvmPredictor::Create(kTestModel);
+  ASSERT_TRUE(predictor);
+  EXPECT_TRUE(predictor->uses_dense_model());
+  std::vector<uint8_t> binary;
+  EXPECT_TRUE(predictor->SerializeToBinary(&binary));
+
+  predictor = SvmPredictor::Create(kCancellingModel);
+  ASSERT_TRUE(predictor);
+  EXPECT_FALSE(predictor->uses_dense_model());
+  EXPECT_FALSE(predictor->SerializeToBinary(&binary));
+  // At speed 2 the support vectors are 1 and 0.999 away.
+  double expected =
+      1e8 * (std::exp(-0.5) - std::exp(-0.5 * 0.999 * 0.999)) + 30;
+  EXPECT_NEAR(expected, predictor->Predict(2.0), 1e-6);
+}
+
+TEST(SvmPredictorTest, ClampPredictedFrameRate) {
+  EXPECT_EQ(24, ClampPredictedFrameRate(-3));
+  EXPECT_EQ(24, ClampPredictedFrameRate(8.5));
+  EXPECT_EQ(10, ClampPredictedFrameRate(9.5));
+  EXPECT_EQ(31, ClampPredictedFrameRate(30.2));
+  EXPECT_EQ(60, ClampPredictedFrameRate(75));
+}
+
+}  // namespace
+}  // namespace ui
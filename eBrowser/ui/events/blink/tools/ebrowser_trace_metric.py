@@ -0,0 +1,135 @@
+#!/usr/bin/env python
+# Copyright 2017 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Aggregates the "ebrowser" trace metadata block across traces.
+
+Every trace the browser records carries the input rate measurements of the
+gestures it covers under metadata["ebrowser"], as written by
+content::InputRateTraceMetadata. This groups traces by build, device and rate
+policy and prints, for each group, the presented against the target frame
+rate, the estimated energy against the full rate, and the scroll latency
+percentiles, so that builds and devices can be compared from traces alone.
+
+  ebrowser_trace_metric.py [--json] trace.json [trace.json.gz ...]
+"""
+
+import argparse
+import gzip
+import json
+import sys
+
+
+def load_metadata(path):
+  opener = gzip.open if path.endswith('.gz') else open
+  with opener(path, 'rb') as f:
+    trace = json.loads(f.read().decode('utf-8'))
+  # Traces saved as a bare event array have no metadata.
+  if not isinstance(trace, dict):
+    return None
+  return trace.get('metadata')
+
+
+def mean(values):
+  return sum(values) / float(len(values)) if values else 0.0
+
+
+class Group(object):
+  def __init__(self):
+    self.traces = 0
+    self.models = set()
+    self.gestures = []
+    self.dropped_gestures = 0
+    self.latency = []
+
+  def add(self, block):
+    self.traces += 1
+    for model in block.get('models', []):
+      self.models.add((model.get('type'), model.get('origin'),
+                       model.get('version')))
+    self.gestures.extend(block.get('gestures', []))
+    self.dropped_gestures += block.get('dropped_gestures', 0)
+    latency = block.get('scroll_latency', {})
+    if latency.get('count'):
+      self.latency.append(latency)
+
+  def summary(self):
+    gestures = self.gestures
+    result = {
+        'traces': self.traces,
+        'models': sorted('%s/%s@%s' % model for model in self.models),
+        'gestures': len(gestures),
+        'dropped_gestures': self.dropped_gestures,
+        'mean_target_fps': mean([g['target_fps'] for g in gestures]),
+        'mean_presented_fps': mean([g['presented_fps'] for g in gestures]),
+    }
+    with_energy = [g for g in gestures if 'energy_mj' in g]
+    if with_energy:
+      energy = sum(g['energy_mj'] for g in with_energy)
+      full_rate_energy = sum(g['full_rate_energy_mj'] for g in with_energy)
+      result['energy_mj'] = energy
+      result['full_rate_energy_mj'] = full_rate_energy
+      if full_rate_energy:
+        result['energy_saved'] = 1 - energy / full_rate_energy
+    # Percentiles cannot be merged exactly, so each trace's is weighted by
+    # its sample count.
+    count = sum(l['count'] for l in self.latency)
+    result['latency_count'] = count
+    for key in ('p50_ms', 'p95_ms', 'p99_ms'):
+      if count:
+        result[key] = sum(l[key] * l['count'] for l in self.latency) / count
+    return result
+
+
+def main(argv):
+  parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+  parser.add_argument('--json', action='store_true',
+                      help='print the groups as JSON')
+  parser.add_argument('traces', nargs='+')
+  args = parser.parse_args(argv)
+
+  groups = {}
+  for path in args.traces:
+    metadata = load_metadata(path)
+    block = metadata and metadata.get('ebrowser')
+    if not block:
+      sys.stderr.write('%s: no ebrowser metadata\n' % path)
+      continue
+    key = (metadata.get('product-version', ''),
+           '%s %s' % (metadata.get('cpu-brand', ''),
+                      metadata.get('os-version', '')),
+           block.get('rate_policy', ''),
+           block.get('gesture_rate_policies', ''))
+    groups.setdefault(key, Group()).add(block)
+
+  results = []
+  for key in sorted(groups):
+    result = groups[key].summary()
+    result.update(zip(('build', 'device', 'rate_policy',
+                       'gesture_rate_policies'), key))
+    results.append(result)
+
+  if args.json:
+    print(json.dumps(results, indent=2, sort_keys=True))
+    return 0
+  for result in results:
+    print('%(build)s on %(device)s, %(rate_policy)s %(gesture_rate_policies)s'
+          % result)
+    print('  %(traces)d traces, %(gestures)d gestures '
+          '(%(dropped_gestures)d dropped)' % result)
+    print('  models: %s' % (', '.join(result['models']) or 'none'))
+    print('  fps: %.1f presented, %.1f target' %
+          (result['mean_presented_fps'], result['mean_target_fps']))
+    if 'energy_mj' in result:
+      print('  energy: %.0f mJ, %.0f mJ at the full rate' %
+            (result['energy_mj'], result['full_rate_energy_mj']))
+    if result['latency_count']:
+      print('  scroll latency: p50 %.1f ms, p95 %.1f ms, p99 %.1f ms '
+            '(%d samples)' % (result['p50_ms'], result['p95_ms'],
+                              result['p99_ms'], result['latency_count']))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))
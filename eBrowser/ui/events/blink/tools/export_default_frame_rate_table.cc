@@ -0,0 +1,116 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Turns a scroll table compiled by the cloud trainer, in the
+// FrameRateTable::CreateFromString() format, into the
+// ui/events/blink/default_frame_rate_table.h header that paces scrolls before
+// a device has a model of its own. The header is written to stdout.
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "ui/events/blink/frame_rate_table.h"
+
+namespace ui {
+namespace {
+
+const size_t kRatesPerLine = 13;
+
+const char kHeaderTemplate[] =
+    "// Copyright 2017 The Chromium Authors. All rights reserved.\n"
+    "// Use of this source code is governed by a BSD-style license that can"
+    " be\n"
+    "// found in the LICENSE file.\n"
+    "\n"
+    "// Generated by ui/events/blink/tools/export_default_frame_rate_table"
+    " from the\n"
+    "// cloud trainer's population scroll table"
+    " (/model/table?device=population).\n"
+    "// Do not edit; regenerate with\n"
+    "//\n"
+    "//   export_default_frame_rate_table population_table.txt \\\n"
+    "//       > ui/events/blink/default_frame_rate_table.h\n"
+    "\n"
+    "#ifndef UI_EVENTS_BLINK_DEFAULT_FRAME_RATE_TABLE_H_\n"
+    "#define UI_EVENTS_BLINK_DEFAULT_FRAME_RATE_TABLE_H_\n"
+    "\n"
+    "#include <stdint.h>\n"
+    "\n"
+    "namespace ui {\n"
+    "namespace default_frame_rate_table {\n"
+    "\n";
+
+const char kFooter[] =
+    "};\n"
+    "\n"
+    "}  // namespace default_frame_rate_table\n"
+    "}  // namespace ui\n"
+    "\n"
+    "#endif  // UI_EVENTS_BLINK_DEFAULT_FRAME_RATE_TABLE_H_\n";
+
+// The version line is only for the server's caching, so the parser skips it.
+std::string GetVersion(const std::string& table_str) {
+  for (const base::StringPiece& line : base::SplitStringPiece(
+           table_str, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (base::StartsWith(line, "version ", base::CompareCase::SENSITIVE))
+      return line.substr(8).as_string();
+  }
+  return "unknown";
+}
+
+void PrintHeader(const FrameRateTable& table, const std::string& version) {
+  printf("%s", kHeaderTemplate);
+  printf("constexpr char kVersion[] = \"%s\";\n", version.c_str());
+  printf("// Speed units per bucket, in physical pixels per second.\n");
+  printf("constexpr double kStep = %g;\n", table.step());
+  printf("constexpr int kMaxError = %d;\n", table.max_error());
+  printf("constexpr uint8_t kFrameRates[] = {\n");
+  for (size_t i = 0; i < table.size(); ++i) {
+    if (i % kRatesPerLine == 0)
+      printf("   ");
+    printf(" %d,", table.Lookup(i * table.step()));
+    if (i % kRatesPerLine == kRatesPerLine - 1 || i + 1 == table.size())
+      printf("\n");
+  }
+  printf("%s", kFooter);
+}
+
+}  // namespace
+}  // namespace ui
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit_manager;
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine::StringVector& args =
+      base::CommandLine::ForCurrentProcess()->GetArgs();
+  if (args.size() != 1) {
+    fprintf(stderr, "Usage: %s <frame_rate_table.txt>\n", argv[0]);
+    return 1;
+  }
+  std::string table_str;
+  if (!base::ReadFileToString(base::FilePath(args[0]), &table_str)) {
+    fprintf(stderr, "Cannot read %s\n",
+            base::FilePath(args[0]).AsUTF8Unsafe().c_str());
+    return 1;
+  }
+  std::unique_ptr<ui::FrameRateTable> table =
+      ui::FrameRateTable::CreateFromString(table_str);
+  if (!table) {
+    fprintf(stderr, "Not a frame rate table\n");
+    return 1;
+  }
+  ui::PrintHeader(*table, ui::GetVersion(table_str));
+  return 0;
+}
@@ -0,0 +1,570 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays recorded scroll gestures through an InputRateController policy
+// offline, and reports for each trace the frames the policy would have
+// produced, an energy estimate and the smoothness of the result, next to the
+// same gestures run at the full frame rate. The per-event logic is the one
+// InputHandlerProxy uses: ScrollVelocityEstimator for the speed feature, the
+// policy and model for the rate, FrameRateGovernor to smooth it, and
+// ScrollUpdatePacer::IsFrameDue() to decide which vsyncs produce a frame.
+//
+// Traces are either touch logs written by TouchEventLogEvdev::DumpLog()
+// (multitouch devices; the first contact of each touch is replayed) or JSON:
+//
+//   {"gestures": [{"begin": 12.5,
+//                  "updates": [[12.508, 0, -4.5], [12.516, 0, -6], ...]}]}
+//
+// where each update is [time in seconds, delta x, delta y] in physical
+// pixels, and "begin" defaults to the time of the first update. Files ending
+// in .json are read as JSON. Traces are replayed in parallel, one worker
+// thread per core unless --jobs says otherwise, and the report is written to
+// stdout as JSON in the order the traces were given.
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/ptr_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/sys_info.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "ui/events/blink/frame_rate_governor.h"
+#include "ui/events/blink/frame_rate_table.h"
+#include "ui/events/blink/input_model.h"
+#include "ui/events/blink/input_rate_controller.h"
+#include "ui/events/blink/scroll_update_pacer.h"
+#include "ui/events/blink/scroll_velocity_estimator.h"
+#include "ui/events/blink/speed_feature.h"
+#include "ui/events/blink/svm_predictor.h"
+
+namespace ui {
+namespace {
+
+const char kPolicySwitch[] = "policy";
+const char kModelSwitch[] = "model";
+const char kTableStepSwitch[] = "table-step";
+const char kFeatureScaleSwitch[] = "feature-scale";
+const char kPhysicalDpiSwitch[] = "physical-dpi";
+const char kEvdevPixelsPerUnitSwitch[] = "evdev-pixels-per-unit";
+const char kFrameEnergySwitch[] = "frame-energy-mj";
+const char kIdlePowerSwitch[] = "idle-power-mw";
+const char kJobsSwitch[] = "jobs";
+
+// Energy model defaults, to be calibrated per device: the cost of producing
+// one frame, and the power drawn regardless of frames during a gesture.
+const double kDefaultFrameEnergyMillijoules = 4;
+const double kDefaultIdlePowerMilliwatts = 0;
+
+// Linux input event codes used by the evdev touch logs.
+const unsigned kEvSyn = 0x00;
+const unsigned kEvAbs = 0x03;
+const unsigned kSynReport = 0x00;
+const unsigned kAbsMtPositionX = 0x35;
+const unsigned kAbsMtPositionY = 0x36;
+const unsigned kAbsMtTrackingId = 0x39;
+
+struct ScrollSample {
+  double time_seconds;
+  float delta_x;
+  float delta_y;
+};
+
+struct RecordedGesture {
+  double begin_seconds = 0;
+  std::vector<ScrollSample> updates;
+};
+
+struct ReplayOptions {
+  InputRatePolicy policy = INPUT_RATE_POLICY_SVR_SLEEP;
+  std::string policy_name = "svr-sleep";
+  std::string model_text;
+  double table_step = 0;
+  double feature_scale = 1;
+  // Of the panel the traces were recorded on, 0 for the reference panel.
+  double physical_dpi = 0;
+  double evdev_pixels_per_unit = 1;
+  double frame_energy_millijoules = kDefaultFrameEnergyMillijoules;
+  double idle_power_milliwatts = kDefaultIdlePowerMilliwatts;
+};
+
+// Frames produced for a set of gestures, and the intervals between them
+// within each gesture.
+struct ReplayStats {
+  int frames = 0;
+  double duration_seconds = 0;
+  int intervals = 0;
+  double interval_sum_ms = 0;
+  double interval_square_sum_ms = 0;
+  double max_interval_ms = 0;
+  // From the oldest update presented in a frame to the frame.
+  double input_delay_sum_ms = 0;
+};
+
+struct TraceResult {
+  std::string error;
+  int gestures = 0;
+  int updates = 0;
+  ReplayStats policy;
+  ReplayStats full_rate;
+};
+
+// The scroll model of the replay, in the slots InputHandlerProxy would hold
+// it in. The other model features are not recorded and read as zero.
+class ReplayModels : public InputRateController::Models {
+ public:
+  explicit ReplayModels(std::unique_ptr<InputModel> model)
+      : model_(std::move(model)) {}
+  ~ReplayModels() override {}
+
+  // InputRateController::Models:
+  bool EvaluateModel(InputModelType type,
+                     double speed,
+                     int* fps) const override {
+    if (type != INPUT_MODEL_SCROLL || !model_ || !model_->predictor)
+      return false;
+    float features[MODEL_FEATURE_COUNT] = {};
+    features[MODEL_FEATURE_SPEED] = static_cast<float>(speed);
+    *fps = ClampPredictedFrameRate(model_->predictor->Predict(features));
+    return true;
+  }
+  bool LookupFrameRateTable(double speed, int* fps) const override {
+    if (!model_ || !model_->frame_rate_table)
+      return false;
+    *fps = model_->frame_rate_table->Lookup(speed);
+    return true;
+  }
+  // Frame energy is --frame-energy-mj's flat cost, so the energy-budget
+  // policy replays as svr-sleep.
+  const EnergyCurve* GetEnergyCurve() const override { return nullptr; }
+
+ private:
+  std::unique_ptr<InputModel> model_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReplayModels);
+};
+
+bool ParseEvdevLog(const std::string& contents,
+                   double pixels_per_unit,
+                   std::vector<RecordedGesture>* gestures) {
+  int active_slot = -1;
+  bool has_position = false;
+  bool position_changed = false;
+  bool has_last_position = false;
+  int x = 0;
+  int y = 0;
+  int last_x = 0;
+  int last_y = 0;
+  RecordedGesture gesture;
+
+  for (const std::string& line : base::SplitString(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (line[0] == '#')
+      continue;
+    long sec = 0;
+    long usec = 0;
+    unsigned type = 0;
+    unsigned code = 0;
+    int value = 0;
+    int slot = 0;
+    if (sscanf(line.c_str(), "E: %ld.%ld %x %x %d %d", &sec, &usec, &type,
+               &code, &value, &slot) != 6) {
+      LOG(ERROR) << "Unrecognized touch log line: " << line;
+      return false;
+    }
+
+    if (type == kEvAbs && code == kAbsMtTrackingId) {
+      if (value >= 0 && active_slot < 0) {
+        active_slot = slot;
+        has_position = has_last_position = position_changed = false;
+        gesture = RecordedGesture();
+      } else if (value < 0 && slot == active_slot) {
+        if (!gesture.updates.empty())
+          gestures->push_back(std::move(gesture));
+        active_slot = -1;
+      }
+    } else if (type == kEvAbs && slot == active_slot &&
+               (code == kAbsMtPositionX || code == kAbsMtPositionY)) {
+      if (code == kAbsMtPositionX)
+        x = value;
+      else
+        y = value;
+      has_position = position_changed = true;
+    } else if (type == kEvSyn && code == kSynReport && active_slot >= 0 &&
+               has_position && position_changed) {
+      double time_seconds = sec + usec / 1e6;
+      if (!has_last_position) {
+        gesture.begin_seconds = time_seconds;
+        has_last_position = true;
+      } else {
+        ScrollSample sample = {
+            time_seconds, static_cast<float>((x - last_x) * pixels_per_unit),
+            static_cast<float>((y - last_y) * pixels_per_unit)};
+        gesture.updates.push_back(sample);
+      }
+      last_x = x;
+      last_y = y;
+      position_changed = false;
+    }
+  }
+  // A log can end mid-touch.
+  if (active_slot >= 0 && !gesture.updates.empty())
+    gestures->push_back(std::move(gesture));
+  return true;
+}
+
+bool ParseJsonTrace(const std::string& contents,
+                    std::vector<RecordedGesture>* gestures) {
+  std::unique_ptr<base::Value> value = base::JSONReader::Read(contents);
+  const base::DictionaryValue* root = nullptr;
+  const base::ListValue* gesture_list = nullptr;
+  if (!value || !value->GetAsDictionary(&root) ||
+      !root->GetList("gestures", &gesture_list)) {
+    LOG(ERROR) << "Expected a JSON object with a \"gestures\" list.";
+    return false;
+  }
+
+  for (size_t i = 0; i < gesture_list->GetSize(); ++i) {
+    const base::DictionaryValue* gesture_value = nullptr;
+    const base::ListValue* update_list = nullptr;
+    if (!gesture_list->GetDictionary(i, &gesture_value) ||
+        !gesture_value->GetList("updates", &update_list)) {
+      LOG(ERROR) << "Gesture " << i << " has no \"updates\" list.";
+      return false;
+    }
+    RecordedGesture gesture;
+    for (size_t j = 0; j < update_list->GetSize(); ++j) {
+      const base::ListValue* update = nullptr;
+      double time_seconds;
+      double delta_x;
+      double delta_y;
+      if (!update_list->GetList(j, &update) || update->GetSize() != 3 ||
+          !update->GetDouble(0, &time_seconds) ||
+          !update->GetDouble(1, &delta_x) || !update->GetDouble(2, &delta_y)) {
+        LOG(ERROR) << "Update " << j << " of gesture " << i
+                   << " is not [time, delta x, delta y].";
+        return false;
+      }
+      if (!gesture.updates.empty() &&
+          time_seconds < gesture.updates.back().time_seconds) {
+        LOG(ERROR) << "Updates of gesture " << i << " are out of order.";
+        return false;
+      }
+      ScrollSample sample = {time_seconds, static_cast<float>(delta_x),
+                             static_cast<float>(delta_y)};
+      gesture.updates.push_back(sample);
+    }
+    if (gesture.updates.empty())
+      continue;
+    if (!gesture_value->GetDouble("begin", &gesture.begin_seconds))
+      gesture.begin_seconds = gesture.updates.front().time_seconds;
+    gestures->push_back(std::move(gesture));
+  }
+  return true;
+}
+
+base::TimeTicks ToTimeTicks(double seconds) {
+  return base::TimeTicks() + base::TimeDelta::FromSecondsD(seconds);
+}
+
+// Runs |gesture| against a display that produces a frame on each vsync that
+// has new scroll input and is due at the paced rate, as InputHandlerProxy and
+// the BeginFrame decimation downstream of it would.
+void ReplayGesture(const RecordedGesture& gesture,
+                   const InputRateController& controller,
+                   const InputRateController::Models& models,
+                   double feature_scale,
+                   const SpeedFeature& speed_feature,
+                   ReplayStats* stats) {
+  const double vsync_interval_seconds = 1. / ScrollUpdatePacer::kMaxFrameRate;
+  ScrollVelocityEstimator velocity_estimator;
+  FrameRateGovernor frame_rate_governor;
+  velocity_estimator.AddDelta(gesture.begin_seconds, 0);
+
+  int gesture_speed = 0;
+  int fps = ScrollUpdatePacer::kMaxFrameRate;
+  size_t next_update = 0;
+  bool has_unpresented_input = false;
+  double oldest_unpresented_seconds = 0;
+  base::TimeTicks last_frame_time;
+  double frame_seconds = gesture.begin_seconds;
+
+  int vsync = 0;
+  while (next_update < gesture.updates.size() || has_unpresented_input) {
+    frame_seconds = gesture.begin_seconds + ++vsync * vsync_interval_seconds;
+    for (; next_update < gesture.updates.size() &&
+           gesture.updates[next_update].time_seconds <= frame_seconds;
+         ++next_update) {
+      const ScrollSample& update = gesture.updates[next_update];
+      velocity_estimator.AddDelta(update.time_seconds, update.delta_y);
+      float velocity;
+      if (velocity_estimator.GetVelocity(&velocity))
+        gesture_speed = static_cast<int>(std::abs(velocity) * feature_scale);
+      int predicted_fps = controller.GestureFrameRate(
+          models, INPUT_GESTURE_SCROLL,
+          speed_feature.FromPhysicalPixelsPerSecond(gesture_speed),
+          PageActivity());
+      fps = frame_rate_governor.Update(update.time_seconds, predicted_fps);
+      if (!has_unpresented_input) {
+        has_unpresented_input = true;
+        oldest_unpresented_seconds = update.time_seconds;
+      }
+    }
+
+    base::TimeTicks frame_time = ToTimeTicks(frame_seconds);
+    if (!has_unpresented_input ||
+        !ScrollUpdatePacer::IsFrameDue(last_frame_time, frame_time, fps)) {
+      continue;
+    }
+    stats->frames++;
+    stats->input_delay_sum_ms +=
+        (frame_seconds - oldest_unpresented_seconds) * 1000;
+    if (!last_frame_time.is_null()) {
+      double interval_ms = (frame_time - last_frame_time).InMillisecondsF();
+      stats->intervals++;
+      stats->interval_sum_ms += interval_ms;
+      stats->interval_square_sum_ms += interval_ms * interval_ms;
+      stats->max_interval_ms = std::max(stats->max_interval_ms, interval_ms);
+    }
+    last_frame_time = frame_time;
+    has_unpresented_input = false;
+  }
+  stats->duration_seconds += frame_seconds - gesture.begin_seconds;
+}
+
+void ReplayTrace(const ReplayOptions* options,
+                 const base::FilePath& path,
+                 TraceResult* result) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents)) {
+    result->error = "unreadable";
+    return;
+  }
+  std::vector<RecordedGesture> gestures;
+  bool parsed = path.MatchesExtension(FILE_PATH_LITERAL(".json"))
+                    ? ParseJsonTrace(contents, &gestures)
+                    : ParseEvdevLog(contents, options->evdev_pixels_per_unit,
+                                    &gestures);
+  if (!parsed) {
+    result->error = "unparseable";
+    return;
+  }
+
+  // Each trace gets its own models; SvmPredictor is not shared across
+  // threads.
+  std::unique_ptr<InputModel> model;
+  if (!options->model_text.empty()) {
+    model = InputModel::CreateFromString(
+        INPUT_MODEL_SCROLL, options->model_text, options->table_step);
+  }
+  ReplayModels models(std::move(model));
+  std::unique_ptr<InputRateController> controller =
+      InputRateController::Create(options->policy);
+  std::unique_ptr<InputRateController> full_rate_controller =
+      InputRateController::Create(INPUT_RATE_POLICY_NONE);
+
+  // The replay runs at the full frame rate's refresh rate.
+  SpeedFeature speed_feature(static_cast<float>(options->physical_dpi),
+                             ScrollUpdatePacer::kMaxFrameRate);
+  for (const RecordedGesture& gesture : gestures) {
+    result->gestures++;
+    result->updates += gesture.updates.size();
+    ReplayGesture(gesture, *controller, models, options->feature_scale,
+                  speed_feature, &result->policy);
+    ReplayGesture(gesture, *full_rate_controller, models,
+                  options->feature_scale, speed_feature, &result->full_rate);
+  }
+}
+
+std::unique_ptr<base::DictionaryValue> StatsToValue(
+    const ReplayOptions& options,
+    const ReplayStats& stats) {
+  std::unique_ptr<base::DictionaryValue> value(new base::DictionaryValue);
+  value->SetInteger("frames", stats.frames);
+  value->SetDouble("energy_mj",
+                   stats.frames * options.frame_energy_millijoules +
+                       stats.duration_seconds * options.idle_power_milliwatts);
+  if (stats.frames) {
+    value->SetDouble("mean_input_delay_ms",
+                     stats.input_delay_sum_ms / stats.frames);
+  }
+  if (stats.intervals) {
+    double mean_interval_ms = stats.interval_sum_ms / stats.intervals;
+    value->SetDouble("presented_fps", 1000 / mean_interval_ms);
+    value->SetDouble(
+        "frame_interval_variance_ms2",
+        std::max(0.0, stats.interval_square_sum_ms / stats.intervals -
+                          mean_interval_ms * mean_interval_ms));
+    value->SetDouble("max_frame_gap_ms", stats.max_interval_ms);
+  }
+  return value;
+}
+
+bool ParseOptions(const base::CommandLine& command_line,
+                  ReplayOptions* options) {
+  if (command_line.HasSwitch(kPolicySwitch)) {
+    options->policy_name = command_line.GetSwitchValueASCII(kPolicySwitch);
+    if (!InputRateController::ParsePolicy(options->policy_name,
+                                          &options->policy)) {
+      LOG(ERROR) << "Unknown policy: " << options->policy_name;
+      return false;
+    }
+  }
+  if (command_line.HasSwitch(kModelSwitch)) {
+    base::FilePath model_path = command_line.GetSwitchValuePath(kModelSwitch);
+    if (!base::ReadFileToString(model_path, &options->model_text)) {
+      LOG(ERROR) << "Cannot read model " << model_path.value();
+      return false;
+    }
+    if (InputModel::IsBinary(options->model_text.data(),
+                             options->model_text.size())) {
+      LOG(ERROR) << "Compiled models are not supported, pass the text model.";
+      return false;
+    }
+  }
+
+  struct {
+    const char* name;
+    double* value;
+  } double_switches[] = {
+      {kTableStepSwitch, &options->table_step},
+      {kFeatureScaleSwitch, &options->feature_scale},
+      {kPhysicalDpiSwitch, &options->physical_dpi},
+      {kEvdevPixelsPerUnitSwitch, &options->evdev_pixels_per_unit},
+      {kFrameEnergySwitch, &options->frame_energy_millijoules},
+      {kIdlePowerSwitch, &options->idle_power_milliwatts},
+  };
+  for (const auto& double_switch : double_switches) {
+    if (command_line.HasSwitch(double_switch.name) &&
+        !base::StringToDouble(
+            command_line.GetSwitchValueASCII(double_switch.name),
+            double_switch.value)) {
+      LOG(ERROR) << "--" << double_switch.name << " needs a number.";
+      return false;
+    }
+  }
+  return true;
+}
+
+void PrintUsage(const char* program) {
+  std::cout
+      << "Replays recorded scroll gestures through an input rate policy.\n"
+      << "\n"
+      << "Usage: " << program << " [options] <trace> [trace2...]\n"
+      << "  --policy=NAME           none, svr-sleep (default), begin-frame,\n"
+      << "                          table or energy-budget, as in the\n"
+      << "                          renderer's switch\n"
+      << "  --model=FILE            text scroll model or frame rate table\n"
+      << "  --table-step=N          compile the model to a table of this step\n"
+      << "  --feature-scale=F       as InputHandlerProxy's feature scale\n"
+      << "  --physical-dpi=F        pixels per inch of the recording panel\n"
+      << "  --evdev-pixels-per-unit=F  touch log units to physical pixels\n"
+      << "  --frame-energy-mj=F     energy per frame (default "
+      << kDefaultFrameEnergyMillijoules << ")\n"
+      << "  --idle-power-mw=F       power drawn during gestures (default "
+      << kDefaultIdlePowerMilliwatts << ")\n"
+      << "  --jobs=N                worker threads (default: one per core)\n";
+}
+
+}  // namespace
+}  // namespace ui
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit_manager;
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  ui::ReplayOptions options;
+  const base::CommandLine::StringVector& traces = command_line.GetArgs();
+  if (traces.empty() || !ui::ParseOptions(command_line, &options)) {
+    ui::PrintUsage(argv[0]);
+    return 1;
+  }
+
+  int jobs = base::SysInfo::NumberOfProcessors();
+  if (command_line.HasSwitch(ui::kJobsSwitch) &&
+      (!base::StringToInt(command_line.GetSwitchValueASCII(ui::kJobsSwitch),
+                          &jobs) ||
+       jobs < 1)) {
+    ui::PrintUsage(argv[0]);
+    return 1;
+  }
+  jobs = static_cast<int>(std::min(static_cast<size_t>(jobs), traces.size()));
+
+  std::vector<ui::TraceResult> results(traces.size());
+  {
+    std::vector<std::unique_ptr<base::Thread>> workers;
+    for (int i = 0; i < jobs; ++i) {
+      workers.push_back(base::MakeUnique<base::Thread>(
+          "ReplayWorker" + base::IntToString(i)));
+      CHECK(workers.back()->Start());
+    }
+    for (size_t i = 0; i < traces.size(); ++i) {
+      workers[i % jobs]->task_runner()->PostTask(
+          FROM_HERE,
+          base::Bind(&ui::ReplayTrace, base::Unretained(&options),
+                     base::FilePath(traces[i]), base::Unretained(&results[i])));
+    }
+    // Stopping a worker runs the traces already posted to it first.
+  }
+
+  std::unique_ptr<base::ListValue> trace_list(new base::ListValue);
+  ui::ReplayStats policy_total;
+  ui::ReplayStats full_rate_total;
+  for (size_t i = 0; i < traces.size(); ++i) {
+    const ui::TraceResult& result = results[i];
+    std::unique_ptr<base::DictionaryValue> trace(new base::DictionaryValue);
+    trace->SetString("path", base::FilePath(traces[i]).AsUTF8Unsafe());
+    if (!result.error.empty()) {
+      trace->SetString("error", result.error);
+      trace_list->Append(std::move(trace));
+      continue;
+    }
+    trace->SetInteger("gestures", result.gestures);
+    trace->SetInteger("updates", result.updates);
+    trace->SetDouble("duration_ms", result.full_rate.duration_seconds * 1000);
+    trace->Set(options.policy_name, ui::StatsToValue(options, result.policy));
+    trace->Set("full_rate", ui::StatsToValue(options, result.full_rate));
+    trace_list->Append(std::move(trace));
+
+    policy_total.frames += result.policy.frames;
+    policy_total.duration_seconds += result.policy.duration_seconds;
+    full_rate_total.frames += result.full_rate.frames;
+    full_rate_total.duration_seconds += result.full_rate.duration_seconds;
+  }
+
+  base::DictionaryValue report;
+  report.SetString("policy", options.policy_name);
+  report.Set("traces", std::move(trace_list));
+  std::unique_ptr<base::DictionaryValue> totals(new base::DictionaryValue);
+  totals->Set("policy", ui::StatsToValue(options, policy_total));
+  totals->Set("full_rate", ui::StatsToValue(options, full_rate_total));
+  report.Set("totals", std::move(totals));
+
+  std::string json;
+  base::JSONWriter::WriteWithOptions(
+      report, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+  std::cout << json;
+  return 0;
+}
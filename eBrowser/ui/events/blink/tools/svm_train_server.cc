@@ -0,0 +1,354 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Trains epsilon-SVR models for the model server over HTTP, with the libsvm
+// the browser ships, so that a device's retraining does not go through the
+// JVM's libsvm port. The model server's IncrementalTrainer posts
+//
+//   POST /train?C=<C>&gamma=<gamma>&p=<epsilon>[&eps=<tolerance>]
+//        [&shrinking=<0|1>][&cache_mb=<kernel cache>]
+//
+// with one sample per line, "<label> <initial coef> <index>:<value> ...". The
+// initial coefficients are the warm start, alpha_i - alpha_i* of the previous
+// solution or 0, and must be feasible. The response is "rho <rho>" followed by
+// the coefficient of each sample, one per line, from which the model server
+// builds the svm_model exactly as its own WarmStartSvr does.
+//
+// Jobs run on --jobs worker threads, by default one per core, next to the
+// HTTP thread. Each job's kernel cache is clamped so that the job stays
+// within --max-job-mb; a problem that does not fit even with the smallest
+// cache is refused with 413.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/task_runner_util.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "net/base/net_errors.h"
+#include "net/base/url_util.h"
+#include "net/http/http_status_code.h"
+#include "net/log/net_log_source.h"
+#include "net/server/http_server.h"
+#include "net/server/http_server_request_info.h"
+#include "net/socket/tcp_server_socket.h"
+#include "ui/events/blink/svm.h"
+#include "url/gurl.h"
+
+namespace ui {
+namespace {
+
+const char kAddressSwitch[] = "address";
+const char kPortSwitch[] = "port";
+const char kJobsSwitch[] = "jobs";
+const char kMaxJobMbSwitch[] = "max-job-mb";
+
+const char kDefaultAddress[] = "127.0.0.1";
+const int kDefaultPort = 9420;
+const int kDefaultMaxJobMb = 256;
+const int kBackLog = 16;
+const char kTextContentType[] = "text/plain; charset=utf-8";
+
+// The solver's own arrays, per sample: SVR doubles the problem to 2l
+// variables, each with an alpha, a gradient, a G_bar, a linear term, a
+// diagonal entry, a sign, an index, a status, and two column buffers of
+// floats.
+const size_t kSolverBytesPerSample = 2 * (5 * sizeof(double) + 4 * 4 + 2 * 4);
+
+void QuietPrint(const char*) {}
+
+struct TrainingJob {
+  std::vector<svm_node> nodes;
+  std::vector<svm_node*> x;
+  std::vector<double> y;
+  std::vector<double> coefs;
+  svm_parameter param;
+};
+
+struct TrainingResult {
+  bool trained = false;
+  double rho = 0;
+  std::vector<double> coefs;
+  base::TimeDelta time;
+};
+
+bool GetDoubleParam(const GURL& url, const std::string& name, double* value) {
+  std::string string_value;
+  return net::GetValueForKeyInQuery(url, name, &string_value) &&
+         base::StringToDouble(string_value, value);
+}
+
+// Parses the request into |job|; returns an error message on failure.
+std::string ParseJob(const net::HttpServerRequestInfo& info,
+                     TrainingJob* job) {
+  GURL url("http://localhost" + info.path);
+  memset(&job->param, 0, sizeof(job->param));
+  job->param.svm_type = EPSILON_SVR;
+  job->param.kernel_type = RBF;
+  job->param.eps = 0.001;
+  job->param.shrinking = 1;
+  job->param.cache_size = 100;
+  if (!GetDoubleParam(url, "C", &job->param.C) ||
+      !GetDoubleParam(url, "gamma", &job->param.gamma) ||
+      !GetDoubleParam(url, "p", &job->param.p)) {
+    return "C, gamma and p are required";
+  }
+  GetDoubleParam(url, "eps", &job->param.eps);
+  GetDoubleParam(url, "cache_mb", &job->param.cache_size);
+  double shrinking = 1;
+  if (GetDoubleParam(url, "shrinking", &shrinking))
+    job->param.shrinking = shrinking != 0;
+
+  std::vector<base::StringPiece> lines = base::SplitStringPiece(
+      info.data, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  // Indices into |nodes| until it stops growing.
+  std::vector<size_t> starts;
+  for (const base::StringPiece& line : lines) {
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        line, " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    double label = 0;
+    double coef = 0;
+    if (fields.size() < 2 || !base::StringToDouble(fields[0], &label) ||
+        !base::StringToDouble(fields[1], &coef)) {
+      return "bad sample: " + line.as_string();
+    }
+    starts.push_back(job->nodes.size());
+    for (size_t i = 2; i < fields.size(); ++i) {
+      size_t colon = fields[i].find(':');
+      svm_node node;
+      if (colon == base::StringPiece::npos ||
+          !base::StringToInt(fields[i].substr(0, colon), &node.index) ||
+          !base::StringToDouble(fields[i].substr(colon + 1), &node.value)) {
+        return "bad sample: " + line.as_string();
+      }
+      job->nodes.push_back(node);
+    }
+    svm_node end;
+    end.index = -1;
+    end.value = 0;
+    job->nodes.push_back(end);
+    job->y.push_back(label);
+    job->coefs.push_back(coef);
+  }
+  if (job->y.empty())
+    return "no samples";
+  for (size_t start : starts)
+    job->x.push_back(&job->nodes[start]);
+  return std::string();
+}
+
+// Clamps the kernel cache of |job| to what |max_job_bytes| leaves, or returns
+// false if the problem does not fit even with the two columns libsvm needs.
+bool FitJob(size_t max_job_bytes, TrainingJob* job) {
+  size_t l = job->y.size();
+  size_t fixed_bytes = job->nodes.size() * sizeof(svm_node) +
+                       l * (sizeof(svm_node*) + 2 * sizeof(double)) +
+                       l * kSolverBytesPerSample;
+  size_t min_cache_bytes = 2 * l * sizeof(float);
+  if (fixed_bytes + min_cache_bytes > max_job_bytes)
+    return false;
+  double max_cache_mb =
+      static_cast<double>(max_job_bytes - fixed_bytes) / (1 << 20);
+  job->param.cache_size = std::min(job->param.cache_size, max_cache_mb);
+  return true;
+}
+
+TrainingResult Train(std::unique_ptr<TrainingJob> job) {
+  TrainingResult result;
+  svm_problem problem;
+  problem.l = static_cast<int>(job->y.size());
+  problem.y = job->y.data();
+  problem.x = job->x.data();
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  svm_model* model =
+      svm_train_warm_start(&problem, &job->param, job->coefs.data());
+  result.time = base::TimeTicks::Now() - start;
+  result.trained = true;
+  result.rho = model->rho[0];
+  result.coefs.assign(problem.l, 0);
+  for (int i = 0; i < model->l; ++i)
+    result.coefs[model->sv_indices[i] - 1] = model->sv_coef[0][i];
+  svm_free_and_destroy_model(&model);
+  return result;
+}
+
+class TrainServer : public net::HttpServer::Delegate {
+ public:
+  TrainServer(int jobs, size_t max_job_bytes)
+      : max_job_bytes_(max_job_bytes), weak_factory_(this) {
+    for (int i = 0; i < jobs; ++i) {
+      workers_.push_back(base::MakeUnique<base::Thread>(
+          "SvmTrainWorker" + base::IntToString(i)));
+      CHECK(workers_.back()->Start());
+    }
+    jobs_in_flight_.assign(jobs, 0);
+  }
+  ~TrainServer() override {}
+
+  bool Listen(const std::string& address, int port) {
+    std::unique_ptr<net::ServerSocket> socket(
+        new net::TCPServerSocket(nullptr, net::NetLogSource()));
+    if (socket->ListenWithAddressAndPort(address, port, kBackLog) != net::OK)
+      return false;
+    server_ = base::MakeUnique<net::HttpServer>(std::move(socket), this);
+    return true;
+  }
+
+ private:
+  // net::HttpServer::Delegate implementation.
+  void OnConnect(int connection_id) override {}
+  void OnHttpRequest(int connection_id,
+                     const net::HttpServerRequestInfo& info) override {
+    if (info.method != "POST" ||
+        !base::StartsWith(info.path, "/train", base::CompareCase::SENSITIVE)) {
+      server_->Send404(connection_id);
+      return;
+    }
+    std::unique_ptr<TrainingJob> job = base::MakeUnique<TrainingJob>();
+    std::string error = ParseJob(info, job.get());
+    if (!error.empty()) {
+      server_->Send(connection_id, net::HTTP_BAD_REQUEST, error,
+                    kTextContentType);
+      return;
+    }
+    if (!FitJob(max_job_bytes_, job.get())) {
+      server_->Send(connection_id, net::HTTP_REQUEST_ENTITY_TOO_LARGE,
+                    "problem exceeds --max-job-mb", kTextContentType);
+      return;
+    }
+    svm_problem problem;
+    problem.l = static_cast<int>(job->y.size());
+    problem.y = job->y.data();
+    problem.x = job->x.data();
+    if (const char* check = svm_check_parameter(&problem, &job->param)) {
+      server_->Send(connection_id, net::HTTP_BAD_REQUEST, check,
+                    kTextContentType);
+      return;
+    }
+
+    size_t worker = std::min_element(jobs_in_flight_.begin(),
+                                     jobs_in_flight_.end()) -
+                    jobs_in_flight_.begin();
+    ++jobs_in_flight_[worker];
+    base::PostTaskAndReplyWithResult(
+        workers_[worker]->task_runner().get(), FROM_HERE,
+        base::Bind(&Train, base::Passed(&job)),
+        base::Bind(&TrainServer::OnTrained, weak_factory_.GetWeakPtr(),
+                   connection_id, worker));
+  }
+  void OnWebSocketRequest(int connection_id,
+                          const net::HttpServerRequestInfo& info) override {
+    server_->Send404(connection_id);
+  }
+  void OnWebSocketMessage(int connection_id,
+                          const std::string& data) override {}
+  void OnClose(int connection_id) override {}
+
+  void OnTrained(int connection_id,
+                 size_t worker,
+                 const TrainingResult& result) {
+    --jobs_in_flight_[worker];
+    std::string response = base::StringPrintf("rho %.17g\n", result.rho);
+    for (double coef : result.coefs)
+      base::StringAppendF(&response, "%.17g\n", coef);
+    LOG(INFO) << "Trained " << result.coefs.size() << " samples in "
+              << result.time.InMillisecondsF() << " ms";
+    // The connection may have closed while training; the server then drops
+    // the response.
+    server_->Send200(connection_id, response, kTextContentType);
+  }
+
+  const size_t max_job_bytes_;
+  std::unique_ptr<net::HttpServer> server_;
+  std::vector<std::unique_ptr<base::Thread>> workers_;
+  // Jobs posted to each worker and not yet answered.
+  std::vector<int> jobs_in_flight_;
+
+  base::WeakPtrFactory<TrainServer> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(TrainServer);
+};
+
+void PrintUsage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--address=<address>] [--port=<port>] [--jobs=<n>]\n"
+          "          [--max-job-mb=<megabytes>]\n"
+          "Serves POST /train for the model server; see the top of\n"
+          "svm_train_server.cc for the protocol. Defaults: %s:%d, one job\n"
+          "per core, %d MB per job.\n",
+          program, kDefaultAddress, kDefaultPort, kDefaultMaxJobMb);
+}
+
+bool GetIntSwitch(const base::CommandLine& command_line,
+                  const char* name,
+                  int min_value,
+                  int* value) {
+  if (!command_line.HasSwitch(name))
+    return true;
+  return base::StringToInt(command_line.GetSwitchValueASCII(name), value) &&
+         *value >= min_value;
+}
+
+}  // namespace
+}  // namespace ui
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit_manager;
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  int port = ui::kDefaultPort;
+  int jobs = base::SysInfo::NumberOfProcessors();
+  int max_job_mb = ui::kDefaultMaxJobMb;
+  if (!ui::GetIntSwitch(command_line, ui::kPortSwitch, 0, &port) ||
+      !ui::GetIntSwitch(command_line, ui::kJobsSwitch, 1, &jobs) ||
+      !ui::GetIntSwitch(command_line, ui::kMaxJobMbSwitch, 1, &max_job_mb)) {
+    ui::PrintUsage(argv[0]);
+    return 1;
+  }
+  std::string address = ui::kDefaultAddress;
+  if (command_line.HasSwitch(ui::kAddressSwitch))
+    address = command_line.GetSwitchValueASCII(ui::kAddressSwitch);
+
+  svm_set_print_string_function(&ui::QuietPrint);
+  // Jobs already keep the cores busy; one more thread per column would only
+  // contend with them.
+  svm_set_kernel_threads(1, 0);
+
+  base::MessageLoopForIO message_loop;
+  ui::TrainServer server(jobs, static_cast<size_t>(max_job_mb) << 20);
+  if (!server.Listen(address, port)) {
+    fprintf(stderr, "Cannot listen on %s:%d\n", address.c_str(), port);
+    return 1;
+  }
+  fprintf(stderr, "Listening on %s:%d with %d jobs\n", address.c_str(), port,
+          jobs);
+  base::RunLoop().Run();
+  return 0;
+}
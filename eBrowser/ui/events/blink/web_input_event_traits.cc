@@ -4,8 +4,14 @@
 
 #include "ui/events/blink/web_input_event_traits.h"
 
+#include <new>
+#include <vector>
+
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/macros.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/thread_local_storage.h"
 
 using base::StringAppendF;
 using base::SStringPrintf;
@@ -20,6 +26,94 @@ using blink::WebTouchPoint;
 namespace ui {
 namespace {
 
+// Storage for cloned events, recycled per thread and per event size, so that
+// cloning and deleting events on the input path does not reach the heap once
+// the lists are warm. Storage freed on another thread than the one that
+// allocated it joins the freeing thread's list; each list is capped, so a
+// thread that only frees does not hoard memory.
+class EventStoragePool {
+ public:
+  EventStoragePool() {}
+  ~EventStoragePool() {
+    for (const FreeList& list : free_lists_) {
+      for (void* block : list.blocks)
+        ::operator delete(block);
+    }
+  }
+
+  static EventStoragePool* Current();
+
+  void* Allocate(size_t size) {
+    FreeList* list = Find(size);
+    if (!list || list->blocks.empty())
+      return ::operator new(size);
+    void* block = list->blocks.back();
+    list->blocks.pop_back();
+    return block;
+  }
+
+  void Free(size_t size, void* block) {
+    FreeList* list = Find(size);
+    if (!list) {
+      free_lists_.push_back(FreeList(size));
+      list = &free_lists_.back();
+    }
+    if (list->blocks.size() >= kMaxFreeBlocks) {
+      ::operator delete(block);
+      return;
+    }
+    list->blocks.push_back(block);
+  }
+
+ private:
+  // About two frames of events at a high touch sampling rate.
+  static const size_t kMaxFreeBlocks = 16;
+
+  struct FreeList {
+    explicit FreeList(size_t size) : size(size) {
+      blocks.reserve(kMaxFreeBlocks);
+    }
+    size_t size;
+    std::vector<void*> blocks;
+  };
+
+  // One list per event class size, so a linear search is enough.
+  FreeList* Find(size_t size) {
+    for (FreeList& list : free_lists_) {
+      if (list.size == size)
+        return &list;
+    }
+    return nullptr;
+  }
+
+  std::vector<FreeList> free_lists_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventStoragePool);
+};
+
+void DeleteEventStoragePool(void* pool) {
+  delete static_cast<EventStoragePool*>(pool);
+}
+
+struct EventStoragePoolSlot {
+  EventStoragePoolSlot() : slot(&DeleteEventStoragePool) {}
+  base::ThreadLocalStorage::Slot slot;
+};
+
+base::LazyInstance<EventStoragePoolSlot>::Leaky g_event_storage_pool_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+// static
+EventStoragePool* EventStoragePool::Current() {
+  base::ThreadLocalStorage::Slot& slot = g_event_storage_pool_slot.Get().slot;
+  EventStoragePool* pool = static_cast<EventStoragePool*>(slot.Get());
+  if (!pool) {
+    pool = new EventStoragePool;
+    slot.Set(pool);
+  }
+  return pool;
+}
+
 void ApppendEventDetails(const WebKeyboardEvent& event, std::string* result) {
   StringAppendF(result,
                 "{\n WinCode: %d\n NativeCode: %d\n IsSystem: %d\n"
@@ -129,8 +223,9 @@ struct WebInputEventClone {
   bool Execute(const WebInputEvent& event,
                ScopedWebInputEvent* scoped_event) const {
     DCHECK_EQ(sizeof(EventType), event.size);
+    void* storage = EventStoragePool::Current()->Allocate(sizeof(EventType));
     *scoped_event = ScopedWebInputEvent(
-        new EventType(static_cast<const EventType&>(event)));
+        new (storage) EventType(static_cast<const EventType&>(event)));
     return true;
   }
 };
@@ -141,7 +236,10 @@ struct WebInputEventDelete {
     if (!event)
       return false;
     DCHECK_EQ(sizeof(EventType), event->size);
-    delete static_cast<EventType*>(event);
+    // Events made by plain new, rather than Clone(), have the same storage,
+    // so they are recycled alike.
+    static_cast<EventType*>(event)->~EventType();
+    EventStoragePool::Current()->Free(sizeof(EventType), event);
     return true;
   }
 };
@@ -45,5 +45,29 @@ TEST_F(WebInputEventTraitsTest, ToString) {
   EXPECT_FALSE(WebInputEventTraits::ToString(touch).empty());
 }
 
+TEST_F(WebInputEventTraitsTest, CloneRecyclesDeletedEvents) {
+  WebTouchEvent touch;
+  touch.type = WebInputEvent::TouchMove;
+  touch.touchesLength = 1;
+  touch.touches[0].position.x = 7;
+
+  ScopedWebInputEvent clone = WebInputEventTraits::Clone(touch);
+  ASSERT_EQ(WebInputEvent::TouchMove, clone->type);
+  EXPECT_EQ(7, static_cast<WebTouchEvent&>(*clone).touches[0].position.x);
+  const WebInputEvent* storage = clone.get();
+
+  // Once deleted, the storage of an event is reused by the next clone of the
+  // same size on this thread, but not by one of another class.
+  clone.reset();
+  WebGestureEvent gesture;
+  gesture.type = WebInputEvent::GestureScrollUpdate;
+  ScopedWebInputEvent gesture_clone = WebInputEventTraits::Clone(gesture);
+  EXPECT_NE(storage, gesture_clone.get());
+  ScopedWebInputEvent second_clone = WebInputEventTraits::Clone(touch);
+  EXPECT_EQ(storage, second_clone.get());
+  EXPECT_EQ(7,
+            static_cast<WebTouchEvent&>(*second_clone).touches[0].position.x);
+}
+
 }  // namespace
 }  // namespace ui
@@ -7,6 +7,11 @@
 
 namespace switches {
 
+// Dispatch the mouse and touch moves that arrive between compositor frames
+// once per frame in Aura, instead of one by one.
+const char kCoalescePointerMovesPerFrame[] =
+    "coalesce-pointer-moves-per-frame";
+
 // Enable scroll prediction for scroll update events.
 const char kEnableScrollPrediction[] = "enable-scroll-prediction";
 
@@ -11,6 +11,7 @@
 
 namespace switches {
 
+EVENTS_BASE_EXPORT extern const char kCoalescePointerMovesPerFrame[];
 EVENTS_BASE_EXPORT extern const char kEnableScrollPrediction[];
 EVENTS_BASE_EXPORT extern const char kTouchEvents[];
 EVENTS_BASE_EXPORT extern const char kTouchEventsAuto[];
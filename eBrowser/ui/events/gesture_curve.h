@@ -24,6 +24,10 @@ class EVENTS_BASE_EXPORT GestureCurve {
   virtual bool ComputeScrollOffset(base::TimeTicks time,
                                    gfx::Vector2dF* offset,
                                    gfx::Vector2dF* velocity) = 0;
+
+  // The terminal offset, i.e. the total movement of the curve once it has
+  // come to rest.
+  virtual gfx::Vector2dF GetFinalOffset() const = 0;
 };
 
 }  // namespace ui
@@ -120,7 +120,8 @@ class GestureProvider::GestureListenerImpl : public ScaleGestureListener,
       max_diameter_before_show_press_ = event.GetTouchMajor();
     }
     gesture_detector_.OnTouchEvent(event);
-    scale_gesture_detector_.OnTouchEvent(event);
+    if (!IsEstablishedSingleTouchScrollMove(event))
+      scale_gesture_detector_.OnTouchEvent(event);
 
     if (action == MotionEvent::ACTION_UP ||
         action == MotionEvent::ACTION_CANCEL) {
@@ -137,6 +138,20 @@ class GestureProvider::GestureListenerImpl : public ScaleGestureListener,
     }
   }
 
+  // Whether |event| only moves the single pointer of a scroll that is already
+  // under way. Such a move can neither begin a pinch nor change any state of
+  // the scale detector, which also resynchronizes on every pointer change, so
+  // scale detection is skipped for it. At high touch sample rates this is
+  // most of the events of a scroll.
+  bool IsEstablishedSingleTouchScrollMove(const MotionEvent& event) const {
+    return event.GetAction() == MotionEvent::ACTION_MOVE &&
+           scroll_event_sent_ && !pinch_event_sent_ &&
+           event.GetPointerCount() == 1 &&
+           !scale_gesture_detector_.IsInProgress() &&
+           !scale_gesture_detector_.InAnchoredScaleMode() &&
+           !(event.GetButtonState() & MotionEvent::BUTTON_STYLUS_PRIMARY);
+  }
+
   void Send(GestureEventData gesture) {
     DCHECK(!gesture.time.is_null());
     // The only valid events that should be sent without an active touch
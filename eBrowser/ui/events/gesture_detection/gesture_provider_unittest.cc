@@ -859,6 +859,45 @@ TEST_F(GestureProviderTest, ScrollUpdateValues) {
   EXPECT_EQ(-delta_y / 2, gesture.details.scroll_y());
 }
 
+// Verify that a pinch can still begin after many single-pointer scroll moves,
+// which skip scale detection.
+TEST_F(GestureProviderTest, PinchAfterEstablishedScroll) {
+  base::TimeTicks event_time = base::TimeTicks::Now();
+  const float touch_slop = GetTouchSlop();
+  gesture_provider_->SetMultiTouchZoomSupportEnabled(true);
+
+  MockMotionEvent event =
+      ObtainMotionEvent(event_time, MotionEvent::ACTION_DOWN);
+  EXPECT_TRUE(gesture_provider_->OnTouchEvent(event));
+
+  float y = kFakeCoordY;
+  for (int i = 0; i < 10; ++i) {
+    y += 2 * touch_slop;
+    event_time += kOneMicrosecond;
+    event = ObtainMotionEvent(event_time, MotionEvent::ACTION_MOVE,
+                              kFakeCoordX, y);
+    EXPECT_TRUE(gesture_provider_->OnTouchEvent(event));
+    EXPECT_EQ(ET_GESTURE_SCROLL_UPDATE, GetMostRecentGestureEventType());
+  }
+  EXPECT_FALSE(HasReceivedGesture(ET_GESTURE_PINCH_BEGIN));
+
+  int secondary_coord_x = kFakeCoordX + 20 * touch_slop;
+  int secondary_coord_y = y + 20 * touch_slop;
+  event_time += kOneMicrosecond;
+  event = ObtainMotionEvent(event_time, MotionEvent::ACTION_POINTER_DOWN,
+                            kFakeCoordX, y, secondary_coord_x,
+                            secondary_coord_y);
+  EXPECT_TRUE(gesture_provider_->OnTouchEvent(event));
+
+  secondary_coord_x += 5 * touch_slop;
+  secondary_coord_y += 5 * touch_slop;
+  event_time += kOneMicrosecond;
+  event = ObtainMotionEvent(event_time, MotionEvent::ACTION_MOVE, kFakeCoordX,
+                            y, secondary_coord_x, secondary_coord_y);
+  EXPECT_TRUE(gesture_provider_->OnTouchEvent(event));
+  EXPECT_TRUE(HasReceivedGesture(ET_GESTURE_PINCH_BEGIN));
+}
+
 // Verify that fractional scroll deltas are rounded as expected and that
 // fractional scrolling doesn't break scroll snapping.
 TEST_F(GestureProviderTest, FractionalScroll) {
@@ -29,6 +29,18 @@ const int kResampleMaxPredictionMs = 8;
 
 typedef ScopedVector<MotionEventGeneric> MotionEventVector;
 
+// Returns how far to predict past the last sample, given the time delta
+// between the last two samples. At a reduced frame rate the target is half a
+// frame interval past the flush, which is up to an input interval past the
+// last sample; the horizon is then bounded by the frame interval instead.
+base::TimeDelta MaxPrediction(base::TimeDelta event_delta,
+                              base::TimeDelta flush_interval) {
+  if (!flush_interval.is_zero())
+    return flush_interval;
+  return std::min(event_delta / 2,
+                  base::TimeDelta::FromMilliseconds(kResampleMaxPredictionMs));
+}
+
 float Lerp(float a, float b, float alpha) {
   return a + alpha * (b - a);
 }
@@ -174,10 +186,15 @@ std::unique_ptr<MotionEventGeneric> ConsumeSamples(MotionEventVector events) {
 // are resampled or resampling is otherwise inconsistent, e.g., a 90hz input
 // and 60hz frame signal could phase-align such that even frames yield an
 // extrapolated event and odd frames are not resampled, crbug.com/399381.
+// |previous| is the newest sample of the last flush, if it is to be used for
+// extrapolation, and |flush_interval| is zero when flushing at the display
+// rate, see |MotionEventBuffer::SetFlushInterval()|.
 std::unique_ptr<MotionEventGeneric> ConsumeSamplesAndTryResampling(
     base::TimeTicks resample_time,
     MotionEventVector events,
-    const MotionEvent* next) {
+    const MotionEvent* next,
+    const MotionEvent* previous,
+    base::TimeDelta flush_interval) {
   const ui::MotionEvent* event0 = nullptr;
   const ui::MotionEvent* event1 = nullptr;
   if (next) {
@@ -185,16 +202,15 @@ std::unique_ptr<MotionEventGeneric> ConsumeSamplesAndTryResampling(
     // Interpolate between current sample and future sample.
     event0 = events.back();
     event1 = next;
-  } else if (events.size() >= 2) {
+  } else if (events.size() >= 2 || previous) {
     // Extrapolate future sample using current sample and past sample.
-    event0 = events[events.size() - 2];
+    event0 = events.size() >= 2 ? events[events.size() - 2] : previous;
     event1 = events[events.size() - 1];
 
     const base::TimeTicks time1 = event1->GetEventTime();
     base::TimeTicks max_predict =
-        time1 +
-        std::min((event1->GetEventTime() - event0->GetEventTime()) / 2,
-                 base::TimeDelta::FromMilliseconds(kResampleMaxPredictionMs));
+        time1 + MaxPrediction(event1->GetEventTime() - event0->GetEventTime(),
+                              flush_interval);
     if (resample_time > max_predict) {
       TRACE_EVENT_INSTANT2("input",
                            "MotionEventBuffer::TryResample prediction adjust",
@@ -245,10 +261,17 @@ MotionEventBuffer::MotionEventBuffer(MotionEventBufferClient* client,
 MotionEventBuffer::~MotionEventBuffer() {
 }
 
+void MotionEventBuffer::SetFlushInterval(base::TimeDelta interval) {
+  flush_interval_ = interval;
+  if (flush_interval_.is_zero())
+    last_flushed_sample_.reset();
+}
+
 void MotionEventBuffer::OnMotionEvent(const MotionEvent& event) {
   DCHECK_EQ(0U, event.GetHistorySize());
   if (event.GetAction() != MotionEvent::ACTION_MOVE) {
     last_extrapolated_event_time_ = base::TimeTicks();
+    last_flushed_sample_.reset();
     if (!buffered_events_.empty())
       FlushWithoutResampling(std::move(buffered_events_));
     client_->ForwardMotionEvent(event);
@@ -275,6 +298,7 @@ void MotionEventBuffer::OnMotionEvent(const MotionEvent& event) {
   if (CanAddSample(*buffered_events_.front(), *clone)) {
     DCHECK(buffered_events_.back()->GetEventTime() <= clone->GetEventTime());
   } else {
+    last_flushed_sample_.reset();
     FlushWithoutResampling(std::move(buffered_events_));
   }
 
@@ -287,9 +311,12 @@ void MotionEventBuffer::Flush(base::TimeTicks frame_time) {
     return;
 
   // Shifting the sample time back slightly minimizes the potential for
-  // misprediction when extrapolating events.
-  if (resample_)
+  // misprediction when extrapolating events. Below the display rate, the
+  // sample time also moves ahead to the middle of the reduced frame.
+  if (resample_) {
     frame_time -= base::TimeDelta::FromMilliseconds(kResampleLatencyMs);
+    frame_time += flush_interval_ / 2;
+  }
 
   // TODO(jdduke): Use a persistent MotionEventVector vector for temporary
   // storage.
@@ -301,18 +328,28 @@ void MotionEventBuffer::Flush(base::TimeTicks frame_time) {
     return;
   }
 
-  if (!resample_ || (events.size() == 1 && buffered_events_.empty())) {
+  std::unique_ptr<MotionEventGeneric> previous_sample =
+      std::move(last_flushed_sample_);
+  if (previous_sample && !CanAddSample(*previous_sample, *events.back()))
+    previous_sample.reset();
+  if (resample_ && !flush_interval_.is_zero())
+    last_flushed_sample_ = MotionEventGeneric::CloneEvent(*events.back());
+
+  if (!resample_ ||
+      (events.size() == 1 && buffered_events_.empty() && !previous_sample)) {
     FlushWithoutResampling(std::move(events));
     if (!buffered_events_.empty())
       client_->SetNeedsFlush();
     return;
   }
 
-  FlushWithResampling(std::move(events), frame_time);
+  FlushWithResampling(std::move(events), frame_time, previous_sample.get());
 }
 
-void MotionEventBuffer::FlushWithResampling(MotionEventVector events,
-                                            base::TimeTicks resample_time) {
+void MotionEventBuffer::FlushWithResampling(
+    MotionEventVector events,
+    base::TimeTicks resample_time,
+    const MotionEvent* previous_sample) {
   DCHECK(!events.empty());
   base::TimeTicks original_event_time = events.back()->GetEventTime();
   const MotionEvent* next_event =
@@ -320,7 +357,8 @@ void MotionEventBuffer::FlushWithResampling(MotionEventVector events,
 
   std::unique_ptr<MotionEventGeneric> resampled_event =
       ConsumeSamplesAndTryResampling(resample_time, std::move(events),
-                                     next_event);
+                                     next_event, previous_sample,
+                                     flush_interval_);
   DCHECK(resampled_event);
 
   // Log the extrapolated event time, guarding against subsequently queued
@@ -54,11 +54,19 @@ class GESTURE_DETECTION_EXPORT MotionEventBuffer {
   // requested.
   void Flush(base::TimeTicks frame_time);
 
+  // Sets the interval between flushes when frames are produced below the
+  // display rate, or zero (the default) when every vsync flushes. Since a
+  // reduced frame stays on screen for the whole interval, resampling then
+  // targets the middle of its display time, half an interval after the flush,
+  // and may predict up to one interval past the last sample to get there.
+  void SetFlushInterval(base::TimeDelta interval);
+
  private:
   typedef ScopedVector<MotionEventGeneric> MotionEventVector;
 
   void FlushWithResampling(MotionEventVector events,
-                           base::TimeTicks resample_time);
+                           base::TimeTicks resample_time,
+                           const MotionEvent* previous_sample);
   void FlushWithoutResampling(MotionEventVector events);
 
   MotionEventBufferClient* const client_;
@@ -76,6 +84,14 @@ class GESTURE_DETECTION_EXPORT MotionEventBuffer {
   // forwarded, with preceding events as historical entries. Defaults to true.
   bool resample_;
 
+  // See |SetFlushInterval()|.
+  base::TimeDelta flush_interval_;
+
+  // The newest platform sample of the last flush, kept while a flush interval
+  // is set. Input may then deliver a single sample per flush, which is
+  // extrapolated from this one.
+  std::unique_ptr<MotionEventGeneric> last_flushed_sample_;
+
   DISALLOW_COPY_AND_ASSIGN(MotionEventBuffer);
 };
 
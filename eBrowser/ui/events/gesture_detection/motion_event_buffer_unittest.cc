@@ -175,6 +175,7 @@ class MotionEventBufferTest : public testing::Test,
                             std::max(event_time_delta, flush_time_delta));
 
     MotionEventBuffer buffer(this, true);
+    buffer.SetFlushInterval(flush_interval_);
 
     gfx::Vector2dF velocity(33.f, -11.f);
     gfx::PointF position(17.f, 42.f);
@@ -240,6 +241,9 @@ class MotionEventBufferTest : public testing::Test,
     EXPECT_GE(events, min_expected_events);
   }
 
+  // Flush interval of the buffers made by |RunResample()|.
+  base::TimeDelta flush_interval_;
+
  private:
   ScopedVector<MotionEvent> forwarded_events_;
   bool needs_flush_;
@@ -823,6 +827,42 @@ TEST_F(MotionEventBufferTest, ExtrapolationHorizonLimited) {
   EXPECT_EVENT_HISTORY_EQ(*events.front(), 1, move1);
 }
 
+TEST_F(MotionEventBufferTest, ExtrapolationToReducedFrame) {
+  base::TimeTicks event_time = base::TimeTicks::Now();
+  MotionEventBuffer buffer(this, true);
+  buffer.SetFlushInterval(base::TimeDelta::FromMilliseconds(32));
+
+  MockMotionEvent move0(MotionEvent::ACTION_MOVE, event_time, 5.f, 10.f);
+  buffer.OnMotionEvent(move0);
+  event_time += base::TimeDelta::FromMilliseconds(16);
+  MockMotionEvent move1(MotionEvent::ACTION_MOVE, event_time, 10.f, 20.f);
+  buffer.OnMotionEvent(move1);
+  ASSERT_FALSE(GetLastEvent());
+
+  // Flush just after the second event. The reduced frame is displayed for
+  // 32 ms, so the event is extrapolated to the middle of that, 16 ms past the
+  // second event, instead of being limited to 8 ms.
+  buffer.Flush(move1.GetEventTime() + ResampleDelta());
+  base::TimeTicks expected_time =
+      move1.GetEventTime() + base::TimeDelta::FromMilliseconds(16);
+  MockMotionEvent extrapolated_event(
+      MotionEvent::ACTION_MOVE, expected_time, 15.f, 30.f);
+  ScopedVector<MotionEvent> events = GetAndResetForwardedEvents();
+  ASSERT_EQ(1U, events.size());
+  EXPECT_EQ(2U, events.front()->GetHistorySize());
+  EXPECT_EVENT_IGNORING_HISTORY_EQ(*events.front(), extrapolated_event);
+  EXPECT_EVENT_HISTORY_EQ(*events.front(), 0, move0);
+  EXPECT_EVENT_HISTORY_EQ(*events.front(), 1, move1);
+
+  // Events older than the extrapolated one are dropped, as at the display
+  // rate.
+  event_time += base::TimeDelta::FromMilliseconds(8);
+  buffer.OnMotionEvent(
+      MockMotionEvent(MotionEvent::ACTION_MOVE, event_time, 12.5f, 25.f));
+  buffer.Flush(event_time + ResampleDelta());
+  EXPECT_FALSE(GetLastEvent());
+}
+
 TEST_F(MotionEventBufferTest, Resampling30to60) {
   base::TimeDelta flush_time_delta =
       base::TimeDelta::FromMillisecondsD(1000. / 60.);
@@ -868,4 +908,14 @@ TEST_F(MotionEventBufferTest, Resampling150to60) {
   RunResample(flush_time_delta, event_time_delta);
 }
 
+TEST_F(MotionEventBufferTest, Resampling60to30WithFlushInterval) {
+  base::TimeDelta flush_time_delta =
+      base::TimeDelta::FromMillisecondsD(1000. / 30.);
+  base::TimeDelta event_time_delta =
+      base::TimeDelta::FromMillisecondsD(1000. / 60.);
+
+  flush_interval_ = flush_time_delta;
+  RunResample(flush_time_delta, event_time_delta);
+}
+
 }  // namespace ui
@@ -433,7 +433,7 @@ void LeastSquaresVelocityTrackerStrategy::Clear() {
  * Solves a linear least squares problem to obtain a N degree polynomial that
  * fits the specified input data as nearly as possible.
  *
- * Returns true if a solution is found, false otherwise.
+ * A solution is found unless ComputeLeastSquaresBasis() returns false.
  *
  * The input consists of two vectors of data points X and Y with indices 0..m-1
  * along with a weight vector W of the same size.
@@ -464,16 +464,18 @@ void LeastSquaresVelocityTrackerStrategy::Clear() {
  * goodness of fit of the model for the given data.  It is a value between 0
  * and 1, where 1 indicates perfect correspondence.
  *
- * This function first expands the X vector to a m by n matrix A such that
- * A[i][0] = 1, A[i][1] = X[i], A[i][2] = X[i]^2, ..., A[i][n] = X[i]^n, then
- * multiplies it by w[i]./
+ * This is done in two steps. ComputeLeastSquaresBasis() first expands the X
+ * vector to a m by n matrix A such that A[i][0] = 1, A[i][1] = X[i], A[i][2] =
+ * X[i]^2, ..., A[i][n] = X[i]^n, then multiplies it by w[i].
  *
  * Then it calculates the QR decomposition of A yielding an m by m orthonormal
  * matrix Q and an m by n upper triangular matrix R.  Because R is upper
  * triangular (lower part is all zeroes), we can simplify the decomposition into
  * an m by n matrix Q1 and a n by n matrix R1 such that A = Q1 R1.
  *
- * Finally we solve the system of linear equations given by
+ * The decomposition only depends on X and W, so it is shared by the fits of
+ * every Y over the same samples, i.e. of both the x and y coordinates.
+ * SolveLeastSquares() then solves the system of linear equations given by
  * R1 B = (Qtranspose W Y) to find B.
  *
  * For efficiency, we lay out A and Q column-wise in memory because we
@@ -482,28 +484,30 @@ void LeastSquaresVelocityTrackerStrategy::Clear() {
  * http://en.wikipedia.org/wiki/Numerical_methods_for_linear_least_squares
  * http://en.wikipedia.org/wiki/Gram-Schmidt
  */
-static bool SolveLeastSquares(const float* x,
-                              const float* y,
-                              const float* w,
-                              uint32_t m,
-                              uint32_t n,
-                              float* out_b,
-                              float* out_det) {
-  // MSVC does not support variable-length arrays (used by the original Android
-  // implementation of this function).
-#if defined(COMPILER_MSVC)
-  const uint32_t M_ARRAY_LENGTH =
+struct LeastSquaresBasis {
+  static const uint32_t kMaxSamples =
       LeastSquaresVelocityTrackerStrategy::kHistorySize;
-  const uint32_t N_ARRAY_LENGTH = Estimator::kMaxDegree;
-  DCHECK_LE(m, M_ARRAY_LENGTH);
-  DCHECK_LE(n, N_ARRAY_LENGTH);
-#else
-  const uint32_t M_ARRAY_LENGTH = m;
-  const uint32_t N_ARRAY_LENGTH = n;
-#endif
+
+  uint32_t m;
+  uint32_t n;
+  // Orthonormal basis, column-major order.
+  float q[Estimator::kMaxDegree][kMaxSamples];
+  // Upper triangular matrix, row-major order.
+  float r[Estimator::kMaxDegree][Estimator::kMaxDegree];
+};
+
+static bool ComputeLeastSquaresBasis(const float* x,
+                                     const float* w,
+                                     uint32_t m,
+                                     uint32_t n,
+                                     LeastSquaresBasis* basis) {
+  DCHECK(m <= LeastSquaresBasis::kMaxSamples);
+  DCHECK_LE(n, static_cast<uint32_t>(Estimator::kMaxDegree));
+  basis->m = m;
+  basis->n = n;
 
   // Expand the X vector to a matrix A, pre-multiplied by the weights.
-  float a[N_ARRAY_LENGTH][M_ARRAY_LENGTH];  // column-major order
+  float a[Estimator::kMaxDegree][LeastSquaresBasis::kMaxSamples];
   for (uint32_t h = 0; h < m; h++) {
     a[0][h] = w[h];
     for (uint32_t i = 1; i < n; i++) {
@@ -512,11 +516,8 @@ static bool SolveLeastSquares(const float* x,
   }
 
   // Apply the Gram-Schmidt process to A to obtain its QR decomposition.
-
-  // Orthonormal basis, column-major order.
-  float q[N_ARRAY_LENGTH][M_ARRAY_LENGTH];
-  // Upper triangular matrix, row-major order.
-  float r[N_ARRAY_LENGTH][N_ARRAY_LENGTH];
+  float (*q)[LeastSquaresBasis::kMaxSamples] = basis->q;
+  float (*r)[Estimator::kMaxDegree] = basis->r;
   for (uint32_t j = 0; j < n; j++) {
     for (uint32_t h = 0; h < m; h++) {
       q[j][h] = a[j][h];
@@ -542,19 +543,30 @@ static bool SolveLeastSquares(const float* x,
       r[j][i] = i < j ? 0 : VectorDot(&q[j][0], &a[i][0], m);
     }
   }
+  return true;
+}
+
+static void SolveLeastSquares(const LeastSquaresBasis& basis,
+                              const float* x,
+                              const float* y,
+                              const float* w,
+                              float* out_b,
+                              float* out_det) {
+  const uint32_t m = basis.m;
+  const uint32_t n = basis.n;
 
   // Solve R B = Qt W Y to find B.  This is easy because R is upper triangular.
   // We just work from bottom-right to top-left calculating B's coefficients.
-  float wy[M_ARRAY_LENGTH];
+  float wy[LeastSquaresBasis::kMaxSamples];
   for (uint32_t h = 0; h < m; h++) {
     wy[h] = y[h] * w[h];
   }
   for (uint32_t i = n; i-- != 0;) {
-    out_b[i] = VectorDot(&q[i][0], wy, m);
+    out_b[i] = VectorDot(&basis.q[i][0], wy, m);
     for (uint32_t j = n - 1; j > i; j--) {
-      out_b[i] -= r[i][j] * out_b[j];
+      out_b[i] -= basis.r[i][j] * out_b[j];
     }
-    out_b[i] /= r[i][i];
+    out_b[i] /= basis.r[i][i];
   }
 
   // Calculate the coefficient of determination as 1 - (SSerr / SStot) where
@@ -581,7 +593,6 @@ static bool SolveLeastSquares(const float* x,
     sstot += w[h] * w[h] * var * var;
   }
   *out_det = sstot > 0.000001f ? 1.0f - (sserr / sstot) : 1;
-  return true;
 }
 
 void LeastSquaresVelocityTrackerStrategy::ClearPointers(BitSet32 id_bits) {
@@ -634,8 +645,10 @@ bool LeastSquaresVelocityTrackerStrategy::GetEstimator(
   if (degree >= 1) {
     float xdet, ydet;
     uint32_t n = degree + 1;
-    if (SolveLeastSquares(time, x, w, m, n, out_estimator->xcoeff, &xdet) &&
-        SolveLeastSquares(time, y, w, m, n, out_estimator->ycoeff, &ydet)) {
+    LeastSquaresBasis basis;
+    if (ComputeLeastSquaresBasis(time, w, m, n, &basis)) {
+      SolveLeastSquares(basis, time, x, w, out_estimator->xcoeff, &xdet);
+      SolveLeastSquares(basis, time, y, w, out_estimator->ycoeff, &ydet);
       if (restriction_ == RESTRICTION_ALIGNED_DIRECTIONS) {
         DCHECK(first_movement);
         float dx = newest_movement.GetPosition(id).x -
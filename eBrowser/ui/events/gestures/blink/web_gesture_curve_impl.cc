@@ -123,11 +123,8 @@ bool WebGestureCurveImpl::apply(double time,
     ++ticks_since_first_animate_;
   }
 
-  const base::TimeTicks time_ticks =
-      base::TimeTicks() + base::TimeDelta::FromSecondsD(time);
   gfx::Vector2dF offset, velocity;
-  bool still_active =
-      curve_->ComputeScrollOffset(time_ticks, &offset, &velocity);
+  bool still_active = PositionAt(time, &offset, &velocity);
 
   gfx::Vector2dF delta = offset - last_offset_;
   last_offset_ = offset;
@@ -144,4 +141,17 @@ bool WebGestureCurveImpl::apply(double time,
   return did_scroll && still_active;
 }
 
+bool WebGestureCurveImpl::PositionAt(double time,
+                                     gfx::Vector2dF* offset,
+                                     gfx::Vector2dF* velocity) {
+  // The curves start at the zero timestamp; see CreateDefaultPlatformCurve().
+  const base::TimeTicks time_ticks =
+      base::TimeTicks() + base::TimeDelta::FromSecondsD(time);
+  return curve_->ComputeScrollOffset(time_ticks, offset, velocity);
+}
+
+gfx::Vector2dF WebGestureCurveImpl::FinalPosition() const {
+  return curve_->GetFinalOffset();
+}
+
 }  // namespace ui
@@ -37,6 +37,18 @@ class WebGestureCurveImpl : public NON_EXPORTED_BASE(blink::WebGestureCurve) {
   bool apply(double time,
              blink::WebGestureCurveTarget* target) override;
 
+  // The curve's offset and velocity at |time|, in the seconds |apply()|
+  // takes. They are evaluated from the curve itself rather than accumulated
+  // over the ticks applied so far, so any ticks may be skipped in between.
+  // Does not scroll anything. Returns false once |time| is past the end of
+  // the curve, reporting its final offset.
+  bool PositionAt(double time,
+                  gfx::Vector2dF* offset,
+                  gfx::Vector2dF* velocity);
+
+  // The offset at which the curve comes to rest.
+  gfx::Vector2dF FinalPosition() const;
+
  private:
   enum class ThreadType {
     MAIN,
@@ -71,4 +71,46 @@ TEST(WebGestureCurveImplTest, Basic) {
   EXPECT_EQ(target.current_velocity().height, 0);
 }
 
+TEST(WebGestureCurveImplTest, SkippedTicksReachTheSamePosition) {
+  gfx::Vector2dF velocity(3000, -4000);
+  base::TimeTicks time;
+  auto dense_curve = WebGestureCurveImpl::CreateFromUICurveForTesting(
+      std::unique_ptr<ui::GestureCurve>(new ui::FlingCurve(velocity, time)),
+      gfx::Vector2dF());
+  auto sparse_impl = WebGestureCurveImpl::CreateFromUICurveForTesting(
+      std::unique_ptr<ui::GestureCurve>(new ui::FlingCurve(velocity, time)),
+      gfx::Vector2dF());
+  WebGestureCurveImpl* sparse_curve =
+      static_cast<WebGestureCurveImpl*>(sparse_impl.get());
+
+  // One curve ticks at 60fps, the other at 10fps.
+  MockGestureCurveTarget dense_target;
+  MockGestureCurveTarget sparse_target;
+  for (int tick = 1; tick <= 30; ++tick) {
+    dense_curve->apply(tick / 60.0, &dense_target);
+    if (tick % 6 == 0)
+      sparse_curve->apply(tick / 60.0, &sparse_target);
+  }
+  EXPECT_NEAR(dense_target.cumulative_delta().width,
+              sparse_target.cumulative_delta().width, 0.01);
+  EXPECT_NEAR(dense_target.cumulative_delta().height,
+              sparse_target.cumulative_delta().height, 0.01);
+
+  gfx::Vector2dF offset, current_velocity;
+  EXPECT_TRUE(sparse_curve->PositionAt(0.5, &offset, &current_velocity));
+  EXPECT_NEAR(offset.x(), sparse_target.cumulative_delta().width, 0.01);
+  EXPECT_NEAR(offset.y(), sparse_target.cumulative_delta().height, 0.01);
+  EXPECT_EQ(gfx::Vector2dF(sparse_target.current_velocity()),
+            current_velocity);
+
+  // Past its end the curve reports where it comes to rest, and the ticks
+  // applied there land on it.
+  EXPECT_FALSE(sparse_curve->PositionAt(10, &offset, &current_velocity));
+  EXPECT_EQ(sparse_curve->FinalPosition(), offset);
+  EXPECT_TRUE(current_velocity.IsZero());
+  EXPECT_FALSE(sparse_curve->apply(10, &sparse_target));
+  EXPECT_NEAR(offset.x(), sparse_target.cumulative_delta().width, 0.01);
+  EXPECT_NEAR(offset.y(), sparse_target.cumulative_delta().height, 0.01);
+}
+
 }  // namespace ui
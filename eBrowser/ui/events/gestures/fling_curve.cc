@@ -86,6 +86,12 @@ bool FlingCurve::ComputeScrollOffset(base::TimeTicks time,
   return still_active;
 }
 
+gfx::Vector2dF FlingCurve::GetFinalOffset() const {
+  return gfx::ScaleVector2d(
+      displacement_ratio_,
+      GetPositionAtTime(curve_duration_) - position_offset_);
+}
+
 bool FlingCurve::ComputeScrollDeltaAtTime(base::TimeTicks current,
                                           gfx::Vector2dF* delta) {
   DCHECK(delta);
@@ -25,6 +25,7 @@ class EVENTS_BASE_EXPORT FlingCurve : public GestureCurve {
   bool ComputeScrollOffset(base::TimeTicks time,
                            gfx::Vector2dF* offset,
                            gfx::Vector2dF* velocity) override;
+  gfx::Vector2dF GetFinalOffset() const override;
 
   // In contrast to |ComputeScrollOffset()|, this method is stateful and
   // returns the *change* in scroll offset between successive calls.
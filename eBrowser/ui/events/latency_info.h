@@ -85,6 +85,9 @@ enum LatencyComponentType {
   // Timestamp of when the gesture scroll update is generated from a mouse wheel
   // event.
   INPUT_EVENT_LATENCY_GENERATE_SCROLL_UPDATE_FROM_MOUSE_WHEEL,
+  // Timestamp of when a scroll update held back to the renderer's target frame
+  // rate is released to the renderer.
+  INPUT_EVENT_LATENCY_PACED_RELEASE_COMPONENT,
   // ---------------------------TERMINAL COMPONENT-----------------------------
   // TERMINAL COMPONENT is when we show the latency end in chrome://tracing.
   // Timestamp when the mouse event is acked from renderer and it does not
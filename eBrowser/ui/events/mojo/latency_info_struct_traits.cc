@@ -62,6 +62,9 @@ ui::mojom::LatencyComponentType UILatencyComponentTypeToMojo(
     case ui::INPUT_EVENT_LATENCY_GENERATE_SCROLL_UPDATE_FROM_MOUSE_WHEEL:
       return ui::mojom::LatencyComponentType::
           INPUT_EVENT_LATENCY_GENERATE_SCROLL_UPDATE_FROM_MOUSE_WHEEL;
+    case ui::INPUT_EVENT_LATENCY_PACED_RELEASE_COMPONENT:
+      return ui::mojom::LatencyComponentType::
+          INPUT_EVENT_LATENCY_PACED_RELEASE_COMPONENT;
     case ui::INPUT_EVENT_LATENCY_TERMINATED_MOUSE_COMPONENT:
       return ui::mojom::LatencyComponentType::
           INPUT_EVENT_LATENCY_TERMINATED_MOUSE_COMPONENT;
@@ -144,6 +147,9 @@ ui::LatencyComponentType MojoLatencyComponentTypeToUI(
     case ui::mojom::LatencyComponentType::
         INPUT_EVENT_LATENCY_GENERATE_SCROLL_UPDATE_FROM_MOUSE_WHEEL:
       return ui::INPUT_EVENT_LATENCY_GENERATE_SCROLL_UPDATE_FROM_MOUSE_WHEEL;
+    case ui::mojom::LatencyComponentType::
+        INPUT_EVENT_LATENCY_PACED_RELEASE_COMPONENT:
+      return ui::INPUT_EVENT_LATENCY_PACED_RELEASE_COMPONENT;
     case ui::mojom::LatencyComponentType::
         INPUT_EVENT_LATENCY_TERMINATED_MOUSE_COMPONENT:
       return ui::INPUT_EVENT_LATENCY_TERMINATED_MOUSE_COMPONENT;
@@ -134,4 +134,10 @@ TouchEventParams::TouchEventParams(const TouchEventParams& other) = default;
 TouchEventParams::~TouchEventParams() {
 }
 
+void DeviceEventDispatcherEvdev::DispatchTouchEvents(
+    const std::vector<TouchEventParams>& params) {
+  for (const TouchEventParams& touch : params)
+    DispatchTouchEvent(touch);
+}
+
 }  // namspace ui
@@ -165,6 +165,9 @@ class EVENTS_OZONE_EVDEV_EXPORT DeviceEventDispatcherEvdev {
   virtual void DispatchPinchEvent(const PinchEventParams& params) = 0;
   virtual void DispatchScrollEvent(const ScrollEventParams& params) = 0;
   virtual void DispatchTouchEvent(const TouchEventParams& params) = 0;
+  // Dispatches touch events in order. Dispatchers that hop threads should
+  // override this to deliver the whole batch with a single task.
+  virtual void DispatchTouchEvents(const std::vector<TouchEventParams>& params);
 
   // Device lifecycle events.
   virtual void DispatchKeyboardDevicesUpdated(
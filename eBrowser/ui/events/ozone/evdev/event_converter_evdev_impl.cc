@@ -27,6 +27,10 @@ const int kKeyRepeatValue = 2;
 // Values for the EV_SW code.
 const int kSwitchStylusInserted = 15;
 
+// Number of events drained from the kernel per read. Large enough that a
+// burst of mouse or keyboard reports is handled in a single wakeup.
+const size_t kMaxEventsPerRead = 64;
+
 }  // namespace
 
 EventConverterEvdevImpl::EventConverterEvdevImpl(
@@ -59,7 +63,7 @@ void EventConverterEvdevImpl::OnFileCanReadWithoutBlocking(int fd) {
   TRACE_EVENT1("evdev", "EventConverterEvdevImpl::OnFileCanReadWithoutBlocking",
                "fd", fd);
 
-  input_event inputs[4];
+  input_event inputs[kMaxEventsPerRead];
   ssize_t read_size = read(fd, inputs, sizeof(inputs));
   if (read_size < 0) {
     if (errno == EINTR || errno == EAGAIN)
@@ -84,6 +84,13 @@ class ProxyDeviceEventDispatcher : public DeviceEventDispatcherEvdev {
                               event_factory_evdev_, params));
   }
 
+  void DispatchTouchEvents(
+      const std::vector<TouchEventParams>& params) override {
+    ui_thread_runner_->PostTask(
+        FROM_HERE, base::Bind(&EventFactoryEvdev::DispatchTouchEvents,
+                              event_factory_evdev_, params));
+  }
+
   void DispatchKeyboardDevicesUpdated(
       const std::vector<InputDevice>& devices) override {
     ui_thread_runner_->PostTask(
@@ -350,6 +357,14 @@ void EventFactoryEvdev::DispatchTouchEvent(const TouchEventParams& params) {
   }
 }
 
+void EventFactoryEvdev::DispatchTouchEvents(
+    const std::vector<TouchEventParams>& params) {
+  TRACE_EVENT1("evdev", "EventFactoryEvdev::DispatchTouchEvents", "count",
+               params.size());
+  for (const TouchEventParams& touch : params)
+    DispatchTouchEvent(touch);
+}
+
 void EventFactoryEvdev::DispatchUiEvent(Event* event) {
   // DispatchEvent takes PlatformEvent which is void*. This function
   // wraps it with the real type.
@@ -72,6 +72,7 @@ class EVENTS_OZONE_EVDEV_EXPORT EventFactoryEvdev : public DeviceEventObserver,
   void DispatchPinchEvent(const PinchEventParams& params);
   void DispatchScrollEvent(const ScrollEventParams& params);
   void DispatchTouchEvent(const TouchEventParams& params);
+  void DispatchTouchEvents(const std::vector<TouchEventParams>& params);
 
   // Device lifecycle events.
   void DispatchKeyboardDevicesUpdated(const std::vector<InputDevice>& devices);
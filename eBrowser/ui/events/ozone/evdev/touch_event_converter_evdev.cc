@@ -279,6 +279,9 @@ void TouchEventConverterEvdev::OnFileCanReadWithoutBlocking(int fd) {
 
     ProcessMultitouchEvent(inputs[i]);
   }
+
+  // Every frame completed by this read goes to the UI thread as one batch.
+  FlushTouchEvents();
 }
 
 void TouchEventConverterEvdev::DumpTouchEventLog(const char* filename) {
@@ -450,7 +453,7 @@ void TouchEventConverterEvdev::ReportTouchEvent(
     const InProgressTouchEvdev& event,
     EventType event_type,
     base::TimeTicks timestamp) {
-  dispatcher_->DispatchTouchEvent(TouchEventParams(
+  pending_touch_events_.push_back(TouchEventParams(
       input_device_.id, event.slot, event_type, gfx::PointF(event.x, event.y),
       GetEventPointerDetails(event), timestamp));
 }
@@ -458,6 +461,10 @@ void TouchEventConverterEvdev::ReportTouchEvent(
 void TouchEventConverterEvdev::ReportStylusEvent(
     const InProgressTouchEvdev& event,
     base::TimeTicks timestamp) {
+  // Stylus events are dispatched directly, so keep them behind any touches
+  // reported before them.
+  FlushTouchEvents();
+
   if (event.btn_left.changed)
     ReportButton(BTN_LEFT, event.btn_left.down, event, timestamp);
   if (event.btn_right.changed)
@@ -516,6 +523,13 @@ void TouchEventConverterEvdev::ReportEvents(base::TimeTicks timestamp) {
   }
 }
 
+void TouchEventConverterEvdev::FlushTouchEvents() {
+  if (pending_touch_events_.empty())
+    return;
+  dispatcher_->DispatchTouchEvents(pending_touch_events_);
+  pending_touch_events_.clear();
+}
+
 void TouchEventConverterEvdev::UpdateTrackingId(int slot, int tracking_id) {
   InProgressTouchEvdev* event = &events_[slot];
 
@@ -539,6 +553,7 @@ void TouchEventConverterEvdev::ReleaseTouches() {
   }
 
   ReportEvents(EventTimeForNow());
+  FlushTouchEvents();
 }
 
 void TouchEventConverterEvdev::ReleaseButtons() {
@@ -560,6 +575,7 @@ void TouchEventConverterEvdev::ReleaseButtons() {
   }
 
   ReportEvents(EventTimeForNow());
+  FlushTouchEvents();
 }
 
 float TouchEventConverterEvdev::ScalePressure(int32_t value) {
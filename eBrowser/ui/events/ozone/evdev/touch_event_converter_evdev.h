@@ -10,12 +10,14 @@
 
 #include <bitset>
 #include <memory>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/message_loop/message_pump_libevent.h"
 #include "ui/events/event_constants.h"
+#include "ui/events/ozone/evdev/device_event_dispatcher_evdev.h"
 #include "ui/events/ozone/evdev/event_converter_evdev.h"
 #include "ui/events/ozone/evdev/event_device_info.h"
 #include "ui/events/ozone/evdev/events_ozone_evdev_export.h"
@@ -27,7 +29,6 @@ class PointF;
 
 namespace ui {
 
-class DeviceEventDispatcherEvdev;
 class TouchEvent;
 class TouchNoiseFinder;
 struct InProgressTouchEvdev;
@@ -91,6 +92,8 @@ class EVENTS_OZONE_EVDEV_EXPORT TouchEventConverterEvdev
                     const InProgressTouchEvdev& event,
                     base::TimeTicks timestamp);
   void ReportEvents(base::TimeTicks timestamp);
+  // Dispatches the touch events reported since the last flush as one batch.
+  void FlushTouchEvents();
 
   void UpdateTrackingId(int slot, int tracking_id);
   void ReleaseTouches();
@@ -145,6 +148,9 @@ class EVENTS_OZONE_EVDEV_EXPORT TouchEventConverterEvdev
   // In-progress touch points.
   std::vector<InProgressTouchEvdev> events_;
 
+  // Touch events reported but not yet dispatched.
+  std::vector<TouchEventParams> pending_touch_events_;
+
   // Finds touch noise.
   std::unique_ptr<TouchNoiseFinder> touch_noise_finder_;
 
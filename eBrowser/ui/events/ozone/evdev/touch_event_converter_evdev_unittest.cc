@@ -141,6 +141,11 @@ class MockDeviceEventDispatcherEvdev : public DeviceEventDispatcherEvdev {
     generic.touch = params;
     callback_.Run(generic);
   }
+  void DispatchTouchEvents(
+      const std::vector<TouchEventParams>& params) override {
+    touch_batch_count_++;
+    DeviceEventDispatcherEvdev::DispatchTouchEvents(params);
+  }
 
   void DispatchKeyboardDevicesUpdated(
       const std::vector<InputDevice>& devices) override {}
@@ -153,8 +158,11 @@ class MockDeviceEventDispatcherEvdev : public DeviceEventDispatcherEvdev {
   void DispatchDeviceListsComplete() override {}
   void DispatchStylusStateChanged(StylusState stylus_state) override {}
 
+  int touch_batch_count() const { return touch_batch_count_; }
+
  private:
   base::Callback<void(const GenericEventParams& params)> callback_;
+  int touch_batch_count_ = 0;
 };
 
 MockTouchEventConverterEvdev::MockTouchEventConverterEvdev(
@@ -256,6 +264,7 @@ class TouchEventConverterEvdevTest : public testing::Test {
     return dispatched_events_[index].mouse_button;
   }
   void ClearDispatchedEvents() { dispatched_events_.clear(); }
+  int touch_batch_count() const { return dispatcher_->touch_batch_count(); }
 
   void DestroyDevice() { device_.reset(); }
 
@@ -503,6 +512,39 @@ TEST_F(TouchEventConverterEvdevTest, TwoFingerGesture) {
   EXPECT_FLOAT_EQ(0.17647059f, ev1.pointer_details.force);
 }
 
+TEST_F(TouchEventConverterEvdevTest, FramesInOneReadDispatchAsOneBatch) {
+  ui::MockTouchEventConverterEvdev* dev = device();
+
+  InitPixelTouchscreen(dev);
+
+  struct input_event mock_kernel_queue[] = {
+    {{0, 0}, EV_ABS, ABS_MT_TRACKING_ID, 684},
+    {{0, 0}, EV_ABS, ABS_MT_POSITION_X, 42},
+    {{0, 0}, EV_ABS, ABS_MT_POSITION_Y, 51}, {{0, 0}, EV_SYN, SYN_REPORT, 0},
+    {{0, 0}, EV_ABS, ABS_MT_POSITION_X, 40}, {{0, 0}, EV_SYN, SYN_REPORT, 0},
+    {{0, 0}, EV_ABS, ABS_MT_TRACKING_ID, -1}, {{0, 0}, EV_SYN, SYN_REPORT, 0}
+  };
+  dev->ConfigureReadMock(mock_kernel_queue, arraysize(mock_kernel_queue), 0);
+  dev->ReadNow();
+
+  // All three frames arrive in order, delivered by a single dispatch.
+  EXPECT_EQ(1, touch_batch_count());
+  EXPECT_EQ(3u, size());
+  EXPECT_EQ(ui::ET_TOUCH_PRESSED, dispatched_touch_event(0).type);
+  EXPECT_EQ(ui::ET_TOUCH_MOVED, dispatched_touch_event(1).type);
+  EXPECT_EQ(40, dispatched_touch_event(1).location.x());
+  EXPECT_EQ(ui::ET_TOUCH_RELEASED, dispatched_touch_event(2).type);
+
+  // A read with no completed frame dispatches nothing.
+  struct input_event mock_kernel_queue_partial[] = {
+    {{0, 0}, EV_ABS, ABS_MT_TRACKING_ID, 685},
+  };
+  dev->ConfigureReadMock(mock_kernel_queue_partial, 1, 0);
+  dev->ReadNow();
+  EXPECT_EQ(1, touch_batch_count());
+  EXPECT_EQ(3u, size());
+}
+
 TEST_F(TouchEventConverterEvdevTest, Unsync) {
   ui::MockTouchEventConverterEvdev* dev = device();
 
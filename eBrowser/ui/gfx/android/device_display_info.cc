@@ -43,6 +43,10 @@ double DeviceDisplayInfo::GetDIPScale() const {
   return SharedDeviceDisplayInfo::GetInstance()->GetDIPScale();
 }
 
+float DeviceDisplayInfo::GetPhysicalDpi() const {
+  return SharedDeviceDisplayInfo::GetInstance()->GetPhysicalDpi();
+}
+
 int DeviceDisplayInfo::GetSmallestDIPWidth() const {
   return SharedDeviceDisplayInfo::GetInstance()->GetSmallestDIPWidth();
 }
@@ -51,4 +55,17 @@ int DeviceDisplayInfo::GetRotationDegrees() const {
   return SharedDeviceDisplayInfo::GetInstance()->GetRotationDegrees();
 }
 
+float DeviceDisplayInfo::GetRefreshRate() const {
+  return SharedDeviceDisplayInfo::GetInstance()->GetRefreshRate();
+}
+
+std::vector<float> DeviceDisplayInfo::GetSupportedRefreshRates() const {
+  return SharedDeviceDisplayInfo::GetInstance()->GetSupportedRefreshRates();
+}
+
+// static
+void DeviceDisplayInfo::SetUpdateCallback(const base::Closure& callback) {
+  SharedDeviceDisplayInfo::GetInstance()->SetUpdateCallback(callback);
+}
+
 }  // namespace gfx
@@ -7,7 +7,9 @@
 
 #include <jni.h>
 #include <string>
+#include <vector>
 
+#include "base/callback_forward.h"
 #include "base/macros.h"
 #include "ui/gfx/gfx_export.h"
 
@@ -48,6 +50,9 @@ class GFX_EXPORT DeviceDisplayInfo {
   // (1.0 is 160dpi, 0.75 is 120dpi, 2.0 is 320dpi).
   double GetDIPScale() const;
 
+  // Returns the panel's physical pixels per inch, or 0 if it is not known.
+  float GetPhysicalDpi() const;
+
   // Smallest possible screen size in density-independent pixels.
   int GetSmallestDIPWidth() const;
 
@@ -56,6 +61,17 @@ class GFX_EXPORT DeviceDisplayInfo {
   // See DeviceDispayInfo.java for more information.
   int GetRotationDegrees() const;
 
+  // Returns the rate the display refreshes at, in Hz.
+  float GetRefreshRate() const;
+
+  // Returns the refresh rates, in Hz, the display supports at its current
+  // resolution. Empty before Android M, which cannot switch modes.
+  std::vector<float> GetSupportedRefreshRates() const;
+
+  // Runs |callback| on the UI thread whenever the information above changes.
+  // Only the last callback set is run; a null one clears it.
+  static void SetUpdateCallback(const base::Closure& callback);
+
  private:
   DISALLOW_COPY_AND_ASSIGN(DeviceDisplayInfo);
 };
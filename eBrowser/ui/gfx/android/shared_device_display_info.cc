@@ -6,6 +6,7 @@
 
 #include "base/android/context_utils.h"
 #include "base/android/jni_android.h"
+#include "base/android/jni_array.h"
 #include "base/android/jni_string.h"
 #include "base/logging.h"
 #include "jni/DeviceDisplayInfo_jni.h"
@@ -24,13 +25,18 @@ static void UpdateSharedDeviceDisplayInfo(JNIEnv* env,
                                           jint bits_per_pixel,
                                           jint bits_per_component,
                                           jdouble dip_scale,
+                                          jfloat physical_dpi,
                                           jint smallest_dip_width,
-                                          jint rotation_degrees) {
+                                          jint rotation_degrees,
+                                          jfloat refresh_rate,
+                                          const JavaParamRef<jfloatArray>&
+                                              supported_refresh_rates) {
   SharedDeviceDisplayInfo::GetInstance()->InvokeUpdate(env, obj,
       display_height, display_width,
       physical_display_height, physical_display_width,
       bits_per_pixel, bits_per_component,
-      dip_scale, smallest_dip_width, rotation_degrees);
+      dip_scale, physical_dpi, smallest_dip_width, rotation_degrees,
+      refresh_rate, supported_refresh_rates);
 }
 
 // static
@@ -78,6 +84,11 @@ double SharedDeviceDisplayInfo::GetDIPScale() {
   return dip_scale_;
 }
 
+float SharedDeviceDisplayInfo::GetPhysicalDpi() {
+  base::AutoLock autolock(lock_);
+  return physical_dpi_;
+}
+
 int SharedDeviceDisplayInfo::GetSmallestDIPWidth() {
   base::AutoLock autolock(lock_);
   DCHECK_NE(0, smallest_dip_width_);
@@ -89,6 +100,22 @@ int SharedDeviceDisplayInfo::GetRotationDegrees() {
   return rotation_degrees_;
 }
 
+float SharedDeviceDisplayInfo::GetRefreshRate() {
+  base::AutoLock autolock(lock_);
+  return refresh_rate_;
+}
+
+std::vector<float> SharedDeviceDisplayInfo::GetSupportedRefreshRates() {
+  base::AutoLock autolock(lock_);
+  return supported_refresh_rates_;
+}
+
+void SharedDeviceDisplayInfo::SetUpdateCallback(
+    const base::Closure& callback) {
+  base::AutoLock autolock(lock_);
+  update_callback_ = callback;
+}
+
 // static
 bool SharedDeviceDisplayInfo::RegisterSharedDeviceDisplayInfo(JNIEnv* env) {
   return RegisterNativesImpl(env);
@@ -103,15 +130,27 @@ void SharedDeviceDisplayInfo::InvokeUpdate(JNIEnv* env,
                                            jint bits_per_pixel,
                                            jint bits_per_component,
                                            jdouble dip_scale,
+                                           jfloat physical_dpi,
                                            jint smallest_dip_width,
-                                           jint rotation_degrees) {
-  base::AutoLock autolock(lock_);
-
-  UpdateDisplayInfo(env, obj,
-      display_height, display_width,
-      physical_display_height, physical_display_width,
-      bits_per_pixel, bits_per_component, dip_scale,
-      smallest_dip_width, rotation_degrees);
+                                           jint rotation_degrees,
+                                           jfloat refresh_rate,
+                                           jfloatArray
+                                               supported_refresh_rates) {
+  base::Closure update_callback;
+  {
+    base::AutoLock autolock(lock_);
+
+    UpdateDisplayInfo(env, obj,
+        display_height, display_width,
+        physical_display_height, physical_display_width,
+        bits_per_pixel, bits_per_component, dip_scale, physical_dpi,
+        smallest_dip_width, rotation_degrees,
+        refresh_rate, supported_refresh_rates);
+    update_callback = update_callback_;
+  }
+  // Observers read the info back, so the lock must not be held.
+  if (!update_callback.is_null())
+    update_callback.Run();
 }
 
 SharedDeviceDisplayInfo::SharedDeviceDisplayInfo()
@@ -120,7 +159,9 @@ SharedDeviceDisplayInfo::SharedDeviceDisplayInfo()
       bits_per_pixel_(0),
       bits_per_component_(0),
       dip_scale_(0),
-      smallest_dip_width_(0) {
+      physical_dpi_(0),
+      smallest_dip_width_(0),
+      refresh_rate_(0) {
   JNIEnv* env = base::android::AttachCurrentThread();
   j_device_info_.Reset(
       Java_DeviceDisplayInfo_create(
@@ -134,8 +175,12 @@ SharedDeviceDisplayInfo::SharedDeviceDisplayInfo()
       Java_DeviceDisplayInfo_getBitsPerPixel(env, j_device_info_),
       Java_DeviceDisplayInfo_getBitsPerComponent(env, j_device_info_),
       Java_DeviceDisplayInfo_getDIPScale(env, j_device_info_),
+      Java_DeviceDisplayInfo_getPhysicalDpi(env, j_device_info_),
       Java_DeviceDisplayInfo_getSmallestDIPWidth(env, j_device_info_),
-      Java_DeviceDisplayInfo_getRotationDegrees(env, j_device_info_));
+      Java_DeviceDisplayInfo_getRotationDegrees(env, j_device_info_),
+      Java_DeviceDisplayInfo_getRefreshRate(env, j_device_info_),
+      Java_DeviceDisplayInfo_getSupportedRefreshRates(env, j_device_info_)
+          .obj());
 }
 
 SharedDeviceDisplayInfo::~SharedDeviceDisplayInfo() {
@@ -150,8 +195,12 @@ void SharedDeviceDisplayInfo::UpdateDisplayInfo(JNIEnv* env,
                                                 jint bits_per_pixel,
                                                 jint bits_per_component,
                                                 jdouble dip_scale,
+                                                jfloat physical_dpi,
                                                 jint smallest_dip_width,
-                                                jint rotation_degrees) {
+                                                jint rotation_degrees,
+                                                jfloat refresh_rate,
+                                                jfloatArray
+                                                    supported_refresh_rates) {
   display_height_ = static_cast<int>(display_height);
   display_width_ = static_cast<int>(display_width);
   physical_display_height_ = static_cast<int>(physical_display_height);
@@ -159,8 +208,15 @@ void SharedDeviceDisplayInfo::UpdateDisplayInfo(JNIEnv* env,
   bits_per_pixel_ = static_cast<int>(bits_per_pixel);
   bits_per_component_ = static_cast<int>(bits_per_component);
   dip_scale_ = static_cast<double>(dip_scale);
+  physical_dpi_ = static_cast<float>(physical_dpi);
   smallest_dip_width_ = static_cast<int>(smallest_dip_width);
   rotation_degrees_ = static_cast<int>(rotation_degrees);
+  refresh_rate_ = static_cast<float>(refresh_rate);
+  supported_refresh_rates_.clear();
+  if (supported_refresh_rates) {
+    base::android::JavaFloatArrayToFloatVector(env, supported_refresh_rates,
+                                               &supported_refresh_rates_);
+  }
 }
 
 }  // namespace gfx
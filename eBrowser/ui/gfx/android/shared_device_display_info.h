@@ -5,7 +5,10 @@
 #ifndef UI_GFX_ANDROID_SHARED_DEVICE_DISPLAY_INFO_H_
 #define UI_GFX_ANDROID_SHARED_DEVICE_DISPLAY_INFO_H_
 
+#include <vector>
+
 #include "base/android/scoped_java_ref.h"
+#include "base/callback.h"
 #include "base/macros.h"
 #include "base/memory/singleton.h"
 #include "base/synchronization/lock.h"
@@ -26,8 +29,15 @@ class SharedDeviceDisplayInfo {
   int GetBitsPerPixel();
   int GetBitsPerComponent();
   double GetDIPScale();
+  float GetPhysicalDpi();
   int GetSmallestDIPWidth();
   int GetRotationDegrees();
+  float GetRefreshRate();
+  std::vector<float> GetSupportedRefreshRates();
+
+  // Runs |callback| on the thread Java updates the info on, after every
+  // update. Only one callback is kept.
+  void SetUpdateCallback(const base::Closure& callback);
 
   // Registers methods with JNI and returns true if succeeded.
   static bool RegisterSharedDeviceDisplayInfo(JNIEnv* env);
@@ -41,8 +51,11 @@ class SharedDeviceDisplayInfo {
                     jint bits_per_pixel,
                     jint bits_per_component,
                     jdouble dip_scale,
+                    jfloat physical_dpi,
                     jint smallest_dip_width,
-                    jint rotation_degrees);
+                    jint rotation_degrees,
+                    jfloat refresh_rate,
+                    jfloatArray supported_refresh_rates);
  private:
   friend struct base::DefaultSingletonTraits<SharedDeviceDisplayInfo>;
 
@@ -57,8 +70,11 @@ class SharedDeviceDisplayInfo {
                          jint bits_per_pixel,
                          jint bits_per_component,
                          jdouble dip_scale,
+                         jfloat physical_dpi,
                          jint smallest_dip_width,
-                         jint rotation_degrees);
+                         jint rotation_degrees,
+                         jfloat refresh_rate,
+                         jfloatArray supported_refresh_rates);
 
   base::Lock lock_;
   base::android::ScopedJavaGlobalRef<jobject> j_device_info_;
@@ -70,8 +86,13 @@ class SharedDeviceDisplayInfo {
   int bits_per_pixel_;
   int bits_per_component_;
   double dip_scale_;
+  float physical_dpi_;
   int smallest_dip_width_;
   int rotation_degrees_;
+  float refresh_rate_;
+  std::vector<float> supported_refresh_rates_;
+
+  base::Closure update_callback_;
 
   DISALLOW_COPY_AND_ASSIGN(SharedDeviceDisplayInfo);
 };
@@ -0,0 +1,46 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/codec/decode_destination.h"
+
+#include "base/logging.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace gfx {
+
+VectorDecodeDestination::VectorDecodeDestination(
+    std::vector<unsigned char>* output)
+    : output_(output) {
+  DCHECK(output_);
+}
+
+VectorDecodeDestination::~VectorDecodeDestination() {}
+
+unsigned char* VectorDecodeDestination::Allocate(int width,
+                                                 int height,
+                                                 int bytes_per_pixel,
+                                                 size_t* row_bytes) {
+  *row_bytes = static_cast<size_t>(width) * bytes_per_pixel;
+  output_->resize(*row_bytes * height);
+  return output_->empty() ? nullptr : &output_->front();
+}
+
+SkBitmapDecodeDestination::SkBitmapDecodeDestination(SkBitmap* bitmap)
+    : bitmap_(bitmap) {
+  DCHECK(bitmap_);
+}
+
+SkBitmapDecodeDestination::~SkBitmapDecodeDestination() {}
+
+unsigned char* SkBitmapDecodeDestination::Allocate(int width,
+                                                   int height,
+                                                   int bytes_per_pixel,
+                                                   size_t* row_bytes) {
+  if (bytes_per_pixel != 4 || !bitmap_->tryAllocN32Pixels(width, height))
+    return nullptr;
+  *row_bytes = bitmap_->rowBytes();
+  return static_cast<unsigned char*>(bitmap_->getPixels());
+}
+
+}  // namespace gfx
@@ -0,0 +1,76 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_GFX_CODEC_DECODE_DESTINATION_H_
+#define UI_GFX_CODEC_DECODE_DESTINATION_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "ui/gfx/gfx_export.h"
+
+class SkBitmap;
+
+namespace gfx {
+
+// The memory a streaming PNGCodec or JPEGCodec decode writes its rows into.
+// The decoder asks for it once the image size is known, so callers can hand
+// out discardable, shared or GPU-mapped memory and avoid an extra copy.
+class GFX_EXPORT DecodeDestination {
+ public:
+  virtual ~DecodeDestination() {}
+
+  // Called once, before any pixels are written, with the dimensions of the
+  // decoded image. Returns the start of the first row and sets |*row_bytes| to
+  // the distance between rows, which must be at least
+  // |width| * |bytes_per_pixel|. The memory must stay valid until the decode
+  // returns. Returning null fails the decode.
+  virtual unsigned char* Allocate(int width,
+                                  int height,
+                                  int bytes_per_pixel,
+                                  size_t* row_bytes) = 0;
+};
+
+// Decodes into a tightly packed vector, resized to fit the image.
+class GFX_EXPORT VectorDecodeDestination : public DecodeDestination {
+ public:
+  explicit VectorDecodeDestination(std::vector<unsigned char>* output);
+  ~VectorDecodeDestination() override;
+
+  // DecodeDestination:
+  unsigned char* Allocate(int width,
+                          int height,
+                          int bytes_per_pixel,
+                          size_t* row_bytes) override;
+
+ private:
+  std::vector<unsigned char>* output_;
+
+  DISALLOW_COPY_AND_ASSIGN(VectorDecodeDestination);
+};
+
+// Decodes 4 byte per pixel formats straight into the pixels of |bitmap|,
+// which is allocated as an N32 bitmap of the image size.
+class GFX_EXPORT SkBitmapDecodeDestination : public DecodeDestination {
+ public:
+  explicit SkBitmapDecodeDestination(SkBitmap* bitmap);
+  ~SkBitmapDecodeDestination() override;
+
+  // DecodeDestination:
+  unsigned char* Allocate(int width,
+                          int height,
+                          int bytes_per_pixel,
+                          size_t* row_bytes) override;
+
+ private:
+  SkBitmap* bitmap_;
+
+  DISALLOW_COPY_AND_ASSIGN(SkBitmapDecodeDestination);
+};
+
+}  // namespace gfx
+
+#endif  // UI_GFX_CODEC_DECODE_DESTINATION_H_
@@ -11,6 +11,7 @@
 #include "base/logging.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColorPriv.h"
+#include "ui/gfx/codec/decode_destination.h"
 
 extern "C" {
 #if defined(USE_SYSTEM_LIBJPEG)
@@ -447,15 +448,21 @@ class DecompressDestroyer {
   jpeg_decompress_struct* cinfo_;
 };
 
-}  // namespace
+// Decodes |input| scanline by scanline into the memory |destination|
+// provides, letting libjpeg's DCT scaling shrink the output by
+// |scale_denominator|.
+bool DecodeToDestination(const unsigned char* input, size_t input_size,
+                         JPEGCodec::ColorFormat format, int scale_denominator,
+                         DecodeDestination* destination, int* w, int* h) {
+  if (scale_denominator != 1 && scale_denominator != 2 &&
+      scale_denominator != 4 && scale_denominator != 8) {
+    NOTREACHED() << "Invalid scale denominator";
+    return false;
+  }
 
-bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
-                       ColorFormat format, std::vector<unsigned char>* output,
-                       int* w, int* h) {
   jpeg_decompress_struct cinfo;
   DecompressDestroyer destroyer;
   destroyer.SetManagedObject(&cinfo);
-  output->clear();
 
   // We set up the normal JPEG error routines, then override error_exit.
   // This must be done before the call to create_decompress.
@@ -501,15 +508,15 @@ bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
       // Same as JPEGCodec::Encode(), libjpeg-turbo supports all input formats
       // used by Chromium (i.e. RGB, RGBA, and BGRA) and we just map the input
       // parameters to a colorspace.
-      if (format == FORMAT_RGB) {
+      if (format == JPEGCodec::FORMAT_RGB) {
         cinfo.out_color_space = JCS_RGB;
         cinfo.output_components = 3;
-      } else if (format == FORMAT_RGBA ||
-                 (format == FORMAT_SkBitmap && SK_R32_SHIFT == 0)) {
+      } else if (format == JPEGCodec::FORMAT_RGBA ||
+                 (format == JPEGCodec::FORMAT_SkBitmap && SK_R32_SHIFT == 0)) {
         cinfo.out_color_space = JCS_EXT_RGBX;
         cinfo.output_components = 4;
-      } else if (format == FORMAT_BGRA ||
-                 (format == FORMAT_SkBitmap && SK_B32_SHIFT == 0)) {
+      } else if (format == JPEGCodec::FORMAT_BGRA ||
+                 (format == JPEGCodec::FORMAT_SkBitmap && SK_B32_SHIFT == 0)) {
         cinfo.out_color_space = JCS_EXT_BGRX;
         cinfo.output_components = 4;
       } else {
@@ -534,91 +541,110 @@ bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
   cinfo.output_components = 3;
 #endif
 
+  // Scaling happens in the IDCT, so a smaller output is also a faster decode.
+  cinfo.scale_num = 1;
+  cinfo.scale_denom = scale_denominator;
+
   jpeg_calc_output_dimensions(&cinfo);
   *w = cinfo.output_width;
   *h = cinfo.output_height;
 
-  jpeg_start_decompress(&cinfo);
+#ifdef JCS_EXTENSIONS
+  int bytes_per_pixel = cinfo.output_components;
+#else
+  void (*converter)(const unsigned char* rgb, int w, unsigned char* out) =
+      NULL;
+  int bytes_per_pixel = 3;
+  if (format == JPEGCodec::FORMAT_RGBA ||
+      (format == JPEGCodec::FORMAT_SkBitmap && SK_R32_SHIFT == 0)) {
+    converter = AddAlpha;
+    bytes_per_pixel = 4;
+  } else if (format == JPEGCodec::FORMAT_BGRA ||
+             (format == JPEGCodec::FORMAT_SkBitmap && SK_B32_SHIFT == 0)) {
+    converter = RGBtoBGRA;
+    bytes_per_pixel = 4;
+  } else if (format != JPEGCodec::FORMAT_RGB) {
+    NOTREACHED() << "Invalid pixel format";
+    return false;
+  }
+#endif
 
-  // FIXME(brettw) we may want to allow the capability for callers to request
-  // how to align row lengths as we do for the compressor.
-  int row_read_stride = cinfo.output_width * cinfo.output_components;
+  size_t row_write_stride = 0;
+  unsigned char* pixels =
+      destination->Allocate(*w, *h, bytes_per_pixel, &row_write_stride);
+  if (!pixels ||
+      row_write_stride < static_cast<size_t>(*w) * bytes_per_pixel) {
+    return false;
+  }
 
-#ifdef JCS_EXTENSIONS
-  // Create memory for a decoded image and write decoded lines to the memory
-  // without conversions same as JPEGCodec::Encode().
-  int row_write_stride = row_read_stride;
-  output->resize(row_write_stride * cinfo.output_height);
+  jpeg_start_decompress(&cinfo);
 
+#ifdef JCS_EXTENSIONS
+  // Write decoded lines to the destination without conversions, same as
+  // JPEGCodec::Encode().
   for (int row = 0; row < static_cast<int>(cinfo.output_height); row++) {
-    unsigned char* rowptr = &(*output)[row * row_write_stride];
+    unsigned char* rowptr = pixels + row * row_write_stride;
     if (!jpeg_read_scanlines(&cinfo, &rowptr, 1))
       return false;
   }
 #else
-  if (format == FORMAT_RGB) {
+  if (!converter) {
     // easy case, row needs no conversion
-    int row_write_stride = row_read_stride;
-    output->resize(row_write_stride * cinfo.output_height);
-
     for (int row = 0; row < static_cast<int>(cinfo.output_height); row++) {
-      unsigned char* rowptr = &(*output)[row * row_write_stride];
+      unsigned char* rowptr = pixels + row * row_write_stride;
       if (!jpeg_read_scanlines(&cinfo, &rowptr, 1))
         return false;
     }
   } else {
-    // Rows need conversion to output format: read into a temporary buffer and
-    // expand to the final one. Performance: we could avoid the extra
-    // allocation by doing the expansion in-place.
-    int row_write_stride;
-    void (*converter)(const unsigned char* rgb, int w, unsigned char* out);
-    if (format == FORMAT_RGBA ||
-        (format == FORMAT_SkBitmap && SK_R32_SHIFT == 0)) {
-      row_write_stride = cinfo.output_width * 4;
-      converter = AddAlpha;
-    } else if (format == FORMAT_BGRA ||
-               (format == FORMAT_SkBitmap && SK_B32_SHIFT == 0)) {
-      row_write_stride = cinfo.output_width * 4;
-      converter = RGBtoBGRA;
-    } else {
-      NOTREACHED() << "Invalid pixel format";
-      jpeg_destroy_decompress(&cinfo);
-      return false;
-    }
-
-    output->resize(row_write_stride * cinfo.output_height);
-
+    // Rows need conversion to output format: read into a temporary row and
+    // expand it into the destination.
+    int row_read_stride = cinfo.output_width * cinfo.output_components;
     std::unique_ptr<unsigned char[]> row_data(
         new unsigned char[row_read_stride]);
     unsigned char* rowptr = row_data.get();
     for (int row = 0; row < static_cast<int>(cinfo.output_height); row++) {
       if (!jpeg_read_scanlines(&cinfo, &rowptr, 1))
         return false;
-      converter(rowptr, *w, &(*output)[row * row_write_stride]);
+      converter(rowptr, *w, pixels + row * row_write_stride);
     }
   }
 #endif
 
   jpeg_finish_decompress(&cinfo);
-  jpeg_destroy_decompress(&cinfo);
   return true;
 }
 
+}  // namespace
+
+bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
+                       ColorFormat format, std::vector<unsigned char>* output,
+                       int* w, int* h) {
+  output->clear();
+  VectorDecodeDestination destination(output);
+  return DecodeToDestination(input, input_size, format, 1, &destination, w, h);
+}
+
+// static
+bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
+                       ColorFormat format, int scale_denominator,
+                       DecodeDestination* destination, int* w, int* h) {
+  DCHECK(destination);
+  return DecodeToDestination(input, input_size, format, scale_denominator,
+                             destination, w, h);
+}
+
 // static
 std::unique_ptr<SkBitmap> JPEGCodec::Decode(const unsigned char* input,
                                             size_t input_size) {
+  // Decode straight into the bitmap's pixels rather than copying them out of
+  // an intermediate buffer.
+  std::unique_ptr<SkBitmap> bitmap(new SkBitmap());
+  SkBitmapDecodeDestination destination(bitmap.get());
   int w, h;
-  std::vector<unsigned char> data_vector;
-  if (!Decode(input, input_size, FORMAT_SkBitmap, &data_vector, &w, &h))
+  if (!DecodeToDestination(input, input_size, FORMAT_SkBitmap, 1, &destination,
+                           &w, &h)) {
     return nullptr;
-
-  // Skia only handles 32 bit images.
-  int data_length = w * h * 4;
-
-  std::unique_ptr<SkBitmap> bitmap(new SkBitmap());
-  bitmap->allocN32Pixels(w, h);
-  memcpy(bitmap->getAddr32(0, 0), &data_vector[0], data_length);
-
+  }
   return bitmap;
 }
 
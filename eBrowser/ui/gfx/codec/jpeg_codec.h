@@ -16,6 +16,8 @@ class SkBitmap;
 
 namespace gfx {
 
+class DecodeDestination;
+
 // Interface for encoding/decoding JPEG data. This is a wrapper around libjpeg,
 // which has an inconvenient interface for callers. This is only used for UI
 // elements, WebKit has its own more complicated JPEG decoder which handles,
@@ -70,6 +72,18 @@ class GFX_EXPORT JPEGCodec {
                      ColorFormat format, std::vector<unsigned char>* output,
                      int* w, int* h);
 
+  // Decodes the JPEG data contained in input of length input_size, writing
+  // each scanline in 'format' straight into the memory |destination| provides,
+  // with no intermediate copy of the image. |scale_denominator| is 1, 2, 4 or
+  // 8 and shrinks the output by that factor in each dimension, rounding up,
+  // as part of the DCT; this is much cheaper than decoding at full size and
+  // resizing. The output dimensions are placed in *w and *h on success
+  // (returns true). On failure the contents of the destination memory are
+  // undefined.
+  static bool Decode(const unsigned char* input, size_t input_size,
+                     ColorFormat format, int scale_denominator,
+                     DecodeDestination* destination, int* w, int* h);
+
   // Decodes the JPEG data contained in input of length input_size. If
   // successful, a SkBitmap is created and returned.
   static std::unique_ptr<SkBitmap> Decode(const unsigned char* input,
@@ -8,6 +8,7 @@
 
 #include "base/macros.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/codec/decode_destination.h"
 #include "ui/gfx/codec/jpeg_codec.h"
 
 namespace {
@@ -100,6 +101,55 @@ static void MakeRGBImage(int w, int h, std::vector<unsigned char>* dat) {
   }
 }
 
+namespace {
+
+// Hands out rows padded by |padding| bytes, the way a destination backed by
+// aligned or GPU-mapped memory would.
+class PaddedDecodeDestination : public DecodeDestination {
+ public:
+  explicit PaddedDecodeDestination(size_t padding)
+      : padding_(padding), width_(0), height_(0), bytes_per_pixel_(0) {}
+  ~PaddedDecodeDestination() override {}
+
+  unsigned char* Allocate(int width,
+                          int height,
+                          int bytes_per_pixel,
+                          size_t* row_bytes) override {
+    width_ = width;
+    height_ = height;
+    bytes_per_pixel_ = bytes_per_pixel;
+    *row_bytes = RowBytes();
+    data_.assign(*row_bytes * height, 0);
+    return data_.data();
+  }
+
+  // Returns the decoded image with the row padding removed.
+  std::vector<unsigned char> Packed() const {
+    std::vector<unsigned char> packed;
+    size_t packed_row = static_cast<size_t>(width_) * bytes_per_pixel_;
+    for (int y = 0; y < height_; y++) {
+      const unsigned char* row = &data_[y * RowBytes()];
+      packed.insert(packed.end(), row, row + packed_row);
+    }
+    return packed;
+  }
+
+ private:
+  size_t RowBytes() const {
+    return static_cast<size_t>(width_) * bytes_per_pixel_ + padding_;
+  }
+
+  const size_t padding_;
+  int width_;
+  int height_;
+  int bytes_per_pixel_;
+  std::vector<unsigned char> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(PaddedDecodeDestination);
+};
+
+}  // namespace
+
 TEST(JPEGCodec, EncodeDecodeRGB) {
   int w = 20, h = 20;
 
@@ -166,6 +216,58 @@ TEST(JPEGCodec, EncodeDecodeRGBA) {
   ASSERT_GE(jpeg_equality_threshold, AveragePixelDelta(original, decoded));
 }
 
+TEST(JPEGCodec, DecodeToDestination) {
+  int w = 20, h = 20;
+  std::vector<unsigned char> original;
+  MakeRGBImage(w, h, &original);
+  std::vector<unsigned char> encoded;
+  ASSERT_TRUE(JPEGCodec::Encode(&original[0], JPEGCodec::FORMAT_RGB, w, h,
+                                w * 3, jpeg_quality, &encoded));
+
+  std::vector<unsigned char> decoded;
+  int outw, outh;
+  ASSERT_TRUE(JPEGCodec::Decode(&encoded[0], encoded.size(),
+                                JPEGCodec::FORMAT_RGBA, &decoded,
+                                &outw, &outh));
+
+  // Decoding into padded rows gives the same pixels as the vector decode.
+  PaddedDecodeDestination destination(12);
+  int streamed_w, streamed_h;
+  ASSERT_TRUE(JPEGCodec::Decode(&encoded[0], encoded.size(),
+                                JPEGCodec::FORMAT_RGBA, 1, &destination,
+                                &streamed_w, &streamed_h));
+  EXPECT_EQ(outw, streamed_w);
+  EXPECT_EQ(outh, streamed_h);
+  EXPECT_TRUE(decoded == destination.Packed());
+}
+
+TEST(JPEGCodec, DecodeScaled) {
+  int w = 20, h = 20;
+  std::vector<unsigned char> original;
+  MakeRGBImage(w, h, &original);
+  std::vector<unsigned char> encoded;
+  ASSERT_TRUE(JPEGCodec::Encode(&original[0], JPEGCodec::FORMAT_RGB, w, h,
+                                w * 3, jpeg_quality, &encoded));
+
+  // The DCT scales dimensions down, rounding up.
+  const struct {
+    int denominator;
+    int size;
+  } kCases[] = {{2, 10}, {4, 5}, {8, 3}};
+  for (const auto& test_case : kCases) {
+    PaddedDecodeDestination destination(0);
+    int outw, outh;
+    ASSERT_TRUE(JPEGCodec::Decode(&encoded[0], encoded.size(),
+                                  JPEGCodec::FORMAT_RGB,
+                                  test_case.denominator, &destination,
+                                  &outw, &outh));
+    EXPECT_EQ(test_case.size, outw);
+    EXPECT_EQ(test_case.size, outh);
+    EXPECT_EQ(static_cast<size_t>(outw * outh * 3),
+              destination.Packed().size());
+  }
+}
+
 // Test that corrupted data decompression causes failures.
 TEST(JPEGCodec, DecodeCorrupted) {
   int w = 20, h = 20;
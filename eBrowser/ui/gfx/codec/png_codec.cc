@@ -14,6 +14,7 @@
 #include "third_party/skia/include/core/SkColorPriv.h"
 #include "third_party/skia/include/core/SkUnPreMultiply.h"
 #include "third_party/zlib/zlib.h"
+#include "ui/gfx/codec/decode_destination.h"
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/skia_util.h"
 
@@ -81,25 +82,13 @@ const double kInverseGamma = 1.0 / kDefaultGamma;
 
 class PngDecoderState {
  public:
-  // Output is a vector<unsigned char>.
-  PngDecoderState(PNGCodec::ColorFormat ofmt, std::vector<unsigned char>* o)
+  PngDecoderState(PNGCodec::ColorFormat ofmt, DecodeDestination* destination)
       : output_format(ofmt),
         output_channels(0),
-        bitmap(NULL),
         is_opaque(true),
-        output(o),
-        width(0),
-        height(0),
-        done(false) {
-  }
-
-  // Output is an SkBitmap.
-  explicit PngDecoderState(SkBitmap* skbitmap)
-      : output_format(PNGCodec::FORMAT_SkBitmap),
-        output_channels(0),
-        bitmap(skbitmap),
-        is_opaque(true),
-        output(NULL),
+        destination(destination),
+        pixels(NULL),
+        row_bytes(0),
         width(0),
         height(0),
         done(false) {
@@ -108,16 +97,17 @@ class PngDecoderState {
   PNGCodec::ColorFormat output_format;
   int output_channels;
 
-  // An incoming SkBitmap to write to. If NULL, we write to output instead.
-  SkBitmap* bitmap;
-
   // Used during the reading of an SkBitmap. Defaults to true until we see a
   // pixel with anything other than an alpha of 255.
   bool is_opaque;
 
-  // The other way to decode output, where we write into an intermediary buffer
-  // instead of directly to an SkBitmap.
-  std::vector<unsigned char>* output;
+  // Provides the memory rows are written to once the size is known.
+  DecodeDestination* destination;
+
+  // The first row of the memory |destination| provided, and the distance
+  // between rows.
+  unsigned char* pixels;
+  size_t row_bytes;
 
   // Size of the image, set in the info callback.
   int width;
@@ -273,11 +263,12 @@ void DecodeInfoCallback(png_struct* png_ptr, png_info* info_ptr) {
 
   png_read_update_info(png_ptr, info_ptr);
 
-  if (state->bitmap) {
-    state->bitmap->allocN32Pixels(state->width, state->height);
-  } else if (state->output) {
-    state->output->resize(
-        state->width * state->output_channels * state->height);
+  state->pixels = state->destination->Allocate(
+      state->width, state->height, state->output_channels, &state->row_bytes);
+  if (!state->pixels ||
+      state->row_bytes <
+          static_cast<size_t>(state->width) * state->output_channels) {
+    longjmp(png_jmpbuf(png_ptr), 1);
   }
 }
 
@@ -289,18 +280,12 @@ void DecodeRowCallback(png_struct* png_ptr, png_byte* new_row,
   PngDecoderState* state = static_cast<PngDecoderState*>(
       png_get_progressive_ptr(png_ptr));
 
-  if (static_cast<int>(row_num) > state->height) {
+  if (static_cast<int>(row_num) >= state->height) {
     NOTREACHED() << "Invalid row";
     return;
   }
 
-  unsigned char* base = NULL;
-  if (state->bitmap)
-    base = reinterpret_cast<unsigned char*>(state->bitmap->getAddr32(0, 0));
-  else if (state->output)
-    base = &state->output->front();
-
-  unsigned char* dest = &base[state->width * state->output_channels * row_num];
+  unsigned char* dest = state->pixels + state->row_bytes * row_num;
   png_progressive_combine_row(png_ptr, dest, new_row);
 }
 
@@ -389,12 +374,13 @@ void LogLibPNGEncodeWarning(png_structp png_ptr, png_const_charp warning_msg) {
   DLOG(ERROR) << "libpng encode warning: " << warning_msg;
 }
 
-}  // namespace
-
-// static
-bool PNGCodec::Decode(const unsigned char* input, size_t input_size,
-                      ColorFormat format, std::vector<unsigned char>* output,
-                      int* w, int* h) {
+// Decodes |input| row by row into the memory |destination| provides. Sets
+// |*is_opaque| to whether every pixel had alpha 255; this is only tracked for
+// FORMAT_SkBitmap.
+bool DecodeToDestination(const unsigned char* input, size_t input_size,
+                         PNGCodec::ColorFormat format,
+                         DecodeDestination* destination,
+                         int* w, int* h, bool* is_opaque) {
   png_struct* png_ptr = NULL;
   png_info* info_ptr = NULL;
   if (!BuildPNGStruct(input, input_size, &png_ptr, &info_ptr))
@@ -408,7 +394,7 @@ bool PNGCodec::Decode(const unsigned char* input, size_t input_size,
     return false;
   }
 
-  PngDecoderState state(format, output);
+  PngDecoderState state(format, destination);
 
   png_set_error_fn(png_ptr, NULL, LogLibPNGDecodeError, LogLibPNGDecodeWarning);
   png_set_progressive_read_fn(png_ptr, &state, &DecodeInfoCallback,
@@ -421,52 +407,60 @@ bool PNGCodec::Decode(const unsigned char* input, size_t input_size,
   if (!state.done) {
     // Fed it all the data but the library didn't think we got all the data, so
     // this file must be truncated.
-    output->clear();
     return false;
   }
 
   *w = state.width;
   *h = state.height;
+  *is_opaque = state.is_opaque;
   return true;
 }
 
+}  // namespace
+
 // static
 bool PNGCodec::Decode(const unsigned char* input, size_t input_size,
-                      SkBitmap* bitmap) {
-  DCHECK(bitmap);
-  png_struct* png_ptr = NULL;
-  png_info* info_ptr = NULL;
-  if (!BuildPNGStruct(input, input_size, &png_ptr, &info_ptr))
-    return false;
-
-  PngReadStructDestroyer destroyer(&png_ptr, &info_ptr);
-  if (setjmp(png_jmpbuf(png_ptr))) {
-    // The destroyer will ensure that the structures are cleaned up in this
-    // case, even though we may get here as a jump from random parts of the
-    // PNG library called below.
+                      ColorFormat format, std::vector<unsigned char>* output,
+                      int* w, int* h) {
+  VectorDecodeDestination destination(output);
+  bool is_opaque;
+  if (!DecodeToDestination(input, input_size, format, &destination, w, h,
+                           &is_opaque)) {
+    output->clear();
     return false;
   }
+  return true;
+}
 
-  PngDecoderState state(bitmap);
-
-  png_set_progressive_read_fn(png_ptr, &state, &DecodeInfoCallback,
-                              &DecodeRowCallback, &DecodeEndCallback);
-  png_process_data(png_ptr,
-                   info_ptr,
-                   const_cast<unsigned char*>(input),
-                   input_size);
-
-  if (!state.done) {
+// static
+bool PNGCodec::Decode(const unsigned char* input, size_t input_size,
+                      SkBitmap* bitmap) {
+  DCHECK(bitmap);
+  SkBitmapDecodeDestination destination(bitmap);
+  int w, h;
+  bool is_opaque;
+  if (!DecodeToDestination(input, input_size, FORMAT_SkBitmap, &destination,
+                           &w, &h, &is_opaque)) {
     return false;
   }
 
   // Set the bitmap's opaqueness based on what we saw.
-  bitmap->setAlphaType(state.is_opaque ?
+  bitmap->setAlphaType(is_opaque ?
                        kOpaque_SkAlphaType : kPremul_SkAlphaType);
 
   return true;
 }
 
+// static
+bool PNGCodec::Decode(const unsigned char* input, size_t input_size,
+                      ColorFormat format, DecodeDestination* destination,
+                      int* w, int* h) {
+  DCHECK(destination);
+  bool is_opaque;
+  return DecodeToDestination(input, input_size, format, destination, w, h,
+                             &is_opaque);
+}
+
 // Encoder --------------------------------------------------------------------
 //
 // This section of the code is based on nsPNGEncoder.cpp in Mozilla
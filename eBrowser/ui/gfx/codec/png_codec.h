@@ -17,6 +17,7 @@ class SkBitmap;
 
 namespace gfx {
 
+class DecodeDestination;
 class Size;
 
 // Interface for encoding and decoding PNG data. This is a wrapper around
@@ -127,6 +128,15 @@ class GFX_EXPORT PNGCodec {
   static bool Decode(const unsigned char* input, size_t input_size,
                      SkBitmap* bitmap);
 
+  // Decodes the PNG data contained in input of length input_size, writing
+  // each row in 'format' straight into the memory |destination| provides as
+  // soon as libpng produces it, with no intermediate copy of the image. The
+  // dimensions are placed in *w and *h on success (returns true). On failure
+  // the contents of the destination memory are undefined.
+  static bool Decode(const unsigned char* input, size_t input_size,
+                     ColorFormat format, DecodeDestination* destination,
+                     int* w, int* h);
+
  private:
   DISALLOW_COPY_AND_ASSIGN(PNGCodec);
 };
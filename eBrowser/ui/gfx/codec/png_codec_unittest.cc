@@ -16,6 +16,7 @@
 #include "third_party/skia/include/core/SkColorPriv.h"
 #include "third_party/skia/include/core/SkUnPreMultiply.h"
 #include "third_party/zlib/zlib.h"
+#include "ui/gfx/codec/decode_destination.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/skia_util.h"
@@ -235,6 +236,51 @@ bool EncodeImage(const std::vector<unsigned char>& input,
   return true;
 }
 
+// Hands out rows padded by |padding| bytes, the way a destination backed by
+// aligned or GPU-mapped memory would.
+class PaddedDecodeDestination : public DecodeDestination {
+ public:
+  explicit PaddedDecodeDestination(size_t padding)
+      : padding_(padding), width_(0), height_(0), bytes_per_pixel_(0) {}
+  ~PaddedDecodeDestination() override {}
+
+  unsigned char* Allocate(int width,
+                          int height,
+                          int bytes_per_pixel,
+                          size_t* row_bytes) override {
+    width_ = width;
+    height_ = height;
+    bytes_per_pixel_ = bytes_per_pixel;
+    *row_bytes = RowBytes();
+    data_.assign(*row_bytes * height, 0);
+    return data_.data();
+  }
+
+  // Returns the decoded image with the row padding removed.
+  std::vector<unsigned char> Packed() const {
+    std::vector<unsigned char> packed;
+    size_t packed_row = static_cast<size_t>(width_) * bytes_per_pixel_;
+    for (int y = 0; y < height_; y++) {
+      const unsigned char* row = &data_[y * RowBytes()];
+      packed.insert(packed.end(), row, row + packed_row);
+    }
+    return packed;
+  }
+
+ private:
+  size_t RowBytes() const {
+    return static_cast<size_t>(width_) * bytes_per_pixel_ + padding_;
+  }
+
+  const size_t padding_;
+  int width_;
+  int height_;
+  int bytes_per_pixel_;
+  std::vector<unsigned char> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(PaddedDecodeDestination);
+};
+
 }  // namespace
 
 // Returns true if each channel of the given two colors are "close." This is
@@ -362,6 +408,27 @@ TEST(PNGCodec, EncodeDecodeBGRA) {
   ASSERT_TRUE(original == decoded);
 }
 
+TEST(PNGCodec, DecodeToDestination) {
+  const int w = 20, h = 20;
+  std::vector<unsigned char> original;
+  MakeRGBAImage(w, h, false, &original);
+  std::vector<unsigned char> encoded;
+  ASSERT_TRUE(PNGCodec::Encode(&original[0], PNGCodec::FORMAT_RGBA,
+                               Size(w, h), w * 4, false,
+                               std::vector<PNGCodec::Comment>(),
+                               &encoded));
+
+  // Rows land in the destination's memory at its stride.
+  PaddedDecodeDestination destination(16);
+  int outw, outh;
+  ASSERT_TRUE(PNGCodec::Decode(&encoded[0], encoded.size(),
+                               PNGCodec::FORMAT_RGBA, &destination,
+                               &outw, &outh));
+  ASSERT_EQ(w, outw);
+  ASSERT_EQ(h, outh);
+  EXPECT_TRUE(original == destination.Packed());
+}
+
 TEST(PNGCodec, DecodePalette) {
   const int w = 20, h = 20;
 
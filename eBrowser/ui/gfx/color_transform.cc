@@ -4,9 +4,17 @@
 
 #include "ui/gfx/color_transform.h"
 
+#include <algorithm>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
 #include "ui/gfx/color_space.h"
 #include "ui/gfx/icc_profile.h"
 #include "ui/gfx/transform.h"
@@ -18,6 +26,14 @@ extern "C" {
 };
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define COLOR_TRANSFORM_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#define COLOR_TRANSFORM_USE_NEON
+#endif
+
 namespace gfx {
 
 Transform Invert(const Transform& t) {
@@ -718,6 +734,164 @@ class ChainColorTransform : public ColorTransform {
   std::unique_ptr<ColorTransform> b_;
 };
 
+// Grid points per axis of a ColorLut. Transfer functions are smooth in the
+// encoded values the grid spans; a shaper evens out linear inputs.
+const int kLutSize = 17;
+
+// Entries of the shaper curve, interpolated linearly.
+const int kShaperSize = 1024;
+
+// Tables kept for reuse, of 80 KB each.
+const size_t kMaxCachedColorLuts = 8;
+
+// A transform sampled on a kLutSize^3 grid over [0, 1]^3 and interpolated
+// tetrahedrally. Immutable once built, so one table serves every thread.
+class ColorLut : public base::RefCountedThreadSafe<ColorLut> {
+ public:
+  // With |shape_input|, inputs are linear light and the grid is spaced on
+  // the sRGB curve, which puts more of it near black.
+  ColorLut(ColorTransform* transform, bool shape_input) {
+    if (shape_input) {
+      shaper_.resize(kShaperSize + 1);
+      for (int i = 0; i <= kShaperSize; ++i) {
+        shaper_[i] = FromLinear(ColorSpace::TransferID::IEC61966_2_1,
+                                static_cast<float>(i) / kShaperSize);
+      }
+    }
+    std::vector<ColorTransform::TriStim> nodes;
+    nodes.reserve(kLutSize * kLutSize * kLutSize);
+    for (int r = 0; r < kLutSize; ++r) {
+      for (int g = 0; g < kLutSize; ++g) {
+        for (int b = 0; b < kLutSize; ++b)
+          nodes.push_back(ColorTransform::TriStim(
+              GridInput(r, shape_input), GridInput(g, shape_input),
+              GridInput(b, shape_input)));
+      }
+    }
+    transform->transform(nodes.data(), nodes.size());
+    // Padded to four floats per node for the vector loads.
+    table_.resize(nodes.size() * 4);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      table_[i * 4] = nodes[i].x();
+      table_[i * 4 + 1] = nodes[i].y();
+      table_[i * 4 + 2] = nodes[i].z();
+      table_[i * 4 + 3] = 0.f;
+    }
+  }
+
+  void Apply(ColorTransform::TriStim* colors, size_t num) const {
+    const int kStride[3] = {kLutSize * kLutSize * 4, kLutSize * 4, 4};
+    for (size_t i = 0; i < num; ++i) {
+      float input[3] = {colors[i].x(), colors[i].y(), colors[i].z()};
+      int offset = 0;
+      float fraction[3];
+      for (int axis = 0; axis < 3; ++axis) {
+        // Also maps NaN to 0.
+        float value = input[axis] > 0.f ? std::min(input[axis], 1.f) : 0.f;
+        if (!shaper_.empty())
+          value = Shape(value);
+        value *= kLutSize - 1;
+        int index = std::min(static_cast<int>(value), kLutSize - 2);
+        fraction[axis] = value - index;
+        offset += index * kStride[axis];
+      }
+      // The tetrahedron of the cube that holds the color walks the axes from
+      // the largest fraction to the smallest.
+      int first = 0;
+      int second = 1;
+      int third = 2;
+      if (fraction[first] < fraction[second])
+        std::swap(first, second);
+      if (fraction[second] < fraction[third])
+        std::swap(second, third);
+      if (fraction[first] < fraction[second])
+        std::swap(first, second);
+      const float* c0 = &table_[offset];
+      const float* c1 = c0 + kStride[first];
+      const float* c2 = c1 + kStride[second];
+      const float* c3 = c2 + kStride[third];
+      float w0 = 1.f - fraction[first];
+      float w1 = fraction[first] - fraction[second];
+      float w2 = fraction[second] - fraction[third];
+      float w3 = fraction[third];
+#if defined(COLOR_TRANSFORM_USE_SSE2)
+      __m128 result = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(c0), _mm_set1_ps(w0)),
+                     _mm_mul_ps(_mm_loadu_ps(c1), _mm_set1_ps(w1))),
+          _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(c2), _mm_set1_ps(w2)),
+                     _mm_mul_ps(_mm_loadu_ps(c3), _mm_set1_ps(w3))));
+      float output[4];
+      _mm_storeu_ps(output, result);
+#elif defined(COLOR_TRANSFORM_USE_NEON)
+      float32x4_t result = vmulq_n_f32(vld1q_f32(c0), w0);
+      result = vmlaq_n_f32(result, vld1q_f32(c1), w1);
+      result = vmlaq_n_f32(result, vld1q_f32(c2), w2);
+      result = vmlaq_n_f32(result, vld1q_f32(c3), w3);
+      float output[4];
+      vst1q_f32(output, result);
+#else
+      float output[3];
+      for (int channel = 0; channel < 3; ++channel) {
+        output[channel] = c0[channel] * w0 + c1[channel] * w1 +
+                          c2[channel] * w2 + c3[channel] * w3;
+      }
+#endif
+      colors[i].SetPoint(output[0], output[1], output[2]);
+    }
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<ColorLut>;
+  ~ColorLut() {}
+
+  static float GridInput(int index, bool shape_input) {
+    float value = static_cast<float>(index) / (kLutSize - 1);
+    return shape_input ? ToLinear(ColorSpace::TransferID::IEC61966_2_1, value)
+                       : value;
+  }
+
+  float Shape(float value) const {
+    float position = value * kShaperSize;
+    int index = std::min(static_cast<int>(position), kShaperSize - 1);
+    float fraction = position - index;
+    return shaper_[index] + (shaper_[index + 1] - shaper_[index]) * fraction;
+  }
+
+  std::vector<float> shaper_;
+  std::vector<float> table_;
+
+  DISALLOW_COPY_AND_ASSIGN(ColorLut);
+};
+
+class LutColorTransform : public ColorTransform {
+ public:
+  explicit LutColorTransform(scoped_refptr<ColorLut> lut)
+      : lut_(std::move(lut)) {}
+
+  void transform(TriStim* colors, size_t num) override {
+    lut_->Apply(colors, num);
+  }
+
+ private:
+  scoped_refptr<ColorLut> lut_;
+};
+
+// The spaces and their ICC profile ids, which operator< leaves out, and the
+// intent.
+typedef std::tuple<ColorSpace, uint64_t, ColorSpace, uint64_t,
+                   ColorTransform::Intent>
+    ColorLutKey;
+
+struct ColorLutCache {
+  ColorLutCache() : luts(kMaxCachedColorLuts) {}
+  ~ColorLutCache() {}
+
+  base::MRUCache<ColorLutKey, scoped_refptr<ColorLut>> luts;
+  base::Lock lock;
+};
+static base::LazyInstance<ColorLutCache>::Leaky g_color_lut_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
 qcms_profile* GetQCMSProfileIfAvailable(const ColorSpace& color_space) {
   ICCProfile icc_profile = ICCProfile::FromColorSpace(color_space);
   if (icc_profile.GetData().empty())
@@ -778,4 +952,33 @@ std::unique_ptr<ColorTransform> ColorTransform::NewColorTransform(
   }
 }
 
+std::unique_ptr<ColorTransform> ColorTransform::NewLutColorTransform(
+    const ColorSpace& from,
+    const ColorSpace& to,
+    Intent intent) {
+  ColorLutKey key(from, from.icc_profile_id_, to, to.icc_profile_id_, intent);
+  ColorLutCache& cache = g_color_lut_cache.Get();
+  {
+    base::AutoLock lock(cache.lock);
+    auto found = cache.luts.Get(key);
+    if (found != cache.luts.end()) {
+      return std::unique_ptr<ColorTransform>(
+          new LutColorTransform(found->second));
+    }
+  }
+
+  // Built without the lock, as sampling an ICC transform takes a while. Two
+  // threads may both build it; the tables are the same.
+  std::unique_ptr<ColorTransform> transform =
+      NewColorTransform(from, to, intent);
+  scoped_refptr<ColorLut> lut(new ColorLut(
+      transform.get(), from.transfer_ == ColorSpace::TransferID::LINEAR &&
+                           !from.icc_profile_id_));
+  {
+    base::AutoLock lock(cache.lock);
+    cache.luts.Put(key, lut);
+  }
+  return std::unique_ptr<ColorTransform>(new LutColorTransform(std::move(lut)));
+}
+
 }  // namespace gfx
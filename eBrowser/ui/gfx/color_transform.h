@@ -33,6 +33,16 @@ class GFX_EXPORT ColorTransform {
       const ColorSpace& from,
       const ColorSpace& to,
       Intent intent);
+
+  // Like NewColorTransform(), but the transform is sampled once into a 3D
+  // lookup table that later transforms between the same spaces share, and
+  // colors are interpolated in it: much cheaper for ICC profiles and long
+  // chains, and typically within 1/256 of them. Colors are clamped to
+  // [0, 1].
+  static std::unique_ptr<ColorTransform> NewLutColorTransform(
+      const ColorSpace& from,
+      const ColorSpace& to,
+      Intent intent);
 };
 }  // namespace gfx
 
@@ -367,6 +367,64 @@ TEST(SimpleColorSpace, BT709toSRGBICC) {
   EXPECT_GT(tmp.z(), tmp.y());
 }
 
+// Compares the lookup table transform from |from| to |to| with the exact one
+// on a grid of colors.
+void ExpectLutMatches(const ColorSpace& from, const ColorSpace& to) {
+  std::unique_ptr<ColorTransform> exact(ColorTransform::NewColorTransform(
+      from, to, ColorTransform::Intent::INTENT_ABSOLUTE));
+  std::unique_ptr<ColorTransform> lut(ColorTransform::NewLutColorTransform(
+      from, to, ColorTransform::Intent::INTENT_ABSOLUTE));
+  for (float r = 0.05f; r < 1.f; r += 0.15f) {
+    for (float g = 0.1f; g < 1.f; g += 0.2f) {
+      for (float b = 0.f; b <= 1.f; b += 0.25f) {
+        ColorTransform::TriStim expected(r, g, b);
+        exact->transform(&expected, 1);
+        ColorTransform::TriStim actual(r, g, b);
+        lut->transform(&actual, 1);
+        EXPECT_NEAR(expected.x(), actual.x(), 0.005f) << r << g << b;
+        EXPECT_NEAR(expected.y(), actual.y(), 0.005f) << r << g << b;
+        EXPECT_NEAR(expected.z(), actual.z(), 0.005f) << r << g << b;
+      }
+    }
+  }
+}
+
+TEST(SimpleColorSpace, LutTransform) {
+  ExpectLutMatches(ColorSpace::CreateREC709(), ColorSpace::CreateSRGB());
+  ExpectLutMatches(ColorSpace::CreateSRGB(), ColorSpace::CreateXYZD50());
+
+  // The second time comes from the cache.
+  ExpectLutMatches(ColorSpace::CreateREC709(), ColorSpace::CreateSRGB());
+
+  ICCProfile srgb_icc = ICCProfile::FromData(
+      reinterpret_cast<char*>(srgb_icc_data), arraysize(srgb_icc_data));
+  ExpectLutMatches(ColorSpace::CreateREC709(), srgb_icc.GetColorSpace());
+}
+
+// Linear inputs go through a shaper curve first.
+TEST(SimpleColorSpace, LutTransformFromLinear) {
+  std::unique_ptr<ColorTransform> to_xyz(ColorTransform::NewColorTransform(
+      ColorSpace::CreateSRGB(), ColorSpace::CreateXYZD50(),
+      ColorTransform::Intent::INTENT_ABSOLUTE));
+  std::unique_ptr<ColorTransform> from_xyz(
+      ColorTransform::NewLutColorTransform(
+          ColorSpace::CreateXYZD50(), ColorSpace::CreateSRGB(),
+          ColorTransform::Intent::INTENT_ABSOLUTE));
+  const ColorTransform::TriStim colors[] = {
+      ColorTransform::TriStim(0.02f, 0.02f, 0.02f),
+      ColorTransform::TriStim(0.5f, 0.5f, 0.5f),
+      ColorTransform::TriStim(0.2f, 0.6f, 0.9f),
+      ColorTransform::TriStim(0.9f, 0.3f, 0.1f)};
+  for (const ColorTransform::TriStim& color : colors) {
+    ColorTransform::TriStim round_trip = color;
+    to_xyz->transform(&round_trip, 1);
+    from_xyz->transform(&round_trip, 1);
+    EXPECT_NEAR(color.x(), round_trip.x(), 0.005f);
+    EXPECT_NEAR(color.y(), round_trip.y(), 0.005f);
+    EXPECT_NEAR(color.z(), round_trip.z(), 0.005f);
+  }
+}
+
 TEST(SimpleColorSpace, GetColorSpace) {
   ICCProfile srgb_icc = ICCProfile::FromData(
       reinterpret_cast<char*>(srgb_icc_data), arraysize(srgb_icc_data));
@@ -481,6 +481,14 @@ void ImageSkia::EnsureRepsForSupportedScales() const {
   }
 }
 
+void ImageSkia::DiscardRepsFromSource() const {
+  if (storage_.get() && storage_->has_source()) {
+    DCHECK(storage_->CalledOnValidThread())
+        << "An ImageSkia with the source must be accessed by the same thread.";
+    storage_->image_reps().clear();
+  }
+}
+
 void ImageSkia::Init(const ImageSkiaRep& image_rep) {
   // TODO(pkotwicz): The image should be null whenever image rep is null.
   if (image_rep.sk_bitmap().empty()) {
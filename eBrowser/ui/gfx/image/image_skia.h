@@ -150,6 +150,12 @@ class GFX_EXPORT ImageSkia {
   // the state change in the storage is agnostic to the caller.
   void EnsureRepsForSupportedScales() const;
 
+  // When the source is available, drops the ImageReps it generated so that it
+  // generates them again the next time they are requested. Bitmaps already
+  // handed out stay valid. Like EnsureRepsForSupportedScales(), this is const
+  // as the state change in the storage is agnostic to the caller.
+  void DiscardRepsFromSource() const;
+
  private:
   friend class test::TestOnThread;
   FRIEND_TEST_ALL_PREFIXES(ImageSkiaTest, EmptyOnThreadTest);
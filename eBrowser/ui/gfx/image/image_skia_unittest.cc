@@ -277,6 +277,30 @@ TEST_F(ImageSkiaTest, DynamicSource) {
   EXPECT_EQ(2U, image_skia.image_reps().size());
 }
 
+// Tests that discarded reps are generated again by the source on demand.
+TEST_F(ImageSkiaTest, DiscardRepsFromSource) {
+  DynamicSource* source = new DynamicSource(Size(100, 200));
+  ImageSkia image_skia(source, Size(100, 200));
+  SkBitmap bitmap = image_skia.GetRepresentation(2.0f).sk_bitmap();
+  EXPECT_EQ(1U, image_skia.image_reps().size());
+  EXPECT_EQ(2.0f, source->GetLastRequestedScaleAndReset());
+
+  image_skia.DiscardRepsFromSource();
+  EXPECT_EQ(0U, image_skia.image_reps().size());
+  EXPECT_EQ(100, image_skia.width());
+  // Bitmaps handed out before the discard stay valid.
+  EXPECT_EQ(200, bitmap.width());
+
+  EXPECT_EQ(200, image_skia.GetRepresentation(2.0f).pixel_width());
+  EXPECT_EQ(2.0f, source->GetLastRequestedScaleAndReset());
+  EXPECT_EQ(1U, image_skia.image_reps().size());
+
+  // Images without a source have nothing to regenerate reps from.
+  ImageSkia static_image(ImageSkiaRep(Size(100, 200), 1.0f));
+  static_image.DiscardRepsFromSource();
+  EXPECT_EQ(1U, static_image.image_reps().size());
+}
+
 // Tests that image_reps returns all of the representations in the
 // image when there are multiple representations for a scale factor.
 // This currently is the case with ImageLoader::LoadImages.
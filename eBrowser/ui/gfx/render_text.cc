@@ -56,6 +56,10 @@ const SkColor kDefaultColor = SK_ColorBLACK;
 // Default color used for drawing selection background.
 const SkColor kDefaultSelectionBackgroundColor = SK_ColorGRAY;
 
+// Number of guesses next to the width estimate RenderText::Elide() tries
+// before bisecting.
+const int kMaxElideNeighbourGuesses = 2;
+
 // Fraction of the text size to lower a strike through below the baseline.
 const SkScalar kStrikeThroughOffset = (-SK_Scalar1 * 6 / 21);
 // Fraction of the text size to lower an underline below the baseline.
@@ -1482,20 +1486,36 @@ base::string16 RenderText::Elide(const base::string16& text,
   const bool elide_in_middle = (behavior == ELIDE_MIDDLE);
   const bool elide_at_beginning = (behavior == ELIDE_HEAD);
 
+  // Measure the graphemes of the full text once, while it is laid out, so the
+  // search below can start from a close estimate.
+  std::vector<float> advances(text.length(), 0.0f);
+  for (size_t i = 0; i < text.length(); ++i) {
+    if (render_text->IsValidCursorIndex(i))
+      advances[i] = render_text->GetGlyphBounds(i).length();
+  }
+  const StringSlicerWidths widths(advances, elide_in_middle,
+                                  elide_at_beginning);
+
+  float ellipsis_width = 0;
   if (insert_ellipsis) {
     render_text->SetText(ellipsis);
-    const float ellipsis_width = render_text->GetContentWidthF();
+    ellipsis_width = render_text->GetContentWidthF();
     if (ellipsis_width > available_width)
       return base::string16();
   }
 
   StringSlicer slicer(text, ellipsis, elide_in_middle, elide_at_beginning);
 
-  // Use binary search to compute the elided text.
+  // Search for the elided text, starting from the estimate. The estimate is
+  // usually off by at most a grapheme, so its neighbours are tried next before
+  // falling back to bisection; each guess costs a full shaping of the cut.
   size_t lo = 0;
   size_t hi = text.length() - 1;
+  size_t guess =
+      std::min(widths.GetLengthForWidth(available_width - ellipsis_width), hi);
+  int neighbour_guesses = kMaxElideNeighbourGuesses;
   const base::i18n::TextDirection text_direction = GetTextDirection(text);
-  for (size_t guess = (lo + hi) / 2; lo <= hi; guess = (lo + hi) / 2) {
+  while (lo <= hi) {
     // Restore colors. They will be truncated to size by SetText.
     render_text->colors_ = colors_;
     base::string16 new_text =
@@ -1535,7 +1555,8 @@ base::string16 RenderText::Elide(const base::string16& text,
     const float guess_width = render_text->GetContentWidthF();
     if (guess_width == available_width)
       break;
-    if (guess_width > available_width) {
+    const bool too_wide = guess_width > available_width;
+    if (too_wide) {
       hi = guess - 1;
       // Move back on the loop terminating condition when the guess is too wide.
       if (hi < lo)
@@ -1543,6 +1564,12 @@ base::string16 RenderText::Elide(const base::string16& text,
     } else {
       lo = guess + 1;
     }
+    if (neighbour_guesses > 0) {
+      --neighbour_guesses;
+      guess = too_wide ? hi : lo;
+    } else {
+      guess = (lo + hi) / 2;
+    }
   }
 
   return render_text->text();
@@ -6,15 +6,20 @@
 
 #include <limits>
 #include <set>
+#include <tuple>
+#include <utility>
 
+#include "base/containers/mru_cache.h"
 #include "base/i18n/bidi_line_iterator.h"
 #include "base/i18n/break_iterator.h"
 #include "base/i18n/char_iterator.h"
+#include "base/lazy_instance.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/profiler/scoped_tracker.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/lock.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "third_party/harfbuzz-ng/src/hb.h"
@@ -565,6 +570,141 @@ struct CaseInsensitiveCompare {
   }
 };
 
+// Number of recently shaped runs to cache, shared by all RenderTexts.
+const size_t kShapeCacheSize = 1024;
+
+// HarfBuzz looks at up to this many characters on either side of a run
+// (HB_BUFFER_CONTEXT_LENGTH), so they are part of the shaping input.
+const size_t kShapeContextLength = 5;
+
+// Everything ShapeRunWithFont() passes to HarfBuzz.
+struct ShapeCacheKey {
+  // The run and its surrounding context.
+  base::string16 text;
+  // The run's range within |text|.
+  size_t run_start;
+  size_t run_length;
+  std::string font_name;
+  int font_size;
+  bool italic;
+  Font::Weight weight;
+  UScriptCode script;
+  bool is_rtl;
+  FontRenderParams render_params;
+  bool subpixel_rendering_suppressed;
+
+  bool operator<(const ShapeCacheKey& other) const {
+    const FontRenderParams& a = render_params;
+    const FontRenderParams& b = other.render_params;
+    return std::tie(text, run_start, run_length, font_name, font_size, italic,
+                    weight, script, is_rtl, a.antialiasing,
+                    a.subpixel_positioning, a.autohinter, a.use_bitmaps,
+                    a.hinting, a.subpixel_rendering,
+                    subpixel_rendering_suppressed) <
+           std::tie(other.text, other.run_start, other.run_length,
+                    other.font_name, other.font_size, other.italic,
+                    other.weight, other.script, other.is_rtl, b.antialiasing,
+                    b.subpixel_positioning, b.autohinter, b.use_bitmaps,
+                    b.hinting, b.subpixel_rendering,
+                    other.subpixel_rendering_suppressed);
+  }
+};
+
+// The glyph data of a shaped run. |glyph_to_char| is relative to the start of
+// the run, so the entry applies wherever the run occurs in a string.
+struct ShapeCacheEntry {
+  std::vector<uint16_t> glyphs;
+  std::vector<SkPoint> positions;
+  std::vector<uint32_t> glyph_to_char;
+  float width;
+};
+
+typedef base::MRUCache<ShapeCacheKey, ShapeCacheEntry> ShapeCache;
+
+// A cache and the lock that must be held while accessing it, since
+// RenderTexts may lay out text on any thread.
+struct SynchronizedShapeCache {
+  SynchronizedShapeCache() : cache(kShapeCacheSize), hits(0), misses(0) {}
+
+  base::Lock lock;
+  ShapeCache cache;
+  int hits;
+  int misses;
+};
+
+base::LazyInstance<SynchronizedShapeCache>::Leaky g_shape_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+ShapeCacheKey MakeShapeCacheKey(const base::string16& text,
+                                const internal::TextRunHarfBuzz& run,
+                                bool subpixel_rendering_suppressed) {
+  const size_t context_start =
+      run.range.start() - std::min(run.range.start(), kShapeContextLength);
+  const size_t context_end =
+      std::min(text.length(), run.range.end() + kShapeContextLength);
+
+  ShapeCacheKey key;
+  key.text = text.substr(context_start, context_end - context_start);
+  key.run_start = run.range.start() - context_start;
+  key.run_length = run.range.length();
+  key.font_name = run.font.GetFontName();
+  key.font_size = run.font_size;
+  key.italic = run.italic;
+  key.weight = run.weight;
+  key.script = run.script;
+  key.is_rtl = run.is_rtl;
+  key.render_params = run.render_params;
+  key.subpixel_rendering_suppressed = subpixel_rendering_suppressed;
+  return key;
+}
+
+// Fills the glyph data of |run| from the cache. Returns false if |key| has not
+// been shaped recently.
+bool GetShapedRunFromCache(const ShapeCacheKey& key,
+                           internal::TextRunHarfBuzz* run) {
+  SynchronizedShapeCache* shape_cache = g_shape_cache.Pointer();
+  base::AutoLock lock(shape_cache->lock);
+  ShapeCache::const_iterator it = shape_cache->cache.Get(key);
+  const bool hit = it != shape_cache->cache.end();
+  if (hit)
+    shape_cache->hits++;
+  else
+    shape_cache->misses++;
+  TRACE_COUNTER2("ui", "RenderTextHarfBuzz::ShapeCache", "hits",
+                 shape_cache->hits, "misses", shape_cache->misses);
+  if (!hit)
+    return false;
+
+  const ShapeCacheEntry& entry = it->second;
+  run->glyph_count = entry.glyphs.size();
+  run->glyphs.reset(new uint16_t[run->glyph_count]);
+  run->positions.reset(new SkPoint[run->glyph_count]);
+  std::copy(entry.glyphs.begin(), entry.glyphs.end(), run->glyphs.get());
+  std::copy(entry.positions.begin(), entry.positions.end(),
+            run->positions.get());
+  run->glyph_to_char.resize(run->glyph_count);
+  for (size_t i = 0; i < run->glyph_count; ++i)
+    run->glyph_to_char[i] = entry.glyph_to_char[i] + run->range.start();
+  run->width = entry.width;
+  return true;
+}
+
+void AddShapedRunToCache(const ShapeCacheKey& key,
+                         const internal::TextRunHarfBuzz& run) {
+  ShapeCacheEntry entry;
+  entry.glyphs.assign(run.glyphs.get(), run.glyphs.get() + run.glyph_count);
+  entry.positions.assign(run.positions.get(),
+                         run.positions.get() + run.glyph_count);
+  entry.glyph_to_char.resize(run.glyph_count);
+  for (size_t i = 0; i < run.glyph_count; ++i)
+    entry.glyph_to_char[i] = run.glyph_to_char[i] - run.range.start();
+  entry.width = run.width;
+
+  SynchronizedShapeCache* shape_cache = g_shape_cache.Pointer();
+  base::AutoLock lock(shape_cache->lock);
+  shape_cache->cache.Put(key, std::move(entry));
+}
+
 }  // namespace
 
 namespace internal {
@@ -765,6 +905,13 @@ size_t TextRunList::GetRunIndexAt(size_t position) const {
   return runs_.size();
 }
 
+void GetShapeCacheStatsForTesting(int* hits, int* misses) {
+  SynchronizedShapeCache* shape_cache = g_shape_cache.Pointer();
+  base::AutoLock lock(shape_cache->lock);
+  *hits = shape_cache->hits;
+  *misses = shape_cache->misses;
+}
+
 }  // namespace internal
 
 RenderTextHarfBuzz::RenderTextHarfBuzz()
@@ -1490,6 +1637,17 @@ bool RenderTextHarfBuzz::ShapeRunWithFont(const base::string16& text,
   run->font = font;
   run->render_params = params;
 
+  // Identical runs are reshaped on every layout and across RenderTexts, so
+  // reuse the glyphs from a recent shaping. Test glyph widths bypass the cache.
+  const bool use_shape_cache = glyph_width_for_test_ <= 0;
+  ShapeCacheKey cache_key;
+  if (use_shape_cache) {
+    cache_key =
+        MakeShapeCacheKey(text, *run, subpixel_rendering_suppressed());
+    if (GetShapedRunFromCache(cache_key, run))
+      return true;
+  }
+
   hb_font_t* harfbuzz_font = CreateHarfBuzzFont(
       run->skia_face, SkIntToScalar(run->font_size), run->render_params,
       subpixel_rendering_suppressed());
@@ -1546,6 +1704,8 @@ bool RenderTextHarfBuzz::ShapeRunWithFont(const base::string16& text,
 
   hb_buffer_destroy(buffer);
   hb_font_destroy(harfbuzz_font);
+  if (use_shape_cache)
+    AddShapedRunToCache(cache_key, *run);
   return true;
 }
 
@@ -140,6 +140,10 @@ class TextRunList {
   DISALLOW_COPY_AND_ASSIGN(TextRunList);
 };
 
+// Returns the number of runs served from and missing in the process-wide cache
+// of shaped runs.
+GFX_EXPORT void GetShapeCacheStatsForTesting(int* hits, int* misses);
+
 }  // namespace internal
 
 class GFX_EXPORT RenderTextHarfBuzz : public RenderText {
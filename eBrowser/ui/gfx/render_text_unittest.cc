@@ -3297,6 +3297,43 @@ TEST_P(RenderTextHarfBuzzTest, HarfBuzz_SubglyphGraphemeCases) {
   }
 }
 
+// Test that laying out the same text again reuses the shaped runs.
+TEST_P(RenderTextHarfBuzzTest, HarfBuzz_ShapeCache) {
+  const base::string16 text = ASCIIToUTF16("Shape cache test");
+  GetRenderText()->SetText(text);
+  test_api()->EnsureLayout();
+  internal::TextRunList* run_list = GetHarfBuzzRunList();
+  ASSERT_EQ(1U, run_list->size());
+  const internal::TextRunHarfBuzz* run = run_list->runs()[0];
+  const std::vector<uint16_t> glyphs(run->glyphs.get(),
+                                     run->glyphs.get() + run->glyph_count);
+  const std::vector<uint32_t> glyph_to_char = run->glyph_to_char;
+  const float width = run->width;
+
+  int hits_before = 0;
+  int misses_before = 0;
+  internal::GetShapeCacheStatsForTesting(&hits_before, &misses_before);
+
+  // A different RenderText with the same text hits the cache and gets the same
+  // glyphs.
+  ResetRenderTextInstance();
+  GetRenderText()->SetText(text);
+  test_api()->EnsureLayout();
+  int hits = 0;
+  int misses = 0;
+  internal::GetShapeCacheStatsForTesting(&hits, &misses);
+  EXPECT_LT(hits_before, hits);
+
+  run_list = GetHarfBuzzRunList();
+  ASSERT_EQ(1U, run_list->size());
+  run = run_list->runs()[0];
+  EXPECT_EQ(glyphs,
+            std::vector<uint16_t>(run->glyphs.get(),
+                                  run->glyphs.get() + run->glyph_count));
+  EXPECT_EQ(glyph_to_char, run->glyph_to_char);
+  EXPECT_EQ(width, run->width);
+}
+
 // Test the partition of a multi-grapheme cluster into grapheme ranges.
 TEST_P(RenderTextHarfBuzzTest, HarfBuzz_SubglyphGraphemePartition) {
   struct {
@@ -10,6 +10,7 @@
 #include <algorithm>
 
 #include "base/logging.h"
+#include "build/build_config.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
@@ -20,6 +21,358 @@
 #include "ui/gfx/geometry/point.h"
 #include "ui/gfx/geometry/size.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define SKBITMAP_OPERATIONS_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#define SKBITMAP_OPERATIONS_USE_NEON
+#endif
+
+#if defined(SKBITMAP_OPERATIONS_USE_SSE2) || \
+    defined(SKBITMAP_OPERATIONS_USE_NEON)
+#define SKBITMAP_OPERATIONS_VECTORIZED
+#endif
+
+// ARMv7 NEON has no double-precision lanes for the kernels that must match
+// the scalar double math.
+#if defined(SKBITMAP_OPERATIONS_USE_SSE2) || \
+    (defined(SKBITMAP_OPERATIONS_USE_NEON) && defined(ARCH_CPU_ARM64))
+#define SKBITMAP_OPERATIONS_VECTORIZED_DOUBLES
+#endif
+
+namespace {
+
+// The vectorized kernels below produce exactly the pixels of the scalar loops
+// they replace; the double-precision ones do the same IEEE operations in the
+// same order. Each kernel handles a prefix of the row and returns its length,
+// and the caller finishes the row with its scalar loop.
+
+bool g_vectorized_kernels_enabled = true;
+
+// Byte offset of the alpha channel within a little-endian SkPMColor.
+const int kPMColorAlphaByte = SK_A32_SHIFT / 8;
+
+#if defined(SKBITMAP_OPERATIONS_USE_SSE2)
+
+// Shuffle that copies the alpha of each pixel into its four 16-bit lanes.
+const int kAlphaBroadcast =
+    _MM_SHUFFLE(kPMColorAlphaByte, kPMColorAlphaByte, kPMColorAlphaByte,
+                kPMColorAlphaByte);
+
+// Returns trunc(first * first_alpha + second * alpha) for four int32 lanes.
+__m128i BlendChannels(__m128i first,
+                      __m128i second,
+                      __m128d first_alpha,
+                      __m128d alpha) {
+  __m128d lo = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(first), first_alpha),
+                          _mm_mul_pd(_mm_cvtepi32_pd(second), alpha));
+  __m128d hi = _mm_add_pd(
+      _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(first, 8)), first_alpha),
+      _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(second, 8)), alpha));
+  return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+}
+
+int BlendRow(const uint32_t* first,
+             const uint32_t* second,
+             double alpha,
+             uint32_t* dst,
+             int width) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128d first_alpha_v = _mm_set1_pd(1 - alpha);
+  const __m128d alpha_v = _mm_set1_pd(alpha);
+  int x = 0;
+  for (; x + 2 <= width; x += 2) {
+    __m128i a = _mm_unpacklo_epi8(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(first + x)), zero);
+    __m128i b = _mm_unpacklo_epi8(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(second + x)), zero);
+    __m128i lo = BlendChannels(_mm_unpacklo_epi16(a, zero),
+                               _mm_unpacklo_epi16(b, zero), first_alpha_v,
+                               alpha_v);
+    __m128i hi = BlendChannels(_mm_unpackhi_epi16(a, zero),
+                               _mm_unpackhi_epi16(b, zero), first_alpha_v,
+                               alpha_v);
+    __m128i packed = _mm_packs_epi32(lo, hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x),
+                     _mm_packus_epi16(packed, packed));
+  }
+  return x;
+}
+
+int MaskRow(const uint32_t* rgb,
+            const uint32_t* alpha,
+            uint32_t* dst,
+            int width) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i byte_mask = _mm_set1_epi32(0xFF);
+  const __m128i one = _mm_set1_epi32(1);
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + x));
+    __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha + x));
+    // SkAlpha255To256() of each mask pixel, in both 16-bit halves.
+    __m128i scale = _mm_add_epi32(
+        _mm_and_si128(_mm_srli_epi32(m, SK_A32_SHIFT), byte_mask), one);
+    scale = _mm_or_si128(scale, _mm_slli_epi32(scale, 16));
+    // (channel * scale) >> 8 fits in 16 bits, as in SkAlphaMulQ().
+    __m128i lo = _mm_srli_epi16(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(c, zero),
+                        _mm_unpacklo_epi32(scale, scale)),
+        8);
+    __m128i hi = _mm_srli_epi16(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(c, zero),
+                        _mm_unpackhi_epi32(scale, scale)),
+        8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x),
+                     _mm_packus_epi16(lo, hi));
+  }
+  return x;
+}
+
+int ButtonBackgroundRow(const double* bg_bgra,
+                        const uint32_t* image_row,
+                        int image_width,
+                        const uint32_t* mask_row,
+                        uint32_t* dst,
+                        int width) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128d max_alpha = _mm_set1_pd(255.0);
+  const __m128d bg_bg = _mm_set_pd(bg_bgra[1], bg_bgra[0]);
+  const __m128d bg_ra = _mm_set_pd(bg_bgra[3], bg_bgra[2]);
+  for (int x = 0; x < width; ++x) {
+    uint32_t image_pixel = image_row[x % image_width];
+    __m128i img = _mm_unpacklo_epi16(
+        _mm_unpacklo_epi8(_mm_cvtsi32_si128(image_pixel), zero), zero);
+    __m128d img_bg = _mm_cvtepi32_pd(img);
+    __m128d img_ra = _mm_cvtepi32_pd(_mm_srli_si128(img, 8));
+
+    double img_alpha = SkColorGetA(image_pixel) / 255.0;
+    __m128d img_alpha_v = _mm_set1_pd(img_alpha);
+    __m128d img_inv_v = _mm_set1_pd(1 - img_alpha);
+    __m128d mask_a = _mm_set1_pd(
+        static_cast<double>(SkColorGetA(mask_row[x])) / 255.0);
+
+    __m128d out_bg = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(bg_bg, img_inv_v),
+                                           _mm_mul_pd(img_bg, img_alpha_v)),
+                                mask_a);
+    __m128d out_r = _mm_mul_pd(_mm_add_pd(_mm_mul_pd(bg_ra, img_inv_v),
+                                          _mm_mul_pd(img_ra, img_alpha_v)),
+                               mask_a);
+    __m128d out_a =
+        _mm_mul_pd(_mm_min_pd(max_alpha, _mm_add_pd(bg_ra, img_ra)), mask_a);
+    __m128i out = _mm_unpacklo_epi64(
+        _mm_cvttpd_epi32(out_bg), _mm_cvttpd_epi32(_mm_move_sd(out_a, out_r)));
+    out = _mm_packs_epi32(out, out);
+    dst[x] =
+        static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(out, out)));
+  }
+  return width;
+}
+
+// Scales the color channels by |factor| / 65536.
+int LightnessDecRow(uint32_t factor,
+                    const SkPMColor* in,
+                    SkPMColor* out,
+                    int width) {
+  DCHECK_LT(factor, 65536u);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i factor_v = _mm_set1_epi16(static_cast<int16_t>(factor));
+  const __m128i alpha_mask =
+      _mm_set1_epi32(static_cast<int>(0xFFu << SK_A32_SHIFT));
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+    __m128i lo = _mm_mulhi_epu16(_mm_unpacklo_epi8(c, zero), factor_v);
+    __m128i hi = _mm_mulhi_epu16(_mm_unpackhi_epi8(c, zero), factor_v);
+    __m128i shifted = _mm_or_si128(
+        _mm_andnot_si128(alpha_mask, _mm_packus_epi16(lo, hi)),
+        _mm_and_si128(alpha_mask, c));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), shifted);
+  }
+  return x;
+}
+
+// Moves the color channels |factor| / 65536 of the way to their alpha. Like
+// the scalar loop this expects premultiplied colors.
+int LightnessIncRow(uint32_t factor,
+                    const SkPMColor* in,
+                    SkPMColor* out,
+                    int width) {
+  DCHECK_LT(factor, 65536u);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i factor_v = _mm_set1_epi16(static_cast<int16_t>(factor));
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+    __m128i lo = _mm_unpacklo_epi8(c, zero);
+    __m128i hi = _mm_unpackhi_epi8(c, zero);
+    // The alpha channel gains a - a = 0.
+    __m128i lo_alpha = _mm_shufflehi_epi16(
+        _mm_shufflelo_epi16(lo, kAlphaBroadcast), kAlphaBroadcast);
+    __m128i hi_alpha = _mm_shufflehi_epi16(
+        _mm_shufflelo_epi16(hi, kAlphaBroadcast), kAlphaBroadcast);
+    lo = _mm_add_epi16(
+        lo, _mm_mulhi_epu16(_mm_sub_epi16(lo_alpha, lo), factor_v));
+    hi = _mm_add_epi16(
+        hi, _mm_mulhi_epu16(_mm_sub_epi16(hi_alpha, hi), factor_v));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x),
+                     _mm_packus_epi16(lo, hi));
+  }
+  return x;
+}
+
+#elif defined(SKBITMAP_OPERATIONS_USE_NEON)
+
+// Returns the high 16 bits of each |c| * |factor|.
+uint16x8_t MulHigh(uint16x8_t c, uint16x4_t factor) {
+  return vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(c), factor), 16),
+                      vshrn_n_u32(vmull_u16(vget_high_u16(c), factor), 16));
+}
+
+#if defined(ARCH_CPU_ARM64)
+
+// Returns trunc(first * first_alpha + second * alpha) for four lanes.
+uint32x4_t BlendChannels(uint32x4_t first,
+                         uint32x4_t second,
+                         float64x2_t first_alpha,
+                         float64x2_t alpha) {
+  float64x2_t lo = vaddq_f64(
+      vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(first))), first_alpha),
+      vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(second))), alpha));
+  float64x2_t hi = vaddq_f64(
+      vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_high_u32(first))), first_alpha),
+      vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_high_u32(second))), alpha));
+  return vcombine_u32(vmovn_u64(vcvtq_u64_f64(lo)),
+                      vmovn_u64(vcvtq_u64_f64(hi)));
+}
+
+int BlendRow(const uint32_t* first,
+             const uint32_t* second,
+             double alpha,
+             uint32_t* dst,
+             int width) {
+  const float64x2_t first_alpha_v = vdupq_n_f64(1 - alpha);
+  const float64x2_t alpha_v = vdupq_n_f64(alpha);
+  int x = 0;
+  for (; x + 2 <= width; x += 2) {
+    uint16x8_t a = vmovl_u8(vreinterpret_u8_u32(vld1_u32(first + x)));
+    uint16x8_t b = vmovl_u8(vreinterpret_u8_u32(vld1_u32(second + x)));
+    uint32x4_t lo = BlendChannels(vmovl_u16(vget_low_u16(a)),
+                                  vmovl_u16(vget_low_u16(b)), first_alpha_v,
+                                  alpha_v);
+    uint32x4_t hi = BlendChannels(vmovl_u16(vget_high_u16(a)),
+                                  vmovl_u16(vget_high_u16(b)), first_alpha_v,
+                                  alpha_v);
+    uint8x8_t packed =
+        vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+    vst1_u32(dst + x, vreinterpret_u32_u8(packed));
+  }
+  return x;
+}
+
+int ButtonBackgroundRow(const double* bg_bgra,
+                        const uint32_t* image_row,
+                        int image_width,
+                        const uint32_t* mask_row,
+                        uint32_t* dst,
+                        int width) {
+  const float64x2_t max_alpha = vdupq_n_f64(255.0);
+  const float64x2_t bg_bg = vld1q_f64(bg_bgra);
+  const float64x2_t bg_ra = vld1q_f64(bg_bgra + 2);
+  for (int x = 0; x < width; ++x) {
+    uint32_t image_pixel = image_row[x % image_width];
+    uint32x4_t img = vmovl_u16(vget_low_u16(
+        vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(image_pixel)))));
+    float64x2_t img_bg = vcvtq_f64_u64(vmovl_u32(vget_low_u32(img)));
+    float64x2_t img_ra = vcvtq_f64_u64(vmovl_u32(vget_high_u32(img)));
+
+    double img_alpha = SkColorGetA(image_pixel) / 255.0;
+    float64x2_t img_alpha_v = vdupq_n_f64(img_alpha);
+    float64x2_t img_inv_v = vdupq_n_f64(1 - img_alpha);
+    float64x2_t mask_a = vdupq_n_f64(
+        static_cast<double>(SkColorGetA(mask_row[x])) / 255.0);
+
+    float64x2_t out_bg = vmulq_f64(vaddq_f64(vmulq_f64(bg_bg, img_inv_v),
+                                             vmulq_f64(img_bg, img_alpha_v)),
+                                   mask_a);
+    float64x2_t out_r = vmulq_f64(vaddq_f64(vmulq_f64(bg_ra, img_inv_v),
+                                            vmulq_f64(img_ra, img_alpha_v)),
+                                  mask_a);
+    float64x2_t out_a =
+        vmulq_f64(vminq_f64(max_alpha, vaddq_f64(bg_ra, img_ra)), mask_a);
+    float64x2_t out_ra =
+        vcombine_f64(vget_low_f64(out_r), vget_high_f64(out_a));
+    uint32x4_t out = vcombine_u32(vmovn_u64(vcvtq_u64_f64(out_bg)),
+                                  vmovn_u64(vcvtq_u64_f64(out_ra)));
+    uint8x8_t packed = vmovn_u16(vcombine_u16(vmovn_u32(out), vmovn_u32(out)));
+    dst[x] = vget_lane_u32(vreinterpret_u32_u8(packed), 0);
+  }
+  return width;
+}
+
+#endif  // defined(ARCH_CPU_ARM64)
+
+int MaskRow(const uint32_t* rgb,
+            const uint32_t* alpha,
+            uint32_t* dst,
+            int width) {
+  const uint8x8_t one = vdup_n_u8(1);
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    uint8x8x4_t c = vld4_u8(reinterpret_cast<const uint8_t*>(rgb + x));
+    uint8x8x4_t m = vld4_u8(reinterpret_cast<const uint8_t*>(alpha + x));
+    uint16x8_t scale = vaddl_u8(m.val[kPMColorAlphaByte], one);
+    for (int i = 0; i < 4; ++i)
+      c.val[i] = vshrn_n_u16(vmulq_u16(vmovl_u8(c.val[i]), scale), 8);
+    vst4_u8(reinterpret_cast<uint8_t*>(dst + x), c);
+  }
+  return x;
+}
+
+int LightnessDecRow(uint32_t factor,
+                    const SkPMColor* in,
+                    SkPMColor* out,
+                    int width) {
+  DCHECK_LT(factor, 65536u);
+  const uint16x4_t factor_v = vdup_n_u16(static_cast<uint16_t>(factor));
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    uint8x8x4_t c = vld4_u8(reinterpret_cast<const uint8_t*>(in + x));
+    for (int i = 0; i < 4; ++i) {
+      if (i != kPMColorAlphaByte)
+        c.val[i] = vmovn_u16(MulHigh(vmovl_u8(c.val[i]), factor_v));
+    }
+    vst4_u8(reinterpret_cast<uint8_t*>(out + x), c);
+  }
+  return x;
+}
+
+int LightnessIncRow(uint32_t factor,
+                    const SkPMColor* in,
+                    SkPMColor* out,
+                    int width) {
+  DCHECK_LT(factor, 65536u);
+  const uint16x4_t factor_v = vdup_n_u16(static_cast<uint16_t>(factor));
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    uint8x8x4_t c = vld4_u8(reinterpret_cast<const uint8_t*>(in + x));
+    uint8x8_t a = c.val[kPMColorAlphaByte];
+    for (int i = 0; i < 4; ++i) {
+      if (i == kPMColorAlphaByte)
+        continue;
+      uint16x8_t gain = MulHigh(vsubl_u8(a, c.val[i]), factor_v);
+      c.val[i] = vmovn_u16(vaddw_u8(gain, c.val[i]));
+    }
+    vst4_u8(reinterpret_cast<uint8_t*>(out + x), c);
+  }
+  return x;
+}
+
+#endif
+
+}  // namespace
+
 // static
 SkBitmap SkBitmapOperations::CreateInvertedBitmap(const SkBitmap& image) {
   DCHECK(image.colorType() == kN32_SkColorType);
@@ -74,7 +427,12 @@ SkBitmap SkBitmapOperations::CreateBlendedBitmap(const SkBitmap& first,
     uint32_t* second_row = second.getAddr32(0, y);
     uint32_t* dst_row = blended.getAddr32(0, y);
 
-    for (int x = 0; x < first.width(); ++x) {
+    int x = 0;
+#if defined(SKBITMAP_OPERATIONS_VECTORIZED_DOUBLES)
+    if (g_vectorized_kernels_enabled)
+      x = BlendRow(first_row, second_row, alpha, dst_row, first.width());
+#endif
+    for (; x < first.width(); ++x) {
       uint32_t first_pixel = first_row[x];
       uint32_t second_pixel = second_row[x];
 
@@ -115,7 +473,12 @@ SkBitmap SkBitmapOperations::CreateMaskedBitmap(const SkBitmap& rgb,
     uint32_t* alpha_row = alpha.getAddr32(0, y);
     uint32_t* dst_row = masked.getAddr32(0, y);
 
-    for (int x = 0; x < masked.width(); ++x) {
+    int x = 0;
+#if defined(SKBITMAP_OPERATIONS_VECTORIZED)
+    if (g_vectorized_kernels_enabled)
+      x = MaskRow(rgb_row, alpha_row, dst_row, masked.width());
+#endif
+    for (; x < masked.width(); ++x) {
       unsigned alpha = SkGetPackedA32(alpha_row[x]);
       unsigned scale = SkAlpha255To256(alpha);
       dst_row[x] = SkAlphaMulQ(rgb_row[x], scale);
@@ -152,7 +515,15 @@ SkBitmap SkBitmapOperations::CreateButtonBackground(SkColor color,
     uint32_t* image_row = image.getAddr32(0, y % image.height());
     uint32_t* mask_row = mask.getAddr32(0, y);
 
-    for (int x = 0; x < mask.width(); ++x) {
+    int x = 0;
+#if defined(SKBITMAP_OPERATIONS_VECTORIZED_DOUBLES)
+    if (g_vectorized_kernels_enabled) {
+      const double bg_bgra[] = {bg_b, bg_g, bg_r, bg_a};
+      x = ButtonBackgroundRow(bg_bgra, image_row, image.width(), mask_row,
+                              dst_row, mask.width());
+    }
+#endif
+    for (; x < mask.width(); ++x) {
       uint32_t image_pixel = image_row[x % image.width()];
 
       double img_a = SkColorGetA(image_pixel);
@@ -267,7 +638,12 @@ void LineProcHnopSnopLdec(const color_utils::HSL& hsl_shift,
   DCHECK(hsl_shift.l <= 0.5 - HSLShift::epsilon && hsl_shift.l >= 0);
 
   uint32_t ldec_num = static_cast<uint32_t>(hsl_shift.l * 2 * den);
-  for (int x = 0; x < width; x++) {
+  int x = 0;
+#if defined(SKBITMAP_OPERATIONS_VECTORIZED)
+  if (g_vectorized_kernels_enabled)
+    x = LightnessDecRow(ldec_num, in, out, width);
+#endif
+  for (; x < width; x++) {
     uint32_t a = SkGetPackedA32(in[x]);
     uint32_t r = SkGetPackedR32(in[x]);
     uint32_t g = SkGetPackedG32(in[x]);
@@ -291,7 +667,13 @@ void LineProcHnopSnopLinc(const color_utils::HSL& hsl_shift,
   DCHECK(hsl_shift.l >= 0.5 + HSLShift::epsilon && hsl_shift.l <= 1);
 
   uint32_t linc_num = static_cast<uint32_t>((hsl_shift.l - 0.5) * 2 * den);
-  for (int x = 0; x < width; x++) {
+  int x = 0;
+#if defined(SKBITMAP_OPERATIONS_VECTORIZED)
+  // A full shift to white does not fit the kernel's 16-bit factor.
+  if (g_vectorized_kernels_enabled && linc_num < den)
+    x = LightnessIncRow(linc_num, in, out, width);
+#endif
+  for (; x < width; x++) {
     uint32_t a = SkGetPackedA32(in[x]);
     uint32_t r = SkGetPackedR32(in[x]);
     uint32_t g = SkGetPackedG32(in[x]);
@@ -754,6 +1136,11 @@ SkBitmap SkBitmapOperations::CreateDropShadow(
   return image_with_shadow;
 }
 
+// static
+void SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(bool enabled) {
+  g_vectorized_kernels_enabled = enabled;
+}
+
 // static
 SkBitmap SkBitmapOperations::Rotate(const SkBitmap& source,
                                     RotationAmount rotation) {
@@ -114,6 +114,10 @@ class GFX_EXPORT SkBitmapOperations {
   // Rotates the given source bitmap clockwise by the requested amount.
   static SkBitmap Rotate(const SkBitmap& source, RotationAmount rotation);
 
+  // Makes the functions above use only their scalar loops when |enabled| is
+  // false, so that tests can compare the SSE2 and NEON kernels with them.
+  static void SetVectorizedKernelsEnabledForTesting(bool enabled);
+
  private:
   SkBitmapOperations();  // Class for scoping only.
 
@@ -0,0 +1,106 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/skbitmap_operations.h"
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorPriv.h"
+
+namespace {
+
+// Large enough to stand for a themed toolbar or a high-DPI icon sheet.
+const int kBitmapWidth = 512;
+const int kBitmapHeight = 256;
+const int kIterations = 50;
+
+void FillBitmap(uint32_t seed, SkBitmap* bitmap) {
+  bitmap->allocN32Pixels(kBitmapWidth, kBitmapHeight);
+  SkAutoLockPixels lock(*bitmap);
+  for (int y = 0; y < kBitmapHeight; ++y) {
+    for (int x = 0; x < kBitmapWidth; ++x) {
+      seed = seed * 1103515245 + 12345;
+      *bitmap->getAddr32(x, y) = SkPreMultiplyColor(seed);
+    }
+  }
+}
+
+// Reports the time per megapixel of |operation| with the vectorized kernels
+// and with the scalar loops.
+void RunOperationTest(const std::string& name,
+                      const base::Callback<SkBitmap()>& operation) {
+  const double megapixels =
+      static_cast<double>(kBitmapWidth) * kBitmapHeight * kIterations / 1e6;
+
+  for (bool vectorized : {true, false}) {
+    SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(vectorized);
+    operation.Run();
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i)
+      EXPECT_FALSE(operation.Run().isNull());
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    perf_test::PrintResult(name, vectorized ? "_vectorized" : "_scalar", "",
+                           elapsed.InMicrosecondsF() / megapixels,
+                           "us/megapixel", true);
+  }
+  SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(true);
+}
+
+SkBitmap Blend(const SkBitmap* first, const SkBitmap* second) {
+  return SkBitmapOperations::CreateBlendedBitmap(*first, *second, 0.4);
+}
+
+SkBitmap Mask(const SkBitmap* rgb, const SkBitmap* alpha) {
+  return SkBitmapOperations::CreateMaskedBitmap(*rgb, *alpha);
+}
+
+SkBitmap ButtonBackground(const SkBitmap* image, const SkBitmap* mask) {
+  return SkBitmapOperations::CreateButtonBackground(
+      SkColorSetARGB(0xC0, 0x30, 0x60, 0x90), *image, *mask);
+}
+
+SkBitmap HSLShift(const SkBitmap* bitmap, double lightness) {
+  color_utils::HSL hsl = {-1, -1, lightness};
+  return SkBitmapOperations::CreateHSLShiftedBitmap(*bitmap, hsl);
+}
+
+}  // namespace
+
+TEST(SkBitmapOperationsPerfTest, CreateBlendedBitmap) {
+  SkBitmap first, second;
+  FillBitmap(1, &first);
+  FillBitmap(2, &second);
+  RunOperationTest("blend", base::Bind(&Blend, &first, &second));
+}
+
+TEST(SkBitmapOperationsPerfTest, CreateMaskedBitmap) {
+  SkBitmap rgb, alpha;
+  FillBitmap(3, &rgb);
+  FillBitmap(4, &alpha);
+  RunOperationTest("mask", base::Bind(&Mask, &rgb, &alpha));
+}
+
+TEST(SkBitmapOperationsPerfTest, CreateButtonBackground) {
+  SkBitmap image, mask;
+  FillBitmap(5, &image);
+  FillBitmap(6, &mask);
+  RunOperationTest("button_background",
+                   base::Bind(&ButtonBackground, &image, &mask));
+}
+
+TEST(SkBitmapOperationsPerfTest, CreateHSLShiftedBitmap) {
+  SkBitmap bitmap;
+  FillBitmap(7, &bitmap);
+  RunOperationTest("hsl_darken", base::Bind(&HSLShift, &bitmap, 0.3));
+  RunOperationTest("hsl_lighten", base::Bind(&HSLShift, &bitmap, 0.7));
+}
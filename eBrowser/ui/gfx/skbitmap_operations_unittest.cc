@@ -5,6 +5,7 @@
 #include "ui/gfx/skbitmap_operations.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -59,6 +60,32 @@ void FillDataToBitmap(int w, int h, SkBitmap* bmp) {
   }
 }
 
+// Fills |bmp| with deterministic premultiplied pixels of every alpha value.
+void FillPremultipliedBitmap(int w, int h, uint32_t seed, SkBitmap* bmp) {
+  bmp->allocN32Pixels(w, h);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      seed = seed * 1103515245 + 12345;
+      SkColor color = SkColorSetARGB((x + y * w) % 256, (seed >> 24) & 0xFF,
+                                     (seed >> 16) & 0xFF, (seed >> 8) & 0xFF);
+      *bmp->getAddr32(x, y) = SkPreMultiplyColor(color);
+    }
+  }
+}
+
+bool BitmapsEqual(const SkBitmap& a, const SkBitmap& b) {
+  SkAutoLockPixels a_lock(a);
+  SkAutoLockPixels b_lock(b);
+
+  if (a.width() != b.width() || a.height() != b.height())
+    return false;
+  for (int y = 0; y < a.height(); y++) {
+    if (memcmp(a.getAddr32(0, y), b.getAddr32(0, y), a.width() * 4))
+      return false;
+  }
+  return true;
+}
+
 // The reference (i.e., old) implementation of |CreateHSLShiftedBitmap()|.
 SkBitmap ReferenceCreateHSLShiftedBitmap(
     const SkBitmap& bitmap,
@@ -209,6 +236,68 @@ TEST(SkBitmapOperationsTest, CreateMaskedBitmap) {
   }
 }
 
+// The vectorized kernels must produce exactly the scalar results. The odd width
+// leaves a tail for the scalar loop after the kernel.
+TEST(SkBitmapOperationsTest, VectorizedBlendMatchesScalar) {
+  SkBitmap first, second;
+  FillPremultipliedBitmap(37, 9, 1, &first);
+  FillPremultipliedBitmap(37, 9, 2, &second);
+
+  for (double alpha : {0.1, 0.3, 0.5, 0.77}) {
+    SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(false);
+    SkBitmap expected =
+        SkBitmapOperations::CreateBlendedBitmap(first, second, alpha);
+    SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(true);
+    SkBitmap blended =
+        SkBitmapOperations::CreateBlendedBitmap(first, second, alpha);
+    EXPECT_TRUE(BitmapsEqual(expected, blended)) << alpha;
+  }
+}
+
+TEST(SkBitmapOperationsTest, VectorizedMaskMatchesScalar) {
+  SkBitmap rgb, alpha;
+  FillPremultipliedBitmap(37, 9, 3, &rgb);
+  FillPremultipliedBitmap(37, 9, 4, &alpha);
+
+  SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(false);
+  SkBitmap expected = SkBitmapOperations::CreateMaskedBitmap(rgb, alpha);
+  SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(true);
+  SkBitmap masked = SkBitmapOperations::CreateMaskedBitmap(rgb, alpha);
+  EXPECT_TRUE(BitmapsEqual(expected, masked));
+}
+
+TEST(SkBitmapOperationsTest, VectorizedButtonBackgroundMatchesScalar) {
+  SkBitmap image, mask;
+  // A narrower image is tiled across the mask.
+  FillPremultipliedBitmap(13, 5, 5, &image);
+  FillPremultipliedBitmap(37, 9, 6, &mask);
+
+  for (SkColor color : {SK_ColorBLACK, SkColorSetARGB(0x80, 0x20, 0x90, 0xF0),
+                        SkColorSetARGB(0xFF, 0xFF, 0x40, 0x00)}) {
+    SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(false);
+    SkBitmap expected =
+        SkBitmapOperations::CreateButtonBackground(color, image, mask);
+    SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(true);
+    SkBitmap background =
+        SkBitmapOperations::CreateButtonBackground(color, image, mask);
+    EXPECT_TRUE(BitmapsEqual(expected, background)) << color;
+  }
+}
+
+TEST(SkBitmapOperationsTest, VectorizedLightnessShiftMatchesScalar) {
+  SkBitmap bitmap;
+  FillPremultipliedBitmap(37, 9, 7, &bitmap);
+
+  for (double lightness : {0.0, 0.2, 0.49, 0.51, 0.8, 1.0}) {
+    color_utils::HSL hsl = {-1, -1, lightness};
+    SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(false);
+    SkBitmap expected = SkBitmapOperations::CreateHSLShiftedBitmap(bitmap, hsl);
+    SkBitmapOperations::SetVectorizedKernelsEnabledForTesting(true);
+    SkBitmap shifted = SkBitmapOperations::CreateHSLShiftedBitmap(bitmap, hsl);
+    EXPECT_TRUE(BitmapsEqual(expected, shifted)) << lightness;
+  }
+}
+
 // Make sure that when shifting a bitmap without any shift parameters,
 // the end result is close enough to the original (rounding errors
 // notwithstanding).
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -144,6 +145,51 @@ base::string16 StringSlicer::CutString(size_t length,
          text_.substr(suffix_start);
 }
 
+StringSlicerWidths::StringSlicerWidths(const std::vector<float>& advances,
+                                       bool elide_in_middle,
+                                       bool elide_at_beginning)
+    : prefix_widths_(advances.size() + 1, 0.0f),
+      elide_in_middle_(elide_in_middle),
+      elide_at_beginning_(elide_at_beginning) {
+  for (size_t i = 0; i < advances.size(); ++i)
+    prefix_widths_[i + 1] = prefix_widths_[i] + advances[i];
+}
+
+StringSlicerWidths::~StringSlicerWidths() {
+}
+
+float StringSlicerWidths::GetCutWidth(size_t length) const {
+  const size_t text_length = prefix_widths_.size() - 1;
+  length = std::min(length, text_length);
+  const float total_width = prefix_widths_[text_length];
+
+  if (elide_at_beginning_)
+    return total_width - prefix_widths_[text_length - length];
+
+  if (!elide_in_middle_)
+    return prefix_widths_[length];
+
+  // Same split as StringSlicer::CutString().
+  const size_t half_length = length / 2;
+  return prefix_widths_[length - half_length] + total_width -
+         prefix_widths_[text_length - half_length];
+}
+
+size_t StringSlicerWidths::GetLengthForWidth(float available_width) const {
+  // The cut width never decreases with the length, so bisect for the last
+  // length that fits.
+  size_t lo = 0;
+  size_t hi = prefix_widths_.size() - 1;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo + 1) / 2;
+    if (GetCutWidth(mid) <= available_width)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
 base::string16 ElideFilename(const base::FilePath& filename,
                              const FontList& font_list,
                              float available_pixel_width) {
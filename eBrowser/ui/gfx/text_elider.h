@@ -68,6 +68,37 @@ class GFX_EXPORT StringSlicer {
   DISALLOW_COPY_AND_ASSIGN(StringSlicer);
 };
 
+// Prefix sums of the grapheme advances of a string, measured once, used to
+// estimate in O(log n) the longest StringSlicer cut that fits a width without
+// shaping the cut. Kerning and shaping across the cut point make this an
+// estimate, so callers still measure the cut they pick.
+class GFX_EXPORT StringSlicerWidths {
+ public:
+  // |advances[i]| is the width of the grapheme starting at index i of the
+  // text, or 0 if i is inside a grapheme. |elide_in_middle| and
+  // |elide_at_beginning| must match those of the StringSlicer.
+  StringSlicerWidths(const std::vector<float>& advances,
+                     bool elide_in_middle,
+                     bool elide_at_beginning);
+  ~StringSlicerWidths();
+
+  // Returns the width of the text kept by StringSlicer::CutString(|length|),
+  // not counting the ellipsis.
+  float GetCutWidth(size_t length) const;
+
+  // Returns the largest length whose cut is at most |available_width| wide.
+  size_t GetLengthForWidth(float available_width) const;
+
+ private:
+  // |prefix_widths_[i]| is the width of the first i characters.
+  std::vector<float> prefix_widths_;
+
+  bool elide_in_middle_;
+  bool elide_at_beginning_;
+
+  DISALLOW_COPY_AND_ASSIGN(StringSlicerWidths);
+};
+
 // Elides |text| to fit the |available_pixel_width| with the specified behavior.
 GFX_EXPORT base::string16 ElideText(const base::string16& text,
                                     const gfx::FontList& font_list,
@@ -0,0 +1,85 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/text_elider.h"
+
+#include <string>
+
+#include "base/macros.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/gfx/font_list.h"
+#include "ui/gfx/text_constants.h"
+#include "ui/gfx/text_utils.h"
+
+namespace gfx {
+namespace {
+
+const int kIterations = 20;
+
+// Strings of the length tab titles and the omnibox elide.
+const char* const kLongUrls[] = {
+    "https://www.example.com/search?q=streaming+row+incremental+decoding+of"
+    "+progressive+images&source=hp&ei=a1b2c3d4e5f6g7h8&oq=streaming+row"
+    "&gs_l=psy-ab.3..0l10.1234.5678.0.9012.0.0.0.0.0.0.0.0..0.0....0...1c.1",
+    "https://code.example.org/project/src/+/refs/heads/master/ui/gfx/"
+    "render_text_harfbuzz.cc?type=cs&q=ShapeRunWithFont&sq=package:project"
+    "&l=1480#anchor-for-a-fairly-deep-link-into-the-file",
+    "file:///home/user/Documents/Projects/2017/quarterly-review/drafts/"
+    "final-final-v3/presentation-with-a-rather-long-descriptive-name.pdf",
+};
+
+const char* const kLongTitles[] = {
+    "Breaking: Researchers announce a new approach to text layout that makes "
+    "browser tab strips noticeably faster on low-end devices - Example News",
+    "How to configure incremental compilation for very large C++ projects "
+    "with distributed caching and remote execution - Developer Forum",
+    "Weekly meeting notes: rendering, input latency, memory footprint, "
+    "startup time, and the plan for the next milestone (shared document)",
+};
+
+// Reports the time to elide each of |strings| to a range of widths with
+// |behavior|.
+void RunElideTest(const std::string& name,
+                  const char* const* strings,
+                  size_t string_count,
+                  ElideBehavior behavior) {
+  const FontList font_list;
+  const int kWidths[] = {60, 150, 300};
+
+  int elisions = 0;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < string_count; ++j) {
+      const base::string16 text = base::UTF8ToUTF16(strings[j]);
+      for (int width : kWidths) {
+        base::string16 elided = ElideText(text, font_list, width, behavior);
+        EXPECT_GE(width, GetStringWidthF(elided, font_list));
+        ++elisions;
+      }
+    }
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  perf_test::PrintResult("elide_time", "", name,
+                         elapsed.InMicrosecondsF() / elisions, "us", true);
+}
+
+}  // namespace
+
+TEST(TextEliderPerfTest, ElideUrls) {
+  RunElideTest("UrlTail", kLongUrls, arraysize(kLongUrls), ELIDE_TAIL);
+  RunElideTest("UrlMiddle", kLongUrls, arraysize(kLongUrls), ELIDE_MIDDLE);
+  RunElideTest("UrlHead", kLongUrls, arraysize(kLongUrls), ELIDE_HEAD);
+}
+
+TEST(TextEliderPerfTest, ElideTitles) {
+  RunElideTest("TitleTail", kLongTitles, arraysize(kLongTitles), ELIDE_TAIL);
+  RunElideTest("TitleTruncate", kLongTitles, arraysize(kLongTitles),
+               TRUNCATE);
+}
+
+}  // namespace gfx
@@ -596,6 +596,35 @@ TEST(TextEliderTest, StringSlicerCombiningSurrogate) {
   EXPECT_EQ(base::string16(kEllipsisUTF16), slicer_mid.CutString(4, true));
 }
 
+TEST(TextEliderTest, StringSlicerWidths) {
+  // Five graphemes; the third spans two characters.
+  const std::vector<float> advances = {1, 2, 4, 0, 8, 16};
+
+  const StringSlicerWidths tail(advances, false, false);
+  EXPECT_EQ(0, tail.GetCutWidth(0));
+  EXPECT_EQ(3, tail.GetCutWidth(2));
+  EXPECT_EQ(31, tail.GetCutWidth(6));
+  EXPECT_EQ(31, tail.GetCutWidth(100));
+  EXPECT_EQ(0U, tail.GetLengthForWidth(0.5f));
+  EXPECT_EQ(2U, tail.GetLengthForWidth(3));
+  EXPECT_EQ(4U, tail.GetLengthForWidth(14.5f));
+  EXPECT_EQ(6U, tail.GetLengthForWidth(100));
+
+  const StringSlicerWidths head(advances, false, true);
+  EXPECT_EQ(16, head.GetCutWidth(1));
+  EXPECT_EQ(24, head.GetCutWidth(3));
+  EXPECT_EQ(1U, head.GetLengthForWidth(23));
+  EXPECT_EQ(3U, head.GetLengthForWidth(24));
+
+  // The middle cut keeps the extra character before the cut, like
+  // StringSlicer::CutString().
+  const StringSlicerWidths middle(advances, true, false);
+  EXPECT_EQ(1 + 16, middle.GetCutWidth(2));
+  EXPECT_EQ(1 + 2 + 16, middle.GetCutWidth(3));
+  EXPECT_EQ(2U, middle.GetLengthForWidth(18));
+  EXPECT_EQ(3U, middle.GetLengthForWidth(19));
+}
+
 TEST(TextEliderTest, ElideString) {
   struct TestData {
     const char* input;
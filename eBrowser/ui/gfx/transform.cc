@@ -7,19 +7,37 @@
 
 #include "ui/gfx/transform.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "base/logging.h"
 #include "base/strings/stringprintf.h"
+#include "build/build_config.h"
 #include "ui/gfx/geometry/box_f.h"
 #include "ui/gfx/geometry/point.h"
 #include "ui/gfx/geometry/point3_f.h"
+#include "ui/gfx/geometry/point_f.h"
 #include "ui/gfx/geometry/rect.h"
 #include "ui/gfx/geometry/safe_integer_conversions.h"
 #include "ui/gfx/geometry/vector3d_f.h"
 #include "ui/gfx/skia_util.h"
 #include "ui/gfx/transform_util.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define TRANSFORM_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#define TRANSFORM_USE_NEON
+#endif
+
+// ARMv7 NEON has no double-precision lanes for the concat, which must match
+// SkMatrix44's double math.
+#if defined(TRANSFORM_USE_SSE2) || \
+    (defined(TRANSFORM_USE_NEON) && defined(ARCH_CPU_ARM64))
+#define TRANSFORM_VECTORIZED_CONCAT
+#endif
+
 namespace gfx {
 
 namespace {
@@ -45,6 +63,91 @@ static float Round(float f) {
   return (f > 0.f) ? std::floor(f + 0.5f) : std::ceil(f - 0.5f);
 }
 
+// SkMatrix44 handles identity and scale-translate operands itself, and
+// computes the other products with a double accumulator per element. This
+// does the same IEEE operations in the same order, two rows at a time, so
+// the results are identical.
+void Concat(const SkMatrix44& a, const SkMatrix44& b, SkMatrix44* result) {
+#if defined(TRANSFORM_VECTORIZED_CONCAT)
+  const SkMatrix44::TypeMask simple =
+      SkMatrix44::kScale_Mask | SkMatrix44::kTranslate_Mask;
+  if (!a.isIdentity() && !b.isIdentity() &&
+      ((a.getType() | b.getType()) & ~simple)) {
+    double lhs[16];
+    double rhs[16];
+    double product[16];
+    a.asColMajord(lhs);
+    b.asColMajord(rhs);
+    for (int col = 0; col < 4; ++col) {
+#if defined(TRANSFORM_USE_SSE2)
+      __m128d top = _mm_setzero_pd();
+      __m128d bottom = _mm_setzero_pd();
+      for (int k = 0; k < 4; ++k) {
+        __m128d factor = _mm_set1_pd(rhs[col * 4 + k]);
+        top = _mm_add_pd(top, _mm_mul_pd(_mm_loadu_pd(lhs + k * 4), factor));
+        bottom = _mm_add_pd(
+            bottom, _mm_mul_pd(_mm_loadu_pd(lhs + k * 4 + 2), factor));
+      }
+      _mm_storeu_pd(product + col * 4, top);
+      _mm_storeu_pd(product + col * 4 + 2, bottom);
+#else
+      // Separate multiplies and adds: a fused multiply-add rounds once and
+      // would not match.
+      float64x2_t top = vdupq_n_f64(0);
+      float64x2_t bottom = vdupq_n_f64(0);
+      for (int k = 0; k < 4; ++k) {
+        float64x2_t factor = vdupq_n_f64(rhs[col * 4 + k]);
+        top = vaddq_f64(top, vmulq_f64(vld1q_f64(lhs + k * 4), factor));
+        bottom =
+            vaddq_f64(bottom, vmulq_f64(vld1q_f64(lhs + k * 4 + 2), factor));
+      }
+      vst1q_f64(product + col * 4, top);
+      vst1q_f64(product + col * 4 + 2, bottom);
+#endif
+    }
+    result->setColMajord(product);
+    return;
+  }
+#endif
+  result->setConcat(a, b);
+}
+
+// Maps |count| interleaved x, y pairs by the 2d affine matrix
+// [m[0] m[1] m[2]; m[3] m[4] m[5]], as SkMatrix44::mapMScalars() would but
+// for the sign of zero.
+void TransformPointsAffine(const float m[6], float* xy, size_t count) {
+  size_t i = 0;
+#if defined(TRANSFORM_USE_SSE2)
+  // Two points per vector: x' = m0 x + m1 y and y' = m4 y + m3 x.
+  const __m128 diagonal = _mm_setr_ps(m[0], m[4], m[0], m[4]);
+  const __m128 skew = _mm_setr_ps(m[1], m[3], m[1], m[3]);
+  const __m128 translation = _mm_setr_ps(m[2], m[5], m[2], m[5]);
+  for (; i + 2 <= count; i += 2) {
+    __m128 point = _mm_loadu_ps(xy + i * 2);
+    __m128 swapped = _mm_shuffle_ps(point, point, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 mapped = _mm_add_ps(_mm_mul_ps(diagonal, point),
+                               _mm_mul_ps(skew, swapped));
+    _mm_storeu_ps(xy + i * 2, _mm_add_ps(mapped, translation));
+  }
+#elif defined(TRANSFORM_USE_NEON)
+  const float32x4_t diagonal = {m[0], m[4], m[0], m[4]};
+  const float32x4_t skew = {m[1], m[3], m[1], m[3]};
+  const float32x4_t translation = {m[2], m[5], m[2], m[5]};
+  for (; i + 2 <= count; i += 2) {
+    float32x4_t point = vld1q_f32(xy + i * 2);
+    float32x4_t mapped = vaddq_f32(vmulq_f32(diagonal, point),
+                                   vmulq_f32(skew, vrev64q_f32(point)));
+    vst1q_f32(xy + i * 2, vaddq_f32(mapped, translation));
+  }
+#endif
+  for (; i < count; ++i) {
+    float x = xy[i * 2];
+    float y = xy[i * 2 + 1];
+    xy[i * 2] = m[0] * x + m[1] * y + m[2];
+    xy[i * 2 + 1] = m[3] * x + m[4] * y + m[5];
+  }
+}
+
 }  // namespace
 
 Transform::Transform(SkMScalar col1row1,
@@ -216,11 +319,11 @@ void Transform::ApplyPerspectiveDepth(SkMScalar depth) {
 }
 
 void Transform::PreconcatTransform(const Transform& transform) {
-  matrix_.preConcat(transform.matrix_);
+  Concat(matrix_, transform.matrix_, &matrix_);
 }
 
 void Transform::ConcatTransform(const Transform& transform) {
-  matrix_.postConcat(transform.matrix_);
+  Concat(transform.matrix_, matrix_, &matrix_);
 }
 
 bool Transform::IsApproximatelyIdentityOrTranslation(
@@ -415,6 +518,34 @@ void Transform::TransformPoint(Point3F* point) const {
   TransformPointInternal(matrix_, point);
 }
 
+void Transform::TransformPoints(PointF* points, size_t count) const {
+  static_assert(sizeof(PointF) == 2 * sizeof(float),
+                "PointF must be an x, y pair");
+  if (matrix_.isIdentity())
+    return;
+  if (matrix_.hasPerspective()) {
+    for (size_t i = 0; i < count; ++i) {
+      Point3F point(points[i]);
+      TransformPointInternal(matrix_, &point);
+      points[i] = point.AsPointF();
+    }
+    return;
+  }
+  if (matrix_.isTranslate()) {
+    Vector2dF translation = To2dTranslation();
+    for (size_t i = 0; i < count; ++i)
+      points[i] += translation;
+    return;
+  }
+  const float m[6] = {SkMScalarToFloat(matrix_.get(0, 0)),
+                      SkMScalarToFloat(matrix_.get(0, 1)),
+                      SkMScalarToFloat(matrix_.get(0, 3)),
+                      SkMScalarToFloat(matrix_.get(1, 0)),
+                      SkMScalarToFloat(matrix_.get(1, 1)),
+                      SkMScalarToFloat(matrix_.get(1, 3))};
+  TransformPointsAffine(m, reinterpret_cast<float*>(points), count);
+}
+
 void Transform::TransformVector(Vector3dF* vector) const {
   DCHECK(vector);
   TransformVectorInternal(matrix_, vector);
@@ -448,6 +579,25 @@ void Transform::TransformRect(RectF* rect) const {
   if (matrix_.isIdentity())
     return;
 
+  // What SkMatrix::mapRect() does for these, without first converting to an
+  // SkMatrix.
+  if (matrix_.isScaleTranslate()) {
+    float scale_x = SkMScalarToFloat(matrix_.get(0, 0));
+    float scale_y = SkMScalarToFloat(matrix_.get(1, 1));
+    float translate_x = SkMScalarToFloat(matrix_.get(0, 3));
+    float translate_y = SkMScalarToFloat(matrix_.get(1, 3));
+    float left = rect->x() * scale_x + translate_x;
+    float right = rect->right() * scale_x + translate_x;
+    float top = rect->y() * scale_y + translate_y;
+    float bottom = rect->bottom() * scale_y + translate_y;
+    if (left > right)
+      std::swap(left, right);
+    if (top > bottom)
+      std::swap(top, bottom);
+    rect->SetRect(left, top, right - left, bottom - top);
+    return;
+  }
+
   SkRect src = RectFToSkRect(*rect);
   const SkMatrix& matrix = matrix_;
   matrix.mapRect(&src);
@@ -5,6 +5,8 @@
 #ifndef UI_GFX_TRANSFORM_H_
 #define UI_GFX_TRANSFORM_H_
 
+#include <stddef.h>
+
 #include <iosfwd>
 #include <string>
 
@@ -19,6 +21,7 @@ class BoxF;
 class RectF;
 class Point;
 class Point3F;
+class PointF;
 class Vector3dF;
 
 // 4x4 transformation matrix. Transform is cheap and explicitly allows
@@ -199,6 +202,11 @@ class GFX_EXPORT Transform {
   // Applies the transformation to the point.
   void TransformPoint(Point* point) const;
 
+  // Applies the transformation to |count| points, as TransformPoint() does to
+  // a Point3F at z = 0, dropping z. Translations and 2d affine matrices, the
+  // common case for layers, are vectorized.
+  void TransformPoints(PointF* points, size_t count) const;
+
   // Applies the transformation to the vector.
   void TransformVector(Vector3dF* vector) const;
 
@@ -0,0 +1,116 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gfx/transform.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/gfx/geometry/point3_f.h"
+#include "ui/gfx/geometry/point_f.h"
+#include "ui/gfx/geometry/rect_f.h"
+
+namespace gfx {
+namespace {
+
+const int kIterations = 100000;
+
+// Roughly the points of a frame's layer quads.
+const size_t kPoints = 256;
+
+// The kinds of matrices layers have, from cheapest to costliest.
+std::vector<std::pair<std::string, Transform>> TestTransforms() {
+  Transform translation;
+  translation.Translate(12.f, -340.f);
+  Transform scale_translate = translation;
+  scale_translate.Scale(2.625f, 2.625f);
+  Transform rotation = scale_translate;
+  rotation.Rotate(15.0);
+  Transform perspective = rotation;
+  perspective.ApplyPerspectiveDepth(800.f);
+  perspective.RotateAboutYAxis(20.0);
+  return {{"translate", translation},
+          {"scale_translate", scale_translate},
+          {"affine", rotation},
+          {"perspective", perspective}};
+}
+
+void PrintTime(const std::string& measurement,
+               const std::string& trace,
+               base::TimeDelta elapsed,
+               int operations) {
+  perf_test::PrintResult(
+      measurement, "", trace,
+      static_cast<size_t>(elapsed.InNanoseconds() / operations), "ns", true);
+}
+
+}  // namespace
+
+TEST(TransformPerfTest, Concat) {
+  for (const auto& lhs : TestTransforms()) {
+    const Transform& rhs = lhs.second;
+    Transform result;
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i) {
+      result = lhs.second;
+      result.ConcatTransform(rhs);
+    }
+    PrintTime("concat_time", lhs.first, base::TimeTicks::Now() - start,
+              kIterations);
+    EXPECT_FALSE(result.IsIdentity());
+  }
+}
+
+TEST(TransformPerfTest, TransformPoints) {
+  std::vector<PointF> points(kPoints);
+  for (size_t i = 0; i < kPoints; ++i)
+    points[i] = PointF(static_cast<float>(i * 7 % 1080),
+                       static_cast<float>(i * 13 % 1920));
+  const int iterations = kIterations / 100;
+
+  for (const auto& transform : TestTransforms()) {
+    std::vector<PointF> mapped;
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < iterations; ++i) {
+      mapped = points;
+      for (PointF& point : mapped) {
+        Point3F point3(point);
+        transform.second.TransformPoint(&point3);
+        point = point3.AsPointF();
+      }
+    }
+    PrintTime("transform_point_time", transform.first,
+              base::TimeTicks::Now() - start, iterations * kPoints);
+
+    start = base::TimeTicks::Now();
+    for (int i = 0; i < iterations; ++i) {
+      mapped = points;
+      transform.second.TransformPoints(mapped.data(), mapped.size());
+    }
+    PrintTime("transform_points_time", transform.first,
+              base::TimeTicks::Now() - start, iterations * kPoints);
+  }
+}
+
+TEST(TransformPerfTest, TransformRect) {
+  for (const auto& transform : TestTransforms()) {
+    RectF rect;
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kIterations; ++i) {
+      rect = RectF(i % 100, 20.f, 300.f, 400.f);
+      transform.second.TransformRect(&rect);
+    }
+    PrintTime("transform_rect_time", transform.first,
+              base::TimeTicks::Now() - start, kIterations);
+    EXPECT_FALSE(rect.IsEmpty());
+  }
+}
+
+}  // namespace gfx
@@ -9,6 +9,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <ostream>
@@ -19,6 +20,7 @@
 #include "ui/gfx/geometry/box_f.h"
 #include "ui/gfx/geometry/point.h"
 #include "ui/gfx/geometry/point3_f.h"
+#include "ui/gfx/geometry/point_f.h"
 #include "ui/gfx/geometry/quad_f.h"
 #include "ui/gfx/geometry/vector3d_f.h"
 #include "ui/gfx/transform_util.h"
@@ -2647,6 +2649,79 @@ TEST(XFormTest, TransformRectReverse) {
   EXPECT_FALSE(singular.TransformRectReverse(&rect));
 }
 
+TEST(XFormTest, TransformRectScaleTranslate) {
+  Transform transform;
+  transform.Translate(10.f, 20.f);
+  transform.Scale(-2.f, 3.f);
+  RectF rect(1.f, 2.f, 3.f, 4.f);
+  RectF expected(2.f, 26.f, 6.f, 12.f);
+  transform.TransformRect(&rect);
+  EXPECT_EQ(expected.ToString(), rect.ToString());
+}
+
+// Concatenation is vectorized for matrices SkMatrix44 has no fast path for;
+// the results must not differ from its own.
+TEST(XFormTest, ConcatMatchesSkMatrix44) {
+  Transform scale_translate;
+  scale_translate.Translate(4.f, -3.f);
+  scale_translate.Scale3d(2.f, 0.5f, 3.f);
+  Transform rotation;
+  rotation.RotateAbout(Vector3dF(1.f, 2.f, 3.f), 33.0);
+  Transform perspective;
+  perspective.ApplyPerspectiveDepth(400.f);
+  perspective.RotateAboutYAxis(21.0);
+  perspective.Translate3d(-7.f, 11.f, 13.f);
+  Transform skew;
+  skew.Skew(12.0, -31.0);
+  const Transform transforms[] = {Transform(), scale_translate, rotation,
+                                  perspective, skew};
+
+  for (const Transform& lhs : transforms) {
+    for (const Transform& rhs : transforms) {
+      SkMatrix44 expected(SkMatrix44::kUninitialized_Constructor);
+      expected.setConcat(rhs.matrix(), lhs.matrix());
+      Transform concat = lhs;
+      concat.ConcatTransform(rhs);
+      EXPECT_TRUE(concat.matrix() == expected);
+
+      expected.setConcat(lhs.matrix(), rhs.matrix());
+      Transform preconcat = lhs;
+      preconcat.PreconcatTransform(rhs);
+      EXPECT_TRUE(preconcat.matrix() == expected);
+    }
+  }
+}
+
+TEST(XFormTest, TransformPoints) {
+  Transform translation;
+  translation.Translate(3.f, -7.f);
+  Transform scale_translate = translation;
+  scale_translate.Scale(-2.f, 0.25f);
+  Transform rotation = scale_translate;
+  rotation.Rotate(47.0);
+  Transform perspective = rotation;
+  perspective.ApplyPerspectiveDepth(100.f);
+  perspective.RotateAboutXAxis(30.0);
+  const Transform transforms[] = {Transform(), translation, scale_translate,
+                                  rotation, perspective};
+
+  // An odd count leaves a point for the scalar tail of the vector loops.
+  const PointF points[] = {PointF(0.f, 0.f), PointF(1.5f, -2.f),
+                           PointF(100.f, 40.f), PointF(-33.f, 8.25f),
+                           PointF(7.f, 7.f)};
+  for (const Transform& transform : transforms) {
+    PointF mapped[arraysize(points)];
+    std::copy(points, points + arraysize(points), mapped);
+    transform.TransformPoints(mapped, arraysize(mapped));
+    for (size_t i = 0; i < arraysize(points); ++i) {
+      Point3F expected(points[i]);
+      transform.TransformPoint(&expected);
+      EXPECT_FLOAT_EQ(expected.x(), mapped[i].x());
+      EXPECT_FLOAT_EQ(expected.y(), mapped[i].y());
+    }
+  }
+}
+
 TEST(XFormTest, TransformBox) {
   Transform translation;
   translation.Translate3d(3.f, 7.f, 6.f);
@@ -29,6 +29,42 @@ UNCONDITIONALLY_BOUND_EXTENSIONS = set([
   'GL_CHROMIUM_egl_khr_fence_sync_hack', # crbug.com/504758
 ])
 
+"""Entry points called often enough per frame that their macros call the
+driver directly while the current GLApi is the one that forwards to it
+unchanged, instead of making a virtual call into it. RealGLApi must not
+override any of them. Trace and stub APIs still get the virtual call, and
+the debug and null draw bindings live in the driver's function table, so
+they apply either way."""
+FAST_GL_FUNCTIONS = set([
+  'glActiveTexture',
+  'glBindBuffer',
+  'glBindFramebufferEXT',
+  'glBindTexture',
+  'glBindVertexArrayOES',
+  'glBlendFunc',
+  'glClear',
+  'glDisable',
+  'glDisableVertexAttribArray',
+  'glDrawArrays',
+  'glDrawElements',
+  'glEnable',
+  'glEnableVertexAttribArray',
+  'glScissor',
+  'glUniform1f',
+  'glUniform1fv',
+  'glUniform1i',
+  'glUniform2f',
+  'glUniform2fv',
+  'glUniform3fv',
+  'glUniform4f',
+  'glUniform4fv',
+  'glUniformMatrix3fv',
+  'glUniformMatrix4fv',
+  'glUseProgram',
+  'glVertexAttribPointer',
+  'glViewport',
+])
+
 """Function binding conditions can be specified manually by supplying a versions
 array instead of the names array. Each version has the following keys:
    name: Mandatory. Name of the function. Multiple versions can have the same
@@ -1881,6 +1917,10 @@ EGL_FUNCTIONS = [
   'names': ['eglPostSubBufferNV'],
   'arguments': 'EGLDisplay dpy, EGLSurface surface, '
     'EGLint x, EGLint y, EGLint width, EGLint height', },
+{ 'return_type': 'EGLBoolean',
+  'versions': [{ 'name': 'eglPresentationTimeANDROID',
+                 'extensions': ['EGL_ANDROID_presentation_time'] }],
+  'arguments': 'EGLDisplay dpy, EGLSurface surface, EGLnsecsANDROID time', },
 { 'return_type': 'EGLenum',
   'names': ['eglQueryAPI'],
   'arguments': 'void', },
@@ -2307,6 +2347,16 @@ def GetStaticBinding(func):
     return None
 
 
+def MakeArgNames(arguments):
+  argument_names = re.sub(
+      r'(const )?[a-zA-Z0-9_]+\** ([a-zA-Z0-9_]+)', r'\2', arguments)
+  argument_names = re.sub(
+      r'(const )?[a-zA-Z0-9_]+\** ([a-zA-Z0-9_]+)', r'\2', argument_names)
+  if argument_names == 'void' or argument_names == '':
+    argument_names = ''
+  return argument_names
+
+
 def GenerateHeader(file, functions, set_name,
                    used_extensions, used_client_extensions):
   """Generates gl_bindings_autogen_x.h"""
@@ -2368,14 +2418,61 @@ class GLContext;
   # macro.
   file.write('\n')
   for func in functions:
-    file.write('#define %s ::gl::g_current_%s_context->%sFn\n' %
-        (func['known_as'], set_name.lower(), func['known_as']))
+    if set_name == 'gl' and func['known_as'] in FAST_GL_FUNCTIONS:
+      file.write('#define %s ::gl::Fast_%s\n' %
+          (func['known_as'], func['known_as']))
+    else:
+      file.write('#define %s ::gl::g_current_%s_context->%sFn\n' %
+          (func['known_as'], set_name.lower(), func['known_as']))
 
   file.write('\n')
   file.write('#endif  //  UI_GL_GL_BINDINGS_AUTOGEN_%s_H_\n' %
       set_name.upper())
 
 
+def GenerateFastBindingsHeader(file, functions):
+  """Generates gl_bindings_autogen_gl_fast.h"""
+
+  # Write file header.
+  file.write(LICENSE_AND_HEADER +
+"""
+
+#ifndef UI_GL_GL_BINDINGS_AUTOGEN_GL_FAST_H_
+#define UI_GL_GL_BINDINGS_AUTOGEN_GL_FAST_H_
+
+namespace gl {
+""")
+
+  # Write the functions the macros of FAST_GL_FUNCTIONS expand to.
+  for func in functions:
+    function_name = func['known_as']
+    if function_name not in FAST_GL_FUNCTIONS:
+      continue
+    return_type = func['return_type']
+    argument_names = MakeArgNames(func['arguments'])
+    file.write('\n')
+    file.write('inline %s Fast_%s(%s) {\n' %
+        (return_type, function_name, func['arguments']))
+    file.write('  GLApi* api = g_current_gl_context;\n')
+    if return_type == 'void':
+      file.write('  if (api == g_fast_gl_api)\n')
+      file.write('    g_driver_gl.fn.%sFn(%s);\n' %
+          (function_name, argument_names))
+      file.write('  else\n')
+      file.write('    api->%sFn(%s);\n' % (function_name, argument_names))
+    else:
+      file.write('  if (api == g_fast_gl_api)\n')
+      file.write('    return g_driver_gl.fn.%sFn(%s);\n' %
+          (function_name, argument_names))
+      file.write('  return api->%sFn(%s);\n' % (function_name, argument_names))
+    file.write('}\n')
+
+  file.write('\n')
+  file.write('}  // namespace gl\n')
+  file.write('\n')
+  file.write('#endif  //  UI_GL_GL_BINDINGS_AUTOGEN_GL_FAST_H_\n')
+
+
 def GenerateAPIHeader(file, functions, set_name):
   """Generates gl_bindings_api_autogen_x.h"""
 
@@ -2749,15 +2846,6 @@ void DriverEGL::InitializeExtensionBindings() {
 }
 """ % set_name.upper())
 
-  def MakeArgNames(arguments):
-    argument_names = re.sub(
-        r'(const )?[a-zA-Z0-9_]+\** ([a-zA-Z0-9_]+)', r'\2', arguments)
-    argument_names = re.sub(
-        r'(const )?[a-zA-Z0-9_]+\** ([a-zA-Z0-9_]+)', r'\2', argument_names)
-    if argument_names == 'void' or argument_names == '':
-      argument_names = ''
-    return argument_names
-
   # Write GLApiBase functions
   for func in functions:
     function_name = func['known_as']
@@ -3279,6 +3367,12 @@ def main(argv):
     ClangFormat(source_file.name)
 
   if not options.verify_order:
+    header_file = open(
+        os.path.join(directory, 'gl_bindings_autogen_gl_fast.h'), 'wb')
+    GenerateFastBindingsHeader(header_file, GL_FUNCTIONS)
+    header_file.close()
+    ClangFormat(header_file.name)
+
     header_file = open(
         os.path.join(directory, 'gl_mock_autogen_gl.h'), 'wb')
     GenerateMockHeader(header_file, GL_FUNCTIONS, 'gl')
@@ -480,6 +480,9 @@ struct GL_EXPORT DriverGLX {
 // This #define is here to support autogenerated code.
 #define g_current_gl_context g_current_gl_context_tls->Get()
 GL_EXPORT extern base::ThreadLocalPointer<GLApi>* g_current_gl_context_tls;
+// The GLApi that forwards every call to g_driver_gl unchanged, if any. While
+// it is current, the entry points in gl_bindings_autogen_gl_fast.h skip it.
+GL_EXPORT extern GLApi* g_fast_gl_api;
 
 GL_EXPORT extern OSMESAApi* g_current_osmesa_context;
 GL_EXPORT extern DriverGL g_driver_gl;
@@ -502,4 +505,6 @@ GL_EXPORT extern DriverGLX g_driver_glx;
 
 }  // namespace gl
 
+#include "ui/gl/gl_bindings_autogen_gl_fast.h"
+
 #endif  // UI_GL_GL_BINDINGS_H_
@@ -84,6 +84,7 @@ void DriverEGL::InitializeStaticBindings() {
   fn.eglMakeCurrentFn =
       reinterpret_cast<eglMakeCurrentProc>(GetGLProcAddress("eglMakeCurrent"));
   fn.eglPostSubBufferNVFn = 0;
+  fn.eglPresentationTimeANDROIDFn = 0;
   fn.eglQueryAPIFn =
       reinterpret_cast<eglQueryAPIProc>(GetGLProcAddress("eglQueryAPI"));
   fn.eglQueryContextFn = reinterpret_cast<eglQueryContextProc>(
@@ -147,6 +148,8 @@ void DriverEGL::InitializeExtensionBindings() {
   ext.b_EGL_ANGLE_d3d_share_handle_client_buffer =
       extensions.find("EGL_ANGLE_d3d_share_handle_client_buffer ") !=
       std::string::npos;
+  ext.b_EGL_ANDROID_presentation_time =
+      extensions.find("EGL_ANDROID_presentation_time ") != std::string::npos;
   ext.b_EGL_ANGLE_query_surface_pointer =
       extensions.find("EGL_ANGLE_query_surface_pointer ") != std::string::npos;
   ext.b_EGL_ANGLE_stream_producer_d3d_texture_nv12 =
@@ -238,6 +241,13 @@ void DriverEGL::InitializeExtensionBindings() {
         GetGLProcAddress("eglPostSubBufferNV"));
   }
 
+  debug_fn.eglPresentationTimeANDROIDFn = 0;
+  if (ext.b_EGL_ANDROID_presentation_time) {
+    fn.eglPresentationTimeANDROIDFn =
+        reinterpret_cast<eglPresentationTimeANDROIDProc>(
+            GetGLProcAddress("eglPresentationTimeANDROID"));
+  }
+
   debug_fn.eglQueryStreamKHRFn = 0;
   if (ext.b_EGL_KHR_stream) {
     fn.eglQueryStreamKHRFn = reinterpret_cast<eglQueryStreamKHRProc>(
@@ -760,6 +770,19 @@ static EGLBoolean GL_BINDING_CALL Debug_eglPostSubBufferNV(EGLDisplay dpy,
   return result;
 }
 
+static EGLBoolean GL_BINDING_CALL
+Debug_eglPresentationTimeANDROID(EGLDisplay dpy,
+                                 EGLSurface surface,
+                                 EGLnsecsANDROID time) {
+  GL_SERVICE_LOG("eglPresentationTimeANDROID"
+                 << "(" << dpy << ", " << surface << ", " << time << ")");
+  DCHECK(g_driver_egl.debug_fn.eglPresentationTimeANDROIDFn != nullptr);
+  EGLBoolean result =
+      g_driver_egl.debug_fn.eglPresentationTimeANDROIDFn(dpy, surface, time);
+  GL_SERVICE_LOG("GL_RESULT: " << result);
+  return result;
+}
+
 static EGLenum GL_BINDING_CALL Debug_eglQueryAPI(void) {
   GL_SERVICE_LOG("eglQueryAPI"
                  << "("
@@ -1196,6 +1219,10 @@ void DriverEGL::InitializeDebugBindings() {
     debug_fn.eglPostSubBufferNVFn = fn.eglPostSubBufferNVFn;
     fn.eglPostSubBufferNVFn = Debug_eglPostSubBufferNV;
   }
+  if (!debug_fn.eglPresentationTimeANDROIDFn) {
+    debug_fn.eglPresentationTimeANDROIDFn = fn.eglPresentationTimeANDROIDFn;
+    fn.eglPresentationTimeANDROIDFn = Debug_eglPresentationTimeANDROID;
+  }
   if (!debug_fn.eglQueryAPIFn) {
     debug_fn.eglQueryAPIFn = fn.eglQueryAPIFn;
     fn.eglQueryAPIFn = Debug_eglQueryAPI;
@@ -1513,6 +1540,12 @@ EGLBoolean EGLApiBase::eglPostSubBufferNVFn(EGLDisplay dpy,
   return driver_->fn.eglPostSubBufferNVFn(dpy, surface, x, y, width, height);
 }
 
+EGLBoolean EGLApiBase::eglPresentationTimeANDROIDFn(EGLDisplay dpy,
+                                                    EGLSurface surface,
+                                                    EGLnsecsANDROID time) {
+  return driver_->fn.eglPresentationTimeANDROIDFn(dpy, surface, time);
+}
+
 EGLenum EGLApiBase::eglQueryAPIFn(void) {
   return driver_->fn.eglQueryAPIFn();
 }
@@ -1897,6 +1930,14 @@ EGLBoolean TraceEGLApi::eglPostSubBufferNVFn(EGLDisplay dpy,
   return egl_api_->eglPostSubBufferNVFn(dpy, surface, x, y, width, height);
 }
 
+EGLBoolean TraceEGLApi::eglPresentationTimeANDROIDFn(EGLDisplay dpy,
+                                                     EGLSurface surface,
+                                                     EGLnsecsANDROID time) {
+  TRACE_EVENT_BINARY_EFFICIENT0("gpu",
+                                "TraceGLAPI::eglPresentationTimeANDROID")
+  return egl_api_->eglPresentationTimeANDROIDFn(dpy, surface, time);
+}
+
 EGLenum TraceEGLApi::eglQueryAPIFn(void) {
   TRACE_EVENT_BINARY_EFFICIENT0("gpu", "TraceGLAPI::eglQueryAPI")
   return egl_api_->eglQueryAPIFn();
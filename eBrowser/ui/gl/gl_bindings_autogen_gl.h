@@ -3146,7 +3146,7 @@ class GL_EXPORT GLApi {
 
 }  // namespace gl
 
-#define glActiveTexture ::gl::g_current_gl_context->glActiveTextureFn
+#define glActiveTexture ::gl::Fast_glActiveTexture
 #define glApplyFramebufferAttachmentCMAAINTEL \
   ::gl::g_current_gl_context->glApplyFramebufferAttachmentCMAAINTELFn
 #define glAttachShader ::gl::g_current_gl_context->glAttachShaderFn
@@ -3154,31 +3154,31 @@ class GL_EXPORT GLApi {
 #define glBeginTransformFeedback \
   ::gl::g_current_gl_context->glBeginTransformFeedbackFn
 #define glBindAttribLocation ::gl::g_current_gl_context->glBindAttribLocationFn
-#define glBindBuffer ::gl::g_current_gl_context->glBindBufferFn
+#define glBindBuffer ::gl::Fast_glBindBuffer
 #define glBindBufferBase ::gl::g_current_gl_context->glBindBufferBaseFn
 #define glBindBufferRange ::gl::g_current_gl_context->glBindBufferRangeFn
 #define glBindFragDataLocation \
   ::gl::g_current_gl_context->glBindFragDataLocationFn
 #define glBindFragDataLocationIndexed \
   ::gl::g_current_gl_context->glBindFragDataLocationIndexedFn
-#define glBindFramebufferEXT ::gl::g_current_gl_context->glBindFramebufferEXTFn
+#define glBindFramebufferEXT ::gl::Fast_glBindFramebufferEXT
 #define glBindImageTextureEXT \
   ::gl::g_current_gl_context->glBindImageTextureEXTFn
 #define glBindRenderbufferEXT \
   ::gl::g_current_gl_context->glBindRenderbufferEXTFn
 #define glBindSampler ::gl::g_current_gl_context->glBindSamplerFn
-#define glBindTexture ::gl::g_current_gl_context->glBindTextureFn
+#define glBindTexture ::gl::Fast_glBindTexture
 #define glBindTransformFeedback \
   ::gl::g_current_gl_context->glBindTransformFeedbackFn
 #define glBindUniformLocationCHROMIUM \
   ::gl::g_current_gl_context->glBindUniformLocationCHROMIUMFn
-#define glBindVertexArrayOES ::gl::g_current_gl_context->glBindVertexArrayOESFn
+#define glBindVertexArrayOES ::gl::Fast_glBindVertexArrayOES
 #define glBlendBarrierKHR ::gl::g_current_gl_context->glBlendBarrierKHRFn
 #define glBlendColor ::gl::g_current_gl_context->glBlendColorFn
 #define glBlendEquation ::gl::g_current_gl_context->glBlendEquationFn
 #define glBlendEquationSeparate \
   ::gl::g_current_gl_context->glBlendEquationSeparateFn
-#define glBlendFunc ::gl::g_current_gl_context->glBlendFuncFn
+#define glBlendFunc ::gl::Fast_glBlendFunc
 #define glBlendFuncSeparate ::gl::g_current_gl_context->glBlendFuncSeparateFn
 #define glBlitFramebuffer ::gl::g_current_gl_context->glBlitFramebufferFn
 #define glBlitFramebufferANGLE \
@@ -3188,7 +3188,7 @@ class GL_EXPORT GLApi {
 #define glBufferSubData ::gl::g_current_gl_context->glBufferSubDataFn
 #define glCheckFramebufferStatusEXT \
   ::gl::g_current_gl_context->glCheckFramebufferStatusEXTFn
-#define glClear ::gl::g_current_gl_context->glClearFn
+#define glClear ::gl::Fast_glClear
 #define glClearBufferfi ::gl::g_current_gl_context->glClearBufferfiFn
 #define glClearBufferfv ::gl::g_current_gl_context->glClearBufferfvFn
 #define glClearBufferiv ::gl::g_current_gl_context->glClearBufferivFn
@@ -3252,17 +3252,16 @@ class GL_EXPORT GLApi {
 #define glDepthRange ::gl::g_current_gl_context->glDepthRangeFn
 #define glDepthRangef ::gl::g_current_gl_context->glDepthRangefFn
 #define glDetachShader ::gl::g_current_gl_context->glDetachShaderFn
-#define glDisable ::gl::g_current_gl_context->glDisableFn
-#define glDisableVertexAttribArray \
-  ::gl::g_current_gl_context->glDisableVertexAttribArrayFn
+#define glDisable ::gl::Fast_glDisable
+#define glDisableVertexAttribArray ::gl::Fast_glDisableVertexAttribArray
 #define glDiscardFramebufferEXT \
   ::gl::g_current_gl_context->glDiscardFramebufferEXTFn
-#define glDrawArrays ::gl::g_current_gl_context->glDrawArraysFn
+#define glDrawArrays ::gl::Fast_glDrawArrays
 #define glDrawArraysInstancedANGLE \
   ::gl::g_current_gl_context->glDrawArraysInstancedANGLEFn
 #define glDrawBuffer ::gl::g_current_gl_context->glDrawBufferFn
 #define glDrawBuffersARB ::gl::g_current_gl_context->glDrawBuffersARBFn
-#define glDrawElements ::gl::g_current_gl_context->glDrawElementsFn
+#define glDrawElements ::gl::Fast_glDrawElements
 #define glDrawElementsInstancedANGLE \
   ::gl::g_current_gl_context->glDrawElementsInstancedANGLEFn
 #define glDrawRangeElements ::gl::g_current_gl_context->glDrawRangeElementsFn
@@ -3270,9 +3269,8 @@ class GL_EXPORT GLApi {
   ::gl::g_current_gl_context->glEGLImageTargetRenderbufferStorageOESFn
 #define glEGLImageTargetTexture2DOES \
   ::gl::g_current_gl_context->glEGLImageTargetTexture2DOESFn
-#define glEnable ::gl::g_current_gl_context->glEnableFn
-#define glEnableVertexAttribArray \
-  ::gl::g_current_gl_context->glEnableVertexAttribArrayFn
+#define glEnable ::gl::Fast_glEnable
+#define glEnableVertexAttribArray ::gl::Fast_glEnableVertexAttribArray
 #define glEndQuery ::gl::g_current_gl_context->glEndQueryFn
 #define glEndTransformFeedback \
   ::gl::g_current_gl_context->glEndTransformFeedbackFn
@@ -3563,7 +3561,7 @@ class GL_EXPORT GLApi {
 #define glSamplerParameteriv ::gl::g_current_gl_context->glSamplerParameterivFn
 #define glSamplerParameterivRobustANGLE \
   ::gl::g_current_gl_context->glSamplerParameterivRobustANGLEFn
-#define glScissor ::gl::g_current_gl_context->glScissorFn
+#define glScissor ::gl::Fast_glScissor
 #define glSetFenceAPPLE ::gl::g_current_gl_context->glSetFenceAPPLEFn
 #define glSetFenceNV ::gl::g_current_gl_context->glSetFenceNVFn
 #define glShaderBinary ::gl::g_current_gl_context->glShaderBinaryFn
@@ -3621,26 +3619,26 @@ class GL_EXPORT GLApi {
   ::gl::g_current_gl_context->glTexSubImage3DRobustANGLEFn
 #define glTransformFeedbackVaryings \
   ::gl::g_current_gl_context->glTransformFeedbackVaryingsFn
-#define glUniform1f ::gl::g_current_gl_context->glUniform1fFn
-#define glUniform1fv ::gl::g_current_gl_context->glUniform1fvFn
-#define glUniform1i ::gl::g_current_gl_context->glUniform1iFn
+#define glUniform1f ::gl::Fast_glUniform1f
+#define glUniform1fv ::gl::Fast_glUniform1fv
+#define glUniform1i ::gl::Fast_glUniform1i
 #define glUniform1iv ::gl::g_current_gl_context->glUniform1ivFn
 #define glUniform1ui ::gl::g_current_gl_context->glUniform1uiFn
 #define glUniform1uiv ::gl::g_current_gl_context->glUniform1uivFn
-#define glUniform2f ::gl::g_current_gl_context->glUniform2fFn
-#define glUniform2fv ::gl::g_current_gl_context->glUniform2fvFn
+#define glUniform2f ::gl::Fast_glUniform2f
+#define glUniform2fv ::gl::Fast_glUniform2fv
 #define glUniform2i ::gl::g_current_gl_context->glUniform2iFn
 #define glUniform2iv ::gl::g_current_gl_context->glUniform2ivFn
 #define glUniform2ui ::gl::g_current_gl_context->glUniform2uiFn
 #define glUniform2uiv ::gl::g_current_gl_context->glUniform2uivFn
 #define glUniform3f ::gl::g_current_gl_context->glUniform3fFn
-#define glUniform3fv ::gl::g_current_gl_context->glUniform3fvFn
+#define glUniform3fv ::gl::Fast_glUniform3fv
 #define glUniform3i ::gl::g_current_gl_context->glUniform3iFn
 #define glUniform3iv ::gl::g_current_gl_context->glUniform3ivFn
 #define glUniform3ui ::gl::g_current_gl_context->glUniform3uiFn
 #define glUniform3uiv ::gl::g_current_gl_context->glUniform3uivFn
-#define glUniform4f ::gl::g_current_gl_context->glUniform4fFn
-#define glUniform4fv ::gl::g_current_gl_context->glUniform4fvFn
+#define glUniform4f ::gl::Fast_glUniform4f
+#define glUniform4fv ::gl::Fast_glUniform4fv
 #define glUniform4i ::gl::g_current_gl_context->glUniform4iFn
 #define glUniform4iv ::gl::g_current_gl_context->glUniform4ivFn
 #define glUniform4ui ::gl::g_current_gl_context->glUniform4uiFn
@@ -3650,14 +3648,14 @@ class GL_EXPORT GLApi {
 #define glUniformMatrix2fv ::gl::g_current_gl_context->glUniformMatrix2fvFn
 #define glUniformMatrix2x3fv ::gl::g_current_gl_context->glUniformMatrix2x3fvFn
 #define glUniformMatrix2x4fv ::gl::g_current_gl_context->glUniformMatrix2x4fvFn
-#define glUniformMatrix3fv ::gl::g_current_gl_context->glUniformMatrix3fvFn
+#define glUniformMatrix3fv ::gl::Fast_glUniformMatrix3fv
 #define glUniformMatrix3x2fv ::gl::g_current_gl_context->glUniformMatrix3x2fvFn
 #define glUniformMatrix3x4fv ::gl::g_current_gl_context->glUniformMatrix3x4fvFn
-#define glUniformMatrix4fv ::gl::g_current_gl_context->glUniformMatrix4fvFn
+#define glUniformMatrix4fv ::gl::Fast_glUniformMatrix4fv
 #define glUniformMatrix4x2fv ::gl::g_current_gl_context->glUniformMatrix4x2fvFn
 #define glUniformMatrix4x3fv ::gl::g_current_gl_context->glUniformMatrix4x3fvFn
 #define glUnmapBuffer ::gl::g_current_gl_context->glUnmapBufferFn
-#define glUseProgram ::gl::g_current_gl_context->glUseProgramFn
+#define glUseProgram ::gl::Fast_glUseProgram
 #define glValidateProgram ::gl::g_current_gl_context->glValidateProgramFn
 #define glVertexAttrib1f ::gl::g_current_gl_context->glVertexAttrib1fFn
 #define glVertexAttrib1fv ::gl::g_current_gl_context->glVertexAttrib1fvFn
@@ -3675,9 +3673,8 @@ class GL_EXPORT GLApi {
 #define glVertexAttribI4uiv ::gl::g_current_gl_context->glVertexAttribI4uivFn
 #define glVertexAttribIPointer \
   ::gl::g_current_gl_context->glVertexAttribIPointerFn
-#define glVertexAttribPointer \
-  ::gl::g_current_gl_context->glVertexAttribPointerFn
-#define glViewport ::gl::g_current_gl_context->glViewportFn
+#define glVertexAttribPointer ::gl::Fast_glVertexAttribPointer
+#define glViewport ::gl::Fast_glViewport
 #define glWaitSync ::gl::g_current_gl_context->glWaitSyncFn
 
 #endif  //  UI_GL_GL_BINDINGS_AUTOGEN_GL_H_
@@ -0,0 +1,253 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// This file is auto-generated from
+// ui/gl/generate_bindings.py
+// It's formatted by clang-format using chromium coding style:
+//    clang-format -i -style=chromium filename
+// DO NOT EDIT!
+
+#ifndef UI_GL_GL_BINDINGS_AUTOGEN_GL_FAST_H_
+#define UI_GL_GL_BINDINGS_AUTOGEN_GL_FAST_H_
+
+namespace gl {
+
+inline void Fast_glActiveTexture(GLenum texture) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glActiveTextureFn(texture);
+  else
+    api->glActiveTextureFn(texture);
+}
+
+inline void Fast_glBindBuffer(GLenum target, GLuint buffer) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glBindBufferFn(target, buffer);
+  else
+    api->glBindBufferFn(target, buffer);
+}
+
+inline void Fast_glBindFramebufferEXT(GLenum target, GLuint framebuffer) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glBindFramebufferEXTFn(target, framebuffer);
+  else
+    api->glBindFramebufferEXTFn(target, framebuffer);
+}
+
+inline void Fast_glBindTexture(GLenum target, GLuint texture) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glBindTextureFn(target, texture);
+  else
+    api->glBindTextureFn(target, texture);
+}
+
+inline void Fast_glBindVertexArrayOES(GLuint array) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glBindVertexArrayOESFn(array);
+  else
+    api->glBindVertexArrayOESFn(array);
+}
+
+inline void Fast_glBlendFunc(GLenum sfactor, GLenum dfactor) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glBlendFuncFn(sfactor, dfactor);
+  else
+    api->glBlendFuncFn(sfactor, dfactor);
+}
+
+inline void Fast_glClear(GLbitfield mask) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glClearFn(mask);
+  else
+    api->glClearFn(mask);
+}
+
+inline void Fast_glDisable(GLenum cap) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glDisableFn(cap);
+  else
+    api->glDisableFn(cap);
+}
+
+inline void Fast_glDisableVertexAttribArray(GLuint index) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glDisableVertexAttribArrayFn(index);
+  else
+    api->glDisableVertexAttribArrayFn(index);
+}
+
+inline void Fast_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glDrawArraysFn(mode, first, count);
+  else
+    api->glDrawArraysFn(mode, first, count);
+}
+
+inline void Fast_glDrawElements(GLenum mode,
+                                GLsizei count,
+                                GLenum type,
+                                const void* indices) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glDrawElementsFn(mode, count, type, indices);
+  else
+    api->glDrawElementsFn(mode, count, type, indices);
+}
+
+inline void Fast_glEnable(GLenum cap) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glEnableFn(cap);
+  else
+    api->glEnableFn(cap);
+}
+
+inline void Fast_glEnableVertexAttribArray(GLuint index) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glEnableVertexAttribArrayFn(index);
+  else
+    api->glEnableVertexAttribArrayFn(index);
+}
+
+inline void Fast_glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glScissorFn(x, y, width, height);
+  else
+    api->glScissorFn(x, y, width, height);
+}
+
+inline void Fast_glUniform1f(GLint location, GLfloat x) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform1fFn(location, x);
+  else
+    api->glUniform1fFn(location, x);
+}
+
+inline void Fast_glUniform1fv(GLint location, GLsizei count, const GLfloat* v) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform1fvFn(location, count, v);
+  else
+    api->glUniform1fvFn(location, count, v);
+}
+
+inline void Fast_glUniform1i(GLint location, GLint x) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform1iFn(location, x);
+  else
+    api->glUniform1iFn(location, x);
+}
+
+inline void Fast_glUniform2f(GLint location, GLfloat x, GLfloat y) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform2fFn(location, x, y);
+  else
+    api->glUniform2fFn(location, x, y);
+}
+
+inline void Fast_glUniform2fv(GLint location, GLsizei count, const GLfloat* v) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform2fvFn(location, count, v);
+  else
+    api->glUniform2fvFn(location, count, v);
+}
+
+inline void Fast_glUniform3fv(GLint location, GLsizei count, const GLfloat* v) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform3fvFn(location, count, v);
+  else
+    api->glUniform3fvFn(location, count, v);
+}
+
+inline void Fast_glUniform4f(GLint location,
+                             GLfloat x,
+                             GLfloat y,
+                             GLfloat z,
+                             GLfloat w) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform4fFn(location, x, y, z, w);
+  else
+    api->glUniform4fFn(location, x, y, z, w);
+}
+
+inline void Fast_glUniform4fv(GLint location, GLsizei count, const GLfloat* v) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniform4fvFn(location, count, v);
+  else
+    api->glUniform4fvFn(location, count, v);
+}
+
+inline void Fast_glUniformMatrix3fv(GLint location,
+                                    GLsizei count,
+                                    GLboolean transpose,
+                                    const GLfloat* value) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniformMatrix3fvFn(location, count, transpose, value);
+  else
+    api->glUniformMatrix3fvFn(location, count, transpose, value);
+}
+
+inline void Fast_glUniformMatrix4fv(GLint location,
+                                    GLsizei count,
+                                    GLboolean transpose,
+                                    const GLfloat* value) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUniformMatrix4fvFn(location, count, transpose, value);
+  else
+    api->glUniformMatrix4fvFn(location, count, transpose, value);
+}
+
+inline void Fast_glUseProgram(GLuint program) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glUseProgramFn(program);
+  else
+    api->glUseProgramFn(program);
+}
+
+inline void Fast_glVertexAttribPointer(GLuint indx,
+                                       GLint size,
+                                       GLenum type,
+                                       GLboolean normalized,
+                                       GLsizei stride,
+                                       const void* ptr) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glVertexAttribPointerFn(indx, size, type, normalized, stride,
+                                           ptr);
+  else
+    api->glVertexAttribPointerFn(indx, size, type, normalized, stride, ptr);
+}
+
+inline void Fast_glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  GLApi* api = g_current_gl_context;
+  if (api == g_fast_gl_api)
+    g_driver_gl.fn.glViewportFn(x, y, width, height);
+  else
+    api->glViewportFn(x, y, width, height);
+}
+
+}  // namespace gl
+
+#endif  //  UI_GL_GL_BINDINGS_AUTOGEN_GL_FAST_H_
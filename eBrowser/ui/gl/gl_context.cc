@@ -20,6 +20,7 @@
 #include "ui/gl/gl_surface.h"
 #include "ui/gl/gl_switches.h"
 #include "ui/gl/gl_version_info.h"
+#include "ui/gl/gpu_frame_timer.h"
 #include "ui/gl/gpu_timing.h"
 
 namespace gl {
@@ -49,7 +50,8 @@ GLContext::GLContext(GLShareGroup* share_group)
       current_virtual_context_(nullptr),
       state_dirtied_externally_(false),
       swap_interval_(1),
-      force_swap_interval_zero_(false) {
+      force_swap_interval_zero_(false),
+      gpu_frame_timer_checked_(false) {
   if (!share_group_.get())
     share_group_ = new gl::GLShareGroup();
 
@@ -175,6 +177,20 @@ void GLContext::ForceSwapIntervalZero(bool force) {
   OnSetSwapInterval(force_swap_interval_zero_ ? 0 : swap_interval_);
 }
 
+void GLContext::WillSwapBuffers() {
+  if (!gpu_frame_timer_checked_) {
+    gpu_frame_timer_checked_ = true;
+    if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+            switches::kEnableGpuFrameTiming)) {
+      scoped_refptr<GPUTimingClient> client = CreateGPUTimingClient();
+      if (client->IsAvailable())
+        gpu_frame_timer_.reset(new GPUFrameTimer(client));
+    }
+  }
+  if (gpu_frame_timer_)
+    gpu_frame_timer_->WillSwapBuffers();
+}
+
 bool GLContext::WasAllocatedUsingRobustnessExtension() {
   return false;
 }
@@ -29,6 +29,7 @@ class GLContextVirtual;
 namespace gl {
 
 class GLSurface;
+class GPUFrameTimer;
 class GPUTiming;
 class GPUTimingClient;
 struct GLVersionInfo;
@@ -74,6 +75,15 @@ class GL_EXPORT GLContext : public base::RefCounted<GLContext> {
   // passed to SetSwapInterval.
   void ForceSwapIntervalZero(bool force);
 
+  // Called by surfaces right before they swap, so that the frames drawn with
+  // this context are timed when --enable-gpu-frame-timing is set and the
+  // context supports timer queries. This context must be current.
+  void WillSwapBuffers();
+
+  // Returns the timer of the frames drawn with this context, or null if they
+  // are not timed.
+  GPUFrameTimer* gpu_frame_timer() { return gpu_frame_timer_.get(); }
+
   // Returns space separated list of extensions. The context must be current.
   virtual std::string GetExtensions();
 
@@ -175,6 +185,9 @@ class GL_EXPORT GLContext : public base::RefCounted<GLContext> {
   int swap_interval_;
   bool force_swap_interval_zero_;
 
+  bool gpu_frame_timer_checked_;
+  std::unique_ptr<GPUFrameTimer> gpu_frame_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(GLContext);
 };
 
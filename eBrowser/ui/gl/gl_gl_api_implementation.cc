@@ -385,6 +385,7 @@ void InitializeStaticGLBindingsGL() {
     g_no_context_gl = new NoContextGLApi();
   }
   g_real_gl->Initialize(&g_driver_gl);
+  g_fast_gl_api = g_real_gl;
   g_gl = g_real_gl;
   if (base::CommandLine::ForCurrentProcess()->HasSwitch(
           switches::kEnableGPUServiceTracing)) {
@@ -450,6 +451,7 @@ bool SetNullDrawGLBindingsEnabledGL(bool enabled) {
 }
 
 void ClearGLBindingsGL() {
+  g_fast_gl_api = NULL;
   if (g_real_gl) {
     delete g_real_gl;
     g_real_gl = NULL;
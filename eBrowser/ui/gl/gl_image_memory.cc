@@ -5,13 +5,17 @@
 #include "ui/gl/gl_image_memory.h"
 
 #include <stdint.h>
+#include <string.h>
 
+#include "base/command_line.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/trace_event/trace_event.h"
 #include "ui/gfx/buffer_format_util.h"
 #include "ui/gl/gl_bindings.h"
 #include "ui/gl/gl_context.h"
+#include "ui/gl/gl_fence.h"
+#include "ui/gl/gl_switches.h"
 #include "ui/gl/gl_version_info.h"
 
 using gfx::BufferFormat;
@@ -221,7 +225,8 @@ std::unique_ptr<uint8_t[]> GLES2RGBData(const gfx::Size& size,
                                         F const& data_to_rgb,
                                         GLenum* data_format,
                                         GLenum* data_type,
-                                        GLint* data_row_length) {
+                                        GLint* data_row_length,
+                                        size_t* data_stride) {
   TRACE_EVENT2("gpu", "GLES2RGBData", "width", size.width(), "height",
                size.height());
 
@@ -241,6 +246,7 @@ std::unique_ptr<uint8_t[]> GLES2RGBData(const gfx::Size& size,
   *data_format = GL_RGB;
   *data_type = GL_UNSIGNED_BYTE;
   *data_row_length = size.width();
+  *data_stride = gles2_rgb_data_stride;
   return gles2_rgb_data;
 }
 
@@ -249,7 +255,8 @@ std::unique_ptr<uint8_t[]> GLES2RGB565Data(const gfx::Size& size,
                                            const uint8_t* data,
                                            GLenum* data_format,
                                            GLenum* data_type,
-                                           GLint* data_row_length) {
+                                           GLint* data_row_length,
+                                           size_t* data_stride) {
   TRACE_EVENT2("gpu", "GLES2RGB565Data", "width", size.width(), "height",
                size.height());
 
@@ -273,6 +280,7 @@ std::unique_ptr<uint8_t[]> GLES2RGB565Data(const gfx::Size& size,
   *data_format = GL_RGB;
   *data_type = GL_UNSIGNED_SHORT_5_6_5;
   *data_row_length = size.width();
+  *data_stride = gles2_rgb_data_stride;
   return gles2_rgb_data;
 }
 
@@ -282,7 +290,8 @@ std::unique_ptr<uint8_t[]> GLES2Data(const gfx::Size& size,
                                      const uint8_t* data,
                                      GLenum* data_format,
                                      GLenum* data_type,
-                                     GLint* data_row_length) {
+                                     GLint* data_row_length,
+                                     size_t* data_stride) {
   TRACE_EVENT2("gpu", "GLES2Data", "width", size.width(), "height",
                size.height());
 
@@ -294,10 +303,11 @@ std::unique_ptr<uint8_t[]> GLES2Data(const gfx::Size& size,
                             dst[1] = src[1];
                             dst[2] = src[2];
                           },
-                          data_format, data_type, data_row_length);
+                          data_format, data_type, data_row_length,
+                          data_stride);
     case gfx::BufferFormat::BGR_565:
       return GLES2RGB565Data(size, stride, data, data_format, data_type,
-                             data_row_length);
+                             data_row_length, data_stride);
     case gfx::BufferFormat::BGRX_8888:
       return GLES2RGBData(size, stride, data,
                           [](const uint8_t* src, uint8_t* dst) {
@@ -305,7 +315,8 @@ std::unique_ptr<uint8_t[]> GLES2Data(const gfx::Size& size,
                             dst[1] = src[1];
                             dst[2] = src[0];
                           },
-                          data_format, data_type, data_row_length);
+                          data_format, data_type, data_row_length,
+                          data_stride);
     case gfx::BufferFormat::RGBA_4444:
     case gfx::BufferFormat::RGBA_8888:
     case gfx::BufferFormat::BGRA_8888:
@@ -324,6 +335,7 @@ std::unique_ptr<uint8_t[]> GLES2Data(const gfx::Size& size,
                gles2_data_stride);
       }
       *data_row_length = size.width();
+      *data_stride = gles2_data_stride;
       return gles2_data;
     }
     case gfx::BufferFormat::ATC:
@@ -343,14 +355,34 @@ std::unique_ptr<uint8_t[]> GLES2Data(const gfx::Size& size,
   return nullptr;
 }
 
+// Whether the current context can upload from pixel unpack buffers that it
+// maps with glMapBufferRange().
+bool PixelBuffersSupported() {
+  if (!GLFence::IsSupported())
+    return false;
+  const GLVersionInfo* version = GLContext::GetCurrent()->GetVersionInfo();
+  if (version->is_es)
+    return version->is_es3;
+  return version->IsAtLeastGL(3, 0) ||
+         (version->IsAtLeastGL(2, 1) &&
+          g_driver_gl.ext.b_GL_ARB_map_buffer_range);
+}
+
 }  // namespace
 
+GLImageMemory::PixelBuffer::PixelBuffer() : id(0), size(0) {}
+
+GLImageMemory::PixelBuffer::~PixelBuffer() {}
+
 GLImageMemory::GLImageMemory(const gfx::Size& size, unsigned internalformat)
     : size_(size),
       internalformat_(internalformat),
       memory_(nullptr),
       format_(gfx::BufferFormat::RGBA_8888),
-      stride_(0) {}
+      stride_(0),
+      pixel_buffer_uploads_(base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnablePixelBufferUploads)),
+      next_pixel_buffer_(0) {}
 
 GLImageMemory::~GLImageMemory() {
   DCHECK(!memory_);
@@ -386,6 +418,15 @@ bool GLImageMemory::Initialize(const unsigned char* memory,
 
 void GLImageMemory::Destroy(bool have_context) {
   memory_ = nullptr;
+  for (PixelBuffer& buffer : pixel_buffers_) {
+    if (buffer.fence && !have_context)
+      buffer.fence->Invalidate();
+    buffer.fence.reset();
+    if (buffer.id && have_context)
+      glDeleteBuffersARB(1, &buffer.id);
+    buffer.id = 0;
+    buffer.size = 0;
+  }
 }
 
 gfx::Size GLImageMemory::GetSize() {
@@ -417,19 +458,24 @@ bool GLImageMemory::CopyTexImage(unsigned target) {
     GLenum data_format = DataFormat(format_);
     GLenum data_type = DataType(format_);
     GLint data_row_length = DataRowLength(stride_, format_);
+    size_t data_stride = stride_;
     std::unique_ptr<uint8_t[]> gles2_data;
 
     if (GLContext::GetCurrent()->GetVersionInfo()->is_es) {
       gles2_data = GLES2Data(size_, format_, stride_, memory_, &data_format,
-                             &data_type, &data_row_length);
+                             &data_type, &data_row_length, &data_stride);
     }
 
     if (data_row_length != size_.width())
       glPixelStorei(GL_UNPACK_ROW_LENGTH, data_row_length);
 
-    glTexImage2D(target, 0, TextureFormat(format_), size_.width(),
-                 size_.height(), 0, data_format, data_type,
-                 gles2_data ? gles2_data.get() : memory_);
+    const uint8_t* data = gles2_data ? gles2_data.get() : memory_;
+    if (!UploadFromPixelBuffer(target, false, gfx::Point(), size_,
+                               data_format, data_type, data,
+                               data_stride * size_.height())) {
+      glTexImage2D(target, 0, TextureFormat(format_), size_.width(),
+                   size_.height(), 0, data_format, data_type, data);
+    }
 
     if (data_row_length != size_.width())
       glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
@@ -467,19 +513,25 @@ bool GLImageMemory::CopyTexSubImage(unsigned target,
     GLenum data_format = DataFormat(format_);
     GLenum data_type = DataType(format_);
     GLint data_row_length = DataRowLength(stride_, format_);
+    size_t data_stride = stride_;
     std::unique_ptr<uint8_t[]> gles2_data;
 
     if (GLContext::GetCurrent()->GetVersionInfo()->is_es) {
       gles2_data = GLES2Data(rect.size(), format_, stride_, data, &data_format,
-                             &data_type, &data_row_length);
+                             &data_type, &data_row_length, &data_stride);
     }
 
     if (data_row_length != rect.width())
       glPixelStorei(GL_UNPACK_ROW_LENGTH, data_row_length);
 
-    glTexSubImage2D(target, 0, offset.x(), offset.y(), rect.width(),
-                    rect.height(), data_format, data_type,
-                    gles2_data ? gles2_data.get() : data);
+    if (gles2_data)
+      data = gles2_data.get();
+    if (!UploadFromPixelBuffer(target, true, offset, rect.size(), data_format,
+                               data_type, data,
+                               data_stride * rect.height())) {
+      glTexSubImage2D(target, 0, offset.x(), offset.y(), rect.width(),
+                      rect.height(), data_format, data_type, data);
+    }
 
     if (data_row_length != rect.width())
       glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
@@ -488,6 +540,63 @@ bool GLImageMemory::CopyTexSubImage(unsigned target,
   return true;
 }
 
+bool GLImageMemory::UploadFromPixelBuffer(unsigned target,
+                                          bool sub_image,
+                                          const gfx::Point& offset,
+                                          const gfx::Size& size,
+                                          unsigned data_format,
+                                          unsigned data_type,
+                                          const uint8_t* data,
+                                          size_t data_size) {
+  if (!pixel_buffer_uploads_ || !PixelBuffersSupported())
+    return false;
+
+  // Rather than wait for the driver to finish reading the buffer, this upload
+  // goes through client memory.
+  PixelBuffer& buffer = pixel_buffers_[next_pixel_buffer_];
+  if (buffer.fence && !buffer.fence->HasCompleted())
+    return false;
+
+  TRACE_EVENT1("gpu", "GLImageMemory::UploadFromPixelBuffer", "size",
+               data_size);
+  // The decoder may have a client's buffer bound.
+  GLint bound_buffer = 0;
+  glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &bound_buffer);
+  if (!buffer.id)
+    glGenBuffersARB(1, &buffer.id);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+  if (buffer.size != data_size) {
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, data_size, nullptr, GL_STREAM_DRAW);
+    buffer.size = data_size;
+  }
+
+  // The fence above guarantees that no upload still reads the buffer, so it
+  // is mapped without synchronizing.
+  bool uploaded = false;
+  void* mapped = glMapBufferRange(
+      GL_PIXEL_UNPACK_BUFFER, 0, data_size,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT |
+          GL_MAP_UNSYNCHRONIZED_BIT);
+  if (mapped) {
+    memcpy(mapped, data, data_size);
+    // The contents are undefined if the unmap fails.
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+      if (sub_image) {
+        glTexSubImage2D(target, 0, offset.x(), offset.y(), size.width(),
+                        size.height(), data_format, data_type, nullptr);
+      } else {
+        glTexImage2D(target, 0, TextureFormat(format_), size.width(),
+                     size.height(), 0, data_format, data_type, nullptr);
+      }
+      buffer.fence.reset(GLFence::Create());
+      next_pixel_buffer_ = (next_pixel_buffer_ + 1) % arraysize(pixel_buffers_);
+      uploaded = true;
+    }
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bound_buffer);
+  return uploaded;
+}
+
 bool GLImageMemory::ScheduleOverlayPlane(gfx::AcceleratedWidget widget,
                                          int z_order,
                                          gfx::OverlayTransform transform,
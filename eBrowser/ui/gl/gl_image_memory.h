@@ -8,6 +8,9 @@
 #include "ui/gl/gl_image.h"
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
 
 #include "base/macros.h"
 #include "base/numerics/safe_math.h"
@@ -16,6 +19,8 @@
 
 namespace gl {
 
+class GLFence;
+
 class GL_EXPORT GLImageMemory : public GLImage {
  public:
   GLImageMemory(const gfx::Size& size, unsigned internalformat);
@@ -41,6 +46,12 @@ class GL_EXPORT GLImageMemory : public GLImage {
                             const gfx::RectF& crop_rect) override;
   void Flush() override {}
 
+  // Whether uncompressed uploads are staged in pixel unpack buffers where the
+  // context supports them. Defaults to --enable-pixel-buffer-uploads.
+  void set_pixel_buffer_uploads(bool enabled) {
+    pixel_buffer_uploads_ = enabled;
+  }
+
   static unsigned GetInternalFormatForTesting(gfx::BufferFormat format);
 
  protected:
@@ -50,12 +61,43 @@ class GL_EXPORT GLImageMemory : public GLImage {
   size_t stride() const { return stride_; }
 
  private:
+  // A pixel unpack buffer and the fence of the last upload that read it.
+  struct PixelBuffer {
+    PixelBuffer();
+    ~PixelBuffer();
+
+    unsigned id;
+    size_t size;
+    std::unique_ptr<GLFence> fence;
+  };
+
+  // Copies the |data_size| bytes at |data| into the next of
+  // |pixel_buffers_| and uploads |size| pixels to |target| from there, at
+  // |offset| if |sub_image|, so that the driver reads them after this
+  // returns. The unpack row length must already be set. Returns false,
+  // having uploaded nothing, if the context has no pixel buffers or the
+  // driver may still be reading the next one.
+  bool UploadFromPixelBuffer(unsigned target,
+                             bool sub_image,
+                             const gfx::Point& offset,
+                             const gfx::Size& size,
+                             unsigned data_format,
+                             unsigned data_type,
+                             const uint8_t* data,
+                             size_t data_size);
+
   const gfx::Size size_;
   const unsigned internalformat_;
   const unsigned char* memory_;
   gfx::BufferFormat format_;
   size_t stride_;
 
+  // See set_pixel_buffer_uploads(). The uploads alternate between the
+  // buffers, so that filling one does not wait for the previous upload.
+  bool pixel_buffer_uploads_;
+  PixelBuffer pixel_buffers_[2];
+  size_t next_pixel_buffer_;
+
   DISALLOW_COPY_AND_ASSIGN(GLImageMemory);
 };
 
@@ -103,5 +103,29 @@ INSTANTIATE_TYPED_TEST_CASE_P(GLImageSharedMemoryPool,
                               GLImageCopyTest,
                               GLImageSharedMemoryPoolTestDelegate);
 
+template <gfx::BufferFormat format>
+class GLImageSharedMemoryPixelBufferTestDelegate
+    : public GLImageSharedMemoryTestDelegate<format> {
+ public:
+  scoped_refptr<GLImage> CreateSolidColorImage(const gfx::Size& size,
+                                               const uint8_t color[4]) const {
+    scoped_refptr<GLImage> image =
+        GLImageSharedMemoryTestDelegate<format>::CreateSolidColorImage(size,
+                                                                       color);
+    static_cast<GLImageSharedMemory*>(image.get())
+        ->set_pixel_buffer_uploads(true);
+    return image;
+  }
+};
+
+using GLImagePixelBufferTestTypes = testing::Types<
+    GLImageSharedMemoryPixelBufferTestDelegate<gfx::BufferFormat::BGR_565>,
+    GLImageSharedMemoryPixelBufferTestDelegate<gfx::BufferFormat::RGBX_8888>,
+    GLImageSharedMemoryPixelBufferTestDelegate<gfx::BufferFormat::RGBA_8888>>;
+
+INSTANTIATE_TYPED_TEST_CASE_P(GLImageSharedMemoryPixelBuffer,
+                              GLImageCopyTest,
+                              GLImagePixelBufferTestTypes);
+
 }  // namespace
 }  // namespace gl
@@ -56,6 +56,7 @@ void CleanupNativeLibraries(void* unused) {
 }  // namespace
 
 base::ThreadLocalPointer<GLApi>* g_current_gl_context_tls = NULL;
+GLApi* g_fast_gl_api = NULL;
 OSMESAApi* g_current_osmesa_context;
 
 #if defined(USE_EGL)
@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -131,6 +132,12 @@ bool g_egl_window_fixed_size_supported = false;
 bool g_egl_surfaceless_context_supported = false;
 bool g_egl_surface_orientation_supported = false;
 bool g_use_direct_composition = false;
+bool g_egl_presentation_time_supported = false;
+base::TimeDelta g_target_frame_interval;
+int g_throttled_swap_interval = 1;
+// Bumped on every change of |g_throttled_swap_interval| so each surface applies
+// it once, on its next swap.
+unsigned g_throttled_swap_interval_generation = 0;
 
 EGLDisplay GetPlatformANGLEDisplay(EGLNativeDisplayType native_display,
                                    EGLenum platform_type,
@@ -484,6 +491,8 @@ bool GLSurfaceEGL::InitializeOneOff(EGLNativeDisplayType native_display) {
       HasEGLExtension("EGL_ANGLE_window_fixed_size");
   g_egl_surface_orientation_supported =
       HasEGLExtension("EGL_ANGLE_surface_orientation");
+  g_egl_presentation_time_supported =
+      HasEGLExtension("EGL_ANDROID_presentation_time");
 
   // Need EGL_ANGLE_flexible_surface_compatibility to allow surfaces with and
   // without alpha to be bound to the same context.
@@ -539,6 +548,9 @@ void GLSurfaceEGL::ResetForTesting() {
   g_egl_surface_orientation_supported = false;
   g_use_direct_composition = false;
   g_egl_surfaceless_context_supported = false;
+  g_egl_presentation_time_supported = false;
+  g_target_frame_interval = base::TimeDelta();
+  g_throttled_swap_interval = 1;
 
   initialized_ = false;
 }
@@ -578,6 +590,20 @@ bool GLSurfaceEGL::IsDirectCompositionSupported() {
   return g_use_direct_composition;
 }
 
+// static
+void GLSurfaceEGL::SetTargetFrameInterval(base::TimeDelta interval) {
+  g_target_frame_interval = interval;
+}
+
+// static
+void GLSurfaceEGL::SetThrottledSwapInterval(int interval) {
+  interval = std::max(interval, 1);
+  if (interval == g_throttled_swap_interval)
+    return;
+  g_throttled_swap_interval = interval;
+  ++g_throttled_swap_interval_generation;
+}
+
 GLSurfaceEGL::~GLSurfaceEGL() {}
 
 // InitializeDisplay is necessary because the static binding code
@@ -648,8 +674,13 @@ NativeViewGLSurfaceEGL::NativeViewGLSurfaceEGL(EGLNativeWindowType window)
       surface_(NULL),
       supports_post_sub_buffer_(false),
       supports_swap_buffer_with_damage_(false),
+      post_sub_buffer_with_damage_(false),
       flips_vertically_(false),
       swap_interval_(1) {
+#if !defined(OS_WIN)
+  throttled_swap_interval_generation_ = 0;
+  max_swap_interval_ = 0;
+#endif
 #if defined(OS_ANDROID)
   if (window)
     ANativeWindow_acquire(window);
@@ -745,6 +776,18 @@ bool NativeViewGLSurfaceEGL::Initialize(
       base::CommandLine::ForCurrentProcess()->HasSwitch(
           switches::kEnableSwapBuffersWithDamage);
 
+#if defined(OS_ANDROID)
+  // Android drivers rarely expose EGL_NV_post_sub_buffer. Once the back buffer
+  // is preserved, a damage swap presents the same contents as posting the
+  // damaged sub-buffer, so use it to give the compositor partial swaps.
+  if (!supports_post_sub_buffer_ && supports_swap_buffer_with_damage_ &&
+      eglSurfaceAttrib(GetDisplay(), surface_, EGL_SWAP_BEHAVIOR,
+                       EGL_BUFFER_PRESERVED)) {
+    supports_post_sub_buffer_ = true;
+    post_sub_buffer_with_damage_ = true;
+  }
+#endif
+
   if (sync_provider)
     vsync_provider_.reset(sync_provider.release());
   else if (g_egl_sync_control_supported)
@@ -770,6 +813,28 @@ bool NativeViewGLSurfaceEGL::IsOffscreen() {
   return false;
 }
 
+void NativeViewGLSurfaceEGL::UpdatePresentationTime() {
+  if (!g_egl_presentation_time_supported ||
+      g_target_frame_interval.is_zero()) {
+    last_presentation_time_ = base::TimeTicks();
+    return;
+  }
+
+  // Frames that are already late are shown as soon as possible; the others
+  // wait out the target interval, which the driver sees as the deadline.
+  base::TimeTicks presentation_time = std::max(
+      base::TimeTicks::Now(), last_presentation_time_ + g_target_frame_interval);
+  // Presentation times are CLOCK_MONOTONIC nanoseconds, like TimeTicks.
+  if (!eglPresentationTimeANDROID(
+          GetDisplay(), surface_,
+          (presentation_time - base::TimeTicks()).InMicroseconds() *
+              base::Time::kNanosecondsPerMicrosecond)) {
+    DVLOG(1) << "eglPresentationTimeANDROID failed with error "
+             << GetLastEGLErrorString();
+  }
+  last_presentation_time_ = presentation_time;
+}
+
 void NativeViewGLSurfaceEGL::UpdateSwapInterval() {
 #if defined(OS_WIN)
   if (!g_use_direct_composition && (swap_interval_ != 0)) {
@@ -806,15 +871,49 @@ void NativeViewGLSurfaceEGL::UpdateSwapInterval() {
 
     swaps_this_generation_++;
   }
+#else
+  if (throttled_swap_interval_generation_ ==
+      g_throttled_swap_interval_generation)
+    return;
+  throttled_swap_interval_generation_ = g_throttled_swap_interval_generation;
+
+  // Surfaces that don't wait for vsync have nothing to pace.
+  if (swap_interval_ == 0)
+    return;
+
+  if (!max_swap_interval_ &&
+      !eglGetConfigAttrib(GetDisplay(), GetConfig(), EGL_MAX_SWAP_INTERVAL,
+                          &max_swap_interval_)) {
+    max_swap_interval_ = 1;
+  }
+  int interval = std::max(
+      swap_interval_, std::min(g_throttled_swap_interval, max_swap_interval_));
+  TRACE_EVENT1("gpu", "NativeViewGLSurfaceEGL::ThrottledSwapInterval",
+               "interval", interval);
+  if (!eglSwapInterval(GetDisplay(), interval)) {
+    DVLOG(1) << "eglSwapInterval failed with error "
+             << GetLastEGLErrorString();
+    // Leave presentation to the vsync decimation in the browser.
+    max_swap_interval_ = 1;
+    eglSwapInterval(GetDisplay(), swap_interval_);
+  }
 #endif
 }
 
+void NativeViewGLSurfaceEGL::UpdateFrameTimer() {
+  GLContext* context = GLContext::GetCurrent();
+  if (context)
+    context->WillSwapBuffers();
+}
+
 gfx::SwapResult NativeViewGLSurfaceEGL::SwapBuffers() {
   TRACE_EVENT2("gpu", "NativeViewGLSurfaceEGL:RealSwapBuffers",
       "width", GetSize().width(),
       "height", GetSize().height());
 
   UpdateSwapInterval();
+  UpdatePresentationTime();
+  UpdateFrameTimer();
 
   if (!CommitAndClearPendingOverlays()) {
     DVLOG(1) << "Failed to commit pending overlay planes.";
@@ -906,6 +1005,8 @@ gfx::SwapResult NativeViewGLSurfaceEGL::SwapBuffersWithDamage(int x,
                                                               int height) {
   DCHECK(supports_swap_buffer_with_damage_);
   UpdateSwapInterval();
+  UpdatePresentationTime();
+  UpdateFrameTimer();
   if (!CommitAndClearPendingOverlays()) {
     DVLOG(1) << "Failed to commit pending overlay planes.";
     return gfx::SwapResult::SWAP_FAILED;
@@ -931,7 +1032,11 @@ gfx::SwapResult NativeViewGLSurfaceEGL::PostSubBuffer(int x,
                                                       int width,
                                                       int height) {
   DCHECK(supports_post_sub_buffer_);
+  if (post_sub_buffer_with_damage_)
+    return SwapBuffersWithDamage(x, y, width, height);
   UpdateSwapInterval();
+  UpdatePresentationTime();
+  UpdateFrameTimer();
   if (!CommitAndClearPendingOverlays()) {
     DVLOG(1) << "Failed to commit pending overlay planes.";
     return gfx::SwapResult::SWAP_FAILED;
@@ -989,6 +1094,13 @@ bool NativeViewGLSurfaceEGL::ScheduleOverlayPlane(
 
 void NativeViewGLSurfaceEGL::OnSetSwapInterval(int interval) {
   swap_interval_ = interval;
+#if !defined(OS_WIN)
+  // The context may just have set |interval| on the EGL surface; have the
+  // next swap reapply any throttled interval on top of it.
+  if (g_throttled_swap_interval > 1)
+    throttled_swap_interval_generation_ =
+        g_throttled_swap_interval_generation - 1;
+#endif
 }
 
 NativeViewGLSurfaceEGL::~NativeViewGLSurfaceEGL() {
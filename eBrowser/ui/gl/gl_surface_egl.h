@@ -92,6 +92,18 @@ class GL_EXPORT GLSurfaceEGL : public GLSurface {
   static bool IsEGLSurfacelessContextSupported();
   static bool IsDirectCompositionSupported();
 
+  // Spaces the presentation times of window surface swaps at least
+  // |interval| apart with EGL_ANDROID_presentation_time, so that a throttled
+  // compositor hands the GPU a steady frame deadline instead of a burst
+  // followed by idle time. Zero, the default, presents as soon as possible.
+  static void SetTargetFrameInterval(base::TimeDelta interval);
+
+  // Raises the swap interval of window surfaces that swap with vsync to
+  // |interval| display refreshes, clamped to the config's
+  // EGL_MAX_SWAP_INTERVAL. 1 restores the surfaces' own intervals. Drivers
+  // that cannot go above 1 keep presenting at the display rate.
+  static void SetThrottledSwapInterval(int interval);
+
  protected:
   ~GLSurfaceEGL() override;
 
@@ -159,16 +171,33 @@ class GL_EXPORT NativeViewGLSurfaceEGL : public GLSurfaceEGL {
   // fail to be committed.
   bool CommitAndClearPendingOverlays();
   void UpdateSwapInterval();
+  void UpdatePresentationTime();
+  // Lets the current context time the frame being swapped.
+  void UpdateFrameTimer();
 
   EGLSurface surface_;
   bool supports_post_sub_buffer_;
   bool supports_swap_buffer_with_damage_;
+  // True when PostSubBuffer is implemented with a damage swap on a surface
+  // whose back buffer is preserved across swaps.
+  bool post_sub_buffer_with_damage_;
   bool flips_vertically_;
 
   std::unique_ptr<gfx::VSyncProvider> vsync_provider_;
 
   int swap_interval_;
 
+  // Presentation time requested for the last swap, if any.
+  base::TimeTicks last_presentation_time_;
+
+#if !defined(OS_WIN)
+  // The value of |g_throttled_swap_interval_generation| when the throttled
+  // swap interval was last applied to this surface.
+  unsigned throttled_swap_interval_generation_;
+  // Largest interval the config supports, or 0 until queried.
+  int max_swap_interval_;
+#endif
+
   std::vector<GLSurfaceOverlay> pending_overlays_;
 
 #if defined(OS_WIN)
@@ -105,6 +105,14 @@ const char kDisableGLExtensions[] = "disable-gl-extensions";
 // Use EGL_KHR_swap_buffers_with_damage to implement PostSubBuffers
 const char kEnableSwapBuffersWithDamage[] = "enable-swap-buffers-with-damage";
 
+// Stages the uploads of shared memory GLImages in pixel unpack buffers, so
+// that the driver copies them into textures asynchronously.
+const char kEnablePixelBufferUploads[] = "enable-pixel-buffer-uploads";
+
+// Times the GPU work of every frame with timer queries and traces it, along
+// with the fraction of the time the GPU is busy.
+const char kEnableGpuFrameTiming[] = "enable-gpu-frame-timing";
+
 // This is the list of switches passed from this file that are passed from the
 // GpuProcessHost to the GPU Process. Add your switch to this list if you need
 // to read it in the GPU process, else don't add it.
@@ -121,6 +129,8 @@ const char* kGLSwitchesCopiedFromGpuProcessHost[] = {
     kUseANGLE,
     kDisableDirectComposition,
     kEnableSwapBuffersWithDamage,
+    kEnablePixelBufferUploads,
+    kEnableGpuFrameTiming,
 };
 const int kGLSwitchesCopiedFromGpuProcessHostNumSwitches =
     arraysize(kGLSwitchesCopiedFromGpuProcessHost);
@@ -50,6 +50,8 @@ GL_EXPORT extern const char kEnableUnsafeES3APIs[];
 GL_EXPORT extern const char kEnableSgiVideoSync[];
 GL_EXPORT extern const char kDisableGLExtensions[];
 GL_EXPORT extern const char kEnableSwapBuffersWithDamage[];
+GL_EXPORT extern const char kEnablePixelBufferUploads[];
+GL_EXPORT extern const char kEnableGpuFrameTiming[];
 
 // These flags are used by the test harness code, not passed in by users.
 GL_EXPORT extern const char kDisableGLDrawingForTests[];
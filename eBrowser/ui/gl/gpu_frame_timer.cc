@@ -0,0 +1,81 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gl/gpu_frame_timer.h"
+
+#include <algorithm>
+
+#include "base/trace_event/trace_event.h"
+#include "ui/gl/gpu_timing.h"
+
+namespace gl {
+
+const size_t GPUFrameTimer::kWindowFrames = 60;
+const size_t GPUFrameTimer::kMaxPendingFrames = 8;
+
+GPUFrameTimer::GPUFrameTimer(scoped_refptr<GPUTimingClient> gpu_timing_client)
+    : gpu_timing_client_(gpu_timing_client) {}
+
+GPUFrameTimer::~GPUFrameTimer() {}
+
+void GPUFrameTimer::WillSwapBuffers() {
+  const int64_t now = gpu_timing_client_->GetCurrentCPUTime();
+  if (current_timer_) {
+    current_timer_->End();
+    pending_frames_.push_back(std::make_pair(
+        std::move(current_timer_), now - current_frame_begin_time_));
+    if (pending_frames_.size() > kMaxPendingFrames)
+      pending_frames_.pop_front();
+  }
+  CollectFinishedFrames();
+
+  current_timer_ = gpu_timing_client_->CreateGPUTimer(true);
+  current_timer_->Start();
+  current_frame_begin_time_ = now;
+}
+
+void GPUFrameTimer::CollectFinishedFrames() {
+  size_t finished_frames = 0;
+  while (finished_frames < pending_frames_.size() &&
+         pending_frames_[finished_frames].first->IsAvailable()) {
+    ++finished_frames;
+  }
+  if (!finished_frames)
+    return;
+
+  // A disjoint operation, such as a change of the GPU's clock, makes the
+  // results collected since the last check meaningless.
+  const bool disjoint = gpu_timing_client_->CheckAndResetTimerErrors();
+  for (size_t i = 0; i < finished_frames; ++i) {
+    GPUTimer* timer = pending_frames_.front().first.get();
+    if (!disjoint)
+      AddFrame(timer->GetDeltaElapsed(), pending_frames_.front().second);
+    timer->Destroy(true);
+    pending_frames_.pop_front();
+  }
+}
+
+void GPUFrameTimer::AddFrame(int64_t gpu_time, int64_t wall_time) {
+  last_frame_time_ = base::TimeDelta::FromMicroseconds(gpu_time);
+  window_.push_back(std::make_pair(gpu_time, wall_time));
+  window_gpu_time_ += gpu_time;
+  window_wall_time_ += wall_time;
+  if (window_.size() > kWindowFrames) {
+    window_gpu_time_ -= window_.front().first;
+    window_wall_time_ -= window_.front().second;
+    window_.pop_front();
+  }
+  busy_fraction_ =
+      window_wall_time_ > 0
+          ? std::min(1.0, static_cast<double>(window_gpu_time_) /
+                              window_wall_time_)
+          : 0;
+
+  TRACE_EVENT_INSTANT2("gpu", "GPUFrameTimer::Frame", TRACE_EVENT_SCOPE_THREAD,
+                       "gpu_time_us", gpu_time, "wall_time_us", wall_time);
+  TRACE_COUNTER1("gpu", "GPUFrameTimer::BusyPercent",
+                 static_cast<int>(busy_fraction_ * 100));
+}
+
+}  // namespace gl
@@ -0,0 +1,80 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_GL_GPU_FRAME_TIMER_H_
+#define UI_GL_GPU_FRAME_TIMER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "ui/gl/gl_export.h"
+
+namespace gl {
+
+class GPUTimer;
+class GPUTimingClient;
+
+// Times the GPU work of every frame drawn with a context, from one swap to
+// the next, with elapsed time queries. Frames are reported to tracing as
+// they finish, along with the fraction of the wall time between the swaps of
+// the last kWindowFrames frames that the GPU spent executing them.
+class GL_EXPORT GPUFrameTimer {
+ public:
+  // Number of frames the GPU busy fraction is averaged over.
+  static const size_t kWindowFrames;
+  // Number of ended frames whose results may be outstanding. Older frames
+  // are dropped, so a GPU that falls far behind does not pile up queries.
+  static const size_t kMaxPendingFrames;
+
+  explicit GPUFrameTimer(scoped_refptr<GPUTimingClient> gpu_timing_client);
+  ~GPUFrameTimer();
+
+  // Ends the timer of the frame drawn since the last swap, collects the
+  // frames the GPU has finished and starts timing the next frame. Call it
+  // right before swapping, with the context current.
+  void WillSwapBuffers();
+
+  // Fraction of the wall time spent on the GPU by the last kWindowFrames
+  // finished frames, 0 until the first one finishes.
+  double busy_fraction() const { return busy_fraction_; }
+
+  // GPU time of the last finished frame.
+  base::TimeDelta last_frame_time() const { return last_frame_time_; }
+
+ private:
+  void CollectFinishedFrames();
+  void AddFrame(int64_t gpu_time, int64_t wall_time);
+
+  scoped_refptr<GPUTimingClient> gpu_timing_client_;
+
+  // Timer of the frame being drawn, and the CPU time of the swap it started
+  // at.
+  std::unique_ptr<GPUTimer> current_timer_;
+  int64_t current_frame_begin_time_ = 0;
+
+  // Ended frames waiting for their results, with their wall times.
+  std::deque<std::pair<std::unique_ptr<GPUTimer>, int64_t>> pending_frames_;
+
+  // GPU and wall times, in microseconds, of the finished frames the busy
+  // fraction is computed over, and their sums.
+  std::deque<std::pair<int64_t, int64_t>> window_;
+  int64_t window_gpu_time_ = 0;
+  int64_t window_wall_time_ = 0;
+
+  double busy_fraction_ = 0;
+  base::TimeDelta last_frame_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(GPUFrameTimer);
+};
+
+}  // namespace gl
+
+#endif  // UI_GL_GPU_FRAME_TIMER_H_
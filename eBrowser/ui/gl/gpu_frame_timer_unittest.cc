@@ -0,0 +1,122 @@
+// Copyright 2017 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/gl/gpu_frame_timer.h"
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/bind.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gl/gl_context_stub_with_extensions.h"
+#include "ui/gl/gl_implementation.h"
+#include "ui/gl/gl_mock.h"
+#include "ui/gl/gl_surface_stub.h"
+#include "ui/gl/gpu_timing.h"
+#include "ui/gl/gpu_timing_fake.h"
+#include "ui/gl/init/gl_factory.h"
+#include "ui/gl/test/gl_surface_test_support.h"
+
+namespace gl {
+
+class GPUFrameTimerTest : public testing::Test {
+ public:
+  void TearDown() override {
+    context_ = nullptr;
+    surface_ = nullptr;
+    if (gl_) {
+      MockGLInterface::SetGLInterface(NULL);
+      init::ClearGLBindings();
+    }
+    gl_.reset();
+    gpu_timing_fake_queries_.Reset();
+  }
+
+  scoped_refptr<GPUTimingClient> CreateGPUTimingClient(bool disjoint) {
+    SetGLGetProcAddressProc(MockGLInterface::GetGLProcAddress);
+    GLSurfaceTestSupport::InitializeOneOffWithMockBindings();
+    gl_.reset(new ::testing::StrictMock<MockGLInterface>());
+    MockGLInterface::SetGLInterface(gl_.get());
+
+    context_ = new GLContextStubWithExtensions;
+    context_->AddExtensionsString(disjoint ? "GL_EXT_disjoint_timer_query"
+                                           : "GL_ARB_timer_query");
+    context_->SetGLVersionString("3.2");
+    surface_ = new GLSurfaceStub;
+    context_->MakeCurrent(surface_.get());
+    gpu_timing_fake_queries_.Reset();
+    gpu_timing_fake_queries_.ExpectGPUTimerQuery(*gl_, true);
+    if (disjoint)
+      gpu_timing_fake_queries_.ExpectDisjointCalls(*gl_);
+    SetTimes(cpu_time_, gl_time_);
+
+    scoped_refptr<GPUTimingClient> client = context_->CreateGPUTimingClient();
+    client->SetCpuTimeForTesting(base::Bind(&GPUTimingFake::GetFakeCPUTime));
+    return client;
+  }
+
+  // Swaps |wall_time| microseconds after the last swap, with the GPU having
+  // spent |gpu_time| microseconds on the frame.
+  void Swap(GPUFrameTimer* frame_timer, int64_t wall_time, int64_t gpu_time) {
+    SetTimes(cpu_time_ + wall_time, gl_time_ + gpu_time);
+    frame_timer->WillSwapBuffers();
+  }
+
+ protected:
+  void SetTimes(int64_t cpu_time, int64_t gl_time) {
+    cpu_time_ = cpu_time;
+    gl_time_ = gl_time;
+    gpu_timing_fake_queries_.SetCPUGLOffset(gl_time_ - cpu_time_);
+    gpu_timing_fake_queries_.SetCurrentCPUTime(cpu_time_);
+  }
+
+  int64_t cpu_time_ = 1000;
+  int64_t gl_time_ = 1000;
+  std::unique_ptr<::testing::StrictMock<MockGLInterface>> gl_;
+  scoped_refptr<GLContextStubWithExtensions> context_;
+  scoped_refptr<GLSurfaceStub> surface_;
+  GPUTimingFake gpu_timing_fake_queries_;
+};
+
+TEST_F(GPUFrameTimerTest, BusyFraction) {
+  GPUFrameTimer frame_timer(CreateGPUTimingClient(false));
+  frame_timer.WillSwapBuffers();
+  EXPECT_EQ(0, frame_timer.busy_fraction());
+
+  // 4 ms of GPU work per frame at 60 fps keeps the GPU busy a quarter of the
+  // time.
+  for (int i = 0; i < 3; ++i)
+    Swap(&frame_timer, 16000, 4000);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(4),
+            frame_timer.last_frame_time());
+  EXPECT_DOUBLE_EQ(0.25, frame_timer.busy_fraction());
+
+  // Halving the frame rate halves it once the window only holds the slower
+  // frames.
+  for (size_t i = 0; i < GPUFrameTimer::kWindowFrames; ++i)
+    Swap(&frame_timer, 32000, 4000);
+  EXPECT_DOUBLE_EQ(0.125, frame_timer.busy_fraction());
+}
+
+TEST_F(GPUFrameTimerTest, DisjointFramesAreDropped) {
+  GPUFrameTimer frame_timer(CreateGPUTimingClient(true));
+  frame_timer.WillSwapBuffers();
+  Swap(&frame_timer, 16000, 4000);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(4),
+            frame_timer.last_frame_time());
+
+  gpu_timing_fake_queries_.SetDisjoint();
+  Swap(&frame_timer, 16000, 8000);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(4),
+            frame_timer.last_frame_time());
+  EXPECT_DOUBLE_EQ(0.25, frame_timer.busy_fraction());
+
+  Swap(&frame_timer, 16000, 8000);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(8),
+            frame_timer.last_frame_time());
+  EXPECT_DOUBLE_EQ(12000.0 / 32000, frame_timer.busy_fraction());
+}
+
+}  // namespace gl
@@ -21,7 +21,10 @@ BoxLayout::BoxLayout(BoxLayout::Orientation orientation,
       cross_axis_alignment_(CROSS_AXIS_ALIGNMENT_STRETCH),
       default_flex_(0),
       minimum_cross_axis_size_(0),
-      host_(NULL) {
+      host_(NULL),
+      cached_preferred_size_valid_(false),
+      cached_height_for_width_width_(-1),
+      cached_height_for_width_(0) {
 }
 
 BoxLayout::~BoxLayout() {
@@ -154,6 +157,9 @@ void BoxLayout::Layout(View* host) {
 
 gfx::Size BoxLayout::GetPreferredSize(const View* host) const {
   DCHECK_EQ(host_, host);
+  if (cached_preferred_size_valid_)
+    return cached_preferred_size_;
+
   // Calculate the child views' preferred width.
   int width = 0;
   if (orientation_ == kVertical) {
@@ -167,18 +173,32 @@ gfx::Size BoxLayout::GetPreferredSize(const View* host) const {
     width = std::max(width, minimum_cross_axis_size_);
   }
 
-  return GetPreferredSizeForChildWidth(host, width);
+  cached_preferred_size_ = GetPreferredSizeForChildWidth(host, width);
+  cached_preferred_size_valid_ = true;
+  return cached_preferred_size_;
 }
 
 int BoxLayout::GetPreferredHeightForWidth(const View* host, int width) const {
   DCHECK_EQ(host_, host);
+  if (width == cached_height_for_width_width_)
+    return cached_height_for_width_;
+
   int child_width = width - NonChildSize(host).width();
-  return GetPreferredSizeForChildWidth(host, child_width).height();
+  cached_height_for_width_ =
+      GetPreferredSizeForChildWidth(host, child_width).height();
+  cached_height_for_width_width_ = width;
+  return cached_height_for_width_;
 }
 
 void BoxLayout::Installed(View* host) {
   DCHECK(!host_);
   host_ = host;
+  InvalidateLayout();
+}
+
+void BoxLayout::InvalidateLayout() {
+  cached_preferred_size_valid_ = false;
+  cached_height_for_width_width_ = -1;
 }
 
 void BoxLayout::ViewRemoved(View* host, View* view) {
@@ -71,14 +71,17 @@ class VIEWS_EXPORT BoxLayout : public LayoutManager {
 
   void set_cross_axis_alignment(CrossAxisAlignment cross_axis_alignment) {
     cross_axis_alignment_ = cross_axis_alignment;
+    InvalidateLayout();
   }
 
   void set_inside_border_insets(const gfx::Insets& insets) {
     inside_border_insets_ = insets;
+    InvalidateLayout();
   }
 
   void set_minimum_cross_axis_size(int size) {
     minimum_cross_axis_size_ = size;
+    InvalidateLayout();
   }
 
   // Sets the flex weight for the given |view|. Using the preferred size as
@@ -99,6 +102,7 @@ class VIEWS_EXPORT BoxLayout : public LayoutManager {
 
   // Overridden from views::LayoutManager:
   void Installed(View* host) override;
+  void InvalidateLayout() override;
   void ViewRemoved(View* host, View* view) override;
   void Layout(View* host) override;
   gfx::Size GetPreferredSize(const View* host) const override;
@@ -167,6 +171,14 @@ class VIEWS_EXPORT BoxLayout : public LayoutManager {
   // The view that this BoxLayout is managing the layout for.
   views::View* host_;
 
+  // The host's preferred size, and its preferred height for the width it was
+  // last asked about, kept until InvalidateLayout(). Resizing a hierarchy
+  // asks each level for these many times with nothing changed.
+  mutable bool cached_preferred_size_valid_;
+  mutable gfx::Size cached_preferred_size_;
+  mutable int cached_height_for_width_width_;
+  mutable int cached_height_for_width_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(BoxLayout);
 };
 
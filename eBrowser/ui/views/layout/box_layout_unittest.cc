@@ -6,7 +6,11 @@
 
 #include <stddef.h>
 
+#include <vector>
+
+#include "base/time/time.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
 #include "ui/views/test/test_views.h"
 #include "ui/views/view.h"
 
@@ -21,6 +25,30 @@ class BoxLayoutTest : public testing::Test {
   std::unique_ptr<View> host_;
 };
 
+// A view that counts how often its preferred size is asked for.
+class CountingView : public View {
+ public:
+  explicit CountingView(const gfx::Size& size) : size_(size), count_(0) {}
+
+  void set_size(const gfx::Size& size) {
+    size_ = size;
+    PreferredSizeChanged();
+  }
+
+  int count() const { return count_; }
+
+  gfx::Size GetPreferredSize() const override {
+    ++count_;
+    return size_;
+  }
+
+ private:
+  gfx::Size size_;
+  mutable int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingView);
+};
+
 }  // namespace
 
 TEST_F(BoxLayoutTest, Empty) {
@@ -629,4 +657,87 @@ TEST_F(BoxLayoutTest, MinimumCrossAxisHorizontal) {
   EXPECT_EQ(gfx::Size(20, 30), layout->GetPreferredSize(host_.get()));
 }
 
+TEST_F(BoxLayoutTest, CachesPreferredSize) {
+  host_->SetLayoutManager(new BoxLayout(BoxLayout::kVertical, 0, 0, 0));
+  View* middle = new View;
+  middle->SetLayoutManager(new BoxLayout(BoxLayout::kHorizontal, 0, 0, 0));
+  host_->AddChildView(middle);
+  CountingView* v1 = new CountingView(gfx::Size(10, 20));
+  middle->AddChildView(v1);
+  View* v2 = new StaticSizedView(gfx::Size(10, 10));
+  host_->AddChildView(v2);
+
+  EXPECT_EQ(gfx::Size(10, 30), host_->GetPreferredSize());
+  int count = v1->count();
+  EXPECT_EQ(gfx::Size(10, 30), host_->GetPreferredSize());
+  EXPECT_EQ(gfx::Size(10, 20), middle->GetPreferredSize());
+  EXPECT_EQ(count, v1->count());
+
+  // A change deep in the hierarchy invalidates every level above it.
+  v1->set_size(gfx::Size(30, 40));
+  EXPECT_EQ(gfx::Size(30, 50), host_->GetPreferredSize());
+  EXPECT_LT(count, v1->count());
+
+  // So does hiding a child.
+  v2->SetVisible(false);
+  EXPECT_EQ(gfx::Size(30, 40), host_->GetPreferredSize());
+}
+
+TEST_F(BoxLayoutTest, CachesPreferredHeightForWidth) {
+  BoxLayout* layout = new BoxLayout(BoxLayout::kVertical, 0, 0, 0);
+  host_->SetLayoutManager(layout);
+  ProportionallySizedView* v1 = new ProportionallySizedView(2);
+  host_->AddChildView(v1);
+
+  EXPECT_EQ(20, host_->GetHeightForWidth(10));
+  EXPECT_EQ(40, host_->GetHeightForWidth(20));
+  host_->AddChildView(new ProportionallySizedView(1));
+  EXPECT_EQ(60, host_->GetHeightForWidth(20));
+  layout->set_inside_border_insets(gfx::Insets(5, 0));
+  EXPECT_EQ(70, host_->GetHeightForWidth(20));
+}
+
+// Resizes a deep hierarchy of nested BoxLayouts the way a resize animation
+// does, and reports how often the leaves are asked for their size.
+TEST_F(BoxLayoutTest, DeepHierarchyResize) {
+  const int kDepth = 12;
+  const int kFrames = 60;
+  std::vector<CountingView*> leaves;
+  View* level = host_.get();
+  for (int i = 0; i < kDepth; ++i) {
+    level->SetLayoutManager(new BoxLayout(
+        i % 2 ? BoxLayout::kHorizontal : BoxLayout::kVertical, 2, 2, 2));
+    CountingView* leaf = new CountingView(gfx::Size(10, 10));
+    level->AddChildView(leaf);
+    leaves.push_back(leaf);
+    View* child = new View;
+    level->AddChildView(child);
+    level = child;
+  }
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int frame = 0; frame < kFrames; ++frame) {
+    host_->SetBounds(0, 0, 200 + frame, 200 + frame);
+    host_->Layout();
+    host_->GetPreferredSize();
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  int count = 0;
+  for (const CountingView* leaf : leaves)
+    count += leaf->count();
+  perf_test::PrintResult("leaf_size_queries_per_frame", "", "deep_box_layout",
+                         static_cast<size_t>(count / kFrames), "count", true);
+  perf_test::PrintResult(
+      "time_per_frame", "", "deep_box_layout",
+      static_cast<size_t>(elapsed.InMicroseconds() / kFrames), "us", true);
+
+  // Nothing changed, so none of the levels walks its children again.
+  host_->GetPreferredSize();
+  int cached_count = 0;
+  for (const CountingView* leaf : leaves)
+    cached_count += leaf->count();
+  EXPECT_EQ(count, cached_count);
+}
+
 }  // namespace views
@@ -657,7 +657,10 @@ GridLayout::GridLayout(View* host)
       current_row_(-1),
       next_column_(0),
       current_row_col_set_(NULL),
-      adding_view_(false) {
+      adding_view_(false),
+      cached_preferred_size_valid_(false),
+      cached_height_for_width_width_(-1),
+      cached_height_for_width_(0) {
   DCHECK(host);
 }
 
@@ -677,16 +680,19 @@ GridLayout* GridLayout::CreatePanel(View* host) {
 
 void GridLayout::SetInsets(int top, int left, int bottom, int right) {
   insets_.Set(top, left, bottom, right);
+  InvalidateLayout();
 }
 
 void GridLayout::SetInsets(const gfx::Insets& insets) {
   insets_ = insets;
+  InvalidateLayout();
 }
 
 ColumnSet* GridLayout::AddColumnSet(int id) {
   DCHECK(GetColumnSet(id) == NULL);
   ColumnSet* column_set = new ColumnSet(id);
   column_sets_.push_back(column_set);
+  InvalidateLayout();
   return column_set;
 }
 
@@ -791,6 +797,11 @@ void GridLayout::ViewRemoved(View* host, View* view) {
   DCHECK(host_ == host);
 }
 
+void GridLayout::InvalidateLayout() {
+  cached_preferred_size_valid_ = false;
+  cached_height_for_width_width_ = -1;
+}
+
 void GridLayout::Layout(View* host) {
   DCHECK(host_ == host);
   // SizeRowsAndColumns sets the size and location of each row/column, but
@@ -826,17 +837,27 @@ void GridLayout::Layout(View* host) {
 
 gfx::Size GridLayout::GetPreferredSize(const View* host) const {
   DCHECK(host_ == host);
+  if (cached_preferred_size_valid_)
+    return cached_preferred_size_;
+
   gfx::Size out;
   SizeRowsAndColumns(false, 0, 0, &out);
   out.SetSize(std::max(out.width(), minimum_size_.width()),
               std::max(out.height(), minimum_size_.height()));
+  cached_preferred_size_ = out;
+  cached_preferred_size_valid_ = true;
   return out;
 }
 
 int GridLayout::GetPreferredHeightForWidth(const View* host, int width) const {
   DCHECK(host_ == host);
+  if (width == cached_height_for_width_width_)
+    return cached_height_for_width_;
+
   gfx::Size pref;
   SizeRowsAndColumns(false, width, 0, &pref);
+  cached_height_for_width_ = pref.height();
+  cached_height_for_width_width_ = width;
   return pref.height();
 }
 
@@ -974,6 +995,7 @@ void GridLayout::AddViewState(ViewState* view_state) {
                                                          CompareByRowSpan);
   view_states_.insert(i, view_state);
   SkipPaddingColumns();
+  InvalidateLayout();
 }
 
 void GridLayout::AddRow(Row* row) {
@@ -989,6 +1011,7 @@ void GridLayout::AddRow(Row* row) {
   rows_.push_back(row);
   current_row_col_set_ = row->column_set();
   SkipPaddingColumns();
+  InvalidateLayout();
 }
 
 void GridLayout::UpdateRemainingHeightFromRows(ViewState* view_state) const {
@@ -179,7 +179,12 @@ class VIEWS_EXPORT GridLayout : public LayoutManager {
 
   int GetPreferredHeightForWidth(const View* host, int width) const override;
 
-  void set_minimum_size(const gfx::Size& size) { minimum_size_ = size; }
+  void InvalidateLayout() override;
+
+  void set_minimum_size(const gfx::Size& size) {
+    minimum_size_ = size;
+    InvalidateLayout();
+  }
 
  private:
   // As both Layout and GetPreferredSize need to do nearly the same thing,
@@ -255,6 +260,15 @@ class VIEWS_EXPORT GridLayout : public LayoutManager {
   // Minimum preferred size.
   gfx::Size minimum_size_;
 
+  // The results of GetPreferredSize() and of the last
+  // GetPreferredHeightForWidth(), kept until InvalidateLayout(). Like the
+  // master columns, these assume the column sets are not changed once the
+  // host has been sized.
+  mutable bool cached_preferred_size_valid_;
+  mutable gfx::Size cached_preferred_size_;
+  mutable int cached_height_for_width_width_;
+  mutable int cached_height_for_width_;
+
   DISALLOW_COPY_AND_ASSIGN(GridLayout);
 };
 
@@ -664,4 +664,28 @@ TEST_F(GridLayoutTest, MinimumPreferredSize) {
   RemoveAll();
 }
 
+TEST_F(GridLayoutTest, InvalidatesCachedPreferredSize) {
+  SettableSizeView v1(gfx::Size(10, 20));
+  ColumnSet* set = layout.AddColumnSet(0);
+  set->AddColumn(GridLayout::FILL, GridLayout::FILL,
+                 0, GridLayout::USE_PREF, 0, 0);
+  layout.StartRow(0, 0);
+  layout.AddView(&v1);
+
+  GetPreferredSize();
+  EXPECT_EQ(gfx::Size(10, 20), pref);
+  EXPECT_EQ(20, layout.GetPreferredHeightForWidth(&host, 10));
+
+  layout.AddPaddingRow(0, 5);
+  GetPreferredSize();
+  EXPECT_EQ(gfx::Size(10, 25), pref);
+  EXPECT_EQ(25, layout.GetPreferredHeightForWidth(&host, 10));
+
+  layout.SetInsets(1, 1, 1, 1);
+  GetPreferredSize();
+  EXPECT_EQ(gfx::Size(12, 27), pref);
+
+  RemoveAll();
+}
+
 }  // namespace views
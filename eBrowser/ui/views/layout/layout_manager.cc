@@ -19,6 +19,9 @@ int LayoutManager::GetPreferredHeightForWidth(const View* host,
   return GetPreferredSize(host).height();
 }
 
+void LayoutManager::InvalidateLayout() {
+}
+
 void LayoutManager::ViewAdded(View* host, View* view) {
 }
 
@@ -52,6 +52,12 @@ class VIEWS_EXPORT LayoutManager {
   // The default implementation returns GetPreferredSize().height().
   virtual int GetPreferredHeightForWidth(const View* host, int width) const;
 
+  // Called when the preferred size of the host may have changed, that is when
+  // InvalidateLayout() was called on the host or one of its descendants, or
+  // when the host's children, their visibility or its insets changed.
+  // LayoutManagers that cache sizes between calls drop them here.
+  virtual void InvalidateLayout();
+
   // Called when a View is added as a child of the View the LayoutManager has
   // been installed on.
   virtual void ViewAdded(View* host, View* view);
@@ -218,6 +218,7 @@ void View::AddChildViewAt(View* view, int index) {
       view->SchedulePaint();
   }
 
+  InvalidateLayoutManagers();
   if (layout_manager_.get())
     layout_manager_->ViewAdded(this, view);
 }
@@ -414,6 +415,7 @@ void View::SetVisible(bool visible) {
 
     // Notify the parent.
     if (parent_) {
+      parent_->InvalidateLayoutManagers();
       parent_->ChildVisibilityChanged(this);
       parent_->NotifyAccessibilityEvent(ui::AX_EVENT_CHILDREN_CHANGED, false);
     }
@@ -551,6 +553,8 @@ void View::InvalidateLayout() {
   // Always invalidate up. This is needed to handle the case of us already being
   // valid, but not our parent.
   needs_layout_ = true;
+  if (layout_manager_)
+    layout_manager_->InvalidateLayout();
   if (parent_)
     parent_->InvalidateLayout();
 }
@@ -566,6 +570,7 @@ void View::SetLayoutManager(LayoutManager* layout_manager) {
   layout_manager_.reset(layout_manager);
   if (layout_manager_)
     layout_manager_->Installed(this);
+  InvalidateLayoutManagers();
 }
 
 void View::SnapLayerToPixelBoundary() {
@@ -858,6 +863,7 @@ void View::set_background(Background* b) {
 
 void View::SetBorder(std::unique_ptr<Border> b) {
   border_ = std::move(b);
+  InvalidateLayoutManagers();
 }
 
 const ui::ThemeProvider* View::GetThemeProvider() const {
@@ -1840,10 +1846,18 @@ void View::DoRemoveChildView(View* view,
   if (update_tool_tip)
     UpdateTooltip();
 
+  InvalidateLayoutManagers();
   if (layout_manager_)
     layout_manager_->ViewRemoved(this, view);
 }
 
+void View::InvalidateLayoutManagers() {
+  for (View* v = this; v; v = v->parent_) {
+    if (v->layout_manager_)
+      v->layout_manager_->InvalidateLayout();
+  }
+}
+
 void View::PropagateRemoveNotifications(View* old_parent, View* new_parent) {
   for (int i = 0, count = child_count(); i < count; ++i)
     child_at(i)->PropagateRemoveNotifications(old_parent, new_parent);
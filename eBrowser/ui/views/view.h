@@ -1260,6 +1260,11 @@ class VIEWS_EXPORT View : public ui::LayerDelegate,
   // to |new_parent| after the remove operation.
   void PropagateRemoveNotifications(View* old_parent, View* new_parent);
 
+  // Lets the layout managers of this view and its ancestors drop the sizes
+  // they cached, without marking the views as needing a layout. Called when
+  // the children, their visibility or the insets of this view change.
+  void InvalidateLayoutManagers();
+
   // Call ViewHierarchyChanged() for all children.
   void PropagateAddNotifications(const ViewHierarchyChangedDetails& details);
 
@@ -613,6 +613,37 @@ TEST_F(ViewTest, PaintWithMovedViewUsesCache) {
             list->VisualRectForTesting(item_index));
 }
 
+TEST_F(ViewTest, PaintCacheKeyedByDeviceScaleFactor) {
+  ScopedTestPaintWidget widget(CreateParams(Widget::InitParams::TYPE_POPUP));
+  View* root_view = widget->GetRootView();
+  TestView* v1 = new TestView;
+  v1->SetBounds(10, 11, 12, 13);
+  root_view->AddChildView(v1);
+
+  // Paint everything once at each scale, since each has to build its cache.
+  gfx::Rect pixel_rect = gfx::Rect(1, 1);
+  scoped_refptr<cc::DisplayItemList> list =
+      cc::DisplayItemList::Create(cc::DisplayItemListSettings());
+  root_view->Paint(ui::PaintContext(list.get(), 1.f, pixel_rect));
+  EXPECT_TRUE(v1->did_paint_);
+  v1->Reset();
+
+  // A recording made at one scale is not reused at another.
+  list = cc::DisplayItemList::Create(cc::DisplayItemListSettings());
+  root_view->Paint(ui::PaintContext(list.get(), 2.f, pixel_rect));
+  EXPECT_TRUE(v1->did_paint_);
+  v1->Reset();
+
+  // Both recordings are kept.
+  list = cc::DisplayItemList::Create(cc::DisplayItemListSettings());
+  root_view->Paint(ui::PaintContext(list.get(), 1.f, pixel_rect));
+  EXPECT_FALSE(v1->did_paint_);
+  v1->Reset();
+  list = cc::DisplayItemList::Create(cc::DisplayItemListSettings());
+  root_view->Paint(ui::PaintContext(list.get(), 2.f, pixel_rect));
+  EXPECT_FALSE(v1->did_paint_);
+}
+
 TEST_F(ViewTest, PaintWithMovedViewUsesCacheInRTL) {
   ScopedRTL rtl;
   ScopedTestPaintWidget widget(CreateParams(Widget::InitParams::TYPE_POPUP));
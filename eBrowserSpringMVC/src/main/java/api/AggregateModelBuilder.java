@@ -0,0 +1,217 @@
+package api;
+
+import java.io.BufferedWriter;
+import java.io.File;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import libsvm.svm;
+import libsvm.svm_model;
+import libsvm.svm_node;
+import libsvm.svm_parameter;
+import libsvm.svm_problem;
+
+/**
+ * Builds the shared model from the base dataset and the feedback of every
+ * device, so that a device starts from what all users asked for rather than
+ * from the static trains/train alone.
+ *
+ * Devices are read one at a time. Each device's samples are reduced to the
+ * mean fps per speed bin, so a device counts once per speed however much
+ * feedback it sent, and the raw samples are never all held at once. The devices are split into shards, each shard is trained in parallel
+ * together with the base dataset, and the shard models are averaged, weighted
+ * by their number of devices, into one RBF expansion. Since the shards share
+ * gamma, the average is itself a model; it is then compressed like any other
+ * shipped model.
+ *
+ * The result is published atomically as the shared model, and the per-bin
+ * means over all devices as AGGREGATE_DATASET, which SampleStore gives new
+ * devices as their base dataset.
+ */
+public class AggregateModelBuilder {
+	public static final String AGGREGATE_DATASET = "trains/aggregate";
+	// Speed bins per unit of speed.
+	private static final int BINS_PER_UNIT = 10;
+	// Devices per shard; the shard count is capped by the cores.
+	private static final int DEVICES_PER_SHARD = 64;
+	// Largest kernel cache of a shard; smaller shards get one sized to their
+	// kernel matrix.
+	private static final double MAX_CACHE_MB = 100;
+
+	// Sum and count of fps per speed bin.
+	private static class Bins {
+		final TreeMap<Long, double[]> bins = new TreeMap<Long, double[]>();
+
+		void add(double speed, double fps, double weight) {
+			long key = Math.round(speed * BINS_PER_UNIT);
+			double[] bin = bins.get(key);
+			if (bin == null) {
+				bin = new double[2];
+				bins.put(key, bin);
+			}
+			bin[0] += fps * weight;
+			bin[1] += weight;
+		}
+	}
+
+	// One shard's training data and its weight in the average.
+	private static class Shard {
+		final List<SampleStore.Sample> samples = new ArrayList<SampleStore.Sample>();
+		int devices;
+	}
+
+	public static void build(SampleStore store, String modelPath, int svBudget, double maxCompressionError)
+			throws IOException {
+		List<SampleStore.Sample> base = new ArrayList<SampleStore.Sample>();
+		SampleStore.readText(new File(SampleStore.BASE_DATASET), 0, base);
+		List<String> devices = store.devices();
+		int numShards = Math.max(1, Math.min(Runtime.getRuntime().availableProcessors(),
+				(devices.size() + DEVICES_PER_SHARD - 1) / DEVICES_PER_SHARD));
+		List<Shard> shards = new ArrayList<Shard>();
+		for (int k = 0; k < numShards; k++) {
+			Shard shard = new Shard();
+			shard.samples.addAll(base);
+			// The base dataset weighs as one device.
+			shard.devices = 1;
+			shards.add(shard);
+		}
+
+		Bins all = new Bins();
+		for (SampleStore.Sample sample : base)
+			all.add(sample.speed, sample.fps, 1);
+		int numDevices = 0;
+		for (String deviceId : devices) {
+			List<SampleStore.Sample> samples = new ArrayList<SampleStore.Sample>();
+			store.read(deviceId, 0, samples);
+			if (samples.isEmpty())
+				continue;
+			Bins bins = new Bins();
+			for (SampleStore.Sample sample : samples)
+				bins.add(sample.speed, sample.fps, 1);
+			Shard shard = shards.get(numDevices++ % numShards);
+			++shard.devices;
+			for (Map.Entry<Long, double[]> bin : bins.bins.entrySet()) {
+				double speed = (double) bin.getKey() / BINS_PER_UNIT;
+				double fps = bin.getValue()[0] / bin.getValue()[1];
+				shard.samples.add(new SampleStore.Sample(fps, speed));
+				all.add(speed, fps, 1);
+			}
+		}
+
+		svm_model model = trainShards(shards);
+		if (model == null)
+			return;
+		System.out.println("AggregateModelBuilder: " + numDevices + " devices, " + numShards + " shards, "
+				+ model.l + " support vectors");
+		model = ModelCompressor.forShipping(modelPath, model, svBudget, maxCompressionError);
+
+		File modelTmp = new File(modelPath + ".tmp");
+		svm.svm_save_model(modelTmp.getPath(), model);
+		Files.move(modelTmp.toPath(), new File(modelPath).toPath(), StandardCopyOption.REPLACE_EXISTING,
+				StandardCopyOption.ATOMIC_MOVE);
+		writeDataset(AGGREGATE_DATASET, all);
+	}
+
+	// Returns the weighted average of the shard models, or null if a shard
+	// could not be trained.
+	private static svm_model trainShards(List<Shard> shards) {
+		ExecutorService executor = Executors.newFixedThreadPool(shards.size());
+		List<Future<svm_model>> models = new ArrayList<Future<svm_model>>();
+		for (final Shard shard : shards) {
+			models.add(executor.submit(new Callable<svm_model>() {
+				public svm_model call() {
+					return trainShard(shard.samples);
+				}
+			}));
+		}
+
+		int devices = 0;
+		int l = 0;
+		List<svm_model> trained = new ArrayList<svm_model>();
+		try {
+			for (int k = 0; k < shards.size(); k++) {
+				svm_model model = models.get(k).get();
+				if (model == null)
+					return null;
+				trained.add(model);
+				devices += shards.get(k).devices;
+				l += model.l;
+			}
+		} catch (InterruptedException | ExecutionException e) {
+			e.printStackTrace();
+			return null;
+		} finally {
+			executor.shutdown();
+		}
+
+		svm_model average = new svm_model();
+		average.param = trained.get(0).param;
+		average.nr_class = 2;
+		average.l = l;
+		average.SV = new svm_node[l][];
+		average.sv_coef = new double[1][l];
+		average.rho = new double[1];
+		int i = 0;
+		for (int k = 0; k < trained.size(); k++) {
+			svm_model model = trained.get(k);
+			double weight = (double) shards.get(k).devices / devices;
+			for (int j = 0; j < model.l; j++, i++) {
+				average.SV[i] = model.SV[j];
+				average.sv_coef[0][i] = weight * model.sv_coef[0][j];
+			}
+			average.rho[0] += weight * model.rho[0];
+		}
+		return average;
+	}
+
+	private static svm_model trainShard(List<SampleStore.Sample> samples) {
+		svm_problem prob = new svm_problem();
+		prob.l = samples.size();
+		prob.x = new svm_node[prob.l][];
+		prob.y = new double[prob.l];
+		for (int i = 0; i < prob.l; i++) {
+			svm_node node = new svm_node();
+			node.index = 1;
+			node.value = samples.get(i).speed;
+			prob.x[i] = new svm_node[] { node };
+			prob.y[i] = samples.get(i).fps;
+		}
+		// Every shard keeps the default hyperparameters: averaging needs a
+		// common gamma.
+		svm_parameter param = svm_train.default_parameter();
+		param.cache_size = Math.min(MAX_CACHE_MB, Math.max(1, 4.0 * prob.l * prob.l / (1 << 20)));
+		String error = svm.svm_check_parameter(prob, param);
+		if (error != null || prob.l == 0) {
+			System.err.print("ERROR: " + (error != null ? error : "empty shard") + "\n");
+			return null;
+		}
+		return svm.svm_train(prob, param);
+	}
+
+	private static void writeDataset(String path, Bins bins) throws IOException {
+		File tmp = new File(path + ".tmp");
+		BufferedWriter writer = new BufferedWriter(new FileWriter(tmp));
+		try {
+			for (Map.Entry<Long, double[]> bin : bins.bins.entrySet()) {
+				double fps = bin.getValue()[0] / bin.getValue()[1];
+				writer.write(fps + " 1:" + ((double) bin.getKey() / BINS_PER_UNIT));
+				writer.newLine();
+			}
+		} finally {
+			writer.close();
+		}
+		Files.move(tmp.toPath(), new File(path).toPath(), StandardCopyOption.REPLACE_EXISTING,
+				StandardCopyOption.ATOMIC_MOVE);
+	}
+}
@@ -2,18 +2,48 @@ package api;
 
 import java.io.BufferedWriter;
 import java.io.File;
-import java.io.FileReader;
 import java.io.FileWriter;
 import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
 import java.util.Random;
 
+import org.springframework.beans.factory.annotation.Autowired;
+import org.springframework.beans.factory.annotation.Value;
 import org.springframework.scheduling.annotation.Async;
 import org.springframework.stereotype.Component;
 
+import libsvm.svm_model;
+
 @Component
 public class AsyscService {
 	public static Random random = new Random();
 
+	private static final int MAX_FRAME_RATE = 60;
+	// The frame rate asked for by one piece of implicit feedback, over the
+	// rate that drew it, like one press of the + button.
+	private static final int IMPLICIT_STEP = 1;
+
+	@Autowired
+	private SampleStore sampleStore;
+	@Autowired
+	private ModelCache modelCache;
+	@Autowired
+	private BlobStore blobStore;
+	@Autowired
+	private WorkQueue workQueue;
+	// Support vector budget of shipped models, and the largest change in a
+	// predicted fps that compressing to it may cause.
+	@Value("${model.sv-budget:16}")
+	private int svBudget;
+	@Value("${model.max-compression-error:2}")
+	private double maxCompressionError;
+	// Base URL of a svm_train_server, e.g. http://127.0.0.1:9420, to train
+	// per-device models on; empty to train them in this JVM.
+	@Value("${model.native-trainer-url:}")
+	private String nativeTrainerUrl;
+
 	@Async
 	public void doTaskOne() throws Exception {
 		System.out.println("开始做任务一");
@@ -33,76 +63,130 @@ public class AsyscService {
 	}
 
 	// 使用单个用户的文件训练模型
-	@Async
+	// Runs on the TrainingScheduler's workers, one call per model at a time.
+	// Models are trained into the working directory and then published to
+	// the BlobStore the API nodes serve from.
 	public void doTrain(Boolean isShared, String deviceId) throws Exception {
 		long start = System.currentTimeMillis();
 		if (isShared) {
-			String trainPath = "trains/train";
+			// The shared model is built from trains/train and the feedback
+			// of all devices.
 			String modelPath = "models/model";
 			try {
-				svm_train.main(new String[] { trainPath, modelPath });
+				AggregateModelBuilder.build(sampleStore, modelPath, svBudget, maxCompressionError);
+				publish(modelPath);
 			} catch (IOException e) {
 				e.printStackTrace();
 			}
+			modelCache.invalidate(modelPath);
 		} else {
-			String trainPath = "trains/" + deviceId;
+			// Per-device models only change by a few samples per training,
+			// so they are updated from their previous solution.
 			String modelPath = "models/" + deviceId;
 			try {
-				svm_train.main(new String[] { trainPath, modelPath });
+				IncrementalTrainer.train(sampleStore, deviceId, modelPath, svBudget, maxCompressionError,
+						nativeTrainerUrl);
+				publish(modelPath);
 			} catch (IOException e) {
 				e.printStackTrace();
 			}
+			modelCache.invalidate(modelPath);
 		}
 		long end = System.currentTimeMillis();
 		System.out.println("Trained Over. Use time: "+ (end-start));
 	}
 
+	private void publish(String modelPath) throws IOException {
+		File model = new File(modelPath);
+		// Trainings with nothing new to learn leave the model as it was.
+		if (model.exists())
+			blobStore.publish(modelPath, model);
+	}
+
 	// 接受用户反馈的速度和点击的次数，使用速度测出原先的fps
 	@Async
 	public void doReceive(String deviceId, String speed, String step) throws Exception {
+		SampleStore.Sample sample = explicitSample(speed, step);
+		if (sample == null)
+			return;
+		try {
+			workQueue.addSamples(deviceId, Collections.singletonList(sample));
+		} catch (IOException e) {
+			e.printStackTrace();
+		}
+		System.out.println(Math.ceil(sample.fps));
+	}
+
+	// The sample a press of the +/- buttons |step| times at |speed| makes, or
+	// null without a shared model to tell the fps the user saw.
+	private SampleStore.Sample explicitSample(String speed, String step) {
 		String modelPath = "models/model";
 		double predictResult = 0;
 		int feedbackFps = 0; // =predictResult+step
-		File trainDataFile = new File("trains/" + deviceId);
 		try {
-			predictResult = svm_predict.main(new String[] { modelPath, speed });
+			svm_model model = modelCache.get(modelPath);
+			if (model == null) {
+				System.err.print("can't open model file " + modelPath + "\n");
+				return null;
+			}
+			predictResult = svm_predict.predict(speed, model);
 		} catch (IOException e) {
 			e.printStackTrace();
 		}
 		feedbackFps = (int) (Math.ceil(predictResult) + Integer.parseInt(step));
-		FileWriter fw;
-		BufferedWriter bufw;
-		if (trainDataFile.exists()) {
-			try {
-				trainDataFile.createNewFile();
-				fw = new FileWriter(trainDataFile, true);
-				bufw = new BufferedWriter(fw);
-				bufw.write(feedbackFps + " 1:" + speed);
-				bufw.newLine();
-				bufw.close();
-				fw.close();
-			} catch (IOException e) {
-				e.printStackTrace();
-			}
-		} else {
+		return new SampleStore.Sample(feedbackFps, Double.parseDouble(speed));
+	}
+
+	// Stores a batch of feedback posted by a device's uploader, one sample per
+	// line: "save <speed> <step>", "pinch <speed> <fps>" or
+	// "implicit <type> <speed> <fps>". Runs on the request thread, so that
+	// training scheduled with the batch sees it.
+	// Returns the number of samples stored; malformed lines are skipped.
+	public int doReceiveBatch(String deviceId, String body) {
+		int stored = 0;
+		List<SampleStore.Sample> samples = new ArrayList<SampleStore.Sample>();
+		for (String line : body.split("\n")) {
+			String[] fields = line.trim().split("\\s+");
 			try {
-				trainDataFile.createNewFile();
-				fw = new FileWriter(trainDataFile);
-				FileReader fr = new FileReader("trains/train");
-				char[] buf = new char[1024];
-				int len = 0;
-				while ((len = fr.read(buf)) != -1) {
-					fw.write(buf, 0, len);
-					fw.flush();
+				if ("implicit".equals(fields[0]) && fields.length == 4) {
+					samples.add(implicitSample(deviceId, Integer.parseInt(fields[1]), Double.parseDouble(fields[2]),
+							Integer.parseInt(fields[3])));
+				} else if (fields.length != 3) {
+					continue;
+				} else if ("save".equals(fields[0])) {
+					Double.parseDouble(fields[1]);
+					Integer.parseInt(fields[2]);
+					SampleStore.Sample sample = explicitSample(fields[1], fields[2]);
+					if (sample != null)
+						samples.add(sample);
+				} else if ("pinch".equals(fields[0])) {
+					doPinch(deviceId, fields[1], fields[2]);
+				} else {
+					continue;
 				}
-				fw.write(feedbackFps + " 1:" + speed+"\n");
-				fw.close();
-				fr.close();
-			} catch (IOException e) {
-				e.printStackTrace();
+				stored++;
+			} catch (Exception e) {
+				System.err.println("bad feedback from " + deviceId + ": " + line);
 			}
 		}
-		System.out.println(Math.ceil(feedbackFps));
+		try {
+			workQueue.addSamples(deviceId, samples);
+		} catch (IOException e) {
+			e.printStackTrace();
+		}
+		return stored;
+	}
+
+	// Implicit feedback says a throttled scroll at |speed| was too choppy at
+	// |fps|: the renderer saw it abandoned, turned back, scrolled again right
+	// after its fling or its updates delayed for frames. It is stored as a
+	// press of the + button would be, at the rate the scroll actually ran at
+	// rather than the one the shared model predicts; |type| is only logged.
+	private SampleStore.Sample implicitSample(String deviceId, int type, double speed, int fps) {
+		if (fps <= 0 || fps >= MAX_FRAME_RATE)
+			throw new IllegalArgumentException("fps " + fps);
+		System.out.println("implicit feedback " + type + " from " + deviceId + ": " + speed + " at " + fps);
+		return new SampleStore.Sample(fps + IMPLICIT_STEP, speed);
 	}
 
 	public void doPinch(String deviceId, String speed, String fps) {
@@ -0,0 +1,84 @@
+package api;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import libsvm.svm;
+import libsvm.svm_model;
+import libsvm.svm_node;
+import libsvm.svm_parameter;
+
+/**
+ * Converts a libsvm text model into the binary format the browser maps and
+ * evaluates in place (ui/events/blink/dense_rbf_model.h). All fields are
+ * little-endian:
+ *
+ * <pre>
+ * uint32 magic "EBSV", uint16 version, uint16 num_features,
+ * uint32 num_support_vectors, uint32 padded_count, double gamma, double rho
+ * float coefficients[padded_count]
+ * float support_vectors[num_features][padded_count]
+ * </pre>
+ */
+public class BinaryModelWriter {
+	public static final int MAGIC = 0x56534245;
+	public static final short VERSION = 1;
+	// Must match DenseRbfModel::kMaxDenseFeatures and its vector width.
+	private static final int MAX_FEATURES = 16;
+	// The most features SvmPredictor::CreateFromSharedMemory accepts. Binary
+	// models with more are dropped by the renderer, so they are served as text.
+	// Matches MODEL_FEATURE_COUNT in ui/events/blink/svm_predictor.h.
+	private static final int MAX_BROWSER_FEATURES = 4;
+	private static final int VECTOR_WIDTH = 4;
+	private static final int HEADER_SIZE = 32;
+
+	// Returns the binary form of the model in |modelPath|, or null if the
+	// model is not an RBF regression model the browser can evaluate densely.
+	public static byte[] convert(String modelPath) throws IOException {
+		return convert(svm.svm_load_model(modelPath));
+	}
+
+	// As above, for a model already parsed.
+	public static byte[] convert(svm_model model) {
+		if (model.param.kernel_type != svm_parameter.RBF)
+			return null;
+		if (model.param.svm_type != svm_parameter.EPSILON_SVR && model.param.svm_type != svm_parameter.NU_SVR)
+			return null;
+
+		int count = model.l;
+		int numFeatures = 0;
+		for (int i = 0; i < count; i++) {
+			for (svm_node node : model.SV[i]) {
+				if (node.index < 1 || node.index > MAX_FEATURES)
+					return null;
+				numFeatures = Math.max(numFeatures, node.index);
+			}
+		}
+		if (count < 1 || numFeatures == 0 || numFeatures > MAX_BROWSER_FEATURES)
+			return null;
+
+		int paddedCount = (count + VECTOR_WIDTH - 1) / VECTOR_WIDTH * VECTOR_WIDTH;
+		ByteBuffer out = ByteBuffer.allocate(HEADER_SIZE + (numFeatures + 1) * paddedCount * 4);
+		out.order(ByteOrder.LITTLE_ENDIAN);
+		out.putInt(MAGIC);
+		out.putShort(VERSION);
+		out.putShort((short) numFeatures);
+		out.putInt(count);
+		out.putInt(paddedCount);
+		out.putDouble(model.param.gamma);
+		out.putDouble(model.rho[0]);
+
+		// Padding entries keep their zero coefficients and values.
+		int coefficients = HEADER_SIZE;
+		int supportVectors = coefficients + paddedCount * 4;
+		for (int i = 0; i < count; i++) {
+			out.putFloat(coefficients + i * 4, (float) model.sv_coef[0][i]);
+			for (svm_node node : model.SV[i]) {
+				int offset = supportVectors + ((node.index - 1) * paddedCount + i) * 4;
+				out.putFloat(offset, (float) node.value);
+			}
+		}
+		return out.array();
+	}
+}
@@ -0,0 +1,43 @@
+package api;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.util.List;
+
+/**
+ * The state that all nodes of the service share: the models they serve and
+ * the work queued for the training worker; see WorkQueue. Keys are relative
+ * "/"-separated paths such as "models/model", so the local backend keeps the
+ * layout the service has always had on disk. StorageConfig picks the backend.
+ *
+ * Implementations must be safe to call from any thread and replace a key's
+ * value atomically, so a reader sees either the old or the new bytes.
+ */
+public interface BlobStore {
+	// Returns the value of |key|, or null if there is none.
+	byte[] get(String key) throws IOException;
+
+	// Returns a token that changes whenever the value of |key| does, or null
+	// if there is none. Cheaper than get(), for callers that cache.
+	String version(String key) throws IOException;
+
+	void put(String key, byte[] value) throws IOException;
+
+	// Stores the contents of |file| as |key|, for output a trainer wrote.
+	default void publish(String key, File file) throws IOException {
+		put(key, Files.readAllBytes(file.toPath()));
+	}
+
+	// Returns the file that holds |key|, for callers that can send it without
+	// reading it, or null if the backend keeps no such file.
+	default File localFile(String key) {
+		return null;
+	}
+
+	// Returns false if there was no |key|.
+	boolean delete(String key) throws IOException;
+
+	// Keys directly under |prefix|, which ends in "/", oldest first.
+	List<String> list(String prefix) throws IOException;
+}
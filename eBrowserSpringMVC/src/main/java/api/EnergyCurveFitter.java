@@ -0,0 +1,60 @@
+package api;
+
+import java.util.Locale;
+import java.util.Map;
+import java.util.TreeMap;
+
+/**
+ * Fits a device's energy cost per frame from lab calibration runs, in which
+ * the browser paces a scroll at fixed frame rates (gpuBenchmarking's
+ * energyCalibration) while a power monitor measures it. Each run is a line
+ *
+ *   <target fps> <frames> <joules>
+ *
+ * with the frames the run presented and the energy measured over its
+ * start_us..end_us window. The runs of each rate are pooled, so the cost is
+ * their total energy over their total frames, and the curve is written in
+ * the text format of ui::EnergyCurve::CreateFromString().
+ */
+public class EnergyCurveFitter {
+	// Must match ScrollUpdatePacer::kMaxFrameRate.
+	private static final int MAX_FRAME_RATE = 60;
+
+	// Returns the curve, or null if no line is a usable run.
+	public static String fit(String runs, String version) {
+		// fps -> {frames, joules}
+		TreeMap<Integer, double[]> totals = new TreeMap<Integer, double[]>();
+		for (String line : runs.split("\n")) {
+			String[] fields = line.trim().split("\\s+");
+			if (fields.length != 3)
+				continue;
+			try {
+				int fps = Integer.parseInt(fields[0]);
+				int frames = Integer.parseInt(fields[1]);
+				double joules = Double.parseDouble(fields[2]);
+				if (fps <= 0 || fps > MAX_FRAME_RATE || frames <= 0 || !(joules > 0))
+					continue;
+				double[] total = totals.get(fps);
+				if (total == null) {
+					total = new double[2];
+					totals.put(fps, total);
+				}
+				total[0] += frames;
+				total[1] += joules;
+			} catch (NumberFormatException e) {
+				continue;
+			}
+		}
+		if (totals.isEmpty())
+			return null;
+
+		StringBuilder frameRates = new StringBuilder("frame_rates");
+		StringBuilder costs = new StringBuilder("millijoules_per_frame");
+		for (Map.Entry<Integer, double[]> entry : totals.entrySet()) {
+			double[] total = entry.getValue();
+			frameRates.append(' ').append(entry.getKey());
+			costs.append(' ').append(String.format(Locale.US, "%.4f", 1000 * total[1] / total[0]));
+		}
+		return "energy_curve\nversion " + version + "\n" + frameRates + "\n" + costs + "\n";
+	}
+}
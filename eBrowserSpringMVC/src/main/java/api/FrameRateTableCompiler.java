@@ -0,0 +1,80 @@
+package api;
+
+import libsvm.svm;
+import libsvm.svm_model;
+import libsvm.svm_node;
+import libsvm.svm_parameter;
+
+/**
+ * Compiles a single-feature model into the speed -> frame rate table served
+ * by /model/table, so that the browser only does a lookup per scroll update
+ * and never parses or evaluates the model. Mirrors ui::FrameRateTable::Create()
+ * in the browser: bucket i holds the clamped frame rate at speed i * step, up
+ * to the speed where the kernel sum has decayed to its constant tail, and
+ * the reported error is the largest difference from the exact model seen
+ * while probing each bucket.
+ */
+public class FrameRateTableCompiler {
+	// Must match ui::ClampPredictedFrameRate().
+	private static final int MIN_PLAUSIBLE_FRAME_RATE = 10;
+	private static final int FALLBACK_FRAME_RATE = 24;
+	private static final int MAX_FRAME_RATE = 60;
+	// Must match frame_rate_table.cc.
+	private static final double KERNEL_TAIL_EXPONENT = 16;
+	private static final int MAX_TABLE_SIZE = 1 << 16;
+	private static final int PROBES_PER_BUCKET = 4;
+
+	// Returns the table of |model| in the text format of
+	// ui::FrameRateTable::CreateFromString(), or null if |step| is not
+	// positive, the table would be too large, or the model reads more than the
+	// speed feature.
+	public static String compile(svm_model model, double step, String version) {
+		if (!(step > 0))
+			return null;
+		double maxSpeed = 0;
+		for (int i = 0; i < model.l; i++) {
+			for (svm_node node : model.SV[i]) {
+				if (node.index != 1)
+					return null;
+				maxSpeed = Math.max(maxSpeed, node.value);
+			}
+		}
+		if (model.param.kernel_type == svm_parameter.RBF && model.param.gamma > 0)
+			maxSpeed += Math.sqrt(KERNEL_TAIL_EXPONENT / model.param.gamma);
+		double buckets = Math.ceil(maxSpeed / step) + 1;
+		if (buckets > MAX_TABLE_SIZE)
+			return null;
+
+		StringBuilder frameRates = new StringBuilder("frame_rates");
+		int maxError = 0;
+		for (int i = 0; i < (int) buckets; i++) {
+			int fps = clamp(predict(model, i * step));
+			frameRates.append(' ').append(fps);
+			// Probe from the lower to the upper edge of the bucket, staying
+			// just inside the upper edge, which rounds to bucket i + 1.
+			for (int probe = 0; probe <= PROBES_PER_BUCKET; probe++) {
+				double offset = Math.min((double) probe / PROBES_PER_BUCKET - 0.5, 0.499);
+				double speed = (i + offset) * step;
+				if (speed < 0)
+					continue;
+				maxError = Math.max(maxError, Math.abs(clamp(predict(model, speed)) - fps));
+			}
+		}
+		return "frame_rate_table\nversion " + version + "\nstep " + step + "\nmax_error " + maxError + "\n"
+				+ frameRates + "\n";
+	}
+
+	private static double predict(svm_model model, double speed) {
+		svm_node node = new svm_node();
+		node.index = 1;
+		node.value = speed;
+		return svm.svm_predict(model, new svm_node[] { node });
+	}
+
+	private static int clamp(double prediction) {
+		int fps = (int) Math.ceil(prediction);
+		if (fps < MIN_PLAUSIBLE_FRAME_RATE)
+			return FALLBACK_FRAME_RATE;
+		return Math.min(fps, MAX_FRAME_RATE);
+	}
+}
@@ -1,23 +1,49 @@
 package api;
 
-import java.io.BufferedInputStream;
 import java.io.File;
-import java.io.FileInputStream;
 import java.io.IOException;
 import java.io.OutputStream;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.channels.WritableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.StandardOpenOption;
+import java.util.zip.CRC32;
 
+import javax.servlet.http.HttpServletRequest;
 import javax.servlet.http.HttpServletResponse;
 
 import org.springframework.beans.factory.annotation.Autowired;
 import org.springframework.ui.Model;
+import org.springframework.web.bind.annotation.RequestBody;
+import org.springframework.web.bind.annotation.RequestHeader;
 import org.springframework.web.bind.annotation.RequestMapping;
+import org.springframework.web.bind.annotation.RequestMethod;
 import org.springframework.web.bind.annotation.RequestParam;
 import org.springframework.web.bind.annotation.RestController;
 
+import libsvm.svm_model;
+
 @RestController
 public class GreetingController {
+	// Request attributes of Tomcat's sendfile support.
+	private static final String SENDFILE_SUPPORT = "org.apache.tomcat.sendfile.support";
+	private static final String SENDFILE_FILENAME = "org.apache.tomcat.sendfile.filename";
+	private static final String SENDFILE_START = "org.apache.tomcat.sendfile.start";
+	private static final String SENDFILE_END = "org.apache.tomcat.sendfile.end";
+
 	@Autowired
 	private AsyscService task;
+	@Autowired
+	private TrainingScheduler trainingScheduler;
+	@Autowired
+	private ModelCache modelCache;
+	@Autowired
+	private BlobStore blobStore;
+	@Autowired
+	private WorkQueue workQueue;
+	@Autowired
+	private ModelDownloads modelDownloads;
 //	@RequestMapping("/async")
 //	public Message async(String name, Model model) {
 //
@@ -32,47 +58,130 @@ public class GreetingController {
 
 	@RequestMapping("/download")
 	public void download(@RequestParam(value = "fileName", required = false, defaultValue = "model") String fileName,
-			HttpServletResponse res) {
-		System.out.println("GreetingController:download, fileName: " + fileName);
-		
+			@RequestParam(value = "format", required = false, defaultValue = "text") String format,
+			@RequestHeader(value = "If-None-Match", required = false) String ifNoneMatch,
+			@RequestHeader(value = "Accept-Encoding", required = false) String acceptEncoding,
+			HttpServletRequest req, HttpServletResponse res) {
+		System.out.println("GreetingController:download, fileName: " + fileName + ", format: " + format);
+
 		String modelPath = "models/" + fileName;
-		String attachment = fileName;
-		res.setHeader("content-type", "application/octet-stream");
-		res.setContentType("application/octet-stream");
-		res.setHeader("Content-Disposition", "attachment;filename=" + attachment);
-		byte[] buffer = new byte[1024];
-		BufferedInputStream bis = null;
-		FileInputStream fis = null;
-		OutputStream os = null;
 		try {
-			os = res.getOutputStream();
-			File file = new File(modelPath);
-			fis = new FileInputStream(file);
-			bis = new BufferedInputStream(fis);
-			int len = 0;
-			while ((len = bis.read(buffer)) != -1) {
-				os.write(buffer, 0, len);
+			ModelDownloads.Download download = modelDownloads.get(modelPath, format);
+			if (download == null) {
+				res.setStatus(HttpServletResponse.SC_NOT_FOUND);
+				return;
 			}
-		} catch (IOException e1) {
-			e1.printStackTrace();
+			res.setHeader("ETag", download.etag);
+			res.setHeader("Cache-Control", "no-cache");
+			if (ifNoneMatch != null && ifNoneMatch.contains(download.etag)) {
+				res.setStatus(HttpServletResponse.SC_NOT_MODIFIED);
+				return;
+			}
+
+			res.setContentType("application/octet-stream");
+			res.setHeader("Content-Disposition", "attachment;filename=" + fileName);
+			if (download.body() == null) {
+				sendFile(download.file(), req, res);
+				return;
+			}
+			byte[] body = download.body();
+			if (download.gzipped() != null) {
+				res.setHeader("Vary", "Accept-Encoding");
+				if (acceptEncoding != null && acceptEncoding.contains("gzip")) {
+					body = download.gzipped();
+					res.setHeader("Content-Encoding", "gzip");
+				}
+			}
+			// With the length set the connection is kept alive for the
+			// device's next request.
+			res.setContentLength(body.length);
+			OutputStream out = res.getOutputStream();
+			out.write(body);
+			out.close();
+		} catch (IOException e) {
+			e.printStackTrace();
+		}
+	}
+
+	// Sends |file| with sendfile when the connector supports it, which copies
+	// it to the socket in the kernel once the handler returns, and otherwise
+	// with FileChannel.transferTo. The length is taken now, so a model that
+	// was retrained since its ETag was computed is still sent whole; the next
+	// request then gets the new ETag.
+	private static void sendFile(File file, HttpServletRequest req, HttpServletResponse res) throws IOException {
+		long length = file.length();
+		res.setContentLengthLong(length);
+		if (Boolean.TRUE.equals(req.getAttribute(SENDFILE_SUPPORT))) {
+			req.setAttribute(SENDFILE_FILENAME, file.getCanonicalPath());
+			req.setAttribute(SENDFILE_START, Long.valueOf(0));
+			req.setAttribute(SENDFILE_END, Long.valueOf(length));
+			return;
+		}
+		FileChannel channel = FileChannel.open(file.toPath(), StandardOpenOption.READ);
+		try {
+			WritableByteChannel out = Channels.newChannel(res.getOutputStream());
+			long position = 0;
+			while (position < length) {
+				long sent = channel.transferTo(position, length - position, out);
+				if (sent <= 0)
+					break;
+				position += sent;
+			}
+			out.close();
 		} finally {
-			try {
-				fis.close();
-			} catch (IOException e) {
-				e.printStackTrace();
+			channel.close();
+		}
+	}
+
+	// The model in |fileName| compiled into a speed -> frame rate table, for
+	// browsers that only look predictions up. The table's version is derived
+	// from the model and the step, like the ETag of /download.
+	@RequestMapping("/model/table")
+	public void modelTable(
+			@RequestParam(value = "fileName", required = false, defaultValue = "model") String fileName,
+			@RequestParam(value = "step", required = false, defaultValue = "0.05") double step,
+			@RequestHeader(value = "If-None-Match", required = false) String ifNoneMatch,
+			HttpServletResponse res) {
+		System.out.println("GreetingController:modelTable, fileName: " + fileName + ", step: " + step);
+
+		String modelPath = "models/" + fileName;
+		try {
+			byte[] modelBytes = blobStore.get(modelPath);
+			if (modelBytes == null) {
+				res.setStatus(HttpServletResponse.SC_NOT_FOUND);
+				return;
 			}
-			try {
-				bis.close();
-			} catch (IOException e) {
-				e.printStackTrace();
+			CRC32 crc = new CRC32();
+			crc.update(modelBytes);
+			String version = Long.toHexString(crc.getValue()) + "-" + step;
+			String etag = "\"table-" + version + "\"";
+			res.setHeader("ETag", etag);
+			res.setHeader("Cache-Control", "no-cache");
+			if (ifNoneMatch != null && ifNoneMatch.contains(etag)) {
+				res.setStatus(HttpServletResponse.SC_NOT_MODIFIED);
+				return;
 			}
-			try {
-				os.close();
-			} catch (IOException e) {
-				e.printStackTrace();
+
+			String table = null;
+			svm_model model = modelCache.get(modelPath);
+			if (model != null)
+				table = FrameRateTableCompiler.compile(model, step, version);
+			// Models with more features than the speed cannot be tabulated
+			// and are only served by /download.
+			if (table == null) {
+				res.setStatus(HttpServletResponse.SC_NOT_ACCEPTABLE);
+				return;
 			}
+			byte[] body = table.getBytes(StandardCharsets.US_ASCII);
+			res.setContentType("text/plain");
+			res.setHeader("Content-Disposition", "attachment;filename=" + fileName);
+			res.setContentLength(body.length);
+			OutputStream out = res.getOutputStream();
+			out.write(body);
+			out.close();
+		} catch (IOException e) {
+			e.printStackTrace();
 		}
-		// return "greeting";
 	}
 
 	@RequestMapping("/train")
@@ -80,17 +189,19 @@ public class GreetingController {
 		System.out.println("GreetingController:train, deviceId: " + deviceId);
 		
 		try {
-			if (deviceId.trim().isEmpty()) {
-				task.doTrain(true, deviceId);
-			} else {
-				task.doTrain(false, deviceId);
-			}
-		} catch (Exception e) {
+			workQueue.requestTraining(deviceId);
+		} catch (IOException e) {
 			e.printStackTrace();
+			return new Message("500", "not queued");
 		}
 		return new Message("200", "success");
 	}
 
+	@RequestMapping("/trainStats")
+	public TrainingScheduler.Stats trainStats() {
+		return trainingScheduler.getStats();
+	}
+
 	@RequestMapping("/save")
 	public Message save(@RequestParam(value = "deviceId", required = true) String deviceId, String speed, String step,
 			Model model) {// 参数speed由客户端除以50
@@ -103,6 +214,50 @@ public class GreetingController {
 		return new Message("200", "success");
 	}
 	
+	// Batched feedback from the browser's uploader; see
+	// AsyscService.doReceiveBatch for the body. |train| schedules training
+	// once the batch is stored, in place of a separate /train request.
+	@RequestMapping(value = "/feedback", method = RequestMethod.POST)
+	public Message feedback(@RequestParam(value = "deviceId", required = true) String deviceId,
+			@RequestParam(value = "train", required = false, defaultValue = "false") boolean train,
+			@RequestBody(required = false) String body) {
+		int stored = body == null ? 0 : task.doReceiveBatch(deviceId, body);
+		System.out.println("GreetingController:feedback, deviceId: " + deviceId + ", samples: " + stored
+				+ ", train: " + train);
+		if (train) {
+			try {
+				workQueue.requestTraining(deviceId);
+			} catch (IOException e) {
+				e.printStackTrace();
+				return new Message("500", "not queued");
+			}
+		}
+		return new Message("200", "success");
+	}
+
+	// Lab calibration runs of the device, one "<fps> <frames> <joules>" line
+	// each; see EnergyCurveFitter. The fitted curve is kept beside the
+	// device's model, and /download serves it as "<deviceId>.energy".
+	@RequestMapping(value = "/energy/calibration", method = RequestMethod.POST)
+	public Message energyCalibration(@RequestParam(value = "deviceId", required = true) String deviceId,
+			@RequestBody(required = false) String body) {
+		System.out.println("GreetingController:energyCalibration, deviceId: " + deviceId);
+		if (body == null)
+			return new Message("400", "no runs");
+		CRC32 crc = new CRC32();
+		crc.update(body.getBytes(StandardCharsets.US_ASCII));
+		String curve = EnergyCurveFitter.fit(body, Long.toHexString(crc.getValue()));
+		if (curve == null)
+			return new Message("400", "no usable runs");
+		try {
+			blobStore.put("models/" + deviceId + ".energy", curve.getBytes(StandardCharsets.US_ASCII));
+		} catch (IOException e) {
+			e.printStackTrace();
+			return new Message("500", "not stored");
+		}
+		return new Message("200", "success");
+	}
+
 	@RequestMapping("/pinch")
 	public Message pinch(@RequestParam(value = "deviceId", required = true) String deviceId, String speed, String fps,
 			Model model) {// 参数speed由客户端除以50
@@ -0,0 +1,163 @@
+package api;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.Future;
+
+import libsvm.svm;
+import libsvm.svm_model;
+import libsvm.svm_node;
+import libsvm.svm_parameter;
+import libsvm.svm_print_interface;
+import libsvm.svm_problem;
+
+/**
+ * Picks C, gamma and epsilon for a model by grid search with k-fold cross
+ * validation, every (configuration, fold) pair trained as its own task on a
+ * fork/join pool. Among the configurations whose validation error is within
+ * ACCURACY_TOLERANCE of the best, the one with the fewest support vectors
+ * wins: every support vector is a kernel evaluation per prediction on the
+ * device.
+ */
+public class HyperparameterSearch {
+	private static final double[] C_VALUES = { 1, 10, 100, 1000 };
+	private static final double[] GAMMA_VALUES = { 0.01, 0.03, 0.1, 0.3, 1 };
+	private static final double[] P_VALUES = { 0.1, 0.5, 1, 2 };
+	private static final int FOLDS = 5;
+	// Relative and absolute (fps^2) slack in mean squared error under which
+	// two configurations count as equally accurate.
+	private static final double ACCURACY_TOLERANCE = 1.05;
+	private static final double ACCURACY_SLACK = 0.25;
+	// Fixed so that a device's search is reproducible.
+	private static final long FOLD_SEED = 0;
+
+	private static final ForkJoinPool pool = new ForkJoinPool();
+	private static final svm_print_interface svm_print_null = new svm_print_interface() {
+		public void print(String s) {
+		}
+	};
+
+	// Squared error and support vector count of one fold.
+	private static class FoldResult {
+		final double squaredError;
+		final int supportVectors;
+
+		FoldResult(double squaredError, int supportVectors) {
+			this.squaredError = squaredError;
+			this.supportVectors = supportVectors;
+		}
+	}
+
+	// Returns a copy of |base| with the chosen C, gamma and p, or |base| itself
+	// if |prob| is too small to be split into folds.
+	public static svm_parameter search(svm_problem prob, svm_parameter base) {
+		if (prob.l < 2 * FOLDS)
+			return base;
+		svm.svm_set_print_string_function(svm_print_null);
+		int[] fold = assignFolds(prob.l);
+		// Many folds train at once; each only needs its own kernel matrix.
+		double cacheSize = Math.min(base.cache_size, Math.max(1, 4.0 * prob.l * prob.l / (1 << 20)));
+
+		List<svm_parameter> configs = new ArrayList<svm_parameter>();
+		List<Future<FoldResult>> results = new ArrayList<Future<FoldResult>>();
+		for (double c : C_VALUES) {
+			for (double gamma : GAMMA_VALUES) {
+				for (double p : P_VALUES) {
+					final svm_parameter param = (svm_parameter) base.clone();
+					param.C = c;
+					param.gamma = gamma;
+					param.p = p;
+					param.cache_size = cacheSize;
+					configs.add(param);
+					for (int k = 0; k < FOLDS; k++)
+						results.add(pool.submit(foldTask(prob, param, fold, k)));
+				}
+			}
+		}
+
+		double[] mse = new double[configs.size()];
+		double[] supportVectors = new double[configs.size()];
+		double best = Double.MAX_VALUE;
+		try {
+			for (int i = 0; i < configs.size(); i++) {
+				for (int k = 0; k < FOLDS; k++) {
+					FoldResult result = results.get(i * FOLDS + k).get();
+					mse[i] += result.squaredError / prob.l;
+					supportVectors[i] += (double) result.supportVectors / FOLDS;
+				}
+				best = Math.min(best, mse[i]);
+			}
+		} catch (InterruptedException | ExecutionException e) {
+			e.printStackTrace();
+			return base;
+		}
+
+		int chosen = -1;
+		for (int i = 0; i < configs.size(); i++) {
+			if (mse[i] > best * ACCURACY_TOLERANCE + ACCURACY_SLACK)
+				continue;
+			if (chosen < 0 || supportVectors[i] < supportVectors[chosen]
+					|| (supportVectors[i] == supportVectors[chosen] && mse[i] < mse[chosen]))
+				chosen = i;
+		}
+		svm_parameter param = configs.get(chosen);
+		System.out.println("HyperparameterSearch: C " + param.C + ", gamma " + param.gamma + ", p " + param.p
+				+ ", mse " + mse[chosen] + " (best " + best + "), support vectors " + supportVectors[chosen]);
+		return param;
+	}
+
+	private static int[] assignFolds(int l) {
+		int[] order = new int[l];
+		for (int i = 0; i < l; i++)
+			order[i] = i;
+		Random random = new Random(FOLD_SEED);
+		for (int i = l - 1; i > 0; i--) {
+			int j = random.nextInt(i + 1);
+			int tmp = order[i];
+			order[i] = order[j];
+			order[j] = tmp;
+		}
+		int[] fold = new int[l];
+		for (int i = 0; i < l; i++)
+			fold[order[i]] = i % FOLDS;
+		return fold;
+	}
+
+	// Trains on every fold but |k| and measures the error on fold |k|.
+	private static Callable<FoldResult> foldTask(final svm_problem prob, final svm_parameter param,
+			final int[] fold, final int k) {
+		return new Callable<FoldResult>() {
+			public FoldResult call() {
+				svm_problem train = new svm_problem();
+				for (int i = 0; i < prob.l; i++) {
+					if (fold[i] != k)
+						++train.l;
+				}
+				train.x = new svm_node[train.l][];
+				train.y = new double[train.l];
+				int j = 0;
+				for (int i = 0; i < prob.l; i++) {
+					if (fold[i] == k)
+						continue;
+					train.x[j] = prob.x[i];
+					train.y[j] = prob.y[i];
+					++j;
+				}
+
+				svm_model model = svm.svm_train(train, param);
+				double squaredError = 0;
+				for (int i = 0; i < prob.l; i++) {
+					if (fold[i] != k)
+						continue;
+					double error = svm.svm_predict(model, prob.x[i]) - prob.y[i];
+					squaredError += error * error;
+				}
+				return new FoldResult(squaredError, model.l);
+			}
+		};
+	}
+}
@@ -0,0 +1,194 @@
+package api;
+
+import java.io.BufferedReader;
+import java.io.BufferedWriter;
+import java.io.File;
+import java.io.FileReader;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.StringTokenizer;
+
+import libsvm.WarmStartSvr;
+import libsvm.svm;
+import libsvm.svm_model;
+import libsvm.svm_node;
+import libsvm.svm_parameter;
+import libsvm.svm_problem;
+
+/**
+ * Retrains a device's model from its previous support vectors plus the
+ * samples appended to its SampleStore log since the last training, with SMO
+ * warm started from the previous solution. Samples that were not support
+ * vectors are not revisited, so the cost of an update depends on the model
+ * size and the number of new samples rather than on the user's history.
+ *
+ * The state between trainings is kept next to the model, in
+ * <modelPath>.state: a line "offset <samples of the log consumed>", a line
+ * "param <C> <gamma> <epsilon>", then one "<coef> <label> 1:<speed>" line per
+ * support vector. Without a usable state the base dataset and the whole log
+ * are trained on, from zero, with hyperparameters picked by
+ * HyperparameterSearch. Warm starts keep those hyperparameters, since the
+ * previous solution is only a valid starting point for the same C.
+ *
+ * With a native trainer URL the solve runs on NativeTrainerClient, falling
+ * back to WarmStartSvr in this JVM when the trainer cannot take the job.
+ */
+public class IncrementalTrainer {
+	private static final String STATE_SUFFIX = ".state";
+	// Largest kernel cache, matching the full trainer; smaller problems get
+	// a cache sized to their kernel matrix.
+	private static final double MAX_CACHE_MB = 100;
+
+	private final List<svm_node[]> x = new ArrayList<svm_node[]>();
+	private final List<Double> y = new ArrayList<Double>();
+	private final List<Double> coef = new ArrayList<Double>();
+	private long offset;
+	// Null until read from the state.
+	private svm_parameter param;
+
+	// The shipped model is compressed to |svBudget| support vectors when that
+	// moves no prediction by more than |maxCompressionError| fps; the state
+	// keeps the full solution.
+	public static void train(SampleStore store, String deviceId, String modelPath, int svBudget,
+			double maxCompressionError, String nativeTrainerUrl) throws IOException {
+		IncrementalTrainer trainer = new IncrementalTrainer();
+		boolean warm = trainer.readState(modelPath + STATE_SUFFIX, store.count(deviceId));
+		if (!warm)
+			trainer = new IncrementalTrainer();
+		if (!trainer.add(store, deviceId, !warm))
+			return;
+		trainer.run(modelPath, svBudget, maxCompressionError, nativeTrainerUrl);
+	}
+
+	// Returns false if the state is missing or does not match the log, which
+	// was then replaced.
+	private boolean readState(String statePath, long numSamples) throws IOException {
+		File stateFile = new File(statePath);
+		if (!stateFile.exists())
+			return false;
+		BufferedReader reader = new BufferedReader(new FileReader(stateFile));
+		try {
+			String header = reader.readLine();
+			if (header == null || !header.startsWith("offset "))
+				return false;
+			offset = Long.parseLong(header.substring("offset ".length()).trim());
+			if (offset > numSamples)
+				return false;
+			String paramLine = reader.readLine();
+			if (paramLine == null || !paramLine.startsWith("param "))
+				return false;
+			StringTokenizer params = new StringTokenizer(paramLine.substring("param ".length()));
+			param = svm_train.default_parameter();
+			param.C = Double.parseDouble(params.nextToken());
+			param.gamma = Double.parseDouble(params.nextToken());
+			param.p = Double.parseDouble(params.nextToken());
+			String line;
+			while ((line = reader.readLine()) != null) {
+				StringTokenizer st = new StringTokenizer(line, " \t:");
+				if (!st.hasMoreTokens())
+					continue;
+				coef.add(Double.parseDouble(st.nextToken()));
+				y.add(Double.parseDouble(st.nextToken()));
+				x.add(parseNodes(st));
+			}
+			return true;
+		} catch (RuntimeException e) {
+			// A malformed state only costs a full training.
+			return false;
+		} finally {
+			reader.close();
+		}
+	}
+
+	// Adds the samples logged past |offset|, preceded by the base dataset if
+	// |withBase|. Returns false if there is nothing new to train on.
+	private boolean add(SampleStore store, String deviceId, boolean withBase) throws IOException {
+		List<SampleStore.Sample> samples = new ArrayList<SampleStore.Sample>();
+		if (withBase)
+			store.readBase(deviceId, samples);
+		int numBase = samples.size();
+		store.read(deviceId, offset, samples);
+		offset += samples.size() - numBase;
+		for (SampleStore.Sample sample : samples) {
+			svm_node node = new svm_node();
+			node.index = 1;
+			node.value = sample.speed;
+			x.add(new svm_node[] { node });
+			y.add(sample.fps);
+			coef.add(0.0);
+		}
+		return !samples.isEmpty();
+	}
+
+	private void run(String modelPath, int svBudget, double maxCompressionError, String nativeTrainerUrl)
+			throws IOException {
+		svm_problem prob = new svm_problem();
+		prob.l = y.size();
+		prob.x = x.toArray(new svm_node[prob.l][]);
+		prob.y = new double[prob.l];
+		double[] alpha = new double[prob.l];
+		for (int i = 0; i < prob.l; i++) {
+			prob.y[i] = y.get(i);
+			alpha[i] = coef.get(i);
+		}
+
+		if (param == null)
+			param = HyperparameterSearch.search(prob, svm_train.default_parameter());
+		// Q columns are floats.
+		param.cache_size = Math.min(MAX_CACHE_MB, Math.max(1, 4.0 * prob.l * prob.l / (1 << 20)));
+		String error = svm.svm_check_parameter(prob, param);
+		if (error != null) {
+			System.err.print("ERROR: " + error + "\n");
+			return;
+		}
+
+		svm_model model = null;
+		if (nativeTrainerUrl != null && !nativeTrainerUrl.isEmpty()) {
+			try {
+				model = NativeTrainerClient.train(nativeTrainerUrl, prob, param, alpha);
+			} catch (IOException e) {
+				System.err.print("Native trainer failed, training in process: " + e.getMessage() + "\n");
+			}
+		}
+		if (model == null)
+			model = WarmStartSvr.train(prob, param, alpha);
+		svm.svm_save_model(modelPath, ModelCompressor.forShipping(modelPath, model, svBudget, maxCompressionError));
+		writeState(modelPath + STATE_SUFFIX, prob, param, alpha);
+	}
+
+	private void writeState(String statePath, svm_problem prob, svm_parameter param, double[] alpha)
+			throws IOException {
+		BufferedWriter writer = new BufferedWriter(new FileWriter(statePath));
+		try {
+			writer.write("offset " + offset);
+			writer.newLine();
+			writer.write("param " + param.C + " " + param.gamma + " " + param.p);
+			writer.newLine();
+			for (int i = 0; i < prob.l; i++) {
+				if (alpha[i] == 0)
+					continue;
+				StringBuilder line = new StringBuilder();
+				line.append(alpha[i]).append(' ').append(prob.y[i]);
+				for (svm_node node : prob.x[i])
+					line.append(' ').append(node.index).append(':').append(node.value);
+				writer.write(line.toString());
+				writer.newLine();
+			}
+		} finally {
+			writer.close();
+		}
+	}
+
+	private static svm_node[] parseNodes(StringTokenizer st) {
+		int m = st.countTokens() / 2;
+		svm_node[] nodes = new svm_node[m];
+		for (int j = 0; j < m; j++) {
+			nodes[j] = new svm_node();
+			nodes[j].index = Integer.parseInt(st.nextToken());
+			nodes[j].value = Double.parseDouble(st.nextToken());
+		}
+		return nodes;
+	}
+}
@@ -0,0 +1,108 @@
+package api;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.List;
+
+/**
+ * BlobStore over a directory, one file per key. With the default root, the
+ * working directory, it is the layout of a single node; pointed at a
+ * directory every node mounts (NFS and the like), it lets several API nodes
+ * share one set of models and queue. Values are written to a temporary file
+ * and renamed into place, which is atomic on the file systems that matter.
+ */
+public class LocalBlobStore implements BlobStore {
+	private static final String TMP_SUFFIX = ".tmp";
+
+	private final File root;
+
+	public LocalBlobStore(String root) {
+		this.root = new File(root);
+	}
+
+	public byte[] get(String key) throws IOException {
+		try {
+			return Files.readAllBytes(file(key).toPath());
+		} catch (NoSuchFileException e) {
+			return null;
+		}
+	}
+
+	public String version(String key) {
+		File file = file(key);
+		long lastModified = file.lastModified();
+		if (lastModified == 0 && !file.exists())
+			return null;
+		return lastModified + "-" + file.length();
+	}
+
+	public void put(String key, byte[] value) throws IOException {
+		File file = file(key);
+		File tmp = createTmp(file);
+		Files.write(tmp.toPath(), value);
+		commit(tmp, file);
+	}
+
+	public void publish(String key, File source) throws IOException {
+		File file = file(key);
+		// Trainers of a single node write straight to the store.
+		if (source.getCanonicalFile().equals(file.getCanonicalFile()))
+			return;
+		File tmp = createTmp(file);
+		Files.copy(source.toPath(), tmp.toPath(), StandardCopyOption.REPLACE_EXISTING);
+		commit(tmp, file);
+	}
+
+	public File localFile(String key) {
+		File file = file(key);
+		return file.isFile() ? file : null;
+	}
+
+	public boolean delete(String key) {
+		return file(key).delete();
+	}
+
+	public List<String> list(String prefix) {
+		List<String> keys = new ArrayList<String>();
+		File[] files = file(prefix).listFiles();
+		if (files == null)
+			return keys;
+		Arrays.sort(files, new Comparator<File>() {
+			public int compare(File a, File b) {
+				int order = Long.compare(a.lastModified(), b.lastModified());
+				return order != 0 ? order : a.getName().compareTo(b.getName());
+			}
+		});
+		for (File file : files) {
+			if (file.isFile() && !file.getName().endsWith(TMP_SUFFIX))
+				keys.add(prefix + file.getName());
+		}
+		return keys;
+	}
+
+	private File file(String key) {
+		return new File(root, key);
+	}
+
+	private static File createTmp(File file) throws IOException {
+		File dir = file.getParentFile();
+		if (!dir.isDirectory() && !dir.mkdirs() && !dir.isDirectory())
+			throw new IOException("cannot create " + dir);
+		return File.createTempFile(file.getName() + ".", TMP_SUFFIX, dir);
+	}
+
+	private static void commit(File tmp, File file) throws IOException {
+		try {
+			Files.move(tmp.toPath(), file.toPath(), StandardCopyOption.REPLACE_EXISTING,
+					StandardCopyOption.ATOMIC_MOVE);
+		} finally {
+			tmp.delete();
+		}
+	}
+}
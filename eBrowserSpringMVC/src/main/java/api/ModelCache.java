@@ -0,0 +1,63 @@
+package api;
+
+import java.io.BufferedReader;
+import java.io.ByteArrayInputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.ConcurrentHashMap;
+
+import org.springframework.beans.factory.annotation.Autowired;
+import org.springframework.stereotype.Component;
+
+import libsvm.svm;
+import libsvm.svm_model;
+
+/**
+ * Parsed models, so that answering a request does not read and parse a model
+ * file. An entry is reused while the BlobStore reports the version it was
+ * parsed at, and is dropped by invalidate() when a training on this node
+ * rewrites it, which also covers stores with coarse timestamps. Models
+ * trained on another node are picked up by their version. Models are
+ * immutable once parsed and may be shared between threads.
+ */
+@Component
+public class ModelCache {
+	private static class Entry {
+		final String version;
+		final svm_model model;
+
+		Entry(String version, svm_model model) {
+			this.version = version;
+			this.model = model;
+		}
+	}
+
+	@Autowired
+	private BlobStore blobStore;
+
+	private final ConcurrentHashMap<String, Entry> entries = new ConcurrentHashMap<String, Entry>();
+
+	// Returns the model stored as |modelPath|, or null if there is none.
+	public svm_model get(String modelPath) throws IOException {
+		String version = blobStore.version(modelPath);
+		Entry entry = entries.get(modelPath);
+		if (entry != null && entry.version.equals(version))
+			return entry.model;
+		if (version == null)
+			return null;
+		byte[] bytes = blobStore.get(modelPath);
+		if (bytes == null)
+			return null;
+		svm_model model = svm.svm_load_model(new BufferedReader(
+				new InputStreamReader(new ByteArrayInputStream(bytes), StandardCharsets.US_ASCII)));
+		if (model != null)
+			entries.put(modelPath, new Entry(version, model));
+		return model;
+	}
+
+	// Called after |modelPath| has been rewritten.
+	public void invalidate(String modelPath) {
+		entries.remove(modelPath);
+	}
+}
@@ -0,0 +1,212 @@
+package api;
+
+import java.util.Arrays;
+import java.util.Comparator;
+
+import libsvm.svm_model;
+import libsvm.svm_node;
+import libsvm.svm_parameter;
+
+/**
+ * Shrinks a trained model to a budget of support vectors before it is
+ * shipped, so that the cost of a prediction on the device, which is linear in
+ * the number of support vectors, stays bounded however much a user trains.
+ *
+ * For single-feature RBF models the support vectors are sorted by speed and
+ * split into |budget| runs; each run is replaced by one center, and the
+ * coefficients of the centers and the bias are refitted by least squares to
+ * the original decision function on a dense grid of speeds (a reduced-set
+ * approximation). Other models are returned unchanged.
+ */
+public class ModelCompressor {
+	// Grid points per center, and the least number of grid points.
+	private static final int GRID_POINTS_PER_CENTER = 20;
+	private static final int MIN_GRID_POINTS = 200;
+	// The grid extends past the outermost support vectors by this many kernel
+	// widths (1 / sqrt(gamma)), where the model is still far from its bias.
+	private static final double GRID_MARGIN_WIDTHS = 2;
+	// Ridge term, relative to the mean diagonal of the normal equations.
+	private static final double RIDGE = 1e-9;
+
+	/** A compressed model and how far its predictions moved, in fps. */
+	public static class Result {
+		public final svm_model model;
+		public final double maxError;
+		public final double rmsError;
+
+		Result(svm_model model, double maxError, double rmsError) {
+			this.model = model;
+			this.maxError = maxError;
+			this.rmsError = rmsError;
+		}
+	}
+
+	public static Result compress(svm_model model, int budget) {
+		if (budget < 1 || model.l <= budget || !isSingleFeatureRbf(model))
+			return new Result(model, 0, 0);
+
+		int l = model.l;
+		double[] x = new double[l];
+		double[] a = new double[l];
+		Integer[] order = new Integer[l];
+		for (int i = 0; i < l; i++) {
+			x[i] = model.SV[i][0].value;
+			a[i] = model.sv_coef[0][i];
+			order[i] = i;
+		}
+		final double[] keys = x;
+		Arrays.sort(order, new Comparator<Integer>() {
+			public int compare(Integer i, Integer j) {
+				return Double.compare(keys[i], keys[j]);
+			}
+		});
+
+		// Centers: the |a|-weighted mean speed of each run of sorted support
+		// vectors.
+		double[] centers = new double[budget];
+		for (int k = 0; k < budget; k++) {
+			int begin = k * l / budget;
+			int end = (k + 1) * l / budget;
+			double weight = 0;
+			double sum = 0;
+			for (int i = begin; i < end; i++) {
+				double w = Math.abs(a[order[i]]) + 1e-12;
+				weight += w;
+				sum += w * x[order[i]];
+			}
+			centers[k] = sum / weight;
+		}
+
+		double gamma = model.param.gamma;
+		double margin = GRID_MARGIN_WIDTHS / Math.sqrt(gamma);
+		double low = x[order[0]] - margin;
+		double high = x[order[l - 1]] + margin;
+		int n = Math.max(MIN_GRID_POINTS, GRID_POINTS_PER_CENTER * budget);
+		double[] grid = new double[n];
+		double[] target = new double[n];
+		for (int g = 0; g < n; g++) {
+			grid[g] = low + (high - low) * g / (n - 1);
+			target[g] = evaluate(x, a, model.rho[0], gamma, grid[g]);
+		}
+
+		// Normal equations for [beta_1 .. beta_budget, bias], where the
+		// prediction is sum(beta_k K(c_k, s)) + bias.
+		int m = budget + 1;
+		double[][] ata = new double[m][m];
+		double[] atb = new double[m];
+		double[] row = new double[m];
+		for (int g = 0; g < n; g++) {
+			for (int k = 0; k < budget; k++)
+				row[k] = kernel(gamma, centers[k], grid[g]);
+			row[budget] = 1;
+			for (int i = 0; i < m; i++) {
+				atb[i] += row[i] * target[g];
+				for (int j = 0; j < m; j++)
+					ata[i][j] += row[i] * row[j];
+			}
+		}
+		double trace = 0;
+		for (int i = 0; i < m; i++)
+			trace += ata[i][i];
+		for (int i = 0; i < budget; i++)
+			ata[i][i] += RIDGE * trace / m;
+		double[] theta = solve(ata, atb);
+		if (theta == null)
+			return new Result(model, 0, 0);
+
+		svm_model compressed = new svm_model();
+		compressed.param = model.param;
+		compressed.nr_class = 2;
+		compressed.l = budget;
+		compressed.SV = new svm_node[budget][];
+		compressed.sv_coef = new double[1][budget];
+		compressed.rho = new double[] { -theta[budget] };
+		for (int k = 0; k < budget; k++) {
+			svm_node node = new svm_node();
+			node.index = 1;
+			node.value = centers[k];
+			compressed.SV[k] = new svm_node[] { node };
+			compressed.sv_coef[0][k] = theta[k];
+		}
+
+		double maxError = 0;
+		double squaredError = 0;
+		for (int g = 0; g < n; g++) {
+			double error = Math.abs(evaluate(centers, theta, -theta[budget], gamma, grid[g]) - target[g]);
+			maxError = Math.max(maxError, error);
+			squaredError += error * error;
+		}
+		return new Result(compressed, maxError, Math.sqrt(squaredError / n));
+	}
+
+	// Returns the model to ship for |model|, which is to be saved to
+	// |modelPath|: compressed to |budget| support vectors unless that moves a
+	// prediction by more than |maxError| fps. Logs the outcome.
+	public static svm_model forShipping(String modelPath, svm_model model, int budget, double maxError) {
+		Result result = compress(model, budget);
+		if (result.model == model)
+			return model;
+		boolean accepted = result.maxError <= maxError;
+		System.out.println("ModelCompressor: " + modelPath + ", support vectors " + model.l + " -> " + result.model.l
+				+ ", max error " + result.maxError + " fps, rms error " + result.rmsError + " fps"
+				+ (accepted ? "" : ", kept uncompressed"));
+		return accepted ? result.model : model;
+	}
+
+	private static boolean isSingleFeatureRbf(svm_model model) {
+		if (model.param.kernel_type != svm_parameter.RBF || model.nr_class != 2)
+			return false;
+		for (int i = 0; i < model.l; i++) {
+			if (model.SV[i].length != 1 || model.SV[i][0].index != 1)
+				return false;
+		}
+		return true;
+	}
+
+	private static double kernel(double gamma, double u, double v) {
+		double d = u - v;
+		return Math.exp(-gamma * d * d);
+	}
+
+	private static double evaluate(double[] x, double[] a, double rho, double gamma, double s) {
+		double sum = -rho;
+		for (int i = 0; i < x.length; i++)
+			sum += a[i] * kernel(gamma, x[i], s);
+		return sum;
+	}
+
+	// Solves |matrix| * result = |rhs| by Gaussian elimination with partial
+	// pivoting. Returns null if the system is singular.
+	private static double[] solve(double[][] matrix, double[] rhs) {
+		int m = rhs.length;
+		for (int col = 0; col < m; col++) {
+			int pivot = col;
+			for (int r = col + 1; r < m; r++) {
+				if (Math.abs(matrix[r][col]) > Math.abs(matrix[pivot][col]))
+					pivot = r;
+			}
+			if (matrix[pivot][col] == 0)
+				return null;
+			double[] tmpRow = matrix[col];
+			matrix[col] = matrix[pivot];
+			matrix[pivot] = tmpRow;
+			double tmp = rhs[col];
+			rhs[col] = rhs[pivot];
+			rhs[pivot] = tmp;
+			for (int r = col + 1; r < m; r++) {
+				double factor = matrix[r][col] / matrix[col][col];
+				for (int c = col; c < m; c++)
+					matrix[r][c] -= factor * matrix[col][c];
+				rhs[r] -= factor * rhs[col];
+			}
+		}
+		double[] result = new double[m];
+		for (int r = m - 1; r >= 0; r--) {
+			double sum = rhs[r];
+			for (int c = r + 1; c < m; c++)
+				sum -= matrix[r][c] * result[c];
+			result[r] = sum / matrix[r][r];
+		}
+		return result;
+	}
+}
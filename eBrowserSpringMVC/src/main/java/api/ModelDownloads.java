@@ -0,0 +1,141 @@
+package api;
+
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.zip.CRC32;
+import java.util.zip.GZIPOutputStream;
+
+import org.springframework.beans.factory.annotation.Autowired;
+import org.springframework.beans.factory.annotation.Value;
+import org.springframework.stereotype.Component;
+
+import libsvm.svm_model;
+
+/**
+ * What /download sends for a model, prepared once per version of it rather
+ * than per request: the ETag, and for the hot set of recently downloaded
+ * models the body, plain and gzipped, so that the whole fleet pulling a new
+ * shared model costs one read, one checksum and one compression. Models too
+ * large for the hot set keep only their ETag and are sent from their file
+ * without being read into the JVM.
+ */
+@Component
+public class ModelDownloads {
+	// A model is kept in memory if it takes at most this part of the set.
+	private static final int MAX_HOT_FRACTION = 8;
+
+	/** What to send for one model in one format. */
+	public static class Download {
+		public final String format;
+		public final String etag;
+		private final String version;
+		private final byte[] body;
+		private final byte[] gzipped;
+		private final File file;
+
+		Download(String format, String etag, String version, byte[] body, byte[] gzipped, File file) {
+			this.format = format;
+			this.etag = etag;
+			this.version = version;
+			this.body = body;
+			this.gzipped = gzipped;
+			this.file = file;
+		}
+
+		// The body, or null if it is sent from file().
+		public byte[] body() {
+			return body;
+		}
+
+		// The gzipped body, or null if it is not worth compressing.
+		public byte[] gzipped() {
+			return gzipped;
+		}
+
+		public File file() {
+			return file;
+		}
+
+		long size() {
+			return (body == null ? 0 : body.length) + (gzipped == null ? 0 : gzipped.length);
+		}
+	}
+
+	@Autowired
+	private BlobStore blobStore;
+	@Autowired
+	private ModelCache modelCache;
+	@Value("${download.hot-set-bytes:33554432}")
+	private long hotSetBytes;
+
+	// Guarded by |this|, least recently used first.
+	private final Map<String, Download> downloads = new LinkedHashMap<String, Download>(16, 0.75f, true);
+	private long hotBytes;
+
+	// Returns what to send for |modelPath| in |format|, "text" or "binary",
+	// or null if there is no such model. Models that cannot be converted
+	// come back as text, which the browser still accepts.
+	public Download get(String modelPath, String format) throws IOException {
+		String version = blobStore.version(modelPath);
+		if (version == null)
+			return null;
+		String key = format + ":" + modelPath;
+		synchronized (this) {
+			Download download = downloads.get(key);
+			if (download != null && download.version.equals(version))
+				return download;
+		}
+		Download download = load(modelPath, format, version);
+		if (download == null)
+			return null;
+		synchronized (this) {
+			Download old = downloads.put(key, download);
+			if (old != null)
+				hotBytes -= old.size();
+			hotBytes += download.size();
+			Iterator<Download> eldest = downloads.values().iterator();
+			while (hotBytes > hotSetBytes && eldest.hasNext()) {
+				Download evicted = eldest.next();
+				if (evicted == download)
+					break;
+				hotBytes -= evicted.size();
+				eldest.remove();
+			}
+		}
+		return download;
+	}
+
+	private Download load(String modelPath, String format, String version) throws IOException {
+		if ("binary".equals(format)) {
+			svm_model model = modelCache.get(modelPath);
+			byte[] body = model == null ? null : BinaryModelWriter.convert(model);
+			// The binary format is mostly float mantissas and does not shrink.
+			if (body != null)
+				return new Download(format, etag(format, body), version, body, null, null);
+		}
+		byte[] body = blobStore.get(modelPath);
+		if (body == null)
+			return null;
+		// The version is derived from the content, so a retraining that
+		// reproduces the same model does not cost the device a transfer.
+		String etag = etag("text", body);
+		File file = blobStore.localFile(modelPath);
+		if (file != null && body.length > hotSetBytes / MAX_HOT_FRACTION)
+			return new Download("text", etag, version, null, null, file);
+		ByteArrayOutputStream compressed = new ByteArrayOutputStream();
+		GZIPOutputStream gzip = new GZIPOutputStream(compressed);
+		gzip.write(body);
+		gzip.close();
+		return new Download("text", etag, version, body, compressed.toByteArray(), null);
+	}
+
+	private static String etag(String format, byte[] body) {
+		CRC32 crc = new CRC32();
+		crc.update(body);
+		return "\"" + format + "-" + Long.toHexString(crc.getValue()) + "-" + body.length + "\"";
+	}
+}
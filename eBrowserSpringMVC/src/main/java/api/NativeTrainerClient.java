@@ -0,0 +1,88 @@
+package api;
+
+import java.io.BufferedReader;
+import java.io.BufferedWriter;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.OutputStream;
+import java.io.OutputStreamWriter;
+import java.io.Writer;
+import java.net.HttpURLConnection;
+import java.net.URL;
+
+import libsvm.WarmStartSvr;
+import libsvm.svm_model;
+import libsvm.svm_node;
+import libsvm.svm_parameter;
+import libsvm.svm_problem;
+
+/**
+ * Runs WarmStartSvr.train() on the native trainer, the browser's libsvm
+ * served by ui/events/blink/tools/svm_train_server, which trains the same
+ * problem in a fraction of the time. The problem and the starting point are
+ * posted as "<label> <coef> <index>:<value> ..." lines and the solution comes
+ * back as "rho <rho>" and one coef per sample; see svm_train_server.cc.
+ */
+public class NativeTrainerClient {
+	private static final int CONNECT_TIMEOUT_MILLIS = 2000;
+	// Large problems train for minutes.
+	private static final int READ_TIMEOUT_MILLIS = 10 * 60 * 1000;
+
+	/**
+	 * Like WarmStartSvr.train(), with |coef| the starting point on entry and
+	 * the solution on return. Throws if the trainer is unreachable or refuses
+	 * the job, in which case |coef| is unchanged.
+	 */
+	public static svm_model train(String baseUrl, svm_problem prob, svm_parameter param, double[] coef)
+			throws IOException {
+		URL url = new URL(baseUrl + "/train?C=" + param.C + "&gamma=" + param.gamma + "&p=" + param.p + "&eps="
+				+ param.eps + "&shrinking=" + param.shrinking + "&cache_mb=" + param.cache_size);
+		HttpURLConnection connection = (HttpURLConnection) url.openConnection();
+		try {
+			connection.setConnectTimeout(CONNECT_TIMEOUT_MILLIS);
+			connection.setReadTimeout(READ_TIMEOUT_MILLIS);
+			connection.setRequestMethod("POST");
+			connection.setDoOutput(true);
+			connection.setRequestProperty("Content-Type", "text/plain; charset=utf-8");
+			OutputStream out = connection.getOutputStream();
+			Writer writer = new BufferedWriter(new OutputStreamWriter(out, "UTF-8"));
+			try {
+				for (int i = 0; i < prob.l; i++) {
+					StringBuilder line = new StringBuilder();
+					line.append(prob.y[i]).append(' ').append(coef[i]);
+					for (svm_node node : prob.x[i])
+						line.append(' ').append(node.index).append(':').append(node.value);
+					writer.write(line.append('\n').toString());
+				}
+			} finally {
+				writer.close();
+			}
+
+			int status = connection.getResponseCode();
+			if (status != HttpURLConnection.HTTP_OK)
+				throw new IOException("native trainer returned " + status);
+			BufferedReader reader = new BufferedReader(new InputStreamReader(connection.getInputStream(), "UTF-8"));
+			try {
+				String header = reader.readLine();
+				if (header == null || !header.startsWith("rho "))
+					throw new IOException("bad native trainer response");
+				double rho = Double.parseDouble(header.substring("rho ".length()).trim());
+				double[] solution = new double[prob.l];
+				for (int i = 0; i < prob.l; i++) {
+					String line = reader.readLine();
+					if (line == null)
+						throw new IOException("truncated native trainer response");
+					solution[i] = Double.parseDouble(line.trim());
+				}
+				System.arraycopy(solution, 0, coef, 0, prob.l);
+				return WarmStartSvr.model(prob, param, coef, rho);
+			} catch (NumberFormatException e) {
+				throw new IOException("bad native trainer response", e);
+			} finally {
+				reader.close();
+			}
+		} finally {
+			connection.disconnect();
+		}
+	}
+}
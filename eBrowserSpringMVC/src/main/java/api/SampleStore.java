@@ -0,0 +1,331 @@
+package api;
+
+import java.io.BufferedReader;
+import java.io.BufferedWriter;
+import java.io.File;
+import java.io.FileReader;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.StringTokenizer;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.TimeUnit;
+
+import javax.annotation.PreDestroy;
+
+import org.springframework.stereotype.Component;
+
+/**
+ * Append-only store of the feedback samples of each device. Replaces the
+ * per-device text files in trains/, which started as a full copy of the
+ * shared training set and were reopened for every sample.
+ *
+ * A device's samples live in samples/<deviceId>/ as fixed-size segments of
+ * SEGMENT_RECORDS little-endian records (double fps, double speed), so an
+ * append touches only the end of the last segment. The directory also holds a
+ * "base" file naming the shared dataset the device's model starts from; that
+ * dataset is read in place and never copied. AggregateModelBuilder.build()
+ * streams every device's log to build the shared model. Appends are fsynced in batches,
+ * every FSYNC_INTERVAL_MS, rather than one by one.
+ */
+@Component
+public class SampleStore {
+	public static final String BASE_DATASET = "trains/train";
+	private static final String ROOT = "samples/";
+	private static final String LEGACY_ROOT = "trains/";
+	private static final int RECORD_SIZE = 16;
+	private static final int SEGMENT_RECORDS = 4096;
+	private static final long FSYNC_INTERVAL_MS = 1000;
+	// Appenders kept open; the least recently used one is closed past this.
+	private static final int MAX_OPEN_LOGS = 256;
+
+	/** A training sample: the fps the user asked for at a speed. */
+	public static class Sample {
+		public final double fps;
+		public final double speed;
+
+		Sample(double fps, double speed) {
+			this.fps = fps;
+			this.speed = speed;
+		}
+	}
+
+	// The open tail segment of one device.
+	private static class DeviceLog {
+		final String deviceId;
+		FileChannel channel;
+		int segment;
+		int recordsInSegment;
+		boolean dirty;
+
+		DeviceLog(String deviceId) {
+			this.deviceId = deviceId;
+		}
+	}
+
+	// Guarded by |this|; each DeviceLog is also guarded by itself.
+	private final Map<String, DeviceLog> logs = new LinkedHashMap<String, DeviceLog>(16, 0.75f, true);
+	private final ScheduledExecutorService flusher = Executors.newSingleThreadScheduledExecutor();
+
+	public SampleStore() {
+		flusher.scheduleWithFixedDelay(new Runnable() {
+			public void run() {
+				flush();
+			}
+		}, FSYNC_INTERVAL_MS, FSYNC_INTERVAL_MS, TimeUnit.MILLISECONDS);
+	}
+
+	@PreDestroy
+	public void close() {
+		flusher.shutdown();
+		synchronized (this) {
+			for (DeviceLog log : logs.values())
+				closeLog(log);
+			logs.clear();
+		}
+	}
+
+	public void append(String deviceId, double fps, double speed) throws IOException {
+		ByteBuffer record = ByteBuffer.allocate(RECORD_SIZE).order(ByteOrder.LITTLE_ENDIAN);
+		record.putDouble(fps).putDouble(speed).flip();
+		while (true) {
+			DeviceLog log = openLog(deviceId);
+			synchronized (log) {
+				// Closed to make room for another device; open it again.
+				if (log.channel == null)
+					continue;
+				if (log.recordsInSegment == SEGMENT_RECORDS)
+					openSegment(log, log.segment + 1);
+				while (record.hasRemaining())
+					log.channel.write(record);
+				++log.recordsInSegment;
+				log.dirty = true;
+				return;
+			}
+		}
+	}
+
+	// Ids of the devices that have a log.
+	public List<String> devices() {
+		List<String> devices = new ArrayList<String>();
+		String[] names = new File(ROOT).list();
+		if (names == null)
+			return devices;
+		for (String name : names) {
+			if (deviceDir(name).isDirectory())
+				devices.add(name);
+		}
+		return devices;
+	}
+
+	// Number of samples of |deviceId|, not counting the base dataset.
+	public long count(String deviceId) {
+		File dir = deviceDir(deviceId);
+		int last = lastSegment(dir);
+		if (last < 0)
+			return 0;
+		return (long) last * SEGMENT_RECORDS + segmentFile(dir, last).length() / RECORD_SIZE;
+	}
+
+	// Appends the samples of |deviceId| from index |from| on to |out|.
+	public void read(String deviceId, long from, List<Sample> out) throws IOException {
+		File dir = deviceDir(deviceId);
+		int last = lastSegment(dir);
+		for (int segment = (int) (from / SEGMENT_RECORDS); segment <= last; segment++) {
+			FileChannel channel = FileChannel.open(segmentFile(dir, segment).toPath(), StandardOpenOption.READ);
+			try {
+				long start = segment == from / SEGMENT_RECORDS ? from % SEGMENT_RECORDS * RECORD_SIZE : 0;
+				long end = channel.size() / RECORD_SIZE * RECORD_SIZE;
+				if (end <= start)
+					continue;
+				ByteBuffer buffer = ByteBuffer.allocate((int) (end - start)).order(ByteOrder.LITTLE_ENDIAN);
+				while (buffer.hasRemaining() && channel.read(buffer, start + buffer.position()) >= 0) {
+				}
+				buffer.flip();
+				while (buffer.remaining() >= RECORD_SIZE)
+					out.add(new Sample(buffer.getDouble(), buffer.getDouble()));
+			} finally {
+				channel.close();
+			}
+		}
+	}
+
+	// Appends the shared dataset |deviceId| starts from to |out|.
+	public void readBase(String deviceId, List<Sample> out) throws IOException {
+		File pointer = new File(deviceDir(deviceId), "base");
+		String basePath = BASE_DATASET;
+		if (pointer.exists()) {
+			BufferedReader reader = new BufferedReader(new FileReader(pointer));
+			try {
+				String line = reader.readLine();
+				if (line != null && !line.trim().isEmpty())
+					basePath = line.trim();
+			} finally {
+				reader.close();
+			}
+		}
+		readText(new File(basePath), 0, out);
+	}
+
+	// Fsyncs the appends made since the last flush.
+	public void flush() {
+		List<DeviceLog> open;
+		synchronized (this) {
+			open = new ArrayList<DeviceLog>(logs.values());
+		}
+		for (DeviceLog log : open) {
+			synchronized (log) {
+				if (!log.dirty || log.channel == null)
+					continue;
+				try {
+					log.channel.force(false);
+					log.dirty = false;
+				} catch (IOException e) {
+					e.printStackTrace();
+				}
+			}
+		}
+	}
+
+	private synchronized DeviceLog openLog(String deviceId) throws IOException {
+		DeviceLog log = logs.get(deviceId);
+		if (log != null)
+			return log;
+
+		File dir = deviceDir(deviceId);
+		boolean created = !dir.exists();
+		if (created && !dir.mkdirs())
+			throw new IOException("cannot create " + dir);
+		log = new DeviceLog(deviceId);
+		synchronized (log) {
+			openSegment(log, Math.max(0, lastSegment(dir)));
+			if (created) {
+				// New devices start from the aggregate of all devices once
+				// there is one; existing ones keep the base their state was
+				// trained from.
+				String basePath = new File(AggregateModelBuilder.AGGREGATE_DATASET).exists()
+						? AggregateModelBuilder.AGGREGATE_DATASET : BASE_DATASET;
+				BufferedWriter writer = new BufferedWriter(new FileWriter(new File(dir, "base")));
+				writer.write(basePath);
+				writer.newLine();
+				writer.close();
+				importLegacy(log);
+			}
+		}
+		logs.put(deviceId, log);
+		if (logs.size() > MAX_OPEN_LOGS) {
+			Iterator<DeviceLog> eldest = logs.values().iterator();
+			closeLog(eldest.next());
+			eldest.remove();
+		}
+		return log;
+	}
+
+	private void openSegment(DeviceLog log, int segment) throws IOException {
+		if (log.channel != null) {
+			log.channel.force(false);
+			log.channel.close();
+		}
+		File file = segmentFile(deviceDir(log.deviceId), segment);
+		log.channel = FileChannel.open(file.toPath(), StandardOpenOption.CREATE, StandardOpenOption.WRITE,
+				StandardOpenOption.APPEND);
+		log.segment = segment;
+		// Drops a torn record left by a crash mid-append.
+		long records = log.channel.size() / RECORD_SIZE;
+		log.channel.truncate(records * RECORD_SIZE);
+		log.recordsInSegment = (int) records;
+		log.dirty = false;
+	}
+
+	private void closeLog(DeviceLog log) {
+		synchronized (log) {
+			if (log.channel == null)
+				return;
+			try {
+				log.channel.force(false);
+				log.channel.close();
+			} catch (IOException e) {
+				e.printStackTrace();
+			}
+			log.channel = null;
+		}
+	}
+
+	// Moves the feedback of a device's old text file, which follows a copy of
+	// the base dataset, into its new log.
+	private void importLegacy(DeviceLog log) throws IOException {
+		File legacy = new File(LEGACY_ROOT + log.deviceId);
+		if (!legacy.exists())
+			return;
+		List<Sample> base = new ArrayList<Sample>();
+		readText(new File(BASE_DATASET), 0, base);
+		List<Sample> feedback = new ArrayList<Sample>();
+		readText(legacy, base.size(), feedback);
+		ByteBuffer records = ByteBuffer.allocate(feedback.size() * RECORD_SIZE).order(ByteOrder.LITTLE_ENDIAN);
+		for (Sample sample : feedback) {
+			if (log.recordsInSegment == SEGMENT_RECORDS) {
+				records.flip();
+				while (records.hasRemaining())
+					log.channel.write(records);
+				records.clear();
+				openSegment(log, log.segment + 1);
+			}
+			records.putDouble(sample.fps).putDouble(sample.speed);
+			++log.recordsInSegment;
+		}
+		records.flip();
+		while (records.hasRemaining())
+			log.channel.write(records);
+		log.channel.force(false);
+	}
+
+	// Reads "fps 1:speed" lines of |file| past the first |skip| ones.
+	static void readText(File file, int skip, List<Sample> out) throws IOException {
+		if (!file.exists())
+			return;
+		BufferedReader reader = new BufferedReader(new FileReader(file));
+		try {
+			String line;
+			int lineNumber = 0;
+			while ((line = reader.readLine()) != null) {
+				StringTokenizer st = new StringTokenizer(line, " \t:");
+				if (st.countTokens() < 3 || lineNumber++ < skip)
+					continue;
+				double fps = Double.parseDouble(st.nextToken());
+				st.nextToken();
+				out.add(new Sample(fps, Double.parseDouble(st.nextToken())));
+			}
+		} finally {
+			reader.close();
+		}
+	}
+
+	private static File deviceDir(String deviceId) {
+		return new File(ROOT + deviceId);
+	}
+
+	private static File segmentFile(File dir, int segment) {
+		return new File(dir, String.format("seg-%06d", segment));
+	}
+
+	private static int lastSegment(File dir) {
+		int last = -1;
+		String[] names = dir.list();
+		if (names == null)
+			return last;
+		for (String name : names) {
+			if (name.startsWith("seg-"))
+				last = Math.max(last, Integer.parseInt(name.substring(4)));
+		}
+		return last;
+	}
+}
@@ -0,0 +1,22 @@
+package api;
+
+import org.springframework.beans.factory.annotation.Value;
+import org.springframework.context.annotation.Bean;
+import org.springframework.context.annotation.Configuration;
+
+/**
+ * Picks the BlobStore the nodes share from storage.backend. "local" keeps
+ * the keys as files under storage.root, the working directory by default,
+ * which is a shared mount when several nodes run. Object store and shared KV
+ * backends implement BlobStore and are added here under their own names.
+ */
+@Configuration
+public class StorageConfig {
+	@Bean
+	public BlobStore blobStore(@Value("${storage.backend:local}") String backend,
+			@Value("${storage.root:.}") String root) {
+		if ("local".equals(backend))
+			return new LocalBlobStore(root);
+		throw new IllegalArgumentException("unknown storage.backend " + backend);
+	}
+}
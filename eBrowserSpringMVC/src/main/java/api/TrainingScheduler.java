@@ -0,0 +1,155 @@
+package api;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+
+import javax.annotation.PreDestroy;
+
+import org.springframework.beans.factory.annotation.Autowired;
+import org.springframework.beans.factory.annotation.Value;
+import org.springframework.scheduling.annotation.Scheduled;
+import org.springframework.stereotype.Component;
+
+/**
+ * Runs model trainings on a worker pool sized to the cores, with at most one
+ * job per device. A request for a device whose job is still queued is folded
+ * into it. A request that arrives while the device's job is running queues a
+ * single follow-up job, so the latest samples are trained on once the running
+ * job has written its model. Two trainings never touch the same model file at
+ * the same time.
+ */
+@Component
+public class TrainingScheduler {
+	// Key of the shared model, which is built by AggregateModelBuilder.
+	private static final String SHARED_KEY = "";
+
+	private enum State {
+		QUEUED, RUNNING, RUNNING_RERUN
+	}
+
+	/** Counters reported by /trainStats. */
+	public static class Stats {
+		private final int queued;
+		private final int running;
+		private final long requested;
+		private final long coalesced;
+		private final long completed;
+
+		Stats(int queued, int running, long requested, long coalesced, long completed) {
+			this.queued = queued;
+			this.running = running;
+			this.requested = requested;
+			this.coalesced = coalesced;
+			this.completed = completed;
+		}
+
+		public int getQueued() {
+			return queued;
+		}
+
+		public int getRunning() {
+			return running;
+		}
+
+		public long getRequested() {
+			return requested;
+		}
+
+		public long getCoalesced() {
+			return coalesced;
+		}
+
+		public long getCompleted() {
+			return completed;
+		}
+	}
+
+	@Autowired
+	private AsyscService task;
+	// See WorkQueue; API-only nodes leave the shared model to the worker.
+	@Value("${node.role:all}")
+	private String role;
+
+	private final ThreadPoolExecutor executor;
+	// Guarded by |this|.
+	private final Map<String, State> jobs = new HashMap<String, State>();
+	private long requested;
+	private long coalesced;
+	private long completed;
+
+	public TrainingScheduler() {
+		int workers = Runtime.getRuntime().availableProcessors();
+		executor = new ThreadPoolExecutor(workers, workers, 0, TimeUnit.MILLISECONDS,
+				new LinkedBlockingQueue<Runnable>());
+	}
+
+	@PreDestroy
+	public void shutdown() {
+		executor.shutdown();
+	}
+
+	// Asks for the model of |deviceId|, or the shared model if it is empty, to
+	// be retrained.
+	public void schedule(String deviceId) {
+		String key = deviceId.trim().isEmpty() ? SHARED_KEY : deviceId;
+		synchronized (this) {
+			++requested;
+			State state = jobs.get(key);
+			if (state == null) {
+				jobs.put(key, State.QUEUED);
+				submit(key);
+			} else {
+				++coalesced;
+				if (state == State.RUNNING)
+					jobs.put(key, State.RUNNING_RERUN);
+			}
+		}
+		System.out.println("TrainingScheduler: queued " + executor.getQueue().size() + ", running "
+				+ executor.getActiveCount());
+	}
+
+	// Rebuilds the shared model from the feedback of all devices, through the
+	// same queue so that it never races a /train of the shared model.
+	@Scheduled(initialDelayString = "${model.aggregate-interval-ms:3600000}",
+			fixedDelayString = "${model.aggregate-interval-ms:3600000}")
+	public void scheduleAggregate() {
+		if ("api".equals(role))
+			return;
+		schedule(SHARED_KEY);
+	}
+
+	public synchronized Stats getStats() {
+		return new Stats(executor.getQueue().size(), executor.getActiveCount(), requested, coalesced, completed);
+	}
+
+	private void submit(final String key) {
+		executor.execute(new Runnable() {
+			public void run() {
+				train(key);
+			}
+		});
+	}
+
+	private void train(String key) {
+		synchronized (this) {
+			jobs.put(key, State.RUNNING);
+		}
+		try {
+			task.doTrain(key.equals(SHARED_KEY), key);
+		} catch (Exception e) {
+			e.printStackTrace();
+		}
+		synchronized (this) {
+			++completed;
+			if (jobs.get(key) == State.RUNNING_RERUN) {
+				jobs.put(key, State.QUEUED);
+				submit(key);
+			} else {
+				jobs.remove(key);
+			}
+		}
+	}
+}
@@ -0,0 +1,122 @@
+package api;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.util.List;
+import java.util.UUID;
+import java.util.concurrent.atomic.AtomicLong;
+
+import org.springframework.beans.factory.annotation.Autowired;
+import org.springframework.beans.factory.annotation.Value;
+import org.springframework.scheduling.annotation.Scheduled;
+import org.springframework.stereotype.Component;
+
+/**
+ * Where requests hand the samples they store and the trainings they ask for,
+ * so that which node does the work is a matter of node.role:
+ *
+ *   all     (default) everything runs in this JVM, as on a single node.
+ *   api     stateless: samples and training requests are queued in the
+ *           BlobStore, and no training runs here. Any number of these can
+ *           sit behind a load balancer.
+ *   worker  drains the queue into its SampleStore and TrainingScheduler and
+ *           publishes the models it trains to the BlobStore.
+ *
+ * A deployment runs a single worker, since the SampleStore it appends to
+ * has one writer. Samples go in as one "queue/samples/" entry per request,
+ * "<deviceId> <fps> <speed>" lines, and a training request as an empty
+ * "queue/train/<deviceId>" entry, so requests for a device that is still
+ * queued fold together as in TrainingScheduler. An entry is deleted once
+ * applied; a worker that dies in between applies it again when it restarts.
+ */
+@Component
+public class WorkQueue {
+	private static final String SAMPLES = "queue/samples/";
+	private static final String TRAIN = "queue/train/";
+	// Stands in for the shared model, whose device id is empty.
+	private static final String SHARED_DEVICE = "-";
+
+	@Autowired
+	private BlobStore blobStore;
+	@Autowired
+	private SampleStore sampleStore;
+	@Autowired
+	private TrainingScheduler trainingScheduler;
+	@Value("${node.role:all}")
+	private String role;
+
+	// Names this node's queue entries apart from other API nodes'.
+	private final String node = UUID.randomUUID().toString();
+	private final AtomicLong sequence = new AtomicLong();
+
+	// Whether this node leaves training to the worker.
+	public boolean isApiOnly() {
+		return "api".equals(role);
+	}
+
+	// Stores |samples| of |deviceId|, or queues them for the worker.
+	public void addSamples(String deviceId, List<SampleStore.Sample> samples) throws IOException {
+		if (samples.isEmpty())
+			return;
+		if (!isApiOnly()) {
+			for (SampleStore.Sample sample : samples)
+				sampleStore.append(deviceId, sample.fps, sample.speed);
+			return;
+		}
+		StringBuilder lines = new StringBuilder();
+		for (SampleStore.Sample sample : samples)
+			lines.append(deviceId).append(' ').append(sample.fps).append(' ').append(sample.speed).append('\n');
+		String key = SAMPLES + System.currentTimeMillis() + "-" + node + "-" + sequence.incrementAndGet();
+		blobStore.put(key, lines.toString().getBytes(StandardCharsets.US_ASCII));
+	}
+
+	// Asks for the model of |deviceId|, or the shared model if it is empty, to
+	// be retrained, here or by the worker.
+	public void requestTraining(String deviceId) throws IOException {
+		if (!isApiOnly()) {
+			trainingScheduler.schedule(deviceId);
+			return;
+		}
+		String device = deviceId.trim().isEmpty() ? SHARED_DEVICE : deviceId;
+		blobStore.put(TRAIN + device, new byte[0]);
+	}
+
+	// Applies what the API nodes queued, samples before trainings so that a
+	// training sees the samples posted with it.
+	@Scheduled(fixedDelayString = "${queue.poll-interval-ms:1000}")
+	public void drain() {
+		if (!"worker".equals(role))
+			return;
+		try {
+			for (String key : blobStore.list(SAMPLES)) {
+				byte[] lines = blobStore.get(key);
+				if (lines != null)
+					applySamples(new String(lines, StandardCharsets.US_ASCII));
+				blobStore.delete(key);
+			}
+			for (String key : blobStore.list(TRAIN)) {
+				// Deleted first, so a request that comes in during the training
+				// queues another.
+				if (!blobStore.delete(key))
+					continue;
+				String device = key.substring(TRAIN.length());
+				trainingScheduler.schedule(SHARED_DEVICE.equals(device) ? "" : device);
+			}
+		} catch (IOException e) {
+			e.printStackTrace();
+		}
+	}
+
+	private void applySamples(String lines) throws IOException {
+		for (String line : lines.split("\n")) {
+			String[] fields = line.trim().split(" ");
+			if (fields.length != 3)
+				continue;
+			try {
+				sampleStore.append(fields[0], Double.parseDouble(fields[1]), Double.parseDouble(fields[2]));
+			} catch (NumberFormatException e) {
+				System.err.println("WorkQueue: bad sample " + line);
+			}
+		}
+	}
+}
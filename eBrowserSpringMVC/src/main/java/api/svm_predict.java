@@ -26,7 +26,7 @@ class svm_predict {
 		return Integer.parseInt(s);
 	}
 
-	private static double predict(String speed, svm_model model) throws IOException {
+	static double predict(String speed, svm_model model) throws IOException {
 		svm_node[] x = new svm_node[1];
 		x[0] = new svm_node();
 		x[0].index = atoi("1");
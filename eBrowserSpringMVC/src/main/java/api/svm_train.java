@@ -136,13 +136,10 @@ class svm_train {
 		return Integer.parseInt(s);
 	}
 
-	private void parse_command_line(String argv[])
+	// The parameters the server trains with when no options are given.
+	static svm_parameter default_parameter()
 	{
-		int i;
-		svm_print_interface print_func = null;	// default printing to stdout
-
-		param = new svm_parameter();
-		// default values
+		svm_parameter param = new svm_parameter();
 		param.svm_type = svm_parameter.EPSILON_SVR;
 		param.kernel_type = svm_parameter.RBF;
 		param.degree = 3;
@@ -158,6 +155,15 @@ class svm_train {
 		param.nr_weight = 0;
 		param.weight_label = new int[0];
 		param.weight = new double[0];
+		return param;
+	}
+
+	private void parse_command_line(String argv[])
+	{
+		int i;
+		svm_print_interface print_func = null;	// default printing to stdout
+
+		param = default_parameter();
 		cross_validation = 0;
 		
 		// parse options
@@ -0,0 +1,71 @@
+package libsvm;
+
+/**
+ * Epsilon-SVR training that starts SMO from a given solution instead of from
+ * zero. libsvm only exposes cold starts, so this lives in the library's
+ * package to reach its Solver and SVR_Q, and mirrors the regression branch of
+ * svm.svm_train.
+ */
+public class WarmStartSvr {
+	/**
+	 * Trains on |prob|. |coef| holds alpha_i - alpha_i* for every sample: on
+	 * entry the starting point (zero for new samples), which must have each
+	 * entry within [-C, C] and sum to zero; on return the solution.
+	 */
+	public static svm_model train(svm_problem prob, svm_parameter param, double[] coef) {
+		int l = prob.l;
+		double[] alpha2 = new double[2 * l];
+		double[] linearTerm = new double[2 * l];
+		byte[] y = new byte[2 * l];
+		for (int i = 0; i < l; i++) {
+			alpha2[i] = Math.max(coef[i], 0);
+			linearTerm[i] = param.p - prob.y[i];
+			y[i] = 1;
+
+			alpha2[i + l] = Math.max(-coef[i], 0);
+			linearTerm[i + l] = param.p + prob.y[i];
+			y[i + l] = -1;
+		}
+
+		Solver.SolutionInfo si = new Solver.SolutionInfo();
+		Solver s = new Solver();
+		s.Solve(2 * l, new SVR_Q(prob, param), linearTerm, y, alpha2, param.C, param.C, param.eps, si,
+				param.shrinking);
+
+		for (int i = 0; i < l; i++)
+			coef[i] = alpha2[i] - alpha2[i + l];
+		return model(prob, param, coef, si.rho);
+	}
+
+	/**
+	 * Builds the model of a solution |coef|, as train() returns it, for
+	 * solutions from elsewhere such as the native trainer.
+	 */
+	public static svm_model model(svm_problem prob, svm_parameter param, double[] coef, double rho) {
+		int l = prob.l;
+		int nSV = 0;
+		for (int i = 0; i < l; i++) {
+			if (coef[i] != 0)
+				++nSV;
+		}
+
+		svm_model model = new svm_model();
+		model.param = param;
+		model.nr_class = 2;
+		model.rho = new double[] { rho };
+		model.l = nSV;
+		model.SV = new svm_node[nSV][];
+		model.sv_coef = new double[1][nSV];
+		model.sv_indices = new int[nSV];
+		int j = 0;
+		for (int i = 0; i < l; i++) {
+			if (coef[i] != 0) {
+				model.SV[j] = prob.x[i];
+				model.sv_coef[0][j] = coef[i];
+				model.sv_indices[j] = i + 1;
+				++j;
+			}
+		}
+		return model;
+	}
+}
@@ -0,0 +1,345 @@
+import java.io.BufferedReader;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileReader;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.HttpURLConnection;
+import java.net.URL;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.Random;
+import java.util.UUID;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * Load harness for the eBrowser cloud service. Simulates devices that each
+ * loop over a weighted mix of the service's endpoints with exponentially
+ * distributed think times between requests, then reports per-endpoint
+ * throughput and latency percentiles, the training queue depth seen on
+ * /trainStats, and, for a server on this host, its disk I/O.
+ *
+ * Plain JDK, no build needed:
+ *
+ *   javac LoadHarness.java
+ *   java LoadHarness --url=http://127.0.0.1:8080 --devices=200 --seconds=60 \
+ *       --mix=save:60,download:25,pinch:10,train:5 --think-ms=500 --pid=1234
+ *
+ * Endpoints of the mix: save, pinch, download (the shared model, with the
+ * ETag of the last download so unchanged models cost a 304, as on a
+ * browser), download-device (the device's own model), feedback (a batch of
+ * --batch save lines, as the browser's uploader sends) and train. --pid is
+ * the server's process id, whose /proc/<pid>/io is sampled; leave it out for
+ * a remote server.
+ */
+public class LoadHarness {
+	private static final int CONNECT_TIMEOUT_MILLIS = 5000;
+	private static final int READ_TIMEOUT_MILLIS = 60000;
+	private static final int STATS_INTERVAL_MILLIS = 1000;
+	private static final Pattern QUEUED = Pattern.compile("\"queued\"\\s*:\\s*(\\d+)");
+	private static final Pattern RUNNING = Pattern.compile("\"running\"\\s*:\\s*(\\d+)");
+
+	// Latencies and outcomes of the requests to one endpoint.
+	private static class Endpoint {
+		final String name;
+		final int weight;
+		// Guarded by |this|, in microseconds.
+		long[] latencies = new long[1024];
+		int count;
+		int errors;
+		long bytes;
+
+		Endpoint(String name, int weight) {
+			this.name = name;
+			this.weight = weight;
+		}
+
+		synchronized void record(long micros, boolean ok, long bodyBytes) {
+			if (count == latencies.length)
+				latencies = Arrays.copyOf(latencies, count * 2);
+			latencies[count++] = micros;
+			if (!ok)
+				++errors;
+			bytes += bodyBytes;
+		}
+	}
+
+	private final String url;
+	private final int devices;
+	private final int seconds;
+	private final double thinkMillis;
+	private final int batch;
+	private final String pid;
+	private final List<Endpoint> endpoints = new ArrayList<Endpoint>();
+	private int totalWeight;
+	private final AtomicBoolean running = new AtomicBoolean(true);
+
+	// Written by the stats thread only.
+	private int maxQueued;
+	private int maxRunning;
+	private long queuedSum;
+	private int statsSamples;
+
+	private LoadHarness(Map<String, String> args) {
+		url = args.getOrDefault("url", "http://127.0.0.1:8080");
+		devices = Integer.parseInt(args.getOrDefault("devices", "50"));
+		seconds = Integer.parseInt(args.getOrDefault("seconds", "30"));
+		thinkMillis = Double.parseDouble(args.getOrDefault("think-ms", "1000"));
+		batch = Integer.parseInt(args.getOrDefault("batch", "20"));
+		pid = args.get("pid");
+		for (String entry : args.getOrDefault("mix", "save:60,download:25,pinch:10,train:5").split(",")) {
+			String[] parts = entry.split(":");
+			int weight = parts.length > 1 ? Integer.parseInt(parts[1]) : 1;
+			endpoints.add(new Endpoint(parts[0], weight));
+			totalWeight += weight;
+		}
+	}
+
+	public static void main(String[] argv) throws Exception {
+		Map<String, String> args = new LinkedHashMap<String, String>();
+		for (String arg : argv) {
+			if (!arg.startsWith("--")) {
+				System.err.println("unexpected argument " + arg);
+				System.exit(1);
+			}
+			int equals = arg.indexOf('=');
+			if (equals < 0)
+				args.put(arg.substring(2), "");
+			else
+				args.put(arg.substring(2, equals), arg.substring(equals + 1));
+		}
+		new LoadHarness(args).run();
+	}
+
+	private void run() throws Exception {
+		long[] ioBefore = readIo();
+		List<Thread> threads = new ArrayList<Thread>();
+		for (int i = 0; i < devices; i++) {
+			final String deviceId = "load-" + UUID.randomUUID();
+			final Random random = new Random(i);
+			Thread thread = new Thread(new Runnable() {
+				public void run() {
+					device(deviceId, random);
+				}
+			}, "device-" + i);
+			threads.add(thread);
+		}
+		Thread stats = new Thread(new Runnable() {
+			public void run() {
+				pollStats();
+			}
+		}, "stats");
+
+		long start = System.nanoTime();
+		for (Thread thread : threads)
+			thread.start();
+		stats.start();
+		Thread.sleep(seconds * 1000L);
+		running.set(false);
+		for (Thread thread : threads)
+			thread.join();
+		stats.join();
+		double elapsed = (System.nanoTime() - start) / 1e9;
+		report(elapsed, ioBefore, readIo());
+	}
+
+	// One device: a request of the mix, then a think time, until the end.
+	private void device(String deviceId, Random random) {
+		String etag = null;
+		while (running.get()) {
+			Endpoint endpoint = pick(random);
+			String path;
+			String body = null;
+			String ifNoneMatch = null;
+			if ("save".equals(endpoint.name)) {
+				path = "/save?deviceId=" + deviceId + "&speed=" + speed(random) + "&step=" + (random.nextInt(5) - 2);
+			} else if ("pinch".equals(endpoint.name)) {
+				path = "/pinch?deviceId=" + deviceId + "&speed=" + speed(random) + "&fps=" + (20 + random.nextInt(40));
+			} else if ("download".equals(endpoint.name)) {
+				path = "/download?fileName=model";
+				ifNoneMatch = etag;
+			} else if ("download-device".equals(endpoint.name)) {
+				path = "/download?fileName=" + deviceId;
+			} else if ("feedback".equals(endpoint.name)) {
+				path = "/feedback?deviceId=" + deviceId + "&train=false";
+				StringBuilder lines = new StringBuilder();
+				for (int i = 0; i < batch; i++)
+					lines.append("save ").append(speed(random)).append(' ').append(random.nextInt(5) - 2).append('\n');
+				body = lines.toString();
+			} else if ("train".equals(endpoint.name)) {
+				path = "/train?deviceId=" + deviceId;
+			} else {
+				throw new IllegalArgumentException("unknown endpoint " + endpoint.name);
+			}
+
+			long start = System.nanoTime();
+			boolean ok = false;
+			long bodyBytes = 0;
+			try {
+				HttpURLConnection connection = (HttpURLConnection) new URL(url + path).openConnection();
+				connection.setConnectTimeout(CONNECT_TIMEOUT_MILLIS);
+				connection.setReadTimeout(READ_TIMEOUT_MILLIS);
+				connection.setRequestProperty("Accept-Encoding", "gzip");
+				if (ifNoneMatch != null)
+					connection.setRequestProperty("If-None-Match", ifNoneMatch);
+				if (body != null) {
+					connection.setRequestMethod("POST");
+					connection.setDoOutput(true);
+					connection.setRequestProperty("Content-Type", "text/plain");
+					OutputStream out = connection.getOutputStream();
+					out.write(body.getBytes(StandardCharsets.US_ASCII));
+					out.close();
+				}
+				int status = connection.getResponseCode();
+				InputStream in = status < 400 ? connection.getInputStream() : connection.getErrorStream();
+				bodyBytes = drain(in);
+				// A device without a model yet gets a 404, which is not an
+				// error of the service.
+				ok = status < 400 || (status == 404 && "download-device".equals(endpoint.name));
+				if (status == 200 && "download".equals(endpoint.name))
+					etag = connection.getHeaderField("ETag");
+			} catch (IOException e) {
+				ok = false;
+			}
+			endpoint.record((System.nanoTime() - start) / 1000, ok, bodyBytes);
+
+			long think = (long) (-Math.log(1 - random.nextDouble()) * thinkMillis);
+			try {
+				Thread.sleep(think);
+			} catch (InterruptedException e) {
+				return;
+			}
+		}
+	}
+
+	private Endpoint pick(Random random) {
+		int choice = random.nextInt(totalWeight);
+		for (Endpoint endpoint : endpoints) {
+			choice -= endpoint.weight;
+			if (choice < 0)
+				return endpoint;
+		}
+		return endpoints.get(endpoints.size() - 1);
+	}
+
+	// Scroll speeds as the browser posts them, already divided by 50.
+	private static String speed(Random random) {
+		return String.format(Locale.US, "%.3f", Math.abs(random.nextGaussian()) * 2);
+	}
+
+	private static long drain(InputStream in) throws IOException {
+		if (in == null)
+			return 0;
+		byte[] buffer = new byte[8192];
+		long total = 0;
+		int read;
+		try {
+			while ((read = in.read(buffer)) >= 0)
+				total += read;
+		} finally {
+			in.close();
+		}
+		return total;
+	}
+
+	private void pollStats() {
+		while (running.get()) {
+			try {
+				HttpURLConnection connection = (HttpURLConnection) new URL(url + "/trainStats").openConnection();
+				connection.setConnectTimeout(CONNECT_TIMEOUT_MILLIS);
+				connection.setReadTimeout(READ_TIMEOUT_MILLIS);
+				ByteArrayOutputStream out = new ByteArrayOutputStream();
+				InputStream in = connection.getInputStream();
+				byte[] buffer = new byte[1024];
+				int read;
+				while ((read = in.read(buffer)) >= 0)
+					out.write(buffer, 0, read);
+				in.close();
+				String json = new String(out.toByteArray(), StandardCharsets.UTF_8);
+				int queued = match(QUEUED, json);
+				maxQueued = Math.max(maxQueued, queued);
+				maxRunning = Math.max(maxRunning, match(RUNNING, json));
+				queuedSum += queued;
+				++statsSamples;
+			} catch (IOException e) {
+				// Counted through the endpoints' errors.
+			}
+			try {
+				Thread.sleep(STATS_INTERVAL_MILLIS);
+			} catch (InterruptedException e) {
+				return;
+			}
+		}
+	}
+
+	private static int match(Pattern pattern, String json) {
+		Matcher matcher = pattern.matcher(json);
+		return matcher.find() ? Integer.parseInt(matcher.group(1)) : 0;
+	}
+
+	// Returns {read_bytes, write_bytes} of the server, or null.
+	private long[] readIo() {
+		if (pid == null)
+			return null;
+		File file = new File("/proc/" + pid + "/io");
+		long[] io = new long[2];
+		try {
+			BufferedReader reader = new BufferedReader(new FileReader(file));
+			try {
+				String line;
+				while ((line = reader.readLine()) != null) {
+					if (line.startsWith("read_bytes:"))
+						io[0] = Long.parseLong(line.substring("read_bytes:".length()).trim());
+					else if (line.startsWith("write_bytes:"))
+						io[1] = Long.parseLong(line.substring("write_bytes:".length()).trim());
+				}
+			} finally {
+				reader.close();
+			}
+		} catch (IOException e) {
+			System.err.println("cannot read " + file + ": " + e.getMessage());
+			return null;
+		}
+		return io;
+	}
+
+	private void report(double elapsed, long[] ioBefore, long[] ioAfter) {
+		System.out.printf("%d devices, %.1f s, think time %.0f ms%n", devices, elapsed, thinkMillis);
+		System.out.printf("%-16s %9s %9s %8s %9s %9s %9s %11s%n", "endpoint", "requests", "req/s", "errors",
+				"p50 ms", "p99 ms", "max ms", "KB/s");
+		int totalRequests = 0;
+		for (Endpoint endpoint : endpoints) {
+			synchronized (endpoint) {
+				long[] sorted = Arrays.copyOf(endpoint.latencies, endpoint.count);
+				Arrays.sort(sorted);
+				totalRequests += endpoint.count;
+				System.out.printf("%-16s %9d %9.1f %8d %9.1f %9.1f %9.1f %11.1f%n", endpoint.name, endpoint.count,
+						endpoint.count / elapsed, endpoint.errors, percentile(sorted, 0.50), percentile(sorted, 0.99),
+						percentile(sorted, 1.0), endpoint.bytes / 1024.0 / elapsed);
+			}
+		}
+		System.out.printf("total %d requests, %.1f req/s%n", totalRequests, totalRequests / elapsed);
+		System.out.printf("training queue: mean %.1f, max %d queued, max %d running%n",
+				statsSamples == 0 ? 0.0 : (double) queuedSum / statsSamples, maxQueued, maxRunning);
+		if (ioBefore != null && ioAfter != null) {
+			System.out.printf("server disk: read %.1f KB/s, write %.1f KB/s%n",
+					(ioAfter[0] - ioBefore[0]) / 1024.0 / elapsed, (ioAfter[1] - ioBefore[1]) / 1024.0 / elapsed);
+		}
+	}
+
+	// In milliseconds.
+	private static double percentile(long[] sorted, double fraction) {
+		if (sorted.length == 0)
+			return 0;
+		int index = (int) Math.ceil(fraction * sorted.length) - 1;
+		return sorted[Math.max(0, Math.min(sorted.length - 1, index))] / 1000.0;
+	}
+}